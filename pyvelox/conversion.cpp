@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,159 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+// Keeps the Python buffer under a BufferView alive. The buffer is released
+// when the last copy of the releaser goes away, i.e. with the BufferView.
+class PyBufferReleaser {
+ public:
+  explicit PyBufferReleaser(std::shared_ptr<py::buffer_info> info)
+      : info_(std::move(info)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  std::shared_ptr<py::buffer_info> info_;
+};
+
+// Returns the kind of the Velox vector that can share the memory of a buffer
+// with 'info'. Booleans are bit-packed in Velox and cannot be shared.
+TypeKind bufferTypeKind(const py::buffer_info& info) {
+  auto format = info.format;
+  if (!format.empty() && (format[0] == '@' || format[0] == '=')) {
+    format = format.substr(1);
+  }
+  if (format.size() == 1) {
+    switch (format[0]) {
+      case 'b':
+      case 'h':
+      case 'i':
+      case 'l':
+      case 'q':
+        switch (info.itemsize) {
+          case 1:
+            return TypeKind::TINYINT;
+          case 2:
+            return TypeKind::SMALLINT;
+          case 4:
+            return TypeKind::INTEGER;
+          case 8:
+            return TypeKind::BIGINT;
+        }
+        break;
+      case 'f':
+        return TypeKind::REAL;
+      case 'd':
+        return TypeKind::DOUBLE;
+    }
+  }
+  throw py::type_error(
+      "Unsupported buffer format '" + info.format +
+      "', expected signed integers, float32 or float64");
+}
+
+template <TypeKind Kind>
+VectorPtr bufferToFlatVector(
+    std::shared_ptr<py::buffer_info> info,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto size = info->size;
+  auto values = BufferView<PyBufferReleaser>::create(
+      reinterpret_cast<const uint8_t*>(info->ptr),
+      size * sizeof(T),
+      PyBufferReleaser(info));
+  return std::make_shared<FlatVector<T>>(
+      pool,
+      createScalarType(Kind),
+      BufferPtr(nullptr),
+      size,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+// Makes a flat vector over the memory of 'buffer', which must be
+// one-dimensional and contiguous, e.g. a NumPy array.
+VectorPtr importFromBuffer(const py::buffer& buffer) {
+  auto info = std::shared_ptr<py::buffer_info>(
+      new py::buffer_info(buffer.request()), [](py::buffer_info* info) {
+        // The buffer may be given up by a Velox thread.
+        py::gil_scoped_acquire acquire;
+        delete info;
+      });
+  if (info->ndim != 1 ||
+      (info->size > 1 && info->strides[0] != info->itemsize)) {
+    throw py::value_error("Buffer must be one-dimensional and contiguous");
+  }
+  if (info->size > std::numeric_limits<vector_size_t>::max()) {
+    throw py::value_error("Buffer has too many elements for a vector");
+  }
+  const auto kind = bufferTypeKind(*info);
+  if (reinterpret_cast<uintptr_t>(info->ptr) % info->itemsize != 0) {
+    throw py::value_error("Buffer must be aligned to its element size");
+  }
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      bufferToFlatVector,
+      kind,
+      std::move(info),
+      PyVeloxContext::getSingletonInstance().pool());
+}
+
+// Returns a read-only NumPy array over the values of 'vector'. The array
+// keeps 'vector' alive.
+py::array exportToNumpy(const VectorPtr& vector) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    throw py::type_error("Only flat vectors can be exported to NumPy");
+  }
+  std::string dtype;
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      dtype = "int8";
+      break;
+    case TypeKind::SMALLINT:
+      dtype = "int16";
+      break;
+    case TypeKind::INTEGER:
+      dtype = "int32";
+      break;
+    case TypeKind::BIGINT:
+      dtype = "int64";
+      break;
+    case TypeKind::REAL:
+      dtype = "float32";
+      break;
+    case TypeKind::DOUBLE:
+      dtype = "float64";
+      break;
+    default:
+      throw py::type_error(
+          "Vectors of type " + vector->type()->toString() +
+          " cannot be exported to NumPy, use export_to_arrow");
+  }
+  if (vector->mayHaveNulls() &&
+      BaseVector::countNulls(vector->nulls(), vector->size()) > 0) {
+    throw py::value_error(
+        "Vectors with nulls cannot be exported to NumPy, use export_to_arrow");
+  }
+  py::dtype numpyType(dtype);
+  auto* holder = new VectorPtr(vector);
+  py::capsule base(holder, [](void* vector) {
+    delete reinterpret_cast<VectorPtr*>(vector);
+  });
+  py::array result(
+      numpyType,
+      {static_cast<py::ssize_t>(vector->size())},
+      {static_cast<py::ssize_t>(numpyType.itemsize())},
+      vector->valuesAsVoid(),
+      base);
+  // Velox vectors may be shared and must not be changed from Python.
+  result.attr("setflags")(py::arg("write") = false);
+  return result;
+}
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +203,19 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "from_numpy",
+      &importFromBuffer,
+      py::arg("array"),
+      "Returns a flat vector sharing the memory of a one-dimensional, "
+      "contiguous NumPy array or other buffer of numbers without copying.");
+
+  m.def(
+      "to_numpy",
+      &exportToNumpy,
+      py::arg("vector"),
+      "Returns a read-only NumPy array sharing the values of a flat vector "
+      "of numbers without nulls without copying.");
 }
 } // namespace facebook::velox::py
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -392,6 +393,58 @@ class TestVeloxVector(unittest.TestCase):
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
 
+    def test_from_numpy(self):
+        test_cases = [
+            (np.int8, pv.TinyintType()),
+            (np.int16, pv.SmallintType()),
+            (np.int32, pv.IntegerType()),
+            (np.int64, pv.BigintType()),
+            (np.float32, pv.RealType()),
+            (np.float64, pv.DoubleType()),
+        ]
+        for dtype, expected_type in test_cases:
+            with self.subTest(dtype=dtype):
+                array = np.arange(10, dtype=dtype)
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.size(), 10)
+                self.assertEqual(vector.dtype(), expected_type)
+                for i in range(10):
+                    self.assertEqual(vector[i], i)
+
+        # The vector shares the memory of the array.
+        array = np.arange(5, dtype=np.int64)
+        vector = pv.from_numpy(array)
+        array[2] = 100
+        self.assertEqual(vector[2], 100)
+        del array
+        self.assertEqual(vector[4], 4)
+
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array([True, False]))
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.arange(10, dtype=np.int64)[::2])
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.zeros((2, 2), dtype=np.int64))
+
+    def test_to_numpy(self):
+        vector = pv.from_list([1, 2, 3])
+        array = pv.to_numpy(vector)
+        self.assertEqual(array.dtype, np.int64)
+        self.assertListEqual(array.tolist(), [1, 2, 3])
+        self.assertFalse(array.flags.writeable)
+
+        # Round trip without copying.
+        source = np.array([0.5, 1.5, 2.5])
+        array = pv.to_numpy(pv.from_numpy(source))
+        self.assertTrue(np.shares_memory(source, array))
+
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None, 3]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.constant_vector(1, 10))
+
     def test_row_vector_basic(self):
         vals = [
             pv.from_list([1, 2, 3]),
@@ -87,6 +87,21 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  auto bigintStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return std::to_string(-1234567890123LL * (row + 1)); });
+  auto shortDoubleStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return fmt::format("{}.25", row); });
+  auto timestampStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) {
+        return fmt::format(
+            "2024-05-{:02d} {:02d}:{:02d}:{:02d}.{:03d}",
+            1 + row % 30,
+            row % 24,
+            row % 60,
+            (row * 7) % 60,
+            row % 1000);
+      });
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -149,6 +164,23 @@ int main(int argc, char** argv) {
           "try_cast_invalid_infinity", "try_cast (invalid_infinity as double)")
       .addExpression("try_cast_space", "try_cast (space as double)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_number_plain_notation",
+          vectorMaker.rowVector(
+              {"integer", "bigint", "double", "timestamp", "spaces"},
+              {validInput,
+               bigintStrings,
+               shortDoubleStrings,
+               timestampStrings,
+               spaceInput}))
+      .addExpression("cast_integer", "cast (integer as int)")
+      .addExpression("cast_bigint", "cast (bigint as bigint)")
+      .addExpression("cast_double", "cast (double as double)")
+      .addExpression("cast_real", "cast (double as real)")
+      .addExpression("cast_timestamp", "cast (timestamp as timestamp)")
+      .addExpression("try_cast_spaces", "try_cast (spaces as int)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast",
@@ -115,7 +115,8 @@ int main(int argc, char** argv) {
   benchmarkBuilder
       .addBenchmarkSet(
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
-      .addExpression("generic", R"(like(col0, '%a%b%c'))");
+      .addExpression("generic", R"(like(col0, '%a%b%c'))")
+      .addExpression("generic_literal", R"(like(col0, '%xa\_b\_c%x_', '\'))");
 
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
@@ -41,7 +41,8 @@ class SelectivityVectorBenchmark
         rows99PerCent_(vectorSize),
         rows50PerCent_(vectorSize),
         rows10PerCent_(vectorSize),
-        rows1PerCent_(vectorSize) {
+        rows1PerCent_(vectorSize),
+        rowsPerMille_(vectorSize) {
     VectorFuzzer::Options opts;
     opts.vectorSize = vectorSize_;
     opts.nullRatio = 0;
@@ -64,6 +65,11 @@ class SelectivityVectorBenchmark
         rows1PerCent_.setValid(i, false);
       }
 
+      // Set 99.9% to invalid.
+      if (fuzzer.coinToss(0.999)) {
+        rowsPerMille_.setValid(i, false);
+      }
+
       // Set 1% to invalid.
       if (fuzzer.coinToss(0.01)) {
         rows99PerCent_.setValid(i, false);
@@ -75,6 +81,7 @@ class SelectivityVectorBenchmark
     rows50PerCent_.updateBounds();
     rows10PerCent_.updateBounds();
     rows1PerCent_.updateBounds();
+    rowsPerMille_.updateBounds();
   }
 
   size_t runBaseline() {
@@ -108,6 +115,24 @@ class SelectivityVectorBenchmark
     return run(rows99PerCent_);
   }
 
+  // Iterates over the list of selected rows.
+  size_t runSelectivityPerMille() {
+    return run(rowsPerMille_);
+  }
+
+  // Iterates over the bits of the same rows as runSelectivityPerMille().
+  size_t runSelectivityPerMilleBits() {
+    const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
+    size_t sum = 0;
+    bits::forEachSetBit(
+        rowsPerMille_.asRange().bits(),
+        rowsPerMille_.begin(),
+        rowsPerMille_.end(),
+        [&flatBuffer, &sum](auto row) { sum += flatBuffer[row]; });
+    folly::doNotOptimizeAway(sum);
+    return vectorSize_;
+  }
+
  private:
   size_t run(const SelectivityVector& rows) {
     const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
@@ -126,6 +151,7 @@ class SelectivityVectorBenchmark
   SelectivityVector rows50PerCent_;
   SelectivityVector rows10PerCent_;
   SelectivityVector rows1PerCent_;
+  SelectivityVector rowsPerMille_;
 };
 
 std::unique_ptr<SelectivityVectorBenchmark> benchmark;
@@ -161,6 +187,14 @@ BENCHMARK(sumSelectivity1PerCent) {
   run([] { benchmark->runSelectivity1PerCent(); });
 }
 
+BENCHMARK(sumSelectivityPerMilleBits) {
+  run([] { benchmark->runSelectivityPerMilleBits(); });
+}
+
+BENCHMARK_RELATIVE(sumSelectivityPerMille) {
+  run([] { benchmark->runSelectivityPerMille(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+
+#include <folly/FileUtil.h>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/dwio/dwrf/RegisterDwrfReader.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/SqlQueryPlanner.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DECLARE_int32(num_drivers);
+DECLARE_int32(split_preload_per_driver);
+
+DEFINE_string(query, "", "SQL query to run");
+DEFINE_string(query_file, "", "File with the SQL query to run");
+DEFINE_double(
+    tpch_scale_factor,
+    1,
+    "Scale factor of the TPC-H tables generated by the TPC-H connector. "
+    "0 disables the TPC-H tables");
+DEFINE_int32(tpch_splits, 16, "Number of splits for each TPC-H table scan");
+DEFINE_string(
+    hive_data_path,
+    "",
+    "Directory with a sub-directory of data files for each Hive table. The "
+    "table is named after the sub-directory and its schema is read from the "
+    "first file. Hive tables hide TPC-H tables of the same name");
+DEFINE_string(hive_format, "parquet", "Format of the Hive data files");
+DEFINE_int32(iterations, 5, "Number of measured runs of the query");
+DEFINE_int32(warmup_iterations, 1, "Number of runs before the measured ones");
+DEFINE_bool(print_plan_stats, false, "Print the plan with the stats");
+
+namespace {
+
+RowTypePtr readFileSchema(
+    const std::string& path,
+    dwio::common::FileFormat format,
+    memory::MemoryPool* pool) {
+  dwio::common::ReaderOptions readerOptions{pool};
+  readerOptions.setFileFormat(format);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      std::move(readFile), *pool);
+  return dwio::common::getReaderFactory(format)
+      ->createReader(std::move(input), readerOptions)
+      ->rowType();
+}
+
+class SqlBenchmark : public QueryBenchmarkBase {
+ public:
+  void initialize() override {
+    QueryBenchmarkBase::initialize();
+    dwrf::registerDwrfReaderFactory();
+    parquet::registerParquetReaderFactory();
+    connector::registerConnectorFactory(
+        std::make_shared<connector::tpch::TpchConnectorFactory>());
+    connector::registerConnector(
+        connector::getConnectorFactory(
+            connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+            ->newConnector(
+                std::string(PlanBuilder::kTpchDefaultConnectorId),
+                std::make_shared<config::ConfigBase>(
+                    std::unordered_map<std::string, std::string>())));
+
+    pool_ = memory::memoryManager()->addLeafPool();
+    planner_ = std::make_unique<SqlQueryPlanner>(pool_.get());
+    if (FLAGS_tpch_scale_factor > 0) {
+      planner_->registerTpchTables(FLAGS_tpch_scale_factor, FLAGS_tpch_splits);
+    }
+    if (!FLAGS_hive_data_path.empty()) {
+      registerHiveTables(FLAGS_hive_data_path);
+    }
+
+    std::string sql = FLAGS_query;
+    if (!FLAGS_query_file.empty()) {
+      VELOX_USER_CHECK(
+          folly::readFile(FLAGS_query_file.c_str(), sql),
+          "Cannot read {}",
+          FLAGS_query_file);
+    }
+    VELOX_USER_CHECK(!sql.empty(), "Specify --query or --query_file");
+    plan_ = planner_->plan(sql);
+  }
+
+  void runMain(std::ostream& out, RunStats& runStats) override {
+    for (auto i = 0; i < FLAGS_warmup_iterations; ++i) {
+      runQuery();
+    }
+    std::vector<uint64_t> micros;
+    std::shared_ptr<Task> task;
+    uint64_t numRows = 0;
+    for (auto i = 0; i < FLAGS_iterations; ++i) {
+      uint64_t runMicros = 0;
+      {
+        MicrosecondTimer timer(&runMicros);
+        numRows = runQuery(&task);
+      }
+      micros.push_back(runMicros);
+    }
+    VELOX_CHECK_NOT_NULL(task);
+
+    const auto stats = task->taskStats();
+    for (const auto& pipeline : stats.pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == "TableScan") {
+          runStats.rawInputBytes += op.rawInputBytes;
+        }
+      }
+    }
+    std::sort(micros.begin(), micros.end());
+    out << fmt::format(
+               "{} rows, median {}, min {}, max {} over {} runs",
+               numRows,
+               succinctMicros(micros[micros.size() / 2]),
+               succinctMicros(micros.front()),
+               succinctMicros(micros.back()),
+               micros.size())
+        << std::endl;
+    if (FLAGS_print_plan_stats) {
+      out << printPlanWithStats(*plan_.plan, stats, FLAGS_include_custom_stats)
+          << std::endl;
+    }
+  }
+
+  void shutdown() {
+    planner_.reset();
+    pool_.reset();
+    QueryBenchmarkBase::shutdown();
+  }
+
+ private:
+  void registerHiveTables(const std::string& path) {
+    const auto format = dwio::common::toFileFormat(FLAGS_hive_format);
+    for (const auto& tableDir : std::filesystem::directory_iterator(path)) {
+      if (!tableDir.is_directory()) {
+        continue;
+      }
+      std::vector<std::string> files;
+      for (const auto& file : std::filesystem::directory_iterator(tableDir)) {
+        if (file.is_regular_file() &&
+            file.path().filename().string().front() != '.') {
+          files.push_back(file.path().string());
+        }
+      }
+      if (files.empty()) {
+        continue;
+      }
+      std::sort(files.begin(), files.end());
+      const auto name = tableDir.path().filename().string();
+      planner_->registerHiveTable(
+          name,
+          readFileSchema(files[0], format, pool_.get()),
+          std::move(files),
+          format);
+    }
+  }
+
+  // Runs the query and returns the number of result rows. Sets 'task' to the
+  // task which ran the query if not null.
+  uint64_t runQuery(std::shared_ptr<Task>* task = nullptr) {
+    AssertQueryBuilder builder(plan_.plan);
+    builder.maxDrivers(FLAGS_num_drivers)
+        .config(
+            core::QueryConfig::kMaxSplitPreloadPerDriver,
+            std::to_string(FLAGS_split_preload_per_driver));
+    for (const auto& [nodeId, splits] : plan_.splits) {
+      builder.splits(nodeId, splits);
+    }
+    std::shared_ptr<Task> runTask;
+    const auto numRows = builder.countResults(runTask);
+    if (task != nullptr) {
+      *task = std::move(runTask);
+    }
+    return numRows;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<SqlQueryPlanner> planner_;
+  SqlQueryPlan plan_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::SetUsageMessage(
+      "Times a SQL query over the TPC-H connector and Hive tables. Run "
+      "'velox_sql_benchmark -helpon=SqlBenchmark' for available options.");
+  folly::Init init{&argc, &argv, false};
+
+  SqlBenchmark benchmark;
+  benchmark.initialize();
+  if (FLAGS_test_flags_file.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    benchmark.runAllCombinations();
+  }
+  benchmark.shutdown();
+  return 0;
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/json.h>
+#include <unordered_set>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DECLARE_int32(num_repeats);
+
+DEFINE_string(
+    dwrf_data_path,
+    "",
+    "Root path of TPC-H data in DWRF format. See velox_tpch_benchmark "
+    "--data_path for the layout");
+DEFINE_string(
+    parquet_data_path,
+    "",
+    "Root path of TPC-H data in Parquet format. See velox_tpch_benchmark "
+    "--data_path for the layout");
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated TPC-H query numbers to run. Runs all if empty");
+DEFINE_string(
+    cache_states,
+    "cold",
+    "Comma separated cache states to measure each query in. 'cold' clears "
+    "the RAM and SSD caches before each run, 'ssd' clears only the RAM cache "
+    "so that the run reads from the SSD cache and 'warm' keeps both. "
+    "'ssd' and 'warm' require --cache_gb, 'ssd' also --ssd_cache_gb");
+DEFINE_int32(iterations, 3, "Number of measured runs of each query");
+DEFINE_string(
+    output_json,
+    "",
+    "File to write the results to. Writes to stdout if empty");
+DEFINE_string(
+    baseline_json,
+    "",
+    "Results of a previous run to compare with. The program fails if a "
+    "query is slower than in the baseline by more than --max_regression_pct "
+    "or returns a different number of rows");
+DEFINE_double(
+    max_regression_pct,
+    10,
+    "Allowed increase of the median wall time over --baseline_json");
+
+namespace {
+
+// Flags that only tell where to read or write files and do not affect the
+// measured numbers.
+const std::unordered_set<std::string> kUnrecordedFlags = {
+    "dwrf_data_path",
+    "parquet_data_path",
+    "output_json",
+    "baseline_json",
+    "ssd_path"};
+
+folly::dynamic nonDefaultFlags() {
+  std::vector<gflags::CommandLineFlagInfo> flags;
+  gflags::GetAllFlags(&flags);
+  folly::dynamic result = folly::dynamic::object;
+  for (const auto& flag : flags) {
+    if (!flag.is_default && kUnrecordedFlags.count(flag.name) == 0) {
+      result[flag.name] = flag.current_value;
+    }
+  }
+  return result;
+}
+
+// Returns the per operator stats of 'stats' ordered by plan node id and
+// operator type so that the output of repeated runs can be diffed.
+folly::dynamic sortedPlanStats(const TaskStats& stats) {
+  auto planStats = toPlanStatsJson(stats);
+  std::vector<folly::dynamic> sorted(planStats.begin(), planStats.end());
+  std::sort(
+      sorted.begin(), sorted.end(), [](const auto& left, const auto& right) {
+        return std::make_pair(
+                   left["planNodeId"].asString(),
+                   left["operatorType"].asString()) <
+            std::make_pair(
+                   right["planNodeId"].asString(),
+                   right["operatorType"].asString());
+      });
+  return folly::dynamic(sorted.begin(), sorted.end());
+}
+
+std::string runKey(const folly::dynamic& run) {
+  return fmt::format(
+      "q{} {} {}",
+      run["query"].asInt(),
+      run["format"].asString(),
+      run["cacheState"].asString());
+}
+
+class TpchRegressionBenchmark : public QueryBenchmarkBase {
+ public:
+  void initialize() override {
+    QueryBenchmarkBase::initialize();
+    if (!FLAGS_dwrf_data_path.empty()) {
+      addFormat(dwio::common::FileFormat::DWRF, FLAGS_dwrf_data_path);
+    }
+    if (!FLAGS_parquet_data_path.empty()) {
+      addFormat(dwio::common::FileFormat::PARQUET, FLAGS_parquet_data_path);
+    }
+    VELOX_USER_CHECK(
+        !builders_.empty(),
+        "Specify --dwrf_data_path or --parquet_data_path or both");
+
+    if (FLAGS_queries.empty()) {
+      for (auto i = 1; i <= 22; ++i) {
+        queries_.push_back(i);
+      }
+    } else {
+      folly::split(',', FLAGS_queries, queries_);
+    }
+
+    folly::split(',', FLAGS_cache_states, cacheStates_);
+    for (const auto& state : cacheStates_) {
+      VELOX_USER_CHECK(
+          state == "cold" || state == "ssd" || state == "warm",
+          "Unknown cache state: {}",
+          state);
+      VELOX_USER_CHECK(
+          state == "cold" || cache_ != nullptr,
+          "Cache state '{}' requires --cache_gb",
+          state);
+      VELOX_USER_CHECK(
+          state != "ssd" || cache_->ssdCache() != nullptr,
+          "Cache state 'ssd' requires --ssd_cache_gb");
+    }
+    VELOX_USER_CHECK_EQ(
+        FLAGS_num_repeats, 1, "Use --iterations to repeat the queries");
+    VELOX_USER_CHECK_GT(FLAGS_iterations, 0);
+  }
+
+  void runMain(std::ostream& out, RunStats& /*runStats*/) override {
+    folly::dynamic runs = folly::dynamic::array;
+    for (const auto& [format, builder] : builders_) {
+      for (auto query : queries_) {
+        const auto plan = builder->getQueryPlan(query);
+        for (const auto& state : cacheStates_) {
+          auto run = runQuery(plan, state);
+          run["query"] = query;
+          run["format"] = format;
+          run["cacheState"] = state;
+          LOG(INFO) << runKey(run) << ": "
+                    << succinctMicros(run["medianMicros"].asInt());
+          runs.push_back(std::move(run));
+        }
+      }
+    }
+
+    results_ = folly::dynamic::object;
+    results_["flags"] = nonDefaultFlags();
+    results_["runs"] = std::move(runs);
+    folly::json::serialization_opts opts;
+    opts.pretty_formatting = true;
+    opts.sort_keys = true;
+    out << folly::json::serialize(results_, opts) << std::endl;
+  }
+
+  // Compares the results of runMain() with 'baseline' and returns the number
+  // of regressions. Runs which are not in 'baseline' are ignored.
+  int32_t compare(const folly::dynamic& baseline) const {
+    std::unordered_map<std::string, const folly::dynamic*> baselineRuns;
+    for (const auto& run : baseline["runs"]) {
+      baselineRuns[runKey(run)] = &run;
+    }
+    int32_t numRegressions = 0;
+    for (const auto& run : results_["runs"]) {
+      const auto key = runKey(run);
+      auto it = baselineRuns.find(key);
+      if (it == baselineRuns.end()) {
+        LOG(WARNING) << key << ": not in baseline";
+        continue;
+      }
+      const auto& expected = *it->second;
+      if (run["outputRows"] != expected["outputRows"]) {
+        LOG(ERROR) << key << ": " << run["outputRows"].asInt()
+                   << " rows, baseline has "
+                   << expected["outputRows"].asInt();
+        ++numRegressions;
+        continue;
+      }
+      const auto micros = run["medianMicros"].asInt();
+      const auto baselineMicros = expected["medianMicros"].asInt();
+      if (baselineMicros == 0) {
+        continue;
+      }
+      const double changePct =
+          100.0 * (micros - baselineMicros) / baselineMicros;
+      if (changePct > FLAGS_max_regression_pct) {
+        LOG(ERROR) << fmt::format(
+            "{}: {} vs {} in baseline (+{:.1f}%)",
+            key,
+            succinctMicros(micros),
+            succinctMicros(baselineMicros),
+            changePct);
+        ++numRegressions;
+      }
+    }
+    return numRegressions;
+  }
+
+ private:
+  void addFormat(dwio::common::FileFormat format, const std::string& path) {
+    auto builder = std::make_shared<TpchQueryBuilder>(format);
+    builder->initialize(path);
+    builders_.emplace_back(
+        std::string(dwio::common::toString(format)), std::move(builder));
+  }
+
+  // Brings the caches to 'state' before a measured run. Runs 'plan' once if
+  // the run should find the data in a cache.
+  void prepareCaches(const TpchPlan& plan, const std::string& state) {
+    if (cache_ == nullptr) {
+      return;
+    }
+    auto* ssdCache = cache_->ssdCache();
+    if (state == "cold") {
+      cache_->clear();
+      if (ssdCache != nullptr) {
+        ssdCache->clear();
+      }
+      return;
+    }
+    if (state == "ssd") {
+      runChecked(plan);
+      ssdCache->waitForWriteToFinish();
+      cache_->clear();
+      return;
+    }
+    runChecked(plan);
+  }
+
+  std::shared_ptr<Task> runChecked(const TpchPlan& plan) {
+    auto [cursor, results] = run(plan);
+    VELOX_CHECK_NOT_NULL(cursor, "Query failed");
+    return cursor->task();
+  }
+
+  folly::dynamic runQuery(const TpchPlan& plan, const std::string& state) {
+    std::vector<int64_t> micros;
+    std::shared_ptr<Task> task;
+    for (auto i = 0; i < FLAGS_iterations; ++i) {
+      prepareCaches(plan, state);
+      uint64_t runMicros = 0;
+      {
+        MicrosecondTimer timer(&runMicros);
+        task = runChecked(plan);
+      }
+      micros.push_back(runMicros);
+    }
+
+    // Reports the stats of the last run. The times vary between runs but the
+    // row counts do not.
+    const auto stats = task->taskStats();
+    int64_t cpuNanos = 0;
+    int64_t rawInputBytes = 0;
+    for (const auto& pipeline : stats.pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        cpuNanos += op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+            op.finishTiming.cpuNanos;
+        if (op.operatorType == "TableScan") {
+          rawInputBytes += op.rawInputBytes;
+        }
+      }
+    }
+    const auto outputRows =
+        toPlanStats(stats).at(plan.plan->id()).outputRows;
+
+    auto sorted = micros;
+    std::sort(sorted.begin(), sorted.end());
+    folly::dynamic result = folly::dynamic::object;
+    result["micros"] = folly::dynamic(micros.begin(), micros.end());
+    result["medianMicros"] = sorted[sorted.size() / 2];
+    result["cpuNanos"] = cpuNanos;
+    result["rawInputBytes"] = rawInputBytes;
+    result["peakMemoryBytes"] = task->pool()->peakBytes();
+    result["outputRows"] = outputRows;
+    result["planStats"] = sortedPlanStats(stats);
+    return result;
+  }
+
+  std::vector<std::pair<std::string, std::shared_ptr<TpchQueryBuilder>>>
+      builders_;
+  std::vector<int32_t> queries_;
+  std::vector<std::string> cacheStates_;
+  folly::dynamic results_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::SetUsageMessage(
+      "Runs TPC-H queries over DWRF and Parquet data in a fixed set of "
+      "configurations and writes the timings and plan node stats as JSON. "
+      "Run 'velox_tpch_regression_benchmark -helpon=TpchRegressionBenchmark' "
+      "for available options.");
+  folly::Init init{&argc, &argv, false};
+
+  TpchRegressionBenchmark benchmark;
+  benchmark.initialize();
+  if (FLAGS_output_json.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    std::ofstream out(FLAGS_output_json);
+    VELOX_USER_CHECK(out.good(), "Cannot open {}", FLAGS_output_json);
+    RunStats ignore;
+    benchmark.runMain(out, ignore);
+  }
+
+  int32_t numRegressions = 0;
+  if (!FLAGS_baseline_json.empty()) {
+    std::string baseline;
+    VELOX_USER_CHECK(
+        folly::readFile(FLAGS_baseline_json.c_str(), baseline),
+        "Cannot read {}",
+        FLAGS_baseline_json);
+    numRegressions = benchmark.compare(folly::parseJson(baseline));
+    LOG(INFO) << numRegressions << " regressions against "
+              << FLAGS_baseline_json;
+  }
+  benchmark.shutdown();
+  return numRegressions == 0 ? 0 : 1;
+}
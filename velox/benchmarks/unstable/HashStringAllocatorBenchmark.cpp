@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/HashStringAllocator.h"
+
+DEFINE_int64(hsa_allocation_count, 1'000'000, "The number of allocations");
+DEFINE_int64(
+    hsa_live_bytes,
+    64 << 20,
+    "The cap of live allocated bytes before freeing");
+DEFINE_int64(hsa_seed, 99887766, "Seed for random allocation sizes");
+DEFINE_int64(
+    hsa_free_every_n_operations,
+    3,
+    "Frees a random live allocation for every N allocations");
+
+using namespace facebook::velox;
+
+namespace {
+
+// Allocates and frees random sized blocks in random order from a
+// HashStringAllocator with and without size classes. This mimics the
+// accumulators of array_agg and map_agg, which allocate and free many small
+// blocks as the groups grow.
+class HashStringAllocatorBenchmark {
+ public:
+  HashStringAllocatorBenchmark(
+      bool useSizeClasses,
+      int32_t minSize,
+      int32_t maxSize)
+      : minSize_(minSize),
+        maxSize_(maxSize),
+        pool_(memory::memoryManager()->addLeafPool()),
+        allocator_(pool_.get(), useSizeClasses) {
+    rng_.seed(FLAGS_hsa_seed);
+  }
+
+  ~HashStringAllocatorBenchmark() {
+    for (auto* header : headers_) {
+      allocator_.free(header);
+    }
+  }
+
+  size_t run() {
+    for (auto i = 0; i < FLAGS_hsa_allocation_count; ++i) {
+      if (i % FLAGS_hsa_free_every_n_operations == 0 && !headers_.empty()) {
+        free();
+      }
+      while (liveBytes_ >= FLAGS_hsa_live_bytes) {
+        free();
+      }
+      const auto size =
+          minSize_ + folly::Random::rand32(maxSize_ - minSize_ + 1, rng_);
+      headers_.push_back(allocator_.allocate(size));
+      liveBytes_ += headers_.back()->size();
+      maxRetainedBytes_ =
+          std::max<int64_t>(maxRetainedBytes_, allocator_.retainedSize());
+    }
+    return FLAGS_hsa_allocation_count;
+  }
+
+  // Returns the ratio of the largest footprint to the live bytes cap.
+  double overhead() const {
+    return static_cast<double>(maxRetainedBytes_) / FLAGS_hsa_live_bytes;
+  }
+
+ private:
+  void free() {
+    const auto index = folly::Random::rand32(headers_.size(), rng_);
+    liveBytes_ -= headers_[index]->size();
+    allocator_.free(headers_[index]);
+    headers_[index] = headers_.back();
+    headers_.pop_back();
+  }
+
+  const int32_t minSize_;
+  const int32_t maxSize_;
+  folly::Random::DefaultGenerator rng_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  HashStringAllocator allocator_;
+  std::vector<HashStringAllocator::Header*> headers_;
+  int64_t liveBytes_{0};
+  int64_t maxRetainedBytes_{0};
+};
+
+BENCHMARK_MULTI(arenaTiny) {
+  return HashStringAllocatorBenchmark(false, 8, 64).run();
+}
+
+BENCHMARK_RELATIVE_MULTI(sizeClassesTiny) {
+  return HashStringAllocatorBenchmark(true, 8, 64).run();
+}
+
+BENCHMARK_MULTI(arenaSmall) {
+  return HashStringAllocatorBenchmark(false, 16, 256).run();
+}
+
+BENCHMARK_RELATIVE_MULTI(sizeClassesSmall) {
+  return HashStringAllocatorBenchmark(true, 16, 256).run();
+}
+
+BENCHMARK_MULTI(arenaMix) {
+  return HashStringAllocatorBenchmark(false, 16, 2048).run();
+}
+
+BENCHMARK_RELATIVE_MULTI(sizeClassesMix) {
+  return HashStringAllocatorBenchmark(true, 16, 2048).run();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+
+  // Reports the footprint relative to the live bytes for each workload.
+  for (const auto& [minSize, maxSize] :
+       std::vector<std::pair<int32_t, int32_t>>{
+           {8, 64}, {16, 256}, {16, 2048}}) {
+    for (const bool useSizeClasses : {false, true}) {
+      HashStringAllocatorBenchmark benchmark(useSizeClasses, minSize, maxSize);
+      benchmark.run();
+      std::cout << "sizes " << minSize << "-" << maxSize
+                << (useSizeClasses ? " size classes" : " arena")
+                << ": retained / live " << benchmark.overhead() << std::endl;
+    }
+  }
+  return 0;
+}
@@ -31,7 +31,7 @@ void AdmissionController::accept(uint64_t resourceUnits) {
       "A single request cannot exceed the max limit");
   {
     std::lock_guard<std::mutex> l(mu_);
-    if (unitsUsed_ + resourceUnits > config_.maxLimit) {
+    if (!fitsLocked(resourceUnits)) {
       auto [unblockPromise, unblockFuture] = makeVeloxContinuePromiseContract();
       Request req;
       req.unitsRequested = resourceUnits;
@@ -73,19 +73,49 @@ void AdmissionController::release(uint64_t resourceUnits) {
         unitsUsed_,
         "Cannot release more units than have been acquired");
     unitsUsed_ -= resourceUnits;
-    while (!queue_.empty()) {
-      auto& request = queue_.front();
-      if (unitsUsed_ + request.unitsRequested > config_.maxLimit) {
-        break;
-      }
-      unitsUsed_ += request.unitsRequested;
-      request.promise.setValue();
-      queue_.pop_front();
+    updatedValue = admitQueuedLocked();
+  }
+  if (!config_.resourceUsageAvgMetric.empty()) {
+    RECORD_METRIC_VALUE(config_.resourceUsageAvgMetric, updatedValue);
+  }
+}
+
+void AdmissionController::admitQueued() {
+  uint64_t updatedValue = 0;
+  {
+    std::lock_guard<std::mutex> l(mu_);
+    if (queue_.empty()) {
+      return;
     }
-    updatedValue = unitsUsed_;
+    updatedValue = admitQueuedLocked();
   }
   if (!config_.resourceUsageAvgMetric.empty()) {
     RECORD_METRIC_VALUE(config_.resourceUsageAvgMetric, updatedValue);
   }
 }
+
+bool AdmissionController::fitsLocked(
+    uint64_t resourceUnits,
+    uint64_t admittedUnits) const {
+  if (unitsUsed_ + resourceUnits > config_.maxLimit) {
+    return false;
+  }
+  return unitsUsed_ == 0 || config_.freeUnits == nullptr ||
+      resourceUnits + admittedUnits <= config_.freeUnits();
+}
+
+uint64_t AdmissionController::admitQueuedLocked() {
+  uint64_t admittedUnits = 0;
+  while (!queue_.empty()) {
+    auto& request = queue_.front();
+    if (!fitsLocked(request.unitsRequested, admittedUnits)) {
+      break;
+    }
+    unitsUsed_ += request.unitsRequested;
+    admittedUnits += request.unitsRequested;
+    request.promise.setValue();
+    queue_.pop_front();
+  }
+  return unitsUsed_;
+}
 } // namespace facebook::velox::common
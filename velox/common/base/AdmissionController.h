@@ -16,6 +16,7 @@
 #pragma once
 
 #include <deque>
+#include <functional>
 #include <mutex>
 #include "velox/common/future/VeloxPromise.h"
 
@@ -33,6 +34,12 @@ class AdmissionController {
     /// The maximum number of resource units that can be used at any given time.
     /// Set to a default value of max unit64 to signify unlimited limit.
     uint64_t maxLimit{std::numeric_limits<uint64_t>::max()};
+    /// If set, returns the resource units that are free outside of the
+    /// accounting of this controller, e.g. the free memory of the node. A
+    /// request is then admitted only if it also fits into these. A request is
+    /// admitted regardless if no units are in use, so that requests cannot
+    /// wait for each other forever. Called under the lock of the controller.
+    std::function<uint64_t()> freeUnits;
     /// The metric name for resource usage. If not set, it will not be reported.
     /// Should be a registered as a average metric.
     std::string resourceUsageAvgMetric;
@@ -49,6 +56,10 @@ class AdmissionController {
   void accept(uint64_t resourceUnits);
   void release(uint64_t resourceUnits);
 
+  /// Admits the queued requests which fit. Only needed with Config::freeUnits,
+  /// after the free units grow without a release, e.g. after memory is freed.
+  void admitQueued();
+
   uint64_t currentResourceUsage() const {
     std::lock_guard<std::mutex> l(mu_);
     return unitsUsed_;
@@ -59,6 +70,15 @@ class AdmissionController {
     uint64_t unitsRequested;
     ContinuePromise promise;
   };
+
+  // Returns true if 'resourceUnits' fit into the limit and into the free units
+  // minus 'admittedUnits', which were admitted but may not be in use yet.
+  bool fitsLocked(uint64_t resourceUnits, uint64_t admittedUnits = 0) const;
+
+  // Admits the queued requests in order until one does not fit. Returns the
+  // units in use after this.
+  uint64_t admitQueuedLocked();
+
   Config config_;
   mutable std::mutex mu_;
   uint64_t unitsUsed_{0};
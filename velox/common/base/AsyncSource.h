@@ -83,6 +83,7 @@ class AsyncSource {
       exception_ = std::current_exception();
     }
     std::unique_ptr<ContinuePromise> promise;
+    std::vector<ContinuePromise> readyPromises;
     {
       std::lock_guard<std::mutex> l(mutex_);
       VELOX_CHECK_NULL(item_);
@@ -91,10 +92,28 @@ class AsyncSource {
       }
       making_ = false;
       promise.swap(promise_);
+      readyPromises.swap(readyPromises_);
     }
     if (promise != nullptr) {
       promise->setValue();
     }
+    for (auto& readyPromise : readyPromises) {
+      readyPromise.setValue();
+    }
+  }
+
+  /// Returns true if move() does not have to wait for the item to be made on
+  /// the executor. Otherwise sets 'future' to be realized when prepare() is
+  /// done and returns false. Lets the consumer do other work or give up its
+  /// thread instead of blocking in move().
+  bool readyOrFuture(ContinueFuture* future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!making_) {
+      return true;
+    }
+    readyPromises_.emplace_back("AsyncSource::readyOrFuture");
+    *future = readyPromises_.back().getSemiFuture();
+    return false;
   }
 
   // Returns the item to the first caller and nullptr to subsequent callers.
@@ -211,6 +230,8 @@ class AsyncSource {
   // True if 'prepare() is making the item.
   bool making_{false};
   std::unique_ptr<ContinuePromise> promise_;
+  // Promises of readyOrFuture() callers. Realized when prepare() is done.
+  std::vector<ContinuePromise> readyPromises_;
   std::unique_ptr<Item> item_;
   std::function<std::unique_ptr<Item>()> make_;
   std::exception_ptr exception_;
@@ -61,6 +61,22 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Same as mayContain() for the 'numWords' words of a filter at 'bits', e.g.
+  // the data() of a filter with another allocator.
+  static bool
+  mayContain(const uint64_t* bits, int32_t numWords, uint64_t value) {
+    return test(bits, numWords, value);
+  }
+
+  // Returns the words of the filter.
+  const uint64_t* data() const {
+    return bits_.data();
+  }
+
+  int32_t numWords() const {
+    return bits_.size();
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -82,17 +98,28 @@ class BloomFilter {
   }
 
   uint32_t serializedSize() const {
+    return serializedSize(bits_.size());
+  }
+
+  void serialize(char* output) const {
+    serialize(bits_.data(), bits_.size(), output);
+  }
+
+  // Same as serializedSize() and serialize() for the 'numWords' words of a
+  // filter at 'bits'.
+  static uint32_t serializedSize(int32_t numWords) {
     return 1 /* version */
         + 4 /* number of bits */
-        + bits_.size() * 8;
+        + numWords * 8;
   }
 
-  void serialize(char* output) const {
+  static void
+  serialize(const uint64_t* bits, int32_t numWords, char* output) {
     common::OutputByteStream stream(output);
     stream.appendOne(kBloomFilterV1);
-    stream.appendOne((int32_t)bits_.size());
-    for (auto bit : bits_) {
-      stream.appendOne(bit);
+    stream.appendOne(numWords);
+    for (auto i = 0; i < numWords; ++i) {
+      stream.appendOne(bits[i]);
     }
   }
 
@@ -127,7 +154,7 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
-  const int8_t kBloomFilterV1 = 1;
+  static constexpr int8_t kBloomFilterV1 = 1;
   std::vector<uint64_t, Allocator> bits_;
 };
 
@@ -239,6 +239,18 @@ void registerVeloxMetrics() {
   // Total number of errors while reading from SSD cache files.
   DEFINE_METRIC(kMetricSsdCacheReadSsdErrors, facebook::velox::StatType::SUM);
 
+  // The time distribution of SSD cache reads in range of [0, 100ms] with 100
+  // buckets. It is configured to report the latency at P50, P90, P99, and P100
+  // percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSsdCacheReadLatencyUs, 1'000, 0, 100'000, 50, 90, 99, 100);
+
+  // The time distribution of SSD cache writes in range of [0, 1s] with 100
+  // buckets. It is configured to report the latency at P50, P90, P99, and P100
+  // percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSsdCacheWriteLatencyUs, 10'000, 0, 1'000'000, 50, 90, 99, 100);
+
   // Total number of corrupted SSD data read detected by checksum.
   DEFINE_METRIC(kMetricSsdCacheReadCorruptions, facebook::velox::StatType::SUM);
 
@@ -434,6 +446,19 @@ void registerVeloxMetrics() {
       99,
       100);
 
+  // The time distribution of a local arbitration wait [0, 300s] with 20
+  // buckets. It is configured to report the latency at P50, P90, P99, and P100
+  // percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorLocalArbitrationWaitTimeMs,
+      15'000,
+      0,
+      300'000,
+      50,
+      90,
+      99,
+      100);
+
   // The distribution of the amount of time it takes to complete a single
   // arbitration operation in range of [0, 600s] with 20 buckets. It is
   // configured to report the latency at P50, P90, P99, and P100 percentiles.
@@ -593,5 +618,11 @@ void registerVeloxMetrics() {
   // The number of times that storage IOs get throttled in a storage cluster.
   DEFINE_METRIC(
       kMetricStorageGlobalThrottled, facebook::velox::StatType::COUNT);
+
+  // The time distribution of the wait of IO loads in IoScheduler queues in
+  // range of [0, 10s] with 100 buckets. It is configured to report the wait at
+  // P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricIoSchedulerQueueWaitMs, 100, 0, 10'000, 50, 90, 99, 100);
 }
 } // namespace facebook::velox
@@ -108,6 +108,9 @@ constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationWaitCount{
 constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationWaitTimeMs{
     "velox.arbitrator_global_arbitration_wait_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorLocalArbitrationWaitTimeMs{
+    "velox.arbitrator_local_arbitration_wait_time_ms"};
+
 constexpr folly::StringPiece kMetricArbitratorAbortedCount{
     "velox.arbitrator_aborted_count"};
 
@@ -310,6 +313,12 @@ constexpr folly::StringPiece kMetricSsdCacheReadCorruptions{
 constexpr folly::StringPiece kMetricSsdCacheReadSsdErrors{
     "velox.ssd_cache_read_ssd_errors"};
 
+constexpr folly::StringPiece kMetricSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
+
+constexpr folly::StringPiece kMetricSsdCacheWriteLatencyUs{
+    "velox.ssd_cache_write_latency_us"};
+
 constexpr folly::StringPiece kMetricSsdCacheReadCheckpointErrors{
     "velox.ssd_cache_read_checkpoint_errors"};
 
@@ -346,6 +355,10 @@ constexpr folly::StringPiece kMetricExchangeDataSizeTimeMs{
 constexpr folly::StringPiece kMetricExchangeDataSizeCount{
     "velox.exchange_data_size_count"};
 
+/// Prefix of the per storage backend read metrics reported by
+/// PeriodicStatsReporter, e.g. 'velox.storage_read_s3_demand_bytes'.
+constexpr folly::StringPiece kMetricStorageReadPrefix{"velox.storage_read"};
+
 constexpr folly::StringPiece kMetricStorageThrottledDurationMs{
     "velox.storage_throttled_duration_ms"};
 
@@ -354,4 +367,7 @@ constexpr folly::StringPiece kMetricStorageLocalThrottled{
 
 constexpr folly::StringPiece kMetricStorageGlobalThrottled{
     "velox.storage_global_throttled_count"};
+
+constexpr folly::StringPiece kMetricIoSchedulerQueueWaitMs{
+    "velox.io_scheduler_queue_wait_ms"};
 } // namespace facebook::velox
@@ -84,6 +84,12 @@ void PeriodicStatsReporter::start() {
       "report_spill_stats",
       [this]() { reportSpillStats(); },
       options_.spillStatsIntervalMs);
+  if (options_.reportStorageStats) {
+    addTask(
+        "report_storage_stats",
+        [this]() { reportStorageStats(); },
+        options_.storageStatsIntervalMs);
+  }
 }
 
 void PeriodicStatsReporter::stop() {
@@ -256,4 +262,53 @@ void PeriodicStatsReporter::reportSpillStats() {
   RECORD_METRIC_VALUE(kMetricSpillPeakMemoryBytes, spillMemoryStats.peakBytes);
 }
 
+void PeriodicStatsReporter::reportStorageStats() {
+  auto storageReadStats = io::IoStatistics::globalStorageReadStats();
+  for (const auto& [backend, stats] : storageReadStats) {
+    auto deltaStats = stats;
+    auto it = lastStorageReadStats_.find(backend);
+    if (it != lastStorageReadStats_.end()) {
+      deltaStats.subtract(it->second);
+    }
+    reportStorageReadCounters(
+        fmt::format("{}_{}_demand", kMetricStorageReadPrefix, backend),
+        deltaStats.demand);
+    reportStorageReadCounters(
+        fmt::format("{}_{}_prefetch", kMetricStorageReadPrefix, backend),
+        deltaStats.prefetch);
+  }
+  lastStorageReadStats_ = std::move(storageReadStats);
+}
+
+void PeriodicStatsReporter::reportStorageReadCounters(
+    const std::string& prefix,
+    const io::StorageReadCounters& counters) {
+  if (counters.count == 0) {
+    return;
+  }
+  RECORD_METRIC_VALUE(
+      storageMetric(prefix + "_count", StatType::SUM), counters.count);
+  RECORD_METRIC_VALUE(
+      storageMetric(prefix + "_bytes", StatType::SUM), counters.bytes);
+  RECORD_METRIC_VALUE(
+      storageMetric(prefix + "_latency_us", StatType::SUM),
+      counters.latencyUs);
+  RECORD_METRIC_VALUE(
+      storageMetric(prefix + "_p50_bytes", StatType::AVG),
+      counters.bytesHistogram.percentile(50));
+  RECORD_METRIC_VALUE(
+      storageMetric(prefix + "_p99_latency_us", StatType::AVG),
+      counters.latencyUsHistogram.percentile(99));
+}
+
+const char* PeriodicStatsReporter::storageMetric(
+    std::string name,
+    StatType statType) {
+  auto [it, inserted] = storageMetrics_.insert(std::move(name));
+  if (inserted) {
+    DEFINE_METRIC(it->c_str(), statType);
+  }
+  return it->c_str();
+}
+
 } // namespace facebook::velox
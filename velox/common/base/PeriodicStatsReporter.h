@@ -17,8 +17,10 @@
 #pragma once
 
 #include <folly/experimental/ThreadedRepeatingFunctionRunner.h>
+#include <unordered_set>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFile.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 
 namespace folly {
@@ -53,14 +55,22 @@ class PeriodicStatsReporter {
     const memory::MemoryPool* spillMemoryPool{nullptr};
     uint64_t spillStatsIntervalMs{60'000};
 
+    /// If true, reports the storage reads by backend from
+    /// io::IoStatistics::globalStorageReadStats().
+    bool reportStorageStats{false};
+    uint64_t storageStatsIntervalMs{60'000};
+
     std::string toString() const {
       return fmt::format(
           "allocatorStatsIntervalMs:{}, cacheStatsIntervalMs:{}, "
-          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}",
+          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}, "
+          "reportStorageStats:{}, storageStatsIntervalMs:{}",
           allocatorStatsIntervalMs,
           cacheStatsIntervalMs,
           arbitratorStatsIntervalMs,
-          spillStatsIntervalMs);
+          spillStatsIntervalMs,
+          reportStorageStats,
+          storageStatsIntervalMs);
     }
   };
 
@@ -95,6 +105,16 @@ class PeriodicStatsReporter {
   void reportAllocatorStats();
   void reportArbitratorStats();
   void reportSpillStats();
+  void reportStorageStats();
+
+  // Reports the reads in 'counters' as the metrics starting with 'prefix'.
+  void reportStorageReadCounters(
+      const std::string& prefix,
+      const io::StorageReadCounters& counters);
+
+  // Registers the metric 'name' on first use. Returns the registered name,
+  // which outlives the registration.
+  const char* storageMetric(std::string name, StatType statType);
 
   const velox::memory::MemoryAllocator* const allocator_{nullptr};
   const velox::cache::AsyncDataCache* const cache_{nullptr};
@@ -104,6 +124,10 @@ class PeriodicStatsReporter {
 
   cache::CacheStats lastCacheStats_;
 
+  std::unordered_map<std::string, io::StorageReadStats> lastStorageReadStats_;
+  // Names of the per-backend storage metrics registered so far.
+  std::unordered_set<std::string> storageMetrics_;
+
   folly::ThreadedRepeatingFunctionRunner scheduler_;
 };
 
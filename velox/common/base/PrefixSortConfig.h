@@ -24,8 +24,15 @@ namespace facebook::velox::common {
 struct PrefixSortConfig {
   PrefixSortConfig() = default;
 
-  PrefixSortConfig(int64_t _maxNormalizedKeySize, int32_t _threshold)
-      : maxNormalizedKeySize(_maxNormalizedKeySize), threshold(_threshold) {}
+  PrefixSortConfig(
+      int64_t _maxNormalizedKeySize,
+      int32_t _threshold,
+      int32_t _maxStringPrefixLength = 16,
+      int32_t _radixSortMinRows = 16'384)
+      : maxNormalizedKeySize(_maxNormalizedKeySize),
+        threshold(_threshold),
+        maxStringPrefixLength(_maxStringPrefixLength),
+        radixSortMinRows(_radixSortMinRows) {}
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry. Same with QueryConfig kPrefixSortNormalizedKeyMaxBytes.
@@ -33,5 +40,14 @@ struct PrefixSortConfig {
 
   /// PrefixSort will have performance regression when the dateset is too small.
   int32_t threshold{130};
+
+  /// Max number of leading bytes of a string sort key to store in the
+  /// prefix-sort buffer. Same with QueryConfig
+  /// kPrefixSortMaxStringPrefixLength.
+  int32_t maxStringPrefixLength{16};
+
+  /// Minimum number of rows to sort the normalized keys with radix-sort
+  /// instead of quick-sort. Same with QueryConfig kPrefixSortRadixSortMinRows.
+  int32_t radixSortMinRows{16'384};
 };
 } // namespace facebook::velox::common
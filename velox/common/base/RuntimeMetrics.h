@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <limits>
 #include <sstream>
 
@@ -66,6 +70,119 @@ struct RuntimeMetric {
   }
 };
 
+/// Counts of values in buckets which get wider with the magnitude of the
+/// values, as in HDR histograms. Values below kNumSubBuckets have a bucket
+/// each. Each larger range between powers of 2 is split into kNumSubBuckets
+/// buckets, so that a percentile is within 1 / kNumSubBuckets of the exact
+/// value. The counts are updated with relaxed atomic adds, so that threads can
+/// record into a shared histogram without locking and a merge is a sum of
+/// counts.
+class RuntimeHistogram {
+ public:
+  static constexpr int32_t kSubBucketBits = 3;
+  static constexpr int32_t kNumSubBuckets = 1 << kSubBucketBits;
+  static constexpr int32_t kNumBuckets =
+      (64 - kSubBucketBits + 1) * kNumSubBuckets;
+
+  RuntimeHistogram() = default;
+
+  RuntimeHistogram(const RuntimeHistogram& other) {
+    merge(other);
+  }
+
+  RuntimeHistogram& operator=(const RuntimeHistogram& other) {
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      counts_[i].store(
+          other.counts_[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  void addValue(uint64_t value) {
+    counts_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void merge(const RuntimeHistogram& other) {
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      const auto count = other.counts_[i].load(std::memory_order_relaxed);
+      if (count != 0) {
+        counts_[i].fetch_add(count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Removes the values of 'other', which must have been added to this, e.g.
+  /// to get the values added since 'other' was copied from this.
+  void subtract(const RuntimeHistogram& other) {
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      const auto count = other.counts_[i].load(std::memory_order_relaxed);
+      if (count != 0) {
+        counts_[i].fetch_sub(count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  uint64_t count() const {
+    uint64_t total = 0;
+    for (const auto& count : counts_) {
+      total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /// Returns the largest value of the bucket holding the value at
+  /// 'percentile', which is between 0 and 100. Returns 0 if there are no
+  /// values.
+  uint64_t percentile(double percentile) const {
+    const auto total = count();
+    if (total == 0) {
+      return 0;
+    }
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100 * total)));
+    uint64_t numValues = 0;
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      numValues += counts_[i].load(std::memory_order_relaxed);
+      if (numValues >= rank) {
+        return bucketMaxValue(i);
+      }
+    }
+    return bucketMaxValue(kNumBuckets - 1);
+  }
+
+  std::string toString() const {
+    return fmt::format(
+        "count:{}, p50:{}, p90:{}, p99:{}, p100:{}",
+        count(),
+        percentile(50),
+        percentile(90),
+        percentile(99),
+        percentile(100));
+  }
+
+  static int32_t bucketIndex(uint64_t value) {
+    if (value < kNumSubBuckets) {
+      return value;
+    }
+    // The bits below the highest 1 bit and the kSubBucketBits after it.
+    const auto shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return (shift + 1) * kNumSubBuckets + (value >> shift) - kNumSubBuckets;
+  }
+
+  static uint64_t bucketMaxValue(int32_t index) {
+    if (index < kNumSubBuckets) {
+      return index;
+    }
+    const auto shift = index / kNumSubBuckets - 1;
+    const uint64_t subBucket = kNumSubBuckets + index % kNumSubBuckets;
+    return (subBucket << shift) + ((uint64_t{1} << shift) - 1);
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> counts_{};
+};
+
 /// Simple interface to implement writing of runtime stats to Velox Operator
 /// stats.
 /// Inherit a concrete class from this to implement your writing.
@@ -35,6 +35,10 @@ class SelectivityInfo {
     return timeClocks_ / static_cast<float>(numIn_ - numOut_);
   }
 
+  float timePerValue() const {
+    return numIn_ == 0 ? 0 : timeClocks_ / static_cast<float>(numIn_);
+  }
+
   bool operator<(const SelectivityInfo& right) const {
     return timeToDropValue() < right.timeToDropValue();
   }
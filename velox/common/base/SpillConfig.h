@@ -43,6 +43,24 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Specifies the remote tier for spilling. New spill files are written to the
+/// remote spill directory once 'useRemoteCb' returns true, for example when
+/// the query has used up its local spill quota.
+struct RemoteSpillConfig {
+  /// Returns the remote spill directory path.
+  GetSpillDirectoryPathCB getSpillDirPathCb;
+
+  /// Returns true if new spill files go to the remote spill directory.
+  std::function<bool()> useRemoteCb;
+
+  /// The size to buffer the serialized spill data before write to a remote
+  /// spill file.
+  uint64_t writeBufferSize;
+
+  /// The buffer size to read from one remote spill file.
+  uint64_t readBufferSize;
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -63,7 +81,8 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _asyncWriteEnabled = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -75,6 +94,18 @@ struct SpillConfig {
   /// Checks if the given 'startBitOffset' has exceeded the max spill limit.
   bool exceedSpillLevelLimit(uint8_t startBitOffset) const;
 
+  /// Returns the executor to run the spill file writes on, nullptr if the
+  /// writes run on the spilling thread.
+  folly::Executor* writeExecutor() const {
+    return asyncWriteEnabled ? executor : nullptr;
+  }
+
+  /// Returns the executor to read ahead the spill files of merged runs on,
+  /// nullptr if there is no read-ahead.
+  folly::Executor* readAheadExecutor() const {
+    return readAheadEnabled ? executor : nullptr;
+  }
+
   /// A callback function that returns the spill directory path. Implementations
   /// can use it to ensure the path exists before returning.
   GetSpillDirectoryPathCB getSpillDirPathCb;
@@ -143,5 +174,19 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, the spill file writes run on 'executor' if set.
+  bool asyncWriteEnabled{false};
+
+  /// If set, spilling falls back to a remote spill directory.
+  std::optional<RemoteSpillConfig> remoteSpillConfig;
+
+  /// If true, spill files are written in the columnar spill format which
+  /// allows reading back a subset of the columns.
+  bool columnarFormat{false};
+
+  /// If true, the spill files of merged runs are read ahead on 'executor' if
+  /// set.
+  bool readAheadEnabled{false};
 };
 } // namespace facebook::velox::common
@@ -87,6 +87,7 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillWrites += other.spillWrites;
   spillFlushTimeNanos += other.spillFlushTimeNanos;
   spillWriteTimeNanos += other.spillWriteTimeNanos;
+  spillWriteStallTimeNanos += other.spillWriteStallTimeNanos;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
   spillReadBytes += other.spillReadBytes;
   spillReads += other.spillReads;
@@ -114,6 +115,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWrites = spillWrites - other.spillWrites;
   result.spillFlushTimeNanos = spillFlushTimeNanos - other.spillFlushTimeNanos;
   result.spillWriteTimeNanos = spillWriteTimeNanos - other.spillWriteTimeNanos;
+  result.spillWriteStallTimeNanos =
+      spillWriteStallTimeNanos - other.spillWriteStallTimeNanos;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
   result.spillReadBytes = spillReadBytes - other.spillReadBytes;
@@ -149,6 +152,7 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillWrites);
   UPDATE_COUNTER(spillFlushTimeNanos);
   UPDATE_COUNTER(spillWriteTimeNanos);
+  UPDATE_COUNTER(spillWriteStallTimeNanos);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
   UPDATE_COUNTER(spillReadBytes);
   UPDATE_COUNTER(spillReads);
@@ -190,6 +194,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillWrites,
              spillFlushTimeNanos,
              spillWriteTimeNanos,
+             spillWriteStallTimeNanos,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -209,6 +214,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillWrites,
              other.spillFlushTimeNanos,
              other.spillWriteTimeNanos,
+             other.spillWriteStallTimeNanos,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -230,6 +236,7 @@ void SpillStats::reset() {
   spillWrites = 0;
   spillFlushTimeNanos = 0;
   spillWriteTimeNanos = 0;
+  spillWriteStallTimeNanos = 0;
   spillMaxLevelExceededCount = 0;
   spillReadBytes = 0;
   spillReads = 0;
@@ -242,7 +249,8 @@ std::string SpillStats::toString() const {
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
       "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
-      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[{}] "
+      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] spillWriteStallTimeNanos[{}] "
+      "maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
       "spillReadDeserializationTimeNanos[{}]",
       spillRuns,
@@ -258,6 +266,7 @@ std::string SpillStats::toString() const {
       spillWrites,
       succinctNanos(spillFlushTimeNanos),
       succinctNanos(spillWriteTimeNanos),
+      succinctNanos(spillWriteStallTimeNanos),
       spillMaxLevelExceededCount,
       succinctBytes(spillReadBytes),
       spillReads,
@@ -318,6 +327,10 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeNanos += writeTimeNs;
 }
 
+void updateGlobalSpillWriteStallTime(uint64_t timeNs) {
+  localSpillStats().wlock()->spillWriteStallTimeNanos += timeNs;
+}
+
 void updateGlobalSpillReadStats(
     uint64_t spillReads,
     uint64_t spillReadBytes,
@@ -56,6 +56,9 @@ struct SpillStats {
   uint64_t spillFlushTimeNanos{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeNanos{0};
+  /// The time the spilling thread waited for asynchronous disk writes to
+  /// finish, either to free write buffer space or to close a spill file.
+  uint64_t spillWriteStallTimeNanos{0};
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
@@ -147,6 +150,9 @@ void updateGlobalSpillWriteStats(
     uint64_t flushTimeNs,
     uint64_t writeTimeNs);
 
+/// Updates the time spent waiting for asynchronous spill disk writes.
+void updateGlobalSpillWriteStallTime(uint64_t timeNs);
+
 /// Updates the stats for disk read including the number of disk reads, the
 /// amount of data read in bytes, and the time it takes to read from the disk.
 void updateGlobalSpillReadStats(
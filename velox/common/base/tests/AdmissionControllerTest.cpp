@@ -17,6 +17,7 @@
 #include "velox/common/base/AdmissionController.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <thread>
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 
@@ -47,6 +48,45 @@ TEST(AdmissionController, basic) {
       "A single request cannot exceed the max limit");
 }
 
+TEST(AdmissionController, freeUnits) {
+  std::atomic_uint64_t freeUnits{50};
+  AdmissionController::Config config;
+  config.maxLimit = 1'000;
+  config.freeUnits = [&]() -> uint64_t { return freeUnits; };
+  AdmissionController admissionController(config);
+
+  // Nothing in use, admitted regardless of the free units.
+  admissionController.accept(100);
+  admissionController.accept(40);
+  EXPECT_EQ(admissionController.currentResourceUsage(), 140);
+
+  std::atomic_int32_t numAccepted{0};
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 2; ++i) {
+    threads.emplace_back([&]() {
+      admissionController.accept(60);
+      ++numAccepted;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(numAccepted, 0);
+
+  // Only one of the queued requests fits into the free units.
+  freeUnits = 100;
+  admissionController.admitQueued();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(numAccepted, 1);
+  EXPECT_EQ(admissionController.currentResourceUsage(), 200);
+
+  freeUnits = 1'000;
+  admissionController.release(40);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(numAccepted, 2);
+  EXPECT_EQ(admissionController.currentResourceUsage(), 220);
+}
+
 TEST(AdmissionController, multiThreaded) {
   // Ensure that resource usage never exceeds the limit set in the admission
   // controller.
@@ -244,6 +244,36 @@ TEST(AsyncSourceTest, close) {
   thread1.join();
 }
 
+TEST(AsyncSourceTest, readyOrFuture) {
+  // Not prepared yet. move() makes the item on the caller thread.
+  AsyncSource<Gizmo> notStarted([]() { return std::make_unique<Gizmo>(1); });
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  EXPECT_TRUE(notStarted.readyOrFuture(&future));
+  EXPECT_FALSE(future.valid());
+  EXPECT_EQ(1, notStarted.move()->id);
+
+  // Being prepared on another thread. The future is realized when the item is
+  // made.
+  folly::Baton<> started;
+  folly::Baton<> release;
+  AsyncSource<Gizmo> preparing([&]() {
+    started.post();
+    release.wait();
+    return std::make_unique<Gizmo>(2);
+  });
+  std::thread thread([&]() { preparing.prepare(); });
+  EXPECT_TRUE(started.try_wait_for(1s));
+  EXPECT_FALSE(preparing.readyOrFuture(&future));
+  ASSERT_TRUE(future.valid());
+  EXPECT_FALSE(future.isReady());
+  release.post();
+  std::move(future).wait();
+  EXPECT_TRUE(preparing.hasValue());
+  EXPECT_TRUE(preparing.readyOrFuture(&future));
+  EXPECT_EQ(2, preparing.move()->id);
+  thread.join();
+}
+
 void verifyContexts(
     const std::string& expectedPoolName,
     const std::string& expectedTaskId) {
@@ -17,6 +17,8 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include <gtest/gtest.h>
 
+#include <thread>
+
 namespace facebook::velox {
 
 class RuntimeMetricsTest : public testing::Test {
@@ -73,4 +75,50 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogram) {
+  for (auto i = 0; i < RuntimeHistogram::kNumBuckets; ++i) {
+    const auto maxValue = RuntimeHistogram::bucketMaxValue(i);
+    EXPECT_EQ(RuntimeHistogram::bucketIndex(maxValue), i);
+    if (i + 1 < RuntimeHistogram::kNumBuckets) {
+      EXPECT_EQ(RuntimeHistogram::bucketIndex(maxValue + 1), i + 1);
+    }
+  }
+  EXPECT_EQ(
+      RuntimeHistogram::bucketIndex(std::numeric_limits<uint64_t>::max()),
+      RuntimeHistogram::kNumBuckets - 1);
+
+  RuntimeHistogram histogram;
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.percentile(99), 0);
+
+  // Threads add to the same histogram.
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto value = i + 1; value <= 1'000; value += 4) {
+        histogram.addValue(value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.count(), 1'000);
+  EXPECT_EQ(histogram.percentile(0), 1);
+  // 500 is in [480, 511] and 990 in [960, 1023].
+  EXPECT_EQ(histogram.percentile(50), 511);
+  EXPECT_EQ(histogram.percentile(99), 1023);
+  EXPECT_EQ(histogram.percentile(100), 1023);
+  EXPECT_EQ(
+      histogram.toString(),
+      "count:1000, p50:511, p90:959, p99:1023, p100:1023");
+
+  RuntimeHistogram other;
+  other.addValue(1'000'000);
+  histogram.merge(other);
+  EXPECT_EQ(histogram.count(), 1'001);
+  EXPECT_EQ(histogram.percentile(100), 1'048'575);
+  EXPECT_EQ(histogram.percentile(50), 511);
+}
+
 } // namespace facebook::velox
@@ -129,7 +129,7 @@ TEST(SpillStatsTest, spillStats) {
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] spillFlushTimeNanos[1.03us] "
-      "spillWriteTimeNanos[1.03us] maxSpillExceededLimitCount[4] "
+      "spillWriteTimeNanos[1.03us] spillWriteStallTimeNanos[0ns] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
   ASSERT_EQ(
@@ -138,7 +138,7 @@ TEST(SpillStatsTest, spillStats) {
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] "
-      "spillFlushTimeNanos[1.03us] spillWriteTimeNanos[1.03us] "
+      "spillFlushTimeNanos[1.03us] spillWriteTimeNanos[1.03us] spillWriteStallTimeNanos[0ns] "
       "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
@@ -16,9 +16,13 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
 
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/StatsReporter.h"
@@ -45,6 +49,7 @@ AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
 
 AsyncDataCacheEntry::~AsyncDataCacheEntry() {
   shard_->cache()->allocator()->freeNonContiguous(data_);
+  shard_->cache()->allocator()->freeNonContiguous(compressedData_);
 }
 
 void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
@@ -76,7 +81,8 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
 
   auto* ssdCache = shard_->cache()->ssdCache();
   if ((ssdCache != nullptr) && (ssdFile_ == nullptr)) {
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_) &&
+        ssdCache->admit(std::hash<FileCacheKey>()(key_), size_)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -115,6 +121,7 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
   key_ = std::move(key);
+  incompressible_ = false;
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
   if (size_ < AsyncDataCacheEntry::kTinyDataSize) {
@@ -137,6 +144,96 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   }
 }
 
+namespace {
+// Returns a chain of IOBufs over the first 'size' bytes of 'allocation'.
+std::unique_ptr<folly::IOBuf> wrapAllocation(
+    const memory::Allocation& allocation,
+    uint64_t size) {
+  std::unique_ptr<folly::IOBuf> result;
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < size; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto bytes = std::min<uint64_t>(run.numBytes(), size - offset);
+    auto buffer = folly::IOBuf::wrapBuffer(run.data(), bytes);
+    if (result == nullptr) {
+      result = std::move(buffer);
+    } else {
+      result->appendToChain(std::move(buffer));
+    }
+    offset += bytes;
+  }
+  return result;
+}
+
+// Copies the first 'size' bytes of 'data' into 'allocation'.
+void copyToAllocation(
+    const folly::IOBuf& data,
+    uint64_t size,
+    memory::Allocation& allocation) {
+  folly::io::Cursor cursor(&data);
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < size; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto bytes = std::min<uint64_t>(run.numBytes(), size - offset);
+    cursor.pull(run.data(), bytes);
+    offset += bytes;
+  }
+}
+} // namespace
+
+void AsyncDataCacheEntry::compress(
+    folly::io::Codec& codec,
+    double maxCompressedRatio) {
+  VELOX_CHECK(isExclusive());
+  VELOX_CHECK(!data_.empty());
+  const auto compressed = codec.compress(wrapAllocation(data_, size_).get());
+  const auto compressedSize = compressed->computeChainDataLength();
+  if (compressedSize > size_ * maxCompressedRatio) {
+    incompressible_ = true;
+    return;
+  }
+  auto* cache = shard_->cache();
+  ClockTimer t(shard_->allocClocks());
+  // 'data_' is freed first so that the compressed data usually fits without
+  // making space in the cache.
+  cache->incrementCachedPages(-data_.numPages());
+  cache->allocator()->freeNonContiguous(data_);
+  const auto sizePages = memory::AllocationTraits::numPages(compressedSize);
+  if (!cache->allocator()->allocateNonContiguous(sizePages, compressedData_)) {
+    VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+        << "Failed to allocate " << sizePages << " pages for compressing "
+        << toString() << ": "
+        << cache->allocator()->getAndClearFailureMessage();
+    return;
+  }
+  cache->incrementCachedPages(compressedData_.numPages());
+  copyToAllocation(*compressed, compressedSize, compressedData_);
+  compressedSize_ = compressedSize;
+}
+
+void AsyncDataCacheEntry::decompress(folly::io::Codec& codec) {
+  VELOX_CHECK(isExclusive());
+  VELOX_CHECK(isCompressed());
+  VELOX_CHECK(data_.empty());
+  const auto uncompressed = codec.uncompress(
+      wrapAllocation(compressedData_, compressedSize_).get(), size_);
+  VELOX_CHECK_EQ(uncompressed->computeChainDataLength(), size_);
+  auto* cache = shard_->cache();
+  ClockTimer t(shard_->allocClocks());
+  const auto sizePages = memory::AllocationTraits::numPages(size_);
+  if (!cache->allocator()->allocateNonContiguous(sizePages, data_)) {
+    VELOX_CACHE_ERROR(fmt::format(
+        "Failed to allocate {} pages for decompressing cache entry: {}",
+        sizePages,
+        cache->allocator()->getAndClearFailureMessage()));
+  }
+  cache->incrementCachedPages(data_.numPages());
+  copyToAllocation(*uncompressed, size_, data_);
+  cache->incrementCachedPages(-compressedData_.numPages());
+  cache->allocator()->freeNonContiguous(compressedData_);
+  compressedSize_ = 0;
+}
+
 void AsyncDataCacheEntry::makeEvictable() {
   accessStats_.lastUse = 0;
   accessStats_.numUses = 0;
@@ -168,7 +265,7 @@ CachePin CacheShard::findOrCreate(
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -191,6 +288,14 @@ CachePin CacheShard::findOrCreate(
           ++numHit_;
           hitBytes_ += foundEntry->size();
         }
+        if (foundEntry->isCompressed()) {
+          // Decompressed outside of 'mutex_'. Other readers wait for it as
+          // for a load.
+          foundEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
+          ++numDecompressions_;
+          l.unlock();
+          return decompressEntry(foundEntry);
+        }
         ++foundEntry->numPins_;
         CachePin pin;
         pin.setEntry(foundEntry);
@@ -253,6 +358,21 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+CachePin CacheShard::find(RawFileCacheKey key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end() || it->second->isExclusive() ||
+      it->second->isCompressed()) {
+    return CachePin();
+  }
+  auto* entry = it->second;
+  entry->touch();
+  ++entry->numPins_;
+  CachePin pin;
+  pin.setEntry(entry);
+  return pin;
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -269,6 +389,62 @@ CachePin CacheShard::initEntry(
   return pin;
 }
 
+CachePin CacheShard::decompressEntry(AsyncDataCacheEntry* entry) {
+  // 'entry' is exclusive as in initEntry(). If decompression fails, releasing
+  // 'pin' removes the entry.
+  CachePin pin;
+  pin.setEntry(entry);
+  auto codec =
+      common::compressionKindToCodec(cache_->options().compressionKind);
+  entry->decompress(*codec);
+  entry->setExclusiveToShared(/*ssdSavable=*/false);
+  return pin;
+}
+
+uint64_t CacheShard::compressEntries(
+    const std::vector<AsyncDataCacheEntry*>& entries) {
+  const auto& options = cache_->options();
+  auto codec = common::compressionKindToCodec(options.compressionKind);
+  uint64_t freedBytes{0};
+  for (auto* entry : entries) {
+    const auto dataBytes = entry->data_.byteSize();
+    try {
+      entry->compress(*codec, options.maxCompressedRatio);
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+          << "Failed to compress " << entry->toString() << ": " << e.what();
+      entry->incompressible_ = true;
+    }
+    if (entry->data_.empty()) {
+      freedBytes += dataBytes - entry->compressedData_.byteSize();
+    }
+  }
+
+  std::vector<std::unique_ptr<folly::SharedPromise<bool>>> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto* entry : entries) {
+      entry->numPins_ = 0;
+      if (entry->isCompressed()) {
+        ++numCompressions_;
+      } else if (entry->data_.empty()) {
+        // The data was freed but there was no memory for the compressed
+        // copy. The entry's slot is reused by a later eviction.
+        removeEntryLocked(entry);
+      }
+      auto promise = entry->movePromise();
+      if (promise != nullptr) {
+        promises.push_back(std::move(promise));
+      }
+    }
+  }
+  // Realize the promises outside of the shard mutex.
+  for (auto& promise : promises) {
+    promise->setValue(true);
+  }
+  return freedBytes;
+}
+
 CoalescedLoad::~CoalescedLoad() {
   // Continue possibly waiting threads.
   setEndState(State::kCancelled);
@@ -360,6 +536,12 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
     cache_->incrementCachedPages(-numPages);
     cache_->allocator()->freeNonContiguous(entry->data());
   }
+  const auto compressedPages = entry->compressedData_.numPages();
+  if (compressedPages > 0) {
+    cache_->incrementCachedPages(-compressedPages);
+    cache_->allocator()->freeNonContiguous(entry->compressedData_);
+  }
+  entry->compressedSize_ = 0;
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
   entry->size_ = 0;
@@ -377,7 +559,14 @@ uint64_t CacheShard::evict(
   std::vector<memory::Allocation> toFree;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
+  int64_t compressedEvicted = 0;
   int32_t evictSaveableSkipped = 0;
+  // Cold entries to compress instead of evicting. Set to exclusive mode and
+  // compressed outside of 'mutex_'.
+  const bool compressionEnabled =
+      cache_->options().compressionKind != common::CompressionKind_NONE;
+  std::vector<AsyncDataCacheEntry*> toCompress;
+  int64_t compressBytes = 0;
   {
     std::lock_guard<std::mutex> l(mutex_);
     const size_t size = entries_.size();
@@ -421,6 +610,20 @@ uint64_t CacheShard::evict(
           ++evictSaveableSkipped;
           continue;
         }
+        if (compressionEnabled && !evictAllUnpinned &&
+            candidate->key_.fileNum.hasValue() && !candidate->data_.empty() &&
+            !candidate->isCompressed() && !candidate->incompressible_ &&
+            !candidate->ssdSaveable() &&
+            candidate->accessStats_.numUses >=
+                cache_->options().minCompressUses) {
+          candidate->numPins_ = AsyncDataCacheEntry::kExclusive;
+          toCompress.push_back(candidate);
+          compressBytes += candidate->data_.byteSize();
+          if (largeEvicted + tinyEvicted + compressBytes > bytesToFree) {
+            break;
+          }
+          continue;
+        }
         if (candidate->ssdSaveable()) {
           ++numSavableEvict_;
         }
@@ -436,6 +639,9 @@ uint64_t CacheShard::evict(
           toFree.push_back(std::move(candidate->data()));
         }
         tinyEvicted += candidate->tinyData_.size();
+        compressedEvicted += candidate->compressedData_.byteSize();
+        toFree.push_back(std::move(candidate->compressedData_));
+        candidate->compressedSize_ = 0;
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
         candidate->size_ = 0;
@@ -447,17 +653,19 @@ uint64_t CacheShard::evict(
         if (score > 0) {
           sumEvictScore_ += score;
         }
-        if (largeEvicted + tinyEvicted > bytesToFree) {
+        if (largeEvicted + tinyEvicted + compressBytes > bytesToFree) {
           break;
         }
       }
     }
   }
 
+  const auto compressedFreed =
+      toCompress.empty() ? 0 : compressEntries(toCompress);
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
-  cache_->incrementCachedPages(
-      -memory::AllocationTraits::numPages(largeEvicted));
+  cache_->incrementCachedPages(-memory::AllocationTraits::numPages(
+      largeEvicted + compressedEvicted));
   if (evictSaveableSkipped) {
     VELOX_CHECK_NOT_NULL(ssdCache);
     if (ssdCache->startWrite()) {
@@ -471,7 +679,7 @@ uint64_t CacheShard::evict(
     }
   }
 
-  return largeEvicted + tinyEvicted;
+  return largeEvicted + tinyEvicted + compressedEvicted + compressedFreed;
 }
 
 void CacheShard::tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry) {
@@ -532,6 +740,11 @@ void CacheShard::updateStats(CacheStats& stats) {
       stats.prefetchBytes += entry->size();
     }
     ++stats.numEntries;
+    if (entry->isCompressed()) {
+      ++stats.numCompressed;
+      stats.compressedSize += entry->compressedSize_;
+      continue;
+    }
     stats.tinySize += entry->tinyData_.size();
     stats.tinyPadding += entry->tinyData_.capacity() - entry->tinyData_.size();
     if (entry->tinyData_.empty()) {
@@ -549,6 +762,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numCompressions += numCompressions_;
+  stats.numDecompressions += numDecompressions_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -639,6 +854,8 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numCompressions = numCompressions - other.numCompressions;
+  result.numDecompressions = numDecompressions - other.numDecompressions;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -698,6 +915,7 @@ AsyncDataCache** AsyncDataCache::getInstancePtr() {
 }
 
 void AsyncDataCache::shutdown() {
+  shutdown_ = true;
   if (ssdCache_) {
     ssdCache_->shutdown();
   }
@@ -715,7 +933,11 @@ CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  const auto hash = std::hash<RawFileCacheKey>()(key);
+  if (ssdCache_ != nullptr) {
+    ssdCache_->recordReference(hash);
+  }
+  const int shard = hash & (kShardMask);
   return shards_[shard]->findOrCreate(key, size, wait);
 }
 
@@ -729,6 +951,15 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+CachePin AsyncDataCache::find(RawFileCacheKey key) {
+  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  return shards_[shard]->find(key);
+}
+
+void AsyncDataCache::setPeerCache(std::unique_ptr<PeerCache> peerCache) {
+  peerCache_ = std::move(peerCache);
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool(memory::Allocation& allocation)> allocate) {
@@ -959,6 +1190,69 @@ CacheStats AsyncDataCache::refreshStats() const {
   return stats;
 }
 
+uint64_t AsyncDataCache::warmUpFromSsd(const WarmUpOptions& options) {
+  if (ssdCache_ == nullptr) {
+    return 0;
+  }
+  const auto startTime = std::chrono::steady_clock::now();
+  const MachinePageCount maxPages = options.maxMemoryRatio *
+      (allocator_->capacity() / memory::AllocationTraits::kPageSize);
+  uint64_t loadedBytes{0};
+  int32_t numLoaded{0};
+  for (auto& [key, run] : ssdCache_->hotEntries(options.maxBytes)) {
+    if (shutdown_) {
+      break;
+    }
+    if (allocator_->numAllocated() +
+            memory::AllocationTraits::numPages(run.size()) >
+        maxPages) {
+      break;
+    }
+    const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+    auto pin = findOrCreate(rawKey, run.size());
+    if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+      // Being loaded by another thread or already in memory.
+      continue;
+    }
+    auto& file = ssdCache_->file(rawKey.fileNum);
+    auto ssdPin = file.find(rawKey);
+    if (ssdPin.empty()) {
+      // Evicted from SSD. Releasing the exclusive 'pin' drops the entry.
+      continue;
+    }
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(std::move(ssdPin));
+    std::vector<CachePin> pins;
+    pins.push_back(std::move(pin));
+    try {
+      file.load(ssdPins, pins);
+    } catch (const std::exception& e) {
+      VELOX_SSD_CACHE_LOG(WARNING)
+          << "Failed to load " << pins[0].checkedEntry()->toString()
+          << " for warm up: " << e.what();
+      continue;
+    }
+    pins[0].checkedEntry()->setExclusiveToShared();
+    loadedBytes += run.size();
+    ++numLoaded;
+
+    if (options.maxBytesPerSec > 0) {
+      const auto targetUs = loadedBytes * 1'000'000 / options.maxBytesPerSec;
+      const uint64_t elapsedUs =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - startTime)
+              .count();
+      if (targetUs > elapsedUs) {
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(targetUs - elapsedUs)); // NOLINT
+      }
+    }
+  }
+  VELOX_CACHE_LOG(INFO) << "Warmed up " << numLoaded << " entries, "
+                        << succinctBytes(loadedBytes) << " from SSD";
+  return loadedBytes;
+}
+
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     memory::Allocation unused;
@@ -1024,6 +1318,12 @@ std::string CacheStats::toString() const {
       << "\n"
       // Cache timing stats.
       << "Alloc Megaclocks " << (allocClocks >> 20);
+  if (numCompressed > 0 || numCompressions > 0) {
+    out << "\nCompressed entries: " << numCompressed
+        << " size: " << succinctBytes(compressedSize)
+        << " compressions: " << numCompressions
+        << " decompressions: " << numDecompressions;
+  }
   return out.str();
 }
 
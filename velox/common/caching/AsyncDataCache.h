@@ -31,6 +31,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -44,6 +45,7 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class PeerCache;
 class SsdCache;
 struct SsdCacheStats;
 class SsdFile;
@@ -187,6 +189,17 @@ class AsyncDataCacheEntry {
     return size_;
   }
 
+  /// True if the data of 'this' is held compressed in memory. A compressed
+  /// entry is decompressed by the next findOrCreate() for it.
+  bool isCompressed() const {
+    return compressedSize_ > 0;
+  }
+
+  /// Returns the compressed size, 0 if not compressed.
+  uint64_t compressedSize() const {
+    return compressedSize_;
+  }
+
   void touch() {
     accessStats_.touch();
   }
@@ -278,6 +291,18 @@ class AsyncDataCacheEntry {
   void release();
   void addReference();
 
+  // Compresses 'data_' with 'codec', frees 'data_' and copies the result into
+  // 'compressedData_', which is allocated from the cache's allocator. Sets
+  // 'incompressible_' and leaves 'this' unchanged if the data does not
+  // compress to at most 'maxCompressedRatio' of 'size_'. If the allocation
+  // fails, 'this' is left without data and the caller removes it. Must be
+  // held exclusively.
+  void compress(folly::io::Codec& codec, double maxCompressedRatio);
+
+  // Allocates 'data_' and decompresses 'compressedData_' into it with 'codec'.
+  // Must be held exclusively.
+  void decompress(folly::io::Codec& codec);
+
   // Returns a future that will be realized when a caller can retry getting
   // 'this'. Must be called inside the mutex of 'shard_'.
   folly::SemiFuture<bool> getFuture() {
@@ -299,6 +324,18 @@ class AsyncDataCacheEntry {
   // page (kTinyDataSize).
   std::string tinyData_;
 
+  // The compressed data of a cold entry. 'data_' is empty when this is set.
+  // Allocated from the cache's allocator and counted in its cached pages like
+  // 'data_'.
+  memory::Allocation compressedData_;
+
+  // Number of bytes of 'compressedData_' in use, 0 if not compressed.
+  uint64_t compressedSize_{0};
+
+  // True if compression was tried and did not reduce the size enough. Such an
+  // entry is evicted instead of being retried.
+  bool incompressible_{false};
+
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
@@ -511,6 +548,10 @@ struct CacheStats {
   /// Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
+  /// Number of entries held compressed.
+  int32_t numCompressed{0};
+  /// Total compressed size of the entries held compressed.
+  int64_t compressedSize{0};
 
   /// ============= Cumulative stats =============
 
@@ -542,6 +583,10 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of eviction candidates compressed instead of evicted.
+  int64_t numCompressions{0};
+  /// Number of compressed entries decompressed on access.
+  int64_t numDecompressions{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
@@ -572,6 +617,9 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// See AsyncDataCache::find.
+  CachePin find(RawFileCacheKey key);
+
   AsyncDataCache* cache() const {
     return cache_;
   }
@@ -645,6 +693,14 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Decompresses the compressed 'entry' which the caller has set to exclusive
+  // mode inside 'mutex_'. Returns a shared pin on 'entry'.
+  CachePin decompressEntry(AsyncDataCacheEntry* entry);
+
+  // Compresses the exclusive 'entries' selected by evict() and returns them to
+  // the unpinned state. Returns the number of freed bytes.
+  uint64_t compressEntries(const std::vector<AsyncDataCacheEntry*>& entries);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
@@ -690,6 +746,10 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of entries compressed instead of evicted.
+  uint64_t numCompressions_{0};
+  // Cumulative count of compressed entries decompressed on access.
+  uint64_t numDecompressions_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -723,6 +783,38 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// The codec for keeping cold entries compressed in memory. If not
+    /// CompressionKind_NONE, an eviction candidate that has been used at least
+    /// 'minCompressUses' times is compressed instead of evicted and is
+    /// decompressed when next pinned. A compressed entry that again becomes an
+    /// eviction candidate is evicted. This trades CPU for holding more
+    /// distinct regions when the cached data is not already compressed.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
+    /// Min number of uses for an eviction candidate to be compressed instead
+    /// of evicted. Entries used fewer times, e.g. by a one time scan, are
+    /// evicted.
+    int32_t minCompressUses{2};
+
+    /// An entry is kept compressed only if it compresses to at most this
+    /// fraction of its size.
+    double maxCompressedRatio{0.8};
+  };
+
+  /// Options for warmUpFromSsd().
+  struct WarmUpOptions {
+    /// Max bytes to load into memory.
+    uint64_t maxBytes{std::numeric_limits<uint64_t>::max()};
+
+    /// Max load rate in bytes per second. 0 means no limit. Limits the SSD
+    /// bandwidth taken from live queries.
+    uint64_t maxBytesPerSec{100 << 20};
+
+    /// Stops loading when the used memory of the allocator would exceed this
+    /// fraction of its capacity, so that the warm up does not evict cache
+    /// entries or take memory from queries.
+    double maxMemoryRatio{0.5};
   };
 
   AsyncDataCache(
@@ -788,6 +880,11 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns a shared pin on the loaded entry for 'key', or an empty pin if
+  /// there is no such entry or it is still being loaded. Unlike
+  /// findOrCreate(), never creates an entry. Used to serve peer cache reads.
+  CachePin find(RawFileCacheKey key);
+
   /// Returns snapshot of the aggregated stats from all shards and the stats of
   /// SSD cache if used.
   virtual CacheStats refreshStats() const;
@@ -810,6 +907,14 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Sets the optional peer cache tier which is consulted on a miss in memory
+  /// and SSD before reading from storage.
+  void setPeerCache(std::unique_ptr<PeerCache> peerCache);
+
+  PeerCache* peerCache() const {
+    return peerCache_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -870,8 +975,20 @@ class AsyncDataCache : public memory::Cache {
   /// NOTE: it is used by testing and Prestissimo server operation.
   void clear();
 
+  /// Loads the most used entries of 'ssdCache_' into memory. The entries are
+  /// chosen by the region access scores that SsdCache keeps in its checkpoint,
+  /// so that a worker restarted from a checkpoint does not start with an empty
+  /// memory cache. Entries already in memory are skipped. Blocks until done
+  /// and returns the loaded bytes. Meant to run on a background thread at
+  /// startup. shutdown() stops the warm up at the next entry.
+  uint64_t warmUpFromSsd(const WarmUpOptions& options);
+
   std::vector<AsyncDataCacheEntry*> testingCacheEntries() const;
 
+  const Options& options() const {
+    return opts_;
+  }
+
   uint64_t testingSsdSavable() const {
     return ssdSaveable_;
   }
@@ -897,6 +1014,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::unique_ptr<PeerCache> peerCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -929,6 +1047,9 @@ class AsyncDataCache : public memory::Cache {
   // Counter of threads competing for allocation in makeSpace(). Used
   // for setting staggered backoff. Mutexes are not allowed for this.
   std::atomic<int32_t> numThreadsInAllocate_{0};
+
+  // Set by shutdown(). Stops warmUpFromSsd().
+  std::atomic<bool> shutdown_{false};
 };
 
 /// Samples a set of values T from 'numSamples' calls of 'iter'. Returns the
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/PeerCache.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Returns the ranges of the data of 'entry'.
+std::vector<folly::Range<char*>> entryRanges(AsyncDataCacheEntry& entry) {
+  std::vector<folly::Range<char*>> ranges;
+  if (entry.tinyData() != nullptr) {
+    ranges.emplace_back(entry.tinyData(), entry.size());
+    return ranges;
+  }
+  const auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < entry.size(); ++i) {
+    const auto run = allocation.runAt(i);
+    const uint64_t bytes = std::min<uint64_t>(
+        run.numPages() * memory::AllocationTraits::kPageSize,
+        entry.size() - offset);
+    ranges.emplace_back(run.data<char>(), bytes);
+    offset += bytes;
+  }
+  return ranges;
+}
+
+uint64_t totalSize(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t size = 0;
+  for (const auto& buffer : buffers) {
+    size += buffer.size();
+  }
+  return size;
+}
+} // namespace
+
+PeerCache::PeerCache(
+    std::string localPeer,
+    std::vector<std::string> peers,
+    std::shared_ptr<PeerCacheTransport> transport,
+    int32_t numVirtualNodes)
+    : localPeer_(std::move(localPeer)),
+      peers_(std::move(peers)),
+      transport_(std::move(transport)) {
+  VELOX_CHECK(!peers_.empty());
+  VELOX_CHECK_NOT_NULL(transport_);
+  VELOX_CHECK_GT(numVirtualNodes, 0);
+  VELOX_CHECK(
+      std::find(peers_.begin(), peers_.end(), localPeer_) != peers_.end(),
+      "Local peer {} is not in the peer list",
+      localPeer_);
+  ring_.reserve(peers_.size() * numVirtualNodes);
+  for (auto i = 0; i < peers_.size(); ++i) {
+    for (auto node = 0; node < numVirtualNodes; ++node) {
+      ring_.emplace_back(hash(peers_[i], node), i);
+    }
+  }
+  std::sort(ring_.begin(), ring_.end());
+}
+
+// static
+uint64_t PeerCache::hash(std::string_view fileName, uint64_t offset) {
+  return folly::hash::hash_combine(
+      folly::hash::fnv64_buf(fileName.data(), fileName.size()), offset);
+}
+
+const std::string& PeerCache::owner(std::string_view fileName, uint64_t offset)
+    const {
+  const auto point = hash(fileName, offset);
+  auto it = std::lower_bound(
+      ring_.begin(),
+      ring_.end(),
+      point,
+      [](const std::pair<uint64_t, int32_t>& node, uint64_t value) {
+        return node.first < value;
+      });
+  if (it == ring_.end()) {
+    it = ring_.begin();
+  }
+  return peers_[it->second];
+}
+
+bool PeerCache::load(AsyncDataCacheEntry& entry) {
+  VELOX_CHECK(entry.isExclusive());
+  const auto fileName = fileIds().string(entry.key().fileNum.id());
+  if (fileName.empty()) {
+    return false;
+  }
+  const auto& peer = owner(fileName, entry.offset());
+  if (peer == localPeer_) {
+    return false;
+  }
+  const auto ranges = entryRanges(entry);
+  bool fetched{false};
+  try {
+    fetched = transport_->fetch(peer, fileName, entry.offset(), ranges);
+  } catch (const std::exception& e) {
+    VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+        << "Failed to fetch " << fileName << " at " << entry.offset()
+        << " from peer " << peer << ": " << e.what();
+  }
+  if (!fetched) {
+    ++numMisses_;
+    return false;
+  }
+  ++numHits_;
+  bytesFetched_ += totalSize(ranges);
+  return true;
+}
+
+bool PeerCache::serve(
+    AsyncDataCache& cache,
+    const std::string& fileName,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  const StringIdLease fileNum(fileIds(), fileName);
+  auto pin = cache.find(RawFileCacheKey{fileNum.id(), offset});
+  if (pin.empty()) {
+    return false;
+  }
+  auto* entry = pin.checkedEntry();
+  const auto size = totalSize(buffers);
+  if (entry->size() < size) {
+    return false;
+  }
+  // Copies the runs of the entry to the destination buffers.
+  const auto sources = entryRanges(*entry);
+  size_t sourceIndex = 0;
+  uint64_t sourceOffset = 0;
+  for (const auto& buffer : buffers) {
+    uint64_t copied = 0;
+    while (copied < buffer.size()) {
+      const auto& source = sources[sourceIndex];
+      const auto bytes =
+          std::min(buffer.size() - copied, source.size() - sourceOffset);
+      if (buffer.data() != nullptr) {
+        ::memcpy(
+            buffer.data() + copied, source.data() + sourceOffset, bytes);
+      }
+      copied += bytes;
+      sourceOffset += bytes;
+      if (sourceOffset == source.size()) {
+        ++sourceIndex;
+        sourceOffset = 0;
+      }
+    }
+  }
+  ++numServed_;
+  return true;
+}
+
+PeerCache::Stats PeerCache::stats() const {
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.bytesFetched = bytesFetched_;
+  stats.numServed = numServed_;
+  return stats;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Moves cached data between the AsyncDataCaches of peer workers. The
+/// implementation is provided by the embedding system, e.g. an RPC to the
+/// peer which calls PeerCache::serve() there.
+class PeerCacheTransport {
+ public:
+  virtual ~PeerCacheTransport() = default;
+
+  /// Reads the cache entry of 'fileName' at 'offset' from the cache of 'peer'
+  /// into 'buffers'. Returns true if the peer had the entry cached with at
+  /// least the total size of 'buffers' and the data was copied. Returns false
+  /// on a peer miss or failure. Must not read from storage.
+  virtual bool fetch(
+      const std::string& peer,
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) = 0;
+};
+
+/// Optional remote tier of AsyncDataCache. Each cache entry key, i.e. file
+/// name and offset, is owned by one of the peer workers on a consistent hash
+/// ring. On a miss in memory and SSD, the reader asks the owner for the entry
+/// through 'transport' before going to storage. When splits of the same file
+/// land on different workers, only the owner's read goes to storage. The
+/// consistent hashing keeps most of the ownership in place when a peer joins
+/// or leaves.
+class PeerCache {
+ public:
+  struct Stats {
+    /// The number of entries loaded from peers.
+    uint64_t numHits{0};
+    /// The number of remote fetches which missed.
+    uint64_t numMisses{0};
+    /// The number of bytes loaded from peers.
+    uint64_t bytesFetched{0};
+    /// The number of fetches from peers served by this cache.
+    uint64_t numServed{0};
+  };
+
+  /// 'localPeer' is the name of this worker in 'peers'. Each peer has
+  /// 'numVirtualNodes' points on the hash ring.
+  PeerCache(
+      std::string localPeer,
+      std::vector<std::string> peers,
+      std::shared_ptr<PeerCacheTransport> transport,
+      int32_t numVirtualNodes = 64);
+
+  /// Returns the peer which owns the cache entry of 'fileName' at 'offset'.
+  const std::string& owner(std::string_view fileName, uint64_t offset) const;
+
+  /// Loads the data of the exclusively pinned 'entry' from its owner peer.
+  /// Returns false if this worker is the owner or the owner doesn't have the
+  /// entry. The caller then reads 'entry' from storage.
+  bool load(AsyncDataCacheEntry& entry);
+
+  /// Serves a fetch from a peer from the memory of 'cache'. Copies the entry
+  /// of 'fileName' at 'offset' into 'buffers' and returns true if it is cached
+  /// with at least the total size of 'buffers'.
+  bool serve(
+      AsyncDataCache& cache,
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  Stats stats() const;
+
+ private:
+  // Returns the position of 'fileName' and 'offset' on the hash ring.
+  static uint64_t hash(std::string_view fileName, uint64_t offset);
+
+  const std::string localPeer_;
+  const std::vector<std::string> peers_;
+  const std::shared_ptr<PeerCacheTransport> transport_;
+  // The points of the hash ring sorted by hash, with the index of the owner
+  // peer in 'peers_'.
+  std::vector<std::pair<uint64_t, int32_t>> ring_;
+
+  std::atomic<uint64_t> numHits_{0};
+  std::atomic<uint64_t> numMisses_{0};
+  std::atomic<uint64_t> bytesFetched_{0};
+  std::atomic<uint64_t> numServed_{0};
+};
+
+} // namespace facebook::velox::cache
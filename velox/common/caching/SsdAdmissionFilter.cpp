@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionFilter.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Keeps the lower three bits of each 4 bit counter after a shift by one.
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+
+// Returns the number of counters for 'windowReferences'. As in TinyLFU, there
+// is about one counter per reference in the window.
+uint64_t numCounters(uint64_t windowReferences) {
+  return bits::nextPowerOfTwo(std::max<uint64_t>(windowReferences, 1024));
+}
+} // namespace
+
+SsdAdmissionFilter::SsdAdmissionFilter(
+    uint32_t minReferences,
+    uint64_t windowReferences)
+    : minReferences_(minReferences),
+      windowReferences_(windowReferences),
+      counterMask_(numCounters(windowReferences) - 1),
+      words_(new std::atomic<uint64_t>[(counterMask_ + 1) / kCountersPerWord]) {
+  VELOX_CHECK_LE(minReferences_, kMaxCount);
+  VELOX_CHECK_GT(windowReferences_, 0);
+  for (auto i = 0; i < (counterMask_ + 1) / kCountersPerWord; ++i) {
+    words_[i] = 0;
+  }
+}
+
+uint64_t SsdAdmissionFilter::counterIndex(uint64_t hash, int32_t i) const {
+  // Double hashing over a remixed hash so that keys equal in the low bits,
+  // e.g. offsets in the same file, don't collide.
+  const uint64_t mixed = folly::hash::twang_mix64(hash);
+  const uint64_t step = (mixed >> 32) | 1;
+  return (mixed + i * step) & counterMask_;
+}
+
+void SsdAdmissionFilter::recordReference(uint64_t hash) {
+  for (auto i = 0; i < kNumHashes; ++i) {
+    const auto index = counterIndex(hash, i);
+    auto& word = words_[index / kCountersPerWord];
+    const auto shift = (index % kCountersPerWord) * 4;
+    auto value = word.load(std::memory_order_relaxed);
+    while (((value >> shift) & kMaxCount) < kMaxCount &&
+           !word.compare_exchange_weak(
+               value, value + (1ULL << shift), std::memory_order_relaxed)) {
+    }
+  }
+  if (numReferences_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      windowReferences_) {
+    age();
+    numReferences_ = 0;
+  }
+}
+
+uint32_t SsdAdmissionFilter::estimate(uint64_t hash) const {
+  uint32_t count = kMaxCount;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    const auto index = counterIndex(hash, i);
+    const auto word =
+        words_[index / kCountersPerWord].load(std::memory_order_relaxed);
+    count = std::min<uint32_t>(
+        count, (word >> ((index % kCountersPerWord) * 4)) & kMaxCount);
+  }
+  return count;
+}
+
+void SsdAdmissionFilter::age() {
+  for (auto i = 0; i < (counterMask_ + 1) / kCountersPerWord; ++i) {
+    auto value = words_[i].load(std::memory_order_relaxed);
+    while (!words_[i].compare_exchange_weak(
+        value, (value >> 1) & kHalfMask, std::memory_order_relaxed)) {
+    }
+  }
+}
+
+} // namespace facebook::velox::cache
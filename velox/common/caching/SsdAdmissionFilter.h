@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace facebook::velox::cache {
+
+/// Decides which AsyncDataCache entries are written to SsdCache based on how
+/// often they are referenced, in the style of TinyLFU. The references are
+/// counted by the hash of the entry key in a count-min sketch of 4 bit
+/// counters. An entry is admitted if its estimated count is at least
+/// 'minReferences'. After each 'windowReferences' references all the counters
+/// are halved so that the counts reflect the recent references. This keeps a
+/// large scan of cold data from replacing the hot regions of the SSD cache.
+///
+/// The filter is thread safe. The counts are approximate under concurrent
+/// updates, which only affects the admission of borderline entries.
+class SsdAdmissionFilter {
+ public:
+  static constexpr uint32_t kMaxCount = 15;
+
+  SsdAdmissionFilter(uint32_t minReferences, uint64_t windowReferences);
+
+  /// Records a reference to the entry with key hash 'hash'.
+  void recordReference(uint64_t hash);
+
+  /// Returns the estimated number of references to the entry with key hash
+  /// 'hash' in the recent window. Never less than the actual number but can
+  /// be larger due to collisions.
+  uint32_t estimate(uint64_t hash) const;
+
+  /// Returns true if the entry with key hash 'hash' should be written to SSD.
+  bool admit(uint64_t hash) const {
+    return estimate(hash) >= minReferences_;
+  }
+
+  uint32_t minReferences() const {
+    return minReferences_;
+  }
+
+ private:
+  // The number of counters of a key.
+  static constexpr int32_t kNumHashes = 4;
+  // The number of 4 bit counters in one word.
+  static constexpr int32_t kCountersPerWord = 16;
+
+  // Returns the index of the 'i'th counter of 'hash'.
+  uint64_t counterIndex(uint64_t hash, int32_t i) const;
+
+  // Halves all the counters.
+  void age();
+
+  const uint32_t minReferences_;
+  const uint64_t windowReferences_;
+  // The number of counters minus one. The number of counters is a power of 2.
+  const uint64_t counterMask_;
+  const std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  std::atomic<uint64_t> numReferences_{0};
+};
+
+} // namespace facebook::velox::cache
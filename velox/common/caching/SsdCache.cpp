@@ -33,6 +33,12 @@ SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
+      admissionFilter_(
+          config.admissionMinReferences == 0
+              ? nullptr
+              : std::make_unique<SsdAdmissionFilter>(
+                    config.admissionMinReferences,
+                    config.admissionWindowReferences)),
       executor_(config.executor) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
@@ -177,14 +183,36 @@ bool SsdCache::removeFileEntries(
   return success;
 }
 
+bool SsdCache::admit(uint64_t keyHash, uint64_t bytes) {
+  if (admissionFilter_ != nullptr && !admissionFilter_->admit(keyHash)) {
+    bytesRejected_ += bytes;
+    return false;
+  }
+  bytesAdmitted_ += bytes;
+  return true;
+}
+
 SsdCacheStats SsdCache::stats() const {
   SsdCacheStats stats;
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.bytesAdmitted = bytesAdmitted_.load();
+  stats.bytesRejected = bytesRejected_.load();
   return stats;
 }
 
+std::vector<std::pair<FileCacheKey, SsdRun>> SsdCache::hotEntries(
+    uint64_t maxBytes) {
+  std::vector<std::pair<FileCacheKey, SsdRun>> entries;
+  for (auto& file : files_) {
+    auto fileEntries = file->hotEntries(maxBytes / files_.size());
+    std::move(
+        fileEntries.begin(), fileEntries.end(), std::back_inserter(entries));
+  }
+  return entries;
+}
+
 std::string SsdCache::toString() const {
   const auto data = stats();
   const uint64_t capacity = maxBytes();
@@ -193,6 +221,8 @@ std::string SsdCache::toString() const {
       << succinctBytes(data.bytesRead) << " Size " << succinctBytes(capacity)
       << " Occupied " << succinctBytes(data.bytesCached);
   out << " " << (data.entriesCached >> 10) << "K entries.";
+  out << " Admitted " << succinctBytes(data.bytesAdmitted) << " rejected "
+      << succinctBytes(data.bytesRejected);
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/SsdAdmissionFilter.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -67,15 +68,26 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// If non-zero, an entry is written to SSD only if it has been referenced
+    /// at least this many times in the recent 'admissionWindowReferences'
+    /// cache references. See SsdAdmissionFilter. The value is at most
+    /// SsdAdmissionFilter::kMaxCount. 0 admits all the entries.
+    uint32_t admissionMinReferences{0};
+
+    /// The number of cache references after which the reference counts of the
+    /// admission filter are halved.
+    uint64_t admissionWindowReferences{1 << 20};
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, admission min references {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          admissionMinReferences);
     }
   };
 
@@ -139,10 +151,27 @@ class SsdCache {
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
+  /// Returns up to 'maxBytes' worth of the most used entries, an equal share
+  /// from each shard. See SsdFile::hotEntries().
+  std::vector<std::pair<FileCacheKey, SsdRun>> hotEntries(uint64_t maxBytes);
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
 
+  /// Records a reference to the AsyncDataCache entry with key hash 'keyHash'
+  /// for the admission filter.
+  void recordReference(uint64_t keyHash) {
+    if (admissionFilter_ != nullptr) {
+      admissionFilter_->recordReference(keyHash);
+    }
+  }
+
+  /// Returns true if the AsyncDataCache entry with key hash 'keyHash' and
+  /// 'bytes' in size should be written to SSD. Counts the admitted and
+  /// rejected bytes.
+  bool admit(uint64_t keyHash, uint64_t bytes);
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -183,6 +212,11 @@ class SsdCache {
   const int32_t numShards_;
   // Stats for selecting entries to save from AsyncDataCache.
   const std::unique_ptr<FileGroupStats> groupStats_;
+  // Selects the entries to save by their number of references. nullptr if
+  // all the entries are admitted.
+  const std::unique_ptr<SsdAdmissionFilter> admissionFilter_;
+  std::atomic<uint64_t> bytesAdmitted_{0};
+  std::atomic<uint64_t> bytesRejected_{0};
   folly::Executor* const executor_;
   mutable std::mutex mutex_;
 
@@ -23,6 +23,7 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -291,7 +292,12 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
-  readFile_->preadv(offset, buffers);
+  uint64_t readUs{0};
+  {
+    MicrosecondTimer timer(&readUs);
+    readFile_->preadv(offset, buffers);
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricSsdCacheReadLatencyUs, readUs);
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
@@ -486,7 +492,12 @@ bool SsdFile::write(
     int64_t length,
     const std::vector<iovec>& iovecs) {
   try {
-    writeFile_->write(iovecs, offset, length);
+    uint64_t writeUs{0};
+    {
+      MicrosecondTimer timer(&writeUs);
+      writeFile_->write(iovecs, offset, length);
+    }
+    RECORD_HISTOGRAM_METRIC_VALUE(kMetricSsdCacheWriteLatencyUs, writeUs);
     return true;
   } catch (const std::exception& e) {
     VELOX_SSD_CACHE_LOG(ERROR)
@@ -539,6 +550,46 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+std::vector<std::pair<FileCacheKey, SsdRun>> SsdFile::hotEntries(
+    uint64_t maxBytes) {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  const auto scores = tracker_.copyScores();
+  std::vector<std::vector<std::pair<FileCacheKey, SsdRun>>> regionEntries(
+      numRegions_);
+  for (const auto& [key, run] : entries_) {
+    regionEntries[regionIndex(run.offset())].emplace_back(key, run);
+  }
+  std::vector<int32_t> regions;
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (!regionEntries[region].empty()) {
+      regions.push_back(region);
+    }
+  }
+  std::sort(regions.begin(), regions.end(), [&](int32_t left, int32_t right) {
+    return scores[left] > scores[right];
+  });
+
+  std::vector<std::pair<FileCacheKey, SsdRun>> result;
+  uint64_t bytes{0};
+  for (const auto region : regions) {
+    auto& entries = regionEntries[region];
+    std::sort(
+        entries.begin(),
+        entries.end(),
+        [](const auto& left, const auto& right) {
+          return left.second.offset() < right.second.offset();
+        });
+    for (auto& entry : entries) {
+      if (bytes + entry.second.size() > maxBytes) {
+        return result;
+      }
+      bytes += entry.second.size();
+      result.push_back(std::move(entry));
+    }
+  }
+  return result;
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
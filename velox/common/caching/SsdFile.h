@@ -167,6 +167,8 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    bytesAdmitted = tsanAtomicValue(other.bytesAdmitted);
+    bytesRejected = tsanAtomicValue(other.bytesRejected);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -198,6 +200,8 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.bytesAdmitted = bytesAdmitted - other.bytesAdmitted;
+    result.bytesRejected = bytesRejected - other.bytesRejected;
     return result;
   }
 
@@ -234,6 +238,10 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// Bytes of the AsyncDataCache entries admitted and rejected for writing to
+  /// SSD by the admission filter of SsdCache.
+  tsan_atomic<uint64_t> bytesAdmitted{0};
+  tsan_atomic<uint64_t> bytesRejected{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -337,6 +345,12 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Returns up to 'maxBytes' worth of entries, the entries of the regions
+  /// with the highest access scores first and in file order within a region.
+  /// Used for loading the most used entries into AsyncDataCache after a
+  /// restart from checkpoint.
+  std::vector<std::pair<FileCacheKey, SsdRun>> hotEntries(uint64_t maxBytes);
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
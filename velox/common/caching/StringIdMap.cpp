@@ -14,104 +14,181 @@
  * limitations under the License.
  */
 
+
 #include "velox/common/caching/StringIdMap.h"
 
+#include <folly/hash/Hash.h>
+
 namespace facebook::velox {
 
+// static
+int32_t StringIdMap::stringShardIndex(std::string_view string) {
+  return folly::hasher<std::string_view>()(string) % kNumShards;
+}
+
 uint64_t StringIdMap::id(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
-    return it->second;
+  auto& shard = stringShards_[stringShardIndex(string)];
+  std::shared_lock<std::shared_mutex> l(shard.mutex);
+  auto it = shard.entries.find(string);
+  if (it != shard.entries.end()) {
+    return it->second->id;
   }
   return kNoId;
 }
 
+std::string StringIdMap::string(uint64_t id) {
+  auto& shard = idShard(id);
+  std::shared_lock<std::shared_mutex> l(shard.mutex);
+  auto it = shard.entries.find(id);
+  return it == shard.entries.end() ? "" : it->second->string;
+}
+
+void StringIdMap::addUse(Entry& entry) {
+  // An entry whose last use is gone is revived if it is not yet freed.
+  if (entry.numInUse.fetch_add(1) == 0) {
+    pinnedSize_ += entry.string.size();
+  }
+}
+
 void StringIdMap::release(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToEntry_.find(id);
-  if (it != idToEntry_.end()) {
-    VELOX_CHECK_LT(
-        0, it->second.numInUse, "Extra release of id in StringIdMap");
-    if (--it->second.numInUse == 0) {
-      pinnedSize_ -= it->second.string.size();
-      auto strIter = stringToId_.find(it->second.string);
-      VELOX_DCHECK(strIter != stringToId_.end());
-      stringToId_.erase(strIter);
-      idToEntry_.erase(it);
+  int32_t stringShard;
+  {
+    auto& shard = idShard(id);
+    std::shared_lock<std::shared_mutex> l(shard.mutex);
+    auto it = shard.entries.find(id);
+    if (it == shard.entries.end()) {
+      return;
     }
+    auto& entry = *it->second;
+    auto numInUse = entry.numInUse.load();
+    do {
+      VELOX_CHECK_LT(0, numInUse, "Extra release of id in StringIdMap");
+    } while (!entry.numInUse.compare_exchange_weak(numInUse, numInUse - 1));
+    if (numInUse > 1) {
+      return;
+    }
+    pinnedSize_ -= entry.string.size();
+    stringShard = entry.stringShard;
   }
+  freeUnused(id, stringShard);
+}
+
+void StringIdMap::freeUnused(uint64_t id, int32_t stringShardIndex) {
+  auto& stringShard = stringShards_[stringShardIndex];
+  std::unique_lock<std::shared_mutex> stringLock(stringShard.mutex);
+  auto& shard = idShard(id);
+  std::unique_lock<std::shared_mutex> idLock(shard.mutex);
+  auto it = shard.entries.find(id);
+  // The entry may have been revived or freed by another release after it
+  // reached no uses.
+  if (it == shard.entries.end() || it->second->numInUse > 0 ||
+      it->second->stringShard != stringShardIndex) {
+    return;
+  }
+  auto strIter = stringShard.entries.find(it->second->string);
+  VELOX_DCHECK(strIter != stringShard.entries.end());
+  stringShard.entries.erase(strIter);
+  shard.entries.erase(it);
 }
 
 void StringIdMap::addReference(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToEntry_.find(id);
+  auto& shard = idShard(id);
+  std::shared_lock<std::shared_mutex> l(shard.mutex);
+  auto it = shard.entries.find(id);
   VELOX_CHECK(
-      it != idToEntry_.end(),
+      it != shard.entries.end(),
       "Trying to add a reference to id {} that is not in StringIdMap",
       id);
-
-  ++it->second.numInUse;
+  addUse(*it->second);
 }
 
 uint64_t StringIdMap::makeId(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
-    auto entry = idToEntry_.find(it->second);
-    VELOX_CHECK(entry != idToEntry_.end());
-    if (++entry->second.numInUse == 1) {
-      pinnedSize_ += entry->second.string.size();
+  const auto shardIndex = stringShardIndex(string);
+  auto& shard = stringShards_[shardIndex];
+  {
+    std::shared_lock<std::shared_mutex> l(shard.mutex);
+    auto it = shard.entries.find(string);
+    if (it != shard.entries.end()) {
+      addUse(*it->second);
+      return it->second->id;
     }
-    return it->second;
   }
-  Entry entry;
-  entry.string = string;
+  std::unique_lock<std::shared_mutex> l(shard.mutex);
+  auto it = shard.entries.find(string);
+  if (it != shard.entries.end()) {
+    addUse(*it->second);
+    return it->second->id;
+  }
   // Check that we do not use an id twice. In practice this never
   // happens because the int64 counter would have to wrap around for
   // this. Even if this happened, the time spent in the loop would
   // have a low cap since the number of mappings would in practice
   // be in the 100K range.
-  do {
-    entry.id = ++lastId_;
-  } while (idToEntry_.find(entry.id) != idToEntry_.end());
-  entry.numInUse = 1;
+  for (;;) {
+    const auto id = ++lastId_;
+    auto& ids = idShard(id);
+    std::unique_lock<std::shared_mutex> idLock(ids.mutex);
+    if (ids.entries.count(id) == 0) {
+      addEntryLocked(shard, shardIndex, ids, string, id);
+      return id;
+    }
+  }
+}
+
+void StringIdMap::addEntryLocked(
+    StringShard& stringShard,
+    int32_t stringShardIndex,
+    IdShard& ids,
+    std::string_view string,
+    uint64_t id) {
+  auto entry = std::make_unique<Entry>();
+  entry->string = string;
+  entry->id = id;
+  entry->stringShard = stringShardIndex;
+  entry->numInUse = 1;
+  stringShard.entries.emplace(entry->string, entry.get());
+  ids.entries.emplace(id, std::move(entry));
   pinnedSize_ += string.size();
-  const auto id = entry.id;
-  idToEntry_[id] = std::move(entry);
-  stringToId_[string] = id;
-  return lastId_;
 }
 
 uint64_t StringIdMap::recoverId(uint64_t id, std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
+  const auto shardIndex = stringShardIndex(string);
+  auto& shard = stringShards_[shardIndex];
+  std::unique_lock<std::shared_mutex> l(shard.mutex);
+  auto it = shard.entries.find(string);
+  if (it != shard.entries.end()) {
     VELOX_CHECK_EQ(
-        id, it->second, "Multiple recover ids assigned to {}", string);
-    auto entry = idToEntry_.find(it->second);
-    VELOX_CHECK(entry != idToEntry_.end());
-    if (++entry->second.numInUse == 1) {
-      pinnedSize_ += entry->second.string.size();
-    }
+        id, it->second->id, "Multiple recover ids assigned to {}", string);
+    addUse(*it->second);
     return id;
   }
 
+  auto& ids = idShard(id);
+  std::unique_lock<std::shared_mutex> idLock(ids.mutex);
   VELOX_CHECK_EQ(
-      idToEntry_.count(id),
+      ids.entries.count(id),
       0,
       "Reused recover id {} assigned to {}",
       id,
       string);
-
-  Entry entry;
-  entry.string = string;
-  entry.id = id;
-  lastId_ = std::max(lastId_, id);
-  entry.numInUse = 1;
-  pinnedSize_ += string.size();
-  idToEntry_[id] = std::move(entry);
-  stringToId_[string] = id;
+  addEntryLocked(shard, shardIndex, ids, string, id);
+  auto lastId = lastId_.load();
+  while (lastId < id && !lastId_.compare_exchange_weak(lastId, id)) {
+  }
   return id;
 }
+
+void StringIdMap::testingReset() {
+  for (auto& shard : stringShards_) {
+    std::unique_lock<std::shared_mutex> l(shard.mutex);
+    shard.entries.clear();
+  }
+  for (auto& shard : idShards_) {
+    std::unique_lock<std::shared_mutex> l(shard.mutex);
+    shard.entries.clear();
+  }
+  lastId_ = 0;
+  pinnedSize_ = 0;
+}
+
 } // namespace facebook::velox
@@ -16,14 +16,22 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
 #include <string_view>
 
 #include <folly/container/F14Map.h>
+#include <folly/lang/Align.h>
 
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
 
+/// Thread-safe map of strings to use counted ids. Strings and ids are sharded
+/// over separately locked maps. Lookups and the use count changes of leases
+/// which do not free an entry take a shared lock on one shard. Only the
+/// creation and the freeing of an entry lock shards exclusively.
 class StringIdMap {
  public:
   static constexpr uint64_t kNoId = ~0UL;
@@ -70,38 +78,64 @@ class StringIdMap {
 
   /// Returns a copy of the string associated with id or empty string if id has
   /// no string.
-  std::string string(uint64_t id) {
-    std::lock_guard<std::mutex> l(mutex_);
-    auto it = idToEntry_.find(id);
-    return it == idToEntry_.end() ? "" : it->second.string;
-  }
+  std::string string(uint64_t id);
 
   /// Resets StringIdMap.
-  void testingReset() {
-    std::lock_guard<std::mutex> l(mutex_);
-    stringToId_.clear();
-    idToEntry_.clear();
-    lastId_ = 0;
-    pinnedSize_ = 0;
-  }
+  void testingReset();
 
   uint64_t testingLastId() const {
-    std::lock_guard<std::mutex> l(mutex_);
     return lastId_;
   }
 
+  static constexpr int32_t kNumShards = 32;
+
  private:
   struct Entry {
     std::string string;
     uint64_t id;
-    uint32_t numInUse{};
+    // The index of the shard of 'string' in 'stringShards_'.
+    int32_t stringShard;
+    std::atomic<uint32_t> numInUse{0};
+  };
+
+  // Entries by string. Writers lock the shard of the string before the shard
+  // of the id.
+  struct alignas(folly::hardware_destructive_interference_size) StringShard {
+    mutable std::shared_mutex mutex;
+    folly::F14FastMap<std::string, Entry*> entries;
   };
 
-  mutable std::mutex mutex_;
-  folly::F14FastMap<std::string, uint64_t> stringToId_;
-  folly::F14FastMap<uint64_t, Entry> idToEntry_;
-  uint64_t lastId_{0};
-  uint64_t pinnedSize_{0};
+  // Owns the entries by id.
+  struct alignas(folly::hardware_destructive_interference_size) IdShard {
+    mutable std::shared_mutex mutex;
+    folly::F14FastMap<uint64_t, std::unique_ptr<Entry>> entries;
+  };
+
+  static int32_t stringShardIndex(std::string_view string);
+
+  IdShard& idShard(uint64_t id) {
+    return idShards_[id % kNumShards];
+  }
+
+  // Increments the use count of 'entry' of which the caller holds a lock.
+  void addUse(Entry& entry);
+
+  // Makes an entry with 'id' for 'string' with one use. The caller holds the
+  // exclusive locks of 'stringShard' and 'ids'.
+  void addEntryLocked(
+      StringShard& stringShard,
+      int32_t stringShardIndex,
+      IdShard& ids,
+      std::string_view string,
+      uint64_t id);
+
+  // Frees the entry of 'id' if it has no uses.
+  void freeUnused(uint64_t id, int32_t stringShardIndex);
+
+  StringShard stringShards_[kNumShards];
+  IdShard idShards_[kNumShards];
+  std::atomic<uint64_t> lastId_{0};
+  std::atomic<int64_t> pinnedSize_{0};
 };
 
 /// Keeps a string-id association live for the duration of this.
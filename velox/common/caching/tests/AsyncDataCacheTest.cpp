@@ -1539,6 +1539,130 @@ TEST_P(AsyncDataCacheTest, checkpoint) {
   ASSERT_EQ(stats.ssdStats->checkpointsWritten, kNumSsdShards);
 }
 
+TEST_P(AsyncDataCacheTest, warmUpFromSsd) {
+  constexpr uint64_t kRamBytes = 64UL << 20; // 64 MB
+  constexpr uint64_t kSsdBytes = 128UL << 20; // 128 MB
+
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      /*checkpointIntervalBytes=*/1UL << 30,
+      /*eraseCheckpoint=*/true,
+      {0.0, 10000.0, 1UL << 30});
+  loadLoop(0, kRamBytes / 4);
+  waitForPendingLoads();
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd(true);
+  cache_->ssdCache()->waitForWriteToFinish();
+  const auto numWritten = cache_->refreshStats().ssdStats->entriesWritten;
+  ASSERT_GT(numWritten, 0);
+  // Makes a checkpoint.
+  cache_->ssdCache()->shutdown();
+
+  // A restarted cache starts empty in memory and loads from SSD.
+  initializeCache(kRamBytes, kSsdBytes, /*checkpointIntervalBytes=*/1UL << 30);
+  ASSERT_EQ(cache_->refreshStats().numEntries, 0);
+  cache_->setVerifyHook(
+      [&](const AsyncDataCacheEntry& entry) { checkContents(entry); });
+
+  // Stops at the memory limit.
+  AsyncDataCache::WarmUpOptions options;
+  options.maxBytesPerSec = 0;
+  options.maxMemoryRatio = 0.0;
+  ASSERT_EQ(cache_->warmUpFromSsd(options), 0);
+
+  options.maxMemoryRatio = 0.9;
+  options.maxBytes = 8 << 20;
+  const auto limitedBytes = cache_->warmUpFromSsd(options);
+  ASSERT_GT(limitedBytes, 0);
+  ASSERT_LE(limitedBytes, 8 << 20);
+
+  options.maxBytes = std::numeric_limits<uint64_t>::max();
+  const auto loadedBytes = cache_->warmUpFromSsd(options);
+  ASSERT_GT(loadedBytes, 0);
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numEntries, stats.ssdStats->entriesRead);
+  ASSERT_EQ(stats.numExclusive, 0);
+  ASSERT_EQ(stats.numShared, 0);
+
+  // Entries already in memory are not loaded again.
+  ASSERT_EQ(cache_->warmUpFromSsd(options), 0);
+}
+
+TEST_P(AsyncDataCacheTest, compressColdEntries) {
+  constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
+  constexpr int32_t kEntrySize = 1 << 20;
+  constexpr int32_t kNumHot = 8;
+  AsyncDataCache::Options options;
+  options.compressionKind = common::CompressionKind_ZSTD;
+  initializeCache(kRamBytes, 0, 0, false, options);
+
+  // Fills 'entry' with a compressible pattern based on the offset.
+  auto fill = [](AsyncDataCacheEntry& entry) {
+    for (auto i = 0; i < entry.data().numRuns(); ++i) {
+      auto run = entry.data().runAt(i);
+      auto* words = reinterpret_cast<int64_t*>(run.data());
+      for (auto j = 0; j < run.numBytes() / sizeof(int64_t); ++j) {
+        words[j] = entry.offset() + j % 16;
+      }
+    }
+  };
+  auto check = [](const AsyncDataCacheEntry& entry) {
+    int64_t numChecked = 0;
+    for (auto i = 0; i < entry.data().numRuns(); ++i) {
+      const auto run = entry.data().runAt(i);
+      const auto* words = reinterpret_cast<const int64_t*>(run.data());
+      for (auto j = 0; j < run.numBytes() / sizeof(int64_t) &&
+           numChecked < entry.size() / sizeof(int64_t);
+           ++j, ++numChecked) {
+        ASSERT_EQ(words[j], entry.offset() + j % 16);
+      }
+    }
+  };
+  auto load = [&](int32_t index) {
+    auto pin = cache_->findOrCreate(
+        {filenames_[0].id(), static_cast<uint64_t>(index) * kEntrySize},
+        kEntrySize);
+    auto* entry = pin.checkedEntry();
+    if (entry->isExclusive()) {
+      fill(*entry);
+      entry->setExclusiveToShared();
+    } else {
+      check(*entry);
+    }
+  };
+
+  // Entries used several times are compressed when they become cold instead
+  // of being evicted.
+  for (auto use = 0; use < 3; ++use) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      load(i);
+    }
+  }
+  for (auto i = kNumHot; i < kNumHot + 12; ++i) {
+    load(i);
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numCompressions, 0);
+  ASSERT_GT(stats.numCompressed, 0);
+  ASSERT_LT(stats.compressedSize, stats.numCompressed * kEntrySize / 10);
+  // The compressed data is allocated from the cache's allocator and is
+  // counted in the cached pages.
+  ASSERT_GE(
+      memory::AllocationTraits::pageBytes(cache_->incrementCachedPages(0)),
+      stats.largeSize + stats.compressedSize);
+
+  // Compressed entries are decompressed on access.
+  for (auto i = 0; i < kNumHot; ++i) {
+    load(i);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_GT(stats.numDecompressions, 0);
+  ASSERT_GE(
+      kRamBytes / memory::AllocationTraits::kPageSize,
+      cache_->incrementCachedPages(0));
+}
+
 // TODO: add concurrent fuzzer test.
 
 INSTANTIATE_TEST_SUITE_P(
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/PeerCache.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+// Calls PeerCache::serve() of the peers in the same process.
+class InProcessTransport : public PeerCacheTransport {
+ public:
+  void addPeer(
+      const std::string& name,
+      PeerCache* peerCache,
+      AsyncDataCache* cache) {
+    peers_[name] = {peerCache, cache};
+  }
+
+  bool fetch(
+      const std::string& peer,
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) override {
+    ++numFetches;
+    auto& [peerCache, cache] = peers_.at(peer);
+    return peerCache->serve(*cache, fileName, offset, buffers);
+  }
+
+  int32_t numFetches{0};
+
+ private:
+  std::unordered_map<std::string, std::pair<PeerCache*, AsyncDataCache*>>
+      peers_;
+};
+
+class PeerCacheTest : public testing::Test {
+ protected:
+  static constexpr uint64_t kCapacity = 64 << 20;
+
+  void SetUp() override {
+    transport_ = std::make_shared<InProcessTransport>();
+    const std::vector<std::string> peers{"worker1", "worker2"};
+    for (auto i = 0; i < peers.size(); ++i) {
+      memory::MemoryManagerOptions options;
+      options.allocatorCapacity = kCapacity;
+      options.arbitratorCapacity = kCapacity;
+      managers_.push_back(std::make_unique<memory::MemoryManager>(options));
+      caches_.push_back(AsyncDataCache::create(managers_.back()->allocator()));
+      caches_.back()->setPeerCache(
+          std::make_unique<PeerCache>(peers[i], peers, transport_));
+      transport_->addPeer(
+          peers[i], caches_.back()->peerCache(), caches_.back().get());
+    }
+    fileName_ = "peer_cache_test_file";
+    fileNum_ = StringIdLease(fileIds(), fileName_);
+  }
+
+  void TearDown() override {
+    for (auto& cache : caches_) {
+      cache->shutdown();
+    }
+  }
+
+  // Returns an offset of 'fileName_' from 'start' owned by the peer at
+  // 'index'.
+  uint64_t ownedOffset(int32_t index, uint64_t start = 0) {
+    auto* peerCache = caches_[index]->peerCache();
+    const auto peer = fmt::format("worker{}", index + 1);
+    for (uint64_t offset = start;; offset += 1'000) {
+      if (peerCache->owner(fileName_, offset) == peer) {
+        return offset;
+      }
+    }
+  }
+
+  // Returns the data of the exclusive 'entry'.
+  static std::vector<folly::Range<char*>> ranges(AsyncDataCacheEntry& entry) {
+    if (entry.tinyData() != nullptr) {
+      return {{entry.tinyData(), static_cast<size_t>(entry.size())}};
+    }
+    std::vector<folly::Range<char*>> result;
+    uint64_t offset = 0;
+    for (auto i = 0; i < entry.data().numRuns(); ++i) {
+      const auto run = entry.data().runAt(i);
+      const auto bytes = std::min<uint64_t>(
+          run.numPages() * memory::AllocationTraits::kPageSize,
+          entry.size() - offset);
+      result.emplace_back(run.data<char>(), bytes);
+      offset += bytes;
+    }
+    return result;
+  }
+
+  // Makes a shared entry of 'size' bytes in the cache at 'index'.
+  void cacheEntry(int32_t index, uint64_t offset, int32_t size) {
+    auto pin = caches_[index]->findOrCreate({fileNum_.id(), offset}, size);
+    ASSERT_FALSE(pin.empty());
+    auto* entry = pin.checkedEntry();
+    int64_t position = offset;
+    for (auto& range : ranges(*entry)) {
+      for (auto i = 0; i < range.size(); ++i) {
+        range.data()[i] = static_cast<char>(position++);
+      }
+    }
+    entry->setExclusiveToShared();
+  }
+
+  void checkEntry(AsyncDataCacheEntry& entry) {
+    int64_t position = entry.offset();
+    for (auto& range : ranges(entry)) {
+      for (auto i = 0; i < range.size(); ++i) {
+        ASSERT_EQ(range.data()[i], static_cast<char>(position++));
+      }
+    }
+  }
+
+  std::shared_ptr<InProcessTransport> transport_;
+  std::vector<std::unique_ptr<memory::MemoryManager>> managers_;
+  std::vector<std::shared_ptr<AsyncDataCache>> caches_;
+  std::string fileName_;
+  StringIdLease fileNum_;
+};
+} // namespace
+
+TEST_F(PeerCacheTest, owner) {
+  const std::vector<std::string> peers{"a", "b", "c"};
+  PeerCache peerCache("a", peers, transport_);
+  std::unordered_map<std::string, int32_t> counts;
+  for (auto i = 0; i < 3'000; ++i) {
+    const auto& owner = peerCache.owner(fileName_, i * 8192);
+    // The owner is stable.
+    ASSERT_EQ(owner, peerCache.owner(fileName_, i * 8192));
+    ++counts[owner];
+  }
+  ASSERT_EQ(counts.size(), 3);
+  for (const auto& [peer, count] : counts) {
+    ASSERT_GT(count, 500) << peer;
+  }
+
+  // Removing a peer only moves the entries it owned.
+  PeerCache smaller("a", {"a", "b"}, transport_);
+  for (auto i = 0; i < 3'000; ++i) {
+    const auto& owner = peerCache.owner(fileName_, i * 8192);
+    if (owner != "c") {
+      ASSERT_EQ(owner, smaller.owner(fileName_, i * 8192));
+    }
+  }
+
+  VELOX_ASSERT_THROW(
+      PeerCache("d", peers, transport_),
+      "Local peer d is not in the peer list");
+}
+
+TEST_F(PeerCacheTest, load) {
+  for (const int32_t size : {100, 300'000}) {
+    SCOPED_TRACE(fmt::format("size {}", size));
+    // An entry owned and cached by worker2 is loaded by worker1 from it.
+    const auto offset = ownedOffset(1, size);
+    cacheEntry(1, offset, size);
+    auto pin = caches_[0]->findOrCreate({fileNum_.id(), offset}, size);
+    ASSERT_TRUE(pin.checkedEntry()->isExclusive());
+    ASSERT_TRUE(caches_[0]->peerCache()->load(*pin.checkedEntry()));
+    checkEntry(*pin.checkedEntry());
+  }
+  const auto stats = caches_[0]->peerCache()->stats();
+  ASSERT_EQ(stats.numMisses, 0);
+  ASSERT_EQ(stats.numHits, caches_[1]->peerCache()->stats().numServed);
+}
+
+TEST_F(PeerCacheTest, miss) {
+  // Not cached on the owner.
+  const auto remoteOffset = ownedOffset(1);
+  auto pin = caches_[0]->findOrCreate({fileNum_.id(), remoteOffset}, 1'000);
+  ASSERT_FALSE(caches_[0]->peerCache()->load(*pin.checkedEntry()));
+  ASSERT_EQ(transport_->numFetches, 1);
+  ASSERT_EQ(caches_[0]->peerCache()->stats().numMisses, 1);
+
+  // The owner has a shorter entry.
+  const auto shortOffset = ownedOffset(1, remoteOffset + 1'000);
+  cacheEntry(1, shortOffset, 100);
+  auto longPin = caches_[0]->findOrCreate({fileNum_.id(), shortOffset}, 1'000);
+  ASSERT_FALSE(caches_[0]->peerCache()->load(*longPin.checkedEntry()));
+  ASSERT_EQ(transport_->numFetches, 2);
+
+  // Locally owned entries are not fetched.
+  const auto fetches = transport_->numFetches;
+  auto localPin =
+      caches_[0]->findOrCreate({fileNum_.id(), ownedOffset(0)}, 1'000);
+  ASSERT_FALSE(caches_[0]->peerCache()->load(*localPin.checkedEntry()));
+  ASSERT_EQ(transport_->numFetches, fetches);
+}
+
+TEST_F(PeerCacheTest, find) {
+  ASSERT_TRUE(caches_[0]->find({fileNum_.id(), 0}).empty());
+  {
+    auto pin = caches_[0]->findOrCreate({fileNum_.id(), 0}, 100);
+    // An exclusive entry is not found.
+    ASSERT_TRUE(caches_[0]->find({fileNum_.id(), 0}).empty());
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  auto pin = caches_[0]->find({fileNum_.id(), 0});
+  ASSERT_FALSE(pin.empty());
+  ASSERT_TRUE(pin.checkedEntry()->isShared());
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(SsdAdmissionFilterTest, admit) {
+  SsdAdmissionFilter filter(2, 1 << 20);
+  ASSERT_EQ(filter.minReferences(), 2);
+  ASSERT_EQ(filter.estimate(1), 0);
+  ASSERT_FALSE(filter.admit(1));
+  filter.recordReference(1);
+  ASSERT_EQ(filter.estimate(1), 1);
+  ASSERT_FALSE(filter.admit(1));
+  filter.recordReference(1);
+  ASSERT_EQ(filter.estimate(1), 2);
+  ASSERT_TRUE(filter.admit(1));
+  ASSERT_FALSE(filter.admit(2));
+
+  // The counts saturate.
+  for (auto i = 0; i < 100; ++i) {
+    filter.recordReference(3);
+  }
+  ASSERT_EQ(filter.estimate(3), SsdAdmissionFilter::kMaxCount);
+}
+
+TEST(SsdAdmissionFilterTest, scanDoesNotPolluteHotKeys) {
+  constexpr int32_t kNumHotKeys = 100;
+  constexpr uint64_t kWindow = 64 << 10;
+  SsdAdmissionFilter filter(3, kWindow);
+  // A large scan of cold keys which are referenced once each, interleaved
+  // with repeated references to hot keys.
+  for (uint64_t i = 0; i < kWindow / 8; ++i) {
+    filter.recordReference((1ULL << 40) + i);
+    if (i % 1'000 == 0) {
+      for (auto key = 0; key < kNumHotKeys; ++key) {
+        filter.recordReference(key);
+      }
+    }
+  }
+  for (auto key = 0; key < kNumHotKeys; ++key) {
+    ASSERT_TRUE(filter.admit(key)) << key;
+  }
+  int32_t numColdAdmitted = 0;
+  for (uint64_t i = 0; i < kWindow / 8; ++i) {
+    numColdAdmitted += filter.admit((1ULL << 40) + i);
+  }
+  // Cold keys are admitted only through rare collisions.
+  ASSERT_LT(numColdAdmitted, 10);
+}
+
+TEST(SsdAdmissionFilterTest, aging) {
+  constexpr uint64_t kWindow = 1024;
+  SsdAdmissionFilter filter(2, kWindow);
+  for (auto i = 0; i < 8; ++i) {
+    filter.recordReference(1);
+  }
+  ASSERT_EQ(filter.estimate(1), 8);
+  // Filling the window with references to another key halves the counts.
+  for (uint64_t i = 0; i < kWindow - 8; ++i) {
+    filter.recordReference(2);
+  }
+  ASSERT_EQ(filter.estimate(1), 4);
+  for (uint64_t i = 0; i < 2 * kWindow; ++i) {
+    filter.recordReference(2);
+  }
+  ASSERT_EQ(filter.estimate(1), 1);
+  ASSERT_FALSE(filter.admit(1));
+}
@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
 
@@ -103,3 +105,45 @@ TEST(StringIdMapTest, recover) {
   ASSERT_EQ(map.testingLastId(), recoverId2);
   ASSERT_EQ(map.pinnedSize(), ::strlen(kRecoverFile1));
 }
+
+TEST(StringIdMapTest, concurrentLeases) {
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumNames = 100;
+  constexpr int32_t kNumIterations = 10'000;
+  StringIdMap map;
+  // Keeps the first half of the names referenced so that their ids stay
+  // fixed while the ids of the other names are freed and made again.
+  std::vector<StringIdLease> pinned;
+  for (auto i = 0; i < kNumNames / 2; ++i) {
+    pinned.emplace_back(map, fmt::format("file_{}", i));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto thread = 0; thread < kNumThreads; ++thread) {
+    threads.emplace_back([&, thread]() {
+      for (auto i = 0; i < kNumIterations; ++i) {
+        const auto index = (i * 7 + thread) % kNumNames;
+        const auto name = fmt::format("file_{}", index);
+        StringIdLease lease(map, name);
+        StringIdLease copy(lease);
+        ASSERT_EQ(name, map.string(copy.id()));
+        ASSERT_EQ(lease.id(), map.id(name));
+        if (index < kNumNames / 2) {
+          ASSERT_EQ(pinned[index].id(), lease.id());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int64_t pinnedSize = 0;
+  for (const auto& lease : pinned) {
+    pinnedSize += map.string(lease.id()).size();
+  }
+  EXPECT_EQ(pinnedSize, map.pinnedSize());
+  EXPECT_EQ(StringIdMap::kNoId, map.id(fmt::format("file_{}", kNumNames - 1)));
+  pinned.clear();
+  EXPECT_EQ(0, map.pinnedSize());
+}
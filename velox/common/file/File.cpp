@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -238,6 +239,24 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::forThread();
+  if (ioUring == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  try {
+    return ioUring->readv(fd_, offset, buffers);
+  } catch (const std::exception& e) {
+    return folly::makeSemiFuture<uint64_t>(e);
+  }
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::available();
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
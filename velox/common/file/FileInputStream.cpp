@@ -16,17 +16,23 @@
 
 #include "velox/common/file/FileInputStream.h"
 
+#include "velox/common/base/AsyncSource.h"
+
 namespace facebook::velox::common {
 
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* readAheadExecutor)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
-      readAheadEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()) {
+      readAheadExecutor_(readAheadExecutor),
+      readAheadEnabled_(
+          (bufferSize_ < fileSize_) &&
+          (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(fileSize_, 0, "Empty FileInputStream");
 
@@ -38,6 +44,10 @@ FileInputStream::FileInputStream(
 }
 
 FileInputStream::~FileInputStream() {
+  if (readAheadSource_ != nullptr) {
+    // Waits for the read into 'buffers_' if it is running.
+    readAheadSource_->close();
+  }
   if (!readAheadWait_.valid()) {
     return;
   }
@@ -68,6 +78,13 @@ void FileInputStream::readNextRange() {
       VELOX_CHECK_LT(
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
       advanceBuffer();
+    } else if (readAheadSource_ != nullptr) {
+      // Reads on this thread if 'readAheadExecutor_' has not started the read.
+      readBytes = *readAheadSource_->move();
+      readAheadSource_.reset();
+      VELOX_CHECK_LT(
+          0, readBytes, "Read past end of FileInputStream {}", fileSize_);
+      advanceBuffer();
     } else {
       readBytes = readSize();
       VELOX_CHECK_LT(
@@ -218,8 +235,18 @@ void FileInputStream::maybeIssueReadahead() {
   }
   std::vector<folly::Range<char*>> ranges;
   ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
-  VELOX_CHECK(readAheadWait_.valid());
+  if (file_->hasPreadvAsync()) {
+    readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
+    VELOX_CHECK(readAheadWait_.valid());
+    return;
+  }
+  VELOX_CHECK_NULL(readAheadSource_);
+  readAheadSource_ = std::make_shared<AsyncSource<uint64_t>>(
+      [file = file_.get(), offset = fileOffset_, ranges]() {
+        return std::make_unique<uint64_t>(file->preadv(offset, ranges));
+      });
+  readAheadExecutor_->add(
+      [source = readAheadSource_]() { source->prepare(); });
 }
 
 void FileInputStream::updateStats(uint64_t readBytes, uint64_t readTimeNs) {
@@ -18,19 +18,29 @@
 
 #include <cstdint>
 
+#include <folly/Executor.h>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/ByteStream.h"
 
+namespace facebook::velox {
+template <typename Item>
+class AsyncSource;
+} // namespace facebook::velox
+
 namespace facebook::velox::common {
 
 /// Readonly byte input stream backed by file.
 class FileInputStream : public ByteInputStream {
  public:
+  /// If 'readAheadExecutor' is set, the next buffer of a file without native
+  /// async read support is read ahead on the executor.
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* readAheadExecutor = nullptr);
 
   ~FileInputStream() override;
 
@@ -77,10 +87,8 @@ class FileInputStream : public ByteInputStream {
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
-  // Issues readahead if underlying file system supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying file system supports async mode read or
+  // 'readAheadExecutor_' is set.
   void maybeIssueReadahead();
 
   inline uint64_t readSize() const;
@@ -112,6 +120,7 @@ class FileInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const readAheadExecutor_;
   const bool readAheadEnabled_;
 
   // Offset of the next byte to read from file.
@@ -122,6 +131,9 @@ class FileInputStream : public ByteInputStream {
   // Sets to read-ahead future if valid.
   folly::SemiFuture<uint64_t> readAheadWait_{
       folly::SemiFuture<uint64_t>::makeEmpty()};
+  // Set to the read-ahead on 'readAheadExecutor_' if not null. Returns the
+  // read size.
+  std::shared_ptr<AsyncSource<uint64_t>> readAheadSource_;
 
   Stats stats_;
 };
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <folly/portability/SysUio.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+DECLARE_bool(velox_io_uring_enabled);
+DECLARE_int32(velox_io_uring_num_rings);
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+
+namespace {
+// Size of the buffer which receives the skipped ranges of a read. Same as
+// LocalReadFile::preadv().
+constexpr size_t kDroppedBytes = 16 * 1024;
+
+// Returns the process wide rings. The rings are never destroyed as the
+// executor threads using them can outlive any static destruction order.
+const std::vector<std::unique_ptr<IoUring>>& rings() {
+  static const auto* rings = []() {
+    auto* rings = new std::vector<std::unique_ptr<IoUring>>();
+    try {
+      for (auto i = 0; i < FLAGS_velox_io_uring_num_rings; ++i) {
+        rings->push_back(
+            std::make_unique<IoUring>(FLAGS_velox_io_uring_queue_depth));
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available: " << e.what();
+      rings->clear();
+    }
+    return rings;
+  }();
+  return *rings;
+}
+} // namespace
+
+struct IoUring::Request {
+  folly::Promise<uint64_t> promise;
+  // The iovecs and file offset of each readv operation. An operation has at
+  // most IOV_MAX iovecs.
+  std::vector<std::vector<iovec>> iovecs;
+  std::vector<uint64_t> offsets;
+  // Receives the skipped ranges.
+  std::vector<char> droppedBytes;
+  // The number of unfinished readv operations. Only accessed by the completion
+  // thread after submission.
+  size_t numPending{0};
+  uint64_t bytesRead{0};
+  int32_t error{0};
+};
+
+IoUring::IoUring(uint32_t queueDepth) {
+  const auto ret = io_uring_queue_init(queueDepth, &ring_, 0);
+  if (ret < 0) {
+    VELOX_FAIL("io_uring_queue_init failed: {}", folly::errnoStr(-ret));
+  }
+  completionThread_ = std::thread([this]() { processCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    // A no-op without request stops the completion thread.
+    std::lock_guard<std::mutex> l(submitMutex_);
+    auto* sqe = getSqeLocked();
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_);
+}
+
+io_uring_sqe* IoUring::getSqeLocked() {
+  io_uring_sqe* sqe;
+  while ((sqe = io_uring_get_sqe(&ring_)) == nullptr) {
+    io_uring_submit(&ring_);
+  }
+  return sqe;
+}
+
+folly::SemiFuture<uint64_t> IoUring::readv(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  auto request = std::make_unique<Request>();
+  auto addIovec = [&](char* data, size_t size) {
+    if (request->iovecs.empty() || request->iovecs.back().size() >= IOV_MAX) {
+      request->iovecs.emplace_back();
+      request->offsets.push_back(offset);
+    }
+    request->iovecs.back().push_back({data, size});
+    offset += size;
+  };
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      addIovec(range.data(), range.size());
+      continue;
+    }
+    if (request->droppedBytes.empty()) {
+      request->droppedBytes.resize(kDroppedBytes);
+    }
+    auto skipSize = range.size();
+    while (skipSize > 0) {
+      const auto bytes = std::min<size_t>(kDroppedBytes, skipSize);
+      addIovec(request->droppedBytes.data(), bytes);
+      skipSize -= bytes;
+    }
+  }
+  if (request->iovecs.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+
+  auto future = request->promise.getSemiFuture();
+  request->numPending = request->iovecs.size();
+  // Owned by the completion thread from here on.
+  auto* submitted = request.release();
+  std::lock_guard<std::mutex> l(submitMutex_);
+  for (auto i = 0; i < submitted->iovecs.size(); ++i) {
+    auto* sqe = getSqeLocked();
+    io_uring_prep_readv(
+        sqe,
+        fd,
+        submitted->iovecs[i].data(),
+        submitted->iovecs[i].size(),
+        submitted->offsets[i]);
+    io_uring_sqe_set_data(sqe, submitted);
+  }
+  int ret;
+  while ((ret = io_uring_submit(&ring_)) == -EBUSY || ret == -EAGAIN ||
+         ret == -EINTR) {
+    std::this_thread::yield();
+  }
+  VELOX_CHECK_GE(ret, 0, "io_uring_submit failed: {}", folly::errnoStr(-ret));
+  return future;
+}
+
+void IoUring::processCompletions() {
+  for (;;) {
+    io_uring_cqe* cqe{nullptr};
+    const auto ret = io_uring_wait_cqe(&ring_, &cqe);
+    if (ret < 0) {
+      if (ret != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-ret);
+      }
+      continue;
+    }
+    auto* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (request == nullptr) {
+      return;
+    }
+    if (result < 0) {
+      request->error = -result;
+    } else {
+      request->bytesRead += result;
+    }
+    if (--request->numPending > 0) {
+      continue;
+    }
+    std::unique_ptr<Request> finished(request);
+    if (finished->error == 0) {
+      finished->promise.setValue(finished->bytesRead);
+      continue;
+    }
+    try {
+      VELOX_FAIL("io_uring readv failed: {}", folly::errnoStr(finished->error));
+    } catch (const std::exception&) {
+      finished->promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+    }
+  }
+}
+
+// static
+IoUring* IoUring::forThread() {
+  if (!FLAGS_velox_io_uring_enabled) {
+    return nullptr;
+  }
+  const auto& allRings = rings();
+  if (allRings.empty()) {
+    return nullptr;
+  }
+  static std::atomic<uint32_t> nextRing{0};
+  thread_local const uint32_t ringIndex = nextRing++;
+  return allRings[ringIndex % allRings.size()].get();
+}
+
+#else
+
+IoUring::IoUring(uint32_t /*queueDepth*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+IoUring::~IoUring() = default;
+
+folly::SemiFuture<uint64_t> IoUring::readv(
+    int32_t /*fd*/,
+    uint64_t /*offset*/,
+    const std::vector<folly::Range<char*>>& /*buffers*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+// static
+IoUring* IoUring::forThread() {
+  return nullptr;
+}
+
+#endif // VELOX_ENABLE_IO_URING
+
+// static
+bool IoUring::available() {
+  return forThread() != nullptr;
+}
+
+} // namespace facebook::velox
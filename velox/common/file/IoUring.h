@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox {
+
+/// Asynchronous file reads through a Linux io_uring submission ring. Each ring
+/// has a completion thread which fulfills the futures of the finished reads,
+/// so the submitting threads never block on I/O. The process has a small set
+/// of rings and each submitting thread always uses the same one, so a ring is
+/// shared by a fixed group of executor threads. The rings are only built if
+/// VELOX_ENABLE_IO_URING is defined.
+class IoUring {
+ public:
+  /// Returns true if io_uring is compiled in, enabled by
+  /// 'velox_io_uring_enabled' and could be set up on this host.
+  static bool available();
+
+  /// Returns the ring used by the calling thread or nullptr if io_uring is not
+  /// available.
+  static IoUring* forThread();
+
+  explicit IoUring(uint32_t queueDepth);
+
+  ~IoUring();
+
+  /// Reads 'buffers' from 'fd' starting at 'offset' and returns the number of
+  /// bytes read. A buffer with nullptr data is skipped over. 'buffers' must
+  /// stay alive until the returned future completes.
+  folly::SemiFuture<uint64_t> readv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+ private:
+#ifdef VELOX_ENABLE_IO_URING
+  struct Request;
+
+  // Gets a free submission queue entry, submitting the queued ones if the
+  // submission queue is full.
+  io_uring_sqe* getSqeLocked();
+
+  // Runs on 'completionThread_' to fulfill the finished requests.
+  void processCompletions();
+
+  std::mutex submitMutex_;
+  io_uring ring_;
+  std::thread completionThread_;
+#endif
+};
+
+} // namespace facebook::velox
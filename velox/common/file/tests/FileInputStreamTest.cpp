@@ -21,6 +21,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
@@ -51,7 +52,8 @@ class FileInputStreamTest : public testing::Test {
 
   std::unique_ptr<common::FileInputStream> createStream(
       uint64_t streamSize,
-      uint32_t bufferSize = 1024) {
+      uint32_t bufferSize = 1024,
+      folly::Executor* readAheadExecutor = nullptr) {
     const auto filePath =
         fmt::format("{}/{}", tempDirPath_->getPath(), fileId_++);
     auto writeFile = fs_->openFileForWrite(filePath);
@@ -63,7 +65,10 @@ class FileInputStreamTest : public testing::Test {
         std::string_view(reinterpret_cast<char*>(buffer), streamSize));
     writeFile->close();
     return std::make_unique<common::FileInputStream>(
-        fs_->openFileForRead(filePath), bufferSize, pool_.get());
+        fs_->openFileForRead(filePath),
+        bufferSize,
+        pool_.get(),
+        readAheadExecutor);
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -112,3 +117,33 @@ TEST_F(FileInputStreamTest, stats) {
     ASSERT_GT(byteStream->stats().readTimeNs, 0);
   }
 }
+
+TEST_F(FileInputStreamTest, readAheadOnExecutor) {
+  // The local file has no native async read. The next buffer is read on the
+  // executor.
+  folly::CPUThreadPoolExecutor executor(2);
+  constexpr size_t kStreamSize = 8192;
+  constexpr size_t kBufferSize = 1024;
+  {
+    auto byteStream = createStream(kStreamSize, kBufferSize, &executor);
+    uint8_t buffer[kBufferSize / 4];
+    for (int offset = 0; offset < kStreamSize;) {
+      byteStream->readBytes(buffer, kBufferSize / 4);
+      for (int i = 0; i < kBufferSize / 4; ++i, ++offset) {
+        ASSERT_EQ(buffer[i], offset % 256);
+      }
+    }
+    ASSERT_TRUE(byteStream->atEnd());
+    ASSERT_EQ(byteStream->stats().numReads, kStreamSize / kBufferSize);
+    ASSERT_EQ(byteStream->stats().readBytes, kStreamSize);
+  }
+
+  // Destroying the stream with a read-ahead in flight.
+  {
+    auto byteStream = createStream(kStreamSize, kBufferSize, &executor);
+    uint8_t buffer[16];
+    byteStream->readBytes(buffer, sizeof(buffer));
+    ASSERT_EQ(buffer[15], 15);
+  }
+  executor.join();
+}
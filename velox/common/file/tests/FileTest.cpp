@@ -105,6 +105,14 @@ void readData(ReadFile* readFile, bool checkFileSize = true) {
   ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
   ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
   ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  std::memset(head, 0, sizeof(head));
+  std::memset(middle, 0, sizeof(middle));
+  std::memset(tail, 0, sizeof(tail));
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
 }
 
 // We could templated this test, but that's kinda overkill for how simple it is.
@@ -190,6 +198,36 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, preadvAsyncManyRanges) {
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  constexpr int32_t kNumRanges = 3'000;
+  std::string data(2 * kNumRanges, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeFile->append(data);
+    writeFile->close();
+  }
+  auto readFile = fs->openFileForRead(filename);
+
+  // Reads every other byte. The number of ranges is above IOV_MAX.
+  std::string result(kNumRanges, 0);
+  std::vector<folly::Range<char*>> buffers;
+  for (auto i = 0; i < kNumRanges; ++i) {
+    buffers.emplace_back(&result[i], 1);
+    buffers.emplace_back(nullptr, (char*)(uint64_t)1);
+  }
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), data.size());
+  for (auto i = 0; i < kNumRanges; ++i) {
+    ASSERT_EQ(result[i], data[2 * i]);
+  }
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
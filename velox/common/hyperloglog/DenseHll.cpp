@@ -143,6 +143,42 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t size) {
+  using Batch = xsimd::batch<uint64_t>;
+  constexpr int32_t kBlockSize = 64;
+  // The bits after the index, with a 1 in the LSB like in
+  // numberOfLeadingZeros().
+  uint64_t valueBits[kBlockSize];
+  uint64_t indices[kBlockSize];
+  const auto marker = Batch::broadcast(1ULL << (indexBitLength_ - 1));
+  const int32_t indexShift = 64 - indexBitLength_;
+
+  for (int32_t start = 0; start < size; start += kBlockSize) {
+    const auto* blockHashes = hashes + start;
+    const auto numHashes = std::min(kBlockSize, size - start);
+    int32_t i = 0;
+    for (; i + Batch::size <= numHashes; i += Batch::size) {
+      const auto batch = Batch::load_unaligned(blockHashes + i);
+      (batch >> indexShift).store_unaligned(indices + i);
+      ((batch << indexBitLength_) | marker).store_unaligned(valueBits + i);
+    }
+    for (; i < numHashes; ++i) {
+      indices[i] = computeIndex(blockHashes[i], indexBitLength_);
+      valueBits[i] = (blockHashes[i] << indexBitLength_) |
+          (1ULL << (indexBitLength_ - 1));
+    }
+
+    for (i = 0; i < numHashes; ++i) {
+      const int8_t value = __builtin_clzll(valueBits[i]) + 1;
+      // Once each bucket has seen a few values, most hashes do not increase
+      // the value of their bucket. 'baseline_' can change in insert().
+      if (value - baseline_ > getDelta(indices[i])) {
+        insert(indices[i], value);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -310,53 +346,65 @@ int DenseHll::findOverflowEntry(int32_t index) const {
 }
 
 void DenseHll::adjustBaselineIfNeeded() {
-  auto numBuckets = 1 << indexBitLength_;
-
   while (baselineCount_ == 0) {
     baseline_++;
 
-    for (int bucket = 0; bucket < numBuckets; ++bucket) {
-      int delta = getDelta(bucket);
-
-      bool hasOverflow = false;
-      if (delta == kMaxDelta) {
-        // scan overflows
-        for (int i = 0; i < overflows_; i++) {
-          if (overflowBuckets_[i] == bucket) {
-            hasOverflow = true;
-            overflowValues_[i]--;
-
-            if (overflowValues_[i] == 0) {
-              int lastEntry = overflows_ - 1;
-              if (i < lastEntry) {
-                // remove the entry by moving the last entry to this position
-                overflowBuckets_[i] = overflowBuckets_[lastEntry];
-                overflowValues_[i] = overflowValues_[lastEntry];
-
-                // clean up to make it easier to catch bugs
-                overflowBuckets_[lastEntry] = 0;
-                overflowValues_[lastEntry] = 0;
-              }
-              overflows_--;
-            }
-            break;
-          }
-        }
+    // All deltas are greater than zero because baselineCount_ is zero, so it
+    // is safe to decrement them.
+    decrementDeltas();
+
+    // The buckets with an overflow keep their delta and decrement the
+    // overflow instead. Goes backwards so that removeOverflow() moves an
+    // already processed entry into the removed one.
+    for (int i = overflows_ - 1; i >= 0; --i) {
+      setDelta(overflowBuckets_[i], kMaxDelta);
+      if (--overflowValues_[i] == 0) {
+        removeOverflow(i);
       }
+    }
 
-      if (!hasOverflow) {
-        // getDelta is guaranteed to return a value greater than zero
-        // because baselineCount is zero (i.e., number of deltas with zero
-        // value) So it's safe to decrement here
-        delta--;
-        setDelta(bucket, delta);
-      }
+    baselineCount_ = countZeroDeltas();
+  }
+}
 
-      if (delta == 0) {
-        ++baselineCount_;
-      }
-    }
+void DenseHll::decrementDeltas() {
+  constexpr auto batchSize = xsimd::batch<int8_t>::size;
+  // Subtracts 1 from both 4-bit deltas of each byte. There is no borrow
+  // between the deltas since both are greater than zero.
+  constexpr int8_t kOnes = (1 << kBitsPerBucket) | 1;
+  const auto onesBatch = xsimd::broadcast(kOnes);
+  int32_t i = 0;
+  for (; i + batchSize <= deltas_.size(); i += batchSize) {
+    auto batch = xsimd::load_unaligned(deltas_.data() + i);
+    xsimd::store_unaligned(deltas_.data() + i, batch - onesBatch);
+  }
+  for (; i < deltas_.size(); ++i) {
+    deltas_[i] -= kOnes;
+  }
+}
+
+int32_t DenseHll::countZeroDeltas() const {
+  constexpr auto batchSize = xsimd::batch<int8_t>::size;
+  const auto bucketMaskBatch = xsimd::broadcast(kBucketMask);
+  const auto zeroBatch = xsimd::broadcast((int8_t)0);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + batchSize <= deltas_.size(); i += batchSize) {
+    const auto batch = xsimd::load_unaligned(deltas_.data() + i);
+    const auto high = xsimd::bitwise_and(
+        xsimd::kernel::bitwise_rshift(batch, 4, xsimd::default_arch{}),
+        bucketMaskBatch);
+    const auto low = xsimd::bitwise_and(batch, bucketMaskBatch);
+    const auto highZeros = xsimd::eq(high, zeroBatch).mask();
+    const auto lowZeros = xsimd::eq(low, zeroBatch).mask();
+    count += bits::countBits(&highZeros, 0, batchSize) +
+        bits::countBits(&lowZeros, 0, batchSize);
+  }
+  for (; i < deltas_.size(); ++i) {
+    count += ((deltas_[i] >> kBitsPerBucket) & kBucketMask) == 0;
+    count += (deltas_[i] & kBucketMask) == 0;
   }
+  return count;
 }
 
 void DenseHll::sortOverflows() {
@@ -517,12 +565,7 @@ DenseHll::DenseHll(const char* serialized, HashStringAllocator* allocator)
         overflowValues_.data());
   }
 
-  baselineCount_ = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (getDelta(i) == 0) {
-      baselineCount_++;
-    }
-  }
+  baselineCount_ = countZeroDeltas();
 }
 
 void DenseHll::mergeWith(const DenseHll& other) {
@@ -48,6 +48,12 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Inserts 'size' hashes. Same as calling insertHash() for each of them,
+  /// but computes the buckets and values of a block of hashes at a time with
+  /// SIMD and skips the hashes which do not increase the value of their
+  /// bucket.
+  void insertHashes(const uint64_t* hashes, int32_t size);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -101,6 +107,12 @@ class DenseHll {
 
   void adjustBaselineIfNeeded();
 
+  // Subtracts 1 from all deltas. All deltas must be greater than zero.
+  void decrementDeltas();
+
+  // Returns the number of zero deltas.
+  int32_t countZeroDeltas() const;
+
   void sortOverflows();
 
   int8_t updateOverflow(int32_t index, int overflowEntry, int8_t delta);
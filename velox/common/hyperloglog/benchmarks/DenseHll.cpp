@@ -43,6 +43,31 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    for (int32_t i = 0; i < 1'000'000; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
+  }
+
+  // Inserts 1M hashes one at a time or in batches of 1024.
+  void runInsert(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    if (batch) {
+      for (auto i = 0; i < hashes_.size(); i += 1024) {
+        hll.insertHashes(
+            hashes_.data() + i, std::min<int32_t>(1024, hashes_.size() - i));
+      }
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
   }
 
   void run(int hashBits) {
@@ -82,6 +107,8 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
@@ -100,6 +127,24 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(insertHash11) {
+  benchmark->runInsert(11, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes11) {
+  benchmark->runInsert(11, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->runInsert(16, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->runInsert(16, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -225,6 +225,37 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  // Sizes which are not a multiple of the SIMD width or the block size,
+  // enough hashes for the baseline to move and hashes with leading zeros.
+  for (auto size : {1, 3, 9, 100, 1'000, 500'000}) {
+    std::vector<uint64_t> hashes;
+    hashes.reserve(size);
+    for (auto i = 0; i < size; ++i) {
+      auto hash = hashOne(i);
+      hashes.push_back(i % 17 == 0 ? hash >> (i % 40) : hash);
+    }
+
+    DenseHll expected{indexBitLength, &allocator_};
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+
+    DenseHll denseHll{indexBitLength, &allocator_};
+    // Inserts in batches of varying sizes.
+    for (auto start = 0; start < size;) {
+      auto batchSize = std::min<int32_t>(size - start, 1 + start % 777);
+      denseHll.insertHashes(hashes.data() + start, batchSize);
+      start += batchSize;
+    }
+
+    ASSERT_EQ(denseHll.cardinality(), expected.cardinality()) << size;
+    ASSERT_EQ(serialize(denseHll), serialize(expected)) << size;
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
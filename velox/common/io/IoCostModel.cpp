@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoCostModel.h"
+#include "velox/common/io/IoStatistics.h"
+
+#include <folly/container/F14Map.h>
+
+#include <algorithm>
+#include <string>
+
+namespace facebook::velox::io {
+
+// static
+std::shared_ptr<IoCostModel> IoCostModel::forPath(std::string_view path) {
+  static std::mutex mutex;
+  static folly::F14FastMap<std::string, std::shared_ptr<IoCostModel>> models;
+  const std::string scheme(IoStatistics::storageBackend(path));
+  std::lock_guard<std::mutex> l(mutex);
+  auto& model = models[scheme];
+  if (model == nullptr) {
+    model = std::make_shared<IoCostModel>();
+  }
+  return model;
+}
+
+void IoCostModel::recordRead(uint64_t bytes, uint64_t us) {
+  const double x = bytes;
+  const double y = us;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  sumWeights_ = sumWeights_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumUs_ = sumUs_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesUs_ = sumBytesUs_ * kDecay + x * y;
+}
+
+std::pair<double, double> IoCostModel::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return estimateLocked();
+}
+
+std::pair<double, double> IoCostModel::estimateLocked() const {
+  if (numReads_ < kMinReads) {
+    return {0, 0};
+  }
+  const double variance =
+      sumWeights_ * sumBytesSquared_ - sumBytes_ * sumBytes_;
+  // The sizes of the reads must vary to tell latency from transfer time.
+  if (variance <= 1e-6 * sumWeights_ * sumBytesSquared_) {
+    return {0, 0};
+  }
+  const double usPerByte =
+      (sumWeights_ * sumBytesUs_ - sumBytes_ * sumUs_) / variance;
+  if (usPerByte <= 0) {
+    return {0, 0};
+  }
+  const double latencyUs =
+      std::max(0.0, (sumUs_ - usPerByte * sumBytes_) / sumWeights_);
+  return {latencyUs, 1 / usPerByte};
+}
+
+int32_t IoCostModel::coalesceDistance(int32_t defaultDistance) const {
+  const auto [latencyUs, bytesPerUs] = estimate();
+  if (bytesPerUs == 0) {
+    return defaultDistance;
+  }
+  return std::clamp<double>(
+      latencyUs * bytesPerUs, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
+} // namespace facebook::velox::io
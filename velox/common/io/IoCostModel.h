@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace facebook::velox::io {
+
+/// Estimates the per request latency and the bandwidth of a storage system
+/// from measured reads and derives the read coalescing distance from them.
+/// Reading a gap of 'gap' bytes between two ranges costs 'gap' / bandwidth and
+/// saves one request, so the break-even gap is latency * bandwidth. This is
+/// megabytes for object storage and a few kilobytes for local NVMe. Thread
+/// safe.
+class IoCostModel {
+ public:
+  /// Bounds of coalesceDistance().
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 8 << 20;
+
+  /// Returns the process wide model of the file system of 'path'. The file
+  /// system is identified by the scheme of 'path', e.g. 's3' for
+  /// 's3://bucket/key'. Paths without a scheme are local files.
+  static std::shared_ptr<IoCostModel> forPath(std::string_view path);
+
+  /// Records a read of 'bytes' that took 'us' microseconds.
+  void recordRead(uint64_t bytes, uint64_t us);
+
+  /// Returns the break-even coalescing distance in bytes, clamped to
+  /// [kMinCoalesceDistance, kMaxCoalesceDistance]. Returns 'defaultDistance'
+  /// until enough reads of different sizes are recorded.
+  int32_t coalesceDistance(int32_t defaultDistance) const;
+
+  /// Returns the estimated latency in microseconds and the bandwidth in bytes
+  /// per microsecond. Both are 0 while unknown.
+  std::pair<double, double> estimate() const;
+
+ private:
+  // Weight of the previous reads relative to a new read. Makes the estimate
+  // follow changes in storage load.
+  static constexpr double kDecay = 0.99;
+  // Min number of reads for an estimate.
+  static constexpr int32_t kMinReads = 16;
+
+  std::pair<double, double> estimateLocked() const;
+
+  mutable std::mutex mutex_;
+  int64_t numReads_{0};
+  // Decayed sums for the least squares fit of time = latency + bytes /
+  // bandwidth.
+  double sumWeights_{0};
+  double sumBytes_{0};
+  double sumUs_{0};
+  double sumBytesSquared_{0};
+  double sumBytesUs_{0};
+};
+
+} // namespace facebook::velox::io
@@ -108,6 +108,98 @@ IoStatistics::operationStats() const {
   return operationStats_;
 }
 
+namespace {
+std::mutex& globalStorageReadStatsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, StorageReadStats>& globalStorageReads() {
+  static std::unordered_map<std::string, StorageReadStats> stats;
+  return stats;
+}
+
+void addStorageRead(
+    std::unordered_map<std::string, StorageReadStats>& stats,
+    std::string_view backend,
+    bool prefetch,
+    uint64_t bytes,
+    uint64_t latencyUs) {
+  auto& backendStats = stats[std::string(backend)];
+  (prefetch ? backendStats.prefetch : backendStats.demand)
+      .add(bytes, latencyUs);
+}
+} // namespace
+
+// static
+std::string_view IoStatistics::storageBackend(std::string_view path) {
+  const auto schemeEnd = path.find("://");
+  if (schemeEnd == std::string_view::npos) {
+    return "file";
+  }
+  return path.substr(0, schemeEnd);
+}
+
+// static
+std::unordered_map<std::string, StorageReadStats>
+IoStatistics::globalStorageReadStats() {
+  std::lock_guard<std::mutex> l(globalStorageReadStatsMutex());
+  return globalStorageReads();
+}
+
+void IoStatistics::incStorageRead(
+    std::string_view backend,
+    bool prefetch,
+    uint64_t bytes,
+    uint64_t latencyUs) {
+  {
+    std::lock_guard<std::mutex> l(storageReadStatsMutex_);
+    addStorageRead(storageReadStats_, backend, prefetch, bytes, latencyUs);
+  }
+  std::lock_guard<std::mutex> l(globalStorageReadStatsMutex());
+  addStorageRead(globalStorageReads(), backend, prefetch, bytes, latencyUs);
+}
+
+std::unordered_map<std::string, StorageReadStats>
+IoStatistics::storageReadStats() const {
+  std::lock_guard<std::mutex> l(storageReadStatsMutex_);
+  return storageReadStats_;
+}
+
+void StorageReadCounters::add(uint64_t readBytes, uint64_t readLatencyUs) {
+  ++count;
+  bytes += readBytes;
+  latencyUs += readLatencyUs;
+  bytesHistogram.addValue(readBytes);
+  latencyUsHistogram.addValue(readLatencyUs);
+}
+
+void StorageReadCounters::merge(const StorageReadCounters& other) {
+  count += other.count;
+  bytes += other.bytes;
+  latencyUs += other.latencyUs;
+  bytesHistogram.merge(other.bytesHistogram);
+  latencyUsHistogram.merge(other.latencyUsHistogram);
+}
+
+void StorageReadCounters::subtract(const StorageReadCounters& other) {
+  count -= other.count;
+  bytes -= other.bytes;
+  latencyUs -= other.latencyUs;
+  bytesHistogram.subtract(other.bytesHistogram);
+  latencyUsHistogram.subtract(other.latencyUsHistogram);
+}
+
+void StorageReadStats::merge(const StorageReadStats& other) {
+  demand.merge(other.demand);
+  prefetch.merge(other.prefetch);
+}
+
+void StorageReadStats::subtract(const StorageReadStats& other) {
+  demand.subtract(other.demand);
+  prefetch.subtract(other.prefetch);
+}
+
 void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
@@ -119,9 +211,17 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
-  std::lock_guard<std::mutex> l(operationStatsMutex_);
-  for (auto& item : other.operationStats_) {
-    operationStats_[item.first].merge(item.second);
+  {
+    std::lock_guard<std::mutex> l(operationStatsMutex_);
+    for (auto& item : other.operationStats_) {
+      operationStats_[item.first].merge(item.second);
+    }
+  }
+  // The reads of 'other' are already in the global stats.
+  const auto otherStorageReadStats = other.storageReadStats();
+  std::lock_guard<std::mutex> l(storageReadStatsMutex_);
+  for (const auto& [backend, stats] : otherStorageReadStats) {
+    storageReadStats_[backend].merge(stats);
   }
 }
 
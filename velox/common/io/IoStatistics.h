@@ -20,10 +20,13 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <folly/dynamic.h>
 
+#include "velox/common/base/RuntimeMetrics.h"
+
 namespace facebook::velox::io {
 
 struct OperationCounters {
@@ -89,8 +92,72 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// An IoCounter of latencies which also keeps their distribution for
+/// percentiles.
+class IoLatencyCounter : public IoCounter {
+ public:
+  void increment(uint64_t amount) {
+    IoCounter::increment(amount);
+    histogram_.addValue(amount);
+  }
+
+  void merge(const IoLatencyCounter& other) {
+    IoCounter::merge(other);
+    histogram_.merge(other.histogram_);
+  }
+
+  const RuntimeHistogram& histogram() const {
+    return histogram_;
+  }
+
+ private:
+  RuntimeHistogram histogram_;
+};
+
+/// Reads of one kind from one storage backend, with the distributions of
+/// their sizes and latencies.
+struct StorageReadCounters {
+  uint64_t count{0};
+  uint64_t bytes{0};
+  uint64_t latencyUs{0};
+  RuntimeHistogram bytesHistogram;
+  RuntimeHistogram latencyUsHistogram;
+
+  void add(uint64_t readBytes, uint64_t readLatencyUs);
+
+  void merge(const StorageReadCounters& other);
+
+  /// Removes the reads of 'other', e.g. an earlier copy of this.
+  void subtract(const StorageReadCounters& other);
+};
+
+/// The reads from one storage backend.
+struct StorageReadStats {
+  /// Reads of data the reader is waiting for.
+  StorageReadCounters demand;
+  /// Reads ahead of use, e.g. coalesced loads issued before the data is
+  /// needed.
+  StorageReadCounters prefetch;
+
+  void merge(const StorageReadStats& other);
+
+  void subtract(const StorageReadStats& other);
+};
+
 class IoStatistics {
  public:
+  /// The storage backend of the reads from SSD cache.
+  static constexpr std::string_view kSsdCacheBackend{"ssd"};
+
+  /// Returns the storage backend of 'path', which is its scheme, e.g. "s3" for
+  /// 's3://bucket/key', or "file" for a path without a scheme.
+  static std::string_view storageBackend(std::string_view path);
+
+  /// Returns the reads recorded by all IoStatistics in the process by storage
+  /// backend.
+  static std::unordered_map<std::string, StorageReadStats>
+  globalStorageReadStats();
+
   uint64_t rawBytesRead() const;
   uint64_t rawOverreadBytes() const;
   uint64_t rawBytesWritten() const;
@@ -123,7 +190,7 @@ class IoStatistics {
     return ramHit_;
   }
 
-  IoCounter& queryThreadIoLatency() {
+  IoLatencyCounter& queryThreadIoLatency() {
     return queryThreadIoLatency_;
   }
 
@@ -141,6 +208,17 @@ class IoStatistics {
 
   std::unordered_map<std::string, OperationCounters> operationStats() const;
 
+  /// Records a read of 'bytes' from storage 'backend' which took 'latencyUs'.
+  /// 'prefetch' is true for a read ahead of use.
+  void incStorageRead(
+      std::string_view backend,
+      bool prefetch,
+      uint64_t bytes,
+      uint64_t latencyUs);
+
+  /// Returns the reads by storage backend.
+  std::unordered_map<std::string, StorageReadStats> storageReadStats() const;
+
   void merge(const IoStatistics& other);
 
   folly::dynamic getOperationStatsSnapshot() const;
@@ -169,10 +247,13 @@ class IoStatistics {
 
   // Time spent by a query processing thread waiting for synchronously issued IO
   // or for an in-progress read-ahead to finish.
-  IoCounter queryThreadIoLatency_;
+  IoLatencyCounter queryThreadIoLatency_;
 
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
+
+  std::unordered_map<std::string, StorageReadStats> storageReadStats_;
+  mutable std::mutex storageReadStatsMutex_;
 };
 
 } // namespace facebook::velox::io
@@ -98,6 +98,14 @@ class ReaderOptions {
     return *this;
   }
 
+  /// If true, the load coalesce distance follows the latency and bandwidth
+  /// measured on the file system of the file and the maximum load coalesce
+  /// distance is only used until there are enough measurements.
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
   /// Modifies the maximum load coalesce bytes.
   ReaderOptions& setMaxCoalesceBytes(int64_t bytes) {
     maxCoalesceBytes_ = bytes;
@@ -110,6 +118,13 @@ class ReaderOptions {
     return *this;
   }
 
+  /// Limits the total compressed size of the row groups loaded ahead of the
+  /// current one. 0 means no limit.
+  ReaderOptions& setMaxPrefetchRowGroupBytes(int64_t bytes) {
+    maxPrefetchRowGroupBytes_ = bytes;
+    return *this;
+  }
+
   /// Gets the memory allocator.
   velox::memory::MemoryPool& memoryPool() const {
     return *memoryPool_;
@@ -131,6 +146,10 @@ class ReaderOptions {
     return maxCoalesceDistance_;
   }
 
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
+
   int64_t maxCoalesceBytes() const {
     return maxCoalesceBytes_;
   }
@@ -139,6 +158,10 @@ class ReaderOptions {
     return prefetchRowGroups_;
   }
 
+  int64_t maxPrefetchRowGroupBytes() const {
+    return maxPrefetchRowGroupBytes_;
+  }
+
   bool noCacheRetention() const {
     return noCacheRetention_;
   }
@@ -153,8 +176,10 @@ class ReaderOptions {
   PrefetchMode prefetchMode_;
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
+  bool adaptiveCoalesce_{false};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  int64_t maxPrefetchRowGroupBytes_{0};
   bool noCacheRetention_{false};
 };
 } // namespace facebook::velox::io
@@ -123,6 +123,21 @@ std::optional<ScopedArbitrationParticipant> ArbitrationParticipant::lock() {
   return ScopedArbitrationParticipant(shared_from_this(), std::move(sharedPtr));
 }
 
+uint64_t ArbitrationParticipant::minCapacity() const {
+  const auto* reclaimer = pool_->reclaimer();
+  if (reclaimer == nullptr) {
+    return config_->minCapacity;
+  }
+  return std::max(
+      config_->minCapacity,
+      std::min(reclaimer->guaranteedCapacity(), maxCapacity_));
+}
+
+int32_t ArbitrationParticipant::priority() const {
+  const auto* reclaimer = pool_->reclaimer();
+  return reclaimer == nullptr ? 0 : reclaimer->priority();
+}
+
 uint64_t ArbitrationParticipant::maxGrowCapacity() const {
   const auto capacity = pool_->capacity();
   VELOX_CHECK_LE(capacity, maxCapacity_);
@@ -131,10 +146,11 @@ uint64_t ArbitrationParticipant::maxGrowCapacity() const {
 
 uint64_t ArbitrationParticipant::minGrowCapacity() const {
   const auto capacity = pool_->capacity();
-  if (capacity >= config_->minCapacity) {
+  const auto minCapacityBytes = minCapacity();
+  if (capacity >= minCapacityBytes) {
     return 0;
   }
-  return config_->minCapacity - capacity;
+  return minCapacityBytes - capacity;
 }
 
 bool ArbitrationParticipant::inactivePool() const {
@@ -157,10 +173,11 @@ uint64_t ArbitrationParticipant::maxReclaimableCapacity() const {
     return pool_->capacity();
   }
   const uint64_t capacityBytes = pool_->capacity();
-  if (capacityBytes < config_->minCapacity) {
+  const uint64_t minCapacityBytes = minCapacity();
+  if (capacityBytes < minCapacityBytes) {
     return 0;
   }
-  return capacityBytes - config_->minCapacity;
+  return capacityBytes - minCapacityBytes;
 }
 
 uint64_t ArbitrationParticipant::reclaimableUsedCapacity() const {
@@ -206,6 +223,14 @@ void ArbitrationParticipant::getGrowTargets(
     }
   }
   maxGrowBytes = std::max(requestBytes, maxGrowBytes);
+  const uint64_t forecastBytes = pool_->growthForecast();
+  if (forecastBytes > 0) {
+    const uint64_t freeBytes = pool_->freeBytes();
+    if (forecastBytes > freeBytes) {
+      maxGrowBytes =
+          std::max(maxGrowBytes, requestBytes + forecastBytes - freeBytes);
+    }
+  }
   minGrowBytes = minGrowCapacity();
   maxGrowBytes = std::max(maxGrowBytes, minGrowBytes);
   maxGrowBytes = std::min(maxGrowCapacity(), maxGrowBytes);
@@ -246,6 +271,9 @@ void ArbitrationParticipant::finishArbitration(ArbitrationOperation* op) {
   {
     std::lock_guard<std::mutex> l(stateLock_);
     VELOX_CHECK_EQ(static_cast<void*>(op), static_cast<void*>(runningOp_));
+    const auto opStats = op->stats();
+    arbitrationWaitTimeNs_ += opStats.localArbitrationWaitTimeNs +
+        opStats.globalArbitrationWaitTimeNs;
     if (!waitOps_.empty()) {
       resumePromise = std::move(waitOps_.front().waitPromise);
       runningOp_ = waitOps_.front().op;
@@ -365,13 +393,14 @@ size_t ArbitrationParticipant::numWaitingOps() const {
 
 std::string ArbitrationParticipant::Stats::toString() const {
   return fmt::format(
-      "numRequests: {}, numReclaims: {}, numShrinks: {}, numGrows: {}, reclaimedBytes: {}, growBytes: {}, aborted: {}, duration: {}",
+      "numRequests: {}, numReclaims: {}, numShrinks: {}, numGrows: {}, reclaimedBytes: {}, growBytes: {}, arbitrationWaitTime: {}, aborted: {}, duration: {}",
       numRequests,
       numReclaims,
       numShrinks,
       numGrows,
       succinctBytes(reclaimedBytes),
       succinctBytes(growBytes),
+      succinctNanos(arbitrationWaitTimeNs),
       aborted,
       succinctNanos(durationNs));
 }
@@ -389,6 +418,7 @@ ArbitrationCandidate::ArbitrationCandidate(
     ScopedArbitrationParticipant&& _participant,
     bool freeCapacityOnly)
     : participant(std::move(_participant)),
+      priority(participant->priority()),
       currentCapacity(participant->capacity()),
       reclaimableUsedCapacity(
           freeCapacityOnly ? 0 : participant->reclaimableUsedCapacity()),
@@ -396,8 +426,9 @@ ArbitrationCandidate::ArbitrationCandidate(
 
 std::string ArbitrationCandidate::toString() const {
   return fmt::format(
-      "{} RECLAIMABLE_USED_CAPACITY {} RECLAIMABLE_FREE_CAPACITY {}",
+      "{} PRIORITY {} RECLAIMABLE_USED_CAPACITY {} RECLAIMABLE_FREE_CAPACITY {}",
       participant->name(),
+      priority,
       succinctBytes(reclaimableUsedCapacity),
       succinctBytes(reclaimableFreeCapacity));
 }
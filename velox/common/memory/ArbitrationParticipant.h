@@ -175,10 +175,16 @@ class ArbitrationParticipant
     return maxCapacity_;
   }
 
-  /// Returns the min capacity of the underlying query memory pool.
-  uint64_t minCapacity() const {
-    return config_->minCapacity;
-  }
+  /// Returns the min capacity of the underlying query memory pool. It is the
+  /// larger one of 'minCapacity' in 'config_' and the guaranteed capacity
+  /// reported by the memory reclaimer of the query memory pool, capped by the
+  /// max capacity.
+  uint64_t minCapacity() const;
+
+  /// Returns the memory arbitration priority reported by the memory reclaimer
+  /// of the query memory pool. The arbitrator reclaims used memory from the
+  /// participants with the lowest priority first.
+  int32_t priority() const;
 
   /// Returns the duration of this arbitration participant since its creation.
   uint64_t durationNs() const {
@@ -214,7 +220,10 @@ class ArbitrationParticipant
   /// capacity and certain headroom free capacity after shrink. Both targets are
   /// set to a coarser granularity to reduce the number of unnecessary future
   /// memory arbitration requests. The parameters used to set the targets are
-  /// defined in 'config_'.
+  /// defined in 'config_'. If the leaf memory pools of the query have reported
+  /// growth forecasts, 'maxGrowBytes' also covers the forecast memory that
+  /// doesn't fit in the current free capacity so that the query can grow to
+  /// its next phase need with one memory arbitration.
   void getGrowTargets(
       uint64_t requestBytes,
       uint64_t& maxGrowBytes,
@@ -285,6 +294,10 @@ class ArbitrationParticipant
     uint32_t numGrows{0};
     uint64_t reclaimedBytes{0};
     uint64_t growBytes{0};
+    /// The total time the arbitration operations of this participant have
+    /// spent in waiting for the prior operations of the same participant and
+    /// for the global arbitration.
+    uint64_t arbitrationWaitTimeNs{0};
     bool aborted{false};
 
     std::string toString() const;
@@ -300,6 +313,7 @@ class ArbitrationParticipant
     stats.numReclaims = numReclaims_;
     stats.reclaimedBytes = reclaimedBytes_;
     stats.growBytes = growBytes_;
+    stats.arbitrationWaitTimeNs = arbitrationWaitTimeNs_;
     return stats;
   }
 
@@ -364,6 +378,7 @@ class ArbitrationParticipant
   tsan_atomic<uint32_t> numGrows_{0};
   tsan_atomic<uint64_t> reclaimedBytes_{0};
   tsan_atomic<uint64_t> growBytes_{0};
+  tsan_atomic<uint64_t> arbitrationWaitTimeNs_{0};
 
   mutable std::timed_mutex reclaimMutex_;
 
@@ -405,6 +420,7 @@ class ScopedArbitrationParticipant {
 /// decisions.
 struct ArbitrationCandidate {
   ScopedArbitrationParticipant participant;
+  int32_t priority{0};
   int64_t currentCapacity{0};
   int64_t reclaimableUsedCapacity{0};
   int64_t reclaimableFreeCapacity{0};
@@ -319,7 +319,7 @@ void ByteOutputStream::flush(OutputStream* out) {
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    out->writeRange(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
   }
   if (isBits_ && isReverseBitOrder_) {
     isReversed_ = true;
@@ -444,33 +444,109 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::enableZeroCopy(
+    std::shared_ptr<StreamArena> owner,
+    int32_t minBytes) {
+  VELOX_CHECK_GT(minBytes, 0);
+  zeroCopy_ = true;
+  zeroCopyOwner_ = std::move(owner);
+  minZeroCopyBytes_ = minBytes;
+}
+
+void IOBufOutputStream::writeRange(const char* s, std::streamsize count) {
+  if (!zeroCopy_ || count < minZeroCopyBytes_) {
+    write(s, count);
+    return;
+  }
+  const int64_t offset = out_->tellp();
+  VELOX_CHECK(
+      externalRanges_.empty() || externalRanges_.back().offset <= offset,
+      "Referenced ranges must be written in order");
+  externalRanges_.push_back({offset, s, count});
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
     const std::function<void()>& releaseFn) {
   // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+  // 'arena_'. The IOBufs of the referenced ranges are inserted between them
+  // and keep shared ownership of 'zeroCopyOwner_'.
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
-    auto userData = newFreeData(arena_, releaseFn);
-    auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+  auto append = [&](std::unique_ptr<folly::IOBuf> newBuf) {
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
+  };
+  auto appendOwn = [&](uint8_t* data, int64_t size) {
+    if (size > 0) {
+      append(folly::IOBuf::takeOwnership(
+          reinterpret_cast<char*>(data),
+          size,
+          freeFunc,
+          newFreeData(arena_, releaseFn)));
+    }
+  };
+  auto externalRange = externalRanges_.begin();
+  auto appendExternal = [&]() {
+    append(folly::IOBuf::takeOwnership(
+        const_cast<char*>(externalRange->data),
+        externalRange->size,
+        freeFunc,
+        newFreeData(zeroCopyOwner_, releaseFn)));
+    ++externalRange;
+  };
+
+  auto& ranges = out_->ranges();
+  int64_t rangeOffset = 0;
+  for (auto& range : ranges) {
+    auto numValues =
+        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+    int64_t written = 0;
+    while (externalRange != externalRanges_.end() &&
+           externalRange->offset <= rangeOffset + numValues) {
+      const int64_t split = externalRange->offset - rangeOffset;
+      appendOwn(range.buffer + written, split - written);
+      written = split;
+      appendExternal();
+    }
+    appendOwn(range.buffer + written, numValues - written);
+    rangeOffset += numValues;
+  }
+  while (externalRange != externalRanges_.end()) {
+    appendExternal();
   }
   return iobuf;
 }
 
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  const int64_t offset = out_->tellp();
+  int64_t externalBytes = 0;
+  for (const auto& range : externalRanges_) {
+    if (range.offset > offset) {
+      break;
+    }
+    externalBytes += range.size;
+  }
+  return offset + externalBytes;
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  const int64_t offset = pos;
+  int64_t externalBytes = 0;
+  for (const auto& range : externalRanges_) {
+    const int64_t start = range.offset + externalBytes;
+    if (offset < start) {
+      break;
+    }
+    VELOX_CHECK_GE(
+        offset, start + range.size, "Cannot seek into a referenced range");
+    externalBytes += range.size;
+  }
+  out_->seekp(offset - externalBytes);
 }
 
 } // namespace facebook::velox
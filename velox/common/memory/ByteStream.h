@@ -58,6 +58,13 @@ class OutputStream {
 
   virtual void write(const char* s, std::streamsize count) = 0;
 
+  /// Writes the 'count' bytes at 's' like write(). 's' is a range of a
+  /// ByteOutputStream, so that a stream which can keep the arena of the range
+  /// alive may reference it instead of copying it.
+  virtual void writeRange(const char* s, std::streamsize count) {
+    write(s, count);
+  }
+
   virtual std::streampos tellp() const = 0;
 
   virtual void seekp(std::streampos pos) = 0;
@@ -341,6 +348,8 @@ class ByteOutputStream {
     append(folly::Range(&value, 1));
   }
 
+  /// Writes the content of 'this' to 'stream' with
+  /// OutputStream::writeRange().
   void flush(OutputStream* stream);
 
   /// Returns the next byte that would be written to by a write. This
@@ -476,17 +485,54 @@ class IOBufOutputStream : public OutputStream {
     }
   }
 
+  /// References the range instead of copying it if zero copy is enabled and
+  /// the range has at least 'minZeroCopyBytes' bytes.
+  void writeRange(const char* s, std::streamsize count) override;
+
   std::streampos tellp() const override;
 
+  /// 'pos' must not be inside a referenced range.
   void seekp(std::streampos pos) override;
 
+  /// Makes writeRange() reference ranges of 'minBytes' or more in the IOBufs
+  /// returned by getIOBuf() instead of copying them. The IOBufs of referenced
+  /// ranges keep shared ownership of 'owner', to which the caller moves the
+  /// memory of the ranges with StreamArena::moveAllocationsTo() after the
+  /// writes. 'owner' may be nullptr if the memory outlives the IOBufs.
+  void enableZeroCopy(
+      std::shared_ptr<StreamArena> owner,
+      int32_t minBytes = kMinZeroCopyBytes);
+
+  /// Returns true if writeRange() referenced a range instead of copying it.
+  bool hasReferencedRanges() const {
+    return !externalRanges_.empty();
+  }
+
   /// 'releaseFn' is executed on iobuf destruction if not null.
   std::unique_ptr<folly::IOBuf> getIOBuf(
       const std::function<void()>& releaseFn = nullptr);
 
+  /// Default minimum size of a range referenced by writeRange(). Smaller
+  /// ranges are cheaper to copy than to wrap in an IOBuf.
+  static constexpr int32_t kMinZeroCopyBytes = 4 << 10;
+
  private:
+  // A range written by writeRange() without copying.
+  struct ExternalRange {
+    // Bytes in 'out_' before the range.
+    int64_t offset;
+    const char* data;
+    int64_t size;
+  };
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
+
+  bool zeroCopy_{false};
+  int32_t minZeroCopyBytes_{kMinZeroCopyBytes};
+  std::shared_ptr<StreamArena> zeroCopyOwner_;
+  // Ranges referenced by writeRange() in order of 'offset'.
+  std::vector<ExternalRange> externalRanges_;
 };
 
 } // namespace facebook::velox
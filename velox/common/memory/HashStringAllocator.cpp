@@ -59,6 +59,9 @@ std::string HashStringAllocator::Header::toString() {
   if (isFree()) {
     out << "|free| ";
   }
+  if (isSizeClass()) {
+    out << "|size class| ";
+  }
   if (isContinued()) {
     out << "|multipart| ";
   }
@@ -75,7 +78,7 @@ std::string HashStringAllocator::Header::toString() {
   if (isPreviousFree()) {
     out << ", previous is free (" << *previousFreeSize(this) << " bytes)";
   }
-  if (next() == nullptr) {
+  if (!isSizeClass() && next() == nullptr) {
     out << ", at end";
   }
   return out.str();
@@ -100,6 +103,18 @@ void HashStringAllocator::clear() {
   for (auto i = 0; i < kNumFreeLists; ++i) {
     new (&state_.freeLists()[i]) CompactDoubleList();
   }
+  for (auto* run : state_.sizeClassRuns()) {
+    pool()->free(run, kSizeClassRunSize);
+  }
+  state_.sizeClassRuns().clear();
+  std::fill(
+      std::begin(state_.sizeClassFreeLists()),
+      std::end(state_.sizeClassFreeLists()),
+      nullptr);
+  state_.sizeClassRunPosition() = nullptr;
+  state_.sizeClassRunEnd() = nullptr;
+  state_.currentBytes() -= state_.sizeClassBytes();
+  state_.sizeClassBytes() = 0;
 
 #ifndef NDEBUG
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
@@ -370,6 +385,10 @@ StringView HashStringAllocator::contiguousString(
 }
 
 void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
+  if (header->isSizeClass()) {
+    // The size of a size class block is fixed.
+    return;
+  }
   keepBytes = std::max(keepBytes, kMinAlloc);
   const int32_t freeSize = header->size() - keepBytes - kHeaderSize;
   if (freeSize <= kMinAlloc) {
@@ -385,6 +404,54 @@ int32_t HashStringAllocator::freeListIndex(int size) {
   return std::min(size - kMinAlloc, kNumFreeLists - 1);
 }
 
+// static
+int32_t HashStringAllocator::sizeClassIndex(int32_t size) {
+  VELOX_DCHECK_LE(size, kMaxSizeClassAlloc);
+  int32_t index = 0;
+  while (kSizeClassStrides[index] - static_cast<int32_t>(kHeaderSize) < size) {
+    ++index;
+  }
+  return index;
+}
+
+HashStringAllocator::Header* HashStringAllocator::allocateFromSizeClass(
+    int32_t size) {
+  const auto index = sizeClassIndex(size);
+  auto& freeList = state_.sizeClassFreeLists()[index];
+  Header* header = freeList;
+  if (header != nullptr) {
+    VELOX_CHECK(header->isFree());
+    freeList = *reinterpret_cast<Header**>(header->begin());
+    header->clearFree();
+  } else {
+    const auto stride = kSizeClassStrides[index];
+    if (state_.sizeClassRunEnd() - state_.sizeClassRunPosition() < stride) {
+      auto* run = reinterpret_cast<char*>(pool()->allocate(kSizeClassRunSize));
+      state_.sizeClassRuns().push_back(run);
+      // The payload after the first header is 8 byte aligned.
+      state_.sizeClassRunPosition() = run + sizeof(void*) - kHeaderSize;
+      state_.sizeClassRunEnd() = run + kSizeClassRunSize;
+    }
+    header = new (state_.sizeClassRunPosition()) Header(stride - kHeaderSize);
+    header->setSizeClass();
+    state_.sizeClassRunPosition() += stride;
+  }
+  state_.sizeClassBytes() += blockBytes(header);
+  state_.currentBytes() += blockBytes(header);
+  return header;
+}
+
+void HashStringAllocator::freeToSizeClass(Header* header) {
+  VELOX_CHECK(header->isSizeClass());
+  VELOX_CHECK(!header->isFree(), "Double free of size class block");
+  auto& freeList = state_.sizeClassFreeLists()[sizeClassIndex(header->size())];
+  header->setFree();
+  *reinterpret_cast<Header**>(header->begin()) = freeList;
+  freeList = header;
+  state_.sizeClassBytes() -= blockBytes(header);
+  state_.currentBytes() -= blockBytes(header);
+}
+
 void HashStringAllocator::removeFromFreeList(Header* header) {
   VELOX_CHECK(header->isFree());
   header->clearFree();
@@ -398,6 +465,9 @@ void HashStringAllocator::removeFromFreeList(Header* header) {
 HashStringAllocator::Header* HashStringAllocator::allocate(
     int32_t size,
     bool exactSize) {
+  if (exactSize && size <= kMaxSizeClassAlloc && state_.useSizeClasses()) {
+    return allocateFromSizeClass(size);
+  }
   if (size > kMaxAlloc && exactSize) {
     VELOX_CHECK_LE(size, Header::kSizeMask);
     auto* header = castToHeader(allocateFromPool(size + kHeaderSize));
@@ -472,7 +542,10 @@ void HashStringAllocator::free(Header* header) {
       continued = headerToFree->nextContinued();
       headerToFree->clearContinued();
     }
-    if (headerToFree->size() > kMaxAlloc &&
+    if (headerToFree->isSizeClass()) {
+      freeToSizeClass(headerToFree);
+    } else if (
+        headerToFree->size() > kMaxAlloc &&
         !state_.pool().isInCurrentRange(headerToFree) &&
         state_.allocationsFromPool().find(headerToFree) !=
             state_.allocationsFromPool().end()) {
@@ -648,6 +721,14 @@ void HashStringAllocator::copyMultipartNoInline(
     char* group,
     int32_t offset) {
   const auto numBytes = srcStr.size();
+  if (numBytes <= kMaxSizeClassAlloc && state_.useSizeClasses()) {
+    auto* header =
+        allocateFromSizeClass(std::max<int32_t>(numBytes, kMinAlloc));
+    simd::memcpy(header->begin(), srcStr.data(), numBytes);
+    *reinterpret_cast<StringView*>(group + offset) =
+        StringView(header->begin(), numBytes);
+    return;
+  }
   if (storeStringFast(srcStr.data(), numBytes, group + offset)) {
     return;
   }
@@ -672,6 +753,10 @@ std::string HashStringAllocator::toString() const {
   out << "standalone allocations: " << state_.sizeFromPool() << " bytes in "
       << state_.allocationsFromPool().size() << " allocations" << std::endl;
   out << "ranges: " << state_.pool().numRanges() << std::endl;
+  if (state_.useSizeClasses()) {
+    out << "size classes: " << state_.sizeClassBytes() << " bytes in "
+        << state_.sizeClassRuns().size() << " runs" << std::endl;
+  }
 
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
@@ -787,6 +872,22 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   VELOX_CHECK_EQ(numInFreeList, state_.numFree());
   VELOX_CHECK_EQ(bytesInFreeList, state_.freeBytes());
+
+  uint64_t sizeClassFreeBytes = 0;
+  for (auto i = 0; i < kNumSizeClasses; ++i) {
+    for (auto* free = state_.sizeClassFreeLists()[i]; free != nullptr;
+         free = *reinterpret_cast<Header**>(free->begin())) {
+      VELOX_CHECK(free->isSizeClass());
+      VELOX_CHECK(free->isFree());
+      VELOX_CHECK_EQ(
+          blockBytes(free), static_cast<size_t>(kSizeClassStrides[i]));
+      sizeClassFreeBytes += blockBytes(free);
+    }
+  }
+  VELOX_CHECK_LE(
+      state_.sizeClassBytes() + sizeClassFreeBytes,
+      state_.sizeClassRuns().size() * kSizeClassRunSize);
+  allocatedBytes += state_.sizeClassBytes();
   return allocatedBytes;
 }
 
@@ -24,6 +24,9 @@
 #include "velox/type/StringView.h"
 
 #include <folly/container/F14Map.h>
+#include <gflags/gflags.h>
+
+DECLARE_bool(velox_hash_string_allocator_size_classes);
 
 namespace facebook::velox {
 
@@ -39,6 +42,14 @@ namespace facebook::velox {
 /// immediately below is free. In this case the uint32_t below the header has
 /// the size of the previous free block. The last word of a Allocation::PageRun
 /// backing a HashStringAllocator is set to kArenaEnd.
+///
+/// In size class mode, allocations of up to kMaxSizeClassAlloc bytes of a
+/// fixed size, i.e. allocate() and short strings, come from a few size classes
+/// instead. These blocks are carved by bump allocation from runs allocated
+/// from pool() outside of the arena and have kSizeClass set in their Header. A
+/// freed block goes to the free list of its size class without coalescing, so
+/// that freeing and reallocating small blocks does not split and merge the
+/// arena. Writes through ByteOutputStream and larger blocks use the arena.
 class HashStringAllocator : public StreamArena {
  public:
   /// The minimum allocation must have space after the header for the free list
@@ -50,12 +61,16 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kMaxAlloc =
       memory::AllocationTraits::kPageSize / 4 * 3;
 
+  /// Sizes up to this come from the size classes in size class mode.
+  static constexpr int32_t kMaxSizeClassAlloc = 260;
+
   class Header {
    public:
     static constexpr uint32_t kFree = 1U << 31;
     static constexpr uint32_t kContinued = 1U << 30;
     static constexpr uint32_t kPreviousFree = 1U << 29;
-    static constexpr uint32_t kSizeMask = (1U << 29) - 1;
+    static constexpr uint32_t kSizeClass = 1U << 28;
+    static constexpr uint32_t kSizeMask = (1U << 28) - 1;
     static constexpr uint32_t kContinuedPtrSize = sizeof(void*);
 
     /// Marker at end of a PageRun. Distinct from valid headers since all the 3
@@ -78,6 +93,11 @@ class HashStringAllocator : public StreamArena {
       return (data_ & kPreviousFree) != 0;
     }
 
+    /// True if this block comes from a size class and not from the arena.
+    bool isSizeClass() const {
+      return (data_ & kSizeClass) != 0;
+    }
+
     void setContinued() {
       data_ |= kContinued;
     }
@@ -90,6 +110,10 @@ class HashStringAllocator : public StreamArena {
       data_ |= kPreviousFree;
     }
 
+    void setSizeClass() {
+      data_ |= kSizeClass;
+    }
+
     void clearContinued() {
       data_ &= ~kContinued;
     }
@@ -175,7 +199,14 @@ class HashStringAllocator : public StreamArena {
   };
 
   explicit HashStringAllocator(memory::MemoryPool* pool)
-      : StreamArena(pool), state_(pool) {}
+      : HashStringAllocator(
+            pool,
+            FLAGS_velox_hash_string_allocator_size_classes) {}
+
+  /// If 'useSizeClasses' is true, small fixed size allocations come from size
+  /// classes. See the class comment.
+  HashStringAllocator(memory::MemoryPool* pool, bool useSizeClasses)
+      : StreamArena(pool), state_(pool, useSizeClasses) {}
 
   ~HashStringAllocator();
 
@@ -303,7 +334,13 @@ class HashStringAllocator : public StreamArena {
 
   /// Returns the total memory footprint of 'this'.
   int64_t retainedSize() const {
-    return state_.pool().allocatedBytes() + state_.sizeFromPool();
+    return state_.pool().allocatedBytes() + state_.sizeFromPool() +
+        state_.sizeClassRuns().size() * kSizeClassRunSize;
+  }
+
+  /// Returns true if small allocations come from size classes.
+  bool useSizeClasses() const {
+    return state_.useSizeClasses();
   }
 
   /// Adds the allocation of 'header' and any extensions (if header has
@@ -363,6 +400,17 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
   static constexpr uint32_t kHeaderSize = sizeof(Header);
 
+  // Distance between consecutive blocks of each size class, including the
+  // Header. These are multiples of 8 so that the payload of all the blocks in
+  // a run is 8 byte aligned.
+  static constexpr int32_t kSizeClassStrides[] = {
+      24, 32, 48, 64, 96, 128, 192, kMaxSizeClassAlloc + kHeaderSize};
+  static constexpr int32_t kNumSizeClasses =
+      sizeof(kSizeClassStrides) / sizeof(kSizeClassStrides[0]);
+
+  // Size of the runs from which size class blocks are bump allocated.
+  static constexpr int32_t kSizeClassRunSize = 64 << 10;
+
   void newRange(
       int32_t bytes,
       ByteRange* lastRange,
@@ -412,13 +460,25 @@ class HashStringAllocator : public StreamArena {
   // Returns the free list index for 'size'.
   int32_t freeListIndex(int size);
 
+  // Returns the smallest size class with at least 'size' payload bytes.
+  static int32_t sizeClassIndex(int32_t size);
+
+  // Allocates a block of at least 'size' bytes from its size class. This
+  // pops the free list of the size class or bump allocates from the current
+  // size class run.
+  Header* allocateFromSizeClass(int32_t size);
+
+  // Adds the size class block of 'header' to the free list of its size class.
+  void freeToSizeClass(Header* header);
+
   /// A class that wraps any fields in the HashStringAllocator, it's main
   /// purpose is to simplify the freeze/unfreeze mechanic.  Fields are exposed
   /// via accessor methods, attempting to invoke a non-const accessor when the
   /// HashStringAllocator is frozen will cause an exception to be thrown.
   class State {
    public:
-    explicit State(memory::MemoryPool* pool) : pool_(pool) {}
+    State(memory::MemoryPool* pool, bool useSizeClasses)
+        : pool_(pool), useSizeClasses_(useSizeClasses) {}
 
     void freeze() {
       VELOX_CHECK(
@@ -466,6 +526,7 @@ class HashStringAllocator : public StreamArena {
     typedef CompactDoubleList FreeList[kNumFreeLists];
     typedef uint64_t FreeNonEmptyBitMap[bits::nwords(kNumFreeLists)];
     typedef folly::F14FastMap<void*, size_t> AllocationsFromPool;
+    typedef Header* SizeClassFreeLists[kNumSizeClasses];
 
     // Circular list of free blocks.
     DECLARE_FIELD(FreeList, freeLists);
@@ -500,6 +561,24 @@ class HashStringAllocator : public StreamArena {
     // Sum of sizes in 'allocationsFromPool_'.
     DECLARE_FIELD_WITH_INIT_VALUE(int64_t, sizeFromPool, 0);
 
+    // True if small allocations come from size classes.
+    DECLARE_FIELD(bool, useSizeClasses);
+
+    // Head of the singly linked list of free blocks of each size class. The
+    // next pointer is the first word of a free block.
+    DECLARE_FIELD_WITH_INIT_VALUE(SizeClassFreeLists, sizeClassFreeLists, {});
+
+    // Runs of kSizeClassRunSize bytes allocated from pool() for size classes.
+    DECLARE_FIELD(std::vector<void*>, sizeClassRuns);
+
+    // Position of the next Header and end of the unused part of the last run
+    // in 'sizeClassRuns_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(char*, sizeClassRunPosition, nullptr);
+    DECLARE_FIELD_WITH_INIT_VALUE(char*, sizeClassRunEnd, nullptr);
+
+    // Sum of the size of the allocated size class blocks, including headers.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, sizeClassBytes, 0);
+
 #undef DECLARE_FIELD_WITH_INIT_VALUE
 #undef DECLARE_FIELD
 #undef DECLARE_GETTERS
@@ -84,6 +84,11 @@ struct MemoryManagerOptions {
   /// Disables the memory manager's tracking on memory pools.
   bool disableMemoryPoolTracking{false};
 
+  /// If not zero, the thread-safe leaf memory pools cache up to twice this
+  /// many reserved bytes per thread to reduce the lock contention of
+  /// concurrent small allocations. See MemoryPool::Options::threadCacheBytes.
+  int64_t memoryPoolThreadCacheBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
 
   /// Specifies the max memory allocation capacity in bytes enforced by
@@ -112,6 +117,18 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, backs the MmapArenas and the size classes whose page size is a
+  /// multiple of the huge page size with transparent huge pages.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool useMmapHugePages{false};
+
+  /// If true, keeps MmapArenas per NUMA node and serves the large contiguous
+  /// allocations from the arenas local to the CPU of the allocating thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator with 'useMmapArena' set.
+  bool numaAwareMmapArenas{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -303,6 +320,7 @@ class MemoryManager {
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
   const bool disableMemoryPoolTracking_;
+  const int64_t memoryPoolThreadCacheBytes_;
 
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
@@ -342,6 +342,22 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the memory arbitration priority of the query memory pool which
+  /// owns this reclaimer. When it needs to reclaim used memory by spilling or
+  /// abort, the memory arbitrator picks the victims from the query memory
+  /// pools with the lowest priority first. The default priority is zero.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
+  /// Returns the memory capacity guaranteed to the query memory pool which
+  /// owns this reclaimer. The memory arbitrator grows the query memory pool to
+  /// at least this capacity, and doesn't shrink or reclaim it below this
+  /// capacity unless the query is aborted.
+  virtual uint64_t guaranteedCapacity() const {
+    return 0;
+  }
+
  protected:
   MemoryReclaimer() = default;
 };
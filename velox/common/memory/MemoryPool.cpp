@@ -227,8 +227,10 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadCacheBytes_(options.threadCacheBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
+  VELOX_CHECK_GE(threadCacheBytes_, 0);
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
   MemoryAllocator::alignmentCheck(0, alignment_);
@@ -279,6 +281,23 @@ uint64_t MemoryPool::getChildCount() const {
   return children_.size();
 }
 
+void MemoryPool::setGrowthForecast(uint64_t bytes) {
+  VELOX_CHECK(isLeaf(), "Only leaf memory pool can set growth forecast");
+  growthForecastBytes_ = bytes;
+}
+
+uint64_t MemoryPool::growthForecast() const {
+  if (isLeaf()) {
+    return growthForecastBytes_;
+  }
+  uint64_t forecastBytes{0};
+  visitChildren([&](MemoryPool* pool) {
+    forecastBytes += pool->growthForecast();
+    return true;
+  });
+  return forecastBytes;
+}
+
 void MemoryPool::visitChildren(
     const std::function<bool(MemoryPool*)>& visitor) const {
   std::vector<std::shared_ptr<MemoryPool>> children;
@@ -429,9 +448,16 @@ MemoryPoolImpl::MemoryPoolImpl(
       // actually used memory arbitration policy.
       capacity_(parent_ != nullptr ? kMaxMemory : 0) {
   VELOX_CHECK(options.threadSafe || isLeaf());
+  if (isLeaf() && trackUsage_ && threadSafe_ && threadCacheBytes_ > 0) {
+    threadCaches_ =
+        std::make_unique<folly::ThreadLocal<ThreadCache, ThreadCacheTag>>(
+            [this]() { return new ThreadCache(this); });
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  flushThreadCaches();
+  threadCaches_.reset();
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -735,7 +761,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .threadCacheBytes = threadCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -763,7 +790,12 @@ bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
 void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
-      reserveThreadSafe(size, reserveOnly);
+      if (threadCaches_ != nullptr && !reserveOnly &&
+          static_cast<int64_t>(size) <= threadCacheBytes_) {
+        reserveThreadCached(size);
+      } else {
+        reserveThreadSafe(size, reserveOnly);
+      }
     } else {
       reserveNonThreadSafe(size, reserveOnly);
     }
@@ -817,6 +849,31 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   }
 }
 
+void MemoryPoolImpl::reserveThreadCached(uint64_t size) {
+  auto& cachedBytes = (*threadCaches_)->bytes;
+  const int64_t bytesToTake = size;
+  int64_t bytes = cachedBytes.load(std::memory_order_relaxed);
+  while (bytes >= bytesToTake) {
+    if (cachedBytes.compare_exchange_weak(bytes, bytes - bytesToTake)) {
+      return;
+    }
+  }
+  // NOTE: the cache refill is accounted as used and cumulative bytes of this
+  // memory pool when it is reserved.
+  try {
+    reserveThreadSafe(size + threadCacheBytes_);
+  } catch (const std::exception&) {
+    if (aborted()) {
+      std::rethrow_exception(std::current_exception());
+    }
+    // Retry without the refill as the memory pool might be close to its
+    // capacity limit.
+    reserveThreadSafe(size);
+    return;
+  }
+  cachedBytes.fetch_add(threadCacheBytes_);
+}
+
 bool MemoryPoolImpl::incrementReservationThreadSafe(
     MemoryPool* requestor,
     uint64_t size) {
@@ -911,13 +968,19 @@ void MemoryPoolImpl::incrementReservationLocked(uint64_t bytes) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  flushThreadCaches();
   release(0, true);
 }
 
 void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
-      releaseThreadSafe(size, releaseOnly);
+      if (threadCaches_ != nullptr && !releaseOnly &&
+          static_cast<int64_t>(size) <= threadCacheBytes_) {
+        releaseThreadCached(size);
+      } else {
+        releaseThreadSafe(size, releaseOnly);
+      }
     } else {
       releaseNonThreadSafe(size, releaseOnly);
     }
@@ -956,6 +1019,42 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   }
 }
 
+void MemoryPoolImpl::releaseThreadCached(uint64_t size) {
+  auto& cachedBytes = (*threadCaches_)->bytes;
+  int64_t bytes = cachedBytes.fetch_add(size) + size;
+  if (FOLLY_LIKELY(bytes <= 2 * threadCacheBytes_)) {
+    return;
+  }
+  while (bytes > threadCacheBytes_ &&
+         !cachedBytes.compare_exchange_weak(bytes, threadCacheBytes_)) {
+  }
+  // 'bytes' is below 'threadCacheBytes_' if the cache has been concurrently
+  // flushed.
+  if (bytes > threadCacheBytes_) {
+    releaseThreadSafe(bytes - threadCacheBytes_, false);
+  }
+}
+
+void MemoryPoolImpl::flushThreadCaches() {
+  if (threadCaches_ == nullptr) {
+    return;
+  }
+  int64_t flushBytes{0};
+  for (auto& cache : threadCaches_->accessAllThreads()) {
+    flushBytes += cache.bytes.exchange(0);
+  }
+  if (flushBytes > 0) {
+    releaseThreadSafe(flushBytes, false);
+  }
+}
+
+MemoryPoolImpl::ThreadCache::~ThreadCache() {
+  const auto cachedBytes = bytes.exchange(0);
+  if (cachedBytes > 0) {
+    pool->releaseThreadSafe(cachedBytes, false);
+  }
+}
+
 void MemoryPoolImpl::decrementReservation(uint64_t size) noexcept {
   VELOX_CHECK_GT(size, 0);
 
@@ -1055,6 +1154,8 @@ uint64_t MemoryPoolImpl::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
     memory::MemoryReclaimer::Stats& stats) {
+  // Returns the thread cached reservations to make them reclaimable.
+  flushThreadCaches();
   if (reclaimer() == nullptr) {
     return 0;
   }
@@ -21,6 +21,7 @@
 #include <optional>
 
 #include <fmt/format.h>
+#include <folly/ThreadLocal.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -159,6 +160,17 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If not zero, a thread-safe leaf memory pool keeps a per-thread cache of
+    /// up to twice this many reserved bytes. The allocations and frees of up
+    /// to this size from a thread are then served from its cache without
+    /// taking the memory pool lock, and the cache is refilled or trimmed in
+    /// units of this size. The cached bytes are counted as used by the memory
+    /// pool. They are returned to the memory pool on release(), on memory
+    /// reclaim, on thread exit and on memory pool destruction.
+    ///
+    /// NOTE: this is inherited by all the child memory pools.
+    int64_t threadCacheBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -357,6 +369,18 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// usage.
   virtual void release() = 0;
 
+  /// Sets the forecast of the memory in bytes this leaf memory pool is going to
+  /// allocate in its next processing phase, e.g. the hash table size of a hash
+  /// build operator. The memory arbitrator grows the query memory pool capacity
+  /// by the forecasts of all its leaf memory pools in one arbitration round.
+  /// The user sets the forecast back to zero once the memory is allocated.
+  void setGrowthForecast(uint64_t bytes);
+
+  /// Returns the memory growth forecast of this leaf memory pool. For non-leaf
+  /// memory pool, it returns the aggregated forecasts of all its leaf memory
+  /// pools.
+  uint64_t growthForecast() const;
+
   /// Memory arbitration related interfaces.
 
   /// Returns the free memory capacity in bytes that haven't been reserved for
@@ -542,6 +566,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t threadCacheBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -549,6 +574,9 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// NOTE: this flag is only set for a root memory pool if it has memory
   /// reclaimer. We process a query abort request from the root memory pool.
   std::atomic<bool> aborted_{false};
+
+  /// The memory growth forecast set by setGrowthForecast().
+  std::atomic<uint64_t> growthForecastBytes_{0};
   /// Saves the aborted error exception which is only set if 'aborted_' is true.
   std::exception_ptr abortError_{nullptr};
 
@@ -819,6 +847,11 @@ class MemoryPoolImpl : public MemoryPool {
 
   void reserveThreadSafe(uint64_t size, bool reserveOnly = false);
 
+  // Reserves 'size' bytes for an allocation from the calling thread's cache of
+  // reserved bytes. Refills the cache from the memory pool if it has less than
+  // 'size' bytes.
+  void reserveThreadCached(uint64_t size);
+
   // Increments the reservation and checks against limits at root tracker. Calls
   // root tracker's 'growCallback_' if it is set and limit exceeded. Should be
   // called without holding 'mutex_'. This function returns true if reservation
@@ -872,6 +905,14 @@ class MemoryPoolImpl : public MemoryPool {
 
   void releaseThreadSafe(uint64_t size, bool releaseOnly);
 
+  // Returns 'size' bytes of a freed allocation to the calling thread's cache of
+  // reserved bytes. Trims the cache to 'threadCacheBytes_' if it holds more
+  // than twice that size.
+  void releaseThreadCached(uint64_t size);
+
+  // Returns the cached reserved bytes of all the threads to this memory pool.
+  void flushThreadCaches();
+
   // Invoked to grow capacity of the root memory pool from the memory
   // arbitrator. 'requestor' is the leaf memory pool that triggers the memory
   // capacity growth. 'size' is the memory capacity growth in bytes.
@@ -1044,6 +1085,25 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // The reserved bytes cached by a thread for a thread-safe leaf memory pool.
+  // Only the owning thread takes bytes from the cache. The flushes from the
+  // other threads exchange the cached bytes with zero.
+  struct ThreadCache {
+    explicit ThreadCache(MemoryPoolImpl* _pool) : pool(_pool) {}
+
+    // Returns the cached bytes to 'pool' on thread exit.
+    ~ThreadCache();
+
+    MemoryPoolImpl* const pool;
+    std::atomic<int64_t> bytes{0};
+  };
+  struct ThreadCacheTag {};
+
+  // Set if 'threadCacheBytes_' is not zero for a thread-safe leaf memory pool
+  // with usage tracking.
+  std::unique_ptr<folly::ThreadLocal<ThreadCache, ThreadCacheTag>>
+      threadCaches_;
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic_uint64_t numAllocs_{0};
@@ -37,15 +37,24 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size, size, options.useHugePages));
   }
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
-    managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+    const auto numNodes = options.numaAwareArenas ? numNumaNodes() : 1;
+    for (auto node = 0; node < numNodes; ++node) {
+      auto nodeArenas = std::make_unique<NodeArenas>();
+      nodeArenas->arenas = std::make_unique<ManagedMmapArenas>(
+          std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes),
+          options.useHugePages,
+          options.numaAwareArenas ? std::optional<int32_t>(node)
+                                  : std::nullopt);
+      nodeArenas_.push_back(std::move(nodeArenas));
+    }
   }
 }
 
@@ -250,8 +259,7 @@ bool MmapAllocator::allocateContiguousImpl(
   if (numLargeCollateralPages > 0) {
     useHugePages(allocation, false);
     if (useMmapArena_) {
-      std::lock_guard<std::mutex> l(arenaMutex_);
-      managedArenas_->free(allocation.data(), allocation.maxSize());
+      freeToArenas(allocation);
     } else {
       if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
@@ -327,8 +335,9 @@ bool MmapAllocator::allocateContiguousImpl(
     data = nullptr;
   } else {
     if (useMmapArena_) {
-      std::lock_guard<std::mutex> l(arenaMutex_);
-      data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+      auto& nodeArenas = allocationArenas();
+      std::lock_guard<std::mutex> l(nodeArenas.mutex);
+      data = nodeArenas.arenas->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
       data = ::mmap(
           nullptr,
@@ -372,8 +381,7 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   }
   useHugePages(allocation, false);
   if (useMmapArena_) {
-    std::lock_guard<std::mutex> l(arenaMutex_);
-    managedArenas_->free(allocation.data(), allocation.maxSize());
+    freeToArenas(allocation);
   } else {
     if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
@@ -497,6 +505,25 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
   }
 }
 
+MmapAllocator::NodeArenas& MmapAllocator::allocationArenas() {
+  if (nodeArenas_.size() == 1) {
+    return *nodeArenas_[0];
+  }
+  return *nodeArenas_[currentNumaNode() % nodeArenas_.size()];
+}
+
+void MmapAllocator::freeToArenas(const ContiguousAllocation& allocation) {
+  for (auto& nodeArenas : nodeArenas_) {
+    std::lock_guard<std::mutex> l(nodeArenas->mutex);
+    if (nodeArenas_.size() == 1 ||
+        nodeArenas->arenas->contains(allocation.data())) {
+      nodeArenas->arenas->free(allocation.data(), allocation.maxSize());
+      return;
+    }
+  }
+  VELOX_FAIL("Allocation not in MmapArenas: {}", allocation.toString());
+}
+
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
   for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
@@ -509,7 +536,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -523,14 +553,13 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
-  void* ptr = mmap(
-      nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  if (ptr == MAP_FAILED || ptr == nullptr) {
+  void* ptr = mmapAnonymous(
+      byteSize_,
+      useHugePages &&
+          AllocationTraits::pageBytes(unitSize_) %
+                  AllocationTraits::kHugePageSize ==
+              0);
+  if (ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory "
         "mmap failed with {} for sizeClass {}",
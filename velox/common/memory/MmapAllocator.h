@@ -66,6 +66,20 @@ class MmapAllocator : public MemoryAllocator {
     /// capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio = 10;
 
+    /// If true, the size classes whose page size is a multiple of the huge page
+    /// size and the MmapArenas are mapped at huge page aligned addresses and
+    /// are backed by transparent huge pages. The smaller size classes are not
+    /// as advising away their pages would split the huge pages.
+    bool useHugePages = false;
+
+    /// If true, keeps one set of MmapArenas per NUMA node whose memory is
+    /// preferably allocated from that node. A contiguous allocation is served
+    /// from the arenas of the NUMA node of the CPU that the calling thread runs
+    /// on.
+    ///
+    /// NOTE: this only applies if 'useMmapArena' is true.
+    bool numaAwareArenas = false;
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations. And those allocations are
     /// delegated to std::malloc.
@@ -168,7 +182,12 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'useHugePages' is true and the size class page size is a multiple of
+    // the huge page size, the address range is backed by huge pages.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        bool useHugePages = false);
 
     ~SizeClass();
 
@@ -416,10 +435,22 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAdvisedPages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
+  // The MmapArenas of one NUMA node.
+  struct NodeArenas {
+    std::mutex mutex;
+    std::unique_ptr<ManagedMmapArenas> arenas;
+  };
+
+  // Returns the arenas to allocate from for the calling thread.
+  NodeArenas& allocationArenas();
+
+  // Frees 'allocation' to the arenas that contain it.
+  void freeToArenas(const ContiguousAllocation& allocation);
+
   // Allocations that are larger than largest size classes will be delegated to
-  // ManagedMmapArenas, to avoid calling mmap on every allocation.
-  std::mutex arenaMutex_;
-  std::unique_ptr<ManagedMmapArenas> managedArenas_;
+  // ManagedMmapArenas, to avoid calling mmap on every allocation. Has one entry
+  // per NUMA node if 'numaAwareArenas' is set and one entry otherwise.
+  std::vector<std::unique_ptr<NodeArenas>> nodeArenas_;
 
   std::shared_ptr<Cache> cache_;
 };
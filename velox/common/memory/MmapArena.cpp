@@ -17,28 +17,125 @@
 #include "velox/common/memory/MmapArena.h"
 
 #include <sys/mman.h>
+#include <unistd.h>
+#ifdef linux
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+// Sets the memory policy of the range to prefer the pages from 'node'.
+void preferNumaNode(void* address, uint64_t bytes, int32_t node) {
+#ifdef linux
+  VELOX_CHECK_LT(node, 64);
+  const uint64_t nodeMask = 1ULL << node;
+  // NOTE: the kernel takes one more than the number of bits in the mask.
+  if (::syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          MPOL_PREFERRED,
+          &nodeMask,
+          sizeof(nodeMask) * 8 + 1,
+          0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "mbind to NUMA node " << node
+                           << " got errno " << folly::errnoStr(errno);
+  }
+#endif
+}
+} // namespace
+
+void* mmapAnonymous(uint64_t bytes, bool useHugePages) {
+  if (!useHugePages) {
+    void* ptr = ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+  VELOX_CHECK_EQ(bytes % AllocationTraits::kPageSize, 0);
+  // Maps one more huge page and unmaps the unaligned head and tail.
+  const uint64_t mapBytes = bytes + AllocationTraits::kHugePageSize;
+  void* ptr = ::mmap(
+      nullptr,
+      mapBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto begin = reinterpret_cast<uintptr_t>(ptr);
+  const auto alignedBegin =
+      bits::roundUp(begin, AllocationTraits::kHugePageSize);
+  if (alignedBegin > begin) {
+    ::munmap(ptr, alignedBegin - begin);
+  }
+  const auto end = begin + mapBytes;
+  const auto alignedEnd = alignedBegin + bytes;
+  if (end > alignedEnd) {
+    ::munmap(reinterpret_cast<void*>(alignedEnd), end - alignedEnd);
+  }
+  void* result = reinterpret_cast<void*>(alignedBegin);
+#ifdef linux
+  if (::madvise(result, bytes, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
+                           << folly::errnoStr(errno);
+  }
+#endif
+  return result;
+}
+
+int32_t numNumaNodes() {
+  static const int32_t numNodes = []() {
+    int32_t count = 0;
+#ifdef linux
+    while (::access(
+               fmt::format("/sys/devices/system/node/node{}", count).c_str(),
+               F_OK) == 0) {
+      ++count;
+    }
+#endif
+    return std::max<int32_t>(count, 1);
+  }();
+  return numNodes;
+}
+
+int32_t currentNumaNode() {
+#ifdef linux
+  uint32_t cpu;
+  uint32_t node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return std::min<int32_t>(node, numNumaNodes() - 1);
+  }
+#endif
+  return 0;
+}
+
 uint64_t MmapArena::roundBytes(uint64_t bytes) {
   return bits::nextPowerOfTwo(bytes);
 }
 
-MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
+MmapArena::MmapArena(
+    size_t capacityBytes,
+    bool useHugePages,
+    std::optional<int32_t> numaNode)
+    : byteSize_(capacityBytes) {
   VELOX_CHECK_EQ(
       byteSize_ % kMinGrainSizeBytes,
       0,
       "Arena must have a multiple of {} bytes capacity.",
       kMinGrainSizeBytes);
-  void* ptr = mmap(
-      nullptr,
-      capacityBytes,
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  if (ptr == MAP_FAILED || ptr == nullptr) {
+  void* ptr = mmapAnonymous(capacityBytes, useHugePages);
+  if (ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory"
         "mmap failed with errno {} with capacity bytes {}",
@@ -46,6 +143,9 @@ MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
         capacityBytes);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode.has_value()) {
+    preferNumaNode(address_, byteSize_, numaNode.value());
+  }
   addFreeBlock(reinterpret_cast<uintptr_t>(address_), byteSize_);
   freeBytes_ = byteSize_;
 }
@@ -277,9 +377,15 @@ std::string MmapArena::toString() const {
       freeList_.size());
 }
 
-ManagedMmapArenas::ManagedMmapArenas(uint64_t singleArenaCapacity)
-    : singleArenaCapacity_(singleArenaCapacity) {
-  auto arena = std::make_shared<MmapArena>(singleArenaCapacity);
+ManagedMmapArenas::ManagedMmapArenas(
+    uint64_t singleArenaCapacity,
+    bool useHugePages,
+    std::optional<int32_t> numaNode)
+    : singleArenaCapacity_(singleArenaCapacity),
+      useHugePages_(useHugePages),
+      numaNode_(numaNode) {
+  auto arena = std::make_shared<MmapArena>(
+      singleArenaCapacity_, useHugePages_, numaNode_);
   arenas_.emplace(reinterpret_cast<uintptr_t>(arena->address()), arena);
   currentArena_ = arena;
 }
@@ -293,7 +399,8 @@ void* ManagedMmapArenas::allocate(uint64_t bytes) {
   // If first allocation fails we create a new MmapArena for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // MmapArena's capacity. No further attempts will happen.
-  auto newArena = std::make_shared<MmapArena>(singleArenaCapacity_);
+  auto newArena = std::make_shared<MmapArena>(
+      singleArenaCapacity_, useHugePages_, numaNode_);
   arenas_.emplace(reinterpret_cast<uintptr_t>(newArena->address()), newArena);
   currentArena_ = newArena;
   return currentArena_->allocate(bytes);
@@ -313,4 +420,14 @@ void ManagedMmapArenas::free(void* address, uint64_t bytes) {
     arenas_.erase(iter);
   }
 }
+
+bool ManagedMmapArenas::contains(const void* address) const {
+  const auto addressU64 = reinterpret_cast<uintptr_t>(address);
+  auto iter = arenas_.upper_bound(addressU64);
+  if (iter == arenas_.begin()) {
+    return false;
+  }
+  --iter;
+  return addressU64 < iter->first + singleArenaCapacity_;
+}
 } // namespace facebook::velox::memory
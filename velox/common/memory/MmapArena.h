@@ -20,12 +20,24 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include "velox/common/memory/MemoryAllocator.h"
 
 namespace facebook::velox::memory {
 
+/// Maps 'bytes' of anonymous memory. If 'useHugePages' is true, the mapping is
+/// aligned to AllocationTraits::kHugePageSize and advised to be backed by
+/// transparent huge pages. Returns nullptr on failure with 'errno' set.
+void* mmapAnonymous(uint64_t bytes, bool useHugePages);
+
+/// Returns the number of NUMA nodes of this machine, or 1 if it is not known.
+int32_t numNumaNodes();
+
+/// Returns the NUMA node of the CPU the calling thread runs on.
+int32_t currentNumaNode();
+
 class MmapArena {
  public:
   /// Single MmapArena capacity is determined by mmap_arena_capacity_ratio ratio
@@ -36,7 +48,13 @@ class MmapArena {
   /// MmapArena capacity should be multiple of kMinGrainSizeBytes.
   static constexpr uint64_t kMinGrainSizeBytes = 1024 * 1024; // 1M
 
-  explicit MmapArena(size_t capacityBytes);
+  /// If 'useHugePages' is true, the arena is backed by transparent huge pages.
+  /// If 'numaNode' is set, the memory of the arena is preferably allocated
+  /// from that NUMA node.
+  explicit MmapArena(
+      size_t capacityBytes,
+      bool useHugePages = false,
+      std::optional<int32_t> numaNode = std::nullopt);
   ~MmapArena();
 
   void* allocate(uint64_t bytes);
@@ -124,12 +142,20 @@ class MmapArena {
 /// fragmentation happens.
 class ManagedMmapArenas {
  public:
-  explicit ManagedMmapArenas(uint64_t singleArenaCapacity);
+  /// 'useHugePages' and 'numaNode' apply to all the managed MmapArenas. See
+  /// MmapArena.
+  explicit ManagedMmapArenas(
+      uint64_t singleArenaCapacity,
+      bool useHugePages = false,
+      std::optional<int32_t> numaNode = std::nullopt);
 
   void* allocate(uint64_t bytes);
 
   void free(void* address, uint64_t bytes);
 
+  /// Returns true if 'address' is in one of the managed MmapArenas.
+  bool contains(const void* address) const;
+
   const std::map<uintptr_t, std::shared_ptr<MmapArena>>& arenas() const {
     return arenas_;
   }
@@ -137,6 +163,8 @@ class ManagedMmapArenas {
  private:
   // Capacity in bytes for a single MmapArena managed by this.
   const uint64_t singleArenaCapacity_;
+  const bool useHugePages_;
+  const std::optional<int32_t> numaNode_;
 
   // A sorted list of MmapArena by its initial address
   std::map<uintptr_t, std::shared_ptr<MmapArena>> arenas_;
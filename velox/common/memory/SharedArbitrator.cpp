@@ -389,6 +389,9 @@ void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
         kLocalArbitrationWaitWallNanos,
         RuntimeCounter(
             stats.localArbitrationWaitTimeNs, RuntimeCounter::Unit::kNanos));
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricArbitratorLocalArbitrationWaitTimeMs,
+        stats.localArbitrationWaitTimeNs / 1'000'000);
   }
   if (stats.localArbitrationExecTimeNs != 0) {
     addThreadLocalRuntimeStat(
@@ -500,6 +503,9 @@ void SharedArbitrator::sortCandidatesByReclaimableUsedCapacity(
       candidates.begin(),
       candidates.end(),
       [](const ArbitrationCandidate& lhs, const ArbitrationCandidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableUsedCapacity > rhs.reclaimableUsedCapacity;
       });
 
@@ -515,30 +521,43 @@ std::optional<ArbitrationCandidate> SharedArbitrator::findAbortCandidate(
     return std::nullopt;
   }
 
-  for (uint64_t capacityLimit : globalArbitrationAbortCapacityLimits_) {
-    int32_t candidateIdx{-1};
-    for (int32_t i = 0; i < candidates.size(); ++i) {
-      if (candidates[i].participant->aborted()) {
-        continue;
-      }
-      if (candidates[i].currentCapacity < capacityLimit ||
-          candidates[i].currentCapacity == 0) {
-        continue;
-      }
-      if (candidateIdx == -1) {
-        candidateIdx = i;
-        continue;
+  // Searches the victim from the participants with the lowest priority first.
+  std::vector<int32_t> priorities;
+  priorities.reserve(candidates.size());
+  for (const auto& candidate : candidates) {
+    priorities.push_back(candidate.priority);
+  }
+  std::sort(priorities.begin(), priorities.end());
+  priorities.erase(
+      std::unique(priorities.begin(), priorities.end()), priorities.end());
+
+  for (const auto priority : priorities) {
+    for (uint64_t capacityLimit : globalArbitrationAbortCapacityLimits_) {
+      int32_t candidateIdx{-1};
+      for (int32_t i = 0; i < candidates.size(); ++i) {
+        if (candidates[i].priority != priority ||
+            candidates[i].participant->aborted()) {
+          continue;
+        }
+        if (candidates[i].currentCapacity < capacityLimit ||
+            candidates[i].currentCapacity == 0) {
+          continue;
+        }
+        if (candidateIdx == -1) {
+          candidateIdx = i;
+          continue;
+        }
+        // With the same capacity size bucket, we favor the old participant to
+        // let long running query proceed first.
+        if (candidates[candidateIdx].participant->id() <
+            candidates[i].participant->id()) {
+          candidateIdx = i;
+        }
       }
-      // With the same capacity size bucket, we favor the old participant to
-      // let long running query proceed first.
-      if (candidates[candidateIdx].participant->id() <
-          candidates[i].participant->id()) {
-        candidateIdx = i;
+      if (candidateIdx != -1) {
+        return candidates[candidateIdx];
       }
     }
-    if (candidateIdx != -1) {
-      return candidates[candidateIdx];
-    }
   }
 
   if (!force) {
@@ -547,11 +566,16 @@ std::optional<ArbitrationCandidate> SharedArbitrator::findAbortCandidate(
   }
 
   // Can't find an eligible abort candidate and then return the youngest
-  // candidate which has the largest participant id.
+  // candidate which has the largest participant id among the ones with the
+  // lowest priority.
   int32_t candidateIdx{-1};
   for (auto i = 0; i < candidates.size(); ++i) {
     if (candidateIdx == -1) {
       candidateIdx = i;
+    } else if (candidates[i].priority != candidates[candidateIdx].priority) {
+      if (candidates[i].priority < candidates[candidateIdx].priority) {
+        candidateIdx = i;
+      }
     } else if (
         candidates[i].participant->id() >
         candidates[candidateIdx].participant->id()) {
@@ -1058,9 +1082,11 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   victims.reserve(candidates.size());
   uint64_t bytesToReclaim{0};
   for (auto& candidate : candidates) {
+    // The candidates are sorted by priority first so a small candidate might
+    // be followed by a larger one with higher priority.
     if (candidate.reclaimableUsedCapacity <
         participantConfig_.minReclaimBytes) {
-      break;
+      continue;
     }
     if (failedParticipants.count(candidate.participant->id()) != 0) {
       VELOX_CHECK_EQ(
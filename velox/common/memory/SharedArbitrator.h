@@ -49,7 +49,10 @@ class SharedArbitratorTestHelper;
 /// memory reclamation from multiple running queries at the same time. The
 /// global arbitration first tries to reclaim memory by disk spilling and if it
 /// can't quickly reclaim enough memory, it then switchs to abort the younger
-/// queries which also have more memory usage.
+/// queries which also have more memory usage. Both the spill and abort victims
+/// are picked from the queries with the lowest priority first as reported by
+/// MemoryReclaimer::priority(). MemoryReclaimer::guaranteedCapacity() sets the
+/// capacity which a query is not reclaimed below.
 class SharedArbitrator : public memory::MemoryArbitrator {
  public:
   struct ExtraConfig {
@@ -449,9 +452,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // if need to switch to abort to reclaim used memory in the next arbitration
   // round. The function returns the actually reclaimed used capacity in bytes.
   //
-  // NOTE: the function sorts participants based on their reclaimable used
-  // memory capacity, and reclaims from participants with larger reclaimable
-  // used memory first.
+  // NOTE: the function sorts participants based on their priority and
+  // reclaimable used memory capacity, and reclaims from participants with lower
+  // priority and larger reclaimable used memory first.
   uint64_t reclaimUsedMemoryBySpill(
       uint64_t targetBytes,
       std::unordered_set<uint64_t>& reclaimedParticipants,
@@ -460,7 +463,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   uint64_t reclaimUsedMemoryBySpill(uint64_t targetBytes);
 
-  // Sorts 'candidates' based on reclaimable used capacity in descending order.
+  // Sorts 'candidates' based on priority in ascending order, then reclaimable
+  // used capacity in descending order.
   static void sortCandidatesByReclaimableUsedCapacity(
       std::vector<ArbitrationCandidate>& candidates);
 
@@ -473,9 +477,11 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   uint64_t reclaimUsedMemoryByAbort(bool force);
 
   // Finds the participant victim to abort to free used memory based on the
-  // participant's memory capacity and age. The function returns std::nullopt if
+  // participant's priority, memory capacity and age. The participants with the
+  // lowest priority are searched first. The function returns std::nullopt if
   // there is no eligible candidate. If 'force' is true, it picks up the
-  // youngest participant to abort if there is no eligible one.
+  // youngest participant with the lowest priority to abort if there is no
+  // eligible one.
   std::optional<ArbitrationCandidate> findAbortCandidate(bool force);
 
   // Invoked to use free capacity from arbitrator to grow participant's
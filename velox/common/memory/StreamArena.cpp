@@ -86,4 +86,21 @@ void StreamArena::clear() {
   tinyRanges_.clear();
 }
 
+void StreamArena::moveAllocationsTo(StreamArena& other) {
+  VELOX_CHECK(this != &other);
+  VELOX_CHECK(pool_ == other.pool_);
+  VELOX_CHECK_EQ(other.size_, 0, "Can only move allocations to empty arena");
+  VELOX_CHECK(other.tinyRanges_.empty());
+  other.allocations_ = std::move(allocations_);
+  if (!allocation_.empty()) {
+    other.allocations_.push_back(
+        std::make_unique<memory::Allocation>(std::move(allocation_)));
+  }
+  other.largeAllocations_ = std::move(largeAllocations_);
+  other.size_ = size_;
+  // Moving the vector keeps the strings and so the tiny ranges in place.
+  other.tinyRanges_ = std::move(tinyRanges_);
+  StreamArena::clear();
+}
+
 } // namespace facebook::velox
@@ -66,6 +66,13 @@ class StreamArena {
   /// serilizers.
   virtual void clear();
 
+  /// Moves the memory held by 'this' to 'other', which must be empty, and
+  /// restores 'this' to post-construction state. The ranges given out by
+  /// 'this' stay valid and accounted in the pool until 'other' is destroyed
+  /// or cleared. Used for handing serialized ranges to the IOBufs of an
+  /// IOBufOutputStream without copying them.
+  void moveAllocationsTo(StreamArena& other);
+
  private:
   memory::MemoryPool* const pool_;
   const memory::MachinePageCount allocationQuantum_{2};
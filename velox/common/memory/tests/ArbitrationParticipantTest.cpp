@@ -606,7 +606,7 @@ TEST_F(ArbitrationParticipantTest, constructor) {
   ASSERT_THAT(
       participant->stats().toString(),
       ::testing::StartsWith(
-          "numRequests: 0, numReclaims: 0, numShrinks: 0, numGrows: 0, reclaimedBytes: 0B, growBytes: 0B, aborted: false"));
+          "numRequests: 0, numReclaims: 0, numShrinks: 0, numGrows: 0, reclaimedBytes: 0B, growBytes: 0B, arbitrationWaitTime: 0ns, aborted: false"));
 
   {
     auto scopedParticipant = participant->lock().value();
@@ -786,6 +786,47 @@ TEST_F(ArbitrationParticipantTest, getGrowTargets) {
   }
 }
 
+TEST_F(ArbitrationParticipantTest, getGrowTargetsWithForecast) {
+  auto task = createTask(kMemoryCapacity);
+  const auto config = arbitrationConfig(0, 0, 0.0);
+  auto participant = ArbitrationParticipant::create(10, task->pool(), &config);
+  auto scopedParticipant = participant->lock().value();
+  scopedParticipant->shrink(/*reclaimFromAll=*/true);
+  void* buffer = task->allocate(4 << 20);
+  SCOPE_EXIT {
+    task->free(buffer);
+  };
+  ASSERT_EQ(scopedParticipant->capacity(), 4 << 20);
+
+  auto forecastPool1 = task->pool()->addLeafChild("forecast1");
+  auto forecastPool2 = task->pool()->addLeafChild("forecast2");
+  VELOX_ASSERT_THROW(
+      task->pool()->setGrowthForecast(1 << 20),
+      "Only leaf memory pool can set growth forecast");
+  forecastPool1->setGrowthForecast(16 << 20);
+  forecastPool2->setGrowthForecast(8 << 20);
+  ASSERT_EQ(task->pool()->growthForecast(), 24 << 20);
+
+  uint64_t maxGrowBytes{0};
+  uint64_t minGrowBytes{0};
+  // The query memory pool has no free capacity so the max grow target covers
+  // both the request and the forecasts.
+  scopedParticipant->getGrowTargets(1 << 20, maxGrowBytes, minGrowBytes);
+  ASSERT_EQ(maxGrowBytes, 25 << 20);
+  ASSERT_EQ(minGrowBytes, 0);
+
+  // The max grow target is capped by the max capacity.
+  forecastPool1->setGrowthForecast(kMemoryCapacity);
+  scopedParticipant->getGrowTargets(1 << 20, maxGrowBytes, minGrowBytes);
+  ASSERT_EQ(maxGrowBytes, kMemoryCapacity - (4 << 20));
+
+  forecastPool1->setGrowthForecast(0);
+  forecastPool2->setGrowthForecast(0);
+  ASSERT_EQ(task->pool()->growthForecast(), 0);
+  scopedParticipant->getGrowTargets(1 << 20, maxGrowBytes, minGrowBytes);
+  ASSERT_EQ(maxGrowBytes, 1 << 20);
+}
+
 TEST_F(ArbitrationParticipantTest, reclaimableFreeCapacityAndShrink) {
   struct {
     uint64_t minCapacity;
@@ -1563,7 +1604,7 @@ TEST_F(ArbitrationParticipantTest, arbitrationCandidate) {
   ASSERT_EQ(candidateWithFreeCapacityOnly.reclaimableFreeCapacity, 31 << 20);
   ASSERT_EQ(
       candidateWithFreeCapacityOnly.toString(),
-      "TaskPool-0 RECLAIMABLE_USED_CAPACITY 0B RECLAIMABLE_FREE_CAPACITY 31.00MB");
+      "TaskPool-0 PRIORITY 0 RECLAIMABLE_USED_CAPACITY 0B RECLAIMABLE_FREE_CAPACITY 31.00MB");
 
   ArbitrationCandidate candidate(
       participant->lock().value(), /*freeCapacityOnly=*/false);
@@ -1572,7 +1613,7 @@ TEST_F(ArbitrationParticipantTest, arbitrationCandidate) {
   ASSERT_EQ(candidate.reclaimableFreeCapacity, 31 << 20);
   ASSERT_EQ(
       candidate.toString(),
-      "TaskPool-0 RECLAIMABLE_USED_CAPACITY 1.00MB RECLAIMABLE_FREE_CAPACITY 31.00MB");
+      "TaskPool-0 PRIORITY 0 RECLAIMABLE_USED_CAPACITY 1.00MB RECLAIMABLE_FREE_CAPACITY 31.00MB");
 }
 
 TEST_F(ArbitrationParticipantTest, arbitrationOperation) {
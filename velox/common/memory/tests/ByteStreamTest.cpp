@@ -357,6 +357,58 @@ TEST_F(ByteStreamTest, reuse) {
   }
 }
 
+TEST_F(ByteStreamTest, zeroCopyOutputStream) {
+  auto arena = newArena();
+  ByteOutputStream source(arena.get());
+  source.startWrite(100);
+  std::string data;
+  for (auto i = 0; i < 100; ++i) {
+    data.append(1000, 'a' + i % 26);
+  }
+  source.appendStringView(data);
+  ASSERT_GT(source.ranges().size(), 1);
+
+  auto owner = std::make_shared<StreamArena>(pool_.get());
+  auto out = std::make_unique<IOBufOutputStream>(*pool_);
+  out->enableZeroCopy(owner);
+  out->write("header", 6);
+  source.flush(out.get());
+  out->write("trailer", 7);
+  EXPECT_TRUE(out->hasReferencedRanges());
+  const int64_t size = 6 + data.size() + 7;
+  EXPECT_EQ(size, out->tellp());
+
+  // Rewrites the header and the trailer around the referenced ranges.
+  out->seekp(0);
+  out->write("HEADER", 6);
+  EXPECT_EQ(6, out->tellp());
+  out->seekp(size - 7);
+  out->write("TRAILER", 7);
+  EXPECT_EQ(size, out->tellp());
+  VELOX_ASSERT_THROW(
+      out->seekp(size / 2), "Cannot seek into a referenced range");
+
+  arena->moveAllocationsTo(*owner);
+  EXPECT_EQ(0, arena->size());
+  EXPECT_LT(0, owner->size());
+  arena = nullptr;
+  owner = nullptr;
+
+  auto iobuf = out->getIOBuf();
+  out = nullptr;
+  EXPECT_EQ(size, iobuf->computeChainDataLength());
+  EXPECT_LT(0, mmapAllocator_->numAllocated());
+  auto coalesced = iobuf->clone()->coalesce();
+  EXPECT_EQ(
+      "HEADER" + data + "TRAILER",
+      std::string(
+          reinterpret_cast<const char*>(coalesced.data()), coalesced.size()));
+
+  // The referenced ranges are freed with the IOBufs.
+  iobuf = nullptr;
+  EXPECT_EQ(0, mmapAllocator_->numAllocated());
+}
+
 class InputByteStreamTest : public ByteStreamTest,
                             public testing::WithParamInterface<bool> {
  protected:
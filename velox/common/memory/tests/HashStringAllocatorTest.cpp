@@ -212,6 +212,88 @@ TEST_F(HashStringAllocatorTest, allocateLarge) {
   EXPECT_EQ(0, allocator_->retainedSize());
 }
 
+TEST_F(HashStringAllocatorTest, sizeClasses) {
+  allocator_ = std::make_unique<HashStringAllocator>(pool_.get(), true);
+  ASSERT_TRUE(allocator_->useSizeClasses());
+  for (auto count = 0; count < 2; ++count) {
+    std::vector<HSA::Header*> headers;
+    for (auto i = 0; i < 10'000; ++i) {
+      headers.push_back(allocate(i % (HSA::kMaxSizeClassAlloc + 40)));
+      ASSERT_EQ(
+          headers.back()->isSizeClass(),
+          i % (HSA::kMaxSizeClassAlloc + 40) <= HSA::kMaxSizeClassAlloc);
+      if (headers.back()->isSizeClass()) {
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(headers.back()->begin()) % 8, 0);
+      }
+    }
+    ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+    for (auto i = 0; i < headers.size(); i += 2) {
+      allocator_->free(headers[i]);
+    }
+    ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+    // A freed size class block is reused without growing.
+    const auto retainedSize = allocator_->retainedSize();
+    for (auto i = 0; i < headers.size(); i += 2) {
+      headers[i] = nullptr;
+    }
+    auto* reused = allocate(100);
+    ASSERT_TRUE(reused->isSizeClass());
+    ASSERT_EQ(allocator_->retainedSize(), retainedSize);
+    allocator_->free(reused);
+    ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+    for (auto* header : headers) {
+      if (header != nullptr) {
+        allocator_->free(header);
+      }
+    }
+    EXPECT_TRUE(allocator_->isEmpty());
+  }
+  auto* header = allocator_->allocate(10);
+  allocator_->free(header);
+  VELOX_ASSERT_THROW(
+      allocator_->free(header), "Double free of size class block");
+  allocator_->clear();
+  EXPECT_EQ(allocator_->retainedSize(), 0);
+}
+
+TEST_F(HashStringAllocatorTest, sizeClassStringsAndWrites) {
+  allocator_ = std::make_unique<HashStringAllocator>(pool_.get(), true);
+  std::vector<std::string> strings;
+  std::vector<StringView> views(100);
+  for (auto i = 0; i < views.size(); ++i) {
+    strings.push_back(std::string(i * 5, 'a' + i % 26));
+    allocator_->copyMultipart(
+        StringView(strings.back()), reinterpret_cast<char*>(&views[i]), 0);
+  }
+  std::string storage;
+  for (auto i = 0; i < views.size(); ++i) {
+    ASSERT_EQ(
+        HSA::contiguousString(views[i], storage), StringView(strings[i]));
+    if (!views[i].isInline()) {
+      ASSERT_EQ(
+          HSA::headerOf(views[i].data())->isSizeClass(),
+          views[i].size() <= HSA::kMaxSizeClassAlloc);
+    }
+  }
+
+  // A write that extends a size class block continues in the arena.
+  auto* header = allocator_->allocate(20);
+  ASSERT_TRUE(header->isSizeClass());
+  auto position = HSA::Position::atOffset(header, 0);
+  allocator_->ensureAvailable(1'000, position);
+  ASSERT_TRUE(header->isContinued());
+  ASSERT_GE(HSA::available(position), 1'000);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  allocator_->free(header);
+
+  for (const auto& view : views) {
+    if (!view.isInline()) {
+      allocator_->free(HSA::headerOf(view.data()));
+    }
+  }
+  EXPECT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, finishWrite) {
   ByteOutputStream stream(allocator_.get());
   auto start = allocator_->newWrite(stream);
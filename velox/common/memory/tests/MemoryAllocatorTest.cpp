@@ -1906,6 +1906,65 @@ TEST_F(MmapArenaTest, managedMmapArenasFreeError) {
   }
 }
 
+TEST_F(MmapArenaTest, hugePagesAndNumaNode) {
+  ASSERT_GE(numNumaNodes(), 1);
+  const auto node = currentNumaNode();
+  ASSERT_GE(node, 0);
+  ASSERT_LT(node, numNumaNodes());
+
+  auto managedArenas =
+      std::make_unique<ManagedMmapArenas>(kArenaCapacityBytes, true, node);
+  ASSERT_EQ(managedArenas->arenas().size(), 1);
+  const auto& arena = managedArenas->arenas().begin()->second;
+  ASSERT_EQ(
+      reinterpret_cast<uintptr_t>(arena->address()) %
+          AllocationTraits::kHugePageSize,
+      0);
+  void* alloc1 = managedArenas->allocate(kArenaCapacityBytes / 2);
+  void* alloc2 = managedArenas->allocate(kArenaCapacityBytes);
+  ASSERT_EQ(managedArenas->arenas().size(), 2);
+  memset(alloc1, 0xff, kArenaCapacityBytes / 2);
+  memset(alloc2, 0xff, kArenaCapacityBytes);
+  ASSERT_TRUE(managedArenas->contains(alloc1));
+  ASSERT_TRUE(managedArenas->contains(alloc2));
+  int32_t notInArena;
+  ASSERT_FALSE(managedArenas->contains(&notInArena));
+  managedArenas->free(alloc1, kArenaCapacityBytes / 2);
+  managedArenas->free(alloc2, kArenaCapacityBytes);
+  ASSERT_EQ(managedArenas->arenas().size(), 1);
+}
+
+TEST_F(MmapArenaTest, hugePageAndNumaAwareMmapAllocator) {
+  MmapAllocator::Options options;
+  options.capacity = 1L << 30;
+  options.largestSizeClass = 1024;
+  options.useMmapArena = true;
+  options.useHugePages = true;
+  options.numaAwareArenas = true;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+
+  // The largest size class pages are huge page aligned.
+  Allocation allocation;
+  ASSERT_TRUE(allocator->allocateNonContiguous(1024, allocation));
+  ASSERT_EQ(allocation.numRuns(), 1);
+  ASSERT_EQ(
+      reinterpret_cast<uintptr_t>(allocation.runAt(0).data()) %
+          AllocationTraits::kHugePageSize,
+      0);
+  allocator->freeNonContiguous(allocation);
+
+  std::vector<ContiguousAllocation> allocations(4);
+  for (auto& contiguous : allocations) {
+    ASSERT_TRUE(allocator->allocateContiguous(2048, nullptr, contiguous));
+    memset(contiguous.data(), 0xff, contiguous.size());
+  }
+  for (auto& contiguous : allocations) {
+    allocator->freeContiguous(contiguous);
+  }
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  ASSERT_TRUE(allocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, unmap) {
   const int smallAllocationSize = 1024;
   const int largeAllocationSize = 8192;
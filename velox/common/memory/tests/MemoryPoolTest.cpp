@@ -432,6 +432,78 @@ TEST_P(MemoryPoolTest, usedBytes) {
   ASSERT_EQ(root->usedBytes(), 0);
 }
 
+TEST_P(MemoryPoolTest, threadCache) {
+  constexpr int64_t kCacheBytes{256 * KB};
+  setupMemory(
+      {.debugEnabled = true,
+       .memoryPoolThreadCacheBytes = kCacheBytes,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity,
+       .extraArbitratorConfigs = {
+           {std::string(SharedArbitrator::ExtraConfig::kReservedCapacity),
+            "1GB"}}});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool();
+  auto child = root->addLeafChild("threadCache", isLeafThreadSafe_);
+  // Only the thread-safe leaf memory pools cache reservations.
+  const int64_t cachedBytes = isLeafThreadSafe_ ? kCacheBytes : 0;
+
+  const int64_t kChunkSize{128};
+  void* buf = child->allocate(kChunkSize);
+  ASSERT_EQ(child->usedBytes(), kChunkSize + cachedBytes);
+  ASSERT_EQ(child->reservedBytes(), 1 << 20);
+  child->free(buf, kChunkSize);
+  ASSERT_EQ(child->usedBytes(), cachedBytes);
+
+  // The allocations larger than the cache size are not cached.
+  buf = child->allocate(2 * kCacheBytes);
+  ASSERT_EQ(child->usedBytes(), 2 * kCacheBytes + cachedBytes);
+  child->free(buf, 2 * kCacheBytes);
+  ASSERT_EQ(child->usedBytes(), cachedBytes);
+
+  // The cache is trimmed when it holds more than twice the cache size.
+  std::vector<void*> buffers;
+  for (int i = 0; i < 1'000; ++i) {
+    buffers.push_back(child->allocate(KB));
+  }
+  ASSERT_GE(child->usedBytes(), 1'000 * KB);
+  for (auto* buffer : buffers) {
+    child->free(buffer, KB);
+  }
+  ASSERT_LE(child->usedBytes(), 2 * cachedBytes);
+
+  // release() returns the cached bytes to the memory pool.
+  child->release();
+  ASSERT_EQ(child->usedBytes(), 0);
+  ASSERT_EQ(child->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // The cached bytes of a thread are returned to the memory pool on thread
+  // exit.
+  if (isLeafThreadSafe_) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&]() {
+        for (int j = 0; j < 1'000; ++j) {
+          child->free(child->allocate(KB), KB);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(child->usedBytes(), 0);
+    ASSERT_EQ(child->reservedBytes(), 0);
+  }
+
+  // The memory pool destruction returns the cached bytes of all the threads.
+  buf = child->allocate(kChunkSize);
+  child->free(buf, kChunkSize);
+  ASSERT_EQ(child->usedBytes(), cachedBytes);
+  child.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, DISABLED_memoryLeakCheck) {
   gflags::FlagSaver flagSaver;
   testing::FLAGS_gtest_death_test_style = "fast";
@@ -108,6 +108,16 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
       memory::MemoryReclaimer::abort(pool, error);
     }
 
+    int32_t priority() const override {
+      auto task = task_.lock();
+      return task == nullptr ? 0 : task->priority();
+    }
+
+    uint64_t guaranteedCapacity() const override {
+      auto task = task_.lock();
+      return task == nullptr ? 0 : task->guaranteedCapacity();
+    }
+
    private:
     std::weak_ptr<MockTask> task_;
   };
@@ -154,6 +164,22 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
     error_ = error;
   }
 
+  int32_t priority() const {
+    return priority_;
+  }
+
+  void setPriority(int32_t priority) {
+    priority_ = priority;
+  }
+
+  uint64_t guaranteedCapacity() const {
+    return guaranteedCapacity_;
+  }
+
+  void setGuaranteedCapacity(uint64_t capacity) {
+    guaranteedCapacity_ = capacity;
+  }
+
  private:
   inline static std::atomic<int64_t> poolId_{0};
   std::shared_ptr<MemoryPool> root_;
@@ -161,6 +187,8 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
   std::vector<std::shared_ptr<MemoryPool>> pools_;
   std::vector<std::shared_ptr<MockMemoryOperator>> ops_;
   std::exception_ptr error_{nullptr};
+  std::atomic<int32_t> priority_{0};
+  std::atomic<uint64_t> guaranteedCapacity_{0};
 };
 
 class MockMemoryOperator {
@@ -2676,6 +2704,60 @@ TEST_F(MockSharedArbitrationTest, memoryPoolAbortCapacityLimit) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, priorityBasedVictimSelection) {
+  const int64_t memoryCapacity = 256 << 20;
+  {
+    // The low priority participant is aborted first even if the high priority
+    // one is larger and younger.
+    setupMemory(memoryCapacity);
+    auto lowPriorityTask = addTask();
+    auto* lowPriorityOp = addMemoryOp(lowPriorityTask, false);
+    lowPriorityOp->allocate(32 << 20);
+    auto highPriorityTask = addTask();
+    highPriorityTask->setPriority(1);
+    auto* highPriorityOp = addMemoryOp(highPriorityTask, false);
+    highPriorityOp->allocate(128 << 20);
+
+    ASSERT_EQ(manager_->shrinkPools(16 << 20, false, true), 32 << 20);
+    ASSERT_NE(lowPriorityTask->error(), nullptr);
+    ASSERT_EQ(highPriorityTask->error(), nullptr);
+    ASSERT_EQ(highPriorityTask->capacity(), 128 << 20);
+  }
+
+  {
+    // The low priority participant is spilled first even if the high priority
+    // one has more reclaimable memory.
+    setupMemory(memoryCapacity);
+    auto highPriorityTask = addTask();
+    highPriorityTask->setPriority(1);
+    auto* highPriorityOp = addMemoryOp(highPriorityTask, true);
+    highPriorityOp->allocate(128 << 20);
+    auto lowPriorityTask = addTask();
+    auto* lowPriorityOp = addMemoryOp(lowPriorityTask, true);
+    lowPriorityOp->allocate(32 << 20);
+
+    ASSERT_GT(manager_->shrinkPools(16 << 20, true, false), 0);
+    ASSERT_LT(lowPriorityTask->usedBytes(), 32 << 20);
+    ASSERT_EQ(highPriorityTask->usedBytes(), 128 << 20);
+    ASSERT_EQ(lowPriorityTask->error(), nullptr);
+    ASSERT_EQ(highPriorityTask->error(), nullptr);
+  }
+
+  {
+    // The guaranteed capacity of a participant is not reclaimed.
+    setupMemory(memoryCapacity);
+    auto task = addTask();
+    task->setGuaranteedCapacity(64 << 20);
+    auto* op = addMemoryOp(task, true);
+    op->allocate(32 << 20);
+    ASSERT_EQ(task->capacity(), 64 << 20);
+
+    ASSERT_EQ(manager_->shrinkPools(0, true, false), 0);
+    ASSERT_EQ(task->usedBytes(), 32 << 20);
+    ASSERT_EQ(task->capacity(), 64 << 20);
+  }
+}
+
 DEBUG_ONLY_TEST_F(
     MockSharedArbitrationTest,
     globalArbitrationWaitReturnEarlyWithFreeCapacity) {
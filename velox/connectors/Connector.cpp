@@ -152,6 +152,52 @@ CommitStrategy stringToCommitStrategy(const std::string& strategy) {
   }
 }
 
+namespace {
+const char* scanAggregateKindName(ScanAggregate::Kind kind) {
+  switch (kind) {
+    case ScanAggregate::Kind::kCount:
+      return "count";
+    case ScanAggregate::Kind::kMin:
+      return "min";
+    case ScanAggregate::Kind::kMax:
+      return "max";
+  }
+  VELOX_UNREACHABLE();
+}
+
+ScanAggregate::Kind scanAggregateKindFromName(const std::string& name) {
+  if (name == "count") {
+    return ScanAggregate::Kind::kCount;
+  }
+  if (name == "min") {
+    return ScanAggregate::Kind::kMin;
+  }
+  if (name == "max") {
+    return ScanAggregate::Kind::kMax;
+  }
+  VELOX_FAIL("Unknown scan aggregate: {}", name);
+}
+} // namespace
+
+std::string ScanAggregate::toString() const {
+  return fmt::format(
+      "{}({})", scanAggregateKindName(kind), column.empty() ? "*" : column);
+}
+
+folly::dynamic ScanAggregate::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["kind"] = scanAggregateKindName(kind);
+  obj["column"] = column;
+  return obj;
+}
+
+// static
+ScanAggregate ScanAggregate::create(const folly::dynamic& obj) {
+  return {
+      scanAggregateKindFromName(obj["kind"].asString()),
+      obj["column"].asString()};
+}
+
 folly::dynamic ColumnHandle::serializeBase(std::string_view name) {
   folly::dynamic obj = folly::dynamic::object;
   obj["name"] = name;
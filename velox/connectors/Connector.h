@@ -25,6 +25,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/core/ExpressionEvaluator.h"
+#include "velox/type/Variant.h"
 #include "velox/vector/ComplexVector.h"
 
 #include <folly/Synchronized.h>
@@ -48,6 +49,16 @@ class DataSource;
 
 /// A split represents a chunk of data that a connector should load and return
 /// as a RowVectorPtr, potentially after processing pushdowns.
+/// The range of the values of a column in a split, known without reading the
+/// split, e.g. from the column statistics in the table metadata.
+struct SplitColumnRange {
+  /// The smallest and largest non-null values.
+  variant min;
+  variant max;
+  /// False if the column has no nulls in the split.
+  bool mayHaveNulls{true};
+};
+
 struct ConnectorSplit : public ISerializable {
   const std::string connectorId;
   const int64_t splitWeight{0};
@@ -66,15 +77,44 @@ struct ConnectorSplit : public ISerializable {
 
   virtual ~ConnectorSplit() {}
 
+  /// Returns the estimated cost of reading the split, e.g. its size in bytes.
+  /// Used to order the queued splits by cost when
+  /// QueryConfig::kLargestSplitFirst is set. Only comparable between the
+  /// splits of the same connector. Defaults to 'splitWeight'.
+  virtual uint64_t estimatedCost() const {
+    return splitWeight > 0 ? splitWeight : 0;
+  }
+
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns a key which identifies the data of the split, including its
+  /// version, such that the splits with the same key have the same rows.
+  /// Used to look up the rows of the split in exec::SplitResultCache. Returns
+  /// std::nullopt if the split cannot be cached.
+  virtual std::optional<std::string> resultCacheKey() const {
+    return std::nullopt;
+  }
+
+  /// Returns the range of the values of the table column 'column' in the
+  /// split, or nullptr if not known. Used to read the splits most likely to
+  /// have the first rows of a TopN first.
+  virtual const SplitColumnRange* columnRange(
+      const std::string& /*column*/) const {
+    return nullptr;
+  }
 };
 
 class ColumnHandle : public ISerializable {
  public:
   virtual ~ColumnHandle() = default;
 
+  /// Returns the name of the table column this handle refers to.
+  virtual const std::string& name() const {
+    VELOX_UNSUPPORTED();
+  }
+
   folly::dynamic serialize() const override;
 
  protected:
@@ -83,6 +123,34 @@ class ColumnHandle : public ISerializable {
 
 using ColumnHandlePtr = std::shared_ptr<const ColumnHandle>;
 
+/// An aggregate which a table scan computes instead of returning the rows.
+/// See ConnectorTableHandle::aggregates().
+struct ScanAggregate {
+  enum class Kind {
+    /// count(*) if 'column' is empty, the number of non-null values of
+    /// 'column' otherwise.
+    kCount,
+    kMin,
+    kMax,
+  };
+
+  Kind kind;
+  /// The aggregated column, a key of the column handles of the scan. Empty
+  /// for count(*).
+  std::string column;
+
+  bool operator==(const ScanAggregate& other) const {
+    return kind == other.kind && column == other.column;
+  }
+
+  /// Returns the aggregate as SQL, e.g. count(*) or min(c0).
+  std::string toString() const;
+
+  folly::dynamic serialize() const;
+
+  static ScanAggregate create(const folly::dynamic& obj);
+};
+
 class ConnectorTableHandle : public ISerializable {
  public:
   explicit ConnectorTableHandle(std::string connectorId)
@@ -98,6 +166,28 @@ class ConnectorTableHandle : public ISerializable {
     return connectorId_;
   }
 
+  /// Returns the names of the table columns by which the rows of each split
+  /// are sorted, most significant first. The order of the rows of a split is
+  /// preserved by the scan, so rows with equal values in a prefix of these
+  /// columns are adjacent. Empty if the rows are not known to be sorted.
+  virtual const std::vector<std::string>& sortedColumns() const {
+    static const std::vector<std::string> kEmpty;
+    return kEmpty;
+  }
+
+  /// Returns the aggregates the scan computes instead of returning the rows.
+  /// If not empty, column i of the output of the scan is a partial result of
+  /// aggregates()[i]: BIGINT for count and the type of the column for min
+  /// and max, null if there are no non-null values. The scan may return any
+  /// number of rows for each split, including none. These must be combined
+  /// by a final
+  /// aggregation: the sum of the counts, the min of the mins and the max of
+  /// the maxes. Only set if Connector::supportsAggregatePushdown() is true.
+  virtual const std::vector<ScanAggregate>& aggregates() const {
+    static const std::vector<ScanAggregate> kEmpty;
+    return kEmpty;
+  }
+
   virtual folly::dynamic serialize() const override;
 
  protected:
@@ -233,6 +323,12 @@ class DataSource {
     return false;
   }
 
+  /// Hints that the caller will consume at most 'numRows' more rows, e.g.
+  /// because the scan feeds a limit. With 0, no more rows are needed and the
+  /// source may drop the current split and any data it is prefetching.
+  /// next() is not called again after a hint of 0.
+  virtual void setRowLimit(uint64_t /*numRows*/) {}
+
   /// Initializes this from 'source'. 'source' is effectively moved into 'this'
   /// Adaptation like dynamic filters stay in effect but the parts dealing with
   /// open files, prefetched data etc. are moved. 'source' is freed after the
@@ -441,6 +537,13 @@ class Connector {
     return false;
   }
 
+  /// Returns true if the DataSource computes the aggregates of
+  /// ConnectorTableHandle::aggregates(), e.g. from the statistics of the
+  /// files.
+  virtual bool supportsAggregatePushdown() const {
+    return false;
+  }
+
   virtual std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -131,10 +131,26 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+bool HiveConfig::adaptiveCoalesceEnabled() const {
+  return config_->get<bool>(kAdaptiveCoalesceEnabled, false);
+}
+
+int32_t HiveConfig::ioSchedulerMaxConcurrency() const {
+  return config_->get<int32_t>(kIoSchedulerMaxConcurrency, 0);
+}
+
+int32_t HiveConfig::ioSchedulerMaxConcurrencyPerQuery() const {
+  return config_->get<int32_t>(kIoSchedulerMaxConcurrencyPerQuery, 8);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+int64_t HiveConfig::maxPrefetchRowGroupBytes() const {
+  return config_->get<int64_t>(kMaxPrefetchRowGroupBytes, 0);
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -230,6 +246,12 @@ std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
 
+uint64_t HiveConfig::maxPendingWriteBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kMaxPendingWriteBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
 uint32_t HiveConfig::sortWriterMaxOutputRows(
     const config::ConfigBase* session) const {
   return session->get<uint32_t>(
@@ -246,6 +268,20 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(
       config::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::isClusteredPartitionWrite(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kClusteredPartitionWriteSession,
+      config_->get<bool>(kClusteredPartitionWrite, false));
+}
+
+uint32_t HiveConfig::unpartitionedWritersPerDriver(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kUnpartitionedWritersPerDriverSession,
+      config_->get<uint32_t>(kUnpartitionedWritersPerDriver, 1));
+}
+
 uint64_t HiveConfig::sortWriterFinishTimeSliceLimitMs(
     const config::ConfigBase* session) const {
   return session->get<uint64_t>(
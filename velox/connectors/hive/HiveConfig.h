@@ -107,9 +107,31 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Maximum number of asynchronous loads of all queries running at a time on
+  /// the connector executor. The loads are queued per query and started round
+  /// robin across queries. 0 submits the loads directly to the executor.
+  static constexpr const char* kIoSchedulerMaxConcurrency =
+      "io-scheduler-max-concurrency";
+
+  /// Maximum number of asynchronous loads of one query running at a time on
+  /// the connector executor if 'io-scheduler-max-concurrency' is positive.
+  static constexpr const char* kIoSchedulerMaxConcurrencyPerQuery =
+      "io-scheduler-max-concurrency-per-query";
+
+  /// If true, the coalesce distance is derived from the latency and bandwidth
+  /// measured on the file system and 'max-coalesced-distance-bytes' is only
+  /// used until there are enough measurements.
+  static constexpr const char* kAdaptiveCoalesceEnabled =
+      "adaptive-coalesce-enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// The maximum total compressed size in bytes of the row groups prefetched
+  /// ahead of the one being read. 0 means no limit.
+  static constexpr const char* kMaxPrefetchRowGroupBytes =
+      "max-prefetch-rowgroups-bytes";
+
   /// The total size in bytes for a direct coalesce request. Up to 8MB load
   /// quantum size is supported when SSD cache is enabled.
   static constexpr const char* kLoadQuantum = "load-quantum";
@@ -178,12 +200,37 @@ class HiveConfig {
   static constexpr const char* kWriteFileCreateConfig =
       "hive.write_file_create_config";
 
+  /// Maximum bytes written by a file writer which may wait to be appended to
+  /// the file on the connector executor. 0 appends synchronously in the
+  /// writer's driver thread.
+  static constexpr const char* kMaxPendingWriteBytes =
+      "max-pending-write-bytes";
+
   /// Maximum number of rows for sort writer in one batch of output.
   static constexpr const char* kSortWriterMaxOutputRows =
       "sort-writer-max-output-rows";
   static constexpr const char* kSortWriterMaxOutputRowsSession =
       "sort_writer_max_output_rows";
 
+  /// If true, the input of a write to a partitioned table which is not
+  /// bucketed is sorted by the partition keys, spilling if needed, and the
+  /// file writer of each partition is closed before the next one is opened.
+  /// This bounds the memory of writes to many partitions. The number of
+  /// partitions is still limited by 'max-partitions-per-writers'.
+  static constexpr const char* kClusteredPartitionWrite =
+      "clustered-partition-write";
+  static constexpr const char* kClusteredPartitionWriteSession =
+      "clustered_partition_write";
+
+  /// The number of file writers of a write to a table which is neither
+  /// partitioned nor bucketed. The input batches are distributed round-robin
+  /// over the writers, each of which writes its own file. If the connector
+  /// has an executor, the writers encode their batches in parallel on it.
+  static constexpr const char* kUnpartitionedWritersPerDriver =
+      "unpartitioned-writers-per-driver";
+  static constexpr const char* kUnpartitionedWritersPerDriverSession =
+      "unpartitioned_writers_per_driver";
+
   /// Maximum bytes for sort writer in one batch of output.
   static constexpr const char* kSortWriterMaxOutputBytes =
       "sort-writer-max-output-bytes";
@@ -238,8 +285,16 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  bool adaptiveCoalesceEnabled() const;
+
+  int32_t ioSchedulerMaxConcurrency() const;
+
+  int32_t ioSchedulerMaxConcurrencyPerQuery() const;
+
   int32_t prefetchRowGroups() const;
 
+  int64_t maxPrefetchRowGroupBytes() const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
@@ -275,10 +330,17 @@ class HiveConfig {
 
   std::string writeFileCreateConfig() const;
 
+  uint64_t maxPendingWriteBytes() const;
+
   uint32_t sortWriterMaxOutputRows(const config::ConfigBase* session) const;
 
   uint64_t sortWriterMaxOutputBytes(const config::ConfigBase* session) const;
 
+  bool isClusteredPartitionWrite(const config::ConfigBase* session) const;
+
+  uint32_t unpartitionedWritersPerDriver(
+      const config::ConfigBase* session) const;
+
   uint64_t sortWriterFinishTimeSliceLimitMs(
       const config::ConfigBase* session) const;
 
@@ -52,6 +52,12 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (executor_ != nullptr && hiveConfig_->ioSchedulerMaxConcurrency() > 0) {
+    ioScheduler_ = std::make_shared<dwio::common::IoScheduler>(
+        executor_,
+        hiveConfig_->ioSchedulerMaxConcurrency(),
+        hiveConfig_->ioSchedulerMaxConcurrencyPerQuery());
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -68,7 +74,12 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      ioScheduler_ != nullptr
+          ? ioScheduler_->executorFor(
+                connectorQueryCtx->queryId(),
+                dwio::common::IoScheduler::Priority::kPrefetch)
+          : nullptr);
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -85,7 +96,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
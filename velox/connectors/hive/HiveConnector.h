@@ -18,6 +18,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/dwio/common/IoScheduler.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -55,6 +56,10 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  bool supportsAggregatePushdown() const override {
+    return true;
+  }
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -79,6 +84,9 @@ class HiveConnector : public Connector {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
+  // Schedules the asynchronous loads of the queries on 'executor_'. Null if
+  // 'io-scheduler-max-concurrency' is 0.
+  std::shared_ptr<dwio::common::IoScheduler> ioScheduler_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
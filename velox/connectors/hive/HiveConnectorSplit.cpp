@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 
+#include <folly/json.h>
+
 namespace facebook::velox::connector::hive {
 
 std::string HiveConnectorSplit::toString() const {
@@ -30,6 +32,38 @@ std::string HiveConnectorSplit::toString() const {
   return fmt::format("Hive: {} {} - {}", filePath, start, length);
 }
 
+uint64_t HiveConnectorSplit::estimatedCost() const {
+  if (length != std::numeric_limits<uint64_t>::max()) {
+    return length;
+  }
+  if (properties.has_value() && properties->fileSize.has_value()) {
+    const uint64_t fileSize =
+        std::max<int64_t>(properties->fileSize.value(), 0);
+    return fileSize > start ? fileSize - start : 0;
+  }
+  return ConnectorSplit::estimatedCost();
+}
+
+std::optional<std::string> HiveConnectorSplit::resultCacheKey() const {
+  // The modification time is the version of the file. The bucket conversion
+  // is not serialized.
+  if (!properties.has_value() || !properties->modificationTime.has_value() ||
+      bucketConversion.has_value()) {
+    return std::nullopt;
+  }
+  auto obj = serialize();
+  obj.erase("splitWeight");
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(obj, opts);
+}
+
+const SplitColumnRange* HiveConnectorSplit::columnRange(
+    const std::string& column) const {
+  auto it = columnRanges.find(column);
+  return it == columnRanges.end() ? nullptr : &it->second;
+}
+
 std::string HiveConnectorSplit::getFileName() const {
   const auto i = filePath.rfind('/');
   return i == std::string::npos ? filePath : filePath.substr(i + 1);
@@ -95,6 +129,18 @@ folly::dynamic HiveConnectorSplit::serialize() const {
     obj["rowIdProperties"] = rowIdObj;
   }
 
+  if (!columnRanges.empty()) {
+    folly::dynamic columnRangesObj = folly::dynamic::object;
+    for (const auto& [column, range] : columnRanges) {
+      folly::dynamic rangeObj = folly::dynamic::object;
+      rangeObj["min"] = range.min.serialize();
+      rangeObj["max"] = range.max.serialize();
+      rangeObj["mayHaveNulls"] = range.mayHaveNulls;
+      columnRangesObj[column] = rangeObj;
+    }
+    obj["columnRanges"] = columnRangesObj;
+  }
+
   return obj;
 }
 
@@ -159,7 +205,7 @@ std::shared_ptr<HiveConnectorSplit> HiveConnectorSplit::create(
         .tableGuid = rowIdObj["tableGuid"].asString()};
   }
 
-  return std::make_shared<HiveConnectorSplit>(
+  auto split = std::make_shared<HiveConnectorSplit>(
       connectorId,
       filePath,
       fileFormat,
@@ -174,6 +220,17 @@ std::shared_ptr<HiveConnectorSplit> HiveConnectorSplit::create(
       infoColumns,
       properties,
       rowIdProperties);
+
+  const auto& columnRangesObj = obj.getDefault("columnRanges", nullptr);
+  if (columnRangesObj != nullptr) {
+    for (const auto& [column, rangeObj] : columnRangesObj.items()) {
+      split->columnRanges[column.asString()] = SplitColumnRange{
+          variant::create(rangeObj["min"]),
+          variant::create(rangeObj["max"]),
+          rangeObj["mayHaveNulls"].asBool()};
+    }
+  }
+  return split;
 }
 
 // static
@@ -70,6 +70,12 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
 
   std::optional<RowIdProperties> rowIdProperties;
 
+  /// The ranges of the values of table columns in the split, e.g. from the
+  /// column statistics of the table metadata. Used to order the splits of a
+  /// TopN and to skip the splits which cannot pass the filters without
+  /// opening their files.
+  std::unordered_map<std::string, SplitColumnRange> columnRanges;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -100,8 +106,19 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         properties(_properties),
         rowIdProperties(_rowIdProperties) {}
 
+  /// Returns the length of the split or, for a split of a whole file, the
+  /// file size if known.
+  uint64_t estimatedCost() const override;
+
   std::string toString() const override;
 
+  /// Returns the serialized split if the modification time of the file is
+  /// known.
+  std::optional<std::string> resultCacheKey() const override;
+
+  const SplitColumnRange* columnRange(
+      const std::string& column) const override;
+
   std::string getFileName() const;
 
   folly::dynamic serialize() const override;
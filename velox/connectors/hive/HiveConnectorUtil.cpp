@@ -42,6 +42,16 @@ namespace {
 struct SubfieldSpec {
   const common::Subfield* subfield;
   bool filterOnly;
+  // Number of array levels the path goes through without a subscript.
+  int implicitSubscripts{0};
+
+  // Returns the path element for the type at nesting 'level', or nullptr if
+  // the path ends above it.
+  const common::Subfield::PathElement* element(int level) const {
+    const auto index = level - implicitSubscripts;
+    return index < subfield->path().size() ? subfield->path()[index].get()
+                                           : nullptr;
+  }
 };
 
 template <typename T>
@@ -110,7 +120,7 @@ void addSubfields(
     common::ScanSpec& spec) {
   int newSize = 0;
   for (int i = 0; i < subfields.size(); ++i) {
-    if (level < subfields[i].subfield->path().size()) {
+    if (subfields[i].element(level) != nullptr) {
       subfields[newSize++] = subfields[i];
     } else if (!subfields[i].filterOnly) {
       spec.addAllChildFields(type);
@@ -122,7 +132,7 @@ void addSubfields(
     case TypeKind::ROW: {
       folly::F14FastMap<std::string, std::vector<SubfieldSpec>> required;
       for (auto& subfield : subfields) {
-        auto* element = subfield.subfield->path()[level].get();
+        auto* element = subfield.element(level);
         auto* nestedField =
             dynamic_cast<const common::Subfield::NestedField*>(element);
         VELOX_CHECK(
@@ -162,7 +172,7 @@ void addSubfields(
       std::vector<std::string> stringSubscripts;
       std::vector<int64_t> longSubscripts;
       for (auto& subfield : subfields) {
-        auto* element = subfield.subfield->path()[level].get();
+        auto* element = subfield.element(level);
         if (dynamic_cast<const common::Subfield::AllSubscripts*>(element)) {
           return;
         }
@@ -208,22 +218,32 @@ void addSubfields(
       break;
     }
     case TypeKind::ARRAY: {
+      // A field name at an array level selects the field of all the
+      // elements, e.g. a.b on a of type array(row(b ...)) is a[*].b. The
+      // name is then matched at the level of the elements.
+      bool allSubscripts = false;
+      for (auto& subfield : subfields) {
+        const auto kind = subfield.element(level)->kind();
+        if (kind == common::kNestedField) {
+          ++subfield.implicitSubscripts;
+          allSubscripts = true;
+        } else if (kind == common::kAllSubscripts) {
+          allSubscripts = true;
+        }
+      }
       addSubfields(
           *type.childAt(0),
           subfields,
           level + 1,
           pool,
           *spec.addArrayElementField());
-      if (subfields.empty()) {
+      if (subfields.empty() || allSubscripts) {
         return;
       }
       constexpr long kMaxIndex = std::numeric_limits<vector_size_t>::max();
       long maxIndex = -1;
       for (auto& subfield : subfields) {
-        auto* element = subfield.subfield->path()[level].get();
-        if (dynamic_cast<const common::Subfield::AllSubscripts*>(element)) {
-          return;
-        }
+        auto* element = subfield.element(level);
         auto* subscript =
             dynamic_cast<const common::Subfield::LongSubscript*>(element);
         VELOX_CHECK(
@@ -559,6 +579,7 @@ void configureReaderOptions(
   readerOptions.setLoadQuantum(hiveConfig->loadQuantum());
   readerOptions.setMaxCoalesceBytes(hiveConfig->maxCoalescedBytes());
   readerOptions.setMaxCoalesceDistance(hiveConfig->maxCoalescedDistanceBytes());
+  readerOptions.setAdaptiveCoalesce(hiveConfig->adaptiveCoalesceEnabled());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setUseColumnNamesForColumnMapping(
@@ -573,6 +594,20 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setMaxPrefetchRowGroupBytes(
+      hiveConfig->maxPrefetchRowGroupBytes());
+  // The parsed footer may be shared with the other splits of the file only if
+  // the version of the file is known.
+  if (hiveSplit->properties.has_value() &&
+      hiveSplit->properties->modificationTime.has_value()) {
+    readerOptions.setFileMetadataCacheKey(fmt::format(
+        "{}@{}:{}",
+        hiveSplit->filePath,
+        hiveSplit->properties->modificationTime.value(),
+        hiveSplit->properties->fileSize.value_or(-1)));
+  } else {
+    readerOptions.setFileMetadataCacheKey("");
+  }
   readerOptions.setNoCacheRetention(
       hiveConfig->cacheNoRetention(sessionProperties));
   const auto& sessionTzName = connectorQueryCtx->sessionTimezone();
@@ -723,6 +758,85 @@ bool testFilters(
   return true;
 }
 
+namespace {
+int64_t toInt64(const variant& value) {
+  switch (value.kind()) {
+    case TypeKind::TINYINT:
+      return value.value<TypeKind::TINYINT>();
+    case TypeKind::SMALLINT:
+      return value.value<TypeKind::SMALLINT>();
+    case TypeKind::INTEGER:
+      return value.value<TypeKind::INTEGER>();
+    case TypeKind::BIGINT:
+      return value.value<TypeKind::BIGINT>();
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+double toDouble(const variant& value) {
+  return value.kind() == TypeKind::REAL ? value.value<TypeKind::REAL>()
+                                        : value.value<TypeKind::DOUBLE>();
+}
+
+// Returns false if 'filter' cannot pass any value in 'range'. Returns true
+// for the ranges and filters which cannot be tested.
+bool testColumnRange(
+    const common::Filter& filter,
+    const SplitColumnRange& range) {
+  if (range.mayHaveNulls && filter.testNull()) {
+    return true;
+  }
+  if (range.min.isNull() || range.max.isNull() ||
+      range.min.kind() != range.max.kind()) {
+    return true;
+  }
+  switch (range.min.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return filter.testInt64Range(
+          toInt64(range.min), toInt64(range.max), range.mayHaveNulls);
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return filter.testDoubleRange(
+          toDouble(range.min), toDouble(range.max), range.mayHaveNulls);
+    case TypeKind::TIMESTAMP:
+      return filter.testTimestampRange(
+          range.min.value<TypeKind::TIMESTAMP>(),
+          range.max.value<TypeKind::TIMESTAMP>(),
+          range.mayHaveNulls);
+    case TypeKind::VARCHAR:
+      return filter.testBytesRange(
+          std::string_view(range.min.value<TypeKind::VARCHAR>()),
+          std::string_view(range.max.value<TypeKind::VARCHAR>()),
+          range.mayHaveNulls);
+    default:
+      return true;
+  }
+}
+} // namespace
+
+bool testColumnRanges(
+    const common::ScanSpec* scanSpec,
+    const std::unordered_map<std::string, SplitColumnRange>& columnRanges) {
+  if (columnRanges.empty()) {
+    return true;
+  }
+  for (const auto& child : scanSpec->children()) {
+    if (child->filter() == nullptr || !child->filter()->isDeterministic()) {
+      continue;
+    }
+    auto it = columnRanges.find(child->fieldName());
+    if (it != columnRanges.end() &&
+        !testColumnRange(*child->filter(), it->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -96,6 +96,13 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if the filters of 'scanSpec' cannot pass any row with the
+/// values in 'columnRanges', e.g. the ranges of the columns of a split from
+/// the table metadata. Lets a split be skipped without opening its file.
+bool testColumnRanges(
+    const common::ScanSpec* scanSpec,
+    const std::unordered_map<std::string, SplitColumnRange>& columnRanges);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
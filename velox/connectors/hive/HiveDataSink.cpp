@@ -27,9 +27,11 @@
 #include "velox/core/ITypedExpr.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SortingWriter.h"
+#include "velox/exec/Driver.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortBuffer.h"
 
+#include <folly/ScopeGuard.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -365,15 +367,30 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* writeExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
       commitStrategy_(commitStrategy),
       hiveConfig_(hiveConfig),
+      writeExecutor_(writeExecutor),
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      clusteredPartitionWrite_(
+          hiveConfig_->isClusteredPartitionWrite(
+              connectorQueryCtx->sessionProperties()) &&
+          insertTableHandle_->isPartitioned() &&
+          !insertTableHandle_->isBucketed()),
+      numUnpartitionedWriters_(
+          insertTableHandle_->isPartitioned() ||
+                  insertTableHandle_->isBucketed()
+              ? 1
+              : std::max<uint32_t>(
+                    1,
+                    hiveConfig_->unpartitionedWritersPerDriver(
+                        connectorQueryCtx->sessionProperties()))),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -412,6 +429,10 @@ HiveDataSink::HiveDataSink(
       "Unsupported commit strategy: {}",
       commitStrategyToString(commitStrategy_));
 
+  if (clusteredPartitionWrite_) {
+    clusteringWriter_ = createClusteringWriter();
+  }
+
   if (!isBucketed()) {
     return;
   }
@@ -435,6 +456,10 @@ HiveDataSink::HiveDataSink(
   }
 }
 
+HiveDataSink::~HiveDataSink() {
+  closeWrites();
+}
+
 bool HiveDataSink::canReclaim() const {
   // Currently, we only support memory reclaim on dwrf file writer.
   return (spillConfig_ != nullptr) &&
@@ -444,10 +469,15 @@ bool HiveDataSink::canReclaim() const {
 void HiveDataSink::appendData(RowVectorPtr input) {
   checkRunning();
 
+  if (clusteredWrite()) {
+    memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+    clusteringWriter_->write(input);
+    return;
+  }
+
   // Write to unpartitioned (and unbucketed) table.
   if (!isPartitioned() && !isBucketed()) {
-    const auto index = ensureWriter(HiveWriterId::unpartitionedId());
-    write(index, input);
+    writeUnpartitioned(input);
     return;
   }
 
@@ -491,6 +521,185 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
 
+void HiveDataSink::writeUnpartitioned(const RowVectorPtr& input) {
+  if (numUnpartitionedWriters_ == 1) {
+    const auto index = ensureWriter(HiveWriterId::unpartitionedId());
+    write(index, input);
+    return;
+  }
+  // The writers are identified by partition ids, which are not used for the
+  // file names of an unpartitioned table.
+  const auto index = ensureWriter(HiveWriterId{nextUnpartitionedWriter_});
+  nextUnpartitionedWriter_ =
+      (nextUnpartitionedWriter_ + 1) % numUnpartitionedWriters_;
+  if (parallelWrite()) {
+    writeAsync(index, input);
+  } else {
+    write(index, input);
+  }
+}
+
+void HiveDataSink::writeAsync(uint32_t index, const RowVectorPtr& input) {
+  waitForWrite(index);
+  // Lazy vectors are loaded by the driver thread.
+  for (column_index_t i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+  auto dataInput = makeDataInput(dataChannels_, input);
+  auto* writer = writers_[index].get();
+  auto* writerInfo = writerInfo_[index].get();
+  // The writer is not reclaimable from the moment the write is scheduled
+  // until it is done. The other writers may be reclaimed meanwhile.
+  *writerInfo->nonReclaimableSectionHolder = true;
+  auto pending = std::make_shared<AsyncSource<bool>>(
+      [writer, writerInfo, dataInput = std::move(dataInput)]() {
+        SCOPE_EXIT {
+          *writerInfo->nonReclaimableSectionHolder = false;
+        };
+        writer->write(dataInput);
+        writerInfo->inputSizeInBytes += dataInput->estimateFlatSize();
+        writerInfo->numWrittenRows += dataInput->size();
+        return std::make_unique<bool>(true);
+      });
+  pendingWrites_[index] = pending;
+  writeExecutor_->add([pending]() { pending->prepare(); });
+}
+
+void HiveDataSink::waitForWrite(uint32_t index) {
+  if (pendingWrites_[index] == nullptr) {
+    return;
+  }
+  auto pending = std::move(pendingWrites_[index]);
+  ContinueFuture future;
+  if (!pending->readyOrFuture(&future)) {
+    // The write runs on 'writeExecutor_'. Its memory allocations may need
+    // arbitration, which reclaims from the other writers of this sink only
+    // while the driver thread is suspended. The writer being written is not
+    // reclaimable until the write is done.
+    std::optional<exec::SuspendedSection> suspended;
+    const auto* driverThreadCtx = exec::driverThreadContext();
+    if (driverThreadCtx != nullptr &&
+        driverThreadCtx->driverCtx()->driver != nullptr) {
+      suspended.emplace(driverThreadCtx->driverCtx()->driver);
+    }
+    std::move(future).wait();
+  }
+  // Makes the item on the driver thread if the write has not started.
+  pending->move();
+}
+
+void HiveDataSink::waitForWrites() {
+  for (auto i = 0; i < pendingWrites_.size(); ++i) {
+    waitForWrite(i);
+  }
+}
+
+void HiveDataSink::closeWrites() {
+  for (auto i = 0; i < pendingWrites_.size(); ++i) {
+    if (pendingWrites_[i] == nullptr) {
+      continue;
+    }
+    auto pending = std::move(pendingWrites_[i]);
+    pending->close();
+    // A write cancelled before it started leaves the writer marked as not
+    // reclaimable.
+    *writerInfo_[i]->nonReclaimableSectionHolder = false;
+  }
+}
+
+std::unique_ptr<dwio::common::Writer> HiveDataSink::createClusteringWriter() {
+  VELOX_CHECK(isPartitioned());
+  VELOX_CHECK(!isBucketed());
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  clusteringPool_ = connectorPool->addAggregateChild(
+      fmt::format("{}.clustering", connectorPool->name()));
+  if (connectorPool->reclaimer() != nullptr) {
+    clusteringPool_->setReclaimer(exec::MemoryReclaimer::create());
+  }
+  clusteringSortPool_ = createSortPool(clusteringPool_);
+  const std::vector<CompareFlags> compareFlags(
+      partitionChannels_.size(),
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue});
+  auto sortBuffer = std::make_unique<exec::SortBuffer>(
+      inputType_,
+      partitionChannels_,
+      compareFlags,
+      clusteringSortPool_.get(),
+      &nonReclaimableSection_,
+      connectorQueryCtx_->prefixSortConfig(),
+      spillConfig_,
+      &clusteringSpillStats_);
+  return std::make_unique<dwio::common::SortingWriter>(
+      std::make_unique<ClusteredPartitionWriter>(this),
+      std::move(sortBuffer),
+      hiveConfig_->sortWriterMaxOutputRows(
+          connectorQueryCtx_->sessionProperties()),
+      hiveConfig_->sortWriterMaxOutputBytes(
+          connectorQueryCtx_->sessionProperties()),
+      sortWriterFinishTimeSliceLimitMs_);
+}
+
+void HiveDataSink::writeClustered(const RowVectorPtr& input) {
+  computePartitionAndBucketIds(input);
+  const vector_size_t numRows = input->size();
+  vector_size_t start = 0;
+  while (start < numRows) {
+    const auto partitionId = partitionIds_[start];
+    vector_size_t end = start + 1;
+    while (end < numRows && partitionIds_[end] == partitionId) {
+      ++end;
+    }
+    const HiveWriterId id{static_cast<uint32_t>(partitionId)};
+    auto it = writerIndexMap_.find(id);
+    uint32_t index;
+    if (it == writerIndexMap_.end()) {
+      closeClusteredWriter();
+      index = appendWriter(id);
+      openClusteredWriter_ = index;
+    } else {
+      index = it->second;
+      VELOX_CHECK(
+          openClusteredWriter_ == index,
+          "Input of clustered write is not ordered by partition: {}",
+          id.toString());
+    }
+    write(
+        index,
+        end - start == numRows
+            ? input
+            : std::static_pointer_cast<RowVector>(
+                  input->slice(start, end - start)));
+    start = end;
+  }
+}
+
+void HiveDataSink::closeClusteredWriter() {
+  if (!openClusteredWriter_.has_value()) {
+    return;
+  }
+  const auto index = *openClusteredWriter_;
+  openClusteredWriter_.reset();
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+  writers_[index]->close();
+  // Frees the memory of the writer. 'writerInfo_' and 'ioStats_' are kept
+  // for the partition update.
+  writers_[index].reset();
+}
+
+void HiveDataSink::ClusteredPartitionWriter::write(const VectorPtr& data) {
+  checkRunning();
+  dataSink_->writeClustered(std::static_pointer_cast<RowVector>(data));
+}
+
+void HiveDataSink::ClusteredPartitionWriter::close() {
+  setState(State::kClosed);
+  dataSink_->closeClusteredWriter();
+}
+
+void HiveDataSink::ClusteredPartitionWriter::abort() {
+  setState(State::kAborted);
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -560,6 +769,10 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  const auto clusteringSpillStats = clusteringSpillStats_.rlock();
+  if (!clusteringSpillStats->empty()) {
+    stats.spillStats += *clusteringSpillStats;
+  }
   return stats;
 }
 
@@ -617,6 +830,13 @@ bool HiveDataSink::finish() {
   // Flush is reentry state.
   setState(State::kFinishing);
 
+  if (clusteredWrite()) {
+    memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+    return clusteringWriter_->finish();
+  }
+
+  waitForWrites();
+
   // As for now, only sorted writer needs flush buffered data. For non-sorted
   // writer, data is directly written to the underlying file writer.
   if (!sortWrite()) {
@@ -683,12 +903,33 @@ void HiveDataSink::closeInternal() {
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
   if (state_ == State::kClosed) {
+    waitForWrites();
+  } else {
+    closeWrites();
+  }
+
+  // The writers of the partitions before the open one are already closed in
+  // clustered write mode.
+  if (state_ == State::kClosed) {
+    if (clusteredWrite()) {
+      memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+      clusteringWriter_->close();
+    }
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
+    if (clusteredWrite()) {
+      clusteringWriter_->abort();
+    }
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -805,11 +1046,16 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
               .pool = writerInfo_.back()->sinkPool.get(),
               .metricLogger = dwio::common::MetricsLog::voidLog(),
               .stats = ioStats_.back().get(),
+              // The parallel writes run on 'writeExecutor_' and append
+              // to the file themselves.
+              .writeExecutor = parallelWrite() ? nullptr : writeExecutor_,
+              .maxPendingWriteBytes = hiveConfig_->maxPendingWriteBytes(),
           }),
       options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
   // Extends the buffer used for partition rows calculations.
+  pendingWrites_.emplace_back(nullptr);
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
   rawPartitionRows_.emplace_back(nullptr);
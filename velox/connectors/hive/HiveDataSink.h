@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -448,7 +449,10 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* writeExecutor = nullptr);
+
+  ~HiveDataSink() override;
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -508,10 +512,44 @@ class HiveDataSink : public DataSink {
     io::IoStatistics* const ioStats_;
   };
 
+  // The output writer of 'clusteringWriter_'. Receives the input ordered by
+  // the partition keys and writes the rows of each partition to the file
+  // writer of the partition, which is closed when the rows of the next
+  // partition arrive.
+  class ClusteredPartitionWriter : public dwio::common::Writer {
+   public:
+    explicit ClusteredPartitionWriter(HiveDataSink* dataSink)
+        : dataSink_(dataSink) {
+      VELOX_CHECK_NOT_NULL(dataSink_);
+      setState(State::kRunning);
+    }
+
+    void write(const VectorPtr& data) override;
+
+    void flush() override {}
+
+    bool finish() override {
+      return true;
+    }
+
+    void close() override;
+
+    void abort() override;
+
+   private:
+    HiveDataSink* const dataSink_;
+  };
+
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
     return !sortColumnIndices_.empty();
   }
 
+  // Returns true if the input is clustered by partition before it is written.
+  // See HiveConfig::kClusteredPartitionWrite.
+  FOLLY_ALWAYS_INLINE bool clusteredWrite() const {
+    return clusteringWriter_ != nullptr;
+  }
+
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
     return partitionIdGenerator_ != nullptr;
@@ -522,6 +560,12 @@ class HiveDataSink : public DataSink {
     return bucketCount_ != 0;
   }
 
+  // Returns true if the unpartitioned writers encode their input in parallel
+  // on 'writeExecutor_'. See HiveConfig::kUnpartitionedWritersPerDriver.
+  FOLLY_ALWAYS_INLINE bool parallelWrite() const {
+    return numUnpartitionedWriters_ > 1 && writeExecutor_ != nullptr;
+  }
+
   FOLLY_ALWAYS_INLINE bool isCommitRequired() const {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
@@ -581,6 +625,37 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Writes 'input' to a table which is neither partitioned nor bucketed. The
+  // batches go round-robin to 'numUnpartitionedWriters_' writers.
+  void writeUnpartitioned(const RowVectorPtr& input);
+
+  // Writes 'input' to the writer at 'index' on 'writeExecutor_' after the
+  // previous write of the writer is done.
+  void writeAsync(uint32_t index, const RowVectorPtr& input);
+
+  // Waits for the pending write of the writer at 'index', if any. Rethrows
+  // the error of the write. The driver thread is suspended while it waits,
+  // so that memory arbitration can reclaim from the other writers.
+  void waitForWrite(uint32_t index);
+
+  // Waits for the pending writes of all the writers.
+  void waitForWrites();
+
+  // Waits for or cancels the pending writes of all the writers. Ignores their
+  // errors.
+  void closeWrites();
+
+  // Makes the SortingWriter which sorts the input by the partition keys in
+  // clustered write mode.
+  std::unique_ptr<dwio::common::Writer> createClusteringWriter();
+
+  // Writes 'input', which is ordered by the partition keys, in clustered
+  // write mode. Closes the open writer when a new partition starts.
+  void writeClustered(const RowVectorPtr& input);
+
+  // Closes the open writer in clustered write mode, if any.
+  void closeClusteredWriter();
+
   void closeInternal();
 
   const RowTypePtr inputType_;
@@ -588,8 +663,15 @@ class HiveDataSink : public DataSink {
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const HiveConfig> hiveConfig_;
+  // Executor of the write-behind file appends. See 'max-pending-write-bytes'.
+  folly::Executor* const writeExecutor_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // True if HiveConfig::kClusteredPartitionWrite applies to the write.
+  const bool clusteredPartitionWrite_;
+  // The number of writers of a table which is neither partitioned nor
+  // bucketed. 1 for other tables.
+  const uint32_t numUnpartitionedWriters_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -617,6 +699,11 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The write of each writer running on 'writeExecutor_' in parallel write
+  // mode. Null if the writer has no pending write.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> pendingWrites_;
+  // The index of the unpartitioned writer of the next input batch.
+  uint32_t nextUnpartitionedWriter_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -628,6 +715,18 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Set in clustered write mode. Sorts all the input by the partition keys,
+  // spilling if needed, and writes it in finish() through a
+  // ClusteredPartitionWriter. The pools and stats it uses are declared first
+  // so that it is destroyed before them.
+  std::shared_ptr<memory::MemoryPool> clusteringPool_;
+  std::shared_ptr<memory::MemoryPool> clusteringSortPool_;
+  folly::Synchronized<common::SpillStats> clusteringSpillStats_;
+  std::unique_ptr<dwio::common::Writer> clusteringWriter_;
+  // The index in 'writers_' of the open writer in clustered write mode. The
+  // writers of the previous partitions are closed and reset.
+  std::optional<uint32_t> openClusteredWriter_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <cmath>
 #include <fmt/ranges.h>
 #include <string>
 #include <unordered_map>
@@ -54,6 +55,129 @@ bool shouldEagerlyMaterialize(
   return false;
 }
 
+VectorPtr makeCount(int64_t count, memory::MemoryPool* pool) {
+  return BaseVector::createConstant(BIGINT(), count, 1, pool);
+}
+
+// Returns the min or max of a column with 'numValues' non-null values from
+// its file statistics 'stats', or nullptr if these do not give it exactly.
+VectorPtr minMaxFromStatistics(
+    const TypePtr& type,
+    bool isMin,
+    const dwio::common::ColumnStatistics& stats,
+    uint64_t numValues,
+    memory::MemoryPool* pool) {
+  if (numValues == 0) {
+    return BaseVector::createNullConstant(type, 1, pool);
+  }
+  if (type->isDecimal()) {
+    return nullptr;
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN: {
+      auto* booleanStats =
+          dynamic_cast<const dwio::common::BooleanColumnStatistics*>(&stats);
+      if (!booleanStats || !booleanStats->getTrueCount().has_value()) {
+        return nullptr;
+      }
+      const auto trueCount = *booleanStats->getTrueCount();
+      const bool value = isMin ? trueCount == numValues : trueCount > 0;
+      return BaseVector::createConstant(type, value, 1, pool);
+    }
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      auto* integerStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&stats);
+      if (!integerStats) {
+        return nullptr;
+      }
+      const auto value =
+          isMin ? integerStats->getMinimum() : integerStats->getMaximum();
+      if (!value.has_value()) {
+        return nullptr;
+      }
+      switch (type->kind()) {
+        case TypeKind::TINYINT:
+          return BaseVector::createConstant(
+              type, static_cast<int8_t>(*value), 1, pool);
+        case TypeKind::SMALLINT:
+          return BaseVector::createConstant(
+              type, static_cast<int16_t>(*value), 1, pool);
+        case TypeKind::INTEGER:
+          return BaseVector::createConstant(
+              type, static_cast<int32_t>(*value), 1, pool);
+        default:
+          return BaseVector::createConstant(type, *value, 1, pool);
+      }
+    }
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE: {
+      auto* doubleStats =
+          dynamic_cast<const dwio::common::DoubleColumnStatistics*>(&stats);
+      if (!doubleStats) {
+        return nullptr;
+      }
+      const auto value =
+          isMin ? doubleStats->getMinimum() : doubleStats->getMaximum();
+      // NaN is larger than all other values in comparisons but the
+      // statistics may not account for it.
+      if (!value.has_value() || std::isnan(*value)) {
+        return nullptr;
+      }
+      if (type->kind() == TypeKind::REAL) {
+        return BaseVector::createConstant(
+            type, static_cast<float>(*value), 1, pool);
+      }
+      return BaseVector::createConstant(type, *value, 1, pool);
+    }
+    case TypeKind::VARCHAR: {
+      auto* stringStats =
+          dynamic_cast<const dwio::common::StringColumnStatistics*>(&stats);
+      if (!stringStats) {
+        return nullptr;
+      }
+      const auto& value =
+          isMin ? stringStats->getMinimum() : stringStats->getMaximum();
+      if (!value.has_value()) {
+        return nullptr;
+      }
+      return BaseVector::createConstant(type, *value, 1, pool);
+    }
+    default:
+      return nullptr;
+  }
+}
+
+// Adds the stats of 'counters' to 'stats' with names starting with 'prefix'.
+void addStorageReadStats(
+    const std::string& prefix,
+    const io::StorageReadCounters& counters,
+    std::unordered_map<std::string, RuntimeCounter>& stats) {
+  if (counters.count == 0) {
+    return;
+  }
+  stats.insert(
+      {{prefix + "numReads", RuntimeCounter(counters.count)},
+       {prefix + "readBytes",
+        RuntimeCounter(counters.bytes, RuntimeCounter::Unit::kBytes)},
+       {prefix + "p50ReadBytes",
+        RuntimeCounter(
+            counters.bytesHistogram.percentile(50),
+            RuntimeCounter::Unit::kBytes)},
+       {prefix + "readWallNanos",
+        RuntimeCounter(
+            counters.latencyUs * 1000, RuntimeCounter::Unit::kNanos)},
+       {prefix + "p50ReadWallNanos",
+        RuntimeCounter(
+            counters.latencyUsHistogram.percentile(50) * 1000,
+            RuntimeCounter::Unit::kNanos)},
+       {prefix + "p99ReadWallNanos",
+        RuntimeCounter(
+            counters.latencyUsHistogram.percentile(99) * 1000,
+            RuntimeCounter::Unit::kNanos)}});
+}
 } // namespace
 
 HiveDataSource::HiveDataSource(
@@ -65,9 +189,12 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    std::shared_ptr<folly::Executor> queryIoExecutor)
     : fileHandleFactory_(fileHandleFactory),
-      executor_(executor),
+      queryIoExecutor_(std::move(queryIoExecutor)),
+      executor_(
+          queryIoExecutor_ != nullptr ? queryIoExecutor_.get() : executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       pool_(connectorQueryCtx->memoryPool()),
@@ -98,29 +225,34 @@ HiveDataSource::HiveDataSource(
     }
   }
 
-  std::vector<std::string> readColumnNames;
-  auto readColumnTypes = outputType_->children();
-  for (const auto& outputName : outputType_->names()) {
-    auto it = columnHandles.find(outputName);
-    VELOX_CHECK(
-        it != columnHandles.end(),
-        "ColumnHandle is missing for output column: {}",
-        outputName);
-
-    auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
-    readColumnNames.push_back(handle->name());
-    for (auto& subfield : handle->requiredSubfields()) {
-      VELOX_USER_CHECK_EQ(
-          getColumnName(subfield),
-          handle->name(),
-          "Required subfield does not match column name");
-      subfields_[handle->name()].push_back(&subfield);
-    }
-  }
-
   hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
       hiveTableHandle_, "TableHandle must be an instance of HiveTableHandle");
+
+  std::vector<std::string> readColumnNames;
+  std::vector<TypePtr> readColumnTypes;
+  if (!hiveTableHandle_->aggregates().empty()) {
+    setupAggregates(columnHandles, readColumnNames, readColumnTypes);
+  } else {
+    readColumnTypes = outputType_->children();
+    for (const auto& outputName : outputType_->names()) {
+      auto it = columnHandles.find(outputName);
+      VELOX_CHECK(
+          it != columnHandles.end(),
+          "ColumnHandle is missing for output column: {}",
+          outputName);
+
+      auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+      readColumnNames.push_back(handle->name());
+      for (auto& subfield : handle->requiredSubfields()) {
+        VELOX_USER_CHECK_EQ(
+            getColumnName(subfield),
+            handle->name(),
+            "Required subfield does not match column name");
+        subfields_[handle->name()].push_back(&subfield);
+      }
+    }
+  }
   if (hiveConfig_->isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->sessionProperties())) {
     checkColumnNameLowerCase(outputType_);
@@ -204,6 +336,72 @@ HiveDataSource::HiveDataSource(
   ioStats_ = std::make_shared<io::IoStatistics>();
 }
 
+void HiveDataSource::setupAggregates(
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    std::vector<std::string>& readColumnNames,
+    std::vector<TypePtr>& readColumnTypes) {
+  const auto& aggregates = hiveTableHandle_->aggregates();
+  VELOX_CHECK_EQ(
+      aggregates.size(),
+      outputType_->size(),
+      "Each output column of a scan with aggregates must be an aggregate");
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    const auto& type = outputType_->childAt(i);
+    Aggregate info{aggregate.kind, nullptr, 0};
+    if (aggregate.column.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == ScanAggregate::Kind::kCount,
+          "Aggregate needs a column: {}",
+          aggregate.toString());
+    } else {
+      auto it = columnHandles.find(aggregate.column);
+      VELOX_CHECK(
+          it != columnHandles.end(),
+          "ColumnHandle is missing for aggregated column: {}",
+          aggregate.column);
+      info.handle = std::static_pointer_cast<HiveColumnHandle>(it->second);
+      VELOX_USER_CHECK(
+          info.handle->columnType() ==
+                  HiveColumnHandle::ColumnType::kRegular ||
+              info.handle->columnType() ==
+                  HiveColumnHandle::ColumnType::kPartitionKey,
+          "Only regular and partition key columns can be aggregated: {}",
+          aggregate.toString());
+      const auto& name = info.handle->name();
+      auto channelIt =
+          std::find(readColumnNames.begin(), readColumnNames.end(), name);
+      info.channel = channelIt - readColumnNames.begin();
+      if (channelIt == readColumnNames.end()) {
+        readColumnNames.push_back(name);
+        readColumnTypes.push_back(info.handle->dataType());
+      }
+    }
+    if (aggregate.kind == ScanAggregate::Kind::kCount) {
+      VELOX_USER_CHECK(
+          type->kind() == TypeKind::BIGINT,
+          "The result of {} must be BIGINT, not {}",
+          aggregate.toString(),
+          type->toString());
+    } else {
+      VELOX_USER_CHECK(
+          info.handle->dataType()->equivalent(*type),
+          "The result of {} must be {}, not {}",
+          aggregate.toString(),
+          info.handle->dataType()->toString(),
+          type->toString());
+      VELOX_USER_CHECK(
+          type->isOrderable(),
+          "Type of {} is not orderable: {}",
+          aggregate.toString(),
+          type->toString());
+    }
+    aggregates_.push_back(std::move(info));
+  }
+}
+
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
   return SplitReader::create(
       split_,
@@ -319,6 +517,146 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
+
+  splitAggregatedFromStatistics_ = false;
+  statisticsAggregates_.reset();
+  if (!aggregates_.empty() && !splitReader_->emptySplit()) {
+    statisticsAggregates_ = aggregateFromStatistics();
+    splitAggregatedFromStatistics_ = statisticsAggregates_ != nullptr;
+  }
+}
+
+RowVectorPtr HiveDataSource::aggregateFromStatistics() {
+  // Filters on partition keys apply to the split as a whole and have passed
+  // if the split is not empty. Other filters need the rows.
+  if (remainingFilterExprSet_ || randomSkip_ || partitionFunction_) {
+    return nullptr;
+  }
+  for (const auto& [subfield, filter] : filters_) {
+    if (partitionKeys_.count(getColumnName(subfield)) == 0) {
+      return nullptr;
+    }
+  }
+  const auto* reader = splitReader_->readerWithExactStatistics();
+  if (!reader) {
+    return nullptr;
+  }
+  const auto numRows = reader->numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  std::vector<VectorPtr> values;
+  values.reserve(aggregates_.size());
+  for (const auto& aggregate : aggregates_) {
+    auto value = aggregateFromStatistics(aggregate, *reader, *numRows);
+    if (!value) {
+      return nullptr;
+    }
+    values.push_back(std::move(value));
+  }
+  ++numSplitsAggregatedFromStatistics_;
+  completedRows_ += *numRows;
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), 1, std::move(values));
+}
+
+VectorPtr HiveDataSource::aggregateFromStatistics(
+    const Aggregate& aggregate,
+    const dwio::common::Reader& reader,
+    uint64_t numRows) {
+  if (!aggregate.handle) {
+    return makeCount(numRows, pool_);
+  }
+  const auto& name = aggregate.handle->name();
+  if (aggregate.handle->columnType() ==
+      HiveColumnHandle::ColumnType::kPartitionKey) {
+    if (aggregate.kind != ScanAggregate::Kind::kCount) {
+      return nullptr;
+    }
+    auto it = split_->partitionKeys.find(name);
+    if (it == split_->partitionKeys.end()) {
+      return nullptr;
+    }
+    return makeCount(it->second.has_value() ? numRows : 0, pool_);
+  }
+  // A column which is not in the file, or is mapped to a file column by
+  // position, is not looked up.
+  const auto& fileType = reader.rowType();
+  const auto fileIndex = fileType->getChildIdxIfExists(name);
+  const auto& type = aggregate.handle->dataType();
+  if (!fileIndex.has_value() ||
+      fileType->childAt(*fileIndex)->kind() != type->kind()) {
+    return nullptr;
+  }
+  auto stats =
+      reader.columnStatistics(reader.typeWithId()->childAt(*fileIndex)->id());
+  if (!stats || !stats->getNumberOfValues().has_value()) {
+    return nullptr;
+  }
+  const auto numValues = *stats->getNumberOfValues();
+  if (aggregate.kind == ScanAggregate::Kind::kCount) {
+    return makeCount(numValues, pool_);
+  }
+  return minMaxFromStatistics(
+      type,
+      aggregate.kind == ScanAggregate::Kind::kMin,
+      *stats,
+      numValues,
+      pool_);
+}
+
+RowVectorPtr HiveDataSource::aggregateRows(
+    const RowVectorPtr& rowVector,
+    vector_size_t numRows,
+    const BufferPtr& indices) {
+  const auto* rawIndices = indices ? indices->as<vector_size_t>() : nullptr;
+  auto rowAt = [&](vector_size_t i) { return rawIndices ? rawIndices[i] : i; };
+  std::vector<VectorPtr> values;
+  values.reserve(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    if (!aggregate.handle) {
+      values.push_back(makeCount(numRows, pool_));
+      continue;
+    }
+    const auto& vector =
+        BaseVector::loadedVectorShared(rowVector->childAt(aggregate.channel));
+    if (aggregate.kind == ScanAggregate::Kind::kCount) {
+      int64_t count = 0;
+      for (auto j = 0; j < numRows; ++j) {
+        count += !vector->isNullAt(rowAt(j));
+      }
+      values.push_back(makeCount(count, pool_));
+      continue;
+    }
+    const bool isMin = aggregate.kind == ScanAggregate::Kind::kMin;
+    std::optional<vector_size_t> best;
+    for (auto j = 0; j < numRows; ++j) {
+      const auto row = rowAt(j);
+      if (vector->isNullAt(row)) {
+        continue;
+      }
+      if (!best.has_value()) {
+        best = row;
+        continue;
+      }
+      const auto result = vector->compare(vector.get(), row, *best, {});
+      if (result.has_value() && (isMin ? *result < 0 : *result > 0)) {
+        best = row;
+      }
+    }
+    const auto& type = outputType_->childAt(i);
+    if (!best.has_value()) {
+      values.push_back(BaseVector::createNullConstant(type, 1, pool_));
+      continue;
+    }
+    // Copies the value so that the batch is not kept referenced.
+    auto value = BaseVector::create(type, 1, pool_);
+    value->copy(vector.get(), 0, *best, 1);
+    values.push_back(std::move(value));
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), 1, std::move(values));
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -374,6 +712,16 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (splitAggregatedFromStatistics_) {
+    if (statisticsAggregates_) {
+      return std::move(statisticsAggregates_);
+    }
+    splitAggregatedFromStatistics_ = false;
+    splitReader_->updateRuntimeStats(runtimeStats_);
+    resetSplit();
+    return nullptr;
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -429,6 +777,10 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     }
   }
 
+  if (!aggregates_.empty()) {
+    return aggregateRows(rowVector, rowsRemaining, remainingIndices);
+  }
+
   if (outputType_->size() == 0) {
     return exec::wrap(rowsRemaining, remainingIndices, rowVector);
   }
@@ -453,6 +805,9 @@ std::optional<RowVectorPtr> HiveDataSource::next(
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  VELOX_CHECK(
+      aggregates_.empty(),
+      "Dynamic filters are not supported in a scan with aggregates");
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
@@ -496,9 +851,32 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"overreadBytes",
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)}});
+  const auto& ioWaitHistogram = ioStats_->queryThreadIoLatency().histogram();
+  if (ioWaitHistogram.count() > 0) {
+    res.insert(
+        {{"p50SingleIoWaitWallNanos",
+          RuntimeCounter(
+              ioWaitHistogram.percentile(50) * 1000,
+              RuntimeCounter::Unit::kNanos)},
+         {"p99SingleIoWaitWallNanos",
+          RuntimeCounter(
+              ioWaitHistogram.percentile(99) * 1000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
+  for (const auto& [backend, stats] : ioStats_->storageReadStats()) {
+    addStorageReadStats(
+        fmt::format("storage.{}.demand.", backend), stats.demand, res);
+    addStorageReadStats(
+        fmt::format("storage.{}.prefetch.", backend), stats.prefetch, res);
+  }
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numSplitsAggregatedFromStatistics_ > 0) {
+    res.insert(
+        {"numSplitsAggregatedFromStatistics",
+         RuntimeCounter(numSplitsAggregatedFromStatistics_)});
+  }
   return res;
 }
 
@@ -521,6 +899,22 @@ void HiveDataSource::setFromDataSource(
   ioStats_ = std::move(source->ioStats_);
   numBucketConversion_ += source->numBucketConversion_;
   partitionFunction_ = std::move(source->partitionFunction_);
+  completedRows_ += source->completedRows_;
+  splitAggregatedFromStatistics_ = source->splitAggregatedFromStatistics_;
+  statisticsAggregates_ = std::move(source->statisticsAggregates_);
+  numSplitsAggregatedFromStatistics_ +=
+      source->numSplitsAggregatedFromStatistics_;
+}
+
+void HiveDataSource::setRowLimit(uint64_t numRows) {
+  if (numRows > 0 || !splitReader_) {
+    return;
+  }
+  // Frees the readers of the current split, which cancels their pending
+  // loads.
+  splitReader_->updateRuntimeStats(runtimeStats_);
+  split_.reset();
+  splitReader_.reset();
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -46,7 +46,8 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      std::shared_ptr<folly::Executor> queryIoExecutor = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -73,6 +74,8 @@ class HiveDataSource : public DataSource {
 
   void setFromDataSource(std::unique_ptr<DataSource> sourceUnique) override;
 
+  void setRowLimit(uint64_t numRows) override;
+
   int64_t estimatedRowSize() override;
 
   std::shared_ptr<wave::WaveDataSource> toWaveDataSource() override;
@@ -104,6 +107,9 @@ class HiveDataSource : public DataSource {
   virtual std::unique_ptr<SplitReader> createSplitReader();
 
   FileHandleFactory* const fileHandleFactory_;
+  // If set, the executor of the split readers which queues the asynchronous
+  // loads of the query in the connector's IoScheduler.
+  const std::shared_ptr<folly::Executor> queryIoExecutor_;
   folly::Executor* const executor_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
@@ -128,6 +134,15 @@ class HiveDataSource : public DataSource {
   std::shared_ptr<io::IoStatistics> ioStats_;
 
  private:
+  // An aggregate of ConnectorTableHandle::aggregates().
+  struct Aggregate {
+    ScanAggregate::Kind kind;
+    // The aggregated column. Null for count(*).
+    std::shared_ptr<HiveColumnHandle> handle;
+    // The channel of the column in 'readerOutputType_'.
+    column_index_t channel{0};
+  };
+
   std::unique_ptr<HivePartitionFunction> setupBucketConversion();
   vector_size_t applyBucketConversion(
       const RowVectorPtr& rowVector,
@@ -135,6 +150,35 @@ class HiveDataSource : public DataSource {
 
   void setupRowIdColumn();
 
+  // Adds the columns of the aggregates of 'hiveTableHandle_' to the columns
+  // to read and sets 'aggregates_'.
+  void setupAggregates(
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      std::vector<std::string>& readColumnNames,
+      std::vector<TypePtr>& readColumnTypes);
+
+  // Returns a row with the aggregates of all the rows of the split computed
+  // from the statistics of the file, or nullptr if these do not give the
+  // exact result.
+  RowVectorPtr aggregateFromStatistics();
+
+  // Returns a constant vector of size 1 with the value of 'aggregate' of the
+  // 'numRows' rows of 'reader', or nullptr if the statistics do not give it.
+  VectorPtr aggregateFromStatistics(
+      const Aggregate& aggregate,
+      const dwio::common::Reader& reader,
+      uint64_t numRows);
+
+  // Returns a row with the aggregates of the first 'numRows' rows of
+  // 'indices' in 'rowVector', or of its first 'numRows' rows if 'indices' is
+  // null.
+  RowVectorPtr aggregateRows(
+      const RowVectorPtr& rowVector,
+      vector_size_t numRows,
+      const BufferPtr& indices);
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If none or all rows passed
@@ -176,6 +220,16 @@ class HiveDataSource : public DataSource {
 
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // Corresponds 1:1 to the columns of 'outputType_' if the scan computes
+  // aggregates instead of returning the rows.
+  std::vector<Aggregate> aggregates_;
+  // True if the aggregates of the current split are computed from the
+  // statistics of the file. 'statisticsAggregates_' is the result, which is
+  // returned by the first call to next() for the split.
+  bool splitAggregatedFromStatistics_{false};
+  RowVectorPtr statisticsAggregates_;
+  int64_t numSplitsAggregatedFromStatistics_{0};
+
   int64_t numBucketConversion_ = 0;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
@@ -51,12 +51,13 @@ PartitionIdGenerator::PartitionIdGenerator(
     partitionKeyNames.push_back(inputType->nameOf(channel));
   }
 
+  const auto initialSize = std::min(maxPartitions_, kInitialPartitions);
   partitionValues_ = BaseVector::create<RowVector>(
       ROW(std::move(partitionKeyNames), std::move(partitionKeyTypes)),
-      maxPartitions_,
+      initialSize,
       pool);
   for (auto& key : partitionValues_->children()) {
-    key->resize(maxPartitions_);
+    key->resize(initialSize);
   }
 }
 
@@ -172,6 +173,15 @@ void PartitionIdGenerator::savePartitionValues(
     uint64_t partitionId,
     const RowVectorPtr& input,
     vector_size_t row) {
+  if (partitionId >= partitionValues_->size()) {
+    const auto newSize = std::min<uint64_t>(
+        std::max<uint64_t>(partitionValues_->size() * 2, partitionId + 1),
+        maxPartitions_);
+    partitionValues_->resize(newSize);
+    for (auto& key : partitionValues_->children()) {
+      key->resize(newSize);
+    }
+  }
   for (auto i = 0; i < partitionChannels_.size(); ++i) {
     auto channel = partitionChannels_[i];
     partitionValues_->childAt(i)->copy(
@@ -56,6 +56,9 @@ class PartitionIdGenerator {
 
  private:
   static constexpr const int32_t kHasherReservePct = 20;
+  // The number of partitions 'partitionValues_' has room for initially. It
+  // grows as needed up to 'maxPartitions_'.
+  static constexpr uint32_t kInitialPartitions = 1'024;
 
   // Computes value IDs using VectorHashers for all rows in 'input'.
   void computeValueIds(
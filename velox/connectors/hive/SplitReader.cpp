@@ -146,6 +146,9 @@ void SplitReader::configureReaderOptions(
 void SplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (skipByColumnRanges(runtimeStats)) {
+    return;
+  }
   createReader(std::move(metadataFilter));
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -175,6 +178,14 @@ bool SplitReader::emptySplit() const {
   return emptySplit_;
 }
 
+const dwio::common::Reader* SplitReader::readerWithExactStatistics() const {
+  if (!baseReader_ || emptySplit_ || hiveSplit_->start != 0 ||
+      hiveSplit_->length < fileSize_) {
+    return nullptr;
+  }
+  return baseReader_.get();
+}
+
 void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
@@ -249,6 +260,7 @@ void SplitReader::createReader(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  fileSize_ = fileHandleCachePtr->file->size();
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -273,6 +285,19 @@ void SplitReader::createReader(
       baseRowReaderOpts_);
 }
 
+bool SplitReader::skipByColumnRanges(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (testColumnRanges(scanSpec_.get(), hiveSplit_->columnRanges)) {
+    return false;
+  }
+  VLOG(1) << "Skipping " << hiveSplit_->filePath
+          << " based on column ranges and filters";
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  emptySplit_ = true;
+  return true;
+}
+
 bool SplitReader::checkIfSplitIsEmpty(
     dwio::common::RuntimeStatistics& runtimeStats) {
   // emptySplit_ may already be set if the data file is not found. In this case
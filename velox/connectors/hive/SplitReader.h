@@ -85,6 +85,12 @@ class SplitReader {
 
   bool emptySplit() const;
 
+  /// Returns the reader of the file if the statistics in the metadata of the
+  /// file describe exactly the rows of the split, i.e. the split covers the
+  /// whole file and no rows are deleted. Returns nullptr otherwise. May be
+  /// called after prepareSplit().
+  virtual const dwio::common::Reader* readerWithExactStatistics() const;
+
   void resetSplit();
 
   int64_t estimatedRowSize() const;
@@ -115,6 +121,11 @@ class SplitReader {
   /// read the data file's metadata and schema
   void createReader(std::shared_ptr<common::MetadataFilter> metadataFilter);
 
+  /// Returns true and marks the split empty if the filters cannot pass the
+  /// column ranges of hiveSplit_. Called before createReader() so that the
+  /// file of such a split is not opened.
+  bool skipByColumnRanges(dwio::common::RuntimeStatistics& runtimeStats);
+
   /// Check if the hiveSplit_ is empty. The split is considered empty when
   ///   1) The data file is missing but the user chooses to ignore it
   ///   2) The file does not contain any rows
@@ -158,6 +169,8 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // The size of the file of the split. Set by createReader().
+  uint64_t fileSize_{0};
 };
 
 } // namespace facebook::velox::connector::hive
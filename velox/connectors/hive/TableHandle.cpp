@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/TableHandle.h"
 
+#include <folly/String.h>
+
 namespace facebook::velox::connector::hive {
 
 namespace {
@@ -110,14 +112,18 @@ HiveTableHandle::HiveTableHandle(
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<std::string> sortedColumns,
+    std::vector<ScanAggregate> aggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      sortedColumns_(std::move(sortedColumns)),
+      aggregates_(std::move(aggregates)) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -145,6 +151,16 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!sortedColumns_.empty()) {
+    out << ", sorted by: " << folly::join(", ", sortedColumns_);
+  }
+  if (!aggregates_.empty()) {
+    out << ", aggregates: [";
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      out << (i > 0 ? ", " : "") << aggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -168,6 +184,20 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!sortedColumns_.empty()) {
+    folly::dynamic sortedColumns = folly::dynamic::array;
+    for (const auto& column : sortedColumns_) {
+      sortedColumns.push_back(column);
+    }
+    obj["sortedColumns"] = sortedColumns;
+  }
+  if (!aggregates_.empty()) {
+    folly::dynamic aggregates = folly::dynamic::array;
+    for (const auto& aggregate : aggregates_) {
+      aggregates.push_back(aggregate.serialize());
+    }
+    obj["aggregates"] = aggregates;
+  }
 
   return obj;
 }
@@ -200,13 +230,30 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  std::vector<std::string> sortedColumns;
+  if (auto it = obj.find("sortedColumns"); it != obj.items().end()) {
+    for (const auto& column : it->second) {
+      sortedColumns.push_back(column.asString());
+    }
+  }
+
+  std::vector<ScanAggregate> aggregates;
+  if (auto it = obj.find("aggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      aggregates.push_back(ScanAggregate::create(aggregate));
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::unordered_map<std::string, std::string>{},
+      std::move(sortedColumns),
+      std::move(aggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -61,7 +61,7 @@ class HiveColumnHandle : public ColumnHandle {
         hiveType_->toString());
   }
 
-  const std::string& name() const {
+  const std::string& name() const override {
     return name_;
   }
 
@@ -129,7 +129,9 @@ class HiveTableHandle : public ConnectorTableHandle {
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      std::vector<std::string> sortedColumns = {},
+      std::vector<ScanAggregate> aggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -156,6 +158,17 @@ class HiveTableHandle : public ConnectorTableHandle {
     return tableParameters_;
   }
 
+  // Columns by which the data files are sorted, e.g. the sorted columns of a
+  // bucketed table written by SortingWriter.
+  const std::vector<std::string>& sortedColumns() const override {
+    return sortedColumns_;
+  }
+
+  // Aggregates computed by HiveDataSource instead of returning the rows.
+  const std::vector<ScanAggregate>& aggregates() const override {
+    return aggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -173,6 +186,8 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<std::string> sortedColumns_;
+  const std::vector<ScanAggregate> aggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteCache.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/exec/VectorHasher.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+folly::Synchronized<std::shared_ptr<EqualityDeleteCache>>& cacheInstance() {
+  static folly::Synchronized<std::shared_ptr<EqualityDeleteCache>> instance;
+  return instance;
+}
+} // namespace
+
+void EqualityDeleteSet::add(const RowVectorPtr& deletes) {
+  VELOX_CHECK(deletes->type()->equivalent(*keyType_));
+  const auto numRows = deletes->size();
+  if (numRows == 0) {
+    return;
+  }
+  deletes->loadedVector();
+  raw_vector<uint64_t> hashes(numRows);
+  hashRows(deletes->children(), numRows, hashes);
+
+  const int32_t batch = batches_.size();
+  batches_.push_back(deletes);
+  entries_.reserve(entries_.size() + numRows);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const int32_t index = entries_.size();
+    auto [it, inserted] = table_.try_emplace(hashes[row], index);
+    entries_.push_back({batch, row, inserted ? -1 : it->second});
+    it->second = index;
+  }
+}
+
+vector_size_t EqualityDeleteSet::findDeleted(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows,
+    uint64_t* deletedRows) const {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  if (entries_.empty() || numRows == 0) {
+    return 0;
+  }
+  raw_vector<uint64_t> hashes(numRows);
+  hashRows(keys, numRows, hashes);
+
+  vector_size_t numDeleted = 0;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (bits::isBitSet(deletedRows, row)) {
+      continue;
+    }
+    auto it = table_.find(hashes[row]);
+    if (it == table_.end()) {
+      continue;
+    }
+    for (auto index = it->second; index != -1; index = entries_[index].next) {
+      if (equals(keys, row, entries_[index])) {
+        bits::setBit(deletedRows, row);
+        ++numDeleted;
+        break;
+      }
+    }
+  }
+  return numDeleted;
+}
+
+uint64_t EqualityDeleteSet::memoryBytes() const {
+  uint64_t bytes = sizeof(*this) + entries_.capacity() * sizeof(Entry) +
+      table_.getAllocatedMemorySize();
+  for (const auto& batch : batches_) {
+    bytes += batch->retainedSize();
+  }
+  return bytes;
+}
+
+void EqualityDeleteSet::hashRows(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows,
+    raw_vector<uint64_t>& hashes) const {
+  SelectivityVector rows(numRows);
+  for (auto i = 0; i < keys.size(); ++i) {
+    exec::VectorHasher hasher(keyType_->childAt(i), i);
+    hasher.decode(*keys[i]->loadedVector(), rows);
+    hasher.hash(rows, i > 0, hashes);
+  }
+}
+
+bool EqualityDeleteSet::equals(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t row,
+    const Entry& entry) const {
+  const auto& batch = batches_[entry.batch];
+  for (auto i = 0; i < keys.size(); ++i) {
+    if (!keys[i]->equalValueAt(batch->childAt(i).get(), row, entry.row)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+EqualityDeleteCache::EqualityDeleteCache(uint64_t maxBytes)
+    : pool_(memory::memoryManager()->addLeafPool("icebergEqualityDeletes")),
+      factory_(
+          std::make_unique<SimpleLRUCache<std::string, EqualityDeleteSet>>(
+              maxBytes),
+          std::make_unique<EqualityDeleteSetGenerator>(pool_.get())) {}
+
+// static
+std::shared_ptr<EqualityDeleteCache> EqualityDeleteCache::getInstance() {
+  return *cacheInstance().rlock();
+}
+
+// static
+void EqualityDeleteCache::setInstance(
+    std::shared_ptr<EqualityDeleteCache> cache) {
+  *cacheInstance().wlock() = std::move(cache);
+}
+
+EqualityDeleteSetCachedPtr EqualityDeleteCache::get(
+    const IcebergDeleteFile& deleteFile,
+    const EqualityDeleteSetReader& reader) {
+  // Delete files are immutable. The size is part of the key in case a path
+  // is reused.
+  const auto key =
+      fmt::format("{}\n{}", deleteFile.filePath, deleteFile.fileSizeInBytes);
+  return factory_.generate(key, &reader);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The rows of one equality delete file, hashed on all their columns. A row
+/// of a data file is deleted if its values in the same columns are equal to
+/// the values of one of these rows. Nulls are equal to nulls.
+class EqualityDeleteSet {
+ public:
+  /// 'keyType' is the type of the equality columns. The added rows must be
+  /// allocated from 'pool'.
+  EqualityDeleteSet(RowTypePtr keyType, memory::MemoryPool* pool)
+      : keyType_(std::move(keyType)), pool_(pool) {}
+
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
+  /// Adds the rows of 'deletes', which is of 'keyType'. Keeps a reference to
+  /// 'deletes', so the caller must not reuse it.
+  void add(const RowVectorPtr& deletes);
+
+  /// Sets bit 'i' of 'deletedRows' for each row 'i' in [0, 'numRows') of
+  /// 'keys' which is equal to one of the deleted rows. 'keys' has one
+  /// vector per column of 'keyType'. Returns the number of bits set which
+  /// were not already set.
+  vector_size_t findDeleted(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t numRows,
+      uint64_t* deletedRows) const;
+
+  uint64_t numRows() const {
+    return entries_.size();
+  }
+
+  /// Returns the number of bytes retained by the deleted rows and the hash
+  /// table.
+  uint64_t memoryBytes() const;
+
+ private:
+  struct Entry {
+    int32_t batch;
+    vector_size_t row;
+    // The next entry with the same hash or -1.
+    int32_t next;
+  };
+
+  void hashRows(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t numRows,
+      raw_vector<uint64_t>& hashes) const;
+
+  bool equals(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t row,
+      const Entry& entry) const;
+
+  const RowTypePtr keyType_;
+  memory::MemoryPool* const pool_;
+  std::vector<RowVectorPtr> batches_;
+  std::vector<Entry> entries_;
+  // Maps a hash to the most recently added entry with the hash.
+  folly::F14FastMap<uint64_t, int32_t> table_;
+};
+
+struct EqualityDeleteSetSizer {
+  uint64_t operator()(const EqualityDeleteSet& deletes) {
+    return deletes.memoryBytes();
+  }
+};
+
+/// Reads the rows of an equality delete file on a cache miss. Takes the pool
+/// for the rows.
+using EqualityDeleteSetReader =
+    std::function<std::unique_ptr<EqualityDeleteSet>(memory::MemoryPool*)>;
+
+/// Allocates the rows from the pool of the cache, so that they outlive the
+/// query which read them.
+struct EqualityDeleteSetGenerator {
+  explicit EqualityDeleteSetGenerator(memory::MemoryPool* pool) : pool(pool) {}
+
+  std::unique_ptr<EqualityDeleteSet> operator()(
+      const std::string& /*key*/,
+      const EqualityDeleteSetReader* reader) {
+    return (*reader)(pool);
+  }
+
+  memory::MemoryPool* const pool;
+};
+
+using EqualityDeleteSetCachedPtr = CachedPtr<std::string, EqualityDeleteSet>;
+
+/// A worker level cache of the hashed rows of equality delete files. An
+/// equality delete file applies to all the data files of a snapshot which
+/// predate it, so the splits of these files can share one EqualityDeleteSet.
+/// The size of the cache is the memory used by the sets, which is allocated
+/// from a leaf pool of the cache. Caching is enabled by setting the instance.
+class EqualityDeleteCache {
+ public:
+  explicit EqualityDeleteCache(uint64_t maxBytes);
+
+  /// Returns the process-wide cache or nullptr if caching is disabled.
+  static std::shared_ptr<EqualityDeleteCache> getInstance();
+
+  /// Sets the process-wide cache. nullptr disables caching. Readers which
+  /// already hold the previous instance keep it alive until they finish.
+  static void setInstance(std::shared_ptr<EqualityDeleteCache> cache);
+
+  /// Returns the rows of 'deleteFile'. Calls 'reader' to read them if they
+  /// are not cached. The returned entry stays pinned until the pointer is
+  /// destroyed.
+  EqualityDeleteSetCachedPtr get(
+      const IcebergDeleteFile& deleteFile,
+      const EqualityDeleteSetReader& reader);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  /// Evicts all the entries which are not in use.
+  void clear() {
+    factory_.clearCache();
+  }
+
+ private:
+  // Declared before 'factory_' so that it outlives the cached rows.
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  CachedFactory<
+      std::string,
+      EqualityDeleteSet,
+      EqualityDeleteSetGenerator,
+      EqualityDeleteSetReader,
+      EqualityDeleteSetSizer>
+      factory_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteCache.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      fileHandleFactory_(fileHandleFactory),
+      connectorQueryCtx_(connectorQueryCtx),
+      executor_(executor),
+      hiveConfig_(hiveConfig),
+      ioStats_(ioStats),
+      connectorId_(connectorId) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+}
+
+void EqualityDeleteFileReader::readDeletes(EqualityDeleteSet& deletes) {
+  const auto& keyType = deletes.keyType();
+  auto* pool = deletes.pool();
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType->size(); ++i) {
+    scanSpec->addField(keyType->nameOf(i), i);
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool);
+  configureReaderOptions(
+      deleteReaderOpts, hiveConfig_, connectorQueryCtx_, keyType, deleteSplit);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory_->generate(deleteFile_.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx_,
+      ioStats_,
+      executor_);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      keyType,
+      deleteSplit,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  static constexpr uint64_t kBatchSize = 10'000;
+  for (;;) {
+    // The rows are kept by 'deletes', so each batch is read into a new vector.
+    VectorPtr output = BaseVector::create(keyType, 0, pool);
+    if (deleteRowReader->next(kBatchSize, output) == 0) {
+      break;
+    }
+    if (output->size() > 0) {
+      deletes.add(std::dynamic_pointer_cast<RowVector>(output));
+    }
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+class EqualityDeleteSet;
+struct IcebergDeleteFile;
+
+/// Reads the rows of an Iceberg equality delete file into an
+/// EqualityDeleteSet.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Adds all the rows of the delete file to 'deletes'. Reads the columns of
+  /// 'deletes->keyType()' by name and allocates the rows from
+  /// 'deletes->pool()'.
+  void readDeletes(EqualityDeleteSet& deletes);
+
+ private:
+  const IcebergDeleteFile& deleteFile_;
+  FileHandleFactory* const fileHandleFactory_;
+  const ConnectorQueryCtx* const connectorQueryCtx_;
+  folly::Executor* const executor_;
+  const std::shared_ptr<const HiveConfig> hiveConfig_;
+  const std::shared_ptr<io::IoStatistics> ioStats_;
+  const std::string connectorId_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -26,6 +26,11 @@ struct IcebergDeleteFile;
 struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
   std::vector<IcebergDeleteFile> deleteFiles;
 
+  /// The names of the top level columns of the table schema by their Iceberg
+  /// field ids. The equality field ids of the delete files are resolved
+  /// through this. The ids are not column positions after schema evolution.
+  std::unordered_map<int32_t, std::string> columnNamesByFieldId;
+
   HiveIcebergSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -55,6 +60,11 @@ struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
       std::vector<IcebergDeleteFile> deletes = {},
       const std::unordered_map<std::string, std::string>& _infoColumns = {},
       std::optional<FileProperties> fileProperties = std::nullopt);
+
+  /// The delete files are not part of the serialized split.
+  std::optional<std::string> resultCacheKey() const override {
+    return std::nullopt;
+  }
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
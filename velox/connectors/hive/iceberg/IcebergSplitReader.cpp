@@ -16,9 +16,11 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/exec/OperatorUtils.h"
 
 using namespace facebook::velox::dwio::common;
 
@@ -55,6 +57,9 @@ IcebergSplitReader::IcebergSplitReader(
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (skipByColumnRanges(runtimeStats)) {
+    return;
+  }
   createReader(std::move(metadataFilter));
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -69,11 +74,39 @@ void IcebergSplitReader::prepareSplit(
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  cachedDeletePositions_.clear();
+  deleteCache_ = PositionalDeleteCache::getInstance();
+  equalityDeletes_.clear();
+  equalityDeleteCache_ = EqualityDeleteCache::getInstance();
+  readerOutput_.reset();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
-      if (deleteFile.recordCount > 0) {
+      if (deleteFile.recordCount == 0) {
+        continue;
+      }
+      if (deleteCache_) {
+        // The positions are read from the start of the base file so that the
+        // other splits of the file can use them.
+        cachedDeletePositions_.push_back(deleteCache_->get(
+            deleteFile, hiveSplit_->filePath, [&]() {
+              auto positions = std::make_unique<DeletePositions>();
+              PositionalDeleteFileReader(
+                  deleteFile,
+                  hiveSplit_->filePath,
+                  fileHandleFactory_,
+                  connectorQueryCtx_,
+                  executor_,
+                  hiveConfig_,
+                  ioStats_,
+                  runtimeStats,
+                  0,
+                  hiveSplit_->connectorId)
+                  .readAllDeletePositions(*positions);
+              return positions;
+            }));
+      } else {
         positionalDeleteFileReaders_.push_back(
             std::make_unique<PositionalDeleteFileReader>(
                 deleteFile,
@@ -87,18 +120,100 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        addEqualityDeletes(deleteFile, icebergSplit->columnNamesByFieldId);
+      }
     } else {
       VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::addEqualityDeletes(
+    const IcebergDeleteFile& deleteFile,
+    const std::unordered_map<int32_t, std::string>& columnNamesByFieldId) {
+  VELOX_USER_CHECK(
+      !deleteFile.equalityFieldIds.empty(),
+      "Iceberg equality delete file {} has no equality field ids",
+      deleteFile.filePath);
+  const auto& dataColumns = hiveTableHandle_->dataColumns();
+  VELOX_USER_CHECK_NOT_NULL(
+      dataColumns, "Iceberg equality deletes require the table schema");
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  EqualityDeletes equalityDeletes;
+  for (auto fieldId : deleteFile.equalityFieldIds) {
+    auto it = columnNamesByFieldId.find(fieldId);
+    VELOX_USER_CHECK(
+        it != columnNamesByFieldId.end(),
+        "Iceberg equality field id {} is not in the table schema",
+        fieldId);
+    const auto& name = it->second;
+    auto column = dataColumns->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        column.has_value(),
+        "Iceberg equality delete column {} is not in the table schema",
+        name);
+    auto channel = readerOutputType_->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Iceberg equality delete column {} must be read by the scan",
+        name);
+    names.push_back(name);
+    types.push_back(dataColumns->childAt(*column));
+    equalityDeletes.channels.push_back(*channel);
+  }
+  auto keyType = ROW(std::move(names), std::move(types));
+
+  auto readDeletes = [&](memory::MemoryPool* pool) {
+    auto deletes = std::make_unique<EqualityDeleteSet>(keyType, pool);
+    EqualityDeleteFileReader(
+        deleteFile,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        hiveSplit_->connectorId)
+        .readDeletes(*deletes);
+    return deletes;
+  };
+  if (equalityDeleteCache_) {
+    equalityDeletes.deletes =
+        equalityDeleteCache_->get(deleteFile, readDeletes);
+  } else {
+    equalityDeletes.deletes = EqualityDeleteSetCachedPtr(
+        readDeletes(connectorQueryCtx_->memoryPool()).release());
+  }
+  VELOX_CHECK(equalityDeletes.deletes->keyType()->equivalent(*keyType));
+  equalityDeletes_.push_back(std::move(equalityDeletes));
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (deleteBitmap_ && deleteBitmapBitOffset_ > 0) {
+  if (!cachedDeletePositions_.empty()) {
+    // The bitmap is made from scratch for each batch, there are no bits left
+    // from the previous one.
+    const auto numWords = bits::nwords(size);
+    dwio::common::ensureCapacity<uint64_t>(
+        deleteBitmap_,
+        numWords,
+        connectorQueryCtx_->memoryPool(),
+        false,
+        true);
+    auto* rawBitmap = deleteBitmap_->asMutable<uint64_t>();
+    std::memset(rawBitmap, 0, numWords * sizeof(uint64_t));
+    uint64_t numDeleted = 0;
+    for (const auto& positions : cachedDeletePositions_) {
+      numDeleted +=
+          positions->setBits(splitOffset_ + baseReadOffset_, size, rawBitmap);
+    }
+    deleteBitmap_->setSize(numDeleted > 0 ? bits::nbytes(size) : 0);
+  } else if (deleteBitmap_ && deleteBitmapBitOffset_ > 0) {
     // There are unconsumed bits from last batch
     if (deleteBitmapBitOffset_ < deleteBitmap_->size() * 8) {
       bits::copyBits(
@@ -144,11 +259,61 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
       ? deleteBitmap_->as<uint64_t>()
       : nullptr;
 
+  if (readerOutput_) {
+    output = std::move(readerOutput_);
+  }
   auto rowsScanned = baseRowReader_->next(size, output, &mutation);
   baseReadOffset_ += rowsScanned;
   deleteBitmapBitOffset_ = rowsScanned;
 
+  if (!equalityDeletes_.empty() && output->size() > 0) {
+    applyEqualityDeletes(output);
+  }
+
   return rowsScanned;
 }
 
+const dwio::common::Reader* IcebergSplitReader::readerWithExactStatistics()
+    const {
+  if (!positionalDeleteFileReaders_.empty() ||
+      !cachedDeletePositions_.empty() || !equalityDeletes_.empty()) {
+    return nullptr;
+  }
+  return SplitReader::readerWithExactStatistics();
+}
+
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(output);
+  VELOX_CHECK_NOT_NULL(rowVector);
+  const auto numRows = rowVector->size();
+  equalityDeletedRows_.assign(bits::nwords(numRows), 0);
+  vector_size_t numDeleted = 0;
+  std::vector<VectorPtr> keys;
+  for (const auto& equalityDeletes : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : equalityDeletes.channels) {
+      keys.push_back(
+          BaseVector::loadedVectorShared(rowVector->childAt(channel)));
+    }
+    numDeleted += equalityDeletes.deletes->findDeleted(
+        keys, numRows, equalityDeletedRows_.data());
+  }
+  if (numDeleted == 0) {
+    return;
+  }
+
+  const auto numRemaining = numRows - numDeleted;
+  auto indices =
+      allocateIndices(numRemaining, connectorQueryCtx_->memoryPool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  bits::forEachUnsetBit(
+      equalityDeletedRows_.data(), 0, numRows, [&](vector_size_t row) {
+        rawIndices[numIndices++] = row;
+      });
+  VELOX_CHECK_EQ(numIndices, numRemaining);
+  readerOutput_ = output;
+  output = exec::wrap(numRemaining, std::move(indices), rowVector);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
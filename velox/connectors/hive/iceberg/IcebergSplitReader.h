@@ -18,6 +18,8 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteCache.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -47,7 +49,29 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// Returns nullptr if there are deletes for the split.
+  const dwio::common::Reader* readerWithExactStatistics() const override;
+
  private:
+  // The rows of an equality delete file and the channels of its columns in
+  // the output of the reader.
+  struct EqualityDeletes {
+    // Owns the set if it is not cached.
+    EqualityDeleteSetCachedPtr deletes;
+    std::vector<column_index_t> channels;
+  };
+
+  // Reads the rows of 'deleteFile' into 'equalityDeletes_'. The equality field
+  // ids of 'deleteFile' are resolved to column names through
+  // 'columnNamesByFieldId'.
+  void addEqualityDeletes(
+      const IcebergDeleteFile& deleteFile,
+      const std::unordered_map<int32_t, std::string>& columnNamesByFieldId);
+
+  // Removes the rows of 'output' which match 'equalityDeletes_'. Replaces
+  // 'output' by a dictionary over the remaining rows if some are deleted.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -55,6 +79,20 @@ class IcebergSplitReader : public SplitReader {
   uint64_t splitOffset_;
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
+  // Set if PositionalDeleteCache is enabled. Then the positions of all the
+  // delete files are in 'cachedDeletePositions_' instead of being read by
+  // 'positionalDeleteFileReaders_'.
+  std::shared_ptr<PositionalDeleteCache> deleteCache_;
+  std::vector<DeletePositionsCachedPtr> cachedDeletePositions_;
+  // Set if EqualityDeleteCache is enabled.
+  std::shared_ptr<EqualityDeleteCache> equalityDeleteCache_;
+  std::vector<EqualityDeletes> equalityDeletes_;
+  // Bit 'i' is set if row 'i' of the output matches an equality delete.
+  std::vector<uint64_t> equalityDeletedRows_;
+  // The output of the reader if the output of the last batch was replaced
+  // by a dictionary over the rows which are not deleted. Reused for the next
+  // batch.
+  VectorPtr readerOutput_;
   BufferPtr deleteBitmap_;
   // The offset in bits of the deleteBitmap_ starting from where the bits shall
   // be consumed
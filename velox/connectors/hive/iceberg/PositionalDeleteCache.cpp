@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+folly::Synchronized<std::shared_ptr<PositionalDeleteCache>>& cacheInstance() {
+  static folly::Synchronized<std::shared_ptr<PositionalDeleteCache>> instance;
+  return instance;
+}
+} // namespace
+
+void DeletePositions::add(int64_t position) {
+  VELOX_CHECK_GE(position, 0);
+  VELOX_CHECK_GE(
+      position,
+      lastPosition_,
+      "Positional deletes must be in ascending order");
+  if (position == lastPosition_) {
+    return;
+  }
+  lastPosition_ = position;
+  ++numPositions_;
+
+  const int64_t high = position >> kContainerBits;
+  const uint16_t low = position & ((1 << kContainerBits) - 1);
+  if (containers_.empty() || containers_.back().high != high) {
+    containers_.push_back(Container{high, {}, {}});
+  }
+  auto& container = containers_.back();
+  if (!container.bitmap.empty()) {
+    bits::setBit(container.bitmap.data(), low);
+    return;
+  }
+  container.array.push_back(low);
+  if (container.array.size() > kMaxArraySize) {
+    container.bitmap.resize(kBitmapWords);
+    for (auto value : container.array) {
+      bits::setBit(container.bitmap.data(), value);
+    }
+    container.array.clear();
+    container.array.shrink_to_fit();
+  }
+}
+
+uint64_t DeletePositions::setBits(
+    int64_t begin,
+    uint64_t size,
+    uint64_t* bitmap) const {
+  if (size == 0) {
+    return 0;
+  }
+  const int64_t end = begin + size;
+  auto it = std::lower_bound(
+      containers_.begin(),
+      containers_.end(),
+      begin >> kContainerBits,
+      [](const Container& container, int64_t high) {
+        return container.high < high;
+      });
+  uint64_t numSet = 0;
+  for (; it != containers_.end() && (it->high << kContainerBits) < end; ++it) {
+    const int64_t base = it->high << kContainerBits;
+    // The range of low bits in [begin, end).
+    const int32_t lowBegin = std::max<int64_t>(begin - base, 0);
+    const int32_t lowEnd = std::min<int64_t>(end - base, 1 << kContainerBits);
+    if (!it->bitmap.empty()) {
+      bits::forEachSetBit(
+          it->bitmap.data(), lowBegin, lowEnd, [&](int32_t low) {
+            bits::setBit(bitmap, base + low - begin);
+            ++numSet;
+          });
+      continue;
+    }
+    for (auto low = std::lower_bound(
+             it->array.begin(), it->array.end(), lowBegin);
+         low != it->array.end() && *low < lowEnd;
+         ++low) {
+      bits::setBit(bitmap, base + *low - begin);
+      ++numSet;
+    }
+  }
+  return numSet;
+}
+
+uint64_t DeletePositions::memoryBytes() const {
+  uint64_t bytes = sizeof(*this) + containers_.capacity() * sizeof(Container);
+  for (const auto& container : containers_) {
+    bytes += container.array.capacity() * sizeof(uint16_t) +
+        container.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+PositionalDeleteCache::PositionalDeleteCache(uint64_t maxBytes)
+    : factory_(
+          std::make_unique<SimpleLRUCache<std::string, DeletePositions>>(
+              maxBytes),
+          std::make_unique<DeletePositionsGenerator>()) {}
+
+// static
+std::shared_ptr<PositionalDeleteCache> PositionalDeleteCache::getInstance() {
+  return *cacheInstance().rlock();
+}
+
+// static
+void PositionalDeleteCache::setInstance(
+    std::shared_ptr<PositionalDeleteCache> cache) {
+  *cacheInstance().wlock() = std::move(cache);
+}
+
+DeletePositionsCachedPtr PositionalDeleteCache::get(
+    const IcebergDeleteFile& deleteFile,
+    const std::string& baseFilePath,
+    const DeletePositionsReader& reader) {
+  // Delete files are immutable. The size is part of the key in case a path
+  // is reused.
+  const auto key = fmt::format(
+      "{}\n{}\n{}",
+      deleteFile.filePath,
+      deleteFile.fileSizeInBytes,
+      baseFilePath);
+  return factory_.generate(key, &reader);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
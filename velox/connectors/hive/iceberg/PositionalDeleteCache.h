@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/caching/CachedFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The positions of the rows of one data file deleted by one positional delete
+/// file. Stored like a roaring bitmap: the positions are grouped by their high
+/// 48 bits and each group keeps the low 16 bits either as a sorted array or,
+/// if it has more than 'kMaxArraySize' positions, as a bitmap.
+class DeletePositions {
+ public:
+  /// Adds 'position'. Positions must be added in ascending order. Repeated
+  /// positions are ignored.
+  void add(int64_t position);
+
+  /// Sets bit 'i' of 'bitmap' for each position 'begin + i' in ['begin',
+  /// 'begin' + 'size'). Returns the number of bits set.
+  uint64_t setBits(int64_t begin, uint64_t size, uint64_t* bitmap) const;
+
+  uint64_t numPositions() const {
+    return numPositions_;
+  }
+
+  /// Returns the number of bytes allocated for the positions.
+  uint64_t memoryBytes() const;
+
+ private:
+  static constexpr int32_t kContainerBits = 16;
+  static constexpr int32_t kMaxArraySize = 4'096;
+  static constexpr int32_t kBitmapWords = (1 << kContainerBits) / 64;
+
+  struct Container {
+    // The high bits of the positions, i.e. position >> kContainerBits.
+    int64_t high;
+    // The low bits of the positions in ascending order. Empty if 'bitmap' is
+    // used.
+    std::vector<uint16_t> array;
+    // Bit 'i' is set if 'i' is the low bits of a position. Empty until
+    // 'array' has more than 'kMaxArraySize' positions.
+    std::vector<uint64_t> bitmap;
+  };
+
+  // Sorted on 'high'.
+  std::vector<Container> containers_;
+  int64_t lastPosition_{-1};
+  uint64_t numPositions_{0};
+};
+
+struct DeletePositionsSizer {
+  uint64_t operator()(const DeletePositions& positions) {
+    return positions.memoryBytes();
+  }
+};
+
+/// Reads the positions on a cache miss.
+using DeletePositionsReader =
+    std::function<std::unique_ptr<DeletePositions>()>;
+
+struct DeletePositionsGenerator {
+  std::unique_ptr<DeletePositions> operator()(
+      const std::string& /*key*/,
+      const DeletePositionsReader* reader) {
+    return (*reader)();
+  }
+};
+
+using DeletePositionsCachedPtr = CachedPtr<std::string, DeletePositions>;
+
+/// A worker level cache of the positions deleted by positional delete files,
+/// keyed on the delete file and the data file. The splits of a data file then
+/// read each delete file once and only take the positions in their row range.
+/// The size of the cache is the memory used by the positions. Caching is
+/// enabled by setting the instance.
+class PositionalDeleteCache {
+ public:
+  explicit PositionalDeleteCache(uint64_t maxBytes);
+
+  /// Returns the process-wide cache or nullptr if caching is disabled.
+  static std::shared_ptr<PositionalDeleteCache> getInstance();
+
+  /// Sets the process-wide cache. nullptr disables caching. Readers which
+  /// already hold the previous instance keep it alive until they finish.
+  static void setInstance(std::shared_ptr<PositionalDeleteCache> cache);
+
+  /// Returns the positions of the rows of 'baseFilePath' deleted by
+  /// 'deleteFile'. Calls 'reader' to read them if they are not cached. The
+  /// returned entry stays pinned until the pointer is destroyed.
+  DeletePositionsCachedPtr get(
+      const IcebergDeleteFile& deleteFile,
+      const std::string& baseFilePath,
+      const DeletePositionsReader& reader);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  /// Evicts all the entries which are not in use.
+  void clear() {
+    factory_.clearCache();
+  }
+
+ private:
+  CachedFactory<
+      std::string,
+      DeletePositions,
+      DeletePositionsGenerator,
+      DeletePositionsReader,
+      DeletePositionsSizer>
+      factory_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
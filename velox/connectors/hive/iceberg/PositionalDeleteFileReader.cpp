@@ -20,6 +20,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -210,6 +211,44 @@ bool PositionalDeleteFileReader::noMoreData() {
       deletePositionsOffset_ >= deletePositionsOutput_->size();
 }
 
+void PositionalDeleteFileReader::readAllDeletePositions(
+    DeletePositions& positions) {
+  if (!deleteRowReader_ || !deleteSplit_) {
+    return;
+  }
+  static constexpr uint64_t kBatchSize = 10'000;
+  RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
+  VectorPtr output = BaseVector::create(outputRowType, 0, pool_);
+  std::vector<int64_t> allPositions;
+  while (deleteRowReader_->next(kBatchSize, output) > 0) {
+    VELOX_CHECK(
+        !output->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    if (output->size() == 0) {
+      continue;
+    }
+    output->loadedVector();
+    const auto& deletePositionsVector =
+        std::dynamic_pointer_cast<RowVector>(output)->childAt(0);
+    const int64_t* deletePositions =
+        deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
+    allPositions.insert(
+        allPositions.end(),
+        deletePositions,
+        deletePositions + deletePositionsVector->size());
+  }
+  deleteSplit_.reset();
+
+  // The positions for a base file are sorted within each RowGroup of the
+  // delete file but not necessarily across RowGroups.
+  if (!std::is_sorted(allPositions.begin(), allPositions.end())) {
+    std::sort(allPositions.begin(), allPositions.end());
+  }
+  for (auto position : allPositions) {
+    positions.add(position);
+  }
+}
+
 void PositionalDeleteFileReader::updateDeleteBitmap(
     VectorPtr deletePositionsVector,
     uint64_t baseReadOffset,
@@ -27,6 +27,7 @@
 
 namespace facebook::velox::connector::hive::iceberg {
 
+class DeletePositions;
 struct IcebergDeleteFile;
 struct IcebergMetadataColumn;
 
@@ -54,6 +55,11 @@ class PositionalDeleteFileReader {
 
   bool noMoreData();
 
+  /// Adds all the positions of the base file deleted by the delete file to
+  /// 'positions'. Used instead of readDeletePositions() when the positions
+  /// are cached across the splits of the base file.
+  void readAllDeletePositions(DeletePositions& positions);
+
  private:
   void updateDeleteBitmap(
       VectorPtr deletePositionsVector,
@@ -14,15 +14,18 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
 using namespace facebook::velox::exec::test;
@@ -163,13 +166,15 @@ class HiveIcebergTest : public HiveConnectorTestBase {
   /// positions for data_file_1 and data_file_2. THere are 3 RowGroups in this
   /// delete file, the first two contain positions for data_file_1, and the last
   /// contain positions for data_file_2
+  /// @numSplitsPerFile The number of splits each data file is divided into.
   void assertPositionalDeletes(
       const std::map<std::string, std::vector<int64_t>>& rowGroupSizesForFiles,
       const std::unordered_map<
           std::string,
           std::multimap<std::string, std::vector<int64_t>>>&
           deleteFilesForBaseDatafiles,
-      int32_t numPrefetchSplits = 0) {
+      int32_t numPrefetchSplits = 0,
+      int32_t numSplitsPerFile = 1) {
     // Keep the reference to the deleteFilePath, otherwise the corresponding
     // file will be deleted.
     std::map<std::string, std::shared_ptr<TempFilePath>> dataFilePaths =
@@ -209,7 +214,10 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         }
       }
 
-      splits.emplace_back(makeIcebergSplit(baseFilePath, deleteFiles));
+      for (auto i = 0; i < numSplitsPerFile; ++i) {
+        splits.emplace_back(makeIcebergSplit(
+            baseFilePath, deleteFiles, i, numSplitsPerFile));
+      }
     }
 
     std::string duckdbSql =
@@ -225,6 +233,85 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     ASSERT_TRUE(it->second.peakMemoryBytes > 0);
   }
 
+  /// Returns 4 batches of 5000 rows with columns c0 BIGINT, c1 BIGINT and
+  /// c2 VARCHAR, where c0 is the row number, c1 is the row number modulo 100
+  /// and c2 is the row number modulo 10 or null for every 7th row.
+  std::vector<RowVectorPtr> makeEqualityDeleteData() {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 4; ++i) {
+      const int64_t offset = i * 5000;
+      vectors.push_back(makeRowVector(
+          {"c0", "c1", "c2"},
+          {makeFlatVector<int64_t>(
+               5000, [&](auto row) { return offset + row; }),
+           makeFlatVector<int64_t>(
+               5000, [&](auto row) { return (offset + row) % 100; }),
+           makeFlatVector<std::string>(
+               5000,
+               [&](auto row) { return std::to_string((offset + row) % 10); },
+               [&](auto row) { return (offset + row) % 7 == 0; })}));
+    }
+    return vectors;
+  }
+
+  /// Writes 'data' to one data file and 'deletes' to one equality delete file
+  /// on the columns with 'equalityFieldIds'. Then checks that scanning the
+  /// data file in 'numSplits' splits returns the result of 'duckDbSql'.
+  /// @outputType The columns to read. Defaults to all columns of 'data'.
+  /// @columnNamesByFieldId The field ids of the table schema. Defaults to the
+  /// 1-based positions of the columns of 'data'.
+  void assertEqualityDeletes(
+      const std::vector<RowVectorPtr>& data,
+      const RowVectorPtr& deletes,
+      const std::vector<int32_t>& equalityFieldIds,
+      const std::string& duckDbSql,
+      const std::vector<std::string>& subfieldFilters = {},
+      int32_t numSplits = 1,
+      const RowTypePtr& outputType = nullptr,
+      std::unordered_map<int32_t, std::string> columnNamesByFieldId = {}) {
+    auto dataFilePath = TempFilePath::create();
+    writeToFile(dataFilePath->getPath(), data, config_, flushPolicyFactory_);
+    createDuckDbTable(data);
+
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(), {deletes}, config_, flushPolicyFactory_);
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        deleteFilePath->getPath(),
+        fileFomat_,
+        deletes->size(),
+        filesystems::getFileSystem(deleteFilePath->getPath(), nullptr)
+            ->openFileForRead(deleteFilePath->getPath())
+            ->size(),
+        equalityFieldIds);
+
+    const auto rowType = asRowType(data[0]->type());
+    if (columnNamesByFieldId.empty()) {
+      for (auto i = 0; i < rowType->size(); ++i) {
+        columnNamesByFieldId[i + 1] = rowType->nameOf(i);
+      }
+    }
+
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (auto i = 0; i < numSplits; ++i) {
+      auto split = makeIcebergSplit(
+          dataFilePath->getPath(), {deleteFile}, i, numSplits);
+      std::dynamic_pointer_cast<HiveIcebergSplit>(split)
+          ->columnNamesByFieldId = columnNamesByFieldId;
+      splits.push_back(split);
+    }
+
+    auto plan = PlanBuilder(pool_.get())
+                    .tableScan(
+                        outputType ? outputType : rowType,
+                        subfieldFilters,
+                        "",
+                        rowType)
+                    .planNode();
+    HiveConnectorTestBase::assertQuery(plan, splits, duckDbSql, 0);
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -337,7 +424,9 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   std::shared_ptr<ConnectorSplit> makeIcebergSplit(
       const std::string& dataFilePath,
-      const std::vector<IcebergDeleteFile>& deleteFiles = {}) {
+      const std::vector<IcebergDeleteFile>& deleteFiles = {},
+      int32_t splitIndex = 0,
+      int32_t numSplits = 1) {
     std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
     std::unordered_map<std::string, std::string> customSplitInfo;
     customSplitInfo["table_format"] = "hive-iceberg";
@@ -345,13 +434,15 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     auto file = filesystems::getFileSystem(dataFilePath, nullptr)
                     ->openFileForRead(dataFilePath);
     const int64_t fileSize = file->size();
+    const int64_t start = fileSize * splitIndex / numSplits;
+    const int64_t end = fileSize * (splitIndex + 1) / numSplits;
 
     return std::make_shared<HiveIcebergSplit>(
         kHiveConnectorId,
         dataFilePath,
         fileFomat_,
-        0,
-        fileSize,
+        start,
+        end - start,
         partitionKeys,
         std::nullopt,
         customSplitInfo,
@@ -659,4 +750,244 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   assertMultipleSplits({}, 10, 3);
 }
 
+TEST_F(HiveIcebergTest, positionalDeletesCached) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  PositionalDeleteCache::setInstance(
+      std::make_shared<PositionalDeleteCache>(64 << 20));
+  SCOPE_EXIT {
+    PositionalDeleteCache::setInstance(nullptr);
+  };
+
+  // The splits of a data file read the delete file once.
+  std::map<std::string, std::vector<int64_t>> rowGroupSizesForFiles = {
+      {"data_file_1", {5000, 5000, 5000, 5000}}};
+  std::unordered_map<
+      std::string,
+      std::multimap<std::string, std::vector<int64_t>>>
+      deleteFilesForBaseDatafiles = {
+          {"delete_file_1",
+           {{"data_file_1", makeRandomIncreasingValues(0, 20000)}}},
+          {"delete_file_2", {{"data_file_1", {0, 4999, 5000, 19999}}}}};
+  assertPositionalDeletes(
+      rowGroupSizesForFiles, deleteFilesForBaseDatafiles, 0, 4);
+  auto stats = PositionalDeleteCache::getInstance()->stats();
+  EXPECT_GT(stats.numHits, 0);
+  EXPECT_EQ(stats.numElements, 2);
+  PositionalDeleteCache::getInstance()->clear();
+
+  deleteFilesForBaseDatafiles = {
+      {"delete_file_1",
+       {{"data_file_1", makeContinuousIncreasingValues(0, 20000)}}}};
+  assertPositionalDeletes(
+      rowGroupSizesForFiles, deleteFilesForBaseDatafiles, 0, 4);
+  PositionalDeleteCache::getInstance()->clear();
+
+  // Positions repeated across the RowGroups of the delete file.
+  rowGroupSizesForFiles = {{"data_file_1", {100, 85}}};
+  deleteFilesForBaseDatafiles = {
+      {"delete_file_1",
+       {{"data_file_1", {0, 1, 2, 3}},
+        {"data_file_1", {1, 2, 3, 4}},
+        {"data_file_1", {98, 99, 100, 101, 184}}}}};
+  assertPositionalDeletes(
+      rowGroupSizesForFiles, deleteFilesForBaseDatafiles, 0, 2);
+  PositionalDeleteCache::getInstance()->clear();
+
+  assertMultipleSplits(makeRandomIncreasingValues(0, 20000), 10, 3);
+  assertMultipleSplits({}, 10, 3);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto data = makeEqualityDeleteData();
+  auto c1Deletes =
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1, 5, 99, 1000})});
+  assertEqualityDeletes(
+      data, c1Deletes, {2}, "SELECT * FROM tmp WHERE c1 NOT IN (1, 5, 99)");
+
+  // Two columns.
+  assertEqualityDeletes(
+      data,
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({0, 101, 102, 19999}),
+           makeFlatVector<int64_t>({0, 1, 1, 99})}),
+      {1, 2},
+      "SELECT * FROM tmp WHERE NOT ((c0 = 0 AND c1 = 0) OR "
+      "(c0 = 101 AND c1 = 1) OR (c0 = 19999 AND c1 = 99))");
+
+  // Nulls match nulls.
+  assertEqualityDeletes(
+      data,
+      makeRowVector(
+          {"c2"}, {makeNullableFlatVector<std::string>({std::nullopt, "3"})}),
+      {3},
+      "SELECT * FROM tmp WHERE c2 IS NOT NULL AND c2 <> '3'");
+
+  // With a filter.
+  assertEqualityDeletes(
+      data,
+      c1Deletes,
+      {2},
+      "SELECT * FROM tmp WHERE c0 < 5000 AND c1 NOT IN (1, 5, 99)",
+      {"c0 < 5000"});
+
+  // All rows deleted.
+  assertEqualityDeletes(
+      data,
+      makeRowVector(
+          {"c1"}, {makeFlatVector<int64_t>(100, [](auto row) { return row; })}),
+      {2},
+      "SELECT * FROM tmp WHERE false");
+
+  // Several splits.
+  assertEqualityDeletes(
+      data,
+      c1Deletes,
+      {2},
+      "SELECT * FROM tmp WHERE c1 NOT IN (1, 5, 99)",
+      {},
+      4);
+
+  // The delete columns must be read.
+  VELOX_ASSERT_THROW(
+      assertEqualityDeletes(
+          data,
+          c1Deletes,
+          {2},
+          "SELECT c0 FROM tmp WHERE c1 NOT IN (1, 5, 99)",
+          {},
+          1,
+          ROW({"c0"}, {BIGINT()})),
+      "Iceberg equality delete column c1 must be read by the scan");
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesSchemaEvolution) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // The column with field id 2 was dropped from the table, so the field ids
+  // of c1 and c2 are 3 and 4 and do not match their positions.
+  auto data = makeEqualityDeleteData();
+  const std::unordered_map<int32_t, std::string> columnNamesByFieldId = {
+      {1, "c0"}, {3, "c1"}, {4, "c2"}};
+  assertEqualityDeletes(
+      data,
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1, 5, 99})}),
+      {3},
+      "SELECT * FROM tmp WHERE c1 NOT IN (1, 5, 99)",
+      {},
+      1,
+      nullptr,
+      columnNamesByFieldId);
+
+  assertEqualityDeletes(
+      data,
+      makeRowVector(
+          {"c0", "c2"},
+          {makeFlatVector<int64_t>({0, 7, 8}),
+           makeNullableFlatVector<std::string>(
+               {std::nullopt, std::nullopt, "8"})}),
+      {1, 4},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 7, 8)",
+      {},
+      1,
+      nullptr,
+      columnNamesByFieldId);
+
+  // The field id of the dropped column is not resolved.
+  VELOX_ASSERT_THROW(
+      assertEqualityDeletes(
+          data,
+          makeRowVector({"c1"}, {makeFlatVector<int64_t>({1, 5, 99})}),
+          {2},
+          "SELECT * FROM tmp",
+          {},
+          1,
+          nullptr,
+          columnNamesByFieldId),
+      "Iceberg equality field id 2 is not in the table schema");
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesCached) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  EqualityDeleteCache::setInstance(
+      std::make_shared<EqualityDeleteCache>(64 << 20));
+  SCOPE_EXIT {
+    EqualityDeleteCache::setInstance(nullptr);
+  };
+
+  // The splits of the data file share the rows of the delete file.
+  auto data = makeEqualityDeleteData();
+  assertEqualityDeletes(
+      data,
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1, 5, 99})}),
+      {2},
+      "SELECT * FROM tmp WHERE c1 NOT IN (1, 5, 99)",
+      {},
+      4);
+  auto stats = EqualityDeleteCache::getInstance()->stats();
+  EXPECT_GT(stats.numHits, 0);
+  EXPECT_EQ(stats.numElements, 1);
+  EqualityDeleteCache::getInstance()->clear();
+
+  assertEqualityDeletes(
+      data,
+      makeRowVector(
+          {"c0", "c2"},
+          {makeFlatVector<int64_t>({0, 7, 8}),
+           makeNullableFlatVector<std::string>(
+               {std::nullopt, std::nullopt, "8"})}),
+      {1, 3},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 7, 8)",
+      {},
+      4);
+}
+
+TEST(DeletePositionsTest, setBits) {
+  DeletePositions positions;
+  std::vector<int64_t> expected;
+  // Sparse positions, a range dense enough for a bitmap and positions in a
+  // far away range.
+  for (int64_t i = 0; i < 100'000; i += 97) {
+    expected.push_back(i);
+  }
+  for (int64_t i = 200'000; i < 210'000; ++i) {
+    expected.push_back(i);
+  }
+  expected.push_back(1LL << 40);
+  for (auto position : expected) {
+    positions.add(position);
+    // Repeated positions are ignored.
+    positions.add(position);
+  }
+  EXPECT_EQ(positions.numPositions(), expected.size());
+  VELOX_ASSERT_THROW(positions.add(1), "must be in ascending order");
+
+  auto testRange = [&](int64_t begin, uint64_t size) {
+    std::vector<uint64_t> bitmap(bits::nwords(size));
+    const auto numSet = positions.setBits(begin, size, bitmap.data());
+    uint64_t expectedNumSet = 0;
+    for (auto position : expected) {
+      if (position >= begin && position < begin + size) {
+        ASSERT_TRUE(bits::isBitSet(bitmap.data(), position - begin))
+            << position;
+        ++expectedNumSet;
+      }
+    }
+    EXPECT_EQ(numSet, expectedNumSet);
+    EXPECT_EQ(bits::countBits(bitmap.data(), 0, size), expectedNumSet);
+  };
+  testRange(0, 1'000);
+  testRange(1'000, 10'000);
+  testRange(65'000, 1'000);
+  testRange(150'000, 100'000);
+  testRange(205'001, 333);
+  testRange(300'000, 10'000);
+  testRange((1LL << 40) - 10, 20);
+  testRange(0, 0);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
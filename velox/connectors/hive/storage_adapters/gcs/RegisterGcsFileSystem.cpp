@@ -64,7 +64,9 @@ std::unique_ptr<velox::dwio::common::FileSink> gcsWriteFileSinkGenerator(
         fileSystem->openFileForWrite(fileURI, {{}, options.pool, std::nullopt}),
         fileURI,
         options.metricLogger,
-        options.stats);
+        options.stats,
+        options.writeExecutor,
+        options.maxPendingWriteBytes);
   }
   return nullptr;
 }
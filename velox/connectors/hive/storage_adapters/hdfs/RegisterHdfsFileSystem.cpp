@@ -85,7 +85,9 @@ hdfsWriteFileSinkGenerator() {
               fileSystem->openFileForWrite(pathSuffix),
               fileURI,
               options.metricLogger,
-              options.stats);
+              options.stats,
+              options.writeExecutor,
+              options.maxPendingWriteBytes);
         }
         return static_cast<std::unique_ptr<dwio::common::WriteFileSink>>(
             nullptr);
@@ -89,7 +89,9 @@ std::unique_ptr<velox::dwio::common::FileSink> s3WriteFileSinkGenerator(
         fileSystem->openFileForWrite(fileURI, {{}, options.pool, std::nullopt}),
         fileURI,
         options.metricLogger,
-        options.stats);
+        options.stats,
+        options.writeExecutor,
+        options.maxPendingWriteBytes);
   }
   return nullptr;
 }
@@ -74,4 +74,14 @@ S3Config::S3Config(
   }
 }
 
+uint64_t S3Config::readPartSize() const {
+  const auto value = config_.find(Keys::kReadPartSize)->second.value();
+  const auto partSize = config::toCapacity(value, config::CapacityUnit::BYTE);
+  VELOX_USER_CHECK_GT(
+      partSize,
+      0,
+      "Invalid configuration: 'hive.s3.read-part-size' must be positive.");
+  return partSize;
+}
+
 } // namespace facebook::velox::filesystems
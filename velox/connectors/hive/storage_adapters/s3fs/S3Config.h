@@ -67,6 +67,8 @@ class S3Config {
     kMaxAttempts,
     kRetryMode,
     kUseProxyFromEnv,
+    kReadPartSize,
+    kReadMaxConcurrency,
     kEnd
   };
 
@@ -100,7 +102,10 @@ class S3Config {
             {Keys::kMaxAttempts, std::make_pair("max-attempts", std::nullopt)},
             {Keys::kRetryMode, std::make_pair("retry-mode", std::nullopt)},
             {Keys::kUseProxyFromEnv,
-             std::make_pair("use-proxy-from-env", "false")}};
+             std::make_pair("use-proxy-from-env", "false")},
+            {Keys::kReadPartSize, std::make_pair("read-part-size", "8MB")},
+            {Keys::kReadMaxConcurrency,
+             std::make_pair("read-max-concurrency", "1")}};
     return config;
   }
 
@@ -214,6 +219,16 @@ class S3Config {
     return folly::to<bool>(value);
   }
 
+  /// Size in bytes of the ranged GETs a large read is split into.
+  uint64_t readPartSize() const;
+
+  /// Maximum number of ranged GETs of the parts of reads in flight at the
+  /// same time. 1 reads each range with a single GET.
+  int32_t readMaxConcurrency() const {
+    auto value = config_.find(Keys::kReadMaxConcurrency)->second.value();
+    return folly::to<int32_t>(value);
+  }
+
  private:
   std::unordered_map<Keys, std::optional<std::string>> config_;
 };
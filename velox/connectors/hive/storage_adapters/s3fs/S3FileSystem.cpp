@@ -23,6 +23,9 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -73,8 +76,15 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  /// Reads larger than 'partSize' are split into ranged GETs of 'partSize'
+  /// bytes which run in parallel on 'executor'. If 'executor' is nullptr, each
+  /// read is a single GET.
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint64_t partSize = 0)
+      : client_(client), executor_(executor), partSize_(partSize) {
     getBucketAndKeyFromPath(path, bucket_, key_);
   }
 
@@ -132,16 +142,51 @@ class S3ReadFile final : public ReadFile {
     // TODO: allocate from a memory pool
     std::string result(length, 0);
     preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    copyToBuffers(result, buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    for (uint64_t partOffset = 0; partOffset < length;
+         partOffset += partSize_) {
+      const auto partLength = std::min(partSize_, length - partOffset);
+      parts.push_back(
+          folly::via(
+              executor_,
+              [this, result, offset, partOffset, partLength]() {
+                getRange(
+                    offset + partOffset,
+                    partLength,
+                    result->data() + partOffset);
+              })
+              .semi());
+    }
+    return folly::collectAll(std::move(parts))
+        .deferValue([result, buffers, length](
+                        std::vector<folly::Try<folly::Unit>>&& tries) {
+          for (auto& partTry : tries) {
+            partTry.throwUnlessValue();
+          }
+          copyToBuffers(*result, buffers);
+          return static_cast<uint64_t>(length);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -165,9 +210,58 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // Copies the bytes of 'data', which starts at the offset of the first of
+  // 'buffers', to the non-gap ranges of 'buffers'.
+  static void copyToBuffers(
+      std::string_view data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t dataOffset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data.data() + dataOffset, range.size());
+      }
+      dataOffset += range.size();
+    }
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (executor_ == nullptr || length <= partSize_) {
+      getRange(offset, length, position);
+      return;
+    }
+    // A single GET is limited by the throughput of one connection. Reads the
+    // parts in parallel and the last part on the calling thread.
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    uint64_t partOffset = 0;
+    for (; partOffset + partSize_ < length; partOffset += partSize_) {
+      parts.push_back(
+          folly::via(
+              executor_,
+              [this, offset, partOffset, position]() {
+                getRange(offset + partOffset, partSize_, position + partOffset);
+              })
+              .semi());
+    }
+    std::exception_ptr lastError;
+    try {
+      getRange(offset + partOffset, length - partOffset, position + partOffset);
+    } catch (const std::exception&) {
+      lastError = std::current_exception();
+    }
+    // Waits for all the parts before throwing since they write to 'position'.
+    auto tries = folly::collectAll(std::move(parts)).get();
+    for (auto& partTry : tries) {
+      partTry.throwUnlessValue();
+    }
+    if (lastError) {
+      std::rethrow_exception(lastError);
+    }
+  }
+
+  // Reads 'length' bytes at 'offset' with a single ranged GET.
+  void getRange(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -184,6 +278,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const executor_;
+  const uint64_t partSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -574,6 +670,18 @@ class S3FileSystem::Impl {
 
     auto credentialsProvider = getCredentialsProvider(s3Config);
 
+    readPartSize_ = s3Config.readPartSize();
+    const auto readMaxConcurrency = s3Config.readMaxConcurrency();
+    VELOX_USER_CHECK_GT(
+        readMaxConcurrency,
+        0,
+        "Invalid configuration: 'hive.s3.read-max-concurrency' must be positive.");
+    if (readMaxConcurrency > 1) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          readMaxConcurrency,
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+    }
+
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider,
         clientConfig,
@@ -583,6 +691,8 @@ class S3FileSystem::Impl {
   }
 
   ~Impl() {
+    // Joins the reads in flight before the client is destroyed.
+    readExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -713,8 +823,20 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the executor of the parts of large reads or nullptr if reads are
+  // not split.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  uint64_t readPartSize_;
 };
 
 S3FileSystem::S3FileSystem(
@@ -733,7 +855,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path, impl_->s3Client(), impl_->readExecutor(), impl_->readPartSize());
   s3file->initialize(options);
   return s3file;
 }
@@ -33,6 +33,8 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.secretKey(), std::nullopt);
   ASSERT_EQ(s3Config.iamRole(), std::nullopt);
   ASSERT_EQ(s3Config.iamRoleSessionName(), "velox-session");
+  ASSERT_EQ(s3Config.readPartSize(), 8 << 20);
+  ASSERT_EQ(s3Config.readMaxConcurrency(), 1);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
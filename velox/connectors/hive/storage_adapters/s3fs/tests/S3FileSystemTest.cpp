@@ -255,6 +255,40 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const auto bucketName = "paralleldata";
+  const auto file = "test.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  std::string data(10'000, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append(data);
+  }
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "1kB"},
+       {"hive.s3.read-max-concurrency", "4"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  ASSERT_EQ(readFile->pread(0, data.size()), data);
+  ASSERT_EQ(readFile->pread(100, 4'500), data.substr(100, 4'500));
+
+  std::string head(3'000, 0);
+  std::string tail(3'000, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      {head.data(), head.size()},
+      {nullptr, 2'000},
+      {tail.data(), tail.size()}};
+  ASSERT_EQ(readFile->preadvAsync(500, buffers).get(), 8'000);
+  ASSERT_EQ(head, data.substr(500, 3'000));
+  ASSERT_EQ(tail, data.substr(5'500, 3'000));
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
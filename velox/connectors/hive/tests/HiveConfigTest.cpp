@@ -41,6 +41,9 @@ TEST(HiveConfigTest, defaultConfig) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalesceEnabled());
+  ASSERT_EQ(hiveConfig.prefetchRowGroups(), 1);
+  ASSERT_EQ(hiveConfig.maxPrefetchRowGroupBytes(), 0);
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -178,6 +181,7 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalesceEnabled());
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -55,6 +55,8 @@ class HiveConnectorSerDeTest : public exec::test::HiveConnectorTestBase {
     ASSERT_EQ(clone->toString(), str);
     ASSERT_EQ(
         handle.remainingFilter()->type(), clone->remainingFilter()->type());
+    ASSERT_EQ(handle.sortedColumns(), clone->sortedColumns());
+    ASSERT_EQ(handle.aggregates(), clone->aggregates());
 
     auto& filters = handle.subfieldFilters();
     auto& cloneFilters = clone->subfieldFilters();
@@ -105,6 +107,15 @@ class HiveConnectorSerDeTest : public exec::test::HiveConnectorTestBase {
     } else {
       ASSERT_FALSE(clone->properties.has_value());
     }
+
+    ASSERT_EQ(split.columnRanges.size(), clone->columnRanges.size());
+    for (const auto& [column, range] : split.columnRanges) {
+      const auto* cloneRange = clone->columnRange(column);
+      ASSERT_NE(cloneRange, nullptr);
+      ASSERT_EQ(range.min, cloneRange->min);
+      ASSERT_EQ(range.max, cloneRange->max);
+      ASSERT_EQ(range.mayHaveNulls, cloneRange->mayHaveNulls);
+    }
   }
 };
 
@@ -130,6 +141,32 @@ TEST_F(HiveConnectorSerDeTest, hiveTableHandle) {
       "hive_table",
       ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}));
   testSerde(*tableHandle);
+
+  HiveTableHandle sortedTableHandle(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      {},
+      parseExpr("c1 > c4", rowType),
+      nullptr,
+      {},
+      {"c1", "c0c0"});
+  testSerde(sortedTableHandle);
+
+  HiveTableHandle aggregateTableHandle(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      {},
+      parseExpr("c1 > c4", rowType),
+      nullptr,
+      {},
+      {},
+      {{ScanAggregate::Kind::kCount, ""},
+       {ScanAggregate::Kind::kCount, "c1"},
+       {ScanAggregate::Kind::kMin, "c2"},
+       {ScanAggregate::Kind::kMax, "c5"}});
+  testSerde(aggregateTableHandle);
 }
 
 TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
@@ -241,7 +278,7 @@ TEST_F(HiveConnectorSerDeTest, hiveConnectorSplit) {
   const auto properties = std::optional<FileProperties>(fileProperties);
   RowIdProperties rowIdProperties{
       .metadataVersion = 2, .partitionId = 3, .tableGuid = "test"};
-  const auto split1 = HiveConnectorSplit(
+  auto split1 = HiveConnectorSplit(
       connectorId,
       filePath,
       fileFormat,
@@ -256,6 +293,8 @@ TEST_F(HiveConnectorSerDeTest, hiveConnectorSplit) {
       infoColumns,
       properties,
       rowIdProperties);
+  split1.columnRanges["ts"] = {variant(int64_t(10)), variant(int64_t(20))};
+  split1.columnRanges["name"] = {variant("a"), variant("z"), false};
   testSerde(split1);
 
   const auto split2 = HiveConnectorSplit(
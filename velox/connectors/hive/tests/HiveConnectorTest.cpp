@@ -254,6 +254,56 @@ TEST_F(HiveConnectorTest, makeScanSpec_requiredSubfields_allSubscripts) {
   validateNullConstant(*elements->childByName("c0c1"), *BIGINT());
 }
 
+TEST_F(
+    HiveConnectorTest,
+    makeScanSpec_requiredSubfields_implicitArraySubscripts) {
+  auto columnType = ARRAY(ROW(
+      {{"c0c0", BIGINT()},
+       {"c0c1", ARRAY(ROW({{"c0c1c0", BIGINT()}, {"c0c1c1", BIGINT()}}))}}));
+  auto rowType = ROW({{"c0", columnType}});
+  auto scanSpec = makeScanSpec(
+      rowType,
+      groupSubfields(makeSubfields({"c0.c0c1.c0c1c0"})),
+      {},
+      nullptr,
+      {},
+      {},
+      {},
+      pool_.get());
+  auto* c0 = scanSpec->childByName("c0");
+  ASSERT_EQ(
+      c0->maxArrayElementsCount(), std::numeric_limits<vector_size_t>::max());
+  auto* elements = c0->childByName(ScanSpec::kArrayElementsFieldName);
+  validateNullConstant(*elements->childByName("c0c0"), *BIGINT());
+  auto* c0c1 = elements->childByName("c0c1");
+  ASSERT_FALSE(c0c1->isConstant());
+  ASSERT_EQ(
+      c0c1->maxArrayElementsCount(), std::numeric_limits<vector_size_t>::max());
+  auto* c0c1Elements = c0c1->childByName(ScanSpec::kArrayElementsFieldName);
+  ASSERT_FALSE(c0c1Elements->childByName("c0c1c0")->isConstant());
+  validateNullConstant(*c0c1Elements->childByName("c0c1c1"), *BIGINT());
+
+  // Mixed with subscripts, all the elements are read.
+  scanSpec = makeScanSpec(
+      rowType,
+      groupSubfields(makeSubfields({"c0[1].c0c0", "c0.c0c1[*].c0c1c1"})),
+      {},
+      nullptr,
+      {},
+      {},
+      {},
+      pool_.get());
+  c0 = scanSpec->childByName("c0");
+  ASSERT_EQ(
+      c0->maxArrayElementsCount(), std::numeric_limits<vector_size_t>::max());
+  elements = c0->childByName(ScanSpec::kArrayElementsFieldName);
+  ASSERT_FALSE(elements->childByName("c0c0")->isConstant());
+  c0c1Elements = elements->childByName("c0c1")->childByName(
+      ScanSpec::kArrayElementsFieldName);
+  validateNullConstant(*c0c1Elements->childByName("c0c1c0"), *BIGINT());
+  ASSERT_FALSE(c0c1Elements->childByName("c0c1c1")->isConstant());
+}
+
 TEST_F(HiveConnectorTest, makeScanSpec_requiredSubfields_doubleMapKey) {
   auto rowType =
       ROW({{"c0", MAP(REAL(), BIGINT())}, {"c1", MAP(DOUBLE(), BIGINT())}});
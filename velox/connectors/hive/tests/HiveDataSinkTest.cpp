@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -510,7 +511,7 @@ TEST_F(HiveDataSinkTest, basic) {
       "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeNanos[0ns] spillSortTimeNanos[0ns] spillExtractVectorTime[0ns] spillSerializationTimeNanos[0ns] "
-      "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] "
+      "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] spillWriteStallTimeNanos[0ns] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
       "spillReadTimeNanos[0ns] spillReadDeserializationTimeNanos[0ns]");
 
@@ -561,7 +562,7 @@ TEST_F(HiveDataSinkTest, basicBucket) {
       "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeNanos[0ns] spillSortTimeNanos[0ns] spillExtractVectorTime[0ns] spillSerializationTimeNanos[0ns] "
-      "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] "
+      "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] spillWriteStallTimeNanos[0ns] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
       "spillReadTimeNanos[0ns] spillReadDeserializationTimeNanos[0ns]");
 
@@ -587,6 +588,113 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, clusteredPartitionWrite) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  const int numPartitions = 300;
+  connectorSessionProperties_->set(
+      HiveConfig::kClusteredPartitionWriteSession, "true");
+  connectorSessionProperties_->set(
+      HiveConfig::kMaxPartitionsPerWritersSession, "1000");
+  connectorSessionProperties_->set(
+      HiveConfig::kSortWriterFinishTimeSliceLimitMsSession, "1");
+  auto dataSink = createDataSink(
+      rowType_,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"c2"});
+
+  const int numBatches = 10;
+  auto vectors = createVectors(500, numBatches);
+  for (auto i = 0; i < numBatches; ++i) {
+    // The rows of each partition are spread over all the batches.
+    vectors[i]->childAt(2) = makeFlatVector<int16_t>(
+        500, [&](auto row) { return (row * 7 + i) % numPartitions; });
+    dataSink->appendData(vectors[i]);
+  }
+  // The input is buffered until finish().
+  ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), 0);
+  while (!dataSink->finish()) {
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), numPartitions);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, numPartitions);
+  std::unordered_set<std::string> partitionNames;
+  int64_t numRows = 0;
+  for (const auto& partition : partitions) {
+    auto update = folly::parseJson(partition);
+    partitionNames.insert(update["name"].asString());
+    numRows += update["rowCount"].asInt();
+  }
+  ASSERT_EQ(partitionNames.size(), numPartitions);
+  ASSERT_EQ(numRows, numBatches * 500);
+
+  const auto filePaths = listFiles(outputDirectory->getPath());
+  ASSERT_EQ(filePaths.size(), numPartitions);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    splits.push_back(makeHiveConnectorSplit(filePath));
+  }
+  createDuckDbTable(vectors);
+  const auto dataType =
+      ROW({"c0", "c1", "c3", "c4", "c5", "c6"},
+          {BIGINT(), INTEGER(), REAL(), DOUBLE(), VARCHAR(), BOOLEAN()});
+  HiveConnectorTestBase::assertQuery(
+      PlanBuilder().tableScan(dataType).planNode(),
+      splits,
+      "SELECT c0, c1, c3, c4, c5, c6 FROM tmp");
+}
+
+TEST_F(HiveDataSinkTest, unpartitionedWriters) {
+  const int numWriters = 3;
+  connectorSessionProperties_->set(
+      HiveConfig::kUnpartitionedWritersPerDriverSession,
+      std::to_string(numWriters));
+  auto executor = std::make_unique<folly::IOThreadPoolExecutor>(4);
+  for (bool parallel : {false, true}) {
+    SCOPED_TRACE(fmt::format("parallel: {}", parallel));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType_,
+        createHiveInsertTableHandle(rowType_, outputDirectory->getPath()),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        connectorConfig_,
+        parallel ? executor.get() : nullptr);
+
+    const int numBatches = 10;
+    const auto vectors = createVectors(500, numBatches);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_TRUE(dataSink->finish());
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), numWriters);
+    ASSERT_EQ(dataSink->stats().numWrittenFiles, numWriters);
+    int64_t numRows = 0;
+    for (const auto& partition : partitions) {
+      numRows += folly::parseJson(partition)["rowCount"].asInt();
+    }
+    ASSERT_EQ(numRows, numBatches * 500);
+
+    createDuckDbTable(vectors);
+    verifyWrittenData(outputDirectory->getPath(), numWriters);
+  }
+
+  // Aborts with pending writes.
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType_,
+      createHiveInsertTableHandle(rowType_, outputDirectory->getPath()),
+      connectorQueryCtx_.get(),
+      CommitStrategy::kNoCommit,
+      connectorConfig_,
+      executor.get());
+  for (const auto& vector : createVectors(500, numWriters)) {
+    dataSink->appendData(vector);
+  }
+  dataSink->abort();
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -63,8 +63,12 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    folly::Executor* executor,
+    int32_t generateParallelism)
+    : executor_(executor),
+      generateParallelism_(executor != nullptr ? generateParallelism : 1),
+      pool_(pool) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -105,6 +109,18 @@ TpchDataSource::TpchDataSource(
   outputType_ = outputType;
 }
 
+TpchDataSource::~TpchDataSource() {
+  closePendingBatches();
+}
+
+void TpchDataSource::closePendingBatches() {
+  // Waits for the batches being generated, which allocate from 'pool_'.
+  for (auto& batch : pendingBatches_) {
+    batch->close();
+  }
+  pendingBatches_.clear();
+}
+
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
@@ -136,26 +152,72 @@ void TpchDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   splitEnd_ = splitOffset_ + partSize;
 }
 
+void TpchDataSource::scheduleBatches(uint64_t size) {
+  while (pendingBatches_.size() < static_cast<size_t>(generateParallelism_) &&
+         splitOffset_ < splitEnd_) {
+    const size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto batch = std::make_shared<AsyncSource<RowVectorPtr>>(
+        [table = tpchTable_,
+         maxRows,
+         offset = splitOffset_,
+         scaleFactor = scaleFactor_,
+         pool = pool_]() {
+          return std::make_unique<RowVectorPtr>(
+              getTpchData(table, maxRows, offset, scaleFactor, pool));
+        });
+    executor_->add([batch]() { batch->prepare(); });
+    pendingBatches_.push_back(std::move(batch));
+    splitOffset_ += maxRows;
+  }
+}
+
+std::optional<RowVectorPtr> TpchDataSource::nextBatch(
+    uint64_t size,
+    velox::ContinueFuture& future) {
+  if (generateParallelism_ == 1) {
+    const size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto outputVector =
+        getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+    // splitOffset needs to advance based on maxRows passed to getTpchData(),
+    // and not the actual number of returned rows in the output vector, as
+    // they are not the same for lineitem.
+    splitOffset_ += maxRows;
+    return outputVector;
+  }
+
+  // Generates the next batches while this one is processed.
+  scheduleBatches(size);
+  if (pendingBatches_.empty()) {
+    return nullptr;
+  }
+  if (!pendingBatches_.front()->readyOrFuture(&future)) {
+    return std::nullopt;
+  }
+  auto outputVector = pendingBatches_.front()->move();
+  pendingBatches_.pop_front();
+  return outputVector == nullptr ? nullptr : std::move(*outputVector);
+}
+
 std::optional<RowVectorPtr> TpchDataSource::next(
     uint64_t size,
-    velox::ContinueFuture& /*future*/) {
+    velox::ContinueFuture& future) {
   VELOX_CHECK_NOT_NULL(
       currentSplit_, "No split to process. Call addSplit() first.");
 
-  size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto batch = nextBatch(size, future);
+  if (!batch.has_value()) {
+    return std::nullopt;
+  }
+  auto& outputVector = batch.value();
 
-  // If the split is exhausted.
+  // If the split is exhausted. The batches after an empty one are beyond the
+  // end of the table.
   if (!outputVector || outputVector->size() == 0) {
+    closePendingBatches();
     currentSplit_ = nullptr;
     return nullptr;
   }
 
-  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
-  // not the actual number of returned rows in the output vector, as they are
-  // not the same for lineitem.
-  splitOffset_ += maxRows;
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
 
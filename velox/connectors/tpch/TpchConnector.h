@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/config/Config.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
@@ -30,7 +33,7 @@ class TpchColumnHandle : public ColumnHandle {
  public:
   explicit TpchColumnHandle(const std::string& name) : name_(name) {}
 
-  const std::string& name() const {
+  const std::string& name() const override {
     return name_;
   }
 
@@ -76,7 +79,11 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      int32_t generateParallelism = 1);
+
+  ~TpchDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -105,6 +112,19 @@ class TpchDataSource : public DataSource {
  private:
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
+  // Returns the next generated batch of the split, or nullptr if the split
+  // is exhausted. Returns std::nullopt and sets 'future' if the batch is
+  // being generated on 'executor_'.
+  std::optional<RowVectorPtr> nextBatch(
+      uint64_t size,
+      velox::ContinueFuture& future);
+
+  // Schedules the generation of batches of 'size' rows on 'executor_' until
+  // 'generateParallelism_' batches are pending or the split is exhausted.
+  void scheduleBatches(uint64_t size);
+
+  void closePendingBatches();
+
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
   size_t tpchTableRowCount_{0};
@@ -121,6 +141,13 @@ class TpchDataSource : public DataSource {
   uint64_t splitOffset_{0};
   uint64_t splitEnd_{0};
 
+  folly::Executor* const executor_;
+  const int32_t generateParallelism_;
+
+  // The batches of the split scheduled on 'executor_', in the order of their
+  // rows.
+  std::deque<std::shared_ptr<AsyncSource<RowVectorPtr>>> pendingBatches_;
+
   size_t completedRows_{0};
   size_t completedBytes_{0};
 
@@ -129,11 +156,26 @@ class TpchDataSource : public DataSource {
 
 class TpchConnector final : public Connector {
  public:
+  /// Number of batches of a split generated in parallel on the connector
+  /// executor. With 1 or without an executor, the batches are generated on
+  /// the driver thread.
+  static constexpr const char* kGenerateParallelism = "generate-parallelism";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const config::ConfigBase> config,
-      folly::Executor* /*executor*/)
-      : Connector(id) {}
+      folly::Executor* executor)
+      : Connector(id),
+        executor_(executor),
+        generateParallelism_(
+            config->get<int32_t>(kGenerateParallelism, 1)) {
+    VELOX_USER_CHECK_GE(
+        generateParallelism_, 1, "{} must be positive", kGenerateParallelism);
+  }
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -146,7 +188,9 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_,
+        generateParallelism_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -157,6 +201,10 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* const executor_;
+  const int32_t generateParallelism_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -200,6 +201,64 @@ TEST_F(TpchConnectorTest, lineitemTinyRowCount) {
   EXPECT_EQ(60'175, output->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
 }
 
+TEST_F(TpchConnectorTest, parallelGeneration) {
+  const std::string kParallelConnectorId = "test-tpch-parallel";
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kParallelConnectorId,
+              std::make_shared<config::ConfigBase>(
+                  std::unordered_map<std::string, std::string>{
+                      {TpchConnector::kGenerateParallelism, "4"}}),
+              executor.get()));
+  SCOPE_EXIT {
+    connector::unregisterConnector(kParallelConnectorId);
+  };
+
+  auto makePlan = [](const std::string& connectorId) {
+    const auto outputType =
+        ROW({"l_orderkey", "l_linenumber", "l_comment"},
+            {BIGINT(), INTEGER(), VARCHAR()});
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+        assignments;
+    for (const auto& name : outputType->names()) {
+      assignments[name] = std::make_shared<TpchColumnHandle>(name);
+    }
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(outputType)
+        .tableHandle(std::make_shared<TpchTableHandle>(
+            connectorId, Table::TBL_LINEITEM, 0.01))
+        .assignments(assignments)
+        .endTableScan()
+        .planNode();
+  };
+
+  // Small batches so that each split generates many of them in parallel.
+  auto expected =
+      exec::test::AssertQueryBuilder(makePlan(kTpchConnectorId))
+          .split(makeTpchSplit())
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+          .copyResults(pool());
+  ASSERT_EQ(expected->size(), 60'175);
+  for (auto totalParts : {1, 3}) {
+    SCOPED_TRACE(fmt::format("totalParts: {}", totalParts));
+    std::vector<exec::Split> splits;
+    for (auto i = 0; i < totalParts; ++i) {
+      splits.push_back(exec::Split(std::make_shared<TpchConnectorSplit>(
+          kParallelConnectorId, totalParts, i)));
+    }
+    auto result =
+        exec::test::AssertQueryBuilder(makePlan(kParallelConnectorId))
+            .splits(std::move(splits))
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+            .copyResults(pool());
+    test::assertEqualVectors(expected, result);
+  }
+}
+
 TEST_F(TpchConnectorTest, unknownColumn) {
   EXPECT_THROW(
       {
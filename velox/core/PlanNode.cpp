@@ -228,13 +228,6 @@ void addVectorSerdeKind(VectorSerde::Kind kind, std::stringstream& stream) {
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -2058,7 +2051,9 @@ PartitionedOutputNode::PartitionedOutputNode(
     PartitionFunctionSpecPtr partitionFunctionSpec,
     RowTypePtr outputType,
     VectorSerde::Kind serdeKind,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    std::optional<SkewedJoin> skewedJoin,
+    std::optional<Combiner> combiner)
     : PlanNode(id),
       kind_(kind),
       sources_{{std::move(source)}},
@@ -2067,7 +2062,9 @@ PartitionedOutputNode::PartitionedOutputNode(
       replicateNullsAndAny_(replicateNullsAndAny),
       partitionFunctionSpec_(std::move(partitionFunctionSpec)),
       serdeKind_(serdeKind),
-      outputType_(std::move(outputType)) {
+      outputType_(std::move(outputType)),
+      skewedJoin_(std::move(skewedJoin)),
+      combiner_(std::move(combiner)) {
   VELOX_USER_CHECK_GT(numPartitions_, 0);
   if (numPartitions_ == 1) {
     VELOX_USER_CHECK(
@@ -2080,6 +2077,34 @@ PartitionedOutputNode::PartitionedOutputNode(
         "{} partitioning doesn't allow for partitioning keys",
         kindString(kind_));
   }
+  if (skewedJoin_.has_value()) {
+    VELOX_USER_CHECK(
+        isPartitioned() && numPartitions_ > 1,
+        "Skewed join splitting requires hash partitioning");
+    VELOX_USER_CHECK(
+        !replicateNullsAndAny_,
+        "Skewed join splitting is not supported with replicateNullsAndAny");
+    VELOX_USER_CHECK(!skewedJoin_->joinId.empty());
+  }
+  if (combiner_.has_value()) {
+    VELOX_USER_CHECK(
+        isPartitioned() && !replicateNullsAndAny_,
+        "Combiner requires hash partitioning without replicateNullsAndAny");
+    VELOX_USER_CHECK(
+        !combiner_->groupingKeys.empty(), "Combiner requires grouping keys");
+    const auto& inputType = sources_[0]->outputType();
+    const auto numKeys = combiner_->groupingKeys.size();
+    VELOX_USER_CHECK_EQ(
+        inputType->size(),
+        numKeys + combiner_->aggregates.size(),
+        "Combiner input must have the grouping keys and the aggregates");
+    for (auto i = 0; i < numKeys; ++i) {
+      VELOX_USER_CHECK_EQ(
+          inputType->nameOf(i),
+          combiner_->groupingKeys[i]->name(),
+          "Combiner input must start with the grouping keys");
+    }
+  }
 }
 
 // static
@@ -2208,6 +2233,15 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
     stream << " replicate nulls and any";
   }
 
+  if (skewedJoin_.has_value()) {
+    stream << " split skewed " << (skewedJoin_->isProbe ? "probe" : "build")
+           << " of " << skewedJoin_->joinId;
+  }
+
+  if (combiner_.has_value()) {
+    stream << " combine on " << combiner_->groupingKeys.size() << " keys";
+  }
+
   stream << " ";
   addVectorSerdeKind(serdeKind_, stream);
 }
@@ -2221,6 +2255,22 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["serdeKind"] = VectorSerde::kindName(serdeKind_);
   obj["outputType"] = outputType_->serialize();
+  if (skewedJoin_.has_value()) {
+    folly::dynamic skewedJoin = folly::dynamic::object;
+    skewedJoin["joinId"] = skewedJoin_->joinId;
+    skewedJoin["isProbe"] = skewedJoin_->isProbe;
+    obj["skewedJoin"] = std::move(skewedJoin);
+  }
+  if (combiner_.has_value()) {
+    folly::dynamic combiner = folly::dynamic::object;
+    combiner["groupingKeys"] =
+        ISerializable::serialize(combiner_->groupingKeys);
+    combiner["aggregates"] = folly::dynamic::array;
+    for (const auto& aggregate : combiner_->aggregates) {
+      combiner["aggregates"].push_back(aggregate.serialize());
+    }
+    obj["combiner"] = std::move(combiner);
+  }
   return obj;
 }
 
@@ -2228,6 +2278,15 @@ folly::dynamic PartitionedOutputNode::serialize() const {
 PlanNodePtr PartitionedOutputNode::create(
     const folly::dynamic& obj,
     void* context) {
+  std::optional<Combiner> combiner;
+  if (obj.count("combiner") != 0) {
+    combiner = Combiner{
+        deserializeFields(obj["combiner"]["groupingKeys"], context), {}};
+    for (const auto& aggregate : obj["combiner"]["aggregates"]) {
+      combiner->aggregates.push_back(
+          AggregationNode::Aggregate::deserialize(aggregate, context));
+    }
+  }
   return std::make_shared<PartitionedOutputNode>(
       deserializePlanNodeId(obj),
       stringToKind(obj["kind"].asString()),
@@ -2238,7 +2297,13 @@ PlanNodePtr PartitionedOutputNode::create(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
       VectorSerde::kindByName(obj["serdeKind"].asString()),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      obj.count("skewedJoin") == 0
+          ? std::nullopt
+          : std::make_optional(SkewedJoin{
+                obj["skewedJoin"]["joinId"].asString(),
+                obj["skewedJoin"]["isProbe"].asBool()}),
+      std::move(combiner));
 }
 
 TopNNode::TopNNode(
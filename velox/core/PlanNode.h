@@ -1254,6 +1254,31 @@ class PartitionedOutputNode : public PlanNode {
   static std::string kindString(Kind kind);
   static Kind stringToKind(const std::string& str);
 
+  /// Marks the outputs of the probe and the build side of a hash join whose
+  /// hot partitions may be split across several destinations. The probe side
+  /// spreads the rows of a hot partition over the destinations and the build
+  /// side replicates the rows of the partition to all of them. Only valid
+  /// for joins which don't produce output for unmatched or matched build
+  /// rows, i.e. inner, left, left semi and anti joins.
+  struct SkewedJoin {
+    /// Identifies the join. The same for the outputs of both sides.
+    std::string joinId;
+    bool isProbe;
+  };
+
+  /// Merges the rows with equal grouping keys before they are sent, like an
+  /// intermediate aggregation with a small memory budget. The input must be
+  /// the output of a partial aggregation: the grouping keys first, followed
+  /// by one intermediate result column per aggregate. This reduces the shuffle
+  /// volume of moderately duplicated keys after the partial aggregation has
+  /// been abandoned.
+  struct Combiner {
+    std::vector<FieldAccessTypedExprPtr> groupingKeys;
+    /// The intermediate aggregates. The calls refer to the intermediate
+    /// result columns of the input.
+    std::vector<AggregationNode::Aggregate> aggregates;
+  };
+
   PartitionedOutputNode(
       const PlanNodeId& id,
       Kind kind,
@@ -1263,7 +1288,9 @@ class PartitionedOutputNode : public PlanNode {
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
       VectorSerde::Kind serdeKind,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      std::optional<SkewedJoin> skewedJoin = std::nullopt,
+      std::optional<Combiner> combiner = std::nullopt);
 
   static std::shared_ptr<PartitionedOutputNode> broadcast(
       const PlanNodeId& id,
@@ -1340,6 +1367,14 @@ class PartitionedOutputNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  const std::optional<SkewedJoin>& skewedJoin() const {
+    return skewedJoin_;
+  }
+
+  const std::optional<Combiner>& combiner() const {
+    return combiner_;
+  }
+
   std::string_view name() const override {
     return "PartitionedOutput";
   }
@@ -1359,6 +1394,8 @@ class PartitionedOutputNode : public PlanNode {
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const VectorSerde::Kind serdeKind_;
   const RowTypePtr outputType_;
+  const std::optional<SkewedJoin> skewedJoin_;
+  const std::optional<Combiner> combiner_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -35,6 +35,18 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The memory arbitration priority of a query. When the memory arbitrator
+  /// needs to reclaim used memory by spilling or abort, it picks the victims
+  /// from the queries with the lowest priority first.
+  static constexpr const char* kQueryMemoryPriority = "query_memory_priority";
+
+  /// The memory capacity guaranteed to a query on a single host. The memory
+  /// arbitrator grows the query memory pool to at least this capacity and
+  /// doesn't reclaim it below this capacity. It is capped by
+  /// kQueryMaxMemoryPerNode.
+  static constexpr const char* kQueryMemoryGuaranteedCapacity =
+      "query_memory_guaranteed_capacity";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -63,11 +75,50 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// If greater than zero and kExprTrackCpuUsage is false, times the first
+  /// vector and every N-th vector after that in each call and special form
+  /// expression. The sampled timing is reported in ExprStats::sampledTiming.
+  /// Zero by default, i.e. no sampling.
+  static constexpr const char* kExprCpuSamplingRate =
+      "expression.cpu_sampling_rate";
+
+  /// Whether to evaluate trees of floating point arithmetic, e.g. a * b + c,
+  /// in one fused loop instead of materializing a vector for each call. Only
+  /// applies to functions registered with
+  /// exec::registerFusedArithmeticFunction(). False by default.
+  static constexpr const char* kExprFuseArithmetic =
+      "expression.fuse_arithmetic";
+
+  /// Whether to skip the regular expression of a LIKE with a generic pattern
+  /// for strings which do not contain the longest literal of the pattern.
+  static constexpr const char* kExprLikePrefilter =
+      "expression.like_prefilter";
+
+  /// Whether to evaluate the calls of a JSON extraction function with the
+  /// same document and different constant paths together, parsing each
+  /// document once for all the paths.
+  static constexpr const char* kExprMultiPathExtract =
+      "expression.multi_path_extract";
+
+  /// Whether FilterProject loads the lazy input columns referenced by its
+  /// projections concurrently on the query executor, once the rows passing
+  /// the filter are known, instead of one by one as the expressions reach
+  /// them.
+  static constexpr const char* kExprConcurrentLazyLoad =
+      "expression.concurrent_lazy_load";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether the operators of a driver share the decoded hash keys of the
+  /// same input vector and rows instead of decoding them again. The group by
+  /// hash tables in hash mode also share the hashes of common key columns.
+  /// False by default.
+  static constexpr const char* kDecodedVectorCacheEnabled =
+      "decoded_vector_cache_enabled";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -103,7 +154,9 @@ class QueryConfig {
       "exchange.max_buffer_size";
 
   /// Maximum size in bytes to accumulate among all sources of the merge
-  /// exchange. Enforced approximately, not strictly.
+  /// exchange. If the sources are too many to get 1MB each, they share half
+  /// of the size and the source the merge waits for gets the other half.
+  /// Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
@@ -119,6 +172,54 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Maximum number of hot grouping keys partial aggregation keeps
+  /// aggregating after it has been abandoned. The hot keys are found with a
+  /// Space-Saving sketch over the first
+  /// 'abandon_partial_aggregation_min_rows' rows after abandoning. Rows with
+  /// other keys are converted to intermediate results one by one. 0 means
+  /// partial aggregation is abandoned for all keys.
+  static constexpr const char* kAbandonPartialAggregationMaxHotKeys =
+      "abandon_partial_aggregation_max_hot_keys";
+
+  /// If non-zero, single and final aggregations with grouping keys keep at
+  /// most this many groups per driver. The input rows of other groups are
+  /// dropped and their counts are summarized, so that the result is exact for
+  /// the groups it contains and no missing group had more input rows than the
+  /// reported bound. Aggregations with distinct or sorted aggregates are
+  /// exact. Meant for exploratory queries. 0 means exact aggregation.
+  static constexpr const char* kApproxAggregationMaxGroups =
+      "approx_aggregation_max_groups";
+
+  /// If true, the drivers of a final aggregation with grouping keys aggregate
+  /// their input locally and then merge the groups by hash partition of the
+  /// grouping keys across the drivers. The input of the final aggregation then
+  /// does not need to be partitioned on the grouping keys by a local exchange.
+  static constexpr const char* kFinalAggregationMergeAcrossDrivers =
+      "final_aggregation_merge_across_drivers";
+
+  /// If true, the drivers of a partial OrderBy sample their sorting keys at
+  /// the end of the input, agree on one key range per driver and exchange
+  /// their rows so that each driver sorts and outputs one range. A LocalMerge
+  /// over such an OrderBy concatenates the outputs of the drivers instead of
+  /// merging them.
+  static constexpr const char* kOrderByRangePartitioning =
+      "order_by_range_partitioning";
+
+  /// If true, a Window over sorted input streams the rows of a partition for
+  /// aggregate window functions with RANGE BETWEEN k PRECEDING AND CURRENT ROW
+  /// frames. Only the rows from the frame start of the last processed row are
+  /// kept. The frame offsets are expected to be constant within a partition.
+  static constexpr const char* kWindowRangeStreamingEnabled =
+      "window_range_streaming_enabled";
+
+  /// Approximate number of rows of each chunk of a large window partition
+  /// that is evaluated on the query executor in parallel with the other
+  /// chunks. Only applies to partitions with at least twice as many rows and
+  /// to windows whose functions all support chunks, e.g. row_number and rank.
+  /// 0 disables the parallel evaluation.
+  static constexpr const char* kWindowParallelChunkRows =
+      "window_parallel_chunk_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -134,6 +235,39 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true, PartitionedOutput with the Presto serde keeps the dictionary and
+  /// constant encodings of its input in the produced SerializedPages instead
+  /// of flattening them. Each page then holds the rows of a single input
+  /// batch for its destination.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
+  /// The number of destinations a hot partition of a skewed join is split
+  /// across. Applies to PartitionedOutputNodes with a SkewedJoin.
+  static constexpr const char* kSkewedJoinSplitFactor =
+      "skewed_join_split_factor";
+
+  /// A partition of a skewed join is hot if the probe side bytes sent to it
+  /// exceed this multiple of the average bytes per partition.
+  static constexpr const char* kSkewedJoinHotPartitionRatio =
+      "skewed_join_hot_partition_ratio";
+
+  /// The number of probe side bytes after which the hot partitions of a
+  /// skewed join are decided. The build side waits for the decision.
+  static constexpr const char* kSkewedJoinDecisionBytes =
+      "skewed_join_decision_bytes";
+
+  /// The max time in milliseconds the build side of a skewed join waits for a
+  /// probe side operator to start in the same process. After this the build
+  /// side fails. 0 means no timeout.
+  static constexpr const char* kSkewedJoinDecisionTimeoutMs =
+      "skewed_join_decision_timeout_ms";
+
+  /// The memory in bytes of the combiner of a PartitionedOutput operator.
+  /// The combined rows are sent when this is exceeded.
+  static constexpr const char* kPartitionedOutputCombinerMaxMemory =
+      "partitioned_output_combiner_max_memory";
+
   /// The maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -141,6 +275,12 @@ class QueryConfig {
   /// OutputBufferManager::kContinuePct % of this.
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// The time in milliseconds after which the pages of an arbitrary output
+  /// buffer that were assigned to an idle consumer but not yet sent to it are
+  /// moved to the other consumers. 0 disables the reassignment.
+  static constexpr const char* kArbitraryOutputBufferReassignTimeoutMs =
+      "arbitrary_output_buffer_reassign_timeout_ms";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -160,6 +300,15 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If not zero, operators size their output batches so that the bytes of
+  /// the batch plus the working set the operator touches per output row, e.g.
+  /// the build side rows of a hash join, fit in this many bytes. This is meant
+  /// to be about the size of the L2 cache. Applies to operators which know
+  /// their per row working set or output row size and takes precedence over
+  /// kPreferredOutputBatchBytes and kPreferredOutputBatchRows for these.
+  static constexpr const char* kOutputBatchCacheBudgetBytes =
+      "output_batch_cache_budget_bytes";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -183,9 +332,25 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// If true, a hash aggregation which is asked to reclaim memory while
+  /// receiving input spills only as many of its spill partitions as needed to
+  /// free the requested memory. The groups of the other partitions stay in
+  /// memory and are produced without merging spilled runs. Only applies if
+  /// "aggregation_spill_enabled" flag is set.
+  static constexpr const char* kAggregationIncrementalSpillEnabled =
+      "aggregation_incremental_spill_enabled";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// If true, a hash join build which is asked to reclaim memory before its
+  /// table is built spills only as many of its spill partitions as needed to
+  /// free the requested memory. The other partitions stay in memory and are
+  /// probed without spilling the matching probe rows. Only applies if
+  /// "join_spill_enabled" flag is set.
+  static constexpr const char* kHybridJoinSpillEnabled =
+      "hybrid_join_spill_enabled";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -246,11 +411,48 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// If true and the query has a spill executor, the spill file writes run on
+  /// the spill executor. The spiller serializes the next write buffer while
+  /// the previous one is being written, with at most one buffer in flight per
+  /// spill file.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
+  /// The max bytes a query spills to the local spill directory if the task
+  /// has a remote spill directory. New spill files go to the remote spill
+  /// directory after that. If it is zero, spilling only uses the local spill
+  /// directory.
+  static constexpr const char* kSpillLocalQuotaBytes =
+      "spill_local_quota_bytes";
+
+  /// The spill write buffer size in bytes for the files in the remote spill
+  /// directory. Remote storage favors larger writes.
+  static constexpr const char* kSpillRemoteWriteBufferSize =
+      "spill_remote_write_buffer_size";
+
+  /// The buffer size in bytes to read from one file in the remote spill
+  /// directory.
+  static constexpr const char* kSpillRemoteReadBufferSize =
+      "spill_remote_read_buffer_size";
+
+  /// If true, spill files store each spilled batch as one separately
+  /// compressed page per column so that the columns can be read back
+  /// selectively.
+  static constexpr const char* kSpillColumnarFormatEnabled =
+      "spill_columnar_format_enabled";
+
   /// Specifies the buffer size in bytes to read from one spilled file. If the
   /// underlying filesystem supports async read, we do read-ahead with double
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// If true and the query has a spill executor, the spill files of the runs
+  /// merged after a sort spill read their next buffer on the spill executor
+  /// when the file system has no async read support. This doubles the read
+  /// buffer memory of each run.
+  static constexpr const char* kSpillReadAheadEnabled =
+      "spill_read_ahead_enabled";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -298,6 +500,12 @@ class QueryConfig {
   static constexpr const char* kPrestoArrayAggIgnoreNulls =
       "presto.array_agg.ignore_nulls";
 
+  /// If true, array_agg() appends the raw input values with their groups to a
+  /// single columnar buffer and groups them by sorting when extracting the
+  /// results, instead of keeping a separate list of values for each group.
+  static constexpr const char* kPrestoArrayAggBufferRawInput =
+      "presto.array_agg.buffer_raw_input";
+
   /// The default number of expected items for the bloomfilter.
   static constexpr const char* kSparkBloomFilterExpectedNumItems =
       "spark.bloom_filter.expected_num_items";
@@ -331,11 +539,71 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum size in bytes of a Bloom filter that the hash probe pushes
+  /// down to the probe side table scan for a join key which has too many
+  /// distinct values to produce an exact dynamic filter. Set to 0 to disable.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// If non-zero, an inner or semi filter hash join probing a large hash table
+  /// counts the probe rows with a match over its first input rows. If at most
+  /// this percentage of them matches, the probe checks the keys of the
+  /// following rows against a Bloom filter of the build side keys and probes
+  /// the hash table only for the rows which pass. 0 means disabled.
+  static constexpr const char* kHashProbeBloomFilterMaxMatchPct =
+      "hash_probe_bloom_filter_max_match_pct";
+
+  /// If true, a TopN whose first sorting key is a column of the table scan in
+  /// the same pipeline pushes down the value of that key in the current N-th
+  /// row as a range filter, so that the scan skips rows and row groups which
+  /// can not make it into the top N.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// If true, the queued splits of a table scan which feeds a TopN on one of
+  /// its columns are ordered by the range of that column in each split, as
+  /// returned by ConnectorSplit::columnRange(), e.g. by the largest value
+  /// first for a descending key. The top rows are then found early and the
+  /// TopN dynamic filter, if enabled by kTopNDynamicFilterEnabled, skips more
+  /// of the later splits. Takes precedence over kLargestSplitFirst for such
+  /// scans.
+  static constexpr const char* kTopNSplitOrderingEnabled =
+      "topn_split_ordering_enabled";
+
+  /// If not zero, the hash probe radix clusters each batch of probe rows into
+  /// 2^N groups by the hash table region they hit and probes one group at a
+  /// time, where N is the value of this config. This improves cache locality
+  /// for hash tables which are much larger than the CPU cache. Must be in
+  /// [0, 16].
+  static constexpr const char* kHashProbeRadixClusterBits =
+      "hash_probe_radix_cluster_bits";
+
+  /// If true, the hash probe outputs the build side columns of matching rows as
+  /// lazy vectors that copy the values out of the hash table when loaded. This
+  /// avoids copying the values of rows that are dropped by a filter after the
+  /// join. Not used if the hash probe may spill.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If not zero, the hash join build side stores its non-key columns in a
+  /// separate cold record per row when they take at least this many bytes in
+  /// the row. This makes the rows accessed when probing the keys smaller at
+  /// the cost of an extra memory access for each match.
+  static constexpr const char* kHashBuildColdPayloadMinBytes =
+      "hash_build_cold_payload_min_bytes";
+
+  /// If true, a nested loop join whose condition bounds a build side column
+  /// by probe side columns, e.g. a.ts BETWEEN b.start AND b.end, sorts the
+  /// build side on that column and evaluates the condition only for the build
+  /// rows within the bounds of each probe row.
+  static constexpr const char* kNestedLoopJoinRangeEnabled =
+      "nested_loop_join_range_enabled";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -363,12 +631,75 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// If true, the queued splits of a table scan are ordered by their estimated
+  /// cost, largest first, instead of by arrival. The drivers then preload and
+  /// read the large splits first and the scan ends with the small ones,
+  /// which shortens the tail where a few drivers read the largest splits.
+  static constexpr const char* kLargestSplitFirst = "largest_split_first";
+
+  /// If true, an ArrowStream source reads the next Arrow array from its
+  /// stream on the query executor while the current one is processed. The
+  /// stream callbacks are then called from executor threads, one call at a
+  /// time.
+  static constexpr const char* kArrowStreamPrefetch = "arrow_stream_prefetch";
+
+  /// If true and the process has an exec::SplitResultCache, a table scan
+  /// returns the rows of a split from the cache if the same scan read the
+  /// same data before, and adds the rows of the splits it reads to the
+  /// cache. Only splits whose connector identifies the version of their data
+  /// are cached. The scan must be deterministic.
+  static constexpr const char* kTableScanResultCacheEnabled =
+      "table_scan_result_cache_enabled";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If true, a Task starts only half of the Drivers of an ungrouped pipeline
+  /// which reads from a TableScan and adapts the number of running Drivers to
+  /// the observed blocked time and the number of queued splits.
+  static constexpr const char* kAdaptiveTableScanDriversEnabled =
+      "adaptive_table_scan_drivers_enabled";
+
+  /// The interval in ms between the adjustments of the number of running
+  /// Drivers of a pipeline with adaptive Drivers.
+  static constexpr const char* kAdaptiveTableScanDriversIntervalMs =
+      "adaptive_table_scan_drivers_interval_ms";
+
+  /// If true, the LocalPlanner fuses each chain of adjacent Filter and Project
+  /// nodes of a pipeline into a single FilterProject operator which evaluates
+  /// all the expressions of the chain in one ExprSet. The operator stats of
+  /// the fused chain are reported under the id of its last Project node.
+  static constexpr const char* kFilterProjectChainFusionEnabled =
+      "filter_project_chain_fusion_enabled";
+
+  /// If true, the LocalPlanner rewrites a Project node of a pipeline which
+  /// recomputes a deterministic expression evaluated by an earlier Project
+  /// node, or by the Filter fused with it, to reference a column of the
+  /// earlier node instead. The nodes in between may only be Filter, Limit,
+  /// TopN or OrderBy nodes, which pass the column through.
+  static constexpr const char* kCrossNodeSubexpressionSharingEnabled =
+      "cross_node_subexpression_sharing_enabled";
+
+  /// If true, an aggregation over the grouping sets of a GroupId node in the
+  /// same pipeline first partially aggregates the input on all the grouping
+  /// keys. GroupId then replicates the partial aggregates instead of the input
+  /// rows and the aggregation merges these for each grouping set. Applies only
+  /// to aggregations without masks, distinct or sorted aggregates.
+  static constexpr const char* kGroupingSetsPreAggregationEnabled =
+      "grouping_sets_pre_aggregation_enabled";
+
+  /// If not empty, each Task records the timeline of the Operator calls and
+  /// the blocked times of its Drivers and writes it as a Chrome trace event
+  /// JSON file named '<taskId>.json' to this directory when it completes.
+  static constexpr const char* kTaskTimelineDir = "task_timeline_dir";
+
+  /// The maximum number of events recorded in the timeline of a Task.
+  static constexpr const char* kTaskTimelineMaxEvents =
+      "task_timeline_max_events";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -378,6 +709,17 @@ class QueryConfig {
   /// derived using micro-benchmarking.
   static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
 
+  /// Maximum number of leading bytes of a VARCHAR or VARBINARY sort key to
+  /// store in the normalized key in prefix-sort. Rows with equal prefixes are
+  /// compared with the full values.
+  static constexpr const char* kPrefixSortMaxStringPrefixLength =
+      "prefixsort_max_string_prefix_length";
+
+  /// Minimum number of rows to sort the normalized keys in prefix-sort with
+  /// radix-sort instead of quick-sort.
+  static constexpr const char* kPrefixSortRadixSortMinRows =
+      "prefixsort_radix_sort_min_rows";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -449,6 +791,16 @@ class QueryConfig {
         config::CapacityUnit::BYTE);
   }
 
+  int32_t queryMemoryPriority() const {
+    return get<int32_t>(kQueryMemoryPriority, 0);
+  }
+
+  uint64_t queryMemoryGuaranteedCapacity() const {
+    return config::toCapacity(
+        get<std::string>(kQueryMemoryGuaranteedCapacity, "0B"),
+        config::CapacityUnit::BYTE);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -467,6 +819,30 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationMaxHotKeys() const {
+    return get<int32_t>(kAbandonPartialAggregationMaxHotKeys, 0);
+  }
+
+  uint64_t approxAggregationMaxGroups() const {
+    return get<uint64_t>(kApproxAggregationMaxGroups, 0);
+  }
+
+  bool finalAggregationMergeAcrossDrivers() const {
+    return get<bool>(kFinalAggregationMergeAcrossDrivers, false);
+  }
+
+  bool orderByRangePartitioning() const {
+    return get<bool>(kOrderByRangePartitioning, false);
+  }
+
+  bool windowRangeStreamingEnabled() const {
+    return get<bool>(kWindowRangeStreamingEnabled, false);
+  }
+
+  int32_t windowParallelChunkRows() const {
+    return get<int32_t>(kWindowParallelChunkRows, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -490,11 +866,41 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
+  int32_t skewedJoinSplitFactor() const {
+    return get<int32_t>(kSkewedJoinSplitFactor, 4);
+  }
+
+  double skewedJoinHotPartitionRatio() const {
+    return get<double>(kSkewedJoinHotPartitionRatio, 4.0);
+  }
+
+  uint64_t skewedJoinDecisionBytes() const {
+    static constexpr uint64_t kDefault = 16UL << 20;
+    return get<uint64_t>(kSkewedJoinDecisionBytes, kDefault);
+  }
+
+  uint64_t skewedJoinDecisionTimeoutMs() const {
+    return get<uint64_t>(kSkewedJoinDecisionTimeoutMs, 10'000);
+  }
+
+  uint64_t partitionedOutputCombinerMaxMemory() const {
+    static constexpr uint64_t kDefault = 1UL << 20;
+    return get<uint64_t>(kPartitionedOutputCombinerMaxMemory, kDefault);
+  }
+
   uint64_t maxOutputBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  uint64_t arbitraryOutputBufferReassignTimeoutMs() const {
+    return get<uint64_t>(kArbitraryOutputBufferReassignTimeoutMs, 0);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -527,6 +933,10 @@ class QueryConfig {
     return batchRows;
   }
 
+  uint64_t outputBatchCacheBudgetBytes() const {
+    return get<uint64_t>(kOutputBatchCacheBudgetBytes, 0);
+  }
+
   vector_size_t maxOutputBatchRows() const {
     const uint32_t maxBatchRows = get<uint32_t>(kMaxOutputBatchRows, 10'000);
     VELOX_USER_CHECK_LE(
@@ -592,6 +1002,14 @@ class QueryConfig {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  bool aggregationIncrementalSpillEnabled() const {
+    return get<bool>(kAggregationIncrementalSpillEnabled, false);
+  }
+
+  bool hybridJoinSpillEnabled() const {
+    return get<bool>(kHybridJoinSpillEnabled, false);
+  }
+
   bool orderBySpillEnabled() const {
     return get<bool>(kOrderBySpillEnabled, true);
   }
@@ -650,11 +1068,37 @@ class QueryConfig {
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
   uint64_t spillReadBufferSize() const {
     // The default read buffer size set to 1MB.
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  bool spillReadAheadEnabled() const {
+    return get<bool>(kSpillReadAheadEnabled, false);
+  }
+
+  uint64_t spillLocalQuotaBytes() const {
+    return get<uint64_t>(kSpillLocalQuotaBytes, 0);
+  }
+
+  uint64_t spillRemoteWriteBufferSize() const {
+    // The default remote write buffer size set to 16MB.
+    return get<uint64_t>(kSpillRemoteWriteBufferSize, 16L << 20);
+  }
+
+  bool spillColumnarFormatEnabled() const {
+    return get<bool>(kSpillColumnarFormatEnabled, false);
+  }
+
+  uint64_t spillRemoteReadBufferSize() const {
+    // The default remote read buffer size set to 8MB.
+    return get<uint64_t>(kSpillRemoteReadBufferSize, 8L << 20);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -696,6 +1140,10 @@ class QueryConfig {
     return get<bool>(kPrestoArrayAggIgnoreNulls, false);
   }
 
+  bool prestoArrayAggBufferRawInput() const {
+    return get<bool>(kPrestoArrayAggBufferRawInput, false);
+  }
+
   int64_t sparkBloomFilterExpectedNumItems() const {
     constexpr int64_t kDefault = 1'000'000L;
     return get<int64_t>(kSparkBloomFilterExpectedNumItems, kDefault);
@@ -735,10 +1183,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  uint32_t exprCpuSamplingRate() const {
+    return get<uint32_t>(kExprCpuSamplingRate, 0);
+  }
+
+  bool exprFuseArithmetic() const {
+    return get<bool>(kExprFuseArithmetic, false);
+  }
+
+  bool exprLikePrefilter() const {
+    return get<bool>(kExprLikePrefilter, true);
+  }
+
+  bool exprMultiPathExtract() const {
+    return get<bool>(kExprMultiPathExtract, false);
+  }
+
+  bool exprConcurrentLazyLoad() const {
+    return get<bool>(kExprConcurrentLazyLoad, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool decodedVectorCacheEnabled() const {
+    return get<bool>(kDecodedVectorCacheEnabled, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -752,10 +1224,47 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, false);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  int32_t hashProbeBloomFilterMaxMatchPct() const {
+    return get<int32_t>(kHashProbeBloomFilterMaxMatchPct, 0);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, false);
+  }
+
+  bool topNSplitOrderingEnabled() const {
+    return get<bool>(kTopNSplitOrderingEnabled, false);
+  }
+
+  int32_t hashProbeRadixClusterBits() const {
+    const auto bits = get<int32_t>(kHashProbeRadixClusterBits, 0);
+    VELOX_USER_CHECK_GE(
+        bits, 0, "{} must not be negative", kHashProbeRadixClusterBits);
+    VELOX_USER_CHECK_LE(
+        bits, 16, "{} must not exceed 16", kHashProbeRadixClusterBits);
+    return bits;
+  }
+
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  int32_t hashBuildColdPayloadMinBytes() const {
+    return get<int32_t>(kHashBuildColdPayloadMinBytes, 0);
+  }
+
+  bool nestedLoopJoinRangeEnabled() const {
+    return get<bool>(kNestedLoopJoinRangeEnabled, false);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -784,10 +1293,50 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  bool largestSplitFirst() const {
+    return get<bool>(kLargestSplitFirst, false);
+  }
+
+  bool arrowStreamPrefetch() const {
+    return get<bool>(kArrowStreamPrefetch, false);
+  }
+
+  bool tableScanResultCacheEnabled() const {
+    return get<bool>(kTableScanResultCacheEnabled, false);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  bool adaptiveTableScanDriversEnabled() const {
+    return get<bool>(kAdaptiveTableScanDriversEnabled, false);
+  }
+
+  uint32_t adaptiveTableScanDriversIntervalMs() const {
+    return get<uint32_t>(kAdaptiveTableScanDriversIntervalMs, 100);
+  }
+
+  bool filterProjectChainFusionEnabled() const {
+    return get<bool>(kFilterProjectChainFusionEnabled, false);
+  }
+
+  bool crossNodeSubexpressionSharingEnabled() const {
+    return get<bool>(kCrossNodeSubexpressionSharingEnabled, false);
+  }
+
+  bool groupingSetsPreAggregationEnabled() const {
+    return get<bool>(kGroupingSetsPreAggregationEnabled, false);
+  }
+
+  std::string taskTimelineDir() const {
+    return get<std::string>(kTaskTimelineDir, "");
+  }
+
+  uint64_t taskTimelineMaxEvents() const {
+    return get<uint64_t>(kTaskTimelineMaxEvents, 1'000'000);
+  }
+
   int64_t prefixSortNormalizedKeyMaxBytes() const {
     return get<int64_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -796,6 +1345,14 @@ class QueryConfig {
     return get<int32_t>(kPrefixSortMinRows, 130);
   }
 
+  int32_t prefixSortMaxStringPrefixLength() const {
+    return get<int32_t>(kPrefixSortMaxStringPrefixLength, 16);
+  }
+
+  int32_t prefixSortRadixSortMinRows() const {
+    return get<int32_t>(kPrefixSortRadixSortMinRows, 16'384);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
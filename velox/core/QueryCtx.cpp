@@ -120,6 +120,22 @@ uint64_t QueryCtx::MemoryReclaimer::reclaim(
   return memory::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
 }
 
+int32_t QueryCtx::MemoryReclaimer::priority() const {
+  auto queryCtx = ensureQueryCtx();
+  if (queryCtx == nullptr) {
+    return 0;
+  }
+  return queryCtx->queryConfig().queryMemoryPriority();
+}
+
+uint64_t QueryCtx::MemoryReclaimer::guaranteedCapacity() const {
+  auto queryCtx = ensureQueryCtx();
+  if (queryCtx == nullptr) {
+    return 0;
+  }
+  return queryCtx->queryConfig().queryMemoryGuaranteedCapacity();
+}
+
 bool QueryCtx::checkUnderArbitration(ContinueFuture* future) {
   VELOX_CHECK_NOT_NULL(future);
   std::lock_guard<std::mutex> l(mutex_);
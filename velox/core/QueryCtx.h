@@ -122,6 +122,11 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the aggregated spill bytes of this query.
+  uint64_t spilledBytes() const {
+    return numSpilledBytes_;
+  }
+
   /// Updates the aggregated trace bytes of this query, and throws if exceeds
   /// the max query trace bytes limit.
   void updateTracedBytesAndCheckLimit(uint64_t bytes);
@@ -167,6 +172,10 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    int32_t priority() const override;
+
+    uint64_t guaranteedCapacity() const override;
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
@@ -695,6 +695,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
   // provided by the UDF object. UDFs are required to provide at least one of
@@ -714,6 +715,7 @@ class UDFHolder {
   //
   // - bool|void callAscii(...)
   // - void initialize(...)
+  // - void callBatch(...)
 
   // call():
   static constexpr bool udf_has_call_return_bool = util::has_method<
@@ -829,6 +831,23 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): Computes call() for 'size' consecutive rows of flat inputs
+  // without nulls. Takes pointers to the first result and input values, e.g.
+  // void callBatch(double* result, const double* a, int32_t size). 'result'
+  // may point to the same values as one of the inputs. Only used for fixed
+  // width types and must neither throw nor produce nulls.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+  static_assert(
+      !udf_has_callBatch || (udf_has_call_return_void && !udf_has_callNullable),
+      "callBatch() requires a call() that returns void and default null "
+      "behavior.");
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -990,6 +1009,14 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      exec_return_type* result,
+      const exec_arg_type<TArgs>*... args,
+      int32_t size) {
+    static_assert(udf_has_callBatch);
+    instance_.callBatch(result, args..., size);
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE Status callImpl(
@@ -89,6 +89,8 @@ void BufferedInput::readToBuffer(
   }
   if (auto* stats = input_->getStats()) {
     stats->read().increment(allocated.size());
+    stats->incStorageRead(
+        input_->storageBackend(), false, allocated.size(), usec);
     stats->queryThreadIoLatency().increment(usec);
   }
 }
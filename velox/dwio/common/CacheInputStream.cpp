@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -245,6 +246,11 @@ void CacheInputStream::loadSync(const Region& region) {
     if (loadFromSsd(region, *entry)) {
       return;
     }
+    auto* peerCache = cache_->peerCache();
+    if (peerCache != nullptr && peerCache->load(*entry)) {
+      entry->setExclusiveToShared(!noCacheRetention_);
+      return;
+    }
     const auto ranges = makeRanges(entry, region.length);
     uint64_t storageReadUs{0};
     {
@@ -252,6 +258,8 @@ void CacheInputStream::loadSync(const Region& region) {
       input_->read(ranges, region.offset, LogType::FILE);
     }
     ioStats_->read().increment(region.length);
+    ioStats_->incStorageRead(
+        input_->storageBackend(), false, region.length, storageReadUs);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
@@ -318,6 +326,8 @@ bool CacheInputStream::loadFromSsd(
   VELOX_CHECK(pin_.empty());
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
+  ioStats_->incStorageRead(
+      IoStatistics::kSsdCacheBackend, false, region.length, ssdLoadUs);
   ioStats_->queryThreadIoLatency().increment(ssdLoadUs);
   // Skip no-cache retention setting as data is loaded from ssd.
   entry.setExclusiveToShared();
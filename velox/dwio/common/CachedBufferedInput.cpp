@@ -15,8 +15,10 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -202,7 +204,12 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   const bool isSsd = !requests[0]->ssdPin.empty();
-  const int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  int32_t maxDistance = 20000;
+  if (!isSsd) {
+    maxDistance = options_.adaptiveCoalesce()
+        ? input_->costModel()->coalesceDistance(options_.maxCoalesceDistance())
+        : options_.maxCoalesceDistance();
+  }
   std::sort(
       requests.begin(),
       requests.end(),
@@ -389,6 +396,24 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
+    // The entries owned by a peer which has them cached are not read from
+    // storage.
+    std::vector<CachePin> peerPins;
+    if (auto* peerCache = cache_.peerCache()) {
+      std::vector<CachePin> storagePins;
+      storagePins.reserve(pins.size());
+      for (auto& pin : pins) {
+        if (peerCache->load(*pin.checkedEntry())) {
+          peerPins.push_back(std::move(pin));
+        } else {
+          storagePins.push_back(std::move(pin));
+        }
+      }
+      pins = std::move(storagePins);
+    }
+    if (pins.empty()) {
+      return peerPins;
+    }
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -399,9 +424,24 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t readUs{0};
+          {
+            MicrosecondTimer timer(&readUs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioStats_ != nullptr) {
+            uint64_t readBytes{0};
+            for (const auto& buffer : buffers) {
+              readBytes += buffer.size();
+            }
+            ioStats_->incStorageRead(
+                input_->storageBackend(), prefetch, readBytes, readUs);
+          }
         });
     updateStats(stats, prefetch, false);
+    for (auto& pin : peerPins) {
+      pins.push_back(std::move(pin));
+    }
     return pins;
   }
 
@@ -436,7 +476,19 @@ class SsdLoad : public DwioCoalescedLoadBase {
       return pins;
     }
     assert(!ssdPins.empty()); // for lint.
-    const auto stats = ssdPins[0].file()->load(ssdPins, pins);
+    uint64_t loadUs{0};
+    CoalesceIoStats stats;
+    {
+      MicrosecondTimer timer(&loadUs);
+      stats = ssdPins[0].file()->load(ssdPins, pins);
+    }
+    if (ioStats_ != nullptr) {
+      ioStats_->incStorageRead(
+          IoStatistics::kSsdCacheBackend,
+          prefetch,
+          stats.payloadBytes + stats.extraBytes,
+          loadUs);
+    }
     updateStats(stats, prefetch, true);
     return pins;
   }
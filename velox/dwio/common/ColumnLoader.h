@@ -30,6 +30,12 @@ class ColumnLoader : public VectorLoader {
         fieldReader_(fieldReader),
         version_(version) {}
 
+  // Only 'fieldReader_' is advanced and read. 'structReader_' is not
+  // modified.
+  bool supportsConcurrentLoad() const override {
+    return true;
+  }
+
  private:
   void loadInternal(
       RowSet rows,
@@ -535,6 +535,54 @@ inline void ColumnVisitor<T, TFilter, ExtractValues, isDense>::addOutputRow(
 
 enum FilterResult { kUnknown = 0x40, kSuccess = 0x80, kFailure = 0 };
 
+// Minimum number of rows per dictionary entry for filling the filter cache of
+// the dictionary up front. Below this many entries are never referenced and
+// evaluating the filter on first reference is cheaper.
+constexpr int64_t kMinRowsPerDictionaryEntry = 4;
+
+// Returns true if the filter cache of a dictionary with 'numValues' entries
+// coding 'numRows' rows should be filled by fillDictionaryFilterCache()
+// before decoding.
+inline bool shouldFillDictionaryFilterCache(
+    const velox::common::Filter* filter,
+    int32_t numValues,
+    int64_t numRows) {
+  return DictionaryValues::hasFilter(filter) && filter->isDeterministic() &&
+      numValues > 0 && numValues * kMinRowsPerDictionaryEntry <= numRows;
+}
+
+// Evaluates 'filter' over the 'numValues' dictionary entries in 'values' and
+// writes the results to 'filterCache'. With a complete cache the dictionary
+// visitors filter rows by gathering from the cache only, instead of
+// evaluating the filter for each entry on first reference. Integer entries are
+// tested a SIMD batch at a time.
+template <typename T>
+void fillDictionaryFilterCache(
+    const velox::common::Filter& filter,
+    const T* values,
+    int32_t numValues,
+    uint8_t* filterCache) {
+  int32_t i = 0;
+  if constexpr (
+      std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+      std::is_same_v<T, int64_t>) {
+    constexpr int32_t kWidth = xsimd::batch<T>::size;
+    for (; i + kWidth <= numValues; i += kWidth) {
+      const auto passed = simd::toBitMask(
+          filter.testValues(xsimd::batch<T>::load_unaligned(values + i)));
+      for (auto j = 0; j < kWidth; ++j) {
+        filterCache[i + j] =
+            (passed >> j) & 1 ? FilterResult::kSuccess : FilterResult::kFailure;
+      }
+    }
+  }
+  for (; i < numValues; ++i) {
+    filterCache[i] = velox::common::applyFilter(filter, values[i])
+        ? FilterResult::kSuccess
+        : FilterResult::kFailure;
+  }
+}
+
 namespace detail {
 
 template <typename T, typename A>
@@ -112,7 +112,9 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  const int32_t maxDistance = options_.adaptiveCoalesce()
+      ? input_->costModel()->coalesceDistance(options_.maxCoalesceDistance())
+      : options_.maxCoalesceDistance();
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
@@ -288,6 +290,8 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
   ioStats_->incRawOverreadBytes(overread);
+  ioStats_->incStorageRead(
+      input_->storageBackend(), prefetch, size + overread, usecs);
   if (prefetch) {
     ioStats_->prefetch().increment(size + overread);
   }
@@ -153,6 +153,8 @@ void DirectInputStream::loadSync() {
     input_->read(ranges, loadedRegion_.offset, LogType::FILE);
   }
   ioStats_->read().increment(loadedRegion_.length);
+  ioStats_->incStorageRead(
+      input_->storageBackend(), false, loadedRegion_.length, usecs);
   ioStats_->queryThreadIoLatency().increment(usecs);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+FileMetadataCache*& instance() {
+  static FileMetadataCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+FileMetadataCache::FileMetadataCache(uint64_t capacity) : capacity_(capacity) {}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  instance() = cache;
+}
+
+std::shared_ptr<const void> FileMetadataCache::find(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->value;
+}
+
+void FileMetadataCache::put(
+    const std::string& key,
+    std::shared_ptr<const void> value,
+    uint64_t bytes) {
+  if (bytes > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (numBytes_ + bytes > capacity_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front(Entry{key, std::move(value), bytes});
+  entries_[key] = lru_.begin();
+  numBytes_ += bytes;
+}
+
+void FileMetadataCache::removeLocked(std::list<Entry>::iterator it) {
+  numBytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numBytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.numBytes = numBytes_;
+  stats.numHits = numHits_;
+  stats.numLookups = numLookups_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
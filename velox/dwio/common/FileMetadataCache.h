@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::velox::dwio::common {
+
+/// Process wide cache of the parsed metadata of files, e.g. the Parquet
+/// FileMetaData or the DWRF footer. The readers of the splits of the same file
+/// share the metadata parsed by the first one instead of reading and parsing
+/// the footer each time. The key identifies a version of a file, e.g. the path
+/// with the modification time and size, so that a rewritten file is not served
+/// stale metadata. Entries are evicted in LRU order when the total estimated
+/// size exceeds the capacity. Thread safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+    uint64_t numHits{0};
+    uint64_t numLookups{0};
+    uint64_t numEvictions{0};
+  };
+
+  explicit FileMetadataCache(uint64_t capacity);
+
+  /// Returns the process wide instance or nullptr if metadata is not cached.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the value for 'key' or nullptr if not cached.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(find(key));
+  }
+
+  /// Inserts 'value' with estimated size 'bytes' for 'key'. The value for the
+  /// same key must have the same type for all callers, e.g. by prefixing the
+  /// key with the file format. Replaces an existing value.
+  void put(
+      const std::string& key,
+      std::shared_ptr<const void> value,
+      uint64_t bytes);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> value;
+    uint64_t bytes;
+  };
+
+  std::shared_ptr<const void> find(const std::string& key);
+
+  void removeLocked(std::list<Entry>::iterator it);
+
+  const uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<std::string, std::list<Entry>::iterator> entries_;
+  uint64_t numBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numLookups_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
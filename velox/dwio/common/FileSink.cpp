@@ -111,25 +111,97 @@ WriteFileSink::WriteFileSink(
     std::unique_ptr<WriteFile> writeFile,
     std::string name,
     MetricsLogPtr metricLogger,
-    IoStatistics* stats)
+    IoStatistics* stats,
+    folly::Executor* writeExecutor,
+    uint64_t maxPendingWriteBytes)
     : FileSink(
           std::move(name),
           {.metricLogger = std::move(metricLogger), .stats = stats}),
-      writeFile_{std::move(writeFile)} {
+      writeFile_{std::move(writeFile)},
+      writeExecutor_{maxPendingWriteBytes > 0 ? writeExecutor : nullptr},
+      maxPendingWriteBytes_{maxPendingWriteBytes} {
   VELOX_CHECK_NOT_NULL(writeFile_);
 }
 
 void WriteFileSink::write(std::vector<DataBuffer<char>>& buffers) {
-  writeImpl(buffers, [&](auto& buffer) {
-    const uint64_t size = buffer.size();
-    writeFile_->append({buffer.data(), size});
-    return size;
-  });
+  if (writeExecutor_ == nullptr) {
+    writeImpl(buffers, [&](auto& buffer) {
+      const uint64_t size = buffer.size();
+      writeFile_->append({buffer.data(), size});
+      return size;
+    });
+    return;
+  }
+
+  DWIO_ENSURE(!isClosed(), "Cannot write to closed sink.");
+  uint64_t bytes{0};
+  uint64_t waitTimeUs{0};
+  {
+    MicrosecondTimer timer(&waitTimeUs);
+    std::unique_lock<std::mutex> l(mutex_);
+    throwIfWriteFailedLocked();
+    for (auto& buffer : buffers) {
+      bytes += buffer.size();
+      pendingBytes_ += buffer.size();
+      pendingBuffers_.push_back(std::move(buffer));
+    }
+    if (!appending_) {
+      appending_ = true;
+      writeExecutor_->add([this]() { appendPending(); });
+    }
+    appendedCv_.wait(l, [&]() {
+      return pendingBytes_ <= maxPendingWriteBytes_ || writeError_ != nullptr;
+    });
+    throwIfWriteFailedLocked();
+  }
+  size_ += bytes;
+  if (stats_ != nullptr) {
+    stats_->incRawBytesWritten(bytes);
+    stats_->incWriteIOTimeUs(waitTimeUs);
+  }
+  buffers.clear();
+}
+
+void WriteFileSink::appendPending() {
+  std::unique_lock<std::mutex> l(mutex_);
+  while (!pendingBuffers_.empty()) {
+    auto buffer = std::move(pendingBuffers_.front());
+    pendingBuffers_.pop_front();
+    l.unlock();
+    std::exception_ptr error;
+    try {
+      writeFile_->append({buffer.data(), buffer.size()});
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    l.lock();
+    pendingBytes_ -= buffer.size();
+    if (error != nullptr) {
+      writeError_ = error;
+      break;
+    }
+    appendedCv_.notify_all();
+  }
+  appending_ = false;
+  appendedCv_.notify_all();
+}
+
+void WriteFileSink::waitForPendingWrites() {
+  if (writeExecutor_ == nullptr) {
+    return;
+  }
+  std::unique_lock<std::mutex> l(mutex_);
+  appendedCv_.wait(l, [&]() { return !appending_; });
+  // Not empty only after an append error.
+  pendingBuffers_.clear();
+  pendingBytes_ = 0;
+  throwIfWriteFailedLocked();
 }
 
 void WriteFileSink::doClose() {
   VLOG(1) << "closing file: " << name()
           << ",  total size: " << succinctBytes(size_);
+  waitForPendingWrites();
   if (writeFile_ != nullptr) {
     writeFile_->close();
   }
@@ -17,6 +17,11 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <folly/Executor.h>
 
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
@@ -46,6 +51,13 @@ class FileSink : public Closeable {
     memory::MemoryPool* pool{nullptr};
     MetricsLogPtr metricLogger{MetricsLog::voidLog()};
     IoStatistics* stats{nullptr};
+    /// If set and 'maxPendingWriteBytes' is positive, sinks over remote
+    /// storage append the written buffers to the file on this executor. A
+    /// write returns once at most 'maxPendingWriteBytes' wait to be appended,
+    /// so that the writer encodes the next data while the previous is
+    /// uploaded.
+    folly::Executor* writeExecutor{nullptr};
+    uint64_t maxPendingWriteBytes{0};
   };
 
   FileSink(std::string name, const Options& options)
@@ -117,14 +129,20 @@ class FileSink : public Closeable {
   uint64_t size_;
 };
 
-/// Wrapper class that delegates calls to the underlying write file.
+/// Wrapper class that delegates calls to the underlying write file. If
+/// 'writeExecutor' is set and 'maxPendingWriteBytes' is positive, the buffers
+/// are appended to the file in order on 'writeExecutor' and write() only
+/// blocks while more than 'maxPendingWriteBytes' are pending. An append error
+/// is thrown by the next write() or close().
 class WriteFileSink final : public FileSink {
  public:
   WriteFileSink(
       std::unique_ptr<WriteFile> writeFile,
       std::string name,
       MetricsLogPtr metricLogger = MetricsLog::voidLog(),
-      IoStatistics* stats = nullptr);
+      IoStatistics* stats = nullptr,
+      folly::Executor* writeExecutor = nullptr,
+      uint64_t maxPendingWriteBytes = 0);
 
   ~WriteFileSink() override {
     destroy();
@@ -143,12 +161,38 @@ class WriteFileSink final : public FileSink {
   // TODO: Hack to make Alpha writer work with Velox.  To be removed after Alpha
   // writer takes DataSink directly.
   std::unique_ptr<WriteFile> toWriteFile() {
+    waitForPendingWrites();
     markClosed();
     return std::move(writeFile_);
   }
 
  private:
+  // Appends the pending buffers to 'writeFile_' until there are none. Runs on
+  // 'writeExecutor_'.
+  void appendPending();
+
+  // Waits until the pending buffers are appended and throws the append error
+  // if any.
+  void waitForPendingWrites();
+
+  void throwIfWriteFailedLocked() const {
+    if (writeError_ != nullptr) {
+      std::rethrow_exception(writeError_);
+    }
+  }
+
   std::unique_ptr<WriteFile> writeFile_;
+  folly::Executor* const writeExecutor_;
+  const uint64_t maxPendingWriteBytes_;
+
+  std::mutex mutex_;
+  // Signaled when pending buffers are appended.
+  std::condition_variable appendedCv_;
+  std::deque<DataBuffer<char>> pendingBuffers_;
+  uint64_t pendingBytes_{0};
+  // True while appendPending() is scheduled or running.
+  bool appending_{false};
+  std::exception_ptr writeError_;
 };
 
 class LocalFileSink : public FileSink {
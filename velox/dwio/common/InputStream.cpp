@@ -65,7 +65,9 @@ ReadFileInputStream::ReadFileInputStream(
     const MetricsLogPtr& metricsLog,
     IoStatistics* stats)
     : InputStream(readFile->getName(), metricsLog, stats),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      costModel_(io::IoCostModel::forPath(getName())),
+      storageBackend_(io::IoStatistics::storageBackend(getName())) {}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -80,6 +82,7 @@ void ReadFileInputStream::read(
     MicrosecondTimer timer(&readTimeUs);
     readData = readFile_->pread(offset, length, buf);
   }
+  costModel_->recordRead(length, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -101,7 +104,13 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    size = readFile_->preadv(offset, buffers);
+  }
+  costModel_->recordRead(bufferSize, readTimeUs);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
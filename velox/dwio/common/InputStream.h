@@ -32,6 +32,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
+#include "velox/common/io/IoCostModel.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/dwio/common/MetricsLog.h"
 
@@ -176,8 +177,21 @@ class ReadFileInputStream final : public InputStream {
     return readFile_;
   }
 
+  /// Returns the cost model of the file system of the file. Updated by the
+  /// synchronous reads of this stream.
+  const std::shared_ptr<io::IoCostModel>& costModel() const {
+    return costModel_;
+  }
+
+  /// Returns the storage backend of the file for IoStatistics::incStorageRead.
+  std::string_view storageBackend() const {
+    return storageBackend_;
+  }
+
  private:
   std::shared_ptr<velox::ReadFile> readFile_;
+  const std::shared_ptr<io::IoCostModel> costModel_;
+  const std::string storageBackend_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/IoScheduler.h"
+
+#include <folly/ScopeGuard.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+// Forwards the tasks to IoScheduler with a fixed query and priority.
+class QueryIoExecutor : public folly::Executor {
+ public:
+  QueryIoExecutor(
+      std::shared_ptr<IoScheduler> scheduler,
+      std::string queryId,
+      IoScheduler::Priority priority)
+      : scheduler_(std::move(scheduler)),
+        queryId_(std::move(queryId)),
+        priority_(priority) {}
+
+  void add(folly::Func func) override {
+    scheduler_->add(queryId_, priority_, std::move(func));
+  }
+
+ private:
+  const std::shared_ptr<IoScheduler> scheduler_;
+  const std::string queryId_;
+  const IoScheduler::Priority priority_;
+};
+} // namespace
+
+IoScheduler::IoScheduler(
+    folly::Executor* executor,
+    int32_t maxConcurrency,
+    int32_t maxConcurrencyPerQuery)
+    : executor_(executor),
+      maxConcurrency_(maxConcurrency),
+      maxConcurrencyPerQuery_(maxConcurrencyPerQuery) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxConcurrency_, 0);
+  VELOX_CHECK_GT(maxConcurrencyPerQuery_, 0);
+}
+
+void IoScheduler::add(
+    const std::string& queryId,
+    Priority priority,
+    folly::Func task) {
+  std::vector<std::pair<std::string, folly::Func>> toStart;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& query = queries_[queryId];
+    if (query.tasks[0].empty() && query.tasks[1].empty()) {
+      roundRobin_.push_back(queryId);
+    }
+    query.tasks[static_cast<int32_t>(priority)].push_back(
+        {std::move(task), std::chrono::steady_clock::now()});
+    ++numQueued_;
+    toStart = nextTasksLocked();
+  }
+  start(std::move(toStart));
+}
+
+std::shared_ptr<folly::Executor> IoScheduler::executorFor(
+    const std::string& queryId,
+    Priority priority) {
+  return std::make_shared<QueryIoExecutor>(
+      shared_from_this(), queryId, priority);
+}
+
+bool IoScheduler::nextTaskLocked(std::string& queryId, Task& task) {
+  for (auto priority = 0; priority < 2; ++priority) {
+    for (auto i = 0; i < roundRobin_.size(); ++i) {
+      auto& query = queries_.at(roundRobin_[i]);
+      if (query.numRunning >= maxConcurrencyPerQuery_ ||
+          query.tasks[priority].empty()) {
+        continue;
+      }
+      queryId = std::move(roundRobin_[i]);
+      roundRobin_.erase(roundRobin_.begin() + i);
+      task = std::move(query.tasks[priority].front());
+      query.tasks[priority].pop_front();
+      ++query.numRunning;
+      // The query goes last in the round robin order.
+      if (!query.tasks[0].empty() || !query.tasks[1].empty()) {
+        roundRobin_.push_back(queryId);
+      }
+      const auto waitUs =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - task.enqueueTime)
+              .count();
+      ++stats_.numStarted[priority];
+      stats_.queueWaitUs[priority] += waitUs;
+      stats_.maxQueueWaitUs[priority] =
+          std::max<uint64_t>(stats_.maxQueueWaitUs[priority], waitUs);
+      RECORD_HISTOGRAM_METRIC_VALUE(
+          kMetricIoSchedulerQueueWaitMs, waitUs / 1'000);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::pair<std::string, folly::Func>>
+IoScheduler::nextTasksLocked() {
+  std::vector<std::pair<std::string, folly::Func>> tasks;
+  while (numRunning_ < maxConcurrency_) {
+    std::string queryId;
+    Task task;
+    if (!nextTaskLocked(queryId, task)) {
+      break;
+    }
+    --numQueued_;
+    ++numRunning_;
+    tasks.emplace_back(std::move(queryId), std::move(task.func));
+  }
+  return tasks;
+}
+
+void IoScheduler::start(
+    std::vector<std::pair<std::string, folly::Func>> tasks) {
+  for (auto& [queryId, func] : tasks) {
+    executor_->add([self = shared_from_this(),
+                    queryId = std::move(queryId),
+                    func = std::move(func)]() mutable {
+      SCOPE_EXIT {
+        self->onTaskDone(queryId);
+      };
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "IO task of query " << queryId << " failed: " << e.what();
+      }
+    });
+  }
+}
+
+void IoScheduler::onTaskDone(const std::string& queryId) {
+  std::vector<std::pair<std::string, folly::Func>> toStart;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    --numRunning_;
+    auto it = queries_.find(queryId);
+    VELOX_CHECK(it != queries_.end());
+    auto& query = it->second;
+    --query.numRunning;
+    if (query.numRunning == 0 && query.tasks[0].empty() &&
+        query.tasks[1].empty()) {
+      queries_.erase(it);
+    }
+    toStart = nextTasksLocked();
+  }
+  start(std::move(toStart));
+}
+
+int32_t IoScheduler::numQueued() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numQueued_;
+}
+
+IoScheduler::Stats IoScheduler::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+} // namespace facebook::velox::dwio::common
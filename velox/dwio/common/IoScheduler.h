@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::dwio::common {
+
+/// Schedules the asynchronous loads of readers, e.g. the prefetches of
+/// CachedBufferedInput and DirectBufferedInput, on an IO executor. Without a
+/// scheduler, the loads of all queries go to the executor in submission order
+/// and a large scan fills its queue ahead of the loads of short queries. The
+/// scheduler keeps the loads in per query queues and runs at most
+/// 'maxConcurrency' of them at a time and at most 'maxConcurrencyPerQuery' of
+/// the same query. The next load is taken round robin from the queries with
+/// queued loads, demand loads before prefetches. Thread safe. Must be created
+/// with std::make_shared since the started loads keep it alive.
+class IoScheduler : public std::enable_shared_from_this<IoScheduler> {
+ public:
+  enum class Priority {
+    /// A load that a driver waits for.
+    kDemand,
+    /// A read ahead of use.
+    kPrefetch,
+  };
+
+  struct Stats {
+    /// The number of loads started per priority.
+    uint64_t numStarted[2]{};
+    /// The total and max time in microseconds from add() to start per
+    /// priority.
+    uint64_t queueWaitUs[2]{};
+    uint64_t maxQueueWaitUs[2]{};
+  };
+
+  IoScheduler(
+      folly::Executor* executor,
+      int32_t maxConcurrency,
+      int32_t maxConcurrencyPerQuery);
+
+  /// Queues 'task' of 'queryId' with 'priority'.
+  void add(const std::string& queryId, Priority priority, folly::Func task);
+
+  /// Returns an executor whose add() queues the task in this for 'queryId'
+  /// with 'priority'. Used as the executor of the BufferedInputs of a query.
+  std::shared_ptr<folly::Executor> executorFor(
+      const std::string& queryId,
+      Priority priority);
+
+  /// Returns the number of loads queued and not started.
+  int32_t numQueued() const;
+
+  Stats stats() const;
+
+ private:
+  struct Task {
+    folly::Func func;
+    std::chrono::steady_clock::time_point enqueueTime;
+  };
+
+  struct QueryQueue {
+    // Queued tasks per priority.
+    std::deque<Task> tasks[2];
+    int32_t numRunning{0};
+  };
+
+  // Removes the tasks to start from the queues until 'maxConcurrency_' are
+  // running or the queued tasks belong to queries at
+  // 'maxConcurrencyPerQuery_'. Returns the tasks with their query ids.
+  std::vector<std::pair<std::string, folly::Func>> nextTasksLocked();
+
+  // Submits 'tasks' to 'executor_'. Called without holding 'mutex_' so that
+  // an inline executor can run them.
+  void start(std::vector<std::pair<std::string, folly::Func>> tasks);
+
+  // Removes the next task to run from the queues. Returns false if there is
+  // none.
+  bool nextTaskLocked(std::string& queryId, Task& task);
+
+  void onTaskDone(const std::string& queryId);
+
+  folly::Executor* const executor_;
+  const int32_t maxConcurrency_;
+  const int32_t maxConcurrencyPerQuery_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, QueryQueue> queries_;
+  // The queries with queued tasks in round robin order.
+  std::deque<std::string> roundRobin_;
+  int32_t numRunning_{0};
+  int32_t numQueued_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -108,6 +108,22 @@ class MetricsLog {
 
   virtual void logStripeFlush(const StripeFlushMetrics& /* metrics */) const {}
 
+  struct EncodingSelectionMetrics {
+    std::string writerVersion;
+    uint32_t stripeIndex;
+    uint32_t node;
+    uint32_t sequence;
+    uint64_t numValues;
+    uint32_t numDistinctValues;
+    uint64_t estimatedDictionarySize;
+    uint64_t estimatedDirectSize;
+    bool dictionary;
+  };
+
+  /// Logs the choice of encoding for a column by a cost based selector.
+  virtual void logEncodingSelection(
+      const EncodingSelectionMetrics& /* metrics */) const {}
+
   struct FileCloseMetrics {
     std::string writerVersion;
     uint64_t footerLength;
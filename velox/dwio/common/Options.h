@@ -286,6 +286,39 @@ class RowReaderOptions {
     decodingParallelismFactor_ = factor;
   }
 
+  /// Sets the number of units, e.g. stripes, loaded at a time on
+  /// 'decodingExecutor' ahead of the reader. Values above 1 take effect only
+  /// with 'decodingExecutor', 'preloadStripe' and no 'unitLoaderFactory'.
+  void setParallelUnitLoadCount(size_t count) {
+    parallelUnitLoadCount_ = count;
+  }
+
+  size_t parallelUnitLoadCount() const {
+    return parallelUnitLoadCount_;
+  }
+
+  /// Sets the number of compression blocks of each stream decompressed on
+  /// 'decodingExecutor' ahead of the block being decoded. 0 means the blocks
+  /// are decompressed by the reader as it gets to them. Takes effect only with
+  /// 'decodingExecutor'.
+  void setDecompressionReadAheadBlocks(int32_t numBlocks) {
+    decompressionReadAheadBlocks_ = numBlocks;
+  }
+
+  int32_t decompressionReadAheadBlocks() const {
+    return decompressionReadAheadBlocks_;
+  }
+
+  /// Sets the maximum IO size of the units loaded ahead of the current one
+  /// with 'parallelUnitLoadCount'. 0 means no limit.
+  void setMaxUnitLoadAheadBytes(uint64_t bytes) {
+    maxUnitLoadAheadBytes_ = bytes;
+  }
+
+  uint64_t maxUnitLoadAheadBytes() const {
+    return maxUnitLoadAheadBytes_;
+  }
+
   void setRowNumberColumnInfo(
       std::optional<RowNumberColumnInfo> rowNumberColumnInfo) {
     rowNumberColumnInfo_ = std::move(rowNumberColumnInfo);
@@ -395,11 +428,16 @@ class RowReaderOptions {
   // Node id for map column to a list of keys to be projected as a struct.
   std::unordered_map<uint32_t, std::vector<std::string>> flatmapNodeIdAsStruct_;
   // Optional executors to enable internal reader parallelism.
-  // 'decodingExecutor' allow parallelising the vector decoding process.
+  // 'decodingExecutor' allow parallelising the vector decoding process. The
+  // Parquet reader decodes the non-filtered columns of a row group on it
+  // instead of loading them lazily.
   // 'ioExecutor' enables parallelism when performing file system read
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   size_t decodingParallelismFactor_{0};
+  size_t parallelUnitLoadCount_{0};
+  uint64_t maxUnitLoadAheadBytes_{0};
+  int32_t decompressionReadAheadBlocks_{0};
   std::optional<RowNumberColumnInfo> rowNumberColumnInfo_{std::nullopt};
 
   // Function to populate metrics related to feature projection stats
@@ -486,6 +524,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the key of the version of the file in FileMetadataCache, e.g. the
+  /// path with the modification time. The metadata is not cached if empty.
+  ReaderOptions& setFileMetadataCacheKey(std::string key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
   ReaderOptions& setFileColumnNamesReadAsLowerCase(bool flag) {
     fileColumnNamesReadAsLowerCase_ = flag;
     return *this;
@@ -546,6 +591,10 @@ class ReaderOptions : public io::ReaderOptions {
     return filePreloadThreshold_;
   }
 
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
   const std::shared_ptr<folly::Executor>& ioExecutor() const {
     return ioExecutor_;
   }
@@ -606,6 +655,7 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<encryption::DecrypterFactory> decrypterFactory_;
   uint64_t footerEstimatedSize_{kDefaultFooterEstimatedSize};
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
+  std::string fileMetadataCacheKey_;
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
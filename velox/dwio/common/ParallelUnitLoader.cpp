@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+
+#include <atomic>
+#include <numeric>
+#include <optional>
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/UnitLoaderTools.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class ParallelUnitLoader : public UnitLoader {
+ public:
+  ParallelUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      size_t maxConcurrentLoads,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      uint64_t maxBytesAhead)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxConcurrentLoads_{maxConcurrentLoads},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        maxBytesAhead_{maxBytesAhead},
+        loads_(loadUnits_.size()) {}
+
+  ~ParallelUnitLoader() override {
+    // The loads in progress reference the units.
+    for (auto& load : loads_) {
+      if (load.has_value()) {
+        *load->cancelled = true;
+        load->future.wait();
+      }
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+
+    // Unloads the units outside of the window starting at 'unit' and starts
+    // the loads of the units in the window.
+    const auto windowEnd =
+        std::min<size_t>(unit + maxConcurrentLoads_, loadUnits_.size());
+    for (size_t i = 0; i < loadUnits_.size(); ++i) {
+      if (i < unit || i >= windowEnd) {
+        unload(i);
+      }
+    }
+    uint64_t bytesAhead = 0;
+    for (size_t i = unit; i < windowEnd; ++i) {
+      if (!loads_[i].has_value()) {
+        const auto ioSize =
+            (i > unit && maxBytesAhead_ > 0) ? loadUnits_[i]->getIoSize() : 0;
+        if (i > unit && maxBytesAhead_ > 0 &&
+            bytesAhead + ioSize > maxBytesAhead_) {
+          break;
+        }
+        startLoad(i, ioSize);
+      }
+      if (i > unit) {
+        bytesAhead += loads_[i]->ioSize;
+      }
+    }
+
+    auto& future = loads_[unit]->future;
+    if (!future.isReady()) {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      future.wait();
+    }
+    // Rethrows the error of the load, if any. A failed load is redone on the
+    // next call.
+    if (future.hasException()) {
+      auto error = future.result().exception();
+      loads_[unit].reset();
+      error.throw_exception();
+    }
+    VELOX_CHECK(future.value());
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+ private:
+  struct Load {
+    // True if the unit was loaded, false if the load was cancelled before it
+    // started.
+    folly::Future<bool> future;
+    std::shared_ptr<std::atomic_bool> cancelled;
+    // The IO size of the unit if it is loaded ahead with a byte budget.
+    uint64_t ioSize;
+  };
+
+  void startLoad(size_t unit, uint64_t ioSize) {
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    auto future = folly::via(executor_, [this, unit, cancelled]() {
+      if (*cancelled) {
+        return false;
+      }
+      loadUnits_[unit]->load();
+      return true;
+    });
+    loads_[unit] = Load{std::move(future), std::move(cancelled), ioSize};
+  }
+
+  // Cancels the load of 'unit' if it has not started. Otherwise waits for the
+  // load in progress, if any, and unloads the unit.
+  void unload(size_t unit) {
+    auto& load = loads_[unit];
+    if (!load.has_value()) {
+      return;
+    }
+    *load->cancelled = true;
+    load->future.wait();
+    if (load->future.hasValue() && load->future.value()) {
+      loadUnits_[unit]->unload();
+    }
+    load.reset();
+  }
+
+  const std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const size_t maxConcurrentLoads_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const uint64_t maxBytesAhead_;
+  // The loads of the units which are loading or loaded.
+  std::vector<std::optional<Load>> loads_;
+};
+
+} // namespace
+
+ParallelUnitLoaderFactory::ParallelUnitLoaderFactory(
+    folly::Executor* executor,
+    size_t maxConcurrentLoads,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback,
+    uint64_t maxBytesAhead)
+    : executor_{executor},
+      maxConcurrentLoads_{maxConcurrentLoads},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+      maxBytesAhead_{maxBytesAhead} {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxConcurrentLoads_, 0);
+}
+
+std::unique_ptr<UnitLoader> ParallelUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<ParallelUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      maxConcurrentLoads_,
+      blockedOnIoCallback_,
+      maxBytesAhead_);
+}
+
+} // namespace facebook::velox::dwio::common
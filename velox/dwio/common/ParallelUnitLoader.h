@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates UnitLoaders which load the next 'maxConcurrentLoads' units ahead
+/// of the reader on 'executor', e.g. the stripes of a DWRF file. The loads
+/// of the units, i.e. their IO and decoder setup, run in parallel while the
+/// reader decodes the rows of the current unit. The units are still returned
+/// in the order the reader asks for them. At most 'maxConcurrentLoads' units
+/// are loaded at a time, including the current one. With 'maxConcurrentLoads'
+/// of 2, this prefetches the next stripe while the current one is decoded.
+///
+/// If 'maxBytesAhead' is not 0, the units after the current one are loaded
+/// only while the sum of their LoadUnit::getIoSize() fits in 'maxBytesAhead'.
+/// The loads of units that the reader skips or seeks past are cancelled if
+/// they have not started, and unloaded otherwise.
+///
+/// The LoadUnits must support being loaded concurrently with each other and
+/// with reading from another unit.
+class ParallelUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  ParallelUnitLoaderFactory(
+      folly::Executor* executor,
+      size_t maxConcurrentLoads,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      uint64_t maxBytesAhead = 0);
+
+  ~ParallelUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const size_t maxConcurrentLoads_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const uint64_t maxBytesAhead_;
+};
+
+} // namespace facebook::velox::dwio::common
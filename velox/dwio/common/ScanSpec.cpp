@@ -49,8 +49,13 @@ bool ScanSpec::compareTimeToDropValue(
     const std::shared_ptr<ScanSpec>& right) {
   if (left->hasFilter() && right->hasFilter()) {
     if (left->selectivity_.numIn() || right->selectivity_.numIn()) {
-      return left->selectivity_.timeToDropValue() <
-          right->selectivity_.timeToDropValue();
+      return left->timeToDropValue() < right->timeToDropValue();
+    }
+    // Without history the filter estimated to pass fewer rows goes first.
+    if (left->selectivityEstimate_.has_value() &&
+        right->selectivityEstimate_.has_value() &&
+        left->selectivityEstimate_ != right->selectivityEstimate_) {
+      return left->selectivityEstimate_ < right->selectivityEstimate_;
     }
     // Integer filters are before other filters if there is no
     // history data.
@@ -76,6 +81,18 @@ bool ScanSpec::compareTimeToDropValue(
   return left->fieldName_ < right->fieldName_;
 }
 
+float ScanSpec::timeToDropValue() const {
+  if (!selectivityEstimate_.has_value() || selectivity_.numIn() == 0) {
+    return selectivity_.timeToDropValue();
+  }
+  const double dropped = 1 - selectivityEstimate_.value();
+  if (dropped <= 0) {
+    // Nothing is expected to be dropped, so the filter goes last.
+    return std::numeric_limits<float>::max();
+  }
+  return selectivity_.timePerValue() / dropped;
+}
+
 uint64_t ScanSpec::newRead() {
   if (numReads_ == 0 ||
       !std::is_sorted(
@@ -286,8 +303,95 @@ bool testBoolFilter(
   return true;
 }
 
+// Returns the fraction of the values in [min, max] that are in [lower, upper].
+// 'discrete' is true for integers.
+double rangeOverlap(
+    double min,
+    double max,
+    double lower,
+    double upper,
+    bool discrete) {
+  if (upper < min || lower > max) {
+    return 0;
+  }
+  if (min == max) {
+    return 1;
+  }
+  const double extra = discrete ? 1 : 0;
+  return (std::min(upper, max) - std::max(lower, min) + extra) /
+      (max - min + extra);
+}
+
+template <typename T>
+std::optional<double> floatingPointOverlap(
+    const common::Filter* filter,
+    dwio::common::DoubleColumnStatistics* stats) {
+  if (!stats || !stats->getMinimum().has_value() ||
+      !stats->getMaximum().has_value()) {
+    return std::nullopt;
+  }
+  auto* range = static_cast<const common::FloatingPointRange<T>*>(filter);
+  return rangeOverlap(
+      stats->getMinimum().value(),
+      stats->getMaximum().value(),
+      range->lowerUnbounded() ? -std::numeric_limits<double>::infinity()
+                              : range->lower(),
+      range->upperUnbounded() ? std::numeric_limits<double>::infinity()
+                              : range->upper(),
+      false);
+}
 } // namespace
 
+std::optional<double> estimateFilterSelectivity(
+    const common::Filter* filter,
+    dwio::common::ColumnStatistics* stats,
+    uint64_t totalRows,
+    const TypePtr& type) {
+  if (totalRows == 0 || !stats->getNumberOfValues().has_value() ||
+      type->isDecimal()) {
+    return std::nullopt;
+  }
+  const double nonNullFraction = std::min<double>(
+      1, stats->getNumberOfValues().value() / static_cast<double>(totalRows));
+  std::optional<double> valueFraction;
+  switch (filter->kind()) {
+    case common::FilterKind::kIsNull:
+      return 1 - nonNullFraction;
+    case common::FilterKind::kIsNotNull:
+      return nonNullFraction;
+    case common::FilterKind::kBigintRange: {
+      auto* intStats =
+          dynamic_cast<dwio::common::IntegerColumnStatistics*>(stats);
+      if (intStats && intStats->getMinimum().has_value() &&
+          intStats->getMaximum().has_value()) {
+        auto* range = static_cast<const common::BigintRange*>(filter);
+        valueFraction = rangeOverlap(
+            intStats->getMinimum().value(),
+            intStats->getMaximum().value(),
+            range->lower(),
+            range->upper(),
+            true);
+      }
+      break;
+    }
+    case common::FilterKind::kDoubleRange:
+      valueFraction = floatingPointOverlap<double>(
+          filter, dynamic_cast<dwio::common::DoubleColumnStatistics*>(stats));
+      break;
+    case common::FilterKind::kFloatRange:
+      valueFraction = floatingPointOverlap<float>(
+          filter, dynamic_cast<dwio::common::DoubleColumnStatistics*>(stats));
+      break;
+    default:
+      break;
+  }
+  if (!valueFraction.has_value()) {
+    return std::nullopt;
+  }
+  const double nullsPassing = filter->testNull() ? 1 - nonNullFraction : 0;
+  return nullsPassing + nonNullFraction * valueFraction.value();
+}
+
 bool testFilter(
     common::Filter* filter,
     dwio::common::ColumnStatistics* stats,
@@ -218,6 +218,19 @@ class ScanSpec {
     return selectivity_;
   }
 
+  /// Sets the estimated fraction of the rows passing the filter in the data
+  /// being read, e.g. from the statistics of the current row group. The
+  /// estimate replaces the measured fraction of dropped rows when ordering the
+  /// filters, while the measured time per value is kept. std::nullopt falls
+  /// back to the measurements only.
+  void setSelectivityEstimate(std::optional<double> estimate) {
+    selectivityEstimate_ = estimate;
+  }
+
+  std::optional<double> selectivityEstimate() const {
+    return selectivityEstimate_;
+  }
+
   ValueHook* valueHook() const {
     return valueHook_;
   }
@@ -370,6 +383,10 @@ class ScanSpec {
       const std::shared_ptr<ScanSpec>& x,
       const std::shared_ptr<ScanSpec>& y);
 
+  // Returns the time to drop a value based on 'selectivity_' and
+  // 'selectivityEstimate_'.
+  float timeToDropValue() const;
+
   // Serializes stableChildren().
   std::mutex mutex_;
 
@@ -412,6 +429,7 @@ class ScanSpec {
       metadataFilters_;
 
   SelectivityInfo selectivity_;
+  std::optional<double> selectivityEstimate_;
 
   std::vector<std::shared_ptr<ScanSpec>> children_;
   // Read-only copy of children, not subject to reordering. Used when
@@ -477,6 +495,16 @@ bool testFilter(
     uint64_t totalRows,
     const TypePtr& type);
 
+// Returns the estimated fraction of 'totalRows' rows described by 'stats' that
+// pass 'filter'. The non-null values are assumed to be uniformly distributed
+// between the min and max. Returns std::nullopt if the filter or the stats do
+// not allow an estimate.
+std::optional<double> estimateFilterSelectivity(
+    const common::Filter* filter,
+    dwio::common::ColumnStatistics* stats,
+    uint64_t totalRows,
+    const TypePtr& type);
+
 } // namespace common
 } // namespace velox
 } // namespace facebook
@@ -186,6 +186,13 @@ void SelectiveIntegerColumnReader::processFilter(
               velox::common::BigintValuesUsingBitmask,
               isDense>(filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kBigintValuesUsingBloomFilter:
+      static_cast<Reader*>(this)
+          ->template readHelper<
+              Reader,
+              velox::common::BigintValuesUsingBloomFilter,
+              isDense>(filter, rows, extractValues);
+      break;
     case velox::common::FilterKind::kNegatedBigintValuesUsingHashTable:
       static_cast<Reader*>(this)
           ->template readHelper<
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -360,6 +361,9 @@ void SelectiveStructColumnReaderBase::read(
 
   const auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  // Non-filtered top level children read after the filters when decoding in
+  // parallel.
+  std::vector<SelectiveColumnReader*> parallelReaders;
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     const auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -386,7 +390,10 @@ void SelectiveStructColumnReaderBase::read(
     auto* reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter()) {
-      // Will make a LazyVector.
+      if (parallelDecoding()) {
+        parallelReaders.push_back(reader);
+      }
+      // Will make a LazyVector unless decoded in parallel.
       continue;
     }
 
@@ -412,6 +419,20 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!activeRows.empty() && !parallelReaders.empty()) {
+    for (auto* reader : parallelReaders) {
+      advanceFieldReader(reader, offset);
+    }
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        parallelReaders.size(),
+        decodingParallelismFactor_)
+        .execute([&](size_t i) {
+          parallelReaders[i]->read(offset, activeRows, structNulls);
+        });
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -543,7 +564,8 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
 
-    if (childSpec->hasFilter() || !children_[index]->isTopLevel()) {
+    if (childSpec->hasFilter() || !children_[index]->isTopLevel() ||
+        parallelDecoding()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
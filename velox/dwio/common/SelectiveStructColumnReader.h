@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -102,6 +104,18 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     currentRowNumber_ = value;
   }
 
+  /// Reads the top level projected children without filters on up to
+  /// 'parallelismFactor' threads of 'executor' instead of returning them as
+  /// LazyVectors. The filtered children are still read first and in order on
+  /// the calling thread. A null 'executor' or a factor of 1 or less keeps the
+  /// lazy loading.
+  void setDecodingExecutor(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -146,6 +160,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   /// forward within the row group.
   void recordParentNullsInChildren(int64_t offset, const RowSet& rows);
 
+  bool parallelDecoding() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
   void setOutputRowsForLazy(const RowSet& rows) {
     if (useOutputRows() && rows.size() != outputRows_.size()) {
       setOutputRows(rows);
@@ -179,6 +197,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // After read() call mutation_ could go out of scope.  Need to keep this
   // around for lazy columns.
   bool hasDeletion_ = false;
+
+  // Executor for reading the non-filtered children in parallel. Not owned.
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelismFactor_{0};
 };
 
 class SelectiveStructColumnReader : public SelectiveStructColumnReaderBase {
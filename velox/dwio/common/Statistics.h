@@ -523,6 +523,9 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages skipped based on the page index statistics.
+  int64_t skippedPages{0};
 };
 
 struct RuntimeStatistics {
@@ -544,7 +547,8 @@ struct RuntimeStatistics {
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
         {"flattenStringDictionaryValues",
-         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)},
+        {"skippedPages", RuntimeCounter(columnReaderStatistics.skippedPages)}};
   }
 };
 
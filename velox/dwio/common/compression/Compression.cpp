@@ -19,6 +19,9 @@
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+#include <array>
+
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <lz4.h>
 #include <snappy.h>
@@ -640,6 +643,168 @@ std::unique_ptr<Compressor> createCompressor(
   return nullptr;
 }
 
+namespace {
+
+folly::Synchronized<std::unordered_map<int32_t, BlockDecompressorFactory>>&
+blockDecompressorFactories() {
+  static folly::Synchronized<
+      std::unordered_map<int32_t, BlockDecompressorFactory>>
+      factories;
+  return factories;
+}
+
+// Returns the factory registered for 'kind' or an empty function.
+BlockDecompressorFactory blockDecompressorFactory(CompressionKind kind) {
+  auto factories = blockDecompressorFactories().rlock();
+  auto it = factories->find(kind);
+  if (it == factories->end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+struct AtomicBlockDecompressorStats {
+  std::atomic<uint64_t> numBlocks{0};
+  std::atomic<uint64_t> numFallbacks{0};
+};
+
+AtomicBlockDecompressorStats& blockDecompressorStatsOf(CompressionKind kind) {
+  static std::array<
+      AtomicBlockDecompressorStats,
+      CompressionKind::CompressionKind_GZIP + 1>
+      stats;
+  VELOX_CHECK_LE(kind, CompressionKind::CompressionKind_GZIP);
+  return stats[kind];
+}
+
+std::unique_ptr<Decompressor> createSoftwareBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo);
+
+// Decompresses with a decompressor of a registered factory. Falls back to the
+// software decompressor for the blocks 'decompressor_' fails on.
+class FallbackDecompressor : public Decompressor {
+ public:
+  FallbackDecompressor(
+      CompressionKind kind,
+      std::unique_ptr<Decompressor> decompressor,
+      uint64_t blockSize,
+      const CompressionOptions& options,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo},
+        kind_{kind},
+        options_{options},
+        decompressor_{std::move(decompressor)},
+        stats_{blockDecompressorStatsOf(kind)} {}
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return decompressor_->getDecompressedLength(src, srcLength);
+  }
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    try {
+      const auto size =
+          decompressor_->decompress(src, srcLength, dest, destLength);
+      ++stats_.numBlocks;
+      return size;
+    } catch (const std::exception& e) {
+      ++stats_.numFallbacks;
+      XLOG_EVERY_MS(WARNING, 60'000)
+          << "Falling back to software decompression of "
+          << compressionKindToString(kind_) << ": " << e.what();
+    }
+    if (fallback_ == nullptr) {
+      fallback_ = createSoftwareBlockDecompressor(
+          kind_, blockSize_, options_, streamDebugInfo_);
+    }
+    return fallback_->decompress(src, srcLength, dest, destLength);
+  }
+
+ private:
+  const CompressionKind kind_;
+  const CompressionOptions options_;
+  const std::unique_ptr<Decompressor> decompressor_;
+  AtomicBlockDecompressorStats& stats_;
+  std::unique_ptr<Decompressor> fallback_;
+};
+
+std::unique_ptr<Decompressor> createSoftwareBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind::CompressionKind_NONE:
+      return nullptr;
+    case CompressionKind::CompressionKind_ZLIB:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
+    case CompressionKind::CompressionKind_GZIP:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
+    case CompressionKind::CompressionKind_SNAPPY:
+      return std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind::CompressionKind_LZO:
+      return std::make_unique<LzoDecompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_LZ4:
+      return std::make_unique<Lz4Decompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_ZSTD:
+      return std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+    default:
+      DWIO_RAISE("Unknown compression codec ", kind);
+  }
+  return nullptr;
+}
+} // namespace
+
+void registerBlockDecompressorFactory(
+    CompressionKind kind,
+    BlockDecompressorFactory factory) {
+  VELOX_CHECK_LE(kind, CompressionKind::CompressionKind_GZIP);
+  auto factories = blockDecompressorFactories().wlock();
+  if (factory) {
+    factories->insert_or_assign(kind, std::move(factory));
+  } else {
+    factories->erase(kind);
+  }
+}
+
+BlockDecompressorStats blockDecompressorStats(CompressionKind kind) {
+  const auto& stats = blockDecompressorStatsOf(kind);
+  return {stats.numBlocks, stats.numFallbacks};
+}
+
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  if (kind != CompressionKind::CompressionKind_NONE) {
+    if (auto factory = blockDecompressorFactory(kind)) {
+      if (auto decompressor = factory(blockSize, options, streamDebugInfo)) {
+        return std::make_unique<FallbackDecompressor>(
+            kind, std::move(decompressor), blockSize, options, streamDebugInfo);
+      }
+    }
+  }
+  return createSoftwareBlockDecompressor(
+      kind, blockSize, options, streamDebugInfo);
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     CompressionKind kind,
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -649,18 +814,21 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const std::string& streamDebugInfo,
     const Decrypter* decrypter,
     bool useRawDecompression,
-    size_t compressedLength) {
-  std::unique_ptr<Decompressor> decompressor;
+    size_t compressedLength,
+    folly::Executor* readAheadExecutor,
+    int32_t readAheadBlocks) {
+  const bool readAhead = readAheadExecutor != nullptr && readAheadBlocks > 0 &&
+      !useRawDecompression && (!decrypter || decrypter->isThreadSafe());
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
         return input;
       }
-      // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
-        // When file is not encrypted, we can use zlib streaming codec to avoid
+      if (!decrypter && !blockDecompressorFactory(kind) && !readAhead) {
+        // When file is not encrypted, no block decompressor is registered and
+        // there is no read ahead, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input),
@@ -672,12 +840,11 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
             useRawDecompression,
             compressedLength);
       }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
       break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
-        // When file is not encrypted, we can use zlib streaming codec to avoid
+      if (!decrypter && !blockDecompressorFactory(kind) && !readAhead) {
+        // When file is not encrypted, no block decompressor is registered and
+        // there is no read ahead, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input),
@@ -689,33 +856,14 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
             useRawDecompression,
             compressedLength);
       }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
-      break;
-    case CompressionKind::CompressionKind_SNAPPY:
-      decompressor =
-          std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZO:
-      decompressor = std::make_unique<LzoDecompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZ4:
-      decompressor = std::make_unique<Lz4Decompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
       break;
     default:
-      DWIO_RAISE("Unknown compression codec ", kind);
+      break;
   }
-  return std::make_unique<PagedInputStream>(
+  // The decompressor remains nullptr for an encrypted uncompressed stream.
+  auto decompressor =
+      createBlockDecompressor(kind, blockSize, options, streamDebugInfo);
+  auto stream = std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
       std::move(decompressor),
@@ -723,6 +871,12 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       streamDebugInfo,
       useRawDecompression,
       compressedLength);
+  if (readAhead) {
+    stream->setReadAhead(readAheadExecutor, readAheadBlocks, [=]() {
+      return createBlockDecompressor(kind, blockSize, options, streamDebugInfo);
+    });
+  }
+  return stream;
 }
 
 } // namespace facebook::velox::dwio::common::compression
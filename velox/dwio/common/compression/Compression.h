@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/encryption/Encryption.h"
@@ -98,6 +100,11 @@ struct CompressionOptions {
  * @param options The compression options to use
  * @param useRawDecompression Specify whether to perform raw decompression
  * @param compressedLength The compressed block length for raw decompression
+ * @param readAheadExecutor The executor to decompress the blocks after the
+ * current one on, if 'readAheadBlocks' > 0
+ * @param readAheadBlocks The number of blocks to decompress ahead. Ignored for
+ * raw decompression and for encrypted streams whose decrypter is not thread
+ * safe
  */
 std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -108,7 +115,55 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const std::string& streamDebugInfo,
     const dwio::common::encryption::Decrypter* decryptr = nullptr,
     bool useRawDecompression = false,
-    size_t compressedLength = 0);
+    size_t compressedLength = 0,
+    folly::Executor* readAheadExecutor = nullptr,
+    int32_t readAheadBlocks = 0);
+
+/**
+ * Create a decompressor of whole blocks for the given compression kind.
+ * Returns nullptr for CompressionKind_NONE.
+ * @param kind The compression type to implement
+ * @param blockSize The maximum size of a decompressed block
+ * @param options The compression options to use
+ */
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    facebook::velox::common::CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo);
+
+/// Makes a block decompressor to use instead of the built-in software one of a
+/// compression kind, e.g. one which offloads to a hardware accelerator.
+/// Returns nullptr if it can not decompress with 'options' on this host, e.g.
+/// if no device is available. The built-in decompressor is used then.
+using BlockDecompressorFactory = std::function<std::unique_ptr<Decompressor>(
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo)>;
+
+/// Registers 'factory' for the decompressors of 'kind' made by
+/// createBlockDecompressor() and createDecompressor(). A block the
+/// registered decompressor fails on is decompressed by the built-in
+/// decompressor instead. Replaces the factory registered for 'kind' before. An
+/// empty 'factory' unregisters it.
+void registerBlockDecompressorFactory(
+    facebook::velox::common::CompressionKind kind,
+    BlockDecompressorFactory factory);
+
+/// Counts the blocks decompressed by the decompressors of the factory
+/// registered for a compression kind.
+struct BlockDecompressorStats {
+  /// Number of blocks decompressed by the registered decompressors.
+  uint64_t numBlocks{0};
+  /// Number of blocks the registered decompressors failed on and which were
+  /// decompressed by the built-in decompressor.
+  uint64_t numFallbacks{0};
+};
+
+/// Returns the stats of the decompressors registered for 'kind' since the
+/// process started.
+BlockDecompressorStats blockDecompressorStats(
+    facebook::velox::common::CompressionKind kind);
 
 /**
  * Create a compressor for the given compression kind.
@@ -18,6 +18,30 @@
 
 namespace facebook::velox::dwio::common::compression {
 
+PagedInputStream::~PagedInputStream() {
+  clearReadAhead();
+}
+
+void PagedInputStream::setReadAhead(
+    folly::Executor* executor,
+    int32_t numBlocks,
+    std::function<std::unique_ptr<Decompressor>()> makeDecompressor) {
+  VELOX_CHECK_NOT_NULL(executor);
+  VELOX_CHECK_GT(numBlocks, 0);
+  VELOX_CHECK_NOT_NULL(makeDecompressor);
+  VELOX_CHECK(
+      !decrypter_ || decrypter_->isThreadSafe(),
+      "Read ahead of {} needs a thread safe decrypter",
+      getName());
+  VELOX_CHECK(
+      state_ == State::HEADER && bytesReturned_ == 0,
+      "Read ahead must be set before reading {}",
+      getName());
+  readAheadExecutor_ = executor;
+  readAheadBlocks_ = numBlocks;
+  makeReadAheadDecompressor_ = std::move(makeDecompressor);
+}
+
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
   if (!outputBuffer_ || uncompressedLength > outputBuffer_->capacity()) {
     outputBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
@@ -132,7 +156,11 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   decryptionBuffer_ = nullptr;
 
   if (state_ == State::HEADER || remainingLength_ == 0) {
-    readHeader();
+    if (readAheadBlocks_ == 0) {
+      readHeader();
+    } else if (nextReadAheadBlock(data, size)) {
+      return true;
+    }
   }
   if (state_ == State::END) {
     return false;
@@ -212,6 +240,225 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+void PagedInputStream::fillReadAhead() {
+  if (decrypter_ && !readAhead_.empty() &&
+      2 * readAhead_.size() > static_cast<size_t>(readAheadBlocks_) + 1) {
+    return;
+  }
+  // readHeader() sets the state of the current block.
+  const auto state = state_;
+  const auto remainingLength = remainingLength_;
+  const auto lastHeaderOffset = lastHeaderOffset_;
+  const auto bytesReturnedAtLastHeaderOffset = bytesReturnedAtLastHeaderOffset_;
+  // The blocks to decrypt if the stream is encrypted.
+  std::vector<ReadAheadBlock*> encryptedBlocks;
+  while (readAhead_.size() <= static_cast<size_t>(readAheadBlocks_) &&
+         (readAhead_.empty() || readAhead_.back()->state == State::START ||
+          (decrypter_ && readAhead_.back()->state == State::ORIGINAL))) {
+    readHeader();
+    auto block = std::make_unique<ReadAheadBlock>();
+    block->headerOffset = lastHeaderOffset_;
+    block->state = state_;
+    block->length = remainingLength_;
+    if (state_ == State::END || (state_ == State::ORIGINAL && !decrypter_)) {
+      readAhead_.push_back(std::move(block));
+      break;
+    }
+    // The ranges returned by 'input_' are not kept, so the block is copied.
+    const auto compressedLength = remainingLength_;
+    block->compressed = getBuffer(compressedLength);
+    for (size_t pos = 0; pos < compressedLength;) {
+      if (inputBufferPtr_ == inputBufferPtrEnd_) {
+        readBuffer(true);
+      }
+      const auto length = std::min(
+          static_cast<size_t>(inputBufferPtrEnd_ - inputBufferPtr_),
+          compressedLength - pos);
+      std::copy(
+          inputBufferPtr_,
+          inputBufferPtr_ + length,
+          block->compressed->data() + pos);
+      pos += length;
+      inputBufferPtr_ += length;
+    }
+    if (decrypter_) {
+      encryptedBlocks.push_back(block.get());
+      readAhead_.push_back(std::move(block));
+      continue;
+    }
+    if (freeDecompressors_.empty()) {
+      block->decompressor = makeReadAheadDecompressor_();
+    } else {
+      block->decompressor = std::move(freeDecompressors_.back());
+      freeDecompressors_.pop_back();
+    }
+    const auto [decompressedLength, exact] =
+        block->decompressor->getDecompressedLength(
+            block->compressed->data(), compressedLength);
+    block->output = getBuffer(decompressedLength);
+    auto* blockPtr = block.get();
+    block->decompressed =
+        std::make_shared<AsyncSource<bool>>([blockPtr, compressedLength]() {
+          blockPtr->outputLength = blockPtr->decompressor->decompress(
+              blockPtr->compressed->data(),
+              compressedLength,
+              blockPtr->output->data(),
+              blockPtr->output->capacity());
+          return std::make_unique<bool>(true);
+        });
+    readAheadExecutor_->add(
+        [source = block->decompressed]() { source->prepare(); });
+    readAhead_.push_back(std::move(block));
+  }
+  if (!encryptedBlocks.empty()) {
+    startDecryption(std::move(encryptedBlocks));
+  }
+  state_ = state;
+  remainingLength_ = remainingLength;
+  lastHeaderOffset_ = lastHeaderOffset;
+  bytesReturnedAtLastHeaderOffset_ = bytesReturnedAtLastHeaderOffset;
+}
+
+void PagedInputStream::startDecryption(std::vector<ReadAheadBlock*> blocks) {
+  for (auto* block : blocks) {
+    if (block->state != State::START) {
+      continue;
+    }
+    if (freeDecompressors_.empty()) {
+      block->decompressor = makeReadAheadDecompressor_();
+    } else {
+      block->decompressor = std::move(freeDecompressors_.back());
+      freeDecompressors_.pop_back();
+    }
+  }
+  // The decrypted length is known only after decryption, so the output
+  // buffers are allocated by the task.
+  auto source = std::make_shared<AsyncSource<bool>>([this, blocks]() {
+    std::vector<folly::StringPiece> inputs;
+    inputs.reserve(blocks.size());
+    for (const auto* block : blocks) {
+      inputs.emplace_back(block->compressed->data(), block->length);
+    }
+    auto decrypted = decrypter_->decryptBatch(inputs);
+    DWIO_ENSURE_EQ(decrypted.size(), blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      auto* block = blocks[i];
+      block->decrypted = std::move(decrypted[i]);
+      if (block->state != State::START) {
+        continue;
+      }
+      DWIO_ENSURE_NOT_NULL(block->decompressor.get(), "invalid stream state");
+      const auto* input =
+          reinterpret_cast<const char*>(block->decrypted->data());
+      const auto inputLength = block->decrypted->length();
+      const auto [decompressedLength, exact] =
+          block->decompressor->getDecompressedLength(input, inputLength);
+      block->output = std::make_unique<dwio::common::DataBuffer<char>>(
+          pool_, decompressedLength);
+      block->outputLength = block->decompressor->decompress(
+          input,
+          inputLength,
+          block->output->data(),
+          block->output->capacity());
+      block->decrypted = nullptr;
+    }
+    return std::make_unique<bool>(true);
+  });
+  for (auto* block : blocks) {
+    block->decompressed = source;
+  }
+  readAheadExecutor_->add([source]() { source->prepare(); });
+}
+
+bool PagedInputStream::nextReadAheadBlock(const void** data, int32_t* size) {
+  fillReadAhead();
+  auto& block = readAhead_.front();
+  lastHeaderOffset_ = block->headerOffset;
+  bytesReturnedAtLastHeaderOffset_ = bytesReturned_;
+  state_ = block->state;
+  if (block->state == State::END) {
+    // The block stays first so that further reads are also at the end.
+    remainingLength_ = 0;
+    return false;
+  }
+  if (block->state == State::ORIGINAL && !decrypter_) {
+    remainingLength_ = block->length;
+    readAhead_.pop_front();
+    return false;
+  }
+
+  // Rethrows the errors of the decryption and decompression. Returns nullptr
+  // if another block of the same batch was already waited for.
+  block->decompressed->move();
+  returnBuffer(std::move(block->compressed));
+  if (block->decompressor) {
+    freeDecompressors_.push_back(std::move(block->decompressor));
+  }
+  const char* output;
+  size_t length;
+  if (block->state == State::ORIGINAL) {
+    // An uncompressed block of an encrypted stream.
+    decryptionBuffer_ = std::move(block->decrypted);
+    output = reinterpret_cast<const char*>(decryptionBuffer_->data());
+    length = decryptionBuffer_->length();
+  } else {
+    returnBuffer(std::move(outputBuffer_));
+    outputBuffer_ = std::move(block->output);
+    output = outputBuffer_->data();
+    length = block->outputLength;
+  }
+  readAhead_.pop_front();
+  // Keeps 'readAheadBlocks_' blocks in flight while this one is decoded.
+  fillReadAhead();
+
+  if (data) {
+    *data = output;
+  }
+  *size = static_cast<int32_t>(length);
+  outputBufferPtr_ = output + length;
+  outputBufferLength_ = 0;
+  remainingLength_ = 0;
+  state_ = State::HEADER;
+  bytesReturned_ += *size;
+  lastWindowSize_ = *size;
+  return true;
+}
+
+void PagedInputStream::clearReadAhead() {
+  for (auto& block : readAhead_) {
+    if (block->decompressed) {
+      block->decompressed->close();
+    }
+    returnBuffer(std::move(block->compressed));
+    returnBuffer(std::move(block->output));
+    if (block->decompressor) {
+      freeDecompressors_.push_back(std::move(block->decompressor));
+    }
+  }
+  readAhead_.clear();
+}
+
+std::unique_ptr<dwio::common::DataBuffer<char>> PagedInputStream::getBuffer(
+    uint64_t size) {
+  for (auto i = 0; i < freeBuffers_.size(); ++i) {
+    if (freeBuffers_[i]->capacity() >= size) {
+      auto buffer = std::move(freeBuffers_[i]);
+      freeBuffers_.erase(freeBuffers_.begin() + i);
+      return buffer;
+    }
+  }
+  return std::make_unique<dwio::common::DataBuffer<char>>(pool_, size);
+}
+
+void PagedInputStream::returnBuffer(
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer) {
+  // A compressed and a decompressed buffer per block in flight.
+  if (buffer != nullptr &&
+      freeBuffers_.size() <= 2 * static_cast<size_t>(readAheadBlocks_)) {
+    freeBuffers_.push_back(std::move(buffer));
+  }
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -297,6 +544,7 @@ void PagedInputStream::seekToPosition(
   };
 
   if (compressedOffset != lastHeaderOffset_ || outsideOriginalWindow()) {
+    clearReadAhead();
     std::vector<uint64_t> positions = {compressedOffset};
     auto provider = dwio::common::PositionProvider(positions);
     input_->seekToPosition(provider);
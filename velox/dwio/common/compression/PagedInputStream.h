@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <deque>
+
+#include <folly/Executor.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
@@ -50,6 +55,21 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     }
   }
 
+  ~PagedInputStream() override;
+
+  /// Decompresses up to 'numBlocks' compression blocks after the one returned
+  /// by Next() on 'executor', so that they are ready when the reader gets to
+  /// them. Each block in flight has its own decompressor made by
+  /// 'makeDecompressor', which may return nullptr for an encrypted stream
+  /// without compression. The blocks of an encrypted stream are decrypted in
+  /// batches with Decrypter::decryptBatch() on 'executor' before their
+  /// decompression, so the decrypter must be thread safe. Must be called
+  /// before the first Next().
+  void setReadAhead(
+      folly::Executor* executor,
+      int32_t numBlocks,
+      std::function<std::unique_ptr<Decompressor>()> makeDecompressor);
+
   bool Next(const void** data, int32_t* size) override;
   void BackUp(int32_t count) override;
 
@@ -178,10 +198,64 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   int64_t pendingSkip_{0};
 
  private:
+  // A compression block after the current one.
+  struct ReadAheadBlock {
+    // Offset in 'input_' of the header of the block.
+    uint64_t headerOffset{0};
+    // START for a compressed block. ORIGINAL for an uncompressed block, which
+    // is read from 'input_' when it becomes current unless the stream is
+    // encrypted. END after the last block.
+    State state{State::END};
+    // Length of the block in 'input_'.
+    size_t length{0};
+    std::unique_ptr<dwio::common::DataBuffer<char>> compressed;
+    std::unique_ptr<dwio::common::DataBuffer<char>> output;
+    size_t outputLength{0};
+    // The decrypted uncompressed block of an encrypted stream.
+    std::unique_ptr<folly::IOBuf> decrypted;
+    std::unique_ptr<Decompressor> decompressor;
+    // Decompresses 'compressed' into 'output' on 'readAheadExecutor_' or on
+    // the reader thread if not started when the block becomes current. Shared
+    // by the blocks of an encrypted stream which are decrypted together.
+    std::shared_ptr<AsyncSource<bool>> decompressed;
+  };
+
   bool skipAllPending();
 
+  // Reads the blocks after the current one from 'input_' and starts their
+  // decompression until 'readAheadBlocks_' blocks are read ahead or an
+  // uncompressed block or the end of 'input_' is reached. The blocks of an
+  // encrypted stream are read when half of them are consumed so that they are
+  // decrypted in batches.
+  void fillReadAhead();
+
+  // Decrypts and decompresses 'blocks' of an encrypted stream in one task.
+  void startDecryption(std::vector<ReadAheadBlock*> blocks);
+
+  // Makes the first block of 'readAhead_' the current one. Returns true and
+  // sets 'data' and 'size' to it if it is compressed. Otherwise leaves
+  // reading it to readOrSkip() and returns false.
+  bool nextReadAheadBlock(const void** data, int32_t* size);
+
+  // Waits for the decompressions in flight and drops the blocks read ahead.
+  void clearReadAhead();
+
+  std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(uint64_t size);
+
+  void returnBuffer(std::unique_ptr<dwio::common::DataBuffer<char>> buffer);
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
+
+  folly::Executor* readAheadExecutor_{nullptr};
+  int32_t readAheadBlocks_{0};
+  std::function<std::unique_ptr<Decompressor>()> makeReadAheadDecompressor_;
+  std::deque<std::unique_ptr<ReadAheadBlock>> readAhead_;
+
+  // Buffers and decompressors of consumed blocks, reused for the blocks read
+  // ahead next.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>> freeBuffers_;
+  std::vector<std::unique_ptr<Decompressor>> freeDecompressors_;
 };
 
 } // namespace facebook::velox::dwio::common::compression
@@ -27,6 +27,16 @@ bool operator==(const EncryptionProperties& a, const EncryptionProperties& b) {
       (typeid(a) == typeid(b) && a.equals(b));
 }
 
+std::vector<std::unique_ptr<folly::IOBuf>> Decrypter::decryptBatch(
+    const std::vector<folly::StringPiece>& inputs) const {
+  std::vector<std::unique_ptr<folly::IOBuf>> outputs;
+  outputs.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    outputs.push_back(decrypt(input));
+  }
+  return outputs;
+}
+
 } // namespace encryption
 } // namespace common
 } // namespace dwio
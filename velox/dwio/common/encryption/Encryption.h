@@ -89,6 +89,19 @@ class Decrypter {
   virtual std::unique_ptr<folly::IOBuf> decrypt(
       folly::StringPiece input) const = 0;
 
+  /// Decrypts 'inputs' in one call, e.g. the blocks of a stream read ahead.
+  /// Providers can decrypt the inputs in parallel, e.g. with AES in counter
+  /// mode on wide vector units. The default decrypts them one at a time.
+  virtual std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+      const std::vector<folly::StringPiece>& inputs) const;
+
+  /// Returns true if decrypt() and decryptBatch() may be called on a read
+  /// ahead executor thread, concurrently with each other. Encrypted streams
+  /// are read ahead only if this returns true.
+  virtual bool isThreadSafe() const {
+    return false;
+  }
+
   virtual std::unique_ptr<Decrypter> clone() const = 0;
 };
 
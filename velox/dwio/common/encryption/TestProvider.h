@@ -58,7 +58,7 @@ class TestEncryption {
 
  private:
   std::string key_;
-  mutable std::atomic<size_t> count_;
+  mutable std::atomic<size_t> count_{0};
 };
 
 class TestEncrypter : public TestEncryption, public Encrypter {
@@ -94,6 +94,10 @@ class TestDecrypter : public TestEncryption, public Decrypter {
     return TestEncryption::decrypt(input);
   }
 
+  bool isThreadSafe() const override {
+    return true;
+  }
+
   std::unique_ptr<Decrypter> clone() const override {
     auto decrypter = std::make_unique<TestDecrypter>();
     decrypter->setKey(getKey());
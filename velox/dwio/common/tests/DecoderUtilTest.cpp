@@ -17,6 +17,7 @@
 #include "velox/dwio/common/DecoderUtil.h"
 #include <folly/Random.h>
 #include "velox/common/base/Nulls.h"
+#include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/type/Filter.h"
 
 #include <gtest/gtest.h>
@@ -233,3 +234,51 @@ TEST_F(DecoderUtilTest, processFixedWithRun) {
     }
   }
 }
+
+namespace {
+template <typename T>
+void testFillDictionaryFilterCache(
+    const common::Filter& filter,
+    const std::vector<T>& values) {
+  std::vector<uint8_t> cache(values.size(), FilterResult::kUnknown);
+  fillDictionaryFilterCache(filter, values.data(), values.size(), cache.data());
+  for (auto i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(
+        common::applyFilter(filter, values[i]) ? FilterResult::kSuccess
+                                               : FilterResult::kFailure,
+        cache[i])
+        << i;
+  }
+}
+} // namespace
+
+TEST_F(DecoderUtilTest, fillDictionaryFilterCache) {
+  common::BigintRange range(-100, 1'000, false);
+  // Sizes that are not a multiple of the SIMD width test the scalar tail.
+  std::vector<int64_t> longs;
+  std::vector<int32_t> ints;
+  std::vector<int16_t> shorts;
+  for (auto i = 0; i < 1'003; ++i) {
+    const int64_t value =
+        static_cast<int64_t>(folly::Random::rand32(rng_) % 4'000) - 2'000;
+    longs.push_back(value);
+    ints.push_back(value);
+    shorts.push_back(value);
+  }
+  testFillDictionaryFilterCache(range, longs);
+  testFillDictionaryFilterCache(range, ints);
+  testFillDictionaryFilterCache(range, shorts);
+
+  common::BytesValues in({"apple", "banana"}, false);
+  std::vector<std::string> strings = {"apple", "cherry", "banana", "", "app"};
+  std::vector<StringView> views;
+  for (const auto& string : strings) {
+    views.emplace_back(string);
+  }
+  testFillDictionaryFilterCache(in, views);
+
+  EXPECT_FALSE(shouldFillDictionaryFilterCache(nullptr, 10, 1'000));
+  EXPECT_TRUE(shouldFillDictionaryFilterCache(&range, 10, 1'000));
+  EXPECT_FALSE(shouldFillDictionaryFilterCache(&range, 1'000, 1'000));
+  EXPECT_FALSE(shouldFillDictionaryFilterCache(&range, 0, 1'000));
+}
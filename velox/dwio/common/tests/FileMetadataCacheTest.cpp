@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(100);
+  EXPECT_EQ(cache.get<std::string>("a"), nullptr);
+  cache.put("a", std::make_shared<std::string>("metadata a"), 40);
+  cache.put("b", std::make_shared<std::string>("metadata b"), 40);
+  EXPECT_EQ(*cache.get<std::string>("a"), "metadata a");
+
+  // 'b' is the least recently used.
+  cache.put("c", std::make_shared<std::string>("metadata c"), 40);
+  EXPECT_EQ(cache.get<std::string>("b"), nullptr);
+  EXPECT_EQ(*cache.get<std::string>("a"), "metadata a");
+  EXPECT_EQ(*cache.get<std::string>("c"), "metadata c");
+
+  // Values larger than the capacity are not cached.
+  cache.put("d", std::make_shared<std::string>("metadata d"), 200);
+  EXPECT_EQ(cache.get<std::string>("d"), nullptr);
+
+  // Replaces the value for an existing key.
+  cache.put("a", std::make_shared<std::string>("new metadata a"), 10);
+  EXPECT_EQ(*cache.get<std::string>("a"), "new metadata a");
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 2);
+  EXPECT_EQ(stats.numBytes, 50);
+  EXPECT_EQ(stats.numEvictions, 1);
+  EXPECT_EQ(stats.numLookups, 7);
+  EXPECT_EQ(stats.numHits, 4);
+
+  // A value stays valid for its users after eviction.
+  auto value = cache.get<std::string>("c");
+  cache.clear();
+  EXPECT_EQ(cache.get<std::string>("c"), nullptr);
+  EXPECT_EQ(*value, "metadata c");
+  EXPECT_EQ(cache.stats().numBytes, 0);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoCostModel.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::io;
+
+TEST(IoCostModelTest, forPath) {
+  EXPECT_EQ(
+      IoCostModel::forPath("s3://bucket/a"),
+      IoCostModel::forPath("s3://other/b"));
+  EXPECT_EQ(IoCostModel::forPath("/tmp/a"), IoCostModel::forPath("/tmp/b"));
+  EXPECT_NE(IoCostModel::forPath("s3://bucket/a"), IoCostModel::forPath("/a"));
+}
+
+TEST(IoCostModelTest, coalesceDistance) {
+  constexpr int32_t kDefault = 512 << 10;
+  IoCostModel model;
+  EXPECT_EQ(model.coalesceDistance(kDefault), kDefault);
+
+  // 10ms latency and 100 bytes per us, i.e. 100MB/s. The break-even gap is 1MB.
+  const auto recordReads = [&](int32_t count) {
+    for (auto i = 0; i < count; ++i) {
+      const uint64_t bytes = (1 + i % 8) << 20;
+      model.recordRead(bytes, 10'000 + bytes / 100);
+    }
+  };
+  recordReads(8);
+  EXPECT_EQ(model.coalesceDistance(kDefault), kDefault);
+  recordReads(100);
+  const auto [latencyUs, bytesPerUs] = model.estimate();
+  EXPECT_NEAR(latencyUs, 10'000, 1);
+  EXPECT_NEAR(bytesPerUs, 100, 0.01);
+  EXPECT_NEAR(model.coalesceDistance(kDefault), 1'000'000, 1'000);
+
+  // Reads of the same size don't tell latency from transfer time.
+  IoCostModel sameSize;
+  for (auto i = 0; i < 100; ++i) {
+    sameSize.recordRead(1 << 20, 20'000);
+  }
+  EXPECT_EQ(sameSize.coalesceDistance(kDefault), kDefault);
+
+  // No measurable latency gives the min distance.
+  IoCostModel noLatency;
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (1 + i % 8) << 20;
+    noLatency.recordRead(bytes, bytes / 1'000);
+  }
+  EXPECT_EQ(
+      noLatency.coalesceDistance(kDefault), IoCostModel::kMinCoalesceDistance);
+}
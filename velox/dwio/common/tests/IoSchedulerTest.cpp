@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/IoScheduler.h"
+
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(IoSchedulerTest, fairQueuing) {
+  folly::ManualExecutor executor;
+  auto scheduler = std::make_shared<IoScheduler>(&executor, 2, 1);
+  std::vector<std::string> started;
+  auto task = [&](const std::string& name) {
+    return [&started, name]() { started.push_back(name); };
+  };
+  auto query1 = scheduler->executorFor("q1", IoScheduler::Priority::kPrefetch);
+  query1->add(task("q1.1"));
+  query1->add(task("q1.2"));
+  query1->add(task("q1.3"));
+  scheduler->add("q2", IoScheduler::Priority::kPrefetch, task("q2.1"));
+  scheduler->add("q3", IoScheduler::Priority::kDemand, task("q3.1"));
+  // q1.1 and q2.1 are running, the others wait for the concurrency limits.
+  EXPECT_EQ(scheduler->numQueued(), 3);
+
+  executor.drain();
+  // The demand load starts before the prefetches. The loads of q1 run one at
+  // a time.
+  EXPECT_EQ(
+      started,
+      std::vector<std::string>({"q1.1", "q2.1", "q3.1", "q1.2", "q1.3"}));
+  EXPECT_EQ(scheduler->numQueued(), 0);
+  const auto stats = scheduler->stats();
+  EXPECT_EQ(stats.numStarted[0], 1);
+  EXPECT_EQ(stats.numStarted[1], 4);
+  EXPECT_GE(stats.queueWaitUs[1], stats.maxQueueWaitUs[1]);
+}
+
+TEST(IoSchedulerTest, taskError) {
+  folly::ManualExecutor executor;
+  auto scheduler = std::make_shared<IoScheduler>(&executor, 1, 1);
+  int32_t numRun{0};
+  scheduler->add("q1", IoScheduler::Priority::kPrefetch, []() {
+    throw std::runtime_error("load failed");
+  });
+  scheduler->add("q1", IoScheduler::Priority::kPrefetch, [&]() { ++numRun; });
+  executor.drain();
+  // A failed load does not block the next.
+  EXPECT_EQ(numRun, 1);
+  EXPECT_EQ(scheduler->numQueued(), 0);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::ParallelUnitLoaderFactory;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+TEST(ParallelUnitLoaderTests, loadsAhead) {
+  // The inline executor loads the units of the window synchronously.
+  ParallelUnitLoaderFactory factory(
+      &folly::InlineExecutor::instance(), 2, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  readerMock.seek(5);
+  EXPECT_TRUE(readerMock.read(5)); // Unit: 0, rows: 5-9, unload(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+}
+
+TEST(ParallelUnitLoaderTests, bytesAhead) {
+  // Up to 4 units at a time, but the units after the current one must fit in
+  // 25 bytes.
+  ParallelUnitLoaderFactory factory(
+      &folly::InlineExecutor::instance(), 4, nullptr, 25);
+  ReaderMock readerMock{{10, 10, 10, 10, 10}, {10, 10, 10, 30, 10}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, load(0), load(1), load(2)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, unload(0)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, true, true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 2, unload(1)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, false, true, false, false}));
+
+  // The current unit is loaded even if it is larger than the budget.
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 3, unload(2), load(3), load(4)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, false, false, true, true}));
+}
+
+TEST(ParallelUnitLoaderTests, readsAllUnits) {
+  folly::CPUThreadPoolExecutor executor(4);
+  std::atomic<int32_t> blockedOnIoCount{0};
+  ParallelUnitLoaderFactory factory(
+      &executor, 3, [&](auto) { ++blockedOnIoCount; });
+  const std::vector<uint64_t> rowsPerUnit(20, 100);
+  ReaderMock readerMock{
+      rowsPerUnit, std::vector<uint64_t>(rowsPerUnit.size()), factory, 0};
+  uint64_t numReads = 0;
+  while (readerMock.read(30)) {
+    ++numReads;
+  }
+  // Each unit is read in 4 reads of up to 30 rows.
+  EXPECT_EQ(numReads, 4 * rowsPerUnit.size());
+  EXPECT_LE(blockedOnIoCount, rowsPerUnit.size());
+  auto expected = std::vector<bool>(rowsPerUnit.size());
+  expected.back() = true;
+  EXPECT_EQ(readerMock.unitsLoaded(), expected);
+}
+
+namespace {
+class FailingLoadUnit : public LoadUnit {
+ public:
+  void load() override {
+    if (numLoads_++ == 0) {
+      VELOX_FAIL("Load failed");
+    }
+  }
+
+  void unload() override {}
+
+  uint64_t getNumRows() override {
+    return 10;
+  }
+
+  uint64_t getIoSize() override {
+    return 0;
+  }
+
+ private:
+  int32_t numLoads_{0};
+};
+} // namespace
+
+TEST(ParallelUnitLoaderTests, loadError) {
+  folly::CPUThreadPoolExecutor executor(2);
+  ParallelUnitLoaderFactory factory(&executor, 2, nullptr);
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<FailingLoadUnit>());
+  units.push_back(std::make_unique<FailingLoadUnit>());
+  auto loader = factory.create(std::move(units), 0);
+  VELOX_ASSERT_THROW(loader->getLoadedUnit(0), "Load failed");
+  // The failed load is retried.
+  EXPECT_EQ(loader->getLoadedUnit(0).getNumRows(), 10);
+  VELOX_ASSERT_THROW(loader->getLoadedUnit(1), "Load failed");
+  EXPECT_EQ(loader->getLoadedUnit(1).getNumRows(), 10);
+}
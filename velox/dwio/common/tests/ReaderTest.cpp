@@ -136,5 +136,48 @@ TEST_F(ReaderTest, projectColumnsMutation) {
   test::assertEqualVectors(expected, actual);
 }
 
+TEST_F(ReaderTest, estimateFilterSelectivity) {
+  // 80 non-null values between 0 and 99 in 100 rows.
+  IntegerColumnStatistics intStats(80, true, {}, {}, 0, 99, {});
+  auto estimate = [&](const Filter& filter) {
+    return estimateFilterSelectivity(&filter, &intStats, 100, BIGINT());
+  };
+  EXPECT_DOUBLE_EQ(estimate(BigintRange(0, 9, false)).value(), 0.08);
+  EXPECT_DOUBLE_EQ(estimate(BigintRange(90, 200, true)).value(), 0.28);
+  EXPECT_DOUBLE_EQ(estimate(BigintRange(100, 200, false)).value(), 0);
+  EXPECT_DOUBLE_EQ(estimate(IsNull()).value(), 0.2);
+  EXPECT_DOUBLE_EQ(estimate(IsNotNull()).value(), 0.8);
+  EXPECT_FALSE(estimate(*createBigintValues({1, 5, 7}, false)).has_value());
+
+  DoubleColumnStatistics doubleStats(100, false, {}, {}, 0, 10, {});
+  DoubleRange greaterThan5(5, false, false, 0, true, false, false);
+  EXPECT_DOUBLE_EQ(
+      estimateFilterSelectivity(&greaterThan5, &doubleStats, 100, DOUBLE())
+          .value(),
+      0.5);
+}
+
+TEST_F(ReaderTest, selectivityEstimateOrder) {
+  ScanSpec spec("<root>");
+  spec.addField("a", 0)->setFilter(std::make_unique<BigintRange>(0, 10, false));
+  spec.addField("b", 1)->setFilter(std::make_unique<BigintRange>(0, 10, false));
+  spec.childByName("a")->setSelectivityEstimate(0.9);
+  spec.childByName("b")->setSelectivityEstimate(0.1);
+  spec.newRead();
+  EXPECT_EQ(spec.children()[0]->fieldName(), "b");
+
+  // With measurements, the estimate replaces the measured fraction of dropped
+  // rows. A filter estimated to drop no rows goes last.
+  for (auto* name : {"a", "b"}) {
+    SelectivityTimer timer(spec.childByName(name)->selectivity(), 100);
+  }
+  spec.childByName("a")->selectivity().addOutput(50);
+  spec.childByName("a")->setSelectivityEstimate(std::nullopt);
+  spec.childByName("b")->selectivity().addOutput(10);
+  spec.childByName("b")->setSelectivityEstimate(1);
+  spec.newRead();
+  EXPECT_EQ(spec.children()[0]->fieldName(), "a");
+}
+
 } // namespace
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileSink.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+// Appends to a string and fails the append at 'failAt' bytes if set.
+class TestWriteFile : public WriteFile {
+ public:
+  TestWriteFile(std::string* data, std::optional<uint64_t> failAt)
+      : data_(data), failAt_(failAt) {}
+
+  void append(std::string_view data) override {
+    if (failAt_.has_value() && data_->size() + data.size() > failAt_.value()) {
+      VELOX_FAIL("Injected append error");
+    }
+    data_->append(data);
+  }
+
+  void flush() override {}
+
+  void close() override {}
+
+  uint64_t size() const override {
+    return data_->size();
+  }
+
+ private:
+  std::string* const data_;
+  const std::optional<uint64_t> failAt_;
+};
+
+class WriteFileSinkTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  DataBuffer<char> makeBuffer(char value, size_t size) {
+    DataBuffer<char> buffer(*pool_, size);
+    std::memset(buffer.data(), value, size);
+    return buffer;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  folly::CPUThreadPoolExecutor executor_{2};
+};
+
+TEST_F(WriteFileSinkTest, writeBehind) {
+  std::string data;
+  WriteFileSink sink(
+      std::make_unique<TestWriteFile>(&data, std::nullopt),
+      "test",
+      MetricsLog::voidLog(),
+      nullptr,
+      &executor_,
+      1'000);
+  ASSERT_FALSE(sink.isBuffered());
+  std::string expected;
+  for (auto i = 0; i < 100; ++i) {
+    sink.write(makeBuffer('a' + i % 26, 100 + i));
+    expected.append(100 + i, 'a' + i % 26);
+  }
+  ASSERT_EQ(sink.size(), expected.size());
+  sink.close();
+  ASSERT_EQ(data, expected);
+}
+
+TEST_F(WriteFileSinkTest, writeBehindError) {
+  std::string data;
+  WriteFileSink sink(
+      std::make_unique<TestWriteFile>(&data, 1'000),
+      "test",
+      MetricsLog::voidLog(),
+      nullptr,
+      &executor_,
+      100'000);
+  // The error is thrown by the first write or close after the failed append.
+  const auto writeAndClose = [&]() {
+    for (auto i = 0; i < 20; ++i) {
+      sink.write(makeBuffer('a', 100));
+    }
+    sink.close();
+  };
+  VELOX_ASSERT_THROW(writeAndClose(), "Injected append error");
+  ASSERT_EQ(data.size(), 1'000);
+}
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "velox/dwio/common/exception/Exception.h"
+
+namespace facebook::velox::dwrf {
+namespace {
+// Constants of the Hive Murmur3 hash64.
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+constexpr int32_t kMurmurR1 = 31;
+constexpr int32_t kMurmurR2 = 27;
+constexpr uint64_t kMurmurM = 5;
+constexpr uint64_t kMurmurN1 = 0x52dce729;
+constexpr uint64_t kMurmurSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+inline uint64_t mixBlock(uint64_t k) {
+  k *= kMurmurC1;
+  k = rotateLeft(k, kMurmurR1);
+  return k * kMurmurC2;
+}
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expectedEntries, double fpp) {
+  DWIO_ENSURE_GT(expectedEntries, 0);
+  DWIO_ENSURE(fpp > 0.0 && fpp < 1.0, "Invalid Bloom filter fpp ", fpp);
+  const auto ln2 = std::log(2.0);
+  const auto optimalBits = static_cast<int64_t>(
+      -static_cast<double>(expectedEntries) * std::log(fpp) / (ln2 * ln2));
+  // Same rounding as the Java writer, which always adds a word.
+  const auto numBits = optimalBits + (64 - optimalBits % 64);
+  numHashFunctions_ = std::max<int32_t>(
+      1, std::lround(static_cast<double>(numBits) / expectedEntries * ln2));
+  bits_.resize(numBits / 64);
+}
+
+BloomFilter::BloomFilter(const proto::BloomFilter& filter)
+    : numHashFunctions_{filter.numhashfunctions()} {
+  DWIO_ENSURE_GT(numHashFunctions_, 0);
+  if (filter.bitset_size() > 0) {
+    bits_.assign(filter.bitset().begin(), filter.bitset().end());
+  } else {
+    const auto& bytes = filter.utf8bitset();
+    DWIO_ENSURE_EQ(bytes.size() % sizeof(uint64_t), 0);
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    ::memcpy(bits_.data(), bytes.data(), bytes.size());
+  }
+  DWIO_ENSURE(!bits_.empty(), "Empty Bloom filter");
+}
+
+void BloomFilter::reset() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void BloomFilter::serialize(proto::BloomFilter& filter) const {
+  filter.set_numhashfunctions(numHashFunctions_);
+  filter.mutable_bitset()->Reserve(bits_.size());
+  for (auto word : bits_) {
+    filter.add_bitset(word);
+  }
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  // Thomas Wang's integer hash. The right shifts are arithmetic as in Java.
+  uint64_t key = value;
+  key = ~key + (key << 21);
+  key ^= static_cast<int64_t>(key) >> 24;
+  key = key + (key << 3) + (key << 8);
+  key ^= static_cast<int64_t>(key) >> 14;
+  key = key + (key << 2) + (key << 4);
+  key ^= static_cast<int64_t>(key) >> 28;
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  const auto* data = value.data();
+  const auto size = value.size();
+  uint64_t hash = kMurmurSeed;
+  const auto numBlocks = size / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t k;
+    ::memcpy(&k, data + i * 8, sizeof(k));
+    hash ^= mixBlock(k);
+    hash = rotateLeft(hash, kMurmurR2) * kMurmurM + kMurmurN1;
+  }
+  const auto* tail = reinterpret_cast<const uint8_t*>(data + numBlocks * 8);
+  uint64_t k = 0;
+  switch (size % 8) {
+    case 7:
+      k ^= static_cast<uint64_t>(tail[6]) << 48;
+      [[fallthrough]];
+    case 6:
+      k ^= static_cast<uint64_t>(tail[5]) << 40;
+      [[fallthrough]];
+    case 5:
+      k ^= static_cast<uint64_t>(tail[4]) << 32;
+      [[fallthrough]];
+    case 4:
+      k ^= static_cast<uint64_t>(tail[3]) << 24;
+      [[fallthrough]];
+    case 3:
+      k ^= static_cast<uint64_t>(tail[2]) << 16;
+      [[fallthrough]];
+    case 2:
+      k ^= static_cast<uint64_t>(tail[1]) << 8;
+      [[fallthrough]];
+    case 1:
+      k ^= tail[0];
+      hash ^= mixBlock(k);
+  }
+  hash ^= size;
+  return fmix64(hash);
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    // 32 bit wrap around arithmetic of the Java implementation.
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const uint64_t position = combined % numBits;
+    bits_[position / 64] |= 1ULL << (position % 64);
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const uint64_t position = combined % numBits;
+    if ((bits_[position / 64] & (1ULL << (position % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::dwrf
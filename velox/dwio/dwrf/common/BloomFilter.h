@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Bloom filter over the values of one row group, stored in the
+/// BLOOM_FILTER_UTF8 stream of a column. The sizing, hashing and bit layout
+/// follow the Hive/ORC BloomFilter so that files written here are usable by
+/// the Java readers and vice versa. Integers are hashed with Thomas Wang's 64
+/// bit integer hash and strings with the Hive variant of Murmur3 hash64. The
+/// bit positions are derived by double hashing of the two 32 bit halves of
+/// the hash.
+class BloomFilter {
+ public:
+  /// Creates an empty filter sized for 'expectedEntries' values with false
+  /// positive probability 'fpp'.
+  BloomFilter(uint64_t expectedEntries, double fpp);
+
+  /// Creates a filter from its serialized form. Accepts the bits either in
+  /// 'bitset' or in 'utf8bitset'.
+  explicit BloomFilter(const proto::BloomFilter& filter);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(hashBytes(value));
+  }
+
+  /// Returns false if 'value' is definitely not in the filter.
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  /// Returns false if 'value' is definitely not in the filter.
+  bool testBytes(std::string_view value) const {
+    return testHash(hashBytes(value));
+  }
+
+  /// Clears all the bits.
+  void reset();
+
+  void serialize(proto::BloomFilter& filter) const;
+
+  uint32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+ private:
+  void addHash(uint64_t hash);
+
+  bool testHash(uint64_t hash) const;
+
+  std::vector<uint64_t> bits_;
+  uint32_t numHashFunctions_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -105,6 +105,8 @@ inline CompressionOptions getDwrfOrcDecompressionOptions(
  * @param input The input stream that is the underlying source
  * @param bufferSize The maximum size of the buffer
  * @param pool The memory pool
+ * @param readAheadExecutor The executor to decompress blocks ahead on
+ * @param readAheadBlocks The number of blocks to decompress ahead
  */
 inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -112,7 +114,9 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     uint64_t bufferSize,
     memory::MemoryPool& pool,
     const std::string& streamDebugInfo,
-    const dwio::common::encryption::Decrypter* decryptr = nullptr) {
+    const dwio::common::encryption::Decrypter* decryptr = nullptr,
+    folly::Executor* readAheadExecutor = nullptr,
+    int32_t readAheadBlocks = 0) {
   const CompressionOptions& options = getDwrfOrcDecompressionOptions(kind);
   return createDecompressor(
       kind,
@@ -121,7 +125,11 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       pool,
       options,
       streamDebugInfo,
-      decryptr);
+      decryptr,
+      /*useRawDecompression=*/false,
+      /*compressedLength=*/0,
+      readAheadExecutor,
+      readAheadBlocks);
 }
 
 } // namespace facebook::velox::dwrf
@@ -59,6 +59,27 @@ Config::Entry<uint32_t> Config::ROW_INDEX_STRIDE{
     "hive.exec.orc.row.index.stride",
     10'000};
 
+Config::Entry<const std::vector<uint32_t>> Config::BLOOM_FILTER_COLS(
+    "orc.bloom.filter.cols",
+    {},
+    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
+    [](const std::string& /* key */, const std::string& val) {
+      std::vector<uint32_t> result;
+      if (!val.empty()) {
+        std::vector<folly::StringPiece> pieces;
+        folly::split(',', val, pieces, true);
+        for (const auto& p : pieces) {
+          const auto& trimmedCol = folly::trimWhitespace(p);
+          if (!trimmedCol.empty()) {
+            result.push_back(folly::to<uint32_t>(trimmedCol));
+          }
+        }
+      }
+      return result;
+    });
+
+Config::Entry<float> Config::BLOOM_FILTER_FPP("orc.bloom.filter.fpp", 0.05f);
+
 Config::Entry<proto::ChecksumAlgorithm> Config::CHECKSUM_ALGORITHM{
     "orc.checksum.algorithm",
     proto::ChecksumAlgorithm::XXHASH};
@@ -81,6 +102,10 @@ Config::Entry<float> Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD{
     "hive.exec.orc.dictionary.key.numeric.size.threshold",
     0.7f};
 
+Config::Entry<bool> Config::DICTIONARY_NUMERIC_COST_BASED_SELECTION{
+    "hive.exec.orc.dictionary.numeric.cost.based.selection",
+    false};
+
 Config::Entry<float> Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD{
     "hive.exec.orc.dictionary.key.string.size.threshold",
     0.8f};
@@ -39,12 +39,22 @@ class Config : public config::ConfigBase {
   static Entry<uint32_t> COMPRESSION_THRESHOLD;
   static Entry<bool> CREATE_INDEX;
   static Entry<uint32_t> ROW_INDEX_STRIDE;
+  /// Top level columns, by column index, that get a Bloom filter per row group
+  /// in their BLOOM_FILTER_UTF8 stream. Only SMALLINT, INTEGER, BIGINT and
+  /// VARCHAR columns are supported. Requires CREATE_INDEX.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLS;
+  /// The false positive probability of the Bloom filters.
+  static Entry<float> BLOOM_FILTER_FPP;
   static Entry<proto::ChecksumAlgorithm> CHECKSUM_ALGORITHM;
   static Entry<StripeCacheMode> STRIPE_CACHE_MODE;
   static Entry<uint32_t> STRIPE_CACHE_SIZE;
   static Entry<uint32_t> DICTIONARY_ENCODING_INTERVAL;
   static Entry<bool> USE_VINTS;
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
+  /// If true, integer columns choose between dictionary and direct encoding
+  /// by the estimated encoded size of both instead of
+  /// DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD.
+  static Entry<bool> DICTIONARY_NUMERIC_COST_BASED_SELECTION;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
   static Entry<float> ENTROPY_KEY_STRING_SIZE_THRESHOLD;
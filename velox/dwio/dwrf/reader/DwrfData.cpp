@@ -17,14 +17,53 @@
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
+namespace {
+// Returns true if the Bloom filters of a column of 'type' can show that no
+// value of a row group passes 'filter', i.e. 'filter' is an equality or IN
+// list which does not pass nulls.
+bool isBloomFilterApplicable(const common::Filter* filter, const Type& type) {
+  if (filter == nullptr || filter->testNull()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      switch (filter->kind()) {
+        case common::FilterKind::kBigintRange:
+          return static_cast<const common::BigintRange*>(filter)
+              ->isSingleValue();
+        case common::FilterKind::kBigintValuesUsingHashTable:
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          return true;
+        default:
+          return false;
+      }
+    case TypeKind::VARCHAR:
+      switch (filter->kind()) {
+        case common::FilterKind::kBytesRange:
+          return static_cast<const common::BytesRange*>(filter)
+              ->isSingleValue();
+        case common::FilterKind::kBytesValues:
+          return true;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+} // namespace
 
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    const common::ScanSpec* scanSpec)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -47,6 +86,15 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+  // Unlike the row index, the Bloom filters are large and only useful for
+  // some filters, so they are not read for filters added after this point.
+  if (scanSpec &&
+      isBloomFilterApplicable(scanSpec->filter(), *fileType_->type())) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -91,6 +139,57 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+bool DwrfData::testBloomFilter(
+    const common::Filter& filter,
+    int32_t rowGroup) {
+  if (bloomFilterStream_) {
+    bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+  if (!bloomFilterIndex_ ||
+      bloomFilterIndex_->bloomfilter_size() != index_->entry_size() ||
+      !isBloomFilterApplicable(&filter, *fileType_->type())) {
+    return true;
+  }
+  const BloomFilter bloomFilter(bloomFilterIndex_->bloomfilter(rowGroup));
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return bloomFilter.testLong(
+          static_cast<const common::BigintRange&>(filter).lower());
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingHashTable&>(filter)
+               .values()) {
+        if (bloomFilter.testLong(value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingBitmask&>(filter)
+               .values()) {
+        if (bloomFilter.testLong(value)) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBytesRange:
+      return bloomFilter.testBytes(
+          static_cast<const common::BytesRange&>(filter).lower());
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (bloomFilter.testBytes(value)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return true;
+  }
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(int64_t index) {
   ensureRowGroupIndex();
 
@@ -146,12 +245,17 @@ void DwrfData::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
+  auto* filter = scanSpec.filter();
   if (!index_ && !indexStream_) {
     return;
   }
+  // Columns without filters do not affect the result. Their row index is only
+  // parsed if a row group is actually skipped and the reader seeks.
+  if (!filter && scanSpec.numMetadataFilters() == 0) {
+    return;
+  }
 
   ensureRowGroupIndex();
-  auto* filter = scanSpec.filter();
   auto* dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
   result.totalCount = std::max(result.totalCount, index_->entry_size());
   const auto nwords = bits::nwords(result.totalCount);
@@ -176,6 +280,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (filter && !testBloomFilter(*filter, i)) {
+      VLOG(1) << "Drop stride " << i << " by Bloom filter on "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
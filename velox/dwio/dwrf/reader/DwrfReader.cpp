@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -124,6 +125,13 @@ uint64_t DwrfUnit::getIoSize() {
   if (cachedIoSize_) {
     return *cachedIoSize_;
   }
+  if (options_.preloadStripe() && !columnReader_ && !selectiveColumnReader_) {
+    // A preloaded stripe is read as a whole. Doesn't fetch the stripe so that
+    // the size of a stripe to load ahead is known without reading it.
+    cachedIoSize_ = stripeInfo_.indexLength() + stripeInfo_.dataLength() +
+        stripeInfo_.footerLength();
+    return *cachedIoSize_;
+  }
   ensureDecoders();
   cachedIoSize_ =
       stripeReadState_->stripeMetadata->stripeInput->nextFetchSize();
@@ -329,6 +337,17 @@ std::unique_ptr<dwio::common::UnitLoader> DwrfRowReader::getUnitLoader() {
   }
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory =
       options_.unitLoaderFactory();
+  if (!unitLoaderFactory && options_.parallelUnitLoadCount() > 1 &&
+      options_.decodingExecutor() && options_.preloadStripe()) {
+    // The stripes are loaded concurrently only when preloaded since otherwise
+    // they share the BufferedInput of the reader.
+    unitLoaderFactory =
+        std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+            options_.decodingExecutor().get(),
+            options_.parallelUnitLoadCount(),
+            options_.blockedOnIoCallback(),
+            options_.maxUnitLoadAheadBytes());
+  }
   if (!unitLoaderFactory) {
     unitLoaderFactory =
         std::make_shared<dwio::common::OnDemandUnitLoaderFactory>(
@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -32,6 +33,17 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+// The parsed post script and footer of a file in FileMetadataCache. The footer
+// is allocated on 'arena'.
+struct CachedTail {
+  std::shared_ptr<google::protobuf::Arena> arena;
+  std::shared_ptr<const PostScript> postScript;
+  FooterWrapper footer;
+  uint64_t psLength;
+};
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -85,8 +97,7 @@ ReaderBase::ReaderBase(
 ReaderBase::ReaderBase(
     const dwio::common::ReaderOptions& options,
     std::unique_ptr<dwio::common::BufferedInput> input)
-    : arena_(std::make_unique<google::protobuf::Arena>()),
-      options_{options},
+    : options_{options},
       input_(std::move(input)),
       fileLength_(input_->getReadFile()->size()) {
   process::TraceContext trace("ReaderBase::ReaderBase");
@@ -94,6 +105,75 @@ ReaderBase::ReaderBase(
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
   VELOX_CHECK_GE(fileLength_, 4, "File size too small");
 
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::string cacheKey;
+  std::shared_ptr<const CachedTail> cachedTail;
+  if (metadataCache != nullptr && !options_.fileMetadataCacheKey().empty()) {
+    cacheKey = "dwrf:" + options_.fileMetadataCacheKey();
+    cachedTail = metadataCache->get<CachedTail>(cacheKey);
+  }
+  if (cachedTail != nullptr) {
+    arena_ = cachedTail->arena;
+    postScript_ = cachedTail->postScript;
+    footer_ = std::make_unique<FooterWrapper>(cachedTail->footer);
+    psLength_ = cachedTail->psLength;
+  } else {
+    readTail();
+    if (!cacheKey.empty()) {
+      auto tail = std::make_shared<CachedTail>(
+          CachedTail{arena_, postScript_, *footer_, psLength_});
+      metadataCache->put(
+          cacheKey, std::move(tail), arena_->SpaceAllocated() + psLength_);
+    }
+  }
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize =
+      1 + psLength_ + postScript_->footerLength() + cacheSize;
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, options_.fileColumnNamesReadAsLowerCase()));
+  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
+    const uint64_t cacheOffset = fileLength_ - tailSize;
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(cacheOffset, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
+          options_.memoryPool(), cacheSize);
+      input_->read(cacheOffset, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    const auto numStripes = footer().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = footer().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes > 0) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ =
+      DecryptionHandler::create(*footer_, options_.decrypterFactory().get());
+}
+
+void ReaderBase::readTail() {
+  arena_ = std::make_shared<google::protobuf::Arena>();
   const auto preloadFile = fileLength_ <= options_.filePreloadThreshold();
   const uint64_t readSize = preloadFile
       ? fileLength_
@@ -171,46 +251,6 @@ ReaderBase::ReaderBase(
         footer);
     footer_ = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, options_.fileColumnNamesReadAsLowerCase()));
-  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
-    const uint64_t cacheOffset = fileLength_ - tailSize;
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(cacheOffset, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
-          options_.memoryPool(), cacheSize);
-      input_->read(cacheOffset, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    const auto numStripes = footer().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = footer().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes > 0) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ =
-      DecryptionHandler::create(*footer_, options_.decrypterFactory().get());
 }
 
 std::vector<uint64_t> ReaderBase::rowsPerStripe() const {
@@ -214,14 +214,18 @@ class ReaderBase {
   std::unique_ptr<dwio::common::SeekableInputStream> createDecompressedStream(
       std::unique_ptr<dwio::common::SeekableInputStream> compressed,
       const std::string& streamDebugInfo,
-      const dwio::common::encryption::Decrypter* decrypter = nullptr) const {
+      const dwio::common::encryption::Decrypter* decrypter = nullptr,
+      folly::Executor* readAheadExecutor = nullptr,
+      int32_t readAheadBlocks = 0) const {
     return createDecompressor(
         compressionKind(),
         std::move(compressed),
         compressionBlockSize(),
         options_.memoryPool(),
         streamDebugInfo,
-        decrypter);
+        decrypter,
+        readAheadExecutor,
+        readAheadBlocks);
   }
 
   template <typename T>
@@ -260,8 +264,12 @@ class ReaderBase {
     return options;
   }
 
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
+  // Reads the post script and the footer from 'input_'.
+  void readTail();
+
+  // Shared with FileMetadataCache and other readers of the same file.
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::shared_ptr<const PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
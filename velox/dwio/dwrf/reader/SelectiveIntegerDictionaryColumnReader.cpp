@@ -111,6 +111,16 @@ void SelectiveIntegerDictionaryColumnReader::read(
   readOffset_ += rows.back() + 1;
 }
 
+template <typename T>
+void SelectiveIntegerDictionaryColumnReader::fillFilterCache(
+    const common::Filter& filter) {
+  fillDictionaryFilterCache(
+      filter,
+      scanState_.dictionary.values->as<T>(),
+      scanState_.dictionary.numValues,
+      scanState_.filterCache.data());
+}
+
 void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -118,7 +128,8 @@ void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
 
   ClockTimer timer{initTimeClocks_};
   scanState_.dictionary.values = dictInit_();
-  if (DictionaryValues::hasFilter(scanSpec_->filter())) {
+  auto* filter = scanSpec_->filter();
+  if (DictionaryValues::hasFilter(filter)) {
     // Make sure there is a cache even for an empty dictionary because of asan
     // failure when preparing a gather with all lanes masked out.
     scanState_.filterCache.resize(
@@ -127,6 +138,13 @@ void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
         scanState_.filterCache.data(),
         FilterResult::kUnknown,
         scanState_.filterCache.size());
+    if (shouldFillDictionaryFilterCache(
+            filter,
+            scanState_.dictionary.numValues,
+            formatData_->as<DwrfData>().stripeRows())) {
+      VELOX_WIDTH_DISPATCH(
+          sizeOfIntKind(fileType_->type()->kind()), fillFilterCache, *filter);
+    }
   }
   scanState_.updateRawState();
   initialized_ = true;
@@ -56,6 +56,11 @@ class SelectiveIntegerDictionaryColumnReader
  private:
   void ensureInitialized();
 
+  // Evaluates 'filter' over the whole dictionary of 'T' values into the
+  // filter cache.
+  template <typename T>
+  void fillFilterCache(const common::Filter& filter);
+
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
   std::unique_ptr<dwio::common::IntDecoder</*isSigned=*/false>> dataReader_;
   std::function<BufferPtr()> dictInit_;
@@ -305,12 +305,24 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
 
-  if (DictionaryValues::hasFilter(scanSpec_->filter())) {
+  auto* filter = scanSpec_->filter();
+  if (DictionaryValues::hasFilter(filter)) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
-    simd::memset(
-        scanState_.filterCache.data(),
-        FilterResult::kUnknown,
-        scanState_.dictionary.numValues);
+    if (shouldFillDictionaryFilterCache(
+            filter,
+            scanState_.dictionary.numValues,
+            formatData_->as<DwrfData>().stripeRows())) {
+      fillDictionaryFilterCache(
+          *filter,
+          scanState_.dictionary.values->as<StringView>(),
+          scanState_.dictionary.numValues,
+          scanState_.filterCache.data());
+    } else {
+      simd::memset(
+          scanState_.filterCache.data(),
+          FilterResult::kUnknown,
+          scanState_.dictionary.numValues);
+    }
   }
 
   // handle in dictionary stream
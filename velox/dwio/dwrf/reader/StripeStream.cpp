@@ -233,6 +233,19 @@ void StripeStreamsImpl::loadStreams() {
       }
     }
   }
+
+  // A flat map has streams for each of its keys. Index the streams by node so
+  // that visiting the streams of one column does not scan all the streams of
+  // the stripe. The streams are in file order so that the reads of the
+  // visited streams are enqueued in order.
+  for (const auto& [id, info] : streams_) {
+    nodeStreams_[id.encodingKey().node()].push_back(info);
+  }
+  for (auto& [node, streams] : nodeStreams_) {
+    std::sort(streams.begin(), streams.end(), [](auto& left, auto& right) {
+      return left.getOffset() < right.getOffset();
+    });
+  }
 }
 
 std::unique_ptr<dwio::common::SeekableInputStream>
@@ -309,23 +322,28 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   const auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
+  // Index streams are read once, before any decoding.
+  const auto readAheadBlocks =
+      isIndexStream(si.kind()) ? 0 : opts_.decompressionReadAheadBlocks();
   return readState_->readerBase->createDecompressedStream(
       std::move(streamInput),
       streamDebugInfo,
-      getDecrypter(si.encodingKey().node()));
+      getDecrypter(si.encodingKey().node()),
+      opts_.decodingExecutor().get(),
+      readAheadBlocks);
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
     uint32_t node,
     std::function<void(const StreamInformation&)> visitor) const {
-  uint32_t count = 0;
-  for (auto& item : streams_) {
-    if (item.first.encodingKey().node() == node) {
-      visitor(item.second);
-      ++count;
-    }
+  const auto it = nodeStreams_.find(node);
+  if (it == nodeStreams_.end()) {
+    return 0;
+  }
+  for (const auto& stream : it->second) {
+    visitor(stream);
   }
-  return count;
+  return it->second.size();
 }
 
 bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
@@ -356,6 +356,8 @@ class StripeStreamsImpl : public StripeStreamsBase {
       StreamInformationImpl,
       dwio::common::StreamIdentifierHash>
       streams_;
+  // The streams of each node in 'streams_', ordered by offset.
+  folly::F14FastMap<uint32_t, std::vector<StreamInformationImpl>> nodeStreams_;
   folly::F14FastMap<EncodingKey, uint32_t, EncodingKeyHash> encodings_;
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
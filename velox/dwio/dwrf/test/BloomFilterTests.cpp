@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+namespace facebook::velox::dwrf {
+
+TEST(BloomFilterTest, sizing) {
+  // Same sizes as the Java writer for the default row index stride and fpp.
+  BloomFilter filter(10'000, 0.05);
+  EXPECT_EQ(filter.numBits(), 62'400);
+  EXPECT_EQ(filter.numHashFunctions(), 4);
+}
+
+TEST(BloomFilterTest, longs) {
+  BloomFilter filter(1'000, 0.05);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    filter.addLong(i * 7 - 3'500);
+  }
+  for (int64_t i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter.testLong(i * 7 - 3'500));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter.testLong(i * 7 - 3'499);
+  }
+  EXPECT_LT(numFalsePositives, 1'000);
+
+  filter.reset();
+  EXPECT_FALSE(filter.testLong(-3'500));
+}
+
+TEST(BloomFilterTest, bytes) {
+  BloomFilter filter(1'000, 0.01);
+  std::vector<std::string> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    // Covers all lengths of the last partial 8 byte block.
+    values.push_back(std::string(i % 20, 'x') + std::to_string(i));
+    filter.addBytes(values.back());
+  }
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter.testBytes(value));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter.testBytes("y" + std::to_string(i));
+  }
+  EXPECT_LT(numFalsePositives, 300);
+}
+
+TEST(BloomFilterTest, serialize) {
+  BloomFilter filter(100, 0.05);
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.addLong(i * 1'000'003);
+  }
+  proto::BloomFilter proto;
+  filter.serialize(proto);
+  EXPECT_EQ(proto.numhashfunctions(), filter.numHashFunctions());
+  EXPECT_EQ(proto.bitset_size() * 64, filter.numBits());
+
+  const BloomFilter copy(proto);
+  // The bits may also come in the bytes field.
+  proto::BloomFilter bytesProto;
+  bytesProto.set_numhashfunctions(proto.numhashfunctions());
+  bytesProto.set_utf8bitset(
+      reinterpret_cast<const char*>(proto.bitset().data()),
+      proto.bitset_size() * sizeof(uint64_t));
+  const BloomFilter bytesCopy(bytesProto);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    const auto value = i * 1'000'003;
+    EXPECT_EQ(copy.testLong(value), filter.testLong(value));
+    EXPECT_EQ(bytesCopy.testLong(value), filter.testLong(value));
+  }
+}
+
+} // namespace facebook::velox::dwrf
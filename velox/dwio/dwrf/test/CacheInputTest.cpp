@@ -504,6 +504,49 @@ TEST_F(CacheTest, window) {
   EXPECT_EQ(kMB, ioStats_->rawBytesRead() - previousRead);
 }
 
+TEST_F(CacheTest, storageReadStats) {
+  EXPECT_EQ(IoStatistics::storageBackend("s3://bucket/key"), "s3");
+  EXPECT_EQ(IoStatistics::storageBackend("hdfs://host:9000/a/b"), "hdfs");
+  EXPECT_EQ(IoStatistics::storageBackend("/tmp/file"), "file");
+
+  const auto globalStatsBefore = IoStatistics::globalStorageReadStats();
+  IoStatistics stats;
+  stats.incStorageRead("s3", false, 1'000, 20);
+  stats.incStorageRead("s3", false, 3'000, 40);
+  stats.incStorageRead("s3", true, 8'000'000, 5'000);
+  stats.incStorageRead(IoStatistics::kSsdCacheBackend, false, 4'096, 100);
+
+  auto storageReadStats = stats.storageReadStats();
+  ASSERT_EQ(storageReadStats.size(), 2);
+  const auto& s3Reads = storageReadStats["s3"];
+  EXPECT_EQ(s3Reads.demand.count, 2);
+  EXPECT_EQ(s3Reads.demand.bytes, 4'000);
+  EXPECT_EQ(s3Reads.demand.latencyUs, 60);
+  EXPECT_EQ(s3Reads.demand.bytesHistogram.count(), 2);
+  EXPECT_EQ(s3Reads.prefetch.count, 1);
+  EXPECT_EQ(s3Reads.prefetch.bytes, 8'000'000);
+  EXPECT_EQ(storageReadStats["ssd"].demand.count, 1);
+  EXPECT_EQ(storageReadStats["ssd"].prefetch.count, 0);
+
+  IoStatistics merged;
+  merged.incStorageRead("s3", false, 2'000, 30);
+  merged.merge(stats);
+  EXPECT_EQ(merged.storageReadStats()["s3"].demand.count, 3);
+  EXPECT_EQ(merged.storageReadStats()["s3"].demand.bytes, 6'000);
+
+  // The global stats have all the reads, including the ones merged above
+  // only once.
+  auto globalReads = IoStatistics::globalStorageReadStats()["s3"];
+  auto it = globalStatsBefore.find("s3");
+  if (it != globalStatsBefore.end()) {
+    globalReads.subtract(it->second);
+  }
+  EXPECT_EQ(globalReads.demand.count, 3);
+  EXPECT_EQ(globalReads.demand.bytes, 6'000);
+  EXPECT_EQ(globalReads.prefetch.count, 1);
+  EXPECT_EQ(globalReads.demand.bytesHistogram.count(), 3);
+}
+
 TEST_F(CacheTest, bufferedInput) {
   // Size 160 MB. Frequent evictions and not everything fits in prefetch window.
   initializeCache(160 << 20);
@@ -941,6 +984,13 @@ TEST_F(CacheTest, ssdReadVerification) {
   ASSERT_GT(ioStats_->read().sum(), 0);
   ASSERT_GT(ioStats_->ramHit().sum(), 0);
   ASSERT_GT(ioStats_->ssdRead().sum(), 0);
+  // The reads from the test file and from SSD are recorded by backend.
+  auto storageReadStats = ioStats_->storageReadStats();
+  const auto& fileReads = storageReadStats["file"];
+  ASSERT_GT(fileReads.demand.count + fileReads.prefetch.count, 0);
+  const auto& ssdReads =
+      storageReadStats[std::string(IoStatistics::kSsdCacheBackend)];
+  ASSERT_GT(ssdReads.demand.bytes + ssdReads.prefetch.bytes, 0);
 
   // Corrupt SSD cache file.
   corruptSsdFile(fmt::format("{}/cache0", tempDirectory_->getPath()));
@@ -22,6 +22,7 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
 
@@ -475,3 +476,280 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
   EXPECT_EQ(options.format.zstd.compressionLevel, 7);
   EXPECT_EQ(options.compressionThreshold, 256);
 }
+
+TEST(BlockDecompressorTest, roundTrip) {
+  namespace compression = facebook::velox::dwio::common::compression;
+  const auto none = facebook::velox::common::CompressionKind_NONE;
+  EXPECT_EQ(
+      compression::createBlockDecompressor(
+          none, 1024, getDwrfOrcDecompressionOptions(none), ""),
+      nullptr);
+
+  const auto kind = facebook::velox::common::CompressionKind_ZSTD;
+  auto options = getDwrfOrcCompressionOptions(kind, 256, 4, 7);
+  auto compressor = compression::createCompressor(kind, options);
+  std::vector<char> input(10'000);
+  generateRandomData(input.data(), input.size(), true);
+  std::vector<char> compressed(input.size() * 2);
+  const auto compressedSize =
+      compressor->compress(input.data(), compressed.data(), input.size());
+
+  auto decompressor = compression::createBlockDecompressor(
+      kind, input.size(), getDwrfOrcDecompressionOptions(kind), "test");
+  // The decompressor is reused for several blocks.
+  for (auto i = 0; i < 2; ++i) {
+    std::vector<char> output(input.size());
+    EXPECT_EQ(
+        decompressor->decompress(
+            compressed.data(), compressedSize, output.data(), output.size()),
+        input.size());
+    EXPECT_EQ(output, input);
+  }
+}
+
+TEST(BlockDecompressorTest, registeredFactory) {
+  namespace compression = facebook::velox::dwio::common::compression;
+  const auto kind = facebook::velox::common::CompressionKind_ZSTD;
+  auto options = getDwrfOrcCompressionOptions(kind, 256, 4, 7);
+  auto compressor = compression::createCompressor(kind, options);
+  std::vector<char> input(10'000);
+  generateRandomData(input.data(), input.size(), true);
+  std::vector<char> compressed(input.size() * 2);
+  const auto compressedSize =
+      compressor->compress(input.data(), compressed.data(), input.size());
+
+  // Stands in for a hardware decompressor. Knows the decompressed block and
+  // fails on every other block.
+  class TestDecompressor : public compression::Decompressor {
+   public:
+    TestDecompressor(const std::vector<char>& block, uint64_t blockSize)
+        : Decompressor{blockSize, "test"}, block_{block} {}
+
+    uint64_t decompress(
+        const char* /*src*/,
+        uint64_t /*srcLength*/,
+        char* dest,
+        uint64_t destLength) override {
+      if (numCalls_++ % 2 == 1) {
+        VELOX_FAIL("Device error");
+      }
+      VELOX_CHECK_GE(destLength, block_.size());
+      std::copy(block_.begin(), block_.end(), dest);
+      return block_.size();
+    }
+
+   private:
+    const std::vector<char>& block_;
+    int32_t numCalls_{0};
+  };
+
+  bool deviceAvailable = true;
+  compression::registerBlockDecompressorFactory(
+      kind,
+      [&](uint64_t blockSize,
+          const compression::CompressionOptions& /*options*/,
+          const std::string& /*streamDebugInfo*/)
+          -> std::unique_ptr<compression::Decompressor> {
+        if (!deviceAvailable) {
+          return nullptr;
+        }
+        return std::make_unique<TestDecompressor>(input, blockSize);
+      });
+
+  auto testDecompress = [&](int32_t numBlocks) {
+    auto decompressor = compression::createBlockDecompressor(
+        kind, input.size(), getDwrfOrcDecompressionOptions(kind), "test");
+    for (auto i = 0; i < numBlocks; ++i) {
+      std::vector<char> output(input.size());
+      EXPECT_EQ(
+          decompressor->decompress(
+              compressed.data(), compressedSize, output.data(), output.size()),
+          input.size());
+      EXPECT_EQ(output, input);
+    }
+  };
+
+  const auto initialStats = compression::blockDecompressorStats(kind);
+  testDecompress(4);
+  auto stats = compression::blockDecompressorStats(kind);
+  EXPECT_EQ(stats.numBlocks - initialStats.numBlocks, 2);
+  EXPECT_EQ(stats.numFallbacks - initialStats.numFallbacks, 2);
+
+  // No device. The software decompressor is used.
+  deviceAvailable = false;
+  testDecompress(2);
+  EXPECT_EQ(
+      compression::blockDecompressorStats(kind).numBlocks, stats.numBlocks);
+
+  compression::registerBlockDecompressorFactory(kind, nullptr);
+  deviceAvailable = true;
+  testDecompress(2);
+  EXPECT_EQ(
+      compression::blockDecompressorStats(kind).numBlocks, stats.numBlocks);
+}
+
+namespace {
+// Counts the calls to decryptBatch().
+class BatchCountingDecrypter : public TestDecrypter {
+ public:
+  std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+      const std::vector<folly::StringPiece>& inputs) const override {
+    ++numBatches_;
+    return Decrypter::decryptBatch(inputs);
+  }
+
+  size_t numBatches() const {
+    return numBatches_;
+  }
+
+ private:
+  mutable std::atomic<size_t> numBatches_{0};
+};
+
+// Reads 'data' compressed into 'sink' with read ahead, with random backups,
+// skips and seeks.
+void testReadAhead(
+    CompressionKind kind,
+    MemorySink& sink,
+    uint64_t block,
+    MemoryPool& pool,
+    const std::vector<char>& data,
+    const Decrypter* decrypter,
+    folly::Executor& executor,
+    int32_t readAheadBlocks) {
+  auto stream = createDecompressor(
+      kind,
+      std::make_unique<SeekableArrayInputStream>(sink.data(), sink.size()),
+      block,
+      pool,
+      "test",
+      decrypter,
+      &executor,
+      readAheadBlocks);
+  folly::Random::DefaultGenerator rng(readAheadBlocks);
+  const char* buffer;
+  int32_t size;
+  size_t pos = 0;
+  int32_t numSeeks = 0;
+  while (stream->Next(reinterpret_cast<const void**>(&buffer), &size)) {
+    ASSERT_LE(pos + size, data.size());
+    ASSERT_EQ(std::memcmp(buffer, data.data() + pos, size), 0);
+    pos += size;
+    // Backs up, skips or seeks back into the first block now and then.
+    const auto action = folly::Random::rand32(20, rng);
+    if (action < 5) {
+      const auto count = folly::Random::rand32(size + 1, rng);
+      stream->BackUp(count);
+      pos -= count;
+    } else if (action < 10 && pos < data.size()) {
+      const auto count = folly::Random::rand32(
+          std::min<size_t>(3 * block, data.size() - pos), rng);
+      stream->SkipInt64(count);
+      pos += count;
+    } else if (action == 10 && numSeeks++ < 3) {
+      pos = folly::Random::rand32(block, rng);
+      std::vector<uint64_t> positions = {0, pos};
+      PositionProvider provider(positions);
+      stream->seekToPosition(provider);
+    }
+  }
+  EXPECT_EQ(pos, data.size());
+
+  // A seek after the end reads the stream again.
+  std::vector<uint64_t> positions = {0, 100};
+  PositionProvider provider(positions);
+  stream->seekToPosition(provider);
+  ASSERT_TRUE(stream->Next(reinterpret_cast<const void**>(&buffer), &size));
+  EXPECT_EQ(std::memcmp(buffer, data.data() + 100, size), 0);
+}
+} // namespace
+
+TEST(DecompressionReadAheadTest, readAhead) {
+  MemoryManager::testingSetInstance({});
+  auto pool = memoryManager()->addLeafPool();
+  const uint64_t block = 1024;
+  // Letters which compress well alternate with random bytes which are kept
+  // uncompressed.
+  std::vector<char> data(200 * block);
+  for (auto i = 0; i < data.size(); i += 4 * block) {
+    generateRandomData(data.data() + i, 4 * block, (i / (4 * block)) % 2 == 0);
+  }
+
+  folly::CPUThreadPoolExecutor executor(4);
+  for (const auto& [kind, encrypted] :
+       std::vector<std::pair<CompressionKind, bool>>{
+           {CompressionKind_ZSTD, false},
+           {CompressionKind_ZSTD, true},
+           {CompressionKind_NONE, true}}) {
+    MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+    compressAndVerify(
+        kind,
+        memSink,
+        block,
+        *pool,
+        data.data(),
+        data.size(),
+        encrypted ? &testEncrypter : nullptr);
+    for (const auto readAheadBlocks : {1, 4}) {
+      SCOPED_TRACE(fmt::format(
+          "kind: {}, encrypted: {}, readAheadBlocks: {}",
+          compressionKindToString(kind),
+          encrypted,
+          readAheadBlocks));
+      BatchCountingDecrypter decrypter;
+      testReadAhead(
+          kind,
+          memSink,
+          block,
+          *pool,
+          data,
+          encrypted ? &decrypter : nullptr,
+          executor,
+          readAheadBlocks);
+      if (encrypted && readAheadBlocks > 1) {
+        // The blocks read ahead are decrypted in batches.
+        EXPECT_LT(decrypter.numBatches(), decrypter.getCount());
+      }
+    }
+  }
+}
+
+TEST(DecompressionReadAheadTest, notThreadSafeDecrypter) {
+  // Decrypts only on the reader thread.
+  class SingleThreadedDecrypter : public BatchCountingDecrypter {
+   public:
+    bool isThreadSafe() const override {
+      return false;
+    }
+  };
+
+  MemoryManager::testingSetInstance({});
+  auto pool = memoryManager()->addLeafPool();
+  const uint64_t block = 1024;
+  std::vector<char> data(20 * block);
+  generateRandomData(data.data(), data.size(), true);
+
+  folly::CPUThreadPoolExecutor executor(4);
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  compressAndVerify(
+      CompressionKind_ZSTD,
+      memSink,
+      block,
+      *pool,
+      data.data(),
+      data.size(),
+      &testEncrypter);
+  SingleThreadedDecrypter decrypter;
+  testReadAhead(
+      CompressionKind_ZSTD,
+      memSink,
+      block,
+      *pool,
+      data,
+      &decrypter,
+      executor,
+      4);
+  // The stream is not read ahead, so no block is decrypted in a batch.
+  EXPECT_EQ(decrypter.numBatches(), 0);
+  EXPECT_GT(decrypter.getCount(), 0);
+}
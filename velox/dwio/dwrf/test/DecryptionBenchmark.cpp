@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include <random>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/encryption/TestProvider.h"
+#include "velox/dwio/dwrf/common/Compression.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwrf;
+
+DEFINE_int32(stream_bytes, 64 << 20, "Uncompressed bytes per stream");
+DEFINE_int32(block_size, 256 << 10, "Compression block size");
+DEFINE_int32(read_ahead_threads, 4, "Threads for the blocks read ahead");
+
+namespace {
+// Hands out a single buffer to the compressor.
+class BufferPool : public CompressionBufferPool {
+ public:
+  BufferPool(memory::MemoryPool& pool, uint64_t blockSize)
+      : buffer_{std::make_unique<DataBuffer<char>>(
+            pool,
+            blockSize + PAGE_HEADER_SIZE)} {}
+
+  std::unique_ptr<DataBuffer<char>> getBuffer(uint64_t /*size*/) override {
+    return std::move(buffer_);
+  }
+
+  void returnBuffer(std::unique_ptr<DataBuffer<char>> buffer) override {
+    buffer_ = std::move(buffer);
+  }
+
+ private:
+  std::unique_ptr<DataBuffer<char>> buffer_;
+};
+
+std::shared_ptr<memory::MemoryPool> pool;
+std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+encryption::test::TestEncrypter encrypter;
+encryption::test::TestDecrypter decrypter;
+
+// Returns a ZSTD compressed stream of 'FLAGS_stream_bytes' of compressible
+// data, encrypted if 'encrypted' is true.
+std::unique_ptr<MemorySink> makeStream(bool encrypted) {
+  std::mt19937 random(1);
+  std::vector<char> data(FLAGS_stream_bytes);
+  for (auto& byte : data) {
+    byte = 'a' + random() % 16;
+  }
+  auto sink = std::make_unique<MemorySink>(
+      FLAGS_stream_bytes, FileSink::Options{.pool = pool.get()});
+  BufferPool bufferPool(*pool, FLAGS_block_size);
+  DataBufferHolder holder{
+      *pool, FLAGS_block_size, 0, DEFAULT_PAGE_GROW_RATIO, sink.get()};
+  Config config;
+  auto stream = createCompressor(
+      common::CompressionKind_ZSTD,
+      bufferPool,
+      holder,
+      config,
+      encrypted ? &encrypter : nullptr);
+  size_t pos = 0;
+  while (pos < data.size()) {
+    void* buffer;
+    int32_t size;
+    VELOX_CHECK(stream->Next(&buffer, &size));
+    const auto length = std::min<size_t>(size, data.size() - pos);
+    std::memcpy(buffer, data.data() + pos, length);
+    pos += length;
+    if (length < size) {
+      stream->BackUp(size - length);
+    }
+  }
+  stream->flush();
+  return sink;
+}
+
+// Reads 'stream' to the end with 'readAheadBlocks' blocks read ahead.
+void scan(
+    uint32_t iters,
+    const MemorySink& stream,
+    bool encrypted,
+    int32_t readAheadBlocks) {
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto input = createDecompressor(
+        common::CompressionKind_ZSTD,
+        std::make_unique<SeekableArrayInputStream>(
+            stream.data(), stream.size()),
+        FLAGS_block_size,
+        *pool,
+        "benchmark",
+        encrypted ? &decrypter : nullptr,
+        readAheadBlocks > 0 ? executor.get() : nullptr,
+        readAheadBlocks);
+    const void* data;
+    int32_t size;
+    uint64_t total = 0;
+    while (input->Next(&data, &size)) {
+      total += size;
+    }
+    folly::doNotOptimizeAway(total);
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  executor =
+      std::make_unique<folly::CPUThreadPoolExecutor>(FLAGS_read_ahead_threads);
+  std::vector<std::unique_ptr<MemorySink>> streams;
+  for (const bool encrypted : {false, true}) {
+    streams.push_back(makeStream(encrypted));
+    const auto* stream = streams.back().get();
+    for (const auto readAheadBlocks : {0, 4}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "{}{}",
+              encrypted ? "encrypted" : "plain",
+              readAheadBlocks > 0 ? "_readAhead" : ""),
+          [stream, encrypted, readAheadBlocks](unsigned iters) {
+            scan(iters, *stream, encrypted, readAheadBlocks);
+            return iters;
+          });
+    }
+  }
+  folly::runBenchmarks();
+  streams.clear();
+  executor.reset();
+  pool.reset();
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -376,6 +377,54 @@ TEST_F(E2EWriterTest, E2E) {
   dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "timestamp_val:timestamp,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "struct_val:struct<a:float,b:double>"
+      ">");
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  // Small compression blocks so that the streams compress while writing.
+  config->set(
+      dwrf::Config::COMPRESSION_BLOCK_SIZE, static_cast<uint64_t>(1024));
+  auto batches = dwrf::E2EWriterTestUtil::generateBatches(
+      type, 8, 2'000, /*seed=*/1, *leafPool_);
+
+  auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * kSizeMB, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelism = 4;
+    auto writer = std::make_unique<dwrf::Writer>(
+        std::move(sink), options, memory::memoryManager()->addRootPool());
+    for (const auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serial = write(nullptr);
+  const auto parallel =
+      write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  // Each column is encoded by one thread at a time, so the files are the same.
+  EXPECT_EQ(serial, parallel);
+}
+
 // Disabled because test is failing in continuous runs T193531984.
 TEST_F(E2EWriterTest, DISABLED_DisableLinearHeuristics) {
   const size_t batchCount = 100;
@@ -188,4 +188,68 @@ TEST_F(LayoutPlannerTest, Basic) {
   });
   ASSERT_EQ(pos, dataStreams.size());
 }
+
+TEST_F(LayoutPlannerTest, accessFrequency) {
+  auto config = std::make_shared<Config>();
+  config->set(
+      Config::COMPRESSION, common::CompressionKind::CompressionKind_NONE);
+  WriterContext context{
+      config,
+      facebook::velox::memory::memoryManager()->addRootPool(
+          "LayoutPlannerTests")};
+  std::vector<DwrfStreamIdentifier> streams;
+  std::array<char, 256> data;
+  std::memset(data.data(), 'a', data.size());
+  auto addStream =
+      [&](uint32_t node, uint32_t col, StreamKind kind, uint32_t size) {
+        auto streamId = DwrfStreamIdentifier{node, 0, col, kind};
+        streams.push_back(streamId);
+        dwio::common::AppendOnlyBufferedStream out{context.newStream(streamId)};
+        out.write(data.data(), size);
+        out.flush();
+      };
+
+  auto encryptionHandler =
+      std::make_unique<velox::dwrf::encryption::EncryptionHandler>();
+  EncodingManager encodingManager{*encryptionHandler};
+  for (auto node = 1; node <= 3; ++node) {
+    auto& encoding = encodingManager.addEncodingToFooter(node);
+    encoding.set_node(node);
+    encoding.set_sequence(0);
+    encoding.set_kind(proto::ColumnEncoding::DIRECT);
+  }
+
+  addStream(1, 0, StreamKind::StreamKind_DATA, 30); // 0
+  addStream(2, 1, StreamKind::StreamKind_DATA, 20); // 1
+  addStream(3, 2, StreamKind::StreamKind_DATA, 10); // 2
+  addStream(1, 0, StreamKind::StreamKind_ROW_INDEX, 3); // 3
+  addStream(2, 1, StreamKind::StreamKind_ROW_INDEX, 2); // 4
+  addStream(3, 2, StreamKind::StreamKind_ROW_INDEX, 1); // 5
+
+  auto typeWithId = dwio::common::TypeWithId::create(
+      ROW({INTEGER(), INTEGER(), INTEGER()}));
+  auto verify = [&](const LayoutPlanner& planner,
+                    const std::vector<size_t>& indexStreams,
+                    const std::vector<size_t>& dataStreams) {
+    auto result = planner.plan(encodingManager, getStreamList(context));
+    size_t pos = 0;
+    result.iterateIndexStreams([&](auto& stream, auto& /* ignored */) {
+      ASSERT_LT(pos, indexStreams.size());
+      ASSERT_EQ(stream, streams.at(indexStreams[pos++]));
+    });
+    ASSERT_EQ(pos, indexStreams.size());
+    pos = 0;
+    result.iterateDataStreams([&](auto& stream, auto& /* ignored */) {
+      ASSERT_LT(pos, dataStreams.size());
+      ASSERT_EQ(stream, streams.at(dataStreams[pos++]));
+    });
+    ASSERT_EQ(pos, dataStreams.size());
+  };
+
+  // Without a hint, the streams are sorted by ascending size.
+  verify(LayoutPlanner{*typeWithId}, {5, 4, 3}, {2, 1, 0});
+  // Column 0 is read most, then column 2. Column 1 is not read.
+  verify(
+      LayoutPlanner{*typeWithId, {{0, 100}, {2, 50}}}, {3, 5, 4}, {0, 2, 1});
+}
 } // namespace facebook::velox::dwrf
@@ -2665,3 +2665,75 @@ TEST_F(TestReader, skipLongString) {
     validate(batch);
   }
 }
+
+TEST_F(TestReader, bloomFilterSkipsStrides) {
+  // Only even values. Each stride of 1000 rows covers a range of 2000 values,
+  // so an odd value inside the range of a stride passes its min/max stats.
+  constexpr int32_t kNumRows = 4'000;
+  auto batch = makeRowVector({
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row * 2; }),
+      makeFlatVector<std::string>(
+          kNumRows, [](auto row) { return fmt::format("{:05}", row * 2); }),
+  });
+  auto schema = asRowType(batch->type());
+  auto readWithFilters = [&](bool bloomFilters,
+                             std::unique_ptr<common::Filter> intFilter,
+                             std::unique_ptr<common::Filter> stringFilter) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1'000));
+    if (bloomFilters) {
+      config->set<const std::vector<uint32_t>>(
+          dwrf::Config::BLOOM_FILTER_COLS, {0, 1});
+    }
+    auto [writer, reader] = createWriterReader({batch}, pool(), config);
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    if (intFilter) {
+      spec->childByName("c0")->setFilter(std::move(intFilter));
+    }
+    if (stringFilter) {
+      spec->childByName("c1")->setFilter(std::move(stringFilter));
+    }
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(schema, 0, pool());
+    int64_t numRows = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      numRows += result->size();
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return std::make_pair(numRows, stats.skippedStrides);
+  };
+
+  // 2001 is in the range of stride 1 but not in the data. 4000 is in stride
+  // 2. Strides 0 and 3 are skipped by the stats.
+  using Result = std::pair<int64_t, int64_t>;
+  EXPECT_EQ(
+      readWithFilters(
+          false, common::createBigintValues({2001, 4000}, false), nullptr),
+      Result(1, 2));
+  EXPECT_EQ(
+      readWithFilters(
+          true, common::createBigintValues({2001, 4000}, false), nullptr),
+      Result(1, 3));
+  EXPECT_EQ(
+      readWithFilters(
+          true,
+          std::make_unique<common::BigintRange>(2001, 2001, false),
+          nullptr),
+      Result(0, 4));
+  EXPECT_EQ(
+      readWithFilters(
+          true,
+          nullptr,
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"02001", "04000"}, false)),
+      Result(1, 3));
+  // Nulls pass the filter, so the Bloom filters are not used.
+  EXPECT_EQ(
+      readWithFilters(
+          true, common::createBigintValues({2001, 4000}, true), nullptr),
+      Result(1, 2));
+}
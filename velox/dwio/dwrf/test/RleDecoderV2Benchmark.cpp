@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <random>
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+DEFINE_int32(num_values, 1'000'000, "Number of values decoded per iteration");
+
+namespace {
+// The bit widths of RLEv2 DIRECT runs with their encoded value.
+const std::vector<std::pair<uint32_t, uint8_t>> kBitWidths = {
+    {1, 0},   {2, 1},   {3, 2},   {4, 3},   {5, 4},   {6, 5},   {7, 6},
+    {8, 7},   {9, 8},   {10, 9},  {11, 10}, {12, 11}, {13, 12}, {14, 13},
+    {15, 14}, {16, 15}, {17, 16}, {18, 17}, {19, 18}, {20, 19}, {21, 20},
+    {22, 21}, {23, 22}, {24, 23}, {26, 24}, {28, 25}, {30, 26}, {32, 27},
+    {40, 28}, {48, 29}, {56, 30}, {64, 31}};
+
+// Returns 'numValues' random values of 'width' bits encoded in DIRECT runs.
+std::vector<unsigned char>
+encodeDirect(int32_t numValues, uint32_t width, uint8_t encodedWidth) {
+  constexpr int32_t kMaxRunLength = 512;
+  std::mt19937_64 random(width);
+  std::vector<unsigned char> bytes;
+  for (auto start = 0; start < numValues; start += kMaxRunLength) {
+    const auto length = std::min(kMaxRunLength, numValues - start);
+    bytes.push_back((1 << 6) | (encodedWidth << 1) | ((length - 1) >> 8));
+    bytes.push_back((length - 1) & 0xff);
+    uint64_t bit = 0;
+    for (auto i = 0; i < length; ++i) {
+      const auto value =
+          width == 64 ? random() : random() & ((1ULL << width) - 1);
+      for (int32_t j = width - 1; j >= 0; --j, ++bit) {
+        if (bit % 8 == 0) {
+          bytes.push_back(0);
+        }
+        if ((value >> j) & 1) {
+          bytes.back() |= 0x80 >> (bit % 8);
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+std::shared_ptr<memory::MemoryPool> pool;
+
+// Decodes 'bytes' in batches of 1000 values, optionally with every third
+// value null.
+void decode(
+    uint32_t iters,
+    const std::vector<unsigned char>& bytes,
+    bool withNulls) {
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<int64_t> data(kBatchSize);
+  std::vector<uint64_t> nulls(bits::nwords(kBatchSize), bits::kNotNull64);
+  for (auto i = 2; withNulls && i < kBatchSize; i += 3) {
+    bits::setNull(nulls.data(), i);
+  }
+  // The number of values read from the stream per batch.
+  const auto numNonNulls = bits::countBits(nulls.data(), 0, kBatchSize);
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto decoder = createRleDecoder<false>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            bytes.data(), bytes.size()),
+        RleVersion_2,
+        *pool,
+        false,
+        dwio::common::INT_BYTE_SIZE);
+    for (auto row = 0; row + numNonNulls <= FLAGS_num_values;
+         row += numNonNulls) {
+      decoder->next(
+          data.data(), kBatchSize, withNulls ? nulls.data() : nullptr);
+      folly::doNotOptimizeAway(data);
+    }
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  std::vector<std::vector<unsigned char>> streams;
+  streams.reserve(kBitWidths.size());
+  for (const auto& [width, encodedWidth] : kBitWidths) {
+    streams.push_back(encodeDirect(FLAGS_num_values, width, encodedWidth));
+    const auto* bytes = &streams.back();
+    for (const bool withNulls : {false, true}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("direct{}{}", width, withNulls ? "_nulls" : ""),
+          [bytes, withNulls](unsigned iters) {
+            decode(iters, *bytes, withNulls);
+            return iters;
+          });
+    }
+  }
+  folly::runBenchmarks();
+  pool.reset();
+  return 0;
+}
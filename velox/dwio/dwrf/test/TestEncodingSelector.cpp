@@ -17,6 +17,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
+#include "velox/dwio/dwrf/writer/IntegerEncodingSelector.h"
 
 using namespace facebook::velox::memory;
 
@@ -218,4 +219,45 @@ TEST_F(EntropyEncodingSelectorTests, Sampling) {
   }
 }
 
+TEST_F(EntropyEncodingSelectorTests, integerEstimate) {
+  auto pool = memoryManager()->addLeafPool();
+  {
+    IntegerDictionaryEncoder<int64_t> encoder{*pool, *pool};
+    for (auto key : {5, 5, 300}) {
+      encoder.addKey(key);
+    }
+    const auto estimate = IntegerEncodingSelector::estimate(encoder, true);
+    // 5 takes one byte and 300 two bytes as zigzag varints.
+    EXPECT_EQ(4, estimate.directBytes);
+    // The repeating 5 is a dictionary entry and two one byte indices, 300 is
+    // written unsigned in two bytes, plus a byte of IN_DICTIONARY bits.
+    EXPECT_EQ(6, estimate.dictionaryBytes);
+    EXPECT_FALSE(estimate.useDictionary());
+  }
+  {
+    // Few distinct small values. The key size ratio would pick a dictionary
+    // but the indices are as wide as the values.
+    IntegerDictionaryEncoder<int64_t> encoder{*pool, *pool};
+    for (auto i = 0; i < 1'000; ++i) {
+      encoder.addKey(i % 10);
+    }
+    EXPECT_FALSE(
+        IntegerEncodingSelector::estimate(encoder, true).useDictionary());
+  }
+  {
+    // Repeating wide values.
+    IntegerDictionaryEncoder<int64_t> encoder{*pool, *pool};
+    for (auto i = 0; i < 1'000; ++i) {
+      encoder.addKey(1'000'000'000'000'000L + i % 100);
+    }
+    const auto estimate = IntegerEncodingSelector::estimate(encoder, true);
+    EXPECT_EQ(8'000, estimate.directBytes);
+    EXPECT_EQ(1'800, estimate.dictionaryBytes);
+    EXPECT_TRUE(estimate.useDictionary());
+    // Without varints, the indices are as wide as the values.
+    EXPECT_FALSE(
+        IntegerEncodingSelector::estimate(encoder, false).useDictionary());
+  }
+}
+
 } // namespace facebook::velox::dwrf
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/SeekableInputStream.h"
@@ -3065,3 +3067,126 @@ TEST_F(RLEv1Test, testLeadingNulls) {
     EXPECT_EQ(i - 4, data[i]) << "Output wrong at " << i;
   }
 }
+
+namespace {
+// Returns the encoded width of 'width' bits in an RLEv2 header.
+uint8_t encodeBitWidth(uint32_t width) {
+  if (width <= 24) {
+    return width - 1;
+  }
+  switch (width) {
+    case 26:
+      return 24;
+    case 28:
+      return 25;
+    case 30:
+      return 26;
+    case 32:
+      return 27;
+    case 40:
+      return 28;
+    case 48:
+      return 29;
+    case 56:
+      return 30;
+    default:
+      return 31;
+  }
+}
+
+// Appends DIRECT runs of 'values' with 'width' bits each to 'bytes'.
+void encodeDirect(
+    const std::vector<uint64_t>& values,
+    uint32_t width,
+    std::vector<unsigned char>& bytes) {
+  constexpr size_t kMaxRunLength = 512;
+  for (size_t start = 0; start < values.size(); start += kMaxRunLength) {
+    const auto length = std::min(kMaxRunLength, values.size() - start);
+    bytes.push_back(
+        (1 << 6) | (encodeBitWidth(width) << 1) | ((length - 1) >> 8));
+    bytes.push_back((length - 1) & 0xff);
+    uint64_t bit = 0;
+    for (auto i = start; i < start + length; ++i) {
+      for (int32_t j = width - 1; j >= 0; --j, ++bit) {
+        if (bit % 8 == 0) {
+          bytes.push_back(0);
+        }
+        if ((values[i] >> j) & 1) {
+          bytes.back() |= 0x80 >> (bit % 8);
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+TEST_F(RLEv2Test, directAllBitWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  constexpr int32_t kNumValues = 1'500;
+  std::mt19937_64 random(1);
+  const uint32_t widths[] = {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+                             12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
+                             23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+  for (const auto width : widths) {
+    std::vector<uint64_t> values(kNumValues);
+    for (auto& value : values) {
+      value = width == 64 ? random() : random() & ((1ULL << width) - 1);
+    }
+    std::vector<unsigned char> bytes;
+    encodeDirect(values, width, bytes);
+
+    // Every third row is null when 'withNulls' is set. The stream has only
+    // the non-null values.
+    std::vector<uint64_t> nulls(bits::nwords(kNumValues * 2));
+    std::vector<uint64_t> expected;
+    for (auto i = 0, next = 0; next < kNumValues; ++i) {
+      const bool isNull = i % 3 == 2;
+      bits::setNull(nulls.data(), i, isNull);
+      expected.push_back(isNull ? 0 : values[next++]);
+    }
+
+    // Block sizes of 0 and 13 read the stream in one buffer and in buffers
+    // that end in the middle of values.
+    for (const auto blockSize : {0, 13}) {
+      for (const bool withNulls : {false, true}) {
+        for (const auto batchSize : {1, 7, 100, kNumValues}) {
+          SCOPED_TRACE(fmt::format(
+              "width {} blockSize {} withNulls {} batchSize {}",
+              width,
+              blockSize,
+              withNulls,
+              batchSize));
+          auto rle = createRleDecoder<false>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  bytes.data(), bytes.size(), blockSize),
+              RleVersion_2,
+              *pool,
+              true /* doesn't matter */,
+              dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+          const auto& expectedValues = withNulls ? expected : values;
+          std::vector<int64_t> data(batchSize);
+          std::vector<uint64_t> batchNulls(bits::nwords(batchSize));
+          for (auto row = 0; row < expectedValues.size(); row += batchSize) {
+            const auto numRows =
+                std::min<int32_t>(batchSize, expectedValues.size() - row);
+            for (auto i = 0; i < numRows; ++i) {
+              bits::setNull(
+                  batchNulls.data(),
+                  i,
+                  bits::isBitNull(nulls.data(), row + i));
+            }
+            rle->next(
+                data.data(), numRows, withNulls ? batchNulls.data() : nullptr);
+            for (auto i = 0; i < numRows; ++i) {
+              if (!withNulls || !bits::isBitNull(nulls.data(), row + i)) {
+                ASSERT_EQ(
+                    data[i], static_cast<int64_t>(expectedValues[row + i]))
+                    << row + i;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -243,6 +243,62 @@ TEST_F(StripeStreamTest, filterSequences) {
   }
 }
 
+TEST_F(StripeStreamTest, visitStreamsOfNode) {
+  google::protobuf::Arena arena;
+  auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(&arena);
+  footer->set_rowindexstride(100);
+  auto type = HiveTypeParser().parse("struct<a:int,b:float>");
+  ProtoUtils::writeType(*type, *footer);
+  auto readerBase = std::make_shared<ReaderBase>(
+      *pool_,
+      std::make_unique<BufferedInput>(
+          std::make_unique<RecordingInputStream>(), *pool_),
+      std::make_unique<PostScript>(proto::PostScript{}),
+      footer,
+      nullptr);
+  ColumnSelector cs{readerBase->schema(), std::vector<uint64_t>{1, 2}, true};
+  auto stripeFooter = std::make_unique<proto::StripeFooter>();
+  std::vector<std::tuple<uint64_t, StreamKind, uint64_t>> ss{
+      std::make_tuple(1, StreamKind::StreamKind_ROW_INDEX, 100),
+      std::make_tuple(2, StreamKind::StreamKind_ROW_INDEX, 100),
+      std::make_tuple(1, StreamKind::StreamKind_PRESENT, 200),
+      std::make_tuple(2, StreamKind::StreamKind_PRESENT, 200),
+      std::make_tuple(1, StreamKind::StreamKind_DATA, 5000000),
+      std::make_tuple(2, StreamKind::StreamKind_DATA, 1000000)};
+  for (const auto& s : ss) {
+    auto&& stream = stripeFooter->add_streams();
+    stream->set_node(std::get<0>(s));
+    stream->set_kind(static_cast<proto::Stream_Kind>(std::get<1>(s)));
+    stream->set_length(std::get<2>(s));
+  }
+  TestDecrypterFactory factory;
+  auto handler = DecryptionHandler::create(FooterWrapper(footer), &factory);
+  auto stripeMetadata = std::make_unique<const StripeMetadata>(
+      readerBase->bufferedInput().clone(),
+      std::move(stripeFooter),
+      std::move(handler),
+      StripeInformationWrapper(
+          static_cast<const proto::StripeInformation*>(nullptr)));
+  auto stripeReadState =
+      std::make_shared<StripeReadState>(readerBase, std::move(stripeMetadata));
+  auto streams = createAndLoadStripeStreams(stripeReadState, cs);
+
+  // The streams of a node are visited in file order.
+  auto visitOffsets = [&](uint32_t node) {
+    std::vector<uint64_t> offsets;
+    const auto count = streams.visitStreamsOfNode(
+        node,
+        [&](const StreamInformation& info) {
+          offsets.push_back(info.getOffset());
+        });
+    EXPECT_EQ(count, offsets.size());
+    return offsets;
+  };
+  EXPECT_EQ(visitOffsets(1), (std::vector<uint64_t>{0, 200, 600}));
+  EXPECT_EQ(visitOffsets(2), (std::vector<uint64_t>{100, 400, 5000600}));
+  EXPECT_TRUE(visitOffsets(3).empty());
+}
+
 TEST_F(StripeStreamTest, zeroLength) {
   google::protobuf::Arena arena;
   auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(&arena);
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Collects the Bloom filter of each row group of a column and writes them to
+/// the BLOOM_FILTER_UTF8 stream of the column at stripe flush. Has one entry
+/// per entry of the row index.
+class BloomFilterIndexBuilder {
+ public:
+  BloomFilterIndexBuilder(
+      std::unique_ptr<dwio::common::BufferedOutputStream> out,
+      uint64_t expectedEntries,
+      double fpp)
+      : out_{std::move(out)}, filter_{expectedEntries, fpp} {}
+
+  void addLong(int64_t value) {
+    filter_.addLong(value);
+  }
+
+  void addBytes(std::string_view value) {
+    filter_.addBytes(value);
+  }
+
+  /// Closes the filter of the current row group.
+  void addEntry() {
+    filter_.serialize(*index_.add_bloomfilter());
+    filter_.reset();
+  }
+
+  void flush() {
+    index_.SerializeToZeroCopyStream(out_.get());
+    out_->flush();
+    index_.Clear();
+  }
+
+ private:
+  const std::unique_ptr<dwio::common::BufferedOutputStream> out_;
+  BloomFilter filter_;
+  proto::BloomFilterIndex index_;
+};
+
+} // namespace facebook::velox::dwrf
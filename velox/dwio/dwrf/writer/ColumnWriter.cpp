@@ -17,11 +17,13 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/FlatMapColumnWriter.h"
 #include "velox/dwio/dwrf/writer/IntegerDictionaryEncoder.h"
+#include "velox/dwio/dwrf/writer/IntegerEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilderUtils.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
@@ -35,7 +37,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localSelected = context_.getLocalSelectivityVector(slice->size());
+  auto& selected = localSelected.get();
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -210,12 +213,15 @@ class IntegerColumnWriter : public BaseColumnWriter {
             /*initialCapacity=*/16},
         dictionaryKeySizeThreshold_{
             getConfig(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD)},
+        costBasedSelection_{
+            getConfig(Config::DICTIONARY_NUMERIC_COST_BASED_SELECTION)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
     DWIO_ENSURE_LE(dictionaryKeySizeThreshold_, 1.0);
     DWIO_ENSURE(firstStripe_);
+    initBloomFilter();
     if (!useDictionaryEncoding_) {
       // Suppress the stream used to initialize dictionary encoder.
       // TODO: passing factory method into the dict encoder also works
@@ -302,6 +308,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -408,6 +417,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
     // TODO(T91508412): Move the dictionary efficiency based decision into
     // dictionary encoder.
     auto totalElementCount = dictEncoder_.getTotalCount();
+    if (costBasedSelection_) {
+      return totalElementCount != 0 && selectByCost();
+    }
     return totalElementCount != 0 &&
         // TODO: wonder if this should be final dictionary size instead. In that
         // case, might be better off passing in the dict size and row size
@@ -417,6 +429,25 @@ class IntegerColumnWriter : public BaseColumnWriter {
         dictionaryKeySizeThreshold_;
   }
 
+  // Chooses the encoding by the estimated encoded sizes and logs the choice.
+  bool selectByCost() const {
+    const auto estimate = IntegerEncodingSelector::estimate(
+        dictEncoder_, getConfig(Config::USE_VINTS));
+    dwio::common::MetricsLog::EncodingSelectionMetrics metrics;
+    metrics.writerVersion =
+        writerVersionToString(getConfig(Config::WRITER_VERSION));
+    metrics.stripeIndex = context_.stripeIndex();
+    metrics.node = type_.id();
+    metrics.sequence = sequence_;
+    metrics.numValues = dictEncoder_.getTotalCount();
+    metrics.numDistinctValues = dictEncoder_.size();
+    metrics.estimatedDictionarySize = estimate.dictionaryBytes;
+    metrics.estimatedDirectSize = estimate.directBytes;
+    metrics.dictionary = estimate.useDictionary();
+    context_.metricLogger()->logEncodingSelection(metrics);
+    return metrics.dictionary;
+  }
+
   // Should be called only once per stripe for both flushing and abandoning
   // dictionary encoding.
   void populateStrides(
@@ -468,6 +499,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
   ChainedBuffer<uint32_t> rows_;
   size_t finalDictionarySize_;
   const float dictionaryKeySizeThreshold_;
+  const bool costBasedSelection_;
   const bool sort_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
@@ -517,6 +549,9 @@ uint64_t IntegerColumnWriter<T>::writeDict(
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
     statsBuilder.addValues(value);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addLong(value);
+    }
   };
 
   uint64_t nullCount = 0;
@@ -559,6 +594,13 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
       ranges);
+  if (bloomFilterBuilder_) {
+    for (auto& pos : ranges) {
+      if (!nulls || !bits::isBitNull(nulls, pos)) {
+        bloomFilterBuilder_->addLong(vals[pos]);
+      }
+    }
+  }
   auto rawSize = count * sizeof(T) + (ranges.size() - count) * NULL_SIZE;
   indexStatsBuilder_->increaseRawSize(rawSize);
   return rawSize;
@@ -816,6 +858,7 @@ class StringColumnWriter : public BaseColumnWriter {
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE(firstStripe_);
+    initBloomFilter();
     if (!useDictionaryEncoding_) {
       initStreamWriters(useDictionaryEncoding_);
     }
@@ -903,6 +946,9 @@ class StringColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -1121,6 +1167,9 @@ uint64_t StringColumnWriter::writeDict(
     auto sp = decodedVector.valueAt<StringView>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
     statsBuilder.addValues(sp);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addBytes(std::string_view(sp));
+    }
     rawSize += sp.size();
   };
 
@@ -1166,6 +1215,9 @@ uint64_t StringColumnWriter::writeDirect(
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
     statsBuilder.addValues(sp);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addBytes(std::string_view(sp));
+    }
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1634,7 +1686,21 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && isRoot() && context_.encodingParallelism() > 1) {
+    // The top level columns are independent and are encoded in parallel.
+    std::vector<uint64_t> childRawSizes(children_.size());
+    dwio::common::ParallelFor(
+        context_.encodingExecutor().get(),
+        0,
+        children_.size(),
+        context_.encodingParallelism())
+        .execute([&](size_t i) {
+          childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+        });
+    for (auto childRawSize : childRawSizes) {
+      rawSize += childRawSize;
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
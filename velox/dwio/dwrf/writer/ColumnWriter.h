@@ -21,6 +21,7 @@
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
+#include "velox/dwio/dwrf/writer/BloomFilterIndexBuilder.h"
 #include "velox/dwio/dwrf/writer/IndexBuilder.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 #include "velox/dwio/dwrf/writer/WriterContext.h"
@@ -117,6 +118,9 @@ class BaseColumnWriter : public ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->flush();
+    }
   }
 
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
@@ -247,6 +251,24 @@ class BaseColumnWriter : public ColumnWriter {
     return context_.indexEnabled();
   }
 
+  /// Creates 'bloomFilterBuilder_' if 'this' is a top level column listed in
+  /// Config::BLOOM_FILTER_COLS. Called by the writers of the supported types.
+  void initBloomFilter() {
+    if (!isIndexEnabled() || sequence_ != 0 || type_.parent() == nullptr ||
+        type_.parent()->id() != 0) {
+      return;
+    }
+    const auto& columns = getConfig(Config::BLOOM_FILTER_COLS);
+    if (std::find(columns.begin(), columns.end(), type_.column()) ==
+        columns.end()) {
+      return;
+    }
+    bloomFilterBuilder_ = std::make_unique<BloomFilterIndexBuilder>(
+        newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8),
+        context_.indexStride(),
+        getConfig(Config::BLOOM_FILTER_FPP));
+  }
+
   virtual bool useDictionaryEncoding() const {
     return (sequence_ == 0 ||
             !context_.getConfig(Config::MAP_FLAT_DISABLE_DICT_ENCODING)) &&
@@ -260,6 +282,8 @@ class BaseColumnWriter : public ColumnWriter {
   const dwio::common::TypeWithId& type_;
   std::vector<std::unique_ptr<BaseColumnWriter>> children_;
   std::unique_ptr<IndexBuilder> indexBuilder_;
+  // Set if the column has Bloom filters.
+  std::unique_ptr<BloomFilterIndexBuilder> bloomFilterBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Varint.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/dwrf/writer/IntegerDictionaryEncoder.h"
+
+namespace facebook::velox::dwrf {
+
+/// Chooses between dictionary and direct encoding of an integer column by
+/// estimating the encoded size of both from the distinct values and their
+/// counts in the dictionary encoder. The key size ratio threshold only looks
+/// at the number of distinct values, which mispredicts when the values are
+/// narrow, e.g. a repeating column of small numbers gains nothing from a
+/// dictionary, or wide with moderate repetition. The estimate does not model
+/// run length encoding, which applies to the data stream of both encodings.
+class IntegerEncodingSelector {
+ public:
+  struct Estimate {
+    /// Estimated bytes of the DICTIONARY_DATA, IN_DICTIONARY and DATA streams
+    /// with dictionary encoding.
+    uint64_t dictionaryBytes{0};
+    /// Estimated bytes of the DATA stream with direct encoding.
+    uint64_t directBytes{0};
+
+    bool useDictionary() const {
+      return dictionaryBytes < directBytes;
+    }
+  };
+
+  /// Estimates the encoded sizes for the values added to 'dictEncoder'.
+  /// 'useVInts' is true if the integer streams are varint encoded.
+  template <typename T>
+  static Estimate estimate(
+      const IntegerDictionaryEncoder<T>& dictEncoder,
+      bool useVInts) {
+    Estimate estimate;
+    const auto numKeys = dictEncoder.size();
+    uint64_t numValues = 0;
+    // Index of the next key written to the dictionary. As in the encoder,
+    // only keys that repeat are kept.
+    uint32_t dictionaryIndex = 0;
+    for (uint32_t i = 0; i < numKeys; ++i) {
+      const auto key = static_cast<int64_t>(dictEncoder.getKey(i));
+      const auto count = dictEncoder.getCount(i);
+      numValues += count;
+      const auto signedBytes =
+          valueBytes<T>(folly::encodeZigZag(key), useVInts);
+      estimate.directBytes += count * signedBytes;
+      if (count > 1) {
+        estimate.dictionaryBytes += signedBytes +
+            count * valueBytes<T>(dictionaryIndex++, useVInts);
+      } else {
+        // Values not in the dictionary are written as is to the unsigned
+        // DATA stream.
+        estimate.dictionaryBytes +=
+            valueBytes<T>(static_cast<uint64_t>(key), useVInts);
+      }
+    }
+    // IN_DICTIONARY is a bit per value and omitted if all keys repeat.
+    if (dictionaryIndex < numKeys) {
+      estimate.dictionaryBytes += bits::nbytes(numValues);
+    }
+    return estimate;
+  }
+
+ private:
+  template <typename T>
+  static uint64_t valueBytes(uint64_t value, bool useVInts) {
+    return useVInts ? folly::encodeVarintSize(value) : sizeof(T);
+  }
+};
+
+} // namespace facebook::velox::dwrf
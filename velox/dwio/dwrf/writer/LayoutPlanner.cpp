@@ -233,7 +233,10 @@ struct MapKeyEqual {
 
 } // namespace
 
-LayoutPlanner::LayoutPlanner(const dwio::common::TypeWithId& schema) {
+LayoutPlanner::LayoutPlanner(
+    const dwio::common::TypeWithId& schema,
+    ColumnAccessFrequency accessFrequency)
+    : accessFrequency_{std::move(accessFrequency)} {
   fillNodeToColumnMap(schema, nodeToColumnMap_);
 }
 
@@ -248,8 +251,8 @@ LayoutResult LayoutPlanner::plan(
   auto flatMapCols = getFlatMapColumns(encoding, nodeToColumnMap_);
 
   // sort streams
-  sortBySize(streams.begin(), iter, flatMapCols);
-  sortBySize(iter, streams.end(), flatMapCols);
+  sortBySize(streams.begin(), iter, flatMapCols, accessFrequency_);
+  sortBySize(iter, streams.end(), flatMapCols, accessFrequency_);
 
   return LayoutResult{std::move(streams), indexCount};
 }
@@ -257,7 +260,8 @@ LayoutResult LayoutPlanner::plan(
 void LayoutPlanner::sortBySize(
     StreamList::iterator begin,
     StreamList::iterator end,
-    const folly::F14FastSet<uint32_t>& flatMapCols) {
+    const folly::F14FastSet<uint32_t>& flatMapCols,
+    const ColumnAccessFrequency& accessFrequency) {
   // calculate node size
   folly::F14FastMap<uint32_t, uint64_t> nodeSize;
   folly::F14FastMap<MapKey, uint64_t, MapKeyHash, MapKeyEqual> flatMapNodeSize;
@@ -277,7 +281,22 @@ void LayoutPlanner::sortBySize(
     }
   }
 
+  const auto frequency = [&](uint32_t column) -> uint64_t {
+    const auto it = accessFrequency.find(column);
+    return it == accessFrequency.end() ? 0 : it->second;
+  };
+
   std::sort(begin, end, [&](auto& a, auto& b) {
+    // 0. Place the streams of more frequently read columns first. Without a
+    // frequency hint, all columns have the same frequency.
+    if (!accessFrequency.empty()) {
+      const auto frequencyA = frequency(a.first->column());
+      const auto frequencyB = frequency(b.first->column());
+      if (frequencyA != frequencyB) {
+        return frequencyA > frequencyB;
+      }
+    }
+
     // 1. Sort based on flatmap or not. Place streams of non-flatmaps before
     // those of flatmaps. Within flatmap, sort by column and sequence. Lowest
     // first.
@@ -125,9 +125,20 @@ class LayoutResult {
   const size_t indexCount_;
 };
 
+/// Relative read frequency of the top level columns by column index, e.g.
+/// the bytes read per column as recorded by cache::ScanTracker on the query
+/// side. Columns not in the map have frequency 0.
+using ColumnAccessFrequency = folly::F14FastMap<uint32_t, uint64_t>;
+
 class LayoutPlanner {
  public:
-  explicit LayoutPlanner(const dwio::common::TypeWithId& schema);
+  /// Streams of columns with a higher 'accessFrequency' are placed before the
+  /// others in both the index and the data sections of a stripe. This keeps
+  /// the columns that are read together adjacent so that their reads coalesce
+  /// into fewer and larger IOs.
+  explicit LayoutPlanner(
+      const dwio::common::TypeWithId& schema,
+      ColumnAccessFrequency accessFrequency = {});
   virtual ~LayoutPlanner() = default;
 
   virtual LayoutResult plan(
@@ -138,7 +149,8 @@ class LayoutPlanner {
   static void sortBySize(
       StreamList::iterator begin,
       StreamList::iterator end,
-      const folly::F14FastSet<uint32_t>& flatMapCols);
+      const folly::F14FastSet<uint32_t>& flatMapCols,
+      const ColumnAccessFrequency& accessFrequency = {});
 
   // This method assumes flatmap can only be top level fields, which is enforced
   // through the way how flatmap is configured.
@@ -147,6 +159,7 @@ class LayoutPlanner {
       const folly::F14FastMap<uint32_t, uint32_t>& nodeToColumnMap);
 
   folly::F14FastMap<uint32_t, uint32_t> nodeToColumnMap_;
+  const ColumnAccessFrequency accessFrequency_;
 
   VELOX_FRIEND_TEST(LayoutPlannerTests, Basic);
 };
@@ -90,6 +90,13 @@ Writer::Writer(
   writerBase_->initBuffers();
 
   context.buildPhysicalSizeAggregators(*schema_);
+  // Flat map writers add streams while writing and the encrypters are shared
+  // between streams, so these are written serially.
+  if (!context.getConfig(Config::FLATTEN_MAP) &&
+      !context.getEncryptionHandler().isEncrypted()) {
+    context.setEncodingExecutor(
+        options.encodingExecutor, options.encodingParallelism);
+  }
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -101,7 +108,8 @@ Writer::Writer(
   if (options.layoutPlannerFactory != nullptr) {
     layoutPlanner_ = options.layoutPlannerFactory(*schema_);
   } else {
-    layoutPlanner_ = std::make_unique<LayoutPlanner>(*schema_);
+    layoutPlanner_ = std::make_unique<LayoutPlanner>(
+        *schema_, options.columnAccessFrequency);
   }
 
   if (options.columnWriterFactory == nullptr) {
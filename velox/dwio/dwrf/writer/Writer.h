@@ -35,6 +35,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   /// Changes the interface to stream list and encoding iter.
   std::function<std::unique_ptr<LayoutPlanner>(const dwio::common::TypeWithId&)>
       layoutPlannerFactory;
+  /// Read frequency hint for the default LayoutPlanner. Ignored with
+  /// 'layoutPlannerFactory'.
+  ColumnAccessFrequency columnAccessFrequency;
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
@@ -44,6 +47,12 @@ struct WriterOptions : public dwio::common::WriterOptions {
       columnWriterFactory;
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
+  /// Optional executor for encoding the top level columns of each batch in
+  /// parallel. 'encodingParallelism' is the number of columns encoded at a
+  /// time, including the writing thread. Has no effect with flat map columns or
+  /// encryption.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelism{1};
 };
 
 class Writer : public dwio::common::Writer {
@@ -159,12 +159,13 @@ int64_t WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  extraCompressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
   decodedVectorPool_.clear();
   decodedVectorPool_.shrink_to_fit();
-  selectivityVector_.reset();
+  selectivityVectorPool_.clear();
   releaseMemoryReservation();
 }
 } // namespace facebook::velox::dwrf
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -258,6 +260,17 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ == nullptr && encodingParallelism_ > 1) {
+      // Another column writer compresses in parallel.
+      if (!extraCompressionBuffers_.empty()) {
+        auto buffer = std::move(extraCompressionBuffers_.back());
+        extraCompressionBuffers_.pop_back();
+        return buffer;
+      }
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -266,6 +279,11 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ != nullptr && encodingParallelism_ > 1) {
+      extraCompressionBuffers_.push_back(std::move(buffer));
+      return;
+    }
     VELOX_CHECK_NULL(compressionBuffer_);
     compressionBuffer_ = std::move(buffer);
   }
@@ -582,13 +600,47 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
+  class LocalSelectivityVector {
+   public:
+    LocalSelectivityVector(WriterContext& context, vector_size_t size)
+        : context_(context), vector_(context_.getSelectivityVector(size)) {}
+
+    ~LocalSelectivityVector() {
+      if (vector_) {
+        context_.releaseSelectivityVector(std::move(vector_));
+      }
     }
-    return *selectivityVector_;
+
+    SelectivityVector& get() {
+      return *vector_;
+    }
+
+   private:
+    WriterContext& context_;
+    std::unique_ptr<velox::SelectivityVector> vector_;
+  };
+
+  LocalSelectivityVector getLocalSelectivityVector(vector_size_t size) {
+    return LocalSelectivityVector{*this, size};
+  }
+
+  /// Sets the executor for encoding the top level columns of each batch in
+  /// parallel. 'parallelism' is the number of columns encoded at a time,
+  /// including the writing thread. Must be set before creating the column
+  /// writers.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelism) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelism_ = encodingExecutor_ ? parallelism : 1;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelism() const {
+    return encodingParallelism_;
   }
 
   void abort();
@@ -609,6 +661,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -618,9 +671,33 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector(
+      vector_size_t size) {
+    std::unique_ptr<velox::SelectivityVector> vector;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!selectivityVectorPool_.empty()) {
+        vector = std::move(selectivityVectorPool_.back());
+        selectivityVectorPool_.pop_back();
+      }
+    }
+    if (vector == nullptr) {
+      return std::make_unique<velox::SelectivityVector>(size);
+    }
+    vector->resize(size);
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   const std::shared_ptr<const Config> config_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -658,11 +735,20 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelism_{1};
+  // Serializes access to the compression buffers and the decoding pools
+  // below, which column writers encoding in parallel share.
+  std::mutex mutex_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers beyond 'compressionBuffer_' for streams compressed in
+  // parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors.
+  std::vector<std::unique_ptr<velox::SelectivityVector>> selectivityVectorPool_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
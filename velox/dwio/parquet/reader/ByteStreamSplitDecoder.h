@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+// Transposes kBatch values of 4 bytes from the 4 streams starting at 'data' +
+// 'begin' into 'out'. Interleaves pairs of byte streams and then pairs of 2
+// byte units.
+inline void byteStreamSplitBatch4(
+    const uint8_t* data,
+    int64_t numValues,
+    int64_t begin,
+    uint8_t* out) {
+  using U8 = xsimd::batch<uint8_t>;
+  using U16 = xsimd::batch<uint16_t>;
+  U8 streams[4];
+  for (auto i = 0; i < 4; ++i) {
+    streams[i] = U8::load_unaligned(data + i * numValues + begin);
+  }
+  // pairs[2 * k + h] has bytes 2k and 2k + 1 of half 'h' of the values.
+  U16 pairs[4];
+  for (auto k = 0; k < 2; ++k) {
+    pairs[2 * k] = xsimd::bitwise_cast<uint16_t>(
+        xsimd::zip_lo(streams[2 * k], streams[2 * k + 1]));
+    pairs[2 * k + 1] = xsimd::bitwise_cast<uint16_t>(
+        xsimd::zip_hi(streams[2 * k], streams[2 * k + 1]));
+  }
+  for (auto half = 0; half < 2; ++half) {
+    xsimd::zip_lo(pairs[half], pairs[half + 2])
+        .store_unaligned(reinterpret_cast<uint16_t*>(out));
+    out += U8::size;
+    xsimd::zip_hi(pairs[half], pairs[half + 2])
+        .store_unaligned(reinterpret_cast<uint16_t*>(out));
+    out += U8::size;
+  }
+}
+
+// Same as byteStreamSplitBatch4() for 8 byte values. Interleaves 1, 2 and 4
+// byte units in turn.
+inline void byteStreamSplitBatch8(
+    const uint8_t* data,
+    int64_t numValues,
+    int64_t begin,
+    uint8_t* out) {
+  using U8 = xsimd::batch<uint8_t>;
+  using U16 = xsimd::batch<uint16_t>;
+  using U32 = xsimd::batch<uint32_t>;
+  U8 streams[8];
+  for (auto i = 0; i < 8; ++i) {
+    streams[i] = U8::load_unaligned(data + i * numValues + begin);
+  }
+  // pairs[2 * k + h] has bytes 2k and 2k + 1 of half 'h' of the values.
+  U16 pairs[8];
+  for (auto k = 0; k < 4; ++k) {
+    pairs[2 * k] = xsimd::bitwise_cast<uint16_t>(
+        xsimd::zip_lo(streams[2 * k], streams[2 * k + 1]));
+    pairs[2 * k + 1] = xsimd::bitwise_cast<uint16_t>(
+        xsimd::zip_hi(streams[2 * k], streams[2 * k + 1]));
+  }
+  // low[q] and high[q] have bytes 0-3 and 4-7 of quarter 'q' of the values.
+  U32 low[4];
+  U32 high[4];
+  for (auto h = 0; h < 2; ++h) {
+    low[2 * h] =
+        xsimd::bitwise_cast<uint32_t>(xsimd::zip_lo(pairs[h], pairs[2 + h]));
+    low[2 * h + 1] =
+        xsimd::bitwise_cast<uint32_t>(xsimd::zip_hi(pairs[h], pairs[2 + h]));
+    high[2 * h] = xsimd::bitwise_cast<uint32_t>(
+        xsimd::zip_lo(pairs[4 + h], pairs[6 + h]));
+    high[2 * h + 1] = xsimd::bitwise_cast<uint32_t>(
+        xsimd::zip_hi(pairs[4 + h], pairs[6 + h]));
+  }
+  for (auto q = 0; q < 4; ++q) {
+    xsimd::zip_lo(low[q], high[q])
+        .store_unaligned(reinterpret_cast<uint32_t*>(out));
+    out += U8::size;
+    xsimd::zip_hi(low[q], high[q])
+        .store_unaligned(reinterpret_cast<uint32_t*>(out));
+    out += U8::size;
+  }
+}
+
+} // namespace detail
+
+/// Decodes the BYTE_STREAM_SPLIT encoding. 'data' has 'width' streams of
+/// 'numValues' bytes each, stream 'i' containing byte 'i' of every value.
+/// Writes the 'numValues' values of 'width' bytes each to 'out' in PLAIN
+/// layout. Values of 4 and 8 bytes are transposed a SIMD batch at a time.
+inline void decodeByteStreamSplit(
+    const char* data,
+    int32_t width,
+    int64_t numValues,
+    char* out) {
+  constexpr int64_t kBatch = xsimd::batch<uint8_t>::size;
+  const auto* input = reinterpret_cast<const uint8_t*>(data);
+  auto* output = reinterpret_cast<uint8_t*>(out);
+  int64_t begin = 0;
+  if (width == 4) {
+    for (; begin + kBatch <= numValues; begin += kBatch) {
+      detail::byteStreamSplitBatch4(
+          input, numValues, begin, output + begin * width);
+    }
+  } else if (width == 8) {
+    for (; begin + kBatch <= numValues; begin += kBatch) {
+      detail::byteStreamSplitBatch8(
+          input, numValues, begin, output + begin * width);
+    }
+  }
+  for (auto i = begin; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      output[i * width + stream] = input[stream * numValues + i];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -210,6 +210,42 @@ bool ColumnChunkMetaDataPtr::hasDictionaryPageOffset() const {
       thriftColumnChunkPtr(ptr_)->meta_data.__isset.dictionary_page_offset;
 }
 
+bool ColumnChunkMetaDataPtr::hasBloomFilterOffset() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilterOffset());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  const auto& isset = thriftColumnChunkPtr(ptr_)->__isset;
+  return isset.column_index_offset && isset.column_index_length &&
+      isset.offset_index_offset && isset.offset_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
 std::unique_ptr<dwio::common::ColumnStatistics>
 ColumnChunkMetaDataPtr::getColumnStatistics(
     const TypePtr type,
@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Returns the statistics of 'type' in 'stats' for a range of 'numRows' rows,
+/// e.g. a column chunk or a page in the page index.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& stats,
+    const velox::Type& type,
+    uint64_t numRows);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -37,6 +48,27 @@ class ColumnChunkMetaDataPtr {
   /// Check the presence of the dictionary page offset in ColumnChunk metadata.
   bool hasDictionaryPageOffset() const;
 
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// The offset of the Bloom filter header and bitset. Must check for its
+  /// presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
+  /// Check the presence of both the ColumnIndex and the OffsetIndex, i.e. the
+  /// page index, of the ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// The location of the ColumnIndex. Must check for its presence using
+  /// hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// The location of the OffsetIndex. Must check for its presence using
+  /// hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
   /// Return the ColumnChunk statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> getColumnStatistics(
       const TypePtr type,
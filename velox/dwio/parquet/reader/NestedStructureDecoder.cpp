@@ -19,27 +19,21 @@
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::parquet {
-
-int64_t NestedStructureDecoder::readOffsetsAndNulls(
+namespace {
+// Fills 'offsets', 'lengths' and 'nulls' as described in
+// NestedStructureDecoder::readOffsetsAndNulls(). If 'kMayBeEmpty' is false,
+// 'maxDefinition' is at most 1, so that no value belongs to a null ancestor
+// and the checks for empty entries are compiled out.
+template <bool kMayBeEmpty>
+int64_t readOffsetsAndNullsImpl(
     const uint8_t* definitionLevels,
     const uint8_t* repetitionLevels,
     int64_t numValues,
     uint8_t maxDefinition,
     uint8_t maxRepeat,
-    BufferPtr& offsetsBuffer,
-    BufferPtr& lengthsBuffer,
-    BufferPtr& nullsBuffer,
-    memory::MemoryPool& pool) {
-  dwio::common::ensureCapacity<uint8_t>(
-      nullsBuffer, bits::nbytes(numValues), &pool);
-  dwio::common::ensureCapacity<vector_size_t>(
-      offsetsBuffer, numValues + 1, &pool);
-  dwio::common::ensureCapacity<vector_size_t>(lengthsBuffer, numValues, &pool);
-
-  auto offsets = offsetsBuffer->asMutable<vector_size_t>();
-  auto lengths = lengthsBuffer->asMutable<vector_size_t>();
-  auto nulls = nullsBuffer->asMutable<uint64_t>();
-
+    vector_size_t* offsets,
+    vector_size_t* lengths,
+    uint64_t* nulls) {
   int64_t offset = 0;
   int64_t lastOffset = 0;
   bool wasLastCollectionNull = definitionLevels[0] == (maxDefinition - 1);
@@ -53,7 +47,7 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
 
     // empty means it belongs to a row that is null in one of its ancestor
     // levels.
-    bool isEmpty = definitionLevel < (maxDefinition - 1);
+    bool isEmpty = kMayBeEmpty && definitionLevel < (maxDefinition - 1);
     bool isNull = definitionLevel == (maxDefinition - 1);
     bool isCollectionBegin = (repetitionLevel < maxRepeat) & !isEmpty;
     bool isEntryBegin = (repetitionLevel <= maxRepeat) & !isEmpty;
@@ -78,5 +72,47 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
 
   return outputIndex;
 }
+} // namespace
+
+int64_t NestedStructureDecoder::readOffsetsAndNulls(
+    const uint8_t* definitionLevels,
+    const uint8_t* repetitionLevels,
+    int64_t numValues,
+    uint8_t maxDefinition,
+    uint8_t maxRepeat,
+    BufferPtr& offsetsBuffer,
+    BufferPtr& lengthsBuffer,
+    BufferPtr& nullsBuffer,
+    memory::MemoryPool& pool) {
+  dwio::common::ensureCapacity<uint8_t>(
+      nullsBuffer, bits::nbytes(numValues), &pool);
+  dwio::common::ensureCapacity<vector_size_t>(
+      offsetsBuffer, numValues + 1, &pool);
+  dwio::common::ensureCapacity<vector_size_t>(lengthsBuffer, numValues, &pool);
+
+  auto offsets = offsetsBuffer->asMutable<vector_size_t>();
+  auto lengths = lengthsBuffer->asMutable<vector_size_t>();
+  auto nulls = nullsBuffer->asMutable<uint64_t>();
+  if (maxDefinition <= 1) {
+    return readOffsetsAndNullsImpl<false>(
+        definitionLevels,
+        repetitionLevels,
+        numValues,
+        maxDefinition,
+        maxRepeat,
+        offsets,
+        lengths,
+        nulls);
+  }
+  return readOffsetsAndNullsImpl<true>(
+      definitionLevels,
+      repetitionLevels,
+      numValues,
+      maxDefinition,
+      maxRepeat,
+      offsets,
+      lengths,
+      nulls);
+}
 
 } // namespace facebook::velox::parquet
@@ -50,6 +50,13 @@ void PageReader::seekToPage(int64_t row) {
     }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+    if (pageHeader.type == thrift::PageType::DATA_PAGE ||
+        pageHeader.type == thrift::PageType::DATA_PAGE_V2) {
+      ++dataPageIndex_;
+      pagePruned_ =
+          dataPageIndex_ < static_cast<int32_t>(prunedPages_.size()) &&
+          prunedPages_[dataPageIndex_];
+    }
 
     switch (pageHeader.type) {
       case thrift::PageType::DATA_PAGE:
@@ -131,6 +138,29 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  if (codec_ == common::CompressionKind::CompressionKind_NONE) {
+    return pageData;
+  }
+  if (codec_ != common::CompressionKind::CompressionKind_ZLIB &&
+      codec_ != common::CompressionKind::CompressionKind_GZIP) {
+    if (!decompressor_) {
+      decompressor_ = dwio::common::compression::createBlockDecompressor(
+          codec_,
+          uncompressedSize,
+          getParquetDecompressionOptions(codec_),
+          fmt::format("Page Reader: Stream {}", inputStream_->getName()));
+    }
+    dwio::common::ensureCapacity<char>(
+        decompressedData_, uncompressedSize, &pool_);
+    const auto size = decompressor_->decompress(
+        pageData,
+        compressedSize,
+        decompressedData_->asMutable<char>(),
+        uncompressedSize);
+    VELOX_CHECK_EQ(
+        size, uncompressedSize, "Unexpected decompressed size of page");
+    return decompressedData_->as<char>();
+  }
   std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
       std::make_unique<dwio::common::SeekableArrayInputStream>(
           pageData, compressedSize, 0);
@@ -175,7 +205,8 @@ void PageReader::setPageRowInfo(bool forRepDef) {
 void PageReader::readPageDefLevels() {
   VELOX_CHECK(kRowsUnknown == numRowsInPage_ || maxDefine_ > 1);
   definitionLevels_.resize(numRepDefsInPage_);
-  wideDefineDecoder_->GetBatch(definitionLevels_.data(), numRepDefsInPage_);
+  auto* levels = reinterpret_cast<uint16_t*>(definitionLevels_.data());
+  wideDefineDecoder_->next(levels, numRepDefsInPage_);
   leafNulls_.resize(bits::nwords(numRepDefsInPage_));
   leafNullsSize_ = getLengthsAndNulls(
       LevelMode::kNulls,
@@ -205,13 +236,16 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   numRepDefsInPage_ = pageHeader.data_page_header.num_values;
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
-      numRowsInPage_ + rowOfPage_ <= row) {
+      (pagePruned_ || numRowsInPage_ + rowOfPage_ <= row)) {
     dwio::common::skipBytes(
         pageHeader.compressed_page_size,
         inputStream_.get(),
         bufferStart_,
         bufferEnd_);
-
+    if (pagePruned_) {
+      // Keeps the dictionary state of the reader consistent with the page.
+      encoding_ = pageHeader.data_page_header.encoding;
+    }
     return;
   }
   pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
@@ -222,9 +256,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   auto pageEnd = pageData_ + pageHeader.uncompressed_page_size;
   if (maxRepeat_ > 0) {
     uint32_t repeatLength = readField<int32_t>(pageData_);
-    repeatDecoder_ = std::make_unique<arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
 
     pageData_ += repeatLength;
@@ -238,9 +272,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
           pageData_ + defineLength,
           ::arrow::bit_util::NumRequiredBits(maxDefine_));
     }
-    wideDefineDecoder_ = std::make_unique<arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        defineLength,
+    wideDefineDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + defineLength,
         ::arrow::bit_util::NumRequiredBits(maxDefine_));
     pageData_ += defineLength;
   }
@@ -261,12 +295,15 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   numRepDefsInPage_ = pageHeader.data_page_header_v2.num_values;
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
-      numRowsInPage_ + rowOfPage_ <= row) {
+      (pagePruned_ || numRowsInPage_ + rowOfPage_ <= row)) {
     skipBytes(
         pageHeader.compressed_page_size,
         inputStream_.get(),
         bufferStart_,
         bufferEnd_);
+    if (pagePruned_) {
+      encoding_ = pageHeader.data_page_header_v2.encoding;
+    }
     return;
   }
 
@@ -279,9 +316,9 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   pageData_ = readBytes(bytes, pageBuffer_);
 
   if (repeatLength) {
-    repeatDecoder_ = std::make_unique<arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
   }
 
@@ -290,6 +327,10 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         pageData_ + repeatLength,
         pageData_ + repeatLength + defineLength,
         ::arrow::bit_util::NumRequiredBits(maxDefine_));
+    wideDefineDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_ + repeatLength,
+        pageData_ + repeatLength + defineLength,
+        ::arrow::bit_util::NumRequiredBits(maxDefine_));
   }
   auto levelsSize = repeatLength + defineLength;
   pageData_ += levelsSize;
@@ -429,6 +470,31 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
     case thrift::Type::FIXED_LEN_BYTE_ARRAY: {
       auto parquetTypeLength = type_->typeLength_;
       auto numParquetBytes = dictionary_.numValues * parquetTypeLength;
+      if (type_->type()->isVarchar() || type_->type()->isVarbinary()) {
+        // Same layout as BYTE_ARRAY so that the values are read as
+        // DictionaryVectors over the dictionary of the column chunk.
+        dictionary_.values =
+            AlignedBuffer::allocate<StringView>(dictionary_.numValues, &pool_);
+        dictionary_.strings =
+            AlignedBuffer::allocate<char>(numParquetBytes, &pool_);
+        auto strings = dictionary_.strings->asMutable<char>();
+        if (pageData_) {
+          memcpy(strings, pageData_, numParquetBytes);
+        } else {
+          dwio::common::readBytes(
+              numParquetBytes,
+              inputStream_.get(),
+              strings,
+              bufferStart_,
+              bufferEnd_);
+        }
+        auto values = dictionary_.values->asMutable<StringView>();
+        for (auto i = 0; i < dictionary_.numValues; ++i) {
+          values[i] =
+              StringView(strings + i * parquetTypeLength, parquetTypeLength);
+        }
+        break;
+      }
       auto veloxTypeLength = type_->type()->cppSizeInBytes();
       auto numVeloxBytes = dictionary_.numValues * veloxTypeLength;
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
@@ -535,13 +601,15 @@ void PageReader::preloadRepDefs() {
     auto begin = definitionLevels_.size();
     auto numLevels = definitionLevels_.size() + numRepDefsInPage_;
     definitionLevels_.resize(numLevels);
-    wideDefineDecoder_->GetBatch(
-        definitionLevels_.data() + begin, numRepDefsInPage_);
+    // The levels are non-negative, so they are decoded as unsigned.
+    auto* levels = reinterpret_cast<uint16_t*>(definitionLevels_.data());
+    levels += begin;
+    wideDefineDecoder_->next(levels, numRepDefsInPage_);
     if (repeatDecoder_) {
       repetitionLevels_.resize(numLevels);
 
-      repeatDecoder_->GetBatch(
-          repetitionLevels_.data() + begin, numRepDefsInPage_);
+      levels = reinterpret_cast<uint16_t*>(repetitionLevels_.data()) + begin;
+      repeatDecoder_->next(levels, numRepDefsInPage_);
     }
     leafNulls_.resize(bits::nwords(leafNullsSize_ + numRepDefsInPage_));
     auto numLeaves = getLengthsAndNulls(
@@ -647,6 +715,9 @@ void PageReader::makeDecoder() {
       dictionaryIdDecoder_ = std::make_unique<RleBpDataDecoder>(
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      decodeByteStreamSplit();
+      FMT_FALLTHROUGH;
     case Encoding::PLAIN:
       switch (parquetType) {
         case thrift::Type::BOOLEAN:
@@ -698,11 +769,50 @@ void PageReader::makeDecoder() {
         break;
       }
       FMT_FALLTHROUGH;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType == thrift::Type::BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_ =
+            std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+        break;
+      }
+      FMT_FALLTHROUGH;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::decodeByteStreamSplit() {
+  int32_t width;
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::INT32:
+    case thrift::Type::FLOAT:
+      width = 4;
+      break;
+    case thrift::Type::INT64:
+    case thrift::Type::DOUBLE:
+      width = 8;
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      width = type_->typeLength_;
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "BYTE_STREAM_SPLIT is not supported for Parquet type {}",
+          thrift::to_string(type_->parquetType_.value()));
+  }
+  VELOX_CHECK_GT(width, 0);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % width,
+      0,
+      "BYTE_STREAM_SPLIT data size is not a multiple of the value width");
+  dwio::common::ensureCapacity<char>(
+      byteStreamSplitData_, encodedDataSize_, &pool_);
+  auto* values = byteStreamSplitData_->asMutable<char>();
+  parquet::decodeByteStreamSplit(
+      pageData_, width, encodedDataSize_ / width, values);
+  pageData_ = values;
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -718,7 +828,8 @@ void PageReader::skip(int64_t numRows) {
   }
   firstUnvisited_ += numRows;
 
-  if (toSkip == 0) {
+  // A pruned page has no decoders to skip.
+  if (toSkip == 0 || pagePruned_) {
     return;
   }
   // Skip nulls
@@ -740,6 +851,8 @@ void PageReader::skip(int64_t numRows) {
     deltaBpDecoder_->skip(toSkip);
   } else if (deltaByteArrDecoder_) {
     deltaByteArrDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrDecoder_) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -808,7 +921,7 @@ void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
 
 const uint64_t* FOLLY_NULLABLE
 PageReader::readNulls(int32_t numValues, BufferPtr& buffer) {
-  if (maxDefine_ == 0) {
+  if (maxDefine_ == 0 || pagePruned_) {
     buffer = nullptr;
     return nullptr;
   }
@@ -22,6 +22,7 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
@@ -76,6 +77,14 @@ class PageReader {
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Sets the data pages of the column chunk which have no value passing the
+  /// filter of the column, indexed by the ordinal of the data page in the
+  /// column chunk. These pages are skipped without decoding and produce no
+  /// rows when read with the filter. Must be called before the first read.
+  void setPrunedPages(std::vector<bool> prunedPages) {
+    prunedPages_ = std::move(prunedPages);
+  }
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -132,7 +141,8 @@ class PageReader {
   }
 
   bool isDeltaByteArray() const {
-    return encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY;
+    return encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY ||
+        encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY;
   }
 
   /// Returns the range of repdefs for the top level rows covered by the last
@@ -205,6 +215,11 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Transposes the BYTE_STREAM_SPLIT encoded values of the current page into
+  // 'byteStreamSplitData_' and points 'pageData_' to them. The values are then
+  // decoded as PLAIN.
+  void decodeByteStreamSplit();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -217,7 +232,8 @@ class PageReader {
 
   // Decompresses data starting at 'pageData_', consuming 'compressedsize' and
   // producing up to 'uncompressedSize' bytes. The start of the decoding
-  // result is returned. an intermediate copy may be made in 'decompresseddata_'
+  // result is returned. Uncompressed data is returned in place. Otherwise the
+  // result is in 'decompressedData_', which is reused across pages.
   const char* decompressData(
       const char* pageData,
       uint32_t compressedSize,
@@ -312,6 +328,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         nullsFromFastPath = false;
         deltaByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -322,6 +341,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         deltaByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -372,13 +393,12 @@ class PageReader {
   BufferPtr tempNulls_;
   BufferPtr nullsInReadRange_;
   BufferPtr multiPageNulls_;
-  // Decoder for single bit definition levels. the arrow decoders are used for
-  // multibit levels pending fixing RleBpDecoder for the case.
+  // Decoder for single bit definition levels.
   std::unique_ptr<RleBpDecoder> defineDecoder_;
-  std::unique_ptr<::facebook::velox::parquet::arrow::util::RleDecoder>
-      repeatDecoder_;
-  std::unique_ptr<::facebook::velox::parquet::arrow::util::RleDecoder>
-      wideDefineDecoder_;
+  // Decoders which expand the repetition and definition levels into
+  // 'repetitionLevels_' and 'definitionLevels_'.
+  std::unique_ptr<RleBpDecoder> repeatDecoder_;
+  std::unique_ptr<RleBpDecoder> wideDefineDecoder_;
 
   // True for a leaf column for which repdefs are loaded for the whole column
   // chunk. This is typically the leaftmost leaf of a list. Other leaves under
@@ -392,6 +412,18 @@ class PageReader {
   // Number of leaf values in each data page of column chunk.
   std::vector<int32_t> numLeavesInPage_;
 
+  // True for the data pages which have no value passing the filter. See
+  // setPrunedPages().
+  std::vector<bool> prunedPages_;
+
+  // Ordinal of the current data page in the column chunk. -1 means before
+  // first page.
+  int32_t dataPageIndex_{-1};
+
+  // True if the current page is in 'prunedPages_'. The page is not decoded
+  // and there are no decoders for it.
+  bool pagePruned_{false};
+
   // First position in '*levels_' for the range of last decodeRepDefs().
   int32_t repDefBegin_{0};
 
@@ -433,6 +465,14 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Decompresses whole pages into 'decompressedData_'. Created on first use
+  // and reused for all pages of the column chunk. Not used for zlib and gzip,
+  // which decompress with a stream.
+  std::unique_ptr<dwio::common::compression::Decompressor> decompressor_;
+
+  // Values of a BYTE_STREAM_SPLIT page transposed to PLAIN layout.
+  BufferPtr byteStreamSplitData_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* pageData_{nullptr};
@@ -501,6 +541,7 @@ class PageReader {
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -540,8 +581,12 @@ void PageReader::readWithVisitor(Visitor& visitor) {
     int32_t numValuesBeforePage = numRowsInReader<hasFilter>(reader);
     visitor.setNumValuesBias(numValuesBeforePage);
     visitor.setRows(pageRows);
-    callDecoder(nulls, nullsFromFastPath, visitor);
-    if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED &&
+    // No row of a pruned page passes the filter.
+    VELOX_DCHECK(hasFilter || !pagePruned_);
+    if (!pagePruned_) {
+      callDecoder(nulls, nullsFromFastPath, visitor);
+    }
+    if (!pagePruned_ && encoding_ == thrift::Encoding::DELTA_BINARY_PACKED &&
         deltaBpDecoder_->validValuesCount() == 0) {
       VELOX_DCHECK(
           deltaBpDecoder_->bufferStart() == pageData_ + encodedDataSize_,
@@ -16,16 +16,143 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
+namespace {
+// Reads a thrift struct of 'length' bytes from 'stream'.
+template <typename T>
+T readThrift(dwio::common::SeekableInputStream& stream, int32_t length) {
+  std::vector<char> buffer(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, &stream, buffer.data(), bufferStart, bufferEnd);
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(buffer.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+// Returns true if 'filter' passes only the values in 'values' and no nulls, so
+// that the column chunk can be skipped if none of 'values' is in its Bloom
+// filter.
+bool bigintFilterValues(
+    const common::Filter& filter,
+    std::vector<int64_t>& values) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      const auto& range = static_cast<const common::BigintRange&>(filter);
+      if (!range.isSingleValue()) {
+        return false;
+      }
+      values.push_back(range.lower());
+      return true;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      values = static_cast<const common::BigintValuesUsingHashTable&>(filter)
+                   .values();
+      return true;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter).values();
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Same as bigintFilterValues() for string filters.
+bool bytesFilterValues(
+    const common::Filter& filter,
+    std::vector<std::string_view>& values) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBytesRange: {
+      const auto& range = static_cast<const common::BytesRange&>(filter);
+      if (!range.isSingleValue()) {
+        return false;
+      }
+      values.push_back(range.lower());
+      return true;
+    }
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        values.push_back(value);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    const TypePtr& type) {
+  if (type->isDecimal()) {
+    return true;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      std::vector<int64_t> values;
+      if (!bigintFilterValues(filter, values)) {
+        return true;
+      }
+      // Values narrower than 64 bits are stored and hashed as INT32.
+      const bool isInt64 = type->kind() == TypeKind::BIGINT;
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        return bloomFilter.findHash(
+            isInt64 ? bloomFilter.hash(value)
+                    : bloomFilter.hash(static_cast<int32_t>(value)));
+      });
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      std::vector<std::string_view> values;
+      if (!bytesFilterValues(filter, values)) {
+        return true;
+      }
+      return std::any_of(
+          values.begin(), values.end(), [&](std::string_view value) {
+            const ByteArray byteArray(value);
+            return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+          });
+    }
+    default:
+      return true;
+  }
+}
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
+    const common::ScanSpec& scanSpec) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type,
+      metaData_,
+      pool(),
+      sessionTimezone_,
+      &scanSpec,
+      &runtimeStatistics(),
+      bloomFilterSource_);
 }
 
 void ParquetData::filterRowGroups(
@@ -70,6 +197,20 @@ void ParquetData::filterRowGroups(
   }
 }
 
+std::optional<double> ParquetData::estimateSelectivity(
+    uint32_t rowGroupId,
+    const common::Filter& filter) const {
+  auto rowGroup = fileMetaDataPtr_.rowGroup(rowGroupId);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasStatistics()) {
+    return std::nullopt;
+  }
+  auto columnStats =
+      columnChunk.getColumnStatistics(type_->type(), rowGroup.numRows());
+  return common::estimateFilterSelectivity(
+      &filter, columnStats.get(), rowGroup.numRows(), type_->type());
+}
+
 bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   auto column = type_->column();
   auto type = type_->type();
@@ -84,9 +225,50 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
   }
-  return true;
+  return bloomFilterMatches(rowGroupId, *filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto* input = bloomFilterSource_.input;
+  if (input == nullptr) {
+    return true;
+  }
+  const auto rowGroupOffset = getRowGroupRegion(rowGroupId).first;
+  if (rowGroupOffset < bloomFilterSource_.offset ||
+      rowGroupOffset >= bloomFilterSource_.limit) {
+    return true;
+  }
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  if (!columnChunk.hasBloomFilterOffset()) {
+    return true;
+  }
+  // Checks that the filter can use a Bloom filter before reading it.
+  std::vector<int64_t> bigintValues;
+  std::vector<std::string_view> bytesValues;
+  if (!bigintFilterValues(filter, bigintValues) &&
+      !bytesFilterValues(filter, bytesValues)) {
+    return true;
+  }
+  // The length of the Bloom filter is only known after reading its header.
+  // The stream reads as much as is consumed. With a cache backed input, the
+  // bytes are cached for the following scans of the file.
+  const uint64_t offset = columnChunk.bloomFilterOffset();
+  const auto fileSize = input->getReadFile()->size();
+  if (offset >= fileSize) {
+    return true;
+  }
+  auto stream = input->read(
+      offset, fileSize - offset, dwio::common::LogType::STREAM);
+  const auto bloomFilter =
+      BlockSplitBloomFilter::deserialize(stream.get(), pool_);
+  return testBloomFilter(filter, bloomFilter, type_->type());
 }
 
 void ParquetData::enqueueRowGroup(
@@ -113,6 +295,75 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+
+  if (usePageIndex(chunk)) {
+    columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.columnIndexOffset()),
+         static_cast<uint64_t>(chunk.columnIndexLength())});
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+         static_cast<uint64_t>(chunk.offsetIndexLength())});
+  }
+}
+
+bool ParquetData::usePageIndex(const ColumnChunkMetaDataPtr& chunk) const {
+  if (scanSpec_ == nullptr || !chunk.hasPageIndex() || maxRepeat_ > 0 ||
+      maxDefine_ > 1 || type_->type()->isDecimal()) {
+    return false;
+  }
+  auto* filter = scanSpec_->filter();
+  // IS NOT NULL may be evaluated on the nulls alone without decoding pages.
+  return filter != nullptr && !filter->testNull() &&
+      filter->kind() != common::FilterKind::kIsNotNull;
+}
+
+std::vector<bool> ParquetData::prunedPages(uint32_t index) {
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto chunk = rowGroup.columnChunk(type_->column());
+  const auto columnIndex = readThrift<thrift::ColumnIndex>(
+      *columnIndexStreams_[index], chunk.columnIndexLength());
+  const auto offsetIndex = readThrift<thrift::OffsetIndex>(
+      *offsetIndexStreams_[index], chunk.offsetIndexLength());
+  columnIndexStreams_[index].reset();
+  offsetIndexStreams_[index].reset();
+
+  const auto& pages = offsetIndex.page_locations;
+  const auto numPages = pages.size();
+  if (columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages ||
+      (columnIndex.__isset.null_counts &&
+       columnIndex.null_counts.size() != numPages)) {
+    return {};
+  }
+  auto* filter = scanSpec_->filter();
+  const auto& type = type_->type();
+  std::vector<bool> pruned(numPages);
+  for (auto i = 0; i < numPages; ++i) {
+    // All the values of a null page are null, which the filter does not pass.
+    if (columnIndex.null_pages[i]) {
+      pruned[i] = true;
+      continue;
+    }
+    const auto numRows =
+        (i + 1 < numPages ? pages[i + 1].first_row_index : rowGroup.numRows()) -
+        pages[i].first_row_index;
+    thrift::Statistics pageStats;
+    pageStats.__set_min_value(columnIndex.min_values[i]);
+    pageStats.__set_max_value(columnIndex.max_values[i]);
+    if (columnIndex.__isset.null_counts) {
+      pageStats.__set_null_count(columnIndex.null_counts[i]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRows);
+    pruned[i] = !testFilter(filter, columnStats.get(), numRows, type);
+  }
+  if (stats_ != nullptr) {
+    stats_->skippedPages += std::count(pruned.begin(), pruned.end(), true);
+  }
+  return pruned;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
@@ -127,6 +378,9 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       metadata.compression(),
       metadata.totalCompressedSize(),
       sessionTimezone_);
+  if (index < columnIndexStreams_.size() && columnIndexStreams_[index]) {
+    reader_->setPrunedPages(prunedPages(index));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
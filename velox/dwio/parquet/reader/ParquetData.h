@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
@@ -30,6 +31,23 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+/// Returns false if no value passing 'filter' is in 'bloomFilter' of a column
+/// of 'type'. Returns true if the filter is not an equality or IN filter
+/// without nulls on a column type with Bloom filter support.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    const TypePtr& type);
+
+/// Input for reading the Bloom filters of the row groups of a split.
+struct BloomFilterSource {
+  dwio::common::BufferedInput* input{nullptr};
+  /// Byte range of the split. Bloom filters are only read for the row groups
+  /// which start in the range.
+  uint64_t offset{0};
+  uint64_t limit{std::numeric_limits<uint64_t>::max()};
+};
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -37,11 +55,13 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      BloomFilterSource bloomFilterSource = {})
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        bloomFilterSource_(bloomFilterSource) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +74,7 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  const BloomFilterSource bloomFilterSource_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -63,14 +84,20 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      const common::ScanSpec* scanSpec = nullptr,
+      dwio::common::ColumnReaderStatistics* stats = nullptr,
+      BloomFilterSource bloomFilterSource = {})
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        scanSpec_(scanSpec),
+        stats_(stats),
+        bloomFilterSource_(bloomFilterSource) {}
 
   /// Prepares to read data for 'index'th row group.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
@@ -80,6 +107,12 @@ class ParquetData : public dwio::common::FormatData {
   /// Other formats may use it.
   dwio::common::PositionProvider seekToRowGroup(int64_t index) override;
 
+  /// Returns the estimated fraction of the rows of row group 'rowGroupId'
+  /// that pass 'filter' based on the statistics of the column chunk.
+  std::optional<double> estimateSelectivity(
+      uint32_t rowGroupId,
+      const common::Filter& filter) const;
+
   void filterRowGroups(
       const common::ScanSpec& scanSpec,
       uint64_t rowsPerRowGroup,
@@ -208,6 +241,20 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if no value passing 'filter' is in the Bloom filter of the column
+  /// chunk of 'this' in 'rowGroup', if any.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  /// True if the pages of 'chunk' can be skipped based on its page index and
+  /// the filter in 'scanSpec_'. This is the case for a filter which does not
+  /// pass nulls on a column with one value per top level row.
+  bool usePageIndex(const ColumnChunkMetaDataPtr& chunk) const;
+
+  /// Returns for each data page of the 'index'th row group whether no value
+  /// of the page passes the filter in 'scanSpec_' according to the page index.
+  /// The page index must be enqueued.
+  std::vector<bool> prunedPages(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -221,6 +268,16 @@ class ParquetData : public dwio::common::FormatData {
   int64_t rowsInRowGroup_;
   const tz::TimeZone* sessionTimezone_;
   std::unique_ptr<PageReader> reader_;
+  const common::ScanSpec* const scanSpec_;
+  dwio::common::ColumnReaderStatistics* const stats_;
+  const BloomFilterSource bloomFilterSource_;
+
+  // Streams for the ColumnIndex and OffsetIndex of this column in each of
+  // 'rowGroups_'. Only set if usePageIndex() is true for the row group.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
   BufferPtr presetNulls_;
@@ -18,6 +18,7 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -25,6 +26,9 @@
 namespace facebook::velox::parquet {
 
 namespace {
+// Estimated ratio of the memory of a parsed thrift FileMetaData to the size of
+// the serialized footer.
+constexpr uint64_t kParsedFooterRatio = 4;
 
 bool isParquetReservedKeyword(
     std::string name,
@@ -47,6 +51,18 @@ TypePtr getUpdatedTableSchema(
       ? tableSchema
       : tableSchema->childAt(i);
 }
+
+// Returns the compressed size of all the column chunks of 'rowGroup'.
+int64_t rowGroupCompressedSize(const thrift::RowGroup& rowGroup) {
+  if (rowGroup.__isset.total_compressed_size) {
+    return rowGroup.total_compressed_size;
+  }
+  int64_t size = 0;
+  for (const auto& column : rowGroup.columns) {
+    size += column.meta_data.total_compressed_size;
+  }
+  return size;
+}
 } // namespace
 
 /// Metadata and options for reading Parquet.
@@ -99,7 +115,9 @@ class ReaderBase {
   }
 
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading up to 'prefetchRowGroups' subsequent
+  /// groups that passed the statistics filters, within
+  /// 'maxPrefetchRowGroupBytes' of compressed size.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
@@ -151,7 +169,7 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -180,6 +198,16 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::string cacheKey;
+  if (metadataCache != nullptr && !options_.fileMetadataCacheKey().empty()) {
+    cacheKey = "parquet:" + options_.fileMetadataCacheKey();
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(cacheKey);
+    if (fileMetaData_ != nullptr) {
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -226,8 +254,13 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  if (!cacheKey.empty()) {
+    metadataCache->put(
+        cacheKey, fileMetaData_, footerLength * kParsedFooterRatio);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -870,8 +903,19 @@ void ReaderBase::scheduleRowGroups(
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
+  // The current row group is always loaded. The row groups after it are
+  // loaded while their total size fits in the prefetch budget.
+  const auto maxPrefetchBytes = options_.maxPrefetchRowGroupBytes();
+  int64_t prefetchBytes = 0;
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
+    if (i > 0 && maxPrefetchBytes > 0) {
+      prefetchBytes +=
+          rowGroupCompressedSize(fileMetaData_->row_groups[thisGroup]);
+      if (prefetchBytes > maxPrefetchBytes) {
+        break;
+      }
+    }
     if (!inputs_[thisGroup]) {
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
@@ -939,7 +983,8 @@ class ParquetRowReader::Impl {
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        {&readerBase_->bufferedInput(), options_.offset(), options_.limit()});
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -948,6 +993,12 @@ class ParquetRowReader::Impl {
         params,
         *options_.scanSpec());
     columnReader_->setIsTopLevel();
+    if (options_.decodingExecutor() != nullptr) {
+      static_cast<StructColumnReader&>(*columnReader_)
+          .setDecodingExecutor(
+              options_.decodingExecutor().get(),
+              options_.decodingParallelismFactor());
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -1046,6 +1097,8 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.columnReaderStatistics.skippedPages +=
+        columnReaderStats_.skippedPages;
   }
 
   void resetFilterCaches() {
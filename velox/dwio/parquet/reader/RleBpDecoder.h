@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BitPackDecoder.h"
 #include "velox/dwio/common/DecoderUtil.h"
 
@@ -34,10 +35,13 @@ class RleBpDecoder {
 
   void skip(uint64_t numValues);
 
-  /// Decode @param numValues number of values and copy the decoded values into
-  /// @param outputBuffer
+  /// Decodes 'numValues' values into 'outputBuffer' and advances
+  /// 'outputBuffer' past them. Bit packed runs are unpacked with the SIMD
+  /// kernels of dwio::common::unpack() and RLE runs are expanded with SIMD
+  /// stores. Must not be mixed with skip() or readBits() on the same decoder.
   template <typename T>
   void next(T* FOLLY_NONNULL& outputBuffer, uint64_t numValues) {
+    static_assert(std::is_unsigned_v<T>);
     while (numValues > 0) {
       if (numRemainingUnpackedValues_ > 0) {
         auto numValuesToRead =
@@ -50,32 +54,21 @@ class RleBpDecoder {
           readHeader();
         }
 
-        auto numValuesToRead = std::min<uint32_t>(numValues, remainingValues_);
+        auto numValuesToRead = std::min<uint64_t>(numValues, remainingValues_);
         if (repeating_) {
-          std::fill(outputBuffer, outputBuffer + numValuesToRead, value_);
-          outputBuffer += numValuesToRead;
+          fillRun(outputBuffer, numValuesToRead);
           remainingValues_ -= numValuesToRead;
         } else {
           remainingUnpackedValuesOffset_ = 0;
           // The parquet standard requires the bit packed values are always a
           // multiple of 8. So we read a multiple of 8 values each time
-          dwio::common::unpack<T>(
-              reinterpret_cast<const uint8_t*&>(bufferStart_),
-              bufferEnd_ - bufferStart_,
-              numValuesToRead & 0xfffffff8,
-              bitWidth_,
-              reinterpret_cast<T * FOLLY_NONNULL&>(outputBuffer));
-          remainingValues_ -= (numValuesToRead & 0xfffffff8);
+          unpackGroups(outputBuffer, numValuesToRead & ~7ULL);
+          remainingValues_ -= (numValuesToRead & ~7ULL);
 
           // Unpack the next 8 values to remainingUnpackedValues_ if necessary
           if ((numValuesToRead & 7) != 0) {
             T* output = reinterpret_cast<T*>(remainingUnpackedValues_);
-            dwio::common::unpack<T>(
-                reinterpret_cast<const uint8_t*&>(bufferStart_),
-                bufferEnd_ - bufferStart_,
-                8,
-                bitWidth_,
-                output);
+            unpackGroups(output, 8);
             numRemainingUnpackedValues_ = 8;
             remainingUnpackedValuesOffset_ = 0;
 
@@ -111,13 +104,58 @@ class RleBpDecoder {
         outputBuffer,
         reinterpret_cast<T*>(remainingUnpackedValues_) +
             remainingUnpackedValuesOffset_,
-        numValues);
+        numValues * sizeof(T));
 
     outputBuffer += numValues;
     numRemainingUnpackedValues_ -= numValues;
     remainingUnpackedValuesOffset_ += numValues;
   }
 
+  // Writes 'numValues' copies of the value of the current RLE run.
+  template <typename T>
+  void fillRun(T* FOLLY_NONNULL& outputBuffer, uint64_t numValues) {
+    using Batch = xsimd::batch<T>;
+    const auto values = xsimd::broadcast<T>(value_);
+    uint64_t i = 0;
+    for (; i + Batch::size <= numValues; i += Batch::size) {
+      values.store_unaligned(outputBuffer + i);
+    }
+    for (; i < numValues; ++i) {
+      outputBuffer[i] = value_;
+    }
+    outputBuffer += numValues;
+  }
+
+  // Unpacks 'numValues' bit packed values, a multiple of 8, and advances
+  // 'bufferStart_' and 'outputBuffer' past them. The SIMD kernels load up to
+  // 16 bytes at a time, so the values near the end of the buffer are unpacked
+  // one at a time.
+  template <typename T>
+  void unpackGroups(T* FOLLY_NONNULL& outputBuffer, uint64_t numValues) {
+    const uint64_t numBytes = numValues * bitWidth_ / 8;
+    auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+    auto* end = reinterpret_cast<const uint8_t*>(bufferEnd_);
+    const uint64_t available = end - input;
+    VELOX_CHECK_LE(numBytes, available);
+    if (numBytes + kUnpackPadding <= available) {
+      T* output = outputBuffer;
+      dwio::common::unpack<T>(input, numBytes, numValues, bitWidth_, output);
+    } else {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        const uint64_t bit = i * bitWidth_;
+        const auto* word = input + (bit >> 3);
+        const auto size = std::min<int64_t>(sizeof(uint64_t), end - word);
+        outputBuffer[i] =
+            (bits::loadPartialWord(word, size) >> (bit & 7)) & bitMask_;
+      }
+    }
+    bufferStart_ += numBytes;
+    outputBuffer += numValues;
+  }
+
+  // Bytes after a bit packed run that the SIMD unpack kernels may read.
+  static constexpr uint64_t kUnpackPadding = 16;
+
   const char* bufferStart_;
   const char* bufferEnd_;
   const int8_t bitWidth_;
@@ -152,6 +152,15 @@ void StructColumnReader::seekToRowGroup(int64_t index) {
   readOffset_ = 0;
   for (auto& child : children_) {
     child->seekToRowGroup(index);
+    // Orders the filters for the row group by the selectivity estimated from
+    // its statistics and the time per value measured so far.
+    auto* childSpec = child->scanSpec();
+    if (childSpec->filter() &&
+        child->fileType().column() != ParquetTypeWithId::kNonLeaf) {
+      childSpec->setSelectivityEstimate(
+          child->formatData().as<ParquetData>().estimateSelectivity(
+              index, *childSpec->filter()));
+    }
   }
 }
 
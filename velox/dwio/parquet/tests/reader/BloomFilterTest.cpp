@@ -395,3 +395,54 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, testBloomFilter) {
+  BlockSplitBloomFilter bloomFilter(leafPool_.get());
+  bloomFilter.init(1024);
+  for (int32_t i = 0; i < 100; i += 2) {
+    bloomFilter.insertHash(bloomFilter.hash(i));
+    bloomFilter.insertHash(bloomFilter.hash(static_cast<int64_t>(i) << 32));
+  }
+  const ByteArray hello(std::string_view("hello"));
+  bloomFilter.insertHash(bloomFilter.hash(&hello));
+
+  using namespace facebook::velox::common;
+  // Equality and IN filters on the INT32 values.
+  EXPECT_TRUE(
+      testBloomFilter(BigintRange(10, 10, false), bloomFilter, INTEGER()));
+  EXPECT_FALSE(
+      testBloomFilter(BigintRange(11, 11, false), bloomFilter, INTEGER()));
+  EXPECT_FALSE(
+      testBloomFilter(BigintRange(11, 11, false), bloomFilter, SMALLINT()));
+  EXPECT_FALSE(testBloomFilter(
+      BigintValuesUsingHashTable(-999, 999, {-999, 111, 999}, false),
+      bloomFilter,
+      INTEGER()));
+  EXPECT_TRUE(testBloomFilter(
+      BigintValuesUsingBitmask(1, 13, {1, 12, 13}, false),
+      bloomFilter,
+      INTEGER()));
+
+  // INT64 values are hashed as 64 bits.
+  constexpr int64_t kHigh = 2L << 32;
+  EXPECT_TRUE(
+      testBloomFilter(BigintRange(kHigh, kHigh, false), bloomFilter, BIGINT()));
+  EXPECT_FALSE(testBloomFilter(
+      BigintRange(kHigh + 1, kHigh + 1, false), bloomFilter, BIGINT()));
+
+  // Strings.
+  EXPECT_TRUE(testBloomFilter(
+      BytesRange("hello", false, false, "hello", false, false, false),
+      bloomFilter,
+      VARCHAR()));
+  EXPECT_FALSE(testBloomFilter(
+      BytesValues({"apple", "pear"}, false), bloomFilter, VARCHAR()));
+
+  // Ranges and filters passing nulls can't be tested.
+  EXPECT_TRUE(
+      testBloomFilter(BigintRange(11, 13, false), bloomFilter, INTEGER()));
+  EXPECT_TRUE(
+      testBloomFilter(BigintRange(11, 11, true), bloomFilter, INTEGER()));
+  EXPECT_TRUE(testBloomFilter(
+      BytesValues({"apple", "pear"}, true), bloomFilter, VARCHAR()));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
+#include "velox/dwio/parquet/writer/arrow/util/RleEncodingInternal.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox;
+using facebook::velox::parquet::arrow::util::RleDecoder;
+using facebook::velox::parquet::arrow::util::RleEncoder;
+
+namespace {
+
+constexpr int32_t kNumValues = 1'000'000;
+constexpr int32_t kBatchSize = 1'024;
+
+// Repetition or definition levels of a nested column, encoded as RLE /
+// bit packed hybrid.
+struct EncodedLevels {
+  EncodedLevels(uint8_t bitWidth, int32_t averageRunLength)
+      : bitWidth(bitWidth) {
+    const int32_t maxValue = (1 << bitWidth) - 1;
+    std::vector<uint16_t> values(kNumValues);
+    uint16_t value = 0;
+    for (auto i = 0; i < kNumValues; ++i) {
+      if (folly::Random::rand32(averageRunLength) == 0) {
+        value = folly::Random::rand32(maxValue + 1);
+      }
+      values[i] = value;
+    }
+    data.resize(
+        RleEncoder::MaxBufferSize(bitWidth, kNumValues) +
+        RleEncoder::MinBufferSize(bitWidth));
+    RleEncoder encoder(data.data(), data.size(), bitWidth);
+    for (auto level : values) {
+      encoder.Put(level);
+    }
+    data.resize(encoder.Flush());
+  }
+
+  const uint8_t bitWidth;
+  std::vector<uint8_t> data;
+};
+
+void decodeArrow(uint8_t bitWidth, int32_t averageRunLength) {
+  folly::BenchmarkSuspender suspender;
+  const EncodedLevels levels(bitWidth, averageRunLength);
+  std::vector<int16_t> output(kBatchSize);
+  RleDecoder decoder(levels.data.data(), levels.data.size(), levels.bitWidth);
+  suspender.dismiss();
+  for (auto i = 0; i < kNumValues; i += kBatchSize) {
+    decoder.GetBatch(output.data(), std::min(kBatchSize, kNumValues - i));
+  }
+  folly::doNotOptimizeAway(output);
+}
+
+void decodeVelox(uint8_t bitWidth, int32_t averageRunLength) {
+  folly::BenchmarkSuspender suspender;
+  const EncodedLevels levels(bitWidth, averageRunLength);
+  std::vector<uint16_t> output(kBatchSize);
+  const auto* data = reinterpret_cast<const char*>(levels.data.data());
+  parquet::RleBpDecoder decoder(
+      data, data + levels.data.size(), levels.bitWidth);
+  suspender.dismiss();
+  for (auto i = 0; i < kNumValues; i += kBatchSize) {
+    auto* values = output.data();
+    decoder.next(values, std::min(kBatchSize, kNumValues - i));
+  }
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_NAMED_PARAM(decodeArrow, bitPacked1, 1, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, bitPacked1, 1, 1);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeArrow, bitPacked2, 2, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, bitPacked2, 2, 1);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeArrow, bitPacked3, 3, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, bitPacked3, 3, 1);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeArrow, mixedRuns2, 2, 8);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, mixedRuns2, 2, 8);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeArrow, mixedRuns3, 3, 8);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, mixedRuns3, 3, 8);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeArrow, longRuns3, 3, 100);
+BENCHMARK_RELATIVE_NAMED_PARAM(decodeVelox, longRuns3, 3, 100);
+BENCHMARK_DRAW_LINE();
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -108,3 +108,24 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
       options.format.zlib.windowBits,
       dwio::common::compression::Compressor::PARQUET_ZLIB_WINDOW_BITS);
 }
+
+TEST(ByteStreamSplitTest, decode) {
+  // Covers the SIMD widths, a generic width and tails shorter than a batch.
+  for (const int32_t width : {2, 4, 8, 16}) {
+    for (const int64_t numValues : {0, 1, 31, 64, 100, 1'000}) {
+      std::vector<char> values(width * numValues);
+      for (auto i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<char>(i * 7 + i / 3);
+      }
+      std::vector<char> encoded(values.size());
+      for (auto i = 0; i < numValues; ++i) {
+        for (auto stream = 0; stream < width; ++stream) {
+          encoded[stream * numValues + i] = values[i * width + stream];
+        }
+      }
+      std::vector<char> decoded(values.size());
+      decodeByteStreamSplit(encoded.data(), width, numValues, decoded.data());
+      EXPECT_EQ(values, decoded) << width << " " << numValues;
+    }
+  }
+}
@@ -14,7 +14,12 @@
  * limitations under the License.
  */
 
+#include <arrow/io/memory.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -837,6 +842,49 @@ TEST_F(ParquetReaderTest, intMultipleFilters) {
       "int.parquet", intSchema(), std::move(filters), expected);
 }
 
+TEST_F(ParquetReaderTest, parallelDecoding) {
+  // The non-filtered columns are decoded on the executor instead of being
+  // returned as LazyVectors.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(sample, readerOptions);
+
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  rowReaderOpts.setDecodingExecutor(executor);
+  rowReaderOpts.setDecodingParallelismFactor(2);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  assertReadWithReaderAndExpected(
+      sampleSchema(), *rowReader, expected, *leafPool_);
+
+  // The filter on 'a' is applied first and 'b' is decoded for the passing
+  // rows only.
+  auto scanSpec = makeScanSpec(sampleSchema());
+  scanSpec->childByName("a")->setFilter(exec::between(16, 20));
+  rowReaderOpts.setScanSpec(scanSpec);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  expected = makeRowVector({
+      makeFlatVector<int64_t>(5, [](auto row) { return row + 16; }),
+      makeFlatVector<double>(5, [](auto row) { return row + 16; }),
+  });
+  auto result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  vector_size_t total = 0;
+  while (rowReader->next(20, result) > 0) {
+    if (result->size() == 0) {
+      continue;
+    }
+    ASSERT_FALSE(isLazyNotLoaded(*result->as<RowVector>()->childAt(1)));
+    assertEqualVectorPart(expected, result, total);
+    total += result->size();
+  }
+  EXPECT_EQ(total, expected->size());
+}
+
 TEST_F(ParquetReaderTest, doubleFilters) {
   // Read sample.parquet with the double filter "b < 10.0".
   FilterMap filters;
@@ -1130,6 +1178,53 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, prefetchRowGroupsMaxBytes) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  const int numRowGroups = 4;
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(numRowGroups);
+  auto reader = createReader(sample, readerOptions);
+  std::vector<int64_t> sizes;
+  for (int i = 0; i < numRowGroups; i++) {
+    auto rowGroup = reader->fileMetaData().rowGroup(i);
+    int64_t size = 0;
+    if (rowGroup.hasTotalCompressedSize()) {
+      size = rowGroup.totalCompressedSize();
+    } else {
+      for (int j = 0; j < rowGroup.numColumns(); j++) {
+        size += rowGroup.columnChunk(j).totalCompressedSize();
+      }
+    }
+    sizes.push_back(size);
+  }
+
+  // Only the row group after the first one fits in the budget at the start.
+  readerOptions.setMaxPrefetchRowGroupBytes(sizes[1]);
+  reader = createReader(sample, readerOptions);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+
+  constexpr int kBatchSize = 1000;
+  auto result = BaseVector::create(rowType, kBatchSize, pool_.get());
+  for (int i = 0; i < numRowGroups; i++) {
+    EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(i));
+    int64_t prefetchBytes = 0;
+    for (int j = i + 1; j < numRowGroups; j++) {
+      prefetchBytes += sizes[j];
+      EXPECT_EQ(
+          parquetRowReader->isRowGroupBuffered(j), prefetchBytes <= sizes[1])
+          << i << " " << j;
+    }
+    parquetRowReader->next(kBatchSize, result);
+    parquetRowReader->nextRowNumber();
+  }
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -1212,6 +1307,58 @@ TEST_F(ParquetReaderTest, readVarbinaryFromFLBA) {
           ->valueAt(0));
 }
 
+TEST_F(ParquetReaderTest, flbaDictionary) {
+  // Writes a FIXED_LEN_BYTE_ARRAY column with a dictionary page. The column is
+  // read as a DictionaryVector over the dictionary of the column chunk.
+  namespace pa = facebook::velox::parquet::arrow;
+  constexpr int32_t kLength = 4;
+  constexpr int32_t kNumRows = 100;
+  const std::vector<std::string> strings = {"abcd", "efgh", "ijkl"};
+
+  auto sink = ::arrow::io::BufferOutputStream::Create().ValueOrDie();
+  pa::schema::NodeVector fields{pa::schema::PrimitiveNode::Make(
+      "flba",
+      pa::Repetition::REQUIRED,
+      pa::Type::FIXED_LEN_BYTE_ARRAY,
+      pa::ConvertedType::NONE,
+      kLength)};
+  auto schema = std::static_pointer_cast<pa::schema::GroupNode>(
+      pa::schema::GroupNode::Make("schema", pa::Repetition::REQUIRED, fields));
+  auto fileWriter = pa::ParquetFileWriter::Open(sink, schema);
+  auto* columnWriter = static_cast<pa::FixedLenByteArrayWriter*>(
+      fileWriter->AppendRowGroup()->NextColumn());
+  std::vector<pa::FLBA> values;
+  for (auto i = 0; i < kNumRows; ++i) {
+    values.emplace_back(
+        reinterpret_cast<const uint8_t*>(strings[i % strings.size()].data()));
+  }
+  columnWriter->WriteBatch(kNumRows, nullptr, nullptr, values.data());
+  fileWriter->Close();
+  auto buffer = sink->Finish().ValueOrDie();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      std::make_shared<InMemoryReadFile>(buffer->ToString()),
+      readerOptions.memoryPool());
+  ParquetReader reader(std::move(input), readerOptions);
+  auto rowType = ROW({"flba"}, {VARBINARY()});
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(kNumRows, result), kNumRows);
+  auto column =
+      BaseVector::loadedVectorShared(result->as<RowVector>()->childAt(0));
+  ASSERT_EQ(column->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(column->size(), kNumRows);
+  auto* simple = column->as<SimpleVector<StringView>>();
+  for (auto i = 0; i < kNumRows; ++i) {
+    const auto& expected = strings[i % strings.size()];
+    EXPECT_EQ(simple->valueAt(i), StringView(expected)) << i;
+  }
+}
+
 TEST_F(ParquetReaderTest, readBinaryAsStringFromNation) {
   const std::string filename("nation.parquet");
   const std::string sample(getExampleFilePath(filename));
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
 #include "velox/dwio/parquet/writer/arrow/util/RleEncodingInternal.h"
 
 #include <gtest/gtest.h>
@@ -140,3 +141,40 @@ TEST(RleBpDecoderTest, DISABLED_allOnes) {
   RleBpDecoderTest<uint8_t> test;
   test.testDecodeSuppliedData(allOnesVector, 1);
 }
+
+TEST(RleBpDecoderTest, nextLevels) {
+  // Mixes RLE runs with bit packed runs and reads in sizes which are not
+  // multiples of 8, so that both the SIMD unpack and the tail handling near
+  // the end of the buffer are covered.
+  constexpr int32_t kNumValues = 10'000;
+  for (const uint8_t bitWidth : {1, 2, 3, 5, 8, 11, 16}) {
+    const uint16_t maxValue = (1 << bitWidth) - 1;
+    std::vector<uint16_t> values(kNumValues);
+    for (auto i = 0; i < kNumValues; ++i) {
+      values[i] = (i / 100) % 3 == 0 ? maxValue : (i * 7919) % (maxValue + 1);
+    }
+    std::vector<uint8_t> encoded(
+        RleEncoder::MaxBufferSize(bitWidth, kNumValues) +
+        RleEncoder::MinBufferSize(bitWidth));
+    RleEncoder encoder(encoded.data(), encoded.size(), bitWidth);
+    for (auto value : values) {
+      ASSERT_TRUE(encoder.Put(value));
+    }
+    const auto encodedSize = encoder.Flush();
+
+    facebook::velox::parquet::RleBpDecoder decoder(
+        reinterpret_cast<const char*>(encoded.data()),
+        reinterpret_cast<const char*>(encoded.data()) + encodedSize,
+        bitWidth);
+    std::vector<uint16_t> decoded(kNumValues);
+    auto* output = decoded.data();
+    int32_t numRead = 0;
+    for (int32_t batch = 1; numRead < kNumValues; batch = batch * 3 + 1) {
+      const auto numValues = std::min(batch, kNumValues - numRead);
+      decoder.next(output, numValues);
+      numRead += numValues;
+    }
+    ASSERT_EQ(output, decoded.data() + kNumValues);
+    EXPECT_EQ(values, decoded) << static_cast<int32_t>(bitWidth);
+  }
+}
@@ -146,6 +146,102 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, pageIndex) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  const int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 2; }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 1);
+  ASSERT_TRUE(reader->fileMetaData().rowGroup(0).columnChunk(0).hasPageIndex());
+
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->getOrCreateChild(Subfield("c0"))
+      ->setFilter(std::make_unique<BigintRange>(5'000, 5'099, false));
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 5'000; }),
+      makeFlatVector<double>(100, [](auto row) { return (row + 5'000) * 2; }),
+  });
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+  // The pages of 'c0' outside of the filter range are not decoded.
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_GT(stats.columnReaderStatistics.skippedPages, 0);
+}
+
+TEST_F(ParquetWriterTest, dictionaryVectors) {
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  const vector_size_t kRows = 1'000;
+  auto makeString = [](auto row) {
+    return fmt::format("dictionary value {}", row % 10);
+  };
+  auto indices = makeIndices(kRows, [](auto row) { return row % 10; });
+  const auto dictionaryBatch = makeRowVector({
+      wrapInDictionary(
+          indices,
+          kRows,
+          makeFlatVector<std::string>(10, [&](auto row) {
+            return makeString(row);
+          })),
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+  });
+  // A later batch with a flat vector with nulls for the same column.
+  const auto flatBatch = makeRowVector({
+      makeFlatVector<std::string>(
+          kRows,
+          [&](auto row) { return makeString(row); },
+          [](auto row) { return row % 7 == 0; }),
+      makeFlatVector<int64_t>(kRows, [](auto row) { return kRows + row; }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(dictionaryBatch);
+  writer->write(flatBatch);
+  writer->close();
+
+  const auto expected = makeRowVector({
+      makeFlatVector<std::string>(
+          2 * kRows,
+          [&](auto row) { return makeString(row); },
+          [](auto row) { return row >= kRows && (row - kRows) % 7 == 0; }),
+      makeFlatVector<int64_t>(2 * kRows, [](auto row) { return row; }),
+  });
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 2 * kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
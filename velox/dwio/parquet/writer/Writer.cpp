@@ -25,6 +25,7 @@
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::parquet {
 
@@ -143,6 +144,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -216,6 +220,46 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Returns true if 'vector' is a dictionary over flat values without nulls,
+// which the Arrow writer can write as a Parquet dictionary page as is.
+bool isDirectDictionary(const BaseVector& vector) {
+  return vector.encoding() == VectorEncoding::Simple::DICTIONARY &&
+      vector.valueVector()->isFlatEncoding() &&
+      !vector.valueVector()->mayHaveNulls();
+}
+
+// Returns 'vector' of a string type as a dictionary over flat values without
+// nulls. The values reference the strings of 'vector' without copying them.
+VectorPtr toDirectDictionary(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool) {
+  if (isDirectDictionary(*vector)) {
+    return vector;
+  }
+  const auto size = vector->size();
+  DecodedVector decoded(*vector);
+  auto values = BaseVector::create<FlatVector<StringView>>(
+      vector->type(), size, pool);
+  values->acquireSharedStringBuffers(decoded.base());
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  BufferPtr nulls;
+  for (auto i = 0; i < size; ++i) {
+    rawIndices[i] = i;
+    if (decoded.isNullAt(i)) {
+      if (!nulls) {
+        nulls = allocateNulls(size, pool);
+      }
+      bits::setNull(nulls->asMutable<uint64_t>(), i);
+      values->set(i, StringView());
+    } else {
+      values->set(i, decoded.valueAt<StringView>(i));
+    }
+  }
+  return BaseVector::wrapInDictionary(
+      std::move(nulls), std::move(indices), size, std::move(values));
+}
+
 } // namespace
 
 Writer::Writer(
@@ -241,6 +285,9 @@ Writer::Writer(
   options_.timestampUnit =
       options.parquetWriteTimestampUnit.value_or(TimestampUnit::kNano);
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
+  dictionaryOptions_ = options_;
+  dictionaryOptions_.flattenDictionary = false;
+  enableDictionary_ = options.enableDictionary;
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
   setMemoryReclaimers();
@@ -322,26 +369,61 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
-  ArrowArray array;
-  ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
-  exportToArrow(data, schema, options_);
+  auto input = std::dynamic_pointer_cast<RowVector>(data);
+  if (input == nullptr) {
+    input = std::static_pointer_cast<RowVector>(
+        BaseVector::copy(*data, generalPool_.get()));
+  }
+  const auto childSize = schema_->size();
+  if (dictionaryColumns_.empty()) {
+    // String columns which arrive as dictionaries in the first batch are
+    // exported as Arrow dictionaries for the whole file. The Arrow writer puts
+    // the dictionary into the Parquet dictionary page and writes the indices,
+    // without flattening or hashing the strings.
+    dictionaryColumns_.resize(childSize);
+    for (auto i = 0; i < childSize; ++i) {
+      const auto& child = BaseVector::loadedVectorShared(input->childAt(i));
+      dictionaryColumns_[i] = enableDictionary_ &&
+          (child->type()->isVarchar() || child->type()->isVarbinary()) &&
+          isDirectDictionary(*child);
+    }
+  }
+
+  // Exports the columns one by one since the dictionary columns use different
+  // options from the rest.
+  std::vector<ArrowArray> arrays(childSize);
+  ::arrow::FieldVector arrowFields;
+  arrowFields.reserve(childSize);
+  for (auto i = 0; i < childSize; ++i) {
+    auto child = BaseVector::loadedVectorShared(input->childAt(i));
+    const auto* columnOptions = &options_;
+    if (dictionaryColumns_[i]) {
+      child = toDirectDictionary(child, generalPool_.get());
+      columnOptions = &dictionaryOptions_;
+    }
+    ArrowSchema schema;
+    exportToArrow(child, arrays[i], generalPool_.get(), *columnOptions);
+    exportToArrow(child, schema, *columnOptions);
+    PARQUET_ASSIGN_OR_THROW(auto field, ::arrow::ImportField(&schema));
+    arrowFields.push_back(std::move(field));
+  }
 
   // Convert the arrow schema to Schema and then update the column names based
   // on schema_.
-  auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
+  auto arrowSchema = ::arrow::schema(std::move(arrowFields));
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::write", arrowSchema.get());
   std::vector<std::shared_ptr<::arrow::Field>> newFields;
-  auto childSize = schema_->size();
+  std::vector<std::shared_ptr<::arrow::Array>> columns;
   for (auto i = 0; i < childSize; i++) {
     newFields.push_back(updateFieldNameRecursive(
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
+    PARQUET_ASSIGN_OR_THROW(
+        auto column, ::arrow::ImportArray(&arrays[i], newFields[i]->type()));
+    columns.push_back(std::move(column));
   }
-
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+  auto recordBatch = ::arrow::RecordBatch::Make(
+      ::arrow::schema(newFields), input->size(), std::move(columns));
   if (!arrowContext_->schema) {
     arrowContext_->schema = recordBatch->schema();
     for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
@@ -91,6 +91,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  /// Writes the ColumnIndex and OffsetIndex of the column chunks, which lets
+  /// readers skip the pages not matching a filter.
+  bool enablePageIndex = false;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
@@ -180,6 +183,16 @@ class Writer : public dwio::common::Writer {
 
   ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
 
+  // Export options of the columns in 'dictionaryColumns_'. Same as 'options_'
+  // but keeps dictionaries.
+  ArrowOptions dictionaryOptions_;
+
+  bool enableDictionary_;
+
+  // True for the top level columns which are written from dictionary
+  // vectors into Parquet dictionary pages. Set at the first write().
+  std::vector<bool> dictionaryColumns_;
+
   // Whether to write Int96 timestamps in Arrow Parquet write.
   bool writeInt96AsTimestamp_;
 };
@@ -167,6 +167,22 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Same as addRawInput() for groups which have small dense ids, e.g. the
+  // indices of the groups in a hash table in array mode.
+  // @param groupIds The id of the group of each row. Aligned with 'groups'.
+  // @param numGroupIds Upper bound of the ids.
+  // Aggregates may accumulate the rows of each group in arrays indexed by
+  // the ids and then update each group once. The default calls addRawInput().
+  virtual void addRawInputWithGroupIds(
+      char** groups,
+      const uint64_t* /*groupIds*/,
+      uint64_t /*numGroupIds*/,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) {
+    addRawInput(groups, rows, args, mayPushdown);
+  }
+
   // Updates final accumulators from intermediate results.
   // @param groups Pointers to the start of the group rows. These are aligned
   // with the 'args', e.g. data in the i-th row of the 'args' goes to the i-th
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <folly/container/F14Set.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -25,6 +26,17 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Returns true if the partial states of 'name' can be merged in any order.
+// Only these aggregates are evaluated with a segment tree for sliding frames.
+bool supportsSegmentTree(const std::string& name) {
+  static const folly::F14FastSet<std::string> kFunctions = {
+      "sum", "count", "min", "max", "avg"};
+  // Strips the prefix of functions registered in a namespace.
+  const auto pos = name.rfind('.');
+  return kFunctions.contains(
+      pos == std::string::npos ? name : name.substr(pos + 1));
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
@@ -101,6 +113,15 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    if (supportsSegmentTree(name)) {
+      const auto intermediateType =
+          exec::Aggregate::intermediateType(name, argTypes_);
+      nodeResultVector_ = BaseVector::create(intermediateType, 1, pool_);
+      nodeIndices_ = allocateIndices(kMaxSegmentTreeNodes, pool_);
+      edgeRowIndices_ = allocateIndices(2 * kSegmentTreeLeafSize, pool_);
+      edgeArgVectors_.resize(argVectors_.size());
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -116,6 +137,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    // The segment tree is built on first use. A partial partition does not
+    // have all its rows yet.
+    segmentTree_.reset();
+    useSegmentTree_ = nodeResultVector_ != nullptr && !partition_->partial();
   }
 
   void apply(
@@ -163,6 +188,18 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree_ && frameMetadata.largeFrames) {
+      if (segmentTree_ == nullptr) {
+        buildSegmentTree();
+      }
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -178,6 +215,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
  private:
+  // Each leaf of the segment tree has the partial state of this many
+  // consecutive rows of the partition.
+  static constexpr vector_size_t kSegmentTreeLeafSize = 32;
+
+  // The segment tree is used for blocks of frames that have at least this
+  // many rows on average. Smaller frames are aggregated from scratch.
+  static constexpr vector_size_t kSegmentTreeMinFrameSize =
+      4 * kSegmentTreeLeafSize;
+
+  // Max number of segment tree nodes that cover a frame: at most 2 per level
+  // of the tree.
+  static constexpr vector_size_t kMaxSegmentTreeNodes = 64;
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -193,6 +243,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // True if the frames have at least kSegmentTreeMinFrameSize rows on
+    // average.
+    bool largeFrames;
   };
 
   bool handleAllEmptyFrames(
@@ -225,9 +279,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t prevFrameEnds = lastRow;
 
     bool incrementalAggregation = true;
+    int64_t numFrames = 0;
+    int64_t numFrameRows = 0;
     validRows.applyToSelected([&](auto i) {
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
+      ++numFrames;
+      numFrameRows += rawFrameEnds[i] + 1 - rawFrameStarts[i];
 
       // Incremental aggregation can be done if :
       // i) All rows have the same frameStart value.
@@ -251,7 +309,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    const bool largeFrames =
+        numFrameRows >= numFrames * kSegmentTreeMinFrameSize;
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        largeFrames};
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -345,6 +410,157 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  void initializeSingleGroup() {
+    static const std::vector<vector_size_t> kSingleGroup{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+  }
+
+  // Copies the intermediate result of the single group to 'node' of the
+  // segment tree.
+  void storeSegmentTreeNode(vector_size_t node) {
+    BaseVector::prepareForReuse(nodeResultVector_, 1);
+    aggregate_->extractAccumulators(
+        &rawSingleGroupRow_, 1, &nodeResultVector_);
+    segmentTree_->copy(nodeResultVector_.get(), node, 0, 1);
+  }
+
+  // Builds the segment tree over all the rows of the partition. This is a
+  // bottom-up tree with 'numLeaves_' leaves. Leaf i is stored at index
+  // 'numLeaves_ + i' and has the intermediate result of the partition rows
+  // [i * kSegmentTreeLeafSize, (i + 1) * kSegmentTreeLeafSize). Inner node i
+  // merges nodes 2 * i and 2 * i + 1. Index 0 is not used. The merge of the
+  // supported aggregates is commutative, so 'numLeaves_' does not have to be
+  // a power of 2.
+  void buildSegmentTree() {
+    // Leaves are built from batches of rows to limit the size of the
+    // argument vectors.
+    static constexpr vector_size_t kLeavesPerBatch = 64;
+
+    const auto numRows = partition_->numRows();
+    numLeaves_ = bits::divRoundUp(numRows, kSegmentTreeLeafSize);
+    segmentTree_ =
+        BaseVector::create(nodeResultVector_->type(), 2 * numLeaves_, pool_);
+
+    SelectivityVector rows;
+    for (vector_size_t leaf = 0; leaf < numLeaves_; leaf += kLeavesPerBatch) {
+      const auto firstRow = leaf * kSegmentTreeLeafSize;
+      const auto numBatchRows = std::min<vector_size_t>(
+          kLeavesPerBatch * kSegmentTreeLeafSize, numRows - firstRow);
+      fillArgVectors(firstRow, firstRow + numBatchRows - 1);
+      rows.resize(numBatchRows);
+      for (vector_size_t begin = 0; begin < numBatchRows;
+           begin += kSegmentTreeLeafSize) {
+        initializeSingleGroup();
+        rows.clearAll();
+        rows.setValidRange(
+            begin, std::min(begin + kSegmentTreeLeafSize, numBatchRows), true);
+        rows.updateBounds();
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_, false);
+        storeSegmentTreeNode(numLeaves_ + leaf + begin / kSegmentTreeLeafSize);
+      }
+    }
+
+    auto* rawNodeIndices = nodeIndices_->asMutable<vector_size_t>();
+    for (auto node = numLeaves_ - 1; node > 0; --node) {
+      rawNodeIndices[0] = 2 * node;
+      rawNodeIndices[1] = 2 * node + 1;
+      initializeSingleGroup();
+      addSegmentTreeNodes(2);
+      storeSegmentTreeNode(node);
+    }
+  }
+
+  // Merges the first 'numNodes' nodes in 'nodeIndices_' into the single
+  // group.
+  void addSegmentTreeNodes(vector_size_t numNodes) {
+    const std::vector<VectorPtr> nodes = {BaseVector::wrapInDictionary(
+        nullptr, nodeIndices_, numNodes, segmentTree_)};
+    aggregate_->addSingleGroupIntermediateResults(
+        rawSingleGroupRow_, SelectivityVector(numNodes), nodes, false);
+  }
+
+  // Evaluates each frame as the merge of the segment tree nodes that cover
+  // the leaves within the frame with the raw input of the remaining rows at
+  // the edges of the frame. This reads O(log(partition size)) nodes and less
+  // than 2 * kSegmentTreeLeafSize rows per frame, instead of all its rows.
+  // The argument vectors have the rows from 'minFrame'.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    auto* rawNodeIndices = nodeIndices_->asMutable<vector_size_t>();
+    auto* rawEdgeRowIndices = edgeRowIndices_->asMutable<vector_size_t>();
+
+    validRows.applyToSelected([&](auto i) {
+      const auto frameStart = frameStartsVector[i];
+      const auto frameEnd = frameEndsVector[i] + 1;
+      // The leaves in [firstLeaf, endLeaf) are fully within the frame.
+      const auto firstLeaf =
+          bits::divRoundUp(frameStart, kSegmentTreeLeafSize);
+      const auto endLeaf = frameEnd / kSegmentTreeLeafSize;
+
+      vector_size_t numEdgeRows = 0;
+      const auto addEdgeRows = [&](vector_size_t begin, vector_size_t end) {
+        for (auto row = begin; row < end; ++row) {
+          rawEdgeRowIndices[numEdgeRows++] = row - minFrame;
+        }
+      };
+
+      initializeSingleGroup();
+      if (firstLeaf >= endLeaf) {
+        // The frame is within 2 adjacent leaves.
+        addEdgeRows(frameStart, frameEnd);
+      } else {
+        addEdgeRows(frameStart, firstLeaf * kSegmentTreeLeafSize);
+        addEdgeRows(endLeaf * kSegmentTreeLeafSize, frameEnd);
+
+        vector_size_t numNodes = 0;
+        for (auto left = firstLeaf + numLeaves_, right = endLeaf + numLeaves_;
+             left < right;
+             left >>= 1, right >>= 1) {
+          if (left & 1) {
+            rawNodeIndices[numNodes++] = left++;
+          }
+          if (right & 1) {
+            rawNodeIndices[numNodes++] = --right;
+          }
+        }
+        VELOX_DCHECK_LE(numNodes, kMaxSegmentTreeNodes);
+        addSegmentTreeNodes(numNodes);
+      }
+
+      if (numEdgeRows > 0) {
+        for (auto j = 0; j < argVectors_.size(); ++j) {
+          // Constant vectors are not wrapped. They have at least as many rows
+          // as the frame.
+          edgeArgVectors_[j] = argIndices_[j] == kConstantChannel
+              ? argVectors_[j]
+              : BaseVector::wrapInDictionary(
+                    nullptr, edgeRowIndices_, numEdgeRows, argVectors_[j]);
+        }
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_,
+            SelectivityVector(numEdgeRows),
+            edgeArgVectors_,
+            false);
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +609,26 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // True if the frames of the current partition can be evaluated with the
+  // segment tree.
+  bool useSegmentTree_{false};
+
+  // Intermediate results of the segment tree nodes for the current
+  // partition. Built on first use.
+  VectorPtr segmentTree_;
+  vector_size_t numLeaves_{0};
+
+  // Used to copy the intermediate result of a node to the segment tree. Set
+  // only if the aggregate supports the segment tree.
+  VectorPtr nodeResultVector_;
+
+  // Indices of the segment tree nodes and of the edge rows of a frame.
+  BufferPtr nodeIndices_;
+  BufferPtr edgeRowIndices_;
+
+  // Argument vectors for the edge rows of a frame.
+  std::vector<VectorPtr> edgeArgVectors_;
 };
 
 } // namespace
@@ -29,45 +29,81 @@ ArrowStream::ArrowStream(
           arrowStreamNode->id(),
           "ArrowStream") {
   arrowStream_ = arrowStreamNode->arrowStream();
+  if (driverCtx->queryConfig().arrowStreamPrefetch()) {
+    executor_ = driverCtx->task->queryCtx()->executor();
+  }
 }
 
 ArrowStream::~ArrowStream() {
   close();
 }
 
-RowVectorPtr ArrowStream::getOutput() {
+ArrowStream::Batch::~Batch() {
+  if (schema.release) {
+    schema.release(&schema);
+  }
+  if (array.release) {
+    array.release(&array);
+  }
+}
+
+std::unique_ptr<ArrowStream::Batch> ArrowStream::readBatch() {
+  auto batch = std::make_unique<Batch>();
   // Get Arrow array.
-  struct ArrowArray arrowArray;
-  if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
+  if (arrowStream_->get_next(arrowStream_.get(), &batch->array)) {
     VELOX_FAIL(
         "Failed to call get_next on ArrowStream: {}", std::string(getError()));
   }
-  if (arrowArray.release == nullptr) {
+  if (batch->array.release == nullptr) {
     // End of Stream.
-    finished_ = true;
     return nullptr;
   }
 
   // Get Arrow schema.
-  struct ArrowSchema arrowSchema;
-  if (arrowStream_->get_schema(arrowStream_.get(), &arrowSchema)) {
-    if (arrowSchema.release) {
-      arrowSchema.release(&arrowSchema);
-    }
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
+  if (arrowStream_->get_schema(arrowStream_.get(), &batch->schema)) {
     VELOX_FAIL(
         "Failed to call get_schema on ArrowStream: {}",
         std::string(getError()));
   }
+  return batch;
+}
+
+void ArrowStream::startPrefetch() {
+  nextBatch_ = std::make_shared<AsyncSource<Batch>>(
+      [this]() { return readBatch(); });
+  executor_->add([nextBatch = nextBatch_]() { nextBatch->prepare(); });
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (nextBatch_ != nullptr && !nextBatch_->readyOrFuture(future)) {
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+RowVectorPtr ArrowStream::getOutput() {
+  std::unique_ptr<Batch> batch;
+  if (executor_ == nullptr) {
+    batch = readBatch();
+  } else {
+    if (nextBatch_ == nullptr) {
+      startPrefetch();
+    }
+    auto nextBatch = std::move(nextBatch_);
+    batch = nextBatch->move();
+  }
+  if (batch == nullptr) {
+    finished_ = true;
+    return nullptr;
+  }
+  if (executor_ != nullptr) {
+    // Reads the next array while this one is processed.
+    startPrefetch();
+  }
 
   // Convert Arrow Array into RowVector and return.
   return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+      importFromArrowAsOwner(batch->schema, batch->array, pool()));
 }
 
 bool ArrowStream::isFinished() {
@@ -81,6 +117,11 @@ const char* ArrowStream::getError() const {
 }
 
 void ArrowStream::close() {
+  if (nextBatch_ != nullptr) {
+    // Waits for a read in progress before releasing the stream.
+    nextBatch_->close();
+    nextBatch_.reset();
+  }
   if (arrowStream_->release) {
     arrowStream_->release(arrowStream_.get());
   }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/core/PlanNode.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/Operator.h"
 
 #include "velox/vector/arrow/Abi.h"
@@ -31,20 +32,44 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // An Arrow array and its schema read from the stream. Releases them unless
+  // they were imported.
+  struct Batch {
+    ArrowArray array;
+    ArrowSchema schema;
+
+    Batch() {
+      array.release = nullptr;
+      schema.release = nullptr;
+    }
+
+    ~Batch();
+  };
+
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Reads the next array and its schema. Returns nullptr at the end of the
+  // stream.
+  std::unique_ptr<Batch> readBatch();
+
+  // Starts reading the next batch on 'executor_'.
+  void startPrefetch();
+
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // Set if QueryConfig::arrowStreamPrefetch() is true.
+  folly::Executor* executor_{nullptr};
+  // The batch being read on 'executor_'.
+  std::shared_ptr<AsyncSource<Batch>> nextBatch_;
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/CompiledKeyComparator.h"
+
+#include <cstring>
+#include <numeric>
+
+namespace facebook::velox::exec {
+
+CompiledKeyComparator::CompiledKeyComparator(
+    const RowContainer* rows,
+    const std::vector<column_index_t>& columns,
+    const std::vector<CompareFlags>& flags)
+    : rows_(rows) {
+  VELOX_CHECK(flags.empty() || flags.size() == columns.size());
+  compareSteps_.reserve(columns.size());
+  for (auto i = 0; i < columns.size(); ++i) {
+    const auto* type = rows_->columnTypes()[columns[i]].get();
+    Step step{
+        rows_->columnAt(columns[i]),
+        type,
+        flags.empty() ? CompareFlags() : flags[i]};
+    if (type->providesCustomComparison()) {
+      step.compare = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+          compareFunc, true, type->kind());
+      step.equals = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+          equalsFunc, true, type->kind());
+    } else {
+      step.compare = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+          compareFunc, false, type->kind());
+      step.equals = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+          equalsFunc, false, type->kind());
+    }
+    // Same as RowContainer::equals(), which does not use custom comparison.
+    if (type->kind() == TypeKind::UNKNOWN) {
+      step.decodedEquals[0] = decodedEqualsUnknown;
+      step.decodedEquals[1] = decodedEqualsUnknown;
+    } else {
+      step.decodedEquals[0] = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH(
+          decodedEqualsFunc, false, type->kind());
+      step.decodedEquals[1] = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH(
+          decodedEqualsFunc, true, type->kind());
+    }
+    compareSteps_.push_back(step);
+  }
+
+  // Merges the adjacent bytewise comparable columns into runs for equality.
+  for (auto i = 0; i < compareSteps_.size(); ++i) {
+    const auto& step = compareSteps_[i];
+    if (!isBytewiseComparable(*step.type)) {
+      equalsSteps_.push_back(step);
+      continue;
+    }
+    if (!equalsSteps_.empty()) {
+      auto& run = equalsSteps_.back();
+      if (run.runBytes > 0 &&
+          run.column.offset() + run.runBytes == step.column.offset() &&
+          run.column.nullByte() == step.column.nullByte()) {
+        run.runBytes += rows_->fixedSizeAt(columns[i]);
+        run.runNullMask |= step.column.nullMask();
+        continue;
+      }
+    }
+    Step run = step;
+    run.runBytes = rows_->fixedSizeAt(columns[i]);
+    run.runNullMask = step.column.nullMask();
+    equalsSteps_.push_back(run);
+  }
+  for (auto& step : equalsSteps_) {
+    if (step.runBytes > 0) {
+      step.equals = equalsRunFunc(step.runBytes);
+    }
+  }
+}
+
+// static
+CompiledKeyComparator CompiledKeyComparator::forKeys(
+    const RowContainer* rows,
+    const std::vector<CompareFlags>& flags) {
+  std::vector<column_index_t> columns(rows->keyTypes().size());
+  std::iota(columns.begin(), columns.end(), 0);
+  return CompiledKeyComparator(rows, columns, flags);
+}
+
+// static
+bool CompiledKeyComparator::isBytewiseComparable(const Type& type) {
+  if (type.providesCustomComparison()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      // Floating point values have several representations of NaN and zero.
+      return false;
+  }
+}
+
+// static
+template <bool typeProvidesCustomComparison, TypeKind Kind>
+CompiledKeyComparator::CompareFunc CompiledKeyComparator::compareFunc() {
+  return &compareTyped<typeProvidesCustomComparison, Kind>;
+}
+
+// static
+template <bool typeProvidesCustomComparison, TypeKind Kind>
+int32_t CompiledKeyComparator::compareTyped(
+    const RowContainer& rows,
+    const Step& step,
+    const char* left,
+    const char* right) {
+  return rows.compare<typeProvidesCustomComparison, Kind>(
+      left, right, step.type, step.column, step.flags);
+}
+
+// static
+template <bool typeProvidesCustomComparison, TypeKind Kind>
+CompiledKeyComparator::EqualsFunc CompiledKeyComparator::equalsFunc() {
+  return &equalsTyped<typeProvidesCustomComparison, Kind>;
+}
+
+// static
+template <bool typeProvidesCustomComparison, TypeKind Kind>
+bool CompiledKeyComparator::equalsTyped(
+    const RowContainer& rows,
+    const Step& step,
+    const char* left,
+    const char* right) {
+  return rows.compare<typeProvidesCustomComparison, Kind>(
+             left, right, step.type, step.column, CompareFlags{true, true}) ==
+      0;
+}
+
+// static
+CompiledKeyComparator::EqualsFunc CompiledKeyComparator::equalsRunFunc(
+    int32_t runBytes) {
+  switch (runBytes) {
+    case 1:
+      return &equalsRun<1>;
+    case 2:
+      return &equalsRun<2>;
+    case 4:
+      return &equalsRun<4>;
+    case 8:
+      return &equalsRun<8>;
+    case 12:
+      return &equalsRun<12>;
+    case 16:
+      return &equalsRun<16>;
+    case 24:
+      return &equalsRun<24>;
+    case 32:
+      return &equalsRun<32>;
+    default:
+      return &equalsRun<0>;
+  }
+}
+
+// static
+template <int32_t kBytes>
+bool CompiledKeyComparator::equalsRun(
+    const RowContainer& /*rows*/,
+    const Step& step,
+    const char* left,
+    const char* right) {
+  const auto nullByte = step.column.nullByte();
+  if ((left[nullByte] ^ right[nullByte]) & step.runNullMask) {
+    return false;
+  }
+  const auto offset = step.column.offset();
+  if constexpr (kBytes == 0) {
+    return std::memcmp(left + offset, right + offset, step.runBytes) == 0;
+  } else {
+    // A constant size lets the compiler inline the comparison.
+    return std::memcmp(left + offset, right + offset, kBytes) == 0;
+  }
+}
+
+// static
+template <bool mayHaveNulls, TypeKind Kind>
+CompiledKeyComparator::DecodedEqualsFunc
+CompiledKeyComparator::decodedEqualsFunc() {
+  return &decodedEqualsTyped<mayHaveNulls, Kind>;
+}
+
+// static
+template <bool mayHaveNulls, TypeKind Kind>
+bool CompiledKeyComparator::decodedEqualsTyped(
+    const RowContainer& rows,
+    const Step& step,
+    const char* row,
+    const DecodedVector& decoded,
+    vector_size_t index) {
+  if constexpr (mayHaveNulls) {
+    return rows.equalsWithNulls<false, Kind>(
+        row,
+        step.column.offset(),
+        step.column.nullByte(),
+        step.column.nullMask(),
+        decoded,
+        index);
+  } else {
+    return rows.equalsNoNulls<false, Kind>(
+        row, step.column.offset(), decoded, index);
+  }
+}
+
+// static
+bool CompiledKeyComparator::decodedEqualsUnknown(
+    const RowContainer& /*rows*/,
+    const Step& step,
+    const char* row,
+    const DecodedVector& /*decoded*/,
+    vector_size_t /*index*/) {
+  return RowContainer::isNullAt(
+      row, step.column.nullByte(), step.column.nullMask());
+}
+
+} // namespace facebook::velox::exec
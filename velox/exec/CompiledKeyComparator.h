@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Compares columns of rows in a RowContainer using a fixed sequence of
+/// comparators that is resolved once from the types and the layout of the
+/// columns. RowContainer::compare() and RowContainer::equals() dispatch on the
+/// type of each column for every comparison. For equality, adjacent
+/// fixed-width columns whose null flags are in the same byte are compared as a
+/// single run of bytes with memcmp. This relies on RowContainer storing a zero
+/// value for a null fixed-width value.
+class CompiledKeyComparator {
+ public:
+  /// Compares 'columns' of 'rows' in the given order. 'flags' is either empty
+  /// for the default flags or has one entry per column.
+  CompiledKeyComparator(
+      const RowContainer* rows,
+      const std::vector<column_index_t>& columns,
+      const std::vector<CompareFlags>& flags = {});
+
+  /// Returns the comparator for all the keys of 'rows'.
+  static CompiledKeyComparator forKeys(
+      const RowContainer* rows,
+      const std::vector<CompareFlags>& flags = {});
+
+  /// Returns 0 if the columns of 'left' and 'right' are equal, < 0 if 'left'
+  /// sorts before 'right' and > 0 otherwise.
+  int32_t compare(const char* left, const char* right) const {
+    for (const auto& step : compareSteps_) {
+      if (auto result = step.compare(*rows_, step, left, right)) {
+        return result;
+      }
+    }
+    return 0;
+  }
+
+  /// Returns true if the columns of 'left' and 'right' are equal. Nulls are
+  /// equal to nulls.
+  bool equals(const char* left, const char* right) const {
+    for (const auto& step : equalsSteps_) {
+      if (!step.equals(*rows_, step, left, right)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Returns true if the columns of 'row' are equal to the values at 'index'
+  /// in the decoded vectors of 'hashers'. 'hashers[i]' has the value for the
+  /// i-th compared column. Nulls are checked only if 'mayHaveNulls' is true.
+  /// Matches RowContainer::equals().
+  template <bool mayHaveNulls, typename Hashers>
+  bool equals(const char* row, const Hashers& hashers, vector_size_t index)
+      const {
+    for (auto i = 0; i < compareSteps_.size(); ++i) {
+      const auto& step = compareSteps_[i];
+      if (!step.decodedEquals[mayHaveNulls](
+              *rows_, step, row, hashers[i]->decodedVector(), index)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  struct Step;
+
+  using CompareFunc = int32_t (*)(
+      const RowContainer& rows,
+      const Step& step,
+      const char* left,
+      const char* right);
+
+  using EqualsFunc = bool (*)(
+      const RowContainer& rows,
+      const Step& step,
+      const char* left,
+      const char* right);
+
+  using DecodedEqualsFunc = bool (*)(
+      const RowContainer& rows,
+      const Step& step,
+      const char* row,
+      const DecodedVector& decoded,
+      vector_size_t index);
+
+  struct Step {
+    RowColumn column;
+    const Type* type;
+    CompareFlags flags;
+    // Number of bytes compared by memcmp for a run of fixed-width columns
+    // starting at 'column'. 0 if this is not a run.
+    int32_t runBytes{0};
+    // Null mask of all the columns of the run in the null byte of 'column'.
+    uint8_t runNullMask{0};
+    CompareFunc compare{nullptr};
+    EqualsFunc equals{nullptr};
+    // Indexed by 'mayHaveNulls'.
+    DecodedEqualsFunc decodedEquals[2]{nullptr, nullptr};
+  };
+
+  // Returns true if equality of values of 'type' is equality of their bytes
+  // in the RowContainer.
+  static bool isBytewiseComparable(const Type& type);
+
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static CompareFunc compareFunc();
+
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static int32_t compareTyped(
+      const RowContainer& rows,
+      const Step& step,
+      const char* left,
+      const char* right);
+
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static EqualsFunc equalsFunc();
+
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static bool equalsTyped(
+      const RowContainer& rows,
+      const Step& step,
+      const char* left,
+      const char* right);
+
+  static EqualsFunc equalsRunFunc(int32_t runBytes);
+
+  template <int32_t kBytes>
+  static bool equalsRun(
+      const RowContainer& rows,
+      const Step& step,
+      const char* left,
+      const char* right);
+
+  template <bool mayHaveNulls, TypeKind Kind>
+  static DecodedEqualsFunc decodedEqualsFunc();
+
+  template <bool mayHaveNulls, TypeKind Kind>
+  static bool decodedEqualsTyped(
+      const RowContainer& rows,
+      const Step& step,
+      const char* row,
+      const DecodedVector& decoded,
+      vector_size_t index);
+
+  static bool decodedEqualsUnknown(
+      const RowContainer& rows,
+      const Step& step,
+      const char* row,
+      const DecodedVector& decoded,
+      vector_size_t index);
+
+  const RowContainer* const rows_;
+
+  // One step per compared column.
+  std::vector<Step> compareSteps_;
+
+  // Steps for row to row equality. Runs of fixed-width columns are merged
+  // into one step.
+  std::vector<Step> equalsSteps_;
+};
+
+} // namespace facebook::velox::exec
@@ -125,6 +125,78 @@ void writeNulls(
   }
 }
 
+// Returns true if the values of 'kind' are serialized as their fixed width
+// native representation. Arrays of these are serialized, deserialized,
+// compared and hashed by loops for the element kind, which is dispatched on
+// once per array instead of once per element.
+bool isFixedWidthKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <TypeKind Kind>
+constexpr bool kFixedWidthKind =
+    TypeTraits<Kind>::isFixedWidth && Kind != TypeKind::BOOLEAN;
+
+bool isFlatFixedWidth(const BaseVector& vector) {
+  return vector.encoding() == VectorEncoding::Simple::FLAT &&
+      isFixedWidthKind(vector.typeKind());
+}
+
+// Appends the non-null values of flat 'elements' in [offset, offset + size).
+template <TypeKind Kind>
+void serializeFlatValues(
+    const BaseVector& elements,
+    vector_size_t offset,
+    vector_size_t size,
+    ByteOutputStream& out) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto* values = elements.asUnchecked<FlatVector<T>>()->rawValues();
+    const auto* nulls = elements.rawNulls();
+    if (nulls == nullptr) {
+      out.append(folly::Range(values + offset, size));
+      return;
+    }
+    bits::forEachSetBit(nulls, offset, offset + size, [&](auto row) {
+      out.appendOne<T>(values[row]);
+    });
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
+// Appends the non-null values of flat 'elements' at 'indices'.
+template <TypeKind Kind>
+void serializeFlatValues(
+    const BaseVector& elements,
+    folly::Range<const vector_size_t*> indices,
+    ByteOutputStream& out) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto* values = elements.asUnchecked<FlatVector<T>>()->rawValues();
+    const auto* nulls = elements.rawNulls();
+    for (auto i : indices) {
+      if (nulls == nullptr || !bits::isBitNull(nulls, i)) {
+        out.appendOne<T>(values[i]);
+      }
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 void serializeArray(
     const BaseVector& elements,
     vector_size_t offset,
@@ -133,6 +205,11 @@ void serializeArray(
     const ContainerRowSerdeOptions& options) {
   out.appendOne<int32_t>(size);
   writeNulls(elements, offset, size, out);
+  if (isFlatFixedWidth(elements)) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeFlatValues, elements.typeKind(), elements, offset, size, out);
+    return;
+  }
   for (auto i = 0; i < size; ++i) {
     if (!elements.isNullAt(i + offset)) {
       serializeSwitch(elements, i + offset, out, options);
@@ -147,6 +224,11 @@ void serializeArray(
     const ContainerRowSerdeOptions& options) {
   out.appendOne<int32_t>(indices.size());
   writeNulls(elements, indices, out);
+  if (isFlatFixedWidth(elements)) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeFlatValues, elements.typeKind(), elements, indices, out);
+    return;
+  }
   for (auto i : indices) {
     if (!elements.isNullAt(i)) {
       serializeSwitch(elements, i, out, options);
@@ -284,6 +366,35 @@ void deserializeOne<TypeKind::ROW>(
   result.setNull(index, false);
 }
 
+// Reads the values of a serialized array with 'nulls' into flat 'elements'
+// in [offset, offset + size).
+template <TypeKind Kind>
+void deserializeFlatValues(
+    ByteInputStream& in,
+    const uint64_t* nulls,
+    vector_size_t offset,
+    vector_size_t size,
+    BaseVector& elements) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    auto* values = elements.asUnchecked<FlatVector<T>>();
+    if (bits::isAllSet(nulls, 0, size, false)) {
+      in.readBytes(values->mutableRawValues() + offset, size * sizeof(T));
+      elements.clearNulls(offset, offset + size);
+      return;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (bits::isBitSet(nulls, i)) {
+        elements.setNull(i + offset, true);
+      } else {
+        values->set(i + offset, in.read<T>());
+      }
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 // Reads the size, null flags and deserializes from 'in', appending to
 // the end of 'elements'. Returns the number of added elements and
 // sets 'offset' to the index of the first added element.
@@ -295,6 +406,17 @@ vector_size_t deserializeArray(
   auto nulls = readNulls(in, size);
   offset = elements.size();
   elements.resize(offset + size);
+  if (size > 0 && isFlatFixedWidth(elements)) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        deserializeFlatValues,
+        elements.typeKind(),
+        in,
+        nulls.data(),
+        offset,
+        size,
+        elements);
+    return size;
+  }
   for (auto i = 0; i < size; ++i) {
     if (bits::isBitSet(nulls.data(), i)) {
       elements.setNull(i + offset, true);
@@ -482,6 +604,44 @@ std::optional<int32_t> compare(
   return 0;
 }
 
+// Compares the first 'compareSize' elements of a serialized array with
+// 'leftNulls' to the values of flat 'elements' at 'rightIndex(i)'.
+template <TypeKind Kind, typename RightIndex>
+std::optional<int32_t> compareFlatElements(
+    ByteInputStream& left,
+    const uint64_t* leftNulls,
+    const BaseVector& elements,
+    int32_t compareSize,
+    RightIndex rightIndex,
+    CompareFlags flags) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto* values = elements.asUnchecked<FlatVector<T>>()->rawValues();
+    const auto* rightNulls = elements.rawNulls();
+    for (auto i = 0; i < compareSize; ++i) {
+      const auto index = rightIndex(i);
+      const bool leftNull = bits::isBitSet(leftNulls, i);
+      const bool rightNull =
+          rightNulls != nullptr && bits::isBitNull(rightNulls, index);
+      if (leftNull || rightNull) {
+        auto result = BaseVector::compareNulls(leftNull, rightNull, flags);
+        if (result.has_value() && result.value() == 0) {
+          continue;
+        }
+        return result;
+      }
+      const auto result = SimpleVector<T>::comparePrimitiveAsc(
+          left.read<T>(), values[index]);
+      if (result != 0) {
+        return flags.ascending ? result : result * -1;
+      }
+    }
+    return 0;
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 template <bool elementTypeProvidesCustomComparison>
 std::optional<int32_t> compareArrays(
     ByteInputStream& left,
@@ -495,6 +655,22 @@ std::optional<int32_t> compareArrays(
   }
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
+  if (!elementTypeProvidesCustomComparison && isFlatFixedWidth(elements)) {
+    auto rightIndex = [&](auto i) { return offset + i; };
+    auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        compareFlatElements,
+        elements.typeKind(),
+        left,
+        leftNulls.data(),
+        elements,
+        compareSize,
+        rightIndex,
+        flags);
+    if (!result.has_value() || result.value() != 0) {
+      return result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   auto wrappedElements = elements.wrappedVector();
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
@@ -532,6 +708,22 @@ std::optional<int32_t> compareArrayIndices(
   }
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
+  if (!elementTypeProvidesCustomComparison && isFlatFixedWidth(elements)) {
+    auto rightIndex = [&](auto i) { return rightIndices[i]; };
+    auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        compareFlatElements,
+        elements.typeKind(),
+        left,
+        leftNulls.data(),
+        elements,
+        compareSize,
+        rightIndex,
+        flags);
+    if (!result.has_value() || result.value() != 0) {
+      return result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   auto wrappedElements = elements.wrappedVector();
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
@@ -725,6 +917,39 @@ std::optional<int32_t> compare(
                          : rightValue.compare(leftValue);
 }
 
+// Compares the first 'compareSize' elements of two serialized arrays with
+// 'leftNulls' and 'rightNulls'.
+template <TypeKind Kind>
+std::optional<int32_t> compareFixedWidthElements(
+    ByteInputStream& left,
+    ByteInputStream& right,
+    const uint64_t* leftNulls,
+    const uint64_t* rightNulls,
+    int32_t compareSize,
+    const Type* elementType,
+    CompareFlags flags) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    for (auto i = 0; i < compareSize; ++i) {
+      const bool leftNull = bits::isBitSet(leftNulls, i);
+      const bool rightNull = bits::isBitSet(rightNulls, i);
+      if (leftNull || rightNull) {
+        auto result = BaseVector::compareNulls(leftNull, rightNull, flags);
+        if (result.has_value() && result.value() == 0) {
+          continue;
+        }
+        return result;
+      }
+      auto result = compare<false, Kind>(left, right, elementType, flags);
+      if (result.value() != 0) {
+        return result;
+      }
+    }
+    return 0;
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 template <bool elementTypeProvidesCustomComparison>
 std::optional<int32_t> compareArrays(
     ByteInputStream& left,
@@ -739,6 +964,23 @@ std::optional<int32_t> compareArrays(
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
   auto rightNulls = readNulls(right, rightSize);
+  if (!elementTypeProvidesCustomComparison &&
+      isFixedWidthKind(elementType->kind())) {
+    auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        compareFixedWidthElements,
+        elementType->kind(),
+        left,
+        right,
+        leftNulls.data(),
+        rightNulls.data(),
+        compareSize,
+        elementType,
+        flags);
+    if (!result.has_value() || result.value() != 0) {
+      return result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
     bool rightNull = bits::isBitSet(rightNulls.data(), i);
@@ -908,11 +1150,44 @@ uint64_t hashOne(ByteInputStream& stream, const Type* /*type*/) {
   return folly::hasher<StringView>()(readStringView(stream, storage));
 }
 
+// Mixes the hashes of the 'size' elements of a serialized array with 'nulls'
+// into 'hash'.
+template <TypeKind Kind>
+uint64_t hashFixedWidthElements(
+    ByteInputStream& in,
+    const uint64_t* nulls,
+    int32_t size,
+    uint64_t hash,
+    const Type* elementType) {
+  if constexpr (kFixedWidthKind<Kind>) {
+    for (auto i = 0; i < size; ++i) {
+      const uint64_t value = bits::isBitSet(nulls, i)
+          ? BaseVector::kNullHash
+          : hashOne<false, Kind>(in, elementType);
+      hash = bits::commutativeHashMix(hash, value);
+    }
+    return hash;
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 template <bool elementTypeProvidesCustomComparison>
 uint64_t
 hashArray(ByteInputStream& in, uint64_t hash, const Type* elementType) {
   auto size = in.read<int32_t>();
   auto nulls = readNulls(in, size);
+  if (!elementTypeProvidesCustomComparison &&
+      isFixedWidthKind(elementType->kind())) {
+    return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        hashFixedWidthElements,
+        elementType->kind(),
+        in,
+        nulls.data(),
+        size,
+        hash,
+        elementType);
+  }
   for (auto i = 0; i < size; ++i) {
     uint64_t value;
     if (bits::isBitSet(nulls.data(), i)) {
@@ -26,7 +26,10 @@ struct ContainerRowSerdeOptions {
   bool isKey = true;
 };
 
-/// Row-wise serialization for use in hash tables and order by.
+/// Row-wise serialization for use in hash tables and order by. The elements of
+/// arrays and maps of fixed width types are serialized as contiguous values
+/// after the size and null flags. These are copied, compared and hashed with
+/// loops for the element type instead of dispatching on each element.
 class ContainerRowSerde {
  public:
   /// Serializes value from source[index] into 'out'. The value must not be
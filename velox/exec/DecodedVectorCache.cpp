@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DecodedVectorCache.h"
+
+namespace facebook::velox::exec {
+
+DecodedVectorCache::DecodedVectorCache(int32_t capacity)
+    : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+  entries_.reserve(capacity_);
+  hashEntries_.reserve(capacity_);
+}
+
+std::shared_ptr<DecodedVector> DecodedVectorCache::get(
+    const VectorPtr& vector,
+    const SelectivityVector& rows) {
+  for (const auto& entry : entries_) {
+    if (entry.vector == vector && entry.rows == rows) {
+      ++numHits_;
+      return entry.decoded;
+    }
+  }
+
+  ++numMisses_;
+  auto decoded = std::make_shared<DecodedVector>(*vector->loadedVector(), rows);
+  // Materializes the nulls for all of 'rows' now. Otherwise the first
+  // consumer calling nulls() with a subset of 'rows', e.g. after deselecting
+  // rows with null keys, would compute them only for that subset.
+  decoded->nulls(&rows);
+  if (entries_.size() < capacity_) {
+    entries_.push_back({vector, rows, decoded});
+  } else {
+    // The entries are usually consumed shortly after they are added, so the
+    // oldest one is replaced.
+    entries_[nextVictim_] = {vector, rows, decoded};
+    nextVictim_ = (nextVictim_ + 1) % capacity_;
+  }
+  return decoded;
+}
+
+const raw_vector<uint64_t>& DecodedVectorCache::hashes(
+    const VectorPtr& vector,
+    const SelectivityVector& rows,
+    const std::function<void(raw_vector<uint64_t>& hashes)>& computeHashes) {
+  for (const auto& entry : hashEntries_) {
+    if (entry.vector == vector && entry.rows == rows) {
+      ++numHashHits_;
+      return entry.hashes;
+    }
+  }
+
+  ++numHashMisses_;
+  HashEntry* entry;
+  if (hashEntries_.size() < capacity_) {
+    entry = &hashEntries_.emplace_back();
+  } else {
+    entry = &hashEntries_[nextHashVictim_];
+    nextHashVictim_ = (nextHashVictim_ + 1) % capacity_;
+  }
+  entry->vector = vector;
+  entry->rows = rows;
+  entry->hashes.resize(rows.end());
+  computeHashes(entry->hashes);
+  return entry->hashes;
+}
+
+void DecodedVectorCache::clear() {
+  entries_.clear();
+  nextVictim_ = 0;
+  hashEntries_.clear();
+  nextHashVictim_ = 0;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+
+#include "velox/common/base/RawVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the DecodedVectors of the vectors recently decoded by the operators
+/// of a Driver, so that the consumers of the same vector with the same rows,
+/// e.g. the hash tables of consecutive operators keyed on the same column,
+/// decode it once. The cached vectors are referenced by the cache so that
+/// they cannot be modified in place. The Driver clears the cache before its
+/// source operator produces the next batch. The cache also keeps the hashes
+/// of the hash table keys, so that the sibling operators grouping on the same
+/// columns, e.g. a MarkDistinct per distinct aggregate followed by the
+/// aggregation, hash them once. Not thread-safe.
+class DecodedVectorCache {
+ public:
+  static constexpr int32_t kDefaultCapacity = 8;
+
+  explicit DecodedVectorCache(int32_t capacity = kDefaultCapacity);
+
+  /// Returns the loaded 'vector' decoded for 'rows'. Decodes it unless it was
+  /// decoded for the same rows since the last clear(). The result may be
+  /// shared with other consumers and must not be decoded again.
+  std::shared_ptr<DecodedVector> get(
+      const VectorPtr& vector,
+      const SelectivityVector& rows);
+
+  /// Returns the hashes of 'vector' for 'rows' as computed by
+  /// VectorHasher::hash() without mixing. Calls 'computeHashes' to set them
+  /// unless they were computed for the same vector and rows since the last
+  /// clear(). Only the positions of 'rows' are set. The result is valid until
+  /// the next call to hashes() or clear().
+  const raw_vector<uint64_t>& hashes(
+      const VectorPtr& vector,
+      const SelectivityVector& rows,
+      const std::function<void(raw_vector<uint64_t>& hashes)>& computeHashes);
+
+  /// Drops all the entries and the references to their vectors.
+  void clear();
+
+  int64_t numHits() const {
+    return numHits_;
+  }
+
+  int64_t numMisses() const {
+    return numMisses_;
+  }
+
+  int64_t numHashHits() const {
+    return numHashHits_;
+  }
+
+  int64_t numHashMisses() const {
+    return numHashMisses_;
+  }
+
+ private:
+  struct Entry {
+    VectorPtr vector;
+    SelectivityVector rows;
+    std::shared_ptr<DecodedVector> decoded;
+  };
+
+  struct HashEntry {
+    VectorPtr vector;
+    SelectivityVector rows;
+    raw_vector<uint64_t> hashes;
+  };
+
+  const int32_t capacity_;
+  std::vector<Entry> entries_;
+  // The entry to replace when 'entries_' is full.
+  int32_t nextVictim_{0};
+  std::vector<HashEntry> hashEntries_;
+  int32_t nextHashVictim_{0};
+  int64_t numHits_{0};
+  int64_t numMisses_{0};
+  int64_t numHashHits_{0};
+  int64_t numHashMisses_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -86,6 +86,15 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct values of a group read back from spill to 'group'.
+  /// 'input' is an array of the distinct values of a group as written by the
+  /// spill extract function of accumulator(). 'index' is the row of the group
+  /// in 'input'.
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
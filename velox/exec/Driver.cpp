@@ -16,7 +16,11 @@
 
 #include "velox/exec/Driver.h"
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -76,6 +80,23 @@ std::exception_ptr makeException(
       false));
 }
 
+// Returns the name of the Operator method whose time is recorded in 'timing'.
+const char* timingName(CpuWallTiming OperatorStats::*timing) {
+  if (timing == &OperatorStats::addInputTiming) {
+    return "addInput";
+  }
+  if (timing == &OperatorStats::getOutputTiming) {
+    return "getOutput";
+  }
+  if (timing == &OperatorStats::isBlockedTiming) {
+    return "isBlocked";
+  }
+  if (timing == &OperatorStats::finishTiming) {
+    return "finish";
+  }
+  return "unknown";
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -89,7 +110,11 @@ DriverCtx::DriverCtx(
       splitGroupId(_splitGroupId),
       partitionId(_partitionId),
       task(std::move(_task)),
-      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}) {}
+      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}) {
+  if (queryConfig().decodedVectorCacheEnabled()) {
+    decodedVectorCache = std::make_unique<DecodedVectorCache>();
+  }
+}
 
 const core::QueryConfig& DriverCtx::queryConfig() const {
   return task->queryCtx()->queryConfig();
@@ -125,7 +150,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -144,7 +169,23 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillAsyncWriteEnabled());
+  spillConfig.columnarFormat = queryConfig.spillColumnarFormatEnabled();
+  spillConfig.readAheadEnabled = queryConfig.spillReadAheadEnabled();
+  const auto localQuotaBytes = queryConfig.spillLocalQuotaBytes();
+  if (localQuotaBytes > 0 && !task->remoteSpillDirectory().empty()) {
+    spillConfig.remoteSpillConfig = common::RemoteSpillConfig{
+        [this]() -> std::string_view {
+          return task->getOrCreateRemoteSpillDirectory();
+        },
+        [this, localQuotaBytes]() {
+          return task->queryCtx()->spilledBytes() >= localQuotaBytes;
+        },
+        queryConfig.spillRemoteWriteBufferSize(),
+        queryConfig.spillRemoteReadBufferSize()};
+  }
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -181,6 +222,19 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          const auto blockedMicros =
+              getCurrentTimeMicro() - state->sinceMicros_;
+          task->addDriverBlockedTimeLocked(
+              driver->driverCtx()->pipelineId, state->reason_, blockedMicros);
+          if (auto* timeline = task->timeline()) {
+            timeline->addBlocked(
+                driver->driverCtx()->pipelineId,
+                driver->driverCtx()->driverId,
+                state->operator_->planNodeId(),
+                state->reason_,
+                state->sinceMicros_,
+                blockedMicros);
+          }
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -240,8 +294,15 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* scheduler = dynamic_cast<DriverScheduler*>(executor)) {
+    DriverScheduler::DriverInfo info;
+    info.lastWorker = driver->lastWorker_;
+    info.taskCpuNanos = driver->task()->driverCpuNanos();
+    scheduler->addDriver([driver]() { Driver::run(driver); }, info);
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -254,6 +315,7 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  timeline_ = task()->timeline();
 }
 
 void Driver::initializeOperators() {
@@ -595,6 +657,10 @@ StopReason Driver::runInternal(
           if (needsInput) {
             uint64_t resultBytes = 0;
             RowVectorPtr intermediateResult;
+            if (i == 0 && ctx_->decodedVectorCache != nullptr) {
+              // The vectors of the previous batch are not consumed anymore.
+              ctx_->decodedVectorCache->clear();
+            }
             withDeltaCpuWallTimer(op, &OperatorStats::getOutputTiming, [&]() {
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
@@ -763,9 +829,12 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  self->lastWorker_ = DriverScheduler::currentWorker();
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
+  const auto startCpuNanos = process::threadCpuNanos();
   auto reason = self->runInternal(self, blockingState, nullResult);
+  self->task()->addDriverCpuNanos(process::threadCpuNanos() - startCpuNanos);
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -857,6 +926,9 @@ void Driver::close() {
   }
   closeOperators();
   updateStats();
+  if (ctx_->decodedVectorCache != nullptr) {
+    ctx_->decodedVectorCache->clear();
+  }
   closed_ = true;
   Task::removeDriver(ctx_->task, this);
 }
@@ -1037,24 +1109,47 @@ void Driver::withDeltaCpuWallTimer(
     Operator* op,
     TimingMemberPtr opTimingMember,
     Func&& opFunction) {
-  // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
-  // to track cpu and wall time of the opFunction.
-  if (!trackOperatorCpuUsage_) {
-    return opFunction();
-  }
+  auto timedFunction = [&]() {
+    // If 'trackOperatorCpuUsage_' is true, create and initialize the timer
+    // object to track cpu and wall time of the opFunction.
+    if (!trackOperatorCpuUsage_) {
+      return opFunction();
+    }
 
-  // The delta CpuWallTiming object would be recorded to the corresponding
-  // opTimingMember upon destruction of the timer when withDeltaCpuWallTimer
-  // ends. The timer is created on the stack to avoid heap allocation
-  auto f = [op, opTimingMember, this](const CpuWallTiming& elapsedTime) {
-    auto elapsedSelfTime = processLazyIoStats(*op, elapsedTime);
-    op->stats().withWLock([&](auto& lockedStats) {
-      (lockedStats.*opTimingMember).add(elapsedSelfTime);
-    });
+    // The delta CpuWallTiming object would be recorded to the corresponding
+    // opTimingMember upon destruction of the timer when withDeltaCpuWallTimer
+    // ends. The timer is created on the stack to avoid heap allocation
+    auto f = [op, opTimingMember, this](const CpuWallTiming& elapsedTime) {
+      auto elapsedSelfTime = processLazyIoStats(*op, elapsedTime);
+      op->stats().withWLock([&](auto& lockedStats) {
+        (lockedStats.*opTimingMember).add(elapsedSelfTime);
+      });
+    };
+    DeltaCpuWallTimer<decltype(f)> timer(std::move(f));
+
+    opFunction();
   };
-  DeltaCpuWallTimer<decltype(f)> timer(std::move(f));
 
-  opFunction();
+  if (FOLLY_LIKELY(timeline_ == nullptr)) {
+    return timedFunction();
+  }
+
+  const auto startMicros = getCurrentTimeMicro();
+  const auto startBytes = op->pool()->usedBytes();
+  SCOPE_EXIT {
+    const auto bytes = op->pool()->usedBytes();
+    timeline_->addOperatorCall(
+        ctx_->pipelineId,
+        ctx_->driverId,
+        op->operatorType(),
+        op->planNodeId(),
+        timingName(opTimingMember),
+        startMicros,
+        getCurrentTimeMicro() - startMicros,
+        bytes,
+        bytes - startBytes);
+  };
+  timedFunction();
 }
 
 void Driver::validateOperatorOutputResult(
@@ -1146,6 +1241,10 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForAggregationMerge:
+      return "kWaitForAggregationMerge";
+    case BlockingReason::kWaitForOrderByRanges:
+      return "kWaitForOrderByRanges";
   }
   VELOX_UNREACHABLE();
 }
@@ -27,6 +27,7 @@
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DecodedVectorCache.h"
 #include "velox/exec/TraceConfig.h"
 
 namespace facebook::velox::exec {
@@ -36,6 +37,7 @@ class ExchangeClient;
 class Operator;
 struct OperatorStats;
 class Task;
+class TaskTimeline;
 
 enum class StopReason {
   /// Keep running.
@@ -111,6 +113,9 @@ struct ThreadState {
   /// True if there is a future outstanding that will schedule this on an
   /// executor thread when some promise is realized.
   bool hasBlockingFuture{false};
+  /// True if the Driver is created but not started by a Task which adapts
+  /// the number of running Drivers of its pipeline.
+  bool isStandby{false};
   /// The number of suspension requests on a on-thread driver. If > 0, this
   /// driver thread is in a (recursive) section waiting for RPC or memory
   /// strategy decision. The thread is not supposed to access its memory, which
@@ -213,6 +218,12 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// Final aggregation operator is blocked waiting for all its peers to
+  /// partition their groups for merging them across the drivers.
+  kWaitForAggregationMerge,
+  /// OrderBy operator is blocked waiting for all its peers to agree on the
+  /// key ranges or to partition their rows by range.
+  kWaitForOrderByRanges,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -281,6 +292,9 @@ struct DriverCtx {
   /// auxiliary operator such as the aggregation operator used by the table
   /// writer to generate the columns stats.
   std::unordered_map<int32_t, std::string> tracedOperatorMap;
+  /// Decoded vectors shared by the operators of the driver. Null unless
+  /// QueryConfig::decodedVectorCacheEnabled() is true.
+  std::unique_ptr<DecodedVectorCache> decodedVectorCache;
 
   DriverCtx(
       std::shared_ptr<Task> _task,
@@ -303,7 +317,9 @@ struct DriverCtx {
   common::PrefixSortConfig prefixSortConfig() const {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
-        queryConfig().prefixSortMinRows()};
+        queryConfig().prefixSortMinRows(),
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().prefixSortRadixSortMinRows()};
   }
 };
 
@@ -570,6 +586,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartUs_{0};
+  // The DriverScheduler worker of the last run, -1 if not run on a
+  // DriverScheduler. Used as the preferred worker when enqueued again.
+  std::atomic<int32_t> lastWorker_{-1};
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -582,6 +601,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // The timeline of the Task if it records one.
+  TaskTimeline* timeline_{nullptr};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -607,6 +629,10 @@ struct DriverAdapter {
 
 struct DriverFactory {
   std::vector<std::shared_ptr<const core::PlanNode>> planNodes;
+  /// If not empty, the nodes to make the operators from. Same as 'planNodes'
+  /// except that the chains of Filter and Project nodes are fused. Set by
+  /// LocalPlanner if QueryConfig::filterProjectChainFusionEnabled() is true.
+  std::vector<std::shared_ptr<const core::PlanNode>> fusedPlanNodes;
   /// Function that will generate the final operator of a driver being
   /// constructed.
   OperatorSupplier consumerSupplier;
@@ -655,8 +681,11 @@ struct DriverFactory {
 
   static void registerAdapter(DriverAdapter adapter);
 
-  bool supportsSerialExecution() const {
-    return !needsPartitionedOutput() && !needsExchangeClient();
+  /// Returns true if the Drivers of this pipeline can run in Task::next().
+  /// An exchange client fetches remote data on an executor, so that a
+  /// pipeline reading from an Exchange needs 'hasExecutor'.
+  bool supportsSerialExecution(bool hasExecutor) const {
+    return hasExecutor || !needsExchangeClient().has_value();
   }
 
   const core::PlanNodeId& leafNodeId() const {
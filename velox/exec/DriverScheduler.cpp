@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec {
+namespace {
+thread_local int32_t currentWorkerIndex{-1};
+} // namespace
+
+// static
+int32_t DriverScheduler::currentWorker() {
+  return currentWorkerIndex;
+}
+
+// static
+void DriverScheduler::setCurrentWorker(int32_t worker) {
+  currentWorkerIndex = worker;
+}
+
+WorkStealingDriverScheduler::WorkStealingDriverScheduler(
+    int32_t numWorkers,
+    std::string threadNamePrefix) {
+  VELOX_CHECK_GT(numWorkers, 0);
+  workers_.reserve(numWorkers);
+  for (auto i = 0; i < numWorkers; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (auto i = 0; i < numWorkers; ++i) {
+    workers_[i]->thread = std::thread([this, i, threadNamePrefix]() {
+      folly::setThreadName(fmt::format("{}{}", threadNamePrefix, i));
+      runWorker(i);
+    });
+  }
+}
+
+WorkStealingDriverScheduler::~WorkStealingDriverScheduler() {
+  stopped_ = true;
+  for (auto& worker : workers_) {
+    std::lock_guard<std::mutex> l(worker->mutex);
+    worker->wakeup.notify_one();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void WorkStealingDriverScheduler::add(folly::Func func) {
+  addWithAffinity(std::move(func), -1);
+}
+
+void WorkStealingDriverScheduler::addWithAffinity(
+    folly::Func func,
+    int32_t worker) {
+  VELOX_CHECK(!stopped_, "Adding a task to a stopped DriverScheduler");
+  if (worker < 0 || worker >= workers_.size()) {
+    worker = currentWorker();
+    if (worker < 0 || worker >= workers_.size()) {
+      worker = nextWorker_++ % workers_.size();
+    }
+  }
+  auto& target = *workers_[worker];
+  bool targetIdle;
+  {
+    std::lock_guard<std::mutex> l(target.mutex);
+    target.queue.push_back(std::move(func));
+    targetIdle = target.idle;
+    if (targetIdle) {
+      target.wakeup.notify_one();
+    }
+  }
+  if (!targetIdle && currentWorker() != worker) {
+    // The target worker is busy running another task. An idle worker, if
+    // any, steals the task instead of waiting for the target.
+    wakeUpThief(worker);
+  }
+}
+
+void WorkStealingDriverScheduler::wakeUpThief(int32_t worker) {
+  const auto numWorkers = workers_.size();
+  for (auto i = 1; i < numWorkers; ++i) {
+    auto& thief = *workers_[(worker + i) % numWorkers];
+    if (!thief.idle) {
+      continue;
+    }
+    std::lock_guard<std::mutex> l(thief.mutex);
+    if (thief.idle && !thief.stealRequested) {
+      thief.stealRequested = true;
+      thief.wakeup.notify_one();
+      return;
+    }
+  }
+}
+
+folly::Func WorkStealingDriverScheduler::takeTask(int32_t worker) {
+  {
+    auto& own = *workers_[worker];
+    std::lock_guard<std::mutex> l(own.mutex);
+    if (!own.queue.empty()) {
+      auto func = std::move(own.queue.front());
+      own.queue.pop_front();
+      ++numLocalRuns_;
+      return func;
+    }
+  }
+  const auto numWorkers = workers_.size();
+  for (auto i = 1; i < numWorkers; ++i) {
+    auto& victim = *workers_[(worker + i) % numWorkers];
+    std::lock_guard<std::mutex> l(victim.mutex);
+    if (!victim.queue.empty()) {
+      // Takes the oldest task, which has waited the longest for its worker.
+      auto func = std::move(victim.queue.front());
+      victim.queue.pop_front();
+      ++numSteals_;
+      return func;
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingDriverScheduler::runWorker(int32_t worker) {
+  setCurrentWorker(worker);
+  auto& self = *workers_[worker];
+  for (;;) {
+    if (auto func = takeTask(worker)) {
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverScheduler task threw unhandled exception: "
+                   << e.what();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> l(self.mutex);
+    if (!self.queue.empty()) {
+      continue;
+    }
+    if (stopped_) {
+      return;
+    }
+    self.idle = true;
+    self.wakeup.wait(l, [&]() {
+      return !self.queue.empty() || self.stealRequested || stopped_;
+    });
+    self.idle = false;
+    self.stealRequested = false;
+  }
+}
+
+WorkStealingDriverScheduler::Stats WorkStealingDriverScheduler::stats() const {
+  Stats stats;
+  stats.numLocalRuns = numLocalRuns_;
+  stats.numSteals = numSteals_;
+  return stats;
+}
+
+MultiLevelDriverScheduler::MultiLevelDriverScheduler(
+    int32_t numWorkers,
+    std::vector<uint64_t> levelThresholdsMs,
+    std::string threadNamePrefix)
+    : levelThresholdsNanos_([&]() {
+        std::vector<uint64_t> nanos;
+        for (const auto ms : levelThresholdsMs) {
+          nanos.push_back(ms * 1'000'000);
+        }
+        return nanos;
+      }()),
+      queues_(levelThresholdsMs.size() + 1),
+      levelCpuNanos_(queues_.size(), 0),
+      levelNumRuns_(queues_.size(), 0) {
+  VELOX_CHECK_GT(numWorkers, 0);
+  VELOX_CHECK(
+      std::is_sorted(
+          levelThresholdsNanos_.begin(), levelThresholdsNanos_.end()),
+      "Level thresholds must be ascending");
+  // Keeps the scaled CPU times from overflowing.
+  VELOX_CHECK_LT(queues_.size(), 16);
+  threads_.reserve(numWorkers);
+  for (auto i = 0; i < numWorkers; ++i) {
+    threads_.emplace_back([this, i, threadNamePrefix]() {
+      folly::setThreadName(fmt::format("{}{}", threadNamePrefix, i));
+      runWorker(i);
+    });
+  }
+}
+
+MultiLevelDriverScheduler::~MultiLevelDriverScheduler() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopped_ = true;
+  }
+  wakeup_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+int32_t MultiLevelDriverScheduler::levelOf(uint64_t taskCpuNanos) const {
+  return std::upper_bound(
+             levelThresholdsNanos_.begin(),
+             levelThresholdsNanos_.end(),
+             taskCpuNanos) -
+      levelThresholdsNanos_.begin();
+}
+
+void MultiLevelDriverScheduler::add(folly::Func func) {
+  std::lock_guard<std::mutex> l(mutex_);
+  addLocked(std::move(func), 0);
+}
+
+void MultiLevelDriverScheduler::addDriver(
+    folly::Func func,
+    const DriverInfo& info) {
+  const auto level = levelOf(info.taskCpuNanos);
+  std::lock_guard<std::mutex> l(mutex_);
+  addLocked(std::move(func), level);
+}
+
+void MultiLevelDriverScheduler::addLocked(folly::Func func, int32_t level) {
+  VELOX_CHECK(!stopped_, "Adding a task to a stopped DriverScheduler");
+  if (queues_[level].empty()) {
+    // A level which has been empty for a while has used little CPU. Catches
+    // its CPU time up with the busy levels so that it doesn't monopolize the
+    // workers until it has made up for the idle time.
+    const auto busyLevel = pickLevelLocked();
+    if (busyLevel >= 0) {
+      levelCpuNanos_[level] = std::max(
+          levelCpuNanos_[level], scaledCpuNanosLocked(busyLevel) >> level);
+    }
+  }
+  queues_[level].push_back(std::move(func));
+  wakeup_.notify_one();
+}
+
+int32_t MultiLevelDriverScheduler::pickLevelLocked() const {
+  int32_t picked = -1;
+  for (auto level = 0; level < queues_.size(); ++level) {
+    if (queues_[level].empty()) {
+      continue;
+    }
+    if (picked < 0 ||
+        scaledCpuNanosLocked(level) < scaledCpuNanosLocked(picked)) {
+      picked = level;
+    }
+  }
+  return picked;
+}
+
+void MultiLevelDriverScheduler::runWorker(int32_t worker) {
+  setCurrentWorker(worker);
+  std::unique_lock<std::mutex> l(mutex_);
+  for (;;) {
+    const auto level = pickLevelLocked();
+    if (level < 0) {
+      if (stopped_) {
+        return;
+      }
+      wakeup_.wait(l);
+      continue;
+    }
+    auto func = std::move(queues_[level].front());
+    queues_[level].pop_front();
+    l.unlock();
+    const auto startCpuNanos = process::threadCpuNanos();
+    try {
+      func();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "DriverScheduler task threw unhandled exception: "
+                 << e.what();
+    }
+    // Destroys the function and what it captures outside of the lock.
+    func = nullptr;
+    const auto cpuNanos = process::threadCpuNanos() - startCpuNanos;
+    l.lock();
+    levelCpuNanos_[level] += cpuNanos;
+    ++levelNumRuns_[level];
+  }
+}
+
+MultiLevelDriverScheduler::Stats MultiLevelDriverScheduler::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.levelCpuNanos = levelCpuNanos_;
+  stats.levelNumRuns = levelNumRuns_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
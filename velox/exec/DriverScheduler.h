@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+/// An executor for Drivers which is told about the Driver of each added
+/// function. If the executor of a QueryCtx is a DriverScheduler, Drivers are
+/// enqueued with addDriver() and the scheduler decides where and in which
+/// order they run, e.g. on the worker thread of their last run or by the CPU
+/// time of their Task.
+class DriverScheduler : public folly::Executor {
+ public:
+  /// Describes the Driver run by a function passed to addDriver().
+  struct DriverInfo {
+    /// The worker the Driver last ran on, -1 if none.
+    int32_t lastWorker{-1};
+    /// The CPU time used so far by all the Drivers of the Driver's Task.
+    uint64_t taskCpuNanos{0};
+  };
+
+  /// Adds 'func' which runs the Driver described by 'info'.
+  virtual void addDriver(folly::Func func, const DriverInfo& info) = 0;
+
+  /// Returns the index of the worker of the calling thread, or -1 if the
+  /// calling thread is not a DriverScheduler worker.
+  static int32_t currentWorker();
+
+ protected:
+  /// Sets the worker index of the calling thread. Called by the worker threads
+  /// of subclasses on start.
+  static void setCurrentWorker(int32_t worker);
+};
+
+/// A DriverScheduler with a run queue per worker thread. A worker runs the
+/// tasks of its own queue in FIFO order and steals from the queues of the
+/// other workers when its own queue is empty. A Driver is added to the queue
+/// of the worker it last ran on, so that its hash tables and vectors are
+/// likely still in that core's cache. Pinning the workers to cores is left to
+/// the embedding system.
+class WorkStealingDriverScheduler : public DriverScheduler {
+ public:
+  struct Stats {
+    /// The number of tasks run by the worker they were added to.
+    uint64_t numLocalRuns{0};
+    /// The number of tasks run by a worker which stole them from another.
+    uint64_t numSteals{0};
+  };
+
+  explicit WorkStealingDriverScheduler(
+      int32_t numWorkers,
+      std::string threadNamePrefix = "DriverScheduler");
+
+  /// Runs the remaining tasks and joins the worker threads.
+  ~WorkStealingDriverScheduler() override;
+
+  /// Adds 'func' to the queue of the calling worker if called from a worker
+  /// thread, otherwise to the queues of the workers in a round robin manner.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' preferably to worker 'worker'. The preference is soft, an
+  /// idle worker may run 'func' first. 'worker' is -1 for no preference.
+  void addWithAffinity(folly::Func func, int32_t worker);
+
+  void addDriver(folly::Func func, const DriverInfo& info) override {
+    addWithAffinity(std::move(func), info.lastWorker);
+  }
+
+  int32_t numWorkers() const {
+    return workers_.size();
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<folly::Func> queue;
+    // True if the worker is waiting for 'wakeup'.
+    std::atomic_bool idle{false};
+    // True if the worker is woken up to steal.
+    bool stealRequested{false};
+    std::thread thread;
+  };
+
+  void runWorker(int32_t worker);
+
+  // Returns the next task of 'worker', stealing from the other workers if
+  // its own queue is empty. Returns an empty function if there is none.
+  folly::Func takeTask(int32_t worker);
+
+  // Wakes up an idle worker other than 'worker' to steal the task added to
+  // the queue of 'worker'.
+  void wakeUpThief(int32_t worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic_bool stopped_{false};
+  std::atomic<uint32_t> nextWorker_{0};
+
+  std::atomic<uint64_t> numLocalRuns_{0};
+  std::atomic<uint64_t> numSteals_{0};
+};
+
+/// A DriverScheduler which shares the CPU between Tasks with multi-level
+/// feedback queues. A Driver is queued at the level of the CPU time its Task
+/// has used so far, so a Task is demoted to higher levels as it keeps
+/// running. Each level is entitled to twice the CPU time of the next one and
+/// the workers take Drivers from the non-empty level that is furthest below
+/// its share. Short, interactive Tasks thus stay at level 0 and run ahead of
+/// long running ones without starving them. The worker of the last run of a
+/// Driver is not taken into account.
+class MultiLevelDriverScheduler : public DriverScheduler {
+ public:
+  struct Stats {
+    /// The CPU time of the runs from each level.
+    std::vector<uint64_t> levelCpuNanos;
+    /// The number of runs from each level.
+    std::vector<uint64_t> levelNumRuns;
+  };
+
+  /// 'levelThresholdsMs' are the Task CPU times at which a Task enters levels
+  /// 1, 2 and so on. They must be ascending.
+  explicit MultiLevelDriverScheduler(
+      int32_t numWorkers,
+      std::vector<uint64_t> levelThresholdsMs =
+          {1'000, 10'000, 60'000, 300'000},
+      std::string threadNamePrefix = "DriverScheduler");
+
+  /// Runs the remaining tasks and joins the worker threads.
+  ~MultiLevelDriverScheduler() override;
+
+  /// Adds 'func' at level 0.
+  void add(folly::Func func) override;
+
+  void addDriver(folly::Func func, const DriverInfo& info) override;
+
+  /// Returns the level of a Driver whose Task has used 'taskCpuNanos'.
+  int32_t levelOf(uint64_t taskCpuNanos) const;
+
+  int32_t numLevels() const {
+    return queues_.size();
+  }
+
+  Stats stats() const;
+
+ private:
+  void addLocked(folly::Func func, int32_t level);
+
+  // Returns the CPU time of 'level' scaled by its share. The level with the
+  // lowest scaled time has used the least of its share.
+  uint64_t scaledCpuNanosLocked(int32_t level) const {
+    return levelCpuNanos_[level] << level;
+  }
+
+  // Returns the level to take the next task from, -1 if all are empty.
+  int32_t pickLevelLocked() const;
+
+  void runWorker(int32_t worker);
+
+  const std::vector<uint64_t> levelThresholdsNanos_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::vector<std::deque<folly::Func>> queues_;
+  std::vector<uint64_t> levelCpuNanos_;
+  std::vector<uint64_t> levelNumRuns_;
+  bool stopped_{false};
+  std::vector<std::thread> threads_;
+};
+
+} // namespace facebook::velox::exec
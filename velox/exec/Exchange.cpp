@@ -115,22 +115,8 @@ RowVectorPtr Exchange::getOutput() {
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
   if (getSerde()->supportsAppendInDeserialize()) {
-    for (const auto& page : currentPages_) {
-      rawInputBytes += page->size();
-
-      auto inputStream = page->prepareStreamForDeserialize();
-
-      while (!inputStream->atEnd()) {
-        getSerde()->deserialize(
-            inputStream.get(),
-            pool(),
-            outputType_,
-            &result_,
-            resultOffset,
-            &options_);
-        resultOffset = result_->size();
-      }
-    }
+    recycleResult();
+    rawInputBytes = deserializePages();
   } else {
     VELOX_CHECK(
         getSerde()->kind() == VectorSerde::Kind::kCompactRow ||
@@ -158,8 +144,8 @@ RowVectorPtr Exchange::getOutput() {
     // We expect the row-wise deserialization to consume all the input into one
     // output vector.
     VELOX_CHECK(inputStream->atEnd());
+    currentPages_.clear();
   }
-  currentPages_.clear();
 
   {
     auto lockedStats = stats_.wlock();
@@ -171,9 +157,68 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+void Exchange::recycleResult() {
+  if (result_ == nullptr || result_.use_count() == 1) {
+    return;
+  }
+  auto* vectorPool = operatorCtx_->execCtx()->vectorPool();
+  if (vectorPool == nullptr) {
+    return;
+  }
+  // 'result_' goes back to the pool once the consumer drops it, so that a
+  // later batch can be deserialized into it.
+  vectorPool->releaseWhenUnreferenced(std::move(result_));
+  result_ =
+      std::static_pointer_cast<RowVector>(vectorPool->get(outputType_, 0));
+}
+
+uint64_t Exchange::deserializePages() {
+  uint64_t rawInputBytes{0};
+  vector_size_t resultOffset = 0;
+  // The serialized bytes in 'result_'. Same measure as the page bytes which
+  // limit the pages returned by ExchangeClient::next().
+  uint64_t resultBytes = 0;
+  // A page can hold more than one serialized batch. Stops between batches
+  // once the result is large enough and continues from there on the next
+  // call. This keeps a large page from being materialized into one vector.
+  while (currentPageIdx_ < currentPages_.size() &&
+         resultBytes < preferredOutputBatchBytes_) {
+    if (inputStream_ == nullptr) {
+      const auto& page = currentPages_[currentPageIdx_];
+      rawInputBytes += page->size();
+      inputStream_ = page->prepareStreamForDeserialize();
+    }
+    while (!inputStream_->atEnd() &&
+           resultBytes < preferredOutputBatchBytes_) {
+      const auto position = inputStream_->tellp();
+      getSerde()->deserialize(
+          inputStream_.get(),
+          pool(),
+          outputType_,
+          &result_,
+          resultOffset,
+          &options_);
+      resultOffset = result_->size();
+      resultBytes += inputStream_->tellp() - position;
+    }
+    if (!inputStream_->atEnd()) {
+      break;
+    }
+    inputStream_.reset();
+    ++currentPageIdx_;
+  }
+  if (currentPageIdx_ == currentPages_.size()) {
+    currentPages_.clear();
+    currentPageIdx_ = 0;
+  }
+  return rawInputBytes;
+}
+
 void Exchange::close() {
   SourceOperator::close();
+  inputStream_.reset();
   currentPages_.clear();
+  currentPageIdx_ = 0;
   result_ = nullptr;
   if (exchangeClient_) {
     recordExchangeClientStats();
@@ -93,6 +93,16 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  // Deserializes 'currentPages_' into 'result_' until it reaches
+  // 'preferredOutputBatchBytes_'. Continues from 'currentPageIdx_' and
+  // 'inputStream_' where the previous call stopped. Returns the bytes of the
+  // pages started by this call.
+  uint64_t deserializePages();
+
+  // Replaces 'result_' with a recycled vector if the consumer still holds
+  // it. The serde reuses 'result_' only if it is singly referenced.
+  void recycleResult();
+
   const uint64_t preferredOutputBatchBytes_;
 
   const VectorSerde::Kind serdeKind_;
@@ -113,6 +123,11 @@ class Exchange : public SourceOperator {
   RowVectorPtr result_;
 
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
+  // The first page in 'currentPages_' which is not fully deserialized.
+  size_t currentPageIdx_{0};
+  // The input stream of 'currentPages_[currentPageIdx_]' if its
+  // deserialization stopped in the middle because the output batch was full.
+  std::unique_ptr<ByteInputStream> inputStream_;
   bool atEnd_{false};
   std::default_random_engine rng_{std::random_device{}()};
   serializer::presto::PrestoVectorSerde::PrestoOptions options_;
@@ -50,6 +50,8 @@ void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
       toClose = std::move(source);
     } else {
       sources_.push_back(source);
+      requestWindowBytes_[source.get()] =
+          std::min<int64_t>(kInitialRequestWindowBytes, maxQueuedBytes_);
       queue_->addSourceLocked();
       emptySources_.push(source);
       requestSpecs = pickSourcesToRequestLocked();
@@ -114,6 +116,10 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  if (requestRttNanos_.count > 0) {
+    stats["requestRttNanos"] = requestRttNanos_;
+    stats["requestWindowBytes"] = requestWindowBytesMetric_;
+  }
 
   return stats;
 }
@@ -147,6 +153,23 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
   return pages;
 }
 
+void ExchangeClient::setMaxQueuedBytes(int64_t maxQueuedBytes) {
+  VELOX_CHECK_GT(maxQueuedBytes, 0);
+  std::vector<RequestSpec> requestSpecs;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    const bool grows = maxQueuedBytes > maxQueuedBytes_;
+    maxQueuedBytes_ = maxQueuedBytes;
+    if (!grows) {
+      return;
+    }
+    requestSpecs = pickSourcesToRequestLocked();
+  }
+
+  // Outside of lock
+  request(std::move(requestSpecs));
+}
+
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
@@ -161,8 +184,9 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
         .via(executor_)
         .thenValue([self,
                     spec = std::move(spec),
-                    sendTimeMs = getCurrentTimeMs()](auto&& response) {
-          const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+                    sendTimeUs = getCurrentTimeMicro()](auto&& response) {
+          const auto requestTimeUs = getCurrentTimeMicro() - sendTimeUs;
+          const auto requestTimeMs = requestTimeUs / 1'000;
           if (spec.maxBytes == 0) {
             RECORD_HISTOGRAM_METRIC_VALUE(
                 kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -184,6 +208,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             if (self->closed_) {
               return;
             }
+            if (spec.maxBytes > 0) {
+              self->updateRequestWindowLocked(
+                  currentSource.get(), spec.maxBytes, response, requestTimeUs);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
@@ -218,24 +246,53 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   }
 }
 
+void ExchangeClient::updateRequestWindowLocked(
+    const ExchangeSource* source,
+    int64_t requestBytes,
+    const ExchangeSource::Response& response,
+    uint64_t requestTimeUs) {
+  requestRttNanos_.addValue(requestTimeUs * 1'000);
+  auto it = requestWindowBytes_.find(source);
+  if (it == requestWindowBytes_.end()) {
+    return;
+  }
+  auto& window = it->second;
+  const uint64_t targetUs =
+      std::chrono::duration_cast<std::chrono::microseconds>(kTargetRequestTime)
+          .count();
+  if (requestTimeUs > targetUs) {
+    window = std::max(window / 2, kMinRequestWindowBytes);
+  } else if (
+      !response.atEnd && !response.remainingBytes.empty() &&
+      response.bytes >= requestBytes) {
+    // The source keeps up and has more data ready than was asked for.
+    window = std::max(std::min(window * 2, maxQueuedBytes_), window);
+  }
+  requestWindowBytesMetric_.addValue(window);
+}
+
 std::vector<ExchangeClient::RequestSpec>
 ExchangeClient::pickSourcesToRequestLocked() {
   if (closed_) {
     return {};
   }
   std::vector<RequestSpec> requestSpecs;
-  while (!emptySources_.empty()) {
-    auto& source = emptySources_.front();
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), 0});
-    emptySources_.pop();
-  }
+  // Sources with data ready go first so their transfers start before the
+  // data size probes of the others.
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
+    const auto windowIt = requestWindowBytes_.find(source.get());
+    const int64_t window = windowIt == requestWindowBytes_.end()
+        ? maxQueuedBytes_
+        : windowIt->second;
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > window) {
+        // Leaves the rest of the space to the other sources.
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -251,6 +308,12 @@ ExchangeClient::pickSourcesToRequestLocked() {
     producingSources_.pop();
     totalPendingBytes_ += requestBytes;
   }
+  while (!emptySources_.empty()) {
+    auto& source = emptySources_.front();
+    VELOX_CHECK(source->shouldRequestLocked());
+    requestSpecs.push_back({std::move(source), 0});
+    emptySources_.pop();
+  }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
     // We have full capacity but still cannot initiate one single data transfer.
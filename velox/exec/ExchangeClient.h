@@ -27,6 +27,13 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr std::chrono::seconds kRequestDataSizesMaxWait{10};
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
+  /// Bounds and initial value of the number of bytes requested from one source
+  /// at a time. The window of each source doubles while its data requests
+  /// complete within kTargetRequestTime and leave data behind, and halves when
+  /// they take longer. The first page of a source is always requested whole.
+  static constexpr int64_t kMinRequestWindowBytes = 64 << 10; // 64 KB.
+  static constexpr int64_t kInitialRequestWindowBytes = 1 << 20; // 1 MB.
+  static constexpr std::chrono::milliseconds kTargetRequestTime{50};
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
 
   ExchangeClient(
@@ -82,6 +89,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     return queue_;
   }
 
+  /// Changes the maximum number of bytes to queue and to request from the
+  /// sources. Requests more data if the limit grows.
+  void setMaxQueuedBytes(int64_t maxQueuedBytes);
+
   /// Returns up to 'maxBytes' pages of data, but no less than one.
   ///
   /// If no data is available returns empty list and sets 'atEnd' to true if no
@@ -115,10 +126,19 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   void request(std::vector<RequestSpec>&& requestSpecs);
 
+  // Records the round trip time of a data request of 'requestBytes' to
+  // 'source' and adapts the request window of 'source' to it.
+  void updateRequestWindowLocked(
+      const ExchangeSource* source,
+      int64_t requestBytes,
+      const ExchangeSource::Response& response,
+      uint64_t requestTimeUs);
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
-  const int64_t maxQueuedBytes_;
+  // Guarded by the mutex of 'queue_'.
+  int64_t maxQueuedBytes_;
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
@@ -135,6 +155,13 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  // The maximum number of bytes to request from each source at a time.
+  folly::F14FastMap<const ExchangeSource*, int64_t> requestWindowBytes_;
+  // The round trip time of the data requests.
+  RuntimeMetric requestRttNanos_{RuntimeCounter::Unit::kNanos};
+  // The request window of a source after each data request.
+  RuntimeMetric requestWindowBytesMetric_{RuntimeCounter::Unit::kBytes};
 };
 
 } // namespace facebook::velox::exec
@@ -97,6 +97,22 @@ void FilterProject::initialize() {
       }
     }
   }
+
+  concurrentLoadExecutor_ = operatorCtx_->task()->queryCtx()->executor();
+  if (operatorCtx_->driverCtx()->queryConfig().exprConcurrentLazyLoad() &&
+      concurrentLoadExecutor_ != nullptr && !resultProjections_.empty()) {
+    const auto& inputType = project_->sources()[0]->outputType();
+    std::unordered_set<column_index_t> fieldIndices;
+    for (auto i = hasFilter_ ? 1 : 0; i < numExprs_; ++i) {
+      for (auto* field : exprs_->expr(i)->distinctFields()) {
+        fieldIndices.insert(inputType->getChildIdx(field->name()));
+      }
+    }
+    if (fieldIndices.size() > 1) {
+      concurrentLoadFieldIndices_.assign(
+          fieldIndices.begin(), fieldIndices.end());
+    }
+  }
   filter_.reset();
   project_.reset();
 }
@@ -160,9 +176,6 @@ RowVectorPtr FilterProject::getOutput() {
   // evaluate projections (if present)
   std::vector<VectorPtr> results;
   if (!isIdentityProjection_) {
-    if (!allRowsSelected) {
-      rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
-    }
     results = project(*rows, evalCtx);
   }
 
@@ -175,17 +188,44 @@ RowVectorPtr FilterProject::getOutput() {
 std::vector<VectorPtr> FilterProject::project(
     const SelectivityVector& rows,
     EvalCtx& evalCtx) {
+  if (!concurrentLoadFieldIndices_.empty()) {
+    std::vector<VectorPtr> columns;
+    columns.reserve(concurrentLoadFieldIndices_.size());
+    for (auto fieldIdx : concurrentLoadFieldIndices_) {
+      columns.push_back(input_->childAt(fieldIdx));
+    }
+    loadColumnsConcurrently(columns, rows, concurrentLoadExecutor_);
+  }
   std::vector<VectorPtr> results;
   exprs_->eval(
       hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results);
   return results;
 }
 
-vector_size_t FilterProject::filter(
-    EvalCtx& evalCtx,
-    const SelectivityVector& allRows) {
+vector_size_t FilterProject::filter(EvalCtx& evalCtx, SelectivityVector& rows) {
+  const auto size = rows.size();
+  LocalSelectivityVector localPassed(*operatorCtx_->execCtx(), size);
+  auto* passed = localPassed.get();
+  if (exprs_->evalFilter(0, rows, evalCtx, *passed)) {
+    // The filter produced the passing rows directly.
+    const auto numOut = passed->countSelected();
+    if (numOut > 0 && numOut < size) {
+      auto* rawSelected = filterEvalCtx_.getRawSelectedIndices(numOut, pool());
+      vector_size_t numSelected = 0;
+      passed->applyToSelected(
+          [&](vector_size_t row) { rawSelected[numSelected++] = row; });
+      rows = *passed;
+    }
+    return numOut;
+  }
+
   std::vector<VectorPtr> results;
-  exprs_->eval(0, 1, true, allRows, evalCtx, results);
-  return processFilterResults(results[0], allRows, filterEvalCtx_, pool());
+  exprs_->eval(0, 1, true, rows, evalCtx, results);
+  const auto numOut =
+      processFilterResults(results[0], rows, filterEvalCtx_, pool());
+  if (numOut > 0 && numOut < size) {
+    rows.setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
+  }
+  return numOut;
 }
 } // namespace facebook::velox::exec
@@ -79,12 +79,13 @@ class FilterProject : public Operator {
   // should return nullptr.
   bool allInputProcessed();
 
-  // Evaluate filter on all rows. Return number of rows that passed the filter.
-  // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
-  // of the passing rows if only some rows pass the filter. If all or no rows
-  // passed the filter filterEvalCtx_.selectedBits and selectedIndices are not
-  // updated.
-  vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
+  // Evaluate filter on all 'rows'. Return number of rows that passed the
+  // filter. If only some rows pass the filter, sets 'rows' to the passing rows
+  // and populates filterEvalCtx_.selectedIndices with their indices. If all or
+  // no rows passed the filter 'rows' and filterEvalCtx_.selectedIndices are
+  // not updated. An AND filter produces the passing rows directly without a
+  // boolean result vector, see ExprSet::evalFilter().
+  vector_size_t filter(EvalCtx& evalCtx, SelectivityVector& rows);
 
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
@@ -117,5 +118,13 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Input columns referenced by the projections which are loaded
+  // concurrently on 'concurrentLoadExecutor_' for the rows passing the filter
+  // before evaluating the projections. Empty unless
+  // QueryConfig::kExprConcurrentLazyLoad is enabled and there are at least two
+  // such columns.
+  std::vector<column_index_t> concurrentLoadFieldIndices_;
+  folly::Executor* concurrentLoadExecutor_{nullptr};
 };
 } // namespace facebook::velox::exec
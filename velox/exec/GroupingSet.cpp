@@ -53,7 +53,8 @@ GroupingSet::GroupingSet(
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
     OperatorCtx* operatorCtx,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    uint64_t approxMaxGroups)
     : preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
@@ -66,11 +67,14 @@ GroupingSet::GroupingSet(
       globalGroupingSets_(globalGroupingSets),
       groupIdChannel_(groupIdChannel),
       spillConfig_(spillConfig),
+      approxMaxGroups_(approxMaxGroups),
       nonReclaimableSection_(nonReclaimableSection),
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
       pool_(*operatorCtx->pool()),
+      decodedVectorCache_(
+          operatorCtx->driverCtx()->decodedVectorCache.get()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
   VELOX_CHECK(pool_.trackUsage());
@@ -108,6 +112,18 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  if (approxMaxGroups_ > 0) {
+    VELOX_CHECK(!isGlobal_);
+    VELOX_CHECK(!isPartial_);
+    VELOX_CHECK(preGroupedKeyChannels_.empty());
+    VELOX_CHECK_NULL(sortedAggregations_);
+    VELOX_CHECK_NULL(spillConfig_);
+    for (const auto& distinct : distinctAggregations_) {
+      VELOX_CHECK_NULL(distinct);
+    }
+    approxDroppedGroupsSummary_.setCapacity(kApproxDroppedGroupsCapacity);
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -197,8 +213,14 @@ void GroupingSet::noMoreInput() {
   // Spill the remaining in-memory state to disk if spilling has been triggered
   // on this grouping set. This is to simplify query OOM prevention when
   // producing output as we don't support to spill during that stage as for now.
+  // If only some partitions have spilled, only the rows of these partitions
+  // are spilled and the other partitions are produced from memory.
   if (hasSpilled()) {
-    spill();
+    if (spiller_->isAllSpilled()) {
+      spill();
+    } else if (table_->numDistinct() > 0) {
+      spillPartitionRows(spiller_->spilledPartitionSet());
+    }
   }
 
   ensureOutputFits();
@@ -236,6 +258,9 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (approxMaxGroups_ > 0) {
+    dropApproxGroups();
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
@@ -276,7 +301,19 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      if (table_->hashMode() == BaseHashTable::HashMode::kArray) {
+        // The value ids of the keys are the indices of the groups in the
+        // table.
+        function->addRawInputWithGroupIds(
+            groups,
+            lookup_->hashes.data(),
+            table_->capacity(),
+            rows,
+            tempVectors_,
+            canPushdown);
+      } else {
+        function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      }
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
@@ -289,6 +326,65 @@ void GroupingSet::addInputForActiveRows(
     }
     sortedAggregations_->addInput(groups, input);
   }
+
+  if (!approxDroppedGroups_.empty()) {
+    // The dropped groups have initialized accumulators and no input.
+    table_->erase(folly::Range<char**>(
+        approxDroppedGroups_.data(), approxDroppedGroups_.size()));
+    approxDroppedGroups_.clear();
+  }
+}
+
+void GroupingSet::dropApproxGroups() {
+  const auto& newGroups = lookup_->newGroups;
+  const uint64_t numGroups = table_->numDistinct();
+  if (numGroups <= approxMaxGroups_) {
+    return;
+  }
+  // The groups before this input are within the limit, so the excess groups
+  // are all new. The last new groups are dropped.
+  const auto numDropped = numGroups - approxMaxGroups_;
+  VELOX_CHECK_LE(numDropped, newGroups.size());
+  auto* groups = lookup_->hits.data();
+  approxDroppedGroupIndices_.clear();
+  approxDroppedGroups_.clear();
+  approxDroppedGroupRows_.assign(numDropped, 0);
+  for (auto i = newGroups.size() - numDropped; i < newGroups.size(); ++i) {
+    auto* group = groups[newGroups[i]];
+    approxDroppedGroupIndices_[group] = approxDroppedGroups_.size();
+    approxDroppedGroups_.push_back(group);
+  }
+
+  for (auto row : lookup_->rows) {
+    auto it = approxDroppedGroupIndices_.find(groups[row]);
+    if (it != approxDroppedGroupIndices_.end()) {
+      ++approxDroppedGroupRows_[it->second];
+      activeRows_.setValid(row, false);
+    }
+  }
+  activeRows_.updateBounds();
+
+  // Summarizes the dropped rows by the hashes of the grouping keys, which do
+  // not depend on the hash mode of 'table_'.
+  approxDroppedGroupHashes_.resize(numDropped);
+  const folly::Range<char**> droppedGroups(
+      approxDroppedGroups_.data(), approxDroppedGroups_.size());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    table_->rows()->hash(
+        i, droppedGroups, i > 0, approxDroppedGroupHashes_.data());
+  }
+  for (auto i = 0; i < approxDroppedGroups_.size(); ++i) {
+    approxDroppedGroupsSummary_.insert(
+        approxDroppedGroupHashes_[i], approxDroppedGroupRows_[i]);
+    numApproxDroppedRows_ += approxDroppedGroupRows_[i];
+  }
+}
+
+int64_t GroupingSet::maxApproxDroppedGroupRows() const {
+  if (approxDroppedGroupsSummary_.size() == 0) {
+    return 0;
+  }
+  return approxDroppedGroupsSummary_.topK(1)[0].second;
 }
 
 void GroupingSet::addRemainingInput() {
@@ -398,6 +494,7 @@ void GroupingSet::createHashTable() {
   }
 
   lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  lookup_->decodedVectorCache = decodedVectorCache_;
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
   }
@@ -730,7 +827,7 @@ bool GroupingSet::getOutput(
   }
 
   if (hasSpilled()) {
-    return getOutputWithSpill(maxOutputRows, maxOutputBytes, result);
+    return getOutputWithSpill(maxOutputRows, maxOutputBytes, iterator, result);
   }
   VELOX_CHECK(!isDistinct());
 
@@ -789,6 +886,87 @@ void GroupingSet::extractGroups(
   }
 }
 
+void GroupingSet::extractPartitions(
+    const RowTypePtr& inputType,
+    int32_t numPartitions,
+    int32_t maxBatchRows,
+    std::vector<std::vector<RowVectorPtr>>& partitions) {
+  VELOX_CHECK(!isRawInput_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!isDistinct());
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_NULL(sortedAggregations_);
+  VELOX_CHECK_GT(numPartitions, 0);
+  VELOX_CHECK_GT(maxBatchRows, 0);
+  partitions.resize(numPartitions);
+  if (table_ == nullptr) {
+    return;
+  }
+
+  RowContainer& rows = *table_->rows();
+  const auto numKeys = rows.keyTypes().size();
+  std::vector<char*> groups(maxBatchRows);
+  std::vector<uint64_t> hashes(maxBatchRows);
+  std::vector<std::vector<char*>> partitionGroups(numPartitions);
+  RowContainerIterator iterator;
+  for (;;) {
+    const auto numGroups =
+        rows.listRows(&iterator, maxBatchRows, groups.data());
+    if (numGroups == 0) {
+      break;
+    }
+    folly::Range<char**> range(groups.data(), numGroups);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows.hash(i, range, i > 0, hashes.data());
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      const auto partition = hashes[i] % numPartitions;
+      auto& partitionRows = partitionGroups[partition];
+      partitionRows.push_back(groups[i]);
+      if (partitionRows.size() == maxBatchRows) {
+        partitions[partition].push_back(
+            extractIntermediateInput(
+                inputType,
+                folly::Range<char**>(
+                    partitionRows.data(), partitionRows.size())));
+        partitionRows.clear();
+      }
+    }
+  }
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    auto& partitionRows = partitionGroups[partition];
+    if (!partitionRows.empty()) {
+      partitions[partition].push_back(
+          extractIntermediateInput(
+              inputType,
+              folly::Range<char**>(
+                  partitionRows.data(), partitionRows.size())));
+    }
+  }
+  table_->clear(/*freeTable=*/false);
+}
+
+RowVectorPtr GroupingSet::extractIntermediateInput(
+    const RowTypePtr& inputType,
+    folly::Range<char**> groups) {
+  auto result = std::static_pointer_cast<RowVector>(
+      BaseVector::create(inputType, groups.size(), &pool_));
+  RowContainer& rows = *table_->rows();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    rows.extractColumn(
+        groups.data(), groups.size(), i, result->childAt(keyChannels_[i]));
+  }
+  for (auto& aggregate : aggregates_) {
+    for (auto channel : aggregate.inputs) {
+      if (channel != kConstantChannel) {
+        aggregate.function->extractAccumulators(
+            groups.data(), groups.size(), &result->childAt(channel));
+      }
+    }
+  }
+  return result;
+}
+
 void GroupingSet::resetTable(bool freeTable) {
   if (table_ != nullptr) {
     table_->clear(freeTable);
@@ -971,23 +1149,7 @@ void GroupingSet::spill() {
 
   auto* rows = table_->rows();
   if (!hasSpilled()) {
-    VELOX_DCHECK(pool_.trackUsage());
-    VELOX_CHECK(numDistinctSpillFilesPerPartition_.empty());
-    spiller_ = std::make_unique<Spiller>(
-        Spiller::Type::kAggregateInput,
-        rows,
-        makeSpillType(),
-        HashBitRange(
-            spillConfig_->startPartitionBit,
-            static_cast<uint8_t>(
-                spillConfig_->startPartitionBit +
-                spillConfig_->numPartitionBits)),
-        rows->keyTypes().size(),
-        std::vector<CompareFlags>(),
-        spillConfig_,
-        spillStats_);
-    VELOX_CHECK_EQ(
-        spiller_->state().maxPartitions(), 1 << spillConfig_->numPartitionBits);
+    createInputSpiller();
   }
   // Spilling may execute on multiple partitions in parallel, and
   // HashStringAllocator is not thread safe. If any aggregations
@@ -1014,6 +1176,97 @@ void GroupingSet::spill() {
   table_->clear(/*freeTable=*/true);
 }
 
+void GroupingSet::createInputSpiller() {
+  VELOX_CHECK(!hasSpilled());
+  VELOX_DCHECK(pool_.trackUsage());
+  VELOX_CHECK(numDistinctSpillFilesPerPartition_.empty());
+  auto* rows = table_->rows();
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kAggregateInput,
+      rows,
+      makeSpillType(),
+      HashBitRange(
+          spillConfig_->startPartitionBit,
+          static_cast<uint8_t>(
+              spillConfig_->startPartitionBit +
+              spillConfig_->numPartitionBits)),
+      rows->keyTypes().size(),
+      std::vector<CompareFlags>(),
+      spillConfig_,
+      spillStats_);
+  VELOX_CHECK_EQ(
+      spiller_->state().maxPartitions(), 1 << spillConfig_->numPartitionBits);
+}
+
+bool GroupingSet::canSpillPartitions() const {
+  if (isDistinct() || sortedAggregations_ != nullptr) {
+    return false;
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GroupingSet::spillPartitions(uint64_t targetBytes) {
+  if (table_ == nullptr || table_->numDistinct() == 0 || targetBytes == 0 ||
+      !canSpillPartitions()) {
+    return false;
+  }
+  if (hasSpilled() && spiller_->isAllSpilled()) {
+    return false;
+  }
+  if (!hasSpilled()) {
+    createInputSpiller();
+  }
+  const auto partitions =
+      Spiller::partitionsToSpill({spiller_.get()}, targetBytes);
+  if (partitions.empty()) {
+    return false;
+  }
+  spillPartitionRows(partitions);
+  return true;
+}
+
+void GroupingSet::spillPartitionRows(const SpillPartitionNumSet& partitions) {
+  auto* rows = table_->rows();
+  // See spill() for why the HashStringAllocator is frozen.
+  rows->stringAllocator().freezeAndExecute(
+      [&]() { spiller_->spill(partitions); });
+
+  // Finds the spilled rows by the same hash partitioning as the spiller.
+  constexpr int32_t kBatchSize = 4096;
+  const auto& bits = spiller_->hashBits();
+  const auto numPartitions = spiller_->state().maxPartitions();
+  const auto numKeys = rows->keyTypes().size();
+  std::vector<char*> batch(kBatchSize);
+  std::vector<uint64_t> hashes(kBatchSize);
+  std::vector<char*> spilledRows;
+  RowContainerIterator iterator;
+  while (const auto numRows = rows->listRows(
+             &iterator, kBatchSize, RowContainer::kUnlimited, batch.data())) {
+    const folly::Range<char**> rowSet(batch.data(), numRows);
+    if (bits.numPartitions() > 1) {
+      for (auto i = 0; i < numKeys; ++i) {
+        rows->hash(i, rowSet, i > 0, hashes.data());
+      }
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      const auto partition = bits.numPartitions() == 1
+          ? 0
+          : bits.partition(hashes[i], numPartitions);
+      if (partitions.count(partition) != 0) {
+        spilledRows.push_back(batch[i]);
+      }
+    }
+  }
+  // Erasing also frees the accumulators of the spilled groups. Their memory
+  // is reused by the groups added by the following input.
+  table_->erase(folly::Range<char**>(spilledRows.data(), spilledRows.size()));
+}
+
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   VELOX_CHECK(!hasSpilled());
 
@@ -1043,7 +1296,22 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
 bool GroupingSet::getOutputWithSpill(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
     const RowVectorPtr& result) {
+  if (outputSpillPartition_ == -1 && table_->rows()->numRows() > 0) {
+    // Produces the groups of the partitions which have not spilled first.
+    VELOX_CHECK(!spiller_->isAllSpilled());
+    // @lint-ignore CLANGTIDY
+    char* groups[maxOutputRows];
+    const auto numGroups = table_->rows()->listRows(
+        &iterator, maxOutputRows, maxOutputBytes, groups);
+    if (numGroups > 0) {
+      extractGroups(folly::Range<char**>(groups, numGroups), result);
+      return true;
+    }
+    table_->clear(/*freeTable=*/true);
+  }
+
   if (outputSpillPartition_ == -1) {
     VELOX_CHECK_NULL(mergeRows_);
     VELOX_CHECK(mergeArgs_.empty());
@@ -1094,7 +1362,10 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->readAheadExecutor());
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -1214,7 +1485,7 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+    if (!aggregate.sortingKeys.empty() || aggregate.distinct) {
       continue;
     }
     aggregate.function->initializeNewGroups(
@@ -1225,6 +1496,13 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     sortedAggregations_->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+    }
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1246,7 +1524,7 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1255,15 +1533,25 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
   mergeSelection_.setValid(input.currentIndex(), false);
 
+  // The accumulators of sorted and distinct aggregations follow the
+  // intermediate results of all the aggregates in the spilled rows. They are
+  // in the order of accumulators().
+  auto channel = aggregates_.size() + keyChannels_.size();
   if (sortedAggregations_ != nullptr) {
-    const auto& vector =
-        input.current().childAt(aggregates_.size() + keyChannels_.size());
+    const auto& vector = input.current().childAt(channel++);
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      const auto& vector = input.current().childAt(channel++);
+      aggregation->addSingleGroupSpillInput(row, vector, input.currentIndex());
+    }
+  }
 }
 
-void GroupingSet::abandonPartialAggregation() {
+void GroupingSet::abandonPartialAggregation(bool keepTable) {
   abandonedPartialAggregation_ = true;
   allSupportToIntermediate_ = true;
   for (auto& aggregate : aggregates_) {
@@ -1284,7 +1572,16 @@ void GroupingSet::abandonPartialAggregation() {
       false,
       &pool_);
   initializeAggregates(aggregates_, *intermediateRows_, true);
-  table_.reset();
+  if (keepTable) {
+    // The hot keys keep being aggregated in 'table_'. The aggregates are
+    // shared between 'table_' and 'intermediateRows_', so their offsets point
+    // to 'table_' and are moved to 'intermediateRows_' only for the duration
+    // of toIntermediate().
+    table_->clear(/*freeTable=*/true);
+    initializeAggregates(aggregates_, *table_->rows(), false);
+  } else {
+    table_.reset();
+  }
 }
 
 namespace {
@@ -1319,6 +1616,9 @@ void GroupingSet::toIntermediate(
 
   result->resize(numRows);
   if (!allSupportToIntermediate_) {
+    if (table_ != nullptr) {
+      initializeAggregates(aggregates_, *intermediateRows_, true);
+    }
     intermediateGroups_.resize(numRows);
     for (auto i = 0; i < numRows; ++i) {
       intermediateGroups_[i] = intermediateRows_->newRow();
@@ -1379,6 +1679,10 @@ void GroupingSet::toIntermediate(
     intermediateRows_->eraseRows(folly::Range<char**>(
         intermediateGroups_.data(), intermediateGroups_.size()));
   }
+  if (table_ != nullptr && !allSupportToIntermediate_) {
+    // Restores the offsets of the accumulators in the kept hot key table.
+    initializeAggregates(aggregates_, *table_->rows(), false);
+  }
 
   // It's unnecessary to call function->clear() to reset the internal states of
   // aggregation functions because toIntermediate() is already called at the end
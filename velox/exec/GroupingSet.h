@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -23,6 +25,7 @@
 #include "velox/exec/Spiller.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/VectorHasher.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -41,7 +44,8 @@ class GroupingSet {
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
       OperatorCtx* operatorCtx,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      uint64_t approxMaxGroups = 0);
 
   ~GroupingSet();
 
@@ -112,6 +116,15 @@ class GroupingSet {
   /// 'rowIterator'.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Spills only the largest spill partitions whose rows add up to
+  /// 'targetBytes' and erases their groups from the hash table. The groups of
+  /// the other partitions stay in memory and are produced without a merge at
+  /// output. The input of a spilled partition keeps aggregating in memory and
+  /// is spilled again at the end of input. Returns false without spilling if
+  /// this grouping set can't spill part of its partitions or if all the
+  /// partitions need to be spilled. The caller then spills all the rows.
+  bool spillPartitions(uint64_t targetBytes);
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<common::SpillStats> spilledStats() const {
     if (spiller_ == nullptr) {
@@ -128,19 +141,49 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns true if the groups beyond 'approxMaxGroups' given at construction
+  /// are dropped.
+  bool isApproximate() const {
+    return approxMaxGroups_ > 0;
+  }
+
+  /// Returns the number of input rows dropped in approximate mode.
+  int64_t numApproxDroppedRows() const {
+    return numApproxDroppedRows_;
+  }
+
+  /// Returns an upper bound of the number of input rows of any group dropped
+  /// in approximate mode.
+  int64_t maxApproxDroppedGroupRows() const;
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
   }
 
   // Frees hash tables and other state when giving up partial aggregation as
-  // non-productive. Must be called before toIntermediate() is used.
-  void abandonPartialAggregation();
+  // non-productive. Must be called before toIntermediate() is used. If
+  // 'keepTable' is true, the empty hash table is kept for aggregating the hot
+  // keys of the input after abandoning.
+  void abandonPartialAggregation(bool keepTable);
 
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
 
+  /// Moves the groups of a final aggregation into vectors of 'inputType', i.e.
+  /// the keys and the intermediate results of the aggregates at the channels
+  /// of the input. The groups are assigned to 'numPartitions' partitions by
+  /// the hash of their keys. Appends the vectors of partition i, each of at
+  /// most 'maxBatchRows' rows, to 'partitions[i]'. The vectors can be added to
+  /// another grouping set over the same input type with addInput(). Clears the
+  /// hash table.
+  void extractPartitions(
+      const RowTypePtr& inputType,
+      int32_t numPartitions,
+      int32_t maxBatchRows,
+      std::vector<std::vector<RowVectorPtr>>& partitions);
+
   /// Returns default global grouping sets output if there are no input rows.
   /// The default global grouping set output is a single row per global grouping
   /// set with the groupId key and the default aggregate value.
@@ -204,14 +247,22 @@ class GroupingSet {
   // otherwise.
   void extractGroups(folly::Range<char**> groups, const RowVectorPtr& result);
 
+  // Copies the keys and the accumulators of 'groups' to a new vector of
+  // 'inputType' for extractPartitions().
+  RowVectorPtr extractIntermediateInput(
+      const RowTypePtr& inputType,
+      folly::Range<char**> groups);
+
   // Produces output in if spilling has occurred. First produces data
   // from non-spilled partitions, then merges spill runs and unspilled data
   // form spilled partitions. Returns nullptr when at end. 'maxOutputRows' and
   // 'maxOutputBytes' specifies the max number of output rows and bytes in
-  // 'result'.
+  // 'result'. 'iterator' is the position in the groups of the non-spilled
+  // partitions which stay in memory after spillPartitions().
   bool getOutputWithSpill(
       int32_t maxOutputRows,
       int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
       const RowVectorPtr& result);
 
   // Prepares for the next spill partition for output. It sets
@@ -259,6 +310,17 @@ class GroupingSet {
   // Returns a RowType of the spilled data.
   RowTypePtr makeSpillType() const;
 
+  // Creates 'spiller_' for spilling the input of the aggregation.
+  void createInputSpiller();
+
+  // Returns true if the rows of some spill partitions can be spilled while
+  // the others stay in memory. Distinct, sorted and distinct aggregations
+  // keep state outside the spilled rows and always spill all the rows.
+  bool canSpillPartitions() const;
+
+  // Spills the rows of 'partitions' and erases them from 'table_'.
+  void spillPartitionRows(const SpillPartitionNumSet& partitions);
+
   // Copies the finalized state from 'mergeRows' to 'result' and clears
   // 'mergeRows'. Used for producing a batch of results when aggregating spilled
   // groups.
@@ -270,6 +332,12 @@ class GroupingSet {
   // 'toIntermediate'.
   std::vector<Accumulator> accumulators(bool excludeToIntermediate);
 
+  // Invoked in approximate mode after a group probe. Deselects from
+  // 'activeRows_' the rows of the new groups beyond 'approxMaxGroups_', adds
+  // their counts to 'approxDroppedGroupsSummary_' and records the groups in
+  // 'approxDroppedGroups_' for erasing once the new groups are initialized.
+  void dropApproxGroups();
+
   std::vector<column_index_t> keyChannels_;
 
   /// A subset of grouping keys on which the input is clustered.
@@ -297,6 +365,28 @@ class GroupingSet {
 
   const common::SpillConfig* const spillConfig_;
 
+  // Maximum number of groups in 'table_'. 0 if all groups are kept.
+  const uint64_t approxMaxGroups_;
+
+  // Number of input rows dropped because their groups did not fit in
+  // 'approxMaxGroups_'.
+  int64_t numApproxDroppedRows_{0};
+
+  // Number of dropped groups tracked by 'approxDroppedGroupsSummary_'.
+  static constexpr int32_t kApproxDroppedGroupsCapacity = 1'024;
+
+  // Space-Saving summary of the dropped rows by hash of their grouping keys.
+  // A group is either in 'table_' or dropped for all its rows, so the largest
+  // count of the summary bounds the rows of any missing group.
+  functions::ApproxMostFrequentStreamSummary<uint64_t>
+      approxDroppedGroupsSummary_;
+
+  // Temporaries for the groups dropped from the current input.
+  folly::F14FastMap<char*, int32_t> approxDroppedGroupIndices_;
+  std::vector<char*> approxDroppedGroups_;
+  std::vector<int64_t> approxDroppedGroupRows_;
+  raw_vector<uint64_t> approxDroppedGroupHashes_;
+
   // Indicates if this grouping set and the associated hash aggregation operator
   // is under non-reclaimable execution section or not.
   tsan_atomic<bool>* const nonReclaimableSection_;
@@ -363,6 +453,9 @@ class GroupingSet {
   // Pool of the OperatorCtx. Used for spilling.
   memory::MemoryPool& pool_;
 
+  // Decodes the grouping keys if set. From the DriverCtx of the operator.
+  DecodedVectorCache* const decodedVectorCache_;
+
   // True if partial aggregation has been given up as non-productive.
   bool abandonedPartialAggregation_{false};
 
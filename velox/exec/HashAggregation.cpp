@@ -15,10 +15,59 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if the final aggregation 'node' can merge its groups across
+// drivers instead of depending on input partitioned on the grouping keys.
+bool canMergeAcrossDrivers(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  if (!config.finalAggregationMergeAcrossDrivers() ||
+      node.step() != core::AggregationNode::Step::kFinal ||
+      node.groupingKeys().empty() || node.aggregates().empty() ||
+      !node.preGroupedKeys().empty()) {
+    return false;
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the maximum number of groups per driver of 'node' if it aggregates
+// approximately or 0 if it aggregates exactly.
+uint64_t approxMaxGroups(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  const auto maxGroups = config.approxAggregationMaxGroups();
+  if (maxGroups == 0 || isPartialOutput(node.step()) ||
+      node.groupingKeys().empty() || node.aggregates().empty() ||
+      !node.preGroupedKeys().empty() || canMergeAcrossDrivers(node, config)) {
+    return 0;
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return 0;
+    }
+  }
+  return maxGroups;
+}
+
+// Returns true if 'node' can spill. The groups merged across drivers and the
+// bounded groups of an approximate aggregation are kept in memory.
+bool canSpill(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  return node.canSpill(config) && !canMergeAcrossDrivers(node, config) &&
+      approxMaxGroups(node, config) == 0;
+}
+} // namespace
 
 HashAggregation::HashAggregation(
     int32_t operatorId,
@@ -32,7 +81,7 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          canSpill(*aggregationNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       aggregationNode_(aggregationNode),
@@ -45,6 +94,12 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationMaxHotKeys_(
+          driverCtx->queryConfig().abandonPartialAggregationMaxHotKeys()),
+      mergeAcrossDrivers_(
+          canMergeAcrossDrivers(*aggregationNode, driverCtx->queryConfig())),
+      approxMaxGroups_(
+          approxMaxGroups(*aggregationNode, driverCtx->queryConfig())),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -85,6 +140,16 @@ void HashAggregation::initialize() {
     identityProjections_.emplace_back(hashers[i]->channel(), i);
   }
 
+  if (abandonPartialAggregationMaxHotKeys_ > 0 && isPartialOutput_ &&
+      !isGlobal_ && !isDistinct_ && preGroupedChannels.empty()) {
+    hotKeyHashers_ =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+  }
+
+  if (mergeAcrossDrivers_) {
+    mergeInputType_ = inputType;
+  }
+
   std::optional<column_index_t> groupIdChannel;
   if (aggregationNode_->groupId().has_value()) {
     groupIdChannel = outputType_->getChildIdxIfExists(
@@ -105,7 +170,8 @@ void HashAggregation::initialize() {
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &nonReclaimableSection_,
       operatorCtx_.get(),
-      &spillStats_);
+      &spillStats_,
+      approxMaxGroups_);
 
   aggregationNode_.reset();
 }
@@ -122,8 +188,12 @@ void HashAggregation::addInput(RowVectorPtr input) {
     pushdownChecked_ = true;
   }
   if (abandonedPartialAggregation_) {
-    input_ = input;
     numInputRows_ += input->size();
+    if (hotKeySketch_ != nullptr || !hotKeyHashes_.empty()) {
+      input_ = addHotKeyInput(input);
+    } else {
+      input_ = input;
+    }
     return;
   }
   groupingSet_->addInput(input, mayPushdown_);
@@ -158,6 +228,92 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::maybeStartHotKeySketch() {
+  // The sketch tracks more keys than it reports as hot to bound the error of
+  // the estimated counts of the hot keys.
+  constexpr int32_t kSketchCapacityFactor = 4;
+  if (hotKeyHashers_.empty()) {
+    return;
+  }
+  hotKeySketch_ =
+      std::make_unique<functions::ApproxMostFrequentStreamSummary<uint64_t>>();
+  hotKeySketch_->setCapacity(
+      kSketchCapacityFactor * abandonPartialAggregationMaxHotKeys_);
+  numSketchedRows_ = 0;
+}
+
+void HashAggregation::decideHotKeys() {
+  VELOX_CHECK_NOT_NULL(hotKeySketch_);
+  // A key is hot if it covers at least 1 / 'maxHotKeys' of the sampled rows.
+  const int64_t minCount = std::max<int64_t>(
+      2, numSketchedRows_ / abandonPartialAggregationMaxHotKeys_);
+  for (const auto& [hash, count] :
+       hotKeySketch_->topK(abandonPartialAggregationMaxHotKeys_)) {
+    if (count < minCount) {
+      break;
+    }
+    hotKeyHashes_.insert(hash);
+  }
+  hotKeySketch_.reset();
+  addRuntimeStat(
+      "partialAggregationHotKeys", RuntimeCounter(hotKeyHashes_.size()));
+  if (hotKeyHashes_.empty()) {
+    hotKeyHashers_.clear();
+  }
+}
+
+RowVectorPtr HashAggregation::addHotKeyInput(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  hotKeyInputRows_.resize(numRows);
+  hotKeyInputRows_.setAll();
+  hotKeyInputHashes_.resize(numRows);
+  for (auto i = 0; i < hotKeyHashers_.size(); ++i) {
+    auto& hasher = hotKeyHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), hotKeyInputRows_);
+    hasher->hash(hotKeyInputRows_, i > 0, hotKeyInputHashes_);
+  }
+
+  if (hotKeySketch_ != nullptr) {
+    for (auto i = 0; i < numRows; ++i) {
+      hotKeySketch_->insert(hotKeyInputHashes_[i]);
+    }
+    numSketchedRows_ += numRows;
+    addRuntimeStat("partialAggregationColdKeyRows", RuntimeCounter(numRows));
+    if (numSketchedRows_ >= abandonPartialAggregationMinRows_) {
+      decideHotKeys();
+    }
+    return input;
+  }
+
+  BufferPtr hotIndices = allocateIndices(numRows, pool());
+  BufferPtr coldIndices = allocateIndices(numRows, pool());
+  auto* rawHotIndices = hotIndices->asMutable<vector_size_t>();
+  auto* rawColdIndices = coldIndices->asMutable<vector_size_t>();
+  vector_size_t numHot = 0;
+  vector_size_t numCold = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (hotKeyHashes_.contains(hotKeyInputHashes_[i])) {
+      rawHotIndices[numHot++] = i;
+    } else {
+      rawColdIndices[numCold++] = i;
+    }
+  }
+  addRuntimeStat("partialAggregationHotKeyRows", RuntimeCounter(numHot));
+  addRuntimeStat("partialAggregationColdKeyRows", RuntimeCounter(numCold));
+
+  if (numHot > 0) {
+    groupingSet_->addInput(
+        numHot == numRows ? input : wrap(numHot, hotIndices, input), false);
+    if (groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_)) {
+      partialFull_ = true;
+    }
+  }
+  if (numCold == 0) {
+    return nullptr;
+  }
+  return numCold == numRows ? input : wrap(numCold, coldIndices, input);
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -186,6 +342,13 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+
+  if (groupingSet_->isApproximate()) {
+    runtimeStats["approxAggregationDroppedRows"] =
+        RuntimeMetric(groupingSet_->numApproxDroppedRows());
+    runtimeStats["approxAggregationMaxDroppedGroupRows"] =
+        RuntimeMetric(groupingSet_->maxApproxDroppedGroupRows());
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -216,7 +379,7 @@ void HashAggregation::resetPartialOutputIfNeed() {
   }
   groupingSet_->resetTable(/*freeTable=*/false);
   partialFull_ = false;
-  if (!finished_) {
+  if (!finished_ && !abandonedPartialAggregation_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
   numOutputRows_ = 0;
@@ -234,10 +397,12 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
+    groupingSet_->abandonPartialAggregation(
+        /*keepTable=*/!hotKeyHashers_.empty());
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
     abandonedPartialAggregation_ = true;
+    maybeStartHotKeySketch();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -266,18 +431,29 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (mergePending_) {
+    if (mergeFuture_.valid()) {
+      return nullptr;
+    }
+    mergeAcrossDrivers();
+  }
   if (abandonedPartialAggregation_) {
-    if (noMoreInput_) {
+    // Hot keys are aggregated in 'groupingSet_' and need to be flushed when
+    // the table is full or at the end of the input.
+    const bool hasHotKeys = !hotKeyHashes_.empty();
+    if (noMoreInput_ && !hasHotKeys) {
       finished_ = true;
     }
-    if (!input_) {
+    if (input_ != nullptr) {
+      prepareOutput(input_->size());
+      groupingSet_->toIntermediate(input_, output_);
+      numOutputRows_ += input_->size();
+      input_ = nullptr;
+      return output_;
+    }
+    if (!hasHotKeys || (!noMoreInput_ && !partialFull_)) {
       return nullptr;
     }
-    prepareOutput(input_->size());
-    groupingSet_->toIntermediate(input_, output_);
-    numOutputRows_ += input_->size();
-    input_ = nullptr;
-    return output_;
   }
 
   // Produce results if one of the following is true:
@@ -379,12 +555,95 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 
 void HashAggregation::noMoreInput() {
   updateEstimatedOutputRowSize();
+  if (mergeAcrossDrivers_) {
+    Operator::noMoreInput();
+    partitionAcrossDrivers();
+    return;
+  }
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (mergeFuture_.valid()) {
+    *future = std::move(mergeFuture_);
+    return BlockingReason::kWaitForAggregationMerge;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void HashAggregation::partitionAcrossDrivers() {
+  VELOX_CHECK(mergeAcrossDrivers_);
+  mergePending_ = true;
+  const auto numDrivers =
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+  if (numDrivers == 1) {
+    return;
+  }
+  groupingSet_->extractPartitions(
+      mergeInputType_,
+      numDrivers,
+      outputBatchRows(estimatedOutputRowSize_),
+      mergePartitions_);
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish moves the partitions of all drivers to the
+  // drivers that merge them. The other drivers are blocked until then.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &mergeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  std::vector<HashAggregation*> aggregations{this};
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    aggregations.push_back(aggregation);
+  }
+  for (auto* target : aggregations) {
+    const auto partition = target->operatorCtx_->driverCtx()->driverId;
+    for (auto* source : aggregations) {
+      auto& vectors = source->mergePartitions_[partition];
+      target->mergeInput_.insert(
+          target->mergeInput_.end(),
+          std::make_move_iterator(vectors.begin()),
+          std::make_move_iterator(vectors.end()));
+      vectors.clear();
+    }
+  }
+}
+
+void HashAggregation::mergeAcrossDrivers() {
+  VELOX_CHECK(mergePending_);
+  vector_size_t numMergedRows = 0;
+  for (auto& input : mergeInput_) {
+    numMergedRows += input->size();
+    groupingSet_->addInput(input, /*mayPushdown=*/false);
+    input = nullptr;
+  }
+  mergeInput_.clear();
+  mergePartitions_.clear();
+  mergePending_ = false;
+  addRuntimeStat("mergedAcrossDriversRows", RuntimeCounter(numMergedRows));
+  groupingSet_->noMoreInput();
+  pool()->release();
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -422,8 +681,16 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    if (operatorCtx_->driverCtx()
+            ->queryConfig()
+            .aggregationIncrementalSpillEnabled() &&
+        groupingSet_->spillPartitions(targetBytes)) {
+      // Only the partitions needed for 'targetBytes' are spilled. The memory
+      // of their erased groups is reused by the following input.
+      addRuntimeStat("incrementalSpills", RuntimeCounter(1));
+      pool()->release();
+      return;
+    }
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
@@ -436,6 +703,8 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  mergeInput_.clear();
+  mergePartitions_.clear();
   groupingSet_.reset();
 }
 
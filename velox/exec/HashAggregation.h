@@ -15,8 +15,11 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -39,9 +42,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -70,6 +71,28 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Invoked on abandoning partial aggregation. Starts sketching the grouping
+  // keys of the input for finding hot keys if enabled.
+  void maybeStartHotKeySketch();
+
+  // Invoked after partial aggregation has been abandoned with hot keys
+  // enabled. Adds the rows of 'input' with hot keys to 'groupingSet_' and
+  // returns the other rows for conversion to intermediate results. Returns
+  // nullptr if all rows have hot keys.
+  RowVectorPtr addHotKeyInput(const RowVectorPtr& input);
+
+  // Chooses the hot keys from 'hotKeySketch_' and frees the sketch.
+  void decideHotKeys();
+
+  // Invoked at the end of the input if 'mergeAcrossDrivers_' is set.
+  // Partitions the groups of 'groupingSet_' by driver. The last driver to
+  // finish hands the partitions of all drivers over to their drivers.
+  void partitionAcrossDrivers();
+
+  // Adds the groups of the partition of 'this' from all the drivers to
+  // 'groupingSet_' after all drivers have partitioned their groups.
+  void mergeAcrossDrivers();
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
@@ -86,6 +109,18 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Max number of hot keys to keep aggregating after abandoning partial
+  // aggregation. 0 means partial aggregation is abandoned for all keys.
+  const int32_t abandonPartialAggregationMaxHotKeys_;
+
+  // True if the drivers of a final aggregation merge their groups by hash
+  // partition of the grouping keys at the end of the input. The input of the
+  // drivers is then not partitioned on the grouping keys.
+  const bool mergeAcrossDrivers_;
+
+  // Maximum number of groups per driver if the aggregation is approximate, 0
+  // otherwise. See QueryConfig::kApproxAggregationMaxGroups.
+  const uint64_t approxMaxGroups_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -101,6 +136,35 @@ class HashAggregation : public Operator {
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
 
+  // Hashers for the grouping keys of the input. Set if hot keys are enabled.
+  std::vector<std::unique_ptr<VectorHasher>> hotKeyHashers_;
+  // Space-Saving sketch of the hashes of the grouping keys. Set while sampling
+  // the input after abandoning partial aggregation.
+  std::unique_ptr<functions::ApproxMostFrequentStreamSummary<uint64_t>>
+      hotKeySketch_;
+  // Number of input rows added to 'hotKeySketch_'.
+  int64_t numSketchedRows_{0};
+  // Hashes of the grouping keys that keep being aggregated after abandoning
+  // partial aggregation. A cold key with the same hash as a hot key is
+  // aggregated as well.
+  folly::F14FastSet<uint64_t> hotKeyHashes_;
+  // Temporaries for splitting the input into hot and cold key rows.
+  SelectivityVector hotKeyInputRows_;
+  raw_vector<uint64_t> hotKeyInputHashes_;
+
+  // Input type of the aggregation. Set if 'mergeAcrossDrivers_' is true.
+  RowTypePtr mergeInputType_;
+  // True from the end of the input until the groups of the partition of
+  // 'this' have been merged into 'groupingSet_'.
+  bool mergePending_{false};
+  // Fulfilled when all drivers have partitioned their groups.
+  ContinueFuture mergeFuture_{ContinueFuture::makeEmpty()};
+  // The groups of 'this' in intermediate form. Indexed by driver id.
+  std::vector<std::vector<RowVectorPtr>> mergePartitions_;
+  // The groups of the partition of 'this' from all the drivers. Set by the
+  // last driver to partition its groups.
+  std::vector<RowVectorPtr> mergeInput_;
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
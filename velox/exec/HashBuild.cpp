@@ -134,6 +134,8 @@ void HashBuild::setupTable() {
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  const auto coldPayloadMinBytes =
+      operatorCtx_->driverCtx()->queryConfig().hashBuildColdPayloadMinBytes();
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -145,7 +147,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        coldPayloadMinBytes);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -165,7 +168,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          coldPayloadMinBytes);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -176,7 +180,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          coldPayloadMinBytes);
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
@@ -314,9 +319,11 @@ void HashBuild::addInput(RowVectorPtr input) {
 
   auto& hashers = table_->hashers();
 
+  auto* decodedVectorCache =
+      operatorCtx_->driverCtx()->decodedVectorCache.get();
   for (auto i = 0; i < hashers.size(); ++i) {
-    auto key = input->childAt(hashers[i]->channel())->loadedVector();
-    hashers[i]->decode(*key, activeRows_);
+    hashers[i]->decode(
+        input->childAt(hashers[i]->channel()), activeRows_, decodedVectorCache);
   }
 
   // Update statistics for null keys in join operator.
@@ -433,6 +440,12 @@ void HashBuild::ensureInputFits(RowVectorPtr& input) {
   auto* rows = table_->rows();
   const auto numRows = rows->numRows();
 
+  // Forecasts the hash table memory to build from the rows so far so that the
+  // memory arbitrator can grow the query capacity for it ahead of the table
+  // build.
+  pool()->setGrowthForecast(
+      table_->estimateHashTableSize(numRows + input->size()));
+
   auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
   const auto outOfLineBytes =
       rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
@@ -701,6 +714,11 @@ bool HashBuild::finishHashBuild() {
     otherBuilds.push_back(build);
   }
 
+  // The table memory is reserved by ensureTableFits() from here on.
+  pool()->setGrowthForecast(0);
+  for (auto* build : otherBuilds) {
+    build->pool()->setGrowthForecast(0);
+  }
   ensureTableFits(numRows);
 
   std::vector<std::unique_ptr<BaseHashTable>> otherTables;
@@ -1045,7 +1063,7 @@ bool HashBuild::canReclaim() const {
 }
 
 void HashBuild::reclaim(
-    uint64_t /*unused*/,
+    uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
   TestValue::adjust("facebook::velox::exec::HashBuild::reclaim", this);
   VELOX_CHECK(canSpill());
@@ -1113,11 +1131,29 @@ void HashBuild::reclaim(
     spillers.push_back(buildOp->spiller_.get());
   }
 
+  if (operatorCtx_->driverCtx()->queryConfig().hybridJoinSpillEnabled()) {
+    // Spills the same partitions from all the build operators so that the
+    // rows of a spilled partition are all on disk. The rows of the spilled
+    // partitions are erased from the row containers. Their memory is reused
+    // by the input of the partitions which stay in memory.
+    const auto partitions = Spiller::partitionsToSpill(spillers, targetBytes);
+    if (!partitions.empty()) {
+      spillHashJoinTable(spillers, config, &partitions);
+      addRuntimeStat(
+          "hybridSpilledPartitions", RuntimeCounter(partitions.size()));
+      for (auto* op : operators) {
+        op->pool()->release();
+      }
+      return;
+    }
+  }
+
   spillHashJoinTable(spillers, config);
 
   for (auto* op : operators) {
     HashBuild* buildOp = static_cast<HashBuild*>(op);
     buildOp->table_->clear(true);
+    buildOp->pool()->setGrowthForecast(0);
     buildOp->pool()->release();
   }
 }
@@ -1138,6 +1174,7 @@ bool HashBuild::nonReclaimableState() const {
 
 void HashBuild::close() {
   Operator::close();
+  pool()->setGrowthForecast(0);
 
   {
     // Free up major memory usage. Gate access to them as they can be accessed
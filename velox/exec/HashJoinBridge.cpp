@@ -111,7 +111,8 @@ std::unique_ptr<Spiller> createSpiller(
 
 std::vector<std::unique_ptr<HashJoinTableSpillResult>> spillHashJoinTable(
     const std::vector<Spiller*>& spillers,
-    const common::SpillConfig* spillConfig) {
+    const common::SpillConfig* spillConfig,
+    const SpillPartitionNumSet* partitions) {
   VELOX_CHECK_NOT_NULL(spillConfig);
   auto spillExecutor = spillConfig->executor;
   std::vector<std::shared_ptr<AsyncSource<HashJoinTableSpillResult>>>
@@ -119,9 +120,13 @@ std::vector<std::unique_ptr<HashJoinTableSpillResult>> spillHashJoinTable(
   for (auto* spiller : spillers) {
     spillTasks.push_back(
         memory::createAsyncMemoryReclaimTask<HashJoinTableSpillResult>(
-            [spiller]() {
+            [spiller, partitions]() {
               try {
-                spiller->spill();
+                if (partitions != nullptr) {
+                  spiller->spill(*partitions);
+                } else {
+                  spiller->spill();
+                }
                 return std::make_unique<HashJoinTableSpillResult>(spiller);
               } catch (const std::exception& e) {
                 LOG(ERROR) << "Spill from hash join bridge failed: "
@@ -217,10 +217,12 @@ struct HashJoinTableSpillResult {
 
 /// Invoked to spill the hash table from a set of spillers. If 'spillExecutor'
 /// is provided, then we do parallel spill. This is used by hash build to spill
-/// a partially built hash join table.
+/// a partially built hash join table. If 'partitions' is not null, only spills
+/// the rows of 'partitions' and erases them from the row containers.
 std::vector<std::unique_ptr<HashJoinTableSpillResult>> spillHashJoinTable(
     const std::vector<Spiller*>& spillers,
-    const common::SpillConfig* spillConfig);
+    const common::SpillConfig* spillConfig,
+    const SpillPartitionNumSet* partitions = nullptr);
 
 /// Invoked to spill 'table' and returns spilled partitions. This is used by
 /// hash probe or hash join bridge to spill a fully built table.
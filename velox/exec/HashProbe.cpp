@@ -58,12 +58,13 @@ RowTypePtr makeTableType(
 }
 
 // Copy values from 'rows' of 'table' according to 'projections' in
-// 'result'. Reuses 'result' children where possible.
+// 'result'. Reuses 'result' children where possible, else gets them from
+// the vector pool of 'execCtx'.
 void extractColumns(
     BaseHashTable* table,
     folly::Range<char* const*> rows,
     folly::Range<const IdentityProjection*> projections,
-    memory::MemoryPool* pool,
+    core::ExecCtx* execCtx,
     const std::vector<TypePtr>& resultTypes,
     std::vector<VectorPtr>& resultVectors) {
   VELOX_CHECK_EQ(resultTypes.size(), resultVectors.size());
@@ -72,16 +73,72 @@ void extractColumns(
     VELOX_CHECK_LT(resultChannel, resultVectors.size());
 
     auto& child = resultVectors[resultChannel];
-    // TODO: Consider reuse of complex types.
-    if (!child || !BaseVector::isVectorWritable(child) ||
-        !child->isFlatEncoding()) {
-      child = BaseVector::create(resultTypes[resultChannel], rows.size(), pool);
+    if (!child || !BaseVector::isVectorWritable(child)) {
+      child = execCtx->getVector(resultTypes[resultChannel], rows.size());
+    } else if (!child->isFlatEncoding()) {
+      // Complex types are extracted by appending to their offsets and
+      // children. Resizing to 0 first also clears the nulls and sizes the
+      // children of a row.
+      child->resize(0);
+      BaseVector::prepareForReuse(child, rows.size());
     }
     child->resize(rows.size());
     table->extractColumn(rows, projection.inputChannel, child);
   }
 }
 
+// Loads a column of 'table' for the rows in 'rows'. A nullptr row produces a
+// null. Keeps 'table' alive until loaded.
+class TableColumnLoader : public VectorLoader {
+ public:
+  TableColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      BufferPtr rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK_NULL(hook, "Build side columns do not support value hooks");
+    const auto* tableRows = rows_->as<char*>();
+    std::vector<char*> selectedRows;
+    if (rows.size() < resultSize) {
+      // Extracts nulls for the rows that are not loaded.
+      selectedRows.resize(resultSize, nullptr);
+      for (auto row : rows) {
+        selectedRows[row] = tableRows[row];
+      }
+      tableRows = selectedRows.data();
+    }
+    if (!*result || !result->unique() || !(*result)->isFlatEncoding()) {
+      *result = BaseVector::create(type_, resultSize, pool_);
+    } else {
+      (*result)->resize(resultSize);
+    }
+    table_->extractColumn(
+        folly::Range<char* const*>(tableRows, resultSize), column_, *result);
+    table_ = nullptr;
+    rows_ = nullptr;
+  }
+
+ private:
+  std::shared_ptr<BaseHashTable> table_;
+  BufferPtr rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -108,6 +165,21 @@ SpillPartitionNumSet toPartitionNumSet(
   return partitionNumSet;
 }
 
+// Number of probe rows to count matches for before deciding whether to check
+// the probe rows against a Bloom filter of the build side keys.
+constexpr int64_t kBloomFilterSampleRows = 10'000;
+
+// Minimum number of rows of a hash table for checking the probe rows against a
+// Bloom filter first. Smaller tables are about as fast to probe.
+constexpr uint64_t kBloomFilterMinTableRows = 1 << 16;
+
+// Returns the size in bytes of a Bloom filter sized for 'numValues'. See
+// BloomFilter::reset().
+uint64_t bloomFilterBytes(uint64_t numValues) {
+  return std::max<uint64_t>(4, bits::nextPowerOfTwo(numValues) / 4) *
+      sizeof(uint64_t);
+}
+
 template <typename T>
 T* initBuffer(BufferPtr& buffer, vector_size_t size, memory::MemoryPool* pool) {
   VELOX_CHECK(!buffer || buffer->isMutable());
@@ -159,6 +231,19 @@ void HashProbe::initialize() {
 
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
+  lookup_->radixClusterBits =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeRadixClusterBits();
+  // Spilling may clear the table while lazy output columns refer to its rows.
+  lazyTableOutput_ =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeLazyBuildColumns() &&
+      !canSpill();
+  // The probe rows which fail the Bloom filter are dropped.
+  if (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+      isRightSemiFilterJoin(joinType_)) {
+    bloomFilterMaxMatchPct_ = operatorCtx_->driverCtx()
+                                  ->queryConfig()
+                                  .hashProbeBloomFilterMaxMatchPct();
+  }
   auto buildType = joinNode_->sources()[1]->outputType();
   auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
   if (joinNode_->filter()) {
@@ -346,9 +431,18 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   initializeResultIter();
+  numBloomFilterSampleRows_ = 0;
+  numBloomFilterSampleHits_ = 0;
+  bloomFilterDecided_ = false;
+  bloomFilter_ = nullptr;
 
   VELOX_CHECK_NOT_NULL(table_);
 
+  if (operatorCtx_->driverCtx()->queryConfig().outputBatchCacheBudgetBytes() >
+      0) {
+    outputBatchSize_ = outputBatchRows();
+  }
+
   maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
   checkMaxSpillLevel(hashBuildResult->restoredPartitionId);
@@ -369,8 +463,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       canPushdownBloomFilters()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -387,14 +482,31 @@ void HashProbe::asyncWaitForHashTable() {
     // nulls on the probe side. Hence, cannot filter these out.
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
+    int32_t numBloomFilters{0};
+
     for (auto i = 0; i < keyChannels_.size(); ++i) {
       if (channels.find(keyChannels_[i]) != channels.end()) {
         if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+        } else if (canPushdownBloomFilters()) {
+          // The key has too many distinct values for an exact filter. Fall
+          // back to an approximate one.
+          // The filter is built once per table and its Bloom filter is
+          // shared by the probe drivers.
+          if (const auto* bloomFilter = table_->keyValuesBloomFilter(i)) {
+            dynamicFilters_.emplace(
+                keyChannels_[i], bloomFilter->clone(nullAllowed));
+            hasBloomDynamicFilters_ = true;
+            ++numBloomFilters;
+          }
         }
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
+    if (numBloomFilters > 0) {
+      addRuntimeStat(
+          "bloomDynamicFiltersProduced", RuntimeCounter(numBloomFilters));
+    }
   }
 }
 
@@ -570,13 +682,22 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   return fromStateToBlockingReason(state_);
 }
 
+bool HashProbe::canPushdownBloomFilters() const {
+  const auto maxBytes = operatorCtx_->driverCtx()
+                            ->queryConfig()
+                            .hashProbeBloomFilterPushdownMaxSize();
+  return maxBytes > 0 && bloomFilterBytes(table_->numDistinct()) <= maxBytes;
+}
+
 void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
   //  * build side has no dependent columns.
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasBloomDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -587,9 +708,13 @@ void HashProbe::decodeAndDetectNonNullKeys() {
   nonNullInputRows_.resize(input_->size());
   nonNullInputRows_.setAll();
 
+  auto* decodedVectorCache =
+      operatorCtx_->driverCtx()->decodedVectorCache.get();
   for (auto i = 0; i < hashers_.size(); ++i) {
-    auto key = input_->childAt(hashers_[i]->channel())->loadedVector();
-    hashers_[i]->decode(*key, nonNullInputRows_);
+    hashers_[i]->decode(
+        input_->childAt(hashers_[i]->channel()),
+        nonNullInputRows_,
+        decodedVectorCache);
   }
 
   deselectRowsWithNulls(hashers_, nonNullInputRows_);
@@ -695,25 +820,86 @@ void HashProbe::addInput(RowVectorPtr input) {
       input_ = nullptr;
       return;
     }
+    if (bloomFilter_ != nullptr) {
+      applyBloomFilter();
+      if (lookup_->rows.empty()) {
+        input_ = nullptr;
+        return;
+      }
+    }
     lookup_->hits.resize(lookup_->rows.back() + 1);
     table_->joinProbe(*lookup_);
+    if (bloomFilterMaxMatchPct_ > 0 && !bloomFilterDecided_) {
+      maybeStartBloomFilter();
+    }
   }
 
   resultIter_->reset(*lookup_);
 }
 
+void HashProbe::maybeStartBloomFilter() {
+  if (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+      table_->numDistinct() < kBloomFilterMinTableRows) {
+    // Array and normalized key tables are probed with a direct lookup.
+    bloomFilterDecided_ = true;
+    return;
+  }
+  const auto& hits = lookup_->hits;
+  for (auto row : lookup_->rows) {
+    if (hits[row] != nullptr) {
+      ++numBloomFilterSampleHits_;
+    }
+  }
+  numBloomFilterSampleRows_ += lookup_->rows.size();
+  if (numBloomFilterSampleRows_ < kBloomFilterSampleRows) {
+    return;
+  }
+  bloomFilterDecided_ = true;
+  if (100 * numBloomFilterSampleHits_ >
+      bloomFilterMaxMatchPct_ * numBloomFilterSampleRows_) {
+    return;
+  }
+  bloomFilter_ = &table_->keyHashBloomFilter();
+  addRuntimeStat("hashProbeBloomFilter", RuntimeCounter(1));
+}
+
+void HashProbe::applyBloomFilter() {
+  auto& rows = lookup_->rows;
+  const auto& hashes = lookup_->hashes;
+  const auto numRows = rows.size();
+  vector_size_t numPassed = 0;
+  for (auto row : rows) {
+    if (bloomFilter_->mayContain(hashes[row])) {
+      rows[numPassed++] = row;
+    }
+  }
+  rows.resize(numPassed);
+  if (numPassed < numRows) {
+    addRuntimeStat(
+        "hashProbeBloomFilterRejectedRows",
+        RuntimeCounter(numRows - numPassed));
+  }
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
   // clearIdentityProjectedOutput). BaseVector::prepareForReuse keeps null
   // children unmodified and makes non-null (build side) children reusable.
-  if (output_) {
+  if (output_ && output_.use_count() == 1) {
     VectorPtr output = std::move(output_);
     BaseVector::prepareForReuse(output, size);
     output_ = std::static_pointer_cast<RowVector>(output);
-  } else {
-    output_ = BaseVector::create<RowVector>(outputType_, size, pool());
+    return;
+  }
+  // The consumer still holds the previous output. Recycles it once the
+  // consumer drops it.
+  auto* execCtx = operatorCtx_->execCtx();
+  if (output_ && execCtx->vectorPool()) {
+    execCtx->vectorPool()->releaseWhenUnreferenced(std::move(output_));
   }
+  output_ = std::static_pointer_cast<RowVector>(
+      execCtx->getVector(outputType_, size));
 }
 
 namespace {
@@ -783,17 +969,41 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyTableOutput_) {
+    fillLazyTableOutput(size);
   } else {
     extractColumns(
         table_.get(),
         folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
         tableOutputProjections_,
-        pool(),
+        operatorCtx_->execCtx(),
         outputType_->children(),
         output_->children());
   }
 }
 
+void HashProbe::fillLazyTableOutput(vector_size_t size) {
+  if (tableOutputProjections_.empty()) {
+    return;
+  }
+  // 'outputTableRows_' is reused for the next output batch. The loaders of
+  // all the columns share a copy of the table rows.
+  auto rows = AlignedBuffer::allocate<char*>(size, pool());
+  std::memcpy(
+      rows->asMutable<char>(),
+      outputTableRows_->as<char>(),
+      size * sizeof(char*));
+  for (const auto& projection : tableOutputProjections_) {
+    const auto& type = outputType_->childAt(projection.outputChannel);
+    output_->childAt(projection.outputChannel) = std::make_shared<LazyVector>(
+        pool(),
+        type,
+        size,
+        std::make_unique<TableColumnLoader>(
+            table_, rows, projection.inputChannel, type, pool()));
+  }
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   auto* outputTableRows =
       initBuffer<char*>(outputTableRows_, outputTableRowsCapacity_, pool());
@@ -834,7 +1044,7 @@ RowVectorPtr HashProbe::getBuildSideOutput() {
       table_.get(),
       folly::Range<char**>(outputTableRows, numOut),
       tableOutputProjections_,
-      pool(),
+      operatorCtx_->execCtx(),
       outputType_->children(),
       output_->children());
 
@@ -1137,7 +1347,7 @@ RowVectorPtr HashProbe::createFilterInput(vector_size_t size) {
       table_.get(),
       folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
       filterTableProjections_,
-      pool(),
+      operatorCtx_->execCtx(),
       filterInputType_->children(),
       filterColumns);
 
@@ -1669,6 +1879,14 @@ bool HashProbe::canReclaim() const {
   return canSpill() && !exceededMaxSpillLevelLimit_;
 }
 
+std::optional<uint64_t> HashProbe::workingSetBytesPerRow() const {
+  if (table_ == nullptr) {
+    return std::nullopt;
+  }
+  // Each output row reads a build side row at a random place in the table.
+  return table_->rows()->estimateRowSize();
+}
+
 void HashProbe::reclaim(
     uint64_t /*unused*/,
     memory::MemoryReclaimer::Stats& stats) {
@@ -68,6 +68,8 @@ class HashProbe : public Operator {
 
   bool canReclaim() const override;
 
+  std::optional<uint64_t> workingSetBytesPerRow() const override;
+
   bool testingHasInputSpiller() const {
     return inputSpiller_ != nullptr;
   }
@@ -120,6 +122,10 @@ class HashProbe : public Operator {
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Populates the build side output columns with lazy vectors that extract
+  // the values from 'table_' when loaded.
+  void fillLazyTableOutput(vector_size_t size);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -215,6 +221,12 @@ class HashProbe : public Operator {
   // Indicates if the probe input is read from spilled data or not.
   bool isSpillInput() const;
 
+  // Returns true if Bloom filters may be pushed down for join keys which have
+  // too many distinct values for an exact dynamic filter. This is the case if
+  // enabled by QueryConfig::kHashProbeBloomFilterPushdownMaxSize and the
+  // Bloom filter for the build side keys fits in that size.
+  bool canPushdownBloomFilters() const;
+
   // Indicates if there is more spill data to restore after finishes processing
   // the current probe inputs.
   bool hasMoreSpillData() const;
@@ -272,6 +284,15 @@ class HashProbe : public Operator {
   /// Decode join key inputs and populate 'nonNullInputRows_'.
   void decodeAndDetectNonNullKeys();
 
+  // Invoked after probing 'table_' if
+  // QueryConfig::kHashProbeBloomFilterMaxMatchPct is set. Counts the probe
+  // rows with a match and decides whether to check the next probe rows against
+  // the Bloom filter of 'table_' once enough rows are counted.
+  void maybeStartBloomFilter();
+
+  // Removes the rows whose keys are not in 'bloomFilter_' from 'lookup_'.
+  void applyBloomFilter();
+
   // Invoked when there is no more input from either upstream task or spill
   // input. If there is remaining spilled data, then the last finished probe
   // operator is responsible for notifying the hash build operators to build the
@@ -311,7 +332,9 @@ class HashProbe : public Operator {
   void clearBuffers();
 
   // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const vector_size_t outputBatchSize_;
+  // Recomputed when 'table_' is set if the output batches are sized to a
+  // cache budget.
+  vector_size_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -361,12 +384,31 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the generated dynamic filters are Bloom filters. These
+  // pass false positives so the join can't be replaced by them.
+  bool hasBloomDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
   // True if the join became a no-op after pushing down the filter.
   bool replacedWithDynamicFilter_{false};
 
+  // See QueryConfig::kHashProbeBloomFilterMaxMatchPct. 0 if disabled.
+  int32_t bloomFilterMaxMatchPct_{0};
+
+  // Number of probe rows and of probe rows with a match counted for deciding
+  // on 'bloomFilter_'.
+  int64_t numBloomFilterSampleRows_{0};
+  int64_t numBloomFilterSampleHits_{0};
+
+  // True after deciding whether to use 'bloomFilter_' for 'table_'.
+  bool bloomFilterDecided_{false};
+
+  // The Bloom filter of the build side keys of 'table_' the probe rows are
+  // checked against before probing 'table_'. Owned by 'table_'.
+  const BloomFilter<>* bloomFilter_{nullptr};
+
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
   // Current working hash table that is shared between other HashProbes in other
@@ -442,6 +484,9 @@ class HashProbe : public Operator {
   // maps from column index in 'table_' to channel in 'output_'.
   std::vector<IdentityProjection> tableOutputProjections_;
 
+  // True if the build side output columns of matching rows are lazy vectors.
+  bool lazyTableOutput_{false};
+
   // Rows of table found by join probe, later filtered by 'filter_'.
   BufferPtr outputTableRows_;
   vector_size_t outputTableRowsCapacity_;
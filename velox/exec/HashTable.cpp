@@ -43,6 +43,106 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+const BloomFilter<>& BaseHashTable::keyHashBloomFilter() {
+  std::call_once(keyHashBloomFilterOnce_, [&]() {
+    VELOX_CHECK_EQ(hashMode(), HashMode::kHash);
+    constexpr int32_t kBatchSize = 1'024;
+    keyHashBloomFilter_.reset(
+        std::min<uint64_t>(numDistinct(), std::numeric_limits<int32_t>::max()));
+    std::vector<char*> rows(kBatchSize);
+    raw_vector<uint64_t> hashes(kBatchSize);
+    for (auto* container : allRows()) {
+      RowContainerIterator iter;
+      while (const auto numRows =
+                 container->listRows(&iter, kBatchSize, rows.data())) {
+        const folly::Range<char**> batch(rows.data(), numRows);
+        for (auto i = 0; i < hashers_.size(); ++i) {
+          container->hash(i, batch, i > 0, hashes.data());
+        }
+        for (auto i = 0; i < numRows; ++i) {
+          keyHashBloomFilter_.insert(hashes[i]);
+        }
+      }
+    }
+  });
+  return keyHashBloomFilter_;
+}
+
+namespace {
+template <typename T>
+std::unique_ptr<common::Filter> makeKeyValuesBloomFilter(
+    const std::vector<RowContainer*>& containers,
+    column_index_t keyIndex,
+    uint64_t numDistinct,
+    memory::MemoryPool& pool) {
+  using PoolBloomFilter = BloomFilter<memory::StlAllocator<uint64_t>>;
+  constexpr int32_t kBatchSize = 1'024;
+  auto bloomFilter =
+      std::make_shared<PoolBloomFilter>(memory::StlAllocator<uint64_t>(pool));
+  bloomFilter->reset(
+      std::min<uint64_t>(numDistinct, std::numeric_limits<int32_t>::max()));
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  std::vector<char*> rows(kBatchSize);
+  for (auto* container : containers) {
+    const auto column = container->columnAt(keyIndex);
+    RowContainerIterator iter;
+    while (const auto numRows =
+               container->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            *reinterpret_cast<const T*>(rows[i] + column.offset());
+        bloomFilter->insert(common::BigintValuesUsingBloomFilter::hash(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+  if (min > max) {
+    // All keys are null.
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::shared_ptr<const PoolBloomFilter>(bloomFilter), false);
+}
+} // namespace
+
+const common::Filter* BaseHashTable::keyValuesBloomFilter(
+    column_index_t keyIndex) {
+  std::lock_guard<std::mutex> l(keyValuesBloomFiltersMutex_);
+  auto it = keyValuesBloomFilters_.find(keyIndex);
+  if (it != keyValuesBloomFilters_.end()) {
+    return it->second.get();
+  }
+  std::unique_ptr<common::Filter> filter;
+  auto& pool = *rows_->pool();
+  switch (hashers_[keyIndex]->typeKind()) {
+    case TypeKind::TINYINT:
+      filter = makeKeyValuesBloomFilter<int8_t>(
+          allRows(), keyIndex, numDistinct(), pool);
+      break;
+    case TypeKind::SMALLINT:
+      filter = makeKeyValuesBloomFilter<int16_t>(
+          allRows(), keyIndex, numDistinct(), pool);
+      break;
+    case TypeKind::INTEGER:
+      filter = makeKeyValuesBloomFilter<int32_t>(
+          allRows(), keyIndex, numDistinct(), pool);
+      break;
+    case TypeKind::BIGINT:
+      filter = makeKeyValuesBloomFilter<int64_t>(
+          allRows(), keyIndex, numDistinct(), pool);
+      break;
+    default:
+      break;
+  }
+  return keyValuesBloomFilters_.emplace(keyIndex, std::move(filter))
+      .first->second.get();
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -52,7 +152,8 @@ HashTable<ignoreNullKeys>::HashTable(
     bool isJoinBuild,
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    int32_t coldPayloadMinBytes)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       isJoinBuild_(isJoinBuild) {
@@ -73,8 +174,11 @@ HashTable<ignoreNullKeys>::HashTable(
       isJoinBuild,
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
-      pool);
+      pool,
+      coldPayloadMinBytes);
   nextOffset_ = rows_->nextOffset();
+  keyComparator_ = std::make_unique<CompiledKeyComparator>(
+      CompiledKeyComparator::forKeys(rows_.get()));
 }
 
 class ProbeState {
@@ -350,32 +454,14 @@ bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     HashLookup& lookup,
     vector_size_t row) {
-  int32_t numKeys = lookup.hashers.size();
-  // The loop runs at least once. Allow for first comparison to fail
-  // before loop end check.
-  int32_t i = 0;
-  do {
-    auto& hasher = lookup.hashers[i];
-    if (!rows_->equals<!ignoreNullKeys>(
-            group, rows_->columnAt(i), hasher->decodedVector(), row)) {
-      return false;
-    }
-  } while (++i < numKeys);
-  return true;
+  return keyComparator_->equals<!ignoreNullKeys>(group, lookup.hashers, row);
 }
 
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     const char* inserted) {
-  auto numKeys = hashers_.size();
-  int32_t i = 0;
-  do {
-    if (rows_->compare(group, inserted, i, CompareFlags{true, true})) {
-      return false;
-    }
-  } while (++i < numKeys);
-  return true;
+  return keyComparator_->equals(group, inserted);
 }
 
 template <bool ignoreNullKeys>
@@ -418,6 +504,17 @@ namespace {
 // Group prefetch size for join build & probe.
 constexpr int32_t kPrefetchSize = 64;
 
+// Number of rows processed together by the unrolled probe loops.
+constexpr int32_t kProbeStride = 4;
+
+// Distance in rows between the stages of the software pipelined probe. See
+// HashTable::prefetchProbes().
+constexpr int32_t kProbePrefetchDistance = 8;
+
+// Minimum size in bytes of the tags and row pointers of a table for software
+// pipelining the probes. Smaller tables are likely to be in the cache.
+constexpr int64_t kMinPrefetchProbeTableBytes = 1 << 20;
+
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
 // normalized key affect the hash table index.
@@ -448,6 +545,39 @@ void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
 }
 } // namespace
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::shouldPrefetchProbes(int32_t numProbes) const {
+  return numProbes > kProbePrefetchDistance &&
+      sizeMask_ + 1 >= kMinPrefetchProbeTableBytes;
+}
+
+template <bool ignoreNullKeys>
+FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::prefetchProbes(
+    const HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t probeIndex,
+    int32_t numProbes,
+    int32_t firstKeyOffset) const {
+  const auto* hashes = lookup.hashes.data();
+  const int32_t bucketIndex = probeIndex + 2 * kProbePrefetchDistance;
+  const int32_t bucketEnd = std::min(bucketIndex + kProbeStride, numProbes);
+  for (auto i = bucketIndex; i < bucketEnd; ++i) {
+    __builtin_prefetch(
+        reinterpret_cast<const char*>(table_) + bucketOffset(hashes[rows[i]]));
+  }
+  const int32_t rowIndex = probeIndex + kProbePrefetchDistance;
+  const int32_t rowEnd = std::min(rowIndex + kProbeStride, numProbes);
+  for (auto i = rowIndex; i < rowEnd; ++i) {
+    const auto hash = hashes[rows[i]];
+    const auto offset = bucketOffset(hash);
+    const auto hits = simd::toBitMask(
+        loadTags(offset) == BaseHashTable::TagVector::broadcast(hashTag(hash)));
+    if (hits) {
+      __builtin_prefetch(row(offset, __builtin_ctz(hits)) + firstKeyOffset);
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupProbe(
     HashLookup& lookup,
@@ -473,7 +603,11 @@ void HashTable<ignoreNullKeys>::groupProbe(
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   auto rows = lookup.rows.data();
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+  const bool prefetch = shouldPrefetchProbes(numProbes);
+  for (; probeIndex + kProbeStride <= numProbes; probeIndex += kProbeStride) {
+    if (prefetch) {
+      prefetchProbes(lookup, rows, probeIndex, numProbes, 0);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -512,7 +646,11 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   auto rows = lookup.rows.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+  const bool prefetch = shouldPrefetchProbes(numProbes);
+  for (; probeIndex + kProbeStride <= numProbes; probeIndex += kProbeStride) {
+    if (prefetch) {
+      prefetchProbes(lookup, rows, probeIndex, numProbes, kKeyOffset);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -602,12 +740,16 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = probeOrder(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+  const bool prefetch = shouldPrefetchProbes(numProbes);
+  for (; probeIndex + kProbeStride <= numProbes; probeIndex += kProbeStride) {
+    if (prefetch) {
+      prefetchProbes(lookup, rows, probeIndex, numProbes, 0);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -679,7 +821,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = probeOrder(lookup);
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
@@ -706,6 +848,39 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::probeOrder(
+    HashLookup& lookup) const {
+  const int32_t numRows = lookup.rows.size();
+  const int32_t clusterBits = lookup.radixClusterBits;
+  const int32_t numClusters = 1 << clusterBits;
+  // Each cluster must cover at least one bucket.
+  const int32_t shift = sizeBits_ - clusterBits;
+  if (clusterBits == 0 || sizeMask_ + 1 < kMinRadixClusterTableBytes ||
+      shift < __builtin_ctzll(kBucketSize) || numRows < numClusters) {
+    return lookup.rows.data();
+  }
+
+  // Counting sort of the rows by the high bits of their bucket offset.
+  const auto* rows = lookup.rows.data();
+  const auto* hashes = lookup.hashes.data();
+  auto& offsets = lookup.clusterOffsets;
+  offsets.assign(numClusters + 1, 0);
+  for (auto i = 0; i < numRows; ++i) {
+    ++offsets[1 + (bucketOffset(hashes[rows[i]]) >> shift)];
+  }
+  for (auto i = 1; i <= numClusters; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.clusteredRows.resize(numRows);
+  auto* clusteredRows = lookup.clusteredRows.data();
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = rows[i];
+    clusteredRows[offsets[bucketOffset(hashes[row]) >> shift]++] = row;
+  }
+  return clusteredRows;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(
     uint64_t size,
@@ -2200,8 +2375,8 @@ void HashTable<ignoreNullKeys>::prepareForGroupProbe(
   auto& hashers = lookup.hashers;
 
   for (auto& hasher : hashers) {
-    auto key = input->childAt(hasher->channel())->loadedVector();
-    hasher->decode(*key, rows);
+    hasher->decode(
+        input->childAt(hasher->channel()), rows, lookup.decodedVectorCache);
   }
 
   if constexpr (ignoreNullKeys) {
@@ -2219,6 +2394,25 @@ void HashTable<ignoreNullKeys>::prepareForGroupProbe(
       if (!hasher->computeValueIds(rows, lookup.hashes)) {
         rehash = true;
       }
+    } else if (lookup.decodedVectorCache != nullptr) {
+      // The hashes of a column are the same for all the tables keyed on it,
+      // so they are computed once for the operators of the driver and mixed
+      // here.
+      const auto& columnHashes = lookup.decodedVectorCache->hashes(
+          input->childAt(hasher->channel()),
+          rows,
+          [&](raw_vector<uint64_t>& hashes) {
+            hasher->hash(rows, false, hashes);
+          });
+      if (i == 0) {
+        rows.applyToSelected(
+            [&](auto row) { lookup.hashes[row] = columnHashes[row]; });
+      } else {
+        rows.applyToSelected([&](auto row) {
+          lookup.hashes[row] =
+              bits::hashMix(lookup.hashes[row], columnHashes[row]);
+        });
+      }
     } else {
       hasher->hash(rows, i > 0, lookup.hashes);
     }
@@ -15,8 +15,12 @@
  */
 #pragma once
 
+#include <mutex>
+
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/CompiledKeyComparator.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -71,6 +75,10 @@ struct HashLookup {
   /// Scratch memory used to call VectorHasher::lookupValueIds.
   VectorHasher::ScratchMemory scratchMemory;
 
+  /// If set, the group probe keys are decoded through this cache. See
+  /// DecodedVectorCache.
+  DecodedVectorCache* decodedVectorCache{nullptr};
+
   /// Input to groupProbe and joinProbe APIs.
 
   /// Set of row numbers of row to probe.
@@ -95,6 +103,17 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// If non-zero, joinProbe on a hash table larger than
+  /// BaseHashTable::kMinRadixClusterTableBytes radix clusters 'rows' into
+  /// 2^radixClusterBits groups by the high bits of their bucket offset and
+  /// probes one group at a time. Each group then touches a contiguous,
+  /// cache-sized range of the table. Does not change 'rows' or the results.
+  int32_t radixClusterBits{0};
+
+  /// Scratch memory for the radix clustered probe order.
+  raw_vector<vector_size_t> clusteredRows;
+  std::vector<int32_t> clusterOffsets;
 };
 
 struct HashTableStats {
@@ -133,6 +152,11 @@ class BaseHashTable {
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
 
+  /// The minimum size in bytes of the tags and row pointers of a hash table
+  /// for joinProbe to radix cluster probe rows. Smaller tables mostly fit in
+  /// the CPU cache and do not benefit. See HashLookup::radixClusterBits.
+  static constexpr int64_t kMinRadixClusterTableBytes = 16 << 20;
+
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
 
@@ -361,6 +385,18 @@ class BaseHashTable {
   /// join use.
   virtual std::vector<RowContainer*> allRows() const = 0;
 
+  /// Returns a Bloom filter over the hashes of the keys of all the rows of a
+  /// join table in kHash mode. These are the hashes in HashLookup::hashes
+  /// after prepareForJoinProbe(). Built on first use. Thread-safe.
+  const BloomFilter<>& keyHashBloomFilter();
+
+  /// Returns a Bloom filter over the values of the integer join key
+  /// 'keyIndex' of all the rows of a join table, or nullptr if the key is not
+  /// an integer or all its values are null. Nulls do not pass. Built on first
+  /// use with memory from the pool of the table, which must outlive the
+  /// clones of the filter. Thread-safe.
+  const common::Filter* keyValuesBloomFilter(column_index_t keyIndex);
+
   /// Static functions for processing internals. Public because used in
   /// structs that define probe and insert algorithms.
 
@@ -424,6 +460,15 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+ private:
+  std::once_flag keyHashBloomFilterOnce_;
+  BloomFilter<> keyHashBloomFilter_;
+
+  std::mutex keyValuesBloomFiltersMutex_;
+  // The filters made by keyValuesBloomFilter(), keyed by key index.
+  std::unordered_map<column_index_t, std::unique_ptr<common::Filter>>
+      keyValuesBloomFilters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -449,6 +494,8 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  /// 'coldPayloadMinBytes' is passed to the RowContainer of a join build side.
+  /// See RowContainer.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -457,7 +504,8 @@ class HashTable : public BaseHashTable {
       bool isJoinBuild,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      int32_t coldPayloadMinBytes = 0);
 
   ~HashTable() override = default;
 
@@ -482,7 +530,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      int32_t coldPayloadMinBytes = 0) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -491,7 +540,8 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        coldPayloadMinBytes);
   }
 
   void groupProbe(HashLookup& lookup, int8_t spillInputStartPartitionBit)
@@ -651,6 +701,17 @@ class HashTable : public BaseHashTable {
       folly::Range<char* const*> rows,
       int32_t columnIndex,
       const VectorPtr& result) override {
+    if (rows_->isColdColumn(columnIndex)) {
+      // The cold records of the rows of 'otherTables_' have the same layout.
+      rows_->extractColdColumn(
+          rows.data(),
+          rows.size(),
+          columnIndex,
+          columnHasNulls_[columnIndex],
+          0,
+          result);
+      return;
+    }
     RowContainer::extractColumn(
         rows.data(),
         rows.size(),
@@ -881,6 +942,24 @@ class HashTable : public BaseHashTable {
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
+  // Returns true if the probes of 'numProbes' rows should be software
+  // pipelined with prefetchProbes(). This is the case for tables which do not
+  // fit in the CPU cache.
+  bool shouldPrefetchProbes(int32_t numProbes) const;
+
+  // Software pipelines the probe of 'rows' in kHash and kNormalizedKey modes.
+  // Called before probing the rows at ['probeIndex', 'probeIndex' + 4).
+  // Prefetches the buckets of the rows 2 * 'kProbePrefetchDistance' ahead.
+  // For the rows 'kProbePrefetchDistance' ahead, whose buckets are expected to
+  // be in the cache, compares the tags and prefetches the first candidate row
+  // at 'firstKeyOffset'.
+  void prefetchProbes(
+      const HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t probeIndex,
+      int32_t numProbes,
+      int32_t firstKeyOffset) const;
+
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
@@ -890,6 +969,12 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns the order in which to probe 'lookup.rows' in joinProbe. This is
+  // 'lookup.rows' radix clustered by bucket offset into
+  // 'lookup.clusteredRows' if 'lookup.radixClusterBits' is set and the table
+  // is large enough to benefit, otherwise 'lookup.rows' unchanged.
+  const vector_size_t* probeOrder(HashLookup& lookup) const;
+
   // Returns the total size of the variable size 'columns' in 'row'.
   // NOTE: No checks are done in the method for performance considerations.
   // Caller needs to make sure only variable size columns are inside of
@@ -1029,6 +1114,11 @@ class HashTable : public BaseHashTable {
 
   // Offset of next row link for join build side set from 'rows_'.
   int32_t nextOffset_{0};
+
+  // Compares the keys of 'rows_' with probe rows and with rows of 'rows_' or
+  // 'otherTables_', which have the same layout.
+  std::unique_ptr<CompiledKeyComparator> keyComparator_;
+
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  if (buffers == nullptr || buffers->getBufferIfExists(taskId) == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<InProcessExchangeSource::Response>
+InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "OutputBufferManager was already destructed");
+  VELOX_CHECK(requestPending_);
+
+  auto pending = std::make_shared<PendingRequest>();
+  auto future = pending->promise.getSemiFuture();
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    pending_ = pending;
+    requestedSequence = sequence_;
+  }
+
+  // The callback may outlive 'this' in the output buffer, so it holds a
+  // reference to the source.
+  auto self = std::static_pointer_cast<InProcessExchangeSource>(
+      shared_from_this());
+  const bool found = buffers->getData(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, pending, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->processData(
+            pending,
+            requestedSequence,
+            std::move(data),
+            sequence,
+            std::move(remainingBytes));
+      });
+  if (!found) {
+    queue_->setError(
+        fmt::format("Output buffers of task {} are not found", taskId_));
+    completePending();
+    return future;
+  }
+
+  // Replies without data if there is no data within 'maxWait'. The data which
+  // arrives after that stays in the output buffer for the next request.
+  std::weak_ptr<ExchangeSource> weakSelf = self;
+  folly::futures::sleep(maxWait)
+      .via(&folly::QueuedImmediateExecutor::instance())
+      .thenValue([weakSelf, pending](auto&&) {
+        if (pending->completed.exchange(true)) {
+          return;
+        }
+        bool atEnd{false};
+        if (auto source = std::static_pointer_cast<InProcessExchangeSource>(
+                weakSelf.lock())) {
+          std::lock_guard<std::mutex> l(source->queue_->mutex());
+          source->requestPending_ = false;
+          atEnd = source->atEnd_;
+          if (source->pending_ == pending) {
+            source->pending_ = nullptr;
+          }
+        }
+        pending->promise.setValue(Response{0, atEnd, {}});
+      });
+  return future;
+}
+
+void InProcessExchangeSource::processData(
+    const std::shared_ptr<PendingRequest>& pending,
+    int64_t requestedSequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (pending->completed.exchange(true)) {
+    // Timed out or closed. The data is fetched again by the next request.
+    return;
+  }
+  if (requestedSequence > sequence && !data.empty()) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+  if (data.empty()) {
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd{false};
+  int64_t totalBytes{0};
+  for (auto& buffer : data) {
+    if (buffer == nullptr) {
+      // There can be more than one end marker.
+      atEnd = true;
+      continue;
+    }
+    totalBytes += buffer->computeChainDataLength();
+    // The IOBuf shares the memory of the producer's page without a copy.
+    pages.push_back(std::make_unique<SerializedPage>(std::move(buffer)));
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    if (pending_ == pending) {
+      pending_ = nullptr;
+    }
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    if (!data.empty()) {
+      sequence_ = sequence + pages.size();
+    }
+  }
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+
+  if (atEnd) {
+    if (auto buffers = OutputBufferManager::getInstance().lock()) {
+      buffers->deleteResults(taskId_, destination_);
+    }
+  }
+  pending->promise.setValue(
+      Response{totalBytes, atEnd, std::move(remainingBytes)});
+}
+
+void InProcessExchangeSource::pause() {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "OutputBufferManager was already destructed");
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    ackSequence = sequence_;
+  }
+  buffers->acknowledge(taskId_, destination_, ackSequence);
+}
+
+void InProcessExchangeSource::completePending() {
+  std::shared_ptr<PendingRequest> pending;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    pending = std::move(pending_);
+  }
+  if (pending != nullptr && !pending->completed.exchange(true)) {
+    pending->promise.setValue(Response{0, false, {}});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  completePending();
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
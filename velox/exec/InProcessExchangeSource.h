@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource for a producer task which runs in the same process as the
+/// consumer. Reads the pages directly from the OutputBufferManager of the
+/// process instead of going over the network. The IOBufs of the pages are
+/// shared with the producer's output buffer, so the data is not copied
+/// between the tasks. The memory of the pages stays accounted to the
+/// producer task until the consumer releases them.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// ExchangeSource::Factory which returns an InProcessExchangeSource if the
+  /// output buffers of 'taskId' are in the OutputBufferManager of this
+  /// process and nullptr otherwise. The producer task must be created before
+  /// the consumer adds its task id. Registered ahead of the remote factories
+  /// to short-circuit the exchange between co-located tasks.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void pause() override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // The state of one request. Completed by whichever of the data callback of
+  // the OutputBufferManager and the timeout comes first.
+  struct PendingRequest {
+    VeloxPromise<Response> promise{
+        VeloxPromise<Response>("InProcessExchangeSource::request")};
+    std::atomic<bool> completed{false};
+  };
+
+  // Adds 'data' fetched for 'requestedSequence' to 'queue_' and completes
+  // 'pending'.
+  void processData(
+      const std::shared_ptr<PendingRequest>& pending,
+      int64_t requestedSequence,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Completes the pending request, if any, without data.
+  void completePending();
+
+  std::shared_ptr<PendingRequest> pending_;
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
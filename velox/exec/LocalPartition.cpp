@@ -29,49 +29,55 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    // A consumer has freed memory since the increase.
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
-  std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return {};
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ >= maxBufferSize_) {
+    return {};
   }
-  return promises;
+  hasPromises_ = false;
+  return std::move(promises_);
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
+      hasConsumerPromises_ = false;
       consumerPromises = std::move(consumerPromises_);
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -79,27 +85,22 @@ BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     int64_t inputBytes,
     ContinueFuture* future) {
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.emplace(std::move(input), inputBytes);
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
-    return false;
-  });
-
-  if (isClosed) {
+  if (closed_) {
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
+  queue_.enqueue({std::move(input), inputBytes});
+
+  if (closed_) {
+    // close() may have drained the queue before the data was added.
+    auto memoryPromises = drain();
+    notify(memoryPromises);
+  } else {
+    auto consumerPromises = takeConsumerPromises();
+    notify(consumerPromises);
+  }
 
   if (blockedOnConsumer) {
     return BlockingReason::kWaitForConsumer;
@@ -108,15 +109,29 @@ BlockingReason LocalExchangeQueue::enqueue(
   return BlockingReason::kNotBlocked;
 }
 
+std::vector<ContinuePromise> LocalExchangeQueue::takeConsumerPromises() {
+  // Orders the load of 'hasConsumerPromises_' after adding the data. Pairs
+  // with the fence in next().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!hasConsumerPromises_) {
+    return {};
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  hasConsumerPromises_ = false;
+  return std::move(consumerPromises_);
+}
+
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
+      hasConsumerPromises_ = false;
       consumerPromises = std::move(consumerPromises_);
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -124,11 +139,21 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  if (closed_) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  std::pair<RowVectorPtr, int64_t> entry;
+  if (!queue_.try_dequeue(entry)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    hasConsumerPromises_ = true;
+    // Orders the re-check of 'queue_' after setting 'hasConsumerPromises_'.
+    // Pairs with the fence in takeConsumerPromises().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!queue_.try_dequeue(entry)) {
+      if (isFinishedLocked()) {
+        hasConsumerPromises_ = !consumerPromises_.empty();
         return BlockingReason::kNotBlocked;
       }
 
@@ -137,25 +162,21 @@ BlockingReason LocalExchangeQueue::next(
 
       return BlockingReason::kWaitForProducer;
     }
+    hasConsumerPromises_ = !consumerPromises_.empty();
+  }
 
-    int64_t size;
-    std::tie(*data, size) = queue.front();
-    queue.pop();
-
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
-
-    return BlockingReason::kNotBlocked;
-  });
+  *data = std::move(entry.first);
+  auto memoryPromises = memoryManager_->decreaseMemoryUsage(entry.second);
   notify(memoryPromises);
-  return blockingReason;
+  return BlockingReason::kNotBlocked;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
+bool LocalExchangeQueue::isFinishedLocked() const {
   if (closed_) {
     return true;
   }
 
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
+  if (noMoreProducers_ && pendingProducers_ == 0 && queue_.empty()) {
     return true;
   }
 
@@ -163,26 +184,33 @@ bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  std::lock_guard<std::mutex> l(mutex_);
+  return isFinishedLocked();
+}
+
+std::vector<ContinuePromise> LocalExchangeQueue::drain() {
+  int64_t freedBytes = 0;
+  std::pair<RowVectorPtr, int64_t> entry;
+  while (queue_.try_dequeue(entry)) {
+    freedBytes += entry.second;
+  }
+  if (freedBytes == 0) {
+    return {};
+  }
+  return memoryManager_->decreaseMemoryUsage(freedBytes);
 }
 
 void LocalExchangeQueue::close() {
+  // Set before draining so that a concurrent enqueue() either sees 'closed_'
+  // or its data is drained here.
+  closed_ = true;
+  auto memoryPromises = drain();
   std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front().second;
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    hasConsumerPromises_ = false;
     consumerPromises = std::move(consumerPromises_);
-    closed_ = true;
-  });
+  }
   notify(consumerPromises);
   notify(memoryPromises);
 }
@@ -15,13 +15,16 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without a lock. The mutex is only
+/// taken to block a producer or to wake up the blocked producers.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +41,12 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set under 'mutex_' before the
+  // blocking producer re-checks 'bufferedBytes_' so that a concurrent decrease
+  // either sees the flag or its decrease is seen by the producer.
+  std::atomic_bool hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -49,6 +56,11 @@ class LocalExchangeMemoryManager {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is passed through a lock-free queue. The mutex is only taken when
+/// a consumer finds the queue empty, to wake up the waiting consumers and to
+/// change the producer state. The number of buffered bytes is bounded by the
+/// LocalExchangeMemoryManager.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -90,20 +102,33 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  using Queue = std::queue<std::pair<RowVectorPtr, int64_t>>;
+  using Queue = folly::UMPMCQueue<
+      std::pair<RowVectorPtr, int64_t>,
+      /*MayBlock=*/false>;
+
+  bool isFinishedLocked() const;
 
-  bool isFinishedLocked(const Queue& queue) const;
+  // Returns 'consumerPromises_' to fulfill after data has been added.
+  std::vector<ContinuePromise> takeConsumerPromises();
+
+  // Drops the data in 'queue_' and returns the producer promises to fulfill.
+  std::vector<ContinuePromise> drain();
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<Queue> queue_;
+  Queue queue_;
+  std::mutex mutex_;
+  // True if 'consumerPromises_' may be non-empty. Set under 'mutex_' before a
+  // consumer re-checks 'queue_', so that a concurrent producer either sees the
+  // flag or its data is seen by the consumer.
+  std::atomic_bool hasConsumerPromises_{false};
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
   std::vector<ContinuePromise> consumerPromises_;
   int pendingProducers_{0};
   bool noMoreProducers_{false};
-  bool closed_{false};
+  std::atomic_bool closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 #include "velox/exec/LocalPlanner.h"
+
+#include <folly/container/F14Set.h>
+
 #include "velox/core/PlanFragment.h"
+#include "velox/exec/Aggregate.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
@@ -46,6 +50,9 @@
 #include "velox/exec/Unnest.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/Window.h"
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/SpecialFormRegistry.h"
+#include "velox/expression/VectorFunction.h"
 
 namespace facebook::velox::exec {
 
@@ -164,6 +171,567 @@ void plan(
   currentPlanNodes->push_back(planNode);
 }
 
+// Returns true if 'expr' returns the same result for the same input. Calls of
+// unknown functions are considered non-deterministic.
+bool isDeterministic(const core::TypedExprPtr& expr) {
+  if (auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr)) {
+    if (specialFormRegistry().getSpecialForm(call->name()) == nullptr) {
+      const auto simpleFunctionsMetadata =
+          simpleFunctions().getFunctionSignaturesAndMetadata(call->name());
+      const auto vectorFunctionMetadata =
+          getVectorFunctionMetadata(call->name());
+      if (simpleFunctionsMetadata.empty() &&
+          !vectorFunctionMetadata.has_value()) {
+        return false;
+      }
+      for (const auto& [metadata, _] : simpleFunctionsMetadata) {
+        if (!metadata.deterministic) {
+          return false;
+        }
+      }
+      if (vectorFunctionMetadata.has_value() &&
+          !vectorFunctionMetadata->deterministic) {
+        return false;
+      }
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isDeterministic(input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the input fields of 'expr' can be replaced by the
+// expressions in 'mapping'. The replaced expressions must be deterministic
+// since they may be evaluated more than once after the replacement. Lambdas
+// are not rewritten since their captures may clash with the replacements.
+bool canInline(
+    const core::TypedExprPtr& expr,
+    const std::unordered_map<std::string, core::TypedExprPtr>& mapping) {
+  if (std::dynamic_pointer_cast<const core::LambdaTypedExpr>(expr)) {
+    return false;
+  }
+  if (auto field =
+          std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr)) {
+    if (field->isInputColumn()) {
+      auto it = mapping.find(field->name());
+      if (it == mapping.end()) {
+        return true;
+      }
+      // A field of an InputTypedExpr can only be renamed.
+      if (!field->inputs().empty() &&
+          !std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+              it->second)) {
+        return false;
+      }
+      return isDeterministic(it->second);
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!canInline(input, mapping)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A chain of Filter and Project nodes fused into at most one filter followed
+// by one projection over the input of the chain.
+class FilterProjectChain {
+ public:
+  // Adds 'node' on top of the chain. Returns false if 'node' is not a Filter
+  // or Project or can't be fused.
+  bool add(const core::PlanNodePtr& node) {
+    auto filterNode = std::dynamic_pointer_cast<const core::FilterNode>(node);
+    auto projectNode = std::dynamic_pointer_cast<const core::ProjectNode>(node);
+    if (filterNode == nullptr && projectNode == nullptr) {
+      return false;
+    }
+    auto exprs = filterNode
+        ? std::vector<core::TypedExprPtr>{filterNode->filter()}
+        : projectNode->projections();
+    if (filterNode && filter_ && !isDeterministic(exprs[0])) {
+      // The conjuncts of an AND may be evaluated in any order.
+      return false;
+    }
+    if (!projectId_.empty()) {
+      std::unordered_map<std::string, core::TypedExprPtr> mapping;
+      for (auto i = 0; i < names_.size(); ++i) {
+        mapping[names_[i]] = projections_[i];
+      }
+      for (const auto& expr : exprs) {
+        if (!canInline(expr, mapping)) {
+          return false;
+        }
+      }
+      for (auto& expr : exprs) {
+        expr = expr->rewriteInputNames(mapping);
+      }
+    }
+
+    if (filterNode) {
+      if (filter_) {
+        filter_ = std::make_shared<core::CallTypedExpr>(
+            BOOLEAN(),
+            std::vector<core::TypedExprPtr>{filter_, exprs[0]},
+            "and");
+      } else {
+        filter_ = exprs[0];
+        filterId_ = filterNode->id();
+      }
+    } else {
+      names_ = projectNode->names();
+      projections_ = std::move(exprs);
+      projectId_ = projectNode->id();
+    }
+    ++numNodes_;
+    return true;
+  }
+
+  int32_t numNodes() const {
+    return numNodes_;
+  }
+
+  // Appends the fused nodes over 'source' to 'planNodes'.
+  void appendTo(
+      core::PlanNodePtr source,
+      std::vector<core::PlanNodePtr>& planNodes) const {
+    if (filter_) {
+      source = std::make_shared<core::FilterNode>(filterId_, filter_, source);
+      planNodes.push_back(source);
+    }
+    if (!projectId_.empty()) {
+      planNodes.push_back(std::make_shared<core::ProjectNode>(
+          projectId_, names_, projections_, source));
+    }
+  }
+
+ private:
+  int32_t numNodes_{0};
+  // The conjunction of the filters over the input of the chain.
+  core::TypedExprPtr filter_;
+  // The id of the first Filter node.
+  core::PlanNodeId filterId_;
+  // The output names and expressions over the input of the chain. Empty if
+  // the chain has no Project node.
+  std::vector<std::string> names_;
+  std::vector<core::TypedExprPtr> projections_;
+  // The id of the last Project node.
+  core::PlanNodeId projectId_;
+};
+
+std::vector<core::PlanNodePtr> fuseFilterProjectChains(
+    const std::vector<core::PlanNodePtr>& planNodes) {
+  std::vector<core::PlanNodePtr> fused;
+  fused.reserve(planNodes.size());
+  for (auto i = 0; i < planNodes.size();) {
+    FilterProjectChain chain;
+    auto end = i;
+    while (end < planNodes.size() && chain.add(planNodes[end])) {
+      ++end;
+    }
+    const bool isFilterProject = chain.numNodes() == 2 &&
+        std::dynamic_pointer_cast<const core::FilterNode>(planNodes[i]) &&
+        std::dynamic_pointer_cast<const core::ProjectNode>(planNodes[i + 1]);
+    if (chain.numNodes() < 2 || isFilterProject) {
+      // Nothing to fuse. A Filter followed by a Project is made into one
+      // FilterProject by createDriver().
+      end = std::max(end, i + 1);
+      fused.insert(fused.end(), planNodes.begin() + i, planNodes.begin() + end);
+    } else {
+      chain.appendTo(
+          fused.empty() ? planNodes[i]->sources()[0] : fused.back(), fused);
+    }
+    i = end;
+  }
+  return fused;
+}
+
+// Returns true if the inputs of 'expr' may be evaluated on a subset of its
+// rows or have their errors suppressed.
+bool isConditional(const core::ITypedExpr& expr) {
+  static const folly::F14FastSet<std::string> kConditionalForms = {
+      "if", "switch", "and", "or", "coalesce", "try"};
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  return call != nullptr && kConditionalForms.contains(call->name());
+}
+
+// Returns true if 'expr' is evaluated on all the rows of 'exprs', i.e. occurs
+// in 'exprs' or in the first input of their calls, recursively, outside of
+// lambdas and conditionals. The later inputs of a call are not evaluated on
+// the rows where an earlier input is null if the function has default null
+// behavior, so moving 'expr' out of them could raise errors for these rows.
+// Lambda parameters may shadow input fields.
+bool containsSubexpression(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const core::ITypedExpr& expr) {
+  for (const auto& candidate : exprs) {
+    if (*candidate == expr) {
+      return true;
+    }
+    if (!std::dynamic_pointer_cast<const core::LambdaTypedExpr>(candidate) &&
+        !isConditional(*candidate) && !candidate->inputs().empty() &&
+        containsSubexpression({candidate->inputs()[0]}, expr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Projections of a Project node which later nodes can reference instead of
+// recomputing them.
+class SharedProjections {
+ public:
+  // 'producer' is the Project node computing the shared projections.
+  // 'filter' is a Filter node right before it, if any, which is evaluated
+  // together with the projections in one FilterProject.
+  SharedProjections(
+      const core::ProjectNode& producer,
+      const core::FilterNode* filter)
+      : names_(producer.names()), projections_(producer.projections()) {
+    for (auto i = 0; i < names_.size(); ++i) {
+      mapping_[names_[i]] = projections_[i];
+    }
+    producerExprs_ = projections_;
+    if (filter) {
+      producerExprs_.push_back(filter->filter());
+    }
+  }
+
+  // Rewrites 'expr' over the output of the producer so that its calls which
+  // the producer computes anyway are references to the producer's outputs.
+  // Adds the calls which are not outputs yet to the outputs.
+  core::TypedExprPtr rewrite(const core::TypedExprPtr& expr) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    auto cast = std::dynamic_pointer_cast<const core::CastTypedExpr>(expr);
+    if (call == nullptr && cast == nullptr) {
+      return expr;
+    }
+    if (isDeterministic(expr) && canInline(expr, mapping_)) {
+      auto inlined = expr->rewriteInputNames(mapping_);
+      for (auto i = 0; i < projections_.size(); ++i) {
+        if (*projections_[i] == *inlined) {
+          ++numRewrites_;
+          return std::make_shared<core::FieldAccessTypedExpr>(
+              expr->type(), names_[i]);
+        }
+      }
+      if (containsSubexpression(producerExprs_, *inlined)) {
+        names_.push_back(newName());
+        projections_.push_back(inlined);
+        ++numRewrites_;
+        return std::make_shared<core::FieldAccessTypedExpr>(
+            expr->type(), names_.back());
+      }
+    }
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(expr->inputs().size());
+    bool changed = false;
+    for (const auto& input : expr->inputs()) {
+      inputs.push_back(rewrite(input));
+      changed |= inputs.back() != input;
+    }
+    if (!changed) {
+      return expr;
+    }
+    if (call) {
+      return std::make_shared<core::CallTypedExpr>(
+          call->type(), std::move(inputs), call->name());
+    }
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+
+  // Returns the number of sub-expressions replaced by rewrite().
+  int32_t numRewrites() const {
+    return numRewrites_;
+  }
+
+  const std::vector<std::string>& names() const {
+    return names_;
+  }
+
+  const std::vector<core::TypedExprPtr>& projections() const {
+    return projections_;
+  }
+
+ private:
+  std::string newName() const {
+    for (auto i = names_.size();; ++i) {
+      auto name = fmt::format("__shared{}", i);
+      if (mapping_.count(name) == 0 &&
+          std::find(names_.begin(), names_.end(), name) == names_.end()) {
+        return name;
+      }
+    }
+  }
+
+  std::vector<std::string> names_;
+  std::vector<core::TypedExprPtr> projections_;
+  // The original outputs of the producer by name.
+  std::unordered_map<std::string, core::TypedExprPtr> mapping_;
+  // The expressions evaluated by the producer.
+  std::vector<core::TypedExprPtr> producerExprs_;
+  int32_t numRewrites_{0};
+};
+
+// Returns a copy of 'node' over 'source' if 'node' is a Filter, Limit, TopN or
+// OrderBy node, whose output columns are the columns of their source. Returns
+// nullptr for other nodes.
+core::PlanNodePtr copyPassThroughNode(
+    const core::PlanNode& node,
+    const core::PlanNodePtr& source) {
+  if (auto* filter = dynamic_cast<const core::FilterNode*>(&node)) {
+    return std::make_shared<core::FilterNode>(
+        filter->id(), filter->filter(), source);
+  }
+  if (auto* limit = dynamic_cast<const core::LimitNode*>(&node)) {
+    return std::make_shared<core::LimitNode>(
+        limit->id(),
+        limit->offset(),
+        limit->count(),
+        limit->isPartial(),
+        source);
+  }
+  if (auto* topN = dynamic_cast<const core::TopNNode*>(&node)) {
+    return std::make_shared<core::TopNNode>(
+        topN->id(),
+        topN->sortingKeys(),
+        topN->sortingOrders(),
+        topN->count(),
+        topN->isPartial(),
+        source);
+  }
+  if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(&node)) {
+    return std::make_shared<core::OrderByNode>(
+        orderBy->id(),
+        orderBy->sortingKeys(),
+        orderBy->sortingOrders(),
+        orderBy->isPartial(),
+        source);
+  }
+  return nullptr;
+}
+
+std::vector<core::PlanNodePtr> shareSubexpressionsAcrossNodes(
+    const std::vector<core::PlanNodePtr>& planNodes) {
+  std::vector<core::PlanNodePtr> result = planNodes;
+  for (auto i = 0; i < result.size(); ++i) {
+    auto producer =
+        std::dynamic_pointer_cast<const core::ProjectNode>(result[i]);
+    if (producer == nullptr) {
+      continue;
+    }
+    // Finds the next Project node separated from 'producer' only by nodes
+    // which pass the columns of 'producer' through.
+    auto end = i + 1;
+    while (end < result.size() &&
+           !std::dynamic_pointer_cast<const core::ProjectNode>(result[end]) &&
+           copyPassThroughNode(*result[end], result[end - 1]) != nullptr) {
+      ++end;
+    }
+    if (end == result.size() ||
+        !std::dynamic_pointer_cast<const core::ProjectNode>(result[end])) {
+      continue;
+    }
+    SharedProjections shared(
+        *producer,
+        i > 0 ? dynamic_cast<const core::FilterNode*>(result[i - 1].get())
+              : nullptr);
+    auto consumer = std::dynamic_pointer_cast<const core::ProjectNode>(
+        result[end]);
+    std::vector<core::TypedExprPtr> consumerProjections;
+    for (const auto& projection : consumer->projections()) {
+      consumerProjections.push_back(shared.rewrite(projection));
+    }
+    std::vector<core::TypedExprPtr> filters;
+    for (auto k = i + 1; k < end; ++k) {
+      if (auto* filter =
+              dynamic_cast<const core::FilterNode*>(result[k].get())) {
+        filters.push_back(shared.rewrite(filter->filter()));
+      }
+    }
+    if (shared.numRewrites() == 0) {
+      continue;
+    }
+
+    // Recreates the nodes from 'producer' to 'consumer' over the new outputs
+    // of 'producer'. 'consumer' drops the new outputs.
+    result[i] = std::make_shared<core::ProjectNode>(
+        producer->id(),
+        shared.names(),
+        shared.projections(),
+        producer->sources()[0]);
+    auto filterIt = filters.begin();
+    for (auto k = i + 1; k < end; ++k) {
+      if (auto* filter =
+              dynamic_cast<const core::FilterNode*>(result[k].get())) {
+        result[k] = std::make_shared<core::FilterNode>(
+            filter->id(), *filterIt++, result[k - 1]);
+      } else {
+        result[k] = copyPassThroughNode(*result[k], result[k - 1]);
+      }
+    }
+    result[end] = std::make_shared<core::ProjectNode>(
+        consumer->id(),
+        consumer->names(),
+        std::move(consumerProjections),
+        result[end - 1]);
+  }
+  return result;
+}
+
+namespace {
+// Returns true if the aggregates of 'aggregation' can be computed from
+// partial aggregates over the distinct inputs of the grouping keys of
+// 'groupId'.
+bool canPreAggregate(
+    const core::GroupIdNode& groupId,
+    const core::AggregationNode& aggregation) {
+  if (aggregation.step() != core::AggregationNode::Step::kSingle &&
+      aggregation.step() != core::AggregationNode::Step::kPartial) {
+    return false;
+  }
+  if (!aggregation.preGroupedKeys().empty() ||
+      aggregation.aggregates().empty()) {
+    return false;
+  }
+  folly::F14FastSet<std::string> keys;
+  for (const auto& info : groupId.groupingKeyInfos()) {
+    keys.insert(info.output);
+  }
+  keys.insert(groupId.groupIdName());
+  if (aggregation.groupingKeys().size() != keys.size()) {
+    return false;
+  }
+  for (const auto& key : aggregation.groupingKeys()) {
+    if (!keys.contains(key->name())) {
+      return false;
+    }
+  }
+
+  folly::F14FastSet<std::string> aggregationInputs;
+  for (const auto& input : groupId.aggregationInputs()) {
+    aggregationInputs.insert(input->name());
+  }
+  folly::F14FastSet<std::string> keyInputs;
+  for (const auto& info : groupId.groupingKeyInfos()) {
+    keyInputs.insert(info.input->name());
+  }
+  for (auto i = 0; i < aggregation.aggregates().size(); ++i) {
+    const auto& aggregate = aggregation.aggregates()[i];
+    if (aggregate.mask != nullptr || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field = core::TypedExprs::asFieldAccess(input)) {
+        if (!aggregationInputs.contains(field->name())) {
+          return false;
+        }
+      } else if (!core::TypedExprs::isConstant(input)) {
+        return false;
+      }
+    }
+    if (keyInputs.contains(aggregation.aggregateNames()[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+std::vector<core::PlanNodePtr> preAggregateGroupingSets(
+    const std::vector<core::PlanNodePtr>& planNodes) {
+  std::vector<core::PlanNodePtr> result;
+  result.reserve(planNodes.size() + 1);
+  for (auto i = 0; i < planNodes.size(); ++i) {
+    auto groupId =
+        std::dynamic_pointer_cast<const core::GroupIdNode>(planNodes[i]);
+    auto aggregation = i + 1 < planNodes.size()
+        ? std::dynamic_pointer_cast<const core::AggregationNode>(
+              planNodes[i + 1])
+        : nullptr;
+    if (groupId == nullptr || aggregation == nullptr ||
+        !canPreAggregate(*groupId, *aggregation)) {
+      result.push_back(planNodes[i]);
+      continue;
+    }
+
+    // Partially aggregates the input on the distinct grouping key columns,
+    // i.e. on the finest grouping set. GroupId replicates these partial
+    // aggregates instead of the input rows and the aggregation merges them
+    // for each grouping set.
+    const auto& source = groupId->sources()[0];
+    std::vector<core::FieldAccessTypedExprPtr> preAggregationKeys;
+    folly::F14FastSet<std::string> keyNames;
+    for (const auto& info : groupId->groupingKeyInfos()) {
+      if (keyNames.insert(info.input->name()).second) {
+        preAggregationKeys.push_back(info.input);
+      }
+    }
+    std::vector<core::AggregationNode::Aggregate> preAggregates;
+    std::vector<core::AggregationNode::Aggregate> finalAggregates;
+    std::vector<core::FieldAccessTypedExprPtr> intermediateInputs;
+    const auto& names = aggregation->aggregateNames();
+    for (auto j = 0; j < aggregation->aggregates().size(); ++j) {
+      const auto& aggregate = aggregation->aggregates()[j];
+      const auto& call = aggregate.call;
+      auto intermediateType =
+          Aggregate::intermediateType(call->name(), aggregate.rawInputTypes);
+      preAggregates.push_back(
+          {.call = std::make_shared<core::CallTypedExpr>(
+               intermediateType, call->inputs(), call->name()),
+           .rawInputTypes = aggregate.rawInputTypes});
+      auto intermediate = std::make_shared<core::FieldAccessTypedExpr>(
+          intermediateType, names[j]);
+      intermediateInputs.push_back(intermediate);
+      finalAggregates.push_back(
+          {.call = std::make_shared<core::CallTypedExpr>(
+               call->type(),
+               std::vector<core::TypedExprPtr>{intermediate},
+               call->name()),
+           .rawInputTypes = aggregate.rawInputTypes});
+    }
+
+    auto preAggregation = std::make_shared<core::AggregationNode>(
+        fmt::format("{}.preAggregation", groupId->id()),
+        core::AggregationNode::Step::kPartial,
+        preAggregationKeys,
+        std::vector<core::FieldAccessTypedExprPtr>{},
+        names,
+        std::move(preAggregates),
+        false,
+        source);
+    auto newGroupId = std::make_shared<core::GroupIdNode>(
+        groupId->id(),
+        groupId->groupingSets(),
+        groupId->groupingKeyInfos(),
+        std::move(intermediateInputs),
+        groupId->groupIdName(),
+        preAggregation);
+    result.push_back(preAggregation);
+    result.push_back(newGroupId);
+    result.push_back(std::make_shared<core::AggregationNode>(
+        aggregation->id(),
+        aggregation->step() == core::AggregationNode::Step::kSingle
+            ? core::AggregationNode::Step::kFinal
+            : core::AggregationNode::Step::kIntermediate,
+        aggregation->groupingKeys(),
+        aggregation->preGroupedKeys(),
+        names,
+        std::move(finalAggregates),
+        aggregation->globalGroupingSets(),
+        aggregation->groupId(),
+        aggregation->ignoreNullKeys(),
+        newGroupId));
+    ++i;
+  }
+  return result;
+}
+
 // Sometimes consumer limits the number of drivers its producer can run.
 uint32_t maxDriversForConsumer(
     const std::shared_ptr<const core::PlanNode>& node) {
@@ -311,6 +879,21 @@ void LocalPlanner::plan(
     } else {
       factory->numTotalDrivers = factory->numDrivers;
     }
+
+    if (queryConfig.filterProjectChainFusionEnabled()) {
+      factory->fusedPlanNodes =
+          detail::fuseFilterProjectChains(factory->planNodes);
+    }
+    if (queryConfig.crossNodeSubexpressionSharingEnabled()) {
+      factory->fusedPlanNodes = detail::shareSubexpressionsAcrossNodes(
+          factory->fusedPlanNodes.empty() ? factory->planNodes
+                                          : factory->fusedPlanNodes);
+    }
+    if (queryConfig.groupingSetsPreAggregationEnabled()) {
+      factory->fusedPlanNodes = detail::preAggregateGroupingSets(
+          factory->fusedPlanNodes.empty() ? factory->planNodes
+                                          : factory->fusedPlanNodes);
+    }
   }
 }
 
@@ -411,6 +994,71 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns the number of rows a Limit in the pipeline 'nodes' needs from the
+// source 'nodes[0]' if there are only projections between them.
+std::optional<uint64_t> sourceRowLimit(
+    const std::vector<core::PlanNodePtr>& nodes) {
+  for (auto i = 1; i < nodes.size(); ++i) {
+    if (auto* limit = dynamic_cast<const core::LimitNode*>(nodes[i].get())) {
+      if (limit->count() >
+          std::numeric_limits<int64_t>::max() - limit->offset()) {
+        return std::nullopt;
+      }
+      return limit->offset() + limit->count();
+    }
+    if (dynamic_cast<const core::ProjectNode*>(nodes[i].get()) == nullptr) {
+      return std::nullopt;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns true if the input of the partial aggregation 'node' comes from a
+// table scan, optionally through filters, whose splits are sorted by the
+// grouping keys in some order. The rows of each group are then adjacent
+// within a split, so a streaming aggregation produces the same partial
+// results as a hash aggregation in bounded memory. A group that spans
+// splits produces more than one partial result, which is fine for a partial
+// aggregation.
+bool isGroupedByTableScan(const core::AggregationNode& node) {
+  if (node.step() != core::AggregationNode::Step::kPartial ||
+      node.groupingKeys().empty() || !node.preGroupedKeys().empty() ||
+      node.ignoreNullKeys() || !node.globalGroupingSets().empty()) {
+    return false;
+  }
+  const auto* source = node.sources()[0].get();
+  while (auto* filter = dynamic_cast<const core::FilterNode*>(source)) {
+    source = filter->sources()[0].get();
+  }
+  auto* scan = dynamic_cast<const core::TableScanNode*>(source);
+  if (scan == nullptr) {
+    return false;
+  }
+  const auto& sortedColumns = scan->tableHandle()->sortedColumns();
+  if (sortedColumns.size() < node.groupingKeys().size()) {
+    return false;
+  }
+
+  folly::F14FastSet<std::string> keys;
+  for (const auto& key : node.groupingKeys()) {
+    keys.insert(key->name());
+  }
+  // The first sorted columns must be the grouping keys.
+  for (auto i = 0; i < node.groupingKeys().size(); ++i) {
+    bool found = false;
+    for (const auto& [name, handle] : scan->assignments()) {
+      if (handle->name() == sortedColumns[i]) {
+        found = keys.erase(name) > 0;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return keys.empty();
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -420,17 +1068,18 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
   auto driver = std::shared_ptr<Driver>(new Driver());
   ctx->driver = driver.get();
   std::vector<std::unique_ptr<Operator>> operators;
-  operators.reserve(planNodes.size());
+  const auto& nodes = fusedPlanNodes.empty() ? planNodes : fusedPlanNodes;
+  operators.reserve(nodes.size());
 
-  for (int32_t i = 0; i < planNodes.size(); i++) {
+  for (int32_t i = 0; i < nodes.size(); i++) {
     // Id of the Operator being made. This is not the same as 'i'
     // because some PlanNodes may get fused.
     auto id = operators.size();
-    auto planNode = planNodes[i];
+    auto planNode = nodes[i];
     if (auto filterNode =
             std::dynamic_pointer_cast<const core::FilterNode>(planNode)) {
-      if (i < planNodes.size() - 1) {
-        auto next = planNodes[i + 1];
+      if (i < nodes.size() - 1) {
+        auto next = nodes[i + 1];
         if (auto projectNode =
                 std::dynamic_pointer_cast<const core::ProjectNode>(next)) {
           operators.push_back(std::make_unique<FilterProject>(
@@ -458,8 +1107,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<TableScan>(id, ctx.get(), tableScanNode));
+      auto tableScan =
+          std::make_unique<TableScan>(id, ctx.get(), tableScanNode);
+      if (i == 0) {
+        if (auto rowLimit = sourceRowLimit(nodes)) {
+          tableScan->setRowLimit(*rowLimit);
+        }
+      }
+      operators.push_back(std::move(tableScan));
     } else if (
         auto tableWriteNode =
             std::dynamic_pointer_cast<const core::TableWriteNode>(planNode)) {
@@ -503,7 +1158,8 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto aggregationNode =
             std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
-      if (aggregationNode->isPreGrouped()) {
+      if (aggregationNode->isPreGrouped() ||
+          isGroupedByTableScan(*aggregationNode)) {
         operators.push_back(std::make_unique<StreamingAggregation>(
             id, ctx.get(), aggregationNode));
       } else {
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryAdmissionController.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+bool isStateful(const core::PlanNode& node) {
+  if (auto* aggregation = dynamic_cast<const core::AggregationNode*>(&node)) {
+    return !aggregation->groupingKeys().empty();
+  }
+  return dynamic_cast<const core::HashJoinNode*>(&node) != nullptr ||
+      dynamic_cast<const core::NestedLoopJoinNode*>(&node) != nullptr ||
+      dynamic_cast<const core::OrderByNode*>(&node) != nullptr ||
+      dynamic_cast<const core::WindowNode*>(&node) != nullptr ||
+      dynamic_cast<const core::RowNumberNode*>(&node) != nullptr ||
+      dynamic_cast<const core::MarkDistinctNode*>(&node) != nullptr ||
+      dynamic_cast<const core::TopNRowNumberNode*>(&node) != nullptr;
+}
+
+// Admits up to the capacity of the memory manager in total and up to its free
+// memory for each query.
+common::AdmissionController::Config makeAdmissionConfig(
+    memory::MemoryManager* memoryManager) {
+  VELOX_CHECK_NOT_NULL(memoryManager);
+  common::AdmissionController::Config config;
+  config.maxLimit = memoryManager->capacity();
+  config.freeUnits = [memoryManager]() -> uint64_t {
+    const auto capacity = memoryManager->capacity();
+    return capacity - std::min(capacity, memoryManager->getTotalBytes());
+  };
+  return config;
+}
+} // namespace
+
+MemoryAdmissionController::MemoryAdmissionController(const Config& config)
+    : config_(config),
+      controller_(makeAdmissionConfig(config.memoryManager)) {
+  VELOX_CHECK_GT(config_.historyWeight, 0);
+  VELOX_CHECK_LE(config_.historyWeight, 1);
+  VELOX_CHECK_GE(config_.headroom, 1);
+}
+
+// static
+uint64_t MemoryAdmissionController::fingerprint(const core::PlanNode& plan) {
+  uint64_t hash = std::hash<std::string_view>()(plan.name());
+  hash = bits::hashMix(
+      hash, std::hash<std::string>()(plan.outputType()->toString()));
+  for (const auto& source : plan.sources()) {
+    hash = bits::hashMix(hash, fingerprint(*source));
+  }
+  return hash;
+}
+
+uint64_t MemoryAdmissionController::forecast(
+    const core::PlanNode& plan) const {
+  return forecast(fingerprint(plan), plan);
+}
+
+uint64_t MemoryAdmissionController::forecast(
+    uint64_t fingerprint,
+    const core::PlanNode& plan) const {
+  uint64_t bytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = history_.find(fingerprint);
+    bytes = it == history_.end() ? 0 : it->second * config_.headroom;
+  }
+  if (bytes == 0) {
+    bytes = shapeForecast(plan);
+  }
+  return std::min(bytes, capacity());
+}
+
+uint64_t MemoryAdmissionController::shapeForecast(
+    const core::PlanNode& plan) const {
+  uint64_t bytes = isStateful(plan) ? config_.statefulNodeBytes
+                                    : config_.nodeBytes;
+  for (const auto& source : plan.sources()) {
+    bytes += shapeForecast(*source);
+  }
+  return bytes;
+}
+
+uint64_t MemoryAdmissionController::capacity() const {
+  return config_.memoryManager->capacity();
+}
+
+MemoryAdmissionController::Admission MemoryAdmissionController::admit(
+    const core::PlanNode& plan) {
+  Admission admission;
+  admission.fingerprint = fingerprint(plan);
+  admission.bytes = forecast(admission.fingerprint, plan);
+  controller_.accept(admission.bytes);
+  return admission;
+}
+
+void MemoryAdmissionController::finish(
+    const Admission& admission,
+    uint64_t peakBytes) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = history_.find(admission.fingerprint);
+    if (it != history_.end()) {
+      it->second = config_.historyWeight * peakBytes +
+          (1 - config_.historyWeight) * it->second;
+    } else if (peakBytes > 0) {
+      if (history_.size() >= config_.maxHistorySize) {
+        history_.erase(history_.begin());
+      }
+      history_.emplace(admission.fingerprint, peakBytes);
+    }
+  }
+  controller_.release(admission.bytes);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/AdmissionController.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Admits queries by their forecast peak memory so that the queries running on
+/// a node fit into its memory. A query is admitted if the sum of the forecasts
+/// of the running queries including it is within the capacity of the
+/// MemoryManager and if its forecast is within the current free memory of the
+/// MemoryManager. Otherwise admit() blocks until enough queries finish.
+///
+/// The forecast of a plan is the peak memory recorded at completion of earlier
+/// queries with the same plan fingerprint, or an estimate from the plan shape
+/// if there is no history.
+class MemoryAdmissionController {
+ public:
+  struct Config {
+    /// The memory manager whose capacity and usage bound the admission.
+    memory::MemoryManager* memoryManager{nullptr};
+
+    /// The plan shape forecast of a plan node which holds no state, e.g. a
+    /// filter or a projection.
+    uint64_t nodeBytes{1 << 20};
+
+    /// The plan shape forecast of a plan node which accumulates its input,
+    /// e.g. a hash join, a grouped aggregation or an order by.
+    uint64_t statefulNodeBytes{128 << 20};
+
+    /// The weight of the latest observed peak in the history of a plan
+    /// fingerprint. The rest is the weight of the earlier peaks.
+    double historyWeight{0.5};
+
+    /// The factor applied to the historical peak of a plan fingerprint.
+    double headroom{1.2};
+
+    /// The maximum number of plan fingerprints with history.
+    size_t maxHistorySize{10'000};
+  };
+
+  /// An admitted query. Passed to finish() when the query completes.
+  struct Admission {
+    uint64_t fingerprint{0};
+    uint64_t bytes{0};
+  };
+
+  explicit MemoryAdmissionController(const Config& config);
+
+  /// Returns a hash of the plan node names and output types of 'plan'. Plans
+  /// which differ only in constants or plan node ids have the same
+  /// fingerprint.
+  static uint64_t fingerprint(const core::PlanNode& plan);
+
+  /// Returns the forecast peak memory of 'plan' in bytes, at most the capacity
+  /// of the memory manager.
+  uint64_t forecast(const core::PlanNode& plan) const;
+
+  /// Blocks until 'plan' can be admitted. The result must be passed to
+  /// finish() when the query completes.
+  Admission admit(const core::PlanNode& plan);
+
+  /// Releases 'admission' and records 'peakBytes', the peak memory of the
+  /// query, e.g. the peak of its root memory pool, in the history of its plan
+  /// fingerprint.
+  void finish(const Admission& admission, uint64_t peakBytes);
+
+  /// Admits the queued queries which fit into the free memory now, e.g. after
+  /// memory was freed outside of the admitted queries.
+  void admitQueued() {
+    controller_.admitQueued();
+  }
+
+  /// Returns the sum of the forecasts of the admitted queries.
+  uint64_t admittedBytes() const {
+    return controller_.currentResourceUsage();
+  }
+
+ private:
+  // Returns the plan shape forecast of 'plan'.
+  uint64_t shapeForecast(const core::PlanNode& plan) const;
+
+  uint64_t forecast(uint64_t fingerprint, const core::PlanNode& plan) const;
+
+  uint64_t capacity() const;
+
+  const Config config_;
+  common::AdmissionController controller_;
+
+  mutable std::mutex mutex_;
+  // The weighted peak memory of the completed queries by plan fingerprint.
+  folly::F14FastMap<uint64_t, uint64_t> history_;
+};
+
+} // namespace facebook::velox::exec
@@ -16,6 +16,8 @@
 
 #include "velox/exec/Merge.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/OrderBy.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -88,8 +90,9 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     return BlockingReason::kNotBlocked;
   }
 
-  // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  // No merging is needed if there is only one source or the sources are
+  // concatenated.
+  if (streams_.empty() && sources_.size() > 1 && !concatenateSources_) {
     initializeTreeOfLosers();
   }
 
@@ -117,18 +120,19 @@ RowVectorPtr Merge::getOutput() {
     return nullptr;
   }
 
-  // No merging is needed if there is only one source.
-  if (sources_.size() == 1) {
-    ContinueFuture future;
-    RowVectorPtr data;
-    auto reason = sources_[0]->next(data, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      sourceBlockingFutures_.emplace_back(std::move(future));
-      return nullptr;
-    }
+  // No merging is needed if there is only one source or the sources are
+  // concatenated.
+  if (sources_.size() == 1 || concatenateSources_) {
+    return getOutputInSourceOrder();
+  }
 
-    finished_ = data == nullptr;
-    return data;
+  if (stallStartNanos_ != 0) {
+    addRuntimeStat(
+        kSourceStallWallNanos,
+        RuntimeCounter(
+            getCurrentTimeNano() - stallStartNanos_,
+            RuntimeCounter::Unit::kNanos));
+    stallStartNanos_ = 0;
   }
 
   if (!output_) {
@@ -162,8 +166,12 @@ RowVectorPtr Merge::getOutput() {
 
     ++outputSize_;
 
-    // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    // Advance the stream. The stream is at the top of the tree, so its source
+    // gets the priority while the merge waits for it.
+    if (stream->pop(sourceBlockingFutures_)) {
+      prioritizeSource(stream->source());
+      stallStartNanos_ = getCurrentTimeNano();
+    }
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -181,6 +189,36 @@ RowVectorPtr Merge::getOutput() {
   }
 }
 
+RowVectorPtr Merge::getOutputInSourceOrder() {
+  for (;;) {
+    ContinueFuture future;
+    RowVectorPtr data;
+    auto reason = sources_[currentSource_]->next(data, &future);
+    if (reason != BlockingReason::kNotBlocked) {
+      sourceBlockingFutures_.emplace_back(std::move(future));
+      return nullptr;
+    }
+    if (data != nullptr) {
+      return data;
+    }
+    if (++currentSource_ == sources_.size()) {
+      finished_ = true;
+      return nullptr;
+    }
+  }
+}
+
+void Merge::prioritizeSource(MergeSource* source) {
+  if (prioritySourceMaxQueuedBytes_ == 0 || source == prioritySource_) {
+    return;
+  }
+  if (prioritySource_ != nullptr) {
+    prioritySource_->setMaxQueuedBytes(sourceMaxQueuedBytes_);
+  }
+  source->setMaxQueuedBytes(prioritySourceMaxQueuedBytes_);
+  prioritySource_ = source;
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
@@ -224,13 +262,24 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
     return;
   }
 
+  // The source rows are consecutive, so runs of consecutive output rows are
+  // copied as one range.
   vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
+  copyRanges_.clear();
+  outputRows_.applyToSelected([&](auto row) {
+    if (!copyRanges_.empty()) {
+      auto& range = copyRanges_.back();
+      if (range.targetIndex + range.count == row) {
+        ++range.count;
+        ++sourceRow;
+        return;
+      }
+    }
+    copyRanges_.push_back({sourceRow++, row, 1});
+  });
 
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), copyRanges_);
   }
 
   outputRows_.clearAll();
@@ -267,6 +316,28 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
   return false;
 }
 
+namespace {
+// Returns true if the sort order of 'localMerge' is a prefix of the sort order
+// of 'orderBy'.
+bool sameSortOrder(
+    const core::OrderByNode& orderBy,
+    const core::LocalMergeNode& localMerge) {
+  if (localMerge.sortingKeys().size() > orderBy.sortingKeys().size()) {
+    return false;
+  }
+  for (auto i = 0; i < localMerge.sortingKeys().size(); ++i) {
+    const auto& order = orderBy.sortingOrders()[i];
+    const auto& mergeOrder = localMerge.sortingOrders()[i];
+    if (!(*orderBy.sortingKeys()[i] == *localMerge.sortingKeys()[i]) ||
+        order.isAscending() != mergeOrder.isAscending() ||
+        order.isNullsFirst() != mergeOrder.isNullsFirst()) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -283,6 +354,17 @@ LocalMerge::LocalMerge(
       operatorCtx_->driverCtx()->driverId,
       0,
       "LocalMerge needs to run single-threaded");
+  // The drivers of a range partitioned OrderBy output consecutive ranges of
+  // the same sort order.
+  if (localMergeNode->sources().size() == 1) {
+    if (auto orderBy = std::dynamic_pointer_cast<const core::OrderByNode>(
+            localMergeNode->sources()[0])) {
+      concatenateSources_ =
+          OrderBy::isRangePartitioned(
+              *orderBy, operatorCtx_->driverCtx()->queryConfig()) &&
+          sameSortOrder(*orderBy, *localMergeNode);
+    }
+  }
 }
 
 BlockingReason LocalMerge::addMergeSources(ContinueFuture* /* future */) {
@@ -329,15 +411,28 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
       } else {
         noMoreSplits_ = true;
         if (!remoteSourceTaskIds_.empty()) {
-          const auto maxMergeExchangeBufferSize =
+          const int64_t maxMergeExchangeBufferSize =
               operatorCtx_->driverCtx()
                   ->queryConfig()
                   .maxMergeExchangeBufferSize();
-          const auto maxQueuedBytesPerSource = std::min<int64_t>(
-              std::max<int64_t>(
-                  maxMergeExchangeBufferSize / remoteSourceTaskIds_.size(),
-                  MergeSource::kMaxQueuedBytesLowerLimit),
+          const int64_t numSources = remoteSourceTaskIds_.size();
+          auto maxQueuedBytesPerSource = std::min<int64_t>(
+              maxMergeExchangeBufferSize / numSources,
               MergeSource::kMaxQueuedBytesUpperLimit);
+          if (maxQueuedBytesPerSource <
+              MergeSource::kMaxQueuedBytesLowerLimit) {
+            // Too many sources to give each the minimum. The sources share
+            // half of the budget and the source the merge waits for gets the
+            // other half, so that the total stays within the budget.
+            sourceMaxQueuedBytes_ = std::max<int64_t>(
+                maxMergeExchangeBufferSize / (2 * numSources),
+                ExchangeClient::kMinRequestWindowBytes);
+            prioritySourceMaxQueuedBytes_ = std::clamp<int64_t>(
+                maxMergeExchangeBufferSize / 2,
+                MergeSource::kMaxQueuedBytesLowerLimit,
+                MergeSource::kMaxQueuedBytesUpperLimit);
+            maxQueuedBytesPerSource = sourceMaxQueuedBytes_;
+          }
           for (uint32_t remoteSourceIndex = 0;
                remoteSourceIndex < remoteSourceTaskIds_.size();
                ++remoteSourceIndex) {
@@ -28,6 +28,11 @@ class SourceStream;
 // its inputs is blocked.
 class Merge : public SourceOperator {
  public:
+  /// Runtime stat with the time the merge waited for the source of its next
+  /// row after the batch of the source ran out.
+  static inline const std::string kSourceStallWallNanos{
+      "sourceStallWallNanos"};
+
   Merge(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -55,9 +60,27 @@ class Merge : public SourceOperator {
 
   std::vector<std::shared_ptr<MergeSource>> sources_;
 
+  /// True if every row of a source sorts after all rows of the previous
+  /// sources. The sources are then read one after another without merging.
+  bool concatenateSources_{false};
+
+  /// The number of bytes each source may buffer, and the larger number for the
+  /// source the merge waits for. 0 if the sources buffer a fixed number of
+  /// batches or if all the sources get the same budget.
+  int64_t sourceMaxQueuedBytes_{0};
+  int64_t prioritySourceMaxQueuedBytes_{0};
+
  private:
   void initializeTreeOfLosers();
 
+  /// Gives the priority budget to 'source' and the regular budget to the
+  /// source that had it before.
+  void prioritizeSource(MergeSource* source);
+
+  /// Returns the next batch of the sources in order. Used if there is one
+  /// source or 'concatenateSources_' is true.
+  RowVectorPtr getOutputInSourceOrder();
+
   /// Maximum number of rows in the output batch.
   const vector_size_t outputBatchSize_;
 
@@ -77,9 +100,19 @@ class Merge : public SourceOperator {
 
   bool finished_{false};
 
+  /// The source read by getOutputInSourceOrder().
+  size_t currentSource_{0};
+
   /// A list of blocking futures for sources. These are populates when a given
   /// source is blocked waiting for the next batch of data.
   std::vector<ContinueFuture> sourceBlockingFutures_;
+
+  /// The source with 'prioritySourceMaxQueuedBytes_'.
+  MergeSource* prioritySource_{nullptr};
+
+  /// The time the merge started waiting for a source in getOutput(). 0 if not
+  /// waiting.
+  uint64_t stallStartNanos_{0};
 };
 
 class SourceStream final : public MergeStream {
@@ -90,8 +123,7 @@ class SourceStream final : public MergeStream {
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+        outputRows_(outputBatchSize, false) {
     keyColumns_.reserve(sortingKeys.size());
   }
 
@@ -108,6 +140,10 @@ class SourceStream final : public MergeStream {
     return !atEnd_;
   }
 
+  MergeSource* source() const {
+    return source_;
+  }
+
   /// Returns true if current source row is less then current source row in
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
@@ -163,8 +199,8 @@ class SourceStream final : public MergeStream {
   /// Output row numbers for source rows that haven't been copied out yet.
   SelectivityVector outputRows_;
 
-  /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  /// Ranges of consecutive output rows to copy from 'data_'. Reusable memory.
+  std::vector<BaseVector::CopyRange> copyRanges_;
 };
 
 // LocalMerge merges its source's output into a single stream of
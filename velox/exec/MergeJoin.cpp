@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+
+#include <numeric>
+
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -379,6 +382,52 @@ void MergeJoin::addOutputRow(
   ++outputSize_;
 }
 
+vector_size_t MergeJoin::addOutputRowsForLeftRow(
+    const RowVectorPtr& left,
+    vector_size_t leftIndex,
+    const RowVectorPtr& right,
+    vector_size_t rightStart,
+    vector_size_t rightEnd) {
+  const auto numRows = std::min<vector_size_t>(
+      rightEnd - rightStart, outputBatchSize_ - outputSize_);
+  if (canAddIndicesOnly()) {
+    std::fill_n(rawLeftIndices_ + outputSize_, numRows, leftIndex);
+    std::iota(
+        rawRightIndices_ + outputSize_,
+        rawRightIndices_ + outputSize_ + numRows,
+        rightStart);
+    outputSize_ += numRows;
+    return numRows;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    addOutputRow(left, leftIndex, right, rightStart + i);
+  }
+  return numRows;
+}
+
+vector_size_t MergeJoin::addOutputRowsForRightRow(
+    const RowVectorPtr& left,
+    vector_size_t leftStart,
+    vector_size_t leftEnd,
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  const auto numRows = std::min<vector_size_t>(
+      leftEnd - leftStart, outputBatchSize_ - outputSize_);
+  if (canAddIndicesOnly()) {
+    std::iota(
+        rawLeftIndices_ + outputSize_,
+        rawLeftIndices_ + outputSize_ + numRows,
+        leftStart);
+    std::fill_n(rawRightIndices_ + outputSize_, numRows, rightIndex);
+    outputSize_ += numRows;
+    return numRows;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    addOutputRow(left, leftStart + i, right, rightIndex);
+  }
+  return numRows;
+}
+
 bool MergeJoin::prepareOutput(
     const RowVectorPtr& newLeft,
     const RowVectorPtr& right) {
@@ -565,7 +614,7 @@ bool MergeJoin::addToOutputForLeftJoin() {
           rightEnd = rightStart + 1;
         }
 
-        for (auto j = rightStart; j < rightEnd; ++j) {
+        for (auto j = rightStart; j < rightEnd;) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
@@ -576,7 +625,7 @@ bool MergeJoin::addToOutputForLeftJoin() {
             rightMatch_->setCursor(r, j);
             return true;
           }
-          addOutputRow(left, i, right, j);
+          j += addOutputRowsForLeftRow(left, i, right, j, rightEnd);
         }
       }
     }
@@ -643,7 +692,7 @@ bool MergeJoin::addToOutputForRightJoin() {
           leftEnd = leftStart + 1;
         }
 
-        for (auto j = leftStart; j < leftEnd; ++j) {
+        for (auto j = leftStart; j < leftEnd;) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
@@ -654,7 +703,7 @@ bool MergeJoin::addToOutputForRightJoin() {
             leftMatch_->setCursor(l, j);
             return true;
           }
-          addOutputRow(left, j, right, i);
+          j += addOutputRowsForRightRow(left, j, leftEnd, right, i);
         }
       }
     }
@@ -1128,12 +1177,20 @@ RowVectorPtr MergeJoin::doGetOutput() {
 RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
   const auto numRows = output->size();
 
-  RowVectorPtr fullOuterOutput = nullptr;
-
-  BufferPtr indices = allocateIndices(numRows, pool());
+  // A full outer join may add a row for each output row that misses.
+  const vector_size_t maxOutputRows =
+      isFullJoin(joinType_) ? 2 * numRows : numRows;
+  BufferPtr indices = allocateIndices(maxOutputRows, pool());
   auto rawIndices = indices->asMutable<vector_size_t>();
   vector_size_t numPassed = 0;
 
+  // Nulls for the left and right side columns of a full outer join. Set if
+  // at least one row missed.
+  BufferPtr leftNulls;
+  uint64_t* rawLeftNulls = nullptr;
+  BufferPtr rightNulls;
+  uint64_t* rawRightNulls = nullptr;
+
   if (joinTracker_) {
     const auto& filterRows = joinTracker_->matchingRows(numRows);
 
@@ -1148,68 +1205,45 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
     // the output with nulls for the right-side columns.
     auto onMiss = [&](auto row) {
       if (!isAntiJoin(joinType_)) {
-        rawIndices[numPassed++] = row;
-
         if (isFullJoin(joinType_)) {
-          // For filtered rows, it is necessary to insert additional data
-          // to ensure the result set is complete. Specifically, we
-          // need to generate two records: one record containing the
-          // columns from the left table along with nulls for the
-          // right table, and another record containing the columns
-          // from the right table along with nulls for the left table.
-          // For instance, the current output is filtered based on the condition
-          // t > 1.
-
+          // For a full outer join, a left-side row whose matches all failed
+          // the filter produces two rows: one with the columns from the left
+          // side and nulls for the right side, and another with the columns
+          // from the right side and nulls for the left side. For instance, if
+          // the filter is t > 1, this output
+          //
           // 1, 1
           // 2, 2
           // 3, 3
-
-          // In this scenario, we need to additionally insert a record 1, 1.
-          // Subsequently, we will set the values of the columns on the left to
-          // null and the values of the columns on the right to null as well. By
-          // doing so, we will obtain the final result set.
-
+          //
+          // becomes
+          //
           // 1,   null
           // null,  1
           // 2, 2
           // 3, 3
-          fullOuterOutput = BaseVector::create<RowVector>(
-              output->type(), output->size() + 1, pool());
-
-          for (auto i = 0; i < row + 1; i++) {
-            for (auto j = 0; j < output->type()->size(); j++) {
-              fullOuterOutput->childAt(j)->copy(
-                  output->childAt(j).get(), i, i, 1);
-            }
-          }
-
-          for (auto j = 0; j < output->type()->size(); j++) {
-            fullOuterOutput->childAt(j)->copy(
-                output->childAt(j).get(), row + 1, row, 1);
-          }
-
-          for (auto i = row + 1; i < output->size(); i++) {
-            for (auto j = 0; j < output->type()->size(); j++) {
-              fullOuterOutput->childAt(j)->copy(
-                  output->childAt(j).get(), i + 1, i, 1);
-            }
-          }
-
-          for (auto& projection : leftProjections_) {
-            auto target = fullOuterOutput->childAt(projection.outputChannel);
-            target->setNull(row, true);
-          }
-
-          for (auto& projection : rightProjections_) {
-            auto target = fullOuterOutput->childAt(projection.outputChannel);
-            target->setNull(row + 1, true);
+          //
+          // Both rows reference 'row' in 'output'. The nulls are added by the
+          // dictionaries that wrap the output columns, so that no values are
+          // copied.
+          if (leftNulls == nullptr) {
+            leftNulls = allocateNulls(maxOutputRows, pool());
+            rawLeftNulls = leftNulls->asMutable<uint64_t>();
+            rightNulls = allocateNulls(maxOutputRows, pool());
+            rawRightNulls = rightNulls->asMutable<uint64_t>();
           }
+          rawIndices[numPassed] = row;
+          bits::setNull(rawRightNulls, numPassed++);
+          rawIndices[numPassed] = row;
+          bits::setNull(rawLeftNulls, numPassed++);
         } else if (!isRightJoin(joinType_)) {
+          rawIndices[numPassed++] = row;
           for (auto& projection : rightProjections_) {
             auto target = output->childAt(projection.outputChannel);
             target->setNull(row, true);
           }
         } else {
+          rawIndices[numPassed++] = row;
           for (auto& projection : leftProjections_) {
             auto target = output->childAt(projection.outputChannel);
             target->setNull(row, true);
@@ -1282,19 +1316,32 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
     return nullptr;
   }
 
+  if (leftNulls != nullptr) {
+    std::vector<VectorPtr> children(output->childrenSize());
+    for (const auto& projection : leftProjections_) {
+      children[projection.outputChannel] = BaseVector::wrapInDictionary(
+          leftNulls,
+          indices,
+          numPassed,
+          output->childAt(projection.outputChannel));
+    }
+    for (const auto& projection : rightProjections_) {
+      children[projection.outputChannel] = BaseVector::wrapInDictionary(
+          rightNulls,
+          indices,
+          numPassed,
+          output->childAt(projection.outputChannel));
+    }
+    return std::make_shared<RowVector>(
+        pool(), output->type(), nullptr, numPassed, std::move(children));
+  }
+
   if (numPassed == numRows) {
     // All rows passed.
-    if (fullOuterOutput) {
-      return fullOuterOutput;
-    }
     return output;
   }
 
   // Some, but not all rows passed.
-  if (fullOuterOutput) {
-    return wrap(numPassed, indices, fullOuterOutput);
-  }
-
   return wrap(numPassed, indices, output);
 }
 
@@ -209,6 +209,34 @@ class MergeJoin : public Operator {
       const RowVectorPtr& right,
       vector_size_t rightIndex);
 
+  // Adds output rows for the left row at 'leftIndex' matching the right rows
+  // in [rightStart, rightEnd). Fills the dictionary indices of the whole run
+  // at once when the output only needs the indices. Otherwise, adds the rows
+  // one by one with addOutputRow(). Stops when output_ is full. Returns the
+  // number of rows added.
+  vector_size_t addOutputRowsForLeftRow(
+      const RowVectorPtr& left,
+      vector_size_t leftIndex,
+      const RowVectorPtr& right,
+      vector_size_t rightStart,
+      vector_size_t rightEnd);
+
+  // Same as addOutputRowsForLeftRow() for the right row at 'rightIndex'
+  // matching the left rows in [leftStart, leftEnd).
+  vector_size_t addOutputRowsForRightRow(
+      const RowVectorPtr& left,
+      vector_size_t leftStart,
+      vector_size_t leftEnd,
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
+  // Returns true if the rows of a match run can be added by filling the
+  // dictionary indices only. This is the case if there is no filter, no
+  // tracking of the matches and the right side projections are dictionaries.
+  bool canAddIndicesOnly() const {
+    return !filter_ && !joinTracker_ && !isRightFlattened_;
+  }
+
   // If the right side projected columns in the current output vector happen to
   // span more than one vector from the right side, they cannot be simply
   // wrapped in a dictionary and must be flattened.
@@ -182,6 +182,12 @@ class MergeExchangeSource : public MergeSource {
     return BlockingReason::kNotBlocked;
   }
 
+  void setMaxQueuedBytes(int64_t maxQueuedBytes) override {
+    if (client_) {
+      client_->setMaxQueuedBytes(maxQueuedBytes);
+    }
+  }
+
   void close() override {
     if (client_) {
       client_->close();
@@ -36,6 +36,10 @@ class MergeSource {
 
   virtual void close() = 0;
 
+  /// Changes the number of bytes the source may buffer ahead of the merge.
+  /// No-op for the sources which buffer a fixed number of batches.
+  virtual void setMaxQueuedBytes(int64_t /*maxQueuedBytes*/) {}
+
   // Factory methods to create MergeSources.
   static std::shared_ptr<MergeSource> createLocalMergeSource();
 
@@ -17,6 +17,174 @@
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
+namespace {
+
+// Returns true if the range of a column of 'type' can be found by sorting the
+// build side with BaseVector::compare. Floating point types are excluded
+// since the comparison functions and the vector order differ for NaN.
+bool isRangeType(const TypePtr& type) {
+  if (type->providesCustomComparison()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+const core::FieldAccessTypedExpr* asInputColumn(
+    const core::TypedExprPtr& expr) {
+  auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn()) {
+    return nullptr;
+  }
+  return field;
+}
+
+class RangeBuilder {
+ public:
+  RangeBuilder(const RowTypePtr& probeType, const RowTypePtr& buildType)
+      : probeType_(probeType), buildType_(buildType) {}
+
+  // Records the bound given by 'left <op> right' where 'op' is one of lt, lte,
+  // gt or gte if one side is a probe column and the other a build column.
+  void addComparison(
+      const std::string& op,
+      const core::TypedExprPtr& left,
+      const core::TypedExprPtr& right) {
+    auto* leftField = asInputColumn(left);
+    auto* rightField = asInputColumn(right);
+    if (leftField == nullptr || rightField == nullptr ||
+        !isRangeType(left->type()) ||
+        !left->type()->equivalent(*right->type())) {
+      return;
+    }
+    // True if the left side is at most the right side.
+    const bool leftIsLess = op == "lt" || op == "lte";
+    const bool inclusive = op == "lte" || op == "gte";
+    auto probe = probeType_->getChildIdxIfExists(rightField->name());
+    auto build = buildType_->getChildIdxIfExists(leftField->name());
+    bool upper = leftIsLess;
+    if (!probe.has_value() || !build.has_value()) {
+      probe = probeType_->getChildIdxIfExists(leftField->name());
+      build = buildType_->getChildIdxIfExists(rightField->name());
+      upper = !leftIsLess;
+    }
+    if (!probe.has_value() || !build.has_value()) {
+      return;
+    }
+    bounds_[build.value()].push_back({probe.value(), upper, inclusive});
+  }
+
+  // Returns the build column with bounds on both sides, or else the one with
+  // the most bounds.
+  std::optional<NestedLoopJoinRange> build() {
+    std::optional<NestedLoopJoinRange> best;
+    int32_t bestScore = 0;
+    for (auto& [channel, bounds] : bounds_) {
+      bool hasLower = false;
+      bool hasUpper = false;
+      for (const auto& bound : bounds) {
+        (bound.upper ? hasUpper : hasLower) = true;
+      }
+      const int32_t score = (hasLower && hasUpper ? 1'000 : 0) +
+          static_cast<int32_t>(bounds.size());
+      if (score > bestScore ||
+          (score == bestScore && channel < best->buildChannel)) {
+        bestScore = score;
+        best = NestedLoopJoinRange{channel, bounds};
+      }
+    }
+    return best;
+  }
+
+ private:
+  const RowTypePtr probeType_;
+  const RowTypePtr buildType_;
+  std::unordered_map<column_index_t, std::vector<NestedLoopJoinRange::Bound>>
+      bounds_;
+};
+} // namespace
+
+// static
+std::optional<NestedLoopJoinRange> NestedLoopJoinRange::create(
+    const core::NestedLoopJoinNode& joinNode,
+    const core::QueryConfig& config) {
+  if (!config.nestedLoopJoinRangeEnabled() ||
+      joinNode.joinCondition() == nullptr) {
+    return std::nullopt;
+  }
+
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  flattenConjuncts(joinNode.joinCondition(), conjuncts);
+
+  RangeBuilder builder(
+      joinNode.sources()[0]->outputType(), joinNode.sources()[1]->outputType());
+  for (const auto* conjunct : conjuncts) {
+    const auto& name = conjunct->name();
+    const auto& inputs = conjunct->inputs();
+    if ((name == "lt" || name == "lte" || name == "gt" || name == "gte") &&
+        inputs.size() == 2) {
+      builder.addComparison(name, inputs[0], inputs[1]);
+    } else if (name == "between" && inputs.size() == 3) {
+      builder.addComparison("gte", inputs[0], inputs[1]);
+      builder.addComparison("lte", inputs[0], inputs[2]);
+    }
+  }
+  return builder.build();
+}
+
+RowVectorPtr NestedLoopJoinRange::sortBuild(
+    const std::vector<RowVectorPtr>& buildVectors,
+    memory::MemoryPool* pool) const {
+  vector_size_t numRows = 0;
+  for (const auto& vector : buildVectors) {
+    numRows += vector->size();
+  }
+
+  auto merged = BaseVector::create<RowVector>(
+      buildVectors[0]->type(), numRows, pool);
+  vector_size_t offset = 0;
+  for (const auto& vector : buildVectors) {
+    merged->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+  }
+
+  std::vector<vector_size_t> indices(numRows);
+  std::iota(indices.begin(), indices.end(), 0);
+  merged->childAt(buildChannel)
+      ->sortIndices(indices, CompareFlags{.nullsFirst = false});
+
+  auto sorted = BaseVector::create<RowVector>(merged->type(), numRows, pool);
+  SelectivityVector rows(numRows);
+  sorted->copy(merged.get(), rows, indices.data());
+  return sorted;
+}
 
 void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   std::vector<ContinuePromise> promises;
@@ -50,7 +218,10 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      range_(NestedLoopJoinRange::create(
+          *joinNode,
+          driverCtx->queryConfig())) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -137,7 +308,11 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
-  dataVectors_ = mergeDataVectors();
+  if (range_.has_value() && !dataVectors_.empty()) {
+    dataVectors_ = {range_->sortBuild(dataVectors_, pool())};
+  } else {
+    dataVectors_ = mergeDataVectors();
+  }
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
@@ -20,6 +20,42 @@
 
 namespace facebook::velox::exec {
 
+/// Describes a nested loop join whose condition is a conjunction with terms
+/// that bound a build side column by probe side columns, e.g. 'b.start <=
+/// a.ts' or 'a.ts BETWEEN b.start AND b.end'. The build side is then sorted on
+/// that column, and only the build rows within the bounds of a probe row are
+/// candidates for a match. The whole condition is still evaluated on the
+/// candidates.
+struct NestedLoopJoinRange {
+  /// A bound on the build column given by a probe column.
+  struct Bound {
+    column_index_t probeChannel;
+    /// True if the build column is at most the probe value, false if it is at
+    /// least the probe value.
+    bool upper;
+    /// True if the build column can be equal to the probe value.
+    bool inclusive;
+  };
+
+  /// The build column the build side is sorted on.
+  column_index_t buildChannel;
+
+  /// Non-empty list of bounds on 'buildChannel'.
+  std::vector<Bound> bounds;
+
+  /// Returns the range to use for 'joinNode' or std::nullopt if the condition
+  /// has no usable bounds or if the range mode is disabled in 'config'.
+  static std::optional<NestedLoopJoinRange> create(
+      const core::NestedLoopJoinNode& joinNode,
+      const core::QueryConfig& config);
+
+  /// Returns the build rows sorted on 'buildChannel' with nulls last as a
+  /// single vector.
+  RowVectorPtr sortBuild(
+      const std::vector<RowVectorPtr>& buildVectors,
+      memory::MemoryPool* pool) const;
+};
+
 class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
@@ -61,6 +97,9 @@ class NestedLoopJoinBuild : public Operator {
  private:
   std::vector<RowVectorPtr> mergeDataVectors() const;
 
+  // Set if the build side is sorted for a range join.
+  const std::optional<NestedLoopJoinRange> range_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -57,7 +57,10 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
       joinNode_(joinNode),
-      joinType_(joinNode_->joinType()) {
+      joinType_(joinNode_->joinType()),
+      range_(NestedLoopJoinRange::create(
+          *joinNode,
+          driverCtx->queryConfig())) {
   auto probeType = joinNode_->sources()[0]->outputType();
   auto buildType = joinNode_->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
@@ -142,6 +145,17 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
       }
       VELOX_CHECK(buildVectors_.has_value());
 
+      if (range_.has_value() && !isBuildSideEmpty()) {
+        VELOX_CHECK(isSingleBuildVector());
+        // Nulls are sorted last.
+        const auto& key = buildVectors_->front()->childAt(range_->buildChannel);
+        numNonNullBuildRows_ = key->size();
+        while (numNonNullBuildRows_ > 0 &&
+               key->isNullAt(numNonNullBuildRows_ - 1)) {
+          --numNonNullBuildRows_;
+        }
+      }
+
       // If we just got build data, check if this is a right or full join where
       // we need to hit track of hits on build records. If it is, initialize the
       // selectivity vectors that do so.
@@ -320,9 +334,20 @@ bool NestedLoopJoinProbe::addToOutput() {
       return false;
     }
 
+    // In a range join, the filter is evaluated only for the build rows within
+    // the bounds of the probe row.
+    const auto& candidates = range_.has_value() ? buildRange_ : currentBuild;
+
     // Only re-calculate the filter if we have a new build vector.
     if (buildRow_ == 0) {
-      evaluateJoinFilter(currentBuild);
+      if (range_.has_value()) {
+        buildRange_ = nextBuildRange(currentBuild);
+        if (buildRange_->size() == 0) {
+          ++buildIndex_;
+          continue;
+        }
+      }
+      evaluateJoinFilter(candidates);
     }
 
     // Iterate over the filter results. For each match, add an output record.
@@ -336,20 +361,20 @@ bool NestedLoopJoinProbe::addToOutput() {
         // records that got a hit (key match), so that at end we know which
         // build records to add and which to skip.
         if (needsBuildMismatch(joinType_)) {
-          buildMatched_[buildIndex_].setValid(i, true);
+          buildMatched_[buildIndex_].setValid(buildRangeOffset_ + i, true);
         }
 
         // If the buffer is full, save state and produce it as output.
         if (numOutputRows_ == outputBatchSize_) {
           buildRow_ = i + 1;
-          copyBuildValues(currentBuild);
+          copyBuildValues(candidates);
           return false;
         }
       }
     }
 
     // Before moving to the next build vector, copy the needed ranges.
-    copyBuildValues(currentBuild);
+    copyBuildValues(candidates);
     ++buildIndex_;
     buildRow_ = 0;
   }
@@ -395,6 +420,49 @@ void NestedLoopJoinProbe::prepareOutput() {
       pool(), outputType_, nullptr, outputBatchSize_, std::move(localColumns));
 }
 
+RowVectorPtr NestedLoopJoinProbe::nextBuildRange(
+    const RowVectorPtr& buildVector) {
+  const auto* key = buildVector->childAt(range_->buildChannel).get();
+  vector_size_t begin = 0;
+  vector_size_t end = numNonNullBuildRows_;
+  for (const auto& bound : range_->bounds) {
+    const auto* probe = input_->childAt(bound.probeChannel)->loadedVector();
+    if (probe->isNullAt(probeRow_)) {
+      end = begin;
+      break;
+    }
+    // Returns the first row in [begin, end) for which 'key' is above the probe
+    // value, or at or above it if 'orEqual' is true.
+    auto findFirst = [&](bool orEqual) {
+      vector_size_t low = begin;
+      vector_size_t high = end;
+      while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        const auto result =
+            key->compare(probe, middle, probeRow_, CompareFlags{}).value();
+        if (result < 0 || (result == 0 && !orEqual)) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      return low;
+    };
+    if (bound.upper) {
+      end = findFirst(!bound.inclusive);
+    } else {
+      begin = findFirst(bound.inclusive);
+    }
+    if (begin >= end) {
+      break;
+    }
+  }
+
+  buildRangeOffset_ = begin;
+  return std::static_pointer_cast<RowVector>(
+      buildVector->slice(begin, std::max(0, end - begin)));
+}
+
 void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
   // First step to process is to get a batch so we can evaluate the join
   // filter.
@@ -61,6 +61,11 @@ namespace facebook::velox::exec {
 /// c) If build side has multiple vectors, take one probe row are at a time,
 /// wrapping it as a constant, and produce it along with build batches.
 ///
+/// If the join condition bounds a build column by probe columns (see
+/// NestedLoopJoinRange), the build side is a single vector sorted on that
+/// column. For each probe row, the build rows within the bounds are found by
+/// binary search and the condition is evaluated on these only, as in c).
+///
 /// If needed, buid-side copies are done lazily; it first accumulates the ranges
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
@@ -134,6 +139,11 @@ class NestedLoopJoinProbe : public Operator {
   // receive rows. Batches have space for `outputBatchSize_`.
   void prepareOutput();
 
+  // Returns the rows of the sorted 'buildVector' within the bounds of 'range_'
+  // for the current probe row and sets 'buildRangeOffset_' to the first of
+  // them.
+  RowVectorPtr nextBuildRange(const RowVectorPtr& buildVector);
+
   // Evaluates the joinCondition for a given build vector. This method sets
   // `filterOutput_` and `decodedFilterResult_`, which will be ready to be used
   // by `isJoinConditionMatch(buildRow)` below.
@@ -346,6 +356,18 @@ class NestedLoopJoinProbe : public Operator {
   // Row being currently processed from `buildVectors_[buildIndex_]`.
   vector_size_t buildRow_{0};
 
+  // Set if the build side is sorted for a range join.
+  const std::optional<NestedLoopJoinRange> range_;
+
+  // The candidate build rows for the current probe row in a range join, and
+  // the index of the first of them in the build vector. 'buildRow_' is
+  // relative to 'buildRange_'.
+  RowVectorPtr buildRange_;
+  vector_size_t buildRangeOffset_{0};
+
+  // Number of rows with a non-null range column in the sorted build vector.
+  vector_size_t numNonNullBuildRows_{0};
+
   // Keep track of the build rows that had matches (only used for right or full
   // outer joins).
   std::vector<SelectivityVector> buildMatched_;
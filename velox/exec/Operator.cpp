@@ -346,6 +346,17 @@ void Operator::close() {
 vector_size_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  const uint64_t cacheBudget = queryConfig.outputBatchCacheBudgetBytes();
+  if (cacheBudget > 0) {
+    const auto workingSetBytes = workingSetBytesPerRow();
+    const uint64_t rowBytes =
+        averageRowSize.value_or(0) + workingSetBytes.value_or(0);
+    if (rowBytes > 0) {
+      return std::clamp<uint64_t>(
+          cacheBudget / rowBytes, 1, queryConfig.maxOutputBatchRows());
+    }
+  }
+
   if (!averageRowSize.has_value()) {
     return queryConfig.preferredOutputBatchRows();
   }
@@ -434,6 +445,13 @@ void Operator::recordSpillStats() {
             static_cast<int64_t>(lockedSpillStats->spillWriteTimeNanos),
             RuntimeCounter::Unit::kNanos});
   }
+  if (lockedSpillStats->spillWriteStallTimeNanos != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillWriteStallTime,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillWriteStallTimeNanos),
+            RuntimeCounter::Unit::kNanos});
+  }
   if (lockedSpillStats->spillRuns != 0) {
     lockedStats->addRuntimeStat(
         kSpillRuns,
@@ -350,6 +350,8 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillFlushTime{"spillFlushWallNanos"};
   static inline const std::string kSpillWrites{"spillWrites"};
   static inline const std::string kSpillWriteTime{"spillWriteWallNanos"};
+  static inline const std::string kSpillWriteStallTime{
+      "spillWriteStallWallNanos"};
   static inline const std::string kSpillRuns{"spillRuns"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
@@ -762,9 +764,21 @@ class Operator : public BaseRuntimeStatWriter {
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
   /// preferredOutputBatchRows.
+  ///
+  /// If outputBatchCacheBudgetBytes is set and there is an averageRowSize or a
+  /// workingSetBytesPerRow(), returns the number of rows for which both fit in
+  /// the budget instead.
   vector_size_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns the estimated number of bytes the operator touches per output
+  /// row besides the row itself, e.g. the build side row of a hash join. Used
+  /// to size the output batches to outputBatchCacheBudgetBytes. std::nullopt
+  /// if not known.
+  virtual std::optional<uint64_t> workingSetBytesPerRow() const {
+    return std::nullopt;
+  }
+
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
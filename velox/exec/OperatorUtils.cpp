@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+
+#include <unordered_set>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -23,97 +27,48 @@ namespace facebook::velox::exec {
 
 namespace {
 
-template <TypeKind kind>
-void scalarGatherCopy(
-    BaseVector* target,
+// The rows to copy from one source of gatherCopy(), as ranges of
+// consecutive rows.
+struct SourceCopyRanges {
+  const RowVector* source;
+  std::vector<BaseVector::CopyRange> ranges;
+};
+
+// Makes the copy plan of gatherCopy(). Consecutive rows of the same source
+// become one range and the ranges are grouped by source, so that each column
+// is copied with one BaseVector::copyRanges() call per source. This copies
+// fixed-width values and nulls with one memcpy or bit copy per range and
+// rebases offsets of strings, arrays and maps once per range.
+std::vector<SourceCopyRanges> makeGatherCopyPlan(
     vector_size_t targetIndex,
     vector_size_t count,
     const std::vector<const RowVector*>& sources,
-    const std::vector<vector_size_t>& sourceIndices,
-    column_index_t sourceColumnChannel) {
-  VELOX_DCHECK(target->isFlatEncoding());
-
-  using T = typename TypeTraits<kind>::NativeType;
-  auto* flatVector = target->template asUnchecked<FlatVector<T>>();
-  uint64_t* rawNulls = nullptr;
-  if (std::is_same_v<T, StringView>) {
-    for (int i = 0; i < count; ++i) {
-      VELOX_DCHECK(!sources[i]->mayHaveNulls());
-      if (sources[i]
-              ->childAt(sourceColumnChannel)
-              ->isNullAt(sourceIndices[i])) {
-        if (FOLLY_UNLIKELY(rawNulls == nullptr)) {
-          rawNulls = target->mutableRawNulls();
-        }
-        bits::setNull(rawNulls, targetIndex + i, true);
+    const std::vector<vector_size_t>& sourceIndices) {
+  std::vector<SourceCopyRanges> plan;
+  folly::F14FastMap<const RowVector*, int32_t> sourceToPlan;
+  SourceCopyRanges* current = nullptr;
+  for (auto i = 0; i < count; ++i) {
+    const auto* source = sources[i];
+    VELOX_DCHECK(!source->mayHaveNulls());
+    const auto sourceIndex = sourceIndices[i];
+    if (current != nullptr && current->source == source) {
+      auto& range = current->ranges.back();
+      if (range.sourceIndex + range.count == sourceIndex &&
+          range.targetIndex + range.count == targetIndex + i) {
+        ++range.count;
         continue;
       }
-      auto* source = sources[i]->childAt(sourceColumnChannel).get();
-      flatVector->setNoCopy(
-          targetIndex + i,
-          source->template asUnchecked<FlatVector<T>>()->valueAt(
-              sourceIndices[i]));
-      flatVector->acquireSharedStringBuffers(source);
-    }
-  } else {
-    for (int i = 0; i < count; ++i) {
-      VELOX_DCHECK(!sources[i]->mayHaveNulls());
-      if (sources[i]
-              ->childAt(sourceColumnChannel)
-              ->isNullAt(sourceIndices[i])) {
-        if (FOLLY_UNLIKELY(rawNulls == nullptr)) {
-          rawNulls = target->mutableRawNulls();
-        }
-        bits::setNull(rawNulls, targetIndex + i, true);
-        continue;
+    } else {
+      auto it = sourceToPlan.find(source);
+      if (it == sourceToPlan.end()) {
+        it = sourceToPlan.emplace(source, plan.size()).first;
+        plan.push_back({source, {}});
       }
-      flatVector->set(
-          targetIndex + i,
-          sources[i]
-              ->childAt(sourceColumnChannel)
-              ->template asUnchecked<FlatVector<T>>()
-              ->valueAt(sourceIndices[i]));
+      current = &plan[it->second];
     }
+    current->ranges.push_back({sourceIndex, targetIndex + i, 1});
   }
-}
-
-void complexGatherCopy(
-    BaseVector* target,
-    vector_size_t targetIndex,
-    vector_size_t count,
-    const std::vector<const RowVector*>& sources,
-    const std::vector<vector_size_t>& sourceIndices,
-    column_index_t sourceChannel) {
-  for (int i = 0; i < count; ++i) {
-    target->copy(
-        sources[i]->childAt(sourceChannel).get(),
-        targetIndex + i,
-        sourceIndices[i],
-        1);
-  }
-}
-
-void gatherCopy(
-    BaseVector* target,
-    vector_size_t targetIndex,
-    vector_size_t count,
-    const std::vector<const RowVector*>& sources,
-    const std::vector<vector_size_t>& sourceIndices,
-    column_index_t sourceChannel) {
-  if (target->isScalar()) {
-    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
-        scalarGatherCopy,
-        target->type()->kind(),
-        target,
-        targetIndex,
-        count,
-        sources,
-        sourceIndices,
-        sourceChannel);
-  } else {
-    complexGatherCopy(
-        target, targetIndex, count, sources, sourceIndices, sourceChannel);
-  }
+  return plan;
 }
 
 // We want to aggregate some operator runtime metrics per operator rather than
@@ -322,6 +277,97 @@ void loadColumns(const RowVectorPtr& input, core::ExecCtx& execCtx) {
   }
 }
 
+namespace {
+// Returns the LazyVector under the dictionary and constant wrappers of
+// 'vector' if this is not loaded, else nullptr.
+const LazyVector* unloadedLazyBase(const BaseVector& vector) {
+  const BaseVector* base = &vector;
+  while ((base->encoding() == VectorEncoding::Simple::DICTIONARY ||
+          base->encoding() == VectorEncoding::Simple::CONSTANT) &&
+         base->valueVector() != nullptr) {
+    base = base->valueVector().get();
+  }
+  if (!base->isLazy() || base->asUnchecked<LazyVector>()->isLoaded()) {
+    return nullptr;
+  }
+  return base->asUnchecked<LazyVector>();
+}
+} // namespace
+
+void loadColumnsConcurrently(
+    const std::vector<VectorPtr>& vectors,
+    const SelectivityVector& rows,
+    folly::Executor* executor) {
+  std::vector<const VectorPtr*> toLoad;
+  // The vectors which wrap the same LazyVector as a vector in 'toLoad'. These
+  // are loaded after 'toLoad' on the calling thread.
+  std::vector<const VectorPtr*> toLoadAfter;
+  std::unordered_set<const LazyVector*> lazyBases;
+  for (const auto& vector : vectors) {
+    const auto* lazy = unloadedLazyBase(*vector);
+    if (lazy == nullptr || !lazy->supportsConcurrentLoad()) {
+      continue;
+    }
+    if (lazyBases.insert(lazy).second) {
+      toLoad.push_back(&vector);
+    } else {
+      toLoadAfter.push_back(&vector);
+    }
+  }
+  if (toLoad.size() < 2) {
+    for (const auto* vector : toLoad) {
+      LazyVector::ensureLoadedRows(*vector, rows);
+    }
+    for (const auto* vector : toLoadAfter) {
+      LazyVector::ensureLoadedRows(*vector, rows);
+    }
+    return;
+  }
+
+  // Passing driver context and stats writer directly to avoid cross thread
+  // access to thread local state.
+  const DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+  auto* statWriter = getThreadLocalRunTimeStatWriter();
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> loads;
+  for (const auto* vector : toLoad) {
+    // Each load gets its own copy of 'rows', so that the loads do not share
+    // any state of the SelectivityVector.
+    loads.push_back(std::make_shared<AsyncSource<bool>>(
+        [vector, loadRows = rows, statWriter]() {
+          RuntimeStatWriterScopeGuard statWriterGuard(statWriter);
+          LazyVector::ensureLoadedRows(*vector, loadRows);
+          return std::make_unique<bool>(true);
+        }));
+    executor->add([driverCtx, load = loads.back()]() {
+      ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+      load->prepare();
+    });
+  }
+
+  // All the loads must be waited for also in case of error because they
+  // reference 'vectors'.
+  std::exception_ptr error;
+  for (auto& load : loads) {
+    try {
+      load->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  for (const auto* vector : toLoadAfter) {
+    LazyVector::ensureLoadedRows(*vector, rows);
+  }
+}
+
 void gatherCopy(
     RowVector* target,
     vector_size_t targetIndex,
@@ -336,25 +382,24 @@ void gatherCopy(
   VELOX_CHECK_LE(count, sources.size());
   VELOX_CHECK_LE(count, sourceIndices.size());
   VELOX_DCHECK_EQ(sources.size(), sourceIndices.size());
+  const auto plan =
+      makeGatherCopyPlan(targetIndex, count, sources, sourceIndices);
+  auto copyColumn = [&](column_index_t outputChannel,
+                        column_index_t inputChannel) {
+    auto* targetChild = target->childAt(outputChannel).get();
+    for (const auto& sourceRanges : plan) {
+      targetChild->copyRanges(
+          sourceRanges.source->childAt(inputChannel).get(),
+          sourceRanges.ranges);
+    }
+  };
   if (!columnMap.empty()) {
     for (const auto& columnProjection : columnMap) {
-      gatherCopy(
-          target->childAt(columnProjection.outputChannel).get(),
-          targetIndex,
-          count,
-          sources,
-          sourceIndices,
-          columnProjection.inputChannel);
+      copyColumn(columnProjection.outputChannel, columnProjection.inputChannel);
     }
   } else {
     for (auto i = 0; i < target->type()->size(); ++i) {
-      gatherCopy(
-          target->childAt(i).get(),
-          targetIndex,
-          count,
-          sources,
-          sourceIndices,
-          i);
+      copyColumn(i, i);
     }
   }
 }
@@ -89,6 +89,19 @@ RowVectorPtr wrap(
 // Ensures that all LazyVectors reachable from 'input' are loaded for all rows.
 void loadColumns(const RowVectorPtr& input, core::ExecCtx& execCtx);
 
+/// Loads 'rows' of the unloaded LazyVectors in 'vectors' which support
+/// concurrent loading, each as a separate work item on 'executor'. The
+/// LazyVectors may be wrapped in dictionaries or constants. A LazyVector
+/// wrapped by several of 'vectors' is loaded by one work item. The
+/// calling thread runs the items which have not started on 'executor' and
+/// returns when all are done, so this cannot deadlock if all the threads of
+/// 'executor' are busy. The other vectors are left as they are. Rethrows the
+/// first error of a load.
+void loadColumnsConcurrently(
+    const std::vector<VectorPtr>& vectors,
+    const SelectivityVector& rows,
+    folly::Executor* executor);
+
 /// Scatter copy from multiple source row vectors into the target row vector.
 /// 'targetIndex' is first row in 'target' to copy to. 'count' specifies how
 /// many rows to copy from the sources. 'sources' and 'sourceIndices' specify
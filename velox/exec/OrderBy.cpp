@@ -21,6 +21,10 @@
 namespace facebook::velox::exec {
 
 namespace {
+// Number of sorting keys each driver samples per range for picking the range
+// boundaries.
+constexpr vector_size_t kSamplesPerRange = 128;
+
 CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
   return {
       sortOrder.isNullsFirst(),
@@ -40,9 +44,12 @@ OrderBy::OrderBy(
           operatorId,
           orderByNode->id(),
           "OrderBy",
-          orderByNode->canSpill(driverCtx->queryConfig())
+          orderByNode->canSpill(driverCtx->queryConfig()) &&
+                  !isRangePartitioned(*orderByNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      rangePartitioned_(
+          isRangePartitioned(*orderByNode, driverCtx->queryConfig())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -70,6 +77,13 @@ OrderBy::OrderBy(
       &spillStats_);
 }
 
+// static
+bool OrderBy::isRangePartitioned(
+    const core::OrderByNode& orderByNode,
+    const core::QueryConfig& config) {
+  return config.orderByRangePartitioning() && orderByNode.isPartial();
+}
+
 void OrderBy::addInput(RowVectorPtr input) {
   sortBuffer_->addInput(input);
 }
@@ -90,6 +104,187 @@ void OrderBy::reclaim(
 
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
+  if (rangePartitioned_ &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1) {
+    sampleRanges();
+    return;
+  }
+  sortBuffer_->noMoreInput();
+  maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (rangeFuture_.valid()) {
+    *future = std::move(rangeFuture_);
+    return BlockingReason::kWaitForOrderByRanges;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void OrderBy::sampleRanges() {
+  VELOX_CHECK(rangePartitioned_);
+  rangeState_ = RangeState::kWaitForBoundaries;
+  const auto numDrivers =
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+  numSampledRows_ = sortBuffer_->numInputRows();
+  rangeSamples_ = sortBuffer_->sampleSortKeys(kSamplesPerRange * numDrivers);
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish picks the boundaries for all drivers. The other
+  // drivers are blocked until then.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &rangeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  std::vector<OrderBy*> orderBys{this};
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    orderBys.push_back(orderBy);
+  }
+  const auto boundaries = pickRangeBoundaries(orderBys, numDrivers);
+  for (auto* orderBy : orderBys) {
+    orderBy->rangeBoundaries_ = boundaries;
+    orderBy->rangeSamples_ = nullptr;
+  }
+}
+
+RowVectorPtr OrderBy::pickRangeBoundaries(
+    const std::vector<OrderBy*>& orderBys,
+    int32_t numRanges) const {
+  struct Sample {
+    const RowVector* keys;
+    vector_size_t index;
+    double numRows;
+  };
+  std::vector<Sample> samples;
+  double totalRows = 0;
+  for (const auto* orderBy : orderBys) {
+    const auto& keys = orderBy->rangeSamples_;
+    if (keys->size() == 0) {
+      continue;
+    }
+    const double numRowsPerSample =
+        static_cast<double>(orderBy->numSampledRows_) / keys->size();
+    for (vector_size_t i = 0; i < keys->size(); ++i) {
+      samples.push_back({keys.get(), i, numRowsPerSample});
+    }
+    totalRows += orderBy->numSampledRows_;
+  }
+
+  const auto& flags = sortBuffer_->sortCompareFlags();
+  std::sort(
+      samples.begin(),
+      samples.end(),
+      [&](const Sample& left, const Sample& right) {
+        for (auto i = 0; i < flags.size(); ++i) {
+          if (auto result = left.keys->childAt(i)
+                                ->compare(
+                                    right.keys->childAt(i).get(),
+                                    left.index,
+                                    right.index,
+                                    flags[i])
+                                .value()) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+
+  // Boundary i is the first sample at which the samples so far stand for
+  // (i + 1) / 'numRanges' of the input rows.
+  auto boundaries = BaseVector::create<RowVector>(
+      rangeSamples_->type(), numRanges - 1, pool());
+  vector_size_t numBoundaries = 0;
+  double numRows = 0;
+  for (const auto& sample : samples) {
+    numRows += sample.numRows;
+    while (numBoundaries < numRanges - 1 &&
+           numRows >= totalRows * (numBoundaries + 1) / numRanges) {
+      boundaries->copy(sample.keys, numBoundaries, sample.index, 1);
+      ++numBoundaries;
+    }
+  }
+  boundaries->resize(numBoundaries);
+  return boundaries;
+}
+
+void OrderBy::partitionRanges() {
+  VELOX_CHECK_NOT_NULL(rangeBoundaries_);
+  rangeState_ = RangeState::kWaitForRanges;
+  sortBuffer_->extractRanges(
+      rangeBoundaries_, maxOutputRows_, rangePartitions_);
+  rangeBoundaries_ = nullptr;
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish moves the ranges of all drivers to the drivers
+  // that sort them. The other drivers are blocked until then.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &rangeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  std::vector<OrderBy*> orderBys{this};
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    orderBys.push_back(orderBy);
+  }
+  for (auto* target : orderBys) {
+    // Drivers output their ranges in the order of their partition ids, which
+    // is the order of the sources of a LocalMerge.
+    const auto range = target->operatorCtx_->driverCtx()->partitionId;
+    for (auto* source : orderBys) {
+      if (range >= source->rangePartitions_.size()) {
+        // There are fewer ranges if there are too few samples.
+        continue;
+      }
+      auto& vectors = source->rangePartitions_[range];
+      target->rangeInput_.insert(
+          target->rangeInput_.end(),
+          std::make_move_iterator(vectors.begin()),
+          std::make_move_iterator(vectors.end()));
+      vectors.clear();
+    }
+  }
+}
+
+void OrderBy::sortRange() {
+  uint64_t numRangeRows = 0;
+  for (auto& input : rangeInput_) {
+    numRangeRows += input->size();
+    sortBuffer_->addInput(input);
+    input = nullptr;
+  }
+  rangeInput_.clear();
+  rangePartitions_.clear();
+  rangeState_ = RangeState::kNone;
+  addRuntimeStat("rangeSortInputRows", RuntimeCounter(numRangeRows));
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
 }
@@ -98,6 +293,15 @@ RowVectorPtr OrderBy::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
+  if (rangeState_ == RangeState::kWaitForBoundaries && !rangeFuture_.valid()) {
+    partitionRanges();
+  }
+  if (rangeState_ == RangeState::kWaitForRanges && !rangeFuture_.valid()) {
+    sortRange();
+  }
+  if (rangeState_ != RangeState::kNone) {
+    return nullptr;
+  }
 
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
@@ -106,6 +310,10 @@ RowVectorPtr OrderBy::getOutput() {
 
 void OrderBy::close() {
   Operator::close();
+  rangeSamples_ = nullptr;
+  rangeBoundaries_ = nullptr;
+  rangePartitions_.clear();
+  rangeInput_.clear();
   sortBuffer_.reset();
 }
 } // namespace facebook::velox::exec
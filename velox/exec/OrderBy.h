@@ -32,6 +32,12 @@ namespace facebook::velox::exec {
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
+///
+/// If range partitioning is enabled for a partial OrderBy, the drivers sample
+/// their sorting keys at the end of the input and agree on one key range per
+/// driver. Each driver then sorts and outputs the rows of all the drivers that
+/// fall in its range, so that the outputs of the drivers in driver order are
+/// the sorted output of the OrderBy.
 class OrderBy : public Operator {
  public:
   OrderBy(
@@ -49,9 +55,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -62,9 +66,58 @@ class OrderBy : public Operator {
 
   void close() override;
 
+  /// Returns true if the drivers of 'orderByNode' partition their rows by
+  /// ranges of the sorting keys, so that driver i outputs the i-th range.
+  static bool isRangePartitioned(
+      const core::OrderByNode& orderByNode,
+      const core::QueryConfig& config);
+
  private:
+  // Key ranges of the drivers are being agreed on, rows partitioned by range
+  // or none of these.
+  enum class RangeState { kNone, kWaitForBoundaries, kWaitForRanges };
+
+  // Invoked at the end of the input if 'rangePartitioned_' is set. Samples
+  // the sorting keys. The last driver to finish picks the range boundaries
+  // for all the drivers from their samples.
+  void sampleRanges();
+
+  // Moves the rows of 'sortBuffer_' out by range after the boundaries are
+  // known. The last driver to do so hands the ranges of all the drivers over
+  // to the drivers that sort them.
+  void partitionRanges();
+
+  // Adds the rows of the range of 'this' from all the drivers to
+  // 'sortBuffer_' and sorts them.
+  void sortRange();
+
+  // Returns the ascending boundaries between the ranges of 'numRanges'
+  // drivers from the samples of 'orderBys'. Each sample stands for an equal
+  // share of the input rows of its driver.
+  RowVectorPtr pickRangeBoundaries(
+      const std::vector<OrderBy*>& orderBys,
+      int32_t numRanges) const;
+
+  const bool rangePartitioned_;
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   vector_size_t maxOutputRows_;
+
+  RangeState rangeState_{RangeState::kNone};
+  // Fulfilled when all the drivers have sampled their keys or partitioned
+  // their rows.
+  ContinueFuture rangeFuture_{ContinueFuture::makeEmpty()};
+  // The sampled sorting keys of the input of 'this'.
+  RowVectorPtr rangeSamples_;
+  // The number of input rows that 'rangeSamples_' stand for.
+  uint64_t numSampledRows_{0};
+  // Upper bounds of the ranges of the drivers except the last. Set by the
+  // last driver to sample its keys.
+  RowVectorPtr rangeBoundaries_;
+  // The rows of 'this' by range. Indexed by driver.
+  std::vector<std::vector<RowVectorPtr>> rangePartitions_;
+  // The rows of the range of 'this' from all the drivers. Set by the last
+  // driver to partition its rows.
+  std::vector<RowVectorPtr> rangeInput_;
 };
 } // namespace facebook::velox::exec
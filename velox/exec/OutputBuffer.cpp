@@ -35,6 +35,14 @@ void ArbitraryBuffer::enqueue(std::unique_ptr<SerializedPage> page) {
   pages_.push_back(std::shared_ptr<SerializedPage>(page.release()));
 }
 
+void ArbitraryBuffer::requeue(
+    std::vector<std::shared_ptr<SerializedPage>> pages) {
+  pages_.insert(
+      pages_.begin(),
+      std::make_move_iterator(pages.begin()),
+      std::make_move_iterator(pages.end()));
+}
+
 void ArbitraryBuffer::getAvailablePageSizes(std::vector<int64_t>& out) const {
   out.reserve(out.size() + pages_.size());
   for (const auto& page : pages_) {
@@ -107,6 +115,17 @@ void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
   recordAcknowledge(data);
 }
 
+void DestinationBuffer::Stats::recordReassign(const SerializedPage& data) {
+  const auto numRows = data.numRows();
+  VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
+  bytesBuffered -= data.size();
+  VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
+  rowsBuffered -= numRows.value();
+  VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
+  --pagesBuffered;
+  VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
+}
+
 DestinationBuffer::Data DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
@@ -164,6 +183,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
       }
     }
   }
+  deliveredSequence_ = std::max(deliveredSequence_, sequence_ + i);
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
   remainingBytes.reserve(data_.size() - i);
@@ -296,6 +316,20 @@ DestinationBuffer::deleteResults() {
   return freed;
 }
 
+std::vector<std::shared_ptr<SerializedPage>>
+DestinationBuffer::takeUndeliveredPages() {
+  const auto first = std::max<int64_t>(deliveredSequence_ - sequence_, 0);
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  auto i = first;
+  // Keeps the end marker, if any, as it is not owned by the arbitrary buffer.
+  for (; i < data_.size() && data_[i] != nullptr; ++i) {
+    stats_.recordReassign(*data_[i]);
+    pages.push_back(std::move(data_[i]));
+  }
+  data_.erase(data_.begin() + first, data_.begin() + i);
+  return pages;
+}
+
 DestinationBuffer::Stats DestinationBuffer::stats() const {
   return stats_;
 }
@@ -332,6 +366,9 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(task_->queryCtx()->queryConfig().maxOutputBufferSize()),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      reassignTimeoutMs_(task_->queryCtx()
+                             ->queryConfig()
+                             .arbitraryOutputBufferReassignTimeoutMs()),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
       numDrivers_(numDrivers) {
@@ -726,6 +763,10 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
+      if (isArbitrary()) {
+        buffer->setLastFetchTimeMs(getCurrentTimeMs());
+        maybeReassignPagesLocked(destination);
+      }
       data = buffer->getData(
           maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
     } else {
@@ -741,6 +782,27 @@ void OutputBuffer::getData(
   }
 }
 
+void OutputBuffer::maybeReassignPagesLocked(int destination) {
+  VELOX_CHECK(isArbitrary());
+  if (reassignTimeoutMs_ == 0 || !arbitraryBuffer_->empty()) {
+    return;
+  }
+  const auto nowMs = buffers_[destination]->lastFetchTimeMs();
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    auto* buffer = buffers_[i].get();
+    if (i == destination || buffer == nullptr ||
+        buffer->lastFetchTimeMs() + reassignTimeoutMs_ > nowMs) {
+      continue;
+    }
+    auto pages = buffer->takeUndeliveredPages();
+    if (pages.empty()) {
+      continue;
+    }
+    numReassignedPages_ += pages.size();
+    arbitraryBuffer_->requeue(std::move(pages));
+  }
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -841,7 +903,7 @@ OutputBuffer::Stats OutputBuffer::stats() {
 
   updateTotalBufferedBytesMsLocked();
 
-  return OutputBuffer::Stats(
+  auto stats = OutputBuffer::Stats(
       kind_,
       noMoreBuffers_,
       atEnd_,
@@ -854,6 +916,8 @@ OutputBuffer::Stats OutputBuffer::stats() {
       getAverageBufferTimeMsLocked(),
       countTopBuffers(bufferStats, numOutputBytes_),
       bufferStats);
+  stats.numReassignedPages = numReassignedPages_;
+  return stats;
 }
 
 } // namespace facebook::velox::exec
@@ -77,6 +77,11 @@ class ArbitraryBuffer {
 
   void enqueue(std::unique_ptr<SerializedPage> page);
 
+  /// Puts back 'pages' taken from a lagging destination buffer at the front of
+  /// this buffer in their original order, so that they are dispatched to the
+  /// next destination which fetches data.
+  void requeue(std::vector<std::shared_ptr<SerializedPage>> pages);
+
   /// Returns a number of pages with total bytes no less than 'maxBytes' if
   /// there are sufficient buffered pages.
   std::vector<std::shared_ptr<SerializedPage>> getPages(uint64_t maxBytes);
@@ -104,6 +109,8 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    void recordReassign(const SerializedPage& data);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -172,6 +179,23 @@ class DestinationBuffer {
   /// Removes all remaining data from the queue and returns the removed data.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
+  /// Removes and returns the pages which have been loaded from the arbitrary
+  /// buffer but not yet returned by getData() to the consumer. This only used
+  /// by arbitrary output type to move the pages of a lagging consumer to the
+  /// other destinations.
+  std::vector<std::shared_ptr<SerializedPage>> takeUndeliveredPages();
+
+  /// Records the time of a data fetch from the consumer of this buffer.
+  void setLastFetchTimeMs(uint64_t timeMs) {
+    lastFetchTimeMs_ = timeMs;
+  }
+
+  /// Returns the time of the last data fetch from the consumer of this buffer,
+  /// 0 if there is none.
+  uint64_t lastFetchTimeMs() const {
+    return lastFetchTimeMs_;
+  }
+
   /// Returns and clears the notify callback, if any, along with arguments for
   /// the callback.
   DataAvailable getAndClearNotify();
@@ -190,6 +214,10 @@ class DestinationBuffer {
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The sequence number after the last page returned by getData(). The pages
+  // from here on have not been seen by the consumer.
+  int64_t deliveredSequence_{0};
+  uint64_t lastFetchTimeMs_{0};
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
@@ -251,6 +279,10 @@ class OutputBuffer {
     /// The number of largest buffers that handle 80% of the total data.
     int32_t numTopBuffers{0};
 
+    /// The number of pages of arbitrary output moved from lagging destinations
+    /// back to the shared arbitrary buffer.
+    int64_t numReassignedPages{0};
+
     /// Stats of the OutputBuffer's destinations.
     std::vector<DestinationBuffer::Stats> buffersStats;
 
@@ -365,6 +397,11 @@ class OutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Moves the undelivered pages of the destinations which have not fetched
+  // data for 'reassignTimeoutMs_' to the arbitrary buffer when it is empty on
+  // a fetch from 'destination'. Only used by arbitrary output type.
+  void maybeReassignPagesLocked(int destination);
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -387,6 +424,9 @@ class OutputBuffer {
   // When 'totalSize_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // Time in ms after which the undelivered pages of an idle destination are
+  // moved to the other destinations. 0 means disabled.
+  const uint64_t reassignTimeoutMs_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -412,6 +452,7 @@ class OutputBuffer {
   uint64_t numOutputBytes_{0};
   uint64_t numOutputRows_{0};
   uint64_t numOutputPages_{0};
+  uint64_t numReassignedPages_{0};
   std::vector<ContinuePromise> promises_;
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
   // which is only used by arbitrary output type.
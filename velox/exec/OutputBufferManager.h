@@ -28,10 +28,16 @@ class OutputBufferManager {
   struct Options {
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
+    /// If true, PartitionedOutput chooses the codec of each page with the
+    /// Presto serde and records it in the page. See
+    /// PrestoVectorSerde::PrestoOptions::adaptiveCompression. The readers
+    /// must be Velox.
+    bool adaptiveCompression{false};
   };
 
   OutputBufferManager(Options options)
-      : compressionKind_(options.compressionKind) {}
+      : compressionKind_(options.compressionKind),
+        adaptiveCompression_(options.adaptiveCompression) {}
 
   void initializeTask(
       std::shared_ptr<Task> task,
@@ -143,12 +149,29 @@ class OutputBufferManager {
     return compressionKind_;
   }
 
+  bool adaptiveCompression() const {
+    return adaptiveCompression_;
+  }
+
+  /// Sets the observed network throughput for adaptive compression. Reported
+  /// by the embedding system, e.g. from the transfer rate of the results.
+  void setNetworkBytesPerSecond(uint64_t bytesPerSecond) {
+    networkBytesPerSecond_ = bytesPerSecond;
+  }
+
+  /// Returns the last value given to setNetworkBytesPerSecond() or 0.
+  uint64_t networkBytesPerSecond() const {
+    return networkBytesPerSecond_;
+  }
+
  private:
   // Retrieves the set of buffers for a query.
   // Throws an exception if buffer doesn't exist.
   std::shared_ptr<OutputBuffer> getBuffer(const std::string& taskId);
 
   const common::CompressionKind compressionKind_;
+  const bool adaptiveCompression_;
+  std::atomic<uint64_t> networkBytesPerSecond_{0};
 
   folly::Synchronized<
       std::unordered_map<std::string, std::shared_ptr<OutputBuffer>>,
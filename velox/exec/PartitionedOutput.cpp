@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/AggregateInfo.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -53,22 +54,39 @@ BlockingReason Destination::advance(
         bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
   }
 
+  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
+  if (preserveEncodings_) {
+    if (rowIdx_ == rows_.size()) {
+      *atEnd = true;
+    }
+    return serializeBatch(
+        output, rows, bufferManager, bufferReleaseFn, future, scratch);
+  }
+
   // Serialize
   if (current_ == nullptr) {
     current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
     const auto rowType = asRowType(output->type());
     if (serde_->kind() == VectorSerde::Kind::kPresto) {
       serializer::presto::PrestoVectorSerde::PrestoOptions options;
-      options.compressionKind =
-          OutputBufferManager::getInstance().lock()->compressionKind();
+      const auto bufferManager = OutputBufferManager::getInstance().lock();
+      options.compressionKind = bufferManager->compressionKind();
       options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+      if (bufferManager->adaptiveCompression()) {
+        options.adaptiveCompression = true;
+        options.networkBytesPerSecond =
+            [weakManager = std::weak_ptr<OutputBufferManager>(
+                 bufferManager)]() -> uint64_t {
+          const auto manager = weakManager.lock();
+          return manager ? manager->networkBytesPerSecond() : 0;
+        };
+      }
       current_->createStreamTree(rowType, rowsInCurrent_, &options);
     } else {
       current_->createStreamTree(rowType, rowsInCurrent_);
     }
   }
 
-  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     VELOX_CHECK_NOT_NULL(outputCompactRow);
     current_->append(*outputCompactRow, rows, sizes);
@@ -90,45 +108,99 @@ BlockingReason Destination::advance(
   return BlockingReason::kNotBlocked;
 }
 
-BlockingReason Destination::flush(
+BlockingReason Destination::serializeBatch(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows,
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
-    ContinueFuture* future) {
-  if (!current_ || rowsInCurrent_ == 0) {
-    return BlockingReason::kNotBlocked;
+    ContinueFuture* future,
+    Scratch& scratch) {
+  if (batchSerializer_ == nullptr) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options;
+    options.compressionKind =
+        OutputBufferManager::getInstance().lock()->compressionKind();
+    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.preserveEncodings = true;
+    batchSerializer_ = serde_->createBatchSerializer(pool_, &options);
+  }
+
+  // Runs of consecutive rows become one range.
+  ranges_.clear();
+  for (const auto row : rows) {
+    if (!ranges_.empty() &&
+        ranges_.back().begin + ranges_.back().size == row) {
+      ++ranges_.back().size;
+    } else {
+      ranges_.push_back(IndexRange{row, 1});
+    }
   }
 
-  // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
-      *current_->pool(),
+      *pool_,
       listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
-  const int64_t flushedRows = rowsInCurrent_;
-
-  current_->flush(&stream);
-  current_->clear();
-
-  const int64_t flushedBytes = stream.tellp();
-
+      std::max<int64_t>(kMinMessageSize, bytesInCurrent_));
+  batchSerializer_->serialize(output, ranges_, scratch, &stream);
+  const int64_t numRows = rowsInCurrent_;
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
   setTargetSizePct();
+  return enqueue(stream, numRows, bufferManager, bufferReleaseFn, future);
+}
 
-  bool blocked = bufferManager.enqueue(
+BlockingReason Destination::enqueue(
+    IOBufOutputStream& stream,
+    int64_t numRows,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const int64_t bytes = stream.tellp();
+  const bool blocked = bufferManager.enqueue(
       taskId_,
       destination_,
       std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
+          stream.getIOBuf(bufferReleaseFn), nullptr, numRows),
       future);
 
-  recordEnqueued_(flushedBytes, flushedRows);
+  recordEnqueued_(bytes, numRows);
 
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
 
+BlockingReason Destination::flush(
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  if (!current_ || rowsInCurrent_ == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  // Upper limit of message size with no columns.
+  constexpr int32_t kMinMessageSize = 128;
+  auto listener = bufferManager.newListener();
+  IOBufOutputStream stream(*current_->pool(), listener.get(), kMinMessageSize);
+  const int64_t flushedRows = rowsInCurrent_;
+
+  // The page references the serialized ranges of 'current_' instead of
+  // copying them. Their memory moves to 'serialized', which lives until the
+  // page is released.
+  auto serialized = std::make_shared<StreamArena>(current_->pool());
+  stream.enableZeroCopy(serialized);
+  current_->flush(&stream);
+  if (stream.hasReferencedRanges()) {
+    current_->moveAllocationsTo(*serialized);
+  }
+  current_->clear();
+
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
+
+  return enqueue(stream, flushedRows, bufferManager, bufferReleaseFn, future);
+}
+
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
   if (current_) {
@@ -142,6 +214,59 @@ void Destination::updateStats(Operator* op) {
 
 } // namespace detail
 
+namespace {
+std::shared_ptr<SkewedPartitionTracker> makeSkewTracker(
+    const core::PartitionedOutputNode& planNode,
+    const std::shared_ptr<core::QueryCtx>& queryCtx) {
+  const auto& skewedJoin = planNode.skewedJoin();
+  if (!skewedJoin.has_value()) {
+    return nullptr;
+  }
+  const auto& config = queryCtx->queryConfig();
+  // The join does not consume the probe side before the build side is done.
+  // The probe side must reach the decision without filling its buffer.
+  const auto decisionBytes = std::min<uint64_t>(
+      config.skewedJoinDecisionBytes(),
+      config.maxPartitionedOutputBufferSize() / 2);
+  auto tracker = SkewedPartitionTracker::getOrCreate(
+      queryCtx,
+      skewedJoin->joinId,
+      planNode.numPartitions(),
+      config.skewedJoinSplitFactor(),
+      config.skewedJoinHotPartitionRatio(),
+      decisionBytes,
+      config.skewedJoinDecisionTimeoutMs());
+  if (skewedJoin->isProbe) {
+    tracker->addProbe();
+  }
+  return tracker;
+}
+
+// Returns the intermediate aggregation over the input of 'planNode' which
+// merges the rows of its combiner, if any.
+std::shared_ptr<const core::AggregationNode> makeCombinerNode(
+    const core::PartitionedOutputNode& planNode) {
+  const auto& combiner = planNode.combiner();
+  if (!combiner.has_value()) {
+    return nullptr;
+  }
+  const auto& inputType = planNode.inputType();
+  std::vector<std::string> aggregateNames;
+  for (auto i = combiner->groupingKeys.size(); i < inputType->size(); ++i) {
+    aggregateNames.push_back(inputType->nameOf(i));
+  }
+  return std::make_shared<core::AggregationNode>(
+      fmt::format("{}.combiner", planNode.id()),
+      core::AggregationNode::Step::kIntermediate,
+      combiner->groupingKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      combiner->aggregates,
+      /*ignoreNullKeys=*/false,
+      planNode.sources()[0]);
+}
+} // namespace
+
 PartitionedOutput::PartitionedOutput(
     int32_t operatorId,
     DriverCtx* ctx,
@@ -175,7 +300,18 @@ PartitionedOutput::PartitionedOutput(
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
       eagerFlush_(eagerFlush),
-      serde_(getNamedVectorSerde(planNode->serdeKind())) {
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputPreserveEncodings()),
+      serde_(getNamedVectorSerde(planNode->serdeKind())),
+      skewTracker_(makeSkewTracker(*planNode, ctx->task->queryCtx())),
+      isSkewedJoinProbe_(
+          planNode->skewedJoin().has_value() &&
+          planNode->skewedJoin()->isProbe),
+      combinerNode_(makeCombinerNode(*planNode)),
+      combinerMaxMemory_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputCombinerMaxMemory()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -185,6 +321,45 @@ PartitionedOutput::PartitionedOutput(
   }
 }
 
+void PartitionedOutput::initialize() {
+  Operator::initialize();
+  if (combinerNode_ == nullptr) {
+    return;
+  }
+  combinerType_ = combinerNode_->sources()[0]->outputType();
+  auto hashers =
+      createVectorHashers(combinerType_, combinerNode_->groupingKeys());
+  const auto numKeys = hashers.size();
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto aggregateInfos = toAggregateInfo(
+      *combinerNode_, *operatorCtx_, numKeys, expressionEvaluator);
+  // The combined rows are sent in place of the input rows.
+  for (auto i = 0; i < aggregateInfos.size(); ++i) {
+    const auto& resultType = aggregateInfos[i].function->resultType();
+    const auto& inputType = combinerType_->childAt(numKeys + i);
+    VELOX_CHECK(
+        resultType->equivalent(*inputType),
+        "Unexpected combiner result type: {}, expected {}",
+        resultType->toString(),
+        inputType->toString());
+  }
+  combiner_ = std::make_unique<GroupingSet>(
+      combinerType_,
+      std::move(hashers),
+      std::vector<column_index_t>{},
+      std::move(aggregateInfos),
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/true,
+      /*isRawInput=*/false,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      /*spillConfig=*/nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+  combinerNode_.reset();
+}
+
 void PartitionedOutput::initializeInput(RowVectorPtr input) {
   input_ = std::move(input);
   if (outputType_->size() == 0) {
@@ -236,7 +411,8 @@ void PartitionedOutput::initializeDestinations() {
           [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          preserveEncodings_));
     }
   }
 }
@@ -275,6 +451,39 @@ void PartitionedOutput::estimateRowSizes() {
 }
 
 void PartitionedOutput::addInput(RowVectorPtr input) {
+  if (combiner_ == nullptr) {
+    processInput(std::move(input));
+    return;
+  }
+  numCombinerInputRows_ += input->size();
+  combiner_->addInput(input, /*mayPushdown=*/false);
+  if (combiner_->isPartialFull(combinerMaxMemory_)) {
+    combinerFlushing_ = true;
+  }
+}
+
+bool PartitionedOutput::addCombinerOutput() {
+  if (!combinerFlushing_ && !noMoreInput_) {
+    return false;
+  }
+  auto result = std::static_pointer_cast<RowVector>(
+      BaseVector::create(combinerType_, 0, pool()));
+  if (combiner_->getOutput(
+          outputBatchRows(combiner_->estimateOutputRowSize()),
+          operatorCtx_->driverCtx()->queryConfig().preferredOutputBatchBytes(),
+          combinerIterator_,
+          result)) {
+    numCombinerOutputRows_ += result->size();
+    processInput(std::move(result));
+    return true;
+  }
+  combiner_->resetTable(/*freeTable=*/false);
+  combinerIterator_.reset();
+  combinerFlushing_ = false;
+  return false;
+}
+
+void PartitionedOutput::processInput(RowVectorPtr input) {
   initializeInput(std::move(input));
   initializeDestinations();
   initializeSizeBuffers();
@@ -314,19 +523,89 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           }
         }
       }
+    } else if (skewTracker_ != nullptr) {
+      if (singlePartition.has_value()) {
+        partitions_.assign(numInput, singlePartition.value());
+      }
+      if (isSkewedJoinProbe_) {
+        routeSkewedProbeRows(numInput);
+        addRowsByPartition(numInput);
+      } else {
+        addSkewedBuildRows(numInput);
+      }
     } else {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        addRowsByPartition(numInput);
       }
     }
   }
 }
 
+void PartitionedOutput::routeSkewedProbeRows(vector_size_t numInput) {
+  if (!skewTracker_->decided()) {
+    partitionBytes_.assign(numDestinations_, 0);
+    for (vector_size_t i = 0; i < numInput; ++i) {
+      partitionBytes_[partitions_[i]] += rowSize_[i];
+    }
+    skewTracker_->addProbeBytes(partitionBytes_);
+  }
+  if (skewTracker_->numHotPartitions() == 0) {
+    return;
+  }
+  const auto splitFactor = skewTracker_->splitFactor();
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const auto partition = partitions_[i];
+    if (!skewTracker_->isSplit(partition)) {
+      continue;
+    }
+    const auto index = nextSplitIndex_;
+    nextSplitIndex_ = (nextSplitIndex_ + 1) % splitFactor;
+    if (index > 0) {
+      partitions_[i] = skewTracker_->destination(partition, index);
+      ++numSkewedPartitionRows_;
+    }
+  }
+}
+
+void PartitionedOutput::addSkewedBuildRows(vector_size_t numInput) {
+  VELOX_CHECK(skewTracker_->decided());
+  if (skewTracker_->numHotPartitions() == 0) {
+    addRowsByPartition(numInput);
+    return;
+  }
+  const auto splitFactor = skewTracker_->splitFactor();
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const auto partition = partitions_[i];
+    if (!skewTracker_->isSplit(partition)) {
+      destinations_[partition]->addRow(i);
+      continue;
+    }
+    for (auto index = 0; index < splitFactor; ++index) {
+      destinations_[skewTracker_->destination(partition, index)]->addRow(i);
+    }
+    numSkewedPartitionRows_ += splitFactor - 1;
+  }
+}
+
+void PartitionedOutput::addRowsByPartition(vector_size_t numInput) {
+  partitionSizes_.assign(numDestinations_, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionSizes_[partitions_[i]];
+  }
+  partitionRows_.resize(numDestinations_);
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionRows_[i] = partitionSizes_[i] == 0
+        ? nullptr
+        : destinations_[i]->addRows(partitionSizes_[i]);
+  }
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    *partitionRows_[partitions_[i]]++ = i;
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -374,49 +653,59 @@ RowVectorPtr PartitionedOutput::getOutput() {
       kMinDestinationSize,
       std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
 
-  bool workLeft;
+  // Without a combiner this loop runs once. With a combiner, it sends the
+  // batches of combined rows one after the other.
   do {
-    workLeft = false;
-    for (auto& destination : destinations_) {
-      bool atEnd = false;
-      blockingReason_ = destination->advance(
-          maxPageSize,
-          rowSize_,
-          output_,
-          outputCompactRow_.get(),
-          outputUnsafeRow_.get(),
-          *bufferManager,
-          bufferReleaseFn_,
-          &atEnd,
-          &future_,
-          scratch_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        blockedDestination = destination.get();
-        workLeft = false;
-        // We stop on first blocked. Adding data to unflushed targets
-        // would be possible but could allocate memory. We wait for
-        // free space in the outgoing queue.
-        break;
+    bool workLeft;
+    do {
+      workLeft = false;
+      for (auto& destination : destinations_) {
+        bool atEnd = false;
+        blockingReason_ = destination->advance(
+            maxPageSize,
+            rowSize_,
+            output_,
+            outputCompactRow_.get(),
+            outputUnsafeRow_.get(),
+            *bufferManager,
+            bufferReleaseFn_,
+            &atEnd,
+            &future_,
+            scratch_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          blockedDestination = destination.get();
+          workLeft = false;
+          // We stop on first blocked. Adding data to unflushed targets
+          // would be possible but could allocate memory. We wait for
+          // free space in the outgoing queue.
+          break;
+        }
+        if (!atEnd) {
+          workLeft = true;
+        }
       }
-      if (!atEnd) {
-        workLeft = true;
+    } while (workLeft);
+
+    if (blockedDestination) {
+      // If we are going off-thread, we may as well make the output in
+      // progress for other destinations available, unless it is too
+      // small to be worth transfer.
+      for (auto& destination : destinations_) {
+        if (destination.get() == blockedDestination ||
+            destination->serializedBytes() < kMinDestinationSize) {
+          continue;
+        }
+        destination->flush(*bufferManager, bufferReleaseFn_, nullptr);
       }
+      return nullptr;
     }
-  } while (workLeft);
+    // The input is fully processed, drop the reference to allow reuse.
+    input_ = nullptr;
+    output_ = nullptr;
+    outputCompactRow_.reset();
+    outputUnsafeRow_.reset();
+  } while (combiner_ != nullptr && addCombinerOutput());
 
-  if (blockedDestination) {
-    // If we are going off-thread, we may as well make the output in
-    // progress for other destinations available, unless it is too
-    // small to be worth transfer.
-    for (auto& destination : destinations_) {
-      if (destination.get() == blockedDestination ||
-          destination->serializedBytes() < kMinDestinationSize) {
-        continue;
-      }
-      destination->flush(*bufferManager, bufferReleaseFn_, nullptr);
-    }
-    return nullptr;
-  }
   // All of 'output_' is written into the destinations. We are finishing, hence
   // move all the destinations to the output queue. This will not grow memory
   // and hence does not need blocking.
@@ -433,14 +722,16 @@ RowVectorPtr PartitionedOutput::getOutput() {
     bufferManager->noMoreData(operatorCtx_->task()->taskId());
     finished_ = true;
   }
-  // The input is fully processed, drop the reference to allow reuse.
-  input_ = nullptr;
-  output_ = nullptr;
-  outputCompactRow_.reset();
-  outputUnsafeRow_.reset();
   return nullptr;
 }
 
+void PartitionedOutput::noMoreInput() {
+  Operator::noMoreInput();
+  if (skewTracker_ != nullptr && isSkewedJoinProbe_) {
+    skewTracker_->probeFinished();
+  }
+}
+
 bool PartitionedOutput::isFinished() {
   return finished_;
 }
@@ -450,6 +741,20 @@ void PartitionedOutput::close() {
   stats_.wlock()->addRuntimeStat(
       Operator::kShuffleSerdeKind,
       RuntimeCounter(static_cast<int64_t>(serde_->kind())));
+  if (skewTracker_ != nullptr) {
+    // Keeps the build side from waiting on a probe side which failed.
+    if (isSkewedJoinProbe_) {
+      skewTracker_->probeFinished();
+    }
+    stats_.wlock()->addRuntimeStat(
+        kSkewedPartitionRows, RuntimeCounter(numSkewedPartitionRows_));
+  }
+  if (combiner_ != nullptr) {
+    stats_.wlock()->addRuntimeStat(
+        kCombinedRows,
+        RuntimeCounter(numCombinerInputRows_ - numCombinerOutputRows_));
+    combiner_.reset();
+  }
   destinations_.clear();
 }
 
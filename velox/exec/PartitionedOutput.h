@@ -16,8 +16,10 @@
 #pragma once
 
 #include <folly/Random.h>
+#include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/SkewedPartitionTracker.h"
 #include "velox/row/CompactRow.h"
 #include "velox/row/UnsafeRowFast.h"
 #include "velox/vector/VectorStream.h"
@@ -35,12 +37,15 @@ class Destination {
       VectorSerde* serde,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool preserveEncodings = false)
       : taskId_(taskId),
         destination_(destination),
         serde_(serde),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        preserveEncodings_(
+            preserveEncodings && serde->kind() == VectorSerde::Kind::kPresto),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -61,6 +66,14 @@ class Destination {
     }
   }
 
+  /// Adds space for 'numRows' row numbers and returns a pointer to it. The
+  /// caller fills in the row numbers.
+  vector_size_t* addRows(vector_size_t numRows) {
+    const auto size = rows_.size();
+    rows_.resize(size + numRows);
+    return rows_.data() + size;
+  }
+
   /// Serializes row from 'output' till either 'maxBytes' have been serialized
   /// or
   BlockingReason advance(
@@ -103,6 +116,24 @@ class Destination {
   // traffic pattern where all consumers contend for the network at
   // the same time. This is done for each batch so that the average
   // batch size for each converges.
+  // Serializes 'rows' of 'output' into a SerializedPage of their own with
+  // the batch serializer, which keeps the encodings of 'output'.
+  BlockingReason serializeBatch(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future,
+      Scratch& scratch);
+
+  // Enqueues the data in 'stream' as a page of 'numRows' rows.
+  BlockingReason enqueue(
+      IOBufOutputStream& stream,
+      int64_t numRows,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   void setTargetSizePct() {
     // Flush at 70 to 120% of target row or byte count.
     targetSizePct_ = 70 + (folly::Random::rand32(rng_) % 50);
@@ -114,6 +145,9 @@ class Destination {
   VectorSerde* const serde_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  // If true, each batch of rows is serialized by 'batchSerializer_' into a
+  // page of its own instead of being accumulated in 'current_'.
+  const bool preserveEncodings_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -128,6 +162,10 @@ class Destination {
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+  // Used instead of 'current_' if 'preserveEncodings_' is set.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  // The ranges of rows passed to 'batchSerializer_'.
+  std::vector<IndexRange> ranges_;
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -159,12 +197,23 @@ class PartitionedOutput : public Operator {
   /// network MTU of 64K.
   static constexpr uint64_t kMinDestinationSize = 60 * 1024;
 
+  /// Runtime stat with the number of rows of split hot partitions. Probe side
+  /// rows moved to another destination and build side rows replicated to the
+  /// extra destinations.
+  static inline const std::string kSkewedPartitionRows{"skewedPartitionRows"};
+
+  /// Runtime stat with the number of input rows merged into other rows by the
+  /// combiner.
+  static inline const std::string kCombinedRows{"combinedRows"};
+
   PartitionedOutput(
       int32_t operatorId,
       DriverCtx* ctx,
       const std::shared_ptr<const core::PartitionedOutputNode>& planNode,
       bool eagerFlush);
 
+  void initialize() override;
+
   void addInput(RowVectorPtr input) override;
 
   /// Always returns nullptr. The action is to further process
@@ -172,10 +221,11 @@ class PartitionedOutput : public Operator {
   /// a non-blocked state, otherwise blocked.
   RowVectorPtr getOutput() override;
 
-  /// always true but the caller will check isBlocked before adding input, hence
-  /// the blocked state does not accumulate input.
+  /// True unless the combined rows are being sent. The caller will check
+  /// isBlocked before adding input, hence the blocked state does not
+  /// accumulate input.
   bool needsInput() const override {
-    return true;
+    return !combinerFlushing_;
   }
 
   BlockingReason isBlocked(ContinueFuture* future) override {
@@ -184,9 +234,17 @@ class PartitionedOutput : public Operator {
       blockingReason_ = BlockingReason::kNotBlocked;
       return BlockingReason::kWaitForConsumer;
     }
+    // The build side of a skewed join sends no rows before the hot
+    // partitions are decided.
+    if (skewTracker_ != nullptr && !isSkewedJoinProbe_ && !noMoreInput_ &&
+        !skewTracker_->decided(future)) {
+      return BlockingReason::kWaitForJoinProbe;
+    }
     return BlockingReason::kNotBlocked;
   }
 
+  void noMoreInput() override;
+
   bool isFinished() override;
 
   void close() override;
@@ -200,6 +258,15 @@ class PartitionedOutput : public Operator {
   }
 
  private:
+  // Partitions 'input' to the destinations. The rows are serialized and sent
+  // by getOutput().
+  void processInput(RowVectorPtr input);
+
+  // Processes the next batch of combined rows when the combiner is full or at
+  // the end of input. Returns false and resets the combiner when all the
+  // combined rows have been processed.
+  bool addCombinerOutput();
+
   void initializeInput(RowVectorPtr input);
 
   void initializeDestinations();
@@ -211,6 +278,21 @@ class PartitionedOutput : public Operator {
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Adds the rows of 'input_' to their destination in 'partitions_'. Builds
+  // the row numbers of each destination in a counting pass instead of adding
+  // the rows one by one.
+  void addRowsByPartition(vector_size_t numInput);
+
+  // Routes the rows of the hot partitions on the probe side of a skewed join.
+  // Reports the bytes of each partition to 'skewTracker_' until the hot
+  // partitions are decided. Then spreads the rows of the split partitions
+  // over their destinations in 'partitions_'.
+  void routeSkewedProbeRows(vector_size_t numInput);
+
+  // Adds the rows of 'input_' to their destinations on the build side of a
+  // skewed join. The rows of split partitions go to all their destinations.
+  void addSkewedBuildRows(vector_size_t numInput);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -225,7 +307,22 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
   VectorSerde* const serde_;
+  // Set if the destinations of the hot partitions of a skewed join are split.
+  const std::shared_ptr<SkewedPartitionTracker> skewTracker_;
+  const bool isSkewedJoinProbe_;
+  // The intermediate aggregation of the combiner. Cleared after initialize().
+  std::shared_ptr<const core::AggregationNode> combinerNode_;
+  const uint64_t combinerMaxMemory_;
+  // Merges the input rows with equal grouping keys if set.
+  std::unique_ptr<GroupingSet> combiner_;
+  RowTypePtr combinerType_;
+  RowContainerIterator combinerIterator_;
+  // True while the combined rows are sent.
+  bool combinerFlushing_{false};
+  int64_t numCombinerInputRows_{0};
+  int64_t numCombinerOutputRows_{0};
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -253,8 +350,17 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // The number of rows of the current input for each destination.
+  std::vector<vector_size_t> partitionSizes_;
+  // The next row number position of each destination in addRowsByPartition().
+  std::vector<vector_size_t*> partitionRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
+  // The probe side bytes of the current input for each partition.
+  std::vector<uint64_t> partitionBytes_;
+  // The next of the destinations of a split partition for a probe side row.
+  int32_t nextSplitIndex_{0};
+  int64_t numSkewedPartitionRows_{0};
 };
 
 } // namespace facebook::velox::exec
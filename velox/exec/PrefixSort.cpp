@@ -43,6 +43,25 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefixBuffer + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    column_index_t index,
+    const RowColumn& rowColumn,
+    char* row,
+    char* prefixBuffer) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value,
+      prefixBuffer + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.stringPrefixLength);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -86,6 +105,12 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefixBuffer);
       return;
     }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(
+          prefixSortLayout, index, rowColumn, row, prefixBuffer);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -124,12 +149,27 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
   return 0;
 }
 
+// Returns the comparator for the sort keys after the normalized prefix.
+CompiledKeyComparator makeNonNormalizedKeyComparator(
+    const RowContainer* rowContainer,
+    const PrefixSortLayout& sortLayout) {
+  std::vector<column_index_t> columns;
+  std::vector<CompareFlags> flags;
+  for (auto i = sortLayout.nonPrefixSortStartIndex; i < sortLayout.numKeys;
+       ++i) {
+    columns.push_back(i);
+    flags.push_back(sortLayout.compareFlags[i]);
+  }
+  return CompiledKeyComparator(rowContainer, columns, flags);
+}
+
 } // namespace
 
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   prefixOffsets.reserve(numKeys);
@@ -140,7 +180,28 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
   // cannot be normalized is encountered.
   uint32_t normalizedKeySize{0};
   uint32_t numNormalizedKeys{0};
+  uint32_t stringPrefixLength{0};
   for (auto i = 0; i < numKeys; ++i) {
+    const auto kind = types[i]->kind();
+    if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      // The prefix of a string key may be followed by a different suffix, so
+      // the keys after it can not be ordered by the prefix. The string key is
+      // the last normalized key and ties are broken from it on.
+      const auto availableBytes = maxNormalizedKeySize > normalizedKeySize
+          ? maxNormalizedKeySize - normalizedKeySize - 1
+          : 0;
+      stringPrefixLength = std::min(maxStringPrefixLength, availableBytes);
+      if (stringPrefixLength == 0 || types[i]->providesCustomComparison()) {
+        stringPrefixLength = 0;
+        break;
+      }
+      prefixOffsets.push_back(normalizedKeySize);
+      encoders.push_back(
+          {compareFlags[i].ascending, compareFlags[i].nullsFirst});
+      normalizedKeySize += 1 + stringPrefixLength;
+      ++numNormalizedKeys;
+      break;
+    }
     const std::optional<uint32_t> encodedSize =
         PrefixSortEncoder::encodedSize(types[i]->kind());
     if (!encodedSize.has_value() ||
@@ -155,15 +216,19 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
 
   const auto numPaddingBytes = alignmentPadding(normalizedKeySize, kAlignment);
   normalizedKeySize += numPaddingBytes;
+  const uint32_t nonPrefixSortStartIndex =
+      stringPrefixLength > 0 ? numNormalizedKeys - 1 : numNormalizedKeys;
 
   return PrefixSortLayout{
       normalizedKeySize + sizeof(char*),
       normalizedKeySize,
       numNormalizedKeys,
       numKeys,
+      nonPrefixSortStartIndex,
+      stringPrefixLength,
       compareFlags,
       numNormalizedKeys != 0,
-      numNormalizedKeys < numKeys,
+      nonPrefixSortStartIndex < numKeys,
       std::move(prefixOffsets),
       std::move(encoders),
       numPaddingBytes};
@@ -183,23 +248,19 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   }
 
   // If prefixes are equal, compare the remaining sort keys with rowContainer.
-  char* leftRow = getRowAddrFromPrefixBuffer(left);
-  char* rightRow = getRowAddrFromPrefixBuffer(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
-    result = rowContainer_->compare(
-        leftRow, rightRow, i, sortLayout_.compareFlags[i]);
-    if (result != 0) {
-      return result;
-    }
-  }
-  return result;
+  return nonNormalizedKeyComparator_.compare(
+      getRowAddrFromPrefixBuffer(left), getRowAddrFromPrefixBuffer(right));
 }
 
 PrefixSort::PrefixSort(
     const RowContainer* rowContainer,
     const PrefixSortLayout& sortLayout,
     memory::MemoryPool* pool)
-    : rowContainer_(rowContainer), sortLayout_(sortLayout), pool_(pool) {}
+    : rowContainer_(rowContainer),
+      sortLayout_(sortLayout),
+      pool_(pool),
+      nonNormalizedKeyComparator_(
+          makeNonNormalizedKeyComparator(rowContainer, sortLayout)) {}
 
 void PrefixSort::extractRowAndEncodePrefixKeys(char* row, char* prefixBuffer) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
@@ -241,7 +302,10 @@ uint32_t PrefixSort::maxRequiredBytes(
   }
   VELOX_CHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
   const auto sortLayout = PrefixSortLayout::makeSortLayout(
-      rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+      rowContainer->keyTypes(),
+      compareFlags,
+      config.maxNormalizedKeySize,
+      config.maxStringPrefixLength);
   if (!sortLayout.hasNormalizedKeys) {
     return 0;
   }
@@ -255,15 +319,11 @@ void PrefixSort::stdSort(
     std::vector<char*, memory::StlAllocator<char*>>& rows,
     const RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
+  const auto comparator =
+      CompiledKeyComparator::forKeys(rowContainer, compareFlags);
   std::sort(
       rows.begin(), rows.end(), [&](const char* leftRow, const char* rightRow) {
-        for (auto i = 0; i < compareFlags.size(); ++i) {
-          if (auto result = rowContainer->compare(
-                  leftRow, rightRow, i, compareFlags[i])) {
-            return result < 0;
-          }
-        }
-        return false;
+        return comparator.compare(leftRow, rightRow) < 0;
       });
 }
 
@@ -279,7 +339,8 @@ uint32_t PrefixSort::maxRequiredBytes() const {
 }
 
 void PrefixSort::sortInternal(
-    std::vector<char*, memory::StlAllocator<char*>>& rows) {
+    std::vector<char*, memory::StlAllocator<char*>>& rows,
+    int32_t radixSortMinRows) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixBufferAlloc;
@@ -303,7 +364,35 @@ void PrefixSort::sortInternal(
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     auto* prefixBufferStart = prefixBuffer;
     auto* prefixBufferEnd = prefixBuffer + numRows * entrySize;
-    if (sortLayout_.hasNonNormalizedKey) {
+    if (static_cast<int64_t>(numRows) >= radixSortMinRows) {
+      // The normalized keys are compared as uint64 words and each word has
+      // its bytes swapped, so the i-th key byte is the (7 - i % 8)-th byte of
+      // its word.
+      const auto keyByte = [](const char* prefix, uint32_t index) {
+        return static_cast<uint8_t>(prefix[(index & ~7u) + 7 - (index & 7u)]);
+      };
+      const uint32_t numKeyBytes =
+          sortLayout_.normalizedBufferSize - sortLayout_.numPaddingBytes;
+      if (sortLayout_.hasNonNormalizedKey) {
+        sortRunner.radixSort(
+            prefixBufferStart,
+            prefixBufferEnd,
+            numKeyBytes,
+            keyByte,
+            [&](char* lhs, char* rhs) {
+              return comparePartNormalizedKeys(lhs, rhs);
+            });
+      } else {
+        sortRunner.radixSort(
+            prefixBufferStart,
+            prefixBufferEnd,
+            numKeyBytes,
+            keyByte,
+            [&](char* lhs, char* rhs) {
+              return compareAllNormalizedKeys(lhs, rhs);
+            });
+      }
+    } else if (sortLayout_.hasNonNormalizedKey) {
       sortRunner.quickSort(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
             return comparePartNormalizedKeys(lhs, rhs);
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/base/PrefixSortConfig.h"
+#include "velox/exec/CompiledKeyComparator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
 #include "velox/exec/prefixsort/PrefixSortEncoder.h"
@@ -23,14 +24,13 @@
 namespace facebook::velox::exec {
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. A string key is stored as its leading bytes and is
+/// the last normalized key.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -42,6 +42,16 @@ struct PrefixSortLayout {
   /// The num of sort keys include normalized and non-normalized.
   const uint32_t numKeys;
 
+  /// Index of the first sort key to compare with the RowContainer when the
+  /// normalized keys are equal. This is the index of the last normalized key
+  /// if it is a string key, as its prefix may not be the full value.
+  /// Otherwise, this is 'numNormalizedKeys'.
+  const uint32_t nonPrefixSortStartIndex;
+
+  /// Number of leading bytes stored for the string key that is the last
+  /// normalized key. 0 if there is no string key in the normalized keys.
+  const uint32_t stringPrefixLength;
+
   /// CompareFlags of all sort keys.
   const std::vector<CompareFlags> compareFlags;
 
@@ -49,7 +59,8 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys != 0', a little faster.
   const bool hasNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether equal normalized keys must be compared with the RowContainer.
+  /// True if the sort keys contain a non-normalized key or a string key.
   const bool hasNonNormalizedKey;
 
   /// Offsets of normalized keys, used to find write locations when
@@ -66,7 +77,8 @@ struct PrefixSortLayout {
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength = 0);
 };
 
 class PrefixSort {
@@ -82,16 +94,16 @@ class PrefixSort {
   /// normalized, normalize it. For this kind of keys can be normalized，we
   /// combine them with the original row address ptr and store them
   /// together into a buffer, called 'Prefix'.
-  /// 3. Sort the prefixes data we got in step 2.
+  /// 3. Sort the prefixes data we got in step 2. With at least
+  /// config.radixSortMinRows rows, the prefixes are radix sorted on the
+  /// normalized key bytes first. Otherwise they are quick sorted.
   /// For keys can normalized(All fixed width types), we use 'memcmp' to compare
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For string keys (Varchar, Varbinary), we store the leading bytes in the
+  /// prefix and compare the keys from the string key on with RowContainer
+  /// when the prefixes are equal. No keys after a string key are normalized.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
@@ -112,7 +124,10 @@ class PrefixSort {
 
     VELOX_CHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with stdSort.
     if (!sortLayout.hasNormalizedKeys) {
@@ -121,7 +136,7 @@ class PrefixSort {
     }
 
     PrefixSort prefixSort(rowContainer, sortLayout, pool);
-    prefixSort.sortInternal(rows);
+    prefixSort.sortInternal(rows, config.radixSortMinRows);
   }
 
   /// The std::sort won't require bytes while prefix sort may require buffers
@@ -146,7 +161,9 @@ class PrefixSort {
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
-  void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
+  void sortInternal(
+      std::vector<char*, memory::StlAllocator<char*>>& rows,
+      int32_t radixSortMinRows);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -164,5 +181,7 @@ class PrefixSort {
   const RowContainer* const rowContainer_;
   const PrefixSortLayout sortLayout_;
   memory::MemoryPool* const pool_;
+  // Compares the keys that are not in the normalized prefix.
+  const CompiledKeyComparator nonNormalizedKeyComparator_;
 };
 } // namespace facebook::velox::exec
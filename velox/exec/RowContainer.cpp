@@ -139,14 +139,16 @@ RowContainer::RowContainer(
     bool isJoinBuild,
     bool hasProbedFlag,
     bool hasNormalizedKeys,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    int32_t coldPayloadMinBytes)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
       hasNormalizedKeys_(hasNormalizedKeys),
       stringAllocator_(std::make_unique<HashStringAllocator>(pool)),
       accumulators_(accumulators),
-      rows_(pool) {
+      rows_(pool),
+      coldRecords_(pool) {
   // Compute the layout of the payload row.  The row has keys, null flags,
   // accumulators, dependent fields. All fields are fixed width. If variable
   // width data is referenced, this is done with StringView(for VARCHAR) and
@@ -168,6 +170,13 @@ RowContainer::RowContainer(
   // build side, the pointer to the next row with the same key is after the
   // optional row size.
   //
+  // If the dependents of a join build side are wide, they are moved to a cold
+  // record that is allocated with the row. The row then has a pointer to the
+  // cold record in place of the dependents and no null flags for them. The
+  // cold record has a null bit for each dependent followed by the dependents.
+  // The variable width data of the cold record is tracked by the row size of
+  // the row.
+  //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
   // bit unique digest of the keys for speeding up comparison. This
@@ -211,11 +220,23 @@ RowContainer::RowContainer(
     usesExternalMemory_ |= accumulator.usesExternalMemory();
     alignment_ = combineAlignments(accumulator.alignment(), alignment_);
   }
+  int32_t dependentsSize = 0;
+  bool canBeCold = coldPayloadMinBytes > 0 && isJoinBuild_ &&
+      accumulators.empty() && !dependentTypes.empty();
+  for (auto& type : dependentTypes) {
+    dependentsSize += typeKindSize(type->kind());
+    canBeCold &= type->kind() != TypeKind::OPAQUE &&
+        type->kind() != TypeKind::UNKNOWN;
+  }
+  const bool coldDependents =
+      canBeCold && dependentsSize >= coldPayloadMinBytes;
   for (auto& type : dependentTypes) {
     types_.push_back(type);
     typeKinds_.push_back(type->kind());
-    nullOffsets_.push_back(nullOffset);
-    ++nullOffset;
+    if (!coldDependents) {
+      nullOffsets_.push_back(nullOffset);
+      ++nullOffset;
+    }
     isVariableWidth |= !type->isFixedWidth();
     columnHasNulls_.push_back(false);
   }
@@ -241,9 +262,20 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
-  for (auto& type : dependentTypes) {
-    offsets_.push_back(offset);
-    offset += typeKindSize(type->kind());
+  if (coldDependents) {
+    int32_t coldOffset = bits::nbytes(dependentTypes.size());
+    for (auto& type : dependentTypes) {
+      offsets_.push_back(coldOffset);
+      coldOffset += typeKindSize(type->kind());
+    }
+    coldRecordSize_ = coldOffset;
+    coldRecordOffset_ = offset;
+    offset += sizeof(char*);
+  } else {
+    for (auto& type : dependentTypes) {
+      offsets_.push_back(offset);
+      offset += typeKindSize(type->kind());
+    }
   }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
@@ -268,6 +300,11 @@ RowContainer::RowContainer(
   normalizedKeySize_ = originalNormalizedKeySize_;
   size_t nullOffsetsPos = 0;
   for (auto i = 0; i < offsets_.size(); ++i) {
+    if (coldDependents && i >= keyTypes_.size()) {
+      // The null bit of a cold dependent is in its cold record.
+      rowColumns_.emplace_back(offsets_[i], i - keyTypes_.size());
+      continue;
+    }
     rowColumns_.emplace_back(
         offsets_[i],
         (nullableKeys_ || i >= keyTypes_.size()) ? nullOffsets_[nullOffsetsPos]
@@ -293,11 +330,15 @@ char* RowContainer::newRow() {
   VELOX_DCHECK(mutable_, "Can't add row into an immutable row container");
   ++numRows_;
   char* row;
+  char* coldRecord = nullptr;
   if (firstFreeRow_) {
     row = firstFreeRow_;
     VELOX_CHECK(bits::isBitSet(row, freeFlagOffset_));
     firstFreeRow_ = nextFree(row);
     --numFreeRows_;
+    if (coldRecordOffset_) {
+      coldRecord = coldRecordAt(row);
+    }
   } else {
     row = rows_.allocateFixed(fixedRowSize_ + normalizedKeySize_, alignment_) +
         normalizedKeySize_;
@@ -305,7 +346,20 @@ char* RowContainer::newRow() {
       ++numRowsWithNormalizedKey_;
     }
   }
-  return initializeRow(row, false /* reuse */);
+  initializeRow(row, false /* reuse */);
+  if (coldRecordOffset_) {
+    initializeColdRecord(row, coldRecord);
+  }
+  return row;
+}
+
+void RowContainer::initializeColdRecord(char* row, char* record) {
+  if (record == nullptr) {
+    record = coldRecords_.allocateFixed(coldRecordSize_);
+  }
+  // Clears the null flags and the string views of the dependents.
+  ::memset(record, 0, coldRecordSize_);
+  coldRecordAt(row) = record;
 }
 
 char* RowContainer::initializeRow(char* row, bool reuse) {
@@ -331,6 +385,9 @@ char* RowContainer::initializeRow(char* row, bool reuse) {
   if (nextOffset_) {
     getNextRowVector(row) = nullptr;
   }
+  if (reuse && coldRecordOffset_) {
+    initializeColdRecord(row, coldRecordAt(row));
+  }
   bits::clearBit(row, freeFlagOffset_);
   return row;
 }
@@ -496,6 +553,17 @@ void RowContainer::store(
     vector_size_t index,
     char* row,
     int32_t column) {
+  if (isColdColumn(column)) {
+    VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+        storeColdValue,
+        typeKinds_[column],
+        decoded,
+        index,
+        row,
+        rowColumns_[column],
+        column);
+    return;
+  }
   auto numKeys = keyTypes_.size();
   bool isKey = column < numKeys;
   if (isKey && !nullableKeys_) {
@@ -529,6 +597,11 @@ void RowContainer::store(
     folly::Range<char**> rows,
     int32_t column) {
   VELOX_CHECK_GE(decoded.size(), rows.size());
+  if (isColdColumn(column)) {
+    VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+        storeColdBatch, typeKinds_[column], decoded, rows, column);
+    return;
+  }
   const bool isKey = column < keyTypes_.size();
   if ((isKey && !nullableKeys_) || !decoded.mayHaveNulls()) {
     VELOX_DYNAMIC_TYPE_DISPATCH(
@@ -566,6 +639,9 @@ std::unique_ptr<ByteInputStream> RowContainer::prepareRead(
 int32_t RowContainer::variableSizeAt(const char* row, column_index_t column)
     const {
   const auto rowColumn = rowColumns_[column];
+  if (isColdColumn(column)) {
+    row = coldRecordAt(row);
+  }
 
   if (isNullAt(row, rowColumn)) {
     return 0;
@@ -666,6 +742,7 @@ void RowContainer::extractSerializedRows(
   // dependent columns. Fixed-width columns are serialized into fixed number of
   // bytes (see typeKindSize). Variable-width columns are serialized as 4 bytes
   // of size followed by that many bytes.
+  VELOX_CHECK_EQ(coldRecordOffset_, 0, "Cold records are not serialized");
 
   // First, calculate total number of bytes needed to serialize all rows.
 
@@ -735,6 +812,7 @@ void RowContainer::storeSerializedRow(
     vector_size_t index,
     char* row) {
   VELOX_CHECK(!vector.isNullAt(index));
+  VELOX_CHECK_EQ(coldRecordOffset_, 0, "Cold records are not serialized");
   auto serialized = vector.valueAt(index);
   size_t offset = 0;
 
@@ -789,6 +867,15 @@ void RowContainer::storeComplexType(
     return;
   }
   RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+  serializeComplexType(decoded, index, isKey, row, offset);
+}
+
+void RowContainer::serializeComplexType(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    bool isKey,
+    char* row,
+    int32_t offset) {
   ByteOutputStream stream(stringAllocator_.get(), false, false);
   auto position = stringAllocator_->newWrite(stream);
   ContainerRowSerdeOptions options{.isKey = isKey};
@@ -938,6 +1025,56 @@ void RowContainer::hash(
   }
 }
 
+std::vector<const char*> RowContainer::coldRecords(
+    const char* const* rows,
+    int32_t numRows) const {
+  std::vector<const char*> records(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    records[i] = rows[i] ? coldRecordAt(rows[i]) : nullptr;
+  }
+  return records;
+}
+
+void RowContainer::extractColdColumn(
+    const char* const* rows,
+    int32_t numRows,
+    int32_t columnIndex,
+    bool columnHasNulls,
+    vector_size_t resultOffset,
+    const VectorPtr& result) const {
+  VELOX_DCHECK(isColdColumn(columnIndex));
+  const auto records = coldRecords(rows, numRows);
+  extractColumn(
+      records.data(),
+      numRows,
+      rowColumns_[columnIndex],
+      columnHasNulls,
+      resultOffset,
+      result);
+}
+
+void RowContainer::extractColdColumn(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t columnIndex,
+    bool columnHasNulls,
+    vector_size_t resultOffset,
+    const VectorPtr& result) const {
+  VELOX_DCHECK(isColdColumn(columnIndex));
+  vector_size_t numRows = 0;
+  for (const auto rowNumber : rowNumbers) {
+    numRows = std::max(numRows, rowNumber + 1);
+  }
+  const auto records = coldRecords(rows, numRows);
+  extractColumn(
+      records.data(),
+      rowNumbers,
+      rowColumns_[columnIndex],
+      columnHasNulls,
+      resultOffset,
+      result);
+}
+
 void RowContainer::clear() {
   if (usesExternalMemory_) {
     constexpr int32_t kBatch = 1000;
@@ -952,6 +1089,7 @@ void RowContainer::clear() {
   hasDuplicateRows_ = false;
 
   rows_.clear();
+  coldRecords_.clear();
   stringAllocator_->clear();
   numRows_ = 0;
   numRowsWithNormalizedKey_ = 0;
@@ -1008,9 +1146,11 @@ std::optional<int64_t> RowContainer::estimateRowSize() const {
   if (numRows_ == 0) {
     return std::nullopt;
   }
-  int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
-  int64_t usedSize = rows_.allocatedBytes() - freeBytes +
-      stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
+  int64_t freeBytes = rows_.freeBytes() + coldRecords_.freeBytes() +
+      (fixedRowSize_ + coldRecordSize_) * numFreeRows_;
+  int64_t usedSize = rows_.allocatedBytes() + coldRecords_.allocatedBytes() -
+      freeBytes + stringAllocator_->retainedSize() -
+      stringAllocator_->freeSpace();
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
       rowSize, 0, "Estimated row size of the RowContainer must be positive.");
@@ -1026,7 +1166,8 @@ int64_t RowContainer::sizeIncrement(
   int32_t needRows = std::max<int64_t>(0, numRows - numFreeRows_);
   int64_t needBytes =
       std::max<int64_t>(0, variableLengthBytes - stringAllocator_->freeSpace());
-  return bits::roundUp(needRows * fixedRowSize_, kAllocUnit) +
+  return bits::roundUp(
+             needRows * (fixedRowSize_ + coldRecordSize_), kAllocUnit) +
       bits::roundUp(needBytes, kAllocUnit);
 }
 
@@ -1188,7 +1329,7 @@ std::string RowContainer::toString(const char* row) const {
   auto vector = BaseVector::create<RowVector>(rowType, 1, pool());
 
   for (auto i = 0; i < rowType->size(); ++i) {
-    extractColumn(&row, 1, columnAt(i), 0, vector->childAt(i));
+    extractColumn(&row, 1, i, vector->childAt(i));
   }
 
   return vector->toString(0);
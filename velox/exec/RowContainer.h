@@ -226,7 +226,11 @@ class RowContainer {
   /// below each row for a normalized key that collapses all parts
   /// into one word for faster comparison. The bulk allocation is done
   /// from 'allocator'. ContainerRowSerde is used for serializing complex
-  /// type values into the container.
+  /// type values into the container. If 'coldPayloadMinBytes' is not 0 and
+  /// the dependents of a join build side take at least that many bytes in the
+  /// row, the dependents are stored in a separately allocated cold record
+  /// referenced from the row. This keeps the rows that are accessed when
+  /// probing the keys small.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -236,13 +240,14 @@ class RowContainer {
       bool isJoinBuild,
       bool hasProbedFlag,
       bool hasNormalizedKey,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      int32_t coldPayloadMinBytes = 0);
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
 
   uint32_t rowSize(const char* row) const {
-    return fixedRowSize_ +
+    return fixedRowSize_ + coldRecordSize_ +
         (rowSizeOffset_
              ? *reinterpret_cast<const uint32_t*>(row + rowSizeOffset_)
              : 0);
@@ -258,7 +263,8 @@ class RowContainer {
     }
   }
 
-  /// The row size excluding any out-of-line stored variable length values.
+  /// The row size excluding any out-of-line stored variable length values and
+  /// the cold record.
   int32_t fixedRowSize() const {
     return fixedRowSize_;
   }
@@ -389,6 +395,35 @@ class RowContainer {
       RowColumn col,
       const BufferPtr& result);
 
+  /// True if 'column' is stored in the cold record of the row. The RowColumn
+  /// of such a column is relative to the cold record, so it is accessed only
+  /// through the methods of 'this' that take a column index.
+  bool isColdColumn(column_index_t column) const {
+    return coldRecordOffset_ != 0 && column >= keyTypes_.size();
+  }
+
+  /// Copies the values of the cold column at 'columnIndex' into 'result'
+  /// (starting at 'resultOffset') for the 'numRows' rows pointed to by 'rows'.
+  /// The rows may come from any container with the same layout as 'this',
+  /// e.g. the containers of a hash table built in parallel, so the caller
+  /// provides 'columnHasNulls'.
+  void extractColdColumn(
+      const char* const* rows,
+      int32_t numRows,
+      int32_t columnIndex,
+      bool columnHasNulls,
+      vector_size_t resultOffset,
+      const VectorPtr& result) const;
+
+  /// Like above for the rows at positions in the 'rowNumbers' array.
+  void extractColdColumn(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t columnIndex,
+      bool columnHasNulls,
+      vector_size_t resultOffset,
+      const VectorPtr& result) const;
+
   /// Copies the values at 'columnIndex' into 'result' for the 'numRows' rows
   /// pointed to by 'rows'. If an entry in 'rows' is null, sets corresponding
   /// row in 'result' to null.
@@ -397,12 +432,7 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       const VectorPtr& result) const {
-    extractColumn(
-        rows,
-        numRows,
-        columnAt(columnIndex),
-        columnHasNulls(columnIndex),
-        result);
+    extractColumn(rows, numRows, columnIndex, 0, result);
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -414,6 +444,16 @@ class RowContainer {
       int32_t columnIndex,
       int32_t resultOffset,
       const VectorPtr& result) const {
+    if (isColdColumn(columnIndex)) {
+      extractColdColumn(
+          rows,
+          numRows,
+          columnIndex,
+          columnHasNulls(columnIndex),
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows,
         numRows,
@@ -436,6 +476,16 @@ class RowContainer {
       int32_t columnIndex,
       const vector_size_t resultOffset,
       const VectorPtr& result) const {
+    if (isColdColumn(columnIndex)) {
+      extractColdColumn(
+          rows,
+          rowNumbers,
+          columnIndex,
+          columnHasNulls(columnIndex),
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows,
         rowNumbers,
@@ -451,6 +501,11 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       const BufferPtr& result) const {
+    if (isColdColumn(columnIndex)) {
+      const auto records = coldRecords(rows, numRows);
+      extractNulls(records.data(), numRows, rowColumns_[columnIndex], result);
+      return;
+    }
     extractNulls(rows, numRows, columnAt(columnIndex), result);
   }
 
@@ -647,6 +702,7 @@ class RowContainer {
   }
 
   RowColumn columnAt(int32_t index) const {
+    VELOX_DCHECK(!isColdColumn(index), "Column {} is cold", index);
     return rowColumns_[index];
   }
 
@@ -696,7 +752,8 @@ class RowContainer {
       uint64_t* result) const;
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + coldRecords_.allocatedBytes() +
+        stringAllocator_->retainedSize();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -808,6 +865,8 @@ class RowContainer {
   std::string toString(const char* row) const;
 
  private:
+  friend class CompiledKeyComparator;
+
   // Offset of the pointer to the next free row on a free row.
   static constexpr int32_t kNextFreeOffset = 0;
 
@@ -961,6 +1020,74 @@ class RowContainer {
     }
   }
 
+  // Stores the 'index'th value in 'decoded' into the cold record of 'row'.
+  // Variable width data is accounted in the row size of 'row'.
+  template <TypeKind Kind>
+  inline void storeColdValue(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      RowColumn column,
+      int32_t columnIndex) {
+    char* record = coldRecordAt(row);
+    if constexpr (
+        Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
+        Kind == TypeKind::MAP || Kind == TypeKind::VARCHAR ||
+        Kind == TypeKind::VARBINARY) {
+      if (decoded.isNullAt(index)) {
+        record[column.nullByte()] |= column.nullMask();
+        updateColumnHasNulls(columnIndex, true);
+        return;
+      }
+      RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+      if constexpr (
+          Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
+        stringAllocator_->copyMultipart(
+            decoded.valueAt<StringView>(index), record, column.offset());
+      } else {
+        serializeComplexType(decoded, index, false, record, column.offset());
+      }
+    } else {
+      storeWithNulls<Kind>(
+          decoded,
+          index,
+          false,
+          record,
+          column.offset(),
+          column.nullByte(),
+          column.nullMask(),
+          columnIndex);
+    }
+  }
+
+  template <TypeKind Kind>
+  inline void storeColdBatch(
+      const DecodedVector& decoded,
+      folly::Range<char**> rows,
+      int32_t columnIndex) {
+    const auto column = rowColumns_[columnIndex];
+    for (int32_t i = 0; i < rows.size(); ++i) {
+      storeColdValue<Kind>(decoded, i, rows[i], column, columnIndex);
+    }
+  }
+
+  // Zeroes 'record' and sets it as the cold record of 'row'. Allocates a new
+  // record if 'record' is null.
+  void initializeColdRecord(char* row, char* record);
+
+  char*& coldRecordAt(char* row) const {
+    return *reinterpret_cast<char**>(row + coldRecordOffset_);
+  }
+
+  const char* coldRecordAt(const char* row) const {
+    return *reinterpret_cast<char* const*>(row + coldRecordOffset_);
+  }
+
+  // Returns the cold records of 'rows'. The record of a null row is null.
+  std::vector<const char*> coldRecords(
+      const char* const* rows,
+      int32_t numRows) const;
+
   template <TypeKind Kind>
   inline void storeWithNullsBatch(
       const DecodedVector& decoded,
@@ -1265,6 +1392,15 @@ class RowContainer {
       uint8_t nullMask = 0,
       int32_t column = 0);
 
+  // Serializes the 'index'th value in 'decoded' into the allocator and sets
+  // the std::string_view at 'offset' in 'row' to it.
+  void serializeComplexType(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      bool isKey,
+      char* row,
+      int32_t offset);
+
   template <bool useRowNumbers>
   static void extractComplexType(
       const char* const* rows,
@@ -1342,13 +1478,15 @@ class RowContainer {
         std::is_same_v<FieldType, StringView> ||
         std::is_same_v<FieldType, std::string_view>);
 
-    const auto column = columnAt(column_index);
-    for (auto row : rows) {
-      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+    const auto column = rowColumns_[column_index];
+    const bool cold = isColdColumn(column_index);
+    for (auto* row : rows) {
+      char* data = cold ? coldRecordAt(row) : row;
+      if (isNullAt(data, column.nullByte(), column.nullMask())) {
         continue;
       }
 
-      auto& view = valueAt<FieldType>(row, column.offset());
+      auto& view = valueAt<FieldType>(data, column.offset());
       if constexpr (std::is_same_v<FieldType, StringView>) {
         if (view.isInline()) {
           continue;
@@ -1420,6 +1558,11 @@ class RowContainer {
   // Bit position of free bit.
   int32_t freeFlagOffset_ = 0;
   int32_t rowSizeOffset_ = 0;
+  // Offset of the pointer to the cold record that holds the null flags and
+  // the values of the dependents. 0 if the dependents are in the row.
+  int32_t coldRecordOffset_ = 0;
+  // Size of the cold record. 0 if there is none.
+  int32_t coldRecordSize_ = 0;
 
   int32_t fixedRowSize_;
   // How many bytes do the flags (null, probed, free) occupy.
@@ -1442,6 +1585,9 @@ class RowContainer {
   uint64_t numFreeRows_ = 0;
 
   memory::AllocationPool rows_;
+  // Cold records of 'rows_'. A cold record stays with its row when the row is
+  // erased and is reused with it.
+  memory::AllocationPool coldRecords_;
 
   int alignment_ = 1;
 };
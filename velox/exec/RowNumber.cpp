@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/RowNumber.h"
+#include <numeric>
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/OperatorUtils.h"
 
@@ -49,6 +50,8 @@ RowNumber::RowNumber(
         0, // minTableSizeForParallelJoinBuild
         pool());
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
+    lookup_->decodedVectorCache =
+        operatorCtx_->driverCtx()->decodedVectorCache.get();
 
     const auto numRowsColumn = table_->rows()->columnAt(numKeys);
     numRowsOffset_ = numRowsColumn.offset();
@@ -285,27 +288,40 @@ RowVectorPtr RowNumber::getOutput() {
   }
 
   // Compute row numbers if needed.
-  FlatVector<int64_t>* rowNumbers = nullptr;
+  int64_t* rawRowNumbers = nullptr;
   if (generateRowNumber_) {
-    rowNumbers = &getOrCreateRowNumberVector(numInput);
-  }
-
-  for (auto i = 0; i < numInput; ++i) {
-    auto* partition = lookup_->hits[i];
-    const auto rowNumber = numRows(partition) + 1;
-
+    rawRowNumbers = getOrCreateRowNumberVector(numInput).mutableRawValues();
+  }
+
+  // The rows of a partition are often adjacent, e.g. if the input is clustered
+  // on the partition keys. The row numbers of a run of rows of the same
+  // partition are consecutive and are written at once.
+  const auto* hits = lookup_->hits.data();
+  vector_size_t runStart = 0;
+  while (runStart < numInput) {
+    auto* partition = hits[runStart];
+    vector_size_t runEnd = runStart + 1;
+    while (runEnd < numInput && hits[runEnd] == partition) {
+      ++runEnd;
+    }
+    const auto firstRowNumber = numRows(partition) + 1;
+    int64_t numRunRows = runEnd - runStart;
     if (limit_) {
-      if (rowNumber > limit_) {
-        // Exceeded the limit for this partition. Drop rows.
-        continue;
-      }
-      rawMapping[index++] = i;
+      // Drop the rows beyond the limit for this partition.
+      numRunRows = std::clamp<int64_t>(
+          limit_.value() - firstRowNumber + 1, 0, numRunRows);
+      std::iota(rawMapping + index, rawMapping + index + numRunRows, runStart);
+      index += numRunRows;
     }
 
-    if (generateRowNumber_) {
-      rowNumbers->set(i, rowNumber);
+    if (rawRowNumbers != nullptr) {
+      std::iota(
+          rawRowNumbers + runStart,
+          rawRowNumbers + runStart + numRunRows,
+          firstRowNumber);
     }
-    setNumRows(partition, rowNumber);
+    setNumRows(partition, firstRowNumber + numRunRows - 1);
+    runStart = runEnd;
   }
 
   RowVectorPtr output;
@@ -351,11 +367,12 @@ RowVectorPtr RowNumber::getOutputForSinglePartition() {
   }
 
   if (generateRowNumber_) {
-    auto& rowNumbers = getOrCreateRowNumberVector(numOutput);
-    for (auto i = 0; i < numOutput; ++i) {
-      rowNumbers.set(i, ++numTotalInput_);
-    }
+    auto* rawRowNumbers =
+        getOrCreateRowNumberVector(numOutput).mutableRawValues();
+    std::iota(rawRowNumbers, rawRowNumbers + numOutput, numTotalInput_ + 1);
   }
+  // Counted also without row numbers for enforcing the limit.
+  numTotalInput_ += numOutput;
 
   auto output = fillOutput(numOutput, nullptr);
   input_ = nullptr;
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SkewedPartitionTracker.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+namespace {
+struct TrackerEntry {
+  std::weak_ptr<core::QueryCtx> queryCtx;
+  std::shared_ptr<SkewedPartitionTracker> tracker;
+};
+
+using TrackerMap = std::unordered_map<std::string, TrackerEntry>;
+
+folly::Synchronized<TrackerMap>& trackers() {
+  static folly::Synchronized<TrackerMap> trackers;
+  return trackers;
+}
+} // namespace
+
+SkewedPartitionTracker::SkewedPartitionTracker(
+    int32_t numPartitions,
+    int32_t splitFactor,
+    double hotPartitionRatio,
+    uint64_t decisionBytes,
+    uint64_t decisionTimeoutMs)
+    : numPartitions_(numPartitions),
+      splitFactor_(std::min(splitFactor, numPartitions)),
+      hotPartitionRatio_(hotPartitionRatio),
+      decisionBytes_(decisionBytes),
+      decisionTimeoutMs_(decisionTimeoutMs),
+      createTimeMs_(getCurrentTimeMs()),
+      bytes_(numPartitions, 0),
+      hot_(numPartitions, false) {
+  VELOX_CHECK_GT(numPartitions_, 1);
+  VELOX_CHECK_GT(splitFactor_, 0);
+  VELOX_CHECK_GT(hotPartitionRatio_, 0);
+}
+
+// static
+std::shared_ptr<SkewedPartitionTracker> SkewedPartitionTracker::getOrCreate(
+    const std::shared_ptr<core::QueryCtx>& queryCtx,
+    const std::string& joinId,
+    int32_t numPartitions,
+    int32_t splitFactor,
+    double hotPartitionRatio,
+    uint64_t decisionBytes,
+    uint64_t decisionTimeoutMs) {
+  VELOX_CHECK_NOT_NULL(queryCtx);
+  const auto key = fmt::format("{}/{}", queryCtx->queryId(), joinId);
+  return trackers().withWLock([&](auto& map) {
+    auto& entry = map[key];
+    if (entry.tracker != nullptr && entry.queryCtx.lock() == queryCtx) {
+      VELOX_CHECK_EQ(entry.tracker->numPartitions_, numPartitions);
+      return entry.tracker;
+    }
+    // Drops the entries of the finished queries.
+    for (auto it = map.begin(); it != map.end();) {
+      if (it->second.queryCtx.expired() && it->first != key) {
+        it = map.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    auto tracker = std::make_shared<SkewedPartitionTracker>(
+        numPartitions,
+        splitFactor,
+        hotPartitionRatio,
+        decisionBytes,
+        decisionTimeoutMs);
+    entry = {queryCtx, tracker};
+    return tracker;
+  });
+}
+
+void SkewedPartitionTracker::addProbe() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numProbes_;
+}
+
+void SkewedPartitionTracker::addProbeBytes(const std::vector<uint64_t>& bytes) {
+  VELOX_CHECK_EQ(bytes.size(), numPartitions_);
+  if (decided_) {
+    return;
+  }
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (decided_) {
+      return;
+    }
+    for (auto i = 0; i < numPartitions_; ++i) {
+      bytes_[i] += bytes[i];
+      totalBytes_ += bytes[i];
+    }
+    if (totalBytes_ >= decisionBytes_) {
+      decideLocked(promises);
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void SkewedPartitionTracker::probeFinished() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (decided_) {
+      return;
+    }
+    decideLocked(promises);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+bool SkewedPartitionTracker::decided(ContinueFuture* future) {
+  if (decided_) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (decided_) {
+    return true;
+  }
+  const bool checkTimeout = numProbes_ == 0 && decisionTimeoutMs_ > 0;
+  const auto elapsedMs = getCurrentTimeMs() - createTimeMs_;
+  // Without a probe side in this process the decision would never come. A
+  // build side deciding on its own could disagree with the probe side, so it
+  // fails instead.
+  VELOX_CHECK(
+      !checkTimeout || elapsedMs < decisionTimeoutMs_,
+      "No probe side of the skewed join in this process. The probe and build "
+      "sides of a skewed join must run in the same process");
+  promises_.emplace_back("SkewedPartitionTracker::decided");
+  *future = promises_.back().getSemiFuture();
+  if (checkTimeout) {
+    // Wakes up the caller to check again on timeout.
+    *future =
+        std::move(*future)
+            .within(std::chrono::milliseconds(decisionTimeoutMs_ - elapsedMs))
+            .deferError(
+                folly::tag_t<folly::FutureTimeout>{},
+                [](const folly::FutureTimeout&) {});
+  }
+  return false;
+}
+
+void SkewedPartitionTracker::decideLocked(
+    std::vector<ContinuePromise>& promises) {
+  if (splitFactor_ > 1 && totalBytes_ > 0) {
+    const double hotBytes =
+        hotPartitionRatio_ * totalBytes_ / static_cast<double>(numPartitions_);
+    for (auto i = 0; i < numPartitions_; ++i) {
+      hot_[i] = bytes_[i] > hotBytes;
+      numHot_ += hot_[i];
+    }
+  }
+  decided_ = true;
+  promises = std::move(promises_);
+}
+
+std::vector<int32_t> SkewedPartitionTracker::hotPartitions() const {
+  std::vector<int32_t> partitions;
+  if (!decided_) {
+    return partitions;
+  }
+  for (auto i = 0; i < numPartitions_; ++i) {
+    if (hot_[i]) {
+      partitions.push_back(i);
+    }
+  }
+  return partitions;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+/// Decides which partitions of a hash partitioned join are hot and how their
+/// rows are routed. Shared by the PartitionedOutput operators of the probe
+/// and the build side of the join, see PartitionedOutputNode::SkewedJoin.
+///
+/// The probe side reports the bytes it sends to each partition. Once it has
+/// sent 'decisionBytes', or one of its operators has no more input, the
+/// partitions with more than 'hotPartitionRatio' times the average bytes
+/// become hot. The probe side then spreads the rows of each hot partition
+/// over 'splitFactor' consecutive destinations and the build side replicates
+/// the rows of the partition to the same destinations. The decision is final
+/// so that probe rows and build rows of a key always meet. The build side
+/// waits for the decision before sending any rows.
+///
+/// The trackers are shared through a process wide registry keyed by query
+/// and join id and live as long as the QueryCtx of the query, so that a build
+/// side which starts after the probe side is done sees the same decision.
+/// The probe and build sides of a skewed join must therefore run in the same
+/// process. A build side fails if no probe side operator has registered within
+/// 'decisionTimeoutMs' of the creation of the tracker.
+class SkewedPartitionTracker {
+ public:
+  SkewedPartitionTracker(
+      int32_t numPartitions,
+      int32_t splitFactor,
+      double hotPartitionRatio,
+      uint64_t decisionBytes,
+      uint64_t decisionTimeoutMs = 0);
+
+  /// Returns the tracker of 'joinId' in the query of 'queryCtx'. Creates it
+  /// with the other arguments if it doesn't exist. The tracker is kept until
+  /// 'queryCtx' is destroyed.
+  static std::shared_ptr<SkewedPartitionTracker> getOrCreate(
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const std::string& joinId,
+      int32_t numPartitions,
+      int32_t splitFactor,
+      double hotPartitionRatio,
+      uint64_t decisionBytes,
+      uint64_t decisionTimeoutMs = 0);
+
+  /// Called when a probe side operator is created.
+  void addProbe();
+
+  /// Adds the probe side bytes of each partition in 'bytes'. Decides the hot
+  /// partitions when the total reaches 'decisionBytes'.
+  void addProbeBytes(const std::vector<uint64_t>& bytes);
+
+  /// Called when a probe side operator has no more input or is closed.
+  /// Decides the hot partitions if not yet decided.
+  void probeFinished();
+
+  /// Returns true if the hot partitions are decided. Otherwise sets 'future'
+  /// to be realized when they are. Throws if no probe side operator has
+  /// registered with addProbe() within 'decisionTimeoutMs'. 0 means no
+  /// timeout.
+  bool decided(ContinueFuture* future);
+
+  bool decided() const {
+    return decided_;
+  }
+
+  /// Returns true if 'partition' is split. False before the decision.
+  bool isSplit(int32_t partition) const {
+    return decided_ && hot_[partition];
+  }
+
+  /// Returns the 'index'th of the 'splitFactor' destinations of the split
+  /// 'partition'.
+  int32_t destination(int32_t partition, int32_t index) const {
+    return (partition + index) % numPartitions_;
+  }
+
+  int32_t splitFactor() const {
+    return splitFactor_;
+  }
+
+  /// Returns the hot partitions. Empty before the decision.
+  std::vector<int32_t> hotPartitions() const;
+
+  /// Returns the number of hot partitions. 0 before the decision.
+  int32_t numHotPartitions() const {
+    return decided_ ? numHot_ : 0;
+  }
+
+ private:
+  // Decides the hot partitions from 'bytes_' and moves 'promises_' to
+  // 'promises'.
+  void decideLocked(std::vector<ContinuePromise>& promises);
+
+  const int32_t numPartitions_;
+  const int32_t splitFactor_;
+  const double hotPartitionRatio_;
+  const uint64_t decisionBytes_;
+  const uint64_t decisionTimeoutMs_;
+  const uint64_t createTimeMs_;
+
+  mutable std::mutex mutex_;
+  int32_t numProbes_{0};
+  std::vector<uint64_t> bytes_;
+  uint64_t totalBytes_{0};
+  std::vector<ContinuePromise> promises_;
+  // Set under 'mutex_' after 'hot_' is final. 'hot_' is then read without
+  // the mutex.
+  std::atomic<bool> decided_{false};
+  std::vector<bool> hot_;
+  int32_t numHot_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -106,6 +106,131 @@ void SortBuffer::addInput(const VectorPtr& input) {
   numInputRows_ += allRows.size();
 }
 
+RowVectorPtr SortBuffer::sampleSortKeys(vector_size_t maxSamples) const {
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_GT(maxSamples, 0);
+  const auto numKeys = sortCompareFlags_.size();
+  std::vector<std::string> names;
+  names.reserve(numKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    names.push_back(input_->nameOf(columnMap_[i].outputChannel));
+  }
+  const auto numSamples = std::min<uint64_t>(numInputRows_, maxSamples);
+  auto keyTypes = data_->keyTypes();
+  auto samples = BaseVector::create<RowVector>(
+      ROW(std::move(names), std::move(keyTypes)), numSamples, pool_);
+  if (numSamples == 0) {
+    return samples;
+  }
+
+  // Takes the first row of every 'step' rows.
+  const double step = static_cast<double>(numInputRows_) / numSamples;
+  std::vector<char*> sampleRows;
+  sampleRows.reserve(numSamples);
+  std::vector<char*> rows(std::min<uint64_t>(numInputRows_, 1'024));
+  RowContainerIterator iter;
+  uint64_t rowIndex = 0;
+  while (sampleRows.size() < numSamples) {
+    const auto numRows = data_->listRows(&iter, rows.size(), rows.data());
+    VELOX_CHECK_GT(numRows, 0);
+    for (auto i = 0; i < numRows && sampleRows.size() < numSamples;
+         ++i, ++rowIndex) {
+      if (rowIndex >= static_cast<uint64_t>(sampleRows.size() * step)) {
+        sampleRows.push_back(rows[i]);
+      }
+    }
+  }
+  for (auto i = 0; i < numKeys; ++i) {
+    data_->extractColumn(
+        sampleRows.data(), sampleRows.size(), i, samples->childAt(i));
+  }
+  return samples;
+}
+
+void SortBuffer::extractRanges(
+    const RowVectorPtr& boundaries,
+    vector_size_t maxOutputRows,
+    std::vector<std::vector<RowVectorPtr>>& ranges) {
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_GT(maxOutputRows, 0);
+  const auto numKeys = sortCompareFlags_.size();
+  VELOX_CHECK_EQ(boundaries->childrenSize(), numKeys);
+  const vector_size_t numBoundaries = boundaries->size();
+  ranges.clear();
+  ranges.resize(numBoundaries + 1);
+
+  const SelectivityVector allBoundaries(numBoundaries);
+  std::vector<DecodedVector> decodedBoundaries(numKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    decodedBoundaries[i].decode(*boundaries->childAt(i), allBoundaries);
+  }
+  // Returns true if 'row' sorts before the boundary at 'index'.
+  auto isBefore = [&](const char* row, vector_size_t index) {
+    for (auto i = 0; i < numKeys; ++i) {
+      if (auto result = data_->compare(
+              row,
+              data_->columnAt(i),
+              decodedBoundaries[i],
+              index,
+              sortCompareFlags_[i])) {
+        return result < 0;
+      }
+    }
+    return false;
+  };
+
+  std::vector<std::vector<char*>> rangeRows(numBoundaries + 1);
+  auto flush = [&](vector_size_t range) {
+    auto& rows = rangeRows[range];
+    auto output = BaseVector::create<RowVector>(input_, rows.size(), pool_);
+    for (const auto& columnProjection : columnMap_) {
+      data_->extractColumn(
+          rows.data(),
+          rows.size(),
+          columnProjection.inputChannel,
+          output->childAt(columnProjection.outputChannel));
+    }
+    ranges[range].push_back(std::move(output));
+    rows.clear();
+  };
+
+  std::vector<char*> rows(1'024);
+  RowContainerIterator iter;
+  for (;;) {
+    const auto numRows = data_->listRows(&iter, rows.size(), rows.data());
+    if (numRows == 0) {
+      break;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      // Finds the first boundary that the row sorts before.
+      vector_size_t low = 0;
+      vector_size_t high = numBoundaries;
+      while (low < high) {
+        const auto middle = (low + high) / 2;
+        if (isBefore(rows[i], middle)) {
+          high = middle;
+        } else {
+          low = middle + 1;
+        }
+      }
+      rangeRows[low].push_back(rows[i]);
+      if (rangeRows[low].size() == maxOutputRows) {
+        flush(low);
+      }
+    }
+  }
+  for (vector_size_t range = 0; range <= numBoundaries; ++range) {
+    if (!rangeRows[range].empty()) {
+      flush(range);
+    }
+  }
+
+  data_->clear();
+  numInputRows_ = 0;
+}
+
 void SortBuffer::noMoreInput() {
   velox::common::testutil::TestValue::adjust(
       "facebook::velox::exec::SortBuffer::noMoreInput", this);
@@ -475,7 +600,10 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->readAheadExecutor());
   spillPartitionSet_.clear();
 }
 
@@ -68,6 +68,33 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// Returns the sorting keys of up to 'maxSamples' input rows, evenly spaced
+  /// over the rows in the order they were added. The columns are the sorting
+  /// keys in sort order. Must be called before noMoreInput() and without
+  /// spilling.
+  RowVectorPtr sampleSortKeys(vector_size_t maxSamples) const;
+
+  /// Moves the input rows out into batches of at most 'maxOutputRows' rows of
+  /// the input type, one list of batches in 'ranges' per key range.
+  /// 'boundaries' has the sorting keys of the upper bounds of the ranges in
+  /// ascending sort order, in the layout returned by sampleSortKeys(). Range
+  /// i has the rows that sort before boundary i and not before boundary i - 1,
+  /// so there is one more range than boundaries. Leaves the buffer empty and
+  /// ready to take more input. Must be called before noMoreInput() and
+  /// without spilling.
+  void extractRanges(
+      const RowVectorPtr& boundaries,
+      vector_size_t maxOutputRows,
+      std::vector<std::vector<RowVectorPtr>>& ranges);
+
+  uint64_t numInputRows() const {
+    return numInputRows_;
+  }
+
+  const std::vector<CompareFlags>& sortCompareFlags() const {
+    return sortCompareFlags_;
+  }
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
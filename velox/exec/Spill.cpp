@@ -18,6 +18,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -35,8 +36,120 @@ const std::vector<CompareFlags> getCompareFlagsOrDefault(
   }
   return std::vector<CompareFlags>(numSortKeys);
 }
+
+template <typename T>
+void encodeNormalizedKey(
+    const DecodedVector& decoded,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t stringPrefixLength,
+    vector_size_t numRows,
+    uint32_t rowSize,
+    char* dest) {
+  for (auto row = 0; row < numRows; ++row, dest += rowSize) {
+    std::optional<T> value;
+    if (!decoded.isNullAt(row)) {
+      value = decoded.valueAt<T>(row);
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      encoder.encode(value, dest, stringPrefixLength);
+    } else {
+      encoder.encode(value, dest);
+    }
+  }
+}
 } // namespace
 
+void SpillMergeStream::encodeNormalizedKeys() {
+  if (size_ == 0) {
+    return;
+  }
+  if (!normalizedKeyLayoutInitialized_) {
+    normalizedKeyLayoutInitialized_ = true;
+    // The encoding does not follow the custom comparison of a type, so only
+    // the keys before the first such key are normalized.
+    std::vector<TypePtr> keyTypes;
+    for (auto i = 0; i < numSortKeys(); ++i) {
+      const auto& type = rowVector_->childAt(i)->type();
+      if (type->providesCustomComparison()) {
+        break;
+      }
+      keyTypes.push_back(type);
+    }
+    auto compareFlags =
+        getCompareFlagsOrDefault(sortCompareFlags(), numSortKeys());
+    compareFlags.resize(keyTypes.size());
+    const common::PrefixSortConfig config;
+    auto layout = PrefixSortLayout::makeSortLayout(
+        keyTypes,
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
+    if (layout.hasNormalizedKeys) {
+      normalizedKeySize_ = layout.normalizedBufferSize;
+      firstNonNormalizedKey_ = layout.nonPrefixSortStartIndex;
+      normalizedKeyLayout_ =
+          std::make_shared<const PrefixSortLayout>(std::move(layout));
+    }
+  }
+  if (normalizedKeyLayout_ == nullptr) {
+    return;
+  }
+
+  const auto& layout = *normalizedKeyLayout_;
+  // Zeroes the padding bytes.
+  normalizedKeys_.assign(static_cast<size_t>(size_) * normalizedKeySize_, 0);
+  SelectivityVector rows(size_);
+  DecodedVector decoded;
+  for (auto i = 0; i < layout.numNormalizedKeys; ++i) {
+    const auto& key = rowVector_->childAt(i);
+    decoded.decode(*key, rows);
+    char* dest = normalizedKeys_.data() + layout.prefixOffsets[i];
+    switch (key->typeKind()) {
+      case TypeKind::SMALLINT:
+        encodeNormalizedKey<int16_t>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::INTEGER:
+        encodeNormalizedKey<int32_t>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::BIGINT:
+        encodeNormalizedKey<int64_t>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::REAL:
+        encodeNormalizedKey<float>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::DOUBLE:
+        encodeNormalizedKey<double>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeNormalizedKey<Timestamp>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::HUGEINT:
+        encodeNormalizedKey<int128_t>(
+            decoded, layout.encoders[i], 0, size_, normalizedKeySize_, dest);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        encodeNormalizedKey<StringView>(
+            decoded,
+            layout.encoders[i],
+            layout.stringPrefixLength,
+            size_,
+            normalizedKeySize_,
+            dest);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected normalized key type: {}", key->type()->toString());
+    }
+  }
+}
+
 void SpillMergeStream::pop() {
   if (++index_ >= size_) {
     setNextBatch();
@@ -48,6 +161,17 @@ int32_t SpillMergeStream::compare(const MergeStream& other) const {
   auto& children = rowVector_->children();
   auto& otherChildren = otherStream.current().children();
   int32_t key = 0;
+  if (normalizedKeyLayout_ != nullptr) {
+    const auto result = std::memcmp(
+        normalizedKeys(), otherStream.normalizedKeys(), normalizedKeySize_);
+    if (result != 0) {
+      return result;
+    }
+    key = firstNonNormalizedKey_;
+    if (key >= numSortKeys()) {
+      return 0;
+    }
+  }
   if (sortCompareFlags().empty()) {
     do {
       auto result = children[key]
@@ -91,7 +215,10 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
+    bool columnarFormat)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -106,6 +233,9 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
+      remoteSpillConfig_(remoteSpillConfig),
+      columnarFormat_(columnarFormat),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -143,13 +273,17 @@ uint64_t SpillState::appendToPartition(
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
-        fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
+        spillDir,
+        fmt::format("{}-spill-{}", fileNamePrefix_, partition),
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        remoteSpillConfig_,
+        columnarFormat_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -259,13 +393,14 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::vector<column_index_t>& projection) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, projection)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -276,12 +411,13 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, {}, readAheadExecutor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
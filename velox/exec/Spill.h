@@ -32,6 +32,8 @@
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
+struct PrefixSortLayout;
+
 // A source of sorted spilled RowVectors coming either from a file or memory.
 class SpillMergeStream : public MergeStream {
  public:
@@ -82,6 +84,7 @@ class SpillMergeStream : public MergeStream {
   virtual void nextBatch() = 0;
 
   // loads the next 'rowVector' and sets 'decoded_' if this is initialized.
+  // Encodes the normalized keys of the new rows.
   void setNextBatch() {
     nextBatch();
     if (!decoded_.empty()) {
@@ -90,6 +93,7 @@ class SpillMergeStream : public MergeStream {
         decoded_[i].decode(*rowVector_->childAt(i), rows_);
       }
     }
+    encodeNormalizedKeys();
   }
 
   void ensureDecodedValid(int32_t index) {
@@ -125,6 +129,34 @@ class SpillMergeStream : public MergeStream {
 
   // Covers all rows inn 'rowVector_' Set if 'decoded_' is non-empty.
   SelectivityVector rows_;
+
+ private:
+  // Encodes the leading sort keys of the rows in 'rowVector_' into
+  // 'normalizedKeys_' with the PrefixSort encoding. compare() then compares
+  // the encoded keys with memcmp and only compares the columns when the
+  // encoded keys are equal and do not cover all the sort keys.
+  void encodeNormalizedKeys();
+
+  const char* normalizedKeys() const {
+    return normalizedKeys_.data() +
+        static_cast<size_t>(index_) * normalizedKeySize_;
+  }
+
+  // Set on the first batch. Null if no sort key can be normalized.
+  std::shared_ptr<const PrefixSortLayout> normalizedKeyLayout_;
+  bool normalizedKeyLayoutInitialized_{false};
+
+  // Number of bytes of the normalized keys of a row. 0 if
+  // 'normalizedKeyLayout_' is null.
+  uint32_t normalizedKeySize_{0};
+
+  // Index of the first sort key to compare from the columns when the
+  // normalized keys are equal.
+  int32_t firstNonNormalizedKey_{0};
+
+  // Normalized keys of the rows in 'rowVector_', 'normalizedKeySize_' bytes
+  // per row.
+  std::vector<char> normalizedKeys_;
 };
 
 // A source of spilled RowVectors coming from a file.
@@ -134,7 +166,7 @@ class FileSpillMergeStream : public SpillMergeStream {
       std::unique_ptr<SpillReadFile> spillFile) {
     auto spillStream = std::unique_ptr<SpillMergeStream>(
         new FileSpillMergeStream(std::move(spillFile)));
-    static_cast<FileSpillMergeStream*>(spillStream.get())->nextBatch();
+    static_cast<FileSpillMergeStream*>(spillStream.get())->setNextBatch();
     return spillStream;
   }
 
@@ -293,22 +325,28 @@ class SpillPartition {
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
   /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// when reading data from spilled files. If 'projection' is not empty, the
+  /// reader only returns the columns at these indices. See
+  /// SpillReadFile::create().
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::vector<column_index_t>& projection = {});
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
   /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// when reading data from spilled files. If 'readAheadExecutor' is set,
+  /// each spill file reads its next buffer on it while the merge consumes the
+  /// current one.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   std::string toString() const;
 
@@ -346,7 +384,11 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig =
+          std::nullopt,
+      bool columnarFormat = false);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -448,6 +490,11 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  // If set, the spill file writes run on this executor.
+  folly::Executor* const writeExecutor_;
+  const std::optional<common::RemoteSpillConfig> remoteSpillConfig_;
+  // If true, the spill files are in the columnar spill format.
+  const bool columnarFormat_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
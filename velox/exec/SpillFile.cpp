@@ -27,6 +27,24 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Returns the type of the columns of 'type' at 'projection'. Returns 'type' if
+// 'projection' is empty.
+RowTypePtr projectType(
+    const RowTypePtr& type,
+    const std::vector<column_index_t>& projection) {
+  if (projection.empty()) {
+    return type;
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto column : projection) {
+    VELOX_CHECK_LT(column, type->size());
+    names.push_back(type->nameOf(column));
+    types.push_back(type->childAt(column));
+  }
+  return ROW(std::move(names), std::move(types));
+}
 } // namespace
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -77,40 +95,75 @@ SpillWriter::SpillWriter(
     const uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
-    const std::string& pathPrefix,
+    const std::string& spillDir,
+    const std::string& fileNamePrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
+    bool columnarFormat)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      pathPrefix_(pathPrefix),
+      pathPrefix_(fmt::format("{}/{}", spillDir, fileNamePrefix)),
+      fileNamePrefix_(fileNamePrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      remoteSpillConfig_(remoteSpillConfig),
+      columnarFormat_(columnarFormat) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  // The write may still reference 'currentFile_'.
+  if (pendingWrite_.has_value()) {
+    pendingWrite_->write->close();
+  }
+}
+
+bool SpillWriter::useRemote() {
+  if (!remote_ && remoteSpillConfig_.has_value()) {
+    remote_ = remoteSpillConfig_->useRemoteCb();
+  }
+  return remote_;
+}
+
+uint64_t SpillWriter::writeBufferSize() {
+  return useRemote() ? remoteSpillConfig_->writeBufferSize : writeBufferSize_;
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
-  if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
+  const bool remote = useRemote();
+  // Moves to the remote spill directory without waiting for the local file to
+  // reach the target size.
+  if ((currentFile_ != nullptr) &&
+      (currentFileBytes_ > targetFileSize_ || remote != currentFileRemote_)) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    const auto pathPrefix = remote
+        ? fmt::format(
+              "{}/{}", remoteSpillConfig_->getSpillDirPathCb(), fileNamePrefix_)
+        : pathPrefix_;
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format("{}-{}", pathPrefix, finishedFiles_.size()),
         fileCreateConfig_);
+    currentFileRemote_ = remote;
   }
   return currentFile_.get();
 }
@@ -119,6 +172,7 @@ void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  waitForWrite();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   finishedFiles_.push_back(SpillFileInfo{
@@ -128,43 +182,128 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .readBufferSize =
+          currentFileRemote_ ? remoteSpillConfig_->readBufferSize : 0,
+      .columnar = columnarFormat_});
   currentFile_.reset();
+  currentFileBytes_ = 0;
 }
 
 size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
 
+uint64_t SpillWriter::bufferedBytes() const {
+  if (!columnarFormat_) {
+    return batch_ == nullptr ? 0 : batch_->size();
+  }
+  uint64_t bytes{0};
+  for (const auto& columnBatch : columnBatches_) {
+    bytes += columnBatch->size();
+  }
+  return bytes;
+}
+
+std::unique_ptr<folly::IOBuf> SpillWriter::flushBatch(
+    VectorStreamGroup& batch) {
+  // The IOBuf references the serialized ranges of 'batch' instead of copying
+  // them. Their memory moves to 'serialized', which lives until the IOBuf is
+  // written.
+  auto serialized = std::make_shared<StreamArena>(pool_);
+  IOBufOutputStream out(*pool_, nullptr, 64 * 1024);
+  out.enableZeroCopy(serialized);
+  batch.flush(&out);
+  if (out.hasReferencedRanges()) {
+    batch.moveAllocationsTo(*serialized);
+  }
+  return out.getIOBuf();
+}
+
+std::unique_ptr<folly::IOBuf> SpillWriter::flushColumns() {
+  std::unique_ptr<folly::IOBuf> iobuf;
+  for (auto& columnBatch : columnBatches_) {
+    auto columnBuf = flushBatch(*columnBatch);
+    // Prefixes each column page with its size so that readers can skip it.
+    const int32_t columnBytes = columnBuf->computeChainDataLength();
+    auto sizeBuf = folly::IOBuf::copyBuffer(&columnBytes, sizeof(columnBytes));
+    sizeBuf->appendToChain(std::move(columnBuf));
+    if (iobuf == nullptr) {
+      iobuf = std::move(sizeBuf);
+    } else {
+      iobuf->appendToChain(std::move(sizeBuf));
+    }
+  }
+  columnBatches_.clear();
+  return iobuf;
+}
+
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && columnBatches_.empty()) {
     return 0;
   }
 
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+  std::unique_ptr<folly::IOBuf> iobuf;
   uint64_t flushTimeNs{0};
-  {
+  if (columnarFormat_) {
     NanosecondTimer timer(&flushTimeNs);
-    batch_->flush(&out);
+    iobuf = flushColumns();
+  } else {
+    NanosecondTimer timer(&flushTimeNs);
+    iobuf = flushBatch(*batch_);
+    batch_.reset();
   }
-  batch_.reset();
 
-  uint64_t writeTimeNs{0};
-  uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
+  const auto writtenBytes = iobuf->computeChainDataLength();
+  currentFileBytes_ += writtenBytes;
+  if (writeExecutor_ == nullptr) {
+    uint64_t writeTimeNs{0};
+    {
+      NanosecondTimer timer(&writeTimeNs);
+      file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+    updateAndCheckSpillLimitCb_(writtenBytes);
+    return writtenBytes;
   }
-  updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+
+  // Keeps the appends to 'file' in order.
+  waitForWrite();
+  std::shared_ptr<folly::IOBuf> buffer = std::move(iobuf);
+  auto write = std::make_shared<AsyncSource<uint64_t>>([file, buffer]() {
+    uint64_t writeTimeNs{0};
+    {
+      NanosecondTimer timer(&writeTimeNs);
+      file->write(std::make_unique<folly::IOBuf>(std::move(*buffer)));
+    }
+    return std::make_unique<uint64_t>(writeTimeNs);
+  });
+  pendingWrite_ = PendingWrite{writtenBytes, flushTimeNs, write};
+  writeExecutor_->add([write]() { write->prepare(); });
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+void SpillWriter::waitForWrite() {
+  if (!pendingWrite_.has_value()) {
+    return;
+  }
+  auto pending = std::move(pendingWrite_.value());
+  pendingWrite_.reset();
+  uint64_t stallTimeNs{0};
+  std::unique_ptr<uint64_t> writeTimeNs;
+  {
+    NanosecondTimer timer(&stallTimeNs);
+    writeTimeNs = pending.write->move();
+  }
+  VELOX_CHECK_NOT_NULL(writeTimeNs);
+  updateWriteStats(pending.bytes, pending.flushTimeNs, *writeTimeNs);
+  updateWriteStallStats(stallTimeNs);
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -173,24 +312,56 @@ uint64_t SpillWriter::write(
   uint64_t timeNs{0};
   {
     NanosecondTimer timer(&timeNs);
-    if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          &options);
+    serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+        kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+    if (columnarFormat_) {
+      appendColumns(rows, indices, options);
+    } else {
+      if (batch_ == nullptr) {
+        batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+        batch_->createStreamTree(
+            std::static_pointer_cast<const RowType>(rows->type()),
+            1'000,
+            &options);
+      }
+      batch_->append(rows, indices);
     }
-    batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeNs);
-  if (batch_->size() < writeBufferSize_) {
+  if (bufferedBytes() < writeBufferSize()) {
     return 0;
   }
   return flush();
 }
 
+void SpillWriter::appendColumns(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices,
+    const serializer::presto::PrestoVectorSerde::PrestoOptions& options) {
+  const auto numColumns = rows->childrenSize();
+  if (columnBatches_.empty()) {
+    columnBatches_.resize(numColumns);
+    for (auto i = 0; i < numColumns; ++i) {
+      columnBatches_[i] = std::make_unique<VectorStreamGroup>(pool_, serde_);
+      columnBatches_[i]->createStreamTree(columnType(i), 1'000, &options);
+    }
+  }
+  VELOX_CHECK_EQ(columnBatches_.size(), numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    auto column = std::make_shared<RowVector>(
+        pool_,
+        columnType(i),
+        nullptr,
+        rows->size(),
+        std::vector<VectorPtr>{rows->childAt(i)});
+    columnBatches_[i]->append(column, indices);
+  }
+}
+
+RowTypePtr SpillWriter::columnType(column_index_t column) const {
+  return ROW({type_->nameOf(column)}, {type_->childAt(column)});
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeNs) {
@@ -213,6 +384,11 @@ void SpillWriter::updateWriteStats(
       spilledBytes, flushTimeNs, fileWriteTimeNs);
 }
 
+void SpillWriter::updateWriteStallStats(uint64_t stallTimeNs) {
+  stats_->wlock()->spillWriteStallTimeNanos += stallTimeNs;
+  common::updateGlobalSpillWriteStallTime(stallTimeNs);
+}
+
 void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
   ++stats_->wlock()->spilledFiles;
   addThreadLocalRuntimeStat(
@@ -265,18 +441,23 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    const std::vector<column_index_t>& projection,
+    folly::Executor* readAheadExecutor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
       fileInfo.size,
-      bufferSize,
+      fileInfo.readBufferSize != 0 ? fileInfo.readBufferSize : bufferSize,
       fileInfo.type,
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.columnar,
+      projection,
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -288,8 +469,11 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool columnar,
+    const std::vector<column_index_t>& projection,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : id_(id),
       path_(path),
       size_(size),
@@ -297,6 +481,9 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      columnar_(columnar),
+      projection_(projection),
+      readType_(projectType(type_, projection_)),
       readOptions_{
           kDefaultUseLosslessTimestamp,
           compressionKind_,
@@ -307,7 +494,7 @@ SpillReadFile::SpillReadFile(
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file), bufferSize, pool_, readAheadExecutor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -319,14 +506,68 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeNs{0};
   {
     NanosecondTimer timer{&timeNs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    if (columnar_) {
+      readColumns(rowVector);
+    } else if (projection_.empty()) {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    } else {
+      RowVectorPtr rows;
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, serde_, &rows, &readOptions_);
+      std::vector<VectorPtr> children;
+      children.reserve(projection_.size());
+      for (auto column : projection_) {
+        children.push_back(rows->childAt(column));
+      }
+      rowVector = std::make_shared<RowVector>(
+          pool_, readType_, nullptr, rows->size(), std::move(children));
+    }
   }
   stats_->wlock()->spillDeserializationTimeNanos += timeNs;
   common::updateGlobalSpillDeserializationTimeNs(timeNs);
   return true;
 }
 
+void SpillReadFile::readColumns(RowVectorPtr& rowVector) {
+  const auto numColumns = type_->size();
+  std::vector<VectorPtr> columns(numColumns);
+  std::vector<bool> isRead(numColumns, projection_.empty());
+  for (auto column : projection_) {
+    isRead[column] = true;
+  }
+  vector_size_t numRows{0};
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto columnBytes = input_->read<int32_t>();
+    if (!isRead[i]) {
+      input_->skip(columnBytes);
+      continue;
+    }
+    RowVectorPtr column;
+    VectorStreamGroup::read(
+        input_.get(),
+        pool_,
+        ROW({type_->nameOf(i)}, {type_->childAt(i)}),
+        serde_,
+        &column,
+        &readOptions_);
+    numRows = column->size();
+    columns[i] = column->childAt(0);
+  }
+
+  std::vector<VectorPtr> children;
+  if (projection_.empty()) {
+    children = std::move(columns);
+  } else {
+    children.reserve(projection_.size());
+    for (auto column : projection_) {
+      children.push_back(columns[column]);
+    }
+  }
+  rowVector = std::make_shared<RowVector>(
+      pool_, readType_, nullptr, numRows, std::move(children));
+}
+
 void SpillReadFile::recordSpillStats() {
   VELOX_CHECK(input_->atEnd());
   const auto readStats = input_->stats();
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -90,6 +91,11 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// If not zero, the buffer size to read the file with instead of the one of
+  /// the reader. Set for remote spill files.
+  uint64_t readBufferSize{0};
+  /// True if the file is in the columnar spill format.
+  bool columnar{false};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -100,13 +106,25 @@ using SpillFiles = std::vector<SpillFileInfo>;
 class SpillWriter {
  public:
   /// 'type' is a RowType describing the content. 'numSortKeys' is the number
-  /// of leading columns on which the data is sorted. 'path' is a file path
-  /// prefix. ' 'targetFileSize' is the target byte size of a single file.
+  /// of leading columns on which the data is sorted. 'spillDir' is the spill
+  /// directory and 'fileNamePrefix' is the name prefix of the spill files.
+  /// 'targetFileSize' is the target byte size of a single file.
   /// 'writeBufferSize' specifies the size limit of the buffered data before
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'writeExecutor' is set, the file writes run on
+  /// it so that serializing the next buffer overlaps with writing the previous
+  /// one. There is at most one write in flight, so the in-flight bytes are
+  /// bounded by about 'writeBufferSize'. If 'remoteSpillConfig' is set, the
+  /// new files go to the remote spill directory once it says so, with the
+  /// remote write and read buffer sizes.
+  ///
+  /// If 'columnarFormat' is true, each flushed batch is written as one page per
+  /// column, prefixed by its size, instead of one page for all the columns.
+  /// The columns are compressed independently, so a column page that doesn't
+  /// compress well is stored uncompressed while the others are compressed.
+  /// Readers can skip the columns they don't need.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -115,13 +133,20 @@ class SpillWriter {
       const uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
-      const std::string& pathPrefix,
+      const std::string& spillDir,
+      const std::string& fileNamePrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig =
+          std::nullopt,
+      bool columnarFormat = false);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -149,6 +174,14 @@ class SpillWriter {
   std::vector<uint32_t> testingSpilledFileIds() const;
 
  private:
+  // A buffer being written to 'currentFile_' on 'writeExecutor_'.
+  struct PendingWrite {
+    uint64_t bytes;
+    uint64_t flushTimeNs;
+    // Returns the time spent on the file write.
+    std::shared_ptr<AsyncSource<uint64_t>> write;
+  };
+
   FOLLY_ALWAYS_INLINE void checkNotFinished() const {
     VELOX_CHECK(!finished_, "SpillWriter has finished");
   }
@@ -162,10 +195,42 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
+  // Returns true if the new spill files go to the remote spill directory.
+  // Stays true once the remote spill config says so.
+  bool useRemote();
+
+  // Returns the size of the serialized data to buffer before a write.
+  uint64_t writeBufferSize();
+
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. If 'writeExecutor_' is set, waits for the previous write
+  // and starts the write in the background.
   uint64_t flush();
 
+  // Returns the bytes of serialized data buffered for the next flush.
+  uint64_t bufferedBytes() const;
+
+  // Appends each column of 'rows' to its 'columnBatches_' entry.
+  void appendColumns(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices,
+      const serializer::presto::PrestoVectorSerde::PrestoOptions& options);
+
+  // Returns the single column row type of the 'column' page.
+  RowTypePtr columnType(column_index_t column) const;
+
+  // Returns the serialization of 'batch'. References the serialized ranges of
+  // 'batch' and moves their memory out of it.
+  std::unique_ptr<folly::IOBuf> flushBatch(VectorStreamGroup& batch);
+
+  // Returns the size prefixed column pages of 'columnBatches_' and clears
+  // them.
+  std::unique_ptr<folly::IOBuf> flushColumns();
+
+  // Waits for 'pendingWrite_' if any and updates the write stats. Rethrows the
+  // error of the write.
+  void waitForWrite();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -178,11 +243,15 @@ class SpillWriter {
       uint64_t flushTimeUs,
       uint64_t writeTimeUs);
 
+  // Invoked to update the time spent waiting for the background writes.
+  void updateWriteStallStats(uint64_t stallTimeNs);
+
   const RowTypePtr type_;
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
   const std::string pathPrefix_;
+  const std::string fileNamePrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
@@ -193,11 +262,24 @@ class SpillWriter {
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const std::optional<common::RemoteSpillConfig> remoteSpillConfig_;
+  const bool columnarFormat_;
 
   bool finished_{false};
+  bool remote_{false};
+  // True if 'currentFile_' is in the remote spill directory.
+  bool currentFileRemote_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // One group per column if 'columnarFormat_' is true. Used instead of
+  // 'batch_'.
+  std::vector<std::unique_ptr<VectorStreamGroup>> columnBatches_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // Bytes appended to 'currentFile_' including 'pendingWrite_'. The file size
+  // can't be read while a write is in flight.
+  uint64_t currentFileBytes_{0};
+  std::optional<PendingWrite> pendingWrite_;
   SpillFiles finishedFiles_;
 };
 
@@ -210,11 +292,18 @@ class SpillWriter {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// If 'projection' is not empty, the read batches have only the columns of
+  /// the file at these indices, in this order. The other columns are skipped
+  /// without deserialization if the file is in the columnar spill format. If
+  /// 'readAheadExecutor' is set, the next buffer is read on it while the
+  /// current one is consumed.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const std::vector<column_index_t>& projection = {},
+      folly::Executor* readAheadExecutor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -249,8 +338,14 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool columnar,
+      const std::vector<column_index_t>& projection,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor);
+
+  // Reads the next batch of the columnar spill format into 'rowVector'.
+  void readColumns(RowVectorPtr& rowVector);
 
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
@@ -266,6 +361,11 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnar_;
+  // The read columns. Empty if all the columns are read.
+  const std::vector<column_index_t> projection_;
+  // The type of the read batches.
+  const RowTypePtr readType_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
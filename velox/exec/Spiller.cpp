@@ -59,6 +59,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -95,6 +98,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -127,6 +133,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -160,6 +169,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           0,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -194,6 +206,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -224,6 +239,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           spillConfig->executor,
+          spillConfig->writeExecutor(),
+          spillConfig->remoteSpillConfig,
+          spillConfig->columnarFormat,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -246,6 +264,9 @@ Spiller::Spiller(
     common::CompressionKind compressionKind,
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     folly::Executor* executor,
+    folly::Executor* writeExecutor,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
+    bool columnarFormat,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
     folly::Synchronized<common::SpillStats>* spillStats)
@@ -270,7 +291,10 @@ Spiller::Spiller(
           prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          writeExecutor,
+          remoteSpillConfig,
+          columnarFormat) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -356,7 +380,7 @@ class RowContainerSpillMergeStream : public SpillMergeStream {
         rows_(std::move(rows)),
         spiller_(spiller) {
     if (!rows_.empty()) {
-      RowContainerSpillMergeStream::nextBatch();
+      setNextBatch();
     }
   }
 
@@ -488,19 +512,19 @@ std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
   }
 }
 
-void Spiller::runSpill(bool lastRun) {
+void Spiller::runSpill(bool lastRun, bool eraseRows) {
   ++spillStats_->wlock()->spillRuns;
   VELOX_CHECK(type_ != Spiller::Type::kOrderByOutput || lastRun);
 
   std::vector<std::shared_ptr<AsyncSource<SpillStatus>>> writes;
   for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
+    if (spillRuns_[partition].rows.empty()) {
+      continue;
+    }
     VELOX_CHECK(
         state_.isPartitionSpilled(partition),
         "Partition {} is not marked as spilled",
         partition);
-    if (spillRuns_[partition].rows.empty()) {
-      continue;
-    }
     writes.push_back(memory::createAsyncMemoryReclaimTask<SpillStatus>(
         [partition, this]() { return writeSpill(partition); }));
     if ((writes.size() > 1) && executor_ != nullptr) {
@@ -532,6 +556,10 @@ void Spiller::runSpill(bool lastRun) {
     auto partition = result->partition;
     auto& run = spillRuns_[partition];
     VELOX_CHECK_EQ(numWritten, run.rows.size());
+    if (eraseRows) {
+      container_->eraseRows(
+          folly::Range<char**>(run.rows.data(), run.rows.size()));
+    }
     run.clear();
     // When a sorted run ends, we start with a new file next time.
     if (needSort()) {
@@ -613,6 +641,102 @@ void Spiller::spill(SpillRows& rows) {
   checkEmptySpillRuns();
 }
 
+void Spiller::spill(const SpillPartitionNumSet& partitions) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK(
+      type_ == Type::kHashJoinBuild || type_ == Type::kAggregateInput,
+      "Unexpected spiller type: {}",
+      typeName(type_));
+  VELOX_CHECK(!partitions.empty());
+
+  for (const auto partition : partitions) {
+    VELOX_CHECK_LT(partition, state_.maxPartitions());
+    if (!state_.isPartitionSpilled(partition)) {
+      state_.setPartitionSpilled(partition);
+    }
+  }
+
+  // The spilled rows of a hash join build are erased after each run, which
+  // the iterator skips.
+  const bool eraseRows = type_ == Type::kHashJoinBuild;
+  RowContainerIterator rowIter;
+  bool lastRun{false};
+  do {
+    lastRun = fillSpillRuns(&rowIter, &partitions);
+    runSpill(lastRun, eraseRows);
+  } while (!lastRun);
+
+  checkEmptySpillRuns();
+}
+
+std::vector<uint64_t> Spiller::partitionRowBytes() const {
+  VELOX_CHECK(
+      type_ == Type::kHashJoinBuild || type_ == Type::kAggregateInput,
+      "Unexpected spiller type: {}",
+      typeName(type_));
+  constexpr int32_t kHashBatchSize = 4096;
+  std::vector<uint64_t> partitionBytes(state_.maxPartitions(), 0);
+  std::vector<uint64_t> hashes(kHashBatchSize);
+  std::vector<char*> rows(kHashBatchSize);
+  const bool isSinglePartition = bits_.numPartitions() == 1;
+  RowContainerIterator iterator;
+  while (const auto numRows = container_->listRows(
+             &iterator, rows.size(), RowContainer::kUnlimited, rows.data())) {
+    auto rowSet = folly::Range<char**>(rows.data(), numRows);
+    if (!isSinglePartition) {
+      for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+        container_->hash(i, rowSet, i > 0, hashes.data());
+      }
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      const auto partition = isSinglePartition
+          ? 0
+          : bits_.partition(hashes[i], state_.maxPartitions());
+      partitionBytes[partition] += container_->rowSize(rows[i]);
+    }
+  }
+  return partitionBytes;
+}
+
+// static
+SpillPartitionNumSet Spiller::partitionsToSpill(
+    const std::vector<Spiller*>& spillers,
+    uint64_t targetBytes) {
+  if (targetBytes == 0) {
+    return {};
+  }
+  std::vector<uint64_t> partitionBytes;
+  for (const auto* spiller : spillers) {
+    const auto bytes = spiller->partitionRowBytes();
+    partitionBytes.resize(bytes.size(), 0);
+    for (auto i = 0; i < bytes.size(); ++i) {
+      partitionBytes[i] += bytes[i];
+    }
+  }
+  std::vector<uint32_t> partitions;
+  for (auto i = 0; i < partitionBytes.size(); ++i) {
+    if (partitionBytes[i] > 0) {
+      partitions.push_back(i);
+    }
+  }
+  std::sort(partitions.begin(), partitions.end(), [&](auto left, auto right) {
+    return partitionBytes[left] > partitionBytes[right];
+  });
+  SpillPartitionNumSet result;
+  uint64_t spillBytes{0};
+  for (const auto partition : partitions) {
+    if (spillBytes >= targetBytes) {
+      break;
+    }
+    result.insert(partition);
+    spillBytes += partitionBytes[partition];
+  }
+  if (result.size() == partitions.size()) {
+    return {};
+  }
+  return result;
+}
+
 void Spiller::checkEmptySpillRuns() const {
   for (const auto& spillRun : spillRuns_) {
     VELOX_CHECK(spillRun.rows.empty());
@@ -670,7 +794,9 @@ void Spiller::finalizeSpill() {
   finalized_ = true;
 }
 
-bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
+bool Spiller::fillSpillRuns(
+    RowContainerIterator* iterator,
+    const SpillPartitionNumSet* partitions) {
   checkEmptySpillRuns();
 
   bool lastRun{false};
@@ -710,6 +836,9 @@ bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
             ? 0
             : bits_.partition(hashes[i], state_.maxPartitions());
         VELOX_DCHECK_GE(partition, 0);
+        if (partitions != nullptr && partitions->count(partition) == 0) {
+          continue;
+        }
         spillRuns_[partition].rows.push_back(rows[i]);
         spillRuns_[partition].numBytes += container_->rowSize(rows[i]);
       }
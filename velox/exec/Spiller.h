@@ -129,6 +129,29 @@ class Spiller {
   /// container. The caller needs to erase them from the row container.
   void spill(SpillRows& rows);
 
+  /// Spills the rows of 'partitions' from the row container and marks these
+  /// partitions as spilled. The rows of the other partitions stay in memory.
+  /// This is used by 'kHashJoinBuild' spiller type to spill part of a hash
+  /// join build side, and by 'kAggregateInput' spiller type to spill part of
+  /// an aggregation hash table. For 'kHashJoinBuild', the spilled rows are
+  /// erased from the row container. For 'kAggregateInput', the spilled rows
+  /// stay in the row container as with spill() and the caller needs to erase
+  /// them from its hash table.
+  void spill(const SpillPartitionNumSet& partitions);
+
+  /// Returns the total byte size of the rows in the row container for each
+  /// partition. For 'kHashJoinBuild', only partitions which are not spilled
+  /// have rows.
+  std::vector<uint64_t> partitionRowBytes() const;
+
+  /// Returns the spill partitions with the most bytes of rows in the row
+  /// containers of 'spillers' whose rows add up to at least 'targetBytes'.
+  /// Returns an empty set if 'targetBytes' is 0 or if all the partitions with
+  /// rows need to be spilled.
+  static SpillPartitionNumSet partitionsToSpill(
+      const std::vector<Spiller*>& spillers,
+      uint64_t targetBytes);
+
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
   /// hash join build and hash join probe.
@@ -217,6 +240,9 @@ class Spiller {
       common::CompressionKind compressionKind,
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       folly::Executor* executor,
+      folly::Executor* writeExecutor,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
+      bool columnarFormat,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
@@ -292,16 +318,20 @@ class Spiller {
 
   // Prepares spill runs for the spillable data from all the hash partitions.
   // If 'startRowIter' is not null, we prepare runs starting from the offset
-  // pointed by 'startRowIter'.
+  // pointed by 'startRowIter'. If 'partitions' is not null, only prepares runs
+  // for the rows of 'partitions'.
   // The function returns true if it is the last spill run.
-  bool fillSpillRuns(RowContainerIterator* startRowIter = nullptr);
+  bool fillSpillRuns(
+      RowContainerIterator* startRowIter = nullptr,
+      const SpillPartitionNumSet* partitions = nullptr);
 
   // Prepares spill run of a single partition for the spillable data from the
   // rows.
   void fillSpillRun(SpillRows& rows);
 
-  // Writes out all the rows collected in spillRuns_.
-  void runSpill(bool lastRun);
+  // Writes out all the rows collected in spillRuns_. If 'eraseRows' is true,
+  // erases the written rows from the row container.
+  void runSpill(bool lastRun, bool eraseRows = false);
 
   // Sorts 'run' if not already sorted.
   void ensureSorted(SpillRun& run);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitResultCache.h"
+
+namespace facebook::velox::exec {
+namespace {
+std::atomic<SplitResultCache*>& instance() {
+  static std::atomic<SplitResultCache*> cache{nullptr};
+  return cache;
+}
+} // namespace
+
+// static
+SplitResultCache* SplitResultCache::getInstance() {
+  return instance().load();
+}
+
+// static
+void SplitResultCache::setInstance(SplitResultCache* cache) {
+  instance() = cache;
+}
+
+std::shared_ptr<const SplitResultCache::Batches> SplitResultCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++stats_.numMisses;
+    return nullptr;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.batches;
+}
+
+void SplitResultCache::insert(const std::string& key, Batches batches) {
+  uint64_t bytes = 0;
+  for (const auto& batch : batches) {
+    VELOX_CHECK_EQ(batch->pool(), pool_.get());
+    bytes += batch->retainedSize();
+  }
+  if (bytes > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) != 0) {
+    // Another driver read the same split.
+    return;
+  }
+  evictLocked(bytes);
+  lru_.push_front(key);
+  entries_.emplace(
+      key,
+      Entry{
+          std::make_shared<const Batches>(std::move(batches)),
+          bytes,
+          lru_.begin()});
+  ++stats_.numEntries;
+  stats_.numBytes += bytes;
+}
+
+void SplitResultCache::evictLocked(uint64_t bytes) {
+  while (!lru_.empty() && stats_.numBytes + bytes > capacity_) {
+    auto it = entries_.find(lru_.back());
+    stats_.numBytes -= it->second.bytes;
+    --stats_.numEntries;
+    ++stats_.numEvictions;
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+void SplitResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_.numEntries = 0;
+  stats_.numBytes = 0;
+}
+
+SplitResultCache::Stats SplitResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+} // namespace facebook::velox::exec
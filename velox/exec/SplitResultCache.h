@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Process-wide cache of the output of table scans over single splits, for
+/// repeated scans of immutable data, e.g. dashboards over sealed partitions.
+/// The key identifies both the scan, i.e. its table handle with filters and
+/// pushed down aggregates, its output type and column handles, and the data
+/// of the split, including its version. See
+/// ConnectorSplit::resultCacheKey(). The batches of an entry are allocated
+/// from the pool of the cache so that they outlive the query which read
+/// them. Entries are evicted least recently used first to stay within
+/// 'capacity' bytes.
+class SplitResultCache {
+ public:
+  using Batches = std::vector<RowVectorPtr>;
+
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+  };
+
+  SplitResultCache(std::shared_ptr<memory::MemoryPool> pool, uint64_t capacity)
+      : pool_(std::move(pool)), capacity_(capacity) {
+    VELOX_CHECK_NOT_NULL(pool_);
+  }
+
+  ~SplitResultCache() {
+    clear();
+  }
+
+  /// Returns the process-wide cache, or nullptr if there is none.
+  static SplitResultCache* getInstance();
+
+  /// Sets the process-wide cache. The caller keeps ownership.
+  static void setInstance(SplitResultCache* cache);
+
+  /// Returns the batches stored for 'key', or nullptr if there are none.
+  std::shared_ptr<const Batches> find(const std::string& key);
+
+  /// Stores 'batches' for 'key'. The batches must have been copied into
+  /// pool(). Evicts the least recently used entries to make room. Does
+  /// nothing if the batches alone are larger than capacity().
+  void insert(const std::string& key, Batches batches);
+
+  /// Removes all the entries.
+  void clear();
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const Batches> batches;
+    uint64_t bytes;
+    // Position in 'lru_'.
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  void evictLocked(uint64_t bytes);
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  // The keys of 'entries_', most recently used first.
+  std::list<std::string> lru_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::exec
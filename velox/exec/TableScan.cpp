@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <folly/json.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
@@ -48,7 +49,11 @@ TableScan::TableScan(
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
-          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
+          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      resultCache_(
+          driverCtx_->queryConfig().tableScanResultCacheEnabled()
+              ? SplitResultCache::getInstance()
+              : nullptr) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -103,16 +108,38 @@ RowVectorPtr TableScan::getOutput() {
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
       exec::Split split;
-      curStatus_ = "getOutput: task->getSplitOrFuture";
-      blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId,
-          planNodeId(),
-          split,
-          blockingFuture_,
-          maxPreloadedSplits_,
-          splitPreloader_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        return nullptr;
+      if (preloadingSplit_.has_value()) {
+        curStatus_ = "getOutput: preloaded split ready";
+        split = std::move(preloadingSplit_.value());
+        preloadingSplit_.reset();
+      } else if (FOLLY_UNLIKELY(
+                     driverCtx_->task->shouldRetireDriver(*driverCtx_))) {
+        // The pipeline has more Drivers than it can use. Finishes this one as
+        // if there were no more splits.
+        curStatus_ = "getOutput: retired by task";
+      } else {
+        curStatus_ = "getOutput: task->getSplitOrFuture";
+        blockingReason_ = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            split,
+            blockingFuture_,
+            maxPreloadedSplits_,
+            splitPreloader_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
+        if (split.hasConnectorSplit() &&
+            split.connectorSplit->dataSource != nullptr &&
+            !split.connectorSplit->dataSource->readyOrFuture(
+                &blockingFuture_)) {
+          // The DataSource is still being made on the connector's executor.
+          // Waits off thread until it is ready.
+          ++numWaitedPreloadedSplits_;
+          preloadingSplit_ = std::move(split);
+          blockingReason_ = BlockingReason::kWaitForConnector;
+          return nullptr;
+        }
       }
 
       if (!split.hasConnectorSplit()) {
@@ -120,18 +147,7 @@ RowVectorPtr TableScan::getOutput() {
         dynamicFilters_.clear();
         if (dataSource_) {
           curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
-          const auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.emplace(
-                  name, RuntimeMetric(counter.unit));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
+          addDataSourceStats();
         }
         return nullptr;
       }
@@ -177,6 +193,24 @@ RowVectorPtr TableScan::getOutput() {
            },
            &debugString_});
 
+      resultCacheKey_ = resultCacheKey(*connectorSplit);
+      if (resultCacheKey_.has_value()) {
+        cachedBatches_ = resultCache_->find(*resultCacheKey_);
+        if (cachedBatches_ != nullptr) {
+          curStatus_ = "getOutput: split result cache hit";
+          resultCacheKey_.reset();
+          nextCachedBatch_ = 0;
+          if (connectorSplit->dataSource != nullptr) {
+            connectorSplit->dataSource->close();
+          }
+          auto lockedStats = stats_.wlock();
+          ++lockedStats->numSplits;
+          lockedStats->addRuntimeStat(
+              "splitResultCacheHits", RuntimeCounter(1));
+          continue;
+        }
+      }
+
       if (connectorSplit->dataSource != nullptr) {
         curStatus_ = "getOutput: preloaded split";
         ++numPreloadedSplits_;
@@ -228,12 +262,40 @@ RowVectorPtr TableScan::getOutput() {
          },
          &debugString_});
 
+    if (cachedBatches_ != nullptr) {
+      if (nextCachedBatch_ < cachedBatches_->size()) {
+        auto data = (*cachedBatches_)[nextCachedBatch_++];
+        stats_.wlock()->addInputVector(data->estimateFlatSize(), data->size());
+        numOutputRows_ += data->size();
+        if (rowLimit_.has_value() && numOutputRows_ >= *rowLimit_) {
+          cachedBatches_.reset();
+          finishAtRowLimit();
+        }
+        return data;
+      }
+      cachedBatches_.reset();
+      curStatus_ = "getOutput: task->splitFinished";
+      driverCtx_->task->splitFinished(true, currentSplitWeight_);
+      needNewSplit_ = true;
+      hasCompletedSplit_ = true;
+      continue;
+    }
+
     int32_t readBatchSize = readBatchSize_;
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
           static_cast<int32_t>(readBatchSize / maxFilteringRatio_));
     }
+    if (rowLimit_.has_value()) {
+      // Reads about as many rows as needed to produce the remaining rows.
+      const uint64_t remainingRows = *rowLimit_ - numOutputRows_;
+      const uint64_t limitBatchSize = maxFilteringRatio_ > 0
+          ? remainingRows / maxFilteringRatio_
+          : remainingRows;
+      readBatchSize = std::max<uint64_t>(
+          1, std::min<uint64_t>(readBatchSize, limitBatchSize));
+    }
     curStatus_ = "getOutput: dataSource_->next";
     uint64_t ioTimeUs{0};
     std::optional<RowVectorPtr> dataOptional;
@@ -268,6 +330,14 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          numOutputRows_ += data->size();
+          if (rowLimit_.has_value() && numOutputRows_ >= *rowLimit_) {
+            lockedStats.unlock();
+            finishAtRowLimit();
+          } else if (resultCacheKey_.has_value()) {
+            lockedStats.unlock();
+            collectForResultCache(data);
+          }
           return data;
         }
         continue;
@@ -287,14 +357,115 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numWaitedPreloadedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "waitedPreloadedSplits",
+            RuntimeCounter(numWaitedPreloadedSplits_));
+        numWaitedPreloadedSplits_ = 0;
+      }
+    }
+
+    if (resultCacheKey_.has_value()) {
+      curStatus_ = "getOutput: adding split result to cache";
+      resultCache_->insert(*resultCacheKey_, std::move(resultCacheBatches_));
+      dropResultCacheBatches();
     }
 
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
+    hasCompletedSplit_ = true;
   }
 }
 
+std::optional<std::string> TableScan::resultCacheKey(
+    const connector::ConnectorSplit& split) {
+  // Dynamic filters depend on the other side of a join.
+  if (resultCache_ == nullptr || !dynamicFilters_.empty()) {
+    return std::nullopt;
+  }
+  auto splitKey = split.resultCacheKey();
+  if (!splitKey.has_value()) {
+    return std::nullopt;
+  }
+  if (resultCacheScanKey_.empty()) {
+    folly::dynamic assignments = folly::dynamic::object;
+    for (const auto& [name, handle] : columnHandles_) {
+      assignments[name] = handle->serialize();
+    }
+    folly::dynamic scan = folly::dynamic::object;
+    scan["tableHandle"] = tableHandle_->serialize();
+    scan["outputType"] = outputType_->serialize();
+    scan["assignments"] = std::move(assignments);
+    // The connector session properties and the timestamp handling of the
+    // session change how the connector reads the same split.
+    folly::dynamic sessionProperties = folly::dynamic::object;
+    for (const auto& [name, value] :
+         connectorQueryCtx_->sessionProperties()->rawConfigsCopy()) {
+      sessionProperties[name] = value;
+    }
+    scan["sessionProperties"] = std::move(sessionProperties);
+    scan["sessionTimezone"] = connectorQueryCtx_->sessionTimezone();
+    scan["adjustTimestampToTimezone"] =
+        connectorQueryCtx_->adjustTimestampToTimezone();
+    folly::json::serialization_opts opts;
+    opts.sort_keys = true;
+    resultCacheScanKey_ = folly::json::serialize(scan, opts);
+  }
+  // JSON has no raw line breaks, so the separator is unambiguous.
+  return fmt::format("{}\n{}", resultCacheScanKey_, splitKey.value());
+}
+
+void TableScan::collectForResultCache(const RowVectorPtr& data) {
+  // Loads the lazy columns, which cannot be loaded after the next batch is
+  // read.
+  data->loadedVector();
+  auto copy = std::static_pointer_cast<RowVector>(
+      BaseVector::copy(*data, resultCache_->pool()));
+  resultCacheBytes_ += copy->retainedSize();
+  if (resultCacheBytes_ > resultCache_->capacity()) {
+    dropResultCacheBatches();
+    return;
+  }
+  resultCacheBatches_.push_back(std::move(copy));
+}
+
+void TableScan::dropResultCacheBatches() {
+  resultCacheKey_.reset();
+  resultCacheBatches_.clear();
+  resultCacheBytes_ = 0;
+}
+
+void TableScan::addDataSourceStats() {
+  const auto connectorStats = dataSource_->runtimeStats();
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
+void TableScan::finishAtRowLimit() {
+  curStatus_ = "getOutput: finishAtRowLimit";
+  // The rows of the split are incomplete.
+  dropResultCacheBatches();
+  dataSource_->setRowLimit(0);
+  driverCtx_->task->splitFinished(true, currentSplitWeight_);
+  if (preloadingSplit_.has_value()) {
+    preloadingSplit_->connectorSplit->dataSource->close();
+    preloadingSplit_.reset();
+  }
+  noMoreSplits_ = true;
+  dynamicFilters_.clear();
+  addDataSourceStats();
+  stats_.wlock()->addRuntimeStat(
+      "finishedAtRowLimit", RuntimeCounter(*rowLimit_));
+}
+
 void TableScan::preload(
     const std::shared_ptr<connector::ConnectorSplit>& split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
@@ -342,6 +513,9 @@ void TableScan::checkPreload() {
       !connector_->supportsSplitPreload()) {
     return;
   }
+  if (rowLimit_.has_value() && !hasCompletedSplit_) {
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         maxSplitPreloadPerDriver_;
@@ -364,6 +538,15 @@ bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::close() {
+  if (preloadingSplit_.has_value()) {
+    // Waits for the preload in progress and frees the unused DataSource.
+    preloadingSplit_->connectorSplit->dataSource->close();
+    preloadingSplit_.reset();
+  }
+  Operator::close();
+}
+
 void TableScan::addDynamicFilter(
     const core::PlanNodeId& producer,
     column_index_t outputChannel,
@@ -371,6 +554,7 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
+  dropResultCacheBatches();
   auto& currentFilter = dynamicFilters_[outputChannel];
   if (currentFilter) {
     currentFilter = currentFilter->mergeWith(filter.get());
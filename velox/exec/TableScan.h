@@ -17,6 +17,7 @@
 
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SplitResultCache.h"
 
 namespace facebook::velox::exec {
 
@@ -41,6 +42,8 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  void close() override;
+
   bool canAddDynamicFilter() const override {
     return connector_->canAddDynamicFilter();
   }
@@ -50,6 +53,14 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  /// Sets the number of rows after which the consumer of 'this' stops, e.g.
+  /// a Limit right after the scan. The scan then reads batches of at most the
+  /// remaining rows, does not preload splits until a split turns out to not
+  /// be enough and finishes as soon as 'numRows' rows are produced.
+  void setRowLimit(uint64_t numRows) {
+    rowLimit_ = numRows;
+  }
+
  private:
   // Checks if this table scan operator needs to yield before processing the
   // next split.
@@ -59,6 +70,27 @@ class TableScan : public SourceOperator {
   // terminated.
   bool shouldStop(StopReason taskStopReason) const;
 
+  // Updates the runtime stats from the stats of 'dataSource_'. Called when
+  // the scan is at end.
+  void addDataSourceStats();
+
+  // Finishes the scan after 'rowLimit_' rows are produced. Frees the current
+  // split and the split being preloaded.
+  void finishAtRowLimit();
+
+  // Returns the key of 'split' in 'resultCache_', or std::nullopt if the rows
+  // of the split are not cached. The key covers the scan, the connector
+  // session properties and the session timezone settings besides the split.
+  std::optional<std::string> resultCacheKey(
+      const connector::ConnectorSplit& split);
+
+  // Adds a copy of 'data' to the rows of the current split collected for
+  // 'resultCache_'. Stops collecting if the rows do not fit in the cache.
+  void collectForResultCache(const RowVectorPtr& data);
+
+  // Stops collecting the rows of the current split for 'resultCache_'.
+  void dropResultCacheBatches();
+
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching splits is
   // appropriate. The preloader will be applied to the 'first 'maxPreloadSplits'
   // of the Task's split queue for 'this' when getting splits.
@@ -90,6 +122,13 @@ class TableScan : public SourceOperator {
 
   int32_t maxPreloadedSplits_{0};
 
+  // See setRowLimit(). 'numOutputRows_' counts the rows produced so far.
+  std::optional<uint64_t> rowLimit_;
+  uint64_t numOutputRows_{0};
+  // True after a split was read to the end. Splits are not preloaded before
+  // if there is a row limit, as the first split may have enough rows.
+  bool hasCompletedSplit_{false};
+
   const int32_t maxSplitPreloadPerDriver_{0};
 
   // Callback passed to getSplitOrFuture() for triggering async preload. The
@@ -105,6 +144,15 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Count of splits for which the Driver went off thread to wait for the
+  // preload to finish.
+  int32_t numWaitedPreloadedSplits_{0};
+
+  // A split from the Task whose DataSource is being made on the connector's
+  // executor. Kept while the Driver waits for the preload to finish instead of
+  // blocking in AsyncSource::move().
+  std::optional<exec::Split> preloadingSplit_;
+
   vector_size_t readBatchSize_;
   vector_size_t maxReadBatchSize_;
 
@@ -112,6 +160,20 @@ class TableScan : public SourceOperator {
   // limit'.
   size_t getOutputTimeLimitMs_{0};
 
+  // The process-wide cache of split results if enabled for the query. See
+  // QueryConfig::kTableScanResultCacheEnabled.
+  SplitResultCache* const resultCache_;
+  // Identifies this scan in the keys of 'resultCache_'. Made on first use.
+  std::string resultCacheScanKey_;
+  // The cached rows of the current split and the next batch to return.
+  std::shared_ptr<const SplitResultCache::Batches> cachedBatches_;
+  size_t nextCachedBatch_{0};
+  // The key of the current split while its rows are collected into
+  // 'resultCacheBatches_'.
+  std::optional<std::string> resultCacheKey_;
+  SplitResultCache::Batches resultCacheBatches_;
+  uint64_t resultCacheBytes_{0};
+
   double maxFilteringRatio_{0};
 
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
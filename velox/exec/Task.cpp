@@ -141,17 +141,91 @@ void buildSplitStates(
   }
 }
 
+// Sets the split order of the table scan which produces the first sorting
+// key of 'topN' through filters and renaming projections, if any.
+void setTopNSplitOrder(
+    const core::TopNNode& topN,
+    std::unordered_map<core::PlanNodeId, SplitsState>& splitStateMap) {
+  std::string name = topN.sortingKeys()[0]->name();
+  const auto& sortOrder = topN.sortingOrders()[0];
+  const core::PlanNode* node = topN.sources()[0].get();
+  for (;;) {
+    if (auto* project = dynamic_cast<const core::ProjectNode*>(node)) {
+      const auto index = project->outputType()->getChildIdxIfExists(name);
+      if (!index.has_value()) {
+        return;
+      }
+      auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(
+          project->projections()[index.value()].get());
+      if (field == nullptr || !field->isInputColumn()) {
+        return;
+      }
+      name = field->name();
+    } else if (auto* scan = dynamic_cast<const core::TableScanNode*>(node)) {
+      auto assignment = scan->assignments().find(name);
+      auto state = splitStateMap.find(scan->id());
+      if (assignment != scan->assignments().end() &&
+          state != splitStateMap.end()) {
+        state->second.splitOrder = SplitOrder{
+            assignment->second->name(),
+            sortOrder.isAscending(),
+            sortOrder.isNullsFirst()};
+      }
+      return;
+    } else if (dynamic_cast<const core::FilterNode*>(node) == nullptr) {
+      return;
+    }
+    node = node->sources()[0].get();
+  }
+}
+
+void setSplitOrders(
+    const core::PlanNode* planNode,
+    std::unordered_map<core::PlanNodeId, SplitsState>& splitStateMap) {
+  if (auto* topN = dynamic_cast<const core::TopNNode*>(planNode)) {
+    setTopNSplitOrder(*topN, splitStateMap);
+  }
+  for (const auto& child : planNode->sources()) {
+    setSplitOrders(child.get(), splitStateMap);
+  }
+}
+
 // Returns a map of ids of source (leaf) plan nodes expecting splits.
 // SplitsState structures are initialized to blank states. Also, checks that
 // plan node IDs are unique and throws if encounters duplicates.
 std::unordered_map<core::PlanNodeId, SplitsState> buildSplitStates(
-    const std::shared_ptr<const core::PlanNode>& planNode) {
+    const std::shared_ptr<const core::PlanNode>& planNode,
+    const core::QueryConfig& queryConfig) {
   std::unordered_set<core::PlanNodeId> allIds;
   std::unordered_map<core::PlanNodeId, SplitsState> splitStateMap;
   buildSplitStates(planNode.get(), allIds, splitStateMap);
+  if (queryConfig.topNSplitOrderingEnabled()) {
+    setSplitOrders(planNode.get(), splitStateMap);
+  }
   return splitStateMap;
 }
 
+// Returns true if 'split' should be read before 'queued' by 'order'. The
+// splits without a range of the column are read last.
+bool readBefore(
+    const SplitOrder& order,
+    const connector::ConnectorSplit& split,
+    const connector::ConnectorSplit& queued) {
+  const auto* range = split.columnRange(order.column);
+  if (range == nullptr) {
+    return false;
+  }
+  const auto* queuedRange = queued.columnRange(order.column);
+  if (queuedRange == nullptr) {
+    return true;
+  }
+  if (order.nullsFirst && range->mayHaveNulls != queuedRange->mayHaveNulls) {
+    return range->mayHaveNulls;
+  }
+  return order.ascending ? range->min < queuedRange->min
+                         : queuedRange->max < range->max;
+}
+
 std::string makeUuid() {
   return boost::lexical_cast<std::string>(boost::uuids::random_generator()());
 }
@@ -295,7 +369,9 @@ Task::Task(
       traceConfig_(maybeMakeTraceConfig()),
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(std::move(onError)),
-      splitsStates_(buildSplitStates(planFragment_.planNode)),
+      splitsStates_(buildSplitStates(
+          planFragment_.planNode,
+          queryCtx_->queryConfig())),
       bufferManager_(OutputBufferManager::getInstance()) {
   // NOTE: the executor must not be folly::InlineLikeExecutor for parallel
   // execution.
@@ -305,6 +381,12 @@ Task::Task(
   }
 
   maybeInitTrace();
+
+  const auto& queryConfig = queryCtx_->queryConfig();
+  if (!queryConfig.taskTimelineDir().empty()) {
+    timeline_ =
+        std::make_unique<TaskTimeline>(queryConfig.taskTimelineMaxEvents());
+  }
 }
 
 Task::~Task() {
@@ -452,7 +534,42 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+const std::string& Task::getOrCreateRemoteSpillDirectory() {
+  VELOX_CHECK(!remoteSpillDirectory_.empty(), "Remote spill directory not set");
+  if (remoteSpillDirectoryCreated_) {
+    return remoteSpillDirectory_;
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (remoteSpillDirectoryCreated_) {
+    return remoteSpillDirectory_;
+  }
+  try {
+    auto fileSystem =
+        filesystems::getFileSystem(remoteSpillDirectory_, nullptr);
+    fileSystem->mkdir(remoteSpillDirectory_);
+  } catch (const std::exception& e) {
+    VELOX_FAIL(
+        "Failed to create remote spill directory '{}' for Task {}: {}",
+        remoteSpillDirectory_,
+        taskId(),
+        e.what());
+  }
+  remoteSpillDirectoryCreated_ = true;
+  return remoteSpillDirectory_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  if (!remoteSpillDirectory_.empty() && remoteSpillDirectoryCreated_) {
+    try {
+      auto fs = filesystems::getFileSystem(remoteSpillDirectory_, nullptr);
+      fs->rmdir(remoteSpillDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove remote spill directory '"
+                 << remoteSpillDirectory_ << "' for Task " << taskId() << ": "
+                 << e.what();
+    }
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -609,7 +726,7 @@ bool Task::supportSerialExecutionMode() const {
       planFragment_, nullptr, &driverFactories, queryCtx_->queryConfig(), 1);
 
   for (const auto& factory : driverFactories) {
-    if (!factory->supportsSerialExecution()) {
+    if (!factory->supportsSerialExecution(queryCtx_->executor() != nullptr)) {
       return false;
     }
   }
@@ -650,16 +767,20 @@ RowVectorPtr Task::next(ContinueFuture* future) {
     taskStats_.executionStartTimeMs = getCurrentTimeMs();
     LocalPlanner::plan(
         planFragment_, nullptr, &driverFactories_, queryCtx_->queryConfig(), 1);
-    exchangeClients_.resize(driverFactories_.size());
 
     // In Task::next() we always assume ungrouped execution.
     for (const auto& factory : driverFactories_) {
-      VELOX_CHECK(factory->supportsSerialExecution());
+      VELOX_CHECK(
+          factory->supportsSerialExecution(queryCtx_->executor() != nullptr));
       numDriversUngrouped_ += factory->numDrivers;
       numTotalDrivers_ += factory->numTotalDrivers;
       taskStats_.pipelineStats.emplace_back(
           factory->inputDriver, factory->outputDriver);
     }
+    // Creates the exchange clients and the output buffers of a
+    // PartitionedOutput. The consumers of the output buffers fetch the
+    // results through OutputBufferManager while next() returns nullptr.
+    initializePartitionOutput();
 
     // Create drivers.
     createSplitGroupStateLocked(kUngroupedGroupId);
@@ -868,10 +989,14 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
     //
     // We might have first slots taken for grouped execution drivers, so need
     // only to enqueue the ungrouped execution drivers.
+    initializeAdaptiveDriversLocked();
     for (auto it = drivers_.end() - numDriversUngrouped_; it != drivers_.end();
          ++it) {
       if (*it) {
         ++numRunningDrivers_;
+        if (makeStandbyDriverLocked(*it)) {
+          continue;
+        }
         Driver::enqueue(*it);
       }
     }
@@ -981,6 +1106,10 @@ void Task::resume(std::shared_ptr<Task> self) {
           // enqueued twice.
           continue;
         }
+        if (driver->state().isStandby) {
+          // Started by its pipeline when needed.
+          continue;
+        }
         VELOX_CHECK(!driver->isOnThread() && !driver->isTerminated());
         if (!driver->state().hasBlockingFuture &&
             driver->task()->queryCtx()->isExecutorSupplied()) {
@@ -1180,6 +1309,7 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
       if (self->isOutputPipeline(pipelineId)) {
         ++splitGroupState.numFinishedOutputDrivers;
       }
+      self->adaptiveDriverFinishedLocked(driver);
 
       // Release the driver, note that after this 'driver' is invalid.
       driverPtr = nullptr;
@@ -1354,9 +1484,26 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     }
   }
 
+  std::function<bool(
+      const connector::ConnectorSplit&, const connector::ConnectorSplit&)>
+      readFirst;
+  if (splitsState.sourceIsTableScan && split.connectorSplit != nullptr) {
+    if (splitsState.splitOrder.has_value()) {
+      readFirst = [&order = splitsState.splitOrder.value()](
+                      const auto& next, const auto& queued) {
+        return readBefore(order, next, queued);
+      };
+    } else if (queryCtx_->queryConfig().largestSplitFirst()) {
+      readFirst = [](const auto& next, const auto& queued) {
+        return next.estimatedCost() > queued.estimatedCost();
+      };
+    }
+  }
   if (!split.hasGroup()) {
     return addSplitToStoreLocked(
-        splitsState.groupSplitsStores[kUngroupedGroupId], std::move(split));
+        splitsState.groupSplitsStores[kUngroupedGroupId],
+        std::move(split),
+        readFirst);
   }
 
   const auto splitGroupId = split.groupId;
@@ -1369,13 +1516,31 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     ensureSplitGroupsAreBeingProcessedLocked();
   }
   return addSplitToStoreLocked(
-      splitsState.groupSplitsStores[splitGroupId], std::move(split));
+      splitsState.groupSplitsStores[splitGroupId], std::move(split), readFirst);
 }
 
 std::unique_ptr<ContinuePromise> Task::addSplitToStoreLocked(
     SplitsStore& splitsStore,
-    exec::Split&& split) {
-  splitsStore.splits.push_back(split);
+    exec::Split&& split,
+    const std::function<bool(
+        const connector::ConnectorSplit&,
+        const connector::ConnectorSplit&)>& readFirst) {
+  if (readFirst) {
+    auto& splits = splitsStore.splits;
+    // The splits being preloaded are at the front and keep their place.
+    auto it = splits.begin();
+    while (it != splits.end() && it->connectorSplit != nullptr &&
+           it->connectorSplit->dataSource != nullptr) {
+      ++it;
+    }
+    it = std::find_if(it, splits.end(), [&](const exec::Split& queued) {
+      return queued.connectorSplit == nullptr ||
+          readFirst(*split.connectorSplit, *queued.connectorSplit);
+    });
+    splits.insert(it, std::move(split));
+  } else {
+    splitsStore.splits.push_back(split);
+  }
   if (splitsStore.splitPromises.empty()) {
     return nullptr;
   }
@@ -1525,6 +1690,144 @@ BlockingReason Task::getSplitOrFuture(
       preload);
 }
 
+void Task::initializeAdaptiveDriversLocked() {
+  if (!queryCtx_->queryConfig().adaptiveTableScanDriversEnabled() ||
+      !queryCtx_->isExecutorSupplied()) {
+    return;
+  }
+  adaptiveDriversIntervalMs_ =
+      queryCtx_->queryConfig().adaptiveTableScanDriversIntervalMs();
+  adaptiveDrivers_.resize(driverFactories_.size());
+  for (auto pipeline = 0; pipeline < driverFactories_.size(); ++pipeline) {
+    const auto& factory = driverFactories_[pipeline];
+    if (factory->groupedExecution || factory->numDrivers < 2) {
+      continue;
+    }
+    const auto& sourceNode = factory->planNodes.front();
+    if (std::dynamic_pointer_cast<const core::TableScanNode>(sourceNode) ==
+        nullptr) {
+      continue;
+    }
+    auto adaptive = std::make_unique<AdaptiveDrivers>();
+    adaptive->scanNodeId = sourceNode->id();
+    adaptive->intervalStartMs = getCurrentTimeMs();
+    adaptiveDrivers_[pipeline] = std::move(adaptive);
+  }
+}
+
+bool Task::makeStandbyDriverLocked(const std::shared_ptr<Driver>& driver) {
+  const auto pipelineId = driver->driverCtx()->pipelineId;
+  if (adaptiveDrivers_.empty() || adaptiveDrivers_[pipelineId] == nullptr) {
+    return false;
+  }
+  auto& adaptive = *adaptiveDrivers_[pipelineId];
+  // Starts half of the Drivers, rounded up.
+  const auto numDrivers = driverFactories_[pipelineId]->numDrivers;
+  if (adaptive.numActive < (numDrivers + 1) / 2) {
+    ++adaptive.numActive;
+    return false;
+  }
+  driver->state().isStandby = true;
+  adaptive.standby.push_back(driver);
+  return true;
+}
+
+size_t Task::startStandbyDriversLocked(
+    uint32_t pipelineId,
+    size_t numDrivers) {
+  auto& adaptive = *adaptiveDrivers_[pipelineId];
+  size_t numStarted = 0;
+  while (numStarted < numDrivers && !adaptive.standby.empty()) {
+    auto driver = adaptive.standby.back().lock();
+    adaptive.standby.pop_back();
+    if (driver == nullptr || driver->isTerminated()) {
+      continue;
+    }
+    driver->state().isStandby = false;
+    ++adaptive.numActive;
+    ++numStarted;
+    if (!pauseRequested_) {
+      // Otherwise, the Driver is enqueued on resume.
+      Driver::enqueue(driver);
+    }
+  }
+  return numStarted;
+}
+
+void Task::adaptiveDriverFinishedLocked(const Driver* driver) {
+  const auto pipelineId = driver->driverCtx()->pipelineId;
+  if (adaptiveDrivers_.empty() || adaptiveDrivers_[pipelineId] == nullptr) {
+    return;
+  }
+  auto& adaptive = *adaptiveDrivers_[pipelineId];
+  if (adaptive.retired.erase(driver) == 0) {
+    VELOX_CHECK_GT(adaptive.numActive, 0);
+    --adaptive.numActive;
+  }
+  if (adaptive.numActive == 0) {
+    // The running Drivers finished early, e.g. because of a limit. The
+    // standby Drivers need to run to finish the pipeline.
+    startStandbyDriversLocked(pipelineId, adaptive.standby.size());
+  }
+}
+
+void Task::addDriverBlockedTimeLocked(
+    uint32_t pipelineId,
+    BlockingReason reason,
+    uint64_t blockedMicros) {
+  if (adaptiveDrivers_.empty() || adaptiveDrivers_[pipelineId] == nullptr) {
+    return;
+  }
+  if (reason == BlockingReason::kWaitForSplit) {
+    // Waiting for splits is a lack of work, not of capacity downstream.
+    return;
+  }
+  adaptiveDrivers_[pipelineId]->blockedMicros += blockedMicros;
+}
+
+bool Task::shouldRetireDriver(const DriverCtx& driverCtx) {
+  const auto pipelineId = driverCtx.pipelineId;
+  // 'adaptiveDrivers_' is set before the Drivers start.
+  if (adaptiveDrivers_.empty() || adaptiveDrivers_[pipelineId] == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& adaptive = *adaptiveDrivers_[pipelineId];
+  const auto& splitsStore = getPlanNodeSplitsStateLocked(adaptive.scanNodeId)
+                                .groupSplitsStores[kUngroupedGroupId];
+  if (splitsStore.splits.empty()) {
+    if (splitsStore.noMoreSplits) {
+      // The standby Drivers find no splits and finish.
+      startStandbyDriversLocked(pipelineId, adaptive.standby.size());
+    }
+    return false;
+  }
+
+  const auto nowMs = getCurrentTimeMs();
+  const auto intervalMs = nowMs - adaptive.intervalStartMs;
+  if (intervalMs < adaptiveDriversIntervalMs_) {
+    return false;
+  }
+  // The fraction of the interval the running Drivers were blocked, e.g.
+  // waiting for the consumer.
+  const double blockedRatio = adaptive.blockedMicros /
+      (1'000.0 * std::max<uint64_t>(intervalMs, 1) * adaptive.numActive);
+  adaptive.intervalStartMs = nowMs;
+  adaptive.blockedMicros = 0;
+  if (blockedRatio >= 0.5 && adaptive.numActive > 1) {
+    // More Drivers don't help when the running ones are mostly blocked.
+    --adaptive.numActive;
+    adaptive.retired.insert(driverCtx.driver);
+    ++taskStats_.numAdaptiveDriversRetired;
+    return true;
+  }
+  if (blockedRatio <= 0.1 && splitsStore.splits.size() > adaptive.numActive) {
+    taskStats_.numAdaptiveDriversStarted +=
+        startStandbyDriversLocked(pipelineId, 1);
+  }
+  return false;
+}
+
 BlockingReason Task::getSplitOrFutureLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
@@ -1940,6 +2243,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
   std::vector<std::shared_ptr<Driver>> offThreadDrivers;
   EventCompletionNotifier taskCompletionNotifier;
   EventCompletionNotifier stateChangeNotifier;
+  bool completed{false};
   std::vector<std::shared_ptr<ExchangeClient>> exchangeClients;
   {
     std::lock_guard<std::timed_mutex> l(mutex_);
@@ -1975,6 +2279,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
 
     taskCompletionNotifier.activate(
         std::move(taskCompletionPromises_), [&]() { onTaskCompletion(); });
+    completed = true;
     stateChangeNotifier.activate(std::move(stateChangePromises_));
 
     // Update the total number of drivers if we were cancelled.
@@ -1999,6 +2304,11 @@ ContinueFuture Task::terminate(TaskState terminalState) {
     exchangeClients.swap(exchangeClients_);
   }
 
+  if (completed) {
+    // Written before the completion is notified so that the file is there
+    // for the waiters.
+    maybeWriteTimeline();
+  }
   taskCompletionNotifier.notify();
   stateChangeNotifier.notify();
 
@@ -2292,6 +2602,20 @@ Task::DriverCounts Task::driverCounts() const {
   return ret;
 }
 
+void Task::maybeWriteTimeline() {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  const auto path = fmt::format(
+      "{}/{}.json", queryCtx_->queryConfig().taskTimelineDir(), taskId_);
+  try {
+    timeline_->write(path);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to write the timeline of task " << taskId_
+                 << " to " << path << ": " << e.what();
+  }
+}
+
 void Task::onTaskCompletion() {
   listeners().withRLock([&](auto& listeners) {
     if (listeners.empty()) {
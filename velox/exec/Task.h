@@ -24,6 +24,7 @@
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/exec/TaskTimeline.h"
 #include "velox/exec/TaskTraceWriter.h"
 #include "velox/exec/TraceConfig.h"
 #include "velox/vector/ComplexVector.h"
@@ -103,6 +104,17 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specify the directory on a remote file system to which data is spilled
+  /// once the query has spilled 'spill_local_quota_bytes' to the spill
+  /// directory. Set 'alreadyCreated' to true if the directory has already been
+  /// created by the caller.
+  void setRemoteSpillDirectory(
+      const std::string& remoteSpillDirectory,
+      bool alreadyCreated = false) {
+    remoteSpillDirectory_ = remoteSpillDirectory;
+    remoteSpillDirectoryCreated_ = alreadyCreated;
+  }
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -127,6 +139,23 @@ class Task : public std::enable_shared_from_this<Task> {
   /// disabled) when task is under serial mode.
   uint64_t driverCpuTimeSliceLimitMs() const;
 
+  /// Adds 'nanos' to the CPU time of the Drivers of this Task, measured per
+  /// Driver run.
+  void addDriverCpuNanos(uint64_t nanos) {
+    driverCpuNanos_.fetch_add(nanos, std::memory_order_relaxed);
+  }
+
+  /// Returns the CPU time used so far by the Drivers of this Task.
+  uint64_t driverCpuNanos() const {
+    return driverCpuNanos_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the timeline of the Operator calls of this Task or nullptr if
+  /// QueryConfig::kTaskTimelineDir is not set.
+  TaskTimeline* timeline() const {
+    return timeline_.get();
+  }
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
@@ -180,8 +209,11 @@ class Task : public std::enable_shared_from_this<Task> {
   /// more data will be produced. Throws an exception if query execution
   /// failed.
   ///
-  /// This API is available for query plans that do not use
-  /// PartitionedOutputNode and LocalPartitionNode plan nodes.
+  /// The results of a plan ending in a PartitionedOutputNode go to the
+  /// OutputBufferManager, where the consumers fetch them, and next() only
+  /// returns nullptr. A plan reading from an ExchangeNode needs an executor in
+  /// the QueryCtx to fetch the remote data on. The Exchange blocks externally
+  /// while waiting for the data, so that `future` must be provided.
   ///
   /// The caller is required to add all the necessary splits, and signal
   /// no-more-splits before calling 'next' for the first time.
@@ -418,6 +450,19 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t maxPreloadSplits = 0,
       const ConnectorSplitPreloadFunc& preload = nullptr);
 
+  /// Called by the TableScan of a pipeline with adaptive Drivers before it
+  /// takes the next split. Adjusts the number of running Drivers of the
+  /// pipeline. Returns true if the Driver of 'driverCtx' should finish as if
+  /// there were no more splits.
+  bool shouldRetireDriver(const DriverCtx& driverCtx);
+
+  /// Adds the time a Driver of 'pipelineId' was blocked for 'reason' to the
+  /// stats of the pipeline if it has adaptive Drivers.
+  void addDriverBlockedTimeLocked(
+      uint32_t pipelineId,
+      BlockingReason reason,
+      uint64_t blockedMicros);
+
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
   void multipleSplitsFinished(
@@ -650,6 +695,13 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  const std::string& remoteSpillDirectory() const {
+    return remoteSpillDirectory_;
+  }
+
+  /// Same as getOrCreateSpillDirectory() for the remote spill directory.
+  const std::string& getOrCreateRemoteSpillDirectory();
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -736,6 +788,22 @@ class Task : public std::enable_shared_from_this<Task> {
   // id. Throws if not found, meaning that plan node does not expect splits.
   SplitsState& getPlanNodeSplitsStateLocked(const core::PlanNodeId& planNodeId);
 
+  // Sets up 'adaptiveDrivers_' for the ungrouped pipelines which read from a
+  // TableScan if enabled in the query config.
+  void initializeAdaptiveDriversLocked();
+
+  // Returns true if 'driver' is not started with the Task but kept on standby
+  // by the adaptive Drivers of its pipeline.
+  bool makeStandbyDriverLocked(const std::shared_ptr<Driver>& driver);
+
+  // Starts up to 'numDrivers' standby Drivers of 'pipelineId'. Returns the
+  // number of started Drivers.
+  size_t startStandbyDriversLocked(uint32_t pipelineId, size_t numDrivers);
+
+  // Updates the adaptive Drivers of the pipeline of 'driver' when it
+  // finishes.
+  void adaptiveDriverFinishedLocked(const Driver* driver);
+
   // Validate that the supplied grouped execution leaf nodes make sense.
   void validateGroupedExecutionLeafNodes();
 
@@ -915,9 +983,15 @@ class Task : public std::enable_shared_from_this<Task> {
       SplitsState& splitsState,
       exec::Split&& split);
 
+  // Adds 'split' to 'splitsStore'. If 'readFirst' is set, the split is
+  // inserted before the first queued split which is not yet preloading and
+  // for which readFirst(split, queued) is true. Otherwise it is appended.
   std::unique_ptr<ContinuePromise> addSplitToStoreLocked(
       SplitsStore& splitsStore,
-      exec::Split&& split);
+      exec::Split&& split,
+      const std::function<bool(
+          const connector::ConnectorSplit&,
+          const connector::ConnectorSplit&)>& readFirst = nullptr);
 
   // Invoked when all the driver threads are off thread. The function returns
   // 'threadFinishPromises_' to fulfill.
@@ -986,6 +1060,9 @@ class Task : public std::enable_shared_from_this<Task> {
   // trace enabled.
   void maybeInitTrace();
 
+  // Writes 'timeline_' to QueryConfig::kTaskTimelineDir if set.
+  void maybeWriteTimeline();
+
   // Universally unique identifier of the task. Used to identify the task when
   // calling TaskListener.
   const std::string uuid_;
@@ -1057,6 +1134,28 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
   std::vector<std::shared_ptr<Driver>> drivers_;
+
+  // The state of a pipeline whose number of running Drivers adapts to its
+  // load. Guarded by 'mutex_'.
+  struct AdaptiveDrivers {
+    // The TableScan the pipeline reads from.
+    core::PlanNodeId scanNodeId;
+    // The Drivers which are created but not started yet. The Drivers are
+    // owned by 'drivers_'.
+    std::vector<std::weak_ptr<Driver>> standby;
+    // The Drivers which are started and neither retired nor finished.
+    uint32_t numActive{0};
+    // The Drivers which are retired but not finished yet.
+    folly::F14FastSet<const Driver*> retired;
+    // The start of the current adjustment interval.
+    uint64_t intervalStartMs{0};
+    // The time the Drivers were blocked in the current interval.
+    uint64_t blockedMicros{0};
+  };
+  // The adaptive Drivers by pipeline, nullptr for the pipelines without. Set
+  // at the Task start.
+  std::vector<std::unique_ptr<AdaptiveDrivers>> adaptiveDrivers_;
+  uint64_t adaptiveDriversIntervalMs_{0};
   // When Drivers are closed by the Task, there is a chance that race and/or
   // bugs can cause such Drivers to be held forever, in turn holding a pointer
   // to the Task making it a zombie Tasks. This vector is used to keep track of
@@ -1154,6 +1253,11 @@ class Task : public std::enable_shared_from_this<Task> {
   std::atomic<bool> pauseRequested_{false};
   std::atomic<bool> terminateRequested_{false};
   std::atomic<int32_t> toYield_ = 0;
+  // The CPU time of all the Driver runs of this Task. Used by DriverScheduler
+  // to prioritize between Tasks.
+  std::atomic<uint64_t> driverCpuNanos_{0};
+  // Set if QueryConfig::kTaskTimelineDir is set.
+  std::unique_ptr<TaskTimeline> timeline_;
   int32_t numThreads_ = 0;
   // Microsecond real time when 'this' last went from no threads to
   // one thread running. Used to decide if continuous run should be
@@ -1176,6 +1280,14 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Base remote spill directory for this task. Used after the local spill
+  // quota of the query is used up.
+  std::string remoteSpillDirectory_;
+
+  // Indicates whether the remote spill directory has been created. Uses
+  // 'spillDirCreateMutex_'.
+  std::atomic<bool> remoteSpillDirectoryCreated_{false};
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -102,6 +102,12 @@ struct TaskStats {
   uint64_t numRunningDrivers{0};
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
+  /// The number of Drivers of pipelines with adaptive Drivers which were
+  /// started after the Task start because of the load of the pipeline.
+  uint64_t numAdaptiveDriversStarted{0};
+  /// The number of Drivers of pipelines with adaptive Drivers which were
+  /// retired before the end of their splits.
+  uint64_t numAdaptiveDriversRetired{0};
 
   /// Output buffer's memory utilization ratio measured as
   /// current buffer usage / max buffer size
@@ -59,11 +59,25 @@ struct SplitsStore {
   std::vector<ContinuePromise> splitPromises;
 };
 
+/// Orders the queued splits of a table scan by the range of the values of a
+/// column in each split, so that the splits most likely to have the first
+/// rows of a TopN are read first.
+struct SplitOrder {
+  /// The table column.
+  std::string column;
+  bool ascending{true};
+  bool nullsFirst{false};
+};
+
 /// Structure contains the current info on splits for a particular plan node.
 struct SplitsState {
   /// True if the source node is a table scan.
   bool sourceIsTableScan{false};
 
+  /// Set for a table scan which feeds a TopN on one of its columns if
+  /// QueryConfig::kTopNSplitOrderingEnabled is true.
+  std::optional<SplitOrder> splitOrder;
+
   /// Plan node-wide 'no more splits'.
   bool noMoreSplits{false};
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskTimeline.h"
+
+#include <set>
+
+#include <folly/json.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+namespace {
+const char* const kOperatorCategory = "operator";
+const char* const kBlockedCategory = "blocked";
+} // namespace
+
+TaskTimeline::TaskTimeline(uint64_t maxEvents)
+    : maxEvents_(maxEvents), startMicros_(getCurrentTimeMicro()) {}
+
+void TaskTimeline::addOperatorCall(
+    uint32_t pipelineId,
+    uint32_t driverId,
+    const std::string& operatorType,
+    const core::PlanNodeId& planNodeId,
+    const char* method,
+    uint64_t startMicros,
+    uint64_t durationMicros,
+    int64_t memoryBytes,
+    int64_t memoryDeltaBytes) {
+  addEvent(
+      {kOperatorCategory,
+       fmt::format("{}::{}", operatorType, method),
+       planNodeId,
+       pipelineId,
+       driverId,
+       startMicros,
+       durationMicros,
+       memoryBytes,
+       memoryDeltaBytes});
+}
+
+void TaskTimeline::addBlocked(
+    uint32_t pipelineId,
+    uint32_t driverId,
+    const core::PlanNodeId& planNodeId,
+    BlockingReason reason,
+    uint64_t startMicros,
+    uint64_t durationMicros) {
+  addEvent(
+      {kBlockedCategory,
+       blockingReasonToString(reason),
+       planNodeId,
+       pipelineId,
+       driverId,
+       startMicros,
+       durationMicros,
+       0,
+       0});
+}
+
+void TaskTimeline::addEvent(Event&& event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= maxEvents_) {
+    ++numDropped_;
+    return;
+  }
+  events_.push_back(std::move(event));
+}
+
+uint64_t TaskTimeline::numEvents() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_.size();
+}
+
+uint64_t TaskTimeline::numDroppedEvents() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDropped_;
+}
+
+std::string TaskTimeline::toChromeTraceJson() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  folly::dynamic traceEvents = folly::dynamic::array;
+  auto addName = [&](const char* kind,
+                     uint32_t pipelineId,
+                     uint32_t driverId,
+                     const std::string& name) {
+    folly::dynamic metadata = folly::dynamic::object;
+    metadata["ph"] = "M";
+    metadata["name"] = kind;
+    metadata["pid"] = pipelineId;
+    metadata["tid"] = driverId;
+    metadata["args"] = folly::dynamic::object("name", name);
+    traceEvents.push_back(std::move(metadata));
+  };
+  // Names the process of each pipeline and the thread of each Driver.
+  std::set<uint32_t> pipelines;
+  std::set<std::pair<uint32_t, uint32_t>> drivers;
+  for (const auto& event : events_) {
+    if (pipelines.insert(event.pipelineId).second) {
+      addName(
+          "process_name",
+          event.pipelineId,
+          0,
+          fmt::format("Pipeline {}", event.pipelineId));
+    }
+    if (drivers.insert({event.pipelineId, event.driverId}).second) {
+      addName(
+          "thread_name",
+          event.pipelineId,
+          event.driverId,
+          fmt::format("Driver {}", event.driverId));
+    }
+  }
+
+  for (const auto& event : events_) {
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["ph"] = "X";
+    traceEvent["cat"] = event.category;
+    traceEvent["name"] = event.name;
+    traceEvent["pid"] = event.pipelineId;
+    traceEvent["tid"] = event.driverId;
+    traceEvent["ts"] = event.startMicros > startMicros_
+        ? event.startMicros - startMicros_
+        : 0;
+    traceEvent["dur"] = event.durationMicros;
+    folly::dynamic args =
+        folly::dynamic::object("planNodeId", event.planNodeId);
+    if (event.category == kOperatorCategory) {
+      args["memoryBytes"] = event.memoryBytes;
+      args["memoryDeltaBytes"] = event.memoryDeltaBytes;
+    }
+    traceEvent["args"] = std::move(args);
+    traceEvents.push_back(std::move(traceEvent));
+  }
+
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = folly::dynamic::object("numDroppedEvents", numDropped_);
+  return folly::toJson(trace);
+}
+
+void TaskTimeline::write(const std::string& path) const {
+  const auto json = toChromeTraceJson();
+  auto fs = filesystems::getFileSystem(path, nullptr);
+  auto file = fs->openFileForWrite(path);
+  file->append(json);
+  file->close();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Records a timeline of the calls to the Operators of the Drivers of a Task
+/// and of the times the Drivers were blocked. Each event has the start time,
+/// duration and the memory of the Operator after the call. The timeline is
+/// written as a Chrome trace event JSON file, which can be viewed in Perfetto
+/// or chrome://tracing, with a process per pipeline and a thread per Driver.
+/// Enabled by QueryConfig::kTaskTimelineDir. Thread safe.
+class TaskTimeline {
+ public:
+  /// Keeps at most 'maxEvents' events. The later events are counted as
+  /// dropped.
+  explicit TaskTimeline(uint64_t maxEvents);
+
+  /// Records a call of 'method', e.g. "getOutput", on the operator of
+  /// 'operatorType' and 'planNodeId' in Driver 'driverId' of 'pipelineId'.
+  /// 'memoryBytes' is the memory used by the operator after the call.
+  void addOperatorCall(
+      uint32_t pipelineId,
+      uint32_t driverId,
+      const std::string& operatorType,
+      const core::PlanNodeId& planNodeId,
+      const char* method,
+      uint64_t startMicros,
+      uint64_t durationMicros,
+      int64_t memoryBytes,
+      int64_t memoryDeltaBytes);
+
+  /// Records that Driver 'driverId' of 'pipelineId' was off thread waiting
+  /// for 'reason' in the operator for 'planNodeId'.
+  void addBlocked(
+      uint32_t pipelineId,
+      uint32_t driverId,
+      const core::PlanNodeId& planNodeId,
+      BlockingReason reason,
+      uint64_t startMicros,
+      uint64_t durationMicros);
+
+  uint64_t numEvents() const;
+
+  uint64_t numDroppedEvents() const;
+
+  /// Returns the events in the Chrome trace event format.
+  std::string toChromeTraceJson() const;
+
+  /// Writes toChromeTraceJson() to 'path' using the file system of 'path'.
+  void write(const std::string& path) const;
+
+ private:
+  struct Event {
+    // "operator" or "blocked".
+    const char* category;
+    std::string name;
+    core::PlanNodeId planNodeId;
+    uint32_t pipelineId;
+    uint32_t driverId;
+    uint64_t startMicros;
+    uint64_t durationMicros;
+    int64_t memoryBytes;
+    int64_t memoryDeltaBytes;
+  };
+
+  void addEvent(Event&& event);
+
+  const uint64_t maxEvents_;
+  // The event times are relative to this.
+  const uint64_t startMicros_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  uint64_t numDropped_{0};
+};
+
+} // namespace facebook::velox::exec
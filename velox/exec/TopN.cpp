@@ -20,6 +20,51 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if a dynamic filter on a TopN sorting key of 'type' can be
+// made from a range filter ordered the same as the key.
+bool supportsDynamicFilter(const Type& type) {
+  if (type.providesCustomComparison() || type.isDecimal()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+T readValue(const char* row, const RowColumn& column) {
+  return *reinterpret_cast<const T*>(row + column.offset());
+}
+
+// Returns the filter that passes the values which are not after 'bound' in
+// the sort order. The bound itself passes as the rows with an equal first key
+// may still be before the bound row on the following keys.
+template <typename T>
+std::unique_ptr<common::Filter>
+makeFloatingPointFilter(T bound, bool ascending, bool nullAllowed) {
+  // NaN sorts after all the other values.
+  if (std::isnan(bound)) {
+    return nullptr;
+  }
+  if (ascending) {
+    return std::make_unique<common::FloatingPointRange<T>>(
+        bound, true, false, bound, false, false, nullAllowed);
+  }
+  return std::make_unique<common::FloatingPointRange<T>>(
+      bound, false, false, bound, true, false, nullAllowed);
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -31,6 +76,7 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstSortOrder_(topNNode->sortingOrders()[0]),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -57,6 +103,108 @@ TopN::TopN(
   }
 }
 
+void TopN::initialize() {
+  Operator::initialize();
+  const auto channel = sortingKeyColumns_[0];
+  if (operatorCtx_->driverCtx()->queryConfig().topNDynamicFilterEnabled() &&
+      supportsDynamicFilter(*outputType_->childAt(channel)) &&
+      !operatorCtx_->driverCtx()
+           ->driver->canPushdownFilters(this, {channel})
+           .empty()) {
+    dynamicFilterChannel_ = channel;
+  }
+}
+
+void TopN::updateDynamicFilter() {
+  const auto* topRow = topRows_.top();
+  const auto channel = dynamicFilterChannel_.value();
+  const auto column = data_->columnAt(channel);
+  const auto nullsFirst = firstSortOrder_.isNullsFirst();
+  const auto ascending = firstSortOrder_.isAscending();
+
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    // With nulls first all the rows in 'topRows_' are nulls and only nulls
+    // may still make it. This does not change anymore. With nulls last all
+    // the values pass.
+    if (nullsFirst && !nullsOnlyDynamicFilter_) {
+      nullsOnlyDynamicFilter_ = true;
+      dynamicFilters_[channel] = std::make_shared<common::IsNull>();
+    }
+    return;
+  }
+
+  variant bound;
+  std::unique_ptr<common::Filter> filter;
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      int64_t value;
+      switch (outputType_->childAt(channel)->kind()) {
+        case TypeKind::TINYINT:
+          value = readValue<int8_t>(topRow, column);
+          break;
+        case TypeKind::SMALLINT:
+          value = readValue<int16_t>(topRow, column);
+          break;
+        case TypeKind::INTEGER:
+          value = readValue<int32_t>(topRow, column);
+          break;
+        default:
+          value = readValue<int64_t>(topRow, column);
+          break;
+      }
+      bound = variant(value);
+      if (bound == dynamicFilterBound_) {
+        return;
+      }
+      filter = std::make_unique<common::BigintRange>(
+          ascending ? std::numeric_limits<int64_t>::min() : value,
+          ascending ? value : std::numeric_limits<int64_t>::max(),
+          nullsFirst);
+      break;
+    }
+    case TypeKind::REAL: {
+      const auto value = readValue<float>(topRow, column);
+      bound = variant(value);
+      if (bound == dynamicFilterBound_) {
+        return;
+      }
+      filter = makeFloatingPointFilter(value, ascending, nullsFirst);
+      break;
+    }
+    case TypeKind::DOUBLE: {
+      const auto value = readValue<double>(topRow, column);
+      bound = variant(value);
+      if (bound == dynamicFilterBound_) {
+        return;
+      }
+      filter = makeFloatingPointFilter(value, ascending, nullsFirst);
+      break;
+    }
+    case TypeKind::TIMESTAMP: {
+      const auto value = readValue<Timestamp>(topRow, column);
+      bound = variant(value);
+      if (bound == dynamicFilterBound_) {
+        return;
+      }
+      filter = std::make_unique<common::TimestampRange>(
+          ascending ? std::numeric_limits<Timestamp>::min() : value,
+          ascending ? value : std::numeric_limits<Timestamp>::max(),
+          nullsFirst);
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+
+  dynamicFilterBound_ = std::move(bound);
+  if (filter) {
+    dynamicFilters_[channel] = std::move(filter);
+  }
+}
+
 void TopN::addInput(RowVectorPtr input) {
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
@@ -104,6 +252,10 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (dynamicFilterChannel_.has_value() && topRows_.size() == count_) {
+    updateDynamicFilter();
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
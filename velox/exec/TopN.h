@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/type/Variant.h"
 
 namespace facebook::velox::exec {
 
@@ -43,8 +44,15 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  void initialize() override;
+
  private:
+  // Pushes down a filter on the first sorting key that passes the values
+  // which may still make it into 'topRows_'. Called when 'topRows_' is full.
+  void updateDynamicFilter();
+
   const int32_t count_;
+  const core::SortOrder firstSortOrder_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
@@ -68,5 +76,16 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Channel of the first sorting key if the dynamic filter on it can be
+  // pushed down to the table scan.
+  std::optional<column_index_t> dynamicFilterChannel_;
+
+  // The value of the first sorting key in the top of 'topRows_' when the
+  // last dynamic filter was made. Null if no filter has been made.
+  variant dynamicFilterBound_;
+
+  // True if the pushed down dynamic filter passes only nulls.
+  bool nullsOnlyDynamicFilter_{false};
 };
 } // namespace facebook::velox::exec
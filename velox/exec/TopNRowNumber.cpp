@@ -165,9 +165,13 @@ TopNRowNumber::TopNRowNumber(
         pool());
     partitionOffset_ = table_->rows()->columnAt(numKeys).offset();
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
+    lookup_->decodedVectorCache =
+        operatorCtx_->driverCtx()->decodedVectorCache.get();
+    topRowsAllocator_ = table_->stringAllocator();
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>();
+    topRowsAllocator_ = allocator_.get();
   }
 
   if (generateRowNumber_) {
@@ -237,19 +241,45 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    new (lookup_->hits[index] + partitionOffset_) TopRows();
   }
 }
 
-void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
-  auto& topRows = partition.rows;
+void TopNRowNumber::TopRows::push(
+    char* row,
+    RowComparator& comparator,
+    HashStringAllocator* allocator,
+    int32_t limit) {
+  VELOX_DCHECK_LT(size_, limit);
+  if (size_ == capacity_) {
+    const auto newCapacity = std::min<int32_t>(limit, 2 * capacity_);
+    StlAllocator<char*> stlAllocator(allocator);
+    auto* newRows = stlAllocator.allocate(newCapacity);
+    std::copy(rows(), rows() + size_, newRows);
+    if (capacity_ > kNumInlineRows) {
+      stlAllocator.deallocate(rows_, capacity_);
+    }
+    rows_ = newRows;
+    capacity_ = newCapacity;
+  }
+  auto* heap = rows();
+  heap[size_++] = row;
+  std::push_heap(heap, heap + size_, Compare{comparator});
+}
 
+void TopNRowNumber::TopRows::pop(RowComparator& comparator) {
+  VELOX_DCHECK_GT(size_, 0);
+  auto* heap = rows();
+  std::pop_heap(heap, heap + size_, Compare{comparator});
+  --size_;
+}
+
+void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   char* newRow = nullptr;
-  if (topRows.size() < limit_) {
+  if (partition.size() < limit_) {
     newRow = data_->newRow();
   } else {
-    char* topRow = topRows.top();
+    char* topRow = partition.top();
 
     if (!comparator_(decodedVectors_, index, topRow)) {
       // Drop this input row.
@@ -257,7 +287,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     }
 
     // Replace existing row.
-    topRows.pop();
+    partition.pop(comparator_);
 
     // Reuse the topRow's memory.
     newRow = data_->initializeRow(topRow, true /* reuse */);
@@ -267,7 +297,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  partition.push(newRow, comparator_, topRowsAllocator_, limit_);
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -360,14 +390,14 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
   // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
+  auto rowNumber = partition.size() - start;
   for (auto i = 0; i < size; ++i) {
     const auto index = outputOffset + size - i - 1;
     if (rowNumbers) {
       rowNumbers->set(index, rowNumber--);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[index] = partition.top();
+    partition.pop(comparator_);
   }
 }
 
@@ -427,7 +457,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
     auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partition.size() - remainingRowsInPartition_;
     const auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -441,7 +471,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    auto numRows = partition->size();
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
@@ -619,29 +649,13 @@ bool TopNRowNumber::isFinished() {
 void TopNRowNumber::close() {
   Operator::close();
 
-  SCOPE_EXIT {
-    table_.reset();
-    singlePartition_.reset();
-    data_.reset();
-    allocator_.reset();
-  };
-
-  if (table_ == nullptr) {
-    return;
-  }
-
+  // TopRows are trivially destructible. Their out-of-line heaps are freed
+  // together with the allocators.
   partitionIt_.reset();
-  partitions_.resize(1'000);
-  while (auto numPartitions = table_->listAllRows(
-             &partitionIt_,
-             partitions_.size(),
-             RowContainer::kUnlimited,
-             partitions_.data())) {
-    for (auto i = 0; i < numPartitions; ++i) {
-      std::destroy_at(
-          reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
-    }
-  }
+  table_.reset();
+  singlePartition_.reset();
+  data_.reset();
+  allocator_.reset();
 }
 
 void TopNRowNumber::reclaim(
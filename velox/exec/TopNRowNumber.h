@@ -69,8 +69,36 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // A max-heap to keep track of top 'limit' rows for a given partition. The
+  // top of the heap is the row that sorts last. With many partitions, the
+  // per-partition overhead dominates the memory usage, so the heap is kept
+  // compact: up to kNumInlineRows row pointers are stored inline, larger
+  // heaps are stored in an array allocated from a HashStringAllocator that
+  // grows up to 'limit' entries. The memory of the array is owned by the
+  // allocator and is released together with it.
   struct TopRows {
+    static constexpr int32_t kNumInlineRows = 2;
+
+    size_t size() const {
+      return size_;
+    }
+
+    char* top() const {
+      return rows()[0];
+    }
+
+    // Adds 'row' to the heap. Grows the out-of-line array if the heap is
+    // full. The heap never holds more than 'limit' rows.
+    void push(
+        char* row,
+        RowComparator& comparator,
+        HashStringAllocator* allocator,
+        int32_t limit);
+
+    // Removes the top row.
+    void pop(RowComparator& comparator);
+
+   private:
     struct Compare {
       RowComparator& comparator;
 
@@ -79,11 +107,20 @@ class TopNRowNumber : public Operator {
       }
     };
 
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
+    char* const* rows() const {
+      return capacity_ > kNumInlineRows ? rows_ : inlineRows_;
+    }
+
+    char** rows() {
+      return capacity_ > kNumInlineRows ? rows_ : inlineRows_;
+    }
 
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+    union {
+      char* inlineRows_[kNumInlineRows];
+      char** rows_;
+    };
+    int32_t size_{0};
+    int32_t capacity_{kNumInlineRows};
   };
 
   void initializeNewPartitions();
@@ -186,6 +223,10 @@ class TopNRowNumber : public Operator {
   std::unique_ptr<HashStringAllocator> allocator_;
   std::unique_ptr<TopRows> singlePartition_;
 
+  // Allocator for the out-of-line heaps of TopRows. Either the allocator of
+  // 'table_' or 'allocator_'.
+  HashStringAllocator* topRowsAllocator_;
+
   // Stores input data. For each partition, only up to 'limit_' rows are stored.
   // Order of columns matches 'inputChannels_': partition keys, sorting keys,
   // the rest.
@@ -19,6 +19,13 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Maximum number of elements vector rows per output row for which the output
+// is a dictionary over a slice of the elements vector. Sparser outputs are
+// copied.
+constexpr vector_size_t kMaxBaseRowsPerOutputRow = 2;
+} // namespace
+
 Unnest::Unnest(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -222,6 +229,11 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
+  // True if the output rows are non-null and refer to consecutive elements.
+  bool consecutive = true;
+  // The range of elements the non-null output rows refer to.
+  vector_size_t minElement = std::numeric_limits<vector_size_t>::max();
+  vector_size_t maxElement = -1;
   VELOX_DCHECK_GT(range.size, 0);
 
   range.forEachRow(
@@ -237,15 +249,24 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
             identityMapping = false;
           }
           auto currentUnnestSize = std::min(end, unnestSize);
+          if (start < currentUnnestSize) {
+            if (maxElement >= 0 && offset + start != maxElement + 1) {
+              consecutive = false;
+            }
+            minElement = std::min(minElement, offset + start);
+            maxElement = std::max(maxElement, offset + currentUnnestSize - 1);
+          }
           for (auto i = start; i < currentUnnestSize; i++) {
             rawElementIndices[index++] = offset + i;
           }
 
           for (auto i = std::max(start, currentUnnestSize); i < end; ++i) {
+            consecutive = false;
             bits::setNull(rawNulls, index++, true);
           }
         } else if (size > 0) {
           identityMapping = false;
+          consecutive = false;
 
           for (auto i = start; i < end; ++i) {
             bits::setNull(rawNulls, index++, true);
@@ -255,16 +276,42 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
       rawMaxSizes_,
       firstRowStart_);
 
-  return {elementIndices, nulls, identityMapping};
+  using Kind = UnnestChannelEncoding::Kind;
+  if (identityMapping) {
+    return {Kind::kIdentity, nullptr, nullptr};
+  }
+  if (maxElement < 0) {
+    // All output rows are null.
+    return {Kind::kCopy, elementIndices, nulls};
+  }
+  if (consecutive) {
+    return {Kind::kSlice, nullptr, nullptr, minElement};
+  }
+  const auto numElements = maxElement - minElement + 1;
+  if (numElements > kMaxBaseRowsPerOutputRow * range.numElements) {
+    return {Kind::kCopy, elementIndices, nulls};
+  }
+  for (auto i = 0; i < range.numElements; ++i) {
+    if (!bits::isBitNull(rawNulls, i)) {
+      rawElementIndices[i] -= minElement;
+    }
+  }
+  return {Kind::kDictionary, elementIndices, nulls, minElement, numElements};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
-  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
-      BIGINT(), range.numElements, pool());
+  auto* execCtx = operatorCtx_->execCtx();
+  auto ordinalityVector = execCtx->getVector(BIGINT(), range.numElements);
+  // The other output columns wrap the input. This one is recycled once the
+  // consumer drops it.
+  if (auto* vectorPool = execCtx->vectorPool()) {
+    vectorPool->releaseWhenUnreferenced(ordinalityVector);
+  }
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
-  auto* rawOrdinality = ordinalityVector->mutableRawValues();
+  auto* rawOrdinality =
+      ordinalityVector->asUnchecked<FlatVector<int64_t>>()->mutableRawValues();
 
   VELOX_DCHECK_GT(range.size, 0);
 
@@ -323,8 +370,16 @@ RowVectorPtr Unnest::generateOutput(const RowRange& range) {
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  switch (kind) {
+    case Kind::kIdentity:
+      return base;
+    case Kind::kSlice:
+      return base->slice(baseOffset, wrapSize);
+    case Kind::kDictionary:
+      return BaseVector::wrapInDictionary(
+          nulls, indices, wrapSize, base->slice(baseOffset, baseSize));
+    case Kind::kCopy:
+      break;
   }
 
   const auto result =
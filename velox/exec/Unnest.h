@@ -107,9 +107,28 @@ class Unnest : public Operator {
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
+    // How the output refers to the rows of the unnested elements vector.
+    enum class Kind {
+      // The output is the elements vector.
+      kIdentity,
+      // The output is rows [baseOffset, baseOffset + wrapSize) of the
+      // elements vector, sliced without copying.
+      kSlice,
+      // The output is 'indices' and 'nulls' over rows [baseOffset,
+      // baseOffset + baseSize) of the elements vector. 'indices' are
+      // relative to 'baseOffset'.
+      kDictionary,
+      // The output is a flat copy of 'indices' and 'nulls' over the elements
+      // vector. Used when the output refers to a small subset of a range of
+      // the elements vector.
+      kCopy,
+    };
+
+    Kind kind;
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    vector_size_t baseOffset{0};
+    vector_size_t baseSize{0};
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
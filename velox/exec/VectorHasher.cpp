@@ -77,44 +77,70 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
 }
 } // namespace
 
+void VectorHasher::prepareDictionaryCache(
+    raw_vector<uint64_t>& cache,
+    VectorPtr& cachedBase,
+    uint64_t emptyValue) {
+  const auto baseSize = decoded_->base()->size();
+  if (dictionaryBase_ != nullptr && cachedBase == dictionaryBase_ &&
+      cache.size() == baseSize) {
+    return;
+  }
+  cache.resize(baseSize);
+  std::fill(cache.begin(), cache.end(), emptyValue);
+  cachedBase = dictionaryBase_;
+}
+
 template <bool typeProvidesCustomComparison, TypeKind Kind>
 void VectorHasher::hashValues(
     const SelectivityVector& rows,
     bool mix,
     uint64_t* result) {
   using T = typename TypeTraits<Kind>::NativeType;
-  if (decoded_.isConstantMapping()) {
-    auto hash = decoded_.isNullAt(rows.begin())
+  if (decoded_->isConstantMapping()) {
+    auto hash = decoded_->isNullAt(rows.begin())
         ? kNullHash
-        : hashOne<typeProvidesCustomComparison, Kind>(decoded_, rows.begin());
+        : hashOne<typeProvidesCustomComparison, Kind>(*decoded_, rows.begin());
     rows.applyToSelected([&](vector_size_t row) {
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else if (
-      !decoded_.isIdentityMapping() &&
-      rows.countSelected() > decoded_.base()->size()) {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+      !decoded_->isIdentityMapping() &&
+      (rows.countSelected() > decoded_->base()->size() || dictionaryReused_)) {
+    // Hashes each distinct base value once. The hashes are kept for the next
+    // batch if it has the same dictionary base.
+    prepareDictionaryCache(cachedHashes_, cachedHashesBase_, kNullHash);
     rows.applyToSelected([&](vector_size_t row) {
-      if (decoded_.isNullAt(row)) {
+      if (decoded_->isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
-      auto baseIndex = decoded_.index(row);
+      auto baseIndex = decoded_->index(row);
       uint64_t hash = cachedHashes_[baseIndex];
       if (hash == kNullHash) {
-        hash = hashOne<typeProvidesCustomComparison, Kind>(decoded_, row);
+        hash = hashOne<typeProvidesCustomComparison, Kind>(*decoded_, row);
         cachedHashes_[baseIndex] = hash;
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else {
+    if constexpr (Kind == TypeKind::VARCHAR && !typeProvidesCustomComparison) {
+      if (decoded_->isIdentityMapping() && !decoded_->mayHaveNulls() &&
+          rows.isAllSelected()) {
+        StringView::hashBatch(
+            decoded_->data<StringView>() + rows.begin(),
+            rows.end() - rows.begin(),
+            mix,
+            result + rows.begin());
+        return;
+      }
+    }
     rows.applyToSelected([&](vector_size_t row) {
-      if (decoded_.isNullAt(row)) {
+      if (decoded_->isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
-      auto hash = hashOne<typeProvidesCustomComparison, Kind>(decoded_, row);
+      auto hash = hashOne<typeProvidesCustomComparison, Kind>(*decoded_, row);
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   }
@@ -126,12 +152,12 @@ bool VectorHasher::makeValueIds(
     uint64_t* result) {
   using T = typename TypeTraits<Kind>::NativeType;
 
-  if (decoded_.isConstantMapping()) {
-    uint64_t id = decoded_.isNullAt(rows.begin())
+  if (decoded_->isConstantMapping()) {
+    uint64_t id = decoded_->isNullAt(rows.begin())
         ? 0
-        : valueId(decoded_.valueAt<T>(rows.begin()));
+        : valueId(decoded_->valueAt<T>(rows.begin()));
     if (id == kUnmappable) {
-      analyzeValue(decoded_.valueAt<T>(rows.begin()));
+      analyzeValue(decoded_->valueAt<T>(rows.begin()));
       return false;
     }
     rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
@@ -140,15 +166,15 @@ bool VectorHasher::makeValueIds(
     return true;
   }
 
-  if (decoded_.isIdentityMapping()) {
-    if (decoded_.mayHaveNulls()) {
+  if (decoded_->isIdentityMapping()) {
+    if (decoded_->mayHaveNulls()) {
       return makeValueIdsFlatWithNulls<T>(rows, result);
     } else {
       return makeValueIdsFlatNoNulls<T>(rows, result);
     }
   }
 
-  if (decoded_.mayHaveNulls()) {
+  if (decoded_->mayHaveNulls()) {
     return makeValueIdsDecoded<T, true>(rows, result);
   } else {
     return makeValueIdsDecoded<T, false>(rows, result);
@@ -159,7 +185,7 @@ template <>
 bool VectorHasher::makeValueIdsFlatNoNulls<bool>(
     const SelectivityVector& rows,
     uint64_t* result) {
-  const auto* values = decoded_.data<uint64_t>();
+  const auto* values = decoded_->data<uint64_t>();
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
     bool value = bits::isBitSet(values, row);
     uint64_t id = valueId(value);
@@ -172,8 +198,8 @@ template <>
 bool VectorHasher::makeValueIdsFlatWithNulls<bool>(
     const SelectivityVector& rows,
     uint64_t* result) {
-  const auto* values = decoded_.data<uint64_t>();
-  const auto* nulls = decoded_.nulls(&rows);
+  const auto* values = decoded_->data<uint64_t>();
+  const auto* nulls = decoded_->nulls(&rows);
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
     if (bits::isBitNull(nulls, row)) {
       if (multiplier_ == 1) {
@@ -222,7 +248,7 @@ template <typename T>
 bool VectorHasher::makeValueIdsFlatNoNulls(
     const SelectivityVector& rows,
     uint64_t* result) {
-  const auto* values = decoded_.data<T>();
+  const auto* values = decoded_->data<T>();
   if (isRange_ && tryMapToRange(values, rows, result)) {
     return true;
   }
@@ -239,8 +265,8 @@ template <typename T>
 bool VectorHasher::makeValueIdsFlatWithNulls(
     const SelectivityVector& rows,
     uint64_t* result) {
-  const auto* values = decoded_.data<T>();
-  const auto* nulls = decoded_.nulls(&rows);
+  const auto* values = decoded_->data<T>();
+  const auto* nulls = decoded_->nulls(&rows);
 
   bool success = true;
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
@@ -253,13 +279,13 @@ template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
     uint64_t* result) {
-  auto indices = decoded_.indices();
-  auto values = decoded_.data<T>();
+  auto indices = decoded_->indices();
+  auto values = decoded_->data<T>();
   bool success = true;
 
-  if (rows.countSelected() <= decoded_.base()->size()) {
+  if (rows.countSelected() <= decoded_->base()->size() && !dictionaryReused_) {
     // Cache is not beneficial in this case and we don't use them.
-    auto* nulls = decoded_.nulls(&rows);
+    auto* nulls = decoded_->nulls(&rows);
     rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
       makeValueIdForOneRow<T, mayHaveNulls>(
           nulls, row, values, indices[row], result, success);
@@ -267,13 +293,12 @@ bool VectorHasher::makeValueIdsDecoded(
     return success;
   }
 
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  prepareDictionaryCache(cachedValueIds_, cachedValueIdsBase_, 0);
 
   int numCachedHashes = 0;
   rows.testSelected([&](vector_size_t row) INLINE_LAMBDA {
     if constexpr (mayHaveNulls) {
-      if (decoded_.isNullAt(row)) {
+      if (decoded_->isNullAt(row)) {
         if (multiplier_ == 1) {
           result[row] = 0;
         }
@@ -282,7 +307,7 @@ bool VectorHasher::makeValueIdsDecoded(
     }
 
     auto baseIndex = indices[row];
-    uint64_t& id = cachedHashes_[baseIndex];
+    uint64_t& id = cachedValueIds_[baseIndex];
 
     if (success) {
       if (id == 0) {
@@ -303,9 +328,14 @@ bool VectorHasher::makeValueIdsDecoded(
       }
     }
 
-    return success || numCachedHashes < cachedHashes_.size();
+    return success || numCachedHashes < cachedValueIds_.size();
   });
 
+  if (!success) {
+    // The cache has kUnmappable for values that are not yet mapped and the
+    // mapping will change before the next batch.
+    clearValueIdCache();
+  }
   return success;
 }
 
@@ -313,11 +343,11 @@ template <>
 bool VectorHasher::makeValueIdsDecoded<bool, true>(
     const SelectivityVector& rows,
     uint64_t* result) {
-  auto indices = decoded_.indices();
-  auto values = decoded_.data<uint64_t>();
+  auto indices = decoded_->indices();
+  auto values = decoded_->data<uint64_t>();
 
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
-    if (decoded_.isNullAt(row)) {
+    if (decoded_->isNullAt(row)) {
       if (multiplier_ == 1) {
         result[row] = 0;
       }
@@ -335,8 +365,8 @@ template <>
 bool VectorHasher::makeValueIdsDecoded<bool, false>(
     const SelectivityVector& rows,
     uint64_t* result) {
-  auto indices = decoded_.indices();
-  auto values = decoded_.data<uint64_t>();
+  auto indices = decoded_->indices();
+  auto values = decoded_->data<uint64_t>();
 
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
     bool value = bits::isBitSet(values, indices[row]);
@@ -577,14 +607,17 @@ void VectorHasher::precompute(const BaseVector& value) {
   }
 
   const SelectivityVector rows(1, true);
-  decoded_.decode(value, rows);
+  useOwnDecoded();
+  decoded_->decode(value, rows);
+  dictionaryBase_.reset();
+  dictionaryReused_ = false;
 
   if (type_->providesCustomComparison()) {
     precomputedHash_ = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH(
-        hashOne, true, typeKind_, decoded_, 0);
+        hashOne, true, typeKind_, *decoded_, 0);
   } else {
     precomputedHash_ = VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH(
-        hashOne, false, typeKind_, decoded_, 0);
+        hashOne, false, typeKind_, *decoded_, 0);
   }
 }
 
@@ -654,6 +687,7 @@ void VectorHasher::copyStringToLocal(const UniqueValue* unique) {
 
 void VectorHasher::setDistinctOverflow() {
   distinctOverflow_ = true;
+  clearValueIdCache();
   uniqueValues_.clear();
   uniqueValuesStorage_.clear();
   distinctStringsBytes_ = 0;
@@ -662,6 +696,7 @@ void VectorHasher::setDistinctOverflow() {
 void VectorHasher::setRangeOverflow() {
   rangeOverflow_ = true;
   hasRange_ = false;
+  clearValueIdCache();
 }
 
 std::unique_ptr<common::Filter> VectorHasher::getFilter(
@@ -808,6 +843,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
   multiplier_ = multiplier;
   rangeSize_ = addIdReserve(uniqueValues_.size(), reservePct) + 1;
   isRange_ = false;
+  clearValueIdCache();
   uint64_t result;
   if (__builtin_mul_overflow(multiplier_, rangeSize_, &result)) {
     return kRangeTooLarge;
@@ -823,6 +859,7 @@ uint64_t VectorHasher::enableValueRange(
   VELOX_CHECK(hasRange_);
   extendRange(type_->kind(), reservePct, min_, max_);
   isRange_ = true;
+  clearValueIdCache();
   // No overflow because max range is under 63 bits.
   if (typeKind_ == TypeKind::BOOLEAN) {
     rangeSize_ = 3;
@@ -844,6 +881,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
   min_ = other.min_;
   max_ = other.max_;
   uniqueValues_ = other.uniqueValues_;
+  clearValueIdCache();
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
@@ -857,6 +895,7 @@ void VectorHasher::merge(const VectorHasher& other) {
     copyStatsFrom(other);
     return;
   }
+  clearValueIdCache();
   if (hasRange_ && other.hasRange_ && !rangeOverflow_ &&
       !other.rangeOverflow_) {
     min_ = std::min(min_, other.min_);
@@ -19,6 +19,7 @@
 
 #include <velox/type/Filter.h>
 #include "velox/common/base/RawVector.h"
+#include "velox/exec/DecodedVectorCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -165,16 +166,32 @@ class VectorHasher {
   // computeValueIds(). The decoded vector can be accessed via decodedVector()
   // getter.
   void decode(const BaseVector& vector, const SelectivityVector& rows) {
-    VELOX_CHECK(
-        type_->kindEquals(vector.type()),
-        "Type mismatch: {} vs. {}",
-        type_->toString(),
-        vector.type()->toString());
-    decoded_.decode(vector, rows);
+    checkType(vector);
+    useOwnDecoded();
+    decoded_->decode(vector, rows);
+    updateDictionaryBase(vector);
+  }
+
+  // Same as above but takes the decoded loaded 'vector' from 'cache' if not
+  // null, so that the consumers of the same vector and rows in a pipeline
+  // decode it once.
+  void decode(
+      const VectorPtr& vector,
+      const SelectivityVector& rows,
+      DecodedVectorCache* cache) {
+    if (cache == nullptr) {
+      decode(*vector->loadedVector(), rows);
+      return;
+    }
+    const auto* loaded = vector->loadedVector();
+    checkType(*loaded);
+    sharedDecoded_ = cache->get(vector, rows);
+    decoded_ = sharedDecoded_.get();
+    updateDictionaryBase(*loaded);
   }
 
   DecodedVector& decodedVector() {
-    return decoded_;
+    return *decoded_;
   }
 
   // Computes a hash for 'rows' in the vector previously decoded via decode()
@@ -247,6 +264,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    clearValueIdCache();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -547,9 +565,80 @@ class VectorHasher {
   const TypePtr type_;
   const TypeKind typeKind_;
 
-  DecodedVector decoded_;
+  void checkType(const BaseVector& vector) const {
+    VELOX_CHECK(
+        type_->kindEquals(vector.type()),
+        "Type mismatch: {} vs. {}",
+        type_->toString(),
+        vector.type()->toString());
+  }
+
+  void useOwnDecoded() {
+    sharedDecoded_.reset();
+    decoded_ = &ownDecoded_;
+  }
+
+  // Sets 'dictionaryBase_' and 'dictionaryReused_' after decoding 'vector'.
+  void updateDictionaryBase(const BaseVector& vector) {
+    // A single level dictionary over a flat base, e.g. a stripe dictionary of
+    // a string column, often has the same base for consecutive batches. The
+    // hashes and value ids of the base values are then cached across batches.
+    VectorPtr base;
+    if (vector.encoding() == VectorEncoding::Simple::DICTIONARY &&
+        decoded_->base() == vector.valueVector().get()) {
+      base = vector.valueVector();
+    }
+    dictionaryReused_ = base != nullptr && base == dictionaryBase_;
+    dictionaryBase_ = std::move(base);
+  }
+
+  // Keeps the hashes or value ids in 'cache' if they were computed for the
+  // base of 'decoded_'. Otherwise fills 'cache' with 'emptyValue' for each
+  // base value and sets 'cachedBase' to the decoded dictionary base, if any.
+  void prepareDictionaryCache(
+      raw_vector<uint64_t>& cache,
+      VectorPtr& cachedBase,
+      uint64_t emptyValue);
+
+  // Drops the cached value ids. Called when the mapping of values to ids
+  // changes.
+  void clearValueIdCache() {
+    cachedValueIdsBase_.reset();
+  }
+
+  DecodedVector ownDecoded_;
+
+  // Set if the last decode() took the decoded vector from a
+  // DecodedVectorCache.
+  std::shared_ptr<DecodedVector> sharedDecoded_;
+
+  // 'ownDecoded_' or 'sharedDecoded_'.
+  DecodedVector* decoded_{&ownDecoded_};
+
+  // The base of 'decoded_' if this is a single level dictionary. Null
+  // otherwise.
+  VectorPtr dictionaryBase_;
+
+  // True if the previously decoded vector had the same dictionary base.
+  bool dictionaryReused_{false};
+
+  // Hashes of the values of the dictionary base, indexed by base index.
+  // kNullHash for a value that is not hashed yet.
   raw_vector<uint64_t> cachedHashes_;
 
+  // The dictionary base for which 'cachedHashes_' is valid over more than one
+  // batch. Holding a reference makes sure that the base is not modified in
+  // place.
+  VectorPtr cachedHashesBase_;
+
+  // Value ids of the values of the dictionary base, indexed by base index. 0
+  // for a value that has no id yet.
+  raw_vector<uint64_t> cachedValueIds_;
+
+  // The dictionary base for which 'cachedValueIds_' is valid over more than
+  // one batch.
+  VectorPtr cachedValueIdsBase_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionStreamingWindowBuild.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
@@ -38,7 +39,8 @@ Window::Window(
       numInputColumns_(windowNode->inputType()->size()),
       windowNode_(windowNode),
       currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      stringAllocator_(pool()),
+      parallelChunkRows_(driverCtx->queryConfig().windowParallelChunkRows()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (spillConfig == nullptr &&
@@ -60,7 +62,9 @@ Window::Window(
         pool(),
         common::PrefixSortConfig{
             driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
-            driverCtx->queryConfig().prefixSortMinRows()},
+            driverCtx->queryConfig().prefixSortMinRows(),
+            driverCtx->queryConfig().prefixSortMaxStringPrefixLength(),
+            driverCtx->queryConfig().prefixSortRadixSortMinRows()},
         spillConfig,
         &nonReclaimableSection_,
         &spillStats_);
@@ -181,6 +185,7 @@ void Window::createWindowFunctions() {
   VELOX_CHECK(windowFrames_.empty());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
+  bool allChunkParallel = true;
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
     std::vector<WindowFunctionArg> functionArgs;
     functionArgs.reserve(windowNodeFunction.functionCall->inputs().size());
@@ -195,22 +200,53 @@ void Window::createWindowFunctions() {
       }
     }
 
+    const auto& name = windowNodeFunction.functionCall->name();
+    const auto& type = windowNodeFunction.functionCall->type();
+    const auto ignoreNulls = windowNodeFunction.ignoreNulls;
     windowFunctions_.push_back(WindowFunction::create(
-        windowNodeFunction.functionCall->name(),
+        name,
         functionArgs,
-        windowNodeFunction.functionCall->type(),
-        windowNodeFunction.ignoreNulls,
+        type,
+        ignoreNulls,
         operatorCtx_->pool(),
         &stringAllocator_,
         operatorCtx_->driverCtx()->queryConfig()));
 
+    if (parallelChunkRows_ > 0) {
+      if (getWindowFunctionMetadata(name).isChunkParallel) {
+        chunkFunctionFactories_.push_back(
+            [this, name, functionArgs, type, ignoreNulls]() {
+              return WindowFunction::create(
+                  name,
+                  functionArgs,
+                  type,
+                  ignoreNulls,
+                  operatorCtx_->pool(),
+                  &stringAllocator_,
+                  operatorCtx_->driverCtx()->queryConfig());
+            });
+      } else {
+        allChunkParallel = false;
+      }
+    }
+
     windowFrames_.push_back(
         createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
   }
+
+  // A partition is evaluated in chunks only if all the functions support it.
+  if (!allChunkParallel) {
+    chunkFunctionFactories_.clear();
+  }
 }
 
 bool Window::supportRowsStreaming() {
-  for (const auto& windowFunction : windowNode_->windowFunctions()) {
+  const bool rangeStreamingEnabled =
+      operatorCtx_->driverCtx()->queryConfig().windowRangeStreamingEnabled();
+  std::vector<column_index_t> rangeStreamingFunctions;
+  const auto& windowFunctions = windowNode_->windowFunctions();
+  for (auto i = 0; i < windowFunctions.size(); ++i) {
+    const auto& windowFunction = windowFunctions[i];
     const auto& functionName = windowFunction.functionCall->name();
     const auto windowFunctionMetadata =
         exec::getWindowFunctionMetadata(functionName);
@@ -227,10 +263,21 @@ bool Window::supportRowsStreaming() {
          frame.endType == core::WindowNode::BoundType::kCurrentRow);
 
     if (windowFunctionMetadata.isAggregate && !isDefaultFrame) {
-      return false;
+      // The frame starts of a k range preceding frame advance with the rows of
+      // the partition. The rows before the frame start of the last processed
+      // row can be removed.
+      const bool isKRangePrecedingFrame =
+          (frame.type == core::WindowNode::WindowType::kRange &&
+           frame.startType == core::WindowNode::BoundType::kPreceding &&
+           frame.endType == core::WindowNode::BoundType::kCurrentRow);
+      if (!rangeStreamingEnabled || !isKRangePrecedingFrame) {
+        return false;
+      }
+      rangeStreamingFunctions.push_back(i);
     }
   }
 
+  rangeStreamingFunctions_ = std::move(rangeStreamingFunctions);
   return true;
 }
 
@@ -294,11 +341,175 @@ void Window::callResetPartition() {
   peerStartRow_ = 0;
   peerEndRow_ = 0;
   currentPartition_ = nullptr;
+  chunkStarts_.clear();
+  chunkResults_.clear();
   if (windowBuild_->hasNextPartition()) {
     currentPartition_ = windowBuild_->nextPartition();
     for (int i = 0; i < windowFunctions_.size(); ++i) {
       windowFunctions_[i]->resetPartition(currentPartition_.get());
     }
+    computeChunkResults();
+  }
+}
+
+void Window::computeChunkResults() {
+  if (chunkFunctionFactories_.empty() || currentPartition_->partial()) {
+    return;
+  }
+  const auto numRows = currentPartition_->numRows();
+  if (numRows < 2 * parallelChunkRows_) {
+    return;
+  }
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  if (executor == nullptr) {
+    return;
+  }
+
+  // Splits the partition into chunks of about the same size. Each chunk
+  // starts at a peer group.
+  const auto maxChunks =
+      std::min<size_t>(kMaxParallelChunks, numRows / parallelChunkRows_);
+  chunkStarts_.push_back(0);
+  for (auto i = 1; i < maxChunks; ++i) {
+    const auto targetStart =
+        static_cast<vector_size_t>(int64_t(numRows) * i / maxChunks);
+    if (targetStart <= chunkStarts_.back()) {
+      continue;
+    }
+    const auto start = currentPartition_->nextPeerGroupStart(targetStart - 1);
+    if (start >= numRows) {
+      break;
+    }
+    chunkStarts_.push_back(start);
+  }
+  const auto numChunks = chunkStarts_.size();
+  if (numChunks == 1) {
+    chunkStarts_.clear();
+    return;
+  }
+
+  while (chunkFunctions_.size() < numChunks) {
+    auto& functions = chunkFunctions_.emplace_back();
+    for (const auto& factory : chunkFunctionFactories_) {
+      functions.push_back(factory());
+    }
+  }
+
+  // Allocates the memory on this thread.
+  std::vector<BufferPtr> peerStarts(numChunks);
+  std::vector<BufferPtr> peerEnds(numChunks);
+  chunkResults_.resize(numChunks);
+  for (auto chunk = 0; chunk < numChunks; ++chunk) {
+    const auto numChunkRows = chunkEnd(chunk) - chunkStarts_[chunk];
+    peerStarts[chunk] =
+        AlignedBuffer::allocate<vector_size_t>(numChunkRows, pool());
+    peerEnds[chunk] =
+        AlignedBuffer::allocate<vector_size_t>(numChunkRows, pool());
+    for (const auto& function : windowFunctions_) {
+      chunkResults_[chunk].push_back(
+          BaseVector::create(function->resultType(), numChunkRows, pool()));
+    }
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> chunkSteps;
+  chunkSteps.reserve(numChunks);
+  for (auto chunk = 0; chunk < numChunks; ++chunk) {
+    chunkSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this,
+         chunk,
+         peerStarts = peerStarts[chunk],
+         peerEnds = peerEnds[chunk]]() {
+          computeChunk(chunk, peerStarts, peerEnds);
+          return std::make_unique<bool>(true);
+        }));
+  }
+
+  // The steps reference the state of this operator, so all of them must
+  // finish before returning, also when unwinding. A step that did not start
+  // on the executor runs on this thread.
+  std::exception_ptr error;
+  const auto syncSteps = [&]() {
+    for (auto& step : chunkSteps) {
+      try {
+        step->move();
+      } catch (const std::exception&) {
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+  auto syncGuard = folly::makeGuard(syncSteps);
+  const auto* driverCtx = operatorCtx_->driverCtx();
+  for (auto chunk = 1; chunk < numChunks; ++chunk) {
+    executor->add([driverCtx, step = chunkSteps[chunk]]() {
+      ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+      step->prepare();
+    });
+  }
+  syncGuard.dismiss();
+  syncSteps();
+  if (error != nullptr) {
+    chunkStarts_.clear();
+    chunkResults_.clear();
+    std::rethrow_exception(error);
+  }
+  addRuntimeStat("windowParallelChunks", RuntimeCounter(numChunks));
+}
+
+void Window::computeChunk(
+    size_t chunk,
+    const BufferPtr& peerStarts,
+    const BufferPtr& peerEnds) {
+  const auto startRow = chunkStarts_[chunk];
+  const auto endRow = chunkEnd(chunk);
+  currentPartition_->computePeerBuffers(
+      startRow,
+      endRow,
+      startRow,
+      startRow,
+      peerStarts->asMutable<vector_size_t>(),
+      peerEnds->asMutable<vector_size_t>());
+
+  // The chunk-parallel functions ignore the frames.
+  const SelectivityVector validRows(endRow - startRow);
+  auto& functions = chunkFunctions_[chunk];
+  for (auto i = 0; i < functions.size(); ++i) {
+    functions[i]->resetPartitionChunk(currentPartition_.get(), startRow);
+    functions[i]->apply(
+        peerStarts,
+        peerEnds,
+        peerStarts,
+        peerEnds,
+        validRows,
+        0,
+        chunkResults_[chunk][i]);
+  }
+}
+
+void Window::copyChunkResults(
+    vector_size_t startRow,
+    vector_size_t numRows,
+    vector_size_t resultOffset,
+    const RowVectorPtr& result) {
+  auto chunk = std::upper_bound(
+                   chunkStarts_.begin(), chunkStarts_.end(), startRow) -
+      chunkStarts_.begin() - 1;
+  while (numRows > 0) {
+    const auto chunkStart = chunkStarts_[chunk];
+    const auto numChunkRows = std::min(numRows, chunkEnd(chunk) - startRow);
+    for (auto i = 0; i < windowFunctions_.size(); ++i) {
+      result->childAt(numInputColumns_ + i)
+          ->copy(
+              chunkResults_[chunk][i].get(),
+              resultOffset,
+              startRow - chunkStart,
+              numChunkRows);
+    }
+    startRow += numChunkRows;
+    resultOffset += numChunkRows;
+    numRows -= numChunkRows;
+    ++chunk;
   }
 }
 
@@ -592,27 +803,81 @@ void Window::callApplyForPartitionRows(
   // processed rows (used for peer group comparison) will be deleted by
   // computePeerAndFrameBuffers after peer group comparison. Hence we need to
   // call getInputColumns after computePeerAndFrameBuffers.
-  computePeerAndFrameBuffers(startRow, endRow);
+  const vector_size_t numRows = endRow - startRow;
+  if (!chunkStarts_.empty()) {
+    // The results were computed in chunks when the partition started.
+    getInputColumns(startRow, endRow, resultOffset, result);
+    copyChunkResults(startRow, numRows, resultOffset, result);
+  } else {
+    computePeerAndFrameBuffers(startRow, endRow);
+    if (currentPartition_->partial() && !rangeStreamingFunctions_.empty()) {
+      checkRangeStreamingFrames(numRows);
+    }
 
-  getInputColumns(startRow, endRow, resultOffset, result);
-  vector_size_t numFuncs = windowFunctions_.size();
-  for (auto i = 0; i < numFuncs; ++i) {
-    windowFunctions_[i]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[i],
-        frameEndBuffers_[i],
-        validFrames_[i],
-        resultOffset,
-        result->childAt(numInputColumns_ + i));
+    getInputColumns(startRow, endRow, resultOffset, result);
+    vector_size_t numFuncs = windowFunctions_.size();
+    for (auto i = 0; i < numFuncs; ++i) {
+      windowFunctions_[i]->apply(
+          peerStartBuffer_,
+          peerEndBuffer_,
+          frameStartBuffers_[i],
+          frameEndBuffers_[i],
+          validFrames_[i],
+          resultOffset,
+          result->childAt(numInputColumns_ + i));
+    }
   }
 
-  const vector_size_t numRows = endRow - startRow;
   numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
 
   if (currentPartition_->partial()) {
-    currentPartition_->removeProcessedRows(numRows);
+    if (rangeStreamingFunctions_.empty()) {
+      currentPartition_->removeProcessedRows(numRows);
+    } else {
+      currentPartition_->removeRowsBefore(firstRetainedRow(numRows));
+    }
+  }
+}
+
+vector_size_t Window::firstRetainedRow(vector_size_t numRows) const {
+  if (currentPartition_->complete() &&
+      currentPartition_->numRowsForProcessing(partitionOffset_) == 0) {
+    // All the rows of the partition are processed.
+    return partitionOffset_;
+  }
+
+  // The frames of the following rows start at or after the frame start of the
+  // last processed row. The last processed row is kept for the peer group
+  // comparison with the next row. The row before the frame start is kept to
+  // detect frames that start before the kept rows, see
+  // checkRangeStreamingFrames().
+  auto firstRow = partitionOffset_ - 1;
+  for (const auto i : rangeStreamingFunctions_) {
+    const auto* rawFrameStarts = frameStartBuffers_[i]->as<vector_size_t>();
+    firstRow = std::min(firstRow, rawFrameStarts[numRows - 1] - 1);
+  }
+  return firstRow;
+}
+
+void Window::checkRangeStreamingFrames(vector_size_t numRows) const {
+  // If a frame starts at the first kept row, then it may also include rows
+  // that were removed before.
+  const auto startRow = currentPartition_->startRow();
+  if (startRow == 0) {
+    return;
+  }
+  for (const auto i : rangeStreamingFunctions_) {
+    const auto* rawFrameStarts = frameStartBuffers_[i]->as<vector_size_t>();
+    for (auto row = 0; row < numRows; ++row) {
+      VELOX_USER_CHECK_GT(
+          rawFrameStarts[row],
+          startRow,
+          "The window frame starts before the rows kept for streaming RANGE "
+          "frames. The frame offsets must be constant within a partition if {} "
+          "is enabled.",
+          core::QueryConfig::kWindowRangeStreamingEnabled);
+    }
   }
 }
 
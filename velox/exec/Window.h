@@ -90,9 +90,20 @@ class Window : public Operator {
 
   // Returns if a window operator support rows-wise streaming processing or not.
   // Currently we supports 'rank', 'dense_rank' and 'row_number' functions with
-  // any frame type. Also supports the agg window function with default frame.
+  // any frame type. Also supports the agg window function with default frame,
+  // and with RANGE BETWEEN k PRECEDING AND CURRENT ROW frames if
+  // 'window_range_streaming_enabled' is set. Sets rangeStreamingFunctions_.
   bool supportRowsStreaming();
 
+  // Returns the first row of the current partial partition that is kept after
+  // processing 'numRows' rows up to 'partitionOffset_'.
+  vector_size_t firstRetainedRow(vector_size_t numRows) const;
+
+  // Checks that none of the frames of rangeStreamingFunctions_ for the
+  // 'numRows' rows being processed start before the kept rows of the current
+  // partial partition.
+  void checkRangeStreamingFrames(vector_size_t numRows) const;
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
@@ -113,6 +124,34 @@ class Window : public Operator {
   // Updates all the state for the next partition.
   void callResetPartition();
 
+  // Evaluates the window functions for the current partition in chunks in
+  // parallel if the partition is large enough and all the functions support
+  // chunks. Sets chunkStarts_ and chunkResults_. Leaves them empty if the
+  // partition is evaluated by apply() calls for each output batch.
+  void computeChunkResults();
+
+  // Evaluates the window functions for the rows of 'chunk'. Runs on the
+  // executor.
+  void computeChunk(
+      size_t chunk,
+      const BufferPtr& peerStarts,
+      const BufferPtr& peerEnds);
+
+  // Returns the end row (exclusive) of 'chunk' of the current partition.
+  vector_size_t chunkEnd(size_t chunk) const {
+    return chunk + 1 < chunkStarts_.size() ? chunkStarts_[chunk + 1]
+                                           : currentPartition_->numRows();
+  }
+
+  // Copies the results of the window functions for 'numRows' rows of the
+  // current partition starting at 'startRow' from chunkResults_ to 'result'
+  // at 'resultOffset'.
+  void copyChunkResults(
+      vector_size_t startRow,
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const RowVectorPtr& result);
+
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
   // could span multiple output blocks and a single output block could
@@ -181,6 +220,30 @@ class Window : public Operator {
   // The functions are ordered by their positions in the output columns.
   std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
 
+  // Maximum number of chunks a partition is split into for the parallel
+  // evaluation.
+  static constexpr size_t kMaxParallelChunks = 32;
+
+  // Approximate number of rows per chunk for the parallel evaluation of a
+  // partition. 0 if disabled.
+  const vector_size_t parallelChunkRows_;
+
+  // Creates instances of the window functions for the chunks of a partition.
+  // Empty if the parallel evaluation is disabled or not all the functions
+  // support chunks.
+  std::vector<std::function<std::unique_ptr<WindowFunction>()>>
+      chunkFunctionFactories_;
+
+  // Instances of the window functions for each chunk. Reused across
+  // partitions.
+  std::vector<std::vector<std::unique_ptr<WindowFunction>>> chunkFunctions_;
+
+  // The first rows of the chunks of the current partition and the results of
+  // the window functions for each chunk. Empty if the current partition is
+  // not evaluated in chunks.
+  std::vector<vector_size_t> chunkStarts_;
+  std::vector<std::vector<VectorPtr>> chunkResults_;
+
   // Vector of WindowFrames corresponding to each windowFunction above.
   // It represents the frame spec for the function computation.
   std::vector<WindowFrame> windowFrames_;
@@ -222,6 +285,11 @@ class Window : public Operator {
   // Tracks how far along the partition rows have been output.
   vector_size_t partitionOffset_ = 0;
 
+  // Indices of the aggregate window functions with RANGE BETWEEN k PRECEDING
+  // AND CURRENT ROW frames over streamed partitions. The rows of a partial
+  // partition before the frames of these functions are removed.
+  std::vector<column_index_t> rangeStreamingFunctions_;
+
   // When traversing input partition rows, the peers are the rows with the same
   // values for the ORDER BY clause. These rows are equal in some ways and
   // affect the results of ranking functions. Since all rows between the
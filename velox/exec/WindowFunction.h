@@ -48,6 +48,11 @@ class WindowFunction {
   struct Metadata {
     ProcessMode processMode;
     bool isAggregate;
+    /// True if the function can compute the results for a chunk of rows of a
+    /// partition that starts at a peer group after resetPartitionChunk(),
+    /// without processing the rows before the chunk. Such functions only use
+    /// the peer groups and ignore the frames of the rows.
+    bool isChunkParallel{false};
 
     static Metadata defaultMetadata() {
       static Metadata defaultValue{ProcessMode::kPartition, false};
@@ -89,6 +94,18 @@ class WindowFunction {
   /// underlying rows of the partition.
   virtual void resetPartition(const WindowPartition* partition) = 0;
 
+  /// Invoked instead of resetPartition() for functions with
+  /// Metadata::isChunkParallel set, when the rows of 'partition' from
+  /// 'startRow' on are processed independently of the rows before. 'startRow'
+  /// is the first row of a peer group. The subsequent calls to apply(...) are
+  /// for the rows starting at 'startRow'. The frame buffers passed to these
+  /// calls are not computed.
+  virtual void resetPartitionChunk(
+      const WindowPartition* /*partition*/,
+      vector_size_t /*startRow*/) {
+    VELOX_UNSUPPORTED("Window function does not support chunks of partitions");
+  }
+
   /// This function is invoked by the Window Operator to compute
   /// the window function for a batch of rows.
   /// @param peerGroupStarts  A buffer of the indexes of rows at which the
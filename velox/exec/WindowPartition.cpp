@@ -79,13 +79,26 @@ void WindowPartition::removeProcessedRows(vector_size_t numRows) {
   startRow_ += numRows;
 }
 
+void WindowPartition::removeRowsBefore(vector_size_t partitionRow) {
+  checkPartial();
+
+  VELOX_CHECK_NULL(previousRow_);
+  const auto numRows = partitionRow - startRow_;
+  if (numRows <= 0) {
+    return;
+  }
+  VELOX_CHECK_LE(numRows, rows_.size());
+  eraseRows(numRows);
+
+  rows_.erase(rows_.begin(), rows_.begin() + numRows);
+  partition_ = folly::Range(rows_.data(), rows_.size());
+  startRow_ = partitionRow;
+}
+
 vector_size_t WindowPartition::numRowsForProcessing(
     vector_size_t partitionOffset) const {
-  if (partial_) {
-    return partition_.size();
-  } else {
-    return partition_.size() - partitionOffset;
-  }
+  // The rows before 'startRow_' are removed from a partial partition.
+  return startRow_ + partition_.size() - partitionOffset;
 }
 
 void WindowPartition::extractColumn(
@@ -123,8 +136,9 @@ void WindowPartition::extractNulls(
     vector_size_t partitionOffset,
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
+  VELOX_CHECK_GE(partitionOffset, startRow_);
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -232,11 +246,19 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   size_t next = start;
   size_t index{0};
   if (partial_ && start > 0) {
-    const auto peerGroup = peerCompare(previousRow_, partition_[0]);
+    // The last row of the previous batch is either kept in 'previousRow_' or,
+    // if the processed rows are kept by removeRowsBefore(), in 'partition_'.
+    const auto* previousRow = previousRow_ != nullptr
+        ? previousRow_
+        : partition_[start - 1 - startRow_];
+    const auto peerGroup =
+        peerCompare(previousRow, partition_[start - startRow_]);
 
     // The first row is the last row in previous batch so delete it after used
     // for the first peer group detection.
-    removePreviousRow();
+    if (previousRow_ != nullptr) {
+      removePreviousRow();
+    }
 
     if (!peerGroup) {
       peerEnd = findPeerRowEndIndex(start, lastPartitionRow, peerCompare);
@@ -271,6 +293,14 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   return {peerStart, peerEnd};
 }
 
+vector_size_t WindowPartition::nextPeerGroupStart(vector_size_t row) {
+  VELOX_CHECK(!partial_);
+  return findPeerRowEndIndex(
+      row, numRows() - 1, [&](const char* lhs, const char* rhs) {
+        return compareRowsWithSortKeys(lhs, rhs);
+      });
+}
+
 // Searches for start[frameColumn] in orderByColumn.
 // The search could return the first or last row matching start[frameColumn].
 // If a matching row is not present, then the index of the first row greater
@@ -288,13 +318,17 @@ vector_size_t WindowPartition::searchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = partition_[currentRow - startRow_];
   vector_size_t begin = start;
   vector_size_t finish = end;
   while (finish - begin >= 2) {
     auto mid = (begin + finish) / 2;
     auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
+        partition_[mid - startRow_],
+        current,
+        orderByColumn,
+        frameColumn,
+        flags);
 
     if (compareResult >= 0) {
       // Search in the first half of the column.
@@ -317,10 +351,14 @@ vector_size_t WindowPartition::linearSearchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = partition_[currentRow - startRow_];
   for (vector_size_t i = start; i < end; ++i) {
     auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
+        partition_[i - startRow_],
+        current,
+        orderByColumn,
+        frameColumn,
+        flags);
 
     // The bound value was found. Return if firstMatch required.
     // If the last match is required, then we need to find the first row that
@@ -346,7 +384,8 @@ vector_size_t WindowPartition::linearSearchFrameValue(
 
   // Return a row beyond the partition boundary. The logic to determine valid
   // frames handles the out of bound and empty frames from this value.
-  return end == numRows() ? numRows() + 1 : -1;
+  const auto endRow = startRow_ + numRows();
+  return end == endRow ? endRow + 1 : -1;
 }
 
 void WindowPartition::updateKRangeFrameBounds(
@@ -370,7 +409,7 @@ void WindowPartition::updateKRangeFrameBounds(
   RowColumn orderByRowColumn = data_->columnAt(orderByColumn);
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
-    auto* partitionRow = partition_[currentRow];
+    auto* partitionRow = partition_[currentRow - startRow_];
 
     // The user is expected to set the frame column equal to NULL when the
     // ORDER BY value is NULL and not in any other case. Validate this
@@ -396,13 +435,14 @@ void WindowPartition::updateKRangeFrameBounds(
     } else {
       // If the search is for a preceding bound then rows between
       // [0, currentRow] are examined. For following bounds, rows between
-      // [currentRow, numRows()) are checked.
+      // [currentRow, numRows()) are checked. A partial partition has only the
+      // rows from 'startRow_'.
       if (isPreceding) {
-        start = 0;
+        start = startRow_;
         end = currentRow + 1;
       } else {
         start = currentRow;
-        end = partition_.size();
+        end = startRow_ + partition_.size();
       }
       rawFrameBounds[i] = searchFrameValue(
           firstMatch,
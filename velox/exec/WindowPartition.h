@@ -63,6 +63,17 @@ class WindowPartition {
   /// after been processed.
   void removeProcessedRows(vector_size_t numRows);
 
+  /// Removes the rows before the partition offset 'partitionRow' from a
+  /// partial window partition. Unlike removeProcessedRows(), the processed
+  /// rows from 'partitionRow' are kept for the frames of the following rows.
+  void removeRowsBefore(vector_size_t partitionRow);
+
+  /// Returns the partition offset of the first row kept in the partition. This
+  /// is always zero for a non-partial partition.
+  vector_size_t startRow() const {
+    return startRow_;
+  }
+
   /// Returns the number of rows in the current WindowPartition.
   vector_size_t numRows() const {
     return partition_.size();
@@ -149,6 +160,11 @@ class WindowPartition {
       vector_size_t* rawPeerStarts,
       vector_size_t* rawPeerEnds);
 
+  /// Returns the first row after 'row' that is not a peer of 'row', or the end
+  /// of the partition if there is none. Used to split a non-partial partition
+  /// into chunks at peer group boundaries.
+  vector_size_t nextPeerGroupStart(vector_size_t row);
+
   /// Sets in 'rawFrameBounds' the frame boundary for the k range
   /// preceding/following frame.
   /// @param isStartBound start or end boundary of the frame.
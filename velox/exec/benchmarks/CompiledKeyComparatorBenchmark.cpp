@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <deque>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/CompiledKeyComparator.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+// Compares the per-column RowContainer::compare() with CompiledKeyComparator
+// for equality and ordering of rows with (bigint, varchar, date) and
+// (bigint, integer, bigint) keys.
+
+namespace facebook::velox::exec {
+namespace {
+
+constexpr int32_t kNumRows = 100'000;
+
+class ComparatorBenchmark {
+ public:
+  explicit ComparatorBenchmark(bool withStrings)
+      : pool_(memory::memoryManager()->addLeafPool()),
+        vectorMaker_(pool_.get()) {
+    // Few distinct values per key so that comparisons often look at all keys.
+    std::vector<VectorPtr> keys;
+    keys.push_back(vectorMaker_.flatVector<int64_t>(
+        kNumRows, [](auto row) { return row % 7; }));
+    if (withStrings) {
+      keys.push_back(
+          vectorMaker_.flatVector<StringView>(kNumRows, [&](auto row) {
+            strings_.push_back(fmt::format("a string key {}", row % 3));
+            return StringView(strings_.back());
+          }));
+      keys.push_back(vectorMaker_.flatVector<int32_t>(
+          kNumRows, [](auto row) { return row % 5; }, nullptr, DATE()));
+    } else {
+      keys.push_back(vectorMaker_.flatVector<int32_t>(
+          kNumRows, [](auto row) { return row % 3; }));
+      keys.push_back(vectorMaker_.flatVector<int64_t>(
+          kNumRows, [](auto row) { return row % 5; }));
+    }
+
+    std::vector<TypePtr> types;
+    for (const auto& key : keys) {
+      types.push_back(key->type());
+    }
+    container_ = std::make_unique<RowContainer>(types, pool_.get());
+    rows_.resize(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows_[i] = container_->newRow();
+    }
+    SelectivityVector allRows(kNumRows);
+    for (auto column = 0; column < keys.size(); ++column) {
+      DecodedVector decoded(*keys[column], allRows);
+      for (auto i = 0; i < kNumRows; ++i) {
+        container_->store(decoded, i, rows_[i], column);
+      }
+    }
+    comparator_ = std::make_unique<CompiledKeyComparator>(
+        CompiledKeyComparator::forKeys(container_.get()));
+  }
+
+  int64_t perColumnEquals() const {
+    int64_t numEqual = 0;
+    const auto numKeys = container_->keyTypes().size();
+    for (auto i = 1; i < kNumRows; ++i) {
+      bool equal = true;
+      for (auto key = 0; key < numKeys && equal; ++key) {
+        equal = container_->compare(rows_[i - 1], rows_[i], key) == 0;
+      }
+      numEqual += equal;
+    }
+    return numEqual;
+  }
+
+  int64_t compiledEquals() const {
+    int64_t numEqual = 0;
+    for (auto i = 1; i < kNumRows; ++i) {
+      numEqual += comparator_->equals(rows_[i - 1], rows_[i]);
+    }
+    return numEqual;
+  }
+
+  void perColumnSort() {
+    auto rows = rows_;
+    std::sort(
+        rows.begin(), rows.end(), [&](const char* left, const char* right) {
+          return container_->compareRows(left, right) < 0;
+        });
+    folly::doNotOptimizeAway(rows);
+  }
+
+  void compiledSort() {
+    auto rows = rows_;
+    std::sort(
+        rows.begin(), rows.end(), [&](const char* left, const char* right) {
+          return comparator_->compare(left, right) < 0;
+        });
+    folly::doNotOptimizeAway(rows);
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_;
+  test::VectorMaker vectorMaker_;
+  std::deque<std::string> strings_;
+  std::unique_ptr<RowContainer> container_;
+  std::unique_ptr<CompiledKeyComparator> comparator_;
+  std::vector<char*> rows_;
+};
+
+std::unique_ptr<ComparatorBenchmark> mixedKeys;
+std::unique_ptr<ComparatorBenchmark> fixedWidthKeys;
+
+BENCHMARK(mixedKeysPerColumnEquals) {
+  folly::doNotOptimizeAway(mixedKeys->perColumnEquals());
+}
+
+BENCHMARK_RELATIVE(mixedKeysCompiledEquals) {
+  folly::doNotOptimizeAway(mixedKeys->compiledEquals());
+}
+
+BENCHMARK(mixedKeysPerColumnSort) {
+  mixedKeys->perColumnSort();
+}
+
+BENCHMARK_RELATIVE(mixedKeysCompiledSort) {
+  mixedKeys->compiledSort();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(fixedWidthKeysPerColumnEquals) {
+  folly::doNotOptimizeAway(fixedWidthKeys->perColumnEquals());
+}
+
+BENCHMARK_RELATIVE(fixedWidthKeysCompiledEquals) {
+  folly::doNotOptimizeAway(fixedWidthKeys->compiledEquals());
+}
+
+BENCHMARK(fixedWidthKeysPerColumnSort) {
+  fixedWidthKeys->perColumnSort();
+}
+
+BENCHMARK_RELATIVE(fixedWidthKeysCompiledSort) {
+  fixedWidthKeys->compiledSort();
+}
+
+} // namespace
+} // namespace facebook::velox::exec
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize({});
+  using facebook::velox::exec::ComparatorBenchmark;
+  facebook::velox::exec::mixedKeys =
+      std::make_unique<ComparatorBenchmark>(true);
+  facebook::velox::exec::fixedWidthKeys =
+      std::make_unique<ComparatorBenchmark>(false);
+  folly::runBenchmarks();
+  facebook::velox::exec::mixedKeys.reset();
+  facebook::velox::exec::fixedWidthKeys.reset();
+  return 0;
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
@@ -41,6 +42,15 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_string(
+    wide_destinations,
+    "100,1000",
+    "Comma separated numbers of destinations of the wide shuffle benchmarks");
+DEFINE_int32(wide_width, 2, "Number of producer tasks in wide shuffles");
+DEFINE_bool(
+    preserve_encodings,
+    false,
+    "Keep dictionary and constant encodings in PartitionedOutput");
 
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
@@ -105,20 +115,28 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Shuffles 'vectors' from 'width' producer tasks to 'numDestinations'
+  /// consumer tasks. 'numDestinations' defaults to 'width'.
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      int32_t numDestinations = 0) {
     assert(!vectors.empty());
+    if (numDestinations == 0) {
+      numDestinations = width;
+    }
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kPartitionedOutputPreserveEncodings] =
+        FLAGS_preserve_encodings ? "true" : "false";
     auto iteration = ++iteration_;
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numDestinations)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
@@ -140,7 +158,7 @@ class ExchangeBenchmark : public VectorTestBase {
             .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
+    for (int i = 0; i < numDestinations; i++) {
       auto taskId = makeTaskId(iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
@@ -444,6 +462,22 @@ void runBenchmarks() {
     return 1;
   });
 
+  std::vector<int32_t> wideDestinations;
+  folly::split(',', FLAGS_wide_destinations, wideDestinations);
+  std::vector<Counters> wideCounters(wideDestinations.size());
+  for (auto i = 0; i < wideDestinations.size(); ++i) {
+    const auto name = fmt::format("exchangeFlat10kTo{}", wideDestinations[i]);
+    folly::addBenchmark(__FILE__, name, [&, i]() {
+      bm->run(
+          flat10k,
+          FLAGS_wide_width,
+          FLAGS_task_width,
+          wideCounters[i],
+          wideDestinations[i]);
+      return 1;
+    });
+  }
+
   folly::addBenchmark(__FILE__, "localFlat10k", [&]() {
     bm->runLocal(
         flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
@@ -456,6 +490,10 @@ void runBenchmarks() {
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
             << "struct1k: " << struct1kCounters.toString() << std::endl;
+  for (auto i = 0; i < wideDestinations.size(); ++i) {
+    std::cout << "flat10k to " << wideDestinations[i]
+              << ": " << wideCounters[i].toString() << std::endl;
+  }
 }
 
 } // namespace
@@ -58,6 +58,9 @@ struct TestCase {
   std::shared_ptr<const core::PlanNode> plan95;
   // Plan that processes data in 4 stages, each selecting 50%
   std::shared_ptr<const core::PlanNode> plan50;
+  // Plan with a narrow AND filter selecting about 3%. The filter produces the
+  // passing rows without a boolean result vector.
+  std::shared_ptr<const core::PlanNode> conjunct;
 };
 
 class FilterProjectBenchmark : public VectorTestBase {
@@ -151,6 +154,16 @@ class FilterProjectBenchmark : public VectorTestBase {
     return builder.planNode();
   }
 
+  std::shared_ptr<const core::PlanNode> makeConjunctPlan(
+      std::vector<RowVectorPtr> data) {
+    return exec::test::PlanBuilder()
+        .values(data)
+        .filter("c0 >= 950000 AND c0 % 3 <> 0")
+        .project({"c0 + 1 as c0"})
+        .singleAggregation({}, {"count(1)", "max(c0)"})
+        .planNode();
+  }
+
   std::string makeString(int32_t n) {
     static std::vector<std::string> tokens = {
         "epi",         "plectic",  "cary",    "ally",    "ously",
@@ -233,6 +246,7 @@ class FilterProjectBenchmark : public VectorTestBase {
     test->baseline = makeFilterProjectPlan(1, 80, test->rows);
     test->plan95 = makeFilterProjectPlan(4, 95, test->rows);
     test->plan50 = makeFilterProjectPlan(4, 50, test->rows);
+    test->conjunct = makeConjunctPlan(test->rows);
     folly::addBenchmark(
         __FILE__, name + "_base", [plan = &test->baseline, this]() {
           run(*plan);
@@ -248,6 +262,11 @@ class FilterProjectBenchmark : public VectorTestBase {
           run(*plan);
           return 1;
         });
+    folly::addBenchmark(
+        __FILE__, name + "_and", [plan = &test->conjunct, this]() {
+          run(*plan);
+          return 1;
+        });
     cases_.push_back(std::move(test));
   }
 
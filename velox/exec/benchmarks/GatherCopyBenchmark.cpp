@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/OperatorUtils.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+constexpr int32_t kNumSources = 8;
+constexpr vector_size_t kSourceSize = 1'000;
+
+// Gathers rows of a wide schema from several sources, like the output of a
+// spilled OrderBy, either with gatherCopy() or one row at a time.
+class GatherCopyBenchmark {
+ public:
+  GatherCopyBenchmark() {
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < 50; ++i) {
+      switch (i % 4) {
+        case 0:
+          types.push_back(BIGINT());
+          break;
+        case 1:
+          types.push_back(DOUBLE());
+          break;
+        case 2:
+          types.push_back(VARCHAR());
+          break;
+        default:
+          types.push_back(ARRAY(INTEGER()));
+          break;
+      }
+    }
+    rowType_ = ROW(std::move(types));
+
+    VectorFuzzer::Options options;
+    options.vectorSize = kSourceSize;
+    options.nullRatio = 0.1;
+    VectorFuzzer fuzzer(options, pool_.get());
+    for (auto i = 0; i < kNumSources; ++i) {
+      sources_.push_back(fuzzer.fuzzInputFlatRow(rowType_));
+      rawSources_.push_back(sources_.back().get());
+    }
+  }
+
+  // Sets up 'kNumSources * kSourceSize' output rows which switch to the next
+  // source every 'runLength' rows.
+  void setRuns(vector_size_t runLength) {
+    const auto numRows = kNumSources * kSourceSize;
+    rowSources_.resize(numRows);
+    rowIndices_.resize(numRows);
+    std::vector<vector_size_t> nextRow(kNumSources, 0);
+    for (auto i = 0; i < numRows; ++i) {
+      const auto source = (i / runLength) % kNumSources;
+      rowSources_[i] = rawSources_[source];
+      rowIndices_[i] = nextRow[source]++;
+    }
+  }
+
+  void gather(bool batched, int32_t iterations) {
+    folly::BenchmarkSuspender suspender;
+    for (auto i = 0; i < iterations; ++i) {
+      auto target = std::static_pointer_cast<RowVector>(
+          BaseVector::create(rowType_, rowSources_.size(), pool_.get()));
+      suspender.dismiss();
+      if (batched) {
+        gatherCopy(
+            target.get(), 0, rowSources_.size(), rowSources_, rowIndices_);
+      } else {
+        for (auto row = 0; row < rowSources_.size(); ++row) {
+          for (auto column = 0; column < rowType_->size(); ++column) {
+            target->childAt(column)->copy(
+                rowSources_[row]->childAt(column).get(),
+                row,
+                rowIndices_[row],
+                1);
+          }
+        }
+      }
+      folly::doNotOptimizeAway(target);
+      suspender.rehire();
+    }
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  RowTypePtr rowType_;
+  std::vector<RowVectorPtr> sources_;
+  std::vector<const RowVector*> rawSources_;
+  std::vector<const RowVector*> rowSources_;
+  std::vector<vector_size_t> rowIndices_;
+};
+
+std::unique_ptr<GatherCopyBenchmark> benchmark;
+
+BENCHMARK_MULTI(rowByRowRuns16) {
+  benchmark->setRuns(16);
+  benchmark->gather(false, 10);
+  return 10;
+}
+
+BENCHMARK_RELATIVE_MULTI(gatherCopyRuns16) {
+  benchmark->setRuns(16);
+  benchmark->gather(true, 10);
+  return 10;
+}
+
+BENCHMARK_MULTI(rowByRowAlternating) {
+  benchmark->setRuns(1);
+  benchmark->gather(false, 10);
+  return 10;
+}
+
+BENCHMARK_RELATIVE_MULTI(gatherCopyAlternating) {
+  benchmark->setRuns(1);
+  benchmark->gather(true, 10);
+  return 10;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<GatherCopyBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
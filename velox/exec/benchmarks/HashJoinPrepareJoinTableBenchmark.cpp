@@ -22,6 +22,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include <iostream>
+#include <numeric>
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -121,6 +122,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     params_ = params;
     topTable_.reset();
     otherTables_.clear();
+    buildBatches_.clear();
     createTable();
   }
 
@@ -133,6 +135,36 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     VELOX_CHECK_EQ(topTable_->hashMode(), params_.mode);
   }
 
+  // Probes the table made by run() with the build side rows in batches of
+  // 'kProbeBatchSize'. Radix clusters the probe rows if 'radixClusterBits' is
+  // not zero. Only supports kHash mode.
+  void probe(int32_t radixClusterBits) {
+    VELOX_CHECK_EQ(topTable_->hashMode(), BaseHashTable::HashMode::kHash);
+    constexpr int32_t kProbeBatchSize = 10'000;
+    auto& hashers = topTable_->hashers();
+    HashLookup lookup(hashers);
+    lookup.radixClusterBits = radixClusterBits;
+    SelectivityVector rows;
+    for (const auto& buildBatch : buildBatches_) {
+      for (vector_size_t offset = 0; offset < buildBatch->size();
+           offset += kProbeBatchSize) {
+        const auto size = std::min<vector_size_t>(
+            kProbeBatchSize, buildBatch->size() - offset);
+        auto batch = std::static_pointer_cast<RowVector>(
+            buildBatch->slice(offset, size));
+        rows.resize(size);
+        rows.setAll();
+        lookup.reset(size);
+        for (auto i = 0; i < hashers.size(); ++i) {
+          hashers[i]->decode(*batch->childAt(i), rows);
+          hashers[i]->hash(rows, i > 0, lookup.hashes);
+        }
+        std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+        topTable_->joinProbe(lookup);
+      }
+    }
+  }
+
  private:
   // Create the row vector for the build side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
@@ -223,6 +255,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
           pool_.get());
 
       copyVectorsToTable(batches[i], table.get());
+      buildBatches_.push_back(batches[i]);
       if (i == 0) {
         topTable_ = std::move(table);
       } else {
@@ -234,6 +267,8 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
   std::default_random_engine randomEngine_;
   std::unique_ptr<HashTable<true>> topTable_;
   std::vector<std::unique_ptr<BaseHashTable>> otherTables_;
+  // The build side input, used as probe side input by probe().
+  std::vector<RowVectorPtr> buildBatches_;
   HashTableBenchmarkParams params_;
 };
 
@@ -296,6 +331,18 @@ void initHashModeBenchmarkParams(
     }
   }
 }
+
+// Large hash mode tables for comparing radix clustered probes with the default.
+// 1B rows do not fit in the memory configured in main().
+void initHashModeProbeBenchmarkParams(
+    std::vector<HashTableBenchmarkParams>& params) {
+  TypePtr threeKeyType{ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()})};
+  std::vector<int64_t> buildSizeVector = {10'000'000, 100'000'000};
+  for (auto buildSize : buildSizeVector) {
+    params.push_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash, threeKeyType, buildSize, buildSize, 8));
+  }
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -322,6 +369,25 @@ int main(int argc, char** argv) {
       return 1;
     });
   }
+
+  std::vector<HashTableBenchmarkParams> probeParams;
+  initHashModeProbeBenchmarkParams(probeParams);
+  for (auto& param : probeParams) {
+    for (auto radixClusterBits : {0, 6, 10}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "Probe:{},radixClusterBits:{}", param.title, radixClusterBits),
+          [param, radixClusterBits, &bm]() {
+            folly::BenchmarkSuspender suspender;
+            bm->prepare(param);
+            bm->run();
+            suspender.dismiss();
+            bm->probe(radixClusterBits);
+            return 1;
+          });
+    }
+  }
   folly::runBenchmarks();
   return 0;
 }
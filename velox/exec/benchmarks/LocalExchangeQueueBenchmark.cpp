@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/exec/LocalPartition.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+DEFINE_int64(
+    local_exchange_buffer_mb,
+    32,
+    "The memory limit of the buffered data of all the queues");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+// The size attributed to each enqueued vector.
+constexpr int64_t kVectorBytes = 64 << 10;
+
+std::shared_ptr<memory::MemoryPool> pool;
+RowVectorPtr vector;
+
+// Runs 'numThreads' producers and 'numThreads' consumers on one
+// LocalExchangeQueue. Each producer enqueues 'iters' vectors.
+void run(uint32_t iters, int32_t numThreads) {
+  folly::BenchmarkSuspender suspender;
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(
+      FLAGS_local_exchange_buffer_mb << 20);
+  auto queue = std::make_shared<LocalExchangeQueue>(memoryManager, 0);
+  for (auto i = 0; i < numThreads; ++i) {
+    queue->addProducer();
+  }
+  queue->noMoreProducers();
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads * 2);
+  suspender.dismiss();
+  for (auto i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < iters; ++j) {
+        ContinueFuture future;
+        if (queue->enqueue(vector, kVectorBytes, &future) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      queue->noMoreData();
+    });
+    threads.emplace_back([&]() {
+      for (;;) {
+        RowVectorPtr data;
+        ContinueFuture future;
+        if (queue->next(&future, pool.get(), &data) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+BENCHMARK_NAMED_PARAM(run, threads8, 8);
+BENCHMARK_NAMED_PARAM(run, threads32, 32);
+BENCHMARK_NAMED_PARAM(run, threads96, 96);
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  test::VectorMaker maker(pool.get());
+  vector = maker.rowVector(
+      {maker.flatVector<int64_t>(1'000, [](auto row) { return row; })});
+  folly::runBenchmarks();
+  vector.reset();
+  pool.reset();
+  return 0;
+}
@@ -135,6 +135,14 @@ static const common::PrefixSortConfig kStdSortConfig(
     1024,
     std::numeric_limits<int>::max());
 
+// Prefix-sort that never uses radix-sort, as the base for the radix-sort of
+// the default config on large datasets.
+static const common::PrefixSortConfig kQuickSortConfig(
+    1024,
+    100,
+    16,
+    std::numeric_limits<int32_t>::max());
+
 class PrefixSortBenchmark {
  public:
   PrefixSortBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
@@ -150,6 +158,16 @@ class PrefixSortBenchmark {
         rowContainer, compareFlags, kDefaultSortConfig, pool_, sortedRows);
   }
 
+  void runQuickSort(
+      const std::vector<char*>& rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags) {
+    auto sortedRows = std::vector<char*, memory::StlAllocator<char*>>(
+        rows.begin(), rows.end(), *pool_);
+    PrefixSort::sort(
+        rowContainer, compareFlags, kQuickSortConfig, pool_, sortedRows);
+  }
+
   void runStdSort(
       const std::vector<char*>& rows,
       RowContainer* rowContainer,
@@ -186,6 +204,22 @@ class PrefixSortBenchmark {
               }
               return rows.size() * iterations;
             });
+        if (numRows >=
+            static_cast<size_t>(kDefaultSortConfig.radixSortMinRows)) {
+          folly::addBenchmark(
+              __FILE__,
+              "%QuickSort",
+              [rows = testCase->rows(),
+               container = testCase->rowContainer(),
+               sortFlags = testCase->compareFlags(),
+               iterations = iterations,
+               this]() {
+                for (auto i = 0; i < iterations; ++i) {
+                  runQuickSort(rows, container, sortFlags);
+                }
+                return rows.size() * iterations;
+              });
+        }
       }
       folly::addBenchmark(
           __FILE__,
@@ -130,7 +130,8 @@ class WindowPrefixSortBenchmark : public HiveConnectorTestBase {
   void run(
       const std::string& key,
       const std::string& aggregate,
-      bool prefixSort = true) {
+      bool prefixSort = true,
+      bool radixSort = true) {
     folly::BenchmarkSuspender suspender1;
 
     if ((prefixSort && !lastRunPrefixSort_) ||
@@ -151,7 +152,7 @@ class WindowPrefixSortBenchmark : public HiveConnectorTestBase {
                                   .planFragment();
 
     vector_size_t numResultRows = 0;
-    auto task = makeTask(plan, prefixSort);
+    auto task = makeTask(plan, prefixSort, radixSort);
     task->addSplit(
         tableScanPlanId,
         exec::Split(makeHiveConnectorSplit(sourceFilePath_->getPath())));
@@ -183,7 +184,20 @@ class WindowPrefixSortBenchmark : public HiveConnectorTestBase {
 
   std::shared_ptr<exec::Task> makeTask(
       core::PlanFragment plan,
-      bool prefixSort) {
+      bool prefixSort,
+      bool radixSort) {
+    if (prefixSort && !radixSort) {
+      const std::unordered_map<std::string, std::string> queryConfigMap(
+          {{core::QueryConfig::kPrefixSortRadixSortMinRows,
+            std::to_string(std::numeric_limits<int32_t>::max())}});
+      return exec::Task::create(
+          "t",
+          std::move(plan),
+          0,
+          core::QueryCtx::create(
+              executor_.get(), core::QueryConfig(queryConfigMap)),
+          Task::ExecutionMode::kSerial);
+    }
     if (prefixSort) {
       return exec::Task::create(
           "t",
@@ -225,6 +239,13 @@ void doPrefixSortRun(
   benchmark->run(key, aggregate, true);
 }
 
+void doPrefixQuickSortRun(
+    uint32_t,
+    const std::string& key,
+    const std::string& aggregate) {
+  benchmark->run(key, aggregate, true, false);
+}
+
 #define AGG_BENCHMARKS(_name_, _key_)              \
   BENCHMARK_NAMED_PARAM(                           \
       doSortRun,                                   \
@@ -320,6 +341,11 @@ BENCHMARK_NAMED_PARAM(doSortRun, count_k_norm, "k_norm", "count(1)");
 BENCHMARK_NAMED_PARAM(doPrefixSortRun, count_k_norm, "k_norm", "count(1)");
 BENCHMARK_NAMED_PARAM(doSortRun, count_k_hash, "k_hash", "count(1)");
 BENCHMARK_NAMED_PARAM(doPrefixSortRun, count_k_hash, "k_hash", "count(1)");
+BENCHMARK_NAMED_PARAM(
+    doPrefixQuickSortRun,
+    count_k_hash,
+    "k_hash",
+    "count(1)");
 BENCHMARK_NAMED_PARAM(
     doSortRun,
     count_k_array_k_hash,
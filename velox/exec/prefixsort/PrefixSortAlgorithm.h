@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -151,6 +153,11 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Within radixSort, ranges with less than kRadixSortMinRange entries are
+  // sorted with quick-sort, as counting the key bytes of a small range costs
+  // more than comparing its entries.
+  static const int kRadixSortMinRange = 256;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +166,91 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts prefix data in range [start, end) with an in-place most significant
+  /// digit radix sort (American flag sort) on the first 'numKeyBytes' key
+  /// bytes of each entry. 'keyByte(entry, i)' returns the i-th key byte of
+  /// 'entry' as uint8_t. Ordering entries by their key bytes must be
+  /// consistent with 'compare'. Ranges of entries with equal key bytes and
+  /// small ranges are sorted with quickSort using 'compare', which also breaks
+  /// the ties on the keys that are not in the key bytes.
+  template <typename TKeyByte, typename TCompare>
+  void radixSort(
+      char* start,
+      char* end,
+      uint32_t numKeyBytes,
+      TKeyByte keyByte,
+      TCompare compare) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    struct Range {
+      char* start;
+      char* end;
+      uint32_t byteIndex;
+    };
+    // The ranges left to sort. Sorting the ranges one by one instead of
+    // recursively keeps one set of counts regardless of the number of key
+    // bytes.
+    std::vector<Range> ranges;
+    ranges.push_back({start, end, 0});
+    std::array<uint64_t, 256> counts;
+    std::array<char*, 256> heads;
+    std::array<char*, 256> tails;
+    while (!ranges.empty()) {
+      auto range = ranges.back();
+      ranges.pop_back();
+      const uint64_t numEntries = (range.end - range.start) / entrySize_;
+      if (numEntries < kRadixSortMinRange) {
+        quickSort(range.start, range.end, compare);
+        continue;
+      }
+
+      // Skips the key bytes that are the same in all the entries of the range.
+      for (; range.byteIndex < numKeyBytes; ++range.byteIndex) {
+        counts.fill(0);
+        for (auto* entry = range.start; entry < range.end;
+             entry += entrySize_) {
+          ++counts[keyByte(entry, range.byteIndex)];
+        }
+        if (counts[keyByte(range.start, range.byteIndex)] != numEntries) {
+          break;
+        }
+      }
+      if (range.byteIndex == numKeyBytes) {
+        quickSort(range.start, range.end, compare);
+        continue;
+      }
+
+      // Moves each entry to the bucket of its key byte.
+      auto* bucketStart = range.start;
+      for (auto i = 0; i < counts.size(); ++i) {
+        heads[i] = bucketStart;
+        bucketStart += counts[i] * entrySize_;
+        tails[i] = bucketStart;
+      }
+      for (auto i = 0; i < counts.size(); ++i) {
+        while (heads[i] < tails[i]) {
+          const uint8_t byte = keyByte(heads[i], range.byteIndex);
+          if (byte == i) {
+            heads[i] += entrySize_;
+          } else {
+            swap(
+                detail::PrefixSortIterator(heads[i], entrySize_),
+                detail::PrefixSortIterator(heads[byte], entrySize_));
+            heads[byte] += entrySize_;
+          }
+        }
+      }
+
+      for (auto i = 0; i < counts.size(); ++i) {
+        if (counts[i] > 1) {
+          ranges.push_back(
+              {tails[i] - counts[i] * entrySize_,
+               tails[i],
+               range.byteIndex + 1});
+        }
+      }
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
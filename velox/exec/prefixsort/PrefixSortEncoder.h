@@ -16,6 +16,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
 #include "velox/common/base/SimdUtil.h"
 #include "velox/type/Timestamp.h"
@@ -38,8 +39,6 @@ class PrefixSortEncoder {
   ///    -If value is null, we set the remaining sizeof(T) bytes to '0', they
   ///     do not affect the comparison results at all.
   ///    -If value is not null, the result is set by calling encodeNoNulls.
-  ///
-  /// TODO: add support for strings.
   template <typename T>
   FOLLY_ALWAYS_INLINE void encode(std::optional<T> value, char* dest) const {
     if (value.has_value()) {
@@ -51,6 +50,33 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encode the leading bytes of a string (VARCHAR or VARBINARY) into
+  /// 1 + 'prefixLength' bytes. The first byte is the null byte as above. The
+  /// remaining bytes are the first 'prefixLength' bytes of the value padded
+  /// with '0', inverted for descending order. The bytes compare as unsigned
+  /// like StringView::compare(), but strings longer than 'prefixLength' or
+  /// ending with '0' bytes may have equal encodings. The caller must break
+  /// ties on the encoding by comparing the full values.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t prefixLength) const {
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength);
+      return;
+    }
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = std::min<uint32_t>(value->size(), prefixLength);
+    std::memcpy(dest + 1, value->data(), size);
+    simd::memset(dest + 1 + size, 0, prefixLength - size);
+    if (!ascending_) {
+      for (auto i = 1; i <= prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, int16_t, uint16_t, float, double, Timestamp.
   template <typename T>
@@ -65,7 +91,8 @@ class PrefixSortEncoder {
   }
 
   /// @return For supported types, returns the encoded size, assume nullable.
-  ///         For not supported types, returns 'std::nullopt'.
+  ///         For not supported types, returns 'std::nullopt'. Strings are
+  ///         not included as their encoded size depends on the prefix length.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
       TypeKind typeKind) {
     // NOTE: one byte is reserved for nullable comparison.
@@ -266,6 +266,52 @@ class PrefixEncoderTest : public testing::Test,
     test(descNullsLastEncoder_);
   };
 
+  void testEncodeString() {
+    constexpr uint32_t kPrefixLength = 4;
+    auto encode = [&](const PrefixSortEncoder& encoder,
+                      std::optional<StringView> value) {
+      std::string encoded(kPrefixLength + 1, 'x');
+      encoder.encode(value, encoded.data(), kPrefixLength);
+      return encoded;
+    };
+
+    ASSERT_EQ(
+        encode(ascNullsFirstEncoder_, StringView("ab")),
+        std::string("\1ab\0\0", 5));
+    ASSERT_EQ(
+        encode(ascNullsLastEncoder_, StringView("abcdef")),
+        std::string("\0abcd", 5));
+    ASSERT_EQ(
+        encode(descNullsFirstEncoder_, StringView("ab")),
+        std::string("\1\x9e\x9d\xff\xff", 5));
+    ASSERT_EQ(
+        encode(ascNullsFirstEncoder_, std::nullopt), std::string(5, '\0'));
+    ASSERT_EQ(
+        encode(ascNullsLastEncoder_, std::nullopt),
+        std::string("\1\0\0\0\0", 5));
+
+    // The encoding keeps the order of the prefixes as unsigned bytes.
+    const std::vector<std::string> values = {
+        "", "a", "ab", "abc", "abd", "b", "\x7f", "\x80", "\xff"};
+    for (auto i = 1; i < values.size(); ++i) {
+      const StringView left(values[i - 1]);
+      const StringView right(values[i]);
+      ASSERT_LT(
+          encode(ascNullsFirstEncoder_, left),
+          encode(ascNullsFirstEncoder_, right))
+          << i;
+      ASSERT_GT(
+          encode(descNullsFirstEncoder_, left),
+          encode(descNullsFirstEncoder_, right))
+          << i;
+    }
+
+    // Strings with a common prefix have equal encodings.
+    ASSERT_EQ(
+        encode(ascNullsFirstEncoder_, StringView("abcdx")),
+        encode(ascNullsFirstEncoder_, StringView("abcdy")));
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -360,6 +406,10 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<Timestamp>();
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  testEncodeString();
+}
+
 TEST_F(PrefixEncoderTest, fuzzySmallInt) {
   testFuzz<TypeKind::SMALLINT>();
 }
@@ -55,6 +55,41 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  void testRadixSort(size_t size, uint64_t maxValue) {
+    SCOPED_TRACE(fmt::format("size: {}, maxValue: {}", size, maxValue));
+    // Data1 will be sorted by radixSort.
+    std::vector<int64_t> data1(size);
+    std::generate(data1.begin(), data1.end(), [&]() {
+      return folly::Random::rand64() % maxValue;
+    });
+
+    // Data2 will be sorted by std::sort.
+    std::vector<int64_t> data2 = data1;
+
+    // Sort data1 with radix-sort. The encoded values are compared by memcmp,
+    // so the key bytes are in memory order.
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(int64_t) * data1.size();
+      uint32_t entrySize = sizeof(int64_t);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      encodeInPlace(data1);
+      sortRunner.radixSort(
+          start,
+          end,
+          sizeof(int64_t),
+          [](char* entry, uint32_t index) {
+            return static_cast<uint8_t>(entry[index]);
+          },
+          [&](char* a, char* b) { return memcmp(a, b, 8); });
+    }
+
+    std::sort(data2.begin(), data2.end());
+    decodeInPlace(data1);
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +105,17 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  const auto kMax = std::numeric_limits<uint64_t>::max();
+  testRadixSort(0, kMax);
+  testRadixSort(PrefixSortRunner::kRadixSortMinRange - 1, kMax);
+  testRadixSort(PrefixSortRunner::kRadixSortMinRange, kMax);
+  testRadixSort(100'000, kMax);
+  // Many duplicates and leading key bytes that are the same for all values.
+  testRadixSort(100'000, 10);
+  testRadixSort(100'000, 100'000);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
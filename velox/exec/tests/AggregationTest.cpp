@@ -808,6 +808,47 @@ TEST_F(AggregationTest, rangeToDistinct) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, arrayModeGroupIds) {
+  // Few groups in array mode. sum, count, min and max accumulate by group id
+  // when there are fewer groups than rows.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return row * (i + 1) - 3'000; },
+            nullEvery(7)),
+        makeFlatVector<double>(1'000, [&](auto row) { return row * 0.5; }),
+        // The number of groups grows to more than the rows of a batch.
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (row + i * 1'000) % 2'500; }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  for (const auto& key : {"c0", "c3"}) {
+    SCOPED_TRACE(key);
+    auto op = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation(
+                      {key},
+                      {"sum(c1)",
+                       "sum(c2)",
+                       "count(c1)",
+                       "count(1)",
+                       "min(c1)",
+                       "max(c2)"})
+                  .planNode();
+    assertQuery(
+        op,
+        fmt::format(
+            "SELECT {0}, sum(c1), sum(c2), count(c1), count(1), min(c1), "
+            "max(c2) FROM tmp GROUP BY {0}",
+            key));
+  }
+}
+
 TEST_F(AggregationTest, allKeyTypes) {
   // Covers different key types. Unlike the integer/string tests, the
   // hash table begins life in the generic mode, not array or
@@ -959,6 +1000,225 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationHotKeys) {
+  // The 1st batch has only distinct keys and triggers abandoning partial
+  // aggregation. In the next batches 90% of the rows have one of 5 hot keys
+  // and the rest have distinct keys.
+  std::vector<RowVectorPtr> vectors;
+  vectors.push_back(makeRowVector(
+      {makeFlatVector<int64_t>(200, [](auto row) { return 1'000'000 + row; }),
+       makeFlatVector<int64_t>(200, [](auto row) { return row; })}));
+  const int32_t kNumSkewedBatches = 10;
+  for (auto i = 0; i < kNumSkewedBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000,
+             [&](auto row) {
+               return row % 10 < 9 ? row % 5 : 1'000 + i * 100 + row / 10;
+             }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const bool hotKeys : {false, true}) {
+    SCOPED_TRACE(fmt::format("hotKeys: {}", hotKeys));
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 100)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(
+                QueryConfig::kAbandonPartialAggregationMaxHotKeys,
+                hotKeys ? 10 : 0)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+    auto runtimeStats =
+        toPlanStats(task->taskStats()).at(partialAggId).customStats;
+    EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregation").sum);
+    if (!hotKeys) {
+      EXPECT_EQ(0, runtimeStats.count("partialAggregationHotKeys"));
+      continue;
+    }
+    // The 1st batch after abandoning is sampled for finding the hot keys.
+    EXPECT_EQ(5, runtimeStats.at("partialAggregationHotKeys").sum);
+    EXPECT_EQ(
+        (kNumSkewedBatches - 1) * 900,
+        runtimeStats.at("partialAggregationHotKeyRows").sum);
+    EXPECT_EQ(
+        1'000 + (kNumSkewedBatches - 1) * 100,
+        runtimeStats.at("partialAggregationColdKeyRows").sum);
+  }
+}
+
+TEST_F(AggregationTest, partialAggregationHotKeysMixedAggregates) {
+  // Mixes aggregates with and without toIntermediate() support, so that the
+  // input with cold keys is converted through the intermediate row container
+  // while the hot keys are aggregated in the kept hash table.
+  std::vector<RowVectorPtr> vectors;
+  vectors.push_back(makeRowVector(
+      {makeFlatVector<int64_t>(200, [](auto row) { return 1'000'000 + row; }),
+       makeFlatVector<int64_t>(200, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           200, [](auto row) { return fmt::format("{}", row); })}));
+  const int32_t kNumSkewedBatches = 10;
+  for (auto i = 0; i < kNumSkewedBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000,
+             [&](auto row) {
+               return row % 10 < 9 ? row % 5 : 1'000 + i * 100 + row / 10;
+             }),
+         makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; }),
+         makeFlatVector<std::string>(1'000, [&](auto row) {
+           return fmt::format("longer than inline {}", (row + i) % 77);
+         })}));
+  }
+
+  const std::vector<std::string> aggregates = {
+      "min(c1)",
+      "max(c2)",
+      "avg(c1)",
+      "approx_distinct(c2)",
+      "sumnonpod(1)",
+      "sum(c1)"};
+  core::PlanNodeId partialAggId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, aggregates)
+                  .capturePlanNodeId(partialAggId)
+                  .finalAggregation()
+                  .planNode();
+  // The expected results are produced without abandoning partial aggregation.
+  auto expected =
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'000'000)
+          .copyResults(pool());
+
+  NonPODInt64::clearStats();
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kAbandonPartialAggregationMinRows, 100)
+          .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+          .config(QueryConfig::kAbandonPartialAggregationMaxHotKeys, 10)
+          .config("max_drivers_per_task", 1)
+          .assertResults(expected);
+  auto runtimeStats =
+      toPlanStats(task->taskStats()).at(partialAggId).customStats;
+  EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregation").sum);
+  EXPECT_EQ(5, runtimeStats.at("partialAggregationHotKeys").sum);
+  EXPECT_LT(0, runtimeStats.at("partialAggregationHotKeyRows").sum);
+  EXPECT_EQ(NonPODInt64::constructed, NonPODInt64::destructed);
+}
+
+TEST_F(AggregationTest, approxAggregationMaxGroups) {
+  constexpr int32_t kNumBatches = 10;
+  constexpr int32_t kNumKeys = 50;
+  constexpr int32_t kMaxGroups = 10;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [](auto row) { return row % kNumKeys; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                  .capturePlanNodeId(aggId)
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config("max_drivers_per_task", 1)
+                  .assertResults("SELECT c0, sum(c1), count(1) FROM tmp "
+                                 "GROUP BY c0");
+  EXPECT_EQ(
+      0,
+      toPlanStats(task->taskStats())
+          .at(aggId)
+          .customStats.count("approxAggregationDroppedRows"));
+
+  auto result =
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kApproxAggregationMaxGroups, kMaxGroups)
+          .config("max_drivers_per_task", 1)
+          .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), kMaxGroups);
+
+  // The groups in the result are exact. Key k has the rows k + 50 * j of each
+  // batch for j in [0, 20).
+  constexpr int64_t kRowsPerKey = kNumBatches * 1'000 / kNumKeys;
+  auto keys = result->childAt(0)->asFlatVector<int64_t>();
+  auto sums = result->childAt(1)->asFlatVector<int64_t>();
+  auto counts = result->childAt(2)->asFlatVector<int64_t>();
+  for (auto i = 0; i < result->size(); ++i) {
+    const auto key = keys->valueAt(i);
+    EXPECT_EQ(counts->valueAt(i), kRowsPerKey);
+    EXPECT_EQ(
+        sums->valueAt(i),
+        kNumBatches * (kRowsPerKey / kNumBatches * key + kNumKeys * 190));
+  }
+
+  auto runtimeStats = toPlanStats(task->taskStats()).at(aggId).customStats;
+  EXPECT_EQ(
+      (kNumKeys - kMaxGroups) * kRowsPerKey,
+      runtimeStats.at("approxAggregationDroppedRows").sum);
+  // Fewer keys are dropped than the summary tracks, so the bound is exact.
+  EXPECT_EQ(
+      kRowsPerKey, runtimeStats.at("approxAggregationMaxDroppedGroupRows").sum);
+}
+
+TEST_F(AggregationTest, finalAggregationMergeAcrossDrivers) {
+  const int32_t kNumGroups = 97;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return (i * 1'000 + row) % kNumGroups; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  // Each driver reads all the values. The final aggregation is in the same
+  // pipeline as the partial aggregation, so its input is not partitioned on
+  // the grouping keys.
+  const int32_t kNumDrivers = 4;
+  core::PlanNodeId finalAggId;
+  auto plan = PlanBuilder()
+                  .values(vectors, true)
+                  .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                  .finalAggregation()
+                  .capturePlanNodeId(finalAggId)
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kFinalAggregationMergeAcrossDrivers, true)
+          .maxDrivers(kNumDrivers)
+          .assertResults(
+              "SELECT c0, sum(c1) * 4, count(1) * 4 FROM tmp GROUP BY c0");
+  auto runtimeStats =
+      toPlanStats(task->taskStats()).at(finalAggId).customStats;
+  // Every driver has all the groups and passes them to the drivers of their
+  // partitions.
+  EXPECT_EQ(
+      kNumDrivers * kNumGroups,
+      runtimeStats.at("mergedAcrossDriversRows").sum);
+
+  // Without the merge every driver produces its own partial groups.
+  auto result = AssertQueryBuilder(plan).maxDrivers(kNumDrivers).copyResults(
+      pool());
+  EXPECT_EQ(kNumDrivers * kNumGroups, result->size());
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1388,6 +1648,97 @@ TEST_F(AggregationTest, groupingSetsOutput) {
   assertEqualResults(orderResult.second, reversedOrderResult.second);
 }
 
+TEST_F(AggregationTest, groupingSetsPreAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 11; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row; }, nullEvery(7)),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  auto test = [&](const std::vector<std::vector<std::string>>& groupingSets,
+                  const std::string& duckDbGroupBy,
+                  bool partial) {
+    SCOPED_TRACE(duckDbGroupBy);
+    core::PlanNodeId groupIdNodeId;
+    PlanBuilder builder;
+    builder.values({data})
+        .groupId({"k1", "k2"}, groupingSets, {"a", "b"})
+        .capturePlanNodeId(groupIdNodeId);
+    const std::vector<std::string> aggregates = {
+        "count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"};
+    if (partial) {
+      builder.partialAggregation({"k1", "k2", "group_id"}, aggregates)
+          .finalAggregation();
+    } else {
+      builder.singleAggregation({"k1", "k2", "group_id"}, aggregates);
+    }
+    auto plan =
+        builder.project({"k1", "k2", "count_1", "sum_a", "max_b"}).planNode();
+    const auto sql = fmt::format(
+        "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY {}",
+        duckDbGroupBy);
+
+    for (bool enabled : {false, true}) {
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(
+                  QueryConfig::kGroupingSetsPreAggregationEnabled, enabled)
+              .assertResults(sql);
+      const auto groupIdInputRows =
+          toPlanStats(task->taskStats()).at(groupIdNodeId).inputRows;
+      if (enabled) {
+        EXPECT_LT(groupIdInputRows, size);
+      } else {
+        EXPECT_EQ(groupIdInputRows, size);
+      }
+    }
+  };
+
+  for (bool partial : {false, true}) {
+    test({{"k1", "k2"}, {"k1"}, {"k2"}, {}}, "CUBE (k1, k2)", partial);
+    test({{"k1", "k2"}, {"k1"}, {}}, "ROLLUP (k1, k2)", partial);
+    test({{"k1"}, {"k2"}}, "GROUPING SETS ((k1), (k2))", partial);
+  }
+
+  // Masks are computed by a projection over the group id. The input is
+  // replicated.
+  core::PlanNodeId groupIdNodeId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a", "b"})
+                  .capturePlanNodeId(groupIdNodeId)
+                  .project(
+                      {"k1",
+                       "k2",
+                       "group_id",
+                       "a",
+                       "b",
+                       "group_id = 0 as mask_a"})
+                  .singleAggregation(
+                      {"k1", "k2", "group_id"},
+                      {"count(1) as count_1", "sum(a) as sum_a"},
+                      {"", "mask_a"})
+                  .project({"k1", "k2", "count_1", "sum_a"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kGroupingSetsPreAggregationEnabled, true)
+          .assertResults(
+              "SELECT k1, null, count(1), sum(a) FROM tmp GROUP BY k1 "
+              "UNION ALL "
+              "SELECT null, k2, count(1), null FROM tmp GROUP BY k2");
+  EXPECT_EQ(toPlanStats(task->taskStats()).at(groupIdNodeId).inputRows, size);
+}
+
 TEST_F(AggregationTest, groupingSetsSameKey) {
   auto data = makeRowVector(
       {"o_key", "o_status"},
@@ -1896,24 +2247,39 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   createDuckDbTable(vectors);
   auto spillDirectory = exec::test::TempDirectoryPath::create();
   core::PlanNodeId aggrNodeId;
-  TestScopedSpillInjection scopedSpillInjection(100);
-  auto task =
-      AssertQueryBuilder(duckDbQueryRunner_)
-          .spillDirectory(spillDirectory->getPath())
-          .config(QueryConfig::kSpillEnabled, true)
-          .config(QueryConfig::kAggregationSpillEnabled, true)
-          .plan(PlanBuilder()
-                    .values(vectors)
-                    .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
-                    .capturePlanNodeId(aggrNodeId)
-                    .planNode())
-          .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
-  const auto& queryConfig = task->queryCtx()->queryConfig();
-  ASSERT_TRUE(queryConfig.spillEnabled());
-  ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
-  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+
+  auto testPlan = [&](const std::vector<std::string>& aggregates,
+                      const std::string& sql) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .project({"c1 % 7 AS k", "c0", "c1", "c6"})
+                              .singleAggregation({"k"}, aggregates, {})
+                              .capturePlanNodeId(aggrNodeId)
+                              .planNode())
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    checkSpillStats(taskStats.at(aggrNodeId), true);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  testPlan(
+      {"count(DISTINCT c0)"},
+      "SELECT c1 % 7, count(DISTINCT c0) FROM tmp GROUP BY 1");
+  testPlan(
+      {"count(DISTINCT c6)", "sum(c0)", "sum(DISTINCT c1)"},
+      "SELECT c1 % 7, count(DISTINCT c6), sum(c0), sum(DISTINCT c1) "
+      "FROM tmp GROUP BY 1");
+  testPlan(
+      {"array_agg(c1 ORDER BY c1)", "count(DISTINCT c0)"},
+      "SELECT c1 % 7, array_agg(c1 ORDER BY c1), count(DISTINCT c0) "
+      "FROM tmp GROUP BY 1");
 }
 
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
@@ -2215,6 +2581,89 @@ DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringInputProcessing) {
   ASSERT_EQ(reclaimerStats_, memory::MemoryReclaimer::Stats{});
 }
 
+DEBUG_ONLY_TEST_F(AggregationTest, incrementalReclaimDuringInputProcessing) {
+  constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
+  auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
+  const int numBatches = 10;
+  auto batches = makeVectors(rowType, 1000, numBatches);
+  const auto plan = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation({"c0", "c1"}, {"array_agg(c2)"})
+                        .planNode();
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto queryCtx = core::QueryCtx::create(executor_.get());
+  queryCtx->testingOverrideMemoryPool(memory::memoryManager()->addRootPool(
+      queryCtx->queryId(), kMaxBytes, memory::MemoryReclaimer::create()));
+  auto expectedResult = AssertQueryBuilder(plan)
+                            .queryCtx(queryCtx)
+                            .copyResults(pool_.get());
+
+  folly::EventCount driverWait;
+  std::atomic_bool driverWaitFlag{true};
+  folly::EventCount testWait;
+  std::atomic_bool testWaitFlag{true};
+
+  std::atomic_int numInputs{0};
+  Operator* op{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>(([&](Operator* testOp) {
+        if (testOp->operatorType() != "Aggregation") {
+          return;
+        }
+        op = testOp;
+        if (++numInputs != 2) {
+          return;
+        }
+        testWaitFlag = false;
+        testWait.notifyAll();
+        driverWait.await([&] { return !driverWaitFlag.load(); });
+      })));
+
+  std::thread taskThread([&]() {
+    AssertQueryBuilder(plan)
+        .queryCtx(queryCtx)
+        .spillDirectory(tempDirectory->getPath())
+        .config(QueryConfig::kSpillEnabled, true)
+        .config(QueryConfig::kAggregationSpillEnabled, true)
+        .config(QueryConfig::kAggregationIncrementalSpillEnabled, true)
+        .maxDrivers(1)
+        .assertResults(expectedResult);
+  });
+
+  testWait.await([&]() { return !testWaitFlag.load(); });
+  ASSERT_TRUE(op != nullptr);
+  auto task = op->testingOperatorCtx()->task();
+  auto taskPauseWait = task->requestPause();
+  driverWaitFlag = false;
+  driverWait.notifyAll();
+  taskPauseWait.wait();
+
+  {
+    auto arbitrationStructs =
+        memory::test::ArbitrationTestStructs::createArbitrationTestStructs(
+            op->pool()->shared_from_this());
+    memory::ScopedMemoryArbitrationContext ctx(
+        op->pool(), arbitrationStructs.operation.get());
+    // A small target spills only the largest partition.
+    op->reclaim(1, reclaimerStats_);
+  }
+  // The groups of the other partitions stay in memory.
+  ASSERT_GT(op->pool()->usedBytes(), 0);
+  reclaimerStats_.reset();
+
+  Task::resume(task);
+  taskThread.join();
+
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+  ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 1);
+  ASSERT_EQ(
+      stats[0].operatorStats[1].runtimeStats["incrementalSpills"].sum, 1);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringReserve) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -202,6 +202,44 @@ TEST_F(ArrowStreamTest, basic) {
   assertQuery(plan, "SELECT * FROM tmp");
 }
 
+TEST_F(ArrowStreamTest, prefetch) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             size, [&](auto row) { return size * i + row; }, nullEvery(5)),
+         makeFlatVector<StringView>(
+             size,
+             [](auto row) {
+               return StringView::makeInline(std::to_string(row % 100));
+             },
+             nullEvery(7))}));
+  }
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+  struct ArrowArrayStream arrowStream;
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type), &arrowStream);
+  auto plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kArrowStreamPrefetch, "true")
+      .assertResults("SELECT * FROM tmp");
+
+  // A get_next error on the executor is reported by the operator.
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type, true, false),
+      &arrowStream);
+  plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kArrowStreamPrefetch, "true")
+          .copyResults(pool_.get()),
+      "Failed to call get_next on ArrowStream: get_next failed.");
+}
+
 TEST_F(ArrowStreamTest, error) {
   vector_size_t size = 1'000;
   std::vector<RowVectorPtr> vectors;
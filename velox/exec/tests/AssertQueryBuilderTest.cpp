@@ -47,6 +47,15 @@ TEST_F(AssertQueryBuilderTest, serialExecution) {
   AssertQueryBuilder(plan).serialExecution(true).assertResults(data);
 }
 
+TEST_F(AssertQueryBuilderTest, countResults) {
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  auto plan = PlanBuilder().values({data}, false, 10).planNode();
+
+  std::shared_ptr<Task> task;
+  ASSERT_EQ(AssertQueryBuilder(plan).countResults(task), 30);
+  ASSERT_EQ(task->state(), TaskState::kFinished);
+}
+
 TEST_F(AssertQueryBuilderTest, orderedResults) {
   auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/CompiledKeyComparator.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class CompiledKeyComparatorTest : public testing::Test,
+                                  public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Stores 'data' in a new container with the columns of 'data' as keys.
+  std::unique_ptr<RowContainer> makeContainer(
+      const RowVectorPtr& data,
+      bool nullableKeys,
+      std::vector<char*>& rows) {
+    auto container = std::make_unique<RowContainer>(
+        asRowType(data->type())->children(),
+        nullableKeys,
+        std::vector<Accumulator>{},
+        std::vector<TypePtr>{},
+        false,
+        false,
+        false,
+        false,
+        pool());
+    rows.resize(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      rows[i] = container->newRow();
+    }
+    SelectivityVector allRows(data->size());
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column), allRows);
+      for (auto i = 0; i < data->size(); ++i) {
+        container->store(decoded, i, rows[i], column);
+      }
+    }
+    return container;
+  }
+
+  // Checks that the compiled comparisons of all pairs of rows and of the
+  // rows against 'data' match RowContainer::compare() and equals().
+  void testComparisons(const RowVectorPtr& data, bool nullableKeys) {
+    SCOPED_TRACE(fmt::format("nullableKeys: {}", nullableKeys));
+    std::vector<char*> rows;
+    auto container = makeContainer(data, nullableKeys, rows);
+    const auto numKeys = data->childrenSize();
+    std::vector<CompareFlags> flags;
+    for (auto i = 0; i < numKeys; ++i) {
+      flags.push_back({i % 2 == 0, i % 3 == 0});
+    }
+    const auto comparator =
+        CompiledKeyComparator::forKeys(container.get(), flags);
+    const auto defaultComparator =
+        CompiledKeyComparator::forKeys(container.get());
+
+    SelectivityVector allRows(data->size());
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < numKeys; ++i) {
+      hashers.push_back(VectorHasher::create(data->childAt(i)->type(), i));
+      hashers.back()->decode(*data->childAt(i), allRows);
+    }
+
+    for (auto i = 0; i < rows.size(); ++i) {
+      for (auto j = 0; j < rows.size(); ++j) {
+        int32_t expected = 0;
+        bool expectedEquals = true;
+        bool expectedDecodedEquals = true;
+        for (auto key = 0; key < numKeys; ++key) {
+          if (expected == 0) {
+            expected = container->compare(rows[i], rows[j], key, flags[key]);
+          }
+          expectedEquals &= container->compare(
+                                rows[i], rows[j], key, CompareFlags()) == 0;
+          expectedDecodedEquals &= container->equals<true>(
+              rows[i],
+              container->columnAt(key),
+              hashers[key]->decodedVector(),
+              j);
+        }
+        ASSERT_EQ(expected, comparator.compare(rows[i], rows[j]))
+            << i << " " << j;
+        ASSERT_EQ(expectedEquals, comparator.equals(rows[i], rows[j]))
+            << i << " " << j;
+        ASSERT_EQ(
+            expectedEquals,
+            defaultComparator.compare(rows[i], rows[j]) == 0)
+            << i << " " << j;
+        ASSERT_EQ(
+            expectedDecodedEquals,
+            comparator.equals<true>(rows[i], hashers, j))
+            << i << " " << j;
+      }
+    }
+  }
+};
+
+TEST_F(CompiledKeyComparatorTest, fixedWidthKeys) {
+  // Adjacent fixed-width keys are compared as one run for equality. The
+  // DOUBLE key splits the runs.
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {1, 1, 2, std::nullopt, 0, 1, std::nullopt, 2}),
+      makeNullableFlatVector<int32_t>(
+          {10, 10, 20, 0, std::nullopt, 10, std::nullopt, 20}, DATE()),
+      makeNullableFlatVector<bool>(
+          {true, true, false, true, false, std::nullopt, std::nullopt, false}),
+      makeNullableFlatVector<double>(
+          {0.0, -0.0, std::nan(""), 1.5, std::nan(""), 0.0, 1.5, std::nan("")}),
+      makeNullableFlatVector<Timestamp>(
+          {Timestamp(1, 2),
+           Timestamp(1, 2),
+           Timestamp(1, 3),
+           std::nullopt,
+           Timestamp(0, 0),
+           Timestamp(1, 2),
+           std::nullopt,
+           Timestamp(1, 3)}),
+  });
+  testComparisons(data, true);
+}
+
+TEST_F(CompiledKeyComparatorTest, mixedKeys) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 1, 2, 2, 1, 3}),
+      makeFlatVector<std::string>(
+          {"a",
+           "a",
+           "a long string that is not inlined",
+           "a long string that is not inlined",
+           "b",
+           ""}),
+      makeFlatVector<int32_t>({5, 5, 6, 6, 5, 7}, DATE()),
+      makeArrayVector<int32_t>({{1, 2}, {1, 2}, {}, {}, {3}, {1}}),
+  });
+  testComparisons(data, false);
+  testComparisons(data, true);
+
+  auto nullableData = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, 1, std::nullopt, 2, std::nullopt}),
+      makeNullableFlatVector<std::string>(
+          {"a", "a", std::nullopt, std::nullopt, "b"}),
+      makeNullableFlatVector<int32_t>({5, 5, 6, std::nullopt, 5}, DATE()),
+  });
+  testComparisons(nullableData, true);
+}
+
+TEST_F(CompiledKeyComparatorTest, subsetOfColumns) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeFlatVector<int64_t>({1, 1, 2, 2}),
+      makeFlatVector<std::string>({"x", "y", "x", "y"}),
+  });
+  std::vector<char*> rows;
+  auto container = makeContainer(data, false, rows);
+  CompiledKeyComparator comparator(
+      container.get(), {2, 1}, {CompareFlags{true, false}, CompareFlags()});
+  // Sorts by column 2 descending, then column 1 ascending.
+  EXPECT_LT(comparator.compare(rows[1], rows[0]), 0);
+  EXPECT_LT(comparator.compare(rows[0], rows[2]), 0);
+  EXPECT_TRUE(comparator.equals(rows[1], rows[1]));
+  EXPECT_FALSE(comparator.equals(rows[0], rows[1]));
+}
+
+} // namespace
+} // namespace facebook::velox::exec
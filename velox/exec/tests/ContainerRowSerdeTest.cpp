@@ -607,6 +607,67 @@ TEST_F(ContainerRowSerdeTest, fuzzCompare) {
   }
 }
 
+TEST_F(ContainerRowSerdeTest, fixedWidthElements) {
+  // Flat arrays of fixed width elements are serialized, deserialized, compared
+  // and hashed with loops for the element type. Checks these against the
+  // same elements wrapped in a dictionary, which take the per element path.
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.2;
+  VectorFuzzer fuzzer(opts, pool_.get());
+
+  const std::vector<vector_size_t> offsets{0, 3, 10, 10, 25, 40, 41, 60, 80};
+  const CompareFlags flags{
+      true, // nullsFirst
+      true, // ascending
+      false, // equalsOnly
+      CompareFlags::NullHandlingMode::kNullAsValue};
+  auto sign = [](int32_t value) { return value > 0 ? 1 : value < 0 ? -1 : 0; };
+
+  for (const auto& type : {INTEGER(), DOUBLE(), TIMESTAMP(), HUGEINT()}) {
+    SCOPED_TRACE(type->toString());
+    auto elements = fuzzer.fuzzFlat(type);
+    auto flat = makeArrayVector(offsets, elements);
+    auto dictionary = makeArrayVector(
+        offsets,
+        wrapInDictionary(
+            makeIndices(elements->size(), [](auto row) { return row; }),
+            elements));
+    testRoundTrip(flat);
+    testCompare(flat, dictionary);
+    testCompare(dictionary, flat);
+
+    auto positions = serializeWithPositions(flat);
+    DecodedVector decoded(*flat);
+    for (auto i = 0; i < flat->size(); ++i) {
+      for (auto j = 0; j < flat->size(); ++j) {
+        const auto expected =
+            sign(dictionary->compare(dictionary.get(), i, j, flags).value());
+        auto left = HashStringAllocator::prepareRead(positions[i].header);
+        ASSERT_EQ(
+            expected,
+            sign(ContainerRowSerde::compare(*left, decoded, j, flags)))
+            << i << " vs " << j;
+        left = HashStringAllocator::prepareRead(positions[i].header);
+        auto right = HashStringAllocator::prepareRead(positions[j].header);
+        ASSERT_EQ(
+            expected,
+            sign(ContainerRowSerde::compare(
+                *left, *right, flat->type().get(), flags)))
+            << i << " vs " << j;
+      }
+    }
+    allocator_.clear();
+  }
+
+  auto map = makeMapVector(
+      offsets,
+      makeFlatVector<int64_t>(100, [](auto row) { return 100 - row; }),
+      fuzzer.fuzzFlat(DOUBLE()));
+  testRoundTrip(map);
+  testCompare(map);
+}
+
 TEST_F(ContainerRowSerdeTest, nans) {
   // Verify that the NaNs with different representations are considered equal
   // and have the same hash value.
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DecodedVectorCache.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+class DecodedVectorCacheTest : public OperatorTestBase {};
+
+TEST_F(DecodedVectorCacheTest, basic) {
+  DecodedVectorCache cache(2);
+  auto base = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  VectorPtr dictionary = wrapInDictionary(makeIndicesInReverse(100), 100, base);
+  SelectivityVector allRows(100);
+  SelectivityVector someRows(100);
+  someRows.setValidRange(0, 50, false);
+  someRows.updateBounds();
+
+  auto decoded = cache.get(dictionary, allRows);
+  EXPECT_EQ(decoded->base(), base.get());
+  EXPECT_EQ(decoded->valueAt<int64_t>(0), 99);
+  EXPECT_EQ(cache.get(dictionary, allRows), decoded);
+  EXPECT_EQ(cache.numHits(), 1);
+  EXPECT_EQ(cache.numMisses(), 1);
+
+  // Other rows are decoded again.
+  auto otherDecoded = cache.get(dictionary, someRows);
+  EXPECT_NE(otherDecoded, decoded);
+  EXPECT_EQ(otherDecoded->valueAt<int64_t>(99), 0);
+  EXPECT_EQ(cache.numMisses(), 2);
+
+  // The oldest entry is replaced when the cache is full.
+  cache.get(base, allRows);
+  EXPECT_EQ(cache.numMisses(), 3);
+  EXPECT_EQ(cache.get(dictionary, someRows), otherDecoded);
+  EXPECT_NE(cache.get(dictionary, allRows), decoded);
+  EXPECT_EQ(cache.numMisses(), 4);
+
+  cache.clear();
+  cache.get(dictionary, someRows);
+  EXPECT_EQ(cache.numMisses(), 5);
+}
+
+TEST_F(DecodedVectorCacheTest, nulls) {
+  DecodedVectorCache cache;
+  // A dictionary adding nulls over a base with nulls.
+  auto base = makeFlatVector<int64_t>(
+      100, [](auto row) { return row; }, nullEvery(3));
+  VectorPtr dictionary = BaseVector::wrapInDictionary(
+      makeNulls(100, nullEvery(5)), makeIndicesInReverse(100), 100, base);
+  SelectivityVector rows(100);
+
+  // The nulls are computed for all the decoded rows, also if the first
+  // consumer asks for a subset.
+  auto decoded = cache.get(dictionary, rows);
+  SelectivityVector someRows(100, false);
+  someRows.setValidRange(0, 10, true);
+  someRows.updateBounds();
+  decoded->nulls(&someRows);
+  const auto* nulls = cache.get(dictionary, rows)->nulls(&rows);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(bits::isBitNull(nulls, i), dictionary->isNullAt(i)) << i;
+  }
+}
+
+TEST_F(DecodedVectorCacheTest, hashes) {
+  DecodedVectorCache cache(2);
+  VectorPtr data = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  SelectivityVector rows(100);
+  SelectivityVector someRows(100);
+  someRows.setValidRange(0, 50, false);
+  someRows.updateBounds();
+
+  int32_t numComputed = 0;
+  auto compute = [&](raw_vector<uint64_t>& hashes) {
+    ++numComputed;
+    EXPECT_EQ(hashes.size(), 100);
+    for (auto i = 0; i < hashes.size(); ++i) {
+      hashes[i] = i * 7;
+    }
+  };
+
+  EXPECT_EQ(cache.hashes(data, rows, compute)[10], 70);
+  EXPECT_EQ(cache.hashes(data, rows, compute)[20], 140);
+  EXPECT_EQ(numComputed, 1);
+  EXPECT_EQ(cache.numHashHits(), 1);
+  EXPECT_EQ(cache.numHashMisses(), 1);
+
+  // Other rows are hashed again.
+  cache.hashes(data, someRows, compute);
+  EXPECT_EQ(numComputed, 2);
+
+  cache.clear();
+  cache.hashes(data, rows, compute);
+  EXPECT_EQ(numComputed, 3);
+  // The decoded vectors are cached separately.
+  EXPECT_EQ(cache.numMisses(), 0);
+}
+
+TEST_F(DecodedVectorCacheTest, vectorHasher) {
+  DecodedVectorCache cache;
+  VectorPtr data = wrapInDictionary(
+      makeIndicesInReverse(1'000),
+      1'000,
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row % 17; }, nullEvery(7)));
+  SelectivityVector rows(1'000);
+
+  VectorHasher expectedHasher(BIGINT(), 0);
+  expectedHasher.decode(*data, rows);
+  raw_vector<uint64_t> expected(1'000);
+  expectedHasher.hash(rows, false, expected);
+
+  VectorHasher hasher(BIGINT(), 0);
+  VectorHasher otherHasher(BIGINT(), 0);
+  hasher.decode(data, rows, &cache);
+  otherHasher.decode(data, rows, &cache);
+  EXPECT_EQ(cache.numMisses(), 1);
+  EXPECT_EQ(cache.numHits(), 1);
+  EXPECT_EQ(&hasher.decodedVector(), &otherHasher.decodedVector());
+
+  for (auto* testHasher : {&hasher, &otherHasher}) {
+    raw_vector<uint64_t> hashes(1'000);
+    testHasher->hash(rows, false, hashes);
+    for (auto i = 0; i < 1'000; ++i) {
+      ASSERT_EQ(hashes[i], expected[i]) << i;
+    }
+  }
+
+  // Decoding without the cache uses the hasher's own DecodedVector again.
+  hasher.decode(*data, rows);
+  EXPECT_NE(&hasher.decodedVector(), &otherHasher.decodedVector());
+}
+
+TEST_F(DecodedVectorCacheTest, plan) {
+  auto data = makeRowVector({
+      wrapInDictionary(
+          makeIndicesInReverse(1'000),
+          1'000,
+          makeFlatVector<int32_t>(
+              1'000, [](auto row) { return row % 31; }, nullEvery(11))),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data, data});
+
+  // RowNumber passes its input columns through, so the aggregation gets the
+  // same keys.
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .rowNumber({"c0"})
+                  .singleAggregation({"c0"}, {"count(1)", "max(row_number)"})
+                  .planNode();
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kDecodedVectorCacheEnabled, enabled)
+        .assertResults("SELECT c0, count(1), count(1) FROM tmp GROUP BY c0");
+  }
+}
+
+TEST_F(DecodedVectorCacheTest, multipleDistinct) {
+  auto data = makeRowVector({
+      makeFlatVector<StringView>(
+          1'000,
+          [](auto row) {
+            return StringView::makeInline(std::to_string(row % 23));
+          },
+          nullEvery(13)),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 37; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 11; }),
+  });
+  createDuckDbTable({data, data});
+
+  // Each MarkDistinct and the aggregation hash c0. Hash mode is forced so
+  // that the hashes are shared.
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .markDistinct("m1", {"c0", "c1"})
+                  .markDistinct("m2", {"c0", "c2"})
+                  .singleAggregation(
+                      {"c0"}, {"count(c1)", "sum(c2)"}, {"m1", "m2"})
+                  .planNode();
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kDecodedVectorCacheEnabled, enabled)
+        .config(core::QueryConfig::kHashAdaptivityEnabled, false)
+        .assertResults(
+            "SELECT c0, count(DISTINCT c1), sum(DISTINCT c2) FROM tmp "
+            "GROUP BY c0");
+  }
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class DriverSchedulerTest : public OperatorTestBase {};
+
+TEST_F(DriverSchedulerTest, runAll) {
+  constexpr int32_t kNumTasks = 10'000;
+  std::atomic<int32_t> numRuns{0};
+  {
+    WorkStealingDriverScheduler scheduler(4);
+    EXPECT_EQ(scheduler.numWorkers(), 4);
+    for (auto i = 0; i < kNumTasks; ++i) {
+      scheduler.addWithAffinity([&]() { ++numRuns; }, i % 5 - 1);
+    }
+  }
+  // The destructor runs the remaining tasks.
+  EXPECT_EQ(numRuns, kNumTasks);
+  EXPECT_EQ(DriverScheduler::currentWorker(), -1);
+}
+
+TEST_F(DriverSchedulerTest, affinity) {
+  WorkStealingDriverScheduler scheduler(4);
+  for (auto i = 0; i < 10; ++i) {
+    // Waits for all the workers to be idle.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    folly::Baton<> done;
+    int32_t worker{-1};
+    scheduler.addWithAffinity(
+        [&]() {
+          worker = DriverScheduler::currentWorker();
+          done.post();
+        },
+        2);
+    done.wait();
+    EXPECT_EQ(worker, 2);
+  }
+
+  // A task added by a worker goes to the queue of that worker.
+  folly::Baton<> done;
+  int32_t worker{-1};
+  scheduler.addWithAffinity(
+      [&]() {
+        scheduler.add([&]() {
+          worker = DriverScheduler::currentWorker();
+          done.post();
+        });
+      },
+      1);
+  done.wait();
+  EXPECT_EQ(worker, 1);
+  EXPECT_EQ(scheduler.stats().numSteals, 0);
+}
+
+TEST_F(DriverSchedulerTest, steal) {
+  WorkStealingDriverScheduler scheduler(4);
+  folly::Baton<> release;
+  folly::Baton<> started;
+  scheduler.addWithAffinity(
+      [&]() {
+        started.post();
+        release.wait();
+      },
+      0);
+  started.wait();
+
+  // Worker 0 is busy. The tasks preferring it are stolen by the other
+  // workers.
+  constexpr int32_t kNumTasks = 10;
+  std::atomic<int32_t> numRuns{0};
+  std::atomic<int32_t> numRunsOnWorker0{0};
+  for (auto i = 0; i < kNumTasks; ++i) {
+    scheduler.addWithAffinity(
+        [&]() {
+          if (DriverScheduler::currentWorker() == 0) {
+            ++numRunsOnWorker0;
+          }
+          ++numRuns;
+        },
+        0);
+  }
+  while (numRuns < kNumTasks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(numRunsOnWorker0, 0);
+  EXPECT_EQ(scheduler.stats().numSteals, kNumTasks);
+  release.post();
+}
+
+TEST_F(DriverSchedulerTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 97; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .localPartition({"c0"})
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+
+  WorkStealingDriverScheduler scheduler(4);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(core::QueryCtx::create(&scheduler))
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+}
+
+TEST_F(DriverSchedulerTest, multiLevelLevels) {
+  MultiLevelDriverScheduler scheduler(1, {10, 100});
+  EXPECT_EQ(scheduler.numLevels(), 3);
+  EXPECT_EQ(scheduler.levelOf(0), 0);
+  EXPECT_EQ(scheduler.levelOf(9'999'999), 0);
+  EXPECT_EQ(scheduler.levelOf(10'000'000), 1);
+  EXPECT_EQ(scheduler.levelOf(99'999'999), 1);
+  EXPECT_EQ(scheduler.levelOf(100'000'000), 2);
+  EXPECT_EQ(scheduler.levelOf(std::numeric_limits<uint64_t>::max()), 2);
+
+  VELOX_ASSERT_THROW(
+      MultiLevelDriverScheduler(1, {100, 10}),
+      "Level thresholds must be ascending");
+}
+
+TEST_F(DriverSchedulerTest, multiLevelPriority) {
+  MultiLevelDriverScheduler scheduler(1, {10, 100});
+  // Keeps the only worker busy while the tasks are added and then charges
+  // some CPU time to level 2.
+  folly::Baton<> release;
+  folly::Baton<> started;
+  scheduler.addDriver(
+      [&]() {
+        started.post();
+        release.wait();
+        const auto startCpuNanos = process::threadCpuNanos();
+        while (process::threadCpuNanos() - startCpuNanos < 20'000'000) {
+        }
+      },
+      {-1, 1'000'000'000});
+  started.wait();
+
+  std::mutex mutex;
+  std::vector<int32_t> order;
+  auto addTask = [&](int32_t id, uint64_t taskCpuNanos) {
+    DriverScheduler::DriverInfo info;
+    info.taskCpuNanos = taskCpuNanos;
+    scheduler.addDriver(
+        [&, id]() {
+          std::lock_guard<std::mutex> l(mutex);
+          order.push_back(id);
+        },
+        info);
+  };
+  // A long running task at level 2 and an interactive one at level 0.
+  for (auto i = 0; i < 5; ++i) {
+    addTask(100 + i, 1'000'000'000);
+  }
+  for (auto i = 0; i < 5; ++i) {
+    addTask(i, 0);
+  }
+  release.post();
+
+  folly::Baton<> done;
+  addTask(200, 1'000'000'000);
+  scheduler.addDriver([&]() { done.post(); }, {-1, 1'000'000'000});
+  done.wait();
+
+  // The level 0 tasks run first as level 2 has used more than its share. The
+  // long running ones are not starved.
+  ASSERT_EQ(order.size(), 11);
+  for (auto i = 0; i < 5; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+  for (auto i = 0; i < 5; ++i) {
+    EXPECT_EQ(order[5 + i], 100 + i);
+  }
+  EXPECT_EQ(order[10], 200);
+
+  const auto stats = scheduler.stats();
+  EXPECT_EQ(stats.levelNumRuns[0], 5);
+  EXPECT_EQ(stats.levelNumRuns[1], 0);
+  EXPECT_GE(stats.levelNumRuns[2], 7);
+}
+
+TEST_F(DriverSchedulerTest, multiLevelQuery) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 97; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .localPartition({"c0"})
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+
+  MultiLevelDriverScheduler scheduler(4);
+  auto queryCtx = core::QueryCtx::create(&scheduler);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+
+  uint64_t numRuns = 0;
+  for (const auto levelNumRuns : scheduler.stats().levelNumRuns) {
+    numRuns += levelNumRuns;
+  }
+  EXPECT_GT(numRuns, 0);
+}
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/time/Timer.h"
 // #include "velox/exec/Exchange.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
@@ -221,6 +222,10 @@ TEST_P(ExchangeClientTest, stats) {
   ASSERT_GE(totalBytes, stats.at("peakBytes").sum);
   ASSERT_EQ(data.size(), stats.at("numReceivedPages").sum);
   ASSERT_EQ(totalBytes / data.size(), stats.at("averageReceivedPageBytes").sum);
+  ASSERT_GE(stats.at("requestRttNanos").count, 1);
+  ASSERT_GE(
+      stats.at("requestWindowBytes").min,
+      ExchangeClient::kMinRequestWindowBytes);
 
   task->requestCancel();
   bufferManager_->removeTask(taskId);
@@ -275,6 +280,82 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+// Verifies that the data of a source larger than its request window is fetched
+// with multiple requests.
+TEST_P(ExchangeClientTest, requestWindow) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(50'000, [](auto row) { return row; }),
+  });
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+  const auto numPages =
+      2 * ExchangeClient::kInitialRequestWindowBytes / page->size() + 1;
+
+  auto client = std::make_shared<ExchangeClient>(
+      "request.window",
+      17,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      pool(),
+      executor());
+  auto taskId = "local://t1";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+  for (auto i = 0; i < numPages; ++i) {
+    enqueue(taskId, 17, data);
+  }
+  client->addRemoteTaskId(taskId);
+
+  fetchPages(*client, numPages);
+
+  const auto stats = client->stats();
+  EXPECT_EQ(numPages, stats.at("numReceivedPages").sum);
+  EXPECT_GE(stats.at("requestRttNanos").count, 2);
+  EXPECT_LE(
+      stats.at("requestWindowBytes").max,
+      ExchangeClient::kDefaultMaxQueuedBytes);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
+TEST_P(ExchangeClientTest, setMaxQueuedBytes) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+  const int64_t pageSize = page->size();
+  const int numPages = 6;
+
+  // Queues one page at a time.
+  auto client = std::make_shared<ExchangeClient>(
+      "max.queued.bytes", 17, pageSize / 2, pool(), executor());
+  auto taskId = "local://t1";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+  for (auto i = 0; i < numPages; ++i) {
+    enqueue(taskId, 17, data);
+  }
+  client->addRemoteTaskId(taskId);
+  fetchPages(*client, 1);
+
+  // The remaining pages are queued once the limit is raised.
+  client->setMaxQueuedBytes(pageSize * numPages);
+  const auto deadline = getCurrentTimeMs() + 10'000;
+  while (client->queue()->totalBytes() < pageSize * (numPages - 1) &&
+         getCurrentTimeMs() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(client->queue()->totalBytes(), pageSize * (numPages - 1));
+  fetchPages(*client, numPages - 1);
+  EXPECT_EQ(numPages, client->stats().at("numReceivedPages").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
 TEST_P(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -363,3 +364,179 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, filterProjectChainFusion) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c0 % 100 + c1 % 50 AS e1"})
+                  .filter("e1 > 10")
+                  .filter("c0 % 10 < 8")
+                  .project({"c0", "e1", "e1 * 2 AS e2", "c1 % 1000 AS e3"})
+                  .filter("e2 % 7 <> 0")
+                  .project({"c0", "e1 + e2 + e3 AS s"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  const std::string duckDbSql =
+      "SELECT c0, e1 + e1 * 2 + c1 % 1000 FROM "
+      "(SELECT c0, c1, c0 % 100 + c1 % 50 AS e1 FROM tmp) "
+      "WHERE e1 > 10 AND c0 % 10 < 8 AND (e1 * 2) % 7 <> 0";
+
+  for (const bool fusionEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("fusionEnabled: {}", fusionEnabled));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kFilterProjectChainFusionEnabled,
+                        fusionEnabled)
+                    .assertResults(duckDbSql);
+    const auto& operatorStats =
+        task->taskStats().pipelineStats[0].operatorStats;
+    if (fusionEnabled) {
+      // Values and one FilterProject for the whole chain.
+      ASSERT_EQ(operatorStats.size(), 2);
+      ASSERT_EQ(operatorStats[1].planNodeId, projectId);
+    } else {
+      ASSERT_EQ(operatorStats.size(), 5);
+    }
+  }
+
+  // A non-deterministic projection is not inlined into the filter.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "rand() AS r"})
+             .filter("r < 2.0")
+             .project({"c0"})
+             .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(
+                      core::QueryConfig::kFilterProjectChainFusionEnabled, true)
+                  .assertResults("SELECT c0 FROM tmp");
+  ASSERT_EQ(task->taskStats().pipelineStats[0].operatorStats.size(), 3);
+}
+
+TEST_F(FilterProjectTest, crossNodeSubexpressionSharing) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  // 'c0 % 1000 * c1' and 'c0 % 1000 * c1 % 7' are computed by the first
+  // projection and referenced by the filter and the second projection.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c0 % 1000 * c1 % 7 AS a"})
+                  .filter("c0 % 1000 * c1 % 7 > 2")
+                  .limit(0, 1'000'000, false)
+                  .project({"c0 % 1000 * c1 AS m", "c0 % 1000 * c1 % 7 + 1"})
+                  .planNode();
+  for (const bool sharingEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("sharingEnabled: {}", sharingEnabled));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kCrossNodeSubexpressionSharingEnabled,
+            sharingEnabled)
+        .assertResults(
+            "SELECT c0 % 1000 * c1, c0 % 1000 * c1 % 7 + 1 FROM tmp "
+            "WHERE c0 % 1000 * c1 % 7 > 2");
+  }
+
+  // A division guarded by a conditional in the first projection is not moved
+  // there from the second one since it would fail on the rows which the
+  // filter removes.
+  vectors = {makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6}),
+      makeFlatVector<int64_t>({1, 0, 3, 0, 5, 0}),
+  })};
+  createDuckDbTable(vectors);
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "c1", "if(c1 <> 0, c0 / c1, 0) AS q"})
+             .filter("c1 <> 0")
+             .project({"q", "c0 / c1 AS d"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kCrossNodeSubexpressionSharingEnabled, true)
+      .assertResults("SELECT c0 // c1, c0 // c1 FROM tmp WHERE c1 <> 0");
+
+  // Same for a division in the second argument of a function with default
+  // null behavior. 'plus' does not evaluate it on the rows where 'c2' is null,
+  // which are the rows with a zero divisor.
+  vectors = {makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6}),
+      makeFlatVector<int64_t>({1, 0, 3, 0, 5, 0}),
+      makeNullableFlatVector<int64_t>(
+          {1, std::nullopt, 3, std::nullopt, 5, std::nullopt}),
+  })};
+  createDuckDbTable(vectors);
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "c1", "c2 + c0 / c1 AS s"})
+             .filter("c1 <> 0")
+             .project({"s", "c0 / c1 AS d"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kCrossNodeSubexpressionSharingEnabled, true)
+      .assertResults("SELECT c2 + c0 // c1, c0 // c1 FROM tmp WHERE c1 <> 0");
+
+  // A match in the first argument is evaluated on all the rows and is shared.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "c1", "c0 * 2 + c2 AS s"})
+             .filter("c1 <> 0")
+             .project({"s", "c0 * 2 AS d"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kCrossNodeSubexpressionSharingEnabled, true)
+      .assertResults("SELECT c0 * 2 + c2, c0 * 2 FROM tmp WHERE c1 <> 0");
+}
+
+TEST_F(FilterProjectTest, conjunctFilter) {
+  const vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row % 17; }, nullEvery(7)),
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row % 5; }, nullEvery(11)),
+        makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Nulls in a conjunct don't pass.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 > 3 AND c1 < 4 AND c2 % 3 <> 0")
+                  .project({"c0 + c1", "c2"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0 + c1, c2 FROM tmp WHERE c0 > 3 AND c1 < 4 AND c2 % 3 <> 0");
+
+  // An error in a conjunct is cleared if another conjunct is false.
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c2 / c1 > 10 AND c1 <> 0")
+             .planNode();
+  assertQuery(plan, "SELECT * FROM tmp WHERE c1 <> 0 AND c2 // c1 > 10");
+
+  // An error in a passing row throws.
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c2 / c1 > 10 AND c0 >= 0")
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()), "division by zero");
+}
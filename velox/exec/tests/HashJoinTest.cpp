@@ -4835,6 +4835,319 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 10'000;
+  // More distinct build keys than VectorHasher::kMaxDistinct so that no exact
+  // dynamic filter is produced.
+  const int32_t numRowsBuild = 2 * VectorHasher::kMaxDistinct;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Only every 10th probe key is odd and may match the build side.
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) {
+              const int64_t key = (row + i * numRowsProbe) * 2;
+              return row % 10 == 0 ? key + 1 : key;
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // Odd build keys only.
+  std::vector<RowVectorPtr> buildVectors{makeRowVector({
+      makeFlatVector<int64_t>(
+          numRowsBuild, [](auto row) { return row * 2 + 1; }),
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+  })};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType)
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinId)
+                .planNode();
+
+  for (const bool enableBloomFilter : {false, true}) {
+    SCOPED_TRACE(fmt::format("enableBloomFilter: {}", enableBloomFilter));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            enableBloomFilter ? "1048576" : "0")
+        .injectSpill(false)
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          if (!enableBloomFilter) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(numRowsProbe * numSplits, getInputPositions(task, 1));
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          ASSERT_EQ(
+              1,
+              getOperatorRuntimeStats(task, 1, "bloomDynamicFiltersProduced")
+                  .sum);
+          // The join can't be replaced by a Bloom filter.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          // Most non-matching probe rows are pruned in the scan.
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 5);
+          ASSERT_EQ(
+              planStats.at(probeScanId).dynamicFilterStats.producerNodeIds,
+              std::unordered_set<core::PlanNodeId>({joinId}));
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, probeBloomFilter) {
+  // Two keys with wide ranges and many distinct values make a table in hash
+  // mode. 1 in 20 probe rows has a match.
+  constexpr int64_t kMultiplier = 7'919'000'003;
+  constexpr int32_t kNumBuildRows = 120'000;
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0", "u_c1", "u_c2"},
+      {
+          makeFlatVector<int64_t>(
+              kNumBuildRows, [](auto row) { return row * kMultiplier; }),
+          makeFlatVector<int64_t>(
+              kNumBuildRows, [](auto row) { return -row * kMultiplier; }),
+          makeFlatVector<int64_t>(kNumBuildRows, [](auto row) { return row; }),
+      })};
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 30; ++i) {
+    probeVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              const int64_t n = i * 1'000 + row;
+              return n % 20 == 0 ? n / 20 * kMultiplier : n * kMultiplier + 1;
+            }),
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              const int64_t n = i * 1'000 + row;
+              return n % 20 == 0 ? -n / 20 * kMultiplier : n;
+            }),
+    }));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"c0", "c1"},
+                      {"u_c0", "u_c1"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"c0", "c1", "u_c2"},
+                      core::JoinType::kInner)
+                  .planNode();
+
+  for (const auto maxMatchPct : {0, 4, 10}) {
+    SCOPED_TRACE(fmt::format("maxMatchPct: {}", maxMatchPct));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(1)
+        .planNode(plan)
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterMaxMatchPct,
+            std::to_string(maxMatchPct))
+        .injectSpill(false)
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.u_c2 FROM t, u "
+            "WHERE t.c0 = u.u_c0 AND t.c1 = u.u_c1")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          // 5% of the probe rows match.
+          if (maxMatchPct < 5) {
+            ASSERT_EQ(
+                0,
+                getOperatorRuntimeStats(task, 1, "hashProbeBloomFilter").sum);
+            return;
+          }
+          ASSERT_EQ(
+              1, getOperatorRuntimeStats(task, 1, "hashProbeBloomFilter").sum);
+          // Most of the rows after the first 10K without a match are rejected.
+          ASSERT_GT(
+              getOperatorRuntimeStats(
+                  task, 1, "hashProbeBloomFilterRejectedRows")
+                  .sum,
+              15'000);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 300; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0", "u_c1", "u_c2"},
+      {
+          makeFlatVector<int64_t>(200, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(200, [](auto row) { return row * 3; }),
+          makeFlatVector<StringView>(
+              200,
+              [](auto row) {
+                return StringView::makeInline(fmt::format("s{}", row));
+              },
+              nullEvery(7)),
+      })};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    // The filter after the join keeps 5% of the build side rows. The build
+    // side columns are loaded only for these rows.
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u_c1", "u_c2"},
+                        joinType)
+                    .filter("u_c1 % 60 = 0")
+                    .planNode();
+    const auto joinSql = joinType == core::JoinType::kInner ? "INNER" : "LEFT";
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .config(core::QueryConfig::kHashProbeLazyBuildColumns, "true")
+        .injectSpill(false)
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1, u_c2 FROM t {} JOIN u ON c0 = u_c0 "
+            "WHERE u_c1 % 60 = 0",
+            joinSql))
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, coldBuildPayload) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 300; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0", "u_c1", "u_c2", "u_c3"},
+      {
+          makeFlatVector<int64_t>(400, [](auto row) { return row % 200; }),
+          makeFlatVector<int64_t>(
+              400, [](auto row) { return row * 3; }, nullEvery(11)),
+          makeFlatVector<std::string>(
+              400,
+              [](auto row) {
+                return fmt::format("{}-{}", std::string(row % 40, 'x'), row);
+              },
+              nullEvery(7)),
+          makeFlatVector<double>(400, [](auto row) { return row * 0.5; }),
+      })};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    // The filter and the output read the build side columns from the cold
+    // records of the build rows.
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "u_c1 % 2 = 0",
+                        {"c0", "c1", "u_c1", "u_c2", "u_c3"},
+                        joinType)
+                    .planNode();
+    std::string joinSql;
+    switch (joinType) {
+      case core::JoinType::kInner:
+        joinSql = "INNER";
+        break;
+      case core::JoinType::kLeft:
+        joinSql = "LEFT";
+        break;
+      case core::JoinType::kRight:
+        joinSql = "RIGHT";
+        break;
+      default:
+        joinSql = "FULL OUTER";
+        break;
+    }
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .config(core::QueryConfig::kHashBuildColdPayloadMinBytes, "16")
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1, u_c2, u_c3 FROM t {} JOIN u "
+            "ON c0 = u_c0 AND u_c1 % 2 = 0",
+            joinSql))
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -6812,6 +7125,55 @@ TEST_F(HashJoinTest, leftJoinPreserveProbeOrder) {
   ASSERT_EQ(v1->valueAt(2), 0);
 }
 
+TEST_F(HashJoinTest, outputBatchCacheBudget) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k", "t_v"},
+        {
+            makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+            makeFlatVector<int64_t>(1'000, folly::identity),
+        }));
+  }
+  const std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u_k", "u_v"},
+      {
+          makeFlatVector<int64_t>(100, folly::identity),
+          makeFlatVector<std::string>(
+              100, [](auto row) { return std::string(100 + row, 'x'); }),
+      })};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  core::PlanNodeId joinNodeId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values(probeVectors)
+          .hashJoin(
+              {"t_k"},
+              {"u_k"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+              "",
+              {"t_v", "u_v"})
+          .capturePlanNodeId(joinNodeId)
+          .planNode();
+
+  const auto numOutputBatches = [&](uint64_t cacheBudget) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kOutputBatchCacheBudgetBytes, cacheBudget)
+            .assertResults("SELECT t_v, u_v FROM t, u WHERE t_k = u_k");
+    return toPlanStats(task->taskStats()).at(joinNodeId).outputVectors;
+  };
+  // Without a budget each probe input batch produces one output batch.
+  ASSERT_EQ(numOutputBatches(0), probeVectors.size());
+  // The build side rows are over 100 bytes, so that a 16KB budget fits less
+  // than 160 output rows.
+  ASSERT_GE(numOutputBatches(16 << 10), 4'000 / 160);
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, minSpillableMemoryReservation) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   VectorFuzzer fuzzer({.vectorSize = 1000}, pool());
@@ -7763,6 +8125,109 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeSpill) {
   }
 }
 
+DEBUG_ONLY_TEST_F(HashJoinTest, hybridJoinSpill) {
+  struct {
+    core::JoinType joinType;
+    // The index of get output call to trigger probe side spilling, -1 for no
+    // probe side spilling.
+    int probeOutputIndex;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType: {}, probeOutputIndex: {}",
+          core::joinTypeName(joinType),
+          probeOutputIndex);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner, -1},
+      {core::JoinType::kInner, 0},
+      {core::JoinType::kInner, 5},
+      {core::JoinType::kRight, -1},
+      {core::JoinType::kRight, 0},
+      {core::JoinType::kRight, 5}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    // Reclaims a small target from the task of the second build input so
+    // that only some of the spill partitions are spilled.
+    std::atomic_bool injectBuildSpillOnce{true};
+    std::atomic_int buildInputCount{0};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::addInput",
+        std::function<void(Operator*)>([&](Operator* op) {
+          if (!isHashBuildMemoryPool(*op->pool())) {
+            return;
+          }
+          if (buildInputCount++ != 1) {
+            return;
+          }
+          if (!injectBuildSpillOnce.exchange(false)) {
+            return;
+          }
+          memory::MemoryPoolArbitrationSection arbitrationSection{op->pool()};
+          memory::ScopedMemoryArbitrationContext arbitrationCtx{};
+          memory::MemoryReclaimer::Stats stats;
+          op->testingOperatorCtx()->task()->pool()->reclaim(1, 0, stats);
+        }));
+
+    std::atomic_bool injectProbeSpillOnce{true};
+    std::atomic_int probeOutputCount{0};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::getOutput",
+        std::function<void(Operator*)>([&](Operator* op) {
+          if (testData.probeOutputIndex < 0) {
+            return;
+          }
+          if (!isHashProbeMemoryPool(*op->pool())) {
+            return;
+          }
+          if (probeOutputCount++ != testData.probeOutputIndex) {
+            return;
+          }
+          if (!injectProbeSpillOnce.exchange(false)) {
+            return;
+          }
+          testingRunArbitration(op->pool());
+        }));
+
+    fuzzerOpts_.vectorSize = 128;
+    auto probeVectors = createVectors(10, probeType_, fuzzerOpts_);
+    auto buildVectors = createVectors(20, buildType_, fuzzerOpts_);
+    const auto spillDirectory = exec::test::TempDirectoryPath::create();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(1)
+        .spillDirectory(spillDirectory->getPath())
+        .probeKeys({"t_k1"})
+        .probeVectors(std::move(probeVectors))
+        .buildKeys({"u_k1"})
+        .buildVectors(std::move(buildVectors))
+        .config(core::QueryConfig::kJoinSpillEnabled, "true")
+        .config(core::QueryConfig::kHybridJoinSpillEnabled, "true")
+        .joinType(testData.joinType)
+        .joinOutputLayout({"t_k1", "t_k2", "u_k1", "t_v1"})
+        .referenceQuery(fmt::format(
+            "SELECT t.t_k1, t.t_k2, u.u_k1, t.t_v1 FROM t {} JOIN u ON t.t_k1 = u.u_k1",
+            testData.joinType == core::JoinType::kInner ? "INNER" : "RIGHT"))
+        .injectSpill(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          auto opStats = toOperatorStats(task->taskStats());
+          const auto& buildStats = opStats.at("HashBuild");
+          ASSERT_GT(buildStats.spilledBytes, 0);
+          // Only some of the build partitions are spilled.
+          ASSERT_EQ(
+              buildStats.runtimeStats.count("hybridSpilledPartitions"), 1);
+          ASSERT_GE(
+              buildStats.runtimeStats.at("hybridSpilledPartitions").sum, 1);
+          ASSERT_LT(buildStats.spilledPartitions, 8);
+          if (testData.probeOutputIndex >= 0) {
+            ASSERT_GT(opStats.at("HashProbe").spilledBytes, 0);
+          }
+        })
+        .run();
+  }
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeSpillInMiddeOfLastOutputProcessing) {
   std::atomic_int outputCountAfterNoMoreInout{0};
   std::atomic_bool injectOnce{true};
@@ -456,6 +456,7 @@ class HashTableTest : public testing::TestWithParam<bool>,
 
   void testProbe() {
     auto lookup = std::make_unique<HashLookup>(topTable_->hashers());
+    lookup->radixClusterBits = radixClusterBits_;
     const auto batchSize = batches_[0]->size();
     SelectivityVector rows(batchSize);
     const auto mode = topTable_->hashMode();
@@ -579,6 +580,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // Number of radix cluster bits for join probes.
+  int32_t radixClusterBits_ = 0;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -616,6 +619,14 @@ TEST_P(HashTableTest, int2SparseNormalizedMostMiss) {
   testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
 }
 
+TEST_P(HashTableTest, int2SparseNormalizedRadixClustered) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  radixClusterBits_ = 8;
+  // 2.2M distinct keys make a table larger than kMinRadixClusterTableBytes.
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 1'100'000, 2, type, 2);
+}
+
 TEST_P(HashTableTest, structKey) {
   auto type =
       ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
@@ -1253,6 +1264,53 @@ TEST_P(HashTableTest, toStringMultipleKeys) {
   ASSERT_NO_THROW(table->toString());
 }
 
+TEST_P(HashTableTest, keyValuesBloomFilter) {
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), 1));
+
+  auto table = HashTable<false>::createForJoin(
+      std::move(hashers),
+      {}, /*dependentTypes*/
+      true /*allowDuplicates*/,
+      false /*hasProbedFlag*/,
+      1 /*minTableSizeForParallelJoinBuild*/,
+      pool());
+
+  vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 2; }),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return std::to_string(row); }),
+  });
+  store(*table->rows(), data);
+  table->prepareJoinTable({}, BaseHashTable::kNoSpillInputStartPartitionBit);
+
+  // The Bloom filter is allocated from the pool of the table.
+  const auto usedBytes = pool()->usedBytes();
+  const auto* filter = table->keyValuesBloomFilter(0);
+  ASSERT_NE(filter, nullptr);
+  ASSERT_GT(pool()->usedBytes(), usedBytes);
+  ASSERT_EQ(filter->kind(), common::FilterKind::kBigintValuesUsingBloomFilter);
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_TRUE(filter->testInt64(i * 2));
+  }
+  ASSERT_FALSE(filter->testInt64(-2));
+  ASSERT_FALSE(filter->testInt64(size * 2));
+  ASSERT_FALSE(filter->testNull());
+
+  // The filter is built once and shared by the callers.
+  const auto filterBytes = pool()->usedBytes();
+  ASSERT_EQ(table->keyValuesBloomFilter(0), filter);
+  auto clone = filter->clone(true);
+  ASSERT_TRUE(clone->testNull());
+  ASSERT_TRUE(clone->testInt64(2));
+  ASSERT_EQ(pool()->usedBytes(), filterBytes);
+
+  // Only integer keys have a filter.
+  ASSERT_EQ(table->keyValuesBloomFilter(1), nullptr);
+}
+
 TEST(HashTableTest, tableInsertPartitionInfo) {
   std::vector<char*> overflows;
   const auto testFn = [&](PartitionBoundIndexType start,
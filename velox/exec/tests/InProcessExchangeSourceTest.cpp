@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/ExchangeClient.h"
+#include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class InProcessExchangeSourceTest : public testing::Test,
+                                    public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kPresto)) {
+      serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
+    }
+  }
+
+  void SetUp() override {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+    ExchangeSource::factories().clear();
+    ExchangeSource::registerFactory(InProcessExchangeSource::create);
+    bufferManager_ = OutputBufferManager::getInstance().lock();
+  }
+
+  void TearDown() override {
+    ExchangeSource::factories().clear();
+    test::waitForAllTasksToBeDeleted();
+  }
+
+  std::shared_ptr<Task> makeTask(const std::string& taskId) {
+    auto queryCtx = core::QueryCtx::create(executor_.get());
+    queryCtx->testingOverrideMemoryPool(
+        memory::memoryManager()->addRootPool(queryCtx->queryId()));
+    auto plan = test::PlanBuilder().values({}).planNode();
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        std::move(queryCtx),
+        Task::ExecutionMode::kParallel);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+    return task;
+  }
+
+  void enqueue(
+      const std::string& taskId,
+      int32_t destination,
+      const RowVectorPtr& data) {
+    auto page = test::toSerializedPage(
+        data, VectorSerde::Kind::kPresto, bufferManager_, pool());
+    ContinueFuture unused;
+    VELOX_CHECK(!bufferManager_->enqueue(
+        taskId, destination, std::move(page), &unused));
+  }
+
+  RowVectorPtr deserialize(SerializedPage& page, const RowTypePtr& type) {
+    auto input = page.prepareStreamForDeserialize();
+    RowVectorPtr result;
+    getNamedVectorSerde(VectorSerde::Kind::kPresto)
+        ->deserialize(input.get(), pool(), type, &result, nullptr);
+    return result;
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<OutputBufferManager> bufferManager_;
+};
+
+TEST_F(InProcessExchangeSourceTest, create) {
+  auto queue = std::make_shared<ExchangeQueue>();
+  // Tasks which are not in this process are left to the other factories.
+  ASSERT_EQ(
+      InProcessExchangeSource::create("remote.1.0.0", 0, queue, pool()),
+      nullptr);
+
+  auto task = makeTask("local.1.0.0");
+  auto source =
+      InProcessExchangeSource::create("local.1.0.0", 0, queue, pool());
+  ASSERT_NE(source, nullptr);
+  ASSERT_TRUE(source->supportsMetrics());
+  source->close();
+
+  task->requestCancel();
+  bufferManager_->removeTask(task->taskId());
+}
+
+TEST_F(InProcessExchangeSourceTest, fetch) {
+  const auto taskId = "local.2.0.0";
+  auto task = makeTask(taskId);
+
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({4, 5})}),
+      makeRowVector({makeFlatVector<int32_t>({6})}),
+  };
+  for (const auto& vector : data) {
+    enqueue(taskId, 1, vector);
+  }
+  bufferManager_->noMoreData(taskId);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "t", 1, ExchangeClient::kDefaultMaxQueuedBytes, pool(), executor_.get());
+  client->addRemoteTaskId(taskId);
+  client->noMoreRemoteTasks();
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd{false};
+  while (!atEnd) {
+    ContinueFuture future;
+    auto next = client->next(1, &atEnd, &future);
+    if (next.empty() && !atEnd) {
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(future).via(&exec).wait();
+      continue;
+    }
+    for (auto& page : next) {
+      pages.push_back(std::move(page));
+    }
+  }
+
+  ASSERT_EQ(pages.size(), data.size());
+  const auto rowType = asRowType(data[0]->type());
+  for (auto i = 0; i < pages.size(); ++i) {
+    velox::test::assertEqualVectors(data[i], deserialize(*pages[i], rowType));
+  }
+
+  const auto stats = client->stats();
+  ASSERT_EQ(stats.at("inProcessExchangeSource.numPages").sum, data.size());
+  ASSERT_GT(stats.at("inProcessExchangeSource.totalBytes").sum, 0);
+
+  client->close();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -13,6 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <thread>
+
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -637,3 +640,56 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
             ")");
   }
 }
+
+TEST_F(LocalPartitionTest, concurrentQueue) {
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumVectors = 1'000;
+  constexpr int64_t kVectorBytes = 1'000;
+  // The limit fits a few vectors so that the producers block.
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(4 * kVectorBytes);
+  auto queue = std::make_shared<LocalExchangeQueue>(memoryManager, 0);
+  for (auto i = 0; i < kNumThreads; ++i) {
+    queue->addProducer();
+  }
+  queue->noMoreProducers();
+
+  auto input = makeRowVector({makeFlatSequence<int64_t>(0, 10)});
+  std::atomic<int64_t> numReceived{0};
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kNumVectors; ++j) {
+        ContinueFuture future;
+        if (queue->enqueue(input, kVectorBytes, &future) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      queue->noMoreData();
+    });
+    threads.emplace_back([&]() {
+      for (;;) {
+        RowVectorPtr data;
+        ContinueFuture future;
+        if (queue->next(&future, pool(), &data) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+        ++numReceived;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numReceived, kNumThreads * kNumVectors);
+  ASSERT_TRUE(queue->isFinished());
+  // All the buffered memory is released.
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager->increaseMemoryUsage(&future, kVectorBytes));
+}
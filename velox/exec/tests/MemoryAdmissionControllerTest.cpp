@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryAdmissionController.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class MemoryAdmissionControllerTest : public OperatorTestBase {
+ protected:
+  static constexpr uint64_t kMB = 1 << 20;
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    memory::MemoryManagerOptions options;
+    options.allocatorCapacity = 1'000 * kMB;
+    memoryManager_ = std::make_unique<memory::MemoryManager>(options);
+    data_ = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  }
+
+  MemoryAdmissionController::Config makeConfig() const {
+    MemoryAdmissionController::Config config;
+    config.memoryManager = memoryManager_.get();
+    config.nodeBytes = kMB;
+    config.statefulNodeBytes = 100 * kMB;
+    config.historyWeight = 0.5;
+    config.headroom = 1.5;
+    return config;
+  }
+
+  core::PlanNodePtr filterPlan(const std::string& filter) const {
+    return PlanBuilder().values({data_}).filter(filter).planNode();
+  }
+
+  core::PlanNodePtr aggregationPlan() const {
+    return PlanBuilder()
+        .values({data_})
+        .singleAggregation({"c0"}, {"count(1)"})
+        .planNode();
+  }
+
+  std::unique_ptr<memory::MemoryManager> memoryManager_;
+  RowVectorPtr data_;
+};
+
+TEST_F(MemoryAdmissionControllerTest, fingerprint) {
+  EXPECT_EQ(
+      MemoryAdmissionController::fingerprint(*filterPlan("c0 > 1")),
+      MemoryAdmissionController::fingerprint(*filterPlan("c0 > 2")));
+  EXPECT_NE(
+      MemoryAdmissionController::fingerprint(*filterPlan("c0 > 1")),
+      MemoryAdmissionController::fingerprint(*aggregationPlan()));
+}
+
+TEST_F(MemoryAdmissionControllerTest, forecast) {
+  MemoryAdmissionController controller(makeConfig());
+  // From the plan shape.
+  EXPECT_EQ(controller.forecast(*filterPlan("c0 > 1")), 2 * kMB);
+  EXPECT_EQ(controller.forecast(*aggregationPlan()), 101 * kMB);
+
+  // From the history of the plan fingerprint.
+  auto admission = controller.admit(*aggregationPlan());
+  EXPECT_EQ(admission.bytes, 101 * kMB);
+  EXPECT_EQ(controller.admittedBytes(), 101 * kMB);
+  controller.finish(admission, 10 * kMB);
+  EXPECT_EQ(controller.admittedBytes(), 0);
+  EXPECT_EQ(controller.forecast(*aggregationPlan()), 15 * kMB);
+
+  admission = controller.admit(*aggregationPlan());
+  EXPECT_EQ(admission.bytes, 15 * kMB);
+  controller.finish(admission, 30 * kMB);
+  EXPECT_EQ(controller.forecast(*aggregationPlan()), 30 * kMB);
+  // Other plans are not affected.
+  EXPECT_EQ(controller.forecast(*filterPlan("c0 > 1")), 2 * kMB);
+
+  // The forecast is at most the capacity.
+  admission = controller.admit(*aggregationPlan());
+  controller.finish(admission, 10'000 * kMB);
+  EXPECT_EQ(controller.forecast(*aggregationPlan()), 1'000 * kMB);
+}
+
+TEST_F(MemoryAdmissionControllerTest, admitByCapacity) {
+  MemoryAdmissionController controller(makeConfig());
+  auto admission = controller.admit(*aggregationPlan());
+  controller.finish(admission, 400 * kMB);
+  ASSERT_EQ(controller.forecast(*aggregationPlan()), 600 * kMB);
+
+  auto first = controller.admit(*aggregationPlan());
+  std::atomic_bool admitted{false};
+  std::thread thread([&]() {
+    auto second = controller.admit(*aggregationPlan());
+    admitted = true;
+    controller.finish(second, 400 * kMB);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(admitted);
+  controller.finish(first, 400 * kMB);
+  thread.join();
+  EXPECT_TRUE(admitted);
+  EXPECT_EQ(controller.admittedBytes(), 0);
+}
+
+TEST_F(MemoryAdmissionControllerTest, admitByFreeMemory) {
+  MemoryAdmissionController controller(makeConfig());
+  auto small = controller.admit(*filterPlan("c0 > 1"));
+
+  // Leaves less free memory than the forecast of the aggregation.
+  auto pool = memoryManager_->addLeafPool();
+  void* buffer = pool->allocate(900 * kMB);
+  std::atomic_bool admitted{false};
+  std::thread thread([&]() {
+    auto large = controller.admit(*aggregationPlan());
+    admitted = true;
+    controller.finish(large, 0);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  controller.admitQueued();
+  EXPECT_FALSE(admitted);
+
+  pool->free(buffer, 900 * kMB);
+  controller.admitQueued();
+  thread.join();
+  EXPECT_TRUE(admitted);
+  controller.finish(small, 0);
+  EXPECT_EQ(controller.admittedBytes(), 0);
+}
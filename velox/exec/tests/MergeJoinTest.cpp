@@ -713,6 +713,51 @@ TEST_F(MergeJoinTest, dictionaryOutput) {
   output.reset();
 }
 
+// Runs of matching rows that cross output batches and input batches.
+TEST_F(MergeJoinTest, matchRuns) {
+  auto left = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row / 10; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto right = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(60, [](auto row) { return 2 + row / 6; }),
+       makeFlatVector<int64_t>(60, [](auto row) { return row; })});
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(split(left, 3))
+                    .mergeJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(split(right, 4))
+                            .planNode(),
+                        "",
+                        {"t0", "t1", "u0", "u1"},
+                        joinType)
+                    .planNode();
+
+    for (const auto* batchSize : {"7", "1024"}) {
+      SCOPED_TRACE(batchSize);
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, batchSize)
+          .assertResults(fmt::format(
+              "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON t0 = u0",
+              core::joinTypeName(joinType)));
+    }
+  }
+}
+
 TEST_F(MergeJoinTest, semiJoin) {
   auto left = makeRowVector(
       {"t0"}, {makeNullableFlatVector<int64_t>({1, 2, 2, 6, std::nullopt})});
@@ -1046,6 +1091,42 @@ TEST_F(MergeJoinTest, fullOuterJoin) {
           "SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0 AND t.t0 > 2");
 }
 
+TEST_F(MergeJoinTest, fullOuterJoinFilterMisses) {
+  // Several rows in the same output batch fail the filter.
+  auto left = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+       makeFlatVector<int64_t>({10, 20, 30, 40, 50, 60, 70, 80})});
+
+  auto right = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>({1, 2, 4, 5, 6, 8, 9}),
+       makeFlatVector<int64_t>({1, 2, 4, 5, 6, 8, 9})});
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (const auto& filter : {"t1 > 45", "t1 < 45", "u1 % 2 = 0"}) {
+    SCOPED_TRACE(filter);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values({left})
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                filter,
+                {"t0", "t1", "u0", "u1"},
+                core::JoinType::kFull)
+            .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(fmt::format(
+            "SELECT t0, t1, u0, u1 FROM t FULL OUTER JOIN u ON t0 = u0 AND {}",
+            filter));
+  }
+}
+
 TEST_F(MergeJoinTest, fullOuterJoinNoFilter) {
   auto left = makeRowVector(
       {"t0", "t1", "t2", "t3"},
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -152,6 +153,61 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+TEST_F(MergeTest, rangePartitionedOrderBy) {
+  // Many duplicate keys in the first batch and nulls.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (row * 7 + i) % (i == 0 ? 10 : 997); },
+            nullEvery(13)),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return row + i * 1'000; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Each of the 4 drivers reads all the vectors.
+  const int32_t numDrivers = 4;
+  for (const std::string orderByClause :
+       {"c0 NULLS LAST", "c0 DESC NULLS FIRST"}) {
+    SCOPED_TRACE(orderByClause);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId orderById;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .localMerge(
+                        {orderByClause, "c1"},
+                        {PlanBuilder(planNodeIdGenerator)
+                             .values(vectors, true)
+                             .orderBy({orderByClause, "c1"}, true)
+                             .capturePlanNodeId(orderById)
+                             .planNode()})
+                    .planNode();
+
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = numDrivers;
+    params.queryCtx = core::QueryCtx::create(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kOrderByRangePartitioning, "true"}});
+    auto task = assertQueryOrdered(
+        params,
+        fmt::format(
+            "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+            "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) "
+            "ORDER BY {}, c1",
+            orderByClause),
+        {0, 1});
+
+    const auto stats = toPlanStats(task->taskStats())
+                           .at(orderById)
+                           .customStats.at("rangeSortInputRows");
+    ASSERT_EQ(numDrivers, stats.count);
+    ASSERT_EQ(numDrivers * 4'000, stats.sum);
+  }
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
@@ -480,6 +480,60 @@ TEST_P(MultiFragmentTest, mergeExchange) {
   ASSERT_EQ(serdeKindRuntimsStats.max, static_cast<int64_t>(GetParam()));
 }
 
+// Merges more sources than fit the merge exchange buffer at 1MB each. The
+// sources share half of the buffer and the source the merge waits for gets
+// the other half.
+TEST_P(MultiFragmentTest, mergeExchangeSmallBuffer) {
+  const int numSources = 8;
+  auto vectors = makeVectors(numSources * 4, 1'000);
+  createDuckDbTable(vectors);
+  configSettings_[core::QueryConfig::kMaxMergeExchangeBufferSize] =
+      std::to_string(1 << 20);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  std::vector<std::string> partialSortTaskIds;
+  for (int i = 0; i < numSources; ++i) {
+    auto sortTaskId = makeTaskId("orderby", tasks.size());
+    partialSortTaskIds.push_back(sortTaskId);
+    auto partialSortPlan =
+        PlanBuilder()
+            .values(std::vector<RowVectorPtr>(
+                vectors.begin() + i * 4, vectors.begin() + (i + 1) * 4))
+            .orderBy({"c0"}, false)
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam())
+            .planNode();
+    auto sortTask = makeTask(sortTaskId, partialSortPlan, tasks.size());
+    tasks.push_back(sortTask);
+    sortTask->start(1);
+  }
+
+  auto finalSortTaskId = makeTaskId("orderby", tasks.size());
+  core::PlanNodeId mergeExchangeId;
+  auto finalSortPlan =
+      PlanBuilder()
+          .mergeExchange(asRowType(vectors[0]->type()), {"c0"}, GetParam())
+          .capturePlanNodeId(mergeExchangeId)
+          .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam())
+          .planNode();
+  auto mergeTask = makeTask(finalSortTaskId, finalSortPlan, 0);
+  tasks.push_back(mergeTask);
+  mergeTask->start(1);
+  addRemoteSplits(mergeTask, partialSortTaskIds);
+
+  auto op = PlanBuilder()
+                .exchange(finalSortPlan->outputType(), GetParam())
+                .planNode();
+  assertQueryOrdered(
+      op, {finalSortTaskId}, "SELECT * FROM tmp ORDER BY 1 NULLS LAST", {0});
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+  const auto mergeExchangeStats =
+      toPlanStats(mergeTask->taskStats()).at(mergeExchangeId);
+  EXPECT_EQ(numSources * 4 * 1'000, mergeExchangeStats.inputRows);
+}
+
 // Test reordering and dropping columns in PartitionedOutput operator.
 TEST_P(MultiFragmentTest, partitionedOutput) {
   setupSources(10, 1000);
@@ -2315,6 +2369,65 @@ TEST_P(MultiFragmentTest, mergeSmallBatchesInExchange) {
   }
 }
 
+TEST_P(MultiFragmentTest, splitLargePageInExchange) {
+  // Only the Presto serde deserializes a page batch by batch.
+  if (GetParam() != VectorSerde::Kind::kPresto) {
+    return;
+  }
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+
+  auto producerPlan = test::PlanBuilder()
+                          .values({data})
+                          .partitionedOutput({}, 1, {}, GetParam())
+                          .planNode();
+  const auto producerTaskId = "local://t1";
+  auto producerTask = makeTask(producerTaskId, producerPlan);
+  bufferManager_->initializeTask(
+      producerTask, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  auto cleanupGuard = folly::makeGuard([&]() {
+    producerTask->requestCancel();
+    bufferManager_->removeTask(producerTaskId);
+  });
+
+  // One page with 10 serialized batches.
+  const int32_t numBatches = 10;
+  std::unique_ptr<folly::IOBuf> buffers;
+  for (auto i = 0; i < numBatches; ++i) {
+    auto page = toSerializedPage(data, GetParam(), bufferManager_, pool());
+    if (buffers == nullptr) {
+      buffers = page->getIOBuf();
+    } else {
+      buffers->appendToChain(page->getIOBuf());
+    }
+  }
+  const auto pageSize = buffers->computeChainDataLength();
+  ContinueFuture unused;
+  bufferManager_->enqueue(
+      producerTaskId,
+      0,
+      std::make_unique<SerializedPage>(std::move(buffers)),
+      &unused);
+  bufferManager_->noMoreData(producerTaskId);
+
+  std::vector<RowVectorPtr> expected(numBatches, data);
+  auto plan = test::PlanBuilder()
+                  .exchange(asRowType(data->type()), GetParam())
+                  .planNode();
+  auto task = test::AssertQueryBuilder(plan)
+                  .split(remoteSplit(producerTaskId))
+                  .config(
+                      core::QueryConfig::kPreferredOutputBatchBytes,
+                      std::to_string(pageSize / 4))
+                  .assertResults(expected);
+
+  // Each output batch is cut at the first serialized batch which brings it
+  // over a quarter of the page.
+  const auto stats = exec::toPlanStats(task->taskStats()).at("0");
+  ASSERT_EQ(stats.outputRows, numBatches * data->size());
+  ASSERT_EQ(stats.outputVectors, 4);
+}
+
 TEST_P(MultiFragmentTest, compression) {
   // NOTE: only presto format supports compression for now
   if (GetParam() != VectorSerde::Kind::kPresto) {
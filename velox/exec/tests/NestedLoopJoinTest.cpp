@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -569,6 +570,183 @@ TEST_F(NestedLoopJoinTest, outputOrder) {
   assertEqualVectors(expectedLeft, results);
 }
 
+TEST_F(NestedLoopJoinTest, rangeJoinOutputOrder) {
+  auto probeVectors = makeRowVector(
+      {"l1", "l2"},
+      {
+          makeNullableFlatVector<int64_t>({1, 8, 6, std::nullopt, 7, 4}),
+          makeFlatVector<StringView>({"a", "b", "c", "d", "e", "f"}),
+      });
+  auto buildVectors = {
+      makeRowVector(
+          {"r1", "r2"},
+          {
+              makeNullableFlatVector<int64_t>({4, 6, 1}),
+              makeFlatVector<StringView>({"z", "x", "y"}),
+          }),
+      makeRowVector(
+          {"r1", "r2"},
+          {
+              makeNullableFlatVector<int64_t>({10, std::nullopt, 6}),
+              makeFlatVector<StringView>({"z", "p", "u"}),
+          })};
+  createDuckDbTable("t", {probeVectors});
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probeVectors})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .project({"r1", "r2"})
+                            .planNode(),
+                        "l1 < r1",
+                        {"l1", "l2", "r1", "r2"},
+                        joinType)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kNestedLoopJoinRangeEnabled, true)
+        .assertResults(fmt::format(
+            "SELECT l1, l2, r1, r2 FROM t {} JOIN u ON l1 < r1",
+            joinTypeName(joinType)));
+
+    // The range join sorts the build side on r1, so the build rows of a probe
+    // row come in another order. The probe rows keep their order.
+    auto results =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kNestedLoopJoinRangeEnabled, true)
+            .copyResults(pool());
+    std::vector<std::string> probeOrder;
+    for (auto row = 0; row < results->size(); ++row) {
+      const auto key = results->childAt(1)->toString(row);
+      if (probeOrder.empty() || probeOrder.back() != key) {
+        probeOrder.push_back(key);
+      }
+    }
+    const std::vector<std::string> expectedOrder =
+        joinType == core::JoinType::kInner
+        ? std::vector<std::string>{"a", "b", "c", "e", "f"}
+        : std::vector<std::string>{"a", "b", "c", "d", "e", "f"};
+    ASSERT_EQ(probeOrder, expectedOrder);
+  }
+}
+
+TEST_F(NestedLoopJoinTest, rangeJoinBounds) {
+  const auto probeType =
+      ROW({"t0", "t1", "t2"}, {BIGINT(), BIGINT(), DOUBLE()});
+  const auto buildType =
+      ROW({"u0", "u1", "u2"}, {BIGINT(), BIGINT(), DOUBLE()});
+  const core::QueryConfig config{
+      {{core::QueryConfig::kNestedLoopJoinRangeEnabled, "true"}}};
+
+  const auto makeRange = [&](const std::string& condition) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({makeRowVector(probeType, 0)})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({makeRowVector(buildType, 0)})
+                            .planNode(),
+                        condition,
+                        {"t0", "u0"})
+                    .planNode();
+    return NestedLoopJoinRange::create(
+        *std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(plan),
+        config);
+  };
+
+  auto range = makeRange("t0 BETWEEN u0 AND u1 AND u1 < t1");
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->buildChannel, 1);
+  ASSERT_EQ(range->bounds.size(), 2);
+  EXPECT_EQ(range->bounds[0].probeChannel, 0);
+  EXPECT_FALSE(range->bounds[0].upper);
+  EXPECT_TRUE(range->bounds[0].inclusive);
+  EXPECT_EQ(range->bounds[1].probeChannel, 1);
+  EXPECT_TRUE(range->bounds[1].upper);
+  EXPECT_FALSE(range->bounds[1].inclusive);
+
+  range = makeRange("u0 BETWEEN t0 AND t1 + 1");
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->buildChannel, 0);
+  ASSERT_EQ(range->bounds.size(), 1);
+  EXPECT_FALSE(range->bounds[0].upper);
+
+  // No bounds in disjunctions, on floating point columns or within a side.
+  EXPECT_FALSE(makeRange("t0 < u0 OR t1 > u1").has_value());
+  EXPECT_FALSE(makeRange("t2 < u2").has_value());
+  EXPECT_FALSE(makeRange("t0 < t1 AND u0 = t0").has_value());
+}
+
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             100,
+             [i](auto row) { return (i * 100 + row) % 97 * 3; },
+             nullEvery(11)),
+         makeFlatVector<int64_t>(100, [](auto row) { return row % 5; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 2; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1", "u2"},
+        {makeFlatVector<int64_t>(
+             50,
+             [i](auto row) { return (i * 50 + row) * 7 % 290; },
+             nullEvery(7)),
+         makeFlatVector<int64_t>(
+             50, [i](auto row) { return (i * 50 + row) * 7 % 290 + row % 13; }),
+         makeFlatVector<int64_t>(50, [](auto row) { return row % 5; })}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u1",
+      "u0 <= t0 AND t0 < u1 AND t1 <> u2",
+      "u1 BETWEEN t0 AND t0 + 10",
+      "u0 > t0 AND u1 > t1",
+      "t0 > u1 OR t1 = u2",
+  };
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    for (const auto& condition : conditions) {
+      SCOPED_TRACE(fmt::format(
+          "joinType:{} condition:{}", joinTypeName(joinType), condition));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"t0", "t1", "u0", "u1"},
+                          joinType)
+                      .planNode();
+      const auto sql = fmt::format(
+          "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON {}",
+          joinTypeName(joinType),
+          condition);
+      for (const auto enabled : {true, false}) {
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kNestedLoopJoinRangeEnabled, enabled)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, 7)
+            .assertResults(sql);
+      }
+    }
+  }
+}
+
 TEST_F(NestedLoopJoinTest, mergeBuildVectors) {
   const std::vector<RowVectorPtr> buildVectors = {
       makeRowVector({makeFlatVector<int64_t>({1, 2})}),
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/OperatorUtils.h"
 #include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -531,3 +532,131 @@ TEST_F(OperatorUtilsTest, outputBatchRows) {
     ASSERT_EQ(1000, mockOp.outputRows(3'000'000'000));
   }
 }
+
+namespace {
+// A SimpleVectorLoader which may declare support for concurrent loading.
+class TestConcurrentLoader : public SimpleVectorLoader {
+ public:
+  TestConcurrentLoader(
+      std::function<VectorPtr(RowSet)> loader,
+      bool supportsConcurrentLoad)
+      : SimpleVectorLoader(std::move(loader)),
+        supportsConcurrentLoad_(supportsConcurrentLoad) {}
+
+  bool supportsConcurrentLoad() const override {
+    return supportsConcurrentLoad_;
+  }
+
+ private:
+  const bool supportsConcurrentLoad_;
+};
+} // namespace
+
+TEST_F(OperatorUtilsTest, loadColumnsConcurrently) {
+  const vector_size_t size = 1'000;
+  std::mutex mutex;
+  std::unordered_set<std::thread::id> loadThreads;
+  auto makeLazy = [&](int64_t column, bool concurrent) -> VectorPtr {
+    return std::make_shared<LazyVector>(
+        pool(),
+        BIGINT(),
+        size,
+        std::make_unique<TestConcurrentLoader>(
+            [&, column](RowSet rows) {
+              if (column < 0) {
+                VELOX_FAIL("Test load failure");
+              }
+              {
+                std::lock_guard<std::mutex> l(mutex);
+                loadThreads.insert(std::this_thread::get_id());
+              }
+              return makeFlatVector<int64_t>(
+                  rows.back() + 1, [column](auto row) { return row * column; });
+            },
+            concurrent));
+  };
+
+  // Every other row passed a filter.
+  SelectivityVector rows(size, false);
+  for (auto i = 0; i < size; i += 2) {
+    rows.setValid(i, true);
+  }
+  rows.updateBounds();
+
+  std::vector<VectorPtr> vectors;
+  for (auto i = 0; i < 8; ++i) {
+    vectors.push_back(makeLazy(i, true));
+  }
+  vectors.push_back(makeLazy(10, false));
+  loadColumnsConcurrently(vectors, rows, executor_.get());
+
+  for (auto i = 0; i < 8; ++i) {
+    auto* lazy = vectors[i]->asUnchecked<LazyVector>();
+    ASSERT_TRUE(lazy->isLoaded());
+    auto* loaded = lazy->loadedVector()->asUnchecked<SimpleVector<int64_t>>();
+    rows.applyToSelected(
+        [&](auto row) { ASSERT_EQ(row * i, loaded->valueAt(row)); });
+  }
+  // Not declared as concurrently loadable.
+  ASSERT_FALSE(vectors.back()->asUnchecked<LazyVector>()->isLoaded());
+  ASSERT_GE(loadThreads.size(), 1);
+
+  // Errors are rethrown after all the loads finish.
+  vectors.clear();
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeLazy(i == 2 ? -1 : i, true));
+  }
+  VELOX_ASSERT_THROW(
+      loadColumnsConcurrently(vectors, rows, executor_.get()),
+      "Test load failure");
+}
+
+TEST_F(OperatorUtilsTest, loadColumnsConcurrentlyDictionaryOverLazy) {
+  // The loads share 'rows' and decode dictionaries over the LazyVectors on
+  // the executor threads. Run under TSAN to check that they do not race.
+  const vector_size_t size = 10'000;
+  auto makeLazy = [&](int64_t column) -> VectorPtr {
+    return std::make_shared<LazyVector>(
+        pool(),
+        BIGINT(),
+        size,
+        std::make_unique<TestConcurrentLoader>(
+            [&, column](RowSet rows) {
+              return makeFlatVector<int64_t>(
+                  rows.back() + 1, [column](auto row) { return row * column; });
+            },
+            true));
+  };
+
+  // Few enough rows for SelectivityVector to iterate over a list of them.
+  SelectivityVector rows(size, false);
+  for (auto i = 0; i < size; i += 97) {
+    rows.setValid(i, true);
+  }
+  rows.updateBounds();
+  ASSERT_TRUE(rows.testingIsSparse());
+
+  auto indices = makeIndicesInReverse(size);
+  for (auto iteration = 0; iteration < 10; ++iteration) {
+    std::vector<VectorPtr> lazies;
+    std::vector<VectorPtr> vectors;
+    for (auto i = 0; i < 8; ++i) {
+      lazies.push_back(makeLazy(i));
+      vectors.push_back(BaseVector::wrapInDictionary(
+          nullptr, indices, size, lazies.back()));
+    }
+    // A second dictionary over the same LazyVector.
+    vectors.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, size, lazies[3]));
+    loadColumnsConcurrently(vectors, rows, executor_.get());
+
+    for (auto i = 0; i < vectors.size(); ++i) {
+      const auto column = i < 8 ? i : 3;
+      ASSERT_TRUE(lazies[column]->asUnchecked<LazyVector>()->isLoaded());
+      DecodedVector decoded(*vectors[i], rows);
+      rows.applyToSelected([&](auto row) {
+        ASSERT_EQ((size - 1 - row) * column, decoded.valueAt<int64_t>(row));
+      });
+    }
+  }
+}
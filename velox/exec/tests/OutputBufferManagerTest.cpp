@@ -89,14 +89,15 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      const std::unordered_map<std::string, std::string>& extraConfigs = {}) {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
                             .values({std::dynamic_pointer_cast<RowVector>(
                                 BatchMaker::createBatch(rowType, 100, *pool_))})
                             .planFragment();
-    std::unordered_map<std::string, std::string> configSettings;
+    std::unordered_map<std::string, std::string> configSettings(extraConfigs);
     if (maxOutputBufferSize != 0) {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
@@ -1254,6 +1255,44 @@ TEST_P(
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, arbitraryReassignLaggingPages) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kArbitrary,
+      2,
+      1,
+      0,
+      {{core::QueryConfig::kArbitraryOutputBufferReassignTimeoutMs, "10"}});
+
+  enqueue(taskId, rowType_, size);
+  enqueue(taskId, rowType_, size);
+  // Destination 0 loads both pages on the repeated fetch but only gets the
+  // first one.
+  fetchOne(taskId, 0, 0, 1);
+  fetchOne(taskId, 0, 0, 1);
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesBuffered, 2);
+
+  // Destination 1 gets the undelivered page of destination 0 after the latter
+  // has been idle for the timeout.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20)); // NOLINT
+  fetchOne(taskId, 1, 0, 1);
+  const auto stats = getStats(taskId);
+  ASSERT_EQ(stats.numReassignedPages, 1);
+  ASSERT_EQ(stats.buffersStats[0].pagesBuffered, 1);
+  ASSERT_EQ(stats.buffersStats[1].pagesBuffered, 1);
+
+  acknowledge(taskId, 0, 1);
+  acknowledge(taskId, 1, 1);
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 1);
+  fetchEndMarker(taskId, 1, 1);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_P(AllOutputBufferManagerTest, maxBytes) {
   const vector_size_t size = 100;
   const std::string taskId = "t0";
@@ -206,6 +206,366 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, preserveEncodings) {
+  if (GetParam() != VectorSerde::Kind::kPresto) {
+    GTEST_SKIP() << "Encodings are only preserved by the Presto serde";
+  }
+  // A dictionary and a constant column which would be flattened otherwise.
+  auto input = makeRowVector(
+      {"p1", "v1", "v2"},
+      {makeFlatVector<int32_t>(100, [](auto row) { return row % 2; }),
+       BaseVector::wrapInDictionary(
+           nullptr,
+           makeIndices(100, [](auto row) { return row % 10; }),
+           100,
+           makeFlatVector<std::string>(
+               10, [](auto row) { return std::string(20 + row, 'x'); })),
+       makeConstant<int64_t>(11, 100)});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 13)
+                  .partitionedOutput(
+                      {"p1"},
+                      2,
+                      std::vector<std::string>{"v1", "v2"},
+                      GetParam())
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-preserve-encodings-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext(
+          {{core::QueryConfig::kPartitionedOutputPreserveEncodings, "true"}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto* serde = getNamedVectorSerde(GetParam());
+  const auto outputType = ROW({"v1", "v2"}, {VARCHAR(), BIGINT()});
+  for (auto destination = 0; destination < 2; ++destination) {
+    auto pages = getAllData(taskId, destination);
+    // Each input batch is serialized into a page of its own.
+    ASSERT_EQ(pages.size(), 13);
+    for (auto& page : pages) {
+      SerializedPage serializedPage(std::move(page));
+      auto inputStream = serializedPage.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      serde->deserialize(
+          inputStream.get(), pool(), outputType, &result, nullptr);
+      ASSERT_EQ(result->size(), 50);
+      for (auto row = 0; row < result->size(); ++row) {
+        // Destination 'd' has the rows 'd', 'd' + 2, ... of the input.
+        const auto inputRow = destination + 2 * row;
+        ASSERT_TRUE(result->childAt(0)->equalValueAt(
+            input->childAt(1).get(), row, inputRow));
+        ASSERT_TRUE(result->childAt(1)->equalValueAt(
+            input->childAt(2).get(), row, inputRow));
+      }
+    }
+  }
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+}
+
+TEST_P(PartitionedOutputTest, skewedJoin) {
+  // 90% of the probe rows have key 0.
+  constexpr int32_t kNumBatches = 10;
+  auto probeInput = makeRowVector(
+      {"k", "v"},
+      {makeFlatVector<int64_t>(
+           1'000, [](auto row) { return row % 10 == 0 ? 1 + row / 10 : 0; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto buildInput = makeRowVector(
+      {"k", "v"},
+      {makeFlatVector<int64_t>(101, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(101, [](auto row) { return row; })});
+  const int32_t numPartitions = 4;
+  auto makePlan = [&](const RowVectorPtr& input,
+                      int32_t numBatches,
+                      bool isProbe) {
+    return PlanBuilder()
+        .values({input}, false, numBatches)
+        .skewedJoinPartitionedOutput(
+            {"k"},
+            numPartitions,
+            {"join", isProbe},
+            std::vector<std::string>{"k"},
+            GetParam())
+        .planNode();
+  };
+
+  auto queryCtx = createQueryContext(
+      {{core::QueryConfig::kSkewedJoinSplitFactor, "2"},
+       {core::QueryConfig::kSkewedJoinHotPartitionRatio, "2"},
+       {core::QueryConfig::kSkewedJoinDecisionBytes, "1"}});
+  const std::string buildTaskId = "local://test-partitioned-output-skew-build";
+  const std::string probeTaskId = "local://test-partitioned-output-skew-probe";
+  // The build side waits for the probe side to decide the hot partitions.
+  const auto buildPlan = makePlan(buildInput, 1, false);
+  auto buildTask = Task::create(
+      buildTaskId,
+      core::PlanFragment{buildPlan},
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel);
+  buildTask->start(1);
+  auto probeTask = Task::create(
+      probeTaskId,
+      core::PlanFragment{makePlan(probeInput, kNumBatches, true)},
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel);
+  probeTask->start(1);
+
+  auto tracker = SkewedPartitionTracker::getOrCreate(
+      queryCtx, "join", numPartitions, 2, 2, 1);
+  // Counts the rows with key 0 in each destination.
+  auto* serde = getNamedVectorSerde(GetParam());
+  auto countHotKeys = [&](const std::string& taskId) {
+    std::vector<int64_t> counts(numPartitions, 0);
+    for (auto destination = 0; destination < numPartitions; ++destination) {
+      for (auto& page : getAllData(taskId, destination)) {
+        SerializedPage serializedPage(std::move(page));
+        auto inputStream = serializedPage.prepareStreamForDeserialize();
+        RowVectorPtr result;
+        serde->deserialize(
+            inputStream.get(),
+            pool(),
+            ROW({"k"}, {BIGINT()}),
+            &result,
+            nullptr);
+        auto* keys = result->childAt(0)->asFlatVector<int64_t>();
+        for (auto row = 0; row < result->size(); ++row) {
+          counts[destination] += keys->valueAt(row) == 0;
+        }
+      }
+    }
+    return counts;
+  };
+  const auto probeCounts = countHotKeys(probeTaskId);
+  const auto buildCounts = countHotKeys(buildTaskId);
+
+  ASSERT_TRUE(tracker->decided());
+  const auto hotPartitions = tracker->hotPartitions();
+  ASSERT_EQ(hotPartitions.size(), 1);
+  const auto hot = hotPartitions[0];
+  const auto other = tracker->destination(hot, 1);
+  // The first batch decides the hot partitions. The probe rows of the hot
+  // key are spread evenly over 2 destinations and the build row of the key
+  // goes to both.
+  EXPECT_EQ(probeCounts[hot], 900 * kNumBatches / 2);
+  EXPECT_EQ(probeCounts[other], 900 * kNumBatches / 2);
+  EXPECT_EQ(buildCounts[hot], 1);
+  EXPECT_EQ(buildCounts[other], 1);
+
+  for (const auto& task : {buildTask, probeTask}) {
+    ASSERT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+  }
+  // The build rows of the hot partition are sent twice.
+  auto planStats = toPlanStats(buildTask->taskStats());
+  EXPECT_GE(
+      planStats.at(buildPlan->id())
+          .customStats.at(PartitionedOutput::kSkewedPartitionRows)
+          .sum,
+      1);
+}
+
+TEST_P(PartitionedOutputTest, skewedJoinWithoutProbe) {
+  // No probe side runs in this process. The build side fails instead of
+  // deciding the hot partitions on its own.
+  constexpr int32_t kNumPartitions = 4;
+  auto input = makeRowVector(
+      {"k"}, {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto plan = PlanBuilder()
+                  .values({input})
+                  .skewedJoinPartitionedOutput(
+                      {"k"},
+                      kNumPartitions,
+                      {"join", false},
+                      std::vector<std::string>{"k"},
+                      GetParam())
+                  .planNode();
+  auto queryCtx = createQueryContext(
+      {{core::QueryConfig::kSkewedJoinDecisionBytes, "1"},
+       {core::QueryConfig::kSkewedJoinDecisionTimeoutMs, "100"}});
+  auto task = Task::create(
+      "local://test-partitioned-output-skew-without-probe",
+      core::PlanFragment{plan},
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  ASSERT_TRUE(waitForTaskFailure(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+  VELOX_ASSERT_THROW(
+      std::rethrow_exception(task->error()),
+      "No probe side of the skewed join in this process");
+}
+
+TEST_P(PartitionedOutputTest, skewedJoinBuildAfterProbe) {
+  // The probe side splits the hot partition and finishes before the build
+  // side starts. The build side waits longer than the decision timeout and
+  // still routes its rows by the decision of the probe side.
+  auto probeInput = makeRowVector(
+      {"k"}, {makeFlatVector<int64_t>(100, [](auto row) {
+        return row % 10 == 0 ? 1 + row / 10 : 0;
+      })});
+  auto buildInput = makeRowVector(
+      {"k"}, {makeFlatVector<int64_t>(11, [](auto row) { return row; })});
+  constexpr int32_t kNumPartitions = 4;
+  auto makePlan = [&](const RowVectorPtr& input, bool isProbe) {
+    return PlanBuilder()
+        .values({input})
+        .skewedJoinPartitionedOutput(
+            {"k"},
+            kNumPartitions,
+            {"join", isProbe},
+            std::vector<std::string>{"k"},
+            GetParam())
+        .planNode();
+  };
+  auto queryCtx = createQueryContext(
+      {{core::QueryConfig::kSkewedJoinSplitFactor, "2"},
+       {core::QueryConfig::kSkewedJoinHotPartitionRatio, "2"},
+       {core::QueryConfig::kSkewedJoinDecisionBytes, "1"},
+       {core::QueryConfig::kSkewedJoinDecisionTimeoutMs, "100"}});
+  auto* serde = getNamedVectorSerde(GetParam());
+  auto countHotKeys = [&](const std::string& taskId) {
+    std::vector<int64_t> counts(kNumPartitions, 0);
+    for (auto destination = 0; destination < kNumPartitions; ++destination) {
+      for (auto& page : getAllData(taskId, destination)) {
+        SerializedPage serializedPage(std::move(page));
+        auto inputStream = serializedPage.prepareStreamForDeserialize();
+        RowVectorPtr result;
+        serde->deserialize(
+            inputStream.get(),
+            pool(),
+            ROW({"k"}, {BIGINT()}),
+            &result,
+            nullptr);
+        auto* keys = result->childAt(0)->asFlatVector<int64_t>();
+        for (auto row = 0; row < result->size(); ++row) {
+          counts[destination] += keys->valueAt(row) == 0;
+        }
+      }
+    }
+    return counts;
+  };
+  auto runTask = [&](const std::string& taskId, bool isProbe) {
+    auto plan = makePlan(isProbe ? probeInput : buildInput, isProbe);
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        queryCtx,
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+    auto counts = countHotKeys(taskId);
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return counts;
+  };
+
+  const auto probeCounts =
+      runTask("local://test-partitioned-output-skew-after-probe-p", true);
+  auto tracker = SkewedPartitionTracker::getOrCreate(
+      queryCtx, "join", kNumPartitions, 2, 2, 1);
+  ASSERT_EQ(tracker->hotPartitions().size(), 1);
+  const auto hot = tracker->hotPartitions()[0];
+  const auto other = tracker->destination(hot, 1);
+  tracker.reset();
+  EXPECT_EQ(probeCounts[hot] + probeCounts[other], 90);
+  EXPECT_GT(probeCounts[other], 0);
+
+  // The probe side operators are gone and the decision timeout has passed.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const auto buildCounts =
+      runTask("local://test-partitioned-output-skew-after-probe-b", false);
+  EXPECT_EQ(buildCounts[hot], 1);
+  EXPECT_EQ(buildCounts[other], 1);
+}
+
+TEST_P(PartitionedOutputTest, combiner) {
+  constexpr int32_t kNumBatches = 10;
+  constexpr int32_t kNumKeys = 50;
+  auto input = makeRowVector(
+      {"k", "v"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % kNumKeys; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  // The partial aggregation flushes after each batch, so each key arrives
+  // once per batch.
+  auto plan = PlanBuilder()
+                  .values({input}, false, kNumBatches)
+                  .partialAggregation({"k"}, {"sum(v)", "count(v)"})
+                  .combinedPartitionedOutput(
+                      {"k"}, 2, std::vector<std::string>{}, GetParam())
+                  .planNode();
+
+  const std::string taskId = "local://test-partitioned-output-combiner-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext(
+          {{core::QueryConfig::kMaxPartialAggregationMemory, "0"}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto* serde = getNamedVectorSerde(GetParam());
+  const auto outputType =
+      ROW({"k", "a0", "a1"}, {BIGINT(), BIGINT(), BIGINT()});
+  int32_t numRows = 0;
+  for (auto destination = 0; destination < 2; ++destination) {
+    for (auto& page : getAllData(taskId, destination)) {
+      SerializedPage serializedPage(std::move(page));
+      auto inputStream = serializedPage.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      serde->deserialize(
+          inputStream.get(), pool(), outputType, &result, nullptr);
+      auto* keys = result->childAt(0)->asFlatVector<int64_t>();
+      auto* sums = result->childAt(1)->asFlatVector<int64_t>();
+      auto* counts = result->childAt(2)->asFlatVector<int64_t>();
+      for (auto row = 0; row < result->size(); ++row) {
+        // Each batch has 20 rows of a key k with the values k + 50 * i.
+        const auto key = keys->valueAt(row);
+        ASSERT_EQ(sums->valueAt(row), kNumBatches * (20 * key + 9'500));
+        ASSERT_EQ(counts->valueAt(row), kNumBatches * 20);
+      }
+      numRows += result->size();
+    }
+  }
+  // The rows of all the batches are combined into one row per key.
+  ASSERT_EQ(numRows, kNumKeys);
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+  auto planStats = toPlanStats(task->taskStats());
+  EXPECT_EQ(
+      planStats.at(plan->id())
+          .customStats.at(PartitionedOutput::kCombinedRows)
+          .sum,
+      kNumKeys * (kNumBatches - 1));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
@@ -355,6 +355,21 @@ TEST_F(PlanNodeSerdeTest, partitionedOutput) {
                .partitionedOutput({"c0"}, 50, {"c1", {"c2"}, "c0"}, serdeKind)
                .planNode();
     testSerde(plan);
+
+    plan = PlanBuilder()
+               .values({data_})
+               .skewedJoinPartitionedOutput(
+                   {"c0"}, 50, {"join", true}, /*outputLayout=*/{}, serdeKind)
+               .planNode();
+    testSerde(plan);
+
+    plan = PlanBuilder()
+               .values({data_})
+               .partialAggregation({"c0"}, {"sum(c1)", "count(c2)"})
+               .combinedPartitionedOutput(
+                   {"c0"}, 50, /*outputLayout=*/{}, serdeKind)
+               .planNode();
+    testSerde(plan);
   }
 }
 
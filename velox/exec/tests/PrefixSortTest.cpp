@@ -41,7 +41,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      int32_t radixSortMinRows = common::PrefixSortConfig().radixSortMinRows) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -77,7 +78,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         common::PrefixSortConfig{
             1024,
             // Set threshold to 0 to enable prefix-sort in small dataset.
-            0},
+            0,
+            16,
+            radixSortMinRows},
         sortPool.get(),
         rows);
     ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
@@ -242,6 +245,41 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringKeys) {
+  // Strings that are equal in their first 16 bytes or differ only in
+  // trailing zero bytes need the tie-break on the full values.
+  const std::string longPrefix(20, 'x');
+  const auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {longPrefix + "b",
+           "a",
+           std::nullopt,
+           longPrefix + "a",
+           std::string("a\0", 2),
+           "",
+           longPrefix,
+           "b",
+           longPrefix + "a",
+           std::nullopt}),
+      makeFlatVector<Timestamp>(
+          {Timestamp(1, 0),
+           Timestamp(2, 0),
+           Timestamp(3, 0),
+           Timestamp(4, 0),
+           Timestamp(5, 0),
+           Timestamp(6, 0),
+           Timestamp(7, 0),
+           Timestamp(8, 0),
+           Timestamp(0, 0),
+           Timestamp(0, 0)}),
+  });
+
+  testPrefixSort({kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kDesc}, data);
+  testPrefixSort({kAsc, kDesc}, data);
+  testPrefixSort({kDesc, kAsc}, data);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -295,6 +333,41 @@ TEST_F(PrefixSortTest, fuzzMulti) {
   }
 }
 
+TEST_F(PrefixSortTest, radixSort) {
+  std::vector<TypePtr> keyTypes = {
+      INTEGER(),
+      SMALLINT(),
+      BIGINT(),
+      DECIMAL(25, 6),
+      REAL(),
+      DOUBLE(),
+      TIMESTAMP(),
+      VARCHAR()};
+
+  VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+
+  for (auto i = 0; i < 10; ++i) {
+    auto type1 = fuzzer.randType(keyTypes, 0);
+    auto type2 = fuzzer.randType(keyTypes, 0);
+
+    SCOPED_TRACE(fmt::format("{}, {}", type1->toString(), type2->toString()));
+    auto data = fuzzer.fuzzRow(ROW({type1, type2, VARCHAR()}));
+
+    testPrefixSort({kAsc, kAsc}, data, 0);
+    testPrefixSort({kDesc, kAsc}, data, 0);
+    // A non-normalized key breaks the ties of the radix sort.
+    testPrefixSort({kAsc, kDesc, kAsc}, data, 0);
+  }
+
+  // Few distinct keys give large ranges of equal key bytes.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row % 1'000; }),
+  });
+  testPrefixSort({kAsc}, data, 0);
+  testPrefixSort({kDesc, kAsc}, data, 0);
+}
+
 TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   // Test the normalizedKeySize doesn't exceed the MaxNormalizedKeySize.
   // The normalizedKeySize for BIGINT should be 8 + 1.
@@ -325,5 +398,37 @@ TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   ASSERT_EQ(sortLayoutTwoKeys.prefixOffsets[0], 0);
   ASSERT_EQ(sortLayoutTwoKeys.prefixOffsets[1], 9);
 }
+
+TEST_F(PrefixSortTest, stringKeyLayout) {
+  const std::vector<CompareFlags> compareFlags = {kAsc, kDesc, kAsc};
+
+  // No keys are normalized after a string key.
+  auto sortLayout = PrefixSortLayout::makeSortLayout(
+      {BIGINT(), VARCHAR(), BIGINT()}, compareFlags, 128, 16);
+  ASSERT_EQ(sortLayout.numNormalizedKeys, 2);
+  ASSERT_EQ(sortLayout.nonPrefixSortStartIndex, 1);
+  ASSERT_EQ(sortLayout.stringPrefixLength, 16);
+  ASSERT_TRUE(sortLayout.hasNonNormalizedKey);
+  ASSERT_EQ(sortLayout.prefixOffsets[1], 9);
+  ASSERT_EQ(sortLayout.normalizedBufferSize, 32);
+
+  // The string prefix is truncated to the space left in the normalized key.
+  sortLayout = PrefixSortLayout::makeSortLayout(
+      {BIGINT(), VARBINARY(), BIGINT()}, compareFlags, 20, 16);
+  ASSERT_EQ(sortLayout.numNormalizedKeys, 2);
+  ASSERT_EQ(sortLayout.stringPrefixLength, 10);
+
+  // No space left for the string key.
+  sortLayout = PrefixSortLayout::makeSortLayout(
+      {BIGINT(), VARCHAR(), BIGINT()}, compareFlags, 10, 16);
+  ASSERT_EQ(sortLayout.numNormalizedKeys, 1);
+  ASSERT_EQ(sortLayout.nonPrefixSortStartIndex, 1);
+  ASSERT_EQ(sortLayout.stringPrefixLength, 0);
+
+  // String keys are not normalized with a zero prefix length.
+  sortLayout = PrefixSortLayout::makeSortLayout(
+      {VARCHAR(), BIGINT()}, compareFlags, 128, 0);
+  ASSERT_FALSE(sortLayout.hasNormalizedKeys);
+}
 } // namespace
 } // namespace facebook::velox::exec::prefixsort::test
@@ -2290,3 +2290,116 @@ TEST_F(RowContainerTest, customComparisonRow) {
             expectedOrder, BIGINT_TYPE_WITH_CUSTOM_COMPARISON())});
       });
 }
+
+TEST_F(RowContainerTest, coldDependents) {
+  const std::vector<TypePtr> dependentTypes{
+      BIGINT(), VARCHAR(), ARRAY(INTEGER()), HUGEINT(), BOOLEAN()};
+  auto makeContainer = [&](int32_t coldPayloadMinBytes) {
+    return std::make_unique<RowContainer>(
+        std::vector<TypePtr>{BIGINT()}, // keyTypes
+        false, // nullableKeys
+        std::vector<Accumulator>{},
+        dependentTypes,
+        true, // hasNext
+        true, // isJoinBuild
+        true, // hasProbedFlag
+        false, // hasNormalizedKey
+        pool_.get(),
+        coldPayloadMinBytes);
+  };
+  auto rowContainer = makeContainer(16);
+  ASSERT_FALSE(rowContainer->isColdColumn(0));
+  for (auto i = 1; i <= dependentTypes.size(); ++i) {
+    ASSERT_TRUE(rowContainer->isColdColumn(i));
+  }
+  // The dependents are below the threshold.
+  ASSERT_FALSE(makeContainer(1'000)->isColdColumn(1));
+  ASSERT_LT(rowContainer->fixedRowSize(), makeContainer(0)->fixedRowSize());
+
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 10; }, nullEvery(7)),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return std::string(row % 31, 'a' + row % 26); },
+          nullEvery(5)),
+      makeArrayVector<int32_t>(
+          size,
+          [](auto row) { return row % 5; },
+          [](auto row) { return row; },
+          nullEvery(11)),
+      makeFlatVector<int128_t>(
+          size, [](auto row) { return HugeInt::build(row, row); }),
+      makeFlatVector<bool>(
+          size, [](auto row) { return row % 3 == 0; }, nullEvery(13)),
+  });
+
+  std::vector<char*> rows(size);
+  for (auto i = 0; i < size; ++i) {
+    rows[i] = rowContainer->newRow();
+  }
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    DecodedVector decoded(*input->childAt(column));
+    if (column % 2 == 0) {
+      rowContainer->store(decoded, folly::Range(rows.data(), size), column);
+    } else {
+      for (auto i = 0; i < size; ++i) {
+        rowContainer->store(decoded, i, rows[i], column);
+      }
+    }
+  }
+  ASSERT_GT(*rowContainer->estimateRowSize(), rowContainer->fixedRowSize());
+
+  auto assertColumns = [&](const std::vector<char*>& resultRows,
+                           const RowVectorPtr& expected) {
+    for (auto column = 0; column < expected->childrenSize(); ++column) {
+      auto result = BaseVector::create(
+          expected->childAt(column)->type(), resultRows.size(), pool());
+      rowContainer->extractColumn(
+          resultRows.data(), resultRows.size(), column, result);
+      assertEqualVectors(expected->childAt(column), result);
+    }
+  };
+  assertColumns(rows, input);
+
+  // Extract every third row in reverse order by row number.
+  std::vector<vector_size_t> rowNumbers;
+  for (auto i = size - 1; i >= 0; i -= 3) {
+    rowNumbers.push_back(i);
+  }
+  auto expectedIndices = makeIndices(rowNumbers);
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    auto result = BaseVector::create(
+        input->childAt(column)->type(), rowNumbers.size(), pool());
+    rowContainer->extractColumn(
+        rows.data(),
+        folly::Range<const vector_size_t*>(
+            rowNumbers.data(), rowNumbers.size()),
+        column,
+        0,
+        result);
+    assertEqualVectors(
+        wrapInDictionary(
+            expectedIndices, rowNumbers.size(), input->childAt(column)),
+        result);
+  }
+
+  // Erase the first half of the rows and store the second half of 'input'
+  // into new rows, which reuse the erased rows and their cold records.
+  const auto half = size / 2;
+  rowContainer->eraseRows(folly::Range(rows.data(), half));
+  std::vector<char*> newRows(half);
+  for (auto i = 0; i < half; ++i) {
+    newRows[i] = rowContainer->newRow();
+  }
+  auto secondHalf = std::dynamic_pointer_cast<RowVector>(
+      input->slice(half, half));
+  for (auto column = 0; column < secondHalf->childrenSize(); ++column) {
+    DecodedVector decoded(*secondHalf->childAt(column));
+    rowContainer->store(decoded, folly::Range(newRows.data(), half), column);
+  }
+  assertColumns(newRows, secondHalf);
+  rowContainer->checkConsistency();
+}
@@ -137,6 +137,36 @@ TEST_F(RowNumberTest, noPartitionKeys) {
 
   testLimit(1);
   testLimit(50);
+  // The limit is reached in the second batch.
+  testLimit(1'500);
+}
+
+TEST_F(RowNumberTest, clusteredPartitions) {
+  // Runs of rows of the same partition which cross the batch boundaries. The
+  // partitions repeat after 10 runs.
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 3; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) / 70 % 10; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  auto plan = PlanBuilder().values(data).rowNumber({"c0"}).planNode();
+  assertQuery(plan, "SELECT *, row_number() over (partition by c0) FROM tmp");
+
+  for (auto limit : {1, 50, 100, 250}) {
+    plan = PlanBuilder().values(data).rowNumber({"c0"}, limit).planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by c0) as rn FROM tmp) "
+            "WHERE rn <= {}",
+            limit));
+  }
 }
 
 TEST_F(RowNumberTest, largeInput) {
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SkewedPartitionTracker.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::exec::test {
+
+TEST(SkewedPartitionTrackerTest, decideOnBytes) {
+  SkewedPartitionTracker tracker(4, 2, 2.0, 1'000);
+  ContinueFuture future;
+  ASSERT_FALSE(tracker.decided(&future));
+  ASSERT_FALSE(future.isReady());
+
+  tracker.addProbeBytes({100, 500, 100, 100});
+  ASSERT_FALSE(tracker.decided());
+  ASSERT_FALSE(tracker.isSplit(1));
+  ASSERT_EQ(tracker.numHotPartitions(), 0);
+
+  // Partition 1 has more than twice the average of 250 bytes.
+  tracker.addProbeBytes({0, 200, 0, 0});
+  ASSERT_TRUE(tracker.decided());
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(tracker.hotPartitions(), std::vector<int32_t>{1});
+  ASSERT_TRUE(tracker.isSplit(1));
+  ASSERT_FALSE(tracker.isSplit(0));
+  ASSERT_EQ(tracker.destination(1, 0), 1);
+  ASSERT_EQ(tracker.destination(1, 1), 2);
+  ASSERT_EQ(tracker.destination(3, 1), 0);
+
+  // The decision is final.
+  tracker.addProbeBytes({10'000, 0, 0, 0});
+  ASSERT_FALSE(tracker.isSplit(0));
+  ASSERT_TRUE(tracker.decided(&future));
+}
+
+TEST(SkewedPartitionTrackerTest, decideOnProbeFinished) {
+  SkewedPartitionTracker tracker(4, 2, 2.0, 1'000'000);
+  ContinueFuture future;
+  ASSERT_FALSE(tracker.decided(&future));
+  tracker.addProbeBytes({0, 0, 0, 10});
+  ASSERT_FALSE(future.isReady());
+  tracker.probeFinished();
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(tracker.hotPartitions(), std::vector<int32_t>{3});
+
+  // No probe bytes means no hot partitions.
+  SkewedPartitionTracker empty(4, 2, 2.0, 1'000'000);
+  empty.probeFinished();
+  ASSERT_TRUE(empty.decided());
+  ASSERT_EQ(empty.numHotPartitions(), 0);
+}
+
+TEST(SkewedPartitionTrackerTest, timeoutWithoutProbe) {
+  SkewedPartitionTracker tracker(4, 2, 2.0, 1'000, 100);
+  ContinueFuture future;
+  ASSERT_FALSE(tracker.decided(&future));
+
+  // The future is realized on timeout and the next check fails since no probe
+  // side has registered.
+  future.wait();
+  VELOX_ASSERT_THROW(
+      tracker.decided(&future),
+      "No probe side of the skewed join in this process");
+  ASSERT_FALSE(tracker.decided());
+
+  // With a probe side the wait is not bounded by the timeout.
+  SkewedPartitionTracker withProbe(4, 2, 2.0, 1'000, 100);
+  withProbe.addProbe();
+  withProbe.addProbeBytes({0, 900, 0, 0});
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_FALSE(withProbe.decided(&future));
+  future.wait(std::chrono::milliseconds(200));
+  ASSERT_FALSE(future.isReady());
+
+  // The probe side decides after the timeout and the build side sees the
+  // split partition.
+  withProbe.addProbeBytes({0, 900, 0, 0});
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(withProbe.decided(&future));
+  ASSERT_EQ(withProbe.hotPartitions(), std::vector<int32_t>{1});
+}
+
+TEST(SkewedPartitionTrackerTest, getOrCreate) {
+  memory::MemoryManager::testingSetInstance({});
+  auto queryCtx = core::QueryCtx::create(
+      nullptr, core::QueryConfig{{}}, {}, nullptr, nullptr, nullptr, "query");
+  auto tracker =
+      SkewedPartitionTracker::getOrCreate(queryCtx, "join", 8, 4, 2.0, 100);
+  ASSERT_EQ(
+      tracker,
+      SkewedPartitionTracker::getOrCreate(queryCtx, "join", 8, 4, 2.0, 100));
+  ASSERT_NE(
+      tracker,
+      SkewedPartitionTracker::getOrCreate(queryCtx, "join2", 8, 4, 2.0, 100));
+  ASSERT_EQ(tracker->splitFactor(), 4);
+
+  // The decision is kept after the operators are gone, as long as the query
+  // runs.
+  tracker->probeFinished();
+  tracker.reset();
+  tracker =
+      SkewedPartitionTracker::getOrCreate(queryCtx, "join", 8, 4, 2.0, 100);
+  ASSERT_TRUE(tracker->decided());
+
+  // A new tracker is made for a new query with the same id.
+  tracker.reset();
+  queryCtx = core::QueryCtx::create(
+      nullptr, core::QueryConfig{{}}, {}, nullptr, nullptr, nullptr, "query");
+  tracker =
+      SkewedPartitionTracker::getOrCreate(queryCtx, "join", 8, 4, 2.0, 100);
+  ASSERT_FALSE(tracker->decided());
+}
+
+} // namespace facebook::velox::exec::test
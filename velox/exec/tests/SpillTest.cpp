@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -232,7 +233,9 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
         compressionKind_,
         prefixSortConfig,
         pool(),
-        &spillStats_);
+        &spillStats_,
+        "",
+        writeExecutor_.get());
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(spillStats_.rlock()->spilledPartitions, 0);
@@ -361,6 +364,9 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
     // resulting in 0us total write time.
     ASSERT_GE(stats.spillWriteTimeNanos, 0);
     ASSERT_GE(stats.spillFlushTimeNanos, 0);
+    if (writeExecutor_ == nullptr) {
+      ASSERT_EQ(stats.spillWriteStallTimeNanos, 0);
+    }
     ASSERT_GT(stats.spilledRows, 0);
     // NOTE: the following stats are not collected by spill state.
     ASSERT_EQ(stats.spillFillTimeNanos, 0);
@@ -469,7 +475,8 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
             "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
             "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
-            "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[0] "
+            "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] spillWriteStallTimeNanos[{}] "
+            "maxSpillExceededLimitCount[0] "
             "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
             "spillReadDeserializationTimeNanos[{}]",
             finalStats.spillRuns,
@@ -485,6 +492,7 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             finalStats.spillWrites,
             succinctNanos(finalStats.spillFlushTimeNanos),
             succinctNanos(finalStats.spillWriteTimeNanos),
+            succinctNanos(finalStats.spillWriteStallTimeNanos),
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctNanos(finalStats.spillReadTimeNanos),
@@ -506,6 +514,8 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
   std::vector<std::vector<RowVectorPtr>> batchesByPartition_;
   std::string fileNamePrefix_;
   folly::Synchronized<common::SpillStats> spillStats_;
+  // Set to run the spill file writes in the background.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> writeExecutor_;
   std::unique_ptr<SpillState> state_;
   std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
   std::unique_ptr<TestRuntimeStatWriter> statWriter_;
@@ -591,6 +601,228 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, remoteSpillTier) {
+  // Uses a second local directory as the remote spill directory.
+  auto localDirectory = exec::test::TempDirectoryPath::create();
+  auto remoteDirectory = exec::test::TempDirectoryPath::create();
+  bool useRemote{false};
+  const common::RemoteSpillConfig remoteSpillConfig{
+      [&]() -> std::string_view { return remoteDirectory->getPath(); },
+      [&]() { return useRemote; },
+      1 << 20,
+      2 << 20};
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  SpillState state(
+      [&]() -> const std::string& { return localDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      {},
+      kGB,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_,
+      "",
+      nullptr,
+      remoteSpillConfig);
+  state.setPartitionSpilled(0);
+  state.appendToPartition(
+      0, makeRowVector({makeFlatVector<int64_t>(10, folly::identity)}));
+  // The open local file is closed and the next write goes to a remote file.
+  useRemote = true;
+  state.appendToPartition(
+      0, makeRowVector({makeFlatVector<int64_t>(10, [](auto row) {
+        return 10 + row;
+      })}));
+  state.finishFile(0);
+
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), 2);
+  ASSERT_EQ(files[0].path.find(localDirectory->getPath()), 0);
+  ASSERT_EQ(files[0].readBufferSize, 0);
+  ASSERT_EQ(files[1].path.find(remoteDirectory->getPath()), 0);
+  ASSERT_EQ(files[1].readBufferSize, 2 << 20);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  for (auto i = 0; i < 20; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, columnarFormat) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return i * 100 + row; }, nullEvery(7)),
+        makeFlatVector<std::string>(
+            100,
+            [&](auto row) { return fmt::format("value {}", row % 13); },
+            nullEvery(5)),
+        makeFlatVector<double>(100, [&](auto row) { return row * 0.5; }),
+    }));
+  }
+  const std::vector<column_index_t> projection{2, 0};
+
+  for (bool columnar : {false, true}) {
+    SCOPED_TRACE(fmt::format("columnar: {}", columnar));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        {},
+        kGB,
+        0,
+        compressionKind_,
+        std::nullopt,
+        pool(),
+        &spillStats_,
+        "",
+        nullptr,
+        std::nullopt,
+        columnar);
+    state.setPartitionSpilled(0);
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    state.finishFile(0);
+    const auto files = state.finish(0);
+    ASSERT_EQ(files.size(), 1);
+    ASSERT_EQ(files[0].columnar, columnar);
+
+    auto readBatches = [&](const std::vector<column_index_t>& columns) {
+      SpillPartition partition(SpillPartitionId{0, 0}, files);
+      auto reader = partition.createUnorderedReader(
+          1 << 20, pool(), &spillStats_, columns);
+      std::vector<RowVectorPtr> result;
+      RowVectorPtr output;
+      while (reader->nextBatch(output)) {
+        result.push_back(output);
+        output = nullptr;
+      }
+      return result;
+    };
+
+    auto concat = [&](const std::vector<RowVectorPtr>& vectors) {
+      auto result =
+          BaseVector::create<RowVector>(vectors[0]->type(), 0, pool());
+      for (const auto& vector : vectors) {
+        result->append(vector.get());
+      }
+      return result;
+    };
+    const auto expected = concat(batches);
+    facebook::velox::test::assertEqualVectors(
+        expected, concat(readBatches({})));
+
+    const auto projected = concat(readBatches(projection));
+    ASSERT_EQ(projected->type()->toString(), "ROW<c2:DOUBLE,c0:BIGINT>");
+    for (auto i = 0; i < projection.size(); ++i) {
+      facebook::velox::test::assertEqualVectors(
+          expected->childAt(projection[i]), projected->childAt(i));
+    }
+  }
+}
+
+TEST_P(SpillTest, mergeNormalizedKeys) {
+  // The merge compares the leading sort keys on their PrefixSort encoding.
+  // The string keys share a prefix longer than the encoded prefix, so their
+  // ties are broken by comparing the columns.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const std::vector<CompareFlags> compareFlags = {
+      {true, true}, {false, false}};
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      2,
+      compareFlags,
+      1024,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_);
+  const int partitionIndex = 0;
+  state.setPartitionSpilled(partitionIndex);
+
+  const vector_size_t numRows = 1'000;
+  const int numFiles = 3;
+  for (auto file = 0; file < numFiles; ++file) {
+    // Sorted by c0 ascending with nulls first, then c1 descending.
+    auto data = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows,
+            [&](auto row) { return (row + file) / 10; },
+            [](auto row) { return row < 5; }),
+        makeFlatVector<std::string>(
+            numRows,
+            [&](auto row) {
+              return fmt::format(
+                  "a string prefix longer than the normalized key {:03}",
+                  999 - (row + file) % 10);
+            }),
+    });
+    state.appendToPartition(partitionIndex, data);
+    state.finishFile(partitionIndex);
+  }
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  ASSERT_TRUE(merge != nullptr);
+
+  std::optional<int64_t> previousKey;
+  std::string previousString;
+  for (auto i = 0; i < numRows * numFiles; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    const auto index = stream->currentIndex();
+    std::optional<int64_t> key;
+    if (!stream->decoded(0).isNullAt(index)) {
+      key = stream->decoded(0).valueAt<int64_t>(index);
+    }
+    const auto string = stream->decoded(1).valueAt<StringView>(index).str();
+    if (i > 0) {
+      if (!previousKey.has_value() || !key.has_value()) {
+        ASSERT_TRUE(!previousKey.has_value() || key.has_value()) << i;
+        if (!previousKey.has_value() && !key.has_value()) {
+          ASSERT_GE(previousString, string) << i;
+        }
+      } else {
+        ASSERT_LE(previousKey.value(), key.value()) << i;
+        if (previousKey == key) {
+          ASSERT_GE(previousString, string) << i;
+        }
+      }
+    }
+    previousKey = key;
+    previousString = string;
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -610,6 +842,18 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 8, 8, {}, 8 * 2);
 }
 
+TEST_P(SpillTest, asyncWrite) {
+  // The files and the data read back are the same as with synchronous writes.
+  writeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {CompareFlags{false, false}}, 8);
+  spillStateTest(kGB, 2, 8, 1, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{true, false}}, 8 * 2);
+  spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+  state_.reset();
+  writeExecutor_.reset();
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
@@ -1320,6 +1320,41 @@ TEST_P(HashJoinBuildOnly, spillPartition) {
   VELOX_ASSERT_THROW(spiller_->spill(RowContainerIterator{}), "");
 }
 
+TEST_P(HashJoinBuildOnly, spillSomePartitions) {
+  if (numPartitions_ < 2) {
+    return;
+  }
+  setupSpillData(numKeys_, 1'000, 1, nullptr, {});
+  std::vector<std::vector<RowVectorPtr>> vectorsByPartition(numPartitions_);
+  HashPartitionFunction spillHashFunction(hashBits_, rowType_, keyChannels_);
+  splitByPartition(rowVector_, spillHashFunction, vectorsByPartition);
+  setupSpiller(100'000, 0, false);
+
+  const auto partitionBytes = spiller_->partitionRowBytes();
+  ASSERT_EQ(partitionBytes.size(), numPartitions_);
+  const uint32_t spillPartition =
+      std::max_element(partitionBytes.begin(), partitionBytes.end()) -
+      partitionBytes.begin();
+  ASSERT_GT(partitionBytes[spillPartition], 0);
+  const auto numRows = rowContainer_->numRows();
+  const auto numSpillRows = vectorsByPartition[spillPartition].back()->size();
+
+  const SpillPartitionNumSet spillPartitions{spillPartition};
+  spiller_->spill(spillPartitions);
+  ASSERT_TRUE(spiller_->isSpilled(spillPartition));
+  ASSERT_FALSE(spiller_->isAllSpilled());
+  ASSERT_EQ(spiller_->spilledPartitionSet(), spillPartitions);
+  // The spilled rows are erased and the other rows stay in memory.
+  ASSERT_EQ(rowContainer_->numRows(), numRows - numSpillRows);
+  const auto remainingBytes = spiller_->partitionRowBytes();
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    ASSERT_EQ(
+        remainingBytes[partition],
+        partition == spillPartition ? 0 : partitionBytes[partition]);
+  }
+  verifyNonSortedSpillData(spillPartitions, vectorsByPartition);
+}
+
 TEST_P(HashJoinBuildOnly, writeBufferSize) {
   std::vector<uint64_t> writeBufferSizes = {0, 4'000'000'000};
   for (const auto writeBufferSize : writeBufferSizes) {
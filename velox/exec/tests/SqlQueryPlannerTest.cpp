@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/SqlQueryPlanner.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class SqlQueryPlannerTest : public OperatorTestBase {
+ protected:
+  static constexpr double kScaleFactor = 0.01;
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    connector::registerConnectorFactory(
+        std::make_shared<connector::tpch::TpchConnectorFactory>());
+    auto tpchConnector =
+        connector::getConnectorFactory(
+            connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+            ->newConnector(
+                std::string(PlanBuilder::kTpchDefaultConnectorId),
+                std::make_shared<config::ConfigBase>(
+                    std::unordered_map<std::string, std::string>()));
+    connector::registerConnector(tpchConnector);
+
+    planner_ = std::make_unique<SqlQueryPlanner>(pool());
+    planner_->registerTpchTables(kScaleFactor, 2);
+    for (auto table :
+         {tpch::Table::TBL_NATION,
+          tpch::Table::TBL_REGION,
+          tpch::Table::TBL_SUPPLIER,
+          tpch::Table::TBL_CUSTOMER}) {
+      const auto type = tpch::getTableSchema(table);
+      auto data = AssertQueryBuilder(PlanBuilder()
+                                         .tpchTableScan(
+                                             table,
+                                             std::vector<std::string>(
+                                                 type->names()),
+                                             kScaleFactor)
+                                         .planNode())
+                      .split(exec::Split(
+                          std::make_shared<connector::tpch::TpchConnectorSplit>(
+                              std::string(
+                                  PlanBuilder::kTpchDefaultConnectorId))))
+                      .copyResults(pool());
+      createDuckDbTable(std::string(tpch::toTableName(table)), {data});
+    }
+  }
+
+  void TearDown() override {
+    planner_.reset();
+    connector::unregisterConnector(
+        std::string(PlanBuilder::kTpchDefaultConnectorId));
+    connector::unregisterConnectorFactory(
+        connector::tpch::TpchConnectorFactory::kTpchConnectorName);
+    OperatorTestBase::TearDown();
+  }
+
+  // Runs 'sql' with Velox and DuckDB and compares the results. Checks the
+  // order of the results on 'sortingKeys' if given.
+  void assertSql(
+      const std::string& sql,
+      const std::optional<std::vector<uint32_t>>& sortingKeys = std::nullopt) {
+    SCOPED_TRACE(sql);
+    auto plan = planner_->plan(sql);
+    AssertQueryBuilder builder(plan.plan, duckDbQueryRunner_);
+    for (auto& [nodeId, splits] : plan.splits) {
+      builder.splits(nodeId, std::move(splits));
+    }
+    builder.assertResults(sql, sortingKeys);
+  }
+
+  std::unique_ptr<SqlQueryPlanner> planner_;
+};
+
+TEST_F(SqlQueryPlannerTest, scan) {
+  assertSql("SELECT * FROM nation");
+  assertSql("SELECT n_name, n_regionkey FROM nation WHERE n_nationkey < 10");
+  assertSql("SELECT n_nationkey * 2 AS k, upper(n_name) FROM nation");
+  assertSql("SELECT count(*) FROM customer");
+}
+
+TEST_F(SqlQueryPlannerTest, aggregation) {
+  assertSql(
+      "SELECT c_nationkey, count(*), sum(c_acctbal), max(c_acctbal) - "
+      "min(c_acctbal) FROM customer GROUP BY c_nationkey");
+  assertSql(
+      "SELECT c_mktsegment, avg(c_acctbal * 2) AS a FROM customer "
+      "GROUP BY 1 HAVING count(*) > 250");
+  assertSql(
+      "SELECT c_nationkey % 5 AS bucket, count(*) FILTER (WHERE c_acctbal > 0) "
+      "FROM customer GROUP BY c_nationkey % 5");
+  assertSql("SELECT count(DISTINCT c_nationkey) FROM customer");
+  assertSql("SELECT DISTINCT c_mktsegment FROM customer");
+}
+
+TEST_F(SqlQueryPlannerTest, join) {
+  assertSql(
+      "SELECT n_name, r_name FROM nation, region "
+      "WHERE n_regionkey = r_regionkey AND r_name <> 'ASIA'");
+  assertSql(
+      "SELECT n.n_name, count(*) FROM customer c, nation n, region r "
+      "WHERE c.c_nationkey = n.n_nationkey AND n.n_regionkey = r.r_regionkey "
+      "AND r.r_name = 'EUROPE' AND c.c_acctbal > 1000 GROUP BY n.n_name");
+  assertSql(
+      "SELECT s_name, n_name FROM supplier JOIN nation "
+      "ON s_nationkey = n_nationkey AND s_acctbal > n_nationkey * 100");
+  assertSql(
+      "SELECT r_name, n_name FROM region LEFT JOIN nation "
+      "ON r_regionkey = n_regionkey AND n_name LIKE 'A%'");
+  assertSql("SELECT n_name, r_name FROM nation, region WHERE n_nationkey < 3");
+}
+
+TEST_F(SqlQueryPlannerTest, orderBy) {
+  assertSql("SELECT n_name FROM nation ORDER BY n_name DESC", {{0}});
+  assertSql(
+      "SELECT n_name, n_nationkey FROM nation ORDER BY 2 LIMIT 5", {{1}});
+  assertSql(
+      "SELECT n_name FROM nation ORDER BY n_nationkey LIMIT 5 OFFSET 10");
+  assertSql(
+      "SELECT c_nationkey, sum(c_acctbal) AS total FROM customer "
+      "GROUP BY c_nationkey ORDER BY total DESC LIMIT 3",
+      {{1}});
+  assertSql("SELECT n_name FROM nation LIMIT 100");
+}
+
+TEST_F(SqlQueryPlannerTest, unsupported) {
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT * FROM nation WHERE n_nationkey IN "
+                     "(SELECT r_regionkey FROM region)"),
+      "Subqueries are not supported");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT n_name FROM nation ORDER BY "
+                     "(SELECT max(r_regionkey) FROM region)"),
+      "Subqueries are not supported");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT count(*) FROM nation GROUP BY "
+                     "(SELECT max(r_regionkey) FROM region)"),
+      "Subqueries are not supported");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT n_name FROM nation JOIN region "
+                     "ON n_regionkey = (SELECT max(r_regionkey) FROM region)"),
+      "Subqueries are not supported");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT n_name FROM nation ORDER BY "
+                     "row_number() OVER (ORDER BY n_name)"),
+      "Window functions are not supported");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT * FROM nation a, nation b"),
+      "Column n_nationkey is in more than one table");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT * FROM orders2"), "Unknown table: orders2");
+  VELOX_ASSERT_THROW(
+      planner_->plan("SELECT 1 UNION ALL SELECT 2"),
+      "Set operations are not supported");
+  VELOX_ASSERT_THROW(planner_->plan("SELEC 1"), "Cannot parse query");
+}
+
+} // namespace
@@ -34,6 +34,7 @@
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TableScan.h"
@@ -426,6 +427,156 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, sortedSplitsPartialAggregation) {
+  // Each file is sorted by (c0, c1). The same groups appear in all files.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row / 100; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row / 10 % 10; }),
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 3; ++i) {
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vector});
+  }
+  createDuckDbTable({vector, vector, vector});
+
+  ColumnHandleMap assignments = {
+      {"a", regularColumn("c1", INTEGER())},
+      {"b", regularColumn("c0", BIGINT())},
+      {"c", regularColumn("c2", BIGINT())}};
+  auto outputType = ROW({"a", "b", "c"}, {INTEGER(), BIGINT(), BIGINT()});
+
+  auto makePlan = [&](std::vector<std::string> sortedColumns,
+                      core::PlanNodeId& aggregationId) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFilters{},
+        nullptr,
+        nullptr,
+        std::unordered_map<std::string, std::string>{},
+        std::move(sortedColumns));
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(outputType)
+        .tableHandle(tableHandle)
+        .assignments(assignments)
+        .endTableScan()
+        .filter("c % 3 <> 0")
+        .partialAggregation({"a", "b"}, {"sum(c)", "count(1)"})
+        .capturePlanNodeId(aggregationId)
+        .finalAggregation()
+        .planNode();
+  };
+  const std::string sql =
+      "SELECT c1, c0, sum(c2), count(1) FROM tmp WHERE c2 % 3 <> 0 "
+      "GROUP BY 1, 2";
+
+  // The grouping keys are the leading sorted columns. The partial aggregation
+  // streams and has no hash table.
+  for (const auto& sortedColumns :
+       {std::vector<std::string>{"c0", "c1"},
+        std::vector<std::string>{"c0", "c1", "c2"}}) {
+    core::PlanNodeId aggregationId;
+    auto task =
+        assertQuery(makePlan(sortedColumns, aggregationId), filePaths, sql);
+    auto stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+    ASSERT_EQ(0, stats.count(BaseHashTable::kCapacity));
+  }
+
+  // The grouping keys are not a prefix of the sorted columns.
+  for (const auto& sortedColumns :
+       {std::vector<std::string>{"c0"},
+        std::vector<std::string>{"c0", "c2"},
+        std::vector<std::string>{}}) {
+    core::PlanNodeId aggregationId;
+    auto task =
+        assertQuery(makePlan(sortedColumns, aggregationId), filePaths, sql);
+    auto stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+    ASSERT_EQ(1, stats.count(BaseHashTable::kCapacity));
+  }
+}
+
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // The files are in descending order of c0, so that the top rows by c0 DESC
+  // are all in the first file.
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (2 - i) * 1'000 + row; }),
+        makeFlatVector<double>(
+            1'000,
+            [&](auto row) { return row % 100 * 0.5 - i; },
+            nullEvery(7)),
+        makeFlatVector<Timestamp>(
+            1'000,
+            [&](auto row) { return Timestamp((2 - i) * 1'000 + row, 0); }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  const auto outputType =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), DOUBLE(), TIMESTAMP()});
+  auto runTopN = [&](const std::vector<std::string>& keys,
+                     const std::string& sql,
+                     bool enabled) {
+    SCOPED_TRACE(fmt::format("{} {}", fmt::join(keys, ", "), enabled));
+    core::PlanNodeId scanId;
+    core::PlanNodeId topNId;
+    auto plan = PlanBuilder()
+                    .tableScan(outputType)
+                    .capturePlanNodeId(scanId)
+                    .filter("c0 % 5 <> 0")
+                    .topN(keys, 10, false)
+                    .capturePlanNodeId(topNId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kTopNDynamicFilterEnabled,
+                        enabled ? "true" : "false")
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .assertResults(sql);
+    auto planStats = toPlanStats(task->taskStats());
+    return std::make_pair(
+        planStats.at(scanId).outputRows,
+        planStats.at(topNId).customStats.count("dynamicFiltersProduced"));
+  };
+
+  for (const auto& [keys, sql] :
+       std::vector<std::pair<std::vector<std::string>, std::string>>{
+           {{"c0 DESC"},
+            "SELECT * FROM tmp WHERE c0 % 5 <> 0 ORDER BY c0 DESC LIMIT 10"},
+           {{"c2 DESC", "c1"},
+            "SELECT * FROM tmp WHERE c0 % 5 <> 0 "
+            "ORDER BY c2 DESC, c1 LIMIT 10"}}) {
+    // The files after the first one are skipped by the dynamic filter.
+    auto [scanRows, numFilterStats] = runTopN(keys, sql, true);
+    ASSERT_LT(scanRows, 3'000);
+    ASSERT_EQ(numFilterStats, 1);
+
+    std::tie(scanRows, numFilterStats) = runTopN(keys, sql, false);
+    ASSERT_EQ(scanRows, 3'000);
+    ASSERT_EQ(numFilterStats, 0);
+  }
+
+  // Nulls first and last on a double key with ties on the first key.
+  for (const auto& order :
+       {"ASC NULLS FIRST", "ASC NULLS LAST", "DESC NULLS LAST"}) {
+    runTopN(
+        {fmt::format("c1 {}", order), "c0"},
+        fmt::format(
+            "SELECT * FROM tmp WHERE c0 % 5 <> 0 ORDER BY c1 {}, c0 LIMIT 10",
+            order),
+        true);
+  }
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1581,6 +1732,170 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, largestSplitFirst) {
+  // File i has the value i in all its rows.
+  const std::vector<vector_size_t> numRows = {10, 10'000, 1'000};
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < numRows.size(); ++i) {
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(
+        filePaths.back()->getPath(),
+        makeRowVector({makeFlatVector<int64_t>(
+            numRows[i], [&](auto /*row*/) { return i; })}));
+  }
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tableScan(ROW({"c0"}, {BIGINT()}))
+                  .capturePlanNodeId(scanId)
+                  .planNode();
+
+  for (const bool largestFirst : {false, true}) {
+    SCOPED_TRACE(fmt::format("largestFirst {}", largestFirst));
+    auto task = Task::create(
+        "t",
+        core::PlanFragment{plan},
+        0,
+        core::QueryCtx::create(
+            nullptr,
+            core::QueryConfig(
+                {{core::QueryConfig::kLargestSplitFirst,
+                  largestFirst ? "true" : "false"},
+                 {core::QueryConfig::kMaxSplitPreloadPerDriver, "0"}})),
+        Task::ExecutionMode::kSerial);
+    for (const auto& filePath : filePaths) {
+      const auto& path = filePath->getPath();
+      auto split = makeHiveConnectorSplit(path, 0, fs::file_size(path));
+      ASSERT_EQ(split->estimatedCost(), fs::file_size(path));
+      task->addSplit(scanId, exec::Split(std::move(split)));
+    }
+    task->noMoreSplits(scanId);
+
+    // The files in the order they are read.
+    std::vector<int64_t> files;
+    while (auto result = task->next()) {
+      auto* values =
+          result->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      for (auto row = 0; row < result->size(); ++row) {
+        if (files.empty() || files.back() != values->valueAt(row)) {
+          files.push_back(values->valueAt(row));
+        }
+      }
+    }
+    if (largestFirst) {
+      ASSERT_EQ(files, (std::vector<int64_t>{1, 2, 0}));
+    } else {
+      ASSERT_EQ(files, (std::vector<int64_t>{0, 1, 2}));
+    }
+  }
+}
+
+TEST_F(TableScanTest, topNSplitOrdering) {
+  // File i has the values of c0 in [i * 1'000, i * 1'000 + 999].
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return i * 1'000 + row; })}));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tableScan(ROW({"c0"}, {BIGINT()}))
+                  .capturePlanNodeId(scanId)
+                  .project({"c0 AS ts"})
+                  .topN({"ts DESC"}, 10, false)
+                  .planNode();
+
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    auto task = Task::create(
+        "t",
+        core::PlanFragment{plan},
+        0,
+        core::QueryCtx::create(
+            nullptr,
+            core::QueryConfig(
+                {{core::QueryConfig::kTopNSplitOrderingEnabled,
+                  enabled ? "true" : "false"},
+                 {core::QueryConfig::kTopNDynamicFilterEnabled, "true"},
+                 {core::QueryConfig::kMaxSplitPreloadPerDriver, "0"}})),
+        Task::ExecutionMode::kSerial);
+    for (auto i = 0; i < filePaths.size(); ++i) {
+      task->addSplit(
+          scanId,
+          exec::Split(HiveConnectorSplitBuilder(filePaths[i]->getPath())
+                          .columnRange(
+                              "c0",
+                              {variant(int64_t(i * 1'000)),
+                               variant(int64_t(i * 1'000 + 999)),
+                               false})
+                          .build()));
+    }
+    task->noMoreSplits(scanId);
+
+    std::vector<RowVectorPtr> results;
+    while (auto result = task->next()) {
+      results.push_back(result);
+    }
+    assertResults(
+        results,
+        asRowType(plan->outputType()),
+        "SELECT c0 FROM tmp ORDER BY c0 DESC LIMIT 10",
+        duckDbQueryRunner_);
+
+    // With the ordering, the last file is read first and the TopN dynamic
+    // filter skips the others by their column ranges.
+    ASSERT_EQ(getSkippedSplitsStat(task), enabled ? 2 : 0);
+  }
+}
+
+TEST_F(TableScanTest, adaptiveDrivers) {
+  auto filePaths = makeFilePaths(50);
+  auto vectors = makeVectors(50, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    std::string intervalMs;
+    bool adjust;
+
+    std::string debugString() const {
+      return fmt::format("intervalMs {}, adjust {}", intervalMs, adjust);
+    }
+  } testSettings[] = {// Half of the 4 Drivers start with the Task. The other
+                      // half starts as the Drivers don't block.
+                      {"0", true},
+                      // The standby Drivers start only to finish the pipeline.
+                      {"3600000", false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .maxDrivers(4)
+            .config(core::QueryConfig::kAdaptiveTableScanDriversEnabled, true)
+            .config(
+                core::QueryConfig::kAdaptiveTableScanDriversIntervalMs,
+                testData.intervalMs)
+            .assertResults("SELECT * FROM tmp");
+    const auto stats = task->taskStats();
+    EXPECT_EQ(stats.numTotalDrivers, 4);
+    if (testData.adjust) {
+      EXPECT_GT(stats.numAdaptiveDriversStarted, 0);
+      EXPECT_LE(stats.numAdaptiveDriversStarted, 2);
+    } else {
+      EXPECT_EQ(stats.numAdaptiveDriversStarted, 0);
+      EXPECT_EQ(stats.numAdaptiveDriversRetired, 0);
+    }
+  }
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -5348,3 +5663,234 @@ TEST_F(TableScanTest, rowId) {
     AssertQueryBuilder(plan).split(split).assertResults(expected);
   }
 }
+
+TEST_F(TableScanTest, aggregatePushdown) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(
+             1'000,
+             [i](auto row) { return (row * 7 + i * 13) % 1'001 - 500; },
+             nullEvery(7)),
+         makeFlatVector<std::string>(
+             1'000, [](auto row) { return fmt::format("s{}", row % 97); }),
+         makeFlatVector<double>(
+             1'000, [i](auto row) { return row * 0.5 - i; })}));
+  }
+  auto filePaths = makeFilePaths(2);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), vectors);
+  }
+  createDuckDbTable(vectors);
+
+  using Kind = connector::ScanAggregate::Kind;
+  const std::vector<connector::ScanAggregate> aggregates = {
+      {Kind::kCount, ""},
+      {Kind::kCount, "c0"},
+      {Kind::kMin, "c0"},
+      {Kind::kMax, "c0"},
+      {Kind::kMin, "c1"},
+      {Kind::kMax, "c2"},
+  };
+  auto makePlan = [&](const core::TypedExprPtr& remainingFilter) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "tmp",
+        true,
+        SubfieldFilters{},
+        remainingFilter,
+        nullptr,
+        std::unordered_map<std::string, std::string>{},
+        std::vector<std::string>{},
+        aggregates);
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(
+            ROW({"a0", "a1", "a2", "a3", "a4", "a5"},
+                {BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR(), DOUBLE()}))
+        .tableHandle(tableHandle)
+        .assignments({
+            {"c0", regularColumn("c0", BIGINT())},
+            {"c1", regularColumn("c1", VARCHAR())},
+            {"c2", regularColumn("c2", DOUBLE())},
+        })
+        .endTableScan()
+        .singleAggregation(
+            {},
+            {"sum(a0)", "sum(a1)", "min(a2)", "max(a3)", "min(a4)", "max(a5)"})
+        .planNode();
+  };
+  const std::string sql =
+      "SELECT count(*), count(c0), min(c0), max(c0), min(c1), max(c2) FROM tmp";
+
+  // Whole files are answered from the file statistics.
+  auto task = assertQuery(makePlan(nullptr), filePaths, sql);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task)
+          .at("numSplitsAggregatedFromStatistics")
+          .sum,
+      filePaths.size());
+
+  // A remaining filter needs the rows.
+  auto remainingFilter = parseExpr("c2 < 200.0", ROW({"c2"}, {DOUBLE()}));
+  task = assertQuery(
+      makePlan(remainingFilter), filePaths, sql + " WHERE c2 < 200");
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).count(
+          "numSplitsAggregatedFromStatistics"),
+      0);
+
+  // Splits of part of a file need the rows.
+  task = AssertQueryBuilder(makePlan(nullptr), duckDbQueryRunner_)
+             .splits(makeHiveConnectorSplits(
+                 filePaths[0]->getPath(), 3, dwio::common::FileFormat::DWRF))
+             .splits(makeHiveConnectorSplits(
+                 filePaths[1]->getPath(), 3, dwio::common::FileFormat::DWRF))
+             .assertResults(sql);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).count(
+          "numSplitsAggregatedFromStatistics"),
+      0);
+}
+
+TEST_F(TableScanTest, rowLimit) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePaths = makeFilePaths(5);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), vectors);
+  }
+
+  // The scan reads the 15 rows the limit needs from the first split and
+  // neither reads nor preloads the other splits.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanNodeId)
+                  .project({"c0", "c1"})
+                  .limit(5, 10, false)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  auto result = AssertQueryBuilder(plan)
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+                    .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 10);
+  auto scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+  EXPECT_EQ(scanStats.numSplits, 1);
+  EXPECT_EQ(scanStats.rawInputRows, 15);
+  EXPECT_EQ(scanStats.customStats.at("finishedAtRowLimit").sum, 15);
+  EXPECT_EQ(scanStats.customStats.count("preloadedSplits"), 0);
+
+  // A filter after the scan drops an unknown number of rows, so the scan has
+  // no row limit.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .capturePlanNodeId(scanNodeId)
+             .filter("c0 % 2 = 0")
+             .limit(0, 10, false)
+             .planNode();
+  result = AssertQueryBuilder(plan)
+               .splits(makeHiveConnectorSplits(filePaths))
+               .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 10);
+  scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+  EXPECT_EQ(scanStats.customStats.count("finishedAtRowLimit"), 0);
+}
+
+TEST_F(TableScanTest, splitResultCache) {
+  auto vectors = makeVectors(3, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  SplitResultCache cache(memory::memoryManager()->addLeafPool(), 64 << 20);
+  SplitResultCache::setInstance(&cache);
+  SCOPE_EXIT {
+    SplitResultCache::setInstance(nullptr);
+  };
+
+  auto makeSplit = [&](int64_t modificationTime) {
+    return HiveConnectorSplitBuilder(filePath->getPath())
+        .fileProperties({std::nullopt, modificationTime})
+        .build();
+  };
+  core::PlanNodeId scanNodeId;
+  auto makePlan = [&](const std::string& remainingFilter) {
+    return PlanBuilder()
+        .tableScan(rowType_, {"c0 > 0"}, remainingFilter)
+        .capturePlanNodeId(scanNodeId)
+        .planNode();
+  };
+  auto numHits = [&](const std::shared_ptr<Task>& task) {
+    const auto& stats =
+        toPlanStats(task->taskStats()).at(scanNodeId).customStats;
+    auto it = stats.find("splitResultCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+  auto runQuery = [&](const std::string& remainingFilter,
+                      int64_t modificationTime,
+                      bool enabled = true) {
+    return AssertQueryBuilder(makePlan(remainingFilter), duckDbQueryRunner_)
+        .split(makeSplit(modificationTime))
+        .config(
+            core::QueryConfig::kTableScanResultCacheEnabled,
+            enabled ? "true" : "false")
+        .assertResults(fmt::format(
+            "SELECT * FROM tmp WHERE c0 > 0 AND {}", remainingFilter));
+  };
+
+  // The first scan adds the rows of the split to the cache and the second
+  // one returns them.
+  auto task = runQuery("c1 % 3 = 0", 1);
+  EXPECT_EQ(numHits(task), 0);
+  EXPECT_EQ(cache.stats().numEntries, 1);
+  task = runQuery("c1 % 3 = 0", 1);
+  EXPECT_EQ(numHits(task), 1);
+  EXPECT_EQ(cache.stats().numEntries, 1);
+
+  // Another version of the file or another filter reads the file again.
+  task = runQuery("c1 % 3 = 0", 2);
+  EXPECT_EQ(numHits(task), 0);
+  task = runQuery("c1 % 5 = 0", 1);
+  EXPECT_EQ(numHits(task), 0);
+  EXPECT_EQ(cache.stats().numEntries, 3);
+
+  // The cache is only used if enabled for the query.
+  task = runQuery("c1 % 3 = 0", 1, false);
+  EXPECT_EQ(numHits(task), 0);
+
+  // Other connector session properties or timestamp settings read the file
+  // again.
+  task = AssertQueryBuilder(makePlan("c1 % 3 = 0"), duckDbQueryRunner_)
+             .split(makeSplit(1))
+             .config(core::QueryConfig::kTableScanResultCacheEnabled, "true")
+             .connectorSessionProperty(
+                 kHiveConnectorId,
+                 connector::hive::HiveConfig::
+                     kFileColumnNamesReadAsLowerCaseSession,
+                 "true")
+             .assertResults("SELECT * FROM tmp WHERE c0 > 0 AND c1 % 3 = 0");
+  EXPECT_EQ(numHits(task), 0);
+  task = AssertQueryBuilder(makePlan("c1 % 3 = 0"), duckDbQueryRunner_)
+             .split(makeSplit(1))
+             .config(core::QueryConfig::kTableScanResultCacheEnabled, "true")
+             .config(core::QueryConfig::kSessionTimezone, "America/New_York")
+             .config(core::QueryConfig::kAdjustTimestampToTimezone, "true")
+             .assertResults("SELECT * FROM tmp WHERE c0 > 0 AND c1 % 3 = 0");
+  EXPECT_EQ(numHits(task), 0);
+  EXPECT_EQ(cache.stats().numEntries, 5);
+
+  // Splits without a file version are not cached.
+  task = AssertQueryBuilder(makePlan("c1 % 7 = 0"), duckDbQueryRunner_)
+             .split(makeHiveConnectorSplit(filePath->getPath()))
+             .config(core::QueryConfig::kTableScanResultCacheEnabled, "true")
+             .assertResults("SELECT * FROM tmp WHERE c0 > 0 AND c1 % 7 = 0");
+  EXPECT_EQ(cache.stats().numEntries, 5);
+
+  // Splits with more rows than fit in the cache are not cached.
+  SplitResultCache smallCache(memory::memoryManager()->addLeafPool(), 1);
+  SplitResultCache::setInstance(&smallCache);
+  runQuery("c1 % 3 = 0", 1);
+  EXPECT_EQ(smallCache.stats().numEntries, 0);
+}
@@ -3772,6 +3772,80 @@ DEBUG_ONLY_TEST_F(TableWriterArbitrationTest, reclaimFromSortTableWriter) {
   }
 }
 
+DEBUG_ONLY_TEST_F(
+    TableWriterArbitrationTest,
+    reclaimFromParallelUnpartitionedWriters) {
+  VectorFuzzer::Options options;
+  const int batchSize = 1'000;
+  options.vectorSize = batchSize;
+  options.stringVariableLength = false;
+  options.stringLength = 1'000;
+  VectorFuzzer fuzzer(options, pool());
+  const int numBatches = 20;
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(fuzzer.fuzzRow(rowType_));
+  }
+  createDuckDbTable(vectors);
+
+  auto queryPool = memory::memoryManager()->addRootPool(
+      "reclaimFromParallelUnpartitionedWriters", kQueryMemoryCapacity);
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(), QueryConfig{{}}, {}, nullptr, std::move(queryPool));
+  auto fakePool = queryCtx->pool()->addLeafChild("fakePool");
+
+  // A write on the connector executor allocates up to the query capacity. The
+  // arbitration must be able to reclaim from the idle writers while the
+  // driver thread waits for the write.
+  std::atomic_int numWrites{0};
+  std::atomic_bool injected{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::dwrf::Writer::write",
+      std::function<void(dwrf::Writer*)>([&](dwrf::Writer* /*unused*/) {
+        if (driverThreadContext() != nullptr || ++numWrites != numBatches / 2) {
+          return;
+        }
+        injected = true;
+        const auto fakeAllocationSize =
+            kQueryMemoryCapacity - queryCtx->pool()->reservedBytes();
+        try {
+          auto* buffer = fakePool->allocate(fakeAllocationSize);
+          fakePool->free(buffer, fakeAllocationSize);
+        } catch (const VeloxRuntimeError& e) {
+          ASSERT_NE(e.message().find("Exceeded memory pool"), std::string::npos)
+              << e.message();
+        }
+      }));
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto outputDirectory = TempDirectoryPath::create();
+  auto writerPlan =
+      PlanBuilder()
+          .values(vectors)
+          .tableWrite(outputDirectory->getPath())
+          .project({TableWriteTraits::rowCountColumnName()})
+          .singleAggregation(
+              {},
+              {fmt::format("sum({})", TableWriteTraits::rowCountColumnName())})
+          .planNode();
+  AssertQueryBuilder(duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(1)
+      .spillDirectory(spillDirectory->getPath())
+      .config(core::QueryConfig::kSpillEnabled, true)
+      .config(core::QueryConfig::kWriterSpillEnabled, true)
+      // Set 0 file writer flush threshold to always trigger flush in test.
+      .config(core::QueryConfig::kWriterFlushThresholdBytes, 0)
+      .connectorSessionProperty(
+          kHiveConnectorId,
+          HiveConfig::kUnpartitionedWritersPerDriverSession,
+          "4")
+      .plan(std::move(writerPlan))
+      .assertResults(fmt::format("SELECT {}", numBatches * batchSize));
+  ASSERT_TRUE(injected);
+  waitForAllTasksToBeDeleted(3'000'000);
+}
+
 DEBUG_ONLY_TEST_F(TableWriterArbitrationTest, writerFlushThreshold) {
   VectorFuzzer::Options options;
   const int batchSize = 1'000;
@@ -15,6 +15,8 @@
  */
 
 #include "velox/exec/Task.h"
+#include <folly/FileUtil.h>
+#include <folly/json.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -1033,9 +1035,72 @@ TEST_F(TaskTest, supportSerialExecutionMode) {
       core::QueryCtx::create(),
       Task::ExecutionMode::kSerial);
 
-  // PartitionedOutput does not support serial execution mode, therefore the
-  // task doesn't support it either.
+  // PartitionedOutput writes to OutputBufferManager in serial execution mode
+  // as well.
+  ASSERT_TRUE(task->supportSerialExecutionMode());
+
+  // An Exchange fetches the remote data on the executor of the QueryCtx.
+  plan = PlanBuilder()
+             .exchange(ROW({"c0"}, {BIGINT()}), VectorSerde::Kind::kPresto)
+             .project({"c0 % 10"})
+             .planFragment();
+  task = Task::create(
+      "single.execution.task.1",
+      plan,
+      0,
+      core::QueryCtx::create(),
+      Task::ExecutionMode::kSerial);
   ASSERT_FALSE(task->supportSerialExecutionMode());
+  task = Task::create(
+      "single.execution.task.2",
+      plan,
+      0,
+      core::QueryCtx::create(driverExecutor_.get()),
+      Task::ExecutionMode::kSerial);
+  ASSERT_TRUE(task->supportSerialExecutionMode());
+}
+
+TEST_F(TaskTest, serialExecutionPartitionedOutput) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(100, folly::identity)});
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .partitionedOutput({}, 1)
+                  .planFragment();
+  auto task = Task::create(
+      "single.execution.partitioned.output",
+      plan,
+      0,
+      core::QueryCtx::create(),
+      Task::ExecutionMode::kSerial);
+  ASSERT_TRUE(task->supportSerialExecutionMode());
+
+  // The results go to the output buffer, not to the caller of next().
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_EQ(task->next(&future), nullptr);
+  ASSERT_FALSE(future.valid());
+
+  auto bufferManager = OutputBufferManager::getInstance().lock();
+  int64_t numPages{0};
+  bool atEnd{false};
+  ASSERT_TRUE(bufferManager->getData(
+      task->taskId(),
+      0,
+      1 << 20,
+      0,
+      [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+          int64_t /*sequence*/,
+          std::vector<int64_t> /*remainingBytes*/) {
+        for (const auto& page : pages) {
+          if (page == nullptr) {
+            atEnd = true;
+          } else {
+            ++numPages;
+          }
+        }
+      }));
+  ASSERT_GT(numPages, 0);
+  ASSERT_TRUE(atEnd);
+  task->requestCancel().wait();
 }
 
 TEST_F(TaskTest, updateBroadCastOutputBuffers) {
@@ -2315,3 +2380,56 @@ DEBUG_ONLY_TEST_F(TaskTest, taskCancellation) {
   waitForAllTasksToBeDeleted();
 }
 } // namespace facebook::velox::exec::test
+
+TEST_F(TaskTest, timeline) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  core::PlanNodeId projectId;
+  const auto plan = PlanBuilder()
+                        .values({data, data})
+                        .project({"c0 * 2 AS c1"})
+                        .capturePlanNodeId(projectId)
+                        .singleAggregation({}, {"sum(c1)"})
+                        .planNode();
+  const auto expected = makeRowVector({makeConstant<int64_t>(1'998'000, 1)});
+
+  const auto timelineDir = exec::test::TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kTaskTimelineDir, timelineDir->getPath())
+          .maxDrivers(1)
+          .assertResults(expected);
+  ASSERT_NE(task->timeline(), nullptr);
+  ASSERT_GT(task->timeline()->numEvents(), 0);
+  ASSERT_EQ(task->timeline()->numDroppedEvents(), 0);
+
+  std::string json;
+  ASSERT_TRUE(folly::readFile(
+      fmt::format("{}/{}.json", timelineDir->getPath(), task->taskId())
+          .c_str(),
+      json));
+  const auto trace = folly::parseJson(json);
+  int32_t numProjectCalls{0};
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"].asString() != "X") {
+      continue;
+    }
+    if (event["name"].asString() == "FilterProject::getOutput") {
+      ASSERT_EQ(event["args"]["planNodeId"].asString(), projectId);
+      ++numProjectCalls;
+    }
+  }
+  ASSERT_GE(numProjectCalls, 2);
+
+  // The events over the limit are dropped.
+  task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kTaskTimelineDir, timelineDir->getPath())
+          .config(core::QueryConfig::kTaskTimelineMaxEvents, "3")
+          .maxDrivers(1)
+          .assertResults(expected);
+  ASSERT_EQ(task->timeline()->numEvents(), 3);
+  ASSERT_GT(task->timeline()->numDroppedEvents(), 0);
+
+  task = AssertQueryBuilder(plan).assertResults(expected);
+  ASSERT_EQ(task->timeline(), nullptr);
+}
@@ -243,6 +243,39 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, partitionHeapGrowth) {
+  // Partitions of different sizes to grow the per-partition heaps past the
+  // inline rows up to the limit.
+  const vector_size_t size = 5'000;
+  auto data = split(
+      makeRowVector(
+          {"p", "s", "d"},
+          {
+              makeFlatVector<int32_t>(
+                  size, [](auto row) { return row % 37 == 0 ? 0 : row % 41; }),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return (row * 7'919) % 1'013; }),
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          }),
+      5);
+
+  createDuckDbTable(data);
+
+  for (auto limit : {1, 2, 3, 7, 64, 500}) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber({"p"}, {"s", "d"}, limit, true)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by p order by s, d) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            limit));
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
@@ -474,6 +474,41 @@ TEST_P(UnnestTest, batchSize) {
   ASSERT_EQ(expectedNumVectors, stats.at(unnestId).outputVectors);
 }
 
+TEST_P(UnnestTest, longArrays) {
+  // Two rows with 10K elements of a complex type each.
+  const vector_size_t numElements = 20'000;
+  auto elements = makeRowVector({
+      makeFlatVector<int64_t>(numElements, [](auto row) { return row; }),
+  });
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2}),
+      makeArrayVector({0, numElements / 2}, elements),
+  });
+
+  auto plan = PlanBuilder().values({data}).unnest({"c0"}, {"c1"}).planNode();
+  auto [cursor, results] = readCursor(makeCursorParameters(plan), [](auto*) {});
+
+  // The output is split into batches of about 'batchSize_' rows. The elements
+  // are slices of the input elements which share their buffers.
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    ASSERT_LE(result->size(), batchSize_);
+    numRows += result->size();
+    auto* unnested = result->childAt(1)->as<RowVector>();
+    ASSERT_NE(unnested, nullptr);
+    ASSERT_TRUE(unnested->childAt(0)->values()->isView());
+  }
+  ASSERT_EQ(numRows, numElements);
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(
+          numElements,
+          [&](auto row) { return row < numElements / 2 ? 1 : 2; }),
+      elements,
+  });
+  assertEqualResults({expected}, results);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     UnnestTest,
     UnnestTest,
@@ -365,6 +365,81 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, reusedDictionary) {
+  // A dictionary of long strings that is shared by consecutive batches, like a
+  // stripe dictionary from a file reader.
+  auto base = makeFlatVector<std::string>(
+      50, [](auto row) { return fmt::format("a long string key {}", row); });
+  auto makeBatch = [&](int32_t offset) {
+    auto indices =
+        makeIndices(20, [&](auto row) { return (row + offset) % 50; });
+    return BaseVector::wrapInDictionary(nullptr, indices, 20, base);
+  };
+  auto expectedHash = [&](int32_t offset, vector_size_t row) {
+    return folly::hasher<StringView>()(base->valueAt((row + offset) % 50));
+  };
+
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
+  SelectivityVector rows(20);
+  raw_vector<uint64_t> hashes(20);
+  for (auto offset : {0, 7, 40}) {
+    hasher->decode(*makeBatch(offset), rows);
+    hasher->hash(rows, false, hashes);
+    for (auto i = 0; i < 20; ++i) {
+      ASSERT_EQ(expectedHash(offset, i), hashes[i]) << offset << " " << i;
+    }
+  }
+
+  // A new base with different values at the same positions.
+  base = makeFlatVector<std::string>(
+      50, [](auto row) { return fmt::format("another key {}", row); });
+  hasher->decode(*makeBatch(7), rows);
+  hasher->hash(rows, false, hashes);
+  hasher->decode(*makeBatch(7), rows);
+  hasher->hash(rows, false, hashes);
+  for (auto i = 0; i < 20; ++i) {
+    ASSERT_EQ(expectedHash(7, i), hashes[i]) << i;
+  }
+
+  // Value ids are kept across batches until the mapping changes.
+  hasher = exec::VectorHasher::create(VARCHAR(), 1);
+  raw_vector<uint64_t> ids(20);
+  hasher->decode(*makeBatch(0), rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, ids));
+  uint64_t asRange;
+  uint64_t asDistinct;
+  hasher->cardinality(0, asRange, asDistinct);
+  hasher->enableValueIds(1, 50);
+  std::vector<uint64_t> firstIds;
+  for (auto offset : {0, 0, 10}) {
+    hasher->decode(*makeBatch(offset), rows);
+    ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+    if (offset == 0) {
+      if (firstIds.empty()) {
+        firstIds.assign(ids.begin(), ids.end());
+      } else {
+        ASSERT_EQ(firstIds, std::vector<uint64_t>(ids.begin(), ids.end()));
+      }
+    } else {
+      // Rows 0 to 9 have the values of rows 10 to 19 of the first batch.
+      for (auto i = 0; i < 10; ++i) {
+        ASSERT_EQ(firstIds[i + 10], ids[i]) << i;
+      }
+    }
+  }
+
+  // Values 20 to 39 are new and do not fit in the reserve.
+  hasher->decode(*makeBatch(20), rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, ids));
+  hasher->cardinality(0, asRange, asDistinct);
+  hasher->enableValueIds(1, 0);
+  hasher->decode(*makeBatch(20), rows);
+  ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+  hasher->decode(*makeBatch(0), rows);
+  ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+  ASSERT_EQ(firstIds, std::vector<uint64_t>(ids.begin(), ids.end()));
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
@@ -157,6 +157,54 @@ TEST_F(WindowTest, spillUnsupported) {
       opStats.at("Window").runtimeStats[Operator::kSpillNotSupported].sum, 1);
 }
 
+TEST_F(WindowTest, parallelChunks) {
+  // One large partition with peer groups of 3 rows and a few small ones.
+  const vector_size_t size = 4'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return row < 3'000 ? 0 : 1 + row % 7; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  const auto testChunks = [&](const std::vector<std::string>& functions,
+                              bool expectChunks) {
+    SCOPED_TRACE(folly::join(", ", functions));
+    std::vector<std::string> windows;
+    for (const auto& function : functions) {
+      windows.push_back(function + " over (partition by p order by s)");
+    }
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window(windows)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kWindowParallelChunkRows, "200")
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+            .assertResults(fmt::format(
+                "SELECT *, {} FROM tmp", folly::join(", ", windows)));
+
+    auto opStats = toOperatorStats(task->taskStats());
+    const auto& runtimeStats = opStats.at("Window").runtimeStats;
+    if (expectChunks) {
+      // 3'000 rows in chunks of 200 rows.
+      ASSERT_EQ(runtimeStats.at("windowParallelChunks").sum, 15);
+    } else {
+      ASSERT_EQ(runtimeStats.count("windowParallelChunks"), 0);
+    }
+  };
+
+  testChunks({"row_number()"}, true);
+  testChunks({"row_number()", "rank()", "percent_rank()"}, true);
+  testChunks({"rank()", "dense_rank()"}, false);
+  testChunks({"row_number()", "sum(d)"}, false);
+}
+
 TEST_F(WindowTest, rowBasedStreamingWindowOOM) {
   const vector_size_t size = 1'000'000;
   auto data = makeRowVector(
@@ -397,6 +445,81 @@ DEBUG_ONLY_TEST_F(WindowTest, nonRowsStreamingWindow) {
   ASSERT_FALSE(isStreamCreated.load());
 }
 
+DEBUG_ONLY_TEST_F(WindowTest, rangeFrameRowsStreamingWindowBuild) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"p", "s", "b", "d"},
+      {
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+          // Sorting key with 2 rows per value in each partition.
+          makeFlatVector<int64_t>(size, [](auto row) { return row / 6; }),
+          // Frame start value for 10 PRECEDING.
+          makeFlatVector<int64_t>(size, [](auto row) { return row / 6 - 10; }),
+          // Payload.
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 17; }, nullEvery(7)),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> kClauses = {
+      "sum(d) over (partition by p order by s range between b preceding and current row)",
+      "count(d) over (partition by p order by s range between b preceding and current row)",
+      "row_number() over (partition by p order by s)"};
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .orderBy({"p", "s"}, false)
+                  .streamingWindow(kClauses)
+                  .planNode();
+
+  std::atomic_bool isStreamCreated{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::RowsStreamingWindowBuild::RowsStreamingWindowBuild",
+      std::function<void(RowsStreamingWindowBuild*)>(
+          [&](RowsStreamingWindowBuild* windowBuild) {
+            isStreamCreated.store(true);
+          }));
+
+  const std::string duckDbSql =
+      "SELECT *, sum(d) over (partition by p order by s range between 10 preceding and current row), "
+      "count(d) over (partition by p order by s range between 10 preceding and current row), "
+      "row_number() over (partition by p order by s) FROM tmp";
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    isStreamCreated = false;
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kWindowRangeStreamingEnabled,
+            enabled ? "true" : "false")
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+        .config(core::QueryConfig::kMaxOutputBatchRows, "7")
+        .assertResults(duckDbSql);
+    ASSERT_EQ(isStreamCreated.load(), enabled);
+  }
+
+  // A frame that starts before the kept rows fails the query.
+  auto decreasingBound = makeRowVector(
+      {"s", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row < 500 ? row - 5 : row - 400; }),
+      });
+  plan = PlanBuilder()
+             .values({decreasingBound})
+             .streamingWindow(
+                 {"count(s) over (order by s range between b preceding and current row)"})
+             .planNode();
+  VELOX_ASSERT_USER_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kWindowRangeStreamingEnabled, "true")
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+          .config(core::QueryConfig::kMaxOutputBatchRows, "7")
+          .copyResults(pool()),
+      "The window frame starts before the rows kept for streaming RANGE frames");
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -247,8 +247,17 @@ RowVectorPtr AssertQueryBuilder::copyResults(
   return copy;
 }
 
+uint64_t AssertQueryBuilder::countResults(std::shared_ptr<Task>& task) {
+  uint64_t numRows = 0;
+  auto [cursor, results] = readCursor(
+      [&](const RowVectorPtr& result) { numRows += result->size(); });
+  task = cursor->task();
+  return numRows;
+}
+
 std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>>
-AssertQueryBuilder::readCursor() {
+AssertQueryBuilder::readCursor(
+    std::function<void(const RowVectorPtr&)> consumer) {
   VELOX_CHECK_NOT_NULL(params_.planNode);
 
   if (!configs_.empty() || !connectorSessionProperties_.empty()) {
@@ -278,18 +287,22 @@ AssertQueryBuilder::readCursor() {
   }
 
   bool noMoreSplits = false;
-  return test::readCursor(params_, [&](Task* task) {
-    if (noMoreSplits) {
-      return;
-    }
-    for (auto& [nodeId, nodeSplits] : splits_) {
-      for (auto& split : nodeSplits) {
-        task->addSplit(nodeId, std::move(split));
-      }
-      task->noMoreSplits(nodeId);
-    }
-    noMoreSplits = true;
-  });
+  return test::readCursor(
+      params_,
+      [&](Task* task) {
+        if (noMoreSplits) {
+          return;
+        }
+        for (auto& [nodeId, nodeSplits] : splits_) {
+          for (auto& split : nodeSplits) {
+            task->addSplit(nodeId, std::move(split));
+          }
+          task->noMoreSplits(nodeId);
+        }
+        noMoreSplits = true;
+      },
+      5'000'000,
+      std::move(consumer));
 }
 
 } // namespace facebook::velox::exec::test
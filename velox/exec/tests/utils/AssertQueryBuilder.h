@@ -180,9 +180,15 @@ class AssertQueryBuilder {
       memory::MemoryPool* pool,
       std::shared_ptr<Task>& task);
 
+  /// Run the query and return the number of result rows without copying or
+  /// retaining the results. Also returns the task.
+  uint64_t countResults(std::shared_ptr<Task>& task);
+
  private:
-  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>>
-  readCursor();
+  // Runs the query. If 'consumer' is set, passes each result to it instead of
+  // returning the results. See test::readCursor().
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> readCursor(
+      std::function<void(const RowVectorPtr&)> consumer = nullptr);
 
   static std::unique_ptr<folly::Executor> newExecutor() {
     return std::make_unique<folly::CPUThreadPoolExecutor>(
@@ -293,11 +293,24 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileProperties(
+      connector::hive::FileProperties fileProperties) {
+    fileProperties_ = fileProperties;
+    return *this;
+  }
+
+  HiveConnectorSplitBuilder& columnRange(
+      const std::string& column,
+      connector::SplitColumnRange range) {
+    columnRanges_[column] = std::move(range);
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
     static const std::unordered_map<std::string, std::string> customSplitInfo;
     static const std::shared_ptr<std::string> extraFileInfo;
     static const std::unordered_map<std::string, std::string> serdeParameters;
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         connectorId_,
         filePath_,
         fileFormat_,
@@ -310,7 +323,9 @@ class HiveConnectorSplitBuilder {
         serdeParameters,
         splitWeight_,
         infoColumns_,
-        std::nullopt);
+        fileProperties_);
+    split->columnRanges = columnRanges_;
+    return split;
   }
 
  private:
@@ -326,6 +341,8 @@ class HiveConnectorSplitBuilder {
   std::unordered_map<std::string, std::string> infoColumns_ = {};
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
+  std::optional<connector::hive::FileProperties> fileProperties_;
+  std::unordered_map<std::string, connector::SplitColumnRange> columnRanges_;
 };
 
 } // namespace facebook::velox::exec::test
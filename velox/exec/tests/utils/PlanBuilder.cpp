@@ -1215,7 +1215,8 @@ PlanBuilder& PlanBuilder::partitionedOutput(
     bool replicateNullsAndAny,
     core::PartitionFunctionSpecPtr partitionFunctionSpec,
     const std::vector<std::string>& outputLayout,
-    VectorSerde::Kind serdeKind) {
+    VectorSerde::Kind serdeKind,
+    std::optional<core::PartitionedOutputNode::SkewedJoin> skewedJoin) {
   VELOX_CHECK_NOT_NULL(
       planNode_, "PartitionedOutput cannot be the source node");
   auto outputType = outputLayout.empty()
@@ -1230,7 +1231,61 @@ PlanBuilder& PlanBuilder::partitionedOutput(
       std::move(partitionFunctionSpec),
       outputType,
       serdeKind,
-      planNode_);
+      planNode_,
+      std::move(skewedJoin));
+  return *this;
+}
+
+PlanBuilder& PlanBuilder::skewedJoinPartitionedOutput(
+    const std::vector<std::string>& keys,
+    int numPartitions,
+    core::PartitionedOutputNode::SkewedJoin skewedJoin,
+    const std::vector<std::string>& outputLayout,
+    VectorSerde::Kind serdeKind) {
+  VELOX_CHECK_NOT_NULL(
+      planNode_, "PartitionedOutput cannot be the source node");
+  auto keyExprs = exprs(keys, planNode_->outputType());
+  return partitionedOutput(
+      keys,
+      numPartitions,
+      false,
+      createPartitionFunctionSpec(planNode_->outputType(), keyExprs, pool_),
+      outputLayout,
+      serdeKind,
+      std::move(skewedJoin));
+}
+
+PlanBuilder& PlanBuilder::combinedPartitionedOutput(
+    const std::vector<std::string>& keys,
+    int numPartitions,
+    const std::vector<std::string>& outputLayout,
+    VectorSerde::Kind serdeKind) {
+  VELOX_CHECK_NOT_NULL(
+      planNode_, "PartitionedOutput cannot be the source node");
+  const auto* aggNode = findPartialAggregation(planNode_.get());
+  VELOX_CHECK(exec::isRawInput(aggNode->step()));
+  const auto intermediate = std::dynamic_pointer_cast<
+      const core::AggregationNode>(createIntermediateOrFinalAggregation(
+      core::AggregationNode::Step::kIntermediate, aggNode));
+  core::PartitionedOutputNode::Combiner combiner{
+      intermediate->groupingKeys(), intermediate->aggregates()};
+
+  auto keyExprs = exprs(keys, planNode_->outputType());
+  auto outputType = outputLayout.empty()
+      ? planNode_->outputType()
+      : extract(planNode_->outputType(), outputLayout);
+  planNode_ = std::make_shared<core::PartitionedOutputNode>(
+      nextPlanNodeId(),
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      keyExprs,
+      numPartitions,
+      false,
+      createPartitionFunctionSpec(planNode_->outputType(), keyExprs, pool_),
+      outputType,
+      serdeKind,
+      planNode_,
+      std::nullopt,
+      std::move(combiner));
   return *this;
 }
 
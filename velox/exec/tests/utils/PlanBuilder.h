@@ -806,6 +806,27 @@ class PlanBuilder {
       bool replicateNullsAndAny,
       core::PartitionFunctionSpecPtr partitionFunctionSpec,
       const std::vector<std::string>& outputLayout = {},
+      VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto,
+      std::optional<core::PartitionedOutputNode::SkewedJoin> skewedJoin =
+          std::nullopt);
+
+  /// Adds a PartitionedOutputNode to hash-partition one side of a skewed join.
+  /// The hot partitions are split across several destinations. See
+  /// core::PartitionedOutputNode::SkewedJoin.
+  PlanBuilder& skewedJoinPartitionedOutput(
+      const std::vector<std::string>& keys,
+      int numPartitions,
+      core::PartitionedOutputNode::SkewedJoin skewedJoin,
+      const std::vector<std::string>& outputLayout = {},
+      VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto);
+
+  /// Adds a PartitionedOutputNode to hash-partition the output of a partial
+  /// aggregation on 'keys'. The rows with equal grouping keys are merged
+  /// before they are sent. See core::PartitionedOutputNode::Combiner.
+  PlanBuilder& combinedPartitionedOutput(
+      const std::vector<std::string>& keys,
+      int numPartitions,
+      const std::vector<std::string>& outputLayout = {},
       VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto);
 
   /// Adds a PartitionedOutputNode to broadcast the input data.
@@ -1424,7 +1424,8 @@ bool testingMaybeTriggerAbort(exec::Task* task) {
 std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> readCursor(
     const CursorParameters& params,
     std::function<void(exec::Task*)> addSplits,
-    uint64_t maxWaitMicros) {
+    uint64_t maxWaitMicros,
+    std::function<void(const RowVectorPtr&)> consumer) {
   auto cursor = TaskCursor::create(params);
   // 'result' borrows memory from cursor so the life cycle must be shorter.
   std::vector<RowVectorPtr> result;
@@ -1432,7 +1433,11 @@ std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> readCursor(
   addSplits(task);
 
   while (cursor->moveNext()) {
-    result.push_back(cursor->current());
+    if (consumer) {
+      consumer(cursor->current());
+    } else {
+      result.push_back(cursor->current());
+    }
     addSplits(task);
     testingMaybeTriggerAbort(task);
   }
@@ -174,10 +174,14 @@ class ScopedOOMInjector {
 /// abortion triggers otherwise false.
 bool testingMaybeTriggerAbort(exec::Task* task);
 
+/// Runs the query of 'params' and returns the cursor and the results. If
+/// 'consumer' is set, it is called with each result instead and the returned
+/// results are empty, so that they are not kept alive until the end.
 std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> readCursor(
     const CursorParameters& params,
     std::function<void(exec::Task*)> addSplits,
-    uint64_t maxWaitMicros = 5'000'000);
+    uint64_t maxWaitMicros = 5'000'000,
+    std::function<void(const RowVectorPtr&)> consumer = nullptr);
 
 /// The Task can return results before the Driver is finished executing.
 /// Wait upto maxWaitMicros for the Task to finish as 'expectedState' before
@@ -0,0 +1,949 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/SqlQueryPlanner.h"
+
+#include <duckdb.hpp> // @manual
+#include <duckdb/parser/expression/columnref_expression.hpp> // @manual
+#include <duckdb/parser/expression/comparison_expression.hpp> // @manual
+#include <duckdb/parser/expression/conjunction_expression.hpp> // @manual
+#include <duckdb/parser/expression/constant_expression.hpp> // @manual
+#include <duckdb/parser/expression/function_expression.hpp> // @manual
+#include <duckdb/parser/parsed_expression_iterator.hpp> // @manual
+#include <duckdb/parser/parser.hpp> // @manual
+#include <duckdb/parser/query_node/select_node.hpp> // @manual
+#include <duckdb/parser/statement/select_statement.hpp> // @manual
+#include <duckdb/parser/tableref/basetableref.hpp> // @manual
+#include <duckdb/parser/tableref/joinref.hpp> // @manual
+
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+using ::duckdb::BaseTableRef;
+using ::duckdb::ColumnRefExpression;
+using ::duckdb::ComparisonExpression;
+using ::duckdb::ConjunctionExpression;
+using ::duckdb::ConstantExpression;
+using ::duckdb::ExpressionClass;
+using ::duckdb::ExpressionType;
+using ::duckdb::FunctionExpression;
+using ::duckdb::JoinRef;
+using ::duckdb::ParsedExpression;
+using ::duckdb::ParsedExpressionIterator;
+using ::duckdb::SelectNode;
+using ::duckdb::TableRef;
+using ::duckdb::TableReferenceType;
+
+using ExprPtr = ::duckdb::unique_ptr<ParsedExpression>;
+
+// Calls 'visit' on 'expr' and all its subexpressions.
+void forEachExpr(
+    const ParsedExpression& expr,
+    const std::function<void(const ParsedExpression&)>& visit) {
+  visit(expr);
+  ParsedExpressionIterator::EnumerateChildren(
+      expr, [&](const ParsedExpression& child) { forEachExpr(child, visit); });
+}
+
+// Replaces 'expr' and its subexpressions with the result of 'replace' when
+// this is not null. Does not descend into the replacements.
+void replaceExprs(
+    ExprPtr& expr,
+    const std::function<ExprPtr(const ParsedExpression&)>& replace) {
+  if (auto replacement = replace(*expr)) {
+    replacement->alias = expr->alias;
+    expr = std::move(replacement);
+    return;
+  }
+  ParsedExpressionIterator::EnumerateChildren(
+      *expr, [&](ExprPtr& child) { replaceExprs(child, replace); });
+}
+
+ExprPtr columnRef(const std::string& name) {
+  return ::duckdb::make_uniq<ColumnRefExpression>(name);
+}
+
+const ColumnRefExpression* asColumn(const ParsedExpression& expr) {
+  if (expr.expression_class != ExpressionClass::COLUMN_REF) {
+    return nullptr;
+  }
+  return dynamic_cast<const ColumnRefExpression*>(&expr);
+}
+
+std::optional<int64_t> asInteger(const ParsedExpression& expr) {
+  if (expr.expression_class != ExpressionClass::CONSTANT) {
+    return std::nullopt;
+  }
+  const auto& value = dynamic_cast<const ConstantExpression&>(expr).value;
+  if (!value.type().IsIntegral()) {
+    return std::nullopt;
+  }
+  return value.GetValue<int64_t>();
+}
+
+// Returns the SQL text of 'expr' without its alias, in the form PlanBuilder
+// parses.
+std::string toSql(const ParsedExpression& expr) {
+  auto copy = expr.Copy();
+  copy->alias.clear();
+  return copy->ToString();
+}
+
+// Returns true if 'left' and 'right' are the same expression, ignoring their
+// aliases.
+bool sameExpr(const ParsedExpression& left, const ParsedExpression& right) {
+  auto leftCopy = left.Copy();
+  auto rightCopy = right.Copy();
+  leftCopy->alias.clear();
+  rightCopy->alias.clear();
+  return leftCopy->Equals(rightCopy.get());
+}
+
+std::unordered_set<std::string> columnsOf(const ParsedExpression& expr) {
+  std::unordered_set<std::string> columns;
+  forEachExpr(expr, [&](const ParsedExpression& subexpr) {
+    if (auto* column = asColumn(subexpr)) {
+      columns.insert(column->GetColumnName());
+    }
+  });
+  return columns;
+}
+
+bool isAggregate(const ParsedExpression& expr) {
+  if (expr.expression_class != ExpressionClass::FUNCTION) {
+    return false;
+  }
+  const auto& name =
+      dynamic_cast<const FunctionExpression&>(expr).function_name;
+  return name == "count_star" || getAggregateFunctionEntry(name) != nullptr;
+}
+
+void splitConjuncts(ExprPtr expr, std::vector<ExprPtr>& conjuncts) {
+  if (expr->type == ExpressionType::CONJUNCTION_AND) {
+    for (auto& child : dynamic_cast<ConjunctionExpression&>(*expr).children) {
+      splitConjuncts(std::move(child), conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(std::move(expr));
+}
+
+std::string andOf(const std::vector<std::string>& conjuncts) {
+  if (conjuncts.size() == 1) {
+    return conjuncts[0];
+  }
+  std::string result;
+  for (const auto& conjunct : conjuncts) {
+    result += result.empty() ? "" : " AND ";
+    result += "(" + conjunct + ")";
+  }
+  return result;
+}
+
+core::JoinType toJoinType(::duckdb::JoinType type) {
+  switch (type) {
+    case ::duckdb::JoinType::INNER:
+      return core::JoinType::kInner;
+    case ::duckdb::JoinType::LEFT:
+      return core::JoinType::kLeft;
+    case ::duckdb::JoinType::RIGHT:
+      return core::JoinType::kRight;
+    case ::duckdb::JoinType::OUTER:
+      return core::JoinType::kFull;
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported join type: {}", ::duckdb::JoinTypeToString(type));
+  }
+}
+
+// Translates one SELECT. Keeps the state of the translation, e.g. the splits
+// of the scans made so far.
+class SelectTranslator {
+ public:
+  SelectTranslator(
+      const std::unordered_map<std::string, SqlQueryPlanner::Table>& tables,
+      memory::MemoryPool* pool)
+      : tables_(tables),
+        pool_(pool),
+        idGenerator_(std::make_shared<core::PlanNodeIdGenerator>()) {}
+
+  SqlQueryPlan translate(SelectNode& select);
+
+ private:
+  // The plan of a part of the FROM clause and the columns it produces.
+  struct Relation {
+    PlanBuilder builder;
+    std::unordered_set<std::string> columns;
+
+    bool covers(const std::unordered_set<std::string>& names) const {
+      for (const auto& name : names) {
+        if (columns.count(name) == 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  void checkSupported(SelectNode& select);
+
+  // Removes table qualifiers from column references and records the
+  // referenced columns in 'usedColumns_'.
+  void resolveColumns(ExprPtr& expr);
+
+  void collectTables(const TableRef& ref);
+
+  // Plans 'ref' with the 'conjuncts' which can be applied to single tables of
+  // it. Conjuncts which are applied are set to null.
+  Relation planFrom(TableRef& ref, std::vector<ExprPtr>& conjuncts);
+
+  Relation planScan(const BaseTableRef& ref, std::vector<ExprPtr>& conjuncts);
+
+  Relation planJoin(JoinRef& ref);
+
+  // Joins 'left' and 'right' on 'conjuncts'. Equalities between a column of
+  // each side are the join keys.
+  Relation join(
+      Relation left,
+      Relation right,
+      std::vector<ExprPtr>& conjuncts,
+      core::JoinType joinType);
+
+  // Plans the aggregation of 'select' and rewrites the select list, HAVING and
+  // ORDER BY to refer to its results.
+  void planAggregation(SelectNode& select, Relation& relation);
+
+  const std::unordered_map<std::string, SqlQueryPlanner::Table>& tables_;
+  memory::MemoryPool* const pool_;
+  const std::shared_ptr<core::PlanNodeIdGenerator> idGenerator_;
+
+  // Maps a column name to the name or alias of its FROM table.
+  std::unordered_map<std::string, std::string> columnTables_;
+  std::unordered_set<std::string> tableNames_;
+  std::unordered_set<std::string> usedColumns_;
+  std::unordered_map<core::PlanNodeId, std::vector<Split>> splits_;
+};
+
+void SelectTranslator::checkSupported(SelectNode& select) {
+  VELOX_USER_CHECK(
+      select.cte_map.map.empty(), "Common table expressions are not supported");
+  VELOX_USER_CHECK_NULL(select.qualify, "QUALIFY is not supported");
+  VELOX_USER_CHECK_NULL(select.sample, "SAMPLE is not supported");
+  VELOX_USER_CHECK_LE(
+      select.groups.grouping_sets.size(), 1, "GROUPING SETS are not supported");
+  VELOX_USER_CHECK(
+      select.aggregate_handling ==
+          ::duckdb::AggregateHandling::STANDARD_HANDLING,
+      "GROUP BY ALL is not supported");
+  VELOX_USER_CHECK_NOT_NULL(select.from_table, "FROM is required");
+
+  auto check = [](const ParsedExpression& expr) {
+    forEachExpr(expr, [](const ParsedExpression& subexpr) {
+      VELOX_USER_CHECK(
+          subexpr.expression_class != ExpressionClass::SUBQUERY,
+          "Subqueries are not supported");
+      VELOX_USER_CHECK(
+          subexpr.expression_class != ExpressionClass::WINDOW,
+          "Window functions are not supported");
+    });
+  };
+  for (const auto& expr : select.select_list) {
+    check(*expr);
+  }
+  if (select.where_clause) {
+    check(*select.where_clause);
+  }
+  if (select.having) {
+    check(*select.having);
+  }
+  for (const auto& groupExpr : select.groups.group_expressions) {
+    check(*groupExpr);
+  }
+  for (const auto& modifier : select.modifiers) {
+    if (modifier->type == ::duckdb::ResultModifierType::ORDER_MODIFIER) {
+      for (const auto& order :
+           dynamic_cast<const ::duckdb::OrderModifier&>(*modifier).orders) {
+        check(*order.expression);
+      }
+    }
+  }
+  std::function<void(const TableRef&)> checkJoins = [&](const TableRef& ref) {
+    if (ref.type == TableReferenceType::JOIN) {
+      const auto& join = dynamic_cast<const JoinRef&>(ref);
+      if (join.condition) {
+        check(*join.condition);
+      }
+      checkJoins(*join.left);
+      checkJoins(*join.right);
+    }
+  };
+  checkJoins(*select.from_table);
+}
+
+void SelectTranslator::resolveColumns(ExprPtr& expr) {
+  replaceExprs(expr, [&](const ParsedExpression& subexpr) -> ExprPtr {
+    auto* column = asColumn(subexpr);
+    if (column == nullptr) {
+      return nullptr;
+    }
+    const auto& name = column->GetColumnName();
+    const auto& names = column->column_names;
+    VELOX_USER_CHECK_LE(names.size(), 2, "Unsupported column name: {}", name);
+    if (names.size() == 2) {
+      VELOX_USER_CHECK(
+          tableNames_.count(names[0]), "Unknown table: {}", names[0]);
+    }
+    usedColumns_.insert(name);
+    return names.size() == 1 ? nullptr : columnRef(name);
+  });
+}
+
+void SelectTranslator::collectTables(const TableRef& ref) {
+  if (ref.type == TableReferenceType::JOIN) {
+    const auto& join = dynamic_cast<const JoinRef&>(ref);
+    collectTables(*join.left);
+    collectTables(*join.right);
+    return;
+  }
+  VELOX_USER_CHECK(
+      ref.type == TableReferenceType::BASE_TABLE,
+      "Only tables and joins are supported in FROM: {}",
+      ref.ToString());
+  const auto& table = dynamic_cast<const BaseTableRef&>(ref);
+  auto it = tables_.find(table.table_name);
+  VELOX_USER_CHECK(it != tables_.end(), "Unknown table: {}", table.table_name);
+  const auto& name = table.alias.empty() ? table.table_name : table.alias;
+  VELOX_USER_CHECK(
+      tableNames_.insert(name).second,
+      "Table {} appears more than once, self joins are not supported",
+      name);
+  for (const auto& column : it->second.type->names()) {
+    VELOX_USER_CHECK(
+        columnTables_.emplace(column, name).second,
+        "Column {} is in more than one table",
+        column);
+  }
+}
+
+SelectTranslator::Relation SelectTranslator::planFrom(
+    TableRef& ref,
+    std::vector<ExprPtr>& conjuncts) {
+  if (ref.type == TableReferenceType::BASE_TABLE) {
+    return planScan(dynamic_cast<const BaseTableRef&>(ref), conjuncts);
+  }
+
+  auto& joinRef = dynamic_cast<JoinRef&>(ref);
+  if (joinRef.condition) {
+    auto relation = planJoin(joinRef);
+    std::vector<std::string> filters;
+    for (auto& conjunct : conjuncts) {
+      if (conjunct && relation.covers(columnsOf(*conjunct))) {
+        filters.push_back(toSql(*conjunct));
+        conjunct = nullptr;
+      }
+    }
+    if (!filters.empty()) {
+      relation.builder.filter(andOf(filters));
+    }
+    return relation;
+  }
+
+  // A cross product. Flattens the list of tables and joins them in the order of
+  // the list, picking first the tables connected by equalities.
+  VELOX_USER_CHECK(
+      joinRef.type == ::duckdb::JoinType::INNER,
+      "Unsupported join: {}",
+      joinRef.ToString());
+  VELOX_USER_CHECK(
+      joinRef.using_columns.empty(), "JOIN USING is not supported");
+  std::vector<Relation> relations;
+  std::function<void(TableRef&)> flatten = [&](TableRef& item) {
+    if (item.type == TableReferenceType::JOIN) {
+      auto& itemJoin = dynamic_cast<JoinRef&>(item);
+      if (!itemJoin.condition && itemJoin.type == ::duckdb::JoinType::INNER) {
+        flatten(*itemJoin.left);
+        flatten(*itemJoin.right);
+        return;
+      }
+    }
+    relations.push_back(planFrom(item, conjuncts));
+  };
+  flatten(ref);
+
+  auto joinsWith = [&](const Relation& left, const Relation& right) {
+    for (const auto& conjunct : conjuncts) {
+      if (conjunct && conjunct->type == ExpressionType::COMPARE_EQUAL) {
+        const auto& equality = dynamic_cast<ComparisonExpression&>(*conjunct);
+        auto* leftColumn = asColumn(*equality.left);
+        auto* rightColumn = asColumn(*equality.right);
+        if (leftColumn && rightColumn) {
+          const auto& a = leftColumn->GetColumnName();
+          const auto& b = rightColumn->GetColumnName();
+          if ((left.columns.count(a) && right.columns.count(b)) ||
+              (left.columns.count(b) && right.columns.count(a))) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  };
+
+  auto result = std::move(relations[0]);
+  relations.erase(relations.begin());
+  while (!relations.empty()) {
+    auto next = std::find_if(
+        relations.begin(), relations.end(), [&](const Relation& relation) {
+          return joinsWith(result, relation);
+        });
+    if (next == relations.end()) {
+      next = relations.begin();
+    }
+    auto right = std::move(*next);
+    relations.erase(next);
+    result = join(
+        std::move(result), std::move(right), conjuncts, core::JoinType::kInner);
+  }
+  return result;
+}
+
+SelectTranslator::Relation SelectTranslator::planScan(
+    const BaseTableRef& ref,
+    std::vector<ExprPtr>& conjuncts) {
+  const auto& table = tables_.at(ref.table_name);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < table.type->size(); ++i) {
+    if (usedColumns_.count(table.type->nameOf(i))) {
+      names.push_back(table.type->nameOf(i));
+      types.push_back(table.type->childAt(i));
+    }
+  }
+  if (names.empty()) {
+    // Reads a column to have the row count, e.g. for count(*).
+    names.push_back(table.type->nameOf(0));
+    types.push_back(table.type->childAt(0));
+  }
+
+  Relation relation{
+      PlanBuilder(idGenerator_, pool_),
+      std::unordered_set<std::string>(names.begin(), names.end())};
+  std::vector<std::string> filters;
+  for (auto& conjunct : conjuncts) {
+    if (conjunct && relation.covers(columnsOf(*conjunct))) {
+      filters.push_back(toSql(*conjunct));
+      conjunct = nullptr;
+    }
+  }
+
+  std::vector<Split> splits;
+  if (table.tpchTable.has_value()) {
+    relation.builder.tpchTableScan(
+        table.tpchTable.value(), std::move(names), table.scaleFactor);
+    for (auto i = 0; i < table.numSplits; ++i) {
+      splits.emplace_back(std::make_shared<connector::tpch::TpchConnectorSplit>(
+          std::string(PlanBuilder::kTpchDefaultConnectorId),
+          table.numSplits,
+          i));
+    }
+  } else {
+    relation.builder.tableScan(
+        ref.table_name,
+        ROW(std::move(names), std::move(types)),
+        {},
+        {},
+        filters.empty() ? "" : andOf(filters),
+        table.type);
+    for (const auto& file : table.dataFiles) {
+      for (auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+               file, table.numSplitsPerFile, table.format)) {
+        splits.emplace_back(std::move(split));
+      }
+    }
+  }
+  splits_[relation.builder.planNode()->id()] = std::move(splits);
+  if (table.tpchTable.has_value() && !filters.empty()) {
+    relation.builder.filter(andOf(filters));
+  }
+  return relation;
+}
+
+SelectTranslator::Relation SelectTranslator::planJoin(JoinRef& ref) {
+  VELOX_USER_CHECK(ref.using_columns.empty(), "JOIN USING is not supported");
+  std::vector<ExprPtr> noConjuncts;
+  auto left = planFrom(*ref.left, noConjuncts);
+  auto right = planFrom(*ref.right, noConjuncts);
+  std::vector<ExprPtr> conjuncts;
+  splitConjuncts(std::move(ref.condition), conjuncts);
+  auto relation = join(
+      std::move(left), std::move(right), conjuncts, toJoinType(ref.type));
+  for (const auto& conjunct : conjuncts) {
+    VELOX_USER_CHECK_NULL(
+        conjunct,
+        "ON may only refer to the joined tables: {}",
+        conjunct->ToString());
+  }
+  return relation;
+}
+
+SelectTranslator::Relation SelectTranslator::join(
+    Relation left,
+    Relation right,
+    std::vector<ExprPtr>& conjuncts,
+    core::JoinType joinType) {
+  std::vector<std::string> leftKeys;
+  std::vector<std::string> rightKeys;
+  std::vector<std::string> filters;
+  for (auto& conjunct : conjuncts) {
+    if (!conjunct) {
+      continue;
+    }
+    if (conjunct->type == ExpressionType::COMPARE_EQUAL) {
+      const auto& equality = dynamic_cast<ComparisonExpression&>(*conjunct);
+      auto* a = asColumn(*equality.left);
+      auto* b = asColumn(*equality.right);
+      if (a && b) {
+        if (left.columns.count(a->GetColumnName()) &&
+            right.columns.count(b->GetColumnName())) {
+          leftKeys.push_back(a->GetColumnName());
+          rightKeys.push_back(b->GetColumnName());
+          conjunct = nullptr;
+          continue;
+        }
+        if (left.columns.count(b->GetColumnName()) &&
+            right.columns.count(a->GetColumnName())) {
+          leftKeys.push_back(b->GetColumnName());
+          rightKeys.push_back(a->GetColumnName());
+          conjunct = nullptr;
+          continue;
+        }
+      }
+    }
+    const auto columns = columnsOf(*conjunct);
+    bool covered = true;
+    for (const auto& column : columns) {
+      covered &= left.columns.count(column) || right.columns.count(column);
+    }
+    if (covered) {
+      filters.push_back(toSql(*conjunct));
+      conjunct = nullptr;
+    }
+  }
+
+  const auto leftType = left.builder.planNode()->outputType();
+  const auto rightType = right.builder.planNode()->outputType();
+  std::vector<std::string> outputLayout = leftType->names();
+  outputLayout.insert(
+      outputLayout.end(), rightType->names().begin(), rightType->names().end());
+  const auto filter = filters.empty() ? "" : andOf(filters);
+  if (leftKeys.empty()) {
+    left.builder.nestedLoopJoin(
+        right.builder.planNode(), filter, outputLayout, joinType);
+  } else {
+    left.builder.hashJoin(
+        leftKeys,
+        rightKeys,
+        right.builder.planNode(),
+        filter,
+        outputLayout,
+        joinType);
+  }
+  left.columns.insert(right.columns.begin(), right.columns.end());
+  return left;
+}
+
+void SelectTranslator::planAggregation(
+    SelectNode& select,
+    Relation& relation) {
+  std::vector<std::string> newColumns;
+  std::vector<std::string> keys;
+  // The GROUP BY expressions which are not columns and the names of their
+  // values.
+  std::vector<std::pair<ExprPtr, std::string>> groupExprs;
+  for (auto& groupExpr : select.groups.group_expressions) {
+    // GROUP BY 1 and GROUP BY <alias> refer to the select list.
+    const ParsedExpression* expr = groupExpr.get();
+    if (auto ordinal = asInteger(*expr)) {
+      VELOX_USER_CHECK(
+          *ordinal >= 1 && *ordinal <= select.select_list.size(),
+          "GROUP BY position out of range: {}",
+          *ordinal);
+      expr = select.select_list[*ordinal - 1].get();
+    } else if (auto* column = asColumn(*expr)) {
+      if (!relation.columns.count(column->GetColumnName())) {
+        for (const auto& item : select.select_list) {
+          if (item->alias == column->GetColumnName()) {
+            expr = item.get();
+          }
+        }
+      }
+    }
+    if (auto* column = asColumn(*expr)) {
+      keys.push_back(column->GetColumnName());
+      continue;
+    }
+    const auto name = fmt::format("_g{}", groupExprs.size());
+    newColumns.push_back(fmt::format("{} AS {}", toSql(*expr), name));
+    keys.push_back(name);
+    groupExprs.emplace_back(expr->Copy(), name);
+  }
+
+  // Collects the distinct aggregate calls and moves their inputs which are
+  // not columns or constants to 'newColumns'.
+  std::vector<std::pair<ExprPtr, std::string>> aggregateExprs;
+  std::vector<std::string> aggregates;
+  std::vector<std::string> masks;
+  auto collect = [&](const ParsedExpression& expr) {
+    forEachExpr(expr, [&](const ParsedExpression& subexpr) {
+      if (!isAggregate(subexpr)) {
+        return;
+      }
+      for (const auto& [existing, name] : aggregateExprs) {
+        if (sameExpr(*existing, subexpr)) {
+          return;
+        }
+      }
+      const auto index = aggregateExprs.size();
+      const auto name = fmt::format("_a{}", index);
+      auto call = subexpr.Copy();
+      call->alias.clear();
+      auto& function = dynamic_cast<FunctionExpression&>(*call);
+      for (auto i = 0; i < function.children.size(); ++i) {
+        auto& input = function.children[i];
+        if (asColumn(*input) ||
+            input->expression_class == ExpressionClass::CONSTANT) {
+          continue;
+        }
+        const auto inputName = fmt::format("_a{}_{}", index, i);
+        newColumns.push_back(fmt::format("{} AS {}", toSql(*input), inputName));
+        input = columnRef(inputName);
+      }
+      std::string mask;
+      if (function.filter) {
+        mask = fmt::format("_a{}_mask", index);
+        newColumns.push_back(
+            fmt::format("{} AS {}", toSql(*function.filter), mask));
+        function.filter = nullptr;
+      }
+      aggregates.push_back(fmt::format("{} AS {}", call->ToString(), name));
+      masks.push_back(mask);
+      aggregateExprs.emplace_back(subexpr.Copy(), name);
+    });
+  };
+  for (const auto& item : select.select_list) {
+    collect(*item);
+  }
+  if (select.having) {
+    collect(*select.having);
+  }
+  for (auto& modifier : select.modifiers) {
+    if (modifier->type == ::duckdb::ResultModifierType::ORDER_MODIFIER) {
+      for (auto& order :
+           dynamic_cast<::duckdb::OrderModifier&>(*modifier).orders) {
+        collect(*order.expression);
+      }
+    }
+  }
+
+  if (!newColumns.empty()) {
+    relation.builder.appendColumns(newColumns);
+  }
+  relation.builder.singleAggregation(keys, aggregates, masks);
+
+  // Replaces the aggregates and GROUP BY expressions with their results.
+  auto rewrite = [&](ExprPtr& expr) {
+    replaceExprs(expr, [&](const ParsedExpression& subexpr) -> ExprPtr {
+      for (const auto* exprs : {&aggregateExprs, &groupExprs}) {
+        for (const auto& [existing, name] : *exprs) {
+          if (sameExpr(*existing, subexpr)) {
+            return columnRef(name);
+          }
+        }
+      }
+      return nullptr;
+    });
+  };
+  for (auto& item : select.select_list) {
+    rewrite(item);
+  }
+  if (select.having) {
+    rewrite(select.having);
+    relation.builder.filter(toSql(*select.having));
+  }
+  for (auto& modifier : select.modifiers) {
+    if (modifier->type == ::duckdb::ResultModifierType::ORDER_MODIFIER) {
+      for (auto& order :
+           dynamic_cast<::duckdb::OrderModifier&>(*modifier).orders) {
+        rewrite(order.expression);
+      }
+    }
+  }
+
+  relation.columns.clear();
+  for (const auto& name : relation.builder.planNode()->outputType()->names()) {
+    relation.columns.insert(name);
+  }
+}
+
+SqlQueryPlan SelectTranslator::translate(SelectNode& select) {
+  checkSupported(select);
+  collectTables(*select.from_table);
+
+  bool hasStar = false;
+  for (auto& item : select.select_list) {
+    if (item->expression_class == ExpressionClass::STAR) {
+      hasStar = true;
+      continue;
+    }
+    resolveColumns(item);
+  }
+  if (hasStar) {
+    for (const auto& [column, table] : columnTables_) {
+      usedColumns_.insert(column);
+    }
+  }
+  std::vector<ExprPtr> conjuncts;
+  if (select.where_clause) {
+    resolveColumns(select.where_clause);
+    splitConjuncts(std::move(select.where_clause), conjuncts);
+  }
+  for (auto& groupExpr : select.groups.group_expressions) {
+    resolveColumns(groupExpr);
+  }
+  if (select.having) {
+    resolveColumns(select.having);
+  }
+  std::function<void(TableRef&)> resolveJoins = [&](TableRef& ref) {
+    if (ref.type == TableReferenceType::JOIN) {
+      auto& join = dynamic_cast<JoinRef&>(ref);
+      if (join.condition) {
+        resolveColumns(join.condition);
+      }
+      resolveJoins(*join.left);
+      resolveJoins(*join.right);
+    }
+  };
+  resolveJoins(*select.from_table);
+
+  ::duckdb::OrderModifier* orderBy = nullptr;
+  std::optional<int64_t> limit;
+  int64_t offset = 0;
+  bool distinct = false;
+  for (auto& modifier : select.modifiers) {
+    switch (modifier->type) {
+      case ::duckdb::ResultModifierType::ORDER_MODIFIER:
+        orderBy = dynamic_cast<::duckdb::OrderModifier*>(modifier.get());
+        for (auto& order : orderBy->orders) {
+          resolveColumns(order.expression);
+        }
+        break;
+      case ::duckdb::ResultModifierType::LIMIT_MODIFIER: {
+        auto& limitModifier =
+            dynamic_cast<::duckdb::LimitModifier&>(*modifier);
+        if (limitModifier.limit) {
+          limit = asInteger(*limitModifier.limit);
+          VELOX_USER_CHECK(limit.has_value(), "LIMIT must be a constant");
+        }
+        if (limitModifier.offset) {
+          auto value = asInteger(*limitModifier.offset);
+          VELOX_USER_CHECK(value.has_value(), "OFFSET must be a constant");
+          offset = value.value();
+        }
+        break;
+      }
+      case ::duckdb::ResultModifierType::DISTINCT_MODIFIER:
+        VELOX_USER_CHECK(
+            dynamic_cast<::duckdb::DistinctModifier&>(*modifier)
+                .distinct_on_targets.empty(),
+            "DISTINCT ON is not supported");
+        distinct = true;
+        break;
+      default:
+        VELOX_USER_FAIL("Unsupported clause: {}", modifier->ToString());
+    }
+  }
+
+  auto relation = planFrom(*select.from_table, conjuncts);
+  std::vector<std::string> filters;
+  for (const auto& conjunct : conjuncts) {
+    if (conjunct) {
+      filters.push_back(toSql(*conjunct));
+    }
+  }
+  if (!filters.empty()) {
+    relation.builder.filter(andOf(filters));
+  }
+
+  bool hasAggregate = !select.groups.group_expressions.empty();
+  auto findAggregates = [&](const ParsedExpression& expr) {
+    forEachExpr(expr, [&](const ParsedExpression& subexpr) {
+      hasAggregate |= isAggregate(subexpr);
+    });
+  };
+  for (const auto& item : select.select_list) {
+    findAggregates(*item);
+  }
+  if (select.having) {
+    findAggregates(*select.having);
+  }
+  if (hasAggregate) {
+    VELOX_USER_CHECK(!hasStar, "SELECT * is not supported with GROUP BY");
+    planAggregation(select, relation);
+  } else {
+    VELOX_USER_CHECK_NULL(select.having, "HAVING requires an aggregation");
+  }
+
+  // The select list, then the ORDER BY keys which are not in it.
+  std::vector<std::string> projections;
+  std::vector<std::string> outputNames;
+  for (auto i = 0; i < select.select_list.size(); ++i) {
+    const auto& item = *select.select_list[i];
+    if (item.expression_class == ExpressionClass::STAR) {
+      for (const auto& name :
+           relation.builder.planNode()->outputType()->names()) {
+        projections.push_back(name);
+        outputNames.push_back(name);
+      }
+      continue;
+    }
+    std::string name = item.alias;
+    if (name.empty()) {
+      auto* column = asColumn(item);
+      name = column ? column->GetColumnName() : fmt::format("_c{}", i);
+    }
+    projections.push_back(fmt::format("{} AS {}", toSql(item), name));
+    outputNames.push_back(name);
+  }
+
+  std::vector<std::string> orderKeys;
+  if (orderBy) {
+    for (const auto& order : orderBy->orders) {
+      std::optional<std::string> key;
+      const auto& expr = *order.expression;
+      if (auto ordinal = asInteger(expr)) {
+        VELOX_USER_CHECK(
+            *ordinal >= 1 && *ordinal <= outputNames.size(),
+            "ORDER BY position out of range: {}",
+            *ordinal);
+        key = outputNames[*ordinal - 1];
+      } else if (auto* column = asColumn(expr)) {
+        auto it = std::find(
+            outputNames.begin(), outputNames.end(), column->GetColumnName());
+        if (it != outputNames.end()) {
+          key = *it;
+        }
+      }
+      for (auto i = 0; !key && i < select.select_list.size(); ++i) {
+        if (sameExpr(*select.select_list[i], expr)) {
+          key = outputNames[i];
+        }
+      }
+      if (!key) {
+        VELOX_USER_CHECK(
+            !distinct, "ORDER BY keys must be in the select list of DISTINCT");
+        key = fmt::format("_o{}", projections.size());
+        projections.push_back(fmt::format("{} AS {}", toSql(expr), *key));
+      }
+      const bool ascending = order.type != ::duckdb::OrderType::DESCENDING;
+      const bool nullsFirst =
+          order.null_order == ::duckdb::OrderByNullType::NULLS_FIRST;
+      orderKeys.push_back(fmt::format(
+          "{} {} NULLS {}",
+          *key,
+          ascending ? "ASC" : "DESC",
+          nullsFirst ? "FIRST" : "LAST"));
+    }
+  }
+
+  relation.builder.project(projections);
+  if (distinct) {
+    relation.builder.singleAggregation(outputNames, {});
+  }
+  if (!orderKeys.empty()) {
+    if (limit.has_value() && offset == 0) {
+      relation.builder.topN(orderKeys, limit.value(), false);
+    } else {
+      relation.builder.orderBy(orderKeys, false);
+    }
+  }
+  if (limit.has_value() && (orderKeys.empty() || offset > 0)) {
+    relation.builder.limit(offset, limit.value(), false);
+  } else if (!limit.has_value() && offset > 0) {
+    relation.builder.limit(offset, std::numeric_limits<int64_t>::max(), false);
+  }
+  if (projections.size() > outputNames.size()) {
+    relation.builder.project(outputNames);
+  }
+  return {relation.builder.planNode(), std::move(splits_)};
+}
+
+} // namespace
+
+void SqlQueryPlanner::registerTpchTables(
+    double scaleFactor,
+    int32_t numSplits) {
+  for (const auto table : tpch::tables) {
+    Table entry;
+    entry.type = tpch::getTableSchema(table);
+    entry.tpchTable = table;
+    entry.scaleFactor = scaleFactor;
+    entry.numSplits = numSplits;
+    tables_[std::string(tpch::toTableName(table))] = std::move(entry);
+  }
+}
+
+void SqlQueryPlanner::registerHiveTable(
+    const std::string& name,
+    const RowTypePtr& type,
+    std::vector<std::string> dataFiles,
+    dwio::common::FileFormat format,
+    int32_t numSplitsPerFile) {
+  Table entry;
+  entry.type = type;
+  entry.dataFiles = std::move(dataFiles);
+  entry.format = format;
+  entry.numSplitsPerFile = numSplitsPerFile;
+  tables_[name] = std::move(entry);
+}
+
+SqlQueryPlan SqlQueryPlanner::plan(const std::string& sql) const {
+  ::duckdb::Parser parser;
+  try {
+    parser.ParseQuery(sql);
+  } catch (const std::exception& e) {
+    VELOX_USER_FAIL("Cannot parse query: {}", e.what());
+  }
+  VELOX_USER_CHECK_EQ(
+      parser.statements.size(), 1, "Expected a single statement: {}", sql);
+  auto& statement = *parser.statements[0];
+  VELOX_USER_CHECK(
+      statement.type == ::duckdb::StatementType::SELECT_STATEMENT,
+      "Only SELECT is supported: {}",
+      sql);
+  auto& node = *dynamic_cast<::duckdb::SelectStatement&>(statement).node;
+  VELOX_USER_CHECK(
+      node.type == ::duckdb::QueryNodeType::SELECT_NODE,
+      "Set operations are not supported: {}",
+      sql);
+  return SelectTranslator(tables_, pool_).translate(
+      dynamic_cast<SelectNode&>(node));
+}
+
+} // namespace facebook::velox::exec::test
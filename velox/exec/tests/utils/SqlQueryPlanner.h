@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/dwio/common/Options.h"
+#include "velox/exec/Split.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// A plan made from a SQL query with the splits for its table scans.
+struct SqlQueryPlan {
+  core::PlanNodePtr plan;
+  std::unordered_map<core::PlanNodeId, std::vector<Split>> splits;
+};
+
+/// Translates simple SQL queries to Velox plans so that benchmarks and tests
+/// can be written without building each plan with PlanBuilder. Parses the
+/// query with the DuckDB parser and supports SELECT [DISTINCT] with FROM,
+/// WHERE, GROUP BY, HAVING, ORDER BY, LIMIT and OFFSET. FROM is a list of
+/// tables and explicit [INNER | LEFT | RIGHT | FULL] JOIN ... ON clauses.
+///
+/// There is no optimizer. The tables of the FROM list are joined in the order
+/// of the list, picking next the first table with an equality to the tables
+/// joined so far. The equalities between columns of the two sides are the
+/// hash join keys and the right side is the build side. Conditions on a
+/// single table of the list are applied right after its scan, pushed into the
+/// scan for Hive tables. Column names must be unique across the tables of a
+/// query; table qualifiers are accepted and ignored. Subqueries, common table
+/// expressions, window functions and set operations are not supported.
+class SqlQueryPlanner {
+ public:
+  explicit SqlQueryPlanner(memory::MemoryPool* pool) : pool_(pool) {}
+
+  /// Makes the TPC-H tables of 'scaleFactor' available under their standard
+  /// names, e.g. 'lineitem'. Scans of these get 'numSplits' splits each.
+  void registerTpchTables(double scaleFactor, int32_t numSplits = 1);
+
+  /// Makes a Hive table 'name' of 'type' stored in 'dataFiles' of 'format'
+  /// available. Scans of the table get 'numSplitsPerFile' splits per file.
+  void registerHiveTable(
+      const std::string& name,
+      const RowTypePtr& type,
+      std::vector<std::string> dataFiles,
+      dwio::common::FileFormat format,
+      int32_t numSplitsPerFile = 1);
+
+  /// Returns the plan for 'sql'. Throws a user error if 'sql' uses anything
+  /// which is not supported.
+  SqlQueryPlan plan(const std::string& sql) const;
+
+  /// Describes a registered table.
+  struct Table {
+    RowTypePtr type;
+
+    /// Set for TPC-H tables.
+    std::optional<tpch::Table> tpchTable;
+    double scaleFactor{0};
+    int32_t numSplits{1};
+
+    /// Set for Hive tables.
+    std::vector<std::string> dataFiles;
+    dwio::common::FileFormat format{dwio::common::FileFormat::UNKNOWN};
+    int32_t numSplitsPerFile{1};
+  };
+
+ private:
+  memory::MemoryPool* const pool_;
+  std::unordered_map<std::string, Table> tables_;
+};
+
+} // namespace facebook::velox::exec::test
@@ -17,6 +17,13 @@
 #include <fmt/format.h>
 #include <gflags/gflags.h>
 #include <nvrtc.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
 #include "velox/experimental/wave/common/Cuda.h"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
 #include "velox/experimental/wave/common/Exception.h"
@@ -26,6 +33,12 @@ DEFINE_string(
     "compute_70",
     "--gpu-architecture flag for generated code");
 
+DEFINE_string(
+    wave_kernel_cache_path,
+    "",
+    "Directory where compiled Wave kernels are kept across processes, keyed "
+    "by source and device architecture. Empty disables the disk cache");
+
 namespace facebook::velox::wave {
 
 void nvrtcCheck(nvrtcResult result) {
@@ -107,7 +120,227 @@ void getNvrtcOptions(
   }
 }
 
-std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
+namespace {
+// 64 bit FNV-1a. Unlike std::hash, the same in every process.
+void fnvHash(const void* data, size_t size, uint64_t& hash) {
+  auto bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+  }
+}
+
+void fnvHash(const char* string, uint64_t& hash) {
+  size_t size = string ? strlen(string) : 0;
+  fnvHash(&size, sizeof(size), hash);
+  fnvHash(string, size, hash);
+}
+
+// Adds the path and the contents of each header included by 'code' to
+// 'hash' if the header is found in one of 'includeDirs'. Recurses into the
+// headers found. 'visited' has the paths of the headers already added. The
+// headers not found, e.g. the CUDA headers, are covered by the NVRTC version.
+void hashIncludedHeaders(
+    const std::string& code,
+    const std::vector<std::string>& includeDirs,
+    std::unordered_set<std::string>& visited,
+    uint64_t& hash) {
+  std::istringstream lines(code);
+  std::string line;
+  while (std::getline(lines, line)) {
+    auto position = line.find_first_not_of(" \t");
+    if (position == std::string::npos || line[position] != '#') {
+      continue;
+    }
+    position = line.find_first_not_of(" \t", position + 1);
+    if (position == std::string::npos ||
+        line.compare(position, 7, "include") != 0) {
+      continue;
+    }
+    const auto begin = line.find_first_of("\"<", position + 7);
+    if (begin == std::string::npos) {
+      continue;
+    }
+    const auto end = line.find_first_of("\">", begin + 1);
+    if (end == std::string::npos) {
+      continue;
+    }
+    const auto name = line.substr(begin + 1, end - begin - 1);
+    for (const auto& dir : includeDirs) {
+      const auto path = fmt::format("{}/{}", dir, name);
+      std::ifstream in(path, std::ios::binary);
+      if (!in) {
+        continue;
+      }
+      if (visited.insert(path).second) {
+        std::stringstream contents;
+        contents << in.rdbuf();
+        const auto header = contents.str();
+        fnvHash(path.c_str(), hash);
+        fnvHash(header.c_str(), hash);
+        hashIncludedHeaders(header, includeDirs, visited, hash);
+      }
+      break;
+    }
+  }
+}
+
+// Returns the path of the disk cache file for 'spec' compiled with 'opts' for
+// the device of the current context. The key covers the contents of the
+// headers included from the -I directories in 'opts', so that a change of
+// e.g. the struct layouts in the Wave headers does not load a stale cubin.
+std::string diskCachePath(
+    const KernelSpec& spec,
+    const std::vector<const char*>& opts) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  fnvHash(spec.code.c_str(), hash);
+  for (auto i = 0; i < spec.numHeaders; ++i) {
+    fnvHash(spec.headers[i], hash);
+    fnvHash(spec.headerNames ? spec.headerNames[i] : nullptr, hash);
+  }
+  std::vector<std::string> includeDirs;
+  for (auto* opt : opts) {
+    if (strncmp(opt, "-I", 2) == 0) {
+      includeDirs.push_back(opt + 2);
+    }
+  }
+  std::unordered_set<std::string> visited;
+  hashIncludedHeaders(spec.code, includeDirs, visited, hash);
+  for (auto i = 0; i < spec.numHeaders; ++i) {
+    hashIncludedHeaders(spec.headers[i], includeDirs, visited, hash);
+  }
+  for (auto& entry : spec.entryPoints) {
+    fnvHash(entry.c_str(), hash);
+  }
+  for (auto* opt : opts) {
+    fnvHash(opt, hash);
+  }
+  int32_t version[2];
+  nvrtcCheck(nvrtcVersion(&version[0], &version[1]));
+  fnvHash(version, sizeof(version), hash);
+  CUdevice device;
+  CU_CHECK(cuCtxGetDevice(&device));
+  int32_t major;
+  int32_t minor;
+  CU_CHECK(cuDeviceGetAttribute(
+      &major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, device));
+  CU_CHECK(cuDeviceGetAttribute(
+      &minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, device));
+  return fmt::format(
+      "{}/{:016x}_sm{}{}.cubin",
+      FLAGS_wave_kernel_cache_path,
+      hash,
+      major,
+      minor);
+}
+
+// A disk cache file has the number of entry points, the lowered name of each
+// entry point and the cubin. Each is preceded by its size.
+bool readCachedModule(
+    const std::string& path,
+    std::vector<std::string>& loweredNames,
+    std::string& image) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  auto readString = [&](std::string& string) {
+    uint64_t size = 0;
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!in || size > (1UL << 30)) {
+      return false;
+    }
+    string.resize(size);
+    in.read(string.data(), size);
+    return static_cast<bool>(in);
+  };
+  uint64_t numNames = 0;
+  in.read(reinterpret_cast<char*>(&numNames), sizeof(numNames));
+  if (!in || numNames > 10000) {
+    return false;
+  }
+  loweredNames.resize(numNames);
+  for (auto& name : loweredNames) {
+    if (!readString(name)) {
+      return false;
+    }
+  }
+  if (!readString(image)) {
+    loweredNames.clear();
+    return false;
+  }
+  return true;
+}
+
+// Writes the cache file through a temporary file so that a concurrent reader
+// never sees a partial file.
+void writeCachedModule(
+    const std::string& path,
+    const std::vector<std::string>& loweredNames,
+    const std::string& image) {
+  static std::atomic<int64_t> counter{0};
+  std::error_code error;
+  std::filesystem::create_directories(FLAGS_wave_kernel_cache_path, error);
+  auto temp = fmt::format("{}.{}.{}", path, getpid(), ++counter);
+  {
+    std::ofstream out(temp, std::ios::binary);
+    auto writeString = [&](const std::string& string) {
+      uint64_t size = string.size();
+      out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      out.write(string.data(), size);
+    };
+    uint64_t numNames = loweredNames.size();
+    out.write(reinterpret_cast<const char*>(&numNames), sizeof(numNames));
+    for (auto& name : loweredNames) {
+      writeString(name);
+    }
+    writeString(image);
+    if (!out) {
+      LOG(WARNING) << "Error writing Wave kernel cache file " << temp;
+      std::remove(temp.c_str());
+      return;
+    }
+  }
+  if (std::rename(temp.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Error renaming Wave kernel cache file " << temp;
+    std::remove(temp.c_str());
+  }
+}
+
+// Links 'ptx' into a cubin for the device of the current context so that
+// loading the cached module does not run the JIT.
+std::string ptxToCubin(const std::string& ptx) {
+  CUlinkState link;
+  CU_CHECK(cuLinkCreate(0, nullptr, nullptr, &link));
+  void* cubin;
+  size_t size;
+  auto result = cuLinkAddData(
+      link,
+      CU_JIT_INPUT_PTX,
+      const_cast<char*>(ptx.data()),
+      ptx.size(),
+      "wave",
+      0,
+      nullptr,
+      nullptr);
+  if (result == CUDA_SUCCESS) {
+    result = cuLinkComplete(link, &cubin, &size);
+  }
+  std::string image;
+  if (result == CUDA_SUCCESS) {
+    // 'cubin' is owned by 'link'.
+    image.assign(reinterpret_cast<const char*>(cubin), size);
+  }
+  cuLinkDestroy(link);
+  CU_CHECK(result);
+  return image;
+}
+
+// Compiles 'spec' to PTX and sets 'loweredNames' to the mangled names of the
+// entry points.
+std::string compileToPtx(
+    const KernelSpec& spec,
+    std::vector<const char*>& opts,
+    std::vector<std::string>& loweredNames) {
   nvrtcProgram prog;
   nvrtcCreateProgram(
       &prog,
@@ -119,15 +352,6 @@ std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
   for (auto& name : spec.entryPoints) {
     nvrtcCheck(nvrtcAddNameExpression(prog, name.c_str()));
   }
-  std::vector<const char*> opts;
-  std::vector<std::string> optsData;
-#ifndef NDEBUG
-  optsData.push_back("-G");
-#else
-  optsData.push_back("-O3");
-#endif
-  getNvrtcOptions(opts, optsData);
-
   auto compileResult = nvrtcCompileProgram(
       prog, // prog
       opts.size(), // numOptions
@@ -150,7 +374,6 @@ std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
   std::string ptx;
   ptx.resize(ptxSize);
   nvrtcCheck(nvrtcGetPTX(prog, ptx.data()));
-  std::vector<std::string> loweredNames;
   for (auto& entry : spec.entryPoints) {
     const char* temp;
     nvrtcCheck(nvrtcGetLoweredName(prog, entry.c_str(), &temp));
@@ -158,6 +381,35 @@ std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
   }
 
   nvrtcDestroyProgram(&prog);
+  return ptx;
+}
+} // namespace
+
+std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
+  std::vector<const char*> opts;
+  std::vector<std::string> optsData;
+#ifndef NDEBUG
+  optsData.push_back("-G");
+#else
+  optsData.push_back("-O3");
+#endif
+  getNvrtcOptions(opts, optsData);
+
+  // 'image' is PTX or, if from or for the disk cache, a cubin.
+  std::string image;
+  std::vector<std::string> loweredNames;
+  std::string cachePath;
+  if (!FLAGS_wave_kernel_cache_path.empty()) {
+    cachePath = diskCachePath(spec, opts);
+  }
+  if (cachePath.empty() || !readCachedModule(cachePath, loweredNames, image)) {
+    image = compileToPtx(spec, opts, loweredNames);
+    if (!cachePath.empty()) {
+      image = ptxToCubin(image);
+      writeCachedModule(cachePath, loweredNames, image);
+    }
+  }
+
   CUjit_option options[] = {
       CU_JIT_INFO_LOG_BUFFER,
       CU_JIT_INFO_LOG_BUFFER_SIZE_BYTES,
@@ -171,7 +423,7 @@ std::shared_ptr<CompiledModule> CompiledModule::create(const KernelSpec& spec) {
 
   CUmodule module;
   auto loadResult = cuModuleLoadDataEx(
-      &module, ptx.data(), sizeof(values) / sizeof(void*), options, values);
+      &module, image.data(), sizeof(values) / sizeof(void*), options, values);
   if (loadResult != CUDA_SUCCESS) {
     LOG(ERROR) << "Load error " << errorSize << " " << infoSize;
     waveError(fmt::format("Error in load module: {} {}", info, error));
@@ -278,6 +278,13 @@ class CompiledKernel {
       const std::string& key,
       KernelGenFunc func);
 
+  /// Starts background compilation of 'key's kernel and keeps the result in
+  /// the kernel cache, so that a later getKernel() does not wait. Meant for
+  /// kernels of common operator shapes at startup. With
+  /// --wave_kernel_cache_path, the compiled code comes from disk if a
+  /// previous process compiled it.
+  static void prewarm(const std::string& key, KernelGenFunc func);
+
   virtual void launch(
       int32_t idx,
       int32_t numBlocks,
@@ -308,35 +308,68 @@ class GpuHashTable : public GpuHashTableBase {
       for (auto slot = 0; slot < GpuBucketMembers::kNumSlots; ++slot) {
         auto* row = oldBuckets[idx].load<RowType>(slot);
         if (row) {
-          uint64_t h = ops.hashRow(row);
-          auto bucketIdx = h & sizeMask;
-          uint32_t tagWord = hashTag(h);
-          tagWord |= tagWord << 8;
-          tagWord = tagWord | tagWord << 16;
-
-          for (;;) {
-            GpuBucket* bucket = buckets + bucketIdx;
-          reprobe:
-            uint32_t tags = asDeviceAtomic<uint32_t>(&bucket->tags)
-                                ->load(cuda::memory_order_consume);
-            auto misses = __vcmpeq4(tags, 0) & 0x01010101;
-            while (misses) {
-              auto missShift = __ffs(misses) - 1;
-              if (!bucket->addNewTag(tagWord, tags, missShift)) {
-                goto reprobe;
-              }
-              bucket->store(missShift / 8, row);
-              goto next;
-            }
-            bucketIdx = (bucketIdx + 1) & sizeMask;
-          }
+          insertNew(row, ops.hashRow(row));
         }
-      next:;
       }
     }
     __syncthreads();
   }
 
+  /// Inserts 'row' with hash number 'h' without looking for an existing row
+  /// with the same key. Used for rehashing and for building a table of
+  /// distinct keys.
+  template <typename RowType>
+  void __device__ insertNew(RowType* row, uint64_t h) {
+    auto bucketIdx = h & sizeMask;
+    uint32_t tagWord = hashTag(h);
+    tagWord |= tagWord << 8;
+    tagWord = tagWord | tagWord << 16;
+    for (;;) {
+      GpuBucket* bucket = buckets + bucketIdx;
+    reprobe:
+      uint32_t tags = asDeviceAtomic<uint32_t>(&bucket->tags)
+                          ->load(cuda::memory_order_consume);
+      auto misses = __vcmpeq4(tags, 0) & 0x01010101;
+      if (misses) {
+        auto missShift = __ffs(misses) - 1;
+        if (!bucket->addNewTag(tagWord, tags, missShift)) {
+          goto reprobe;
+        }
+        bucket->store(missShift / 8, row);
+        return;
+      }
+      bucketIdx = (bucketIdx + 1) & sizeMask;
+    }
+  }
+
+  /// Returns the row that matches probe row 'i' or nullptr if none. 'h' is the
+  /// hash number of 'i'. For a read-only probe with one row per lane, e.g. a
+  /// join probe inside a Wave program.
+  template <typename RowType, typename Ops>
+  RowType* __device__ find(uint64_t h, int32_t i, Ops& ops) {
+    uint32_t tagWord = hashTag(h);
+    tagWord |= tagWord << 8;
+    tagWord = tagWord | tagWord << 16;
+    auto bucketIdx = h & sizeMask;
+    for (;;) {
+      GpuBucket* bucket = buckets + bucketIdx;
+      auto tags = bucket->tags;
+      auto hits = __vcmpeq4(tags, tagWord) & 0x01010101;
+      while (hits) {
+        auto hitIdx = (__ffs(hits) - 1) / 8;
+        auto* hit = bucket->load<RowType>(hitIdx);
+        if (ops.compare(this, hit, i)) {
+          return hit;
+        }
+        hits = hits & (hits - 1);
+      }
+      if (__vcmpeq4(tags, 0)) {
+        return nullptr;
+      }
+      bucketIdx = (bucketIdx + 1) & sizeMask;
+    }
+  }
+
   int32_t __device__ partitionIdx(uint64_t h) const {
     return partitionMask == 0 ? 0 : (h >> 41) & partitionMask;
   }
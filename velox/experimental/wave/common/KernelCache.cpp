@@ -137,4 +137,10 @@ std::unique_ptr<CompiledKernel> CompiledKernel::getKernel(
   return std::make_unique<AsyncCompiledKernel>(std::move(ptr));
 }
 
+//  static
+void CompiledKernel::prewarm(const std::string& key, KernelGenFunc gen) {
+  // The module stays in the cache after the returned reference is dropped.
+  kernelCache().generate(key, &gen);
+}
+
 } // namespace facebook::velox::wave
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define PLATFORM_CUDA
+
+// clang-format off
+#define CUDA_PLATFORM_SPECIALIZATION_HEADER \
+  breeze/platforms/specialization/cuda-ptx.cuh
+// clang-format on
+
+#include <breeze/algorithms/sort.h>
+#include <breeze/functions/load.h>
+#include <breeze/functions/scan.h>
+#include <breeze/functions/store.h>
+#include <breeze/platforms/platform.h>
+#include <breeze/platforms/cuda.cuh>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/RadixSort.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+using namespace breeze::algorithms;
+using namespace breeze::functions;
+using namespace breeze::utils;
+
+constexpr int32_t kBlockThreads = 256;
+constexpr int32_t kWarpThreads = 32;
+constexpr int32_t kItemsPerThread = 8;
+constexpr int32_t kBlockItems = kBlockThreads * kItemsPerThread;
+constexpr int32_t kRadixBits = 8;
+constexpr int32_t kNumBins = 1 << kRadixBits;
+// The passes are over the 32 bit prefixes in the high half of the sort keys.
+// The row numbers in the low half are already in order.
+constexpr int32_t kNumPasses = 32 / kRadixBits;
+constexpr int32_t kHistogramSize = kNumBins * kNumPasses;
+constexpr int32_t kHistogramItemsPerThread = 8;
+constexpr int32_t kHistogramTileSize = 16;
+constexpr int32_t kHistogramTileItems =
+    kBlockThreads * kHistogramItemsPerThread * kHistogramTileSize;
+
+using SortKey = unsigned long long;
+using HistogramT = DeviceRadixSortHistogram<kRadixBits, unsigned>;
+
+// Fixed size part of the temporary memory. Followed by two arrays of sort
+// keys and the block states of all passes.
+struct SortTemp {
+  unsigned histogram[kHistogramSize];
+  unsigned offsets[kHistogramSize];
+  int nextBlockIdx[kNumPasses];
+};
+
+int32_t numSortBlocks(int32_t numRows) {
+  return (numRows + kBlockItems - 1) / kBlockItems;
+}
+
+int64_t keysOffset() {
+  return roundUp(sizeof(SortTemp), sizeof(SortKey));
+}
+
+__global__ __launch_bounds__(kBlockThreads) void packKeysKernel(
+    const uint32_t* prefixes,
+    int32_t numRows,
+    SortKey* keys) {
+  for (int32_t row = blockIdx.x * blockDim.x + threadIdx.x; row < numRows;
+       row += gridDim.x * blockDim.x) {
+    keys[row] = static_cast<SortKey>(prefixes[row]) << 32 | row;
+  }
+}
+
+__global__ __launch_bounds__(kBlockThreads) void histogramKernel(
+    const uint32_t* prefixes,
+    unsigned* histogram,
+    int32_t numRows) {
+  CudaPlatform<kBlockThreads, kWarpThreads> p;
+  __shared__ typename HistogramT::Scratch scratch;
+  HistogramT::template Build<kHistogramItemsPerThread, kHistogramTileSize>(
+      p,
+      make_slice<GLOBAL>(prefixes),
+      make_slice<GLOBAL>(histogram),
+      make_slice(&scratch).template reinterpret<SHARED>(),
+      numRows);
+}
+
+// Turns the counts of each pass into the start offsets of the bins. One
+// block per pass.
+__global__ __launch_bounds__(kBlockThreads) void offsetsKernel(
+    const unsigned* histogram,
+    unsigned* offsets) {
+  CudaPlatform<kBlockThreads, kWarpThreads> p;
+  using BlockScanT = BlockScan<decltype(p), unsigned, 1>;
+  __shared__ typename BlockScanT::Scratch scratch;
+  unsigned items[1];
+  unsigned sums[1];
+  const unsigned* counts = histogram + p.block_idx() * kNumBins;
+  BlockLoad<kBlockThreads, 1>(
+      p, make_slice<GLOBAL>(counts), make_slice(items), kNumBins);
+  BlockScanT::template Scan<ScanOpAdd>(
+      p,
+      make_slice(items),
+      make_slice(sums),
+      make_slice<SHARED>(&scratch),
+      kNumBins);
+  sums[0] -= items[0];
+  BlockStore<kBlockThreads, 1>(
+      p,
+      make_slice(sums),
+      make_slice<GLOBAL>(offsets + p.block_idx() * kNumBins),
+      kNumBins);
+}
+
+__global__ __launch_bounds__(kBlockThreads) void sortPassKernel(
+    const SortKey* in,
+    const unsigned* offsets,
+    int32_t startBit,
+    SortKey* out,
+    int* nextBlockIdx,
+    unsigned* blocks,
+    int32_t numRows) {
+  CudaPlatform<kBlockThreads, kWarpThreads> p;
+  using RadixSortT =
+      DeviceRadixSort<decltype(p), kItemsPerThread, kRadixBits, SortKey>;
+  __shared__ typename RadixSortT::Scratch scratch;
+  RadixSortT::template Sort<unsigned>(
+      p,
+      make_slice<GLOBAL>(in),
+      make_slice<GLOBAL>(offsets),
+      startBit,
+      kRadixBits,
+      make_slice<GLOBAL>(out),
+      make_slice<GLOBAL>(nextBlockIdx),
+      make_slice<GLOBAL>(blocks),
+      make_slice(&scratch).template reinterpret<SHARED>(),
+      numRows);
+}
+
+__global__ __launch_bounds__(kBlockThreads) void unpackRowsKernel(
+    const SortKey* keys,
+    int32_t numRows,
+    int32_t* permutation) {
+  for (int32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < numRows;
+       i += gridDim.x * blockDim.x) {
+    permutation[i] = static_cast<int32_t>(keys[i]);
+  }
+}
+
+} // namespace
+
+int64_t radixSortTempBytes(int32_t numRows) {
+  return keysOffset() + 2 * sizeof(SortKey) * numRows +
+      sizeof(unsigned) * numSortBlocks(numRows) * kNumBins * kNumPasses;
+}
+
+void radixSortPermutation(
+    Stream& stream,
+    const uint32_t* prefixes,
+    int32_t numRows,
+    int32_t* permutation,
+    void* temp) {
+  // The block states of the sort keep the offsets in 30 bits.
+  VELOX_CHECK_LT(numRows, 1 << SORT_BLOCK_STATUS_SHIFT);
+  if (numRows == 0) {
+    return;
+  }
+  auto cudaStream = stream.stream()->stream;
+  auto* sortTemp = reinterpret_cast<SortTemp*>(temp);
+  SortKey* keys[2];
+  keys[0] =
+      reinterpret_cast<SortKey*>(reinterpret_cast<char*>(temp) + keysOffset());
+  keys[1] = keys[0] + numRows;
+  auto* blocks = reinterpret_cast<unsigned*>(keys[1] + numRows);
+  const auto numBlocks = numSortBlocks(numRows);
+
+  stream.memset(sortTemp, 0, sizeof(SortTemp));
+  stream.memset(
+      blocks, 0, sizeof(unsigned) * numBlocks * kNumBins * kNumPasses);
+
+  const int32_t numGridBlocks =
+      std::min<int32_t>(roundUp(numRows, kBlockThreads) / kBlockThreads, 1024);
+  packKeysKernel<<<numGridBlocks, kBlockThreads, 0, cudaStream>>>(
+      prefixes, numRows, keys[0]);
+  CUDA_CHECK(cudaGetLastError());
+  const int32_t numHistogramBlocks =
+      (numRows + kHistogramTileItems - 1) / kHistogramTileItems;
+  histogramKernel<<<numHistogramBlocks, kBlockThreads, 0, cudaStream>>>(
+      prefixes, sortTemp->histogram, numRows);
+  CUDA_CHECK(cudaGetLastError());
+  offsetsKernel<<<kNumPasses, kBlockThreads, 0, cudaStream>>>(
+      sortTemp->histogram, sortTemp->offsets);
+  CUDA_CHECK(cudaGetLastError());
+
+  // An even number of passes leaves the result in 'keys[0]'.
+  static_assert(kNumPasses % 2 == 0);
+  for (auto pass = 0; pass < kNumPasses; ++pass) {
+    sortPassKernel<<<numBlocks, kBlockThreads, 0, cudaStream>>>(
+        keys[pass % 2],
+        sortTemp->offsets + pass * kNumBins,
+        32 + pass * kRadixBits,
+        keys[(pass + 1) % 2],
+        &sortTemp->nextBlockIdx[pass],
+        blocks + pass * numBlocks * kNumBins,
+        numRows);
+    CUDA_CHECK(cudaGetLastError());
+  }
+  unpackRowsKernel<<<numGridBlocks, kBlockThreads, 0, cudaStream>>>(
+      keys[0], numRows, permutation);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
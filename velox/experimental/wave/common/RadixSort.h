@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "velox/experimental/wave/common/Cuda.h"
+
+/// Device sort of normalized key prefixes for OrderBy and TopN, built on the
+/// Breeze radix sort.
+
+namespace facebook::velox::wave {
+
+/// Returns a 32 bit prefix of 'value' whose unsigned order is the order of
+/// the values, reversed if 'ascending' is false.
+inline uint32_t normalizedPrefix(int64_t value, bool ascending) {
+  uint32_t prefix = (static_cast<uint64_t>(value) ^ (1ULL << 63)) >> 32;
+  return ascending ? prefix : ~prefix;
+}
+
+/// Same as above for a double. NaN sorts after all other values.
+inline uint32_t normalizedPrefix(double value, bool ascending) {
+  if (std::isnan(value)) {
+    // A NaN with the sign bit set would otherwise sort first.
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bits = (bits & (1ULL << 63)) ? ~bits : bits ^ (1ULL << 63);
+  uint32_t prefix = bits >> 32;
+  return ascending ? prefix : ~prefix;
+}
+
+/// Returns the device bytes of temporary memory for sorting 'numRows'.
+int64_t radixSortTempBytes(int32_t numRows);
+
+/// Enqueues on 'stream' a stable sort of the 'numRows' device resident
+/// 'prefixes' and writes the row numbers in ascending prefix order to
+/// 'permutation'. 'temp' is device memory of radixSortTempBytes(numRows).
+/// Rows with equal prefixes stay in input order, so that the caller
+/// compares the full keys only inside runs of equal prefixes. The
+/// permutation can be used for a gather on host or on device.
+void radixSortPermutation(
+    Stream& stream,
+    const uint32_t* prefixes,
+    int32_t numRows,
+    int32_t* permutation,
+    void* temp);
+
+} // namespace facebook::velox::wave
@@ -17,7 +17,11 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <fmt/format.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <filesystem>
 #include "velox/experimental/wave/common/Buffer.h"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
 #include "velox/experimental/wave/common/Exception.h"
@@ -26,6 +30,8 @@
 
 #include <iostream>
 
+DECLARE_string(wave_kernel_cache_path);
+
 namespace facebook::velox::wave {
 
 void testCuCheck(CUresult result) {
@@ -119,6 +125,44 @@ TEST_F(CompileTest, module) {
   EXPECT_EQ(6, ptr[0]);
 }
 
+TEST_F(CompileTest, diskCache) {
+  gflags::FlagSaver saver;
+  auto dir = std::filesystem::temp_directory_path() /
+      fmt::format("wave_kernel_cache_{}", getpid());
+  std::filesystem::remove_all(dir);
+  FLAGS_wave_kernel_cache_path = dir.string();
+  KernelSpec spec = KernelSpec{
+      kernelText,
+      {"facebook::velox::wave::add1", "facebook::velox::wave::add2"},
+      "/tmp/add1.cu"};
+  auto countFiles = [&]() {
+    return std::distance(
+        std::filesystem::directory_iterator(dir),
+        std::filesystem::directory_iterator());
+  };
+  auto buffer = arena_->allocate<int32_t>(1000);
+  memset(buffer->as<int32_t>(), 0, sizeof(int32_t) * 1000);
+  KernelParams record{buffer->as<int32_t>(), 1000};
+  void* recordPtr = &record;
+  auto stream = std::make_unique<Stream>();
+
+  // The first create compiles and writes the cache file. The second loads it.
+  auto compiled = CompiledModule::create(spec);
+  compiled->launch(0, 1, 256, 0, stream.get(), &recordPtr);
+  EXPECT_EQ(1, countFiles());
+  auto loaded = CompiledModule::create(spec);
+  loaded->launch(1, 1, 256, 0, stream.get(), &recordPtr);
+  stream->wait();
+  EXPECT_EQ(1, countFiles());
+  EXPECT_EQ(3, buffer->as<int32_t>()[0]);
+
+  // Different code gets a different file.
+  spec.code += "\n";
+  CompiledModule::create(spec);
+  EXPECT_EQ(2, countFiles());
+  std::filesystem::remove_all(dir);
+}
+
 TEST_F(CompileTest, cache) {
   KernelSpec spec = KernelSpec{
       kernelText,
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include "velox/experimental/wave/common/Buffer.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/common/RadixSort.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+class RadixSortTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, getAllocator(device_));
+    stream_ = std::make_unique<Stream>();
+  }
+
+  // Sorts 'prefixes' on device and checks that the permutation is the
+  // stable order of the prefixes.
+  void testSort(const std::vector<uint32_t>& prefixes) {
+    const int32_t numRows = prefixes.size();
+    auto prefixBuffer = arena_->allocate<uint32_t>(numRows);
+    std::copy(prefixes.begin(), prefixes.end(), prefixBuffer->as<uint32_t>());
+    auto permutationBuffer = arena_->allocate<int32_t>(numRows);
+    auto temp = arena_->allocateBytes(radixSortTempBytes(numRows));
+    radixSortPermutation(
+        *stream_,
+        prefixBuffer->as<uint32_t>(),
+        numRows,
+        permutationBuffer->as<int32_t>(),
+        temp->as<char>());
+    stream_->wait();
+
+    std::vector<int32_t> expected(numRows);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(expected.begin(), expected.end(), [&](auto l, auto r) {
+      return prefixes[l] < prefixes[r];
+    });
+    auto* permutation = permutationBuffer->as<int32_t>();
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(expected[i], permutation[i]) << "at " << i;
+    }
+  }
+
+  Device* device_;
+  std::unique_ptr<GpuArena> arena_;
+  std::unique_ptr<Stream> stream_;
+};
+
+TEST_F(RadixSortTest, random) {
+  std::mt19937 rng(1);
+  for (auto numRows : {1, 100, 2048, 100'000, 1'000'000}) {
+    std::vector<uint32_t> prefixes(numRows);
+    for (auto& prefix : prefixes) {
+      prefix = rng();
+    }
+    testSort(prefixes);
+  }
+}
+
+TEST_F(RadixSortTest, duplicates) {
+  std::mt19937 rng(1);
+  std::vector<uint32_t> prefixes(300'000);
+  for (auto& prefix : prefixes) {
+    prefix = rng() % 100;
+  }
+  testSort(prefixes);
+  // All prefixes equal.
+  testSort(std::vector<uint32_t>(10'000, 7));
+}
+
+TEST_F(RadixSortTest, normalizedPrefix) {
+  std::vector<int64_t> values = {
+      std::numeric_limits<int64_t>::min(), -(1LL << 40), -1, 0, 1LL << 33};
+  for (auto i = 1; i < values.size(); ++i) {
+    EXPECT_LT(
+        normalizedPrefix(values[i - 1], true),
+        normalizedPrefix(values[i], true));
+    EXPECT_GT(
+        normalizedPrefix(values[i - 1], false),
+        normalizedPrefix(values[i], false));
+  }
+  std::vector<double> doubles = {
+      -std::numeric_limits<double>::infinity(), -1e10, -1.5, 0, 2.5, 1e300};
+  for (auto i = 1; i < doubles.size(); ++i) {
+    EXPECT_LT(
+        normalizedPrefix(doubles[i - 1], true),
+        normalizedPrefix(doubles[i], true));
+  }
+  // NaNs sort after infinity regardless of their sign bit.
+  const auto infinity =
+      normalizedPrefix(std::numeric_limits<double>::infinity(), true);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_LT(infinity, normalizedPrefix(nan, true));
+  EXPECT_LT(infinity, normalizedPrefix(-nan, true));
+  EXPECT_EQ(normalizedPrefix(nan, true), normalizedPrefix(-nan, true));
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -52,18 +52,43 @@ void SplitStaging::registerPointerInternal(
   patch_.push_back(std::make_pair(id, ptr));
 }
 
-void SplitStaging::copyColumns(
-    int32_t begin,
-    int32_t end,
-    char* destination,
-    bool release) {
+void SplitStaging::copyColumns(int32_t begin, int32_t end) {
+  auto* destination = hostBuffer_->as<char>();
   for (auto i = begin; i < end; ++i) {
-    memcpy(destination, staging_[i].hostData, staging_[i].size);
-    destination += staging_[i].size;
+    memcpy(destination + offsets_[i], staging_[i].hostData, staging_[i].size);
   }
-  if (release) {
-    sem_.release();
+}
+
+void SplitStaging::copyAndTransfer(
+    WaveStream& waveStream,
+    Stream& stream,
+    bool recordEvent) {
+  WaveTime startTime = WaveTime::now();
+  auto& stats = waveStream.stats();
+  copyColumns(shards_[0].begin, shards_[0].end);
+  for (auto& shard : shards_) {
+    if (shard.done) {
+      WaveTime waitStart = WaveTime::now();
+      shard.done->acquire();
+      stats.stagingWaitTime += WaveTime::now() - waitStart;
+    }
+    auto offset = offsets_[shard.begin];
+    auto end = shard.end == staging_.size() ? fill_ : offsets_[shard.end];
+    stream.hostToDeviceAsync(
+        deviceBuffer_->as<char>() + offset,
+        hostBuffer_->as<char>() + offset,
+        end - offset);
+    ++stats.numTransfers;
   }
+  stats.stagingTime += WaveTime::now() - startTime;
+  if (recordEvent) {
+    event_ = std::make_unique<Event>();
+    event_->record(stream);
+  }
+  fill_ = 0;
+  patch_.clear();
+  offsets_.clear();
+  shards_.clear();
 }
 
 // Shared pool of 1-2GB of pinned host memory for staging. May
@@ -94,74 +119,45 @@ void SplitStaging::transfer(
   WaveTime startTime = WaveTime::now();
   deviceBuffer_ = waveStream.deviceArena().allocate<char>(fill_);
   hostBuffer_ = getTransferArena().allocate<char>(fill_);
-  auto transferBuffer = hostBuffer_->as<char>();
-  int firstToCopy = 0;
-  int32_t numCopies = staging_.size();
-  int64_t copySize = 0;
+  // Large transfers are cut into shards of about
+  // 'FLAGS_staging_bytes_per_thread'. The first shard is copied by the
+  // calling thread, the others in parallel on the copy executor.
+  int32_t firstInShard = 0;
+  int64_t shardSize = 0;
   auto targetCopySize = FLAGS_staging_bytes_per_thread;
-  int32_t numThreads = 0;
-  if (fill_ > 2000000) {
-    for (auto i = 0; i < staging_.size(); ++i) {
-      auto columnSize = staging_[i].size;
-      copySize += columnSize;
-      if (copySize >= targetCopySize && i < staging_.size() - 1) {
-        ++numThreads;
-        WaveStream::copyExecutor()->add(
-            [i, firstToCopy, transferBuffer, this]() {
-              copyColumns(firstToCopy, i + 1, transferBuffer, true);
-            });
-        transferBuffer += copySize;
-        copySize = 0;
-        firstToCopy = i + 1;
-      }
+  for (auto i = 0; i < staging_.size(); ++i) {
+    shardSize += staging_[i].size;
+    if (i == staging_.size() - 1 ||
+        (fill_ > 2000000 && shardSize >= targetCopySize)) {
+      shards_.push_back({firstInShard, i + 1, nullptr});
+      firstInShard = i + 1;
+      shardSize = 0;
     }
   }
+  for (auto i = 1; i < shards_.size(); ++i) {
+    auto& shard = shards_[i];
+    shard.done = std::make_unique<Semaphore>(0);
+    auto* done = shard.done.get();
+    WaveStream::copyExecutor()->add(
+        [begin = shard.begin, end = shard.end, done, this]() {
+          copyColumns(begin, end);
+          done->release();
+        });
+  }
   auto deviceData = deviceBuffer_->as<char>();
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
         reinterpret_cast<int64_t>(deviceData) + offsets_[pair.first];
   }
+  waveStream.stats().stagingTime += WaveTime::now() - startTime;
   if (asyncTail) {
-    WaveStream::syncExecutor()->add([firstToCopy,
-                                     numThreads,
-                                     transferBuffer,
-                                     asyncTail,
-                                     &waveStream,
-                                     &stream,
-                                     recordEvent,
-                                     startTime,
-                                     this]() {
-      copyColumns(firstToCopy, staging_.size(), transferBuffer, false);
-      for (auto i = 0; i < numThreads; ++i) {
-        sem_.acquire();
-      }
-      stream.hostToDeviceAsync(
-          deviceBuffer_->as<char>(), hostBuffer_->as<char>(), fill_);
-      waveStream.stats().stagingTime += WaveTime::now() - startTime;
-      if (recordEvent) {
-        event_ = std::make_unique<Event>();
-        event_->record(stream);
-      }
-      fill_ = 0;
-      patch_.clear();
-      offsets_.clear();
-      asyncTail(waveStream, stream);
-    });
+    WaveStream::syncExecutor()->add(
+        [asyncTail, &waveStream, &stream, recordEvent, this]() {
+          copyAndTransfer(waveStream, stream, recordEvent);
+          asyncTail(waveStream, stream);
+        });
   } else {
-    copyColumns(firstToCopy, staging_.size(), transferBuffer, false);
-    for (auto i = 0; i < numThreads; ++i) {
-      sem_.acquire();
-    }
-    stream.hostToDeviceAsync(
-        deviceBuffer_->as<char>(), hostBuffer_->as<char>(), fill_);
-    waveStream.stats().stagingTime += WaveTime::now() - startTime;
-    if (recordEvent) {
-      event_ = std::make_unique<Event>();
-      event_->record(stream);
-    }
-    fill_ = 0;
-    patch_.clear();
-    offsets_.clear();
+    copyAndTransfer(waveStream, stream, recordEvent);
   }
 }
 
@@ -125,9 +125,26 @@ class SplitStaging {
   }
 
  private:
+  // A range of staged columns copied to pinned memory by one thread and then
+  // transferred to device by one copy.
+  struct CopyShard {
+    int32_t begin;
+    int32_t end;
+    // Released when the copy to pinned memory is done. nullptr for the shard
+    // copied by the thread calling transfer().
+    std::unique_ptr<Semaphore> done;
+  };
+
   void registerPointerInternal(BufferId id, void** ptr, bool clear);
 
-  void copyColumns(int32_t begin, int32_t end, char* destination, bool release);
+  // Copies the staged columns from 'begin' to 'end' to 'hostBuffer_'.
+  void copyColumns(int32_t begin, int32_t end);
+
+  // Copies the first shard and enqueues the host to device copy of each
+  // shard on 'stream' as soon as the shard is in pinned memory, so that the
+  // transfer of the first shards overlaps with the copy of the others.
+  void
+  copyAndTransfer(WaveStream& waveStream, Stream& stream, bool recordEvent);
 
   const int32_t id_;
 
@@ -153,8 +170,8 @@ class SplitStaging {
   // kernels on other streams.
   std::unique_ptr<Event> event_;
 
-  // Synchronizes arrival of multithreaded memcpy
-  Semaphore sem_{0};
+  // Shards of 'staging_' for the transfer in progress.
+  std::vector<CopyShard> shards_;
 
   FileInfo& fileInfo_;
 
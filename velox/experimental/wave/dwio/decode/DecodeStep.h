@@ -94,9 +94,30 @@ enum class DecodeStep {
   kFlatMapNode,
   kRowCountNoFilter,
   kCountBits,
+  kRleBitpacked,
+  kDeltaBinaryPacked,
   kUnsupported,
 };
 
+/// A run of Parquet RLE/bit-packed hybrid encoded data. See
+/// scanRleBitpackedRuns().
+struct RleBitpackedRun {
+  /// Number of values before the run.
+  int32_t row;
+  /// Byte offset of the repeated value or of the bit-packed values.
+  int32_t offset;
+  bool isRle;
+};
+
+/// A miniblock of Parquet DELTA_BINARY_PACKED encoded data. See
+/// scanDeltaBinaryPacked().
+struct alignas(16) DeltaMiniblock {
+  int64_t minDelta;
+  /// Byte offset of the bit-packed deltas.
+  int32_t offset;
+  uint8_t bitWidth;
+};
+
 class ColumnReader;
 
 /// Describes a decoding loop's input and result disposition.
@@ -346,6 +367,44 @@ struct alignas(16) GpuDecode {
     // One int per warp (blockDim.x/32).
   };
 
+  struct RleBitpacked {
+    // Type of the result and of 'alphabet'.
+    WaveTypeKind dataType;
+    // Encoded data, starting at the first run header.
+    const uint8_t* input;
+    // Runs of 'input'. Offsets are relative to 'input'.
+    const RleBitpackedRun* runs;
+    int32_t numRuns;
+    // Bit width of each value. At most 32.
+    int32_t bitWidth;
+    // Begin position for decoded values, scatter and result.
+    int32_t begin;
+    // End position (exclusive) for decoded values, scatter and result.
+    int32_t end;
+    // Dictionary alphabet. If nullptr, the decoded values are the result,
+    // e.g. for repetition and definition levels.
+    const void* alphabet;
+    // If not null, contains the output position relative to result pointer.
+    const int32_t* scatter;
+    // Starting address of the result.
+    void* result;
+  };
+
+  struct DeltaBinaryPacked {
+    // INTEGER or BIGINT.
+    WaveTypeKind dataType;
+    // Encoded data, starting at the page header.
+    const uint8_t* input;
+    // Miniblocks of 'input'. Offsets are relative to 'input'.
+    const DeltaMiniblock* miniblocks;
+    int32_t valuesPerMiniblock;
+    int64_t firstValue;
+    // Number of values to decode, starting at the first value of the page.
+    int32_t numValues;
+    // Starting address of the result.
+    void* result;
+  };
+
   struct CompactValues {
     // Selected row numbers from the source filtered column.
     int32_t* sourceRows;
@@ -370,6 +429,8 @@ struct alignas(16) GpuDecode {
     MakeScatterIndices makeScatterIndices;
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
+    RleBitpacked rleBitpacked;
+    DeltaBinaryPacked deltaBinaryPacked;
     CompactValues compact;
   } data;
 
@@ -601,6 +601,128 @@ __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   }
 }
 
+// Returns the index of the run that contains 'row'.
+inline __device__ int32_t
+findRun(const RleBitpackedRun* runs, int32_t numRuns, int32_t row) {
+  int32_t lo = 0, hi = numRuns;
+  while (hi - lo > 1) {
+    int32_t i = (lo + hi) / 2;
+    if (runs[i].row <= row) {
+      lo = i;
+    } else {
+      hi = i;
+    }
+  }
+  return lo;
+}
+
+template <typename T>
+__device__ void decodeRleBitpacked(GpuDecode::RleBitpacked& op) {
+  auto width = op.bitWidth;
+  auto input = op.input;
+  auto runs = op.runs;
+  auto dict = reinterpret_cast<const T*>(op.alphabet);
+  auto scatter = op.scatter;
+  auto result = reinterpret_cast<T*>(op.result);
+  for (auto i = op.begin + threadIdx.x; i < op.end; i += blockDim.x) {
+    const auto& run = runs[findRun(runs, op.numRuns, i)];
+    uint32_t value = 0;
+    if (run.isRle) {
+      // The repeated value is in the next ceil(width / 8) bytes, little
+      // endian.
+      for (auto byte = 0; byte < (width + 7) / 8; ++byte) {
+        value |= static_cast<uint32_t>(input[run.offset + byte]) << (byte * 8);
+      }
+    } else if (width > 0) {
+      value = loadBits32(input + run.offset, (i - run.row) * width, width);
+    }
+    auto target = scatter ? scatter[i] : i;
+    result[target] = dict ? dict[value] : static_cast<T>(value);
+  }
+}
+
+__device__ inline void decodeRleBitpacked(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpacked;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpacked<uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpacked<uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpacked<uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpacked<uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpacked\n");
+      }
+  }
+}
+
+// Decodes all the values of a DELTA_BINARY_PACKED page in one TB. Each value
+// is the first value plus the sum of the deltas before it, which is a prefix
+// sum over the TB with a carry from the previous 'kBlockSize' values. The
+// arithmetic wraps around like in the Parquet spec.
+template <int kBlockSize, typename T>
+__device__ void decodeDeltaBinaryPacked(GpuDecode::DeltaBinaryPacked& op) {
+  using BlockScan = cub::BlockScan<uint64_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  auto result = reinterpret_cast<T*>(op.result);
+  auto numValues = op.numValues;
+  auto valuesPerMiniblock = op.valuesPerMiniblock;
+  uint64_t carry = op.firstValue;
+  for (int32_t base = 0; base < numValues; base += kBlockSize) {
+    auto i = base + threadIdx.x;
+    // Value i is preceded by delta i - 1.
+    uint64_t delta = 0;
+    if (i > 0 && i < numValues) {
+      auto nth = i - 1;
+      const auto& miniblock = op.miniblocks[nth / valuesPerMiniblock];
+      auto width = miniblock.bitWidth;
+      auto bitIndex = (nth % valuesPerMiniblock) * width;
+      auto bits = op.input + miniblock.offset;
+      delta = miniblock.minDelta;
+      if (width > 32) {
+        delta += loadBits64(bits, bitIndex, width);
+      } else if (width > 0) {
+        delta += loadBits32(bits, bitIndex, width);
+      }
+    }
+    uint64_t sum;
+    uint64_t total;
+    BlockScan(*scanStorage).InclusiveSum(delta, sum, total);
+    if (i < numValues) {
+      result[i] = static_cast<T>(carry + sum);
+    }
+    carry += total;
+    __syncthreads();
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeDeltaBinaryPacked(GpuDecode& plan) {
+  auto& op = plan.data.deltaBinaryPacked;
+  switch (op.dataType) {
+    case WaveTypeKind::INTEGER:
+      decodeDeltaBinaryPacked<kBlockSize, int32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+      decodeDeltaBinaryPacked<kBlockSize, int64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for DeltaBinaryPacked\n");
+      }
+  }
+}
+
 template <typename T, DecodeStep kEncoding>
 inline __device__ T randomAccessDecode(const GpuDecode* op, int32_t idx) {
   switch (kEncoding) {
@@ -1104,6 +1226,12 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kRleBitpacked:
+      detail::decodeRleBitpacked(op);
+      break;
+    case DecodeStep::kDeltaBinaryPacked:
+      detail::decodeDeltaBinaryPacked<kBlockSize>(op);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf(
@@ -1123,6 +1251,7 @@ template <int32_t kBlockSize>
 int32_t sharedMemorySizeForDecode(DecodeStep step) {
   using Reduce32 = cub::BlockReduce<int32_t, kBlockSize>;
   using BlockScan32 = cub::BlockScan<int32_t, kBlockSize>;
+  using BlockScan64 = cub::BlockScan<uint64_t, kBlockSize>;
   switch (step) {
     case DecodeStep::kSelective32:
     case DecodeStep::kSelective64:
@@ -1132,6 +1261,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kRleBitpacked:
       return 0;
       break;
 
@@ -1144,6 +1274,8 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kDeltaBinaryPacked:
+      return sizeof(typename BlockScan64::TempStorage);
     default:
       assert(false); // Undefined.
       return 0;
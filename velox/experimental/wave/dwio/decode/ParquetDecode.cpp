@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/decode/ParquetDecode.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::wave {
+namespace {
+uint64_t readVarint(const uint8_t*& pos, const uint8_t* end) {
+  uint64_t value = 0;
+  for (auto shift = 0; shift < 64; shift += 7) {
+    VELOX_CHECK_LT(pos, end, "Truncated varint in Parquet page");
+    auto byte = *pos++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  VELOX_FAIL("Bad varint in Parquet page");
+}
+
+int64_t readZigzag(const uint8_t*& pos, const uint8_t* end) {
+  auto value = readVarint(pos, end);
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+} // namespace
+
+int32_t scanRleBitpackedRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    std::vector<RleBitpackedRun>& runs) {
+  VELOX_CHECK_LE(bitWidth, 32);
+  const auto* pos = data;
+  const auto* end = data + size;
+  int32_t numValues = 0;
+  while (pos < end) {
+    auto header = readVarint(pos, end);
+    RleBitpackedRun run;
+    run.row = numValues;
+    run.offset = pos - data;
+    run.isRle = (header & 1) == 0;
+    if (run.isRle) {
+      numValues += header >> 1;
+      pos += (bitWidth + 7) / 8;
+    } else {
+      // Groups of 8 values, i.e. 'bitWidth' bytes per group.
+      auto numGroups = header >> 1;
+      numValues += numGroups * 8;
+      pos += numGroups * bitWidth;
+    }
+    VELOX_CHECK_LE(pos, end, "Truncated RLE/bit-packed run in Parquet page");
+    runs.push_back(run);
+  }
+  return numValues;
+}
+
+int32_t scanDeltaBinaryPacked(
+    const uint8_t* data,
+    int32_t size,
+    int32_t& valuesPerMiniblock,
+    int64_t& firstValue,
+    std::vector<DeltaMiniblock>& miniblocks) {
+  const auto* pos = data;
+  const auto* end = data + size;
+  const auto blockSize = readVarint(pos, end);
+  const auto miniblocksPerBlock = readVarint(pos, end);
+  const int32_t numValues = readVarint(pos, end);
+  firstValue = readZigzag(pos, end);
+  VELOX_CHECK(
+      miniblocksPerBlock > 0 && blockSize % miniblocksPerBlock == 0,
+      "Bad DELTA_BINARY_PACKED header");
+  valuesPerMiniblock = blockSize / miniblocksPerBlock;
+  VELOX_CHECK_EQ(valuesPerMiniblock % 32, 0, "Bad DELTA_BINARY_PACKED header");
+  miniblocks.clear();
+  // The first value is in the header, the others are deltas. The miniblocks
+  // which have no deltas are left out at the end of the last block.
+  int64_t numDeltas = numValues > 0 ? numValues - 1 : 0;
+  while (numDeltas > 0) {
+    auto minDelta = readZigzag(pos, end);
+    const auto* widths = pos;
+    pos += miniblocksPerBlock;
+    VELOX_CHECK_LE(pos, end, "Truncated DELTA_BINARY_PACKED block");
+    for (auto i = 0; i < miniblocksPerBlock && numDeltas > 0; ++i) {
+      DeltaMiniblock miniblock;
+      miniblock.minDelta = minDelta;
+      miniblock.offset = pos - data;
+      miniblock.bitWidth = widths[i];
+      VELOX_CHECK_LE(miniblock.bitWidth, 64);
+      pos += valuesPerMiniblock * miniblock.bitWidth / 8;
+      numDeltas -= valuesPerMiniblock;
+      miniblocks.push_back(miniblock);
+    }
+    VELOX_CHECK_LE(pos, end, "Truncated DELTA_BINARY_PACKED miniblock");
+  }
+  return numValues;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+namespace facebook::velox::wave {
+
+/// Host side preparation of Parquet encoded pages for decoding on device.
+/// The run and block headers are scanned on host so that each value can be
+/// decoded independently on device by the kRleBitpacked and
+/// kDeltaBinaryPacked steps.
+
+/// Appends the runs of the RLE/bit-packed hybrid encoded 'data' of 'size'
+/// bytes with 'bitWidth' bit values to 'runs'. 'data' starts at the first run
+/// header, i.e. after the bit width byte of dictionary indices or the length
+/// of levels. Returns the number of values in the runs. This can be more than
+/// the values in the page since bit-packed runs are padded to a multiple of 8
+/// values.
+int32_t scanRleBitpackedRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    std::vector<RleBitpackedRun>& runs);
+
+/// Sets 'miniblocks' to the miniblocks of the DELTA_BINARY_PACKED encoded
+/// 'data' of 'size' bytes. Sets 'valuesPerMiniblock' and 'firstValue' from
+/// the page header. Returns the number of values in the page.
+int32_t scanDeltaBinaryPacked(
+    const uint8_t* data,
+    int32_t size,
+    int32_t& valuesPerMiniblock,
+    int64_t& firstValue,
+    std::vector<DeltaMiniblock>& miniblocks);
+
+} // namespace facebook::velox::wave
@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 #include "velox/experimental/gpu/Common.h"
 #include "velox/experimental/wave/dwio/decode/GpuDecoder.cuh"
+#include "velox/experimental/wave/dwio/decode/ParquetDecode.h"
 
 DEFINE_int32(device_id, 0, "");
 DEFINE_bool(benchmark, false, "");
@@ -73,6 +74,116 @@ void fillRandom(T* values, int32_t numValues) {
   }
 }
 
+void appendVarint(uint64_t value, std::vector<uint8_t>& out) {
+  while (value >= 128) {
+    out.push_back(0x80 | (value & 0x7f));
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+// Appends 'values' packed in 'bitWidth' bits, least significant bit first.
+void appendBitpacked(
+    const uint64_t* values,
+    int32_t numValues,
+    int32_t bitWidth,
+    std::vector<uint8_t>& out) {
+  auto start = out.size();
+  out.resize(start + (numValues * bitWidth + 7) / 8);
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto bit = 0; bit < bitWidth; ++bit) {
+      if (values[i] & (1UL << bit)) {
+        setBit(&out[start], i * bitWidth + bit);
+      }
+    }
+  }
+}
+
+// Encodes 'values' in the Parquet RLE/bit-packed hybrid encoding. Groups of 8
+// equal values start a RLE run. The other values are bit-packed.
+std::vector<uint8_t> encodeRleBitpacked(
+    const std::vector<uint64_t>& values,
+    int32_t bitWidth) {
+  std::vector<uint8_t> out;
+  auto isRepeat = [&](int32_t i) {
+    return i + 8 <= values.size() &&
+        std::all_of(values.begin() + i, values.begin() + i + 8, [&](auto v) {
+             return v == values[i];
+           });
+  };
+  int32_t i = 0;
+  while (i < values.size()) {
+    if (isRepeat(i)) {
+      auto end = i;
+      while (end < values.size() && values[end] == values[i]) {
+        ++end;
+      }
+      appendVarint((end - i) << 1, out);
+      for (auto byte = 0; byte < (bitWidth + 7) / 8; ++byte) {
+        out.push_back(values[i] >> (byte * 8));
+      }
+      i = end;
+      continue;
+    }
+    auto end = i;
+    while (end < values.size() && !isRepeat(end)) {
+      end += 8;
+    }
+    std::vector<uint64_t> group(
+        values.begin() + i,
+        values.begin() + std::min<int32_t>(end, values.size()));
+    group.resize(end - i);
+    appendVarint(((end - i) / 8) << 1 | 1, out);
+    appendBitpacked(group.data(), group.size(), bitWidth, out);
+    i = end;
+  }
+  return out;
+}
+
+// Encodes 'values' as a DELTA_BINARY_PACKED page with blocks of 128 values in
+// 4 miniblocks.
+std::vector<uint8_t> encodeDeltaBinaryPacked(
+    const std::vector<int64_t>& values) {
+  constexpr int32_t kBlockSize = 128;
+  constexpr int32_t kMiniblocks = 4;
+  constexpr int32_t kMiniblockSize = kBlockSize / kMiniblocks;
+  auto zigzag = [](int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+  };
+  std::vector<uint8_t> out;
+  appendVarint(kBlockSize, out);
+  appendVarint(kMiniblocks, out);
+  appendVarint(values.size(), out);
+  appendVarint(zigzag(values.empty() ? 0 : values[0]), out);
+  std::vector<int64_t> deltas;
+  for (auto i = 1; i < values.size(); ++i) {
+    deltas.push_back(static_cast<uint64_t>(values[i]) - values[i - 1]);
+  }
+  for (auto block = 0; block < deltas.size(); block += kBlockSize) {
+    auto blockEnd = std::min<int32_t>(block + kBlockSize, deltas.size());
+    auto minDelta =
+        *std::min_element(deltas.begin() + block, deltas.begin() + blockEnd);
+    appendVarint(zigzag(minDelta), out);
+    std::vector<uint64_t> packed(kBlockSize, 0);
+    int32_t widths[kMiniblocks] = {};
+    for (auto i = 0; i < blockEnd - block; ++i) {
+      packed[i] = static_cast<uint64_t>(deltas[block + i]) - minDelta;
+      auto& width = widths[i / kMiniblockSize];
+      if (packed[i] != 0) {
+        width = std::max<int32_t>(width, 64 - __builtin_clzll(packed[i]));
+      }
+    }
+    for (auto width : widths) {
+      out.push_back(width);
+    }
+    for (auto i = 0; i * kMiniblockSize < blockEnd - block; ++i) {
+      appendBitpacked(
+          &packed[i * kMiniblockSize], kMiniblockSize, widths[i], out);
+    }
+  }
+  return out;
+}
+
 // Generate random bits with probability "p" being true and "1 - p" being false.
 void fillRandomBits(uint8_t* bits, double p, int numValues) {
   for (int i = 0; i < numValues; ++i) {
@@ -531,6 +642,114 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <typename T, int kBlockSize>
+  void testRleBitpacked(int32_t bitWidth, int numValues, int numBlocks) {
+    std::vector<uint64_t> indices(numValues);
+    fillRandom(indices.data(), numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      // Some long runs of repeats.
+      indices[i] = (i % 1000 < 100 ? i / 1000 : indices[i]) &
+          ((1UL << bitWidth) - 1);
+    }
+    auto encoded = encodeRleBitpacked(indices, bitWidth);
+    std::vector<RleBitpackedRun> runVector;
+    ASSERT_GE(
+        scanRleBitpackedRuns(
+            encoded.data(), encoded.size(), bitWidth, runVector),
+        numValues);
+    // Room for reading a word past the end.
+    auto input = allocate<uint8_t>(encoded.size() + 8);
+    memcpy(input.get(), encoded.data(), encoded.size());
+    auto runs = allocate<RleBitpackedRun>(runVector.size());
+    std::copy(runVector.begin(), runVector.end(), runs.get());
+    auto dictSize = 1 << bitWidth;
+    auto dict = allocate<T>(dictSize);
+    fillRandom(dict.get(), dictSize);
+    auto result = allocate<T>(numValues);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    int valuesPerOp = roundUp(numValues, numBlocks) / numBlocks;
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpacked;
+      auto& op = ops[i].data.rleBitpacked;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+      op.input = input.get();
+      op.runs = runs.get();
+      op.numRuns = runVector.size();
+      op.bitWidth = bitWidth;
+      op.begin = std::min(numValues, i * valuesPerOp);
+      op.end = std::min(numValues, (i + 1) * valuesPerOp);
+      op.alphabet = dict.get();
+      op.scatter = nullptr;
+      op.result = result.get();
+    }
+    testCase(
+        fmt::format("rle bitpacked {} bits numValues={}", bitWidth, numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        numValues * sizeof(T),
+        10);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(dict[indices[i]], result[i]) << i;
+    }
+  }
+
+  template <int kBlockSize>
+  void testDeltaBinaryPacked(int numValues, int numPages) {
+    std::vector<std::vector<int64_t>> pages(numPages);
+    std::vector<uint64_t> random(numValues);
+    fillRandom(random.data(), numValues);
+    for (auto& page : pages) {
+      int64_t value = random[0];
+      for (auto i = 0; i < numValues; ++i) {
+        // Mostly small deltas with some which need all the 64 bits.
+        value = i % 1000 == 999
+            ? random[i]
+            : value + static_cast<int64_t>(random[i] % 100) - 20;
+        page.push_back(value);
+      }
+      std::rotate(random.begin(), random.begin() + 1, random.end());
+    }
+    auto ops = allocate<GpuDecode>(numPages);
+    auto result = allocate<int64_t>(numValues * numPages);
+    std::vector<gpu::CudaPtr<uint8_t[]>> inputs;
+    std::vector<gpu::CudaPtr<DeltaMiniblock[]>> miniblocks;
+    for (auto i = 0; i < numPages; ++i) {
+      auto encoded = encodeDeltaBinaryPacked(pages[i]);
+      auto& op = ops[i].data.deltaBinaryPacked;
+      std::vector<DeltaMiniblock> miniblockVector;
+      ASSERT_EQ(
+          numValues,
+          scanDeltaBinaryPacked(
+              encoded.data(),
+              encoded.size(),
+              op.valuesPerMiniblock,
+              op.firstValue,
+              miniblockVector));
+      inputs.push_back(allocate<uint8_t>(encoded.size() + 16));
+      memcpy(inputs.back().get(), encoded.data(), encoded.size());
+      miniblocks.push_back(allocate<DeltaMiniblock>(miniblockVector.size()));
+      std::copy(
+          miniblockVector.begin(),
+          miniblockVector.end(),
+          miniblocks.back().get());
+      ops[i].step = DecodeStep::kDeltaBinaryPacked;
+      op.dataType = WaveTypeKind::BIGINT;
+      op.input = inputs.back().get();
+      op.miniblocks = miniblocks.back().get();
+      op.numValues = numValues;
+      op.result = result.get() + i * numValues;
+    }
+    testCase(
+        fmt::format("delta binary packed numValues={}", numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numPages); },
+        numValues * numPages * sizeof(int64_t),
+        10);
+    for (auto i = 0; i < numPages; ++i) {
+      for (auto j = 0; j < numValues; ++j) {
+        ASSERT_EQ(pages[i][j], result[i * numValues + j]) << i << " " << j;
+      }
+    }
+  }
+
   template <int kBlockSize>
   void testMakeScatterIndices(int numValues, int numBlocks) {
     auto bits = allocate<uint8_t>((numValues * numBlocks + 7) / 8);
@@ -699,6 +918,18 @@ TEST_F(GpuDecoderTest, rle) {
   testRle<int64_t, 256>(40'000'003, 1024);
 }
 
+TEST_F(GpuDecoderTest, rleBitpacked) {
+  testRleBitpacked<int64_t, 256>(1, 1'000'003, 64);
+  testRleBitpacked<int32_t, 256>(11, 4'000'037, 1024);
+  testRleBitpacked<int64_t, 256>(17, 4'000'037, 1024);
+}
+
+TEST_F(GpuDecoderTest, deltaBinaryPacked) {
+  testDeltaBinaryPacked<256>(1, 10);
+  testDeltaBinaryPacked<256>(20'000, 1024);
+  testDeltaBinaryPacked<1024>(100'003, 64);
+}
+
 TEST_F(GpuDecoderTest, makeScatterIndices) {
   testMakeScatterIndices<256>(40013, 1024);
 }
@@ -20,6 +20,7 @@
 #include "velox/experimental/wave/common/Block.cuh"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
 #include "velox/experimental/wave/exec/Aggregate.cuh"
+#include "velox/experimental/wave/exec/HashJoin.cuh"
 #include "velox/experimental/wave/exec/WaveCore.cuh"
 
 DEFINE_bool(kernel_gdb, false, "Run kernels sequentially for debugging");
@@ -45,6 +46,12 @@ __global__ void oneAggregate(KernelParams params, int32_t pc, int32_t base) {
 
 __global__ void oneReadAggregate(KernelParams params, int32_t pc, int32_t base);
 
+__global__ void oneJoinProbe(KernelParams params, int32_t pc, int32_t base) {
+  PROGRAM_PREAMBLE(base);
+  joinProbeKernel(instruction[pc]._.joinProbe, shared, laneStatus);
+  PROGRAM_EPILOGUE();
+}
+
 __global__ void onePlusBigint(KernelParams params, int32_t pc, int32_t base);
 template <typename T>
 __global__ void oneLt(KernelParams params, int32_t pc, int32_t base) {
@@ -88,6 +95,9 @@ __global__ void waveBaseKernel(KernelParams params) {
       case OpCode::kReadAggregate:
         readAggregateKernel(&instruction->_.aggregate, shared);
         break;
+      case OpCode::kJoinProbe:
+        joinProbeKernel(instruction->_.joinProbe, shared, laneStatus);
+        break;
         BINARY_TYPES(OpCode::kPlus_BIGINT, int64_t, +);
         BINARY_TYPES(OpCode::kLT_BIGINT, int64_t, <);
     }
@@ -163,6 +173,9 @@ void WaveKernelStream::callOne(
         case OpCode::kReadAggregate:
           CALL_ONE(oneReadAggregate, params, pc, base);
           break;
+        case OpCode::kJoinProbe:
+          CALL_ONE(oneJoinProbe, params, pc, base);
+          break;
         case OpCode::kPlus_BIGINT:
           CALL_ONE(onePlusBigint, params, pc, base);
           break;
@@ -226,4 +239,20 @@ void WaveKernelStream::setupAggregation(AggregationControl& op) {
   wait();
 }
 
+void __global__ setupHashJoinKernel(HashJoinControl op) {
+  buildHashJoin(op);
+}
+
+void WaveKernelStream::setupHashJoin(HashJoinControl& op) {
+  if (op.numRows == 0) {
+    return;
+  }
+  // One thread per row. Enough TBs for full device.
+  int32_t numBlocks =
+      std::min<int64_t>(roundUp(op.numRows, kBlockSize) / kBlockSize, 640);
+  setupHashJoinKernel<<<numBlocks, kBlockSize, 0, stream_->stream>>>(op);
+  CUDA_CHECK(cudaGetLastError());
+  wait();
+}
+
 } // namespace facebook::velox::wave
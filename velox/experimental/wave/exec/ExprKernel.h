@@ -42,6 +42,7 @@ enum class OpCode {
   kNegate,
   kAggregate,
   kReadAggregate,
+  kJoinProbe,
   kReturn,
 
   // From here, only OpCodes that have variants for scalar types.
@@ -152,6 +153,35 @@ struct IAggregate {
   IUpdateAgg* aggregates;
 };
 
+/// Device-side state for a hash join probe. The build side rows are arrays of
+/// 'rowWords' int64_t, the key first, followed by the dependent columns.
+struct DeviceHashJoin {
+  GpuHashTableBase* table{nullptr};
+
+  int32_t rowWords{0};
+};
+
+/// Parameters for building the device side table of a hash join.
+struct HashJoinControl {
+  DeviceHashJoin* head;
+
+  /// Build side rows to insert into 'head->table'.
+  int64_t* rows{nullptr};
+
+  int64_t numRows{0};
+};
+
+struct IJoinProbe {
+  OperandIndex key;
+  /// Set to true for the lanes that have a match.
+  OperandIndex hits;
+  uint16_t numDependents;
+  /// Index of the state in operator states.
+  uint8_t stateIndex;
+  /// 'numDependents' results, copied from the matching build side row.
+  OperandIndex* dependents;
+};
+
 struct AggregateReturn {
   /// Count of rows in the table. Triggers rehash when high enough.
   int64_t numDistinct;
@@ -166,6 +196,7 @@ struct Instruction {
     ILiteral literal;
     INegate negate;
     IAggregate aggregate;
+    IJoinProbe joinProbe;
   } _;
 };
 
@@ -279,6 +310,9 @@ class WaveKernelStream : public Stream {
   /// Sets up or updates an aggregation.
   void setupAggregation(AggregationControl& op);
 
+  /// Inserts the build side rows of a hash join into the device side table.
+  void setupHashJoin(HashJoinControl& op);
+
  private:
   // Debug implementation of call() where each instruction is a separate kernel
   // launch.
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/HashTable.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave {
+
+inline uint64_t __device__ hashJoinKey(int64_t key) {
+  constexpr uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  return kMul * key;
+}
+
+class JoinProbeOps {
+ public:
+  explicit __device__ JoinProbeOps(int64_t key) : key_(key) {}
+
+  bool __device__ compare(GpuHashTable* table, int64_t* row, int32_t i) {
+    return row[0] == key_;
+  }
+
+ private:
+  const int64_t key_;
+};
+
+/// Inserts build side rows into the table of 'control'. The keys are
+/// distinct. One thread per row.
+void __device__ __forceinline__ buildHashJoin(const HashJoinControl& control) {
+  auto* table = reinterpret_cast<GpuHashTable*>(control.head->table);
+  auto rowWords = control.head->rowWords;
+  int64_t stride = blockDim.x * gridDim.x;
+  for (int64_t i = threadIdx.x + blockDim.x * blockIdx.x; i < control.numRows;
+       i += stride) {
+    auto* row = control.rows + i * rowWords;
+    table->insertNew(row, hashJoinKey(row[0]));
+  }
+}
+
+/// Looks up the key of each active lane. Sets 'hits' and copies the
+/// dependent columns of the matching row to the results. The non-matching
+/// lanes are to be removed by a filter on 'hits'.
+__device__ __forceinline__ void joinProbeKernel(
+    const IJoinProbe& probe,
+    WaveShared* shared,
+    ErrorCode& laneStatus) {
+  if (!laneActive(laneStatus)) {
+    return;
+  }
+  auto* join =
+      reinterpret_cast<DeviceHashJoin*>(shared->states[probe.stateIndex]);
+  auto* table = reinterpret_cast<GpuHashTable*>(join->table);
+  int64_t key;
+  int64_t* row = nullptr;
+  if (operandOrNull(
+          shared->operands,
+          probe.key,
+          shared->blockBase,
+          &shared->data,
+          key)) {
+    JoinProbeOps ops(key);
+    row = table->find<int64_t>(hashJoinKey(key), threadIdx.x, ops);
+  }
+  flatResult<bool>(
+      shared->operands, probe.hits, shared->blockBase, &shared->data) =
+      row != nullptr;
+  if (row) {
+    for (auto i = 0; i < probe.numDependents; ++i) {
+      flatResult<int64_t>(
+          shared->operands,
+          probe.dependents[i],
+          shared->blockBase,
+          &shared->data) = row[i + 1];
+    }
+  }
+}
+
+} // namespace facebook::velox::wave
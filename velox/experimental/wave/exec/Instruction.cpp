@@ -177,6 +177,30 @@ AdvanceResult AbstractAggregation::canAdvance(
   return {};
 }
 
+exec::BlockingReason AbstractHashJoinProbe::isBlockedOnHost(
+    ContinueFuture* future) {
+  if (table) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto buildResult = bridge->tableOrFuture(future);
+  if (!buildResult.has_value()) {
+    VELOX_CHECK(future->valid());
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  VELOX_CHECK(
+      !buildResult->restoredPartitionId.has_value() &&
+          buildResult->spillPartitionIds.empty(),
+      "Wave hash join does not support spilling");
+  VELOX_CHECK_NOT_NULL(buildResult->table);
+  // ToWave checks that the keys are unique unless
+  // testingSetAssumeUniqueJoinKeys() is set.
+  VELOX_CHECK(
+      !buildResult->table->hasDuplicateKeys(),
+      "Wave hash join requires unique build side keys");
+  table = buildResult->table;
+  return exec::BlockingReason::kNotBlocked;
+}
+
 std::pair<int64_t, int64_t> countResultRows(
     std::vector<AllocationRange>& ranges,
     int32_t rowSize) {
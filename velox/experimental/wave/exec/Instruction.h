@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/exec/Driver.h"
+#include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/Operator.h"
 #include "velox/experimental/wave/common/ResultStaging.h"
 #include "velox/experimental/wave/exec/ExprKernel.h"
@@ -157,6 +158,13 @@ struct AbstractInstruction {
     return exec::BlockingReason::kNotBlocked;
   }
 
+  /// Checks blocking for a host side dependency of an instruction anywhere in
+  /// a Program, e.g. the build side of a hash join. Called before each launch
+  /// of work that contains 'this'.
+  virtual exec::BlockingReason isBlockedOnHost(ContinueFuture* future) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
   /// Prepares the source instruction of a Program that begins with a
   /// source instruction, like reading an aggregation or an
   /// exchange. 'state' is a handle to the state on device. The
@@ -303,7 +311,7 @@ struct AbstractUnary : public AbstractInstruction {
   AbstractOperand* predicate;
 };
 
-enum class StateKind : uint8_t { kGroupBy };
+enum class StateKind : uint8_t { kGroupBy, kHashJoin };
 
 /// Represents a shared state operated on by instructions. For example, a
 /// join/group by table, destination buffers for repartition etc. Device side
@@ -438,6 +446,53 @@ struct AbstractReadAggregation : public AbstractOperator {
   int32_t literalOffset{0};
 };
 
+/// Probes a hash join build side with a single BIGINT key. The build side is
+/// made by HashBuild on host. The probe waits for it in isBlockedOnHost() and
+/// the rows are copied to a device side hash table when first used by a
+/// WaveStream. Unique build keys and inner join only. Joins where the build
+/// keys may repeat are left on the CPU HashProbe. Sets 'hits' for the
+/// matching lanes and copies the build side columns to 'dependents'. To be
+/// followed by a filter on 'hits'.
+struct AbstractHashJoinProbe : public AbstractOperator {
+  AbstractHashJoinProbe(
+      int32_t serial,
+      AbstractOperand* key,
+      AbstractOperand* hits,
+      std::vector<AbstractOperand*> dependents,
+      std::vector<int32_t> dependentChannels,
+      std::shared_ptr<exec::HashJoinBridge> bridge,
+      AbstractState* state,
+      RowTypePtr outputType)
+      : AbstractOperator(OpCode::kJoinProbe, serial, state, outputType),
+        key(key),
+        hits(hits),
+        dependents(std::move(dependents)),
+        dependentChannels(std::move(dependentChannels)),
+        bridge(std::move(bridge)) {}
+
+  exec::BlockingReason isBlockedOnHost(ContinueFuture* future) override;
+
+  bool isOutput(const AbstractOperand* op) const override {
+    return op == hits ||
+        std::find(dependents.begin(), dependents.end(), op) !=
+        dependents.end();
+  }
+
+  AbstractOperand* key;
+  AbstractOperand* hits;
+  std::vector<AbstractOperand*> dependents;
+
+  /// Column of 'table' for each of 'dependents'. The key is column 0.
+  std::vector<int32_t> dependentChannels;
+
+  std::shared_ptr<exec::HashJoinBridge> bridge;
+
+  /// The build side. Set by isBlockedOnHost() when the build is complete.
+  std::shared_ptr<exec::BaseHashTable> table;
+
+  int32_t literalOffset{0};
+};
+
 /// Serializes 'row' to characters interpretable on device.
 std::string rowTypeString(const RowTypePtr& row);
 
@@ -24,6 +24,18 @@
 
 namespace facebook::velox::wave {
 
+exec::BlockingReason Project::isBlocked(ContinueFuture* future) {
+  for (auto& level : levels_) {
+    for (auto& program : level) {
+      auto reason = program->isBlockedOnHost(future);
+      if (reason != exec::BlockingReason::kNotBlocked) {
+        return reason;
+      }
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
 AbstractWrap* Project::findWrap() const {
   return filterWrap_;
 }
@@ -29,6 +29,8 @@ class Project : public WaveOperator {
         levels_(std::move(levels)),
         filterWrap_(filterWrap) {}
 
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
   AbstractWrap* findWrap() const override;
 
   bool isStreaming() const override {
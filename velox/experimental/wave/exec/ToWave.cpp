@@ -27,6 +27,9 @@
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
 
 namespace facebook::velox::wave {
+namespace {
+std::atomic<bool> assumeUniqueJoinKeys{false};
+} // namespace
 
 using exec::Expr;
 
@@ -555,6 +558,150 @@ void CompileState::makeAggregateAccumulate(const core::AggregationNode* node) {
   }
 }
 
+namespace {
+// Returns the column of 'name' in the hash table of a join with build side
+// 'buildType' and build side key 'key'. The key is first, then the other
+// build side columns in order, like in HashProbe.
+std::optional<int32_t> tableChannel(
+    const RowType& buildType,
+    const std::string& key,
+    const std::string& name) {
+  auto channel = buildType.getChildIdxIfExists(name);
+  if (!channel.has_value()) {
+    return std::nullopt;
+  }
+  auto keyChannel = buildType.getChildIdx(key);
+  if (channel.value() == keyChannel) {
+    return 0;
+  }
+  return channel.value() < keyChannel ? channel.value() + 1 : channel.value();
+}
+
+// Returns true if the rows of 'node' have distinct values in the column
+// 'key'. This is known if 'node' is a complete group by on 'key' under
+// filters and projections that pass 'key' through.
+bool hasUniqueKey(const core::PlanNode& node, const std::string& key) {
+  if (auto* aggregation = dynamic_cast<const core::AggregationNode*>(&node)) {
+    return (aggregation->step() == core::AggregationNode::Step::kSingle ||
+            aggregation->step() == core::AggregationNode::Step::kFinal) &&
+        aggregation->groupingKeys().size() == 1 &&
+        aggregation->groupingKeys()[0]->name() == key;
+  }
+  if (dynamic_cast<const core::FilterNode*>(&node)) {
+    return hasUniqueKey(*node.sources()[0], key);
+  }
+  if (auto* project = dynamic_cast<const core::ProjectNode*>(&node)) {
+    const auto& names = project->names();
+    for (auto i = 0; i < names.size(); ++i) {
+      if (names[i] != key) {
+        continue;
+      }
+      auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(
+          project->projections()[i].get());
+      return field != nullptr && field->isInputColumn() &&
+          hasUniqueKey(*node.sources()[0], field->name());
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool CompileState::addHashJoinProbe(const core::HashJoinNode& node) {
+  const auto& config = driver_.driverCtx()->queryConfig();
+  // Inner joins on one BIGINT key without spilling. The build side columns are
+  // copied to device as int64_t. The device probe finds one match per probe
+  // row, so joins with possibly duplicate build keys stay on the CPU
+  // HashProbe.
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1 ||
+      node.leftKeys()[0]->type()->kind() != TypeKind::BIGINT ||
+      (config.spillEnabled() && config.joinSpillEnabled())) {
+    return false;
+  }
+  if (!assumeUniqueJoinKeys &&
+      !hasUniqueKey(*node.sources()[1], node.rightKeys()[0]->name())) {
+    return false;
+  }
+  const auto& outputType = node.outputType();
+  const auto& buildType = node.sources()[1]->outputType();
+  const auto& buildKey = node.rightKeys()[0]->name();
+  std::vector<int32_t> outputChannels;
+  std::vector<int32_t> dependentChannels;
+  for (auto i = 0; i < outputType->size(); ++i) {
+    auto channel = tableChannel(*buildType, buildKey, outputType->nameOf(i));
+    if (!channel.has_value()) {
+      continue;
+    }
+    auto kind = outputType->childAt(i)->kind();
+    if (kind != TypeKind::BIGINT && kind != TypeKind::DOUBLE) {
+      return false;
+    }
+    outputChannels.push_back(i);
+    dependentChannels.push_back(channel.value());
+  }
+  if (!reserveMemory()) {
+    return false;
+  }
+
+  auto key = findCurrentValue(node.leftKeys()[0]);
+  VELOX_CHECK_NOT_NULL(key);
+  auto* state = newState(StateKind::kHashJoin, node.id(), "");
+  auto hits = newOperand(BOOLEAN(), "hits");
+  hits->notNull = true;
+  std::vector<AbstractOperand*> dependents;
+  for (auto channel : outputChannels) {
+    auto dependent =
+        newOperand(outputType->childAt(channel), outputType->nameOf(channel));
+    dependent->notNull = true;
+    dependents.push_back(dependent);
+  }
+  auto* driverCtx = driver_.driverCtx();
+  auto bridge = driverCtx->task->getHashJoinBridgeLocked(
+      driverCtx->splitGroupId, node.id());
+
+  int32_t numPrograms = allPrograms_.size();
+  auto program = newProgram();
+  if (auto source = programOf(key, false)) {
+    program->addSource(source);
+  }
+  program->addLabel(fmt::format("HashProbe {}", node.id()));
+  program->add(std::make_unique<AbstractHashJoinProbe>(
+      nthContinuable_++,
+      key,
+      hits,
+      dependents,
+      std::move(dependentChannels),
+      std::move(bridge),
+      state,
+      outputType));
+  definedIn_[hits] = program;
+
+  // Drop the lanes without a match. The build side columns come before the
+  // cardinality change, so they are wrapped like the probe side columns.
+  auto indices = newOperand(INTEGER(), "indices");
+  indices->notNull = true;
+  program->markOutput(indices->id);
+  program->add(std::make_unique<AbstractFilter>(hits, indices));
+  auto wrapUnique = std::make_unique<AbstractWrap>(indices, wrapCounter_++);
+  auto wrap = wrapUnique.get();
+  for (auto* dependent : dependents) {
+    wrap->addWrap(dependent);
+  }
+  program->add(std::move(wrapUnique));
+  for (auto* dependent : dependents) {
+    program->markOutput(dependent->id);
+    definedIn_[dependent] = program;
+  }
+  auto levels = makeLevels(numPrograms);
+  operators_.push_back(
+      std::make_unique<Project>(*this, outputType, levels, wrap));
+  for (auto i = 0; i < dependents.size(); ++i) {
+    Value value(toSubfield(outputType->nameOf(outputChannels[i])));
+    definedBy_[value] = dependents[i];
+    operators_.back()->defined(value, dependents[i]);
+  }
+  return true;
+}
+
 void CompileState::makeProject(int firstProgram, RowTypePtr outputType) {
   auto levels = makeLevels(firstProgram);
   operators_.push_back(
@@ -604,6 +751,14 @@ bool CompileState::addOperator(
     operators_.push_back(
         std::make_unique<TableScan>(*this, operators_.size(), *scan));
     outputType = scan->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!addHashJoinProbe(*node)) {
+      return false;
+    }
+    outputType = node->outputType();
   } else {
     return false;
   }
@@ -739,4 +894,8 @@ void registerWave() {
   exec::DriverAdapter waveAdapter{"Wave", {}, waveDriverAdapter};
   exec::DriverFactory::registerAdapter(waveAdapter);
 }
+
+void testingSetAssumeUniqueJoinKeys(bool assumeUnique) {
+  assumeUniqueJoinKeys = assumeUnique;
+}
 } // namespace facebook::velox::wave
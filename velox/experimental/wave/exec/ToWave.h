@@ -115,6 +115,11 @@ class CompileState {
 
   void makeAggregateAccumulate(const core::AggregationNode* node);
 
+  // Adds a probe of the hash table built by the CPU HashBuild of 'node'
+  // followed by a filter on the matches. Returns false if the join is not
+  // supported on Wave.
+  bool addHashJoinProbe(const core::HashJoinNode& node);
+
   bool reserveMemory();
 
   // Adds 'instruction' to the suitable program and records the result
@@ -193,4 +198,10 @@ class CompileState {
 /// Registers adapter to add Wave operators to Drivers.
 void registerWave();
 
+/// Makes hash joins probe on device also if the plan does not show that the
+/// build side keys are unique, e.g. for benchmarks on tables with known
+/// primary keys. Such a join fails if the keys are not unique. Not for
+/// production use.
+void testingSetAssumeUniqueJoinKeys(bool assumeUnique);
+
 } // namespace facebook::velox::wave
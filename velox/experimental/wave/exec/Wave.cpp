@@ -63,6 +63,8 @@ void WaveStats::add(const WaveStats& other) {
   waitTime += other.waitTime;
   transferWaitTime += other.transferWaitTime;
   stagingTime += other.stagingTime;
+  stagingWaitTime += other.stagingWaitTime;
+  numTransfers += other.numTransfers;
 }
 
 void WaveStats::clear() {
@@ -966,6 +968,85 @@ void WaveStream::makeAggregate(
   releaseStream(std::move(stream));
 }
 
+void WaveStream::makeHashJoin(
+    AbstractHashJoinProbe& inst,
+    HashJoinOperatorState& state) {
+  VELOX_CHECK_NOT_NULL(inst.table);
+  const int32_t rowWords = 1 + inst.dependents.size();
+  auto containers = inst.table->allRows();
+  int64_t numRows = 0;
+  for (auto* container : containers) {
+    numRows += container->numRows();
+  }
+  WaveBufferPtr head =
+      arena_.allocate<char>(sizeof(DeviceHashJoin) + sizeof(GpuHashTableBase));
+  state.buffers.push_back(head);
+  state.head = new (head->as<char>()) DeviceHashJoin();
+  auto* hashTable = reinterpret_cast<GpuHashTableBase*>(state.head + 1);
+  // Leave at least 1/6 of the slots empty, like in a group by table.
+  int64_t numBuckets = bits::nextPowerOfTwo(std::max<int64_t>(
+      16, numRows * 6 / 5 / GpuBucketMembers::kNumSlots + 1));
+  WaveBufferPtr buckets =
+      arena_.allocate<char>(sizeof(GpuBucketMembers) * numBuckets);
+  state.buffers.push_back(buckets);
+  new (hashTable) GpuHashTableBase(
+      buckets->as<GpuBucket>(), numBuckets - 1, 0, nullptr);
+  state.head->table = hashTable;
+  state.head->rowWords = rowWords;
+
+  // Copy the key and the dependent columns of the build side rows into arrays
+  // of int64_t. The columns are extracted by column index, so that the
+  // dependents stored in cold records are found.
+  WaveBufferPtr rows =
+      arena_.allocate<int64_t>(std::max<int64_t>(1, numRows * rowWords));
+  state.buffers.push_back(rows);
+  auto* row = rows->as<int64_t>();
+  std::vector<int32_t> columnIndices;
+  columnIndices.push_back(0);
+  columnIndices.insert(
+      columnIndices.end(),
+      inst.dependentChannels.begin(),
+      inst.dependentChannels.end());
+  std::vector<char*> buildRows(1024);
+  std::vector<VectorPtr> values(columnIndices.size());
+  for (auto* container : containers) {
+    exec::RowContainerIterator iter;
+    int32_t numListed;
+    while ((numListed = container->listRows(
+                &iter, buildRows.size(), buildRows.data())) > 0) {
+      for (auto column = 0; column < columnIndices.size(); ++column) {
+        const auto columnIndex = columnIndices[column];
+        const auto& type = container->columnTypes()[columnIndex];
+        VELOX_CHECK_EQ(type->cppSizeInBytes(), sizeof(int64_t));
+        values[column] =
+            BaseVector::create(type, numListed, container->pool());
+        container->extractColumn(
+            buildRows.data(), numListed, columnIndex, values[column]);
+        VELOX_CHECK_EQ(
+            BaseVector::countNulls(values[column]->nulls(), numListed),
+            0,
+            "Wave hash join does not support nulls in build side columns");
+      }
+      for (auto i = 0; i < numListed; ++i) {
+        for (auto& vector : values) {
+          *row++ = vector->values()->as<int64_t>()[i];
+        }
+      }
+    }
+  }
+
+  HashJoinControl control;
+  control.head = state.head;
+  control.rows = rows->as<int64_t>();
+  control.numRows = numRows;
+  auto stream = streamFromReserve();
+  stream->prefetch(getDevice(), head->as<char>(), head->size());
+  stream->memset(buckets->as<char>(), 0, buckets->size());
+  reinterpret_cast<WaveKernelStream*>(stream.get())->setupHashJoin(control);
+  stream->wait();
+  releaseStream(std::move(stream));
+}
+
 std::string WaveStream::toString() const {
   std::stringstream out;
   out << "{WaveStream ";
@@ -1004,6 +1085,16 @@ void Program::getOperatorStates(WaveStream& stream, std::vector<void*>& ptrs) {
   }
 }
 
+exec::BlockingReason Program::isBlockedOnHost(ContinueFuture* future) {
+  for (auto& instruction : instructions_) {
+    auto reason = instruction->isBlockedOnHost(future);
+    if (reason != exec::BlockingReason::kNotBlocked) {
+      return reason;
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
 bool Program::isSink() const {
   int32_t size = instructions_.size();
   if (instructions_[size - 1]->opCode == OpCode::kReturn) {
@@ -1133,6 +1224,17 @@ void Program::prepareForDevice(GpuArena& arena) {
         }
         break;
       }
+      case OpCode::kJoinProbe: {
+        auto& probe = instruction->as<AbstractHashJoinProbe>();
+        markInput(probe.key);
+        markResult(probe.hits);
+        std::vector<OperandIndex> dependents(probe.dependents.size());
+        probe.literalOffset = addLiteral(dependents.data(), dependents.size());
+        for (auto* dependent : probe.dependents) {
+          markResult(dependent);
+        }
+        break;
+      }
       default:
         VELOX_UNSUPPORTED(
             "OpCode {}", static_cast<int32_t>(instruction->opCode));
@@ -1252,6 +1354,31 @@ void Program::prepareForDevice(GpuArena& arena) {
         }
         break;
       }
+      case OpCode::kJoinProbe: {
+        IN_HEAD(AbstractHashJoinProbe, IJoinProbe, OpCode::kJoinProbe);
+        IN_OPERAND(key);
+        IN_OPERAND(hits);
+        physicalInst->numDependents = abstractInst->dependents.size();
+        physicalInst->dependents = reinterpret_cast<OperandIndex*>(
+            deviceLiterals_ + abstractInst->literalOffset);
+        for (auto i = 0; i < abstractInst->dependents.size(); ++i) {
+          physicalInst->dependents[i] =
+              operandIndex(abstractInst->dependents[i]);
+        }
+        physicalInst->stateIndex = operatorStates_.size();
+        auto programState = std::make_unique<ProgramState>();
+        programState->stateId = abstractInst->state->id;
+        programState->isGlobal = true;
+        programState->create =
+            [inst = abstractInst](
+                WaveStream& stream) -> std::shared_ptr<OperatorState> {
+          auto newState = std::make_shared<HashJoinOperatorState>();
+          stream.makeHashJoin(*inst, *newState);
+          return newState;
+        };
+        operatorStates_.push_back(std::move(programState));
+        break;
+      }
       case OpCode::kReturn: {
         IN_HEAD(AbstractReturn, IReturn, OpCode::kReturn);
         break;
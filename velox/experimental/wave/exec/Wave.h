@@ -131,6 +131,15 @@ struct WaveStats {
   /// Optionally measured host to device transfer latency.
   WaveTime transferWaitTime;
 
+  /// Time the staging thread waits for parallel copies to pinned memory. Part
+  /// of 'stagingTime'.
+  WaveTime stagingWaitTime;
+
+  /// Number of host to device copies for staged data. A large staging is
+  /// transferred in shards so that the transfer overlaps with the copy to
+  /// pinned memory.
+  int64_t numTransfers{0};
+
   void clear();
   void add(const WaveStats& other);
 };
@@ -299,6 +308,16 @@ struct AggregateOperatorState : public OperatorState {
   WaveBufferPtr temp;
 };
 
+/// Device side table of a hash join probe. Made from the build side table on
+/// host.
+struct HashJoinOperatorState : public OperatorState {
+  void* devicePtr() const override {
+    return head;
+  }
+
+  DeviceHashJoin* head{nullptr};
+};
+
 struct OperatorStateMap {
   folly::F14FastMap<int32_t, std::shared_ptr<OperatorState>> states;
 };
@@ -538,6 +557,10 @@ class Program : public std::enable_shared_from_this<Program> {
   /// necessary.
   void getOperatorStates(WaveStream& stream, std::vector<void*>& ptrs);
 
+  /// Returns the first host side blocking reason of an instruction of 'this',
+  /// e.g. a hash join waiting for its build side.
+  exec::BlockingReason isBlockedOnHost(ContinueFuture* future);
+
   /// True if begins with a source instruction, like reading and aggregate
   /// result or exchange.
   bool isSource() {
@@ -914,6 +937,10 @@ class WaveStream {
   /// 'state' is ready to use on device.
   void makeAggregate(AbstractAggregation& inst, AggregateOperatorState& state);
 
+  /// Initializes 'state' to a device side copy of the build side of 'inst'.
+  /// Returns after 'state' is ready to use on device.
+  void makeHashJoin(AbstractHashJoinProbe& inst, HashJoinOperatorState& state);
+
   std::unique_ptr<Executable> recycleExecutable(
       Program* program,
       int32_t numRows);
@@ -603,6 +603,13 @@ void WaveDriver::updateStats() {
       "wave.stagingNanos",
       RuntimeCounter(
           waveStats_.stagingTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.stagingWaitNanos",
+      RuntimeCounter(
+          waveStats_.stagingWaitTime.micros * 1000,
+          RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.numTransfers", RuntimeCounter(waveStats_.numTransfers));
   if (FLAGS_wave_transfer_timing) {
     lockedStats->addRuntimeStat(
         "wave.transferWaitNanos",
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <folly/ScopeGuard.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/dwio/FormatData.h"
+#include "velox/experimental/wave/exec/Wave.h"
+
+DECLARE_int32(staging_bytes_per_thread);
+
+namespace facebook::velox::wave {
+namespace {
+
+class SplitStagingTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    auto* device = getDevice();
+    setDevice(device);
+    arena_ = std::make_unique<GpuArena>(1 << 28, getAllocator(device));
+    deviceArena_ =
+        std::make_unique<GpuArena>(1 << 28, getDeviceAllocator(device));
+  }
+
+  std::unique_ptr<GpuArena> arena_;
+  std::unique_ptr<GpuArena> deviceArena_;
+};
+
+TEST_F(SplitStagingTest, shardedTransfer) {
+  // Shards of about 500KB, so that the 3MB below is copied by several
+  // threads and transferred in several copies.
+  const auto bytesPerThread = FLAGS_staging_bytes_per_thread;
+  FLAGS_staging_bytes_per_thread = 500'000;
+  SCOPE_EXIT {
+    FLAGS_staging_bytes_per_thread = bytesPerThread;
+  };
+
+  std::vector<std::unique_ptr<AbstractOperand>> operands;
+  OperatorStateMap stateMap;
+  WaveStream waveStream(
+      *arena_, *deviceArena_, &operands, &stateMap, InstructionStatus{}, 0);
+  FileInfo fileInfo;
+  SplitStaging staging(fileInfo, 0);
+
+  // Sizes which are not a multiple of 8 check the padding between buffers.
+  constexpr int32_t kNumBuffers = 10;
+  std::vector<std::string> data;
+  std::vector<int64_t> deviceAddresses(kNumBuffers);
+  for (auto i = 0; i < kNumBuffers; ++i) {
+    data.emplace_back(300'001 + i * 1'001, 'a' + i);
+    for (auto j = 0; j < data.back().size(); j += 997) {
+      data.back()[j] = static_cast<char>(j + i);
+    }
+    Staging buffer(data.back().data(), data.back().size(), common::Region{});
+    auto id = staging.add(buffer);
+    staging.registerPointer(id, &deviceAddresses[i], true);
+  }
+  ASSERT_GT(staging.bytesToDevice(), 2'000'000);
+
+  Stream stream;
+  staging.transfer(waveStream, stream);
+  ASSERT_GT(waveStream.stats().numTransfers, 1);
+
+  std::vector<std::string> result(kNumBuffers);
+  for (auto i = 0; i < kNumBuffers; ++i) {
+    ASSERT_NE(deviceAddresses[i], 0);
+    result[i].resize(data[i].size());
+    stream.deviceToHostAsync(
+        result[i].data(),
+        reinterpret_cast<const void*>(deviceAddresses[i]),
+        data[i].size());
+  }
+  stream.wait();
+  for (auto i = 0; i < kNumBuffers; ++i) {
+    ASSERT_EQ(result[i], data[i]) << "Buffer " << i;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -217,6 +217,46 @@ class TableScanTest : public virtual HiveConnectorTestBase,
     ASSERT_EQ(n, task->numFinishedDrivers());
   }
 
+  // Joins a scan of 'probeType' with c0 in [0, 2000) to 'build' on c0 = b0
+  // and checks the result against DuckDB. 'build' has BIGINT columns b0, b1
+  // and b2. If 'groupBuild' is true, the build side is grouped by b0, so
+  // that the plan shows that the build keys are unique.
+  std::shared_ptr<Task> assertHashJoin(
+      const RowTypePtr& probeType,
+      const std::vector<RowVectorPtr>& build,
+      bool groupBuild,
+      const std::unordered_map<std::string, std::string>& config = {}) {
+    auto splits =
+        makeData(probeType, numBatches_, batchSize_, true, [&](auto row) {
+          makeRange(row, 2000, true, 0, 1);
+          makeRange(row, 1000000000, true, 1);
+        });
+    createDuckDbTable("u", build);
+    auto idGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto buildPlan = PlanBuilder(idGenerator, pool_.get()).values(build);
+    if (groupBuild) {
+      buildPlan.singleAggregation(
+          {"b0"}, {"max(b1) as b1", "max(b2) as b2"});
+    }
+    auto plan = PlanBuilder(idGenerator, pool_.get())
+                    .tableScan(probeType)
+                    .hashJoin(
+                        {"c0"},
+                        {"b0"},
+                        buildPlan.planNode(),
+                        "",
+                        {"c0", "c1", "b1", "b2"})
+                    .planNode();
+    const auto buildSql = groupBuild
+        ? "SELECT b0, max(b1) AS b1, max(b2) AS b2 FROM u GROUP BY b0"
+        : "SELECT * FROM u";
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .configs(config)
+        .splits(splits)
+        .assertResults(fmt::format(
+            "SELECT c0, c1, b1, b2 FROM tmp, ({}) b WHERE c0 = b0", buildSql));
+  }
+
   FOLLY_NOINLINE void toFile() {
     std::ofstream out("/tmp/file.txt");
     int32_t row = 0;
@@ -374,6 +414,46 @@ TEST_P(TableScanTest, scanGroupBy) {
       "SELECT c0, sum(c1 + 1), sum(c2 + 2), sum(c3 + c2), sum(rn + 1) FROM tmp where c1 < 950000000 group by c0");
 }
 
+TEST_P(TableScanTest, hashJoinColdPayload) {
+  auto type = ROW({"c0", "c1", "rn"}, {BIGINT(), BIGINT(), BIGINT()});
+  auto build = makeRowVector(
+      {"b0", "b1", "b2"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row * 2; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row * 10; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row + 7; })});
+  // The dependents of the build side are stored in cold records.
+  assertHashJoin(
+      type,
+      {build},
+      true,
+      {{core::QueryConfig::kHashBuildColdPayloadMinBytes, "1"}});
+}
+
+TEST_P(TableScanTest, hashJoinDuplicateBuildKeys) {
+  auto type = ROW({"c0", "c1", "rn"}, {BIGINT(), BIGINT(), BIGINT()});
+  // Each build key is in 3 rows.
+  auto build = makeRowVector(
+      {"b0", "b1", "b2"},
+      {makeFlatVector<int64_t>(3'000, [](auto row) { return row % 1'000; }),
+       makeFlatVector<int64_t>(3'000, [](auto row) { return row * 10; }),
+       makeFlatVector<int64_t>(3'000, [](auto row) { return row + 7; })});
+  // The plan does not show that the build keys are unique, so the join is
+  // probed on the CPU.
+  assertHashJoin(type, {build}, false);
+
+  // The same keys made unique by a group by are probed on the device.
+  assertHashJoin(type, {build}, true);
+
+  // The device probe fails on duplicate keys if told to assume unique keys.
+  wave::testingSetAssumeUniqueJoinKeys(true);
+  SCOPE_EXIT {
+    wave::testingSetAssumeUniqueJoinKeys(false);
+  };
+  VELOX_ASSERT_THROW(
+      assertHashJoin(type, {build}, false),
+      "Wave hash join requires unique build side keys");
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TableScanTests,
     TableScanTest,
@@ -69,6 +69,12 @@ DEFINE_int32(rows_per_stripe, 200000, "Rows in a stripe");
 
 DEFINE_int64(num_rows, 1000000000, "Rows in test table");
 
+DEFINE_int64(
+    num_orders,
+    1'500'000,
+    "Rows in the orders table of the join query. customer has 1/10 and "
+    "lineitem 4x as many rows");
+
 DEFINE_int32(
     run_query_verbose,
     -1,
@@ -120,6 +126,101 @@ class WaveBenchmark : public QueryBenchmarkBase {
     }
   }
 
+  // Path of the data of table 'name' of the join query.
+  std::string tablePath(const std::string& name) {
+    if (FLAGS_wave) {
+      return fmt::format("{}/{}.wave", FLAGS_data_path, name);
+    }
+    return fmt::format("{}/{}.{}", FLAGS_data_path, name, FLAGS_data_format);
+  }
+
+  void storeTable(const std::string& name, std::vector<RowVectorPtr>& vectors) {
+    auto path = tablePath(name);
+    if (FLAGS_wave) {
+      makeTable(path, vectors);
+      wave::test::Table::getTable(path)->toFile(path);
+    } else {
+      writeToFile(path, vectors, vectors.front()->type());
+    }
+  }
+
+  void loadTable(const std::string& name) {
+    if (FLAGS_wave) {
+      auto path = tablePath(name);
+      auto table = wave::test::Table::getTable(path, true);
+      table->fromFile(path);
+      if (FLAGS_preload) {
+        table->loadData(leafPool_);
+      }
+    }
+  }
+
+  // Sets column 'channel' of 'vectors' to 'value(n)', where n is the row
+  // number over all of 'vectors'.
+  void setColumn(
+      std::vector<RowVectorPtr>& vectors,
+      int32_t channel,
+      std::function<int64_t(int64_t)> value) {
+    int64_t row = 0;
+    for (auto& vector : vectors) {
+      auto column = vector->childAt(channel)->as<FlatVector<int64_t>>();
+      for (auto i = 0; i < column->size(); ++i) {
+        column->set(i, value(row++));
+      }
+    }
+  }
+
+  std::vector<RowVectorPtr> makeJoinVectors(
+      const RowTypePtr& type,
+      int64_t numRows) {
+    auto numVectors = std::max<int64_t>(1, numRows / FLAGS_rows_per_stripe);
+    auto vectors = makeVectors(type, numVectors, numRows / numVectors);
+    for (auto& vector : vectors) {
+      makeRange(vector, 1000000000);
+    }
+    return vectors;
+  }
+
+  // Makes the tables of the TPC-H Q3 shaped join query. All keys have a
+  // match on the build side. The other columns are uniformly distributed in
+  // [0, 1e9).
+  void makeJoinData() {
+    const int64_t numOrders = FLAGS_num_orders;
+    const int64_t numCustomers = std::max<int64_t>(1, numOrders / 10);
+    auto customer = makeJoinVectors(customerType(), numCustomers);
+    setColumn(customer, 0, [](int64_t row) { return row; });
+    storeTable("customer", customer);
+
+    auto orders = makeJoinVectors(ordersType(), numOrders);
+    setColumn(orders, 0, [](int64_t row) { return row; });
+    setColumn(orders, 1, [&](int64_t row) {
+      return folly::hasher<int64_t>()(row) % numCustomers;
+    });
+    storeTable("orders", orders);
+
+    auto lineitem = makeJoinVectors(lineitemType(), numOrders * 4);
+    setColumn(lineitem, 0, [&](int64_t row) { return (row / 4) % numOrders; });
+    storeTable("lineitem", lineitem);
+  }
+
+  static RowTypePtr customerType() {
+    return ROW(
+        {"c_custkey", "c_mktsegment", "c_nationkey"},
+        {BIGINT(), BIGINT(), BIGINT()});
+  }
+
+  static RowTypePtr ordersType() {
+    return ROW(
+        {"o_orderkey", "o_custkey", "o_orderdate", "o_shippriority"},
+        {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  }
+
+  static RowTypePtr lineitemType() {
+    return ROW(
+        {"l_orderkey", "l_extendedprice", "l_discount", "l_shipdate"},
+        {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  }
+
   std::vector<RowVectorPtr> makeVectors(
       const RowTypePtr& rowType,
       int32_t numVectors,
@@ -270,6 +371,57 @@ class WaveBenchmark : public QueryBenchmarkBase {
 
         return plan;
       }
+      case 2: {
+        // TPC-H Q3 shape: lineitem x orders x customer with a filter on each
+        // table and a group by on the order key. The build side keys are the
+        // primary keys of customer and orders.
+        wave::testingSetAssumeUniqueJoinKeys(true);
+        exec::test::TpchPlan plan;
+        plan.dataFileFormat = FLAGS_wave ? FileFormat::UNKNOWN
+                                         : toFileFormat(FLAGS_data_format);
+        int64_t bound = (1'000'000'000LL * FLAGS_filter_pass_pct) / 100;
+        auto idGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+        core::PlanNodeId customerId;
+        core::PlanNodeId ordersId;
+        core::PlanNodeId lineitemId;
+        auto customer =
+            PlanBuilder(idGenerator, leafPool_.get())
+                .tableScan(
+                    customerType(), {fmt::format("c_mktsegment < {}", bound)})
+                .capturePlanNodeId(customerId)
+                .planNode();
+        auto orders =
+            PlanBuilder(idGenerator, leafPool_.get())
+                .tableScan(
+                    ordersType(), {fmt::format("o_orderdate < {}", bound)})
+                .capturePlanNodeId(ordersId)
+                .hashJoin(
+                    {"o_custkey"},
+                    {"c_custkey"},
+                    customer,
+                    "",
+                    {"o_orderkey", "o_orderdate", "o_shippriority"})
+                .planNode();
+        plan.plan =
+            PlanBuilder(idGenerator, leafPool_.get())
+                .tableScan(
+                    lineitemType(), {fmt::format("l_shipdate < {}", bound)})
+                .capturePlanNodeId(lineitemId)
+                .hashJoin(
+                    {"l_orderkey"},
+                    {"o_orderkey"},
+                    orders,
+                    "",
+                    {"l_orderkey", "l_extendedprice", "o_shippriority"})
+                .singleAggregation(
+                    {"l_orderkey"},
+                    {"sum(l_extendedprice)", "sum(o_shippriority)"})
+                .planNode();
+        plan.dataFiles[customerId] = {tablePath("customer")};
+        plan.dataFiles[ordersId] = {tablePath("orders")};
+        plan.dataFiles[lineitemId] = {tablePath("lineitem")};
+        return plan;
+      }
       default:
         VELOX_FAIL("Bad query number");
     }
@@ -289,6 +441,16 @@ class WaveBenchmark : public QueryBenchmarkBase {
         }
         break;
       }
+      case 2: {
+        if (FLAGS_generate) {
+          makeJoinData();
+        } else {
+          loadTable("customer");
+          loadTable("orders");
+          loadTable("lineitem");
+        }
+        break;
+      }
       default:
         VELOX_FAIL("Bad query number");
     }
@@ -54,6 +54,130 @@ inline std::exception_ptr makeBadCastException(
 
 namespace detail {
 
+/// Returns true if the 8 bytes in 'chunk' are all ASCII digits.
+FOLLY_ALWAYS_INLINE bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+/// Returns the value of the 8 ASCII digits in 'chunk', the first digit being
+/// the most significant. Combines pairs of digits, then pairs of pairs, with
+/// multiplications on the whole word.
+FOLLY_ALWAYS_INLINE uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+}
+
+/// Parses the ASCII digits in 'size' bytes at 'data' into 'value'. Returns
+/// false if there is a non-digit. 'size' must be at most 19 so that 'value'
+/// does not overflow.
+FOLLY_ALWAYS_INLINE bool
+parseDigits(const char* data, size_t size, uint64_t& value) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+/// Parses 's' into 'value' if 's' is an optional '-' followed by 1 to 19 ASCII
+/// digits and the value fits in T. Such strings convert to the same integer
+/// under all cast policies. Returns false for any other string, e.g. with
+/// white space, a '+' sign or a decimal point, and on overflow. These are left
+/// to the policy-specific conversion.
+template <typename T>
+FOLLY_ALWAYS_INLINE bool tryParseSimpleInteger(const StringView& s, T& value) {
+  const char* data = s.data();
+  size_t size = s.size();
+  const bool negative = size > 0 && data[0] == '-';
+  data += negative;
+  size -= negative;
+  if (size == 0 || size > 19) {
+    return false;
+  }
+  uint64_t magnitude = 0;
+  if (!parseDigits(data, size, magnitude)) {
+    return false;
+  }
+  constexpr auto kMax = static_cast<uint64_t>(std::numeric_limits<T>::max());
+  if (negative) {
+    if (magnitude > kMax + 1) {
+      return false;
+    }
+    // Subtracts 1 before negating so that the minimum of T does not overflow.
+    value = magnitude == 0
+        ? 0
+        : static_cast<T>(-static_cast<int64_t>(magnitude - 1) - 1);
+    return true;
+  }
+  if (magnitude > kMax) {
+    return false;
+  }
+  value = static_cast<T>(magnitude);
+  return true;
+}
+
+/// Parses 's' into 'value' if 's' is an optional '-', then digits, then
+/// optionally a '.' followed by more digits, with few enough digits that the
+/// significand and the power of ten are exact in T. The value is then the
+/// correctly rounded quotient of the two, which is what all cast policies
+/// return. Returns false for any other string, e.g. with an exponent, white
+/// space, NaN or Infinity, which are left to the policy-specific conversion.
+template <typename T>
+FOLLY_ALWAYS_INLINE bool tryParseSimpleFloatingPoint(
+    const StringView& s,
+    T& value) {
+  // T represents integers up to 10^kMaxDigits and powers of ten up to
+  // 10^kMaxExponent exactly.
+  constexpr size_t kMaxDigits = std::is_same_v<T, float> ? 7 : 15;
+  constexpr size_t kMaxExponent = std::is_same_v<T, float> ? 10 : 22;
+  static_assert(kMaxDigits <= kMaxExponent);
+  static constexpr double kPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const char* data = s.data();
+  size_t size = s.size();
+  const bool negative = size > 0 && data[0] == '-';
+  data += negative;
+  size -= negative;
+  const char* point = static_cast<const char*>(memchr(data, '.', size));
+  const size_t wholeSize = point ? point - data : size;
+  const size_t fractionSize = point ? size - wholeSize - 1 : 0;
+  if (wholeSize == 0 || (point && fractionSize == 0) ||
+      wholeSize + fractionSize > kMaxDigits) {
+    return false;
+  }
+  uint64_t significand = 0;
+  if (!parseDigits(data, wholeSize, significand) ||
+      (point && !parseDigits(point + 1, fractionSize, significand))) {
+    return false;
+  }
+  value = static_cast<T>(significand) /
+      static_cast<T>(kPowersOfTen[fractionSize]);
+  if (negative) {
+    value = -value;
+  }
+  return true;
+}
+
 /// Represent the varchar fragment.
 ///
 /// For example:
@@ -672,21 +796,56 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Numbers in plain decimal notation are parsed in a tight loop over flat
+  // strings. The rest of the rows go through the per-row kernel.
+  const SelectivityVector* kernelRows = &rows;
+  LocalSelectivityVector fallbackRows(context);
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+       ToKind == TypeKind::REAL || ToKind == TypeKind::DOUBLE)) {
+    if (input.isFlatEncoding()) {
+      const auto* rawStrings =
+          input.asUnchecked<FlatVector<StringView>>()->rawValues();
+      auto* fallback = fallbackRows.get(rows.end(), false);
+      rows.applyToSelected([&](vector_size_t row) {
+        To value;
+        bool parsed;
+        if constexpr (std::is_floating_point_v<To>) {
+          parsed = detail::tryParseSimpleFloatingPoint(rawStrings[row], value);
+        } else {
+          parsed = detail::tryParseSimpleInteger(rawStrings[row], value);
+        }
+        if (parsed) {
+          resultFlatVector->set(row, value);
+        } else {
+          fallback->setValid(row, true);
+        }
+      });
+      fallback->updateBounds();
+      if (!fallback->hasSelections()) {
+        return;
+      }
+      kernelRows = fallback;
+    }
+  }
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case PrestoCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case SparkCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
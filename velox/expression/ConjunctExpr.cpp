@@ -94,9 +94,6 @@ void ConjunctExpr::evalSpecialForm(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
-  // TODO Revisit error handling
-  bool throwOnError = *context.mutableThrowOnError();
-  ScopedVarSetter saveError(context.mutableThrowOnError(), false);
   context.ensureWritable(rows, type(), result);
   auto flatResult = result->asFlatVector<bool>();
   // clear nulls from the result for the active rows.
@@ -117,11 +114,43 @@ void ConjunctExpr::evalSpecialForm(
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(
       context, &rows, !isAnd_);
 
-  bool handleErrors = false;
-  LocalSelectivityVector errorRows(context);
   LocalSelectivityVector activeRowsHolder(context, rows);
   auto activeRows = activeRowsHolder.get();
   VELOX_DCHECK(activeRows != nullptr);
+  evalInputs(rows, context, flatResult, activeRows, nullptr);
+}
+
+void ConjunctExpr::evalFilter(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    SelectivityVector& passed) {
+  VELOX_CHECK(isAnd_);
+  passed = rows;
+  // Rows where a conjunct is null. These stay active like in evalSpecialForm
+  // so that errors are raised the same way but don't pass.
+  LocalSelectivityVector nullRowsHolder(context, rows.end());
+  auto* nullRows = nullRowsHolder.get();
+  nullRows->clearAll();
+  evalInputs(rows, context, nullptr, &passed, nullRows);
+  bits::andWithNegatedBits(
+      passed.asMutableRange().bits(),
+      nullRows->asRange().bits(),
+      rows.begin(),
+      rows.end());
+  passed.updateBounds();
+}
+
+void ConjunctExpr::evalInputs(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    FlatVector<bool>* result,
+    SelectivityVector* activeRows,
+    SelectivityVector* nullRows) {
+  // TODO Revisit error handling
+  bool throwOnError = *context.mutableThrowOnError();
+  ScopedVarSetter saveError(context.mutableThrowOnError(), false);
+  bool handleErrors = false;
+  LocalSelectivityVector errorRows(context);
   int32_t numActive = activeRows->countSelected();
   for (int32_t i = 0; i < inputs_.size(); ++i) {
     VectorPtr inputResult;
@@ -151,7 +180,11 @@ void ConjunctExpr::evalSpecialForm(
       extraActive =
           rowsWithError(rows, *activeRows, context, errors, errorRows);
     }
-    updateResult(inputResult.get(), context, flatResult, activeRows);
+    if (result) {
+      updateResult(inputResult.get(), context, result, activeRows);
+    } else {
+      updateFilterRows(inputResult.get(), context, activeRows, nullRows);
+    }
     if (extraActive) {
       uint64_t* activeBits = activeRows->asMutableRange().bits();
       bits::orBits(activeBits, extraActive, rows.begin(), rows.end());
@@ -380,6 +413,53 @@ void ConjunctExpr::updateResult(
   }
 }
 
+void ConjunctExpr::updateFilterRows(
+    BaseVector* inputResult,
+    EvalCtx& context,
+    SelectivityVector* activeRows,
+    SelectivityVector* nullRows) {
+  // Deselects the rows where the conjunct is false and records the rows where
+  // it is null.
+  const uint64_t* values = nullptr;
+  const uint64_t* nulls = nullptr;
+  switch (getFlatBool(
+      inputResult,
+      *activeRows,
+      context,
+      &tempValues_,
+      &tempNulls_,
+      false,
+      &values,
+      &nulls)) {
+    case BooleanMix::kAllNull:
+      bits::orBits(
+          nullRows->asMutableRange().bits(),
+          activeRows->asRange().bits(),
+          activeRows->begin(),
+          activeRows->end());
+      return;
+    case BooleanMix::kAllFalse:
+      activeRows->clearAll();
+      return;
+    case BooleanMix::kAllTrue:
+      return;
+    default: {
+      auto* activeBits = activeRows->asMutableRange().bits();
+      auto* nullBits = nullRows->asMutableRange().bits();
+      bits::forEachWord(
+          activeRows->begin(),
+          activeRows->end(),
+          [&](int32_t index, uint64_t mask) {
+            const uint64_t present = nulls ? nulls[index] : bits::kNotNull64;
+            const uint64_t active = activeBits[index] & mask;
+            nullBits[index] |= active & ~present;
+            activeBits[index] &= ~(active & ~values[index] & present);
+          });
+      activeRows->updateBounds();
+    }
+  }
+}
+
 std::string ConjunctExpr::toSql(
     std::vector<VectorPtr>* complexConstants) const {
   std::stringstream out;
@@ -60,6 +60,19 @@ class ConjunctExpr : public SpecialForm {
     return true;
   }
 
+  bool isAnd() const {
+    return isAnd_;
+  }
+
+  /// Evaluates an AND as a filter. Sets 'passed' to the subset of 'rows' where
+  /// all the conjuncts are true. Unlike evalSpecialForm, this narrows
+  /// 'passed' conjunct by conjunct without producing a result vector. Errors
+  /// are handled like in evalSpecialForm.
+  void evalFilter(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      SelectivityVector& passed);
+
   const SelectivityInfo& selectivityAt(int32_t index) {
     return selectivity_[inputOrder_[index]];
   }
@@ -82,12 +95,28 @@ class ConjunctExpr : public SpecialForm {
 
   void maybeReorderInputs();
 
+  // Evaluates the inputs on 'activeRows', which starts as 'rows', and updates
+  // 'result' with their values. If 'result' is nullptr, only updates
+  // 'activeRows' and 'nullRows' as in evalFilter.
+  void evalInputs(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      FlatVector<bool>* result,
+      SelectivityVector* activeRows,
+      SelectivityVector* nullRows);
+
   void updateResult(
       BaseVector* inputResult,
       EvalCtx& context,
       FlatVector<bool>* result,
       SelectivityVector* activeRows);
 
+  void updateFilterRows(
+      BaseVector* inputResult,
+      EvalCtx& context,
+      SelectivityVector* activeRows,
+      SelectivityVector* nullRows);
+
   bool evaluatesArgumentsOnNonIncreasingSelection() const override {
     return isAnd_;
   }
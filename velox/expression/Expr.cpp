@@ -25,6 +25,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/Expressions.h"
 #include "velox/expression/CastExpr.h"
+#include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
@@ -742,6 +743,7 @@ void Expr::evalFlatNoNullsImpl(
     return;
   }
 
+  ++stats_.numFlatNoNullsVectors;
   if (isSpecialForm()) {
     evalSpecialFormWithStats(rows, context, result);
     return;
@@ -1082,6 +1084,7 @@ void Expr::evalEncodings(
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
+          ++stats_.numPeeledVectors;
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity
           // vector if all selected values we are waiting for are nulls. So,
@@ -1190,6 +1193,19 @@ void Expr::evalWithNulls(
   evalAll(rows, context, result);
 }
 
+bool Expr::isSameBaseOfDictionary(const BaseVector& base) const {
+  if (&base == baseOfDictionaryRawPtr_ && !baseOfDictionaryWeakPtr_.expired()) {
+    return true;
+  }
+  // Readers may wrap the same dictionary, e.g. a DWRF stripe dictionary, in a
+  // new vector for each batch. The values are then the same since the values
+  // and nulls buffers are. The references held to these buffers ensure that
+  // they are not modified in place.
+  return baseOfDictionaryValues_ != nullptr && base.isFlatEncoding() &&
+      base.values() == baseOfDictionaryValues_ &&
+      base.nulls() == baseOfDictionaryNulls_;
+}
+
 // Optimization that attempts to cache results for inputs that are dictionary
 // encoded and use the same base vector between subsequent input batches. Since
 // this hold onto a reference to the base vector and the cached results, it can
@@ -1203,16 +1219,31 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
 
-  if (base.get() != baseOfDictionaryRawPtr_ ||
-      baseOfDictionaryWeakPtr_.expired()) {
+  if (!isSameBaseOfDictionary(*base)) {
     baseOfDictionaryRepeats_ = 0;
     baseOfDictionaryWeakPtr_ = base;
     baseOfDictionaryRawPtr_ = base.get();
     context.releaseVector(baseOfDictionary_);
     context.releaseVector(dictionaryCache_);
+    if (base->isFlatEncoding() && base->values() != nullptr) {
+      baseOfDictionaryValues_ = base->values();
+      baseOfDictionaryNulls_ = base->nulls();
+    } else {
+      baseOfDictionaryValues_ = nullptr;
+      baseOfDictionaryNulls_ = nullptr;
+    }
     evalWithNulls(rows, context, result);
     return;
   }
+  if (base.get() != baseOfDictionaryRawPtr_) {
+    // A new vector over the same buffers. Track it instead of the previous
+    // one, which may go away.
+    baseOfDictionaryWeakPtr_ = base;
+    baseOfDictionaryRawPtr_ = base.get();
+    if (baseOfDictionary_ != nullptr) {
+      baseOfDictionary_ = base;
+    }
+  }
   ++baseOfDictionaryRepeats_;
 
   if (baseOfDictionaryRepeats_ == 1) {
@@ -1490,6 +1521,7 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
+  ++stats_.numPeeledVectors;
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
 
@@ -1520,13 +1552,75 @@ bool Expr::applyFunctionWithPeeling(
   return true;
 }
 
+namespace {
+
+// Returns the vector holding the StringViews of a string vector or of the
+// elements of an array of strings, with the wrappers removed. Returns nullptr
+// for other types.
+const BaseVector* stringsOf(const BaseVector* vector) {
+  vector = vector->wrappedVector();
+  if (vector->encoding() == VectorEncoding::Simple::ARRAY) {
+    vector = vector->asUnchecked<ArrayVector>()->elements()->wrappedVector();
+  }
+  if (vector->typeKind() != TypeKind::VARCHAR &&
+      vector->typeKind() != TypeKind::VARBINARY) {
+    return nullptr;
+  }
+  return vector;
+}
+
+bool hasStringBuffer(const BaseVector* vector, const Buffer* buffer) {
+  if (vector->isFlatEncoding()) {
+    for (const auto& stringBuffer :
+         vector->asUnchecked<FlatVector<StringView>>()->stringBuffers()) {
+      if (stringBuffer.get() == buffer) {
+        return true;
+      }
+    }
+  } else if (vector->isConstantEncoding() && !vector->isNullAt(0)) {
+    return vector->asUnchecked<ConstantVector<StringView>>()
+               ->getStringBuffer()
+               .get() == buffer;
+  }
+  return false;
+}
+
+// Returns the size of the string buffers of 'result' which are not shared
+// with any of 'inputs', i.e. the bytes a function wrote instead of referencing
+// the strings of its inputs.
+uint64_t stringBytesWritten(
+    const BaseVector& result,
+    const std::vector<VectorPtr>& inputs) {
+  const auto* strings = stringsOf(&result);
+  if (strings == nullptr || !strings->isFlatEncoding()) {
+    return 0;
+  }
+  uint64_t bytes = 0;
+  for (const auto& buffer :
+       strings->asUnchecked<FlatVector<StringView>>()->stringBuffers()) {
+    const bool shared =
+        std::any_of(inputs.begin(), inputs.end(), [&](const auto& input) {
+          const auto* inputStrings =
+              input != nullptr ? stringsOf(input.get()) : nullptr;
+          return inputStrings != nullptr &&
+              hasStringBuffer(inputStrings, buffer.get());
+        });
+    if (!shared) {
+      bytes += buffer->size();
+    }
+  }
+  return bytes;
+}
+
+} // namespace
+
 void Expr::applyFunction(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
-  auto timer = cpuWallTimer();
+  auto timer = cpuWallTimer(context);
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
   auto isAscii = type()->isVarchar()
@@ -1562,19 +1656,37 @@ void Expr::applyFunction(
     result = BaseVector::createNullConstant(type(), rows.end(), context.pool());
   }
 
+  stats_.numStringBytesWritten += stringBytesWritten(*result, inputValues_);
+
   if (isAscii.has_value()) {
     result->asUnchecked<SimpleVector<StringView>>()->setIsAscii(
         isAscii.value(), rows);
   }
 }
 
+std::unique_ptr<CpuWallTimer> Expr::cpuWallTimer(const EvalCtx& context) {
+  if (trackCpuUsage_) {
+    return std::make_unique<CpuWallTimer>(stats_.timing);
+  }
+  if (!cpuSamplingRate_.has_value()) {
+    cpuSamplingRate_ =
+        context.execCtx()->queryCtx()->queryConfig().exprCpuSamplingRate();
+  }
+  // Samples the first vector and every N-th one after that.
+  if (*cpuSamplingRate_ > 0 &&
+      (stats_.numProcessedVectors - 1) % *cpuSamplingRate_ == 0) {
+    return std::make_unique<CpuWallTimer>(stats_.sampledTiming);
+  }
+  return nullptr;
+}
+
 void Expr::evalSpecialFormWithStats(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
-  auto timer = cpuWallTimer();
+  auto timer = cpuWallTimer(context);
 
   evalSpecialForm(rows, context, result);
 }
@@ -1814,6 +1926,36 @@ std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   return stats;
 }
 
+namespace {
+ExprStatsTreeNode makeStatsTree(
+    const exec::Expr& expr,
+    std::unordered_set<const exec::Expr*>& uniqueExprs) {
+  ExprStatsTreeNode node;
+  node.name = expr.name();
+  if (!uniqueExprs.insert(&expr).second) {
+    // Common sub-expression. Its stats are reported at the first occurrence.
+    node.isRepeated = true;
+    return node;
+  }
+  node.stats = expr.stats();
+  node.inputs.reserve(expr.inputs().size());
+  for (const auto& input : expr.inputs()) {
+    node.inputs.push_back(makeStatsTree(*input, uniqueExprs));
+  }
+  return node;
+}
+} // namespace
+
+std::vector<ExprStatsTreeNode> ExprSet::statsTrees() const {
+  std::vector<ExprStatsTreeNode> trees;
+  trees.reserve(exprs().size());
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  for (const auto& expr : exprs()) {
+    trees.push_back(makeStatsTree(*expr, uniqueExprs));
+  }
+  return trees;
+}
+
 ExprSet::~ExprSet() {
   exprSetListeners().withRLock([&](auto& listeners) {
     if (!listeners.empty()) {
@@ -1833,10 +1975,13 @@ ExprSet::~ExprSet() {
       // TODO Enhance listener API to allow passing 'complexConstants' in
       // addition to SQL.
 
+      auto statsTrees = this->statsTrees();
+
       auto uuid = makeUuid();
       for (const auto& listener : listeners) {
         listener->onCompletion(
-            uuid, {exprStats, sqls, execCtx()->queryCtx()->queryId()});
+            uuid,
+            {exprStats, statsTrees, sqls, execCtx()->queryCtx()->queryId()});
       }
     }
   });
@@ -1969,6 +2114,32 @@ void ExprSet::clearCache() {
   }
 }
 
+bool ExprSet::evalFilter(
+    int32_t index,
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    SelectivityVector& passed) {
+  auto* conjunct = dynamic_cast<ConjunctExpr*>(exprs_[index].get());
+  // A shared top level expression or one evaluated without throwing on errors
+  // needs its result vector.
+  if (conjunct == nullptr || !conjunct->isAnd() ||
+      conjunct->isMultiplyReferenced() || !context.throwOnError()) {
+    return false;
+  }
+  clearSharedSubexprs();
+  for (const auto& field : multiplyReferencedFields_) {
+    context.ensureFieldLoaded(field->index(context), rows);
+  }
+
+  ExprExceptionContext exprExceptionContext{conjunct, context.row(), this};
+  ExceptionContextSetter exceptionContext(
+      {.messageFunc = onTopLevelException,
+       .arg = (void*)&exprExceptionContext,
+       .isEssential = true});
+  conjunct->evalFilter(rows, context, passed);
+  return true;
+}
+
 void ExprSetSimplified::eval(
     int32_t begin,
     int32_t end,
@@ -52,6 +52,11 @@ struct ExprStats {
   /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
   CpuWallTiming timing;
 
+  /// Timing of every N-th vector, where N is
+  /// QueryConfig.exprCpuSamplingRate(). 'sampledTiming.count' is the number of
+  /// sampled vectors. Not collected if exprTrackCpuUsage() is 'true'.
+  CpuWallTiming sampledTiming;
+
   /// Number of processed rows.
   uint64_t numProcessedRows{0};
 
@@ -63,23 +68,86 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of vectors evaluated on inputs with dictionary or constant
+  /// encodings peeled off.
+  uint64_t numPeeledVectors{0};
+
+  /// Number of vectors evaluated on the fast path for flat inputs without
+  /// nulls.
+  uint64_t numFlatNoNullsVectors{0};
+
+  /// Number of bytes in the string buffers of the results of a function which
+  /// are not shared with its inputs, i.e. strings that were written or copied
+  /// instead of referencing the input strings. Counts string and array of
+  /// string results. A result buffer reused across batches is counted again.
+  uint64_t numStringBytesWritten{0};
+
+  /// For CASE expressions, the number of rows matched by each WHEN clause in
+  /// the order of the query text. Empty for other expressions.
+  std::vector<uint64_t> numCaseMatches;
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
+    sampledTiming.add(other.sampledTiming);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numPeeledVectors += other.numPeeledVectors;
+    numFlatNoNullsVectors += other.numFlatNoNullsVectors;
+    numStringBytesWritten += other.numStringBytesWritten;
+    if (numCaseMatches.size() < other.numCaseMatches.size()) {
+      numCaseMatches.resize(other.numCaseMatches.size());
+    }
+    for (auto i = 0; i < other.numCaseMatches.size(); ++i) {
+      numCaseMatches[i] += other.numCaseMatches[i];
+    }
   }
 
   std::string toString() const {
-    return fmt::format(
+    auto result = fmt::format(
         "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}",
         timing.toString(),
         numProcessedRows,
         numProcessedVectors,
         defaultNullRowsSkipped ? "true" : "false");
+    if (sampledTiming.count > 0) {
+      result += fmt::format(", sampledTiming: {}", sampledTiming.toString());
+    }
+    if (numPeeledVectors > 0) {
+      result += fmt::format(", numPeeledVectors: {}", numPeeledVectors);
+    }
+    if (numFlatNoNullsVectors > 0) {
+      result +=
+          fmt::format(", numFlatNoNullsVectors: {}", numFlatNoNullsVectors);
+    }
+    if (numStringBytesWritten > 0) {
+      result +=
+          fmt::format(", numStringBytesWritten: {}", numStringBytesWritten);
+    }
+    if (!numCaseMatches.empty()) {
+      result += ", numCaseMatches: [";
+      for (auto i = 0; i < numCaseMatches.size(); ++i) {
+        result += fmt::format("{}{}", i > 0 ? ", " : "", numCaseMatches[i]);
+      }
+      result += "]";
+    }
+    return result;
   }
 };
 
+/// Runtime stats of a node of an expression tree.
+struct ExprStatsTreeNode {
+  /// Name of the expression, e.g. a function name or a special form like and,
+  /// or, switch.
+  std::string name;
+  /// Stats of this node. Empty if 'isRepeated' is true.
+  ExprStats stats;
+  /// True if this node is a repeated occurrence of a common sub-expression.
+  /// The stats and inputs are reported at the first occurrence only.
+  bool isRepeated{false};
+  std::vector<ExprStatsTreeNode> inputs;
+};
+
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -261,6 +329,8 @@ class Expr {
     baseOfDictionary_.reset();
     baseOfDictionaryWeakPtr_.reset();
     baseOfDictionaryRawPtr_ = nullptr;
+    baseOfDictionaryValues_ = nullptr;
+    baseOfDictionaryNulls_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
   }
@@ -456,6 +526,10 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Returns true if the results cached for the previous base of dictionary
+  // are valid for 'base'.
+  bool isSameBaseOfDictionary(const BaseVector& base) const;
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -573,12 +647,10 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
-  /// Returns an instance of CpuWallTimer if cpu usage tracking is enabled. Null
-  /// otherwise.
-  std::unique_ptr<CpuWallTimer> cpuWallTimer() {
-    return trackCpuUsage_ ? std::make_unique<CpuWallTimer>(stats_.timing)
-                          : nullptr;
-  }
+  /// Returns an instance of CpuWallTimer if cpu usage tracking is enabled or
+  /// the current vector is sampled. Null otherwise. Must be called after
+  /// stats_.numProcessedVectors has been incremented for the current vector.
+  std::unique_ptr<CpuWallTimer> cpuWallTimer(const EvalCtx& context);
 
   // Should be called only after computeMetadata() has been called on 'inputs_'.
   // Computes distinctFields for this expression. Also updates any multiply
@@ -676,6 +748,12 @@ class Expr {
   // not modified and re-used in-place.
   VectorPtr baseOfDictionary_;
 
+  // The values and nulls buffers of 'baseOfDictionaryRawPtr_' if it is flat. A
+  // different base vector over the same buffers has the same values, so the
+  // cached results stay valid for it.
+  BufferPtr baseOfDictionaryValues_;
+  BufferPtr baseOfDictionaryNulls_;
+
   // Number of times currently held cacheable vector is seen for a non-first
   // time. Is reset everytime 'baseOfDictionaryRawPtr_' is different from the
   // current input's base.
@@ -691,6 +769,9 @@ class Expr {
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
+  // QueryConfig.exprCpuSamplingRate(). Read on first evaluation.
+  std::optional<uint32_t> cpuSamplingRate_;
+
   // If true computeMetaData returns, otherwise meta data is computed and the
   // flag is set to true.
   bool metaDataComputed_ = false;
@@ -741,6 +822,17 @@ class ExprSet {
       EvalCtx& ctx,
       std::vector<VectorPtr>& result);
 
+  /// Initializes and evaluates the expression at 'index' as a filter. If it is
+  /// an AND, sets 'passed' to the subset of 'rows' where all the conjuncts are
+  /// true and returns true. The conjuncts narrow 'passed' directly, without
+  /// producing a boolean result vector. Returns false without evaluating
+  /// anything otherwise, in which case the caller uses eval().
+  virtual bool evalFilter(
+      int32_t index,
+      const SelectivityVector& rows,
+      EvalCtx& ctx,
+      SelectivityVector& passed);
+
   void clear();
 
   /// Clears the internally cached buffers used for shared sub-expressions and
@@ -791,6 +883,11 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns runtime statistics for each node of each expression in the same
+  /// order as exprs(). A common sub-expression has its stats at its first
+  /// occurrence only.
+  std::vector<ExprStatsTreeNode> statsTrees() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -835,6 +932,14 @@ class ExprSetSimplified : public ExprSet {
       const SelectivityVector& rows,
       EvalCtx& ctx,
       std::vector<VectorPtr>& result) override;
+
+  bool evalFilter(
+      int32_t /*index*/,
+      const SelectivityVector& /*rows*/,
+      EvalCtx& /*ctx*/,
+      SelectivityVector& /*passed*/) override {
+    return false;
+  }
 };
 
 // Factory method that takes `kExprEvalSimplified` (query parameter) into
@@ -853,6 +958,9 @@ struct ExprSetCompletionEvent {
   /// Aggregated runtime stats keyed on expression name (e.g. built-in
   /// expression like and, or, switch or a function name).
   std::unordered_map<std::string, exec::ExprStats> stats;
+  /// Runtime stats of each node of each top level expression in ExprSet. In
+  /// the same order as 'sqls'.
+  std::vector<ExprStatsTreeNode> statsTrees;
   /// List containing sql representation of each top level expression in ExprSet
   std::vector<std::string> sqls;
   // Query id corresponding query
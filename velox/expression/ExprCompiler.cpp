@@ -21,7 +21,9 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/LambdaExpr.h"
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
 #include "velox/expression/SpecialFormRegistry.h"
@@ -85,6 +87,13 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // The groups of calls to a multi-path extract function, keyed on the
+  // function name and the compiled document.
+  std::map<
+      std::pair<std::string, const Expr*>,
+      std::shared_ptr<MultiPathExtractGroup>>
+      extractGroups;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -366,6 +375,160 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+// Returns true if 'expr' is a call to a fused arithmetic function which takes
+// and returns 'type'.
+bool isFusableCall(const TypedExprPtr& expr, const TypePtr& type) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (!call || *expr->type() != *type) {
+    return false;
+  }
+  const auto op = fusedArithmeticFunction(call->name());
+  const size_t numArgs = op == FusedArithmeticOp::kNegate ? 1 : 2;
+  if (!op.has_value() || expr->inputs().size() != numArgs) {
+    return false;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (*input->type() != *type) {
+      return false;
+    }
+  }
+  // A rewritten call is compiled as a leaf.
+  return rewriteExpression(expr).get() == expr.get();
+}
+
+// Returns the number of fusable calls in the tree of fusable calls rooted at
+// 'expr'.
+int32_t countFusableCalls(const TypedExprPtr& expr, const TypePtr& type) {
+  if (!isFusableCall(expr, type)) {
+    return 0;
+  }
+  int32_t count = 1;
+  for (const auto& input : expr->inputs()) {
+    count += countFusableCalls(input, type);
+  }
+  return count;
+}
+
+// Appends the postfix program of the tree of fusable calls rooted at 'expr' to
+// 'program'. The other expressions are compiled as usual and added to
+// 'inputs'.
+void compileFusedProgram(
+    const TypedExprPtr& expr,
+    const TypePtr& type,
+    Scope* scope,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool,
+    const std::unordered_set<std::string>& flatteningCandidates,
+    bool enableConstantFolding,
+    std::vector<ExprPtr>& inputs,
+    std::vector<FusedArithmeticExpr::Instruction>& program) {
+  FusedArithmeticExpr::Instruction instruction;
+  if (isFusableCall(expr, type)) {
+    for (const auto& input : expr->inputs()) {
+      compileFusedProgram(
+          input,
+          type,
+          scope,
+          config,
+          pool,
+          flatteningCandidates,
+          enableConstantFolding,
+          inputs,
+          program);
+    }
+    const auto& name =
+        static_cast<const core::CallTypedExpr*>(expr.get())->name();
+    instruction.op = fusedArithmeticFunction(name);
+    instruction.name = name;
+    program.push_back(std::move(instruction));
+    return;
+  }
+  auto input = compileExpression(
+      expr, scope, config, pool, flatteningCandidates, enableConstantFolding);
+  auto it = std::find(inputs.begin(), inputs.end(), input);
+  instruction.input = it - inputs.begin();
+  if (it == inputs.end()) {
+    inputs.push_back(std::move(input));
+  }
+  program.push_back(std::move(instruction));
+}
+
+// Returns a FusedArithmeticExpr for 'expr' if it is the root of at least two
+// fusable calls. Returns nullptr otherwise.
+ExprPtr tryCompileFused(
+    const TypedExprPtr& expr,
+    Scope* scope,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool,
+    const std::unordered_set<std::string>& flatteningCandidates,
+    bool enableConstantFolding) {
+  const auto& type = expr->type();
+  if (*type != *DOUBLE() && *type != *REAL()) {
+    return nullptr;
+  }
+  if (countFusableCalls(expr, type) < 2) {
+    return nullptr;
+  }
+  std::vector<ExprPtr> inputs;
+  std::vector<FusedArithmeticExpr::Instruction> program;
+  compileFusedProgram(
+      expr,
+      type,
+      scope,
+      config,
+      pool,
+      flatteningCandidates,
+      enableConstantFolding,
+      inputs,
+      program);
+  const bool inputsSupportFlatNoNullsFastPath =
+      Expr::allSupportFlatNoNullsFastPath(inputs);
+  return std::make_shared<FusedArithmeticExpr>(
+      type,
+      std::move(inputs),
+      std::move(program),
+      inputsSupportFlatNoNullsFastPath);
+}
+
+// Returns a MultiPathExtractExpr for 'call' if it calls a multi-path extract
+// function with a constant path. Returns nullptr otherwise. Calls on constant
+// documents are left for constant folding.
+ExprPtr tryCompileMultiPathExtract(
+    const core::CallTypedExpr& call,
+    const TypePtr& resultType,
+    const std::vector<ExprPtr>& compiledInputs,
+    Scope* scope) {
+  auto function = multiPathExtractFunction(call.name());
+  if (!function.has_value() || compiledInputs.size() != 2 ||
+      resultType->kind() != TypeKind::VARCHAR ||
+      compiledInputs[0]->type()->kind() != TypeKind::VARCHAR ||
+      compiledInputs[0]->is<ConstantExpr>()) {
+    return nullptr;
+  }
+  auto* constant = compiledInputs[1]->as<ConstantExpr>();
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR ||
+      constant->value()->isNullAt(0)) {
+    return nullptr;
+  }
+  const auto path =
+      constant->value()->as<SimpleVector<StringView>>()->valueAt(0).str();
+  if (!function->isValidPath(path)) {
+    return nullptr;
+  }
+  auto& group = scope->extractGroups[{call.name(), compiledInputs[0].get()}];
+  if (group == nullptr) {
+    group = std::make_shared<MultiPathExtractGroup>(std::move(*function));
+  }
+  const auto pathIndex = group->addPath(path);
+  return std::make_shared<MultiPathExtractExpr>(
+      resultType,
+      compiledInputs[0],
+      compiledInputs[1],
+      call.name(),
+      group,
+      pathIndex);
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -386,6 +549,22 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
+  if (config.exprFuseArithmetic()) {
+    if (auto fused = tryCompileFused(
+            expr,
+            scope,
+            config,
+            pool,
+            flatteningCandidates,
+            enableConstantFolding)) {
+      fused->computeMetadata();
+      auto folded =
+          enableConstantFolding ? tryFoldIfConstant(fused, scope) : fused;
+      scope->visited[expr.get()] = folded;
+      return folded;
+    }
+  }
+
   const bool trackCpuUsage = config.exprTrackCpuUsage();
 
   ExprPtr result;
@@ -417,6 +596,12 @@ ExprPtr compileRewrittenExpression(
     if (auto specialForm = specialFormRegistry().getSpecialForm(call->name())) {
       result = specialForm->constructSpecialForm(
           resultType, std::move(compiledInputs), trackCpuUsage, config);
+    } else if (
+        auto extract = config.exprMultiPathExtract()
+            ? tryCompileMultiPathExtract(
+                  *call, resultType, compiledInputs, scope)
+            : nullptr) {
+      result = std::move(extract);
     } else if (
         auto functionWithMetadata = getVectorFunctionWithMetadata(
             call->name(),
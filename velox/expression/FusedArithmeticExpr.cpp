@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedArithmeticExpr.h"
+
+#include <folly/Synchronized.h>
+#include <sstream>
+
+namespace facebook::velox::exec {
+namespace {
+const char* const kFusedArithmetic = "fused_arithmetic";
+
+folly::Synchronized<std::unordered_map<std::string, FusedArithmeticOp>>&
+fusedArithmeticFunctions() {
+  static folly::Synchronized<
+      std::unordered_map<std::string, FusedArithmeticOp>>
+      functions;
+  return functions;
+}
+
+int32_t arity(FusedArithmeticOp op) {
+  return op == FusedArithmeticOp::kNegate ? 1 : 2;
+}
+
+template <typename T>
+void divide(T* a, const T* b, int32_t size)
+// Depend on compiler have correct behaviour for divide by zero.
+#if defined(__has_feature)
+#if __has_feature(__address_sanitizer__)
+    __attribute__((__no_sanitize__("float-divide-by-zero")))
+#endif
+#endif
+{
+  for (auto i = 0; i < size; ++i) {
+    a[i] = a[i] / b[i];
+  }
+}
+} // namespace
+
+void registerFusedArithmeticFunction(
+    const std::string& name,
+    FusedArithmeticOp op) {
+  fusedArithmeticFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedArithmeticOp> fusedArithmeticFunction(
+    const std::string& name) {
+  auto functions = fusedArithmeticFunctions().rlock();
+  auto it = functions->find(name);
+  if (it == functions->end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+FusedArithmeticExpr::FusedArithmeticExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    std::vector<Instruction>&& program,
+    bool inputsSupportFlatNoNullsFastPath)
+    : SpecialForm(
+          std::move(type),
+          std::move(inputs),
+          kFusedArithmetic,
+          inputsSupportFlatNoNullsFastPath,
+          false /* trackCpuUsage */),
+      program_(std::move(program)) {
+  VELOX_CHECK(
+      this->type()->kind() == TypeKind::DOUBLE ||
+          this->type()->kind() == TypeKind::REAL,
+      "Fused arithmetic is only supported for DOUBLE and REAL: {}",
+      this->type()->toString());
+  int32_t depth = 0;
+  for (const auto& instruction : program_) {
+    if (!instruction.op.has_value()) {
+      VELOX_CHECK_LT(instruction.input, inputs_.size());
+      maxDepth_ = std::max(maxDepth_, ++depth);
+      continue;
+    }
+    VELOX_CHECK_GE(depth, arity(*instruction.op));
+    depth -= arity(*instruction.op) - 1;
+  }
+  VELOX_CHECK_EQ(depth, 1, "Malformed fused arithmetic program");
+  stack_.resize(maxDepth_ * kBlockSize);
+}
+
+void FusedArithmeticExpr::computePropagatesNulls() {
+  // All the fused functions have default null behavior.
+  propagatesNulls_ = std::all_of(
+      inputs_.begin(), inputs_.end(), [](const ExprPtr& input) {
+        return input->propagatesNulls();
+      });
+}
+
+void FusedArithmeticExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  // Rows which are not null in any of the inputs so far. Like for a function
+  // call with default null behavior, the inputs are only evaluated on these.
+  LocalSelectivityVector remainingRows(context, rows);
+  auto* remaining = remainingRows.get();
+  std::vector<VectorPtr> inputValues(inputs_.size());
+  std::vector<LocalDecodedVector> localDecoded;
+  localDecoded.reserve(inputs_.size());
+  std::vector<DecodedVector*> decoded;
+  decoded.reserve(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(*remaining, context, inputValues[i]);
+    if (context.errors()) {
+      context.deselectErrors(*remaining);
+    }
+    localDecoded.emplace_back(context, *inputValues[i], *remaining);
+    decoded.push_back(localDecoded.back().get());
+    if (auto* rawNulls = decoded.back()->nulls(remaining)) {
+      remaining->deselectNulls(rawNulls, remaining->begin(), remaining->end());
+    }
+    if (!remaining->hasSelections()) {
+      break;
+    }
+  }
+
+  context.ensureWritable(rows, type(), result);
+  result->clearNulls(rows);
+  if (remaining->hasSelections()) {
+    if (type()->kind() == TypeKind::DOUBLE) {
+      evalTyped<double>(*remaining, decoded, result);
+    } else {
+      evalTyped<float>(*remaining, decoded, result);
+    }
+  }
+  if (remaining->countSelected() < rows.countSelected()) {
+    addNulls(rows, remaining->asRange().bits(), context, result);
+  }
+}
+
+template <typename T>
+void FusedArithmeticExpr::evalTyped(
+    const SelectivityVector& rows,
+    const std::vector<DecodedVector*>& decoded,
+    VectorPtr& result) {
+  auto* rawResult = result->asUnchecked<FlatVector<T>>()->mutableRawValues();
+  // 'stack_' holds doubles, which is enough room for the same number of floats.
+  auto* stack = reinterpret_cast<T*>(stack_.data());
+  vector_size_t indices[kBlockSize];
+
+  auto runBlock = [&](int32_t size) {
+    int32_t depth = 0;
+    for (const auto& instruction : program_) {
+      if (!instruction.op.has_value()) {
+        auto* target = stack + depth * kBlockSize;
+        const auto& input = *decoded[instruction.input];
+        if (input.isConstantMapping()) {
+          std::fill_n(target, size, input.valueAt<T>(indices[0]));
+        } else if (input.isIdentityMapping()) {
+          const auto* data = input.data<T>();
+          for (auto i = 0; i < size; ++i) {
+            target[i] = data[indices[i]];
+          }
+        } else {
+          for (auto i = 0; i < size; ++i) {
+            target[i] = input.valueAt<T>(indices[i]);
+          }
+        }
+        ++depth;
+        continue;
+      }
+      if (*instruction.op == FusedArithmeticOp::kNegate) {
+        auto* a = stack + (depth - 1) * kBlockSize;
+        for (auto i = 0; i < size; ++i) {
+          a[i] = -a[i];
+        }
+        continue;
+      }
+      auto* a = stack + (depth - 2) * kBlockSize;
+      const auto* b = a + kBlockSize;
+      switch (*instruction.op) {
+        case FusedArithmeticOp::kPlus:
+          for (auto i = 0; i < size; ++i) {
+            a[i] = a[i] + b[i];
+          }
+          break;
+        case FusedArithmeticOp::kMinus:
+          for (auto i = 0; i < size; ++i) {
+            a[i] = a[i] - b[i];
+          }
+          break;
+        case FusedArithmeticOp::kMultiply:
+          for (auto i = 0; i < size; ++i) {
+            a[i] = a[i] * b[i];
+          }
+          break;
+        case FusedArithmeticOp::kDivide:
+          divide(a, b, size);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+      --depth;
+    }
+    for (auto i = 0; i < size; ++i) {
+      rawResult[indices[i]] = stack[i];
+    }
+  };
+
+  int32_t numIndices = 0;
+  rows.applyToSelected([&](vector_size_t row) {
+    indices[numIndices++] = row;
+    if (numIndices == kBlockSize) {
+      runBlock(numIndices);
+      numIndices = 0;
+    }
+  });
+  if (numIndices > 0) {
+    runBlock(numIndices);
+  }
+}
+
+std::string FusedArithmeticExpr::print(
+    const std::function<std::string(const ExprPtr&)>& printInput,
+    bool quoteNames) const {
+  std::vector<std::string> stack;
+  for (const auto& instruction : program_) {
+    if (!instruction.op.has_value()) {
+      stack.push_back(printInput(inputs_[instruction.input]));
+      continue;
+    }
+    const auto numArgs = arity(*instruction.op);
+    std::stringstream out;
+    if (quoteNames) {
+      out << "\"" << instruction.name << "\"(";
+    } else {
+      out << instruction.name << "(";
+    }
+    for (auto i = stack.size() - numArgs; i < stack.size(); ++i) {
+      if (i > stack.size() - numArgs) {
+        out << ", ";
+      }
+      out << stack[i];
+    }
+    out << ")";
+    stack.resize(stack.size() - numArgs);
+    stack.push_back(out.str());
+  }
+  return stack.back();
+}
+
+std::string FusedArithmeticExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name();
+  }
+  return print([](const ExprPtr& input) { return input->toString(); }, false);
+}
+
+std::string FusedArithmeticExpr::toSql(
+    std::vector<VectorPtr>* complexConstants) const {
+  return print(
+      [&](const ExprPtr& input) { return input->toSql(complexConstants); },
+      true);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Floating point operations which can be fused into a FusedArithmeticExpr.
+enum class FusedArithmeticOp {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kNegate,
+};
+
+/// Declares that the scalar function 'name' computes 'op' with IEEE semantics
+/// for DOUBLE and REAL arguments, has default null behavior and never throws.
+/// Calls to such functions can be fused when
+/// QueryConfig::kExprFuseArithmetic is enabled.
+void registerFusedArithmeticFunction(
+    const std::string& name,
+    FusedArithmeticOp op);
+
+/// Returns the operation registered for function 'name', if any.
+std::optional<FusedArithmeticOp> fusedArithmeticFunction(
+    const std::string& name);
+
+/// Evaluates a tree of floating point arithmetic calls in one loop over the
+/// rows instead of materializing a vector for each call. The tree is kept as
+/// a postfix program over 'inputs_', which are the non-fusable leaves, e.g.
+/// field references, constants or other calls. The program runs over blocks
+/// of rows so that the intermediate values stay in cache.
+class FusedArithmeticExpr : public SpecialForm {
+ public:
+  struct Instruction {
+    /// Set for an operation, unset for loading 'inputs_[input]'.
+    std::optional<FusedArithmeticOp> op;
+    /// The input to load if 'op' is not set.
+    int32_t input{0};
+    /// The name of the fused function. Used for printing.
+    std::string name;
+  };
+
+  FusedArithmeticExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      std::vector<Instruction>&& program,
+      bool inputsSupportFlatNoNullsFastPath);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  const std::vector<Instruction>& program() const {
+    return program_;
+  }
+
+ private:
+  // Number of rows the program runs over at a time.
+  static constexpr int32_t kBlockSize = 256;
+
+  void computePropagatesNulls() override;
+
+  template <typename T>
+  void evalTyped(
+      const SelectivityVector& rows,
+      const std::vector<DecodedVector*>& decoded,
+      VectorPtr& result);
+
+  // Prints the program as nested calls, using 'printInput' for the inputs.
+  std::string print(
+      const std::function<std::string(const ExprPtr&)>& printInput,
+      bool quoteNames) const;
+
+  const std::vector<Instruction> program_;
+  // The maximum number of values on the stack of the program.
+  int32_t maxDepth_{0};
+  // Stack of 'maxDepth_' blocks of 'kBlockSize' values of the result type.
+  // Reused across batches.
+  std::vector<double> stack_;
+};
+
+} // namespace facebook::velox::exec
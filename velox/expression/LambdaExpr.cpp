@@ -51,7 +51,7 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       const BufferPtr& elementToTopLevelRows,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto row = createRowVector(context, wrapCapture, args, rows);
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(
         lambdaCtx.mutableThrowOnError(), context->throwOnError());
@@ -68,7 +68,7 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       EvalErrorsPtr& elementErrors,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto row = createRowVector(context, wrapCapture, args, rows);
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(lambdaCtx.mutableThrowOnError(), false);
     resetSharedExprs();
@@ -110,19 +110,51 @@ class ExprCallable : public Callable {
     }
   }
 
+  // Returns the captured 'values' for the elements in 'rows', where
+  // 'wrapCapture' maps each element to its top-level row. Avoids wrapping
+  // 'values' in a dictionary if all the elements map to the same top-level
+  // row or each element maps to the top-level row at the same position.
+  static VectorPtr wrapCaptureValues(
+      const BufferPtr& wrapCapture,
+      const SelectivityVector& rows,
+      const VectorPtr& values) {
+    const auto size = rows.end();
+    if (values->isConstantEncoding() || !rows.hasSelections()) {
+      return BaseVector::wrapInDictionary(
+          BufferPtr(nullptr), wrapCapture, size, values);
+    }
+    const auto* rawIndices = wrapCapture->as<vector_size_t>();
+    const auto first = rawIndices[rows.begin()];
+    bool isIdentity = true;
+    bool isSame = true;
+    rows.testSelected([&](vector_size_t row) {
+      isIdentity &= rawIndices[row] == row;
+      isSame &= rawIndices[row] == first;
+      return isIdentity || isSame;
+    });
+    if (isSame) {
+      return BaseVector::wrapInConstant(size, first, values);
+    }
+    if (isIdentity && values->size() >= size) {
+      return values;
+    }
+    return BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), wrapCapture, size, values);
+  }
+
   std::shared_ptr<RowVector> createRowVector(
       EvalCtx* context,
       const BufferPtr& wrapCapture,
       const std::vector<VectorPtr>& args,
-      vector_size_t size) {
+      const SelectivityVector& rows) {
     VELOX_CHECK_EQ(signature_->size(), args.size());
+    const auto size = rows.end();
     std::vector<VectorPtr> allVectors = args;
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
       if (wrapCapture) {
-        values = BaseVector::wrapInDictionary(
-            BufferPtr(nullptr), wrapCapture, size, values);
+        values = wrapCaptureValues(wrapCapture, rows, values);
       }
       allVectors.push_back(values);
     }
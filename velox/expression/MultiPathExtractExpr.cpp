@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/MultiPathExtractExpr.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::exec {
+namespace {
+folly::Synchronized<std::unordered_map<std::string, MultiPathExtractFunction>>&
+multiPathExtractFunctions() {
+  static folly::Synchronized<
+      std::unordered_map<std::string, MultiPathExtractFunction>>
+      functions;
+  return functions;
+}
+} // namespace
+
+void registerMultiPathExtractFunction(
+    const std::string& name,
+    MultiPathExtractFunction function) {
+  VELOX_CHECK_NOT_NULL(function.isValidPath);
+  VELOX_CHECK_NOT_NULL(function.makeExtractor);
+  multiPathExtractFunctions().wlock()->insert_or_assign(
+      name, std::move(function));
+}
+
+std::optional<MultiPathExtractFunction> multiPathExtractFunction(
+    const std::string& name) {
+  auto functions = multiPathExtractFunctions().rlock();
+  auto it = functions->find(name);
+  if (it == functions->end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+int32_t MultiPathExtractGroup::addPath(const std::string& path) {
+  VELOX_CHECK_NULL(extractor_, "Cannot add a path after evaluation");
+  auto it = std::find(paths_.begin(), paths_.end(), path);
+  if (it != paths_.end()) {
+    return it - paths_.begin();
+  }
+  paths_.push_back(path);
+  return paths_.size() - 1;
+}
+
+void MultiPathExtractGroup::evaluate(
+    int32_t index,
+    const SelectivityVector& rows,
+    const VectorPtr& documents,
+    EvalCtx& context,
+    VectorPtr& result) {
+  VELOX_CHECK_LT(index, paths_.size());
+  // Extracts all the paths again if these are other documents, or rows
+  // which were not extracted, or if the result was already taken, e.g. by
+  // an evaluation of the same call on other rows.
+  if (documents != documents_ || results_[index] == nullptr ||
+      !rows.isSubset(rows_)) {
+    if (extractor_ == nullptr) {
+      extractor_ = function_.makeExtractor(paths_);
+    }
+    results_.assign(paths_.size(), nullptr);
+    LocalDecodedVector decoded(context, *documents, rows);
+    extractor_->extract(rows, *decoded.get(), context, results_);
+    documents_ = documents;
+    rows_ = rows;
+    numResults_ = paths_.size();
+  }
+
+  context.moveOrCopyResult(results_[index], rows, result);
+  results_[index] = nullptr;
+  if (--numResults_ == 0) {
+    documents_ = nullptr;
+  }
+}
+
+MultiPathExtractExpr::MultiPathExtractExpr(
+    TypePtr type,
+    ExprPtr document,
+    ExprPtr path,
+    std::string name,
+    std::shared_ptr<MultiPathExtractGroup> group,
+    int32_t pathIndex)
+    : SpecialForm(
+          std::move(type),
+          {std::move(document)},
+          std::move(name),
+          false /* supportsFlatNoNullsFastPath */,
+          false /* trackCpuUsage */),
+      pathExpr_(std::move(path)),
+      group_(std::move(group)),
+      pathIndex_(pathIndex) {
+  VELOX_CHECK_NOT_NULL(group_);
+  VELOX_CHECK_LT(pathIndex_, group_->numPaths());
+}
+
+void MultiPathExtractExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  VectorPtr documents;
+  inputs_[0]->eval(rows, context, documents);
+  if (context.errors()) {
+    LocalSelectivityVector remainingRows(context, rows);
+    context.deselectErrors(*remainingRows);
+    if (remainingRows->hasSelections()) {
+      group_->evaluate(pathIndex_, *remainingRows, documents, context, result);
+    }
+    return;
+  }
+  group_->evaluate(pathIndex_, rows, documents, context, result);
+}
+
+std::string MultiPathExtractExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name();
+  }
+  return fmt::format(
+      "{}({}, {})", name(), inputs_[0]->toString(), pathExpr_->toString());
+}
+
+std::string MultiPathExtractExpr::toSql(
+    std::vector<VectorPtr>* complexConstants) const {
+  return fmt::format(
+      "\"{}\"({}, {})",
+      name(),
+      inputs_[0]->toSql(complexConstants),
+      pathExpr_->toSql(complexConstants));
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Extracts the values at several paths from each document of a batch, so
+/// that each document is parsed once for all the paths.
+class MultiPathExtractor {
+ public:
+  virtual ~MultiPathExtractor() = default;
+
+  /// Sets 'results[i]' to a VARCHAR vector with the values at the i-th path
+  /// of 'documents' for 'rows'. The result is null for null documents and
+  /// for documents without a value at the path. Must not throw for
+  /// individual documents.
+  virtual void extract(
+      const SelectivityVector& rows,
+      const DecodedVector& documents,
+      EvalCtx& context,
+      std::vector<VectorPtr>& results) = 0;
+};
+
+/// Describes a VARCHAR function f(document, path) with default null behavior
+/// which can be evaluated for several constant paths at once.
+struct MultiPathExtractFunction {
+  /// Returns true if 'path' can be extracted. Calls with other paths are
+  /// evaluated by the function itself.
+  std::function<bool(const std::string& path)> isValidPath;
+
+  /// Makes an extractor for 'paths'. All of them are valid.
+  std::function<std::unique_ptr<MultiPathExtractor>(
+      const std::vector<std::string>& paths)>
+      makeExtractor;
+};
+
+/// Declares that calls to the scalar function 'name' with the same document
+/// and different constant paths can be evaluated together when
+/// QueryConfig::kExprMultiPathExtract is enabled.
+void registerMultiPathExtractFunction(
+    const std::string& name,
+    MultiPathExtractFunction function);
+
+/// Returns the function registered for 'name', if any.
+std::optional<MultiPathExtractFunction> multiPathExtractFunction(
+    const std::string& name);
+
+/// The calls of one function over the same document in an ExprSet. Extracts
+/// all the paths of the group when the first of them is evaluated and keeps
+/// the results until the other calls take them.
+class MultiPathExtractGroup {
+ public:
+  explicit MultiPathExtractGroup(MultiPathExtractFunction function)
+      : function_(std::move(function)) {}
+
+  /// Adds 'path' to the group and returns its index. Must be called before
+  /// the first evaluation.
+  int32_t addPath(const std::string& path);
+
+  const std::string& path(int32_t index) const {
+    return paths_[index];
+  }
+
+  int32_t numPaths() const {
+    return paths_.size();
+  }
+
+  /// Sets 'result' to the values at path 'index' of 'documents' for 'rows'.
+  void evaluate(
+      int32_t index,
+      const SelectivityVector& rows,
+      const VectorPtr& documents,
+      EvalCtx& context,
+      VectorPtr& result);
+
+ private:
+  const MultiPathExtractFunction function_;
+  std::vector<std::string> paths_;
+  std::unique_ptr<MultiPathExtractor> extractor_;
+
+  // The documents and rows 'results_' were extracted from. 'documents_' is
+  // kept referenced so that it cannot be reused for another batch.
+  VectorPtr documents_;
+  SelectivityVector rows_;
+  // Corresponds 1:1 to 'paths_'. Null for the results taken by evaluate().
+  std::vector<VectorPtr> results_;
+  int32_t numResults_{0};
+};
+
+/// A call f(document, 'path') of a function registered with
+/// registerMultiPathExtractFunction(). The only input is the document. The
+/// calls over the same document share a MultiPathExtractGroup. 'path' is the
+/// constant path expression, which is kept for printing.
+class MultiPathExtractExpr : public SpecialForm {
+ public:
+  MultiPathExtractExpr(
+      TypePtr type,
+      ExprPtr document,
+      ExprPtr path,
+      std::string name,
+      std::shared_ptr<MultiPathExtractGroup> group,
+      int32_t pathIndex);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  const std::string& path() const {
+    return group_->path(pathIndex_);
+  }
+
+  const MultiPathExtractGroup& group() const {
+    return *group_;
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = inputs_[0]->propagatesNulls();
+  }
+
+  const ExprPtr pathExpr_;
+  const std::shared_ptr<MultiPathExtractGroup> group_;
+  const int32_t pathIndex_;
+};
+
+} // namespace facebook::velox::exec
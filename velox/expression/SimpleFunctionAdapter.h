@@ -91,6 +91,27 @@ class SimpleFunctionAdapter : public VectorFunction {
       SimpleTypeTrait<arg_at<POSITION>>::typeKind != TypeKind::BOOLEAN &&
       !providesCustomComparison<arg_at<POSITION>>::value;
 
+  // Whether callBatch() can run over the raw values of flat vectors, i.e. the
+  // UDF provides it and the result and all the arguments have fixed-width
+  // primitive types other than boolean.
+  template <size_t... Is>
+  static constexpr bool isBatchCallEligibleImpl(std::index_sequence<Is...>) {
+    return (
+        (isArgFlatConstantFastPathEligible<Is> &&
+         SimpleTypeTrait<arg_at<Is>>::isFixedWidth) &&
+        ...);
+  }
+
+  static constexpr bool isBatchCallEligible() {
+    if constexpr (
+        FUNC::udf_has_callBatch && fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN) {
+      return isBatchCallEligibleImpl(
+          std::make_index_sequence<FUNC::num_args>());
+    }
+    return false;
+  }
+
   constexpr int32_t reuseStringsFromArgValue() const {
     return udf_reuse_strings_from_arg<typename FUNC::udf_struct_t>();
   }
@@ -369,6 +390,20 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (isBatchCallEligible()) {
+      if (canCallBatch(rows, args)) {
+        callBatch(
+            rows,
+            args,
+            applyContext.result,
+            std::make_index_sequence<FUNC::num_args>());
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -414,6 +449,36 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // Returns true if 'rows' is a contiguous range and all 'args' are flat
+  // without nulls.
+  static bool canCallBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (rows.countSelected() != rows.end() - rows.begin()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <size_t... Is>
+  void callBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      result_vector_t* result,
+      std::index_sequence<Is...>) const {
+    const auto begin = rows.begin();
+    fn_->callBatch(
+        result->mutableRawValues() + begin,
+        args[Is]->asUnchecked<FlatVector<exec_arg_at<Is>>>()->rawValues() +
+            begin...,
+        rows.end() - begin);
+  }
+
   // All string vectors within `vector` will acquire shared ownership of all
   // string buffers found within source.
   void tryAcquireStringBuffer(BaseVector* vector, const BaseVector* source)
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/expression/SwitchExpr.h"
+
+#include <numeric>
+#include <optional>
+
 #include "velox/expression/BooleanMix.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/FieldReference.h"
@@ -25,12 +29,73 @@ namespace {
 bool hasElseClause(const std::vector<ExprPtr>& inputs) {
   return inputs.size() % 2 == 1;
 }
+
+bool isEq(const std::string& name) {
+  // Functions may be registered with a prefix, e.g. presto.default.eq.
+  const auto pos = name.rfind('.');
+  return (pos == std::string::npos ? name : name.substr(pos + 1)) == "eq";
+}
+
+// Returns the field and constant compared by 'condition' if it is of the form
+// 'field = constant' with a non-null constant.
+std::optional<std::pair<const FieldReference*, const ConstantExpr*>>
+fieldEqualsConstant(const Expr& condition) {
+  if (condition.isSpecialForm() || !isEq(condition.name()) ||
+      condition.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto* left = condition.inputs()[0].get();
+  const auto* right = condition.inputs()[1].get();
+  if (left->is<ConstantExpr>()) {
+    std::swap(left, right);
+  }
+  if (!left->is<FieldReference>() || !left->inputs().empty() ||
+      !right->is<ConstantExpr>()) {
+    return std::nullopt;
+  }
+  const auto* constant = right->as<ConstantExpr>();
+  if (constant->value() == nullptr || constant->value()->isNullAt(0)) {
+    return std::nullopt;
+  }
+  return std::make_pair(left->as<FieldReference>(), constant);
+}
 } // namespace
 
+// static
+bool SwitchExpr::hasExclusiveCases(const std::vector<ExprPtr>& inputs) {
+  const auto numCases = inputs.size() / 2;
+  if (numCases < 2) {
+    return false;
+  }
+  std::vector<const ConstantExpr*> constants;
+  const FieldReference* field = nullptr;
+  for (auto i = 0; i < numCases; ++i) {
+    const auto comparison = fieldEqualsConstant(*inputs[2 * i]);
+    if (!comparison.has_value()) {
+      return false;
+    }
+    if (field == nullptr) {
+      field = comparison->first;
+    } else if (field->field() != comparison->first->field()) {
+      return false;
+    }
+    const auto* value = comparison->second->value().get();
+    for (const auto* other : constants) {
+      if (!value->type()->equivalent(*other->value()->type()) ||
+          value->equalValueAt(other->value().get(), 0, 0)) {
+        return false;
+      }
+    }
+    constants.push_back(comparison->second);
+  }
+  return true;
+}
+
 SwitchExpr::SwitchExpr(
     TypePtr type,
     const std::vector<ExprPtr>& inputs,
-    bool inputsSupportFlatNoNullsFastPath)
+    bool inputsSupportFlatNoNullsFastPath,
+    bool exclusiveCases)
     : SpecialForm(
           std::move(type),
           inputs,
@@ -38,7 +103,14 @@ SwitchExpr::SwitchExpr(
           hasElseClause(inputs) && inputsSupportFlatNoNullsFastPath,
           false /* trackCpuUsage */),
       numCases_{inputs_.size() / 2},
-      hasElseClause_{hasElseClause(inputs_)} {
+      hasElseClause_{hasElseClause(inputs_)},
+      exclusiveCases_{exclusiveCases} {
+  caseOrder_.resize(numCases_);
+  std::iota(caseOrder_.begin(), caseOrder_.end(), 0);
+  if (exclusiveCases_) {
+    caseSelectivity_.resize(numCases_);
+  }
+  stats_.numCaseMatches.resize(numCases_);
   std::vector<TypePtr> inputTypes;
   inputTypes.reserve(inputs_.size());
   std::transform(
@@ -87,13 +159,22 @@ void SwitchExpr::evalSpecialForm(
   VectorPtr condition;
   const uint64_t* values;
 
-  for (auto i = 0; i < numCases_; i++) {
+  for (auto n = 0; n < numCases_; n++) {
+    const auto i = caseOrder_[n];
     context.releaseVector(condition);
 
     if (!remainingRows.get()->hasSelections()) {
       break;
     }
 
+    // Time the condition to order exclusive cases by cost per matched row.
+    std::optional<SelectivityTimer> timer;
+    vector_size_t numRemaining = 0;
+    if (exclusiveCases_) {
+      numRemaining = remainingRows->countSelected();
+      timer.emplace(caseSelectivity_[i], numRemaining);
+    }
+
     // evaluate the case condition
     inputs_[2 * i]->eval(*remainingRows.get(), context, condition);
 
@@ -113,14 +194,17 @@ void SwitchExpr::evalSpecialForm(
         true,
         &values,
         nullptr);
+    timer.reset();
+    vector_size_t numMatched = 0;
     switch (booleanMix) {
       case BooleanMix::kAllTrue:
+        numMatched = remainingRows->countSelected();
         inputs_[2 * i + 1]->eval(*remainingRows.get(), context, localResult);
         remainingRows->clearAll();
-        continue;
+        break;
       case BooleanMix::kAllNull:
       case BooleanMix::kAllFalse:
-        continue;
+        break;
       default: {
         thenRows.get(remainingRows->end(), false);
         bits::andBits(
@@ -132,11 +216,16 @@ void SwitchExpr::evalSpecialForm(
         thenRows.get()->updateBounds();
 
         if (thenRows.get()->hasSelections()) {
+          numMatched = thenRows.get()->countSelected();
           inputs_[2 * i + 1]->eval(*thenRows.get(), context, localResult);
           remainingRows.get()->deselect(*thenRows.get());
         }
       }
     }
+    stats_.numCaseMatches[i] += numMatched;
+    if (exclusiveCases_) {
+      caseSelectivity_[i].addOutput(std::max(0, numRemaining - numMatched));
+    }
   }
 
   // Evaluate the "else" clause.
@@ -169,6 +258,39 @@ void SwitchExpr::evalSpecialForm(
   }
 
   context.moveOrCopyResult(localResult, rows, finalResult);
+
+  if (exclusiveCases_) {
+    if (!reorderEnabledChecked_) {
+      reorderEnabled_ = context.execCtx()
+                            ->queryCtx()
+                            ->queryConfig()
+                            .adaptiveFilterReorderingEnabled();
+      reorderEnabledChecked_ = true;
+    }
+    if (reorderEnabled_) {
+      maybeReorderCases();
+    }
+  }
+}
+
+void SwitchExpr::maybeReorderCases() {
+  bool reorder = false;
+  for (auto i = 1; i < numCases_; ++i) {
+    if (caseSelectivity_[caseOrder_[i - 1]].timeToDropValue() >
+        caseSelectivity_[caseOrder_[i]].timeToDropValue()) {
+      reorder = true;
+      break;
+    }
+  }
+  if (reorder) {
+    std::stable_sort(
+        caseOrder_.begin(),
+        caseOrder_.end(),
+        [this](int32_t left, int32_t right) {
+          return caseSelectivity_[left].timeToDropValue() <
+              caseSelectivity_[right].timeToDropValue();
+        });
+  }
 }
 
 // This is safe to call only after all metadata is computed for input
@@ -278,8 +400,12 @@ ExprPtr SwitchCallToSpecialForm::constructSpecialForm(
     const core::QueryConfig& /*config*/) {
   bool inputsSupportFlatNoNullsFastPath =
       Expr::allSupportFlatNoNullsFastPath(compiledChildren);
+  const bool exclusiveCases = SwitchExpr::hasExclusiveCases(compiledChildren);
   return std::make_shared<SwitchExpr>(
-      type, std::move(compiledChildren), inputsSupportFlatNoNullsFastPath);
+      type,
+      std::move(compiledChildren),
+      inputsSupportFlatNoNullsFastPath,
+      exclusiveCases);
 }
 
 TypePtr IfCallToSpecialForm::resolveType(const std::vector<TypePtr>& argTypes) {
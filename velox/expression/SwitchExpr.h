@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/SelectivityInfo.h"
 #include "velox/expression/FunctionCallToSpecialForm.h"
 #include "velox/expression/SpecialForm.h"
 
@@ -34,14 +35,36 @@ namespace facebook::velox::exec {
 ///
 /// IF expression can be represented as a CASE expression with a single
 /// condition.
+///
+/// If at most one condition can be true for any row, e.g. all conditions
+/// compare the same field with distinct constants, the order of evaluation
+/// does not matter. The conditions are then evaluated in the order of their
+/// observed cost per matched row when adaptive filter reordering is enabled.
 class SwitchExpr : public SpecialForm {
  public:
   /// Inputs are concatenated conditions and results with an optional "else" at
   /// the end, e.g. {condition1, result1, condition2, result2,..else}
+  /// 'exclusiveCases' is true if at most one condition can be true for any
+  /// row.
   SwitchExpr(
       TypePtr type,
       const std::vector<ExprPtr>& inputs,
-      bool inputsSupportFlatNoNullsFastPath);
+      bool inputsSupportFlatNoNullsFastPath,
+      bool exclusiveCases = false);
+
+  /// Returns true if the conditions in 'inputs' can not be true for the same
+  /// row. Detects conditions of the form 'field = constant' over the same
+  /// field with distinct non-null constants.
+  static bool hasExclusiveCases(const std::vector<ExprPtr>& inputs);
+
+  bool exclusiveCases() const {
+    return exclusiveCases_;
+  }
+
+  /// Returns the 0-based position of the case evaluated at 'index'.
+  int32_t caseOrderAt(int32_t index) const {
+    return caseOrder_[index];
+  }
 
   void evalSpecialForm(
       const SelectivityVector& rows,
@@ -62,10 +85,25 @@ class SwitchExpr : public SpecialForm {
 
   void computePropagatesNulls() override;
 
+  // Sorts 'caseOrder_' by the time per row matched by each condition.
+  void maybeReorderCases();
+
   const size_t numCases_;
   const bool hasElseClause_;
+  const bool exclusiveCases_;
   BufferPtr tempValues_;
 
+  // The order in which the cases are evaluated. Changes only if
+  // 'exclusiveCases_' is true.
+  std::vector<int32_t> caseOrder_;
+
+  // The time spent in each condition and the rows it was evaluated on and did
+  // not match. Only maintained if 'exclusiveCases_' is true.
+  std::vector<SelectivityInfo> caseSelectivity_;
+
+  bool reorderEnabledChecked_{false};
+  bool reorderEnabled_{false};
+
   friend class SwitchCallToSpecialForm;
 };
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Benchmarks lambda functions with captures over many small arrays, where the
+// per-element handling of the captures dominates. 'oneElement' has one
+// element per array, so the captures are passed as is. 'oneRow' has all the
+// elements in one array, so the captures are passed as constants. 'many'
+// wraps the captures in a dictionary over the elements.
+
+using namespace facebook::velox;
+
+namespace {
+class LambdaBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  LambdaBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerAllScalarFunctions();
+  }
+
+  RowVectorPtr makeData(vector_size_t numRows, vector_size_t arraySize) {
+    return vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(numRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<int64_t>(
+            numRows, [](auto row) { return row % 7; }),
+        vectorMaker_.arrayVector<int64_t>(
+            numRows,
+            [&](auto /*row*/) { return arraySize; },
+            [](auto index) { return index; }),
+    });
+  }
+
+  size_t run(
+      const std::string& expression,
+      vector_size_t numRows,
+      vector_size_t arraySize) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(numRows, arraySize);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data)->size();
+    }
+    return count;
+  }
+};
+
+const std::string kTransform = "transform(c2, x -> x * c0 + c1)";
+const std::string kFilter = "filter(c2, x -> x > c0)";
+
+BENCHMARK_MULTI(transformOneElement) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kTransform, 10'000, 1);
+}
+
+BENCHMARK_MULTI(transformOneRow) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kTransform, 1, 10'000);
+}
+
+BENCHMARK_MULTI(transformMany) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kTransform, 1'000, 10);
+}
+
+BENCHMARK_MULTI(filterOneElement) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kFilter, 10'000, 1);
+}
+
+BENCHMARK_MULTI(filterOneRow) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kFilter, 1, 10'000);
+}
+
+BENCHMARK_MULTI(filterMany) {
+  LambdaBenchmark benchmark;
+  return benchmark.run(kFilter, 1'000, 10);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+
+  folly::runBenchmarks();
+  return 0;
+}
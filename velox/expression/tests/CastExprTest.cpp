@@ -1139,6 +1139,60 @@ TEST_F(CastExprTest, primitiveValidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, stringToNumberInPlainNotation) {
+  // Mixes strings parsed in the batch loop with strings which fall back to the
+  // per-row conversion.
+  testCast<std::string, int8_t>(
+      "tinyint",
+      {"0", "-0", "127", "-128", "007", "+1", " 12 ", std::nullopt},
+      {0, 0, 127, -128, 7, 1, 12, std::nullopt});
+  testCast<std::string, int32_t>(
+      "integer",
+      {"2147483647", "-2147483648", "12345678", "-123456789", "1"},
+      {std::numeric_limits<int32_t>::max(),
+       std::numeric_limits<int32_t>::min(),
+       12345678,
+       -123456789,
+       1});
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"9223372036854775807",
+       "-9223372036854775808",
+       "1234567890123456789",
+       "0000000000000000001"},
+      {std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       1234567890123456789,
+       1});
+  testInvalidCast<std::string>(
+      "tinyint", {"128"}, "Overflow during conversion");
+  testInvalidCast<std::string>(
+      "tinyint", {"-129"}, "Negative overflow during conversion");
+  testInvalidCast<std::string>(
+      "bigint", {"99999999999999999999"}, "Overflow during conversion");
+  testInvalidCast<std::string>(
+      "integer",
+      {"12a"},
+      "Non-whitespace character found after end of conversion");
+
+  testCast<std::string, double>(
+      "double",
+      {"0.1",
+       "-0",
+       "123.456",
+       "-98765.4321",
+       "123456789012345",
+       "1234567890.12345678",
+       "1e3",
+       "  7.5 "},
+      {0.1, -0.0, 123.456, -98765.4321, 123456789012345, 1234567890.12345678,
+       1000, 7.5});
+  testCast<std::string, float>(
+      "real",
+      {"0.1", "-1.5", "1234567", "3.4028235", "2.5e1"},
+      {0.1f, -1.5f, 1234567, 3.4028235f, 25});
+}
+
 TEST_F(CastExprTest, truncateVsRound) {
   // Testing round cast from double to int.
   testCast<double, int>(
@@ -153,6 +153,7 @@ TEST_F(ExprStatsTest, printWithStats) {
 struct Event {
   std::string uuid;
   std::unordered_map<std::string, exec::ExprStats> stats;
+  std::vector<exec::ExprStatsTreeNode> statsTrees;
   std::vector<std::string> sqls;
 };
 
@@ -164,7 +165,7 @@ class TestListener : public exec::ExprSetListener {
   void onCompletion(
       const std::string& uuid,
       const exec::ExprSetCompletionEvent& event) override {
-    events_.push_back({uuid, event.stats, event.sqls});
+    events_.push_back({uuid, event.stats, event.statsTrees, event.sqls});
   }
 
   void onError(vector_size_t numRows, const std::string& /*queryId*/) override {
@@ -285,6 +286,88 @@ TEST_F(ExprStatsTest, listener) {
   ASSERT_EQ(3, events.size());
 }
 
+TEST_F(ExprStatsTest, statsTrees) {
+  vector_size_t size = 1'024;
+
+  std::vector<Event> events;
+  auto listener = std::make_shared<TestListener>(events);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  // Time every other vector instead of all of them.
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprTrackCpuUsage, "false"},
+      {core::QueryConfig::kExprCpuSamplingRate, "2"},
+  });
+
+  // Makes new dictionary vectors for each batch so that the results are not
+  // memoized across batches.
+  auto makeData = [&]() {
+    auto indices = makeIndicesInReverse(size);
+    return makeRowVector({
+        wrapInDictionary(
+            indices,
+            makeFlatVector<int32_t>(size, [](auto row) { return row; })),
+        wrapInDictionary(
+            indices,
+            makeFlatVector<int32_t>(size, [](auto row) { return row % 7; })),
+    });
+  };
+
+  auto rowType = asRowType(makeData()->type());
+  {
+    auto exprSet =
+        compileExpressions({"(c0 + c1) * c1", "(c0 + c1) % 5"}, rowType);
+    for (auto i = 0; i < 3; ++i) {
+      evaluate(*exprSet, makeData());
+    }
+  }
+  ASSERT_EQ(1, events.size());
+  const auto& trees = events.back().statsTrees;
+  ASSERT_EQ(2, trees.size());
+
+  // Returns the first node named 'name' in 'node' in pre-order.
+  std::function<const exec::ExprStatsTreeNode*(
+      const exec::ExprStatsTreeNode&, const std::string&)>
+      find = [&](const auto& node, const auto& name) {
+        if (node.name == name) {
+          return &node;
+        }
+        for (const auto& input : node.inputs) {
+          if (auto* found = find(input, name)) {
+            return found;
+          }
+        }
+        return (const exec::ExprStatsTreeNode*)nullptr;
+      };
+
+  const auto& multiply = trees[0];
+  ASSERT_EQ("multiply", multiply.name);
+  ASSERT_FALSE(multiply.isRepeated);
+  ASSERT_EQ(3, multiply.stats.numProcessedVectors);
+  ASSERT_EQ(1024 * 3, multiply.stats.numProcessedRows);
+  // The dictionary encoding of the inputs is peeled off.
+  ASSERT_EQ(3, multiply.stats.numPeeledVectors);
+  // The first and third vectors are timed.
+  ASSERT_EQ(2, multiply.stats.sampledTiming.count);
+  ASSERT_EQ(0, multiply.stats.timing.count);
+
+  auto* plus = find(multiply, "plus");
+  ASSERT_NE(plus, nullptr);
+  ASSERT_FALSE(plus->isRepeated);
+  ASSERT_GE(plus->stats.numProcessedVectors, 3);
+  ASSERT_GE(plus->stats.sampledTiming.count, 2);
+
+  // The common sub-expression is reported at its first occurrence only.
+  ASSERT_EQ("mod", trees[1].name);
+  plus = find(trees[1], "plus");
+  ASSERT_NE(plus, nullptr);
+  ASSERT_TRUE(plus->isRepeated);
+  ASSERT_EQ(0, plus->stats.numProcessedVectors);
+  ASSERT_TRUE(plus->inputs.empty());
+
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+}
+
 TEST_F(ExprStatsTest, specialForms) {
   vector_size_t size = 1'024;
 
@@ -345,6 +428,40 @@ TEST_F(ExprStatsTest, specialForms) {
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
 
+TEST_F(ExprStatsTest, stringBytesWritten) {
+  std::vector<Event> events;
+  auto listener = std::make_shared<TestListener>(events);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      1'024,
+      [](auto row) {
+        return fmt::format("a string, which is not inlined, {}", row);
+      })});
+
+  auto stringBytesWritten = [&](const std::string& expression,
+                                const std::string& name) {
+    events.clear();
+    evaluate(expression, data);
+    VELOX_CHECK_EQ(1, events.size());
+    return events.back().stats.at(name).numStringBytesWritten;
+  };
+
+  // The results reference the strings of the input.
+  EXPECT_EQ(0, stringBytesWritten("substr(c0, 3)", "substr"));
+  EXPECT_EQ(0, stringBytesWritten("split_part(c0, ',', 2)", "split_part"));
+  EXPECT_EQ(0, stringBytesWritten("split(c0, ',')", "split"));
+  EXPECT_EQ(
+      0,
+      stringBytesWritten(
+          "regexp_extract_all(c0, '[a-z]+ [a-z]+')", "regexp_extract_all"));
+
+  // The results are new strings.
+  EXPECT_GT(stringBytesWritten("upper(c0)", "upper"), 1'024 * 30);
+
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+}
+
 TEST_F(ExprStatsTest, errorLog) {
   // Register a listener to log exceptions.
   std::vector<Event> events;
@@ -2159,6 +2159,93 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK_EQ(base.use_count(), 1);
 }
 
+TEST_F(ExprTest, memoSameBuffers) {
+  // Verify that the results cached for a base vector are reused for a
+  // different base vector over the same buffers.
+  auto base = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto newBase = [&]() {
+    return std::make_shared<FlatVector<int64_t>>(
+        pool(),
+        BIGINT(),
+        base->nulls(),
+        base->size(),
+        base->values(),
+        std::vector<BufferPtr>{});
+  };
+
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+  auto exprSet = compileExpression("c0 + 1", ROW({"c0"}, {BIGINT()}));
+  auto expectedResult =
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 3 + 1; });
+
+  auto [result, stats] = evaluateWithStats(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(indices, 100, newBase())}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["plus"].numProcessedRows, 100);
+
+  // After this results would be cached.
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(indices, 100, newBase())}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["plus"].numProcessedRows, 200);
+
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(indices, 100, newBase())}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["plus"].numProcessedRows, 200);
+
+  // Different values buffer.
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(
+          indices,
+          100,
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row; }))}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["plus"].numProcessedRows, 300);
+}
+
+TEST_F(ExprTest, switchExclusiveCases) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 10 == 0 ? 1 : 3; }),
+  });
+  auto exprSet = compileExpression(
+      "case when c0 = 1 then 10 when c0 = 2 then 20 when 3 = c0 then 30 "
+      "else 0 end",
+      asRowType(data->type()));
+  auto* switchExpr = exprSet->expr(0)->as<exec::SwitchExpr>();
+  ASSERT_NE(switchExpr, nullptr);
+  ASSERT_TRUE(switchExpr->exclusiveCases());
+  ASSERT_EQ(switchExpr->caseOrderAt(0), 0);
+
+  auto expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 10 == 0 ? 10 : 30; });
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto [result, stats] = evaluateWithStats(exprSet.get(), data);
+    assertEqualVectors(expected, result);
+    ASSERT_EQ(
+        stats["switch"].numCaseMatches,
+        (std::vector<uint64_t>{100 * (i + 1), 0, 900 * (i + 1)}));
+  }
+  // The most frequently matched case is evaluated first.
+  ASSERT_EQ(switchExpr->caseOrderAt(0), 2);
+
+  auto notExclusive = [&](const std::string& expression) {
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    return !exprSet->expr(0)->as<exec::SwitchExpr>()->exclusiveCases();
+  };
+  EXPECT_TRUE(notExclusive(
+      "case when c0 = 1 then 10 when c0 > 2 then 20 else 0 end"));
+  EXPECT_TRUE(notExclusive(
+      "case when c0 = 1 then 10 when c0 = 1 then 20 else 0 end"));
+  EXPECT_TRUE(notExclusive("case when c0 = 1 then 10 else 0 end"));
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
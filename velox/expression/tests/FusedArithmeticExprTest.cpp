@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/expression/FusedArithmeticExpr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+class FusedArithmeticExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFuseArithmetic(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFuseArithmetic, enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without fusion and checks that the
+  // results are the same.
+  void testFused(const std::string& expression, const RowVectorPtr& data) {
+    const auto rowType = asRowType(data->type());
+    setFuseArithmetic(false);
+    auto expected = evaluate(*compileExpression(expression, rowType), data);
+
+    setFuseArithmetic(true);
+    auto exprSet = compileExpression(expression, rowType);
+    ASSERT_TRUE(exprSet->expr(0)->is<exec::FusedArithmeticExpr>())
+        << exprSet->expr(0)->toString();
+    assertEqualVectors(expected, evaluate(*exprSet, data));
+
+    // Only a subset of the rows.
+    SelectivityVector rows(data->size());
+    for (auto i = 0; i < data->size(); i += 3) {
+      rows.setValid(i, false);
+    }
+    rows.updateBounds();
+    auto result = evaluate(*exprSet, data, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(expected->equalValueAt(result.get(), row, row))
+          << "at " << row;
+    });
+  }
+};
+
+TEST_F(FusedArithmeticExprTest, basic) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(
+          size, [](auto row) { return row % 7 - 3; }, nullEvery(11)),
+      makeFlatVector<double>(size, [](auto row) { return row % 5 + 1; }),
+      makeFlatVector<float>(size, [](auto row) { return row * 0.25; }),
+      makeFlatVector<float>(
+          size, [](auto row) { return row % 3 + 1; }, nullEvery(13)),
+  });
+
+  testFused("c0 * c1 + c2", data);
+  testFused("(c0 - c1) * (c1 + c2) / c2", data);
+  testFused("-(c0 * c0) + c1", data);
+  testFused("c0 * cast(2 as double) - c2", data);
+  testFused("c0 * c1 + cos(c2)", data);
+  testFused("c3 * c4 - c3 / c4", data);
+}
+
+TEST_F(FusedArithmeticExprTest, encodings) {
+  const vector_size_t size = 1'000;
+  auto indices = makeIndicesInReverse(size);
+  auto data = makeRowVector({
+      wrapInDictionary(
+          indices,
+          makeFlatVector<double>(
+              size, [](auto row) { return row; }, nullEvery(7))),
+      makeConstant(1.5, size),
+      makeNullConstant(TypeKind::DOUBLE, size),
+  });
+
+  testFused("c0 * c1 + c0", data);
+  testFused("c0 * c2 + c1", data);
+}
+
+TEST_F(FusedArithmeticExprTest, notFused) {
+  auto data = makeRowVector({
+      makeFlatVector<double>({1, 2, 3}),
+      makeFlatVector<int64_t>({1, 2, 3}),
+  });
+  const auto rowType = asRowType(data->type());
+
+  setFuseArithmetic(true);
+  // A single call.
+  EXPECT_FALSE(compileExpression("c0 + c0", rowType)
+                   ->expr(0)
+                   ->is<exec::FusedArithmeticExpr>());
+  // Not floating point.
+  EXPECT_FALSE(compileExpression("c1 * c1 + c1", rowType)
+                   ->expr(0)
+                   ->is<exec::FusedArithmeticExpr>());
+
+  setFuseArithmetic(false);
+  EXPECT_FALSE(compileExpression("c0 * c0 + c0", rowType)
+                   ->expr(0)
+                   ->is<exec::FusedArithmeticExpr>());
+}
+
+TEST_F(FusedArithmeticExprTest, toString) {
+  auto data = makeRowVector({
+      makeFlatVector<double>({1, 2, 3}),
+      makeFlatVector<double>({4, 5, 6}),
+  });
+  setFuseArithmetic(true);
+  auto exprSet =
+      compileExpression("(c0 - c1) * c0 + c1", asRowType(data->type()));
+  ASSERT_TRUE(exprSet->expr(0)->is<exec::FusedArithmeticExpr>());
+  EXPECT_EQ(
+      exprSet->expr(0)->toString(), "plus(multiply(minus(c0, c1), c0), c1)");
+  EXPECT_EQ(
+      exprSet->expr(0)->toSql(),
+      "\"plus\"(\"multiply\"(\"minus\"(\"c0\", \"c1\"), \"c0\"), \"c1\")");
+}
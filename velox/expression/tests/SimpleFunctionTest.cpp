@@ -1655,4 +1655,77 @@ TEST_F(SimpleFunctionTest, toDebugString) {
       "Priority: 999997\nDefaultNullBehavior: true");
 }
 
+// The number of rows computed by call() and callBatch() of BatchPlusFunction.
+int64_t numCallRows = 0;
+int64_t numBatchRows = 0;
+
+template <typename TExec>
+struct BatchPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(int64_t& result, const int64_t& a, const int64_t& b) {
+    ++numCallRows;
+    result = a + b;
+  }
+
+  void callBatch(
+      int64_t* result,
+      const int64_t* a,
+      const int64_t* b,
+      int32_t size) {
+    numBatchRows += size;
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] + b[i];
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int64_t>(
+      {"batch_plus"});
+
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 10; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 10; }, nullEvery(7)),
+  });
+
+  auto test = [&](const std::string& expression,
+                  const VectorPtr& expected,
+                  int64_t expectedBatchRows) {
+    numCallRows = 0;
+    numBatchRows = 0;
+    auto result = evaluate(expression, data);
+    assertEqualVectors(expected, result);
+    EXPECT_EQ(numBatchRows, expectedBatchRows) << expression;
+    EXPECT_EQ(numCallRows > 0, expectedBatchRows == 0) << expression;
+  };
+
+  // Flat inputs without nulls.
+  test(
+      "batch_plus(c0, c1)",
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 11; }),
+      size);
+
+  // Nulls and constants take the row by row path.
+  test(
+      "batch_plus(c0, c2)",
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 11; }, nullEvery(7)),
+      0);
+  test(
+      "batch_plus(c0, cast(1 as bigint))",
+      makeFlatVector<int64_t>(size, [](auto row) { return row + 1; }),
+      0);
+
+  // Rows which are not contiguous.
+  test(
+      "if(c0 % 2 = 0, batch_plus(c0, c1), 0)",
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 2 == 0 ? row * 11 : 0; }),
+      0);
+}
+
 } // namespace
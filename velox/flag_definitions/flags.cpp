@@ -100,3 +100,25 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+DEFINE_bool(
+    velox_hash_string_allocator_size_classes,
+    false,
+    "If true, HashStringAllocator serves small fixed size allocations from "
+    "size classes with per class free lists and bump allocation");
+
+DEFINE_bool(
+    velox_io_uring_enabled,
+    true,
+    "If true and Velox is built with VELOX_ENABLE_IO_URING, local files are "
+    "read asynchronously through io_uring by ReadFile::preadvAsync()");
+
+DEFINE_int32(
+    velox_io_uring_num_rings,
+    4,
+    "The number of io_uring rings shared by the threads reading local files");
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    256,
+    "The submission queue depth of each io_uring ring");
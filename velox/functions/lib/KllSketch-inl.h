@@ -307,6 +307,49 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const T* values, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  size_t i = 0;
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+    i = 1;
+  }
+  for (; i < count; ++i) {
+    minValue_ = std::min(minValue_, values[i], C());
+    maxValue_ = std::max(maxValue_, values[i], C());
+  }
+  doInsert(values, count);
+}
+
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::doInsert(const T* values, size_t count) {
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  while (i < count) {
+    if (items_.size() < k_ && numLevels() == 1) {
+      const auto numToAdd = std::min<size_t>(count - i, k_ - items_.size());
+      items_.insert(items_.end(), values + i, values + i + numToAdd);
+      levels_[1] += numToAdd;
+      i += numToAdd;
+    } else if (levels_[0] > 0) {
+      // Level zero grows downwards into the free space below it.
+      const auto numToAdd = std::min<size_t>(count - i, levels_[0]);
+      levels_[0] -= numToAdd;
+      std::copy(values + i, values + i + numToAdd, &items_[levels_[0]]);
+      i += numToAdd;
+    } else {
+      // No free space, compact a level to make some.
+      items_[insertPosition()] = values[i++];
+    }
+  }
+  n_ += count;
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -611,9 +654,8 @@ void KllSketch<T, A, C>::mergeViews(
     if (other.n == 0) {
       continue;
     }
-    for (uint32_t j = other.levels[0]; j < other.levels[1]; ++j) {
-      doInsert(other.items[j]);
-    }
+    doInsert(
+        other.items.data() + other.levels[0], other.safeLevelSize(0));
   }
   // Merge higher levels.
   auto tmpNumItems = getNumRetained();
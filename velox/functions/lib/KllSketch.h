@@ -82,6 +82,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'count' new values to the sketch. Equivalent to calling insert() for
+  /// each of them, but fills the free space of level zero in bulk instead of
+  /// one value at a time.
+  void insert(const T* values, size_t count);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -175,6 +180,7 @@ struct KllSketch {
  private:
   KllSketch(const Allocator&, uint32_t seed);
   void doInsert(T);
+  void doInsert(const T* values, size_t count);
   uint32_t insertPosition();
   int findLevelToCompact() const;
   void addEmptyTopLevelToCompletelyFullSketch();
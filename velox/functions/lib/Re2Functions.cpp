@@ -821,15 +821,25 @@ class OptimizedLike final : public exec::VectorFunction {
 };
 
 // This function is used when pattern and escape are constants. And there is not
-// fast path that avoids compiling the regular expression.
+// fast path that avoids compiling the regular expression. If 'prefilter' is
+// true, strings which do not contain the longest literal of the pattern are
+// discarded with a SIMD substring search before running the regular
+// expression.
 class LikeWithRe2 final : public exec::VectorFunction {
  public:
-  LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
+  LikeWithRe2(
+      StringView pattern,
+      std::optional<char> escapeChar,
+      bool prefilter) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
     re_.emplace(
         toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
         opt);
+    if (prefilter && validPattern_) {
+      requiredLiteral_ =
+          longestLikeLiteral(std::string_view(pattern), escapeChar);
+    }
   }
 
   void apply(
@@ -861,6 +871,17 @@ class LikeWithRe2 final : public exec::VectorFunction {
     auto toSearch = decodedArgs.at(0);
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
+      if (!requiredLiteral_.empty()) {
+        context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+          const auto& string = rawStrings[i];
+          result.set(
+              i,
+              stringCore::containsSubstring(
+                  string.data(), string.size(), requiredLiteral_) &&
+                  re2FullMatch(string, *re_));
+        });
+        return;
+      }
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         result.set(i, re2FullMatch(rawStrings[i], *re_));
       });
@@ -883,6 +904,9 @@ class LikeWithRe2 final : public exec::VectorFunction {
  private:
   std::optional<RE2> re_;
   bool validPattern_;
+  // A substring of all the strings which match the pattern. Empty if there is
+  // none or prefiltering is disabled.
+  std::string requiredLiteral_;
 };
 
 // This function is constructed when pattern or escape are not constants.
@@ -2155,10 +2179,38 @@ PatternMetadata determinePatternKind(
   return PatternMetadata::generic();
 }
 
+std::string longestLikeLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  if (pattern.empty()) {
+    return "";
+  }
+  std::vector<SubPatternKind> subPatternKinds;
+  std::vector<std::pair<size_t, size_t>> subPatternRanges;
+  std::optional<std::string> parsedPattern =
+      parsePattern(pattern, escapeChar, subPatternKinds, subPatternRanges);
+  std::string_view unescapedPattern =
+      escapeChar.has_value() ? parsedPattern.value() : pattern;
+
+  std::optional<size_t> longest;
+  for (auto i = 0; i < subPatternKinds.size(); ++i) {
+    if (subPatternKinds[i] == SubPatternKind::kLiteralString &&
+        (!longest.has_value() ||
+         subPatternRanges[i].second > subPatternRanges[*longest].second)) {
+      longest = i;
+    }
+  }
+  if (!longest.has_value()) {
+    return "";
+  }
+  return std::string(unescapedPattern.substr(
+      subPatternRanges[*longest].first, subPatternRanges[*longest].second));
+}
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/) {
+    const core::QueryConfig& config) {
   auto numArgs = inputArgs.size();
 
   std::optional<char> escapeChar;
@@ -2248,7 +2300,8 @@ std::shared_ptr<exec::VectorFunction> makeLike(
       return std::make_shared<OptimizedLike<PatternKind::kSubstring>>(
           patternMetadata);
     default:
-      return std::make_shared<LikeWithRe2>(pattern, escapeChar);
+      return std::make_shared<LikeWithRe2>(
+          pattern, escapeChar, config.exprLikePrefilter());
   }
 }
 
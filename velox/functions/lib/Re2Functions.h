@@ -221,6 +221,14 @@ PatternMetadata determinePatternKind(
     std::string_view pattern,
     std::optional<char> escapeChar);
 
+/// Returns the longest run of literal characters in LIKE 'pattern', i.e. of
+/// characters other than the '%' and '_' wildcards, with escapes removed. All
+/// strings which match the pattern contain it. Returns an empty string if the
+/// pattern has no literal characters.
+std::string longestLikeLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
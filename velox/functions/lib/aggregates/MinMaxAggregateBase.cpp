@@ -129,6 +129,25 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
+  void addRawInputWithGroupIds(
+      char** groups,
+      const uint64_t* groupIds,
+      uint64_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    if (!BaseAggregate::template updateGroupsWithIds<true, T>(
+            groups,
+            groupIds,
+            numGroupIds,
+            rows,
+            args[0],
+            updateGroup,
+            kInitialValue_)) {
+      addRawInput(groups, rows, args, mayPushdown);
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -230,6 +249,25 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
+  void addRawInputWithGroupIds(
+      char** groups,
+      const uint64_t* groupIds,
+      uint64_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    if (!BaseAggregate::template updateGroupsWithIds<true, T>(
+            groups,
+            groupIds,
+            numGroupIds,
+            rows,
+            args[0],
+            updateGroup,
+            kInitialValue_)) {
+      addRawInput(groups, rows, args, mayPushdown);
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
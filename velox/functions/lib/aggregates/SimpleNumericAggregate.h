@@ -198,6 +198,72 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Same as updateGroups() for groups with small dense ids, e.g. groups of
+  // a hash table in array mode. Accumulates the values of each group into a
+  // dense array indexed by the ids, starting from 'identity', and then
+  // updates each group once. Returns false without updating anything if the
+  // input is lazy or constant or if there are too many ids for the number of
+  // rows. The caller is then expected to call updateGroups().
+  template <
+      bool tableHasNulls,
+      typename TData = TResult,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  bool updateGroupsWithIds(
+      char** groups,
+      const uint64_t* groupIds,
+      uint64_t numGroupIds,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue,
+      TData identity) {
+    if constexpr (std::is_same_v<TData, bool> || std::is_same_v<TValue, bool>) {
+      return false;
+    } else {
+      if (arg->isLazy() || numGroupIds > kMaxDenseGroupIds ||
+          numGroupIds > rows.countSelected()) {
+        return false;
+      }
+      DecodedVector decoded(*arg, rows);
+      if (decoded.isConstantMapping()) {
+        return false;
+      }
+      denseValues_.resize(bits::divRoundUp(
+          numGroupIds * sizeof(TData), sizeof(int128_t)));
+      auto* values = reinterpret_cast<TData*>(denseValues_.data());
+      std::fill_n(values, numGroupIds, identity);
+      denseGroups_.assign(numGroupIds, nullptr);
+      auto accumulate = [&](vector_size_t i, TData value) {
+        const auto id = groupIds[i];
+        VELOX_DCHECK_LT(id, numGroupIds);
+        updateSingleValue(values[id], value);
+        denseGroups_[id] = groups[i];
+      };
+      if (decoded.mayHaveNulls()) {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            accumulate(i, TData(decoded.valueAt<TValue>(i)));
+          }
+        });
+      } else if (decoded.isIdentityMapping()) {
+        const auto* data = decoded.data<TValue>();
+        rows.applyToSelected(
+            [&](vector_size_t i) { accumulate(i, TData(data[i])); });
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          accumulate(i, TData(decoded.valueAt<TValue>(i)));
+        });
+      }
+      for (uint64_t id = 0; id < numGroupIds; ++id) {
+        if (denseGroups_[id] != nullptr) {
+          updateNonNullValue<tableHasNulls, TData>(
+              denseGroups_[id], values[id], updateSingleValue);
+        }
+      }
+      return true;
+    }
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -232,6 +298,10 @@ class SimpleNumericAggregate : public exec::Aggregate {
   }
 
  private:
+  // Maximum number of group ids for updateGroupsWithIds(). Keeps the dense
+  // arrays in cache.
+  static constexpr uint64_t kMaxDenseGroupIds = 4096;
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <
@@ -245,6 +315,11 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  // Dense per group id values and groups for updateGroupsWithIds(). The
+  // values are stored as int128_t for alignment. Reused across batches.
+  std::vector<int128_t> denseValues_;
+  std::vector<char*> denseGroups_;
 };
 
 } // namespace facebook::velox::functions::aggregate
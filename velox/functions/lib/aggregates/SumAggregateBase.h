@@ -72,6 +72,39 @@ class SumAggregateBase
     updateInternal<TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  void addRawInputWithGroupIds(
+      char** groups,
+      const uint64_t* groupIds,
+      uint64_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    bool updated;
+    if (exec::Aggregate::numNulls_) {
+      updated = BaseAggregate::template updateGroupsWithIds<true, TAccumulator>(
+          groups,
+          groupIds,
+          numGroupIds,
+          rows,
+          args[0],
+          &updateSingleValue<TAccumulator>,
+          TAccumulator(0));
+    } else {
+      updated =
+          BaseAggregate::template updateGroupsWithIds<false, TAccumulator>(
+              groups,
+              groupIds,
+              numGroupIds,
+              rows,
+              args[0],
+              &updateSingleValue<TAccumulator>,
+              TAccumulator(0));
+    }
+    if (!updated) {
+      addRawInput(groups, rows, args, mayPushdown);
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
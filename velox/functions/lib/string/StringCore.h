@@ -311,6 +311,42 @@ cappedByteLengthUnicode(const char* input, size_t size, int64_t maxChars) {
   return utf8Position;
 }
 
+/// Returns true if 'subString' occurs in the 'length' bytes at 'string'.
+/// Compares the first and last bytes of 'subString' at a SIMD batch of
+/// positions at a time and compares the whole 'subString' only where both
+/// match.
+FOLLY_ALWAYS_INLINE bool containsSubstring(
+    const char* string,
+    size_t length,
+    std::string_view subString) {
+  const auto size = subString.size();
+  if (size == 0) {
+    return true;
+  }
+  if (size > length) {
+    return false;
+  }
+  using Batch = xsimd::batch<uint8_t>;
+  const auto first = xsimd::broadcast<uint8_t>(subString[0]);
+  const auto last = xsimd::broadcast<uint8_t>(subString[size - 1]);
+  const auto* data = reinterpret_cast<const uint8_t*>(string);
+  size_t i = 0;
+  for (; i + size - 1 + Batch::size <= length; i += Batch::size) {
+    const auto matches = (Batch::load_unaligned(data + i) == first) &
+        (Batch::load_unaligned(data + i + size - 1) == last);
+    auto mask = simd::toBitMask(matches);
+    while (mask) {
+      const auto offset = __builtin_ctzll(mask);
+      if (memcmp(string + i + offset, subString.data(), size) == 0) {
+        return true;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return std::string_view(string + i, length - i).find(subString) !=
+      std::string_view::npos;
+}
+
 /// Returns the start byte index of the Nth instance of subString in
 /// string. Search starts from startPosition. Positions start with 0. If not
 /// found, -1 is returned. To facilitate finding overlapping strings, the
@@ -129,6 +129,39 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, batchInsert) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  std::vector<double> values(N);
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  // Batches of varying sizes, some larger than k.
+  for (int i = 0, size = 1; i < N; size = size * 3 % 1'009) {
+    const int count = std::min(size, N - i);
+    kll.insert(values.data() + i, count);
+    i += count;
+    EXPECT_EQ(kll.totalCount(), i);
+  }
+  kll.insert(values.data(), 0);
+  EXPECT_EQ(kll.totalCount(), N);
+  kll.finish();
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(kll.estimateQuantile(0.0), values.front());
+  EXPECT_EQ(kll.estimateQuantile(1.0), values.back());
+  auto q = linspace(M);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+  for (int i = 0; i < M; ++i) {
+    auto it = std::lower_bound(values.begin(), values.end(), v[i]);
+    double actualQ = 1.0 * (it - values.begin()) / N;
+    EXPECT_NEAR(q[i], actualQ, kEpsilon);
+  }
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
@@ -618,6 +618,55 @@ TEST_F(Re2FunctionsTest, likeDeterminePatternKindWithEscapeChar) {
   testPattern(R"(%\_ab\%%%)", PatternKind::kSubstring, "_ab%");
 }
 
+TEST_F(Re2FunctionsTest, likeLongestLiteral) {
+  EXPECT_EQ(longestLikeLiteral("", std::nullopt), "");
+  EXPECT_EQ(longestLikeLiteral("%_%", std::nullopt), "");
+  EXPECT_EQ(longestLikeLiteral("abc", std::nullopt), "abc");
+  EXPECT_EQ(longestLikeLiteral("%ab%cde_f%", std::nullopt), "cde");
+  EXPECT_EQ(longestLikeLiteral("_abc%de", std::nullopt), "abc");
+  EXPECT_EQ(longestLikeLiteral(R"(%a\_b\_c%x_)", '\\'), "a_b_c");
+  EXPECT_EQ(longestLikeLiteral(R"(%\%%x\_)", '\\'), "x_");
+}
+
+TEST_F(Re2FunctionsTest, likePrefilter) {
+  // Generic patterns with literals of different lengths. Some of the strings
+  // contain the longest literal and do not match the pattern.
+  const std::vector<std::string> patterns = {
+      "%a%b%c",
+      "%abc%de_f%",
+      "_abc%x%",
+      "%special%requests%",
+      R"(%a\_b\_c%x_)",
+  };
+  auto data = makeRowVector({makeFlatVector<std::string>({
+      "",
+      "abc",
+      "xabcxdefx",
+      "abcdeffx",
+      "xabcxxdezfxx",
+      "theabc x",
+      "yabcxyz",
+      "special requests",
+      "some special and long requests here",
+      "a_b_c a_b_cxy",
+      "a_b_cx",
+      "the quick brown fox jumps over the lazy dog abcde_f",
+  })});
+
+  for (const auto& pattern : patterns) {
+    SCOPED_TRACE(pattern);
+    const auto expression = fmt::format("like(c0, '{}', '\\')", pattern);
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprLikePrefilter, "false"},
+    });
+    auto expected = evaluate(expression, data);
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprLikePrefilter, "true"},
+    });
+    assertEqualVectors(expected, evaluate(expression, data));
+  }
+}
+
 TEST_F(Re2FunctionsTest, likePatternWildcard) {
   testLike("", "", true);
   testLike("", "%", true);
@@ -43,6 +43,17 @@ class RankFunction : public exec::WindowFunction {
     numPartitionRows_ = partition->numRows();
   }
 
+  void resetPartitionChunk(
+      const exec::WindowPartition* partition,
+      vector_size_t startRow) override {
+    VELOX_CHECK(TRank != RankType::kDenseRank);
+    // The rank of the first row of a peer group is its row number.
+    rank_ = startRow + 1;
+    currentPeerGroupStart_ = startRow;
+    previousPeerCount_ = 0;
+    numPartitionRows_ = partition->numRows();
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
@@ -109,7 +120,15 @@ void registerRankInternal(
     return std::make_unique<RankFunction<TRank, TResult>>(resultType);
   };
 
-  if constexpr (TRank == RankType::kRank || TRank == RankType::kDenseRank) {
+  // The dense rank of a row depends on the number of peer groups before it,
+  // so it can't be computed for a chunk of rows independently.
+  if constexpr (TRank == RankType::kRank) {
+    exec::registerWindowFunction(
+        name,
+        std::move(signatures),
+        {exec::WindowFunction::ProcessMode::kRows, false, true},
+        std::move(windowFunctionFactory));
+  } else if constexpr (TRank == RankType::kDenseRank) {
     exec::registerWindowFunction(
         name,
         std::move(signatures),
@@ -119,7 +138,7 @@ void registerRankInternal(
     exec::registerWindowFunction(
         name,
         std::move(signatures),
-        exec::WindowFunction::Metadata::defaultMetadata(),
+        {exec::WindowFunction::ProcessMode::kPartition, false, true},
         std::move(windowFunctionFactory));
   }
 }
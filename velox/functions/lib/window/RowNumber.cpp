@@ -32,6 +32,12 @@ class RowNumberFunction : public exec::WindowFunction {
     rowNumber_ = 1;
   }
 
+  void resetPartitionChunk(
+      const exec::WindowPartition* /*partition*/,
+      vector_size_t startRow) override {
+    rowNumber_ = startRow + 1;
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
@@ -75,7 +81,7 @@ void registerRowNumber(const std::string& name, TypeKind resultTypeKind) {
   exec::registerWindowFunction(
       name,
       std::move(signatures),
-      {exec::WindowFunction::ProcessMode::kRows, false},
+      {exec::WindowFunction::ProcessMode::kRows, false, true},
       [name](
           const std::vector<exec::WindowFunctionArg>& /*args*/,
           const TypePtr& resultType,
@@ -29,6 +29,7 @@
 #include "folly/CPortability.h"
 #include "velox/common/base/Doubles.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/prestosql/ArithmeticImpl.h"
 
@@ -46,6 +47,38 @@ inline constexpr char digits[36] = {
 
 namespace {
 
+// Computes 'op' over 'size' values of 'a' and 'b' a SIMD batch at a time and
+// writes the results to 'result', which may be the same as 'a' or 'b'. 'op'
+// is called with both xsimd batches and scalars.
+template <typename T, typename Op>
+FOLLY_ALWAYS_INLINE void
+binaryBatch(T* result, const T* a, const T* b, int32_t size, Op op) {
+  using Batch = xsimd::batch<T>;
+  constexpr int32_t kWidth = Batch::size;
+  int32_t i = 0;
+  for (; i + kWidth <= size; i += kWidth) {
+    op(Batch::load_unaligned(a + i), Batch::load_unaligned(b + i))
+        .store_unaligned(result + i);
+  }
+  for (; i < size; ++i) {
+    result[i] = op(a[i], b[i]);
+  }
+}
+
+template <typename T, typename Op>
+FOLLY_ALWAYS_INLINE void
+unaryBatch(T* result, const T* a, int32_t size, Op op) {
+  using Batch = xsimd::batch<T>;
+  constexpr int32_t kWidth = Batch::size;
+  int32_t i = 0;
+  for (; i + kWidth <= size; i += kWidth) {
+    op(Batch::load_unaligned(a + i)).store_unaligned(result + i);
+  }
+  for (; i < size; ++i) {
+    result[i] = op(a[i]);
+  }
+}
+
 template <typename T>
 struct PlusFunction {
   template <typename TInput>
@@ -53,6 +86,15 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(
+        result, a, b, size, [](auto x, auto y) { return plus(x, y); });
+  }
 };
 
 template <typename T>
@@ -62,6 +104,15 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(
+        result, a, b, size, [](auto x, auto y) { return minus(x, y); });
+  }
 };
 
 template <typename T>
@@ -71,6 +122,15 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(
+        result, a, b, size, [](auto x, auto y) { return multiply(x, y); });
+  }
 };
 
 // Multiply function for IntervalDayTime * Double and Double * IntervalDayTime.
@@ -121,6 +181,15 @@ struct DivideFunction {
   {
     result = a / b;
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(
+        result, a, b, size, [](auto x, auto y) { return divide(x, y); });
+  }
 };
 
 template <typename T>
@@ -213,6 +282,14 @@ struct NegateFunction {
   FOLLY_ALWAYS_INLINE void call(TInput& result, const TInput& a) {
     result = negate(a);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, int32_t size) {
+    unaryBatch(result, a, size, [](auto x) { return negate(x); });
+  }
 };
 
 template <typename T>
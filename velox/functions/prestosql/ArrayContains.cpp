@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/FloatingPointUtil.h"
 #include "velox/vector/DecodedVector.h"
@@ -29,6 +30,26 @@ inline bool isPrimitiveEqual(const T& lhs, const T& rhs) {
   }
 }
 
+// Returns true if one of 'values[0, size)' is equal to 'search'. Compares a
+// batch of values at a time.
+template <typename T>
+bool containsSimd(const T* values, vector_size_t size, T search) {
+  using Batch = xsimd::batch<T>;
+  const auto searchBatch = Batch::broadcast(search);
+  vector_size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    if (xsimd::any(Batch::load_unaligned(values + i) == searchBatch)) {
+      return true;
+    }
+  }
+  for (; i < size; ++i) {
+    if (values[i] == search) {
+      return true;
+    }
+  }
+  return false;
+}
+
 template <TypeKind kind>
 void applyTyped(
     const SelectivityVector& rows,
@@ -52,6 +73,20 @@ void applyTyped(
     auto rawElements = elementsDecoded.data<T>();
     auto search = searchDecoded.valueAt<T>(0);
 
+    if constexpr (
+        std::is_integral_v<T> && !isBoolType &&
+        sizeof(T) <= sizeof(int64_t)) {
+      rows.applyToSelected([&](auto row) {
+        flatResult.set(
+            row,
+            containsSimd(
+                rawElements + rawOffsets[indices[row]],
+                rawSizes[indices[row]],
+                search));
+      });
+      return;
+    }
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
@@ -142,6 +142,59 @@ struct SimdComparator {
       VectorPtr& /* result */) {
     VELOX_UNSUPPORTED("Unsupported type for SIMD comparison");
   }
+
+  /// Compares VARCHAR or VARBINARY vectors. Equality of flat and constant
+  /// vectors uses StringView::equalBatch, other cases compare row by row.
+  void applyStringComparison(
+      const SelectivityVector& rows,
+      BaseVector& lhs,
+      BaseVector& rhs,
+      exec::EvalCtx& context,
+      VectorPtr& result) {
+    constexpr bool kIsEquality =
+        std::is_same_v<ComparisonOp, Eq> || std::is_same_v<ComparisonOp, Neq>;
+    auto resultVector = result->asUnchecked<FlatVector<bool>>();
+    const bool isBatchable = kIsEquality &&
+        (lhs.isConstantEncoding() || lhs.isFlatEncoding()) &&
+        (rhs.isConstantEncoding() || rhs.isFlatEncoding()) &&
+        !(lhs.isConstantEncoding() && rhs.isConstantEncoding()) &&
+        rows.isAllSelected();
+    if (!isBatchable) {
+      exec::LocalDecodedVector lhsDecoded(context, lhs, rows);
+      exec::LocalDecodedVector rhsDecoded(context, rhs, rows);
+      context.template applyToSelectedNoThrow(rows, [&](auto row) {
+        resultVector->set(
+            row,
+            ComparisonOp()(
+                lhsDecoded->template valueAt<StringView>(row),
+                rhsDecoded->template valueAt<StringView>(row)));
+      });
+      return;
+    }
+
+    // Equality is symmetric, so a constant is always on the right.
+    auto* flat = lhs.isFlatEncoding() ? &lhs : &rhs;
+    auto* other = flat == &lhs ? &rhs : &lhs;
+    const bool otherConstant = other->isConstantEncoding();
+    StringView constant;
+    if (otherConstant) {
+      constant = other->asUnchecked<ConstantVector<StringView>>()->valueAt(0);
+    }
+    // All rows are selected, so these start at 0.
+    auto* rawResult = resultVector->mutableRawValues<uint64_t>();
+    StringView::equalBatch(
+        flat->asUnchecked<FlatVector<StringView>>()->rawValues(),
+        otherConstant
+            ? &constant
+            : other->asUnchecked<FlatVector<StringView>>()->rawValues(),
+        otherConstant,
+        rows.end(),
+        rawResult);
+    if constexpr (std::is_same_v<ComparisonOp, Neq>) {
+      bits::negate(reinterpret_cast<char*>(rawResult), rows.end());
+    }
+    resultVector->clearNulls(rows);
+  }
 };
 
 template <typename ComparisonOp, typename Arch = xsimd::default_arch>
@@ -160,6 +213,13 @@ class ComparisonSimdFunction : public exec::VectorFunction {
     context.ensureWritable(rows, outputType, result);
     auto comparator = SimdComparator<ComparisonOp>{};
 
+    if (args[0]->typeKind() == TypeKind::VARCHAR ||
+        args[0]->typeKind() == TypeKind::VARBINARY) {
+      comparator.applyStringComparison(
+          rows, *args[0], *args[1], context, result);
+      return;
+    }
+
     if (args[0]->type()->isLongDecimal()) {
       comparator.template applyComparison<TypeKind::HUGEINT>(
           rows, *args[0], *args[1], context, result);
@@ -189,6 +249,8 @@ class ComparisonSimdFunction : public exec::VectorFunction {
              "date",
              "interval day to second",
              "interval year to month",
+             "varchar",
+             "varbinary",
          }) {
       signatures.push_back(exec::FunctionSignatureBuilder()
                                .returnType("boolean")
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
@@ -299,12 +300,35 @@ std::pair<std::unique_ptr<common::Filter>, bool> createBytesValuesFilter(
   return {std::make_unique<common::BytesValues>(values, nullAllowed), false};
 }
 
+// Maximum number of distinct integers in an IN list for comparing the input
+// to each of them with SIMD instead of testing the filter.
+constexpr int32_t kMaxSimdInListSize = 32;
+
+// Returns the distinct non-null values of an integer IN list if there are at
+// most kMaxSimdInListSize of them and no nulls, otherwise an empty list.
+template <typename T>
+std::vector<int64_t> smallInList(
+    const VectorPtr& valuesVector,
+    vector_size_t offset,
+    vector_size_t size) {
+  auto [values, nullAllowed] = toValues<int64_t, T>(valuesVector, offset, size);
+  if (nullAllowed || values.size() > kMaxSimdInListSize) {
+    return {};
+  }
+  return std::move(values);
+}
+
 /// x IN (2, null) returns null when x != 2 and true when x == 2.
 /// Null for x always produces null, regardless of 'IN' list.
 class InPredicate : public exec::VectorFunction {
  public:
-  explicit InPredicate(std::unique_ptr<common::Filter> filter, bool alwaysNull)
-      : filter_{std::move(filter)}, alwaysNull_(alwaysNull) {}
+  explicit InPredicate(
+      std::unique_ptr<common::Filter> filter,
+      bool alwaysNull,
+      std::vector<int64_t> smallInList = {})
+      : filter_{std::move(filter)},
+        alwaysNull_(alwaysNull),
+        smallInList_(std::move(smallInList)) {}
 
   static std::shared_ptr<exec::VectorFunction> create(
       const std::string& /*name*/,
@@ -349,6 +373,7 @@ class InPredicate : public exec::VectorFunction {
     }
 
     std::pair<std::unique_ptr<common::Filter>, bool> filter;
+    std::vector<int64_t> smallValues;
 
     switch (elementType->kind()) {
       case TypeKind::HUGEINT:
@@ -356,15 +381,19 @@ class InPredicate : public exec::VectorFunction {
         break;
       case TypeKind::BIGINT:
         filter = createBigintValuesFilter<int64_t>(elements, offset, size);
+        smallValues = smallInList<int64_t>(elements, offset, size);
         break;
       case TypeKind::INTEGER:
         filter = createBigintValuesFilter<int32_t>(elements, offset, size);
+        smallValues = smallInList<int32_t>(elements, offset, size);
         break;
       case TypeKind::SMALLINT:
         filter = createBigintValuesFilter<int16_t>(elements, offset, size);
+        smallValues = smallInList<int16_t>(elements, offset, size);
         break;
       case TypeKind::TINYINT:
         filter = createBigintValuesFilter<int8_t>(elements, offset, size);
+        smallValues = smallInList<int8_t>(elements, offset, size);
         break;
       case TypeKind::REAL:
         filter = createFloatingPointValuesFilter<float>(elements, offset, size);
@@ -399,7 +428,7 @@ class InPredicate : public exec::VectorFunction {
             inListType->toString());
     }
     return std::make_shared<InPredicate>(
-        std::move(filter.first), filter.second);
+        std::move(filter.first), filter.second, std::move(smallValues));
   }
 
   void apply(
@@ -577,6 +606,14 @@ class InPredicate : public exec::VectorFunction {
         }
       });
     } else {
+      if constexpr (
+          std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+          sizeof(T) <= sizeof(int64_t)) {
+        if (!smallInList_.empty()) {
+          testSmallInList(rows, flatArg->rawValues(), rawResults);
+          return;
+        }
+      }
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
         bits::setBit(rawResults, row, pass);
@@ -584,8 +621,61 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Sets the bits of 'rawResults' for 'rows' to whether 'values' are in
+  // 'smallInList_'. Compares a batch of values to each value of the list at a
+  // time and writes 64 results at a time.
+  template <typename T>
+  void testSmallInList(
+      const SelectivityVector& rows,
+      const T* values,
+      uint64_t* rawResults) const {
+    using Batch = xsimd::batch<T>;
+    std::vector<Batch> inList;
+    inList.reserve(smallInList_.size());
+    for (auto value : smallInList_) {
+      inList.push_back(Batch::broadcast(static_cast<T>(value)));
+    }
+    const auto* selected = rows.asRange().bits();
+    auto testWord = [&](int32_t index, uint64_t mask) {
+      const vector_size_t begin = index * 64;
+      const vector_size_t end = std::min(begin + 64, rows.end());
+      uint64_t found = 0;
+      vector_size_t row = begin;
+      for (; row + Batch::size <= end; row += Batch::size) {
+        const auto batch = Batch::load_unaligned(values + row);
+        auto matches = batch == inList[0];
+        for (auto i = 1; i < inList.size(); ++i) {
+          matches = matches | (batch == inList[i]);
+        }
+        found |= static_cast<uint64_t>(
+                     static_cast<uint32_t>(simd::toBitMask(matches)))
+            << (row - begin);
+      }
+      for (; row < end; ++row) {
+        const auto value = values[row];
+        for (auto inValue : smallInList_) {
+          if (value == inValue) {
+            found |= 1UL << (row - begin);
+            break;
+          }
+        }
+      }
+      rawResults[index] = (rawResults[index] & ~mask) | (found & mask);
+    };
+    bits::forEachWord(
+        rows.begin(),
+        rows.end(),
+        [&](int32_t index, uint64_t mask) {
+          testWord(index, mask & selected[index]);
+        },
+        [&](int32_t index) { testWord(index, selected[index]); });
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
+  // The distinct values of an integer IN list without nulls, if there are
+  // few enough of them for testSmallInList(). Empty otherwise.
+  const std::vector<int64_t> smallInList_;
 };
 } // namespace
 
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -181,8 +183,113 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::string paddedInput_;
 };
 
+// Evaluates json_extract_scalar for several paths of the same documents.
+// Each document is parsed once and rewound for each path.
+class JsonExtractScalarMultiPath : public exec::MultiPathExtractor {
+ public:
+  explicit JsonExtractScalarMultiPath(const std::vector<std::string>& paths) {
+    extractors_.reserve(paths.size());
+    for (const auto& path : paths) {
+      auto extractor = SIMDJsonExtractor::tryCreate(path);
+      VELOX_CHECK_NOT_NULL(extractor, "Invalid JSON path: {}", path);
+      extractors_.push_back(std::move(extractor));
+    }
+  }
+
+  void extract(
+      const SelectivityVector& rows,
+      const DecodedVector& documents,
+      exec::EvalCtx& context,
+      std::vector<VectorPtr>& results) override {
+    VELOX_CHECK_EQ(results.size(), extractors_.size());
+    std::vector<FlatVector<StringView>*> flatResults;
+    flatResults.reserve(results.size());
+    for (auto& result : results) {
+      context.ensureWritable(rows, VARCHAR(), result);
+      flatResults.push_back(result->asFlatVector<StringView>());
+    }
+
+    size_t maxSize = 0;
+    rows.applyToSelected([&](auto row) {
+      if (!documents.isNullAt(row)) {
+        maxSize = std::max(maxSize, documents.valueAt<StringView>(row).size());
+      }
+    });
+    paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+
+    rows.applyToSelected([&](auto row) {
+      if (documents.isNullAt(row)) {
+        for (auto* result : flatResults) {
+          result->setNull(row, true);
+        }
+        return;
+      }
+      const auto json = documents.valueAt<StringView>(row);
+      memcpy(paddedInput_.data(), json.data(), json.size());
+      extractRow(row, json.size(), flatResults);
+    });
+  }
+
+ private:
+  void extractRow(
+      vector_size_t row,
+      size_t size,
+      const std::vector<FlatVector<StringView>*>& results) {
+    simdjson::padded_string_view input(
+        paddedInput_.data(), size, paddedInput_.size());
+    simdjson::ondemand::document jsonDoc;
+    if (simdjsonParse(input).get(jsonDoc)) {
+      for (auto* result : results) {
+        result->setNull(row, true);
+      }
+      return;
+    }
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      JsonExtractScalarConsumer consumer;
+      const auto error = simdJsonExtract(jsonDoc, *extractors_[i], consumer);
+      if (error == simdjson::SUCCESS && consumer.resultStr.has_value()) {
+        results[i]->set(row, StringView(*consumer.resultStr));
+      } else {
+        results[i]->setNull(row, true);
+      }
+      if (i + 1 == extractors_.size()) {
+        break;
+      }
+      // The state of the document is undefined after an error, so it is
+      // parsed again. Otherwise, the structural index of the document is
+      // reused for the next path.
+      if (error != simdjson::SUCCESS) {
+        if (simdjsonParse(input).get(jsonDoc)) {
+          for (auto j = i + 1; j < extractors_.size(); ++j) {
+            results[j]->setNull(row, true);
+          }
+          return;
+        }
+      } else {
+        jsonDoc.rewind();
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+  // Padding is needed in case string view is inlined.
+  std::string paddedInput_;
+};
+
 } // namespace
 
+void registerJsonExtractScalarMultiPath(const std::string& name) {
+  exec::registerMultiPathExtractFunction(
+      name,
+      {[](const std::string& path) {
+         return SIMDJsonExtractor::tryCreate(path) != nullptr;
+       },
+       [](const std::vector<std::string>& paths)
+           -> std::unique_ptr<exec::MultiPathExtractor> {
+         return std::make_unique<JsonExtractScalarMultiPath>(paths);
+       }});
+}
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
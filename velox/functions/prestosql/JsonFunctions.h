@@ -198,6 +198,48 @@ struct JsonArrayGetFunction {
   }
 };
 
+// Consumes the values at the path of json_extract_scalar. Sets 'resultStr' to
+// the value as a string if there is exactly one value and it is a boolean,
+// number or string.
+struct JsonExtractScalarConsumer {
+  template <typename TValue>
+  simdjson::error_code operator()(TValue& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      resultStr = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        resultStr = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  }
+
+  bool resultPopulated{false};
+  std::optional<std::string> resultStr;
+};
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -218,46 +260,12 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
+    JsonExtractScalarConsumer consumer;
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
+    if (consumer.resultStr.has_value()) {
+      result.copy_from(*consumer.resultStr);
       return simdjson::SUCCESS;
     } else {
       return simdjson::NO_SUCH_FIELD;
@@ -405,4 +413,9 @@ struct JsonSizeFunction {
   }
 };
 
+/// Registers 'name', which must be json_extract_scalar, for evaluation with
+/// other paths of the same documents. See
+/// exec::registerMultiPathExtractFunction().
+void registerJsonExtractScalarMultiPath(const std::string& name);
+
 } // namespace facebook::velox::functions
@@ -54,6 +54,16 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t size) {
+    int32_t i = 0;
+    for (; i < size && isSparse_; ++i) {
+      append(hashes[i]);
+    }
+    if (i < size) {
+      denseHll_.insertHashes(hashes + i, size - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -269,18 +279,20 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      hashes_.clear();
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (hashes_.empty()) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), hashes_.size());
     }
   }
 
@@ -423,6 +435,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // The hashes of the input of a single group. Reused across batches.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -92,6 +92,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(const T* values, size_t count) {
+    sketch_.insert(values, count);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -436,19 +440,23 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
+      // Collects the values so that the sketch can add them in bulk.
+      values_.clear();
+      values_.reserve(rows.countSelected());
       if (decodedValue_.mayHaveNulls()) {
         rows.applyToSelected([&](auto row) {
           if (decodedValue_.isNullAt(row)) {
             return;
           }
 
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_.push_back(decodedValue_.valueAt<T>(row));
         });
       } else {
         rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_.push_back(decodedValue_.valueAt<T>(row));
         });
       }
+      accumulator->append(values_.data(), values_.size());
     }
   }
 
@@ -672,6 +680,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Values of the current batch in addSingleGroupRawInput(). Reused across
+  // batches.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/container/F14Set.h>
+
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/functions/lib/aggregates/ValueList.h"
@@ -23,12 +25,40 @@ namespace {
 
 struct ArrayAccumulator {
   ValueList elements;
+  // Number of values of the group in the raw input buffer of the aggregate.
+  vector_size_t numBuffered{0};
 };
 
+// Appends copying 'sourceIndex' to 'targetIndex' to 'ranges'. Extends the last
+// range if the rows are consecutive.
+void appendCopyRange(
+    std::vector<BaseVector::CopyRange>& ranges,
+    vector_size_t sourceIndex,
+    vector_size_t targetIndex) {
+  if (!ranges.empty()) {
+    auto& last = ranges.back();
+    if (last.sourceIndex + last.count == sourceIndex &&
+        last.targetIndex + last.count == targetIndex) {
+      ++last.count;
+      return;
+    }
+  }
+  ranges.push_back({sourceIndex, targetIndex, 1});
+}
+
 class ArrayAggAggregate : public exec::Aggregate {
  public:
-  explicit ArrayAggAggregate(TypePtr resultType, bool ignoreNulls)
-      : Aggregate(resultType), ignoreNulls_(ignoreNulls) {}
+  // If 'bufferRawInput' is true, the raw input values are appended to one
+  // vector for all the groups instead of the ValueList of each group. The
+  // values are grouped by sorting on their group when extracting results.
+  // The intermediate results are still added to the ValueLists.
+  ArrayAggAggregate(
+      TypePtr resultType,
+      bool ignoreNulls,
+      bool bufferRawInput = false)
+      : Aggregate(resultType),
+        ignoreNulls_(ignoreNulls),
+        bufferRawInput_(bufferRawInput) {}
 
   int32_t accumulatorFixedWidthSize() const override {
     return sizeof(ArrayAccumulator);
@@ -99,25 +129,35 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     auto elements = vector->elements();
     elements->resize(countElements(groups, numGroups));
+    sortBuffer();
+    copyRanges_.clear();
 
     uint64_t* rawNulls = getRawNulls(vector);
     vector_size_t offset = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      auto& values = value<ArrayAccumulator>(groups[i])->elements;
-      auto arraySize = values.size();
+      auto* accumulator = value<ArrayAccumulator>(groups[i]);
+      auto& values = accumulator->elements;
+      auto listSize = values.size();
+      auto arraySize = listSize + accumulator->numBuffered;
       if (arraySize) {
         clearNull(rawNulls, i);
 
         ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
+        for (auto index = 0; index < listSize; ++index) {
           reader.next(*elements, offset + index);
         }
+        if (accumulator->numBuffered > 0) {
+          addBufferedCopyRanges(groups[i], offset + listSize);
+        }
         vector->setOffsetAndSize(i, offset, arraySize);
         offset += arraySize;
       } else {
         vector->setNull(i, true);
       }
     }
+    if (!copyRanges_.empty()) {
+      elements->copyRanges(bufferedValues_.get(), copyRanges_);
+    }
   }
 
   void extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result)
@@ -130,6 +170,11 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
+    if (bufferRawInput_) {
+      bufferRawInput(
+          rows, args[0], [&](vector_size_t row) { return groups[row]; });
+      return;
+    }
     decodedElements_.decode(*args[0], rows);
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
@@ -170,6 +215,11 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /* mayPushdown */) override {
+    if (bufferRawInput_) {
+      bufferRawInput(
+          rows, args[0], [&](vector_size_t /*row*/) { return group; });
+      return;
+    }
     auto& values = value<ArrayAccumulator>(group)->elements;
 
     decodedElements_.decode(*args[0], rows);
@@ -208,6 +258,8 @@ class ArrayAggAggregate : public exec::Aggregate {
   void initializeNewGroupsInternal(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
+    // The new groups may reuse the memory of destroyed groups.
+    compactBuffer();
     for (auto index : indices) {
       new (groups[index] + offset_) ArrayAccumulator();
     }
@@ -216,25 +268,153 @@ class ArrayAggAggregate : public exec::Aggregate {
   void destroyInternal(folly::Range<char**> groups) override {
     for (auto group : groups) {
       if (isInitialized(group)) {
-        value<ArrayAccumulator>(group)->elements.free(allocator_);
+        auto* accumulator = value<ArrayAccumulator>(group);
+        accumulator->elements.free(allocator_);
+        if (accumulator->numBuffered > 0) {
+          // The values are removed from the buffer when it is used next.
+          destroyedGroups_.insert(group);
+          numDestroyedBuffered_ += accumulator->numBuffered;
+        }
       }
     }
+    if (numDestroyedBuffered_ > 0 &&
+        numDestroyedBuffered_ == bufferedGroups_.size()) {
+      clearBuffer();
+    }
+  }
+
+  void clearInternal() override {
+    Aggregate::clearInternal();
+    clearBuffer();
   }
 
  private:
   vector_size_t countElements(char** groups, int32_t numGroups) const {
     vector_size_t size = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      size += value<ArrayAccumulator>(groups[i])->elements.size();
+      auto* accumulator = value<ArrayAccumulator>(groups[i]);
+      size += accumulator->elements.size() + accumulator->numBuffered;
     }
     return size;
   }
 
+  // Appends the values of 'input' for 'rows' to 'bufferedValues_' and their
+  // groups, given by 'groupAt(row)', to 'bufferedGroups_'.
+  template <typename GroupAt>
+  void bufferRawInput(
+      const SelectivityVector& rows,
+      const VectorPtr& input,
+      GroupAt groupAt) {
+    compactBuffer();
+    auto loadedInput = BaseVector::loadedVectorShared(input);
+    decodedElements_.decode(*loadedInput, rows);
+    if (bufferedValues_ == nullptr) {
+      bufferedValues_ =
+          BaseVector::create(loadedInput->type(), 0, allocator_->pool());
+    }
+    copyRanges_.clear();
+    vector_size_t size = bufferedValues_->size();
+    rows.applyToSelected([&](vector_size_t row) {
+      if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
+        return;
+      }
+      auto* group = groupAt(row);
+      ++value<ArrayAccumulator>(group)->numBuffered;
+      bufferedGroups_.push_back(group);
+      appendCopyRange(copyRanges_, row, size++);
+    });
+    bufferedValues_->resize(size);
+    bufferedValues_->copyRanges(loadedInput.get(), copyRanges_);
+  }
+
+  // Removes the values of the destroyed groups from the buffer.
+  void compactBuffer() {
+    if (destroyedGroups_.empty()) {
+      return;
+    }
+    if (numDestroyedBuffered_ == bufferedGroups_.size()) {
+      clearBuffer();
+      return;
+    }
+    copyRanges_.clear();
+    vector_size_t numKept = 0;
+    for (vector_size_t i = 0; i < bufferedGroups_.size(); ++i) {
+      if (!destroyedGroups_.contains(bufferedGroups_[i])) {
+        bufferedGroups_[numKept] = bufferedGroups_[i];
+        appendCopyRange(copyRanges_, i, numKept++);
+      }
+    }
+    auto keptValues = BaseVector::create(
+        bufferedValues_->type(), numKept, allocator_->pool());
+    keptValues->copyRanges(bufferedValues_.get(), copyRanges_);
+    bufferedValues_ = std::move(keptValues);
+    bufferedGroups_.resize(numKept);
+    sortedIndices_.clear();
+    destroyedGroups_.clear();
+    numDestroyedBuffered_ = 0;
+  }
+
+  void clearBuffer() {
+    bufferedValues_.reset();
+    bufferedGroups_.clear();
+    sortedIndices_.clear();
+    destroyedGroups_.clear();
+    numDestroyedBuffered_ = 0;
+  }
+
+  // Sorts the indices of the buffered values by group if values were added
+  // since the last sort. The sort is stable so that the values of a group
+  // keep the order in which they were added.
+  void sortBuffer() {
+    compactBuffer();
+    if (sortedIndices_.size() == bufferedGroups_.size()) {
+      return;
+    }
+    sortedIndices_.resize(bufferedGroups_.size());
+    std::iota(sortedIndices_.begin(), sortedIndices_.end(), 0);
+    std::stable_sort(
+        sortedIndices_.begin(),
+        sortedIndices_.end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return std::less<char*>()(
+              bufferedGroups_[left], bufferedGroups_[right]);
+        });
+  }
+
+  // Adds to 'copyRanges_' the copies of the buffered values of 'group' to
+  // the elements of the result starting at 'targetIndex'.
+  void addBufferedCopyRanges(char* group, vector_size_t targetIndex) {
+    auto it = std::lower_bound(
+        sortedIndices_.begin(),
+        sortedIndices_.end(),
+        group,
+        [&](vector_size_t index, char* other) {
+          return std::less<char*>()(bufferedGroups_[index], other);
+        });
+    for (; it != sortedIndices_.end() && bufferedGroups_[*it] == group; ++it) {
+      appendCopyRange(copyRanges_, *it, targetIndex++);
+    }
+  }
+
   // A boolean representing whether to ignore nulls when aggregating inputs.
   const bool ignoreNulls_;
+  const bool bufferRawInput_;
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedElements_;
   DecodedVector decodedIntermediate_;
+
+  // The raw input values of all the groups when 'bufferRawInput_' is true,
+  // in the order they were added, and the group of each value.
+  VectorPtr bufferedValues_;
+  std::vector<char*> bufferedGroups_;
+  // Indices into 'bufferedGroups_' sorted by group.
+  std::vector<vector_size_t> sortedIndices_;
+  // Destroyed groups which may still have values in the buffer and the total
+  // number of these values.
+  folly::F14FastSet<char*> destroyedGroups_;
+  size_t numDestroyedBuffered_{0};
+  // Reusable ranges for copying to and from 'bufferedValues_'.
+  std::vector<BaseVector::CopyRange> copyRanges_;
 };
 
 } // namespace
@@ -263,7 +443,9 @@ void registerArrayAggAggregate(
         VELOX_CHECK_EQ(
             argTypes.size(), 1, "{} takes at most one argument", name);
         return std::make_unique<ArrayAggAggregate>(
-            resultType, config.prestoArrayAggIgnoreNulls());
+            resultType,
+            config.prestoArrayAggIgnoreNulls(),
+            config.prestoArrayAggBufferRawInput());
       },
       withCompanionFunctions,
       overwrite);
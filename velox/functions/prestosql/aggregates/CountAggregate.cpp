@@ -69,6 +69,55 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  void addRawInputWithGroupIds(
+      char** groups,
+      const uint64_t* groupIds,
+      uint64_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    if (numGroupIds > kMaxDenseGroupIds ||
+        numGroupIds > rows.countSelected()) {
+      addRawInput(groups, rows, args, mayPushdown);
+      return;
+    }
+
+    // Counts the rows of each group id and then adds the counts to the
+    // groups.
+    denseCounts_.assign(numGroupIds, 0);
+    denseGroups_.resize(numGroupIds);
+    auto countRow = [&](vector_size_t i) {
+      const auto id = groupIds[i];
+      VELOX_DCHECK_LT(id, numGroupIds);
+      ++denseCounts_[id];
+      denseGroups_[id] = groups[i];
+    };
+    if (args.empty()) {
+      rows.applyToSelected(countRow);
+    } else {
+      DecodedVector decoded(*args[0], rows);
+      if (decoded.isConstantMapping()) {
+        if (decoded.isNullAt(0)) {
+          return;
+        }
+        rows.applyToSelected(countRow);
+      } else if (decoded.mayHaveNulls()) {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            countRow(i);
+          }
+        });
+      } else {
+        rows.applyToSelected(countRow);
+      }
+    }
+    for (uint64_t id = 0; id < numGroupIds; ++id) {
+      if (denseCounts_[id] > 0) {
+        addToGroup(denseGroups_[id], denseCounts_[id]);
+      }
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -142,11 +191,18 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
  private:
+  // Maximum number of group ids for addRawInputWithGroupIds().
+  static constexpr uint64_t kMaxDenseGroupIds = 4096;
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
 
   DecodedVector decodedIntermediate_;
+
+  // Per group id counts and groups for addRawInputWithGroupIds().
+  std::vector<int64_t> denseCounts_;
+  std::vector<char*> denseGroups_;
 };
 
 } // namespace
@@ -272,6 +272,55 @@ TEST_F(ArrayAggTest, global) {
   testFunction("simple_array_agg", false);
 }
 
+TEST_F(ArrayAggTest, bufferRawInput) {
+  const auto size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            size, [i](auto row) { return i * size + row; }, nullEvery(7)),
+        makeFlatVector<std::string>(
+            size,
+            [](auto row) { return std::string(row % 20, 'a' + row % 26); },
+            nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (auto ignoreNulls : {false, true}) {
+    SCOPED_TRACE(fmt::format("ignoreNulls: {}", ignoreNulls));
+    auto config = makeConfig(ignoreNulls);
+    config["presto.array_agg.buffer_raw_input"] = "true";
+    auto filter = [&](const std::string& column) {
+      return ignoreNulls ? fmt::format("filter (where {} is not null)", column)
+                         : "";
+    };
+    testAggregations(
+        vectors,
+        {"c0"},
+        {"array_agg(c1)", "array_agg(c2)"},
+        {"c0", "array_sort(a0)", "array_sort(a1)"},
+        fmt::format(
+            "SELECT c0, array_sort(array_agg(c1) {}), "
+            "array_sort(array_agg(c2) {}) FROM tmp GROUP BY c0",
+            filter("c1"),
+            filter("c2")),
+        config);
+    testAggregations(
+        vectors,
+        {},
+        {"array_agg(c1)", "array_agg(c2)"},
+        {"array_sort(a0)", "array_sort(a1)"},
+        fmt::format(
+            "SELECT array_sort(array_agg(c1) {}), "
+            "array_sort(array_agg(c2) {}) FROM tmp",
+            filter("c1"),
+            filter("c2")),
+        config);
+  }
+}
+
 TEST_F(ArrayAggTest, globalNoData) {
   auto testFunction = [this](
                           const std::string& functionName,
@@ -116,6 +116,22 @@ BENCHMARK_RELATIVE(in) {
   benchmark.run(10);
 }
 
+// The largest IN list compared with SIMD.
+BENCHMARK(fastIn32) {
+  InBenchmark benchmark;
+  benchmark.runFast(32);
+}
+
+BENCHMARK_RELATIVE(in32) {
+  InBenchmark benchmark;
+  benchmark.run(32);
+}
+
+BENCHMARK_RELATIVE(in33) {
+  InBenchmark benchmark;
+  benchmark.run(33);
+}
+
 BENCHMARK(fastIn1K) {
   InBenchmark benchmark;
   benchmark.runFast(1'000);
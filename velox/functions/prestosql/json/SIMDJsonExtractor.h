@@ -57,7 +57,14 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns an extractor for 'path' which is owned by the caller, or nullptr
+  /// if 'path' is invalid. Unlike the references returned by getInstance(),
+  /// any number of these can be used at the same time.
+  static std::unique_ptr<SIMDJsonExtractor> tryCreate(folly::StringPiece path);
+
  private:
+  SIMDJsonExtractor() = default;
+
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
     if (!tokenize(path)) {
@@ -127,6 +134,23 @@ simdjson::error_code SIMDJsonExtractor::extract(
   return consumer(input);
 };
 
+/// Same as the overload below for a parsed document. The document can be
+/// rewound afterwards to extract another path from it.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, std::forward<TConsumer>(consumer));
+}
+
 /**
  * Extract element(s) from a JSON object using the given path.
  * @param json: A JSON object
@@ -152,15 +176,7 @@ simdjson::error_code simdJsonExtract(
     TConsumer&& consumer) {
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return simdJsonExtract(jsonDoc, extractor, std::forward<TConsumer>(consumer));
 }
 
 } // namespace facebook::velox::functions
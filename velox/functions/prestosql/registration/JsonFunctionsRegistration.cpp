@@ -30,6 +30,7 @@ void registerJsonFunctions(const std::string& prefix) {
       {prefix + "json_extract_scalar"});
   registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
+  registerJsonExtractScalarMultiPath(prefix + "json_extract_scalar");
 
   registerFunction<JsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -49,6 +50,8 @@ void registerMathFunctions(const std::string& prefix) {
       {prefix + "negate"});
   registerFunction<NegateFunction, ShortDecimal<P1, S1>, ShortDecimal<P1, S1>>(
       {prefix + "negate"});
+  exec::registerFusedArithmeticFunction(
+      prefix + "negate", exec::FusedArithmeticOp::kNegate);
 
   registerFunction<RadiansFunction, double, double>({prefix + "radians"});
   registerFunction<DegreesFunction, double, double>({prefix + "degrees"});
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/Registerer.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
 #include "velox/functions/prestosql/DecimalFunctions.h"
@@ -56,6 +57,15 @@ void registerMathOperators(const std::string& prefix = "") {
       IntervalDayTime,
       double>({prefix + "divide"});
   registerBinaryFloatingPoint<ModulusFunction>({prefix + "mod"});
+
+  exec::registerFusedArithmeticFunction(
+      prefix + "plus", exec::FusedArithmeticOp::kPlus);
+  exec::registerFusedArithmeticFunction(
+      prefix + "minus", exec::FusedArithmeticOp::kMinus);
+  exec::registerFusedArithmeticFunction(
+      prefix + "multiply", exec::FusedArithmeticOp::kMultiply);
+  exec::registerFusedArithmeticFunction(
+      prefix + "divide", exec::FusedArithmeticOp::kDivide);
 }
 
 } // namespace
@@ -129,6 +129,29 @@ TEST_F(ArrayContainsTest, integerNoNulls) {
        std::nullopt});
 }
 
+TEST_F(ArrayContainsTest, longIntegerArrays) {
+  auto test = [&](auto tag) {
+    using T = decltype(tag);
+    // Row i has the values 0 to i - 1.
+    const vector_size_t size = 100;
+    auto arrayVector = makeArrayVector<T>(
+        size,
+        [](auto row) { return row; },
+        [](auto /*row*/, auto index) { return index; });
+    for (T search : {0, 1, 7, 31, 32, 63, 98, 99, -1}) {
+      std::vector<std::optional<bool>> expected;
+      for (auto row = 0; row < size; ++row) {
+        expected.push_back(search >= 0 && search < row);
+      }
+      testContains(arrayVector, search, expected);
+    }
+  };
+  test(int8_t{});
+  test(int16_t{});
+  test(int32_t{});
+  test(int64_t{});
+}
+
 TEST_F(ArrayContainsTest, integerWithNulls) {
   auto arrayVector = makeNullableArrayVector<int64_t>(
       {{1, 2, 3, 4},
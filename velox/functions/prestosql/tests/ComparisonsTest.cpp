@@ -420,6 +420,78 @@ TEST_F(ComparisonsTest, eqNeqDecimal) {
       "neq(DECIMAL(10, 5), DECIMAL(10, 4))");
 }
 
+TEST_F(ComparisonsTest, varchar) {
+  // Strings within the prefix, inlined and out of line which share prefixes.
+  const std::vector<std::string> values = {
+      "",
+      "a",
+      "abcd",
+      "abce",
+      "abcdefgh",
+      "abcdefgi",
+      "abcdefghijkl",
+      "abcdefghijkm",
+      "abcdefghijklm",
+      "abcdefghijkln",
+      std::string(30, 'x'),
+      std::string(29, 'x') + "y",
+  };
+  const vector_size_t size = values.size() * values.size();
+  auto left = makeFlatVector<std::string>(
+      size, [&](auto row) { return values[row / values.size()]; });
+  auto right = makeFlatVector<std::string>(
+      size, [&](auto row) { return values[row % values.size()]; });
+  auto data = makeRowVector({left, right});
+
+  auto expected = [&](const std::function<bool(int32_t)>& op) {
+    return makeFlatVector<bool>(size, [&](auto row) {
+      const auto& l = values[row / values.size()];
+      const auto& r = values[row % values.size()];
+      return op(l.compare(r));
+    });
+  };
+  auto eq = expected([](auto result) { return result == 0; });
+  auto neq = expected([](auto result) { return result != 0; });
+  test::assertEqualVectors(eq, evaluate("c0 = c1", data));
+  test::assertEqualVectors(neq, evaluate("c0 <> c1", data));
+  test::assertEqualVectors(
+      expected([](auto result) { return result < 0; }),
+      evaluate("c0 < c1", data));
+  test::assertEqualVectors(
+      expected([](auto result) { return result >= 0; }),
+      evaluate("c0 >= c1", data));
+  test::assertEqualVectors(
+      evaluate("cast(c0 as varbinary) = cast(c1 as varbinary)", data), eq);
+
+  // A constant on either side.
+  for (const auto& value : values) {
+    auto constantExpected = makeFlatVector<bool>(
+        size, [&](auto row) { return values[row % values.size()] == value; });
+    const auto literal = fmt::format("'{}'", value);
+    test::assertEqualVectors(
+        constantExpected, evaluate(fmt::format("c1 = {}", literal), data));
+    test::assertEqualVectors(
+        constantExpected, evaluate(fmt::format("{} = c1", literal), data));
+  }
+
+  // Nulls and a dictionary.
+  auto nullable = makeNullableFlatVector<std::string>(
+      {"abcdefghijklm", std::nullopt, "abc", "abcdefghijklm"});
+  auto other = makeFlatVector<std::string>(
+      {"abcdefghijklm", "abc", "abd", "abcdefghijkl"});
+  test::assertEqualVectors(
+      makeNullableFlatVector<bool>({true, std::nullopt, false, false}),
+      evaluate("c0 = c1", makeRowVector({nullable, other})));
+  test::assertEqualVectors(
+      makeFlatVector<bool>({false, true, true, true}),
+      evaluate(
+          "c0 = c1",
+          makeRowVector(
+              {wrapInDictionary(makeIndicesInReverse(4), other),
+               makeFlatVector<std::string>(
+                   {"abcdefghijkm", "abd", "abc", "abcdefghijklm"})})));
+}
+
 TEST_F(ComparisonsTest, gtLtDecimal) {
   auto runAndCompare = [&](std::string expr,
                            std::vector<VectorPtr>& inputs,
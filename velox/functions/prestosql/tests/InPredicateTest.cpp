@@ -48,6 +48,53 @@ class InPredicateTest : public FunctionBaseTest {
         "in");
   }
 
+  // Tests IN lists with up to 33 values. Lists of up to 32 integers are
+  // compared with SIMD.
+  template <typename T>
+  void testSmallInList() {
+    const auto type = CppToType<T>::create();
+    const vector_size_t size = 1'000;
+    auto data = makeRowVector({makeFlatVector<T>(
+        size, [](auto row) { return row % 101 - 50; }, nullptr, type)});
+
+    // A subset of rows. The other rows of the result keep their values.
+    SelectivityVector rows(size);
+    for (auto i = 0; i < size; i += 3) {
+      rows.setValid(i, false);
+    }
+    rows.setValidRange(500, 570, false);
+    rows.updateBounds();
+
+    for (auto numValues = 1; numValues <= 33; ++numValues) {
+      SCOPED_TRACE(fmt::format("numValues: {}", numValues));
+      std::vector<std::optional<T>> values;
+      for (auto i = 0; i < numValues; ++i) {
+        values.push_back(i * 3 - 40);
+      }
+      auto expression =
+          makeInExpression("c0", getInList<T>(values, type), type);
+      auto isIn = [&](vector_size_t row) {
+        const auto n = row % 101 - 50;
+        return n >= -40 && n < numValues * 3 - 40 && (n + 40) % 3 == 0;
+      };
+
+      assertEqualVectors(
+          makeFlatVector<bool>(size, isIn), evaluate(expression, data));
+
+      exec::ExprSet exprSet({expression}, &execCtx_);
+      exec::EvalCtx context(&execCtx_, &exprSet, data.get());
+      std::vector<VectorPtr> results{
+          makeFlatVector<bool>(size, [](auto row) { return row % 2 == 0; })};
+      exprSet.eval(rows, context, results);
+      for (auto row = 0; row < size; ++row) {
+        ASSERT_EQ(
+            results[0]->asFlatVector<bool>()->valueAt(row),
+            rows.isValid(row) ? isIn(row) : row % 2 == 0)
+            << "at " << row;
+      }
+    }
+  }
+
   template <typename T>
   void testValues(
       const TypePtr type = CppToType<T>::create(),
@@ -396,6 +443,13 @@ TEST_F(InPredicateTest, tinyint) {
   testConstantValues<int8_t>();
 }
 
+TEST_F(InPredicateTest, smallInList) {
+  testSmallInList<int64_t>();
+  testSmallInList<int32_t>();
+  testSmallInList<int16_t>();
+  testSmallInList<int8_t>();
+}
+
 TEST_F(InPredicateTest, timestamp) {
   auto inValues = makeTimestampVector({0, 1, 1'133, 12'345});
 
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -70,6 +71,40 @@ class JsonExtractScalarTest : public functions::test::FunctionBaseTest {
             "json_extract_scalar(c0, c1)",
             makeRowVector({varcharVector, pathVector})));
   }
+
+  void setMultiPathExtract(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprMultiPathExtract, enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without multi-path extraction and checks
+  // that the results are the same. Returns the ExprSet with multi-path
+  // extraction.
+  std::unique_ptr<exec::ExprSet> testMultiPath(
+      const std::string& expression,
+      const RowVectorPtr& data) {
+    const auto rowType = asRowType(data->type());
+    setMultiPathExtract(false);
+    auto expected = evaluate(*compileExpression(expression, rowType), data);
+
+    setMultiPathExtract(true);
+    auto exprSet = compileExpression(expression, rowType);
+    velox::test::assertEqualVectors(expected, evaluate(*exprSet, data));
+
+    // Only a subset of the rows.
+    SelectivityVector rows(data->size());
+    for (auto i = 0; i < data->size(); i += 3) {
+      rows.setValid(i, false);
+    }
+    rows.updateBounds();
+    auto result = evaluate(*exprSet, data, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(expected->equalValueAt(result.get(), row, row))
+          << "at " << row;
+    });
+    return exprSet;
+  }
 };
 
 TEST_F(JsonExtractScalarTest, simple) {
@@ -235,6 +270,58 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiPath) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(
+          {R"({"a": 1, "b": "x", "c": {"d": [true, 2.5]}})",
+           R"({"b": "a long string value\twith an escape", "a": null})",
+           std::nullopt,
+           R"({"a": 1, "b": )",
+           R"([1, 2, 3])",
+           R"({"a": [1], "b": {"c": 1}, "c": {"d": [false]}})",
+           "",
+           R"({"c": {"d": [null, "y"]}, "a": -12345678901234567890})"},
+          JSON()),
+      makeFlatVector<bool>(
+          {true, false, true, false, true, false, true, false}),
+  });
+
+  auto exprSet = testMultiPath(
+      "row_constructor(json_extract_scalar(c0, '$.a'), "
+      "json_extract_scalar(c0, '$.b'), json_extract_scalar(c0, '$.c.d[1]'), "
+      "json_extract_scalar(c0, '$[2]'), json_extract_scalar(c0, '$'))",
+      data);
+  const auto& inputs = exprSet->expr(0)->inputs();
+  ASSERT_EQ(inputs.size(), 5);
+  for (const auto& input : inputs) {
+    ASSERT_TRUE(input->is<exec::MultiPathExtractExpr>()) << input->toString();
+  }
+  auto* extract = inputs[2]->as<exec::MultiPathExtractExpr>();
+  EXPECT_EQ(extract->path(), "$.c.d[1]");
+  EXPECT_EQ(extract->group().numPaths(), 5);
+  EXPECT_EQ(extract->toString(), "json_extract_scalar(c0, $.c.d[1]:VARCHAR)");
+
+  // The calls are evaluated on different rows.
+  testMultiPath(
+      "if(c1, json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$.b'))",
+      data);
+  testMultiPath(
+      "concat(coalesce(json_extract_scalar(c0, '$.a'), 'none'), "
+      "coalesce(json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, "
+      "'$.c.d[0]')))",
+      data);
+
+  // Calls with an invalid path are not rewritten.
+  setMultiPathExtract(true);
+  exprSet = compileExpression(
+      "row_constructor(json_extract_scalar(c0, '$.a'), "
+      "json_extract_scalar(c0, '$.a.'))",
+      asRowType(data->type()));
+  EXPECT_TRUE(exprSet->expr(0)->inputs()[0]->is<exec::MultiPathExtractExpr>());
+  EXPECT_FALSE(exprSet->expr(0)->inputs()[1]->is<exec::MultiPathExtractExpr>());
+  VELOX_ASSERT_THROW(evaluate(*exprSet, data), "Invalid JSON path");
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -197,3 +197,37 @@ TEST_F(TransformTest, try) {
   });
   assertEqualVectors(expectedResult, result);
 }
+
+TEST_F(TransformTest, capture) {
+  vector_size_t size = 1'000;
+  auto capture =
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 10; });
+
+  // One element per row. The elements map to the rows at the same position.
+  auto input = makeRowVector({
+      capture,
+      makeArrayVector<int64_t>(size, [](auto) { return 1; }, modN(7)),
+  });
+  auto result = evaluate<ArrayVector>("transform(c1, x -> x + c0)", input);
+  auto expectedResult = makeArrayVector<int64_t>(
+      size,
+      [](auto) { return 1; },
+      [](auto row) { return row % 7 + row * 10; });
+  assertEqualVectors(expectedResult, result);
+
+  // All the elements in the row at the same position as the capture.
+  input = makeRowVector({
+      makeFlatVector<int64_t>({5}),
+      makeArrayVector<int64_t>({{1, 2, 3, 4}}),
+  });
+  result = evaluate<ArrayVector>("transform(c1, x -> x * c0)", input);
+  assertEqualVectors(makeArrayVector<int64_t>({{5, 10, 15, 20}}), result);
+
+  // All the elements in a later row.
+  input = makeRowVector({
+      makeNullableFlatVector<int64_t>({std::nullopt, 5}),
+      makeArrayVector<int64_t>({{}, {1, 2, 3}}),
+  });
+  result = evaluate<ArrayVector>("transform(c1, x -> x * c0)", input);
+  assertEqualVectors(makeArrayVector<int64_t>({{}, {5, 10, 15}}), result);
+}
@@ -443,5 +443,31 @@ TEST_F(AggregateWindowTest, singlePartitionColumnForPrefixSort) {
       {"rows between unbounded preceding and unbounded following"});
 }
 
+// Tests sliding frames that are large enough to be evaluated with the merge
+// of partial aggregates over a segment tree.
+TEST_F(AggregateWindowTest, largeSlidingFrames) {
+  const vector_size_t size = 3'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 97; }, nullEvery(7)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 300; }),
+  });
+  const std::vector<std::string> frameClauses = {
+      "rows between 200 preceding and 100 following",
+      "rows between 500 preceding and current row",
+      "rows between 150 following and 400 following",
+      "rows between c3 preceding and c3 following",
+  };
+
+  auto aggregateFunctions = kAggregateFunctions;
+  aggregateFunctions.push_back("count(*)");
+  for (const auto& function : aggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        {input}, function, {"partition by c0 order by c1"}, frameClauses);
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -16,6 +16,7 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -43,7 +44,11 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxBatchRows_(metadata.maxBatchRows),
+        maxConcurrentRequests_(metadata.maxConcurrentRequests) {
+    VELOX_CHECK_GE(maxBatchRows_, 0);
+    VELOX_CHECK_GT(maxConcurrentRequests_, 0);
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +90,38 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    const vector_size_t numRows = remoteRowVector->size();
+    if (maxBatchRows_ == 0 || numRows <= maxBatchRows_) {
+      std::vector<remote::RemoteFunctionRequest> requests;
+      requests.push_back(makeRequest(remoteRowVector, outputType, context));
+      auto responses = invoke(requests);
+      result = processResponse(responses[0], 0, outputType, context);
+      return;
+    }
+
+    // Splits the rows into requests of 'maxBatchRows_' and copies the result
+    // of each into 'result' at the offset of its rows.
+    // TODO: serialize only active rows.
+    std::vector<remote::RemoteFunctionRequest> requests;
+    for (vector_size_t offset = 0; offset < numRows; offset += maxBatchRows_) {
+      auto slice = std::static_pointer_cast<RowVector>(remoteRowVector->slice(
+          offset, std::min<vector_size_t>(maxBatchRows_, numRows - offset)));
+      requests.push_back(makeRequest(slice, outputType, context));
+    }
+    auto responses = invoke(requests);
+
+    result = BaseVector::create(outputType, numRows, context.pool());
+    for (auto i = 0; i < responses.size(); ++i) {
+      const vector_size_t offset = i * maxBatchRows_;
+      auto values = processResponse(responses[i], offset, outputType, context);
+      result->copy(values.get(), offset, 0, values->size());
+    }
+  }
+
+  remote::RemoteFunctionRequest makeRequest(
+      const RowVectorPtr& input,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,15 +131,43 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = input->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, input->size(), *context.pool(), serde_.get());
+    return request;
+  }
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
-
+  // Sends 'requests' to the server and returns the responses in the same
+  // order. Keeps up to 'maxConcurrentRequests_' requests in flight on the
+  // connection, so that the server processes them in parallel.
+  std::vector<remote::RemoteFunctionResponse> invoke(
+      const std::vector<remote::RemoteFunctionRequest>& requests) const {
+    std::vector<remote::RemoteFunctionResponse> responses;
+    responses.reserve(requests.size());
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      if (requests.size() == 1) {
+        thriftClient_->sync_invokeFunction(
+            responses.emplace_back(), requests[0]);
+        return responses;
+      }
+      for (auto i = 0; i < requests.size(); i += maxConcurrentRequests_) {
+        const auto end =
+            std::min<size_t>(i + maxConcurrentRequests_, requests.size());
+        std::vector<folly::SemiFuture<remote::RemoteFunctionResponse>> futures;
+        futures.reserve(end - i);
+        for (auto j = i; j < end; ++j) {
+          futures.push_back(
+              thriftClient_->semifuture_invokeFunction(requests[j]));
+        }
+        // Runs the event base of the client until all responses arrive.
+        auto batch = folly::collect(std::move(futures))
+                         .via(&eventBase_)
+                         .getVia(&eventBase_);
+        for (auto& response : batch) {
+          responses.push_back(std::move(response));
+        }
+      }
     } catch (const std::exception& e) {
       VELOX_FAIL(
           "Error while executing remote function '{}' at '{}': {}",
@@ -112,13 +175,21 @@ class RemoteFunction : public exec::VectorFunction {
           location_.describe(),
           e.what());
     }
+    return responses;
+  }
 
+  // Returns the results of 'remoteResponse' and sets the errors it returned
+  // in 'context'. The response is for the rows starting at 'offset'.
+  VectorPtr processResponse(
+      const remote::RemoteFunctionResponse& remoteResponse,
+      vector_size_t offset,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.get_result().get_payload(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
 
     if (auto errorPayload = remoteResponse.get_result().errorPayload()) {
       auto errorsRowVector = IOBufToRowVector(
@@ -135,19 +206,23 @@ class RemoteFunction : public exec::VectorFunction {
         try {
           throw std::runtime_error(errorsVector->valueAt(i));
         } catch (const std::exception& ex) {
-          context.setError(i, std::current_exception());
+          context.setError(offset + i, std::current_exception());
         }
       });
     }
+    return outputRowVector->childAt(0);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Mutable because apply() runs the event base while waiting for responses.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const int32_t maxBatchRows_;
+  const int32_t maxConcurrentRequests_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
@@ -30,6 +30,14 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Maximum number of rows sent in one request. Larger batches are split
+  /// into several requests. 0 means no limit.
+  int32_t maxBatchRows{0};
+
+  /// Maximum number of requests of one batch that are in flight at the same
+  /// time. The requests share the connection of the function.
+  int32_t maxConcurrentRequests{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
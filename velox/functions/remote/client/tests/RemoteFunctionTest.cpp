@@ -88,6 +88,15 @@ class RemoteFunctionTest
                                  .build()};
     registerRemoteFunction("remote_substr", substrSignatures, metadata);
 
+    // Splits batches into requests of 7 rows, 2 of them in flight at a time.
+    RemoteVectorFunctionMetadata batchedMetadata = metadata;
+    batchedMetadata.maxBatchRows = 7;
+    batchedMetadata.maxConcurrentRequests = 2;
+    registerRemoteFunction(
+        "remote_plus_batched", plusSignatures, batchedMetadata);
+    registerRemoteFunction(
+        "remote_divide_batched", divSignatures, batchedMetadata);
+
     // Registers the actual function under a different prefix. This is only
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
@@ -98,6 +107,10 @@ class RemoteFunctionTest
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {remotePrefix_ + ".remote_substr"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_batched"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {remotePrefix_ + ".remote_divide_batched"});
   }
 
   void initializeServer() {
@@ -186,6 +199,28 @@ TEST_P(RemoteFunctionTest, tryException) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, batched) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeFlatVector<double>(100, [](auto row) { return row * 2; }),
+      makeFlatVector<double>(100, [](auto row) { return row % 10; }),
+  });
+  auto results =
+      evaluate<SimpleVector<int64_t>>("remote_plus_batched(c0, c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }), results);
+
+  // Errors of each request are set at the rows of the request.
+  auto divideResults = evaluate<SimpleVector<double>>(
+      "TRY(remote_divide_batched(c1, c2))", data);
+  assertEqualVectors(
+      makeFlatVector<double>(
+          100,
+          [](auto row) { return row * 2.0 / (row % 10); },
+          [](auto row) { return row % 10 == 0; }),
+      divideResults);
+}
+
 TEST_P(RemoteFunctionTest, conditionalConjunction) {
   // conditional conjunction disables throwing on error.
   auto inputVector0 = makeFlatVector<bool>({true, true});
@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -292,33 +293,55 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
+class Murmur3Hash;
+
 template <typename HashClass, typename ReturnType, typename ArgType>
 void hashSimdTyped(
     const SelectivityVector* rows,
     std::vector<VectorPtr>& args,
+    const DecodedVector& decoded,
     FlatVector<ReturnType>& result,
     const int32_t hashIdx) {
+  auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
+  if (!args[hashIdx]->isFlatEncoding()) {
+    // Hashes the column without the per row virtual call of a
+    // SparkVectorHasher.
+    rows->applyToSelected([&](auto row) {
+      rawResult[row] = hashOne<HashClass>(
+          decoded.valueAt<ArgType>(row), rawResult[row]);
+    });
+    return;
+  }
   const ArgType* __restrict rawA =
       args[hashIdx]->asUnchecked<FlatVector<ArgType>>()->rawValues();
-  auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
+  if constexpr (
+      std::is_same_v<HashClass, Murmur3Hash> &&
+      (std::is_same_v<ArgType, int32_t> || std::is_same_v<ArgType, float>)) {
+    HashClass::hashColumn(*rows, rawA, rawResult);
+    return;
+  }
   rows->applyToSelected([&](auto row) {
     rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
   });
 }
 
+// Updates the hashes in 'result' with the hashes of the values of a column
+// of a primitive type. 'decoded' is the decoded column.
 template <typename HashClass, typename ReturnType>
 void hashSimd(
     const SelectivityVector* rows,
     std::vector<VectorPtr>& args,
+    const DecodedVector& decoded,
     FlatVector<ReturnType>& result,
     const int32_t hashIdx) {
   switch (args[hashIdx]->typeKind()) {
-#define SCALAR_CASE(kind) \
-  case TypeKind::kind:    \
-    return hashSimdTyped< \
-        HashClass,        \
-        ReturnType,       \
-        TypeTraits<TypeKind::kind>::NativeType>(rows, args, result, hashIdx);
+#define SCALAR_CASE(kind)                        \
+  case TypeKind::kind:                           \
+    return hashSimdTyped<                        \
+        HashClass,                               \
+        ReturnType,                              \
+        TypeTraits<TypeKind::kind>::NativeType>( \
+        rows, args, decoded, result, hashIdx);
     SCALAR_CASE(TINYINT)
     SCALAR_CASE(SMALLINT)
     SCALAR_CASE(INTEGER)
@@ -373,9 +396,8 @@ void applyWithType(
          kind == TypeKind::REAL || kind == TypeKind::DOUBLE ||
          kind == TypeKind::TIMESTAMP || kind == TypeKind::VARCHAR ||
          kind == TypeKind::VARBINARY || kind == TypeKind::HUGEINT ||
-         kind == TypeKind::UNKNOWN) &&
-        args[i]->isFlatEncoding()) {
-      hashSimd<HashClass, ReturnType>(selected, args, result, i);
+         kind == TypeKind::UNKNOWN)) {
+      hashSimd<HashClass, ReturnType>(selected, args, *decoded, result, i);
       continue;
     }
 
@@ -398,6 +420,8 @@ void applyWithType(
 // original) to avoid undefined signed integer overflow and sign extension.
 
 class Murmur3Hash final {
+  using Batch32 = xsimd::batch<uint32_t>;
+
  public:
   using SeedType = int32_t;
   using ReturnType = int32_t;
@@ -458,7 +482,89 @@ class Murmur3Hash final {
     return hashInt64(input.toMicros(), seed);
   }
 
+  // Same as hashInt32() or hashFloat() of 'values' with 'hashes' as seeds for
+  // 'rows'. Sets 'hashes' to the results. Hashes a batch of values at a time
+  // where all rows of the batch are selected.
+  template <typename T>
+  static void hashColumn(
+      const SelectivityVector& rows,
+      const T* values,
+      int32_t* hashes) {
+    static_assert(sizeof(T) == sizeof(uint32_t));
+    constexpr uint64_t kAllLanes = bits::lowMask(Batch32::size);
+    const auto* inputs = reinterpret_cast<const uint32_t*>(values);
+    auto* seeds = reinterpret_cast<uint32_t*>(hashes);
+    const auto* selected = rows.asRange().bits();
+    auto hashWord = [&](int32_t index, uint64_t mask) {
+      const vector_size_t begin = index * 64;
+      const vector_size_t end = std::min(begin + 64, rows.end());
+      vector_size_t row = begin;
+      for (; row + Batch32::size <= end; row += Batch32::size) {
+        const auto lanes = (mask >> (row - begin)) & kAllLanes;
+        if (lanes != kAllLanes) {
+          for (auto i = 0; i < Batch32::size; ++i) {
+            if (lanes & (1UL << i)) {
+              seeds[row + i] = hashOne<Murmur3Hash>(
+                  values[row + i], seeds[row + i]);
+            }
+          }
+          continue;
+        }
+        auto input = Batch32::load_unaligned(inputs + row);
+        if constexpr (std::is_same_v<T, float>) {
+          // -0f has the same hash as +0f.
+          input = xsimd::select(
+              input == Batch32(0x80000000u), Batch32(0u), input);
+        }
+        const auto seed = Batch32::load_unaligned(seeds + row);
+        fmix(mixH1(seed, mixK1(input)), Batch32(4u))
+            .store_unaligned(seeds + row);
+      }
+      for (; row < end; ++row) {
+        if (mask & (1UL << (row - begin))) {
+          seeds[row] = hashOne<Murmur3Hash>(values[row], seeds[row]);
+        }
+      }
+    };
+    bits::forEachWord(
+        rows.begin(),
+        rows.end(),
+        [&](int32_t index, uint64_t mask) {
+          hashWord(index, mask & selected[index]);
+        },
+        [&](int32_t index) { hashWord(index, selected[index]); });
+  }
+
  private:
+  static Batch32 rotateLeft(Batch32 x, int32_t n) {
+    return (x << n) | (x >> (32 - n));
+  }
+
+  // Same as the scalar functions below for a batch of values.
+  static Batch32 mixK1(Batch32 k1) {
+    k1 *= Batch32(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= Batch32(0x1b873593);
+    return k1;
+  }
+
+  static Batch32 mixH1(Batch32 h1, Batch32 k1) {
+    h1 ^= k1;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * Batch32(5) + Batch32(0xe6546b64);
+    return h1;
+  }
+
+  static Batch32 fmix(Batch32 h1, Batch32 length) {
+    h1 ^= length;
+    h1 ^= h1 >> 16;
+    h1 *= Batch32(0x85ebca6b);
+    h1 ^= h1 >> 13;
+    h1 *= Batch32(0xc2b2ae35);
+    h1 ^= h1 >> 16;
+    return h1;
+  }
+
   static uint32_t mixK1(uint32_t k1) {
     k1 *= 0xcc9e2d51;
     k1 = bits::rotateLeft(k1, 15);
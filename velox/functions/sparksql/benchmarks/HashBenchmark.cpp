@@ -34,6 +34,7 @@ int main(int argc, char** argv) {
   std::vector<TypePtr> inputTypes = {
       TINYINT(),
       SMALLINT(),
+      INTEGER(),
       BIGINT(),
       REAL(),
       DOUBLE(),
@@ -59,6 +60,25 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Several columns are hashed one column at a time, each updating the hashes
+  // of all rows.
+  for (auto nullRatio : {0.0, 0.25}) {
+    for (auto& inputType : {INTEGER(), REAL(), BIGINT(), VARCHAR()}) {
+      benchmarkBuilder
+          .addBenchmarkSet(
+              fmt::format(
+                  "hash_4_columns#{}#{}\%nulls",
+                  inputType->toString(),
+                  nullRatio * 100),
+              ROW({"c0", "c1", "c2", "c3"},
+                  {inputType, inputType, inputType, inputType}))
+          .withFuzzerOptions({.vectorSize = 4096, .nullRatio = nullRatio})
+          .addExpression("hash", "hash(c0, c1, c2, c3)")
+          .addExpression("xxhash64", "xxhash64(c0, c1, c2, c3)")
+          .withIterations(100);
+    }
+  }
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
@@ -303,5 +303,29 @@ TEST_F(HashTest, simd) {
   runSIMDHashAndAssert<UnknownValue>(UnknownValue(), 42, 10);
 }
 
+TEST_F(HashTest, columns) {
+  // Hashing several columns gives the same result as hashing a row of them.
+  const vector_size_t size = 1'000;
+  auto ints = makeFlatVector<int32_t>(
+      size, [](auto row) { return row * 7919 - 100'000; }, nullEvery(5));
+  auto floats = makeFlatVector<float>(
+      size,
+      [](auto row) { return row % 3 == 0 ? -0.0f : row * 0.5f; },
+      nullEvery(7));
+  auto check = [&](const VectorPtr& c0, const VectorPtr& c1) {
+    auto expected = hash(makeRowVector({c0, c1}));
+    assertEqualVectors(
+        expected, evaluate("hash(c0, c1)", makeRowVector({c0, c1})));
+  };
+  check(ints, floats);
+  check(ints, makeFlatVector<float>(size, [](auto row) { return row; }));
+
+  // Not flat.
+  auto indices = makeIndicesInReverse(size);
+  check(
+      wrapInDictionary(indices, ints),
+      BaseVector::wrapInConstant(size, 3, floats));
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
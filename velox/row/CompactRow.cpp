@@ -328,6 +328,45 @@ int32_t CompactRow::rowRowSize(vector_size_t index) const {
   return size;
 }
 
+void CompactRow::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t* sizes) const {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  raw_vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+    sizes[i] = fixedSize;
+  }
+
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    if (childIsFixedWidth_[childIdx]) {
+      continue;
+    }
+    const auto& child = children_[childIdx];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < indices.size(); ++i) {
+        if (!mayHaveNulls || !child.isNullAt(indices[i])) {
+          sizes[i] += kSizeBytes +
+              child.decoded_.valueAt<StringView>(indices[i]).size();
+        }
+      }
+    } else {
+      for (auto i = 0; i < indices.size(); ++i) {
+        if (!mayHaveNulls || !child.isNullAt(indices[i])) {
+          sizes[i] += child.variableWidthRowSize(indices[i]);
+        }
+      }
+    }
+  }
+}
+
 void CompactRow::serializedRowSizes(
     const folly::Range<const vector_size_t*>& rows,
     vector_size_t** sizes) const {
@@ -339,8 +378,10 @@ void CompactRow::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  raw_vector<vector_size_t> rowSizes(rows.size());
+  this->rowSizes(rows, rowSizes.data());
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[rows[i]] = rowSizes[i] + sizeof(TRowSize);
   }
 }
 
@@ -386,7 +427,6 @@ void CompactRow::serializeRow(
     char* buffer,
     const size_t* bufferOffsets) const {
   raw_vector<vector_size_t> rows(size);
-  raw_vector<uint8_t*> nulls(size);
   if (decoded_.isIdentityMapping()) {
     std::iota(rows.begin(), rows.end(), offset);
   } else {
@@ -394,6 +434,15 @@ void CompactRow::serializeRow(
       rows[i] = decoded_.index(offset + i);
     }
   }
+  serializeRows(rows, bufferOffsets, buffer);
+}
+
+void CompactRow::serializeRows(
+    const raw_vector<vector_size_t>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  const auto size = rows.size();
+  raw_vector<uint8_t*> nulls(size);
 
   // After serializing each column, the 'offsets' are updated accordingly.
   std::vector<size_t> offsets(size);
@@ -664,6 +713,17 @@ void CompactRow::serialize(
   serializeRow(offset, size, buffer, bufferOffsets);
 }
 
+void CompactRow::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  raw_vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+  serializeRows(indices, bufferOffsets, buffer);
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) const {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
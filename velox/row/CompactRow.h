@@ -39,6 +39,11 @@ class CompactRow {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index) const;
 
+  /// Stores the serialized size of the row at 'rows[i]' in 'sizes[i]'. Same
+  /// as rowSize() but computed one column at a time for all 'rows'.
+  void rowSizes(folly::Range<const vector_size_t*> rows, vector_size_t* sizes)
+      const;
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
@@ -55,6 +60,14 @@ class CompactRow {
       const size_t* bufferOffsets,
       char* buffer) const;
 
+  /// Same as above but serializes the rows at the specified indexes, which
+  /// need not be consecutive. The row at 'rows[i]' is written at
+  /// 'bufferOffsets[i]'.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -138,6 +151,13 @@ class CompactRow {
       char* buffer,
       const size_t* bufferOffsets) const;
 
+  /// Serializes the struct values at 'rows' one column at a time. 'rows' are
+  /// indexes into the base of 'decoded_'. Values must not be null.
+  void serializeRows(
+      const raw_vector<vector_size_t>& rows,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
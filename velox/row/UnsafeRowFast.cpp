@@ -15,6 +15,10 @@
  */
 #include "velox/row/UnsafeRowFast.h"
 
+#include <folly/lang/Bits.h>
+
+#include "velox/row/UnsafeRowDeserializers.h"
+
 namespace facebook::velox::row {
 
 namespace {
@@ -425,4 +429,224 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) const {
 
   return variableWidthOffset;
 }
+
+namespace {
+bool isNullField(std::string_view row, column_index_t column) {
+  return bits::isBitSet(reinterpret_cast<const uint8_t*>(row.data()), column);
+}
+
+// Deserializes the fixed-width field at 'fieldOffset' of each row in 'data'.
+// Null fields are serialized as zeros, so the values are read unconditionally.
+template <TypeKind Kind>
+VectorPtr deserializeFixedWidth(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto numRows = data.size();
+  auto flatVector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  if constexpr (std::is_same_v<T, bool>) {
+    auto* rawValues = flatVector->template mutableRawValues<uint64_t>();
+    for (auto i = 0; i < numRows; ++i) {
+      bits::setBit(rawValues, i, data[i][fieldOffset] != 0);
+    }
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    auto* rawValues = flatVector->mutableRawValues();
+    for (auto i = 0; i < numRows; ++i) {
+      rawValues[i] = Timestamp::fromMicros(
+          folly::loadUnaligned<int64_t>(data[i].data() + fieldOffset));
+    }
+  } else {
+    auto* rawValues = flatVector->mutableRawValues();
+    for (auto i = 0; i < numRows; ++i) {
+      rawValues[i] = folly::loadUnaligned<T>(data[i].data() + fieldOffset);
+    }
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    if (isNullField(data[i], column)) {
+      flatVector->setNull(i, true);
+    }
+  }
+  return flatVector;
+}
+
+// Returns the size and the offset from the start of the row of the
+// variable-width field at 'fieldOffset' of 'row'.
+std::pair<uint32_t, uint32_t> readSizeAndOffset(
+    std::string_view row,
+    size_t fieldOffset) {
+  const auto sizeAndOffset =
+      folly::loadUnaligned<uint64_t>(row.data() + fieldOffset);
+  return {static_cast<uint32_t>(sizeAndOffset), sizeAndOffset >> 32};
+}
+
+// Deserializes the string field at 'fieldOffset' of each row in 'data'. The
+// strings which are not inlined in StringView are copied into a single
+// buffer.
+VectorPtr deserializeStrings(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  auto flatVector =
+      BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
+  size_t totalBytes = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (!isNullField(data[i], column)) {
+      const auto size = readSizeAndOffset(data[i], fieldOffset).first;
+      if (!StringView::isInline(size)) {
+        totalBytes += size;
+      }
+    }
+  }
+
+  char* rawBuffer = nullptr;
+  if (totalBytes > 0) {
+    auto buffer = AlignedBuffer::allocate<char>(totalBytes, pool);
+    rawBuffer = buffer->asMutable<char>();
+    flatVector->addStringBuffer(buffer);
+  }
+  auto* rawValues = flatVector->mutableRawValues();
+  for (auto i = 0; i < numRows; ++i) {
+    if (isNullField(data[i], column)) {
+      flatVector->setNull(i, true);
+      continue;
+    }
+    const auto [size, offset] = readSizeAndOffset(data[i], fieldOffset);
+    const char* value = data[i].data() + offset;
+    if (StringView::isInline(size)) {
+      rawValues[i] = StringView(value, size);
+    } else {
+      ::memcpy(rawBuffer, value, size);
+      rawValues[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
+    }
+  }
+  return flatVector;
+}
+
+// Deserializes the long decimal field at 'fieldOffset' of each row in 'data'.
+VectorPtr deserializeLongDecimals(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  auto flatVector =
+      BaseVector::create<FlatVector<int128_t>>(type, numRows, pool);
+  auto* rawValues = flatVector->mutableRawValues();
+  for (auto i = 0; i < numRows; ++i) {
+    if (isNullField(data[i], column)) {
+      flatVector->setNull(i, true);
+      continue;
+    }
+    const auto [size, offset] = readSizeAndOffset(data[i], fieldOffset);
+    rawValues[i] = UnsafeRowPrimitiveBatchDeserializer::deserializeLongDecimal(
+        std::string_view(data[i].data() + offset, size));
+  }
+  return flatVector;
+}
+
+// Deserializes the nested field at 'fieldOffset' of each row in 'data' with
+// UnsafeRowDeserializer.
+VectorPtr deserializeNested(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+  std::vector<std::optional<std::string_view>> values(data.size());
+  for (auto i = 0; i < data.size(); ++i) {
+    if (!isNullField(data[i], column)) {
+      const auto [size, offset] = readSizeAndOffset(data[i], fieldOffset);
+      values[i] = std::string_view(data[i].data() + offset, size);
+    }
+  }
+  return UnsafeRowDeserializer::deserialize(values, type, pool);
+}
+
+VectorPtr deserializeColumn(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+#define DESERIALIZE_FIXED_WIDTH(KIND)             \
+  case TypeKind::KIND:                            \
+    return deserializeFixedWidth<TypeKind::KIND>( \
+        type, data, column, fieldOffset, pool);
+
+  switch (type->kind()) {
+    DESERIALIZE_FIXED_WIDTH(BOOLEAN)
+    DESERIALIZE_FIXED_WIDTH(TINYINT)
+    DESERIALIZE_FIXED_WIDTH(SMALLINT)
+    DESERIALIZE_FIXED_WIDTH(INTEGER)
+    DESERIALIZE_FIXED_WIDTH(BIGINT)
+    DESERIALIZE_FIXED_WIDTH(REAL)
+    DESERIALIZE_FIXED_WIDTH(DOUBLE)
+    DESERIALIZE_FIXED_WIDTH(TIMESTAMP)
+    case TypeKind::UNKNOWN:
+      return std::make_shared<FlatVector<UnknownValue>>(
+          pool,
+          type,
+          allocateNulls(data.size(), pool, bits::kNull),
+          data.size(),
+          nullptr,
+          std::vector<BufferPtr>{});
+    case TypeKind::HUGEINT:
+      return deserializeLongDecimals(type, data, column, fieldOffset, pool);
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY:
+      return deserializeStrings(type, data, column, fieldOffset, pool);
+    default:
+      return deserializeNested(type, data, column, fieldOffset, pool);
+  }
+
+#undef DESERIALIZE_FIXED_WIDTH
+}
+} // namespace
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool,
+    const std::vector<column_index_t>* projection) {
+  const auto numRows = data.size();
+  const auto nullLength = alignBits(rowType->size());
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> columns;
+  auto addColumn = [&](column_index_t column) {
+    VELOX_CHECK_LT(column, rowType->size());
+    const auto& type = rowType->childAt(column);
+    names.push_back(rowType->nameOf(column));
+    types.push_back(type);
+    columns.push_back(deserializeColumn(
+        type, data, column, nullLength + column * kFieldWidth, pool));
+  };
+  if (projection == nullptr) {
+    for (column_index_t column = 0; column < rowType->size(); ++column) {
+      addColumn(column);
+    }
+  } else {
+    for (const auto column : *projection) {
+      addColumn(column);
+    }
+  }
+
+  auto resultType = projection == nullptr
+      ? rowType
+      : ROW(std::move(names), std::move(types));
+  return std::make_shared<RowVector>(
+      pool, resultType, nullptr, numRows, std::move(columns));
+}
+
 } // namespace facebook::velox::row
@@ -43,6 +43,20 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
 
+  /// Deserializes UnsafeRows in 'data' into a RowVector of flat vectors.
+  /// Top-level fixed-width columns are read with a strided loop over the
+  /// rows. Top-level strings are copied into a single string buffer per
+  /// column. Nested columns are deserialized by UnsafeRowDeserializer.
+  ///
+  /// @param projection Optional indices of the columns of 'rowType' to
+  /// deserialize. The result has only these columns, in this order. If
+  /// nullptr, all columns are deserialized.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool,
+      const std::vector<column_index_t>* projection = nullptr);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
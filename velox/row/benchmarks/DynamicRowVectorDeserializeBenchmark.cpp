@@ -53,6 +53,38 @@ class UnsaferowBatchDeserializer : public Deserializer {
       memory::memoryManager()->addLeafPool()};
 };
 
+class UnsafeRowFastDeserializer : public Deserializer {
+ public:
+  /// If 'projectHalf' is true, deserializes only every other column.
+  explicit UnsafeRowFastDeserializer(bool projectHalf = false)
+      : projectHalf_(projectHalf) {}
+
+  void deserialize(
+      const std::vector<std::optional<std::string_view>>& data,
+      const TypePtr& type) override {
+    std::vector<std::string_view> rows;
+    rows.reserve(data.size());
+    for (const auto& row : data) {
+      rows.push_back(row.value());
+    }
+    const auto rowType = asRowType(type);
+    if (!projectHalf_) {
+      UnsafeRowFast::deserialize(rows, rowType, pool_.get());
+      return;
+    }
+    std::vector<column_index_t> projection;
+    for (column_index_t i = 0; i < rowType->size(); i += 2) {
+      projection.push_back(i);
+    }
+    UnsafeRowFast::deserialize(rows, rowType, pool_.get(), &projection);
+  }
+
+ private:
+  const bool projectHalf_;
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
 class BenchmarkHelper {
  public:
   std::tuple<std::vector<std::optional<std::string_view>>, TypePtr>
@@ -145,6 +177,22 @@ BENCHMARK_NAMED_PARAM_MULTI(
     true,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_batch_10_100k_string_only,
+    10,
+    100000,
+    true,
+    std::make_unique<UnsafeRowFastDeserializer>());
+
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_half_batch_10_100k_string_only,
+    10,
+    100000,
+    true,
+    std::make_unique<UnsafeRowFastDeserializer>(true));
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_100_100k_string_only,
@@ -153,6 +201,22 @@ BENCHMARK_NAMED_PARAM_MULTI(
     true,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_batch_100_100k_string_only,
+    100,
+    100000,
+    true,
+    std::make_unique<UnsafeRowFastDeserializer>());
+
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_half_batch_100_100k_string_only,
+    100,
+    100000,
+    true,
+    std::make_unique<UnsafeRowFastDeserializer>(true));
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_10_100k_all_types,
@@ -161,6 +225,22 @@ BENCHMARK_NAMED_PARAM_MULTI(
     false,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_batch_10_100k_all_types,
+    10,
+    100000,
+    false,
+    std::make_unique<UnsafeRowFastDeserializer>());
+
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_half_batch_10_100k_all_types,
+    10,
+    100000,
+    false,
+    std::make_unique<UnsafeRowFastDeserializer>(true));
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_100_100k_all_types,
@@ -169,6 +249,22 @@ BENCHMARK_NAMED_PARAM_MULTI(
     false,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_batch_100_100k_all_types,
+    100,
+    100000,
+    false,
+    std::make_unique<UnsafeRowFastDeserializer>());
+
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    fast_half_batch_100_100k_all_types,
+    100,
+    100000,
+    false,
+    std::make_unique<UnsafeRowFastDeserializer>(true));
+
 } // namespace
 } // namespace facebook::spark::benchmarks
 
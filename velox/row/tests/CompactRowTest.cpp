@@ -82,6 +82,11 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
       // The serialized row includes the size of the row.
       ASSERT_EQ(serializedRowSizes[i], row.rowSize(i) + sizeof(uint32_t));
     }
+    std::vector<vector_size_t> columnarRowSizes(numRows);
+    row.rowSizes(folly::Range(rows.data(), numRows), columnarRowSizes.data());
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(columnarRowSizes[i], row.rowSize(i));
+    }
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
     auto* rawBuffer = buffer->asMutable<char>();
@@ -125,6 +130,26 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
       auto copy = CompactRow::deserialize(serialized, rowType, pool());
       assertEqualVectors(data, copy);
     }
+    {
+      // Test serialize by row numbers. The rows are serialized in reverse
+      // order, each at its offset.
+      memset(rawBuffer, 0, totalSize);
+
+      std::vector<vector_size_t> reversedRows(rows.rbegin(), rows.rend());
+      std::vector<size_t> reversedOffsets(offsets.rbegin(), offsets.rend());
+      row.serialize(
+          folly::Range(reversedRows.data(), numRows),
+          reversedOffsets.data(),
+          rawBuffer);
+
+      std::vector<std::string_view> serialized;
+      for (auto i = 0; i < numRows; ++i) {
+        serialized.push_back(
+            std::string_view(rawBuffer + offsets[i], rowSize[i]));
+      }
+      auto copy = CompactRow::deserialize(serialized, rowType, pool());
+      assertEqualVectors(data, copy);
+    }
   }
 };
 
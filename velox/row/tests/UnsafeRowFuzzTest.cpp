@@ -85,6 +85,29 @@ class UnsafeRowFuzzTests : public ::testing::Test {
           UnsafeRowDeserializer::deserialize(serialized, rowType, pool_.get());
 
       assertEqualVectors(inputVector, outputVector);
+
+      std::vector<std::string_view> rows;
+      rows.reserve(serialized.size());
+      for (const auto& row : serialized) {
+        rows.push_back(row.value());
+      }
+      assertEqualVectors(
+          inputVector,
+          UnsafeRowFast::deserialize(rows, rowType, pool_.get()));
+
+      // Deserializes every other column in reverse order.
+      std::vector<column_index_t> projection;
+      std::vector<VectorPtr> expectedColumns;
+      for (int32_t column = rowType->size() - 1; column >= 0; column -= 2) {
+        projection.push_back(column);
+        expectedColumns.push_back(inputVector->childAt(column));
+      }
+      auto projected =
+          UnsafeRowFast::deserialize(rows, rowType, pool_.get(), &projection);
+      ASSERT_EQ(projected->childrenSize(), projection.size());
+      for (auto i = 0; i < projection.size(); ++i) {
+        assertEqualVectors(expectedColumns[i], projected->childAt(i));
+      }
     }
   }
 
@@ -44,19 +44,25 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     }
 
     row::CompactRow row(vector);
-    std::vector<vector_size_t> rowSize(totalRows);
+    // Serializes all the rows of 'ranges' together one column at a time.
+    raw_vector<vector_size_t> rows(totalRows);
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      std::iota(
+          rows.begin() + index, rows.begin() + index + range.size, range.begin);
+      index += range.size;
+    }
+    const auto rowRange = folly::Range(rows.data(), rows.size());
+
+    raw_vector<vector_size_t> rowSize(totalRows);
     if (auto fixedRowSize =
             row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * totalRows;
       std::fill(rowSize.begin(), rowSize.end(), fixedRowSize.value());
     } else {
-      vector_size_t index = 0;
-      for (const auto& range : ranges) {
-        for (auto i = 0; i < range.size; ++i, ++index) {
-          rowSize[index] = row.rowSize(range.begin + i);
-          totalSize += rowSize[index] + sizeof(TRowSize);
-        }
-      }
+      row.rowSizes(rowRange, rowSize.data());
+    }
+    for (const auto size : rowSize) {
+      totalSize += size + sizeof(TRowSize);
     }
 
     if (totalSize == 0) {
@@ -67,28 +73,15 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     auto* rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    raw_vector<size_t> offsets(totalRows);
     size_t offset = 0;
-    vector_size_t index = 0;
-    for (const auto& range : ranges) {
-      if (range.size == 1) {
-        // Fast path for single-row serialization.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[index]);
-        auto size =
-            row.serialize(range.begin, rawBuffer + offset + sizeof(TRowSize));
-        offset += size + sizeof(TRowSize);
-        ++index;
-      } else {
-        raw_vector<size_t> offsets(range.size);
-        for (auto i = 0; i < range.size; ++i, ++index) {
-          // Write raw size. Needs to be in big endian order.
-          *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[index]);
-          offsets[i] = offset + sizeof(TRowSize);
-          offset += rowSize[index] + sizeof(TRowSize);
-        }
-        // Write row data for all rows in range.
-        row.serialize(range.begin, range.size, offsets.data(), rawBuffer);
-      }
+    for (auto i = 0; i < totalRows; ++i) {
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[i]);
+      offsets[i] = offset + sizeof(TRowSize);
+      offset += rowSize[i] + sizeof(TRowSize);
     }
+    row.serialize(rowRange, offsets.data(), rawBuffer);
   }
 
   void append(
@@ -107,16 +100,18 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     auto* rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    // 'sizes' are from estimateSerializedSize() and are exact.
+    raw_vector<size_t> offsets(rows.size());
     size_t offset = 0;
-    for (auto& row : rows) {
-      // Write row data.
-      const TRowSize size =
-          compactRow.serialize(row, rawBuffer + offset + sizeof(TRowSize));
-
+    for (auto i = 0; i < rows.size(); ++i) {
       // Write raw size. Needs to be in big endian order.
+      const TRowSize size = sizes[rows[i]] - sizeof(TRowSize);
       *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-      offset += sizeof(TRowSize) + size;
+      offsets[i] = offset + sizeof(TRowSize);
+      offset += sizes[rows[i]];
     }
+    // Write row data for all rows one column at a time.
+    compactRow.serialize(rows, offsets.data(), rawBuffer);
   }
 
   size_t maxSerializedSize() const override {
@@ -15,6 +15,9 @@
  */
 #include "velox/serializers/PrestoSerializer.h"
 
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <optional>
 
 #include <folly/lang/Bits.h>
@@ -37,6 +40,11 @@ namespace {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Velox specific. Bits 3-5 of the codec marker of a compressed page written
+// with adaptive compression hold its CompressionKind. 0 means the kind given
+// in the options of the reader.
+constexpr int8_t kCodecKindShift = 3;
+constexpr int8_t kCodecKindMask = 7 << kCodecKindShift;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -135,6 +143,19 @@ bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+char codecKindBits(common::CompressionKind kind) {
+  VELOX_DCHECK_LE(static_cast<int32_t>(kind), 7);
+  return static_cast<char>(kind) << kCodecKindShift;
+}
+
+std::optional<common::CompressionKind> codecKindFromMarker(int8_t codec) {
+  const auto kind = (codec & kCodecKindMask) >> kCodecKindShift;
+  if (kind == 0) {
+    return std::nullopt;
+  }
+  return static_cast<common::CompressionKind>(kind);
+}
+
 std::string_view typeToEncodingName(const TypePtr& type) {
   switch (type->kind()) {
     case TypeKind::BOOLEAN:
@@ -2859,6 +2880,16 @@ void serializeConstantVector(
   }
 
   T value = constVector->valueAtFast(0);
+  if constexpr (
+      std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      !std::is_same_v<T, int128_t>) {
+    // Values without a special wire format are filled in one batch.
+    stream->appendNonNull(numRows);
+    AppendWindow<T> window(stream->values(), scratch);
+    T* output = window.get(numRows);
+    std::fill(output, output + numRows, value);
+    return;
+  }
   for (int32_t i = 0; i < numRows; ++i) {
     stream->appendNonNull();
     stream->appendOne(value);
@@ -3588,6 +3619,20 @@ void flushSerialization(
   output->seekp(endSize);
 }
 
+// Returns the number of columns and the content of 'streams'. The result
+// references the ranges of 'streams' in 'arena' and is valid while they are.
+std::unique_ptr<folly::IOBuf> serializeStreams(
+    const std::vector<std::unique_ptr<VectorStream>>& streams,
+    const StreamArena& arena) {
+  IOBufOutputStream out(*(arena.pool()));
+  out.enableZeroCopy(nullptr);
+  writeInt32(&out, streams.size());
+  for (auto& stream : streams) {
+    stream->flush(&out);
+  }
+  return out.getIOBuf();
+}
+
 FlushSizes flushCompressed(
     const std::vector<std::unique_ptr<VectorStream>>& streams,
     const StreamArena& arena,
@@ -3608,19 +3653,12 @@ FlushSizes flushCompressed(
 
   writeInt32(output, numRows);
 
-  IOBufOutputStream out(*(arena.pool()), nullptr, arena.size());
-  writeInt32(&out, streams.size());
-
-  for (auto& stream : streams) {
-    stream->flush(&out);
-  }
-
-  const int32_t uncompressedSize = out.tellp();
+  auto iobuf = serializeStreams(streams, arena);
+  const int32_t uncompressedSize = iobuf->computeChainDataLength();
   VELOX_CHECK_LE(
       uncompressedSize,
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
-  auto iobuf = out.getIOBuf();
   const auto compressedBuffer = codec.compress(iobuf.get());
   const int32_t compressedSize = compressedBuffer->length();
   if (compressedSize > uncompressedSize * minCompressionRatio) {
@@ -3667,6 +3705,207 @@ FlushSizes flushStreams(
   }
 }
 
+// Returns the entropy in bits per byte of the byte histogram of a sample of
+// up to 'kSampleBytes' evenly spaced bytes of 'data'. Close to 8 for
+// incompressible data.
+double estimateEntropy(const folly::IOBuf& data) {
+  constexpr uint64_t kSampleBytes = 16 << 10;
+  const auto size = data.computeChainDataLength();
+  if (size == 0) {
+    return 0;
+  }
+  const uint64_t step = std::max<uint64_t>(1, size / kSampleBytes);
+  std::array<uint32_t, 256> counts{};
+  uint64_t numSampled = 0;
+  uint64_t offset = 0;
+  for (const auto range : data) {
+    // The first sampled byte of 'range'.
+    auto i = (step - offset % step) % step;
+    for (; i < range.size(); i += step) {
+      ++counts[range[i]];
+      ++numSampled;
+    }
+    offset += range.size();
+  }
+  double entropy = 0;
+  for (const auto count : counts) {
+    if (count > 0) {
+      const double p = static_cast<double>(count) / numSampled;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+// Chooses the codec of each page for PrestoOptions::adaptiveCompression.
+// Keeps a decayed average of the compression ratio and speed of LZ4 and
+// ZSTD. Skips compression for pages with high entropy. Otherwise picks the
+// codec with the least time to compress and transfer the page at the
+// network throughput, or LZ4 if the throughput is not known.
+class CompressionSelector {
+ public:
+  struct CodecStats {
+    int64_t inputBytes{0};
+    int64_t compressedBytes{0};
+    int64_t nanos{0};
+  };
+
+  explicit CompressionSelector(std::function<uint64_t()> networkBytesPerSecond)
+      : networkBytesPerSecond_(std::move(networkBytesPerSecond)) {
+    codecs_[kLz4].kind = common::CompressionKind::CompressionKind_LZ4;
+    // Priors before the first pages.
+    codecs_[kLz4].ratio = 0.5;
+    codecs_[kLz4].nanosPerByte = 2;
+    codecs_[kZstd].kind = common::CompressionKind::CompressionKind_ZSTD;
+    codecs_[kZstd].ratio = 0.35;
+    codecs_[kZstd].nanosPerByte = 8;
+    for (auto& codec : codecs_) {
+      codec.codec = common::compressionKindToCodec(codec.kind);
+    }
+  }
+
+  // Returns the index of the codec for 'page' or -1 for no compression.
+  int32_t select(const folly::IOBuf& page) {
+    constexpr double kMaxEntropy = 7.5;
+    constexpr int64_t kMinCompressBytes = 512;
+    if (page.computeChainDataLength() < kMinCompressBytes ||
+        estimateEntropy(page) > kMaxEntropy) {
+      return -1;
+    }
+    const auto networkBytesPerSecond =
+        networkBytesPerSecond_ ? networkBytesPerSecond_() : 0;
+    if (networkBytesPerSecond == 0) {
+      return kLz4;
+    }
+    // The time to compress a byte and to send its compressed bytes.
+    const double networkNanosPerByte = 1e9 / networkBytesPerSecond;
+    const auto cost = [&](const Codec& codec) {
+      return codec.nanosPerByte + codec.ratio * networkNanosPerByte;
+    };
+    const int32_t best =
+        cost(codecs_[kZstd]) < cost(codecs_[kLz4]) ? kZstd : kLz4;
+    // Tries the other codec now and then to keep its averages current.
+    constexpr int32_t kProbeInterval = 32;
+    return ++numSelected_ % kProbeInterval == 0 ? 1 - best : best;
+  }
+
+  folly::io::Codec& codec(int32_t index) {
+    return *codecs_[index].codec;
+  }
+
+  common::CompressionKind kind(int32_t index) const {
+    return codecs_[index].kind;
+  }
+
+  // Records the compression of 'inputBytes' into 'compressedBytes' with the
+  // codec at 'index' in 'nanos'.
+  void record(
+      int32_t index,
+      int64_t inputBytes,
+      int64_t compressedBytes,
+      int64_t nanos) {
+    constexpr double kDecay = 0.9;
+    auto& codec = codecs_[index];
+    codec.ratio = kDecay * codec.ratio +
+        (1 - kDecay) * compressedBytes / static_cast<double>(inputBytes);
+    codec.nanosPerByte = kDecay * codec.nanosPerByte +
+        (1 - kDecay) * nanos / static_cast<double>(inputBytes);
+    codec.stats.inputBytes += inputBytes;
+    codec.stats.compressedBytes += compressedBytes;
+    codec.stats.nanos += nanos;
+  }
+
+  const CodecStats& stats(int32_t index) const {
+    return codecs_[index].stats;
+  }
+
+  // The maximum compressed size of 'size' bytes over the codecs.
+  uint64_t maxCompressedLength(uint64_t size) const {
+    uint64_t length = size;
+    for (const auto& codec : codecs_) {
+      length = std::max(length, codec.codec->maxCompressedLength(size));
+    }
+    return length;
+  }
+
+  static constexpr int32_t kLz4 = 0;
+  static constexpr int32_t kZstd = 1;
+  static constexpr int32_t kNumCodecs = 2;
+
+ private:
+  struct Codec {
+    common::CompressionKind kind;
+    std::unique_ptr<folly::io::Codec> codec;
+    // Decayed averages of compressed / input bytes and of compression time.
+    double ratio;
+    double nanosPerByte;
+    CodecStats stats;
+  };
+
+  const std::function<uint64_t()> networkBytesPerSecond_;
+  std::array<Codec, kNumCodecs> codecs_;
+  int64_t numSelected_{0};
+};
+
+// Writes 'streams' as a page compressed with the codec chosen by 'selector'.
+// Writes the page uncompressed if no codec is chosen or the compression
+// does not reach 'minCompressionRatio'.
+FlushSizes flushAdaptive(
+    const std::vector<std::unique_ptr<VectorStream>>& streams,
+    const StreamArena& arena,
+    CompressionSelector& selector,
+    int32_t numRows,
+    float minCompressionRatio,
+    OutputStream* output) {
+  auto listener = dynamic_cast<PrestoOutputStreamListener*>(output->listener());
+  char codecMask = 0;
+  if (listener) {
+    listener->reset();
+    codecMask |= kCheckSumBitMask;
+    // Pause CRC computation
+    listener->pause();
+  }
+
+  writeInt32(output, numRows);
+  auto iobuf = serializeStreams(streams, arena);
+  const int32_t uncompressedSize = iobuf->computeChainDataLength();
+  const auto index = selector.select(*iobuf);
+  if (index >= 0) {
+    auto& codec = selector.codec(index);
+    VELOX_CHECK_LE(
+        uncompressedSize,
+        codec.maxUncompressedLength(),
+        "UncompressedSize exceeds limit");
+    const auto start = std::chrono::steady_clock::now();
+    const auto compressedBuffer = codec.compress(iobuf.get());
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    const int32_t compressedSize = compressedBuffer->computeChainDataLength();
+    selector.record(index, uncompressedSize, compressedSize, nanos);
+    if (compressedSize <= uncompressedSize * minCompressionRatio) {
+      flushSerialization(
+          numRows,
+          uncompressedSize,
+          compressedSize,
+          codecMask | kCompressedBitMask | codecKindBits(selector.kind(index)),
+          compressedBuffer,
+          output,
+          listener);
+      return {uncompressedSize, compressedSize};
+    }
+  }
+  flushSerialization(
+      numRows,
+      uncompressedSize,
+      uncompressedSize,
+      codecMask,
+      iobuf,
+      output,
+      listener);
+  return {uncompressedSize, uncompressedSize};
+}
+
 template <TypeKind Kind>
 void estimateConstantSerializedSize(
     const VectorPtr& vector,
@@ -3939,7 +4178,11 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
+        codec_(common::compressionKindToCodec(opts.compressionKind)),
+        selector_(
+            opts.adaptiveCompression ? std::make_unique<CompressionSelector>(
+                                           opts.networkBytesPerSecond)
+                                     : nullptr) {
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3984,6 +4227,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       dataSize += stream->serializedSize();
     }
 
+    if (selector_ != nullptr) {
+      return kHeaderSize + selector_->maxCompressedLength(dataSize);
+    }
     auto compressedSize = needCompression(*codec_)
         ? codec_->maxCompressedLength(dataSize)
         : dataSize;
@@ -3995,6 +4241,22 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // checksum(8) | data
   void flush(OutputStream* out) override {
     constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+    if (selector_ != nullptr) {
+      auto [size, compressedSize] = flushAdaptive(
+          streams_,
+          *streamArena_,
+          *selector_,
+          numRows_,
+          opts_.minCompressionRatio,
+          out);
+      if (compressedSize < size) {
+        stats_.compressionInputBytes += size;
+        stats_.compressedBytes += compressedSize;
+      } else {
+        stats_.compressionSkippedBytes += size;
+      }
+      return;
+    }
     if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
@@ -4041,6 +4303,22 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
          {"compressionSkippedBytes",
           RuntimeCounter(
               stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+    if (selector_ != nullptr) {
+      for (auto i = 0; i < CompressionSelector::kNumCodecs; ++i) {
+        const auto name =
+            i == CompressionSelector::kLz4 ? std::string("lz4") : "zstd";
+        const auto& codecStats = selector_->stats(i);
+        map.insert(
+            {{name + "CompressionInputBytes",
+              RuntimeCounter(
+                  codecStats.inputBytes, RuntimeCounter::Unit::kBytes)},
+             {name + "CompressedBytes",
+              RuntimeCounter(
+                  codecStats.compressedBytes, RuntimeCounter::Unit::kBytes)},
+             {name + "CompressionTimeNanos",
+              RuntimeCounter(codecStats.nanos, RuntimeCounter::Unit::kNanos)}});
+      }
+    }
     return map;
   }
 
@@ -4070,6 +4348,8 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  // Chooses the codec of each page if 'opts_.adaptiveCompression' is set.
+  const std::unique_ptr<CompressionSelector> selector_;
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
@@ -4234,9 +4514,15 @@ void PrestoVectorSerde::deserialize(
     source->readBytes(compressBuf->writableData(), header.compressedSize);
     compressBuf->append(header.compressedSize);
 
+    // Pages written with adaptive compression carry their codec.
+    std::unique_ptr<folly::io::Codec> pageCodec;
+    if (const auto kind = codecKindFromMarker(header.pageCodecMarker)) {
+      pageCodec = common::compressionKindToCodec(kind.value());
+    }
     // Process chained uncompressed results IOBufs.
-    auto uncompress =
-        codec->uncompress(compressBuf.get(), header.uncompressedSize);
+    auto uncompress = (pageCodec ? pageCodec : codec)
+                          ->uncompress(
+                              compressBuf.get(), header.uncompressedSize);
     auto uncompressedSource = std::make_unique<BufferInputStream>(
         byteRangesFromIOBuf(uncompress.get()));
     readTopColumns(
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <string_view>
 
 #include "velox/common/base/Crc.h"
@@ -79,6 +80,19 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, the iterative serializer chooses the codec of each page
+    /// between none, LZ4 and ZSTD instead of using 'compressionKind'. The
+    /// choice is based on a sampled entropy estimate of the page, the
+    /// observed speed and ratio of the codecs and 'networkBytesPerSecond'.
+    /// The codec is recorded in the page header so that the reader does not
+    /// need to know it. Not understood by Presto Java readers.
+    bool adaptiveCompression{false};
+
+    /// Returns the current throughput in bytes per second of the network the
+    /// pages are sent over for 'adaptiveCompression'. Compressible pages use
+    /// LZ4 if not set or if it returns 0.
+    std::function<uint64_t()> networkBytesPerSecond;
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
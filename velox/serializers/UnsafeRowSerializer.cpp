@@ -15,7 +15,6 @@
  */
 #include "velox/serializers/UnsafeRowSerializer.h"
 #include <folly/lang/Bits.h>
-#include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 
 namespace facebook::velox::serializer::spark {
@@ -162,7 +161,7 @@ void UnsafeRowVectorSerde::deserialize(
     RowTypePtr type,
     RowVectorPtr* result,
     const Options* /* options */) {
-  std::vector<std::optional<std::string_view>> serializedRows;
+  std::vector<std::string_view> serializedRows;
   std::vector<std::unique_ptr<std::string>> serializedBuffers;
 
   while (!source->atEnd()) {
@@ -190,9 +189,7 @@ void UnsafeRowVectorSerde::deserialize(
     return;
   }
 
-  *result = std::dynamic_pointer_cast<RowVector>(
-      velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+  *result = velox::row::UnsafeRowFast::deserialize(serializedRows, type, pool);
 }
 
 // static
@@ -31,7 +31,42 @@ class RowSerializerBenchmark {
     deregisterVectorSerde();
   }
 
+  // Serializes every other row by row number as PartitionedOutput does for
+  // one of two destinations.
+  void compactRowVectorSerdeRows(const RowTypePtr& rowType) {
+    serializer::CompactRowVectorSerde::registerVectorSerde();
+    serializeRows(rowType);
+    deregisterVectorSerde();
+  }
+
  private:
+  void serializeRows(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    std::vector<vector_size_t> rows;
+    for (auto row = 0; row < data->size(); row += 2) {
+      rows.push_back(row);
+    }
+    std::vector<vector_size_t> sizes(data->size());
+    std::vector<vector_size_t*> sizePointers(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      sizePointers[i] = &sizes[i];
+    }
+    suspender.dismiss();
+
+    row::CompactRow compactRow(data);
+    const auto rowRange = folly::Range(rows.data(), rows.size());
+    getVectorSerde()->estimateSerializedSize(
+        &compactRow, rowRange, sizePointers.data());
+    auto group = std::make_unique<VectorStreamGroup>(pool_.get(), nullptr);
+    group->createStreamTree(rowType, rows.size());
+    group->append(compactRow, rowRange, sizes);
+
+    std::stringstream stream;
+    OStreamOutputStream outputStream(&stream);
+    group->flush(&outputStream);
+  }
+
   void serialize(const RowTypePtr& rowType, vector_size_t rangeSize) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -83,7 +118,22 @@ class RowSerializerBenchmark {
   BENCHMARK(compact_serialize_1000_##name) {         \
     RowSerializerBenchmark benchmark;                \
     benchmark.compactRowVectorSerde(rowType, 1'000); \
+  }                                                  \
+  BENCHMARK(compact_serialize_rows_##name) {         \
+    RowSerializerBenchmark benchmark;                \
+    benchmark.compactRowVectorSerdeRows(rowType);    \
+  }
+
+// Returns a row type with 'numColumns' columns cycling through 'types'.
+RowTypePtr wideRowType(
+    int32_t numColumns,
+    const std::vector<TypePtr>& types) {
+  std::vector<TypePtr> children;
+  for (auto i = 0; i < numColumns; ++i) {
+    children.push_back(types[i % types.size()]);
   }
+  return ROW(std::move(children));
+}
 
 VECTOR_SERDE_BENCHMARKS(
     fixedWidth5,
@@ -139,6 +189,18 @@ VECTOR_SERDE_BENCHMARKS(
     structs,
     ROW({BIGINT(), ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()})}));
 
+VECTOR_SERDE_BENCHMARKS(
+    wideFixedWidth100,
+    wideRowType(100, {BIGINT(), DOUBLE(), INTEGER(), BOOLEAN()}));
+
+VECTOR_SERDE_BENCHMARKS(
+    wideMixed100,
+    wideRowType(100, {BIGINT(), VARCHAR(), DOUBLE(), VARCHAR(), INTEGER()}));
+
+VECTOR_SERDE_BENCHMARKS(
+    wideMixed500,
+    wideRowType(500, {BIGINT(), VARCHAR(), DOUBLE(), BOOLEAN()}));
+
 } // namespace
 } // namespace facebook::velox::test
 
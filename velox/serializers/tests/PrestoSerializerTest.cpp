@@ -1525,6 +1525,60 @@ TEST_P(PrestoSerializerTest, checksum) {
       "Received corrupted serialized page.");
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  // Compressible and random data. The reader uses the compression kind of the
+  // test parameter, which the codec recorded in each page overrides.
+  const vector_size_t numRows = 10'000;
+  std::vector<RowVectorPtr> inputs = {
+      makeRowVector({makeFlatVector<int64_t>(
+          numRows, [](auto row) { return row % 7; })}),
+      makeRowVector({makeFlatVector<int64_t>(
+          numRows, [](auto /*row*/) { return folly::Random::rand64(); })})};
+  std::vector<uint64_t> networkBytesPerSecond = {0, 10 << 20, 10UL << 30};
+  for (const auto throughput : networkBytesPerSecond) {
+    SCOPED_TRACE(fmt::format("throughput {}", throughput));
+    serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions;
+    serdeOptions.adaptiveCompression = true;
+    serdeOptions.networkBytesPerSecond = [throughput]() { return throughput; };
+    for (auto i = 0; i < inputs.size(); ++i) {
+      const auto& input = inputs[i];
+      const auto rowType = asRowType(input->type());
+      StreamArena arena(pool_.get());
+      auto serializer = serde_->createIterativeSerializer(
+          rowType, numRows, &arena, &serdeOptions);
+      serializer->append(input);
+      const auto maxSize = serializer->maxSerializedSize();
+      std::ostringstream output;
+      serializer::presto::PrestoOutputStreamListener listener;
+      OStreamOutputStream out(&output, &listener);
+      serializer->flush(&out);
+      EXPECT_GE(maxSize, output.str().size());
+
+      const auto stats = serializer->runtimeStats();
+      const auto compressedBytes = stats.at("lz4CompressedBytes").value +
+          stats.at("zstdCompressedBytes").value;
+      if (i == 0) {
+        // Only the compressible data is compressed.
+        EXPECT_GT(compressedBytes, 0);
+        EXPECT_LT(output.str().size(), numRows * sizeof(int64_t) / 2);
+        if (throughput == 0) {
+          EXPECT_EQ(stats.at("zstdCompressionInputBytes").value, 0);
+        }
+      } else {
+        EXPECT_EQ(compressedBytes, 0);
+        EXPECT_GT(stats.at("compressionSkippedBytes").value, 0);
+      }
+      auto paramOptions = getParamSerdeOptions(nullptr);
+      auto serialized = output.str();
+      auto byteStream = toByteStream(serialized);
+      RowVectorPtr result;
+      serde_->deserialize(
+          byteStream.get(), pool_.get(), rowType, &result, 0, &paramOptions);
+      assertEqualVectors(input, result);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PrestoSerializerTest,
     PrestoSerializerTest,
@@ -15,6 +15,7 @@
  */
 
 #include "velox/substrait/SubstraitParser.h"
+#include <folly/Synchronized.h>
 #include <string>
 #include "velox/common/base/Exceptions.h"
 #include "velox/substrait/TypeUtils.h"
@@ -22,6 +23,39 @@
 
 namespace facebook::velox::substrait {
 
+namespace {
+// Results of resolving function specifications, shared by all plan
+// conversions. Entries are never removed, so that references to the values
+// stay valid.
+template <typename T>
+using SpecCache = folly::Synchronized<std::unordered_map<std::string, T>>;
+
+template <typename T, typename Make>
+const T& cachedValue(SpecCache<T>& cache, const std::string& key, Make make) {
+  {
+    auto values = cache.rlock();
+    auto it = values->find(key);
+    if (it != values->end()) {
+      return it->second;
+    }
+  }
+  // Computed outside of the lock. Another thread may insert the same key
+  // first, in which case its value is kept.
+  auto value = make();
+  return cache.wlock()->emplace(key, std::move(value)).first->second;
+}
+
+SpecCache<std::string>& veloxFunctionNames() {
+  static SpecCache<std::string> names;
+  return names;
+}
+
+SpecCache<std::vector<TypePtr>>& signatureInputTypes() {
+  static SpecCache<std::vector<TypePtr>> types;
+  return types;
+}
+} // namespace
+
 TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
   switch (substraitType.kind_case()) {
     case ::substrait::Type::KindCase::kBool:
@@ -144,20 +178,25 @@ int SubstraitParser::getIdxFromNodeName(const std::string& nodeName) {
 const std::string& SubstraitParser::findFunctionSpec(
     const std::unordered_map<uint64_t, std::string>& functionMap,
     uint64_t id) const {
-  if (functionMap.find(id) == functionMap.end()) {
+  auto it = functionMap.find(id);
+  if (it == functionMap.end()) {
     VELOX_FAIL("Could not find function id {} in function map.", id);
   }
-  std::unordered_map<uint64_t, std::string>& map =
-      const_cast<std::unordered_map<uint64_t, std::string>&>(functionMap);
-  return map[id];
+  return it->second;
 }
 
-std::string SubstraitParser::findVeloxFunction(
+const std::string& SubstraitParser::findVeloxFunction(
     const std::unordered_map<uint64_t, std::string>& functionMap,
     uint64_t id) const {
-  std::string funcSpec = findFunctionSpec(functionMap, id);
-  std::string_view funcName = getNameBeforeDelimiter(funcSpec, ":");
-  return mapToVeloxFunction({funcName.begin(), funcName.end()});
+  return veloxFunction(findFunctionSpec(functionMap, id));
+}
+
+const std::string& SubstraitParser::veloxFunction(
+    const std::string& functionSpec) const {
+  return cachedValue(veloxFunctionNames(), functionSpec, [&]() {
+    std::string_view funcName = getNameBeforeDelimiter(functionSpec, ":");
+    return mapToVeloxFunction({funcName.begin(), funcName.end()});
+  });
 }
 
 std::string SubstraitParser::mapToVeloxFunction(
@@ -202,16 +241,18 @@ std::vector<std::string> SubstraitParser::getSubFunctionTypes(
   return types;
 }
 
-std::vector<TypePtr> SubstraitParser::getInputTypes(
+const std::vector<TypePtr>& SubstraitParser::getInputTypes(
     const std::string& signature) {
-  std::vector<std::string> typeStrs = getSubFunctionTypes(signature);
-  std::vector<TypePtr> types;
-  types.reserve(typeStrs.size());
-  for (const auto& typeStr : typeStrs) {
-    types.emplace_back(
-        VeloxSubstraitSignature::fromSubstraitSignature(typeStr));
-  }
-  return types;
+  return cachedValue(signatureInputTypes(), signature, [&]() {
+    std::vector<std::string> typeStrs = getSubFunctionTypes(signature);
+    std::vector<TypePtr> types;
+    types.reserve(typeStrs.size());
+    for (const auto& typeStr : typeStrs) {
+      types.emplace_back(
+          VeloxSubstraitSignature::fromSubstraitSignature(typeStr));
+    }
+    return types;
+  });
 }
 
 } // namespace facebook::velox::substrait
@@ -71,15 +71,22 @@ class SubstraitParser {
 
   /// Find the Velox function name according to the function id
   /// from a pre-constructed function map.
-  std::string findVeloxFunction(
+  const std::string& findVeloxFunction(
       const std::unordered_map<uint64_t, std::string>& functionMap,
       uint64_t id) const;
 
+  /// Returns the Velox function name for the Substrait function
+  /// specification 'functionSpec'. The names are resolved once per process
+  /// since the same specifications recur in all the plans of a workload.
+  const std::string& veloxFunction(const std::string& functionSpec) const;
+
   /// Map the Substrait function keyword into Velox function keyword.
   std::string mapToVeloxFunction(const std::string& substraitFunction) const;
 
-  /// Get input types from Substrait function signature.
-  static std::vector<TypePtr> getInputTypes(const std::string& signature);
+  /// Get input types from Substrait function signature. The types of a
+  /// signature are parsed once per process.
+  static const std::vector<TypePtr>& getInputTypes(
+      const std::string& signature);
 
  private:
   /// A map used for mapping Substrait function keywords into Velox functions'
@@ -30,6 +30,7 @@ class SubstraitVeloxExprConverter {
   /// subParser: A Substrait parser used to convert Substrait representations
   /// into recognizable representations. functionMap: A pre-constructed map
   /// storing the relations between the function id and the function name.
+  /// Must outlive 'this'.
   explicit SubstraitVeloxExprConverter(
       memory::MemoryPool* pool,
       const std::unordered_map<uint64_t, std::string>& functionMap)
@@ -77,8 +78,8 @@ class SubstraitVeloxExprConverter {
   SubstraitParser substraitParser_;
 
   /// The map storing the relations between the function id and the function
-  /// name.
-  std::unordered_map<uint64_t, std::string> functionMap_;
+  /// name. Owned by the plan converter.
+  const std::unordered_map<uint64_t, std::string>& functionMap_;
 };
 
 } // namespace facebook::velox::substrait
@@ -132,7 +132,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (const auto& measure : aggRel.measures()) {
     core::FieldAccessTypedExprPtr mask;
-    ::substrait::Expression substraitAggMask = measure.filter();
+    const auto& substraitAggMask = measure.filter();
     // Get Aggregation Masks.
     if (measure.has_filter()) {
       if (substraitAggMask.ByteSizeLong() > 0) {
@@ -142,7 +142,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     }
 
     const auto& aggFunction = measure.measure();
-    auto funcName = substraitParser_->findVeloxFunction(
+    const auto& funcName = substraitParser_->findVeloxFunction(
         functionMap_, aggFunction.function_reference());
 
     std::vector<core::TypedExprPtr> aggParams;
@@ -154,7 +154,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     auto aggVeloxType = substraitParser_->parseType(aggFunction.output_type());
     auto aggExpr = std::make_shared<const core::CallTypedExpr>(
         aggVeloxType, std::move(aggParams), funcName);
-    std::vector<TypePtr> rawInputTypes = SubstraitParser::getInputTypes(
+    const auto& rawInputTypes = SubstraitParser::getInputTypes(
         findFunction(aggFunction.function_reference()));
     aggregates.emplace_back(
         core::AggregationNode::Aggregate{aggExpr, rawInputTypes, mask, {}, {}});
@@ -194,7 +194,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   auto childNode = convertSingleInput<::substrait::ProjectRel>(projectRel);
 
   // Construct Velox Expressions.
-  auto projectExprs = projectRel.expressions();
+  const auto& projectExprs = projectRel.expressions();
   std::vector<std::string> projectNames;
   std::vector<core::TypedExprPtr> expressions;
   projectNames.reserve(projectExprs.size());
@@ -225,7 +225,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   }
 
   if (projectRel.has_common()) {
-    auto relCommon = projectRel.common();
+    const auto& relCommon = projectRel.common();
     const auto& emit = relCommon.emit();
     int emitSize = emit.output_mapping_size();
     std::vector<std::string> emitProjectNames(emitSize);
@@ -457,7 +457,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     const RowTypePtr& type) {
-  ::substrait::ReadRel_VirtualTable readVirtualTable = readRel.virtual_table();
+  const auto& readVirtualTable = readRel.virtual_table();
   int64_t numVectors = readVirtualTable.values_size();
   int64_t numColumns = type->size();
   int64_t valueFieldNums =
@@ -649,25 +649,25 @@ connector::hive::SubfieldFilters SubstraitVeloxPlanConverter::toVeloxFilter(
   flattenConditions(substraitFilter, scalarFunctions);
   // Construct the FilterInfo for the related column.
   for (const auto& scalarFunction : scalarFunctions) {
-    auto filterNameSpec = substraitParser_->findFunctionSpec(
+    const auto& filterNameSpec = substraitParser_->findFunctionSpec(
         functionMap_, scalarFunction.function_reference());
     auto filterName = getNameBeforeDelimiter(filterNameSpec, ":");
     int32_t colIdx;
     // TODO: Add different types' support here.
     double val;
     for (auto& arg : scalarFunction.arguments()) {
-      auto argExpr = arg.value();
+      const auto& argExpr = arg.value();
       auto typeCase = argExpr.rex_type_case();
       switch (typeCase) {
         case ::substrait::Expression::RexTypeCase::kSelection: {
-          auto sel = argExpr.selection();
+          const auto& sel = argExpr.selection();
           // TODO: Only direct reference is considered here.
-          auto dRef = sel.direct_reference();
+          const auto& dRef = sel.direct_reference();
           colIdx = substraitParser_->parseReferenceSegment(dRef);
           break;
         }
         case ::substrait::Expression::RexTypeCase::kLiteral: {
-          auto sLit = argExpr.literal();
+          const auto& sLit = argExpr.literal();
           // TODO: Only double is considered here.
           val = sLit.fp64();
           break;
@@ -735,8 +735,8 @@ void SubstraitVeloxPlanConverter::flattenConditions(
   auto typeCase = substraitFilter.rex_type_case();
   switch (typeCase) {
     case ::substrait::Expression::RexTypeCase::kScalarFunction: {
-      auto sFunc = substraitFilter.scalar_function();
-      auto filterNameSpec = substraitParser_->findFunctionSpec(
+      const auto& sFunc = substraitFilter.scalar_function();
+      const auto& filterNameSpec = substraitParser_->findFunctionSpec(
           functionMap_, sFunc.function_reference());
       // TODO: Only and relation is supported here.
       if (getNameBeforeDelimiter(filterNameSpec, ":") == "and") {
@@ -761,9 +761,7 @@ void SubstraitVeloxPlanConverter::constructFunctionMap(
       continue;
     }
     const auto& sFmap = sExtension.extension_function();
-    auto id = sFmap.function_anchor();
-    auto name = sFmap.name();
-    functionMap_[id] = name;
+    functionMap_[sFmap.function_anchor()] = sFmap.name();
   }
 }
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+#include "velox/substrait/VeloxToSubstraitPlan.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::substrait;
+
+// Measures the conversion of short Substrait plans to Velox plans, as done
+// once per query by engines that hand Velox Substrait plans. Each
+// conversion uses a new converter like a new query would.
+
+namespace {
+
+class PlanConversionBenchmark {
+ public:
+  PlanConversionBenchmark() {
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    parse::registerTypeResolver();
+    pool_ = memory::memoryManager()->addLeafPool();
+    test::VectorMaker maker(pool_.get());
+    auto data = maker.rowVector({
+        maker.flatVector<int64_t>({1, 2, 3}),
+        maker.flatVector<int32_t>({4, 5, 6}),
+        maker.flatVector<double>({0.5, 1.5, 2.5}),
+    });
+    project_ = toSubstrait(
+        PlanBuilder()
+            .values({data})
+            .project(
+                {"c0 + c1 as a",
+                 "c2 * 2.0 as b",
+                 "c0 - c1 as c",
+                 "c0 % 7 as d",
+                 "cast(c1 as bigint) as e"})
+            .filter("a > 2 and b < 10.0 and c <> 0")
+            .planNode());
+    aggregation_ = toSubstrait(
+        PlanBuilder()
+            .values({data})
+            .filter("c0 > 1")
+            .partialAggregation(
+                {"c1"}, {"sum(c0)", "count(c2)", "sum(c2)"})
+            .planNode());
+  }
+
+  void run(const ::substrait::Plan& plan, int32_t numConversions) {
+    for (auto i = 0; i < numConversions; ++i) {
+      SubstraitVeloxPlanConverter converter(pool_.get());
+      folly::doNotOptimizeAway(converter.toVeloxPlan(plan));
+    }
+  }
+
+  const ::substrait::Plan& project() const {
+    return *project_;
+  }
+
+  const ::substrait::Plan& aggregation() const {
+    return *aggregation_;
+  }
+
+ private:
+  std::unique_ptr<::substrait::Plan> toSubstrait(
+      const core::PlanNodePtr& plan) {
+    VeloxToSubstraitPlanConvertor converter;
+    auto& substraitPlan = converter.toSubstrait(arena_, plan);
+    auto copy = std::make_unique<::substrait::Plan>();
+    copy->CopyFrom(substraitPlan);
+    return copy;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  google::protobuf::Arena arena_;
+  std::unique_ptr<::substrait::Plan> project_;
+  std::unique_ptr<::substrait::Plan> aggregation_;
+};
+
+std::unique_ptr<PlanConversionBenchmark> benchmark;
+
+BENCHMARK_MULTI(projectFilter) {
+  constexpr int32_t kNumConversions = 1'000;
+  benchmark->run(benchmark->project(), kNumConversions);
+  return kNumConversions;
+}
+
+BENCHMARK_MULTI(aggregation) {
+  constexpr int32_t kNumConversions = 1'000;
+  benchmark->run(benchmark->aggregation(), kNumConversions);
+  return kNumConversions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<PlanConversionBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -239,4 +239,29 @@ TEST_F(FunctionTest, getInputTypes) {
   ASSERT_EQ(types[2]->kind(), TypeKind::TIMESTAMP);
   ASSERT_EQ(types[3]->kind(), TypeKind::INTEGER);
   ASSERT_EQ(types[4]->kind(), TypeKind::DOUBLE);
+
+  // The types of a signature are parsed once.
+  ASSERT_EQ(
+      &SubstraitParser::getInputTypes("and:opt_bool_bool"),
+      &SubstraitParser::getInputTypes("and:opt_bool_bool"));
+}
+
+TEST_F(FunctionTest, veloxFunction) {
+  ASSERT_EQ(substraitParser_->veloxFunction("add:i32_i32"), "plus");
+  ASSERT_EQ(substraitParser_->veloxFunction("not_equal:i64_i64"), "neq");
+  ASSERT_EQ(substraitParser_->veloxFunction("sum:opt_i32"), "sum");
+  ASSERT_EQ(substraitParser_->veloxFunction("lower"), "lower");
+
+  // Resolved once and shared between parsers.
+  SubstraitParser otherParser;
+  ASSERT_EQ(
+      &substraitParser_->veloxFunction("add:i32_i32"),
+      &otherParser.veloxFunction("add:i32_i32"));
+
+  std::unordered_map<uint64_t, std::string> functionMap = {
+      {0, "subtract:i32_i32"}};
+  ASSERT_EQ(substraitParser_->findVeloxFunction(functionMap, 0), "minus");
+  VELOX_ASSERT_THROW(
+      substraitParser_->findVeloxFunction(functionMap, 1),
+      "Could not find function id 1 in function map.");
 }
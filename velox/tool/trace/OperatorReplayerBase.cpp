@@ -72,6 +72,38 @@ RowVectorPtr OperatorReplayerBase::run() {
       .copyResults(memory::MemoryManager::getInstance()->tracePool());
 }
 
+std::shared_ptr<exec::Task> OperatorReplayerBase::runTask(
+    int32_t numDrivers,
+    const std::shared_ptr<core::QueryCtx>& queryCtx,
+    const std::unordered_map<std::string, std::string>& configOverrides,
+    const std::string& spillDirectory) {
+  std::shared_ptr<exec::Task> task;
+  makeTaskBuilder(numDrivers, queryCtx, configOverrides, spillDirectory)
+      ->countResults(task);
+  return task;
+}
+
+std::unique_ptr<exec::test::AssertQueryBuilder>
+OperatorReplayerBase::makeTaskBuilder(
+    int32_t numDrivers,
+    const std::shared_ptr<core::QueryCtx>& queryCtx,
+    const std::unordered_map<std::string, std::string>& configOverrides,
+    const std::string& spillDirectory) const {
+  auto configs = queryConfigs_;
+  for (const auto& [key, value] : configOverrides) {
+    configs[key] = value;
+  }
+  auto builder = std::make_unique<exec::test::AssertQueryBuilder>(createPlan());
+  builder->maxDrivers(numDrivers)
+      .queryCtx(queryCtx)
+      .configs(configs)
+      .connectorSessionProperties(connectorConfigs_);
+  if (!spillDirectory.empty()) {
+    builder->spillDirectory(spillDirectory);
+  }
+  return builder;
+}
+
 core::PlanNodePtr OperatorReplayerBase::createPlan() const {
   const auto* replayNode = core::PlanNode::findFirstNode(
       planFragment_.get(),
@@ -20,10 +20,18 @@
 #include "velox/core/PlanNode.h"
 #include "velox/parse/PlanNodeIdGenerator.h"
 
+namespace facebook::velox::core {
+class QueryCtx;
+}
+
 namespace facebook::velox::exec {
 class Task;
 }
 
+namespace facebook::velox::exec::test {
+class AssertQueryBuilder;
+}
+
 namespace facebook::velox::tool::trace {
 class OperatorReplayerBase {
  public:
@@ -43,6 +51,22 @@ class OperatorReplayerBase {
 
   virtual RowVectorPtr run();
 
+  /// Replays the traced operator like run() without copying the results and
+  /// returns the task for its stats. Used by the benchmark mode of the
+  /// replayer. Runs with 'numDrivers' drivers in 'queryCtx', whose pool may
+  /// limit the memory of the replay. 'configOverrides' are applied on top of
+  /// the traced query configs. Spills to 'spillDirectory' if not empty.
+  virtual std::shared_ptr<exec::Task> runTask(
+      int32_t numDrivers,
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const std::unordered_map<std::string, std::string>& configOverrides,
+      const std::string& spillDirectory);
+
+  /// Returns the number of drivers of the traced pipeline.
+  uint32_t maxDrivers() const {
+    return maxDrivers_;
+  }
+
  protected:
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -51,6 +75,13 @@ class OperatorReplayerBase {
 
   core::PlanNodePtr createPlan() const;
 
+  /// Returns an AssertQueryBuilder for the replay in runTask().
+  std::unique_ptr<exec::test::AssertQueryBuilder> makeTaskBuilder(
+      int32_t numDrivers,
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const std::unordered_map<std::string, std::string>& configOverrides,
+      const std::string& spillDirectory) const;
+
   const std::string queryId_;
   const std::string taskId_;
   const std::string nodeId_;
@@ -146,6 +146,14 @@ RowVectorPtr PartitionedOutputReplayer::run() {
   return nullptr;
 }
 
+std::shared_ptr<exec::Task> PartitionedOutputReplayer::runTask(
+    int32_t /*numDrivers*/,
+    const std::shared_ptr<core::QueryCtx>& /*queryCtx*/,
+    const std::unordered_map<std::string, std::string>& /*configOverrides*/,
+    const std::string& /*spillDirectory*/) {
+  VELOX_UNSUPPORTED("Benchmarking PartitionedOutput replay is not supported");
+}
+
 core::PlanNodePtr PartitionedOutputReplayer::createPlanNode(
     const core::PlanNode* node,
     const core::PlanNodeId& nodeId,
@@ -161,7 +169,9 @@ core::PlanNodePtr PartitionedOutputReplayer::createPlanNode(
       originalNode->partitionFunctionSpecPtr(),
       originalNode->outputType(),
       serdeKind_,
-      source);
+      source,
+      originalNode->skewedJoin(),
+      originalNode->combiner());
 }
 
 } // namespace facebook::velox::tool::trace
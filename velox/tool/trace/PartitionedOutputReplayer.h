@@ -51,6 +51,13 @@ class PartitionedOutputReplayer final : public OperatorReplayerBase {
 
   RowVectorPtr run() override;
 
+  /// Not supported since the results go to the output buffers of the task.
+  std::shared_ptr<exec::Task> runTask(
+      int32_t numDrivers,
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const std::unordered_map<std::string, std::string>& configOverrides,
+      const std::string& spillDirectory) override;
+
  private:
   core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
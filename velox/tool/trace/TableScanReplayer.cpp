@@ -37,6 +37,18 @@ RowVectorPtr TableScanReplayer::run() {
       .copyResults(memory::MemoryManager::getInstance()->tracePool());
 }
 
+std::shared_ptr<exec::Task> TableScanReplayer::runTask(
+    int32_t numDrivers,
+    const std::shared_ptr<core::QueryCtx>& queryCtx,
+    const std::unordered_map<std::string, std::string>& configOverrides,
+    const std::string& spillDirectory) {
+  std::shared_ptr<exec::Task> task;
+  makeTaskBuilder(numDrivers, queryCtx, configOverrides, spillDirectory)
+      ->splits(getSplits())
+      .countResults(task);
+  return task;
+}
+
 core::PlanNodePtr TableScanReplayer::createPlanNode(
     const core::PlanNode* node,
     const core::PlanNodeId& nodeId,
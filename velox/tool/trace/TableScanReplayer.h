@@ -39,6 +39,12 @@ class TableScanReplayer final : public OperatorReplayerBase {
 
   RowVectorPtr run() override;
 
+  std::shared_ptr<exec::Task> runTask(
+      int32_t numDrivers,
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const std::unordered_map<std::string, std::string>& configOverrides,
+      const std::string& spillDirectory) override;
+
  private:
   core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -16,10 +16,15 @@
 
 #include "velox/tool/trace/TraceReplayRunner.h"
 
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gflags/gflags.h>
 
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveDataSink.h"
@@ -33,10 +38,13 @@
 #include "velox/dwio/dwrf/RegisterDwrfWriter.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/RegisterParquetWriter.h"
+#include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/OperatorTraceReader.h"
 #include "velox/exec/PartitionFunction.h"
+#include "velox/exec/Task.h"
 #include "velox/exec/TaskTraceReader.h"
 #include "velox/exec/TraceUtil.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
@@ -83,6 +91,33 @@ DEFINE_int32(
     shuffle_serialization_format,
     0,
     "Specify the shuffle serialization format, 0: presto columnar, 1: compact row, 2: spark unsafe row.");
+DEFINE_int32(
+    benchmark_iterations,
+    0,
+    "If positive, replays the traced operator this many times per benchmark "
+    "configuration and reports the average time, throughput, CPU time and "
+    "spilled bytes instead of replaying once.");
+DEFINE_int32(
+    benchmark_warmup_iterations,
+    1,
+    "Number of untimed replays before the timed ones of each benchmark "
+    "configuration.");
+DEFINE_string(
+    benchmark_drivers,
+    "",
+    "Comma separated numbers of drivers to benchmark. Defaults to the traced "
+    "number of drivers.");
+DEFINE_string(
+    benchmark_memory_limits,
+    "",
+    "Comma separated query memory limits in bytes to benchmark, 0 for no "
+    "limit. Spilling is enabled for limited configurations. Defaults to no "
+    "limit.");
+DEFINE_string(
+    benchmark_spill_dir,
+    "",
+    "Spill directory of the benchmark replays. A temporary directory is used "
+    "if empty.");
 
 namespace facebook::velox::tool::trace {
 namespace {
@@ -209,6 +244,44 @@ void printSummary(
   }
   LOG(INFO) << summary.str();
 }
+
+template <typename T>
+std::vector<T> parseList(const std::string& list, T defaultValue) {
+  if (list.empty()) {
+    return {defaultValue};
+  }
+  std::vector<folly::StringPiece> items;
+  folly::split(',', list, items);
+  std::vector<T> values;
+  values.reserve(items.size());
+  for (const auto& item : items) {
+    values.push_back(folly::to<T>(folly::trimWhitespace(item)));
+  }
+  return values;
+}
+
+// Totals of the timed replays of one benchmark configuration.
+struct BenchmarkTotals {
+  uint64_t wallMicros{0};
+  uint64_t cpuNanos{0};
+  uint64_t sourceRows{0};
+  uint64_t spilledBytes{0};
+  int64_t peakBytes{0};
+
+  void add(const exec::TaskStats& stats) {
+    for (const auto& pipeline : stats.pipelineStats) {
+      // The first operator of a pipeline reads the traced input or the table.
+      if (!pipeline.operatorStats.empty()) {
+        sourceRows += pipeline.operatorStats[0].outputPositions;
+      }
+      for (const auto& op : pipeline.operatorStats) {
+        cpuNanos += op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+            op.finishTiming.cpuNanos + op.isBlockedTiming.cpuNanos;
+        spilledBytes += op.spilledBytes;
+      }
+    }
+  }
+};
 } // namespace
 
 TraceReplayRunner::TraceReplayRunner()
@@ -224,7 +297,13 @@ void TraceReplayRunner::init() {
   VELOX_USER_CHECK(!FLAGS_node_id.empty(), "--node_id must be provided");
   fs_ = filesystems::getFileSystem(FLAGS_root_dir, nullptr);
 
-  memory::initializeMemoryManager({});
+  memory::MemoryManagerOptions memoryOptions;
+  if (!FLAGS_benchmark_memory_limits.empty()) {
+    // Spilling at a query memory limit needs an arbitrator to reclaim memory.
+    memory::SharedArbitrator::registerFactory();
+    memoryOptions.arbitratorKind = "SHARED";
+  }
+  memory::initializeMemoryManager(memoryOptions);
   filesystems::registerLocalFileSystem();
   filesystems::registerS3FileSystem();
   filesystems::registerHdfsFileSystem();
@@ -353,6 +432,92 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
+  if (FLAGS_benchmark_iterations > 0) {
+    runBenchmark(*createReplayer());
+    return;
+  }
   createReplayer()->run();
 }
+
+void TraceReplayRunner::runBenchmark(
+    tool::trace::OperatorReplayerBase& replayer) {
+  const auto driverCounts = parseList<int32_t>(
+      FLAGS_benchmark_drivers, static_cast<int32_t>(replayer.maxDrivers()));
+  const auto memoryLimits =
+      parseList<int64_t>(FLAGS_benchmark_memory_limits, 0);
+  std::shared_ptr<exec::test::TempDirectoryPath> tempSpillDir;
+  std::string spillDir = FLAGS_benchmark_spill_dir;
+  if (spillDir.empty()) {
+    tempSpillDir = exec::test::TempDirectoryPath::create();
+    spillDir = tempSpillDir->getPath();
+  }
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+      std::thread::hardware_concurrency(),
+      std::make_shared<folly::NamedThreadFactory>("TraceReplayBenchmark"));
+
+  std::ostringstream report;
+  report << "\n++++++Trace replay benchmark of node " << FLAGS_node_id
+         << "++++++\n";
+  int32_t queryCounter = 0;
+  for (const auto numDrivers : driverCounts) {
+    VELOX_USER_CHECK_GT(numDrivers, 0, "--benchmark_drivers must be positive");
+    for (const auto memoryLimit : memoryLimits) {
+      std::unordered_map<std::string, std::string> configOverrides;
+      if (memoryLimit > 0) {
+        configOverrides[core::QueryConfig::kSpillEnabled] = "true";
+        configOverrides[core::QueryConfig::kAggregationSpillEnabled] = "true";
+        configOverrides[core::QueryConfig::kJoinSpillEnabled] = "true";
+        configOverrides[core::QueryConfig::kOrderBySpillEnabled] = "true";
+      }
+      BenchmarkTotals totals;
+      const auto numRuns =
+          FLAGS_benchmark_warmup_iterations + FLAGS_benchmark_iterations;
+      for (auto i = 0; i < numRuns; ++i) {
+        const auto queryId =
+            fmt::format("trace_replay_benchmark_{}", queryCounter++);
+        auto queryCtx = core::QueryCtx::create(
+            executor.get(),
+            core::QueryConfig({}),
+            {},
+            cache::AsyncDataCache::getInstance(),
+            memory::memoryManager()->addRootPool(
+                queryId,
+                memoryLimit > 0 ? memoryLimit : memory::kMaxMemory,
+                exec::MemoryReclaimer::create()),
+            nullptr,
+            queryId);
+        std::shared_ptr<exec::Task> task;
+        uint64_t wallMicros{0};
+        {
+          MicrosecondTimer timer(&wallMicros);
+          task = replayer.runTask(
+              numDrivers,
+              queryCtx,
+              configOverrides,
+              memoryLimit > 0 ? spillDir : "");
+        }
+        if (i < FLAGS_benchmark_warmup_iterations) {
+          continue;
+        }
+        totals.wallMicros += wallMicros;
+        totals.add(task->taskStats());
+        totals.peakBytes =
+            std::max(totals.peakBytes, queryCtx->pool()->peakBytes());
+      }
+
+      const auto iterations = FLAGS_benchmark_iterations;
+      report << "drivers: " << numDrivers << ", memory limit: "
+             << (memoryLimit > 0 ? succinctBytes(memoryLimit) : "none")
+             << ", time: " << succinctMicros(totals.wallMicros / iterations)
+             << ", source rows/s: "
+             << (totals.wallMicros == 0
+                     ? 0
+                     : totals.sourceRows * 1'000'000 / totals.wallMicros)
+             << ", cpu: " << succinctNanos(totals.cpuNanos / iterations)
+             << ", spilled: " << succinctBytes(totals.spilledBytes / iterations)
+             << ", peak memory: " << succinctBytes(totals.peakBytes) << "\n";
+    }
+  }
+  LOG(INFO) << report.str();
+}
 } // namespace facebook::velox::tool::trace
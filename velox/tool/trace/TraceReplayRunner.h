@@ -32,6 +32,11 @@ DECLARE_int32(driver_id);
 DECLARE_string(table_writer_output_dir);
 DECLARE_double(hiveConnectorExecutorHwMultiplier);
 DECLARE_int32(shuffle_serialization_format);
+DECLARE_int32(benchmark_iterations);
+DECLARE_int32(benchmark_warmup_iterations);
+DECLARE_string(benchmark_drivers);
+DECLARE_string(benchmark_memory_limits);
+DECLARE_string(benchmark_spill_dir);
 
 namespace facebook::velox::tool::trace {
 
@@ -52,6 +57,11 @@ class TraceReplayRunner {
  private:
   std::unique_ptr<tool::trace::OperatorReplayerBase> createReplayer() const;
 
+  // Replays the traced operator --benchmark_iterations times for each
+  // combination of --benchmark_drivers and --benchmark_memory_limits and
+  // logs the average time, throughput, CPU time and spilled bytes.
+  void runBenchmark(tool::trace::OperatorReplayerBase& replayer);
+
   const std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::shared_ptr<filesystems::FileSystem> fs_;
 };
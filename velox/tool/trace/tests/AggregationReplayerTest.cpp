@@ -208,4 +208,45 @@ TEST_F(AggregationReplayerTest, test) {
     assertEqualResults({results}, {replayingResult});
   }
 }
+
+TEST_F(AggregationReplayerTest, runTask) {
+  const auto data = generateInput(groupingKeys_, keyTypes_);
+  const auto sourceFilePath = TempFilePath::create();
+  writeToFile(sourceFilePath->getPath(), data);
+  const auto& plan = aggregatePlans(asRowType(data[0]->type()))[0].plan;
+  const auto testDir = TempDirectoryPath::create();
+  const auto traceRoot = fmt::format("{}/{}", testDir->getPath(), "traceRoot");
+  std::shared_ptr<Task> task;
+  auto results =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kQueryTraceEnabled, true)
+          .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+          .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+          .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+          .config(core::QueryConfig::kQueryTraceNodeIds, traceNodeId_)
+          .split(makeHiveConnectorSplit(sourceFilePath->getPath()))
+          .copyResults(pool(), task);
+
+  AggregationReplayer replayer(
+      traceRoot,
+      task->queryCtx()->queryId(),
+      task->taskId(),
+      traceNodeId_,
+      "Aggregation");
+  // Replays repeatedly as in the benchmark mode of the replayer.
+  for (auto i = 0; i < 3; ++i) {
+    auto queryCtx = core::QueryCtx::create(driverExecutor_.get());
+    auto replayTask =
+        replayer.runTask(replayer.maxDrivers(), queryCtx, {}, "");
+    uint64_t numRows = 0;
+    for (const auto& pipeline : replayTask->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == "Aggregation") {
+          numRows += op.outputPositions;
+        }
+      }
+    }
+    ASSERT_EQ(numRows, results->size());
+  }
+}
 } // namespace facebook::velox::tool::trace::test
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +196,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -435,6 +443,39 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return true;
 }
 
+std::string BigintValuesUsingBloomFilter::serializeBloomFilter() const {
+  std::string serialized(BloomFilter<>::serializedSize(numWords_), '\0');
+  BloomFilter<>::serialize(bits_, numWords_, serialized.data());
+  return serialized;
+}
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  obj["bloomFilter"] = encoding::Base64::encode(serializeBloomFilter());
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto serialized = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  return otherBloom != nullptr && Filter::testingBaseEquals(other) &&
+      min_ == otherBloom->min_ && max_ == otherBloom->max_ &&
+      serializeBloomFilter() == otherBloom->serializeBloomFilter();
+}
+
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingHashTable");
   obj["nonNegated"] = nonNegated_->serialize();
@@ -1864,6 +1905,8 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
           std::make_unique<common::BigintRange>(lower_, upper_, false));
       return combineRangesAndNegatedValues(rangeList, vals, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1983,6 +2026,8 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
           negatedValuesToRanges(rejectedValues),
           bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2041,6 +2086,13 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     default:
       VELOX_UNREACHABLE();
   }
@@ -2134,6 +2186,13 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     default:
       VELOX_UNREACHABLE();
   }
@@ -2154,6 +2213,82 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    const uint64_t* bits,
+    int32_t numWords,
+    std::shared_ptr<const void> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)),
+      bits_(bits),
+      numWords_(numWords) {
+  VELOX_CHECK_LE(min_, max_, "min must not be greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK_GT(numWords_, 0, "Bloom filter must be initialized");
+}
+
+std::unique_ptr<BigintValuesUsingBloomFilter>
+BigintValuesUsingBloomFilter::withRange(
+    int64_t min,
+    int64_t max,
+    bool nullAllowed) const {
+  return std::unique_ptr<BigintValuesUsingBloomFilter>(
+      new BigintValuesUsingBloomFilter(
+          min, max, bits_, numWords_, bloomFilter_, nullAllowed));
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return withRange(min, max, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+      // The exact IN-list is filtered through 'this'.
+      return other->mergeWith(this);
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // The Bloom filters may differ in size and cannot be combined bit by
+      // bit. Keeping only one of them is correct since a Bloom filter never
+      // rejects a value that should pass but makes the result less selective.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min_);
+      auto max = std::min(max_, otherBloom->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return withRange(min, max, bothNullAllowed);
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange:
+      // These cannot be combined with a Bloom filter. Drop the Bloom filter
+      // and keep the exact filter, which passes a superset of the values
+      // passing the conjunction.
+      return other->clone(bothNullAllowed);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2188,6 +2323,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
       return other->mergeWith(this);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2232,6 +2369,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return combineNegatedBigintLists(
           values(), otherBitmask->values(), bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2305,6 +2444,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return combineRangesAndNegatedValues(ranges_, rejects, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
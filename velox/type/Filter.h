@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1092,6 +1095,137 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// Approximate IN-list filter for integral data types backed by a Bloom
+/// filter. Passes all values in the list and, with a small false positive
+/// rate, some values which are not in the list. Intended for dynamic filters
+/// produced from a join build side with too many distinct keys for an exact
+/// IN-list. Must not be used where exact semantics are required.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Initialized Bloom filter over folly::hasher<int64_t>
+  /// hashes of the passing values. Shared, not copied.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : BigintValuesUsingBloomFilter(
+            min,
+            max,
+            bloomFilter->data(),
+            bloomFilter->numWords(),
+            bloomFilter,
+            nullAllowed) {}
+
+  /// Same as above for a Bloom filter with another allocator, e.g. one backed
+  /// by a memory pool.
+  template <typename Allocator>
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<Allocator>> bloomFilter,
+      bool nullAllowed)
+      : BigintValuesUsingBloomFilter(
+            min,
+            max,
+            bloomFilter->data(),
+            bloomFilter->numWords(),
+            bloomFilter,
+            nullAllowed) {}
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_),
+        bits_(other.bits_),
+        numWords_(other.numWords_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  /// Returns the hash of 'value' used for inserting into and probing the
+  /// Bloom filter.
+  static uint64_t hash(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        BloomFilter<>::mayContain(bits_, numWords_, hash(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final {
+    if (hasNull && nullAllowed_) {
+      return true;
+    }
+    return !(min > max_ || max < min_);
+  }
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  // Makes a filter over the 'numWords' words of the Bloom filter at 'bits',
+  // which stay valid while 'bloomFilter' is referenced.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      const uint64_t* bits,
+      int32_t numWords,
+      std::shared_ptr<const void> bloomFilter,
+      bool nullAllowed);
+
+  // Returns 'this' over the same Bloom filter with 'min', 'max' and
+  // 'nullAllowed'.
+  std::unique_ptr<BigintValuesUsingBloomFilter>
+  withRange(int64_t min, int64_t max, bool nullAllowed) const;
+
+  // Returns the Bloom filter in the serialized form of BloomFilter.
+  std::string serializeBloomFilter() const;
+
+  const int64_t min_;
+  const int64_t max_;
+  // The Bloom filter that owns 'bits_'. Shared between clones and filters
+  // merged from 'this'. Immutable after construction.
+  const std::shared_ptr<const void> bloomFilter_;
+  const uint64_t* const bits_;
+  const int32_t numWords_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/FilterChain.h"
+
+namespace facebook::velox::common {
+namespace {
+
+using Kernel = uint64_t (*)(
+    const Filter& filter,
+    const void* values,
+    int32_t begin,
+    int32_t numRows);
+
+uint64_t lowMask(int32_t numRows) {
+  return numRows == 64 ? ~0ULL : bits::lowMask(numRows);
+}
+
+template <typename TFilter, typename T>
+bool testValue(const TFilter& filter, T value) {
+  if constexpr (std::is_same_v<T, double>) {
+    return filter.testDouble(value);
+  } else if constexpr (std::is_same_v<T, float>) {
+    return filter.testFloat(value);
+  } else {
+    return filter.testInt64(value);
+  }
+}
+
+// 'TFilter' is a final class, so the calls below are not virtual.
+template <typename TFilter, typename T>
+uint64_t testWord(
+    const Filter& filter,
+    const void* values,
+    int32_t begin,
+    int32_t numRows) {
+  constexpr int32_t kStep = xsimd::batch<T>::size;
+  constexpr uint64_t kStepMask = bits::lowMask(kStep);
+  const auto& typedFilter = static_cast<const TFilter&>(filter);
+  const auto* typedValues = reinterpret_cast<const T*>(values) + begin;
+  uint64_t result = 0;
+  int32_t i = 0;
+  for (; i + kStep <= numRows; i += kStep) {
+    const auto passed =
+        typedFilter.testValues(xsimd::load_unaligned(typedValues + i));
+    result |= (static_cast<uint64_t>(simd::toBitMask(passed)) & kStepMask)
+        << i;
+  }
+  for (; i < numRows; ++i) {
+    if (testValue(typedFilter, typedValues[i])) {
+      result |= 1ULL << i;
+    }
+  }
+  return result;
+}
+
+uint64_t testNotNull(
+    const Filter& /*filter*/,
+    const void* /*values*/,
+    int32_t /*begin*/,
+    int32_t numRows) {
+  return lowMask(numRows);
+}
+
+template <typename T>
+Kernel integerKernel(FilterKind kind) {
+  switch (kind) {
+    case FilterKind::kBigintRange:
+      return testWord<BigintRange, T>;
+    case FilterKind::kNegatedBigintRange:
+      return testWord<NegatedBigintRange, T>;
+    case FilterKind::kBigintValuesUsingHashTable:
+      return testWord<BigintValuesUsingHashTable, T>;
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+      return testWord<NegatedBigintValuesUsingHashTable, T>;
+    default:
+      return nullptr;
+  }
+}
+
+Kernel kernel(const Filter& filter, TypeKind type) {
+  // These only depend on the nulls.
+  if (filter.kind() == FilterKind::kAlwaysTrue ||
+      filter.kind() == FilterKind::kIsNotNull) {
+    return testNotNull;
+  }
+  switch (type) {
+    case TypeKind::BIGINT:
+      return integerKernel<int64_t>(filter.kind());
+    case TypeKind::INTEGER:
+      return integerKernel<int32_t>(filter.kind());
+    case TypeKind::SMALLINT:
+      return integerKernel<int16_t>(filter.kind());
+    case TypeKind::DOUBLE:
+      return filter.kind() == FilterKind::kDoubleRange
+          ? testWord<DoubleRange, double>
+          : nullptr;
+    case TypeKind::REAL:
+      return filter.kind() == FilterKind::kFloatRange
+          ? testWord<FloatRange, float>
+          : nullptr;
+    default:
+      return nullptr;
+  }
+}
+} // namespace
+
+bool FilterChain::isSupported(const Filter& filter, TypeKind type) {
+  return kernel(filter, type) != nullptr;
+}
+
+FilterChain::FilterChain(const std::vector<Column>& columns) {
+  columns_.reserve(columns.size());
+  for (const auto& column : columns) {
+    VELOX_CHECK_NOT_NULL(column.filter);
+    auto* columnKernel = kernel(*column.filter, column.type);
+    VELOX_CHECK_NOT_NULL(
+        columnKernel,
+        "Unsupported filter in FilterChain: {} on {}",
+        column.filter->toString(),
+        mapTypeKindToName(column.type));
+    columns_.push_back(
+        {column.filter, columnKernel, column.filter->testNull()});
+  }
+}
+
+int32_t FilterChain::filter(
+    const std::vector<const void*>& values,
+    const std::vector<const uint64_t*>& nulls,
+    int32_t numRows,
+    uint64_t* selection) const {
+  VELOX_CHECK_EQ(values.size(), columns_.size());
+  VELOX_CHECK_EQ(nulls.size(), columns_.size());
+  int32_t numPassed = 0;
+  for (int32_t begin = 0; begin < numRows; begin += 64) {
+    const auto numWordRows = std::min<int32_t>(64, numRows - begin);
+    auto word = lowMask(numWordRows);
+    for (auto i = 0; i < columns_.size() && word != 0; ++i) {
+      const auto& column = columns_[i];
+      auto passed =
+          column.kernel(*column.filter, values[i], begin, numWordRows);
+      if (nulls[i] != nullptr) {
+        // A set bit is a non-null value. The values under nulls are
+        // arbitrary, so their results are replaced.
+        const auto notNull = nulls[i][begin / 64];
+        passed = (passed & notNull) | (column.nullAllowed ? ~notNull : 0);
+      }
+      word &= passed;
+    }
+    selection[begin / 64] = word;
+    numPassed += __builtin_popcountll(word);
+  }
+  return numPassed;
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::common {
+
+/// A conjunction of filters over fixed-width columns which is evaluated
+/// without virtual calls per value. Each filter is bound at construction to
+/// a kernel specialized for its filter class and column type, which tests
+/// the values with SIMD. The rows are processed 64 at a time: all the
+/// columns are tested for one word of the selection before the next word,
+/// and the remaining columns are skipped as soon as no row of the word
+/// passes. Callers should therefore put the most selective filters first.
+class FilterChain {
+ public:
+  struct Column {
+    /// Not owned. Must outlive the chain.
+    const Filter* filter;
+    TypeKind type;
+  };
+
+  /// Returns true if 'filter' over a column of 'type' can be part of a chain.
+  static bool isSupported(const Filter& filter, TypeKind type);
+
+  /// All of 'columns' must be supported.
+  explicit FilterChain(const std::vector<Column>& columns);
+
+  /// Sets bit i of 'selection' to whether row i passes all the filters, for
+  /// the first 'numRows' rows. 'values[i]' are the flat values of the i-th
+  /// column and 'nulls[i]' are its null flags, or nullptr if it has no nulls.
+  /// 'selection' must have room for bits::nwords(numRows) words. Returns the
+  /// number of passing rows.
+  int32_t filter(
+      const std::vector<const void*>& values,
+      const std::vector<const uint64_t*>& nulls,
+      int32_t numRows,
+      uint64_t* selection) const;
+
+  int32_t numColumns() const {
+    return columns_.size();
+  }
+
+ private:
+  // Returns the bits of the passing rows among 'numRows' <= 64 values
+  // starting at row 'begin' of 'values'.
+  using Kernel = uint64_t (*)(
+      const Filter& filter,
+      const void* values,
+      int32_t begin,
+      int32_t numRows);
+
+  struct CompiledColumn {
+    const Filter* filter;
+    Kernel kernel;
+    bool nullAllowed;
+  };
+
+  std::vector<CompiledColumn> columns_;
+};
+
+} // namespace facebook::velox::common
@@ -41,6 +41,56 @@ int32_t linearSearchSimple(
   return -1;
 }
 
+// Returns whether 'left' and 'right' are equal given that their size and
+// prefix are equal. 'inlinedEqual' tells whether the second words of the
+// views are equal.
+inline bool equalAfterPrefix(
+    const StringView& left,
+    const StringView& right,
+    bool inlinedEqual) {
+  if (left.size() <= StringView::kPrefixSize) {
+    return true;
+  }
+  if (left.isInline()) {
+    return inlinedEqual;
+  }
+  return memcmp(
+             left.data() + StringView::kPrefixSize,
+             right.data() + StringView::kPrefixSize,
+             left.size() - StringView::kPrefixSize) == 0;
+}
+
+// Returns the same as bits::hashBytes(1, data, size) for the 'data' of an
+// inlined string of 'size' bytes. Relies on the bytes after the string in
+// the view being zeros.
+inline uint64_t hashInlined(const char* data, int32_t size) {
+  constexpr uint64_t kSeed = 1;
+  constexpr uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  const auto* words = reinterpret_cast<const uint64_t*>(data);
+  if (size < 8) {
+    // The second word is not zeroed for empty strings.
+    const uint64_t word = size <= StringView::kPrefixSize
+        ? *reinterpret_cast<const uint32_t*>(data)
+        : words[0];
+    const uint64_t crc = simd::crc32U64(kSeed, word);
+    const uint64_t crc2 = simd::crc32U64(kSeed, word >> 32);
+    return crc | (crc2 << 32);
+  }
+  const uint64_t a0 = simd::crc32U64(kSeed, words[0]);
+  uint64_t a1 = kSeed << 32;
+  if (size > 8) {
+    a1 = simd::crc32U64(a1, *reinterpret_cast<const uint32_t*>(words + 1));
+  }
+  // The third accumulator of hashBytes stays zero for up to 16 bytes.
+  return a0 ^ (a1 * kMul);
+}
+
+inline uint64_t hashString(const StringView& string) {
+  if (string.isInline()) {
+    return hashInlined(string.data(), string.size());
+  }
+  return bits::hashBytes(1, string.data(), string.size());
+}
 } // namespace
 
 // static
@@ -134,4 +184,64 @@ int32_t StringView::linearSearch(
   return linearSearchSimple(key, strings, indices, numStrings);
 #endif
 }
+
+// static
+void StringView::equalBatch(
+    const StringView* left,
+    const StringView* right,
+    bool rightConstant,
+    int32_t numStrings,
+    uint64_t* result) {
+  // Each StringView is 2 words, so a batch covers kBatch / 2 views.
+  constexpr int32_t kBatch = xsimd::batch<uint64_t>::size;
+  constexpr int32_t kViewsPerBatch = kBatch / 2;
+  const auto* leftWords = reinterpret_cast<const uint64_t*>(left);
+  const auto* rightWords = reinterpret_cast<const uint64_t*>(right);
+  uint64_t constantWords[kBatch] = {};
+  if (rightConstant) {
+    for (auto i = 0; i < kViewsPerBatch; ++i) {
+      memcpy(&constantWords[2 * i], right, sizeof(StringView));
+    }
+  }
+  const auto constantVector = xsimd::load_unaligned(constantWords);
+  int32_t i = 0;
+  for (; i + kViewsPerBatch <= numStrings; i += kViewsPerBatch) {
+    const auto leftVector = xsimd::load_unaligned(leftWords + 2 * i);
+    const auto rightVector = rightConstant
+        ? constantVector
+        : xsimd::load_unaligned(rightWords + 2 * i);
+    auto hits = simd::toBitMask(leftVector == rightVector);
+    for (auto j = 0; j < kViewsPerBatch; ++j, hits >>= 2) {
+      // The low bit is set if the sizes and prefixes are equal.
+      bits::setBit(
+          result,
+          i + j,
+          (hits & 1) &&
+              equalAfterPrefix(
+                  left[i + j],
+                  rightConstant ? right[0] : right[i + j],
+                  (hits & 3) == 3));
+    }
+  }
+  for (; i < numStrings; ++i) {
+    bits::setBit(result, i, left[i] == (rightConstant ? right[0] : right[i]));
+  }
+}
+
+// static
+void StringView::hashBatch(
+    const StringView* strings,
+    int32_t numStrings,
+    bool mix,
+    uint64_t* hashes) {
+  if (mix) {
+    for (auto i = 0; i < numStrings; ++i) {
+      hashes[i] = bits::hashMix(hashes[i], hashString(strings[i]));
+    }
+  } else {
+    for (auto i = 0; i < numStrings; ++i) {
+      hashes[i] = hashString(strings[i]);
+    }
+  }
+}
 } // namespace facebook::velox
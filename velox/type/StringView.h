@@ -159,17 +159,27 @@ struct StringView {
   int32_t compare(const StringView& other) const {
     if (prefixAsInt() != other.prefixAsInt()) {
       // The result is decided on prefix. The shorter will be less
-      // because the prefix is padded with zeros.
-      return memcmp(prefix_, other.prefix_, kPrefixSize);
+      // because the prefix is padded with zeros. The prefixes read as
+      // big endian integers compare like memcmp.
+      return __builtin_bswap32(prefixAsInt()) <
+              __builtin_bswap32(other.prefixAsInt())
+          ? -1
+          : 1;
     }
     int32_t size = std::min(size_, other.size_) - kPrefixSize;
     if (size <= 0) {
       // One ends within the prefix.
       return size_ - other.size_;
     }
-    if (size <= kInlineSize && isInline() && other.isInline()) {
-      int32_t result = memcmp(value_.inlined, other.value_.inlined, size);
-      return (result != 0) ? result : size_ - other.size_;
+    if (isInline() && other.isInline()) {
+      // Both inlined parts are padded with zeros, so they compare like
+      // memcmp as big endian words and the sizes decide if they are equal.
+      const uint64_t inlined = __builtin_bswap64(inlinedAsInt64());
+      const uint64_t otherInlined = __builtin_bswap64(other.inlinedAsInt64());
+      if (inlined != otherInlined) {
+        return inlined < otherInlined ? -1 : 1;
+      }
+      return size_ - other.size_;
     }
     int32_t result =
         memcmp(data() + kPrefixSize, other.data() + kPrefixSize, size);
@@ -250,6 +260,29 @@ struct StringView {
       const int32_t* indices,
       int32_t numStrings);
 
+  /// Sets bit i of 'result' to 'left[i] == right[i]' for 0 <= i <
+  /// numStrings. If 'rightConstant' is true, compares all of 'left' with
+  /// 'right[0]'. Compares the size, prefix and inlined part of several views
+  /// at a time with SIMD and reads the bodies of out of line strings only if
+  /// these match.
+  static void equalBatch(
+      const StringView* left,
+      const StringView* right,
+      bool rightConstant,
+      int32_t numStrings,
+      uint64_t* result);
+
+  /// Sets 'hashes[i]' to the hash of 'strings[i]' for 0 <= i < numStrings.
+  /// The hash is the same as that of std::hash<StringView>. If 'mix' is true,
+  /// mixes the hash into 'hashes[i]' with bits::hashMix instead. Inlined
+  /// strings are hashed from the words of the view, which are padded with
+  /// zeros, without the byte-wise load of a partial word.
+  static void hashBatch(
+      const StringView* strings,
+      int32_t numStrings,
+      bool mix,
+      uint64_t* hashes);
+
  private:
   inline int64_t sizeAndPrefixAsInt64() const {
     return reinterpret_cast<const int64_t*>(this)[0];
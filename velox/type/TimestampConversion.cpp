@@ -529,6 +529,77 @@ bool tryParseTimeString(
   return true;
 }
 
+// Returns the value of the two digits at 'buf', or -1 if they are not digits.
+inline int32_t twoDigits(const char* buf) {
+  if (!characterIsDigit(buf[0]) || !characterIsDigit(buf[1])) {
+    return -1;
+  }
+  return (buf[0] - '0') * 10 + (buf[1] - '0');
+}
+
+// Fast path of tryParseTimestampString() for the common fixed format
+// 'YYYY-MM-DD HH:MM:SS[.ffffff]', with 'T' instead of the space where
+// 'parseMode' allows it. Returns false without consuming anything if the
+// string is in another format. The general parser then handles it.
+bool tryParseFixedTimestampString(
+    const char* buf,
+    size_t len,
+    size_t& pos,
+    Timestamp& result,
+    TimestampParseMode parseMode) {
+  constexpr size_t kSize = 19;
+  if (pos != 0 || len < kSize || buf[4] != '-' || buf[7] != '-' ||
+      buf[13] != ':' || buf[16] != ':') {
+    return false;
+  }
+  const char separator = buf[10];
+  const bool validSeparator = parseMode == TimestampParseMode::kIso8601
+      ? separator == 'T'
+      : separator == ' ' ||
+          (separator == 'T' && parseMode != TimestampParseMode::kPrestoCast);
+  if (!validSeparator) {
+    return false;
+  }
+  const auto century = twoDigits(buf);
+  const auto yearOfCentury = twoDigits(buf + 2);
+  const auto month = twoDigits(buf + 5);
+  const auto day = twoDigits(buf + 8);
+  const auto hour = twoDigits(buf + 11);
+  const auto minute = twoDigits(buf + 14);
+  const auto second = twoDigits(buf + 17);
+  if (century < 0 || yearOfCentury < 0 || month < 0 || day < 0 || hour < 0 ||
+      hour >= 24 || minute < 0 || minute >= 60 || second < 0 || second > 60) {
+    return false;
+  }
+  size_t end = kSize;
+  int32_t micros = 0;
+  if (end < len) {
+    if (buf[end] == '.') {
+      int32_t mult = 100000;
+      for (++end; end < len && characterIsDigit(buf[end]); ++end, mult /= 10) {
+        if (mult == 0) {
+          return false;
+        }
+        micros += (buf[end] - '0') * mult;
+      }
+      if (mult == 100000) {
+        return false;
+      }
+    } else if (characterIsDigit(buf[end]) || buf[end] == ',') {
+      return false;
+    }
+  }
+  const auto daysSinceEpoch =
+      daysSinceEpochFromDate(century * 100 + yearOfCentury, month, day);
+  if (daysSinceEpoch.hasError()) {
+    return false;
+  }
+  result = fromDatetime(
+      daysSinceEpoch.value(), fromTime(hour, minute, second, micros));
+  pos = end;
+  return true;
+}
+
 // Parses a variety of timestamp strings, depending on the value of `parseMode`.
 // Consumes as much of the string as it can and sets `result` to the
 // timestamp from whatever it successfully parses. `pos` is set to the position
@@ -540,6 +611,10 @@ bool tryParseTimestampString(
     size_t& pos,
     Timestamp& result,
     TimestampParseMode parseMode) {
+  if (tryParseFixedTimestampString(buf, len, pos, result, parseMode)) {
+    return true;
+  }
+
   int64_t daysSinceEpoch = 0;
   int64_t microsSinceMidnight = 0;
 
@@ -24,6 +24,7 @@
 #include "velox/dwio/common/exception/Exception.h"
 
 #include "velox/type/Filter.h"
+#include "velox/type/FilterChain.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -32,6 +33,14 @@ std::vector<int64_t> sparseValues;
 std::vector<int64_t> denseValues;
 std::unique_ptr<BigintValuesUsingHashTable> filter;
 
+// Three columns with a conjunction of filters, each passing about half of
+// the rows.
+std::vector<int64_t> bigints;
+std::vector<int32_t> integers;
+std::vector<double> doubles;
+std::vector<std::unique_ptr<Filter>> columnFilters;
+std::unique_ptr<FilterChain> filterChain;
+
 int32_t run1x64(const std::vector<int64_t>& data) {
   int32_t count = 0;
   for (auto i = 0; i < data.size(); ++i) {
@@ -51,6 +60,49 @@ int32_t run4x64(const std::vector<int64_t>& data) {
   return count;
 }
 
+// Tests the columns one at a time with a virtual call per value, keeping the
+// passing rows in a row list like the column readers do.
+int32_t runColumnByColumn() {
+  std::vector<int32_t> rows(bigints.size());
+  int32_t numRows = 0;
+  for (auto i = 0; i < bigints.size(); ++i) {
+    if (columnFilters[0]->testInt64(bigints[i])) {
+      rows[numRows++] = i;
+    }
+  }
+  int32_t numPassed = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (columnFilters[1]->testInt64(integers[rows[i]])) {
+      rows[numPassed++] = rows[i];
+    }
+  }
+  numRows = numPassed;
+  numPassed = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (columnFilters[2]->testDouble(doubles[rows[i]])) {
+      rows[numPassed++] = rows[i];
+    }
+  }
+  return numPassed;
+}
+
+int32_t runFilterChain() {
+  std::vector<uint64_t> selection(bits::nwords(bigints.size()));
+  return filterChain->filter(
+      {bigints.data(), integers.data(), doubles.data()},
+      {nullptr, nullptr, nullptr},
+      bigints.size(),
+      selection.data());
+}
+
+BENCHMARK(scalarColumnByColumn) {
+  folly::doNotOptimizeAway(runColumnByColumn());
+}
+
+BENCHMARK_RELATIVE(simdFilterChain) {
+  folly::doNotOptimizeAway(runFilterChain());
+}
+
 BENCHMARK(scalarDense) {
   folly::doNotOptimizeAway(run1x64(denseValues));
 }
@@ -86,6 +138,25 @@ int32_t main(int32_t argc, char* argv[]) {
     sparseValues[i] = (folly::Random::rand32() % 100000) * 1000;
   }
 
+  bigints.resize(kNumValues);
+  integers.resize(kNumValues);
+  doubles.resize(kNumValues);
+  for (auto i = 0; i < kNumValues; ++i) {
+    bigints[i] = folly::Random::rand32() % 1000;
+    integers[i] = folly::Random::rand32() % 1000;
+    doubles[i] = folly::Random::randDouble01();
+  }
+  columnFilters.push_back(std::make_unique<BigintRange>(0, 499, false));
+  columnFilters.push_back(std::make_unique<BigintRange>(250, 749, false));
+  columnFilters.push_back(std::make_unique<DoubleRange>(
+      0.5, false, false, 1, false, false, false));
+  filterChain = std::make_unique<FilterChain>(std::vector<FilterChain::Column>{
+      {columnFilters[0].get(), TypeKind::BIGINT},
+      {columnFilters[1].get(), TypeKind::INTEGER},
+      {columnFilters[2].get(), TypeKind::DOUBLE},
+  });
+
+  VELOX_CHECK_EQ(runColumnByColumn(), runFilterChain());
   VELOX_CHECK_EQ(run1x64(denseValues), run4x64(denseValues));
   VELOX_CHECK_EQ(run1x64(sparseValues), run4x64(sparseValues));
   folly::runBenchmarks();
@@ -76,6 +76,14 @@ TEST_F(FilterSerDeTest, bigintFilters) {
   int128_t lower = HugeInt::build(hi, lo);
   testSerde(HugeintRange(lower, upper, true));
   testSerde(HugeintRange(lower, upper, false));
+
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(i * 7));
+  }
+  testSerde(BigintValuesUsingBloomFilter(0, 693, bloomFilter, true));
+  testSerde(BigintValuesUsingBloomFilter(0, 693, bloomFilter, false));
 }
 
 TEST_F(FilterSerDeTest, valuesFilters) {
@@ -21,8 +21,10 @@
 #include <optional>
 
 #include <velox/type/DecimalUtil.h>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/type/Filter.h"
+#include "velox/type/FilterChain.h"
 
 #include <gtest/gtest.h>
 
@@ -454,6 +456,61 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(i * 1'000));
+  }
+  BigintValuesUsingBloomFilter filter(0, 999'000, bloomFilter, false);
+
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter.testInt64(i * 1'000));
+  }
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-1'000));
+  EXPECT_FALSE(filter.testInt64(1'000'000));
+
+  // Values in range but not in the Bloom filter mostly fail.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter.testInt64(i * 1'000 + 1);
+  }
+  EXPECT_LT(numPassed, 100);
+
+  EXPECT_TRUE(filter.testInt64Range(5, 50, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter.testInt64Range(1'000'000, 2'000'000, false));
+
+  auto withNulls = filter.clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64(2'000));
+
+  // Merging with a range narrows the range and keeps the Bloom filter.
+  BigintRange range(10'000, 20'000, false);
+  auto merged = filter.mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(10'000));
+  EXPECT_TRUE(merged->testInt64(20'000));
+  EXPECT_FALSE(merged->testInt64(5'000));
+  EXPECT_FALSE(merged->testInt64(21'000));
+  ASSERT_EQ(
+      range.mergeWith(&filter)->kind(),
+      FilterKind::kBigintValuesUsingBloomFilter);
+
+  // Merging with an IN-list gives an exact IN-list.
+  auto values = createBigintValues({1'000, 1'001, 2'000, 3'000'000}, false);
+  merged = filter.mergeWith(values.get());
+  ASSERT_NE(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(1'000));
+  EXPECT_TRUE(merged->testInt64(2'000));
+  EXPECT_FALSE(merged->testInt64(3'000'000));
+  EXPECT_FALSE(merged->testInt64(3'000));
+
+  BigintRange disjoint(1'000'000, 2'000'000, false);
+  EXPECT_EQ(filter.mergeWith(&disjoint)->kind(), FilterKind::kAlwaysFalse);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -1881,3 +1938,87 @@ TEST(FilterTest, timestampRange) {
   EXPECT_TRUE(filter->testTimestampRange(
       Timestamp(5, 123000000), Timestamp(30, 123000000), true));
 }
+
+TEST(FilterTest, filterChain) {
+  constexpr int32_t kNumRows = 1'000;
+  std::vector<int64_t> c0(kNumRows);
+  std::vector<int32_t> c1(kNumRows);
+  std::vector<int16_t> c2(kNumRows);
+  std::vector<double> c3(kNumRows);
+  std::vector<float> c4(kNumRows);
+  // A set bit is a non-null value.
+  std::vector<uint64_t> c3Nulls(bits::nwords(kNumRows), ~0ULL);
+  std::vector<uint64_t> c4Nulls(bits::nwords(kNumRows), ~0ULL);
+  for (auto i = 0; i < kNumRows; ++i) {
+    c0[i] = i;
+    c1[i] = i % 17;
+    c2[i] = i % 11;
+    c3[i] = i * 0.5;
+    c4[i] = kNumRows - i;
+    if (i % 5 == 0) {
+      bits::clearBit(c3Nulls.data(), i);
+    }
+    if (i % 7 == 0) {
+      bits::clearBit(c4Nulls.data(), i);
+    }
+  }
+
+  auto c0Filter = between(100, 800);
+  BigintValuesUsingHashTable c1Filter(0, 15, {0, 3, 5, 15}, false);
+  auto c2Filter = notEqual(7);
+  auto c3Filter = betweenDouble(10, 300, true);
+  auto c4Filter = lessThanFloat(800);
+
+  FilterChain chain({
+      {c0Filter.get(), TypeKind::BIGINT},
+      {&c1Filter, TypeKind::INTEGER},
+      {c2Filter.get(), TypeKind::SMALLINT},
+      {c3Filter.get(), TypeKind::DOUBLE},
+      {c4Filter.get(), TypeKind::REAL},
+  });
+  std::vector<uint64_t> selection(bits::nwords(kNumRows));
+  const auto numPassed = chain.filter(
+      {c0.data(), c1.data(), c2.data(), c3.data(), c4.data()},
+      {nullptr, nullptr, nullptr, c3Nulls.data(), c4Nulls.data()},
+      kNumRows,
+      selection.data());
+
+  int32_t expectedNumPassed = 0;
+  for (auto i = 0; i < kNumRows; ++i) {
+    const bool expected = c0Filter->testInt64(c0[i]) &&
+        c1Filter.testInt64(c1[i]) && c2Filter->testInt64(c2[i]) &&
+        (bits::isBitNull(c3Nulls.data(), i) ? c3Filter->testNull()
+                                            : c3Filter->testDouble(c3[i])) &&
+        (bits::isBitNull(c4Nulls.data(), i) ? c4Filter->testNull()
+                                            : c4Filter->testFloat(c4[i]));
+    ASSERT_EQ(bits::isBitSet(selection.data(), i), expected) << "at " << i;
+    expectedNumPassed += expected;
+  }
+  EXPECT_GT(expectedNumPassed, 0);
+  EXPECT_EQ(numPassed, expectedNumPassed);
+
+  // No row passes the first filter, so the next ones are not tested.
+  auto noneFilter = greaterThan(kNumRows);
+  FilterChain noneChain({
+      {noneFilter.get(), TypeKind::BIGINT},
+      {c2Filter.get(), TypeKind::SMALLINT},
+  });
+  EXPECT_EQ(
+      noneChain.filter(
+          {c0.data(), c2.data()},
+          {nullptr, nullptr},
+          kNumRows,
+          selection.data()),
+      0);
+  EXPECT_EQ(bits::countBits(selection.data(), 0, kNumRows), 0);
+
+  EXPECT_TRUE(FilterChain::isSupported(IsNotNull(), TypeKind::VARCHAR));
+  EXPECT_FALSE(FilterChain::isSupported(*c0Filter, TypeKind::TINYINT));
+  EXPECT_FALSE(FilterChain::isSupported(*c3Filter, TypeKind::REAL));
+  EXPECT_FALSE(FilterChain::isSupported(
+      BytesRange("a", false, false, "b", false, false, false),
+      TypeKind::VARCHAR));
+  VELOX_ASSERT_THROW(
+      FilterChain({{c3Filter.get(), TypeKind::BIGINT}}),
+      "Unsupported filter in FilterChain");
+}
@@ -49,6 +49,119 @@ BENCHMARK_PARAM(runStringViewCreate, INLINE_SIZE);
 
 // Larger strings which won't be inlined.
 BENCHMARK_PARAM(runStringViewCreate, NON_INLINE_SIZE);
+
+constexpr int32_t kNumStrings = 10'000;
+
+// Makes 'kNumStrings' views of up to 'maxLen' characters over 'storage'. Only
+// the last characters differ so that the prefixes are mostly equal.
+std::vector<StringView> makeStrings(uint32_t maxLen, std::string& storage) {
+  storage.resize(kNumStrings * maxLen);
+  std::vector<StringView> strings;
+  strings.reserve(kNumStrings);
+  for (auto i = 0; i < kNumStrings; ++i) {
+    const auto len = 1 + folly::Random::rand32(maxLen);
+    auto* data = storage.data() + i * maxLen;
+    memset(data, 'a', len);
+    data[len - 1] = 'a' + folly::Random::rand32(4);
+    strings.push_back(StringView(data, len));
+  }
+  return strings;
+}
+
+void runHashRowByRow(uint32_t iterations, uint32_t maxLen) {
+  folly::BenchmarkSuspender suspender;
+  std::string storage;
+  auto strings = makeStrings(maxLen, storage);
+  std::vector<uint64_t> hashes(kNumStrings);
+  suspender.dismiss();
+
+  for (auto i = 0; i < iterations; ++i) {
+    for (auto j = 0; j < kNumStrings; ++j) {
+      hashes[j] = folly::hasher<StringView>()(strings[j]);
+    }
+  }
+  folly::doNotOptimizeAway(hashes);
+}
+
+void runHashBatch(uint32_t iterations, uint32_t maxLen) {
+  folly::BenchmarkSuspender suspender;
+  std::string storage;
+  auto strings = makeStrings(maxLen, storage);
+  std::vector<uint64_t> hashes(kNumStrings);
+  suspender.dismiss();
+
+  for (auto i = 0; i < iterations; ++i) {
+    StringView::hashBatch(strings.data(), kNumStrings, false, hashes.data());
+  }
+  folly::doNotOptimizeAway(hashes);
+}
+
+void runEqualRowByRow(uint32_t iterations, uint32_t maxLen) {
+  folly::BenchmarkSuspender suspender;
+  std::string leftStorage;
+  std::string rightStorage;
+  auto left = makeStrings(maxLen, leftStorage);
+  auto right = makeStrings(maxLen, rightStorage);
+  std::vector<uint64_t> result(bits::nwords(kNumStrings));
+  suspender.dismiss();
+
+  for (auto i = 0; i < iterations; ++i) {
+    for (auto j = 0; j < kNumStrings; ++j) {
+      bits::setBit(result.data(), j, left[j] == right[j]);
+    }
+  }
+  folly::doNotOptimizeAway(result);
+}
+
+void runEqualBatch(uint32_t iterations, uint32_t maxLen) {
+  folly::BenchmarkSuspender suspender;
+  std::string leftStorage;
+  std::string rightStorage;
+  auto left = makeStrings(maxLen, leftStorage);
+  auto right = makeStrings(maxLen, rightStorage);
+  std::vector<uint64_t> result(bits::nwords(kNumStrings));
+  suspender.dismiss();
+
+  for (auto i = 0; i < iterations; ++i) {
+    StringView::equalBatch(
+        left.data(), right.data(), false, kNumStrings, result.data());
+  }
+  folly::doNotOptimizeAway(result);
+}
+
+void runSort(uint32_t iterations, uint32_t maxLen) {
+  folly::BenchmarkSuspender suspender;
+  std::string storage;
+  auto strings = makeStrings(maxLen, storage);
+  suspender.dismiss();
+
+  for (auto i = 0; i < iterations; ++i) {
+    suspender.rehire();
+    auto copy = strings;
+    suspender.dismiss();
+    std::sort(copy.begin(), copy.end());
+    folly::doNotOptimizeAway(copy);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_PARAM(runHashRowByRow, INLINE_SIZE);
+BENCHMARK_RELATIVE_PARAM(runHashBatch, INLINE_SIZE);
+BENCHMARK_PARAM(runHashRowByRow, NON_INLINE_SIZE);
+BENCHMARK_RELATIVE_PARAM(runHashBatch, NON_INLINE_SIZE);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_PARAM(runEqualRowByRow, INLINE_SIZE);
+BENCHMARK_RELATIVE_PARAM(runEqualBatch, INLINE_SIZE);
+BENCHMARK_PARAM(runEqualRowByRow, NON_INLINE_SIZE);
+BENCHMARK_RELATIVE_PARAM(runEqualBatch, NON_INLINE_SIZE);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_PARAM(runSort, INLINE_SIZE);
+BENCHMARK_PARAM(runSort, NON_INLINE_SIZE);
 } // namespace
 } // namespace facebook::velox
 
@@ -285,3 +285,82 @@ TEST(StringView, linearSearch) {
             << simdIndicesUsec << " scalar: " << loopUsec << " / "
             << loopIndicesUsec;
 }
+
+TEST(StringView, equalBatch) {
+  std::vector<std::string> strings;
+  for (auto size = 0; size < 20; ++size) {
+    strings.push_back(std::string(size, 'a'));
+    strings.push_back(std::string(size, 'a') + "b");
+    strings.push_back("b" + std::string(size, 'a'));
+  }
+  std::vector<StringView> left;
+  std::vector<StringView> right;
+  for (auto i = 0; i < strings.size(); ++i) {
+    for (auto j = 0; j < strings.size(); ++j) {
+      left.push_back(StringView(strings[i]));
+      right.push_back(StringView(strings[j]));
+    }
+  }
+  std::vector<uint64_t> result(bits::nwords(left.size()));
+  StringView::equalBatch(
+      left.data(), right.data(), false, left.size(), result.data());
+  for (auto i = 0; i < left.size(); ++i) {
+    EXPECT_EQ(bits::isBitSet(result.data(), i), left[i] == right[i]) << i;
+  }
+
+  for (auto i = 0; i < strings.size(); ++i) {
+    StringView constant(strings[i]);
+    StringView::equalBatch(
+        left.data(), &constant, true, left.size(), result.data());
+    for (auto j = 0; j < left.size(); ++j) {
+      EXPECT_EQ(bits::isBitSet(result.data(), j), left[j] == constant) << j;
+    }
+  }
+}
+
+TEST(StringView, hashBatch) {
+  const std::string text = "We are stardust, we are golden";
+  std::vector<StringView> views;
+  for (auto i = 0; i <= text.size(); ++i) {
+    views.push_back(StringView(text.data(), i));
+  }
+  // An empty view which is not default constructed.
+  views.push_back(StringView(text.data() + 3, 0));
+
+  std::vector<uint64_t> hashes(views.size());
+  StringView::hashBatch(views.data(), views.size(), false, hashes.data());
+  for (auto i = 0; i < views.size(); ++i) {
+    EXPECT_EQ(hashes[i], std::hash<StringView>()(views[i])) << i;
+  }
+
+  std::vector<uint64_t> mixed(views.size(), 123);
+  StringView::hashBatch(views.data(), views.size(), true, mixed.data());
+  for (auto i = 0; i < views.size(); ++i) {
+    EXPECT_EQ(mixed[i], bits::hashMix(123, hashes[i])) << i;
+  }
+}
+
+TEST(StringView, compareInlined) {
+  // Inlined strings which differ after the prefix, including embedded zeros.
+  const std::vector<std::string> strings = {
+      "abcde",
+      std::string("abcde\0", 6),
+      std::string("abcde\0x", 7),
+      "abcdex",
+      "abcdf",
+      "abcdefghijkl",
+      "abcdefghijkm",
+      "abcdefghijklm",
+      "abcd",
+      "abce",
+      "b",
+  };
+  for (const auto& left : strings) {
+    for (const auto& right : strings) {
+      const auto expected = left.compare(right);
+      const auto actual = StringView(left).compare(StringView(right));
+      EXPECT_EQ(expected < 0, actual < 0) << left << " " << right;
+      EXPECT_EQ(expected == 0, actual == 0) << left << " " << right;
+    }
+  }
+}
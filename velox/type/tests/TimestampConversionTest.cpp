@@ -310,6 +310,20 @@ TEST(DateTimeUtilTest, fromTimestampString) {
   EXPECT_EQ(
       Timestamp(946729316, 0),
       parseTimestamp("2000-01-01T12:21:56", TimestampParseMode::kIso8601));
+
+  // Fractions of a second in the fixed format.
+  EXPECT_EQ(
+      Timestamp(946729316, 120'000'000),
+      parseTimestamp("2000-01-01 12:21:56.12"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01 12:21:56.123456"));
+  // More than microsecond precision is truncated.
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01 12:21:56.1234567"));
+  // Leap day and leap second.
+  EXPECT_EQ(Timestamp(951782460, 0), parseTimestamp("2000-02-29 00:00:60"));
 }
 
 TEST(DateTimeUtilTest, fromTimestampStringInvalid) {
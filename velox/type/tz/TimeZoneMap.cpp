@@ -16,6 +16,8 @@
 
 #include "velox/type/tz/TimeZoneMap.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <fmt/core.h>
 #include <folly/container/F14Map.h>
@@ -38,6 +40,10 @@ extern const std::vector<std::pair<int16_t, std::string>>& getTimeZoneEntries();
 
 namespace {
 
+// UTC offsets are precomputed from 1900-01-01 to 2100-01-01.
+constexpr int64_t kMinTransitionSeconds = -2'208'988'800;
+constexpr int64_t kMaxTransitionSeconds = 4'102'444'800;
+
 // Returns the offset in minutes for a specific time zone offset in the
 // database. Do not call for tzID 0 (UTC / "+00:00").
 inline std::chrono::minutes getTimeZoneOffset(int16_t tzID) {
@@ -436,15 +442,83 @@ TimeZone::milliseconds TimeZone::to_sys(
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
+void TimeZone::ensureTransitions() const {
+  std::call_once(transitionsFlag_, [&]() {
+    const date::sys_seconds end{seconds(kMaxTransitionSeconds)};
+    date::sys_seconds start{seconds(kMinTransitionSeconds)};
+    while (start < end) {
+      const auto info = tz_->get_info(start);
+      // Changes of abbreviation or DST save without a change of the offset
+      // do not matter for the conversion.
+      if (transitionOffsets_.empty() ||
+          transitionOffsets_.back() != info.offset.count()) {
+        transitionStarts_.push_back(start.time_since_epoch().count());
+        transitionOffsets_.push_back(info.offset.count());
+      }
+      start = info.end;
+    }
+  });
+}
+
+int32_t TimeZone::findTransition(int64_t seconds, int32_t hint) const {
+  if (seconds < kMinTransitionSeconds || seconds >= kMaxTransitionSeconds) {
+    return -1;
+  }
+  const int32_t numTransitions = transitionStarts_.size();
+  if (transitionStarts_[hint] <= seconds &&
+      (hint + 1 == numTransitions || seconds < transitionStarts_[hint + 1])) {
+    return hint;
+  }
+  auto it = std::upper_bound(
+      transitionStarts_.begin(), transitionStarts_.end(), seconds);
+  return it - transitionStarts_.begin() - 1;
+}
+
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  if (tz_ != nullptr) {
+    ensureTransitions();
+    if (auto index = findTransition(timestamp.count()); index >= 0) {
+      return timestamp + seconds(transitionOffsets_[index]);
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  if (tz_ != nullptr) {
+    ensureTransitions();
+    const auto utcSeconds = date::floor<seconds>(timestamp).count();
+    if (auto index = findTransition(utcSeconds); index >= 0) {
+      return timestamp + seconds(transitionOffsets_[index]);
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
+void TimeZone::to_local(
+    const TimeZone::seconds* timestamps,
+    int32_t size,
+    TimeZone::seconds* result) const {
+  if (tz_ == nullptr) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = toLocalImpl(timestamps[i], tz_, offset_);
+    }
+    return;
+  }
+  ensureTransitions();
+  int32_t index = 0;
+  for (auto i = 0; i < size; ++i) {
+    const auto next = findTransition(timestamps[i].count(), index);
+    if (next < 0) {
+      result[i] = toLocalImpl(timestamps[i], tz_, offset_);
+      continue;
+    }
+    index = next;
+    result[i] = timestamps[i] + seconds(transitionOffsets_[index]);
+  }
+}
+
 std::string TimeZone::getShortName(
     TimeZone::milliseconds timestamp,
     TimeZone::TChoose choose) const {
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace facebook::velox::date {
 class time_zone;
@@ -140,9 +142,19 @@ class TimeZone {
   /// GMT), convert to the same instant in time as observed in the user local
   /// time represented by this object). Note that this conversion is not
   /// susceptible to the error above.
+  ///
+  /// For time zones with a name, the UTC offsets between 1900 and 2100 are
+  /// looked up in a table of transitions built on first use, instead of
+  /// going through external/date for each timestamp.
   seconds to_local(seconds timestamp) const;
   milliseconds to_local(milliseconds timestamp) const;
 
+  /// Same as to_local(seconds) for 'size' timestamps. Consecutive timestamps
+  /// between the same transitions are converted without a search. 'result'
+  /// may be the same as 'timestamps'.
+  void to_local(const seconds* timestamps, int32_t size, seconds* result)
+      const;
+
   const std::string& name() const {
     return timeZoneName_;
   }
@@ -172,10 +184,25 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // Builds 'transitionStarts_' and 'transitionOffsets_' once.
+  void ensureTransitions() const;
+
+  // Returns the index in 'transitionStarts_' of the transition in effect at
+  // UTC 'seconds', or -1 if it is outside of the table. Checks 'hint' before
+  // searching.
+  int32_t findTransition(int64_t seconds, int32_t hint = 0) const;
+
   const date::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  // Start in UTC seconds and UTC offset in seconds of each interval with a
+  // different offset in the period covered by the table. Only used when
+  // 'tz_' is set.
+  mutable std::once_flag transitionsFlag_;
+  mutable std::vector<int64_t> transitionStarts_;
+  mutable std::vector<int32_t> transitionOffsets_;
 };
 
 } // namespace facebook::velox::tz
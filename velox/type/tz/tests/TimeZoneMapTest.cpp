@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -91,6 +92,61 @@ TEST(TimeZoneMapTest, offsetToLocal) {
   EXPECT_NE(toLocalTime("-07:00", ts), toLocalTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, toLocalTransitions) {
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "America/Sao_Paulo",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe",
+        "Europe/London",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    ASSERT_NE(tz, nullptr);
+    const auto* dateTz = date::locate_zone(name);
+
+    // Every 7 hours and 13 seconds from 1899 to 2101, which covers the ends of
+    // the transition table and the times around each transition.
+    std::vector<seconds> timestamps;
+    for (int64_t ts = -2'240'000'000; ts < 4'140'000'000; ts += 25'213) {
+      timestamps.push_back(seconds(ts));
+    }
+    for (const auto& ts : {-2'208'988'801L, -2'208'988'800L, 4'102'444'799L}) {
+      timestamps.push_back(seconds(ts));
+    }
+    std::vector<seconds> expected;
+    for (const auto& ts : timestamps) {
+      expected.push_back(date::zoned_time{dateTz, date::sys_seconds{ts}}
+                             .get_local_time()
+                             .time_since_epoch());
+    }
+
+    for (auto i = 0; i < timestamps.size(); ++i) {
+      ASSERT_EQ(tz->to_local(timestamps[i]), expected[i])
+          << timestamps[i].count();
+      ASSERT_EQ(
+          tz->to_local(milliseconds(timestamps[i]) + milliseconds(123)),
+          milliseconds(expected[i]) + milliseconds(123));
+    }
+
+    std::vector<seconds> result(timestamps.size());
+    tz->to_local(timestamps.data(), timestamps.size(), result.data());
+    EXPECT_EQ(result, expected);
+
+    // In place, in reverse order.
+    std::reverse(timestamps.begin(), timestamps.end());
+    std::reverse(expected.begin(), expected.end());
+    tz->to_local(timestamps.data(), timestamps.size(), timestamps.data());
+    EXPECT_EQ(timestamps, expected);
+  }
+
+  // Offset time zones.
+  const auto* tz = locateZone("-01:01");
+  std::vector<seconds> timestamps = {seconds(0), seconds(100)};
+  tz->to_local(timestamps.data(), timestamps.size(), timestamps.data());
+  EXPECT_EQ(timestamps, std::vector<seconds>({seconds(-3660), seconds(-3560)}));
+}
+
 TEST(TimeZoneMapTest, offsetToSys) {
   auto toSysTime = [&](std::string_view name, size_t ts) {
     const auto* tz = locateZone(name);
@@ -144,4 +144,19 @@ xsimd::batch<T> BiasVector<T>::loadSIMDValueBufferAt(size_t index) const {
   }
 }
 
+template <typename T>
+void BiasVector<T>::copyValuesTo(T* values) const {
+  const vector_size_t size = BaseVector::length_;
+  vector_size_t row = 0;
+  if constexpr (can_simd) {
+    constexpr auto kBatchSize = xsimd::batch<T>::size;
+    for (; row + kBatchSize <= size; row += kBatchSize) {
+      loadSIMDValueBufferAt(row * sizeof(T)).store_unaligned(values + row);
+    }
+  }
+  for (; row < size; ++row) {
+    values[row] = valueAtFast(row);
+  }
+}
+
 } // namespace facebook::velox
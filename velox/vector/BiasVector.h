@@ -132,6 +132,13 @@ class BiasVector : public SimpleVector<T> {
    */
   xsimd::batch<T> loadSIMDValueBufferAt(size_t index) const;
 
+  /**
+   * Writes the values of all rows to 'values', which must have space for
+   * size() values. Widens and adds the bias to a batch of values at a time.
+   * The values of null rows are undefined.
+   */
+  void copyValuesTo(T* values) const;
+
   std::unique_ptr<SimpleVector<uint64_t>> hashAll() const override;
 
   inline T bias() const {
@@ -17,6 +17,7 @@
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
 #include "velox/vector/LazyVector.h"
 
 namespace facebook::velox {
@@ -298,6 +299,11 @@ void DecodedVector::setBaseData(
       setFlatNulls(vector, rows);
       break;
     }
+    case VectorEncoding::Simple::BIASED: {
+      debiasValues(vector);
+      setFlatNulls(vector, rows);
+      break;
+    }
     case VectorEncoding::Simple::ROW:
     case VectorEncoding::Simple::ARRAY:
     case VectorEncoding::Simple::MAP: {
@@ -313,6 +319,30 @@ void DecodedVector::setBaseData(
   }
 }
 
+void DecodedVector::debiasValues(const BaseVector& vector) {
+  // 'debiasedValues_' is allocated as int64_t but is used for values of any
+  // width.
+  debiasedValues_.resize(vector.size());
+  switch (vector.typeKind()) {
+    case TypeKind::BIGINT:
+      vector.asUnchecked<BiasVector<int64_t>>()->copyValuesTo(
+          debiasedValues_.data());
+      break;
+    case TypeKind::INTEGER:
+      vector.asUnchecked<BiasVector<int32_t>>()->copyValuesTo(
+          reinterpret_cast<int32_t*>(debiasedValues_.data()));
+      break;
+    case TypeKind::SMALLINT:
+      vector.asUnchecked<BiasVector<int16_t>>()->copyValuesTo(
+          reinterpret_cast<int16_t*>(debiasedValues_.data()));
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Unexpected type of biased vector: {}", vector.type()->toString());
+  }
+  data_ = debiasedValues_.data();
+}
+
 void DecodedVector::setBaseDataForConstant(
     const BaseVector& vector,
     const SelectivityVector* rows) {
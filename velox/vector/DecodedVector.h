@@ -349,6 +349,9 @@ class DecodedVector {
       const BaseVector& vector,
       const SelectivityVector* rows);
 
+  // Sets 'data_' to the values of BiasVector 'vector' with the bias added.
+  void debiasValues(const BaseVector& vector);
+
   void reset(vector_size_t size);
 
   // If `rows` is null applies the `func` to all rows in [0, size_)
@@ -425,6 +428,10 @@ class DecodedVector {
   // dictionary and base values.
   std::vector<uint64_t> copiedNulls_;
 
+  // Used as backing for 'data_' when the base vector is a BiasVector. Holds
+  // the values of all rows of the base vector with the bias added.
+  std::vector<int64_t> debiasedValues_;
+
   // Used as 'nulls_' for a null constant vector.
   static uint64_t constantNullMask_;
 };
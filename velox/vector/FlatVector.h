@@ -415,12 +415,8 @@ class FlatVector final : public SimpleVector<T> {
   }
 
   uint64_t retainedSize() const override {
-    auto size =
-        BaseVector::retainedSize() + (values_ ? values_->capacity() : 0);
-    for (auto& buffer : stringBuffers_) {
-      size += buffer->capacity();
-    }
-    return size;
+    return BaseVector::retainedSize() + (values_ ? values_->capacity() : 0) +
+        stringBuffersCapacity_;
   }
 
   /// Used for vectors of type VARCHAR and VARBINARY to hold data referenced
@@ -439,8 +435,10 @@ class FlatVector final : public SimpleVector<T> {
     stringBuffers_ = std::move(buffers);
     stringBufferSet_.clear();
     stringBufferSet_.reserve(stringBuffers_.size());
+    stringBuffersCapacity_ = 0;
     for (const auto& bufferPtr : stringBuffers_) {
       stringBufferSet_.insert(bufferPtr.get());
+      stringBuffersCapacity_ += bufferPtr->capacity();
     }
   }
 
@@ -451,6 +449,7 @@ class FlatVector final : public SimpleVector<T> {
 
     stringBuffers_.clear();
     stringBufferSet_.clear();
+    stringBuffersCapacity_ = 0;
   }
 
   /// Used for vectors of type VARCHAR and VARBINARY to hold a reference on
@@ -463,6 +462,7 @@ class FlatVector final : public SimpleVector<T> {
       return false;
     }
     stringBuffers_.push_back(buffer);
+    stringBuffersCapacity_ += buffer->capacity();
     return true;
   }
 
@@ -595,6 +595,11 @@ class FlatVector final : public SimpleVector<T> {
   // NOTE: we need to ensure 'stringBuffers_' and 'stringBufferSet_' are
   // always consistent.
   folly::F14FastSet<const Buffer*> stringBufferSet_;
+
+  // Sum of the capacities of 'stringBuffers_'. Maintained together with
+  // 'stringBufferSet_' so that retainedSize() does not need to visit the
+  // buffers. The buffers are append only and their capacity does not change.
+  uint64_t stringBuffersCapacity_{0};
 };
 
 template <>
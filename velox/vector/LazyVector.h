@@ -201,6 +201,13 @@ class VectorLoader {
       vector_size_t resultSize,
       VectorPtr* result);
 
+  // Returns true if load() can run on another thread concurrently with the
+  // loads of the other LazyVectors of the same batch, e.g. because these
+  // read independent streams.
+  virtual bool supportsConcurrentLoad() const {
+    return false;
+  }
+
  protected:
   virtual void loadInternal(
       RowSet rows,
@@ -253,6 +260,13 @@ class LazyVector : public BaseVector {
     return allLoaded_;
   }
 
+  // Returns true if 'this' can be loaded on another thread concurrently with
+  // the other LazyVectors of the same batch. See
+  // VectorLoader::supportsConcurrentLoad().
+  bool supportsConcurrentLoad() const {
+    return loader_ != nullptr && loader_->supportsConcurrentLoad();
+  }
+
   // Loads the positions in 'rows' into loadedVector_. If 'hook' is
   // non-nullptr, the hook is instead called on the values and
   // loadedVector is not updated. This method is const because call
@@ -54,6 +54,27 @@ std::string SelectivityVector::toString(
   return out.str();
 }
 
+void SelectivityVector::collectSparseRows() {
+  const vector_size_t maxRows = (end_ - begin_) / kSparseRatio;
+  sparseRows_.clear();
+  // Stops at the first row over 'maxRows', so this is cheap for dense
+  // vectors.
+  const bool isSparse =
+      bits::testSetBits(bits_.data(), begin_, end_, [&](vector_size_t row) {
+        if (sparseRows_.size() == static_cast<size_t>(maxRows)) {
+          return false;
+        }
+        sparseRows_.push_back(row);
+        return true;
+      });
+  if (isSparse) {
+    sparseState_ = SparseState::kSparse;
+  } else {
+    sparseState_ = SparseState::kDense;
+    sparseRows_.clear();
+  }
+}
+
 void SelectivityVector::copyNulls(uint64_t* dest, const uint64_t* src) const {
   if (isAllSelected()) {
     bits::copyBits(src, 0, dest, 0, size_);
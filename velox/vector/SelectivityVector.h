@@ -88,6 +88,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    sparseState_ = SparseState::kUnknown;
   }
 
   /**
@@ -99,6 +100,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    sparseState_ = SparseState::kUnknown;
   }
 
   /**
@@ -114,6 +116,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    sparseState_ = SparseState::kUnknown;
   }
 
   /**
@@ -131,6 +134,7 @@ class SelectivityVector {
    * updateBounds() need to be called explicitly if data is modified.
    */
   MutableRange<bool> asMutableRange() {
+    sparseState_ = SparseState::kUnknown;
     return MutableRange<bool>(bits_.data(), begin_, end_);
   }
 
@@ -163,6 +167,7 @@ class SelectivityVector {
     VELOX_SUPPRESS_STRINGOP_OVERFLOW_WARNING
     allSelected_ = false;
     VELOX_UNSUPPRESS_STRINGOP_OVERFLOW_WARNING
+    sparseState_ = SparseState::kUnknown;
   }
 
   /**
@@ -173,6 +178,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    sparseState_ = SparseState::kUnknown;
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -289,6 +295,7 @@ class SelectivityVector {
    * index (noting that the range in between may contain not selected indices).
    */
   void updateBounds() {
+    sparseState_ = SparseState::kUnknown;
     begin_ = bits::findFirstBit(bits_.data(), 0, size_);
     if (begin_ == -1) {
       begin_ = 0;
@@ -300,6 +307,9 @@ class SelectivityVector {
     }
     end_ = bits::findLastBit(bits_.data(), begin_, size_) + 1;
     allSelected_.reset();
+    if (end_ - begin_ >= kMinSparseRange) {
+      collectSparseRows();
+    }
   }
 
   bool isAllSelected() const {
@@ -355,6 +365,12 @@ class SelectivityVector {
   template <typename Callable>
   bool testSelected(Callable func) const;
 
+  /// Returns true if the last updateBounds() found few enough selected rows to
+  /// iterate over a list of them instead of the bits. Used in tests.
+  bool testingIsSparse() const {
+    return sparseState_ == SparseState::kSparse;
+  }
+
   friend std::ostream& operator<<(
       std::ostream& os,
       const SelectivityVector& selectivityVector) {
@@ -379,6 +395,27 @@ class SelectivityVector {
   }
 
  private:
+  // If at most 1 in 'kSparseRatio' of the rows between 'begin_' and 'end_'
+  // is selected, applyToSelected() iterates over a list of the selected
+  // rows. This avoids scanning the bits again for each use of a very
+  // selective vector. Ranges shorter than 'kMinSparseRange' are always
+  // iterated over the bits. The list is made by updateBounds() and not by
+  // the const functions, so that a vector can be read by several threads.
+  static constexpr vector_size_t kSparseRatio = 64;
+  static constexpr vector_size_t kMinSparseRange = 1'024;
+
+  enum class SparseState : int8_t {
+    // Not known since the last change of the bits.
+    kUnknown,
+    // 'sparseRows_' has the selected rows.
+    kSparse,
+    // Too many rows are selected for 'sparseRows_'.
+    kDense,
+  };
+
+  // Sets 'sparseState_' and, if sparse, fills 'sparseRows_'.
+  void collectSparseRows();
+
   // The vector of bits for what is selected vs not (1 is selected).
   std::vector<uint64_t> bits_;
 
@@ -393,6 +430,11 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  // The selected rows if 'sparseState_' is kSparse. Reset by all the
+  // functions which change the bits, including asMutableRange().
+  SparseState sparseState_{SparseState::kUnknown};
+  std::vector<vector_size_t> sparseRows_;
+
   friend class SelectivityIterator;
 };
 
@@ -445,6 +487,12 @@ inline void SelectivityVector::applyToSelected(Callable func) const {
     for (vector_size_t row = begin_; row < end; ++row) {
       func(row);
     }
+    return;
+  }
+  if (sparseState_ == SparseState::kSparse) {
+    for (auto row : sparseRows_) {
+      func(row);
+    }
   } else {
     bits::forEachSetBit(bits_.data(), begin_, end_, func);
   }
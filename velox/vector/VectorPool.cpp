@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,12 +48,31 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexType(const Type& type) {
+  return type.isArray() || type.isMap() || type.isRow();
+}
+
+// Returns true if the bytes retained by a cached vector of 'type' can vary
+// and are counted against kMaxVariableWidthBytes.
+bool isVariableWidth(const Type& type) {
+  return type.kind() == TypeKind::VARCHAR ||
+      type.kind() == TypeKind::VARBINARY || isComplexType(type);
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (!pending_.empty()) {
+    releaseUnreferenced();
+  }
+  if (size <= kMaxRecycleSize) {
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_, retainedBytes_);
+    }
+    if (isComplexType(*type)) {
+      return complexVectors_.pop(type, size, *pool_, retainedBytes_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -66,10 +86,13 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
-    return false;
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector, retainedBytes_);
+  }
+  if (isComplexType(*vector->type())) {
+    return complexVectors_.maybePushBack(vector, retainedBytes_);
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  return false;
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -84,23 +107,66 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   return numReleased;
 }
 
+void VectorPool::releaseWhenUnreferenced(VectorPtr vector) {
+  if (vector == nullptr) {
+    return;
+  }
+  releaseUnreferenced();
+  if (pending_.size() >= kNumPerType) {
+    pending_.pop_front();
+  }
+  pending_.push_back(std::move(vector));
+}
+
+void VectorPool::releaseUnreferenced() {
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (it->use_count() == 1) {
+      // Not recyclable vectors are dropped.
+      release(*it);
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void VectorPool::clear() {
+  pending_.clear();
   for (auto& vectorPool : vectors_) {
     vectorPool.clear();
   }
+  complexVectors_.clear();
+  retainedBytes_ = 0;
 }
 
-bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
+bool VectorPool::TypePool::maybePushBack(
+    VectorPtr& vector,
+    uint64_t& retainedBytes) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // an Array, Map or Row Vector with unique and mutable buffers and children.
+  if (!vector->isWritable()) {
+    return false;
+  }
+  if (vector->type()->isPrimitiveType() &&
+      (!vector->isFlatEncoding() || !vector->values())) {
     return false;
   }
   if (size >= kNumPerType) {
     return false;
   }
 
+  // This is an upper bound of the bytes kept after prepareForReuse(), which
+  // may drop string buffers.
+  const uint64_t vectorBytes =
+      isVariableWidth(*vector->type()) ? vector->retainedSize() : 0;
+  if (retainedBytes + vectorBytes > kMaxVariableWidthBytes) {
+    return false;
+  }
+
   vector->prepareForReuse();
+  retainedBytes += vectorBytes;
+  bytes[size] = vectorBytes;
   vectors[size++] = std::move(vector);
   return true;
 }
@@ -108,8 +174,23 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
 VectorPtr VectorPool::TypePool::pop(
     const TypePtr& type,
     vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
+    memory::MemoryPool& pool,
+    uint64_t& retainedBytes) {
+  if (size && isComplexType(*type)) {
+    // Moves the last vector of 'type' to the end.
+    for (auto i = size - 1; i >= 0; --i) {
+      if (*vectors[i]->type() == *type) {
+        std::swap(vectors[i], vectors[size - 1]);
+        std::swap(bytes[i], bytes[size - 1]);
+        break;
+      }
+      if (i == 0) {
+        return BaseVector::create(type, vectorSize, &pool);
+      }
+    }
+  }
   if (size) {
+    retainedBytes -= bytes[size - 1];
     auto result = std::move(vectors[--size]);
     if (UNLIKELY(result->rawNulls() != nullptr)) {
       // This is a recyclable vector, no need to check uniqueness.
@@ -129,6 +210,16 @@ VectorPtr VectorPool::TypePool::pop(
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
+    if (type->isRow()) {
+      // prepareForReuse() resized the children to 0.
+      auto* row = result->asUnchecked<RowVector>();
+      for (auto i = 0; i < row->childrenSize(); ++i) {
+        auto& child = row->childAt(i);
+        if (child) {
+          child->resize(vectorSize);
+        }
+      }
+    }
     return result;
   }
   return BaseVector::create(type, vectorSize, &pool);
@@ -136,6 +227,7 @@ VectorPtr VectorPool::TypePool::pop(
 
 void VectorPool::TypePool::clear() {
   std::fill_n(vectors.begin(), kNumPerType, nullptr);
+  bytes.fill(0);
   size = 0;
 }
 } // namespace facebook::velox
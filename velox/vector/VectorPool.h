@@ -16,32 +16,47 @@
 #pragma once
 
 #include <folly/container/F14Map.h>
+#include <deque>
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// A thread-level cache of pre-allocated vectors of different types.
+/// Keeps up to 10 recyclable vectors of each singleton built-in type and up to
+/// 10 ARRAY, MAP and ROW vectors of any type. A vector is recyclable if it is
+/// flat, or an ARRAY, MAP or ROW vector, and recursively singly-referenced.
+/// Arrays, maps and rows are recycled with their offsets, sizes and children,
+/// and string vectors with at most one string buffer, see
+/// FlatVector::prepareForReuse(). The bytes retained by these is limited to
+/// kMaxVariableWidthBytes. Decimal types, fixed-size array type and custom
+/// types other than as children of complex types are not supported. Calling
+/// 'get' for an unsupported type already returns a newly allocated vector.
+/// Calling 'release' for an unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector of 'type'.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is recyclable and there is space. The
+  /// function returns true if 'vector' is not null and has been returned back
+  /// to this pool, otherwise returns false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Keeps 'vector', which has been handed out to a consumer, e.g. as an
+  /// operator output, and releases it into 'this' once the consumer no longer
+  /// references it. Keeps at most 10 such vectors, dropping the oldest.
+  void releaseWhenUnreferenced(VectorPtr vector);
+
+  /// Bytes retained by the cached string and complex vectors.
+  uint64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
   /// Clears all the cached vectors.
   void clear();
 
@@ -50,22 +65,36 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max bytes retained by the cached string and complex vectors. These hold
+  /// variable amounts of memory, unlike the other vectors which are bounded
+  /// by kMaxRecycleSize.
+  static constexpr uint64_t kMaxVariableWidthBytes = 16 << 20;
 
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
+    /// The bytes counted in 'retainedBytes_' for the corresponding 'vectors'.
+    std::array<uint64_t, kNumPerType> bytes{};
 
-    bool maybePushBack(VectorPtr& vector);
+    bool maybePushBack(VectorPtr& vector, uint64_t& retainedBytes);
 
+    /// Returns a cached vector of 'type' or a new one if there is none. A
+    /// vector of a complex type is looked up by type equality, the other
+    /// vectors are all of 'type'.
     VectorPtr pop(
         const TypePtr& type,
         vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+        memory::MemoryPool& pool,
+        uint64_t& retainedBytes);
 
     /// Clears all the cached vectors.
     void clear();
   };
 
+  // Moves the vectors in 'pending_' which are no longer referenced
+  // elsewhere into 'this'.
+  void releaseUnreferenced();
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -73,6 +102,15 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Cache of pre-allocated ARRAY, MAP and ROW vectors of any type.
+  TypePool complexVectors_;
+
+  /// Bytes retained by the cached string and complex vectors.
+  uint64_t retainedBytes_{0};
+
+  /// Vectors passed to releaseWhenUnreferenced(), oldest first.
+  std::deque<VectorPtr> pending_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorSaver.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <fstream>
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -72,6 +76,128 @@ std::string read<std::string>(std::istream& in) {
   return data;
 }
 
+// Alignment of the buffer contents in a snapshot file.
+constexpr int64_t kSnapshotAlignment = 64;
+
+// First 8 bytes of a snapshot file: "VXSNAP01".
+constexpr int64_t kSnapshotMagic = 0x313050414e535856;
+
+// Index of the stream variable which marks the streams of snapshots. The
+// iword of an output stream is 1 while writing a snapshot. The pword of an
+// input stream points to the MappedSnapshot being read.
+int snapshotStreamIndex() {
+  static const int index = std::ios_base::xalloc();
+  return index;
+}
+
+// The file of a snapshot mapped in memory. Unmapped when the last buffer
+// over it is released.
+class MappedSnapshot : public std::enable_shared_from_this<MappedSnapshot> {
+ public:
+  static std::shared_ptr<MappedSnapshot> map(const char* filePath) {
+    const int fd = ::open(filePath, O_RDONLY);
+    VELOX_CHECK_GE(fd, 0, "Cannot open file: {}", filePath);
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0) {
+      ::close(fd);
+      VELOX_FAIL("Cannot stat file: {}", filePath);
+    }
+    const size_t size = fileStat.st_size;
+    VELOX_CHECK_GE(
+        size, sizeof(kSnapshotMagic), "Not a snapshot: {}", filePath);
+    // The mapping is read-only. Buffers which need changes, e.g. the string
+    // views rebased onto the mapped string buffers, are copied first.
+    auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    VELOX_CHECK(data != MAP_FAILED, "Cannot map file: {}", filePath);
+    return std::shared_ptr<MappedSnapshot>(
+        new MappedSnapshot(static_cast<char*>(data), size));
+  }
+
+  ~MappedSnapshot() {
+    ::munmap(data_, size_);
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns a view over the 'numBytes' bytes of the buffer at the next
+  // aligned offset of 'in' and moves 'in' past them.
+  BufferPtr readBuffer(std::istream& in, int32_t numBytes);
+
+ private:
+  // Holds a reference to the mapping.
+  struct Releaser {
+    std::shared_ptr<MappedSnapshot> snapshot;
+
+    void addRef() const {}
+    void release() const {}
+  };
+
+  MappedSnapshot(char* data, size_t size) : data_(data), size_(size) {}
+
+  char* const data_;
+  const size_t size_;
+};
+
+BufferPtr MappedSnapshot::readBuffer(std::istream& in, int32_t numBytes) {
+  const int64_t offset =
+      bits::roundUp(static_cast<int64_t>(in.tellg()), kSnapshotAlignment);
+  VELOX_CHECK_LE(offset + numBytes, size_, "Buffer is outside of snapshot");
+  in.seekg(offset + numBytes);
+  return BufferView<Releaser>::create(
+      reinterpret_cast<const uint8_t*>(data_ + offset),
+      numBytes,
+      Releaser{shared_from_this()});
+}
+
+// Reads from memory, e.g. a MappedSnapshot, with support for tellg() and
+// seekg().
+class MemoryStreamBuf : public std::streambuf {
+ public:
+  MemoryStreamBuf(char* data, size_t size) {
+    setg(data, data, data + size);
+  }
+
+ protected:
+  pos_type seekoff(
+      off_type offset,
+      std::ios_base::seekdir dir,
+      std::ios_base::openmode /*which*/) override {
+    char* target = egptr();
+    if (dir == std::ios_base::beg) {
+      target = eback();
+    } else if (dir == std::ios_base::cur) {
+      target = gptr();
+    }
+    target += offset;
+    if (target < eback() || target > egptr()) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override {
+    return seekoff(off_type(position), std::ios_base::beg, which);
+  }
+};
+
+// Pads 'out' to the alignment of buffer contents if this writes a snapshot.
+void alignForSnapshot(std::ostream& out) {
+  if (out.iword(snapshotStreamIndex()) == 0) {
+    return;
+  }
+  static const char kZeros[kSnapshotAlignment] = {};
+  const int64_t offset = out.tellp();
+  out.write(kZeros, bits::roundUp(offset, kSnapshotAlignment) - offset);
+}
+
 void writeEncoding(VectorEncoding::Simple encoding, std::ostream& out) {
   switch (encoding) {
     case VectorEncoding::Simple::FLAT:
@@ -165,6 +291,7 @@ void writeStringViews(
     const std::vector<BufferPtr>& stringBuffers,
     std::ostream& out) {
   write<int32_t>(strings->size(), out);
+  alignForSnapshot(out);
 
   auto rawBytes = strings->as<char>();
   auto rawValues = strings->as<StringView>();
@@ -262,6 +389,10 @@ VectorPtr readFlatVector(
 
     // Update the pointers in the StringViews.
     if (values) {
+      if (values->isView()) {
+        // Read from a snapshot. The string buffers stay mapped.
+        values = AlignedBuffer::copy(pool, values);
+      }
       restoreVectorStringViews(size, values, stringBuffers);
     }
   }
@@ -551,6 +682,7 @@ VectorPtr readLazyVector(
 void writeBuffer(const BufferPtr& buffer, std::ostream& out) {
   VELOX_CHECK_NOT_NULL(buffer);
   write<int32_t>(buffer->size(), out);
+  alignForSnapshot(out);
   out.write(buffer->as<char>(), buffer->size());
 }
 
@@ -565,6 +697,10 @@ void writeOptionalBuffer(const BufferPtr& buffer, std::ostream& out) {
 
 BufferPtr readBuffer(std::istream& in, memory::MemoryPool* pool) {
   auto numBytes = read<int32_t>(in);
+  if (auto* snapshot =
+          static_cast<MappedSnapshot*>(in.pword(snapshotStreamIndex()))) {
+    return snapshot->readBuffer(in, numBytes);
+  }
   auto buffer = AlignedBuffer::allocate<char>(numBytes, pool);
   auto rawBuffer = buffer->asMutable<char>();
   in.read(rawBuffer, numBytes);
@@ -687,6 +823,28 @@ VectorPtr restoreVectorFromFile(
   return result;
 }
 
+void saveVectorSnapshot(const BaseVector& vector, const char* filePath) {
+  std::ofstream outputFile(filePath, std::ofstream::binary);
+  VELOX_CHECK(!outputFile.fail(), "Cannot open file: {}", filePath);
+  outputFile.iword(snapshotStreamIndex()) = 1;
+  write<int64_t>(kSnapshotMagic, outputFile);
+  saveVector(vector, outputFile);
+  outputFile.close();
+  VELOX_CHECK(!outputFile.fail(), "Cannot write file: {}", filePath);
+}
+
+VectorPtr restoreVectorFromSnapshot(
+    const char* filePath,
+    memory::MemoryPool* pool) {
+  auto snapshot = MappedSnapshot::map(filePath);
+  MemoryStreamBuf streamBuf(snapshot->data(), snapshot->size());
+  std::istream in(&streamBuf);
+  VELOX_CHECK_EQ(
+      read<int64_t>(in), kSnapshotMagic, "Not a snapshot: {}", filePath);
+  in.pword(snapshotStreamIndex()) = snapshot.get();
+  return restoreVector(in, pool);
+}
+
 std::string restoreStringFromFile(const char* filePath) {
   std::ifstream inputFile(filePath, std::ifstream::binary);
   VELOX_CHECK(!inputFile.fail(), "Cannot open file: {}", filePath);
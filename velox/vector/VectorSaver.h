@@ -50,6 +50,20 @@ VectorPtr restoreVector(std::istream& in, memory::MemoryPool* pool);
 /// method call
 VectorPtr restoreVectorFromFile(const char* filePath, memory::MemoryPool* pool);
 
+/// Writes the vector to a new file in 'filePath' in the format of
+/// saveVector(), preceded by a magic number and with the contents of all
+/// buffers aligned to 64 bytes in the file. restoreVectorFromSnapshot() can
+/// then map the buffers instead of copying them.
+void saveVectorSnapshot(const BaseVector& vector, const char* filePath);
+
+/// Maps a file written by saveVectorSnapshot() in memory and returns the
+/// vector. The buffers of the vector, except for the StringViews which are
+/// rebased, are read-only views over the mapping, which stays mapped until
+/// the last of them is released. The mapped memory is not counted in 'pool'.
+VectorPtr restoreVectorFromSnapshot(
+    const char* filePath,
+    memory::MemoryPool* pool);
+
 /// Reads a string from a file stored by saveStringToFile() method
 std::string restoreStringFromFile(const char* filePath);
 
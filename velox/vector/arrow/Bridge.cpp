@@ -573,6 +573,31 @@ VectorPtr createStringFlatVectorFromUtf8View(
         arrowArray.buffers[buffer_id], bufferSizes[buffer_id - 2]);
   }
 
+  // An inline Arrow Utf8View [4-byte length, 12-byte data] has the layout of
+  // an inline Velox StringView. If all the strings are inline, the views are
+  // wrapped without a copy.
+  const auto* arrowViews = static_cast<const uint32_t*>(arrowArray.buffers[1]);
+  bool allInline = true;
+  for (int64_t i = 0; i < arrowArray.length; ++i) {
+    if (arrowViews[4 * i] > StringView::kInlineSize) {
+      allInline = false;
+      break;
+    }
+  }
+  if (allInline) {
+    return std::make_shared<FlatVector<StringView>>(
+        pool,
+        type,
+        nulls,
+        arrowArray.length,
+        wrapInBufferView(
+            arrowArray.buffers[1], arrowArray.length * sizeof(StringView)),
+        std::vector<BufferPtr>(),
+        SimpleVectorStats<StringView>{},
+        std::nullopt,
+        optionalNullCount(arrowArray.null_count));
+  }
+
   BufferPtr stringViews =
       AlignedBuffer::allocate<StringView>(arrowArray.length, pool);
   auto* rawStringViews = stringViews->asMutable<uint64_t>();
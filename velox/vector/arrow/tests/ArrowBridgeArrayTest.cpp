@@ -1621,6 +1621,30 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         ArrowOptions{.exportToStringView = true});
   }
 
+  void testImportInlineStringView() {
+    arrow::StringViewBuilder sb(arrow::default_memory_pool());
+    ASSERT_OK(sb.Append("hello world", 11));
+    ASSERT_OK(sb.AppendNull());
+    ASSERT_OK(sb.Append("", 0));
+    ASSERT_OK(sb.Append("twelve bytes", 12));
+    ASSERT_OK(sb.Append("a", 1));
+    ASSERT_OK_AND_ASSIGN(auto array, sb.Finish());
+    const void* views = array->data()->buffers[1]->data();
+
+    testArrowRoundTrip(
+        *array,
+        [views](const BaseVector& vec) {
+          // All the strings are inline, so the views are not copied.
+          auto* flat = vec.asFlatVector<StringView>();
+          ASSERT_EQ(flat->values()->as<void>(), views);
+          ASSERT_TRUE(flat->stringBuffers().empty());
+          EXPECT_EQ(vec.size(), 5);
+          EXPECT_EQ(flat->valueAt(3), StringView("twelve bytes"));
+          EXPECT_TRUE(vec.isNullAt(1));
+        },
+        ArrowOptions{.exportToStringView = true});
+  }
+
   void testImportREE() {
     testImportREENoRuns();
     testImportREESingleRun();
@@ -1831,6 +1855,7 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
 
 TEST_F(ArrowBridgeArrayImportAsViewerTest, stringview) {
   testImportStringView();
+  testImportInlineStringView();
 }
 
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
@@ -1888,6 +1913,7 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
 
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringview) {
   testImportStringView();
+  testImportInlineStringView();
 }
 
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
@@ -577,6 +577,49 @@ TEST_F(DecodedVectorTest, dictionary) {
       1000, [](vector_size_t i) { return std::make_shared<int>(i % 5); });
 }
 
+TEST_F(DecodedVectorTest, biased) {
+  auto test = [&](auto value) {
+    using T = decltype(value);
+    std::vector<std::optional<T>> data;
+    for (auto i = 0; i < 1'000; ++i) {
+      if (i % 11 == 0) {
+        data.push_back(std::nullopt);
+      } else {
+        data.push_back(T(value + (i * 7) % 100));
+      }
+    }
+    auto biased = vectorMaker_.biasVector<T>(data);
+    ASSERT_EQ(biased->encoding(), VectorEncoding::Simple::BIASED);
+
+    SelectivityVector rows(data.size());
+    DecodedVector decoded(*biased, rows);
+    ASSERT_TRUE(decoded.isIdentityMapping());
+    for (auto i = 0; i < data.size(); ++i) {
+      ASSERT_EQ(decoded.isNullAt(i), !data[i].has_value()) << i;
+      if (data[i].has_value()) {
+        ASSERT_EQ(decoded.valueAt<T>(i), data[i].value()) << i;
+      }
+    }
+
+    // Wrapped in a dictionary.
+    auto indices = makeIndicesInReverse(data.size());
+    auto dictionary = BaseVector::wrapInDictionary(
+        nullptr, indices, data.size(), biased);
+    decoded.decode(*dictionary, rows);
+    for (auto i = 0; i < data.size(); ++i) {
+      const auto& expected = data[data.size() - 1 - i];
+      ASSERT_EQ(decoded.isNullAt(i), !expected.has_value()) << i;
+      if (expected.has_value()) {
+        ASSERT_EQ(decoded.valueAt<T>(i), expected.value()) << i;
+      }
+    }
+  };
+
+  test(int16_t(-10'000));
+  test(int32_t(1'000'000));
+  test(int64_t(10'000'000'000));
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverLazy) {
   constexpr vector_size_t size = 1000;
   auto lazyVector = vectorMaker_.lazyFlatVector<int32_t>(
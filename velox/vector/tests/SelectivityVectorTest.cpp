@@ -619,4 +619,67 @@ TEST(SelectivityVectorTest, copyNulls) {
   }
 }
 
+TEST(SelectivityVectorTest, sparse) {
+  const vector_size_t size = 10'000;
+  auto selected = [](const SelectivityVector& rows) {
+    std::vector<vector_size_t> result;
+    rows.applyToSelected([&](auto row) { result.push_back(row); });
+    return result;
+  };
+
+  SelectivityVector rows(size, false);
+  std::vector<vector_size_t> expected;
+  for (auto i = 7; i < size; i += 997) {
+    rows.setValid(i, true);
+    expected.push_back(i);
+  }
+  // The list of rows is made by updateBounds().
+  rows.updateBounds();
+  EXPECT_TRUE(rows.testingIsSparse());
+  EXPECT_EQ(selected(rows), expected);
+
+  // Changes to the bits reset the list. The bits are iterated until the next
+  // updateBounds().
+  rows.setValid(100, true);
+  EXPECT_FALSE(rows.testingIsSparse());
+  expected.insert(expected.begin() + 1, 100);
+  EXPECT_EQ(selected(rows), expected);
+  EXPECT_FALSE(rows.testingIsSparse());
+  rows.updateBounds();
+  EXPECT_TRUE(rows.testingIsSparse());
+  EXPECT_EQ(selected(rows), expected);
+
+  bits::setBit(rows.asMutableRange().bits(), 200);
+  rows.updateBounds();
+  expected.insert(expected.begin() + 2, 200);
+  EXPECT_EQ(selected(rows), expected);
+
+  SelectivityVector other(size, false);
+  other.setValidRange(0, 150, true);
+  other.updateBounds();
+  rows.deselect(other);
+  expected.erase(expected.begin(), expected.begin() + 2);
+  EXPECT_EQ(selected(rows), expected);
+
+  // Dense vectors iterate over the bits.
+  rows.setValidRange(0, 1'000, true);
+  rows.updateBounds();
+  auto result = selected(rows);
+  EXPECT_FALSE(rows.testingIsSparse());
+  EXPECT_EQ(result.size(), 1'000 + expected.size() - 1);
+  EXPECT_EQ(result.back(), expected.back());
+
+  rows.clearAll();
+  EXPECT_TRUE(selected(rows).empty());
+  rows.setAll();
+  EXPECT_EQ(selected(rows).size(), size);
+
+  // Short ranges are not collected.
+  SelectivityVector small(500, false);
+  small.setValid(10, true);
+  small.updateBounds();
+  EXPECT_EQ(selected(small), std::vector<vector_size_t>{10});
+  EXPECT_FALSE(small.testingIsSparse());
+}
+
 } // namespace facebook::velox
@@ -292,6 +292,43 @@ TEST_F(VectorEstimateFlatSizeTest, flatStrings) {
   EXPECT_EQ(65504, flat->estimateFlatSize());
 }
 
+TEST_F(VectorEstimateFlatSizeTest, stringBuffers) {
+  // The capacity of the string buffers is kept up to date as they are added,
+  // replaced and cleared.
+  auto flat = makeFlatVector<StringView>(1'000, shortStringAt);
+  const auto baseSize = flat->retainedSize();
+  auto buffer = AlignedBuffer::allocate<char>(1'000, pool());
+  const auto capacity = buffer->capacity();
+
+  EXPECT_TRUE(flat->addStringBuffer(buffer));
+  EXPECT_EQ(baseSize + capacity, flat->retainedSize());
+  // Adding the same buffer again does not count it twice.
+  EXPECT_FALSE(flat->addStringBuffer(buffer));
+  EXPECT_EQ(baseSize + capacity, flat->retainedSize());
+
+  auto other = makeFlatVector<StringView>(10, shortStringAt);
+  other->acquireSharedStringBuffers(flat.get());
+  EXPECT_EQ(other->stringBuffers().size(), 1);
+  EXPECT_EQ(
+      makeFlatVector<StringView>(10, shortStringAt)->retainedSize() + capacity,
+      other->retainedSize());
+
+  auto otherBuffer = AlignedBuffer::allocate<char>(10'000, pool());
+  flat->setStringBuffers({buffer, otherBuffer});
+  EXPECT_EQ(
+      baseSize + capacity + otherBuffer->capacity(), flat->retainedSize());
+
+  flat->clearStringBuffers();
+  EXPECT_EQ(baseSize, flat->retainedSize());
+
+  // Appending strings allocates buffers through addStringBuffer.
+  const std::string longString(100, 'x');
+  flat->set(0, StringView(longString));
+  EXPECT_EQ(flat->stringBuffers().size(), 1);
+  EXPECT_EQ(
+      baseSize + flat->stringBuffers()[0]->capacity(), flat->retainedSize());
+}
+
 TEST_F(VectorEstimateFlatSizeTest, dictionaryShortStrings) {
   // Inlined strings.
   auto indices = makeIndices(100, [](auto row) { return row * 2; });
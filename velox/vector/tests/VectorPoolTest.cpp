@@ -195,4 +195,111 @@ TEST_F(VectorPoolTest, clear) {
     ASSERT_EQ(vectorPtrs[i].lock(), nullptr);
   }
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto arrayType = ARRAY(BIGINT());
+  auto vector = vectorPool.get(arrayType, 1'000);
+  ASSERT_EQ(1'000, vector->size());
+  ASSERT_EQ(*arrayType, *vector->type());
+
+  // Recycles an array vector with nulls and elements.
+  vector = makeArrayVector<int64_t>(
+      100, [](auto row) { return row % 5; }, [](auto row) { return row; });
+  vector->setNull(3, true);
+  auto* vectorPtr = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_GT(vectorPool.retainedBytes(), 0);
+
+  // Another type is not matched.
+  auto mapVector = vectorPool.get(MAP(BIGINT(), BIGINT()), 10);
+  ASSERT_NE(vectorPtr, mapVector.get());
+
+  auto recycled = vectorPool.get(arrayType, 50);
+  ASSERT_EQ(vectorPtr, recycled.get());
+  ASSERT_EQ(0, vectorPool.retainedBytes());
+  ASSERT_EQ(50, recycled->size());
+  auto* array = recycled->as<ArrayVector>();
+  ASSERT_EQ(0, array->elements()->size());
+  for (auto i = 0; i < 50; ++i) {
+    ASSERT_FALSE(array->isNullAt(i));
+    ASSERT_EQ(0, array->sizeAt(i));
+  }
+
+  // Rows are matched by names and get children of the requested size.
+  auto rowType = ROW({"a", "b"}, {VARCHAR(), ARRAY(INTEGER())});
+  auto row = vectorPool.get(rowType, 100);
+  auto* rowPtr = row.get();
+  ASSERT_TRUE(vectorPool.release(row));
+  ASSERT_NE(
+      rowPtr,
+      vectorPool.get(ROW({"c", "d"}, {VARCHAR(), ARRAY(INTEGER())}), 10)
+          .get());
+  row = vectorPool.get(rowType, 10);
+  ASSERT_EQ(rowPtr, row.get());
+  ASSERT_EQ(10, row->size());
+  ASSERT_EQ(10, row->as<RowVector>()->childAt(0)->size());
+  ASSERT_EQ(10, row->as<RowVector>()->childAt(1)->size());
+
+  // A row with a shared child is not recycled.
+  auto child = row->as<RowVector>()->childAt(0);
+  ASSERT_FALSE(vectorPool.release(row));
+  ASSERT_NE(row, nullptr);
+}
+
+TEST_F(VectorPoolTest, retainedBytesLimit) {
+  VectorPool vectorPool(pool());
+
+  const std::string value(40'000, 'x');
+  auto makeStrings = [&]() {
+    return makeArrayVector<StringView>(
+        100,
+        [](auto /*row*/) { return 1; },
+        [&](auto /*row*/) { return StringView(value); });
+  };
+
+  // Each vector retains 4MB of strings. Only some fit.
+  std::vector<VectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeStrings());
+  }
+  const auto numReleased = vectorPool.release(vectors);
+  ASSERT_GT(numReleased, 0);
+  ASSERT_LT(numReleased, 10);
+
+  vectorPool.clear();
+  ASSERT_EQ(0, vectorPool.retainedBytes());
+  auto vector = makeStrings();
+  ASSERT_TRUE(vectorPool.release(vector));
+}
+
+TEST_F(VectorPoolTest, releaseWhenUnreferenced) {
+  VectorPool vectorPool(pool());
+
+  auto vector = vectorPool.get(BIGINT(), 1'000);
+  auto* vectorPtr = vector.get();
+  vectorPool.releaseWhenUnreferenced(vector);
+
+  // Still referenced.
+  ASSERT_NE(vectorPtr, vectorPool.get(BIGINT(), 1'000).get());
+
+  vector.reset();
+  ASSERT_EQ(vectorPtr, vectorPool.get(BIGINT(), 1'000).get());
+
+  // Only the last 10 vectors are kept.
+  std::vector<VectorPtr> vectors;
+  for (auto i = 0; i < 15; ++i) {
+    vectors.push_back(vectorPool.get(BIGINT(), 1'000));
+    vectorPool.releaseWhenUnreferenced(vectors.back());
+  }
+  std::vector<BaseVector*> vectorPtrs;
+  for (auto i = 0; i < 15; ++i) {
+    vectorPtrs.push_back(vectors[i].get());
+  }
+  vectors.clear();
+  for (auto i = 14; i >= 5; --i) {
+    ASSERT_EQ(vectorPtrs[i], vectorPool.get(BIGINT(), 1'000).get());
+  }
+}
 } // namespace facebook::velox::test
@@ -672,6 +672,54 @@ TEST_F(VectorSaverTest, exceptionContext) {
   }
 }
 
+TEST_F(VectorSaverTest, snapshot) {
+  SCOPED_TRACE(fmt::format("seed: {}", seed_));
+  auto options = fuzzerOptions();
+  options.nullRatio = 0.1;
+  VectorFuzzer fuzzer(options, pool(), seed_);
+  auto type =
+      ROW({BIGINT(), VARCHAR(), ARRAY(INTEGER()), MAP(VARCHAR(), DOUBLE())});
+  std::vector<VectorPtr> children;
+  for (const auto& childType : type->children()) {
+    children.push_back(fuzzer.fuzzFlat(childType));
+  }
+  children.push_back(wrapInDictionary(
+      makeIndicesInReverse(options.vectorSize), fuzzer.fuzzFlat(BIGINT())));
+  auto vector = makeRowVector(children);
+
+  auto path = exec::test::TempFilePath::create();
+  saveVectorSnapshot(*vector, path->getPath().c_str());
+  // The snapshot is mapped, so it stays readable after the file is removed.
+  auto copy = restoreVectorFromSnapshot(path->getPath().c_str(), pool());
+  path.reset();
+
+  assertEqualEncodings(vector, copy);
+
+  // The fixed-width buffers are aligned views over the mapping.
+  auto* row = copy->as<RowVector>();
+  for (const auto& buffer :
+       {row->childAt(0)->values(),
+        row->childAt(0)->nulls(),
+        row->childAt(2)->as<ArrayVector>()->offsets(),
+        row->childAt(4)->wrapInfo()}) {
+    ASSERT_TRUE(buffer->isView());
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer->as<char>()) % 64, 0);
+  }
+  // The string views are rebased into a copy. The strings are mapped.
+  auto* strings = row->childAt(1)->asFlatVector<StringView>();
+  ASSERT_FALSE(strings->values()->isView());
+  for (const auto& buffer : strings->stringBuffers()) {
+    ASSERT_TRUE(buffer->isView());
+  }
+
+  // A file written by saveVector() is not a snapshot.
+  auto otherPath = exec::test::TempFilePath::create();
+  saveVectorToFile(vector.get(), otherPath->getPath().c_str());
+  VELOX_ASSERT_THROW(
+      restoreVectorFromSnapshot(otherPath->getPath().c_str(), pool()),
+      "Not a snapshot");
+}
+
 TEST_F(VectorSaverTest, multipleVectors) {
   // Save and restore multiple vectors to/from a single binary.
 